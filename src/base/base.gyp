@@ -414,6 +414,7 @@
         'containers/adapters_unittest.cc',
         'containers/hash_tables_unittest.cc',
         'containers/linked_list_unittest.cc',
+        'containers/flat_mru_cache_unittest.cc',
         'containers/mru_cache_unittest.cc',
         'containers/scoped_ptr_hash_map_unittest.cc',
         'containers/small_map_unittest.cc',
@@ -429,6 +430,7 @@
         'environment_unittest.cc',
         'feature_list_unittest.cc',
         'file_version_info_win_unittest.cc',
+        'files/async_file_unittest.cc',
         'files/dir_reader_posix_unittest.cc',
         'files/file_locking_unittest.cc',
         'files/file_path_unittest.cc',
@@ -448,6 +450,7 @@
         'i18n/char_iterator_unittest.cc',
         'i18n/file_util_icu_unittest.cc',
         'i18n/icu_string_conversions_unittest.cc',
+        'i18n/icu_util_unittest.cc',
         'i18n/message_formatter_unittest.cc',
         'i18n/number_formatting_unittest.cc',
         'i18n/rtl_unittest.cc',
@@ -484,6 +487,7 @@
         'memory/linked_ptr_unittest.cc',
         'memory/memory_pressure_listener_unittest.cc',
         'memory/memory_pressure_monitor_chromeos_unittest.cc',
+        'memory/memory_pressure_monitor_linux_unittest.cc',
         'memory/memory_pressure_monitor_mac_unittest.cc',
         'memory/memory_pressure_monitor_win_unittest.cc',
         'memory/ptr_util_unittest.cc',
@@ -496,6 +500,7 @@
         'memory/singleton_unittest.cc',
         'memory/weak_ptr_unittest.cc',
         'memory/weak_ptr_unittest.nc',
+        'message_loop/lock_free_task_queue_unittest.cc',
         'message_loop/message_loop_task_runner_unittest.cc',
         'message_loop/message_loop_unittest.cc',
         'message_loop/message_pump_glib_unittest.cc',
@@ -586,6 +591,7 @@
         'task_scheduler/test_task_factory.cc',
         'task_scheduler/test_task_factory.h',
         'task_scheduler/test_utils.h',
+        'task_scheduler/timer_wheel_unittest.cc',
         'template_util_unittest.cc',
         'test/histogram_tester_unittest.cc',
         'test/test_pending_task_unittest.cc',
@@ -812,9 +818,16 @@
         '../testing/gtest.gyp:gtest',
       ],
       'sources': [
+        'callback_perftest.cc',
+        'containers/mru_cache_perftest.cc',
+        'message_loop/message_loop_perftest.cc',
         'message_loop/message_pump_perftest.cc',
+        'strings/string_util_perftest.cc',
+        'task_scheduler/delayed_task_manager_perftest.cc',
+        'task_scheduler/scheduler_worker_pool_impl_perftest.cc',
         'test/run_all_unittests.cc',
         'threading/thread_perftest.cc',
+        'values_perftest.cc',
         '../testing/perf/perf_test.cc'
       ],
       'conditions': [
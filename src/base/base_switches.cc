@@ -24,6 +24,13 @@ const char kEnableHeapProfiling[]           = "enable-heap-profiling";
 // derived from trace events are reported.
 const char kEnableHeapProfilingModeNative[] = "native";
 
+// Makes the heap profiler record a Poisson-distributed sample of the
+// allocations instead of all of them, with the given mean number of bytes
+// between two recorded allocations. The heap dumps are scaled back up to
+// estimate the whole heap.
+const char kHeapProfilingSamplingInterval[] =
+    "heap-profiling-sampling-interval";
+
 // Generates full memory crash dump.
 const char kFullMemoryCrashReport[]         = "full-memory-crash-report";
 
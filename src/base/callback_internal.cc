@@ -4,11 +4,130 @@
 
 #include "base/callback_internal.h"
 
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/macros.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace base {
 namespace internal {
 
+namespace {
+
+// BindStates up to this size are allocated from the per-thread cache. This fits
+// the BindState of a method bound to a WeakPtr and two pointer-sized arguments.
+const size_t kSmallBindStateSize = 8 * sizeof(void*);
+
+// Maximum number of free blocks kept by the cache of a thread. Blocks freed
+// beyond that are returned to the heap. Since tasks are usually destroyed on
+// the thread that runs them, this bounds the memory held by threads that run
+// more tasks than they post.
+const size_t kMaxFreeBlocksPerThread = 64;
+
+// Cache of blocks of |kSmallBindStateSize| bytes. A block can be freed to the
+// cache of any thread, not only the thread that allocated it.
+class SmallBindStateCache {
+ public:
+  SmallBindStateCache() = default;
+
+  ~SmallBindStateCache() {
+    while (free_list_) {
+      FreeBlock* const block = free_list_;
+      free_list_ = block->next;
+      ::operator delete(block);
+    }
+  }
+
+  void* Allocate() {
+    if (!free_list_)
+      return AllocateFromHeap(kSmallBindStateSize);
+    FreeBlock* const block = free_list_;
+    free_list_ = block->next;
+    --num_free_blocks_;
+    return block;
+  }
+
+  void Free(void* ptr) {
+    if (num_free_blocks_ == kMaxFreeBlocksPerThread) {
+      ::operator delete(ptr);
+      return;
+    }
+    FreeBlock* const block = static_cast<FreeBlock*>(ptr);
+    block->next = free_list_;
+    free_list_ = block;
+    ++num_free_blocks_;
+  }
+
+  void* AllocateFromHeap(size_t size) {
+    ++num_heap_allocations_;
+    return ::operator new(size);
+  }
+
+  size_t num_heap_allocations() const { return num_heap_allocations_; }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  FreeBlock* free_list_ = nullptr;
+  size_t num_free_blocks_ = 0;
+  size_t num_heap_allocations_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SmallBindStateCache);
+};
+
+void DeleteSmallBindStateCache(void* cache) {
+  delete static_cast<SmallBindStateCache*>(cache);
+}
+
+// A ThreadLocalStorage::Slot which deletes the cache of a thread when it exits.
+class SmallBindStateCacheSlot : public ThreadLocalStorage::Slot {
+ public:
+  SmallBindStateCacheSlot() : Slot(&DeleteSmallBindStateCache) {}
+};
+
+LazyInstance<SmallBindStateCacheSlot>::Leaky g_small_bind_state_cache_slot =
+    LAZY_INSTANCE_INITIALIZER;
+
+SmallBindStateCache* GetSmallBindStateCacheForCurrentThread() {
+  SmallBindStateCacheSlot& slot = g_small_bind_state_cache_slot.Get();
+  SmallBindStateCache* cache = static_cast<SmallBindStateCache*>(slot.Get());
+  if (!cache) {
+    // Also reached if a BindState is freed after the cache of the exiting
+    // thread was deleted. ThreadLocalStorage then deletes the new cache too.
+    cache = new SmallBindStateCache;
+    slot.Set(cache);
+  }
+  return cache;
+}
+
+}  // namespace
+
+// static
+void* BindStateBase::operator new(size_t size) {
+  SmallBindStateCache* const cache = GetSmallBindStateCacheForCurrentThread();
+  if (size > kSmallBindStateSize)
+    return cache->AllocateFromHeap(size);
+  return cache->Allocate();
+}
+
+// static
+void BindStateBase::operator delete(void* ptr, size_t size) {
+  if (!ptr)
+    return;
+  if (size > kSmallBindStateSize) {
+    ::operator delete(ptr);
+    return;
+  }
+  GetSmallBindStateCacheForCurrentThread()->Free(ptr);
+}
+
+// static
+size_t BindStateBase::GetHeapAllocationCountForTesting() {
+  return GetSmallBindStateCacheForCurrentThread()->num_heap_allocations();
+}
+
 void BindStateBase::AddRef() {
   AtomicRefCountInc(&ref_count_);
 }
@@ -8,6 +8,8 @@
 #ifndef BASE_CALLBACK_INTERNAL_H_
 #define BASE_CALLBACK_INTERNAL_H_
 
+#include <stddef.h>
+
 #include "base/atomic_ref_count.h"
 #include "base/base_export.h"
 #include "base/callback_forward.h"
@@ -30,7 +32,20 @@ class CallbackBase;
 // Creating a vtable for every BindState template instantiation results in a lot
 // of bloat. Its only task is to call the destructor which can be done with a
 // function pointer.
-class BindStateBase {
+//
+// Most BindStates are small (e.g. a method bound to a WeakPtr), and are created
+// and destroyed once per posted task. To avoid a heap allocation per task,
+// small BindStates are allocated from a per-thread cache of recycled blocks.
+// Larger BindStates are allocated from the heap.
+class BASE_EXPORT BindStateBase {
+ public:
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
+
+  // Returns the number of BindStates that were allocated from the heap rather
+  // than from the per-thread cache on the current thread. Provided for testing.
+  static size_t GetHeapAllocationCountForTesting();
+
  protected:
   explicit BindStateBase(void (*destructor)(BindStateBase*))
       : ref_count_(0), destructor_(destructor) {}
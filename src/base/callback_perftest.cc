@@ -0,0 +1,135 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/callback.h"
+
+#include <stddef.h>
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/callback_internal.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const size_t kNumCallbacks = 1000000;
+const size_t kNumTasks = 100000;
+
+class Receiver {
+ public:
+  Receiver() : weak_ptr_factory_(this) {}
+
+  void Increment() { ++count_; }
+  void IncrementBy(int a, int b) { count_ += a + b; }
+  void TakeStrings(const std::string& a,
+                   const std::string& b,
+                   const std::string& c) {
+    ++count_;
+  }
+
+  WeakPtr<Receiver> GetWeakPtr() { return weak_ptr_factory_.GetWeakPtr(); }
+
+ private:
+  size_t count_ = 0;
+  WeakPtrFactory<Receiver> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(Receiver);
+};
+
+size_t GetHeapAllocationCount() {
+  return internal::BindStateBase::GetHeapAllocationCountForTesting();
+}
+
+void PrintResults(const std::string& trace,
+                  size_t num_callbacks,
+                  size_t num_heap_allocations,
+                  TimeDelta elapsed) {
+  perf_test::PrintResult(
+      "callback_heap_allocations", "", trace,
+      static_cast<double>(num_heap_allocations) / num_callbacks,
+      "allocations/callback", true);
+  perf_test::PrintResult("callback_time", "", trace,
+                         elapsed.InMillisecondsF() * 1000000 / num_callbacks,
+                         "ns/callback", true);
+}
+
+// Binds, runs and destroys |kNumCallbacks| callbacks created by
+// |make_callback|.
+template <typename MakeCallback>
+void RunBindTest(const std::string& trace, MakeCallback make_callback) {
+  // Warm up the BindState cache of the current thread.
+  make_callback().Run();
+
+  const size_t num_heap_allocations = GetHeapAllocationCount();
+  const TimeTicks start = TimeTicks::Now();
+  for (size_t i = 0; i < kNumCallbacks; ++i)
+    make_callback().Run();
+  PrintResults(trace, kNumCallbacks,
+               GetHeapAllocationCount() - num_heap_allocations,
+               TimeTicks::Now() - start);
+}
+
+}  // namespace
+
+TEST(CallbackPerfTest, BindWeakMethod) {
+  Receiver receiver;
+  const WeakPtr<Receiver> weak_receiver = receiver.GetWeakPtr();
+  RunBindTest("weak_method", [&weak_receiver]() {
+    return Bind(&Receiver::Increment, weak_receiver);
+  });
+}
+
+TEST(CallbackPerfTest, BindWeakMethodWithTwoArgs) {
+  Receiver receiver;
+  const WeakPtr<Receiver> weak_receiver = receiver.GetWeakPtr();
+  RunBindTest("weak_method_two_args", [&weak_receiver]() {
+    return Bind(&Receiver::IncrementBy, weak_receiver, 1, 2);
+  });
+}
+
+TEST(CallbackPerfTest, BindLargeState) {
+  Receiver receiver;
+  const std::string str("a string that doesn't fit the small buffer");
+  RunBindTest("large_state", [&receiver, &str]() {
+    return Bind(&Receiver::TakeStrings, Unretained(&receiver), str, str, str);
+  });
+}
+
+// Posts |kNumTasks| tasks bound to a WeakPtr to the current MessageLoop and
+// runs them. Only BindState allocations are counted.
+TEST(CallbackPerfTest, PostTaskToCurrentThread) {
+  MessageLoop message_loop;
+  Receiver receiver;
+  const WeakPtr<Receiver> weak_receiver = receiver.GetWeakPtr();
+  scoped_refptr<SingleThreadTaskRunner> task_runner =
+      message_loop.task_runner();
+
+  const size_t num_heap_allocations = GetHeapAllocationCount();
+  const TimeTicks start = TimeTicks::Now();
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    task_runner->PostTask(FROM_HERE,
+                          Bind(&Receiver::Increment, weak_receiver));
+    // Run tasks in batches so that the cache of the thread is replenished as
+    // it would be by a running MessageLoop.
+    if (i % 64 == 63)
+      RunLoop().RunUntilIdle();
+  }
+  RunLoop().RunUntilIdle();
+  PrintResults("post_task", kNumTasks,
+               GetHeapAllocationCount() - num_heap_allocations,
+               TimeTicks::Now() - start);
+}
+
+}  // namespace base
@@ -5,6 +5,7 @@
 #include "base/callback.h"
 
 #include <memory>
+#include <string>
 
 #include "base/bind.h"
 #include "base/callback_helpers.h"
@@ -162,5 +163,30 @@ TEST_F(CallbackTest, CallbackHasLastRefOnContainingObject) {
   ASSERT_TRUE(deleted);
 }
 
+void NopInt(int* value) {}
+
+void TakeLargeArgs(const std::string& a,
+                   const std::string& b,
+                   const std::string& c) {}
+
+// Verify that the storage of small BindStates is recycled, while large
+// BindStates are allocated from the heap.
+TEST_F(CallbackTest, SmallBindStateIsRecycled) {
+  int value = 0;
+  // Warm up the cache of the current thread.
+  Bind(&NopInt, &value).Reset();
+
+  const size_t num_heap_allocations =
+      internal::BindStateBase::GetHeapAllocationCountForTesting();
+  for (int i = 0; i < 10; ++i)
+    Bind(&NopInt, &value).Run();
+  EXPECT_EQ(num_heap_allocations,
+            internal::BindStateBase::GetHeapAllocationCountForTesting());
+
+  Bind(&TakeLargeArgs, std::string(), std::string(), std::string()).Run();
+  EXPECT_EQ(num_heap_allocations + 1,
+            internal::BindStateBase::GetHeapAllocationCountForTesting());
+}
+
 }  // namespace
 }  // namespace base
@@ -0,0 +1,393 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// FlatMRUCache is a drop-in alternative to HashingMRUCache for hot caches.
+// HashingMRUCache allocates a list node and a hash map node for every entry
+// and follows several pointers on each lookup. FlatMRUCache keeps all entries
+// in one array, links them into the recency list by index, and finds them
+// through an open-addressed table of indices, so inserts only allocate when
+// the array grows and lookups touch two contiguous arrays.
+//
+// The interface matches MRUCacheBase, with one difference: iterators stay
+// valid across inserts and erases of other entries, as with MRUCache, but
+// pointers and references to entries do not survive an insert that grows the
+// cache. Caches created with a |max_size| stop growing once they can hold that
+// many entries.
+
+#ifndef BASE_CONTAINERS_FLAT_MRU_CACHE_H_
+#define BASE_CONTAINERS_FLAT_MRU_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/macros.h"
+
+namespace base {
+
+template <class KeyType,
+          class PayloadType,
+          class HashType = std::hash<KeyType>>
+class FlatMRUCache {
+ public:
+  typedef std::pair<KeyType, PayloadType> value_type;
+  typedef size_t size_type;
+
+ private:
+  static const uint32_t kNone = static_cast<uint32_t>(-1);
+
+  struct Node {
+    typename std::aligned_storage<sizeof(value_type),
+                                  alignof(value_type)>::type storage;
+    size_t hash;
+    // Neighbors in the recency list, or the next free node.
+    uint32_t prev;
+    uint32_t next;
+
+    value_type* value() { return reinterpret_cast<value_type*>(&storage); }
+    const value_type* value() const {
+      return reinterpret_cast<const value_type*>(&storage);
+    }
+  };
+
+  template <bool is_const>
+  class Iterator {
+   public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename FlatMRUCache::value_type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename std::conditional<is_const,
+                                      const value_type*,
+                                      value_type*>::type pointer;
+    typedef typename std::conditional<is_const,
+                                      const value_type&,
+                                      value_type&>::type reference;
+    typedef typename std::conditional<is_const,
+                                      const FlatMRUCache*,
+                                      FlatMRUCache*>::type Owner;
+
+    Iterator() : owner_(nullptr), index_(kNone) {}
+    Iterator(Owner owner, uint32_t index) : owner_(owner), index_(index) {}
+    // Allows conversion from iterator to const_iterator.
+    Iterator(const Iterator<false>& other)
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return *owner_->nodes_[index_].value(); }
+    pointer operator->() const { return owner_->nodes_[index_].value(); }
+
+    Iterator& operator++() {
+      index_ = owner_->nodes_[index_].next;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator result = *this;
+      ++*this;
+      return result;
+    }
+    // Decrementing end() gives the least recently used entry.
+    Iterator& operator--() {
+      index_ = index_ == kNone ? owner_->tail_ : owner_->nodes_[index_].prev;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator result = *this;
+      --*this;
+      return result;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    friend class FlatMRUCache;
+    friend class Iterator<true>;
+
+    Owner owner_;
+    uint32_t index_;
+  };
+
+ public:
+  typedef Iterator<false> iterator;
+  typedef Iterator<true> const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  enum { NO_AUTO_EVICT = 0 };
+
+  // See MRUCacheBase.
+  explicit FlatMRUCache(size_type max_size)
+      : capacity_(0),
+        bucket_mask_(0),
+        size_(0),
+        head_(kNone),
+        tail_(kNone),
+        free_(kNone),
+        max_size_(max_size) {}
+
+  ~FlatMRUCache() { Clear(); }
+
+  size_type max_size() const { return max_size_; }
+
+  // Inserts a payload item with the given key. If an existing item has
+  // the same key, it is removed prior to insertion. An iterator indicating the
+  // inserted item will be returned (this will always be the front of the list).
+  //
+  // The payload will be forwarded.
+  template <typename Payload>
+  iterator Put(const KeyType& key, Payload&& payload) {
+    size_t hash = hasher_(key);
+    uint32_t index = Find(key, hash);
+    if (index != kNone) {
+      Erase(iterator(this, index));
+    } else if (max_size_ != NO_AUTO_EVICT) {
+      ShrinkToSize(max_size_ - 1);
+    }
+
+    if (free_ == kNone) {
+      size_type new_capacity = capacity_ ? capacity_ * 2 : 4;
+      if (max_size_ != NO_AUTO_EVICT)
+        new_capacity = std::min(new_capacity, max_size_);
+      Grow(new_capacity);
+    }
+    index = free_;
+    Node& node = nodes_[index];
+    free_ = node.next;
+    new (&node.storage) value_type(key, std::forward<Payload>(payload));
+    node.hash = hash;
+    LinkFront(index);
+    InsertIntoBuckets(index);
+    ++size_;
+    return begin();
+  }
+
+  // Retrieves the contents of the given key, or end() if not found. This method
+  // has the side effect of moving the requested item to the front of the
+  // recency list.
+  iterator Get(const KeyType& key) {
+    uint32_t index = Find(key, hasher_(key));
+    if (index == kNone)
+      return end();
+    if (index != head_) {
+      Unlink(index);
+      LinkFront(index);
+    }
+    return begin();
+  }
+
+  // Retrieves the payload associated with a given key and returns it via
+  // result without affecting the ordering (unlike Get).
+  iterator Peek(const KeyType& key) {
+    return iterator(this, Find(key, hasher_(key)));
+  }
+
+  const_iterator Peek(const KeyType& key) const {
+    return const_iterator(this, Find(key, hasher_(key)));
+  }
+
+  // Exchanges the contents of |this| by the contents of the |other|.
+  void Swap(FlatMRUCache& other) {
+    nodes_.swap(other.nodes_);
+    buckets_.swap(other.buckets_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(bucket_mask_, other.bucket_mask_);
+    std::swap(size_, other.size_);
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(free_, other.free_);
+    std::swap(max_size_, other.max_size_);
+    std::swap(hasher_, other.hasher_);
+  }
+
+  // Erases the item referenced by the given iterator. An iterator to the item
+  // following it will be returned. The iterator must be valid.
+  iterator Erase(iterator pos) {
+    uint32_t index = pos.index_;
+    DCHECK_NE(kNone, index);
+    uint32_t next = nodes_[index].next;
+    RemoveFromBuckets(index);
+    Unlink(index);
+    nodes_[index].value()->~value_type();
+    nodes_[index].next = free_;
+    free_ = index;
+    --size_;
+    return iterator(this, next);
+  }
+
+  // See MRUCacheBase::Erase(reverse_iterator).
+  reverse_iterator Erase(reverse_iterator pos) {
+    return reverse_iterator(Erase((++pos).base()));
+  }
+
+  // Shrinks the cache so it only holds |new_size| items. If |new_size| is
+  // bigger or equal to the current number of items, this will do nothing.
+  void ShrinkToSize(size_type new_size) {
+    while (size_ > new_size)
+      Erase(iterator(this, tail_));
+  }
+
+  // Deletes everything from the cache. Keeps the memory for reuse.
+  void Clear() {
+    while (head_ != kNone)
+      Erase(begin());
+  }
+
+  // Returns the number of elements in the cache.
+  size_type size() const { return size_; }
+
+  // Allows iteration over the list. Forward iteration starts with the most
+  // recent item and works backwards.
+  iterator begin() { return iterator(this, head_); }
+  const_iterator begin() const { return const_iterator(this, head_); }
+  iterator end() { return iterator(this, kNone); }
+  const_iterator end() const { return const_iterator(this, kNone); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  bool empty() const { return size_ == 0; }
+
+ private:
+  // Returns the index of the node holding |key|, or kNone.
+  uint32_t Find(const KeyType& key, size_t hash) const {
+    if (!capacity_)
+      return kNone;
+    for (size_t bucket = hash & bucket_mask_;;
+         bucket = (bucket + 1) & bucket_mask_) {
+      uint32_t index = buckets_[bucket];
+      if (index == kNone)
+        return kNone;
+      const Node& node = nodes_[index];
+      if (node.hash == hash && node.value()->first == key)
+        return index;
+    }
+  }
+
+  void InsertIntoBuckets(uint32_t index) {
+    size_t bucket = nodes_[index].hash & bucket_mask_;
+    while (buckets_[bucket] != kNone)
+      bucket = (bucket + 1) & bucket_mask_;
+    buckets_[bucket] = index;
+  }
+
+  // Removes |index| from the probe sequence, shifting later entries of the
+  // same run back so that lookups never need tombstones.
+  void RemoveFromBuckets(uint32_t index) {
+    size_t hole = nodes_[index].hash & bucket_mask_;
+    while (buckets_[hole] != index)
+      hole = (hole + 1) & bucket_mask_;
+    for (size_t bucket = (hole + 1) & bucket_mask_;
+         buckets_[bucket] != kNone; bucket = (bucket + 1) & bucket_mask_) {
+      size_t home = nodes_[buckets_[bucket]].hash & bucket_mask_;
+      // Move the entry into the hole unless its home bucket lies cyclically
+      // in (hole, bucket].
+      bool home_after_hole = hole <= bucket ? (hole < home && home <= bucket)
+                                            : (hole < home || home <= bucket);
+      if (!home_after_hole) {
+        buckets_[hole] = buckets_[bucket];
+        hole = bucket;
+      }
+    }
+    buckets_[hole] = kNone;
+  }
+
+  void LinkFront(uint32_t index) {
+    nodes_[index].prev = kNone;
+    nodes_[index].next = head_;
+    if (head_ != kNone)
+      nodes_[head_].prev = index;
+    else
+      tail_ = index;
+    head_ = index;
+  }
+
+  void Unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != kNone)
+      nodes_[node.prev].next = node.next;
+    else
+      head_ = node.next;
+    if (node.next != kNone)
+      nodes_[node.next].prev = node.prev;
+    else
+      tail_ = node.prev;
+  }
+
+  // Reallocates the arrays to hold |new_capacity| entries, keeping each entry
+  // at its index so that iterators stay valid.
+  void Grow(size_type new_capacity) {
+    DCHECK_GT(new_capacity, capacity_);
+    CHECK_LT(new_capacity, static_cast<size_type>(kNone) / 2);
+    std::unique_ptr<Node[]> nodes(new Node[new_capacity]);
+    for (uint32_t index = head_; index != kNone; index = nodes_[index].next) {
+      Node& node = nodes[index];
+      new (&node.storage) value_type(std::move(*nodes_[index].value()));
+      nodes_[index].value()->~value_type();
+      node.hash = nodes_[index].hash;
+      node.prev = nodes_[index].prev;
+      node.next = nodes_[index].next;
+    }
+    // Existing free nodes are all in use once the array needs to grow, so the
+    // free list only holds the new nodes.
+    DCHECK_EQ(kNone, free_);
+    for (size_type i = capacity_; i < new_capacity; ++i) {
+      nodes[i].next =
+          i + 1 < new_capacity ? static_cast<uint32_t>(i + 1) : kNone;
+    }
+    free_ = static_cast<uint32_t>(capacity_);
+    nodes_ = std::move(nodes);
+    capacity_ = new_capacity;
+
+    // Keep the table at most half full.
+    size_type bucket_count = 1;
+    while (bucket_count < new_capacity * 2)
+      bucket_count *= 2;
+    buckets_.reset(new uint32_t[bucket_count]);
+    bucket_mask_ = bucket_count - 1;
+    for (size_type i = 0; i < bucket_count; ++i)
+      buckets_[i] = kNone;
+    for (uint32_t index = head_; index != kNone; index = nodes_[index].next)
+      InsertIntoBuckets(index);
+  }
+
+  std::unique_ptr<Node[]> nodes_;
+  std::unique_ptr<uint32_t[]> buckets_;
+  size_type capacity_;
+  size_t bucket_mask_;
+  size_type size_;
+
+  // The most and least recently used entries, and the first free node.
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t free_;
+
+  size_type max_size_;
+  HashType hasher_;
+
+  DISALLOW_COPY_AND_ASSIGN(FlatMRUCache);
+};
+
+template <class KeyType, class PayloadType, class HashType>
+const uint32_t FlatMRUCache<KeyType, PayloadType, HashType>::kNone;
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_MRU_CACHE_H_
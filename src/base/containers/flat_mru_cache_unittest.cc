@@ -0,0 +1,201 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_mru_cache.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+int live_payloads = 0;
+
+struct Payload {
+  explicit Payload(int value) : value(value) { live_payloads++; }
+  Payload(const Payload& other) : value(other.value) { live_payloads++; }
+  ~Payload() { live_payloads--; }
+
+  int value;
+};
+
+// Sends every key to the same bucket, so that all entries share one probe run.
+struct CollidingHash {
+  size_t operator()(int key) const { return 7; }
+};
+
+template <class Cache>
+std::vector<int> Keys(const Cache& cache) {
+  std::vector<int> keys;
+  for (const auto& entry : cache)
+    keys.push_back(entry.first);
+  return keys;
+}
+
+}  // namespace
+
+TEST(FlatMRUCacheTest, Basic) {
+  typedef FlatMRUCache<int, Payload> Cache;
+  Cache cache(Cache::NO_AUTO_EVICT);
+  EXPECT_TRUE(cache.empty());
+  EXPECT_TRUE(cache.Get(1) == cache.end());
+  EXPECT_TRUE(cache.Peek(1) == cache.end());
+
+  Cache::iterator inserted = cache.Put(1, Payload(10));
+  EXPECT_EQ(1, inserted->first);
+  EXPECT_EQ(10, inserted->second.value);
+  cache.Put(2, Payload(20));
+  cache.Put(3, Payload(30));
+  EXPECT_EQ(3u, cache.size());
+  EXPECT_EQ(std::vector<int>({3, 2, 1}), Keys(cache));
+
+  // Peek doesn't change the order, Get moves the entry to the front.
+  EXPECT_EQ(10, cache.Peek(1)->second.value);
+  EXPECT_EQ(std::vector<int>({3, 2, 1}), Keys(cache));
+  EXPECT_EQ(10, cache.Get(1)->second.value);
+  EXPECT_EQ(std::vector<int>({1, 3, 2}), Keys(cache));
+
+  // Replacing an entry moves it to the front.
+  cache.Put(2, Payload(21));
+  EXPECT_EQ(3u, cache.size());
+  EXPECT_EQ(std::vector<int>({2, 1, 3}), Keys(cache));
+  EXPECT_EQ(21, cache.Peek(2)->second.value);
+  EXPECT_EQ(3, live_payloads);
+
+  // Reverse iteration starts with the least recently used entry.
+  Cache::reverse_iterator oldest = cache.rbegin();
+  EXPECT_EQ(3, oldest->first);
+  oldest = cache.Erase(oldest);
+  EXPECT_EQ(1, oldest->first);
+  EXPECT_EQ(std::vector<int>({2, 1}), Keys(cache));
+
+  Cache::iterator it = cache.Erase(cache.begin());
+  EXPECT_EQ(1, it->first);
+  EXPECT_EQ(1u, cache.size());
+
+  cache.Clear();
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(0, live_payloads);
+}
+
+TEST(FlatMRUCacheTest, AutoEvict) {
+  typedef FlatMRUCache<int, std::unique_ptr<Payload>> Cache;
+  {
+    Cache cache(3);
+    for (int i = 0; i < 10; ++i)
+      cache.Put(i, WrapUnique(new Payload(i)));
+    EXPECT_EQ(3u, cache.size());
+    EXPECT_EQ(3, live_payloads);
+    EXPECT_EQ(std::vector<int>({9, 8, 7}), Keys(cache));
+    EXPECT_TRUE(cache.Peek(6) == cache.end());
+
+    cache.ShrinkToSize(1);
+    EXPECT_EQ(std::vector<int>({9}), Keys(cache));
+    EXPECT_EQ(1, live_payloads);
+  }
+  EXPECT_EQ(0, live_payloads);
+}
+
+// Iterators refer to entries by index, so they stay valid while the cache
+// grows.
+TEST(FlatMRUCacheTest, IteratorsSurviveGrowth) {
+  typedef FlatMRUCache<std::string, int> Cache;
+  Cache cache(Cache::NO_AUTO_EVICT);
+  Cache::iterator first = cache.Put("first", 1);
+  for (int i = 0; i < 100; ++i)
+    cache.Put(IntToString(i), i);
+  EXPECT_EQ("first", first->first);
+  EXPECT_EQ(1, first->second);
+  EXPECT_EQ(101u, cache.size());
+  EXPECT_EQ(99, cache.Peek("99")->second);
+  EXPECT_EQ("first", cache.rbegin()->first);
+}
+
+TEST(FlatMRUCacheTest, Collisions) {
+  typedef FlatMRUCache<int, int, CollidingHash> Cache;
+  Cache cache(Cache::NO_AUTO_EVICT);
+  for (int i = 0; i < 20; ++i)
+    cache.Put(i, i);
+
+  // Erasing from the middle of the probe run must keep the rest reachable.
+  for (int i = 0; i < 20; i += 3)
+    cache.Erase(cache.Peek(i));
+  for (int i = 0; i < 20; ++i) {
+    Cache::const_iterator it = cache.Peek(i);
+    if (i % 3 == 0) {
+      EXPECT_TRUE(it == cache.end()) << i;
+    } else {
+      ASSERT_TRUE(it != cache.end()) << i;
+      EXPECT_EQ(i, it->second);
+    }
+  }
+}
+
+TEST(FlatMRUCacheTest, MatchesHashingMRUCache) {
+  const size_t kMaxSize = 37;
+  FlatMRUCache<int, int> flat(kMaxSize);
+  HashingMRUCache<int, int> reference(kMaxSize);
+
+  // A fixed pseudo-random mix of inserts, lookups and erases.
+  uint32_t state = 12345;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1103515245 + 12345;
+    int key = (state >> 16) % 100;
+    switch ((state >> 8) % 4) {
+      case 0:
+      case 1:
+        flat.Put(key, i);
+        reference.Put(key, i);
+        break;
+      case 2: {
+        bool flat_found = flat.Get(key) != flat.end();
+        bool reference_found = reference.Get(key) != reference.end();
+        ASSERT_EQ(reference_found, flat_found);
+        break;
+      }
+      case 3: {
+        auto flat_it = flat.Peek(key);
+        auto reference_it = reference.Peek(key);
+        ASSERT_EQ(reference_it == reference.end(), flat_it == flat.end());
+        if (flat_it != flat.end()) {
+          flat.Erase(flat_it);
+          reference.Erase(reference_it);
+        }
+        break;
+      }
+    }
+    ASSERT_EQ(reference.size(), flat.size());
+  }
+
+  std::vector<std::pair<int, int>> flat_entries(flat.begin(), flat.end());
+  std::vector<std::pair<int, int>> reference_entries(reference.begin(),
+                                                     reference.end());
+  EXPECT_EQ(reference_entries, flat_entries);
+}
+
+TEST(FlatMRUCacheTest, Swap) {
+  typedef FlatMRUCache<int, int> Cache;
+  Cache cache1(Cache::NO_AUTO_EVICT);
+  Cache cache2(2);
+  cache1.Put(1, 1);
+  cache2.Put(2, 2);
+  cache2.Put(3, 3);
+
+  cache1.Swap(cache2);
+  EXPECT_EQ(std::vector<int>({3, 2}), Keys(cache1));
+  EXPECT_EQ(std::vector<int>({1}), Keys(cache2));
+  EXPECT_EQ(2u, cache1.max_size());
+  EXPECT_EQ(static_cast<size_t>(Cache::NO_AUTO_EVICT), cache2.max_size());
+}
+
+}  // namespace base
@@ -0,0 +1,79 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_mru_cache.h"
+#include "base/containers/mru_cache.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const size_t kCacheSize = 256;
+const int kNumOperations = 2000000;
+
+// Looks up keys drawn from a range twice the size of the cache, inserting the
+// misses, which is the pattern of the font and session caches using MRUCache.
+template <class Cache, class Key>
+void RunGetOrPut(const std::string& trace,
+                 const std::vector<Key>& keys) {
+  Cache cache(kCacheSize);
+  uint32_t state = 1;
+  int hits = 0;
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kNumOperations; ++i) {
+    state = state * 1103515245 + 12345;
+    const Key& key = keys[(state >> 16) % keys.size()];
+    if (cache.Get(key) != cache.end())
+      hits++;
+    else
+      cache.Put(key, i);
+  }
+  TimeDelta elapsed = TimeTicks::Now() - start;
+  EXPECT_GT(hits, 0);
+  perf_test::PrintResult("get_or_put", "", trace,
+                         kNumOperations / elapsed.InSecondsF(), "ops/s",
+                         true);
+}
+
+std::vector<uint32_t> CreateIntKeys() {
+  std::vector<uint32_t> keys;
+  for (size_t i = 0; i < 2 * kCacheSize; ++i)
+    keys.push_back(static_cast<uint32_t>(i * 2654435761u));
+  return keys;
+}
+
+std::vector<std::string> CreateStringKeys() {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 2 * kCacheSize; ++i)
+    keys.push_back(StringPrintf("www.example%d.com:443", static_cast<int>(i)));
+  return keys;
+}
+
+}  // namespace
+
+TEST(MRUCachePerfTest, IntKeys) {
+  std::vector<uint32_t> keys = CreateIntKeys();
+  RunGetOrPut<HashingMRUCache<uint32_t, int>>("hashing_mru_cache", keys);
+  RunGetOrPut<MRUCache<uint32_t, int>>("mru_cache", keys);
+  RunGetOrPut<FlatMRUCache<uint32_t, int>>("flat_mru_cache", keys);
+}
+
+TEST(MRUCachePerfTest, StringKeys) {
+  std::vector<std::string> keys = CreateStringKeys();
+  RunGetOrPut<HashingMRUCache<std::string, int>>("hashing_mru_cache", keys);
+  RunGetOrPut<MRUCache<std::string, int>>("mru_cache", keys);
+  RunGetOrPut<FlatMRUCache<std::string, int>>("flat_mru_cache", keys);
+}
+
+}  // namespace base
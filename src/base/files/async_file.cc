@@ -0,0 +1,180 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/async_file.h"
+
+#include <string.h>
+
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/location.h"
+#include "base/task_runner.h"
+
+namespace base {
+
+// Owns the file while operations are outstanding. Every operation holds a
+// reference until its work is done, and the AsyncFile hands its own reference
+// to the TaskRunner on destruction, so the file is closed on the TaskRunner.
+class AsyncFile::Core : public RefCountedThreadSafe<Core> {
+ public:
+  explicit Core(File file) : file_(std::move(file)) {}
+
+  File* file() { return &file_; }
+
+ private:
+  friend class RefCountedThreadSafe<Core>;
+
+  ~Core() {}
+
+  File file_;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+namespace {
+
+void ReleaseCore(scoped_refptr<AsyncFile::Core> core) {}
+
+class ReadHelper {
+ public:
+  ReadHelper(scoped_refptr<AsyncFile::Core> core, int bytes_to_read)
+      : core_(std::move(core)),
+        buffer_(new char[bytes_to_read]),
+        bytes_to_read_(bytes_to_read),
+        bytes_read_(0),
+        error_(File::FILE_ERROR_FAILED) {}
+
+  void RunWork(int64_t offset) {
+    bytes_read_ = core_->file()->Read(offset, buffer_.get(), bytes_to_read_);
+    error_ = bytes_read_ < 0 ? File::FILE_ERROR_FAILED : File::FILE_OK;
+    core_ = nullptr;
+  }
+
+  void Reply(const AsyncFile::ReadCallback& callback) {
+    callback.Run(error_, buffer_.get(), bytes_read_);
+  }
+
+ private:
+  scoped_refptr<AsyncFile::Core> core_;
+  std::unique_ptr<char[]> buffer_;
+  int bytes_to_read_;
+  int bytes_read_;
+  File::Error error_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadHelper);
+};
+
+class WriteHelper {
+ public:
+  WriteHelper(scoped_refptr<AsyncFile::Core> core,
+              const char* buffer,
+              int bytes_to_write)
+      : core_(std::move(core)),
+        buffer_(new char[bytes_to_write]),
+        bytes_to_write_(bytes_to_write),
+        bytes_written_(0),
+        error_(File::FILE_ERROR_FAILED) {
+    memcpy(buffer_.get(), buffer, bytes_to_write);
+  }
+
+  void RunWork(int64_t offset) {
+    bytes_written_ =
+        core_->file()->Write(offset, buffer_.get(), bytes_to_write_);
+    error_ = bytes_written_ < 0 ? File::FILE_ERROR_FAILED : File::FILE_OK;
+    core_ = nullptr;
+  }
+
+  void Reply(const AsyncFile::WriteCallback& callback) {
+    if (!callback.is_null())
+      callback.Run(error_, bytes_written_);
+  }
+
+ private:
+  scoped_refptr<AsyncFile::Core> core_;
+  std::unique_ptr<char[]> buffer_;
+  int bytes_to_write_;
+  int bytes_written_;
+  File::Error error_;
+
+  DISALLOW_COPY_AND_ASSIGN(WriteHelper);
+};
+
+class FlushHelper {
+ public:
+  explicit FlushHelper(scoped_refptr<AsyncFile::Core> core)
+      : core_(std::move(core)), error_(File::FILE_ERROR_FAILED) {}
+
+  void RunWork() {
+    if (core_->file()->Flush())
+      error_ = File::FILE_OK;
+    core_ = nullptr;
+  }
+
+  void Reply(const AsyncFile::StatusCallback& callback) {
+    if (!callback.is_null())
+      callback.Run(error_);
+  }
+
+ private:
+  scoped_refptr<AsyncFile::Core> core_;
+  File::Error error_;
+
+  DISALLOW_COPY_AND_ASSIGN(FlushHelper);
+};
+
+}  // namespace
+
+AsyncFile::AsyncFile(File file, const scoped_refptr<TaskRunner>& task_runner)
+    : core_(new Core(std::move(file))), task_runner_(task_runner) {
+  DCHECK(core_->file()->IsValid());
+}
+
+AsyncFile::~AsyncFile() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  task_runner_->PostTask(FROM_HERE, Bind(&ReleaseCore, Passed(&core_)));
+}
+
+bool AsyncFile::Read(int64_t offset,
+                     int bytes_to_read,
+                     const ReadCallback& callback) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK(!callback.is_null());
+  if (bytes_to_read < 0)
+    return false;
+
+  ReadHelper* helper = new ReadHelper(core_, bytes_to_read);
+  return task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      Bind(&ReadHelper::RunWork, Unretained(helper), offset),
+      Bind(&ReadHelper::Reply, Owned(helper), callback));
+}
+
+bool AsyncFile::Write(int64_t offset,
+                      const char* buffer,
+                      int bytes_to_write,
+                      const WriteCallback& callback) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  if (bytes_to_write <= 0 || buffer == NULL)
+    return false;
+
+  WriteHelper* helper = new WriteHelper(core_, buffer, bytes_to_write);
+  return task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      Bind(&WriteHelper::RunWork, Unretained(helper), offset),
+      Bind(&WriteHelper::Reply, Owned(helper), callback));
+}
+
+bool AsyncFile::Flush(const StatusCallback& callback) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  FlushHelper* helper = new FlushHelper(core_);
+  return task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      Bind(&FlushHelper::RunWork, Unretained(helper)),
+      Bind(&FlushHelper::Reply, Owned(helper), callback));
+}
+
+}  // namespace base
@@ -0,0 +1,83 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_ASYNC_FILE_H_
+#define BASE_FILES_ASYNC_FILE_H_
+
+#include <stdint.h>
+
+#include "base/base_export.h"
+#include "base/callback_forward.h"
+#include "base/files/file.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/threading/thread_checker.h"
+
+namespace base {
+
+class TaskRunner;
+
+// This class provides asynchronous reads and writes on an open File, running
+// them on a TaskRunner and replying on the thread that issued them.
+//
+// Unlike FileProxy, any number of operations may be outstanding at once. They
+// use positional I/O on a descriptor shared between them, so a TaskRunner
+// that runs tasks in parallel, such as a SequencedWorkerPool with a few
+// threads, services many of them concurrently. The TaskRunner bounds the
+// number of threads doing I/O no matter how many operations are issued.
+// Operations issued together are not ordered relative to one another unless
+// the TaskRunner is sequenced.
+//
+// Callbacks run even if the AsyncFile has been destroyed in the meantime; the
+// file is closed on the TaskRunner once the last operation finishes.
+class BASE_EXPORT AsyncFile {
+ public:
+  // This callback is used by methods that report only an error code. It is
+  // valid to pass a null StatusCallback, in which case the operation will
+  // complete silently.
+  typedef Callback<void(File::Error)> StatusCallback;
+
+  typedef Callback<void(File::Error,
+                        const char* data,
+                        int bytes_read)> ReadCallback;
+  typedef Callback<void(File::Error,
+                        int bytes_written)> WriteCallback;
+
+  // |file| must be valid.
+  AsyncFile(File file, const scoped_refptr<TaskRunner>& task_runner);
+  ~AsyncFile();
+
+  // Proxies File::Read. The callback can't be null.
+  // This returns false if |bytes_to_read| is less than zero, or
+  // if task posting to |task_runner| has failed.
+  bool Read(int64_t offset, int bytes_to_read, const ReadCallback& callback);
+
+  // Proxies File::Write. The callback can be null.
+  // This returns false if |bytes_to_write| is less than or equal to zero,
+  // if |buffer| is NULL, or if task posting to |task_runner| has failed.
+  bool Write(int64_t offset,
+             const char* buffer,
+             int bytes_to_write,
+             const WriteCallback& callback);
+
+  // Proxies File::Flush. The callback can be null.
+  // This returns false if task posting to |task_runner| has failed.
+  bool Flush(const StatusCallback& callback);
+
+  TaskRunner* task_runner() { return task_runner_.get(); }
+
+  // Holds the file for the outstanding operations. Defined in async_file.cc.
+  class Core;
+
+ private:
+  scoped_refptr<Core> core_;
+  scoped_refptr<TaskRunner> task_runner_;
+  ThreadChecker thread_checker_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncFile);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_ASYNC_FILE_H_
@@ -0,0 +1,162 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/async_file.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/macros.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/threading/sequenced_worker_pool.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const int kChunkSize = 4096;
+const int kNumChunks = 16;
+
+class AsyncFileTest : public testing::Test {
+ public:
+  AsyncFileTest()
+      : pool_(new SequencedWorkerPool(4, "AsyncFileTest")),
+        pending_(0),
+        bytes_written_(-1),
+        error_(File::FILE_OK) {}
+
+  void SetUp() override { ASSERT_TRUE(dir_.CreateUniqueTempDir()); }
+
+  void TearDown() override { pool_->Shutdown(); }
+
+  void DidRead(int chunk, File::Error error, const char* data, int bytes_read) {
+    EXPECT_EQ(File::FILE_OK, error);
+    chunks_[chunk].assign(data, bytes_read);
+    Done();
+  }
+
+  void DidWrite(File::Error error, int bytes_written) {
+    error_ = error;
+    bytes_written_ = bytes_written;
+    Done();
+  }
+
+  void DidFlush(File::Error error) {
+    error_ = error;
+    Done();
+  }
+
+ protected:
+  void Done() {
+    if (--pending_ == 0)
+      MessageLoop::current()->QuitWhenIdle();
+  }
+
+  // Writes a file made of |kNumChunks| chunks, each filled with its index.
+  std::string CreateTestFile() {
+    std::string contents;
+    for (int i = 0; i < kNumChunks; ++i)
+      contents.append(kChunkSize, static_cast<char>('a' + i));
+    EXPECT_EQ(static_cast<int>(contents.size()),
+              WriteFile(test_path(), contents.data(), contents.size()));
+    return contents;
+  }
+
+  FilePath test_path() const { return dir_.path().AppendASCII("test"); }
+
+  ScopedTempDir dir_;
+  MessageLoop message_loop_;
+  scoped_refptr<SequencedWorkerPool> pool_;
+
+  int pending_;
+  std::string chunks_[kNumChunks];
+  int bytes_written_;
+  File::Error error_;
+};
+
+}  // namespace
+
+TEST_F(AsyncFileTest, ConcurrentReads) {
+  std::string contents = CreateTestFile();
+
+  AsyncFile file(File(test_path(), File::FLAG_OPEN | File::FLAG_READ), pool_);
+  // Issue every read before any of them completes.
+  for (int i = kNumChunks - 1; i >= 0; --i) {
+    ASSERT_TRUE(file.Read(i * kChunkSize, kChunkSize,
+                          Bind(&AsyncFileTest::DidRead, Unretained(this), i)));
+    pending_++;
+  }
+  RunLoop().Run();
+
+  for (int i = 0; i < kNumChunks; ++i)
+    EXPECT_EQ(contents.substr(i * kChunkSize, kChunkSize), chunks_[i]) << i;
+}
+
+TEST_F(AsyncFileTest, ReadPastEnd) {
+  CreateTestFile();
+
+  AsyncFile file(File(test_path(), File::FLAG_OPEN | File::FLAG_READ), pool_);
+  ASSERT_TRUE(file.Read(kNumChunks * kChunkSize - 10, 100,
+                        Bind(&AsyncFileTest::DidRead, Unretained(this), 0)));
+  pending_++;
+  RunLoop().Run();
+  EXPECT_EQ(std::string(10, 'a' + kNumChunks - 1), chunks_[0]);
+
+  EXPECT_FALSE(file.Read(0, -1, Bind(&AsyncFileTest::DidRead,
+                                     Unretained(this), 0)));
+}
+
+TEST_F(AsyncFileTest, WriteAndFlush) {
+  AsyncFile file(
+      File(test_path(), File::FLAG_CREATE | File::FLAG_READ | File::FLAG_WRITE),
+      pool_);
+  const char kData[] = "0123456789";
+  ASSERT_TRUE(file.Write(0, kData, 10, Bind(&AsyncFileTest::DidWrite,
+                                            Unretained(this))));
+  pending_++;
+  RunLoop().Run();
+  EXPECT_EQ(File::FILE_OK, error_);
+  EXPECT_EQ(10, bytes_written_);
+
+  ASSERT_TRUE(file.Flush(Bind(&AsyncFileTest::DidFlush, Unretained(this))));
+  pending_++;
+  RunLoop().Run();
+  EXPECT_EQ(File::FILE_OK, error_);
+
+  std::string written;
+  ASSERT_TRUE(ReadFileToString(test_path(), &written));
+  EXPECT_EQ("0123456789", written);
+
+  EXPECT_FALSE(file.Write(0, kData, 0, AsyncFile::WriteCallback()));
+}
+
+// Operations still complete after the AsyncFile goes away.
+TEST_F(AsyncFileTest, DestroyWithPendingReads) {
+  std::string contents = CreateTestFile();
+
+  std::unique_ptr<AsyncFile> file(new AsyncFile(
+      File(test_path(), File::FLAG_OPEN | File::FLAG_READ), pool_));
+  for (int i = 0; i < kNumChunks; ++i) {
+    ASSERT_TRUE(file->Read(i * kChunkSize, kChunkSize,
+                           Bind(&AsyncFileTest::DidRead, Unretained(this), i)));
+    pending_++;
+  }
+  file.reset();
+  RunLoop().Run();
+
+  for (int i = 0; i < kNumChunks; ++i)
+    EXPECT_EQ(contents.substr(i * kChunkSize, kChunkSize), chunks_[i]) << i;
+}
+
+}  // namespace base
@@ -66,6 +66,24 @@ bool WriteScopedStringToFileAtomically(const FilePath& path,
   return ImportantFileWriter::WriteFileAtomically(path, *data);
 }
 
+// Runs |producer| and writes its output to |path|. Called on the backend
+// thread.
+bool ProduceAndWriteStringToFileAtomically(
+    const FilePath& path,
+    const ImportantFileWriter::BackgroundDataProducer& producer) {
+  std::string data;
+  if (!producer.Run(&data)) {
+    DLOG(WARNING) << "failed to serialize data to be saved in "
+                  << path.value();
+    return false;
+  }
+  if (!IsValueInRangeForNumericType<int32_t>(data.length())) {
+    NOTREACHED();
+    return false;
+  }
+  return ImportantFileWriter::WriteFileAtomically(path, data);
+}
+
 }  // namespace
 
 // static
@@ -144,6 +162,7 @@ ImportantFileWriter::ImportantFileWriter(
     : path_(path),
       task_runner_(std::move(task_runner)),
       serializer_(nullptr),
+      background_serializer_(nullptr),
       commit_interval_(interval),
       weak_factory_(this) {
   DCHECK(CalledOnValidThread());
@@ -188,6 +207,21 @@ void ImportantFileWriter::ScheduleWrite(DataSerializer* serializer) {
 
   DCHECK(serializer);
   serializer_ = serializer;
+  background_serializer_ = nullptr;
+
+  if (!timer_.IsRunning()) {
+    timer_.Start(FROM_HERE, commit_interval_, this,
+                 &ImportantFileWriter::DoScheduledWrite);
+  }
+}
+
+void ImportantFileWriter::ScheduleWriteWithBackgroundDataSerializer(
+    BackgroundDataSerializer* serializer) {
+  DCHECK(CalledOnValidThread());
+
+  DCHECK(serializer);
+  background_serializer_ = serializer;
+  serializer_ = nullptr;
 
   if (!timer_.IsRunning()) {
     timer_.Start(FROM_HERE, commit_interval_, this,
@@ -196,6 +230,20 @@ void ImportantFileWriter::ScheduleWrite(DataSerializer* serializer) {
 }
 
 void ImportantFileWriter::DoScheduledWrite() {
+  if (background_serializer_) {
+    if (HasPendingWrite())
+      timer_.Stop();
+    BackgroundDataProducer producer =
+        background_serializer_->GetSerializedDataProducerForBackgroundSequence();
+    background_serializer_ = nullptr;
+    auto task = Bind(&ProduceAndWriteStringToFileAtomically, path_, producer);
+    if (!PostWriteTask(task)) {
+      NOTREACHED();
+      task.Run();
+    }
+    return;
+  }
+
   DCHECK(serializer_);
   std::unique_ptr<std::string> data(new std::string);
   if (serializer_->SerializeData(data.get())) {
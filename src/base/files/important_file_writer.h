@@ -53,6 +53,25 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
     virtual ~DataSerializer() {}
   };
 
+  // Serializes a snapshot of the data into its argument and returns true on
+  // success. Run on the task runner passed to the constructor.
+  typedef Callback<bool(std::string* data)> BackgroundDataProducer;
+
+  // Like DataSerializer, but for data that is expensive to serialize: only a
+  // snapshot of the data is taken on the writer's thread, and the encoding is
+  // done along with the file I/O.
+  class BASE_EXPORT BackgroundDataSerializer {
+   public:
+    // Returns a producer for the data to be saved. Will be called on the same
+    // thread on which ImportantFileWriter has been created, so the producer
+    // must not refer to anything that can change once this returns.
+    virtual BackgroundDataProducer
+    GetSerializedDataProducerForBackgroundSequence() = 0;
+
+   protected:
+    virtual ~BackgroundDataSerializer() {}
+  };
+
   // Save |data| to |path| in an atomic manner (see the class comment above).
   // Blocks and writes data on the current thread.
   static bool WriteFileAtomically(const FilePath& path, StringPiece data);
@@ -92,6 +111,11 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
   // ImportantFileWriter.
   void ScheduleWrite(DataSerializer* serializer);
 
+  // Same as above, but the data produced by |serializer| is encoded on the
+  // backend thread.
+  void ScheduleWriteWithBackgroundDataSerializer(
+      BackgroundDataSerializer* serializer);
+
   // Serialize data pending to be saved and execute write on backend thread.
   void DoScheduledWrite();
 
@@ -124,8 +148,10 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
   // Timer used to schedule commit after ScheduleWrite.
   OneShotTimer timer_;
 
-  // Serializer which will provide the data to be saved.
+  // Serializer which will provide the data to be saved. At most one of
+  // |serializer_| and |background_serializer_| is set.
   DataSerializer* serializer_;
+  BackgroundDataSerializer* background_serializer_;
 
   // Time delta after which scheduled data will be written to disk.
   const TimeDelta commit_interval_;
@@ -46,6 +46,28 @@ class DataSerializer : public ImportantFileWriter::DataSerializer {
   const std::string data_;
 };
 
+bool ProduceData(const std::string& data, std::string* output) {
+  output->assign(data);
+  return true;
+}
+
+class BackgroundDataSerializer
+    : public ImportantFileWriter::BackgroundDataSerializer {
+ public:
+  explicit BackgroundDataSerializer(const std::string& data) : data_(data) {}
+
+  ImportantFileWriter::BackgroundDataProducer
+  GetSerializedDataProducerForBackgroundSequence() override {
+    return Bind(&ProduceData, data_);
+  }
+
+  // Changes the data returned by future producers.
+  void set_data(const std::string& data) { data_ = data; }
+
+ private:
+  std::string data_;
+};
+
 class SuccessfulWriteObserver {
  public:
   SuccessfulWriteObserver() : successful_write_observed_(false) {}
@@ -195,4 +217,34 @@ TEST_F(ImportantFileWriterTest, BatchingWrites) {
   EXPECT_EQ("baz", GetFileContent(writer.path()));
 }
 
+TEST_F(ImportantFileWriterTest, ScheduleWriteWithBackgroundDataSerializer) {
+  ImportantFileWriter writer(file_, ThreadTaskRunnerHandle::Get());
+  SuccessfulWriteObserver successful_write_observer;
+  successful_write_observer.ObserveNextSuccessfulWrite(&writer);
+  BackgroundDataSerializer serializer("foo");
+  writer.ScheduleWriteWithBackgroundDataSerializer(&serializer);
+  EXPECT_TRUE(writer.HasPendingWrite());
+  writer.DoScheduledWrite();
+  EXPECT_FALSE(writer.HasPendingWrite());
+
+  // The data was snapshotted when the write was started.
+  serializer.set_data("bar");
+  RunLoop().RunUntilIdle();
+  EXPECT_TRUE(successful_write_observer.GetAndResetObservationState());
+  ASSERT_TRUE(PathExists(writer.path()));
+  EXPECT_EQ("foo", GetFileContent(writer.path()));
+}
+
+TEST_F(ImportantFileWriterTest, BatchingMixedSerializers) {
+  ImportantFileWriter writer(file_, ThreadTaskRunnerHandle::Get());
+  DataSerializer foo("foo");
+  BackgroundDataSerializer bar("bar");
+  writer.ScheduleWrite(&foo);
+  writer.ScheduleWriteWithBackgroundDataSerializer(&bar);
+  writer.DoScheduledWrite();
+  RunLoop().RunUntilIdle();
+  ASSERT_TRUE(PathExists(writer.path()));
+  EXPECT_EQ("bar", GetFileContent(writer.path()));
+}
+
 }  // namespace base
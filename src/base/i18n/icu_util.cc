@@ -8,6 +8,12 @@
 #include <windows.h>
 #endif
 
+#if defined(OS_POSIX)
+#include <sys/mman.h>
+#endif
+
+#include <string.h>
+
 #include <string>
 
 #include "base/debug/alias.h"
@@ -15,6 +21,7 @@
 #include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
 #include "base/path_service.h"
+#include "base/process/process_metrics.h"
 #include "base/strings/string_util.h"
 #include "base/strings/sys_string_conversions.h"
 #include "build/build_config.h"
@@ -193,6 +200,36 @@ bool InitializeICUWithFileDescriptorInternal(
   }
   return err == U_ZERO_ERROR;
 }
+
+#if defined(OS_POSIX)
+// Items of the ICU data file that are read when text is first laid out: the
+// break rules used for line and word breaking, character properties, the
+// converter alias table and the root locale. Keep this in sync with what a
+// fresh renderer touches when the ICU data configuration changes.
+const char* const kHotIcuDataItems[] = {
+    "brkitr/char.brk", "brkitr/line.brk", "brkitr/word.brk", "cnvalias.icu",
+    "res_index.res",   "root.res",        "uprops.icu",
+};
+
+// The table of contents of an ICU common data file, which follows the data
+// header. Offsets are relative to the start of the table.
+struct IcuDataTocEntry {
+  uint32_t name_offset;
+  uint32_t data_offset;
+};
+
+bool IsHotIcuDataItem(const char* name) {
+  // Item names are prefixed with the package name, e.g. "icudt56l/".
+  const char* slash = strchr(name, '/');
+  if (!slash)
+    return false;
+  for (const char* item : kHotIcuDataItems) {
+    if (strcmp(slash + 1, item) == 0)
+      return true;
+  }
+  return false;
+}
+#endif  // defined(OS_POSIX)
 #endif  // ICU_UTIL_DATA_IMPL == ICU_UTIL_DATA_FILE
 #endif  // !defined(OS_NACL)
 
@@ -238,6 +275,53 @@ bool InitializeICUFromRawMemory(const uint8_t* raw_memory) {
 #endif
 }
 
+#if defined(OS_POSIX)
+bool PrefetchHotIcuData() {
+  if (!g_icudtl_mapped_file)
+    return false;
+
+  const uint8_t* data = g_icudtl_mapped_file->data();
+  const size_t length = g_icudtl_mapped_file->length();
+  // The data header starts with its own size followed by the magic bytes
+  // 0xda 0x27.
+  if (length < 4 || data[2] != 0xda || data[3] != 0x27)
+    return false;
+  const size_t toc_offset = *reinterpret_cast<const uint16_t*>(data);
+  if (toc_offset + sizeof(uint32_t) > length)
+    return false;
+  const uint8_t* toc = data + toc_offset;
+  const size_t toc_length = length - toc_offset;
+  const uint32_t count = *reinterpret_cast<const uint32_t*>(toc);
+  if (count > (toc_length - sizeof(uint32_t)) / sizeof(IcuDataTocEntry))
+    return false;
+  const IcuDataTocEntry* entries =
+      reinterpret_cast<const IcuDataTocEntry*>(toc + sizeof(uint32_t));
+
+  const uintptr_t page_mask = ~static_cast<uintptr_t>(GetPageSize() - 1);
+  for (uint32_t i = 0; i < count; ++i) {
+    if (entries[i].name_offset >= toc_length ||
+        !memchr(toc + entries[i].name_offset, '\0',
+                toc_length - entries[i].name_offset) ||
+        !IsHotIcuDataItem(
+            reinterpret_cast<const char*>(toc + entries[i].name_offset))) {
+      continue;
+    }
+    // Items are stored in table order, so each one ends where the next
+    // begins.
+    const size_t begin = entries[i].data_offset;
+    const size_t end =
+        i + 1 < count ? entries[i + 1].data_offset : toc_length;
+    if (begin >= end || end > toc_length)
+      continue;
+    uintptr_t start = reinterpret_cast<uintptr_t>(toc + begin) & page_mask;
+    uintptr_t stop = reinterpret_cast<uintptr_t>(toc + end);
+    // This is only a hint, so failures are ignored.
+    madvise(reinterpret_cast<void*>(start), stop - start, MADV_WILLNEED);
+  }
+  return true;
+}
+#endif  // defined(OS_POSIX)
+
 #endif  // ICU_UTIL_DATA_IMPL == ICU_UTIL_DATA_FILE
 
 bool InitializeICU() {
@@ -55,6 +55,16 @@ BASE_I18N_EXPORT const uint8_t* GetRawIcuMemory();
 // linked in but in non-component builds, these will be separate copies of
 // base.)
 BASE_I18N_EXPORT bool InitializeICUFromRawMemory(const uint8_t* raw_memory);
+
+#if defined(OS_POSIX)
+// Asks the kernel to start reading in the parts of the ICU data file that are
+// needed for the first text layout (break rules, character properties and the
+// root locale), so that ICU does not take those page faults on the main thread
+// later. The pages land in the page cache, so processes forked afterwards
+// (e.g. by the zygote) find them warm as well. Must be called after
+// InitializeICU(). Returns false if no data file is mapped.
+BASE_I18N_EXPORT bool PrefetchHotIcuData();
+#endif
 #endif  // ICU_UTIL_DATA_IMPL == ICU_UTIL_DATA_FILE
 #endif  // !defined(OS_NACL)
 
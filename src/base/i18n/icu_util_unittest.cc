@@ -0,0 +1,27 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/i18n/icu_util.h"
+
+#include "build/build_config.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/icu/source/common/unicode/uchar.h"
+
+namespace base {
+namespace i18n {
+
+#if ICU_UTIL_DATA_IMPL == ICU_UTIL_DATA_FILE && defined(OS_POSIX) && \
+    !defined(OS_NACL)
+// The test suite has already mapped icudtl.dat.
+TEST(IcuUtilTest, PrefetchHotIcuData) {
+  EXPECT_TRUE(PrefetchHotIcuData());
+
+  // ICU keeps working off the same mapping.
+  EXPECT_TRUE(u_isalpha('a'));
+  EXPECT_EQ(U_RIGHT_TO_LEFT, u_charDirection(0x05d0));
+}
+#endif
+
+}  // namespace i18n
+}  // namespace base
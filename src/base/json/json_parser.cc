@@ -4,6 +4,8 @@
 
 #include "base/json/json_parser.h"
 
+#include <string.h>
+
 #include <cmath>
 #include <utility>
 
@@ -12,6 +14,7 @@
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversion_utils.h"
@@ -188,8 +191,58 @@ class StackMarker {
   DISALLOW_COPY_AND_ASSIGN(StackMarker);
 };
 
+// Returns the number of bytes at the start of [begin, end) that a string
+// builder can take verbatim: ASCII characters other than '"' and '\\'. Most
+// string contents are such runs, so they are checked a word at a time.
+size_t CountVerbatimChars(const char* begin, const char* end) {
+  typedef uintptr_t MachineWord;
+  const MachineWord kOnes = ~static_cast<MachineWord>(0) / 0xFF;
+  const MachineWord kHighBits = kOnes * 0x80;
+  const MachineWord kQuotes = kOnes * '"';
+  const MachineWord kBackslashes = kOnes * '\\';
+
+  const char* pos = begin;
+  while (end - pos >= static_cast<ptrdiff_t>(sizeof(MachineWord))) {
+    MachineWord word;
+    memcpy(&word, pos, sizeof(word));
+    // A byte of |quotes| or |backslashes| is zero where |word| has the
+    // character; (x - kOnes) & ~x sets the high bit of some byte iff x has a
+    // zero byte.
+    MachineWord quotes = word ^ kQuotes;
+    MachineWord backslashes = word ^ kBackslashes;
+    if ((word | ((quotes - kOnes) & ~quotes) |
+         ((backslashes - kOnes) & ~backslashes)) & kHighBits) {
+      break;
+    }
+    pos += sizeof(MachineWord);
+  }
+  while (pos < end && static_cast<unsigned char>(*pos) < kExtendedASCIIStart &&
+         *pos != '"' && *pos != '\\') {
+    ++pos;
+  }
+  return pos - begin;
+}
+
+// Converts |num_string| to an int in |num_int| if it fits in one, setting
+// |is_int|, or else to a finite double in |num_double|. Returns false if
+// neither is possible.
+bool StringToNumber(StringPiece num_string,
+                    bool* is_int,
+                    int* num_int,
+                    double* num_double) {
+  *is_int = StringToInt(num_string, num_int);
+  if (*is_int)
+    return true;
+  return StringToDouble(num_string.as_string(), num_double) &&
+         std::isfinite(*num_double);
+}
+
 }  // namespace
 
+JSONParser::PathNode::PathNode() : selected(false) {}
+
+JSONParser::PathNode::~PathNode() {}
+
 JSONParser::JSONParser(int options)
     : options_(options),
       start_pos_(NULL),
@@ -199,6 +252,7 @@ JSONParser::JSONParser(int options)
       stack_depth_(0),
       line_number_(0),
       index_last_line_(0),
+      filter_(NULL),
       error_code_(JSONReader::JSON_NO_ERROR),
       error_line_(0),
       error_column_(0) {
@@ -214,42 +268,17 @@ std::unique_ptr<Value> JSONParser::Parse(StringPiece input) {
   // be used anywhere.
   if (!(options_ & JSON_DETACHABLE_CHILDREN)) {
     input_copy = WrapUnique(new std::string(input.as_string()));
-    start_pos_ = input_copy->data();
-  } else {
-    start_pos_ = input.data();
-  }
-  pos_ = start_pos_;
-  end_pos_ = start_pos_ + input.length();
-  index_ = 0;
-  line_number_ = 1;
-  index_last_line_ = 0;
-
-  error_code_ = JSONReader::JSON_NO_ERROR;
-  error_line_ = 0;
-  error_column_ = 0;
-
-  // When the input JSON string starts with a UTF-8 Byte-Order-Mark
-  // <0xEF 0xBB 0xBF>, advance the start position to avoid the
-  // ParseNextToken function mis-treating a Unicode BOM as an invalid
-  // character and returning NULL.
-  if (CanConsume(3) && static_cast<uint8_t>(*pos_) == 0xEF &&
-      static_cast<uint8_t>(*(pos_ + 1)) == 0xBB &&
-      static_cast<uint8_t>(*(pos_ + 2)) == 0xBF) {
-    NextNChars(3);
+    input = *input_copy;
   }
+  StartParsing(input);
 
   // Parse the first and any nested tokens.
   std::unique_ptr<Value> root(ParseNextToken());
   if (!root)
     return nullptr;
 
-  // Make sure the input stream is at an end.
-  if (GetNextToken() != T_END_OF_INPUT) {
-    if (!CanConsume(1) || (NextChar() && GetNextToken() != T_END_OF_INPUT)) {
-      ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
-      return nullptr;
-    }
-  }
+  if (!ConsumeEndOfInput())
+    return nullptr;
 
   // Dictionaries and lists can contain JSONStringValues, so wrap them in a
   // hidden root.
@@ -272,6 +301,35 @@ std::unique_ptr<Value> JSONParser::Parse(StringPiece input) {
   return root;
 }
 
+bool JSONParser::ParseWithHandler(StringPiece input,
+                                  JSONReader::Handler* handler) {
+  DCHECK(handler);
+  StartParsing(input);
+  return WalkToken(GetNextToken(), handler) && ConsumeEndOfInput();
+}
+
+std::unique_ptr<DictionaryValue> JSONParser::ParseSubtrees(
+    StringPiece input,
+    const std::vector<StringPiece>& paths) {
+  PathNode root_filter;
+  for (const StringPiece& path : paths) {
+    PathNode* node = &root_filter;
+    for (const StringPiece& key :
+         SplitStringPiece(path, ".", KEEP_WHITESPACE, SPLIT_WANT_ALL)) {
+      std::unique_ptr<PathNode>& child = node->children[key.as_string()];
+      if (!child)
+        child.reset(new PathNode);
+      node = child.get();
+    }
+    node->selected = true;
+  }
+
+  filter_ = &root_filter;
+  std::unique_ptr<Value> root = Parse(input);
+  filter_ = NULL;
+  return DictionaryValue::From(std::move(root));
+}
+
 JSONReader::JsonParseError JSONParser::error_code() const {
   return error_code_;
 }
@@ -323,6 +381,15 @@ void JSONParser::StringBuilder::Append(const char& c) {
     ++length_;
 }
 
+void JSONParser::StringBuilder::AppendRun(const char* chars, size_t length) {
+  if (string_) {
+    string_->append(chars, length);
+  } else {
+    DCHECK_EQ(pos_ + length_, chars);
+    length_ += length;
+  }
+}
+
 void JSONParser::StringBuilder::AppendString(const std::string& str) {
   DCHECK(string_);
   string_->append(str);
@@ -352,6 +419,40 @@ const std::string& JSONParser::StringBuilder::AsString() {
 
 // JSONParser private //////////////////////////////////////////////////////////
 
+void JSONParser::StartParsing(StringPiece input) {
+  start_pos_ = input.data();
+  pos_ = start_pos_;
+  end_pos_ = start_pos_ + input.length();
+  index_ = 0;
+  line_number_ = 1;
+  index_last_line_ = 0;
+
+  error_code_ = JSONReader::JSON_NO_ERROR;
+  error_line_ = 0;
+  error_column_ = 0;
+
+  // When the input JSON string starts with a UTF-8 Byte-Order-Mark
+  // <0xEF 0xBB 0xBF>, advance the start position to avoid the
+  // ParseNextToken function mis-treating a Unicode BOM as an invalid
+  // character and returning NULL.
+  if (CanConsume(3) && static_cast<uint8_t>(*pos_) == 0xEF &&
+      static_cast<uint8_t>(*(pos_ + 1)) == 0xBB &&
+      static_cast<uint8_t>(*(pos_ + 2)) == 0xBF) {
+    NextNChars(3);
+  }
+}
+
+bool JSONParser::ConsumeEndOfInput() {
+  // Make sure the input stream is at an end.
+  if (GetNextToken() != T_END_OF_INPUT) {
+    if (!CanConsume(1) || (NextChar() && GetNextToken() != T_END_OF_INPUT)) {
+      ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
+      return false;
+    }
+  }
+  return true;
+}
+
 inline bool JSONParser::CanConsume(int length) {
   return pos_ + length <= end_pos_;
 }
@@ -507,6 +608,9 @@ Value* JSONParser::ConsumeDictionary() {
 
   std::unique_ptr<DictionaryValue> dict(new DictionaryValue);
 
+  const PathNode* filter = filter_;
+  filter_ = NULL;
+
   NextChar();
   Token token = GetNextToken();
   while (token != T_OBJECT_END) {
@@ -529,15 +633,35 @@ Value* JSONParser::ConsumeDictionary() {
       return NULL;
     }
 
-    // The next token is the value. Ownership transfers to |dict|.
+    // The next token is the value.
     NextChar();
-    Value* value = ParseNextToken();
-    if (!value) {
-      // ReportError from deeper level.
-      return NULL;
+    token = GetNextToken();
+
+    const PathNode* child = NULL;
+    if (filter) {
+      auto it = filter->children.find(key.AsString());
+      if (it != filter->children.end())
+        child = it->second.get();
     }
 
-    dict->SetWithoutPathExpansion(key.AsString(), value);
+    if (filter && (!child ||
+                   (!child->selected && token != T_OBJECT_BEGIN))) {
+      // Not wanted; check it without building anything.
+      if (!WalkToken(token, NULL))
+        return NULL;
+    } else {
+      if (child && !child->selected)
+        filter_ = child;
+      // Ownership transfers to |dict|.
+      Value* value = ParseToken(token);
+      filter_ = NULL;
+      if (!value) {
+        // ReportError from deeper level.
+        return NULL;
+      }
+
+      dict->SetWithoutPathExpansion(key.AsString(), value);
+    }
 
     NextChar();
     token = GetNextToken();
@@ -571,6 +695,9 @@ Value* JSONParser::ConsumeList() {
 
   std::unique_ptr<ListValue> list(new ListValue);
 
+  // Paths only lead through dictionaries, so a list is always built whole.
+  filter_ = NULL;
+
   NextChar();
   Token token = GetNextToken();
   while (token != T_ARRAY_END) {
@@ -631,6 +758,16 @@ bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
   int32_t next_char = 0;
 
   while (CanConsume(1)) {
+    // Take any run of characters that need no decoding in one step. The last
+    // byte of input is left to the loop below, which reports the error if the
+    // string is unterminated.
+    size_t run_length =
+        CountVerbatimChars(start_pos_ + index_, end_pos_ - 1);
+    if (run_length) {
+      string.AppendRun(start_pos_ + index_, run_length);
+      index_ += run_length;
+    }
+
     pos_ = start_pos_ + index_;  // CBU8_NEXT is postcrement.
     CBU8_NEXT(start_pos_, index_, length, next_char);
     if (next_char < 0 || !IsValidCharacter(next_char)) {
@@ -828,6 +965,21 @@ void JSONParser::DecodeUTF8(const int32_t& point, StringBuilder* dest) {
 }
 
 Value* JSONParser::ConsumeNumber() {
+  StringPiece num_string;
+  if (!ConsumeNumberRaw(&num_string))
+    return NULL;
+
+  bool is_int;
+  int num_int;
+  double num_double;
+  if (!StringToNumber(num_string, &is_int, &num_int, &num_double))
+    return NULL;
+  if (is_int)
+    return new FundamentalValue(num_int);
+  return new FundamentalValue(num_double);
+}
+
+bool JSONParser::ConsumeNumberRaw(StringPiece* out) {
   const char* num_start = pos_;
   const int start_index = index_;
   int end_index = start_index;
@@ -837,7 +989,7 @@ Value* JSONParser::ConsumeNumber() {
 
   if (!ReadInt(false)) {
     ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-    return NULL;
+    return false;
   }
   end_index = index_;
 
@@ -845,12 +997,12 @@ Value* JSONParser::ConsumeNumber() {
   if (*pos_ == '.') {
     if (!CanConsume(1)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     NextChar();
     if (!ReadInt(true)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     end_index = index_;
   }
@@ -862,7 +1014,7 @@ Value* JSONParser::ConsumeNumber() {
       NextChar();
     if (!ReadInt(true)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     end_index = index_;
   }
@@ -882,25 +1034,14 @@ Value* JSONParser::ConsumeNumber() {
       break;
     default:
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
   }
 
   pos_ = exit_pos;
   index_ = exit_index;
 
-  StringPiece num_string(num_start, end_index - start_index);
-
-  int num_int;
-  if (StringToInt(num_string, &num_int))
-    return new FundamentalValue(num_int);
-
-  double num_double;
-  if (StringToDouble(num_string.as_string(), &num_double) &&
-      std::isfinite(num_double)) {
-    return new FundamentalValue(num_double);
-  }
-
-  return NULL;
+  *out = StringPiece(num_start, end_index - start_index);
+  return true;
 }
 
 bool JSONParser::ReadInt(bool allow_leading_zeros) {
@@ -923,6 +1064,15 @@ bool JSONParser::ReadInt(bool allow_leading_zeros) {
 }
 
 Value* JSONParser::ConsumeLiteral() {
+  Token literal;
+  if (!ConsumeLiteralRaw(&literal))
+    return NULL;
+  if (literal == T_NULL)
+    return Value::CreateNullValue().release();
+  return new FundamentalValue(literal == T_BOOL_TRUE);
+}
+
+bool JSONParser::ConsumeLiteralRaw(Token* out) {
   switch (*pos_) {
     case 't': {
       const char kTrueLiteral[] = "true";
@@ -930,10 +1080,11 @@ Value* JSONParser::ConsumeLiteral() {
       if (!CanConsume(kTrueLen - 1) ||
           !StringsAreEqual(pos_, kTrueLiteral, kTrueLen)) {
         ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-        return NULL;
+        return false;
       }
       NextNChars(kTrueLen - 1);
-      return new FundamentalValue(true);
+      *out = T_BOOL_TRUE;
+      return true;
     }
     case 'f': {
       const char kFalseLiteral[] = "false";
@@ -941,10 +1092,11 @@ Value* JSONParser::ConsumeLiteral() {
       if (!CanConsume(kFalseLen - 1) ||
           !StringsAreEqual(pos_, kFalseLiteral, kFalseLen)) {
         ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-        return NULL;
+        return false;
       }
       NextNChars(kFalseLen - 1);
-      return new FundamentalValue(false);
+      *out = T_BOOL_FALSE;
+      return true;
     }
     case 'n': {
       const char kNullLiteral[] = "null";
@@ -952,15 +1104,164 @@ Value* JSONParser::ConsumeLiteral() {
       if (!CanConsume(kNullLen - 1) ||
           !StringsAreEqual(pos_, kNullLiteral, kNullLen)) {
         ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-        return NULL;
+        return false;
       }
       NextNChars(kNullLen - 1);
-      return Value::CreateNullValue().release();
+      *out = T_NULL;
+      return true;
     }
     default:
       ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
-      return NULL;
+      return false;
+  }
+}
+
+bool JSONParser::WalkToken(Token token, JSONReader::Handler* handler) {
+  switch (token) {
+    case T_OBJECT_BEGIN:
+      return WalkDictionary(handler);
+    case T_ARRAY_BEGIN:
+      return WalkList(handler);
+    case T_STRING: {
+      StringBuilder string;
+      if (!ConsumeStringRaw(&string))
+        return false;
+      if (!handler)
+        return true;
+      return handler->OnString(string.CanBeStringPiece()
+                                   ? string.AsStringPiece()
+                                   : StringPiece(string.AsString()));
+    }
+    case T_NUMBER: {
+      StringPiece num_string;
+      if (!ConsumeNumberRaw(&num_string))
+        return false;
+      bool is_int;
+      int num_int;
+      double num_double;
+      if (!StringToNumber(num_string, &is_int, &num_int, &num_double))
+        return false;
+      if (!handler)
+        return true;
+      return is_int ? handler->OnInteger(num_int)
+                    : handler->OnDouble(num_double);
+    }
+    case T_BOOL_TRUE:
+    case T_BOOL_FALSE:
+    case T_NULL: {
+      Token literal;
+      if (!ConsumeLiteralRaw(&literal))
+        return false;
+      if (!handler)
+        return true;
+      return literal == T_NULL ? handler->OnNull()
+                               : handler->OnBoolean(literal == T_BOOL_TRUE);
+    }
+    default:
+      ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+      return false;
+  }
+}
+
+bool JSONParser::WalkDictionary(JSONReader::Handler* handler) {
+  if (*pos_ != '{') {
+    ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+    return false;
+  }
+
+  StackMarker depth_check(&stack_depth_);
+  if (depth_check.IsTooDeep()) {
+    ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 1);
+    return false;
+  }
+
+  if (handler && !handler->OnDictionaryBegin())
+    return false;
+
+  NextChar();
+  Token token = GetNextToken();
+  while (token != T_OBJECT_END) {
+    if (token != T_STRING) {
+      ReportError(JSONReader::JSON_UNQUOTED_DICTIONARY_KEY, 1);
+      return false;
+    }
+
+    StringBuilder key;
+    if (!ConsumeStringRaw(&key))
+      return false;
+    if (handler &&
+        !handler->OnDictionaryKey(key.CanBeStringPiece()
+                                      ? key.AsStringPiece()
+                                      : StringPiece(key.AsString()))) {
+      return false;
+    }
+
+    NextChar();
+    token = GetNextToken();
+    if (token != T_OBJECT_PAIR_SEPARATOR) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+
+    NextChar();
+    if (!WalkToken(GetNextToken(), handler))
+      return false;
+
+    NextChar();
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      NextChar();
+      token = GetNextToken();
+      if (token == T_OBJECT_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
+        ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
+      }
+    } else if (token != T_OBJECT_END) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 0);
+      return false;
+    }
   }
+
+  return !handler || handler->OnDictionaryEnd();
+}
+
+bool JSONParser::WalkList(JSONReader::Handler* handler) {
+  if (*pos_ != '[') {
+    ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+    return false;
+  }
+
+  StackMarker depth_check(&stack_depth_);
+  if (depth_check.IsTooDeep()) {
+    ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 1);
+    return false;
+  }
+
+  if (handler && !handler->OnListBegin())
+    return false;
+
+  NextChar();
+  Token token = GetNextToken();
+  while (token != T_ARRAY_END) {
+    if (!WalkToken(token, handler))
+      return false;
+
+    NextChar();
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      NextChar();
+      token = GetNextToken();
+      if (token == T_ARRAY_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
+        ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
+      }
+    } else if (token != T_ARRAY_END) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+  }
+
+  return !handler || handler->OnListEnd();
 }
 
 // static
@@ -8,8 +8,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/compiler_specific.h"
@@ -20,6 +22,7 @@
 
 namespace base {
 
+class DictionaryValue;
 class Value;
 
 namespace internal {
@@ -53,6 +56,18 @@ class BASE_EXPORT JSONParser {
   // result as a Value owned by the caller.
   std::unique_ptr<Value> Parse(StringPiece input);
 
+  // Parses the input string and reports its contents to |handler| instead of
+  // building Values. Returns false on a parse error, or if |handler| stopped
+  // parsing, in which case error_code() is JSON_NO_ERROR.
+  bool ParseWithHandler(StringPiece input, JSONReader::Handler* handler);
+
+  // Parses the input string like Parse(), but only builds the values at the
+  // dotted |paths| into the root dictionary and merely validates the rest.
+  // Returns NULL on a parse error or if the root is not a dictionary.
+  std::unique_ptr<DictionaryValue> ParseSubtrees(
+      StringPiece input,
+      const std::vector<StringPiece>& paths);
+
   // Returns the error code.
   JSONReader::JsonParseError error_code() const;
 
@@ -108,6 +123,10 @@ class BASE_EXPORT JSONParser {
     // AppendString below.
     void Append(const char& c);
 
+    // Appends the |length| ASCII characters at |chars|. Unless the builder has
+    // been converted, they must directly follow the characters added so far.
+    void AppendRun(const char* chars, size_t length);
+
     // Appends a string to the std::string. Must be Convert()ed to use.
     void AppendString(const std::string& str);
 
@@ -138,6 +157,25 @@ class BASE_EXPORT JSONParser {
     std::string* string_;
   };
 
+  // A node in the tree of dictionary keys built from the paths passed to
+  // ParseSubtrees(). The whole value at a |selected| node is built; below
+  // other nodes only the dictionary members named in |children| are.
+  struct PathNode {
+    PathNode();
+    ~PathNode();
+
+    bool selected;
+    std::map<std::string, std::unique_ptr<PathNode>> children;
+  };
+
+  // Resets the parser state to the start of |input|, skipping any UTF-8
+  // Byte-Order-Mark.
+  void StartParsing(StringPiece input);
+
+  // Checks that only whitespace and comments follow the root value, reporting
+  // an error otherwise.
+  bool ConsumeEndOfInput();
+
   // Quick check that the stream has capacity to consume |length| more bytes.
   bool CanConsume(int length);
 
@@ -168,7 +206,8 @@ class BASE_EXPORT JSONParser {
   Value* ParseToken(Token token);
 
   // Assuming that the parser is currently wound to '{', this parses a JSON
-  // object into a DictionaryValue.
+  // object into a DictionaryValue. If |filter_| is set, it is cleared and only
+  // the members it selects are added.
   Value* ConsumeDictionary();
 
   // Assuming that the parser is wound to '[', this parses a JSON list into a
@@ -197,6 +236,9 @@ class BASE_EXPORT JSONParser {
   // Assuming that the parser is wound to the start of a valid JSON number,
   // this parses and converts it to either an int or double value.
   Value* ConsumeNumber();
+  // Parses a number like ConsumeNumber() and places its text in |out|.
+  // Returns false on failure with error information set.
+  bool ConsumeNumberRaw(StringPiece* out);
   // Helper that reads characters that are ints. Returns true if a number was
   // read and false on error.
   bool ReadInt(bool allow_leading_zeros);
@@ -204,6 +246,18 @@ class BASE_EXPORT JSONParser {
   // Consumes the literal values of |true|, |false|, and |null|, assuming the
   // parser is wound to the first character of any of those.
   Value* ConsumeLiteral();
+  // Parses a literal like ConsumeLiteral() and places its token in |out|.
+  // Returns false on failure with error information set.
+  bool ConsumeLiteralRaw(Token* out);
+
+  // The counterparts of ParseToken(), ConsumeDictionary() and ConsumeList()
+  // for ParseWithHandler(): they accept the same input, but report each value
+  // to |handler| instead of building it. With a NULL |handler| the value is
+  // only validated and skipped over. Return false on failure, with error
+  // information set unless the handler stopped parsing.
+  bool WalkToken(Token token, JSONReader::Handler* handler);
+  bool WalkDictionary(JSONReader::Handler* handler);
+  bool WalkList(JSONReader::Handler* handler);
 
   // Compares two string buffers of a given length.
   static bool StringsAreEqual(const char* left, const char* right, size_t len);
@@ -243,6 +297,10 @@ class BASE_EXPORT JSONParser {
   // The last value of |index_| on the previous line.
   int index_last_line_;
 
+  // The paths selected for the next dictionary to be consumed, during
+  // ParseSubtrees(). Not owned.
+  const PathNode* filter_;
+
   // Error information.
   JSONReader::JsonParseError error_code_;
   int error_line_;
@@ -54,6 +54,14 @@ std::unique_ptr<Value> JSONReader::Read(StringPiece json, int options) {
   return parser.Parse(json);
 }
 
+// static
+std::unique_ptr<DictionaryValue> JSONReader::ReadSubtrees(
+    StringPiece json,
+    int options,
+    const std::vector<StringPiece>& paths) {
+  internal::JSONParser parser(options);
+  return parser.ParseSubtrees(json, paths);
+}
 
 // static
 std::unique_ptr<Value> JSONReader::ReadAndReturnError(
@@ -110,6 +118,10 @@ std::unique_ptr<Value> JSONReader::ReadToValue(StringPiece json) {
   return parser_->Parse(json);
 }
 
+bool JSONReader::ReadWithHandler(StringPiece json, Handler* handler) {
+  return parser_->ParseWithHandler(json, handler);
+}
+
 JSONReader::JsonParseError JSONReader::error_code() const {
   return parser_->error_code();
 }
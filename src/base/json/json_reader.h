@@ -30,12 +30,14 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/strings/string_piece.h"
 
 namespace base {
 
+class DictionaryValue;
 class Value;
 
 namespace internal {
@@ -73,6 +75,27 @@ class BASE_EXPORT JSONReader {
     JSON_PARSE_ERROR_COUNT
   };
 
+  // Receives the contents of a JSON document in document order, as an
+  // alternative to building a Value tree for it. StringPiece arguments are
+  // only valid for the duration of the call. Returning false from any method
+  // stops parsing.
+  class BASE_EXPORT Handler {
+   public:
+    virtual bool OnNull() = 0;
+    virtual bool OnBoolean(bool value) = 0;
+    virtual bool OnInteger(int value) = 0;
+    virtual bool OnDouble(double value) = 0;
+    virtual bool OnString(StringPiece value) = 0;
+    virtual bool OnDictionaryBegin() = 0;
+    virtual bool OnDictionaryKey(StringPiece key) = 0;
+    virtual bool OnDictionaryEnd() = 0;
+    virtual bool OnListBegin() = 0;
+    virtual bool OnListEnd() = 0;
+
+   protected:
+    virtual ~Handler() {}
+  };
+
   // String versions of parse error codes.
   static const char kInvalidEscape[];
   static const char kSyntaxError[];
@@ -112,6 +135,18 @@ class BASE_EXPORT JSONReader {
       int* error_line_out = nullptr,
       int* error_column_out = nullptr);
 
+  // Reads and parses |json| like Read(), but only builds the values at the
+  // given dotted |paths| into the root dictionary, e.g. "policy.homepage".
+  // The rest of the input is checked for errors without allocating any Values
+  // for it, which keeps memory use down when only a small part of a large
+  // document is needed. Paths that do not lead to a value are left out of the
+  // result. Returns NULL if |json| is malformed or its root is not a
+  // dictionary.
+  static std::unique_ptr<DictionaryValue> ReadSubtrees(
+      StringPiece json,
+      int options,
+      const std::vector<StringPiece>& paths);
+
   // Converts a JSON parse error code into a human readable message.
   // Returns an empty string if error_code is JSON_NO_ERROR.
   static std::string ErrorCodeToString(JsonParseError error_code);
@@ -119,7 +154,14 @@ class BASE_EXPORT JSONReader {
   // Parses an input string into a Value that is owned by the caller.
   std::unique_ptr<Value> ReadToValue(StringPiece json);
 
-  // Returns the error code if the last call to ReadToValue() failed.
+  // Parses |json| and reports its contents to |handler| without building any
+  // Values. Returns false if the input is malformed, or if |handler| stopped
+  // parsing, in which case error_code() is JSON_NO_ERROR. |handler| may have
+  // received some of the contents before an error is found.
+  bool ReadWithHandler(StringPiece json, Handler* handler);
+
+  // Returns the error code if the last call to ReadToValue() or
+  // ReadWithHandler() failed.
   // Returns JSON_NO_ERROR otherwise.
   JsonParseError error_code() const;
 
@@ -13,6 +13,7 @@
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
@@ -21,6 +22,49 @@
 
 namespace base {
 
+namespace {
+
+// Records the events of JSONReader::ReadWithHandler() as a string, and
+// optionally stops parsing at the |stop_after|-th one.
+class RecordingHandler : public JSONReader::Handler {
+ public:
+  explicit RecordingHandler(int stop_after = -1) : stop_after_(stop_after) {}
+
+  bool OnNull() override { return Record("null"); }
+  bool OnBoolean(bool value) override {
+    return Record(value ? "true" : "false");
+  }
+  bool OnInteger(int value) override { return Record(IntToString(value)); }
+  bool OnDouble(double value) override {
+    return Record("d" + DoubleToString(value));
+  }
+  bool OnString(StringPiece value) override {
+    return Record("'" + value.as_string() + "'");
+  }
+  bool OnDictionaryBegin() override { return Record("{"); }
+  bool OnDictionaryKey(StringPiece key) override {
+    return Record(key.as_string() + ":");
+  }
+  bool OnDictionaryEnd() override { return Record("}"); }
+  bool OnListBegin() override { return Record("["); }
+  bool OnListEnd() override { return Record("]"); }
+
+  const std::string& events() const { return events_; }
+
+ private:
+  bool Record(const std::string& event) {
+    if (!events_.empty())
+      events_ += " ";
+    events_ += event;
+    return stop_after_ < 0 || --stop_after_ > 0;
+  }
+
+  int stop_after_;
+  std::string events_;
+};
+
+}  // namespace
+
 TEST(JSONReaderTest, Reading) {
   // some whitespace checking
   std::unique_ptr<Value> root = JSONReader().ReadToValue("   null   ");
@@ -657,4 +701,80 @@ TEST(JSONReaderTest, IllegalTrailingNull) {
   EXPECT_EQ(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, reader.error_code());
 }
 
+TEST(JSONReaderTest, ReadWithHandler) {
+  JSONReader reader(JSON_ALLOW_TRAILING_COMMAS);
+  RecordingHandler handler;
+  EXPECT_TRUE(reader.ReadWithHandler(
+      "{\"a\": [1, 2.5, true, null,], \"b\\n\": {\"c\": \"x\\u00e9\"}}",
+      &handler));
+  EXPECT_EQ(JSONReader::JSON_NO_ERROR, reader.error_code());
+  EXPECT_EQ("{ a: [ 1 d2.5 true null ] b\n: { c: 'x\xc3\xa9' } }",
+            handler.events());
+}
+
+TEST(JSONReaderTest, ReadWithHandlerErrors) {
+  JSONReader reader;
+  RecordingHandler handler;
+  EXPECT_FALSE(reader.ReadWithHandler("[1, 2,]", &handler));
+  EXPECT_EQ(JSONReader::JSON_TRAILING_COMMA, reader.error_code());
+  EXPECT_EQ("[ 1 2", handler.events());
+
+  RecordingHandler trailing_data_handler;
+  EXPECT_FALSE(reader.ReadWithHandler("[] []", &trailing_data_handler));
+  EXPECT_EQ(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, reader.error_code());
+
+  // Stopping parsing is not an error.
+  RecordingHandler stopping_handler(2);
+  EXPECT_FALSE(reader.ReadWithHandler("[1, 2, 3]", &stopping_handler));
+  EXPECT_EQ(JSONReader::JSON_NO_ERROR, reader.error_code());
+  EXPECT_EQ("[ 1", stopping_handler.events());
+}
+
+TEST(JSONReaderTest, ReadSubtrees) {
+  std::vector<StringPiece> paths;
+  paths.push_back("policy.homepage");
+  paths.push_back("channels");
+  paths.push_back("missing.path");
+  std::unique_ptr<DictionaryValue> root = JSONReader::ReadSubtrees(
+      "{\"policy\": {\"homepage\": \"http://a/\", \"other\": [1, {}]},"
+      " \"channels\": [{\"id\": 7}], \"skipped\": {\"x\": \"y\"},"
+      " \"missing\": 3}",
+      JSON_PARSE_RFC, paths);
+  ASSERT_TRUE(root);
+
+  std::unique_ptr<Value> expected = JSONReader::Read(
+      "{\"policy\": {\"homepage\": \"http://a/\"},"
+      " \"channels\": [{\"id\": 7}]}");
+  EXPECT_TRUE(root->Equals(expected.get()));
+
+  // Skipped values are still checked for errors.
+  EXPECT_FALSE(JSONReader::ReadSubtrees("{\"skipped\": [1,]}", JSON_PARSE_RFC,
+                                        paths));
+  EXPECT_FALSE(JSONReader::ReadSubtrees("[1]", JSON_PARSE_RFC, paths));
+}
+
+// Strings are copied a machine word at a time up to the first character that
+// needs decoding, so check escapes at every offset around a word boundary.
+TEST(JSONReaderTest, LongStrings) {
+  for (size_t i = 0; i < 24; ++i) {
+    std::string prefix(i, 'a');
+    std::string result;
+
+    std::unique_ptr<Value> value =
+        JSONReader::Read("\"" + prefix + "\\tbc\"");
+    ASSERT_TRUE(value);
+    EXPECT_TRUE(value->GetAsString(&result));
+    EXPECT_EQ(prefix + "\tbc", result);
+
+    value = JSONReader::Read("\"" + prefix + "\xc3\xa9" + prefix + "\"");
+    ASSERT_TRUE(value);
+    EXPECT_TRUE(value->GetAsString(&result));
+    EXPECT_EQ(prefix + "\xc3\xa9" + prefix, result);
+
+    JSONReader reader;
+    EXPECT_FALSE(reader.ReadToValue("\"" + prefix));
+    EXPECT_EQ(JSONReader::JSON_SYNTAX_ERROR, reader.error_code());
+  }
+}
+
 }  // namespace base
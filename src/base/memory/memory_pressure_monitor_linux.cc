@@ -0,0 +1,514 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/memory_pressure_monitor_linux.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/single_thread_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/platform_thread.h"
+#include "base/threading/thread_task_runner_handle.h"
+
+namespace base {
+
+namespace {
+
+// The level goes back to NONE when no event of a level was received for this
+// long. PSI triggers fire at most once per window while the stalls last, so
+// this must be longer than their windows.
+const int kMemoryPressureTimeoutMs = 5000;
+
+// Minimum time between two MODERATE notifications, as on ChromeOS.
+const int kModerateMemoryPressureCooldownMs = 10000;
+
+// PSI triggers: "<some|full> <stall us> <window us>". Unprivileged processes
+// may only use windows which are multiples of 2 s.
+const char kModeratePsiTrigger[] = "some 200000 2000000";
+const char kCriticalPsiTrigger[] = "full 200000 2000000";
+
+const char kSystemPsiPath[] = "/proc/pressure/memory";
+const char kProcSelfCgroupPath[] = "/proc/self/cgroup";
+
+// The cgroup v2 hierarchy is mounted at the first path on unified systems and
+// at the second one on hybrid systems.
+const char kCgroupV2Root[] = "/sys/fs/cgroup";
+const char kHybridCgroupV2Root[] = "/sys/fs/cgroup/unified";
+const char kMemoryCgroupV1Root[] = "/sys/fs/cgroup/memory";
+
+const int kMaxEventsPerWait = 8;
+
+FilePath GetCgroupV2Path(const std::string& cgroup_path) {
+  const FilePath root(kCgroupV2Root);
+  if (PathExists(root.Append("cgroup.controllers")))
+    return FilePath(kCgroupV2Root + cgroup_path);
+  return FilePath(kHybridCgroupV2Root + cgroup_path);
+}
+
+}  // namespace
+
+// Waits for the kernel sources of memory pressure events on a non-joinable
+// thread, which holds a reference to the watcher until it exits, so that the
+// monitor never blocks on it.
+class MemoryPressureMonitorLinux::Watcher
+    : public RefCountedThreadSafe<Watcher>,
+      public PlatformThread::Delegate {
+ public:
+  Watcher(scoped_refptr<SingleThreadTaskRunner> task_runner,
+          WeakPtr<MemoryPressureMonitorLinux> monitor);
+
+  void Start();
+
+  // Asks the thread to exit, without waiting for it.
+  void Stop();
+
+ private:
+  friend class RefCountedThreadSafe<Watcher>;
+
+  enum SourceType {
+    PSI_TRIGGER,
+    CGROUP_V2_EVENTS,
+    CGROUP_V1_PRESSURE_LEVEL,
+  };
+
+  struct Source {
+    SourceType type;
+    // The level of the events of PSI_TRIGGER and CGROUP_V1_PRESSURE_LEVEL.
+    MemoryPressureLevel level =
+        MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+    // The file descriptor added to |epoll_fd_|.
+    ScopedFD fd;
+    // memory.pressure_level, which must stay open for CGROUP_V1_PRESSURE_LEVEL.
+    ScopedFD pressure_level_fd;
+    // The last counters of CGROUP_V2_EVENTS.
+    internal::MemoryCgroupEvents events;
+  };
+
+  ~Watcher() override;
+
+  // PlatformThread::Delegate:
+  void ThreadMain() override;
+
+  // Adds all sources available to the process.
+  void AddSources();
+  void AddPsiTrigger(const FilePath& path,
+                     const char* trigger,
+                     MemoryPressureLevel level);
+  void AddCgroupV2Events(const FilePath& cgroup);
+  void AddCgroupV1PressureLevel(const FilePath& cgroup,
+                                const char* level_name,
+                                MemoryPressureLevel level);
+  void Watch(std::unique_ptr<Source> source, uint32_t epoll_events);
+
+  void OnSourceEvent(Source* source, uint32_t epoll_events);
+
+  const scoped_refptr<SingleThreadTaskRunner> task_runner_;
+  const WeakPtr<MemoryPressureMonitorLinux> monitor_;
+
+  ScopedFD epoll_fd_;
+
+  // An eventfd which becomes readable when the thread must exit.
+  ScopedFD stop_fd_;
+
+  // Only accessed on the watcher thread.
+  std::vector<std::unique_ptr<Source>> sources_;
+
+  DISALLOW_COPY_AND_ASSIGN(Watcher);
+};
+
+MemoryPressureMonitorLinux::Watcher::Watcher(
+    scoped_refptr<SingleThreadTaskRunner> task_runner,
+    WeakPtr<MemoryPressureMonitorLinux> monitor)
+    : task_runner_(std::move(task_runner)),
+      monitor_(monitor),
+      epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      stop_fd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {}
+
+MemoryPressureMonitorLinux::Watcher::~Watcher() {}
+
+void MemoryPressureMonitorLinux::Watcher::Start() {
+  if (!epoll_fd_.is_valid() || !stop_fd_.is_valid()) {
+    DPLOG(ERROR) << "Cannot create the memory pressure watcher";
+    return;
+  }
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.ptr = nullptr;
+  if (epoll_ctl(epoll_fd_.get(), EPOLL_CTL_ADD, stop_fd_.get(), &event) < 0) {
+    DPLOG(ERROR) << "epoll_ctl";
+    return;
+  }
+
+  AddRef();
+  if (!PlatformThread::CreateNonJoinable(0, this)) {
+    DLOG(ERROR) << "Cannot start the memory pressure watcher thread";
+    Release();
+  }
+}
+
+void MemoryPressureMonitorLinux::Watcher::Stop() {
+  const uint64_t value = 1;
+  ignore_result(HANDLE_EINTR(write(stop_fd_.get(), &value, sizeof(value))));
+}
+
+void MemoryPressureMonitorLinux::Watcher::ThreadMain() {
+  PlatformThread::SetName("MemoryPressureWatcher");
+  AddSources();
+  if (sources_.empty())
+    VLOG(1) << "No kernel source of memory pressure events is available.";
+
+  bool stop = sources_.empty();
+  while (!stop) {
+    epoll_event events[kMaxEventsPerWait];
+    const int num_events = HANDLE_EINTR(
+        epoll_wait(epoll_fd_.get(), events, kMaxEventsPerWait, -1));
+    if (num_events < 0) {
+      DPLOG(ERROR) << "epoll_wait";
+      break;
+    }
+    for (int i = 0; i < num_events; ++i) {
+      if (!events[i].data.ptr) {
+        stop = true;
+        break;
+      }
+      OnSourceEvent(static_cast<Source*>(events[i].data.ptr),
+                    events[i].events);
+    }
+  }
+
+  sources_.clear();
+  // Balances the reference taken by Start(). Nothing must touch |this| after.
+  Release();
+}
+
+void MemoryPressureMonitorLinux::Watcher::AddSources() {
+  std::string proc_self_cgroup;
+  std::string cgroup_v2_path;
+  std::string memory_cgroup_v1_path;
+  if (ReadFileToString(FilePath(kProcSelfCgroupPath), &proc_self_cgroup)) {
+    internal::ParseProcSelfCgroup(proc_self_cgroup, &cgroup_v2_path,
+                                  &memory_cgroup_v1_path);
+  }
+
+  // Prefer the stalls of the cgroup of the process to the system-wide ones.
+  FilePath psi_path(kSystemPsiPath);
+  if (!cgroup_v2_path.empty() && cgroup_v2_path != "/") {
+    const FilePath cgroup = GetCgroupV2Path(cgroup_v2_path);
+    if (PathExists(cgroup.Append("memory.pressure")))
+      psi_path = cgroup.Append("memory.pressure");
+    AddCgroupV2Events(cgroup);
+  }
+  AddPsiTrigger(psi_path, kModeratePsiTrigger,
+                MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  AddPsiTrigger(psi_path, kCriticalPsiTrigger,
+                MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+
+  if (!memory_cgroup_v1_path.empty()) {
+    const FilePath cgroup(kMemoryCgroupV1Root + memory_cgroup_v1_path);
+    AddCgroupV1PressureLevel(
+        cgroup, "medium",
+        MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+    AddCgroupV1PressureLevel(
+        cgroup, "critical",
+        MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  }
+}
+
+void MemoryPressureMonitorLinux::Watcher::AddPsiTrigger(
+    const FilePath& path,
+    const char* trigger,
+    MemoryPressureLevel level) {
+  std::unique_ptr<Source> source(new Source);
+  source->type = PSI_TRIGGER;
+  source->level = level;
+  source->fd.reset(HANDLE_EINTR(
+      open(path.value().c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC)));
+  if (!source->fd.is_valid())
+    return;
+  // The kernel expects the terminating null character.
+  if (HANDLE_EINTR(write(source->fd.get(), trigger, strlen(trigger) + 1)) < 0) {
+    DPLOG(WARNING) << "Cannot add the PSI trigger \"" << trigger << "\" to "
+                   << path.value();
+    return;
+  }
+  Watch(std::move(source), EPOLLPRI);
+}
+
+void MemoryPressureMonitorLinux::Watcher::AddCgroupV2Events(
+    const FilePath& cgroup) {
+  std::string contents;
+  const FilePath path = cgroup.Append("memory.events");
+  std::unique_ptr<Source> source(new Source);
+  source->type = CGROUP_V2_EVENTS;
+  if (!ReadFileToString(path, &contents) ||
+      !internal::ParseMemoryCgroupEvents(contents, &source->events)) {
+    return;
+  }
+  source->fd.reset(
+      HANDLE_EINTR(open(path.value().c_str(), O_RDONLY | O_CLOEXEC)));
+  if (!source->fd.is_valid())
+    return;
+  // The kernel signals changes of the file with EPOLLPRI.
+  Watch(std::move(source), EPOLLPRI);
+}
+
+void MemoryPressureMonitorLinux::Watcher::AddCgroupV1PressureLevel(
+    const FilePath& cgroup,
+    const char* level_name,
+    MemoryPressureLevel level) {
+  std::unique_ptr<Source> source(new Source);
+  source->type = CGROUP_V1_PRESSURE_LEVEL;
+  source->level = level;
+  source->pressure_level_fd.reset(HANDLE_EINTR(
+      open(cgroup.Append("memory.pressure_level").value().c_str(),
+           O_RDONLY | O_CLOEXEC)));
+  if (!source->pressure_level_fd.is_valid())
+    return;
+  ScopedFD event_control_fd(HANDLE_EINTR(
+      open(cgroup.Append("cgroup.event_control").value().c_str(),
+           O_WRONLY | O_CLOEXEC)));
+  if (!event_control_fd.is_valid())
+    return;
+  source->fd.reset(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+  if (!source->fd.is_valid())
+    return;
+
+  const std::string registration =
+      StringPrintf("%d %d %s", source->fd.get(),
+                   source->pressure_level_fd.get(), level_name);
+  if (HANDLE_EINTR(write(event_control_fd.get(), registration.data(),
+                         registration.size())) < 0) {
+    DPLOG(WARNING) << "Cannot listen to " << level_name
+                   << " memory pressure of " << cgroup.value();
+    return;
+  }
+  Watch(std::move(source), EPOLLIN);
+}
+
+void MemoryPressureMonitorLinux::Watcher::Watch(std::unique_ptr<Source> source,
+                                                uint32_t epoll_events) {
+  epoll_event event = {};
+  event.events = epoll_events;
+  event.data.ptr = source.get();
+  if (epoll_ctl(epoll_fd_.get(), EPOLL_CTL_ADD, source->fd.get(), &event) <
+      0) {
+    DPLOG(WARNING) << "epoll_ctl";
+    return;
+  }
+  sources_.push_back(std::move(source));
+}
+
+void MemoryPressureMonitorLinux::Watcher::OnSourceEvent(
+    Source* source,
+    uint32_t epoll_events) {
+  MemoryPressureLevel level = source->level;
+  switch (source->type) {
+    case PSI_TRIGGER:
+      if (epoll_events & EPOLLERR) {
+        // The cgroup of the trigger went away; it won't fire anymore.
+        epoll_ctl(epoll_fd_.get(), EPOLL_CTL_DEL, source->fd.get(), nullptr);
+        return;
+      }
+      break;
+    case CGROUP_V2_EVENTS: {
+      // Reading the file acknowledges the change.
+      char buffer[512];
+      const ssize_t size = HANDLE_EINTR(
+          pread(source->fd.get(), buffer, sizeof(buffer) - 1, 0));
+      internal::MemoryCgroupEvents events;
+      if (size <= 0 ||
+          !internal::ParseMemoryCgroupEvents(std::string(buffer, size),
+                                             &events)) {
+        return;
+      }
+      level = internal::GetMemoryPressureLevelFromCgroupEvents(source->events,
+                                                               events);
+      source->events = events;
+      break;
+    }
+    case CGROUP_V1_PRESSURE_LEVEL: {
+      uint64_t count;
+      if (HANDLE_EINTR(read(source->fd.get(), &count, sizeof(count))) < 0)
+        return;
+      break;
+    }
+  }
+
+  if (level == MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+  task_runner_->PostTask(
+      FROM_HERE, Bind(&MemoryPressureMonitorLinux::OnMemoryPressureEvent,
+                      monitor_, level));
+}
+
+MemoryPressureMonitorLinux::MemoryPressureMonitorLinux()
+    : MemoryPressureMonitorLinux(true) {}
+
+MemoryPressureMonitorLinux::MemoryPressureMonitorLinux(bool watch_kernel)
+    : weak_ptr_factory_(this) {
+  if (!watch_kernel)
+    return;
+  watcher_ = new Watcher(ThreadTaskRunnerHandle::Get(),
+                         weak_ptr_factory_.GetWeakPtr());
+  watcher_->Start();
+}
+
+MemoryPressureMonitorLinux::~MemoryPressureMonitorLinux() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  if (watcher_)
+    watcher_->Stop();
+}
+
+MemoryPressureListener::MemoryPressureLevel
+MemoryPressureMonitorLinux::GetCurrentPressureLevel() const {
+  const TimeTicks now = Now();
+  const TimeDelta timeout =
+      TimeDelta::FromMilliseconds(kMemoryPressureTimeoutMs);
+  if (!last_critical_event_time_.is_null() &&
+      now - last_critical_event_time_ < timeout) {
+    return MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+  }
+  if (!last_moderate_event_time_.is_null() &&
+      now - last_moderate_event_time_ < timeout) {
+    return MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE;
+  }
+  return MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+}
+
+// static
+MemoryPressureMonitorLinux* MemoryPressureMonitorLinux::Get() {
+  return static_cast<MemoryPressureMonitorLinux*>(
+      base::MemoryPressureMonitor::Get());
+}
+
+void MemoryPressureMonitorLinux::OnMemoryPressureEvent(
+    MemoryPressureLevel level) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_NE(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE, level);
+  const TimeTicks now = Now();
+
+  if (level == MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL) {
+    // Critical events are always forwarded, so that memory keeps being
+    // released while the pressure lasts.
+    last_critical_event_time_ = now;
+    MemoryPressureListener::NotifyMemoryPressure(level);
+    return;
+  }
+
+  const bool is_critical =
+      GetCurrentPressureLevel() ==
+      MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+  last_moderate_event_time_ = now;
+  if (is_critical) {
+    // Going down from critical to moderate restarts the cooldown without a
+    // notification.
+    last_moderate_notification_time_ = now;
+    return;
+  }
+  if (!last_moderate_notification_time_.is_null() &&
+      now - last_moderate_notification_time_ <
+          TimeDelta::FromMilliseconds(kModerateMemoryPressureCooldownMs)) {
+    return;
+  }
+  last_moderate_notification_time_ = now;
+  MemoryPressureListener::NotifyMemoryPressure(level);
+}
+
+TimeTicks MemoryPressureMonitorLinux::Now() const {
+  return TimeTicks::Now();
+}
+
+namespace internal {
+
+bool ParseMemoryCgroupEvents(const std::string& contents,
+                             MemoryCgroupEvents* events) {
+  bool found = false;
+  for (const StringPiece& line :
+       SplitStringPiece(contents, "\n", TRIM_WHITESPACE, SPLIT_WANT_NONEMPTY)) {
+    std::vector<StringPiece> fields =
+        SplitStringPiece(line, " ", TRIM_WHITESPACE, SPLIT_WANT_NONEMPTY);
+    uint64_t value;
+    if (fields.size() != 2 || !StringToUint64(fields[1], &value))
+      continue;
+    if (fields[0] == "high")
+      events->high = value;
+    else if (fields[0] == "max")
+      events->max = value;
+    else if (fields[0] == "oom")
+      events->oom = value;
+    else if (fields[0] == "oom_kill")
+      events->oom_kill = value;
+    else
+      continue;
+    found = true;
+  }
+  return found;
+}
+
+MemoryPressureListener::MemoryPressureLevel
+GetMemoryPressureLevelFromCgroupEvents(const MemoryCgroupEvents& previous,
+                                       const MemoryCgroupEvents& current) {
+  // "max" means that allocations failed to be reclaimed below memory.max, and
+  // precedes the OOM killer.
+  if (current.max > previous.max || current.oom > previous.oom ||
+      current.oom_kill > previous.oom_kill) {
+    return MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+  }
+  // "high" means that the cgroup was throttled over memory.high.
+  if (current.high > previous.high)
+    return MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE;
+  return MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+}
+
+void ParseProcSelfCgroup(const std::string& contents,
+                         std::string* cgroup_v2_path,
+                         std::string* memory_cgroup_v1_path) {
+  cgroup_v2_path->clear();
+  memory_cgroup_v1_path->clear();
+  // Lines are "<hierarchy id>:<controllers>:<path>", where the single cgroup
+  // v2 hierarchy has the id 0 and no controllers.
+  for (const StringPiece& line :
+       SplitStringPiece(contents, "\n", TRIM_WHITESPACE, SPLIT_WANT_NONEMPTY)) {
+    const size_t first_colon = line.find(':');
+    if (first_colon == StringPiece::npos)
+      continue;
+    const size_t second_colon = line.find(':', first_colon + 1);
+    if (second_colon == StringPiece::npos)
+      continue;
+    const StringPiece id = line.substr(0, first_colon);
+    const StringPiece controllers =
+        line.substr(first_colon + 1, second_colon - first_colon - 1);
+    const StringPiece path = line.substr(second_colon + 1);
+
+    if (id == "0" && controllers.empty()) {
+      path.CopyToString(cgroup_v2_path);
+      continue;
+    }
+    for (const StringPiece& controller : SplitStringPiece(
+             controllers, ",", TRIM_WHITESPACE, SPLIT_WANT_NONEMPTY)) {
+      if (controller == "memory")
+        path.CopyToString(memory_cgroup_v1_path);
+    }
+  }
+}
+
+}  // namespace internal
+
+}  // namespace base
@@ -0,0 +1,121 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_MEMORY_PRESSURE_MONITOR_LINUX_H_
+#define BASE_MEMORY_MEMORY_PRESSURE_MONITOR_LINUX_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/memory_pressure_monitor.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/thread_checker.h"
+#include "base/time/time.h"
+
+namespace base {
+
+class TestMemoryPressureMonitorLinux;
+
+////////////////////////////////////////////////////////////////////////////////
+// MemoryPressureMonitorLinux
+//
+// A MemoryPressureMonitor which is told about memory pressure by the kernel
+// instead of polling memory statistics, for embedded Linux systems such as
+// webOS where the browser runs in a memory cgroup. It listens to:
+// - PSI triggers (Linux 4.20+) on memory stalls of the cgroup v2 of the
+//   process, or of the whole system: "some" stalls are MODERATE pressure and
+//   "full" stalls CRITICAL pressure.
+// - memory.events of the cgroup v2: "high" events are MODERATE pressure and
+//   "max", "oom" and "oom_kill" events CRITICAL pressure.
+// - memory.pressure_level of the cgroup v1 (through cgroup.event_control):
+//   "medium" is MODERATE pressure and "critical" CRITICAL pressure.
+// The kernel is waited for with epoll on a dedicated thread, and events are
+// forwarded to MemoryPressureListener on the thread which created the monitor.
+// The kernel keeps sending events while the pressure lasts, so the level goes
+// back to NONE once no event was received for a few seconds.
+//
+class BASE_EXPORT MemoryPressureMonitorLinux : public MemoryPressureMonitor {
+ public:
+  MemoryPressureMonitorLinux();
+  ~MemoryPressureMonitorLinux() override;
+
+  // Get the current memory pressure level.
+  MemoryPressureListener::MemoryPressureLevel GetCurrentPressureLevel() const
+      override;
+
+  // Returns a type-casted version of the current memory pressure monitor. A
+  // simple wrapper to base::MemoryPressureMonitor::Get.
+  static MemoryPressureMonitorLinux* Get();
+
+ private:
+  friend TestMemoryPressureMonitorLinux;
+  class Watcher;
+
+  // Only creates the watcher when |watch_kernel| is true. Used by tests.
+  explicit MemoryPressureMonitorLinux(bool watch_kernel);
+
+  // Called for each pressure event sent by the kernel. Notifies the listeners,
+  // except for MODERATE events received during a cooldown period after the
+  // previous MODERATE notification or while the pressure is CRITICAL.
+  void OnMemoryPressureEvent(MemoryPressureLevel level);
+
+  // Returns the current time. Virtual for testing.
+  virtual TimeTicks Now() const;
+
+  // The times of the last events of each level.
+  TimeTicks last_moderate_event_time_;
+  TimeTicks last_critical_event_time_;
+
+  // The time of the last MODERATE notification, to slow down their rate.
+  TimeTicks last_moderate_notification_time_;
+
+  // Waits for the kernel on a dedicated thread. Null in tests.
+  scoped_refptr<Watcher> watcher_;
+
+  ThreadChecker thread_checker_;
+
+  WeakPtrFactory<MemoryPressureMonitorLinux> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryPressureMonitorLinux);
+};
+
+namespace internal {
+
+// Counters of memory.events of a cgroup v2.
+struct BASE_EXPORT MemoryCgroupEvents {
+  uint64_t high = 0;
+  uint64_t max = 0;
+  uint64_t oom = 0;
+  uint64_t oom_kill = 0;
+};
+
+// Parses the contents of a memory.events file. Returns false if it has none
+// of the known counters. Exposed for testing.
+BASE_EXPORT bool ParseMemoryCgroupEvents(const std::string& contents,
+                                         MemoryCgroupEvents* events);
+
+// Returns the pressure level signaled by the counters of memory.events going
+// from |previous| to |current|. Exposed for testing.
+BASE_EXPORT MemoryPressureListener::MemoryPressureLevel
+GetMemoryPressureLevelFromCgroupEvents(const MemoryCgroupEvents& previous,
+                                       const MemoryCgroupEvents& current);
+
+// Parses the contents of /proc/self/cgroup into the path of the cgroup v2 of
+// the process and the path of its cgroup v1 memory controller, relative to
+// their hierarchy roots. Paths are left empty if the process has no such
+// cgroup. Exposed for testing.
+BASE_EXPORT void ParseProcSelfCgroup(const std::string& contents,
+                                     std::string* cgroup_v2_path,
+                                     std::string* memory_cgroup_v1_path);
+
+}  // namespace internal
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_MEMORY_PRESSURE_MONITOR_LINUX_H_
@@ -0,0 +1,165 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/memory_pressure_monitor_linux.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+class TestMemoryPressureMonitorLinux : public MemoryPressureMonitorLinux {
+ public:
+  TestMemoryPressureMonitorLinux()
+      : MemoryPressureMonitorLinux(false), now_(TimeTicks::Now()) {}
+  ~TestMemoryPressureMonitorLinux() override {}
+
+  void AdvanceTime(TimeDelta delta) { now_ += delta; }
+
+  void SendEvent(MemoryPressureLevel level) { OnMemoryPressureEvent(level); }
+
+ private:
+  TimeTicks Now() const override { return now_; }
+
+  TimeTicks now_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestMemoryPressureMonitorLinux);
+};
+
+namespace {
+
+class MemoryPressureMonitorLinuxTest : public testing::Test {
+ public:
+  MemoryPressureMonitorLinuxTest()
+      : listener_(Bind(&MemoryPressureMonitorLinuxTest::OnMemoryPressure,
+                       Unretained(this))) {}
+
+ protected:
+  // Returns the number of notifications since the last call.
+  int TakeNumNotifications() {
+    RunLoop().RunUntilIdle();
+    int num_notifications = num_notifications_;
+    num_notifications_ = 0;
+    return num_notifications;
+  }
+
+  MemoryPressureListener::MemoryPressureLevel last_level() const {
+    return last_level_;
+  }
+
+  MessageLoopForUI message_loop_;
+  TestMemoryPressureMonitorLinux monitor_;
+
+ private:
+  void OnMemoryPressure(MemoryPressureListener::MemoryPressureLevel level) {
+    ++num_notifications_;
+    last_level_ = level;
+  }
+
+  MemoryPressureListener listener_;
+  int num_notifications_ = 0;
+  MemoryPressureListener::MemoryPressureLevel last_level_ =
+      MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+};
+
+}  // namespace
+
+TEST_F(MemoryPressureMonitorLinuxTest, ModerateEventsAreRateLimited) {
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE,
+            monitor_.GetCurrentPressureLevel());
+
+  monitor_.SendEvent(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  EXPECT_EQ(1, TakeNumNotifications());
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE,
+            last_level());
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE,
+            monitor_.GetCurrentPressureLevel());
+
+  // Repeated events within the cooldown only keep the level up.
+  for (int i = 0; i < 4; ++i) {
+    monitor_.AdvanceTime(TimeDelta::FromSeconds(2));
+    monitor_.SendEvent(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  }
+  EXPECT_EQ(0, TakeNumNotifications());
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE,
+            monitor_.GetCurrentPressureLevel());
+
+  monitor_.AdvanceTime(TimeDelta::FromSeconds(2));
+  monitor_.SendEvent(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  EXPECT_EQ(1, TakeNumNotifications());
+
+  // The level decays once the kernel stops sending events.
+  monitor_.AdvanceTime(TimeDelta::FromSeconds(10));
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE,
+            monitor_.GetCurrentPressureLevel());
+}
+
+TEST_F(MemoryPressureMonitorLinuxTest, CriticalEventsAreAlwaysForwarded) {
+  for (int i = 0; i < 3; ++i) {
+    monitor_.SendEvent(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+    monitor_.AdvanceTime(TimeDelta::FromSeconds(1));
+  }
+  EXPECT_EQ(3, TakeNumNotifications());
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL,
+            last_level());
+
+  // Moderate events don't lower a critical level, nor notify.
+  monitor_.SendEvent(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  EXPECT_EQ(0, TakeNumNotifications());
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL,
+            monitor_.GetCurrentPressureLevel());
+
+  monitor_.AdvanceTime(TimeDelta::FromSeconds(4));
+  monitor_.SendEvent(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE,
+            monitor_.GetCurrentPressureLevel());
+  EXPECT_EQ(0, TakeNumNotifications());
+}
+
+TEST(MemoryPressureMonitorLinuxParsingTest, MemoryCgroupEvents) {
+  internal::MemoryCgroupEvents previous;
+  ASSERT_TRUE(internal::ParseMemoryCgroupEvents(
+      "low 0\nhigh 12\nmax 3\noom 0\noom_kill 0\n", &previous));
+  EXPECT_EQ(12u, previous.high);
+  EXPECT_EQ(3u, previous.max);
+  EXPECT_FALSE(internal::ParseMemoryCgroupEvents("unknown 1\n", &previous));
+
+  internal::MemoryCgroupEvents current = previous;
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE,
+            internal::GetMemoryPressureLevelFromCgroupEvents(previous,
+                                                             current));
+  current.high++;
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE,
+            internal::GetMemoryPressureLevelFromCgroupEvents(previous,
+                                                             current));
+  current.oom_kill++;
+  EXPECT_EQ(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL,
+            internal::GetMemoryPressureLevelFromCgroupEvents(previous,
+                                                             current));
+}
+
+TEST(MemoryPressureMonitorLinuxParsingTest, ProcSelfCgroup) {
+  std::string cgroup_v2_path;
+  std::string memory_cgroup_v1_path;
+  internal::ParseProcSelfCgroup(
+      "12:cpu,cpuacct:/apps\n"
+      "7:memory:/apps/browser\n"
+      "0::/system.slice/browser.service\n",
+      &cgroup_v2_path, &memory_cgroup_v1_path);
+  EXPECT_EQ("/system.slice/browser.service", cgroup_v2_path);
+  EXPECT_EQ("/apps/browser", memory_cgroup_v1_path);
+
+  internal::ParseProcSelfCgroup("0::/\n", &cgroup_v2_path,
+                                &memory_cgroup_v1_path);
+  EXPECT_EQ("/", cgroup_v2_path);
+  EXPECT_TRUE(memory_cgroup_v1_path.empty());
+}
+
+}  // namespace base
@@ -10,6 +10,7 @@
 #include <cassert>
 #include <iosfwd>
 #include <type_traits>
+#include <utility>
 
 #include "base/atomic_ref_count.h"
 #include "base/base_export.h"
@@ -208,6 +209,7 @@ class RefCountedData
  public:
   RefCountedData() : data() {}
   RefCountedData(const T& in_value) : data(in_value) {}
+  RefCountedData(T&& in_value) : data(std::move(in_value)) {}
 
   T data;
 
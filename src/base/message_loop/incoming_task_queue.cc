@@ -7,6 +7,7 @@
 #include <limits>
 
 #include "base/location.h"
+#include "base/message_loop/lock_free_task_queue.h"
 #include "base/message_loop/message_loop.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/time/time.h"
@@ -50,6 +51,11 @@ TimeTicks CalculateDelayedRuntime(TimeDelta delay) {
 
 IncomingTaskQueue::IncomingTaskQueue(MessageLoop* message_loop)
     : high_res_task_count_(0),
+      lock_free_incoming_queue_(
+          MessageLoop::IsLockFreeIncomingQueueEnabledForType(
+              message_loop->type())
+              ? new LockFreeTaskQueue
+              : nullptr),
       message_loop_(message_loop),
       next_sequence_num_(0),
       message_loop_scheduled_(false),
@@ -83,11 +89,15 @@ bool IncomingTaskQueue::AddToIncomingQueue(
 }
 
 bool IncomingTaskQueue::HasHighResolutionTasks() {
+  if (lock_free_incoming_queue_)
+    return high_res_task_count_.load(std::memory_order_relaxed) > 0;
   AutoLock lock(incoming_queue_lock_);
   return high_res_task_count_ > 0;
 }
 
 bool IncomingTaskQueue::IsIdleForTesting() {
+  if (lock_free_incoming_queue_)
+    return lock_free_incoming_queue_->IsEmpty();
   AutoLock lock(incoming_queue_lock_);
   return incoming_queue_.empty();
 }
@@ -96,6 +106,9 @@ int IncomingTaskQueue::ReloadWorkQueue(TaskQueue* work_queue) {
   // Make sure no tasks are lost.
   DCHECK(work_queue->empty());
 
+  if (lock_free_incoming_queue_)
+    return ReloadWorkQueueLockFree(work_queue);
+
   // Acquire all we can from the inter-thread queue with one lock acquisition.
   AutoLock lock(incoming_queue_lock_);
   if (incoming_queue_.empty()) {
@@ -119,7 +132,17 @@ void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
 
 void IncomingTaskQueue::StartScheduling() {
   bool schedule_work;
-  {
+  if (lock_free_incoming_queue_) {
+    DCHECK(!is_ready_for_scheduling_);
+    DCHECK(!message_loop_scheduled_);
+    // Either a concurrent PostPendingTaskLockFree() sees
+    // |is_ready_for_scheduling_| or this sees its task (both are sequentially
+    // consistent). If both happen, |message_loop_scheduled_| ensures that only
+    // one of them schedules work.
+    is_ready_for_scheduling_.store(true);
+    schedule_work = !lock_free_incoming_queue_->IsEmpty() &&
+                    !message_loop_scheduled_.exchange(true);
+  } else {
     AutoLock lock(incoming_queue_lock_);
     DCHECK(!is_ready_for_scheduling_);
     DCHECK(!message_loop_scheduled_);
@@ -152,6 +175,9 @@ bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
     return false;
   }
 
+  if (lock_free_incoming_queue_)
+    return PostPendingTaskLockFree(pending_task);
+
   bool schedule_work = false;
   {
     AutoLock hold(incoming_queue_lock_);
@@ -195,5 +221,52 @@ bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
   return true;
 }
 
+bool IncomingTaskQueue::PostPendingTaskLockFree(PendingTask* pending_task) {
+  DCHECK(message_loop_);
+
+#if defined(OS_WIN)
+  if (pending_task->is_high_res)
+    high_res_task_count_.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+  // Tasks posted concurrently from different threads may be pushed in a
+  // different order than their sequence numbers. This is fine since there is
+  // no ordering guarantee between such tasks anyways.
+  pending_task->sequence_num =
+      next_sequence_num_.fetch_add(1, std::memory_order_relaxed);
+
+  message_loop_->task_annotator()->DidQueueTask("MessageLoop::PostTask",
+                                                *pending_task);
+
+  lock_free_incoming_queue_->Push(*pending_task);
+  pending_task->task.Reset();
+
+  // Unlike the locked implementation, this can't tell whether the queue was
+  // empty before the push. Instead, the first poster after the message loop
+  // went idle schedules work, and ReloadWorkQueueLockFree() clears
+  // |message_loop_scheduled_| before its last attempt to find work.
+  if (is_ready_for_scheduling_.load() &&
+      (always_schedule_work_ || !message_loop_scheduled_.exchange(true))) {
+    message_loop_->ScheduleWork();
+  }
+
+  return true;
+}
+
+int IncomingTaskQueue::ReloadWorkQueueLockFree(TaskQueue* work_queue) {
+  if (!lock_free_incoming_queue_->MoveTo(work_queue)) {
+    // The message loop will go to sleep waiting for more work unless a task is
+    // found below. Clearing |message_loop_scheduled_| with a read-modify-write
+    // synchronizes with the poster that set it, so the second MoveTo() sees
+    // every task pushed before that poster skipped ScheduleWork(). Tasks pushed
+    // later are posted with |message_loop_scheduled_| cleared and schedule work
+    // themselves.
+    message_loop_scheduled_.exchange(false, std::memory_order_acq_rel);
+    lock_free_incoming_queue_->MoveTo(work_queue);
+  }
+  // Reset the count of high resolution tasks since our queue is now empty.
+  return high_res_task_count_.exchange(0, std::memory_order_relaxed);
+}
+
 }  // namespace internal
 }  // namespace base
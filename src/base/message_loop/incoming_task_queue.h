@@ -5,6 +5,9 @@
 #ifndef BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 #define BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 
+#include <atomic>
+#include <memory>
+
 #include "base/base_export.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -20,6 +23,8 @@ class WaitableEvent;
 
 namespace internal {
 
+class LockFreeTaskQueue;
+
 // Implements a queue of tasks posted to the message loop running on the current
 // thread. This class takes care of synchronizing posting tasks from different
 // threads and together with MessageLoop ensures clean shutdown.
@@ -69,12 +74,17 @@ class BASE_EXPORT IncomingTaskQueue
   // does not retain |pending_task->task| beyond this function call.
   bool PostPendingTask(PendingTask* pending_task);
 
+  // Implementations of PostPendingTask() and ReloadWorkQueue() used when
+  // |lock_free_incoming_queue_| is set.
+  bool PostPendingTaskLockFree(PendingTask* pending_task);
+  int ReloadWorkQueueLockFree(TaskQueue* work_queue);
+
   // Wakes up the message loop and schedules work.
   void ScheduleWork();
 
   // Number of tasks that require high resolution timing. This value is kept
   // so that ReloadWorkQueue() completes in constant time.
-  int high_res_task_count_;
+  std::atomic<int> high_res_task_count_;
 
   // The lock that protects access to the members of this class, except
   // |message_loop_|.
@@ -89,22 +99,27 @@ class BASE_EXPORT IncomingTaskQueue
   // |message_loop_|.
   TaskQueue incoming_queue_;
 
+  // Replaces |incoming_queue_| and |incoming_queue_lock_| if the type of
+  // |message_loop_| uses a lock-free incoming queue. See
+  // MessageLoop::SetLockFreeIncomingQueueEnabledForType().
+  const std::unique_ptr<LockFreeTaskQueue> lock_free_incoming_queue_;
+
   // Points to the message loop that owns |this|.
   MessageLoop* message_loop_;
 
   // The next sequence number to use for delayed tasks.
-  int next_sequence_num_;
+  std::atomic<int> next_sequence_num_;
 
   // True if our message loop has already been scheduled and does not need to be
   // scheduled again until an empty reload occurs.
-  bool message_loop_scheduled_;
+  std::atomic<bool> message_loop_scheduled_;
 
   // True if we always need to call ScheduleWork when receiving a new task, even
   // if the incoming queue was not empty.
   const bool always_schedule_work_;
 
   // False until StartScheduling() is called.
-  bool is_ready_for_scheduling_;
+  std::atomic<bool> is_ready_for_scheduling_;
 
   DISALLOW_COPY_AND_ASSIGN(IncomingTaskQueue);
 };
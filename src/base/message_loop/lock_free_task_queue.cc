@@ -0,0 +1,61 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop/lock_free_task_queue.h"
+
+#include <utility>
+
+#include "base/location.h"
+
+namespace base {
+namespace internal {
+
+LockFreeTaskQueue::Node::Node(const PendingTask& pending_task)
+    : next(nullptr), pending_task(pending_task) {}
+
+LockFreeTaskQueue::LockFreeTaskQueue()
+    : head_(new Node(PendingTask(FROM_HERE, Closure()))),
+      tail_(head_.load(std::memory_order_relaxed)) {}
+
+LockFreeTaskQueue::~LockFreeTaskQueue() {
+  // No producer can be running at this point, so all nodes are linked.
+  while (tail_) {
+    Node* const next = tail_->next.load(std::memory_order_relaxed);
+    delete tail_;
+    tail_ = next;
+  }
+}
+
+void LockFreeTaskQueue::Push(const PendingTask& pending_task) {
+  Node* const node = new Node(pending_task);
+  // Between the exchange and the store, |node| is reachable from |head_| but
+  // not from |tail_|. The consumer treats the chain as ending at |prev| until
+  // the store is visible. The exchange is sequentially consistent so that
+  // either IsEmpty() sees |node| or the producer sees flags that the consumer
+  // stored before calling IsEmpty().
+  Node* const prev = head_.exchange(node);
+  prev->next.store(node, std::memory_order_release);
+}
+
+size_t LockFreeTaskQueue::MoveTo(TaskQueue* work_queue) {
+  size_t num_moved = 0;
+  for (Node* next = tail_->next.load(std::memory_order_acquire); next;
+       next = tail_->next.load(std::memory_order_acquire)) {
+    delete tail_;
+    tail_ = next;
+    work_queue->push(std::move(tail_->pending_task));
+    // Don't retain references to the task's bound arguments in the stub node.
+    tail_->pending_task.task.Reset();
+    ++num_moved;
+  }
+  return num_moved;
+}
+
+bool LockFreeTaskQueue::IsEmpty() const {
+  return !tail_->next.load(std::memory_order_acquire) &&
+         head_.load(std::memory_order_seq_cst) == tail_;
+}
+
+}  // namespace internal
+}  // namespace base
@@ -0,0 +1,62 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MESSAGE_LOOP_LOCK_FREE_TASK_QUEUE_H_
+#define BASE_MESSAGE_LOOP_LOCK_FREE_TASK_QUEUE_H_
+
+#include <atomic>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/pending_task.h"
+
+namespace base {
+namespace internal {
+
+// An unbounded multiple-producer single-consumer queue of PendingTasks. Push()
+// is wait-free and can be called from any thread. MoveTo() and IsEmpty() must
+// only be called from the consumer thread.
+//
+// Tasks pushed by a given thread are dequeued in the order in which they were
+// pushed. Tasks pushed concurrently by different threads are dequeued in the
+// order in which their Push() calls were linearized.
+class BASE_EXPORT LockFreeTaskQueue {
+ public:
+  LockFreeTaskQueue();
+  ~LockFreeTaskQueue();
+
+  // Appends |pending_task| to the queue. Can be called from any thread.
+  void Push(const PendingTask& pending_task);
+
+  // Appends all tasks that are fully pushed to |work_queue|, in order, and
+  // returns the number of tasks moved. A Push() which is in progress on another
+  // thread may not be visible to this call.
+  size_t MoveTo(TaskQueue* work_queue);
+
+  // Returns true if there is no task in the queue, including tasks whose Push()
+  // is in progress.
+  bool IsEmpty() const;
+
+ private:
+  struct Node {
+    explicit Node(const PendingTask& pending_task);
+
+    std::atomic<Node*> next;
+    PendingTask pending_task;
+  };
+
+  // Last node pushed. Exchanged by producers.
+  std::atomic<Node*> head_;
+
+  // Stub node preceding the first task not yet moved out of the queue. Its
+  // |pending_task| has already been moved out. Only accessed by the consumer.
+  Node* tail_;
+
+  DISALLOW_COPY_AND_ASSIGN(LockFreeTaskQueue);
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_MESSAGE_LOOP_LOCK_FREE_TASK_QUEUE_H_
@@ -0,0 +1,107 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop/lock_free_task_queue.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/memory/ptr_util.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+const int kNumProducers = 4;
+const int kNumTasksPerProducer = 1000;
+
+// Encodes the producer and the index of a task in |sequence_num|.
+PendingTask CreateTask(int producer, int index) {
+  PendingTask pending_task(FROM_HERE, Bind(&DoNothing));
+  pending_task.sequence_num = producer * kNumTasksPerProducer + index;
+  return pending_task;
+}
+
+class ProducerThread : public SimpleThread {
+ public:
+  ProducerThread(LockFreeTaskQueue* queue, int producer)
+      : SimpleThread("LockFreeTaskQueueProducer"),
+        queue_(queue),
+        producer_(producer) {}
+
+  void Run() override {
+    for (int i = 0; i < kNumTasksPerProducer; ++i)
+      queue_->Push(CreateTask(producer_, i));
+  }
+
+ private:
+  LockFreeTaskQueue* const queue_;
+  const int producer_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProducerThread);
+};
+
+}  // namespace
+
+TEST(LockFreeTaskQueueTest, PushAndMove) {
+  LockFreeTaskQueue queue;
+  TaskQueue work_queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(0U, queue.MoveTo(&work_queue));
+
+  for (int i = 0; i < 3; ++i)
+    queue.Push(CreateTask(0, i));
+  EXPECT_FALSE(queue.IsEmpty());
+
+  EXPECT_EQ(3U, queue.MoveTo(&work_queue));
+  EXPECT_TRUE(queue.IsEmpty());
+  ASSERT_EQ(3U, work_queue.size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(i, work_queue.front().sequence_num);
+    work_queue.pop();
+  }
+}
+
+// Verify that tasks pushed concurrently by multiple producers aren't lost and
+// that the tasks of each producer are dequeued in order.
+TEST(LockFreeTaskQueueTest, MultipleProducers) {
+  LockFreeTaskQueue queue;
+  std::vector<std::unique_ptr<ProducerThread>> producers;
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers.push_back(WrapUnique(new ProducerThread(&queue, i)));
+    producers.back()->Start();
+  }
+
+  std::vector<int> next_index(kNumProducers, 0);
+  int num_dequeued = 0;
+  TaskQueue work_queue;
+  while (num_dequeued < kNumProducers * kNumTasksPerProducer) {
+    queue.MoveTo(&work_queue);
+    while (!work_queue.empty()) {
+      const int sequence_num = work_queue.front().sequence_num;
+      const int producer = sequence_num / kNumTasksPerProducer;
+      const int index = sequence_num % kNumTasksPerProducer;
+      EXPECT_EQ(next_index[producer], index);
+      next_index[producer] = index + 1;
+      ++num_dequeued;
+      work_queue.pop();
+    }
+  }
+
+  for (const auto& producer : producers)
+    producer->Join();
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+}  // namespace internal
+}  // namespace base
@@ -91,6 +91,10 @@ bool enable_histogrammer_ = false;
 
 MessageLoop::MessagePumpFactory* message_pump_for_ui_factory_ = NULL;
 
+// Bit |type| is set if MessageLoops of that type use a lock-free incoming task
+// queue.
+unsigned lock_free_incoming_queue_types_ = 1u << MessageLoop::TYPE_IO;
+
 #if defined(OS_IOS)
 typedef MessagePumpIOSForIO MessagePumpForIO;
 #elif defined(OS_NACL_SFI)
@@ -209,6 +213,20 @@ bool MessageLoop::InitMessagePumpForUIFactory(MessagePumpFactory* factory) {
   return true;
 }
 
+// static
+void MessageLoop::SetLockFreeIncomingQueueEnabledForType(Type type,
+                                                         bool enabled) {
+  if (enabled)
+    lock_free_incoming_queue_types_ |= 1u << type;
+  else
+    lock_free_incoming_queue_types_ &= ~(1u << type);
+}
+
+// static
+bool MessageLoop::IsLockFreeIncomingQueueEnabledForType(Type type) {
+  return (lock_free_incoming_queue_types_ & (1u << type)) != 0;
+}
+
 // static
 std::unique_ptr<MessagePump> MessageLoop::CreateMessagePumpForType(Type type) {
 // TODO(rvargas): Get rid of the OS guards.
@@ -130,6 +130,17 @@ class BASE_EXPORT MessageLoop : public MessagePump::Delegate {
   // was successfully registered.
   static bool InitMessagePumpForUIFactory(MessagePumpFactory* factory);
 
+  // Enables or disables the lock-free incoming task queue for MessageLoops of
+  // |type| constructed after this call. The lock-free queue avoids contention
+  // on loops that are posted to from many threads. The default is enabled for
+  // TYPE_IO only. Must be called before any MessageLoop of |type| is created,
+  // typically during process startup.
+  static void SetLockFreeIncomingQueueEnabledForType(Type type, bool enabled);
+
+  // Returns true if MessageLoops of |type| use the lock-free incoming task
+  // queue.
+  static bool IsLockFreeIncomingQueueEnabledForType(Type type);
+
   // Creates the default MessagePump based on |type|. Caller owns return
   // value.
   static std::unique_ptr<MessagePump> CreateMessagePumpForType(Type type);
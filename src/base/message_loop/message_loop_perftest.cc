@@ -0,0 +1,148 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/memory/ptr_util.h"
+#include "base/message_loop/message_loop.h"
+#include "base/single_thread_task_runner.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const size_t kNumTasksPerProducer = 20000;
+
+// Measures the time between the moment a task is posted to a MessageLoop from
+// one of several producer threads and the moment it runs.
+class PostToRunLatencyTest : public testing::TestWithParam<bool> {
+ public:
+  PostToRunLatencyTest()
+      : all_tasks_ran_(WaitableEvent::ResetPolicy::AUTOMATIC,
+                       WaitableEvent::InitialState::NOT_SIGNALED),
+        start_posting_(WaitableEvent::ResetPolicy::MANUAL,
+                       WaitableEvent::InitialState::NOT_SIGNALED) {}
+
+  void SetUp() override {
+    was_lock_free_ = MessageLoop::IsLockFreeIncomingQueueEnabledForType(
+        MessageLoop::TYPE_DEFAULT);
+    MessageLoop::SetLockFreeIncomingQueueEnabledForType(
+        MessageLoop::TYPE_DEFAULT, GetParam());
+  }
+
+  void TearDown() override {
+    MessageLoop::SetLockFreeIncomingQueueEnabledForType(
+        MessageLoop::TYPE_DEFAULT, was_lock_free_);
+  }
+
+  void Run(size_t num_producers) {
+    Thread target("target");
+    ASSERT_TRUE(target.Start());
+    target.WaitUntilThreadStarted();
+    target_task_runner_ = target.task_runner();
+
+    num_pending_tasks_ = num_producers * kNumTasksPerProducer;
+    total_latency_ = TimeDelta();
+    max_latency_ = TimeDelta();
+
+    std::vector<std::unique_ptr<Thread>> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+      producers.push_back(WrapUnique(new Thread("producer")));
+      ASSERT_TRUE(producers.back()->Start());
+      producers.back()->task_runner()->PostTask(
+          FROM_HERE,
+          Bind(&PostToRunLatencyTest::PostTasks, Unretained(this)));
+    }
+
+    // Release all producers at once to maximize contention.
+    start_posting_.Signal();
+    all_tasks_ran_.Wait();
+    for (const auto& producer : producers)
+      producer->Stop();
+    target.Stop();
+    target_task_runner_ = nullptr;
+    start_posting_.Reset();
+
+    const std::string trace = StringPrintf(
+        "%u_producers%s", static_cast<unsigned>(num_producers),
+        GetParam() ? "_lock_free" : "");
+    const size_t num_tasks = num_producers * kNumTasksPerProducer;
+    perf_test::PrintResult(
+        "post_to_run_latency", "", trace,
+        total_latency_.InMicroseconds() / static_cast<double>(num_tasks),
+        "us/task", true);
+    perf_test::PrintResult("post_to_run_latency", "_max", trace,
+                           static_cast<double>(max_latency_.InMicroseconds()),
+                           "us", false);
+  }
+
+ private:
+  void PostTasks() {
+    start_posting_.Wait();
+    for (size_t i = 0; i < kNumTasksPerProducer; ++i) {
+      target_task_runner_->PostTask(
+          FROM_HERE, Bind(&PostToRunLatencyTest::RunTask, Unretained(this),
+                          TimeTicks::Now()));
+    }
+  }
+
+  // Runs on the target thread.
+  void RunTask(TimeTicks post_time) {
+    const TimeDelta latency = TimeTicks::Now() - post_time;
+    total_latency_ += latency;
+    max_latency_ = std::max(max_latency_, latency);
+    if (--num_pending_tasks_ == 0)
+      all_tasks_ran_.Signal();
+  }
+
+  bool was_lock_free_ = false;
+  scoped_refptr<SingleThreadTaskRunner> target_task_runner_;
+
+  // Only accessed on the target thread while tasks are running.
+  size_t num_pending_tasks_ = 0;
+  TimeDelta total_latency_;
+  TimeDelta max_latency_;
+
+  WaitableEvent all_tasks_ran_;
+  WaitableEvent start_posting_;
+
+  DISALLOW_COPY_AND_ASSIGN(PostToRunLatencyTest);
+};
+
+}  // namespace
+
+TEST_P(PostToRunLatencyTest, OneProducer) {
+  Run(1);
+}
+
+TEST_P(PostToRunLatencyTest, FourProducers) {
+  Run(4);
+}
+
+TEST_P(PostToRunLatencyTest, SixteenProducers) {
+  Run(16);
+}
+
+INSTANTIATE_TEST_CASE_P(Locked,
+                        PostToRunLatencyTest,
+                        ::testing::Values(false));
+INSTANTIATE_TEST_CASE_P(LockFree,
+                        PostToRunLatencyTest,
+                        ::testing::Values(true));
+
+}  // namespace base
@@ -113,6 +113,19 @@ void HistogramSamples::Subtract(const HistogramSamples& other) {
   DCHECK(success);
 }
 
+HistogramBase::AtomicCount* HistogramSamples::GetOrCreateAtomicCount(
+    HistogramBase::Sample value) {
+  return nullptr;
+}
+
+void HistogramSamples::AccumulateAtomic(HistogramBase::AtomicCount* counter,
+                                        HistogramBase::Sample value,
+                                        HistogramBase::Count count) {
+  subtle::NoBarrier_AtomicIncrement(counter, count);
+  IncreaseSum(static_cast<int64_t>(count) * value);
+  IncreaseRedundantCount(count);
+}
+
 bool HistogramSamples::Serialize(Pickle* pickle) const {
   if (!pickle->WriteInt64(sum()))
     return false;
@@ -75,6 +75,19 @@ class BASE_EXPORT HistogramSamples {
   virtual void Subtract(const HistogramSamples& other);
 
   virtual std::unique_ptr<SampleCountIterator> Iterator() const = 0;
+
+  // Returns the counter for |value|, creating it if needed, when these samples
+  // keep it at a fixed address where it can be incremented atomically, or null
+  // otherwise. Creating a counter needs the same locking as Accumulate().
+  virtual HistogramBase::AtomicCount* GetOrCreateAtomicCount(
+      HistogramBase::Sample value);
+
+  // Adds |count| samples of |value| to |counter|, as returned by
+  // GetOrCreateAtomicCount() for |value|, along with the sum and redundant
+  // count. This needs no lock.
+  void AccumulateAtomic(HistogramBase::AtomicCount* counter,
+                        HistogramBase::Sample value,
+                        HistogramBase::Count count);
   virtual bool Serialize(Pickle* pickle) const;
 
   // Accessor fuctions.
@@ -104,7 +104,8 @@ PersistentSampleMap::~PersistentSampleMap() {
 }
 
 void PersistentSampleMap::Accumulate(Sample value, Count count) {
-  *GetOrCreateSampleCountStorage(value) += count;
+  subtle::NoBarrier_AtomicIncrement(GetOrCreateSampleCountStorage(value),
+                                    count);
   IncreaseSum(static_cast<int64_t>(count) * value);
   IncreaseRedundantCount(count);
 }
@@ -136,6 +137,13 @@ std::unique_ptr<SampleCountIterator> PersistentSampleMap::Iterator() const {
   return WrapUnique(new PersistentSampleMapIterator(sample_counts_));
 }
 
+HistogramBase::AtomicCount* PersistentSampleMap::GetOrCreateAtomicCount(
+    Sample value) {
+  // Counts live in persistent memory, or on the heap if that is full, and are
+  // never freed while this map exists.
+  return GetOrCreateSampleCountStorage(value);
+}
+
 // static
 PersistentMemoryAllocator::Reference
 PersistentSampleMap::GetNextPersistentRecord(
@@ -186,8 +194,9 @@ bool PersistentSampleMap::AddSubtractImpl(SampleCountIterator* iter,
     if (min + 1 != max)
       return false;  // SparseHistogram only supports bucket with size 1.
 
-    *GetOrCreateSampleCountStorage(min) +=
-        (op == HistogramSamples::ADD) ? count : -count;
+    subtle::NoBarrier_AtomicIncrement(
+        GetOrCreateSampleCountStorage(min),
+        (op == HistogramSamples::ADD) ? count : -count);
   }
   return true;
 }
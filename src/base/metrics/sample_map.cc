@@ -83,7 +83,7 @@ SampleMap::SampleMap(uint64_t id) : HistogramSamples(id) {}
 SampleMap::~SampleMap() {}
 
 void SampleMap::Accumulate(Sample value, Count count) {
-  sample_counts_[value] += count;
+  subtle::NoBarrier_AtomicIncrement(&sample_counts_[value], count);
   IncreaseSum(static_cast<int64_t>(count) * value);
   IncreaseRedundantCount(count);
 }
@@ -107,6 +107,10 @@ std::unique_ptr<SampleCountIterator> SampleMap::Iterator() const {
   return WrapUnique(new SampleMapIterator(sample_counts_));
 }
 
+HistogramBase::AtomicCount* SampleMap::GetOrCreateAtomicCount(Sample value) {
+  return &sample_counts_[value];
+}
+
 bool SampleMap::AddSubtractImpl(SampleCountIterator* iter, Operator op) {
   Sample min;
   Sample max;
@@ -116,7 +120,8 @@ bool SampleMap::AddSubtractImpl(SampleCountIterator* iter, Operator op) {
     if (min + 1 != max)
       return false;  // SparseHistogram only supports bucket with size 1.
 
-    sample_counts_[min] += (op == HistogramSamples::ADD) ? count : -count;
+    subtle::NoBarrier_AtomicIncrement(
+        &sample_counts_[min], (op == HistogramSamples::ADD) ? count : -count);
   }
   return true;
 }
@@ -34,12 +34,17 @@ class BASE_EXPORT SampleMap : public HistogramSamples {
   HistogramBase::Count GetCount(HistogramBase::Sample value) const override;
   HistogramBase::Count TotalCount() const override;
   std::unique_ptr<SampleCountIterator> Iterator() const override;
+  HistogramBase::AtomicCount* GetOrCreateAtomicCount(
+      HistogramBase::Sample value) override;
 
  protected:
   // Performs arithemetic. |op| is ADD or SUBTRACT.
   bool AddSubtractImpl(SampleCountIterator* iter, Operator op) override;
 
  private:
+  // Counts are updated atomically since GetOrCreateAtomicCount() hands them out
+  // to be incremented without a lock. Entries are never removed, so those
+  // pointers stay valid.
   std::map<HistogramBase::Sample, HistogramBase::Count> sample_counts_;
 
   DISALLOW_COPY_AND_ASSIGN(SampleMap);
@@ -109,9 +109,15 @@ void SparseHistogram::AddCount(Sample value, int count) {
     NOTREACHED();
     return;
   }
-  {
+  AtomicCount* counter = FindCachedCounter(value);
+  if (counter) {
+    samples_->AccumulateAtomic(counter, value, count);
+  } else {
     base::AutoLock auto_lock(lock_);
-    samples_->Accumulate(value, count);
+    counter = samples_->GetOrCreateAtomicCount(value);
+    DCHECK(counter);
+    samples_->AccumulateAtomic(counter, value, count);
+    CacheCounter(value, counter);
   }
 
   FindAndRunCallback(value);
@@ -223,6 +229,39 @@ void SparseHistogram::GetCountAndBucketData(Count* count,
   // TODO(kaiwang): Implement. (See HistogramBase::WriteJSON.)
 }
 
+HistogramBase::AtomicCount* SparseHistogram::FindCachedCounter(
+    Sample value) const {
+  size_t slot = static_cast<uint32_t>(value) % kCachedCounters;
+  for (size_t i = 0; i < kMaxCacheProbes; ++i) {
+    const CachedCounter& cached = cached_counters_[slot];
+    subtle::AtomicWord counter = subtle::Acquire_Load(&cached.counter);
+    // Slots are filled in probe order, so an empty one ends the search.
+    if (!counter)
+      return nullptr;
+    if (subtle::NoBarrier_Load(&cached.value) == value)
+      return reinterpret_cast<AtomicCount*>(counter);
+    slot = (slot + 1) % kCachedCounters;
+  }
+  return nullptr;
+}
+
+void SparseHistogram::CacheCounter(Sample value, AtomicCount* counter) {
+  lock_.AssertAcquired();
+  size_t slot = static_cast<uint32_t>(value) % kCachedCounters;
+  for (size_t i = 0; i < kMaxCacheProbes; ++i) {
+    CachedCounter* cached = &cached_counters_[slot];
+    if (!subtle::NoBarrier_Load(&cached->counter)) {
+      subtle::NoBarrier_Store(&cached->value, value);
+      subtle::Release_Store(&cached->counter,
+                            reinterpret_cast<subtle::AtomicWord>(counter));
+      return;
+    }
+    if (subtle::NoBarrier_Load(&cached->value) == value)
+      return;
+    slot = (slot + 1) % kCachedCounters;
+  }
+}
+
 void SparseHistogram::WriteAsciiImpl(bool graph_it,
                                      const std::string& newline,
                                      std::string* output) const {
@@ -15,6 +15,7 @@
 #include "base/base_export.h"
 #include "base/compiler_specific.h"
 #include "base/logging.h"
+#include "base/atomicops.h"
 #include "base/macros.h"
 #include "base/metrics/histogram_base.h"
 #include "base/metrics/sample_map.h"
@@ -26,10 +27,12 @@ namespace base {
 // that are sparsely distributed over a large range.
 //
 // The implementation uses a lock and a map, whereas other histogram types use a
-// vector and no lock. It is thus more costly to add values to, and each value
-// stored has more overhead, compared to the other histogram types. However it
-// may be more efficient in memory if the total number of sample values is small
-// compared to the range of their values.
+// vector and no lock. Values already recorded are counted without the lock
+// through a small cache of their counters, but the first sample of each value
+// takes the lock, and each value stored has more overhead, compared to the
+// other histogram types. However it may be more efficient in memory if the
+// total number of sample values is small compared to the range of their
+// values.
 //
 // UMA_HISTOGRAM_ENUMERATION would be better suited for a smaller range of
 // enumerations that are (nearly) contiguous. Also for code that is expected to
@@ -90,6 +93,15 @@ class BASE_EXPORT SparseHistogram : public HistogramBase {
   bool SerializeInfoImpl(base::Pickle* pickle) const override;
 
  private:
+  struct CachedCounter {
+    subtle::Atomic32 value;
+    subtle::AtomicWord counter;
+  };
+
+  // The number of counters cached, and how many slots a value may probe.
+  static const size_t kCachedCounters = 16;
+  static const size_t kMaxCacheProbes = 4;
+
   // Clients should always use FactoryGet to create SparseHistogram.
   explicit SparseHistogram(const std::string& name);
 
@@ -116,6 +128,14 @@ class BASE_EXPORT SparseHistogram : public HistogramBase {
   void WriteAsciiHeader(const Count total_count,
                         std::string* output) const;
 
+  // Returns the cached counter of |value| in |samples_|, or null if it isn't
+  // cached. Needs no lock.
+  AtomicCount* FindCachedCounter(Sample value) const;
+
+  // Caches |counter| as the counter of |value|, if there is room. |lock_|
+  // must be held.
+  void CacheCounter(Sample value, AtomicCount* counter);
+
   // For constuctor calling.
   friend class SparseHistogramTest;
 
@@ -128,6 +148,11 @@ class BASE_EXPORT SparseHistogram : public HistogramBase {
   std::unique_ptr<HistogramSamples> samples_;
   std::unique_ptr<HistogramSamples> logged_samples_;
 
+  // Counters of values recorded so far, found by probing from the value's
+  // slot. A slot is filled once, under |lock_|, by storing its value and then
+  // publishing its counter, and never changes after that.
+  CachedCounter cached_counters_[kCachedCounters] = {};
+
   DISALLOW_COPY_AND_ASSIGN(SparseHistogram);
 };
 
@@ -6,7 +6,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_base.h"
 #include "base/metrics/histogram_samples.h"
 #include "base/metrics/persistent_histogram_allocator.h"
@@ -15,6 +17,7 @@
 #include "base/metrics/statistics_recorder.h"
 #include "base/pickle.h"
 #include "base/strings/stringprintf.h"
+#include "base/threading/simple_thread.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
@@ -148,6 +151,67 @@ TEST_P(SparseHistogramTest, AddCount_LargeValuesDontOverflow) {
   EXPECT_EQ(55250000000LL, snapshot2->sum());
 }
 
+namespace {
+
+// Records each of |values| |count| times into a histogram.
+class SparseHistogramAdder : public DelegateSimpleThread::Delegate {
+ public:
+  SparseHistogramAdder(HistogramBase* histogram,
+                       const std::vector<HistogramBase::Sample>& values,
+                       int count)
+      : histogram_(histogram), values_(values), count_(count) {}
+
+  void Run() override {
+    for (int i = 0; i < count_; ++i) {
+      for (HistogramBase::Sample value : values_)
+        histogram_->Add(value);
+    }
+  }
+
+ private:
+  HistogramBase* const histogram_;
+  const std::vector<HistogramBase::Sample> values_;
+  const int count_;
+
+  DISALLOW_COPY_AND_ASSIGN(SparseHistogramAdder);
+};
+
+}  // namespace
+
+// Values recorded from several threads at once, most of them without taking
+// the histogram's lock, are all counted.
+TEST_P(SparseHistogramTest, AddFromManyThreads) {
+  const int kThreadCount = 4;
+  const int kAddCount = 10000;
+  HistogramBase* histogram =
+      SparseHistogram::FactoryGet("Sparse", HistogramBase::kNoFlags);
+
+  // More distinct values than are cached, so that some always take the lock.
+  std::vector<HistogramBase::Sample> values;
+  for (HistogramBase::Sample value = -10; value < 30; ++value)
+    values.push_back(value * 1000);
+
+  std::vector<std::unique_ptr<SparseHistogramAdder>> adders;
+  std::vector<std::unique_ptr<DelegateSimpleThread>> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    adders.push_back(WrapUnique(
+        new SparseHistogramAdder(histogram, values, kAddCount)));
+    threads.push_back(WrapUnique(
+        new DelegateSimpleThread(adders.back().get(), "SparseHistogramAdder")));
+    threads.back()->Start();
+  }
+  for (const auto& thread : threads)
+    thread->Join();
+
+  std::unique_ptr<HistogramSamples> samples = histogram->SnapshotSamples();
+  EXPECT_EQ(static_cast<HistogramBase::Count>(kThreadCount * kAddCount *
+                                              values.size()),
+            samples->TotalCount());
+  EXPECT_EQ(samples->TotalCount(), samples->redundant_count());
+  for (HistogramBase::Sample value : values)
+    EXPECT_EQ(kThreadCount * kAddCount, samples->GetCount(value));
+}
+
 TEST_P(SparseHistogramTest, MacroBasicTest) {
   UMA_HISTOGRAM_SPARSE_SLOWLY("Sparse", 100);
   UMA_HISTOGRAM_SPARSE_SLOWLY("Sparse", 200);
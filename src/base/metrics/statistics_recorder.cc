@@ -8,6 +8,7 @@
 
 #include "base/at_exit.h"
 #include "base/debug/leak_annotations.h"
+#include "base/hash.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
@@ -296,6 +297,12 @@ void StatisticsRecorder::GetBucketRanges(
 
 // static
 HistogramBase* StatisticsRecorder::FindHistogram(base::StringPiece name) {
+  subtle::AtomicWord* cache_slot = GetLookupCacheSlot(name);
+  HistogramBase* cached =
+      reinterpret_cast<HistogramBase*>(subtle::Acquire_Load(cache_slot));
+  if (cached && cached->histogram_name() == name)
+    return cached;
+
   // This must be called *before* the lock is acquired below because it will
   // call back into this object to register histograms. Those called methods
   // will acquire the lock at that time.
@@ -310,6 +317,8 @@ HistogramBase* StatisticsRecorder::FindHistogram(base::StringPiece name) {
   HistogramMap::iterator it = histograms_->find(name);
   if (histograms_->end() == it)
     return NULL;
+  subtle::Release_Store(cache_slot,
+                        reinterpret_cast<subtle::AtomicWord>(it->second));
   return it->second;
 }
 
@@ -417,8 +426,10 @@ size_t StatisticsRecorder::GetHistogramCount() {
 
 // static
 void StatisticsRecorder::ForgetHistogramForTesting(base::StringPiece name) {
-  if (histograms_)
+  if (histograms_) {
     histograms_->erase(name);
+    ClearLookupCache();
+  }
 }
 
 // static
@@ -481,6 +492,7 @@ StatisticsRecorder::StatisticsRecorder() {
   histograms_ = new HistogramMap;
   callbacks_ = new CallbackMap;
   ranges_ = new RangesMap;
+  ClearLookupCache();
 
   if (VLOG_IS_ON(1))
     AtExitManager::RegisterCallback(&DumpHistogramsToVlog, this);
@@ -505,10 +517,23 @@ void StatisticsRecorder::Reset() {
     histograms_ = NULL;
     callbacks_ = NULL;
     ranges_ = NULL;
+    ClearLookupCache();
   }
   // We are going to leak the histograms and the ranges.
 }
 
+// static
+subtle::AtomicWord* StatisticsRecorder::GetLookupCacheSlot(
+    base::StringPiece name) {
+  return &lookup_cache_[Hash(name.data(), name.size()) % kLookupCacheSize];
+}
+
+// static
+void StatisticsRecorder::ClearLookupCache() {
+  for (subtle::AtomicWord& slot : lookup_cache_)
+    subtle::NoBarrier_Store(&slot, 0);
+}
+
 // static
 void StatisticsRecorder::DumpHistogramsToVlog(void* instance) {
   std::string output;
@@ -525,5 +550,8 @@ StatisticsRecorder::CallbackMap* StatisticsRecorder::callbacks_ = NULL;
 StatisticsRecorder::RangesMap* StatisticsRecorder::ranges_ = NULL;
 // static
 base::Lock* StatisticsRecorder::lock_ = NULL;
+// static
+subtle::AtomicWord
+    StatisticsRecorder::lookup_cache_[StatisticsRecorder::kLookupCacheSize];
 
 }  // namespace base
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/callback.h"
 #include "base/gtest_prod_util.h"
@@ -133,7 +134,9 @@ class BASE_EXPORT StatisticsRecorder {
   static void GetBucketRanges(std::vector<const BucketRanges*>* output);
 
   // Find a histogram by name. It matches the exact name. This method is thread
-  // safe.  It returns NULL if a matching histogram is not found.
+  // safe.  It returns NULL if a matching histogram is not found. Histograms
+  // found before are usually returned from a cache without taking the lock,
+  // so this is cheap enough for names computed each time a sample is added.
   static HistogramBase* FindHistogram(base::StringPiece name);
 
   // Support for iterating over known histograms.
@@ -215,6 +218,12 @@ class BASE_EXPORT StatisticsRecorder {
   static void Reset();
   static void DumpHistogramsToVlog(void* instance);
 
+  // Returns the slot of |lookup_cache_| for histograms named |name|.
+  static subtle::AtomicWord* GetLookupCacheSlot(base::StringPiece name);
+
+  // Empties |lookup_cache_|. |lock_| must be held.
+  static void ClearLookupCache();
+
   static HistogramMap* histograms_;
   static CallbackMap* callbacks_;
   static RangesMap* ranges_;
@@ -222,6 +231,13 @@ class BASE_EXPORT StatisticsRecorder {
   // Lock protects access to above maps.
   static base::Lock* lock_;
 
+  // Histograms returned by FindHistogram(), indexed by a hash of their name.
+  // Histograms are never deleted once registered, so a cached one can be
+  // returned without taking |lock_| after checking its name. Slots are
+  // written under |lock_| and emptied whenever a histogram is unregistered.
+  static const size_t kLookupCacheSize = 256;
+  static subtle::AtomicWord lookup_cache_[kLookupCacheSize];
+
   DISALLOW_COPY_AND_ASSIGN(StatisticsRecorder);
 };
 
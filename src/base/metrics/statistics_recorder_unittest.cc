@@ -212,6 +212,18 @@ TEST_P(StatisticsRecorderTest, FindHistogram) {
   EXPECT_FALSE(StatisticsRecorder::FindHistogram("TestHistogram"));
 }
 
+TEST_P(StatisticsRecorderTest, FindForgottenHistogram) {
+  HistogramBase* histogram = Histogram::FactoryGet(
+      "TestHistogram", 1, 1000, 10, HistogramBase::kNoFlags);
+
+  // Repeated lookups, which are served from the lookup cache, keep finding
+  // the histogram until it is unregistered.
+  EXPECT_EQ(histogram, StatisticsRecorder::FindHistogram("TestHistogram"));
+  EXPECT_EQ(histogram, StatisticsRecorder::FindHistogram("TestHistogram"));
+  StatisticsRecorder::ForgetHistogramForTesting("TestHistogram");
+  EXPECT_FALSE(StatisticsRecorder::FindHistogram("TestHistogram"));
+}
+
 TEST_P(StatisticsRecorderTest, GetSnapshot) {
   Histogram::FactoryGet("TestHistogram1", 1, 1000, 10, Histogram::kNoFlags);
   Histogram::FactoryGet("TestHistogram2", 1, 1000, 10, Histogram::kNoFlags);
@@ -360,8 +360,10 @@ void Pickle::Reserve(size_t length) {
 #endif
   DCHECK_LE(write_offset_, std::numeric_limits<uint32_t>::max() - data_len);
   size_t new_size = write_offset_ + data_len;
+  // Grow to exactly the reserved size when that is more than doubling would
+  // give, so that a pickle sized up front is allocated once.
   if (new_size > capacity_after_header_)
-    Resize(capacity_after_header_ * 2 + new_size);
+    Resize(std::max(capacity_after_header_ * 2, new_size));
 }
 
 bool Pickle::WriteAttachment(scoped_refptr<Attachment> attachment) {
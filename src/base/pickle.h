@@ -268,7 +268,9 @@ class BASE_EXPORT Pickle {
 
   // Reserves space for upcoming writes when multiple writes will be made and
   // their sizes are computed in advance. It can be significantly faster to call
-  // Reserve() before calling WriteFoo() multiple times.
+  // Reserve() before calling WriteFoo() multiple times. A pickle whose whole
+  // payload is reserved up front, e.g. from a PickleSizer, is not reallocated
+  // while it is written.
   void Reserve(size_t additional_capacity);
 
   // Payload follows after allocation of Header (header size is customizable).
@@ -372,6 +374,7 @@ class BASE_EXPORT Pickle {
   inline void WriteBytesCommon(const void* data, size_t length);
 
   FRIEND_TEST_ALL_PREFIXES(PickleTest, DeepCopyResize);
+  FRIEND_TEST_ALL_PREFIXES(PickleTest, Reserve);
   FRIEND_TEST_ALL_PREFIXES(PickleTest, Resize);
   FRIEND_TEST_ALL_PREFIXES(PickleTest, PeekNext);
   FRIEND_TEST_ALL_PREFIXES(PickleTest, PeekNextOverflow);
@@ -421,6 +421,29 @@ TEST(PickleTest, Resize) {
   EXPECT_EQ(cur_payload, pickle.payload_size());
 }
 
+TEST(PickleTest, Reserve) {
+  size_t unit = Pickle::kPayloadUnit;
+  const std::string data(10 * unit, 'G');
+  PickleSizer sizer;
+  sizer.AddInt();
+  sizer.AddString(data);
+
+  // Reserving the exact size allocates no more than the payload needs.
+  Pickle pickle;
+  pickle.Reserve(sizer.payload_size());
+  size_t capacity = pickle.capacity_after_header();
+  EXPECT_EQ(11 * unit, capacity);
+
+  pickle.WriteInt(42);
+  pickle.WriteString(data);
+  EXPECT_EQ(capacity, pickle.capacity_after_header());
+  EXPECT_EQ(sizer.payload_size(), pickle.payload_size());
+
+  // Small reservations past the capacity still grow it geometrically.
+  pickle.Reserve(capacity - pickle.payload_size() + 1);
+  EXPECT_EQ(capacity * 2, pickle.capacity_after_header());
+}
+
 namespace {
 
 struct CustomHeader : Pickle::Header {
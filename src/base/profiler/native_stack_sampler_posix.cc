@@ -4,11 +4,447 @@
 
 #include "base/profiler/native_stack_sampler.h"
 
+#include "build/build_config.h"
+
+#if (defined(OS_LINUX) || defined(OS_ANDROID)) && \
+    (defined(ARCH_CPU_X86_FAMILY) || defined(ARCH_CPU_ARM64))
+#define SIGNAL_STACK_SAMPLING_SUPPORTED
+#endif
+
+#if defined(SIGNAL_STACK_SAMPLING_SUPPORTED)
+
+#include <dlfcn.h>
+#include <elf.h>
+#include <errno.h>
+#include <link.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/debug/proc_maps_linux.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
+
+#if defined(__GLIBC__)
+// The highest address used by the main thread's stack, set up by the loader.
+extern "C" void* __libc_stack_end;
+#endif
+
+#endif  // defined(SIGNAL_STACK_SAMPLING_SUPPORTED)
+
 namespace base {
 
+#if defined(SIGNAL_STACK_SAMPLING_SUPPORTED)
+
+// Stack recording functions --------------------------------------------------
+
+namespace {
+
+// The target thread records its own stack in a signal handler, by walking the
+// frame pointer chain from the interrupted context. Chrome does not use
+// SIGURG, whose default action is to ignore it, so a late signal arriving
+// after the handler is gone is harmless. SIGPROF is avoided because the V8
+// sampling profiler uses it.
+const int kSampleSignal = SIGURG;
+
+// The deepest stack recorded. Deeper frames are dropped.
+const size_t kMaxFrames = 256;
+
+// How long to wait for the target thread to run the signal handler. A thread
+// may not get to it if it is blocking signals or has exited.
+const int kSignalTimeoutMilliseconds = 100;
+
+// State of the single in-flight sample request.
+enum SampleState : subtle::Atomic32 {
+  // No request. The handler ignores signals.
+  SAMPLE_IDLE,
+  // The sampling thread sent the signal and waits for the handler.
+  SAMPLE_PENDING,
+  // The handler is recording the stack and will post |done| when finished.
+  SAMPLE_RECORDING,
+};
+
+// The request shared with the signal handler. There is only one, guarded by
+// |lock| on the sampling side, since the handler cannot tell requests apart
+// and must not touch memory that may be freed.
+struct SampleRequest {
+  Lock lock;
+  bool initialized = false;
+  subtle::Atomic32 state = SAMPLE_IDLE;
+  sem_t done;
+
+  // Set before the signal is sent.
+  pid_t thread_id = 0;
+  uintptr_t stack_top = 0;
+
+  // Set by the handler.
+  uintptr_t stack_pointer = 0;
+  size_t frame_count = 0;
+  uintptr_t frames[kMaxFrames];
+};
+
+LazyInstance<SampleRequest>::Leaky g_request = LAZY_INSTANCE_INITIALIZER;
+
+// Extracts the registers needed to walk the stack from a signal context.
+void GetRegisters(const ucontext_t* context,
+                  uintptr_t* instruction_pointer,
+                  uintptr_t* stack_pointer,
+                  uintptr_t* frame_pointer) {
+  const mcontext_t& mcontext = context->uc_mcontext;
+#if defined(ARCH_CPU_X86_64)
+  *instruction_pointer = mcontext.gregs[REG_RIP];
+  *stack_pointer = mcontext.gregs[REG_RSP];
+  *frame_pointer = mcontext.gregs[REG_RBP];
+#elif defined(ARCH_CPU_X86)
+  *instruction_pointer = mcontext.gregs[REG_EIP];
+  *stack_pointer = mcontext.gregs[REG_ESP];
+  *frame_pointer = mcontext.gregs[REG_EBP];
+#elif defined(ARCH_CPU_ARM64)
+  *instruction_pointer = mcontext.pc;
+  *stack_pointer = mcontext.sp;
+  *frame_pointer = mcontext.regs[29];
+#endif
+}
+
+// Walks the frame pointer chain starting at |frame_pointer|. Every frame
+// record read must lie between |stack_pointer| and |stack_top| and sit above
+// the previous one, so a bogus frame pointer from code built without frame
+// pointers ends the walk instead of faulting. Async-signal-safe.
+size_t WalkFramePointers(uintptr_t instruction_pointer,
+                         uintptr_t stack_pointer,
+                         uintptr_t frame_pointer,
+                         uintptr_t stack_top,
+                         uintptr_t* frames,
+                         size_t max_frames) {
+  size_t frame_count = 0;
+  frames[frame_count++] = instruction_pointer;
+
+  // A frame record is the caller's frame pointer followed by the return
+  // address, on all the supported architectures.
+  const uintptr_t kRecordSize = 2 * sizeof(uintptr_t);
+  uintptr_t lowest_valid = stack_pointer;
+  while (frame_count < max_frames && frame_pointer >= lowest_valid &&
+         frame_pointer <= stack_top - kRecordSize &&
+         frame_pointer % sizeof(uintptr_t) == 0) {
+    const uintptr_t* record = reinterpret_cast<const uintptr_t*>(frame_pointer);
+    uintptr_t return_address = record[1];
+    if (!return_address)
+      break;
+    frames[frame_count++] = return_address;
+    lowest_valid = frame_pointer + kRecordSize;
+    frame_pointer = record[0];
+  }
+  return frame_count;
+}
+
+void HandleSampleSignal(int signal, siginfo_t* info, void* context) {
+  SampleRequest* request = g_request.Pointer();
+  if (subtle::Acquire_Load(&request->state) != SAMPLE_PENDING)
+    return;
+  int saved_errno = errno;
+  if (syscall(__NR_gettid) == request->thread_id &&
+      subtle::Acquire_CompareAndSwap(&request->state, SAMPLE_PENDING,
+                                     SAMPLE_RECORDING) == SAMPLE_PENDING) {
+    uintptr_t instruction_pointer = 0;
+    uintptr_t frame_pointer = 0;
+    GetRegisters(static_cast<ucontext_t*>(context), &instruction_pointer,
+                 &request->stack_pointer, &frame_pointer);
+    // Without a known stack top only the registers are recorded.
+    request->frame_count =
+        request->stack_top
+            ? WalkFramePointers(instruction_pointer, request->stack_pointer,
+                                frame_pointer, request->stack_top,
+                                request->frames, kMaxFrames)
+            : 0;
+    sem_post(&request->done);
+  }
+  errno = saved_errno;
+}
+
+// Installs the signal handler on first use. Must be called with the request
+// lock held.
+bool InitializeRequest(SampleRequest* request) {
+  if (request->initialized)
+    return true;
+  if (sem_init(&request->done, 0, 0) != 0)
+    return false;
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = &HandleSampleSignal;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  if (sigaction(kSampleSignal, &action, nullptr) != 0) {
+    DPLOG(ERROR) << "sigaction";
+    sem_destroy(&request->done);
+    return false;
+  }
+  request->initialized = true;
+  return true;
+}
+
+// Waits for the signal handler to post |semaphore|, or the timeout to expire.
+bool WaitForHandler(sem_t* semaphore) {
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_nsec += kSignalTimeoutMilliseconds * 1000000L;
+  deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+  deadline.tv_nsec %= 1000000000L;
+  return HANDLE_EINTR(sem_timedwait(semaphore, &deadline)) == 0;
+}
+
+// Interrupts |thread_id| to record its stack pointer and, if |stack_top| is
+// non-zero, its stack into |frames|. Returns false if the thread did not
+// respond.
+bool SignalThreadAndRecordStack(pid_t thread_id,
+                                uintptr_t stack_top,
+                                uintptr_t* stack_pointer,
+                                std::vector<uintptr_t>* frames) {
+  SampleRequest* request = g_request.Pointer();
+  AutoLock lock(request->lock);
+  if (!InitializeRequest(request))
+    return false;
+
+  request->thread_id = thread_id;
+  request->stack_top = stack_top;
+  request->frame_count = 0;
+  subtle::Release_Store(&request->state, SAMPLE_PENDING);
+
+  if (syscall(__NR_tgkill, getpid(), thread_id, kSampleSignal) != 0) {
+    subtle::Release_Store(&request->state, SAMPLE_IDLE);
+    return false;
+  }
+  if (!WaitForHandler(&request->done)) {
+    // Withdraw the request, unless the handler has just started on it, in
+    // which case it is about to finish.
+    if (subtle::Acquire_CompareAndSwap(&request->state, SAMPLE_PENDING,
+                                       SAMPLE_IDLE) == SAMPLE_PENDING) {
+      return false;
+    }
+    HANDLE_EINTR(sem_wait(&request->done));
+  }
+
+  *stack_pointer = request->stack_pointer;
+  frames->assign(request->frames, request->frames + request->frame_count);
+  subtle::Release_Store(&request->state, SAMPLE_IDLE);
+  return true;
+}
+
+// Returns the highest address of the stack holding |stack_pointer|, which
+// belongs to |thread_id|, or 0 if it cannot be determined.
+uintptr_t FindStackTop(pid_t thread_id, uintptr_t stack_pointer) {
+  // Thread stacks are each a single mapping.
+  std::string proc_maps;
+  std::vector<debug::MappedMemoryRegion> regions;
+  if (debug::ReadProcMaps(&proc_maps) &&
+      debug::ParseProcMaps(proc_maps, &regions)) {
+    for (const debug::MappedMemoryRegion& region : regions) {
+      if (stack_pointer >= region.start && stack_pointer < region.end)
+        return region.end;
+    }
+  }
+
+#if defined(__GLIBC__)
+  // /proc is not available in the sandbox, but the main thread's stack can
+  // still be found.
+  uintptr_t main_stack_end = reinterpret_cast<uintptr_t>(__libc_stack_end);
+  if (thread_id == getpid() && stack_pointer < main_stack_end)
+    return main_stack_end;
+#endif
+  return 0;
+}
+
+// Returns the build ID of the ELF module loaded at |base_address| as a hex
+// string, or an empty string if it has none.
+std::string GetBuildIDForModule(const void* base_address) {
+  const ElfW(Ehdr)* header = static_cast<const ElfW(Ehdr)*>(base_address);
+  if (memcmp(header->e_ident, ELFMAG, SELFMAG) != 0)
+    return std::string();
+
+  const char* base = static_cast<const char*>(base_address);
+  const ElfW(Phdr)* program_headers =
+      reinterpret_cast<const ElfW(Phdr)*>(base + header->e_phoff);
+
+  // Segment addresses are relative to the first loaded segment.
+  uintptr_t load_bias = reinterpret_cast<uintptr_t>(base_address);
+  for (int i = 0; i < header->e_phnum; ++i) {
+    if (program_headers[i].p_type == PT_LOAD &&
+        program_headers[i].p_offset == 0) {
+      load_bias -= program_headers[i].p_vaddr;
+      break;
+    }
+  }
+
+  for (int i = 0; i < header->e_phnum; ++i) {
+    const ElfW(Phdr)& segment = program_headers[i];
+    if (segment.p_type != PT_NOTE)
+      continue;
+    const char* note = reinterpret_cast<const char*>(load_bias +
+                                                     segment.p_vaddr);
+    const char* end = note + segment.p_memsz;
+    while (note + sizeof(ElfW(Nhdr)) <= end) {
+      const ElfW(Nhdr)* note_header = reinterpret_cast<const ElfW(Nhdr)*>(note);
+      const char* name = note + sizeof(ElfW(Nhdr));
+      const char* desc = name + ((note_header->n_namesz + 3) & ~3);
+      if (desc + note_header->n_descsz > end)
+        break;
+      if (note_header->n_type == NT_GNU_BUILD_ID &&
+          note_header->n_namesz == sizeof(ELF_NOTE_GNU) &&
+          memcmp(name, ELF_NOTE_GNU, sizeof(ELF_NOTE_GNU)) == 0) {
+        return HexEncode(desc, note_header->n_descsz);
+      }
+      note = desc + ((note_header->n_descsz + 3) & ~3);
+    }
+  }
+  return std::string();
+}
+
+// NativeStackSamplerPosix ----------------------------------------------------
+
+class NativeStackSamplerPosix : public NativeStackSampler {
+ public:
+  NativeStackSamplerPosix(pid_t thread_id,
+                          uintptr_t stack_top,
+                          NativeStackSamplerTestDelegate* test_delegate);
+  ~NativeStackSamplerPosix() override;
+
+  // StackSamplingProfiler::NativeStackSampler:
+  void ProfileRecordingStarting(
+      std::vector<StackSamplingProfiler::Module>* modules) override;
+  void RecordStackSample(StackSamplingProfiler::Sample* sample) override;
+  void ProfileRecordingStopped() override;
+
+ private:
+  // Gets the index for the Module containing |instruction_pointer| in
+  // |modules|, adding it if it's not already present. Returns
+  // StackSamplingProfiler::Frame::kUnknownModuleIndex if no Module can be
+  // determined.
+  size_t GetModuleIndex(uintptr_t instruction_pointer,
+                        std::vector<StackSamplingProfiler::Module>* modules);
+
+  const pid_t thread_id_;
+
+  // The highest address of the thread's stack.
+  const uintptr_t stack_top_;
+
+  NativeStackSamplerTestDelegate* const test_delegate_;
+
+  // Reused between samples to avoid allocations.
+  std::vector<uintptr_t> frames_;
+
+  // Weak. Points to the modules associated with the profile being recorded
+  // between ProfileRecordingStarting() and ProfileRecordingStopped().
+  std::vector<StackSamplingProfiler::Module>* current_modules_;
+
+  // Maps a module base address to the corresponding Module's index within
+  // current_modules_.
+  std::map<uintptr_t, size_t> profile_module_index_;
+
+  DISALLOW_COPY_AND_ASSIGN(NativeStackSamplerPosix);
+};
+
+NativeStackSamplerPosix::NativeStackSamplerPosix(
+    pid_t thread_id,
+    uintptr_t stack_top,
+    NativeStackSamplerTestDelegate* test_delegate)
+    : thread_id_(thread_id),
+      stack_top_(stack_top),
+      test_delegate_(test_delegate),
+      current_modules_(nullptr) {
+  frames_.reserve(kMaxFrames);
+}
+
+NativeStackSamplerPosix::~NativeStackSamplerPosix() {}
+
+void NativeStackSamplerPosix::ProfileRecordingStarting(
+    std::vector<StackSamplingProfiler::Module>* modules) {
+  current_modules_ = modules;
+  profile_module_index_.clear();
+}
+
+void NativeStackSamplerPosix::RecordStackSample(
+    StackSamplingProfiler::Sample* sample) {
+  DCHECK(current_modules_);
+
+  sample->clear();
+  uintptr_t stack_pointer;
+  if (!SignalThreadAndRecordStack(thread_id_, stack_top_, &stack_pointer,
+                                  &frames_)) {
+    return;
+  }
+
+  if (test_delegate_)
+    test_delegate_->OnPreStackWalk();
+
+  sample->reserve(frames_.size());
+  for (uintptr_t instruction_pointer : frames_) {
+    sample->push_back(StackSamplingProfiler::Frame(
+        instruction_pointer,
+        GetModuleIndex(instruction_pointer, current_modules_)));
+  }
+}
+
+void NativeStackSamplerPosix::ProfileRecordingStopped() {
+  current_modules_ = nullptr;
+}
+
+size_t NativeStackSamplerPosix::GetModuleIndex(
+    uintptr_t instruction_pointer,
+    std::vector<StackSamplingProfiler::Module>* modules) {
+  Dl_info info;
+  if (!dladdr(reinterpret_cast<void*>(instruction_pointer), &info) ||
+      !info.dli_fbase) {
+    return StackSamplingProfiler::Frame::kUnknownModuleIndex;
+  }
+
+  uintptr_t base_address = reinterpret_cast<uintptr_t>(info.dli_fbase);
+  auto loc = profile_module_index_.find(base_address);
+  if (loc == profile_module_index_.end()) {
+    modules->push_back(StackSamplingProfiler::Module(
+        base_address, GetBuildIDForModule(info.dli_fbase),
+        FilePath(info.dli_fname ? info.dli_fname : "")));
+    loc = profile_module_index_.insert(std::make_pair(
+        base_address, modules->size() - 1)).first;
+  }
+  return loc->second;
+}
+
+}  // namespace
+
+#endif  // defined(SIGNAL_STACK_SAMPLING_SUPPORTED)
+
 std::unique_ptr<NativeStackSampler> NativeStackSampler::Create(
     PlatformThreadId thread_id,
     NativeStackSamplerTestDelegate* test_delegate) {
+#if defined(SIGNAL_STACK_SAMPLING_SUPPORTED)
+  // Interrupt the thread once to find its stack, and make sure it handles
+  // the signal at all.
+  uintptr_t stack_pointer;
+  std::vector<uintptr_t> frames;
+  if (SignalThreadAndRecordStack(thread_id, 0, &stack_pointer, &frames)) {
+    uintptr_t stack_top = FindStackTop(thread_id, stack_pointer);
+    if (stack_top) {
+      return std::unique_ptr<NativeStackSampler>(
+          new NativeStackSamplerPosix(thread_id, stack_top, test_delegate));
+    }
+  }
+#endif
   return std::unique_ptr<NativeStackSampler>();
 }
 
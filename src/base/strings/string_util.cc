@@ -501,12 +501,14 @@ bool IsStringASCII(const StringPiece& str) {
   return DoIsStringASCII(str.data(), str.length());
 }
 
+// Only four UTF-16 characters fit in a machine word, so these use the
+// vectorized scan shared with the UTF converters.
 bool IsStringASCII(const StringPiece16& str) {
-  return DoIsStringASCII(str.data(), str.length());
+  return CountLeadingASCII(str.data(), str.length()) == str.length();
 }
 
 bool IsStringASCII(const string16& str) {
-  return DoIsStringASCII(str.data(), str.length());
+  return CountLeadingASCII(str.data(), str.length()) == str.length();
 }
 
 #if defined(WCHAR_T_IS_UTF32)
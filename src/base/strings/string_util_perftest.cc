@@ -0,0 +1,110 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/string_util.h"
+
+#include <stddef.h>
+
+#include <string>
+
+#include "base/strings/string16.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kBytesPerTrace = 64 * 1024 * 1024;
+
+// Lengths of a short header value, a typical URL and a long URL or cookie.
+const size_t kLengths[] = {24, 96, 1024};
+
+// Returns an ASCII string of |length| characters shaped like a URL.
+std::string CreateASCII(size_t length) {
+  std::string result = "https://www.example.com/";
+  while (result.length() < length)
+    result += "path/segment?query=value&";
+  result.resize(length);
+  return result;
+}
+
+// Returns CreateASCII(length) with a non-ASCII character in the middle, as in
+// an internationalized URL.
+std::string CreateMixed(size_t length) {
+  std::string result = CreateASCII(length);
+  result.replace(length / 2, 2, "\xC3\xA9");
+  return result;
+}
+
+// Runs |function| on |input| enough times to process kBytesPerTrace bytes and
+// prints the throughput.
+template <class Function>
+void Measure(const std::string& name,
+             size_t length,
+             size_t bytes_per_call,
+             const Function& function) {
+  const int iterations = kBytesPerTrace / static_cast<int>(bytes_per_call);
+  size_t checksum = 0;
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < iterations; ++i)
+    checksum += function();
+  TimeDelta elapsed = TimeTicks::Now() - start;
+  EXPECT_NE(0u, checksum);
+  perf_test::PrintResult(name, "", StringPrintf("%d", static_cast<int>(length)),
+                         kBytesPerTrace / elapsed.InSecondsF() / (1 << 20),
+                         "MB/s", true);
+}
+
+}  // namespace
+
+TEST(StringUtilPerfTest, IsStringASCII) {
+  for (size_t length : kLengths) {
+    std::string ascii = CreateASCII(length);
+    string16 ascii16 = ASCIIToUTF16(ascii);
+    Measure("is_string_ascii_8", length, length,
+            [&ascii]() { return IsStringASCII(ascii) ? 1u : 0u; });
+    Measure("is_string_ascii_16", length, length * sizeof(char16),
+            [&ascii16]() { return IsStringASCII(ascii16) ? 1u : 0u; });
+  }
+}
+
+TEST(StringUtilPerfTest, UTF8ToUTF16) {
+  for (size_t length : kLengths) {
+    std::string ascii = CreateASCII(length);
+    std::string mixed = CreateMixed(length);
+    string16 output;
+    Measure("utf8_to_utf16_ascii", length, length, [&ascii, &output]() {
+      UTF8ToUTF16(ascii.data(), ascii.length(), &output);
+      return output.length();
+    });
+    Measure("utf8_to_utf16_mixed", length, length, [&mixed, &output]() {
+      UTF8ToUTF16(mixed.data(), mixed.length(), &output);
+      return output.length();
+    });
+  }
+}
+
+TEST(StringUtilPerfTest, UTF16ToUTF8) {
+  for (size_t length : kLengths) {
+    string16 ascii = UTF8ToUTF16(CreateASCII(length));
+    string16 mixed = UTF8ToUTF16(CreateMixed(length));
+    std::string output;
+    Measure("utf16_to_utf8_ascii", length, length * sizeof(char16),
+            [&ascii, &output]() {
+              UTF16ToUTF8(ascii.data(), ascii.length(), &output);
+              return output.length();
+            });
+    Measure("utf16_to_utf8_mixed", length, length * sizeof(char16),
+            [&mixed, &output]() {
+              UTF16ToUTF8(mixed.data(), mixed.length(), &output);
+              return output.length();
+            });
+  }
+}
+
+}  // namespace base
@@ -4,7 +4,21 @@
 
 #include "base/strings/utf_string_conversion_utils.h"
 
+#include <stdint.h>
+#include <string.h>
+
 #include "base/third_party/icu/icu_utf.h"
+#include "build/build_config.h"
+
+// NaCl does not allow intrinsics.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#define ASCII_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && \
+    (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define ASCII_NEON
+#endif
 
 namespace base {
 
@@ -102,6 +116,110 @@ size_t WriteUnicodeCharacter(uint32_t code_point, string16* output) {
   return CBU16_MAX_LENGTH;
 }
 
+// ASCII fast paths ------------------------------------------------------------
+
+// The vector loops below handle whole 16-byte blocks and leave the rest of
+// the string, including the block holding the first non-ASCII character, to
+// the scalar loops.
+
+size_t CountLeadingASCII(const char* src, size_t src_len) {
+  size_t i = 0;
+#if defined(ASCII_SSE2)
+  for (; i + 16 <= src_len; i += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(block))
+      break;
+  }
+#elif defined(ASCII_NEON)
+  for (; i + 16 <= src_len; i += 16) {
+    uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x8_t folded = vorr_u8(vget_low_u8(block), vget_high_u8(block));
+    if (vget_lane_u64(vreinterpret_u64_u8(folded), 0) & 0x8080808080808080ULL)
+      break;
+  }
+#endif
+  // Check what is left a word at a time before the final few characters.
+  for (; i + sizeof(uint64_t) <= src_len; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, src + i, sizeof(word));
+    if (word & 0x8080808080808080ULL)
+      break;
+  }
+  while (i < src_len && static_cast<unsigned char>(src[i]) < 0x80)
+    ++i;
+  return i;
+}
+
+size_t CountLeadingASCII(const char16* src, size_t src_len) {
+  size_t i = 0;
+#if defined(ASCII_SSE2)
+  const __m128i non_ascii_mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 8 <= src_len; i += 8) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i non_ascii = _mm_and_si128(block, non_ascii_mask);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, zero)) != 0xFFFF)
+      break;
+  }
+#elif defined(ASCII_NEON)
+  for (; i + 8 <= src_len; i += 8) {
+    uint16x8_t block = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+    uint16x4_t folded = vorr_u16(vget_low_u16(block), vget_high_u16(block));
+    if (vget_lane_u64(vreinterpret_u64_u16(folded), 0) & 0xFF80FF80FF80FF80ULL)
+      break;
+  }
+#endif
+  while (i < src_len && src[i] < 0x80)
+    ++i;
+  return i;
+}
+
+void CopyASCII(const char* src, size_t src_len, char16* dest) {
+  size_t i = 0;
+#if defined(ASCII_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= src_len; i += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_unpacklo_epi8(block, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i + 8),
+                     _mm_unpackhi_epi8(block, zero));
+  }
+#elif defined(ASCII_NEON)
+  for (; i + 16 <= src_len; i += 16) {
+    uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint16_t* out = reinterpret_cast<uint16_t*>(dest + i);
+    vst1q_u16(out, vmovl_u8(vget_low_u8(block)));
+    vst1q_u16(out + 8, vmovl_u8(vget_high_u8(block)));
+  }
+#endif
+  for (; i < src_len; ++i)
+    dest[i] = static_cast<unsigned char>(src[i]);
+}
+
+void CopyASCII(const char16* src, size_t src_len, char* dest) {
+  size_t i = 0;
+#if defined(ASCII_SSE2)
+  for (; i + 16 <= src_len; i += 16) {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i high =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+    // The characters are ASCII, so packing never saturates.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_packus_epi16(low, high));
+  }
+#elif defined(ASCII_NEON)
+  for (; i + 16 <= src_len; i += 16) {
+    const uint16_t* in = reinterpret_cast<const uint16_t*>(src + i);
+    uint8x16_t block =
+        vcombine_u8(vmovn_u16(vld1q_u16(in)), vmovn_u16(vld1q_u16(in + 8)));
+    vst1q_u8(reinterpret_cast<uint8_t*>(dest + i), block);
+  }
+#endif
+  for (; i < src_len; ++i)
+    dest[i] = static_cast<char>(src[i]);
+}
+
 // Generalized Unicode converter -----------------------------------------------
 
 template<typename CHAR>
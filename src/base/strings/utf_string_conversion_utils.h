@@ -80,6 +80,18 @@ inline size_t WriteUnicodeCharacter(uint32_t code_point, std::wstring* output) {
 }
 #endif  // defined(WCHAR_T_IS_UTF32)
 
+// ASCII fast paths ------------------------------------------------------------
+
+// Returns the number of characters at the start of |src| that are ASCII. Uses
+// SSE2 or NEON where available, as most text converted is ASCII.
+BASE_EXPORT size_t CountLeadingASCII(const char* src, size_t src_len);
+BASE_EXPORT size_t CountLeadingASCII(const char16* src, size_t src_len);
+
+// Copies |src_len| characters from |src| to |dest|, which must have room for
+// them, widening or narrowing each one. All of them must be ASCII.
+BASE_EXPORT void CopyASCII(const char* src, size_t src_len, char16* dest);
+BASE_EXPORT void CopyASCII(const char16* src, size_t src_len, char* dest);
+
 // Generalized Unicode converter -----------------------------------------------
 
 // Guesses the length of the output in UTF-8 in bytes, clears that output
@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversion_utils.h"
@@ -41,6 +43,59 @@ bool ConvertUnicode(const SRC_CHAR* src,
   return success;
 }
 
+// Appends |src_len| ASCII characters from |src| to |output|. This goes through
+// a buffer on the stack since resizing |output| first would fill it with a
+// slow, character at a time loop for string16.
+template<typename SRC_CHAR, typename DEST_STRING>
+void AppendASCII(const SRC_CHAR* src, size_t src_len, DEST_STRING* output) {
+  const size_t kBufferSize = 256;
+  typename DEST_STRING::value_type buffer[kBufferSize];
+  while (src_len) {
+    size_t length = std::min(src_len, kBufferSize);
+    CopyASCII(src, length, buffer);
+    output->append(buffer, length);
+    src += length;
+    src_len -= length;
+  }
+}
+
+// Like ConvertUnicode above, but copies runs of ASCII characters in bulk,
+// which is most of the text converted between UTF-8 and UTF-16.
+template<typename SRC_CHAR, typename DEST_STRING>
+bool ConvertUnicodeWithASCIIRuns(const SRC_CHAR* src,
+                                 size_t src_len,
+                                 DEST_STRING* output) {
+  bool success = true;
+  int32_t src_len32 = static_cast<int32_t>(src_len);
+  for (int32_t i = 0; i < src_len32; i++) {
+    size_t ascii_length = CountLeadingASCII(src + i, src_len - i);
+    if (ascii_length) {
+      AppendASCII(src + i, ascii_length, output);
+      i += static_cast<int32_t>(ascii_length);
+      if (i == src_len32)
+        break;
+    }
+
+    uint32_t code_point;
+    if (ReadUnicodeCharacter(src, src_len32, &i, &code_point)) {
+      WriteUnicodeCharacter(code_point, output);
+    } else {
+      WriteUnicodeCharacter(0xFFFD, output);
+      success = false;
+    }
+  }
+
+  return success;
+}
+
+bool ConvertUnicode(const char* src, size_t src_len, string16* output) {
+  return ConvertUnicodeWithASCIIRuns(src, src_len, output);
+}
+
+bool ConvertUnicode(const char16* src, size_t src_len, std::string* output) {
+  return ConvertUnicodeWithASCIIRuns(src, src_len, output);
+}
+
 }  // namespace
 
 // UTF-8 <-> Wide --------------------------------------------------------------
@@ -147,43 +202,24 @@ std::wstring UTF16ToWide(const string16& utf16) {
 #if defined(WCHAR_T_IS_UTF32)
 
 bool UTF8ToUTF16(const char* src, size_t src_len, string16* output) {
-  if (IsStringASCII(StringPiece(src, src_len))) {
-    output->assign(src, src + src_len);
-    return true;
-  } else {
-    PrepareForUTF16Or32Output(src, src_len, output);
-    return ConvertUnicode(src, src_len, output);
-  }
+  PrepareForUTF16Or32Output(src, src_len, output);
+  return ConvertUnicode(src, src_len, output);
 }
 
 string16 UTF8ToUTF16(StringPiece utf8) {
-  if (IsStringASCII(utf8)) {
-    return string16(utf8.begin(), utf8.end());
-  }
-
   string16 ret;
-  PrepareForUTF16Or32Output(utf8.data(), utf8.length(), &ret);
   // Ignore the success flag of this call, it will do the best it can for
   // invalid input, which is what we want here.
-  ConvertUnicode(utf8.data(), utf8.length(), &ret);
+  UTF8ToUTF16(utf8.data(), utf8.length(), &ret);
   return ret;
 }
 
 bool UTF16ToUTF8(const char16* src, size_t src_len, std::string* output) {
-  if (IsStringASCII(StringPiece16(src, src_len))) {
-    output->assign(src, src + src_len);
-    return true;
-  } else {
-    PrepareForUTF8Output(src, src_len, output);
-    return ConvertUnicode(src, src_len, output);
-  }
+  PrepareForUTF8Output(src, src_len, output);
+  return ConvertUnicode(src, src_len, output);
 }
 
 std::string UTF16ToUTF8(StringPiece16 utf16) {
-  if (IsStringASCII(utf16)) {
-    return std::string(utf16.begin(), utf16.end());
-  }
-
   std::string ret;
   // Ignore the success flag of this call, it will do the best it can for
   // invalid input, which is what we want here.
@@ -220,12 +256,18 @@ std::string UTF16ToUTF8(StringPiece16 utf16) {
 
 string16 ASCIIToUTF16(StringPiece ascii) {
   DCHECK(IsStringASCII(ascii)) << ascii;
-  return string16(ascii.begin(), ascii.end());
+  string16 ret;
+  ret.reserve(ascii.length());
+  AppendASCII(ascii.data(), ascii.length(), &ret);
+  return ret;
 }
 
 std::string UTF16ToASCII(StringPiece16 utf16) {
   DCHECK(IsStringASCII(utf16)) << UTF16ToUTF8(utf16);
-  return std::string(utf16.begin(), utf16.end());
+  std::string ret;
+  ret.reserve(utf16.length());
+  AppendASCII(utf16.data(), utf16.length(), &ret);
+  return ret;
 }
 
 }  // namespace base
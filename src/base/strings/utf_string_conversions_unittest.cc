@@ -8,6 +8,7 @@
 #include "base/macros.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversion_utils.h"
 #include "base/strings/utf_string_conversions.h"
 #include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -208,4 +209,45 @@ TEST(UTFStringConversionsTest, ConvertMultiString) {
   EXPECT_EQ(expected, converted);
 }
 
+// Runs of ASCII are copied in blocks, so put a non-ASCII or invalid character
+// at every position of strings that span several blocks.
+TEST(UTFStringConversionsTest, ConvertASCIIRuns) {
+  const size_t kLength = 300;
+  const std::string ascii(kLength, 'a');
+  const string16 ascii16(kLength, 'a');
+  EXPECT_EQ(ascii16, UTF8ToUTF16(ascii));
+  EXPECT_EQ(ascii, UTF16ToUTF8(ascii16));
+  EXPECT_EQ(ascii16, ASCIIToUTF16(ascii));
+  EXPECT_EQ(ascii, UTF16ToASCII(ascii16));
+  EXPECT_EQ(kLength, CountLeadingASCII(ascii.data(), kLength));
+  EXPECT_EQ(kLength, CountLeadingASCII(ascii16.data(), kLength));
+
+  for (size_t i = 0; i < 40; ++i) {
+    std::string utf8 = ascii;
+    utf8.replace(i, 1, "\xC3\xA9");
+    string16 utf16 = ascii16;
+    utf16[i] = 0xE9;
+    EXPECT_EQ(i, CountLeadingASCII(utf8.data(), utf8.length()));
+    EXPECT_EQ(i, CountLeadingASCII(utf16.data(), utf16.length()));
+    EXPECT_FALSE(IsStringASCII(utf16));
+    EXPECT_EQ(utf16, UTF8ToUTF16(utf8)) << i;
+    EXPECT_EQ(utf8, UTF16ToUTF8(utf16)) << i;
+
+    // An unpaired surrogate in UTF-16 and a truncated sequence in UTF-8 are
+    // replaced without losing the ASCII around them.
+    utf16[i] = 0xD800;
+    std::string converted;
+    EXPECT_FALSE(UTF16ToUTF8(utf16.data(), utf16.length(), &converted));
+    EXPECT_EQ(ascii.substr(0, i) + "\xEF\xBF\xBD" + ascii.substr(i + 1),
+              converted);
+    utf8 = ascii;
+    utf8[i] = '\xC3';
+    string16 converted16;
+    EXPECT_FALSE(UTF8ToUTF16(utf8.data(), utf8.length(), &converted16));
+    utf16 = ascii16;
+    utf16[i] = 0xFFFD;
+    EXPECT_EQ(utf16, converted16) << i;
+  }
+}
+
 }  // namespace base
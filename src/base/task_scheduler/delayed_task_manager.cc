@@ -4,7 +4,9 @@
 
 #include "base/task_scheduler/delayed_task_manager.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/task_scheduler/scheduler_worker_pool.h"
@@ -12,6 +14,31 @@
 namespace base {
 namespace internal {
 
+namespace {
+
+// Granularity of the slots of the timer wheel holding delayed tasks.
+const int64_t kTimerWheelTickMs = 1;
+
+// Returns |delayed_run_time| rounded up to a multiple of the largest power of
+// two number of milliseconds that doesn't exceed |leeway|. Tasks whose delayed
+// run times fall in the same window of that size get the same coalesced run
+// time, which is never more than |leeway| after |delayed_run_time|.
+TimeTicks GetCoalescedRunTime(TimeTicks delayed_run_time, TimeDelta leeway) {
+  const int64_t leeway_us = leeway.InMicroseconds();
+  int64_t window_us = Time::kMicrosecondsPerMillisecond;
+  if (leeway_us < window_us)
+    return delayed_run_time;
+  while (window_us <= leeway_us / 2)
+    window_us *= 2;
+
+  const int64_t run_time_us = (delayed_run_time - TimeTicks()).InMicroseconds();
+  const int64_t coalesced_run_time_us =
+      (run_time_us + window_us - 1) / window_us * window_us;
+  return TimeTicks() + TimeDelta::FromMicroseconds(coalesced_run_time_us);
+}
+
+}  // namespace
+
 struct DelayedTaskManager::DelayedTask {
   DelayedTask(std::unique_ptr<Task> task,
               scoped_refptr<Sequence> sequence,
@@ -61,17 +88,23 @@ void DelayedTaskManager::AddDelayedTask(std::unique_ptr<Task> task,
   DCHECK(sequence);
   DCHECK(worker_pool);
 
-  const TimeTicks new_task_delayed_run_time = task->delayed_run_time;
+  const TimeTicks new_task_delayed_run_time =
+      GetCoalescedRunTime(task->delayed_run_time, task->traits.leeway());
   TimeTicks current_delayed_run_time;
 
   {
     AutoSchedulerLock auto_lock(lock_);
 
-    if (!delayed_tasks_.empty())
-      current_delayed_run_time = delayed_tasks_.top().task->delayed_run_time;
+    if (!delayed_tasks_) {
+      delayed_tasks_.reset(new TimerWheel<DelayedTask>(
+          Now(), TimeDelta::FromMilliseconds(kTimerWheelTickMs)));
+    }
 
-    delayed_tasks_.emplace(std::move(task), std::move(sequence), worker,
-                           worker_pool, ++delayed_task_index_);
+    current_delayed_run_time = delayed_tasks_->GetNextFireTime();
+    delayed_tasks_->Insert(
+        new_task_delayed_run_time,
+        DelayedTask(std::move(task), std::move(sequence), worker, worker_pool,
+                    ++delayed_task_index_));
   }
 
   if (current_delayed_run_time.is_null() ||
@@ -90,17 +123,14 @@ void DelayedTaskManager::PostReadyTasks() {
 
   {
     AutoSchedulerLock auto_lock(lock_);
-    while (!delayed_tasks_.empty() &&
-           delayed_tasks_.top().task->delayed_run_time <= now) {
-      // The const_cast for std::move is okay since we're immediately popping
-      // the task from |delayed_tasks_|. See DelayedTaskComparator::operator()
-      // for minor debug-check implications.
-      ready_tasks.push_back(
-          std::move(const_cast<DelayedTask&>(delayed_tasks_.top())));
-      delayed_tasks_.pop();
-    }
+    if (delayed_tasks_)
+      delayed_tasks_->AdvanceTo(now, &ready_tasks);
   }
 
+  // The timer wheel doesn't order the Tasks that become ripe for execution at
+  // the same time. Sort them to preserve the order of Tasks within a Sequence.
+  std::sort(ready_tasks.begin(), ready_tasks.end(), DelayedTaskComparator());
+
   // Post delayed tasks that are ready for execution.
   for (auto& delayed_task : ready_tasks) {
     delayed_task.worker_pool->PostTaskWithSequenceNow(
@@ -112,37 +142,22 @@ void DelayedTaskManager::PostReadyTasks() {
 TimeTicks DelayedTaskManager::GetDelayedRunTime() const {
   AutoSchedulerLock auto_lock(lock_);
 
-  if (delayed_tasks_.empty())
+  if (!delayed_tasks_)
     return TimeTicks();
 
-  return delayed_tasks_.top().task->delayed_run_time;
+  return delayed_tasks_->GetNextFireTime();
 }
 
-// In std::priority_queue, the largest element is on top. Therefore, this
-// comparator returns true if the delayed run time of |right| is earlier than
-// the delayed run time of |left|.
 bool DelayedTaskManager::DelayedTaskComparator::operator()(
     const DelayedTask& left,
     const DelayedTask& right) const {
-#ifndef NDEBUG
-  // Due to STL consistency checks in Windows and const_cast'ing right before
-  // popping the DelayedTask, a null task can be passed to this comparator in
-  // Debug builds. To satisfy these consistency checks, this comparator
-  // considers null tasks to be the larger than anything.
-  DCHECK(left.task || right.task);
-  if (!left.task)
-    return false;
-  if (!right.task)
-    return true;
-#else
   DCHECK(left.task);
   DCHECK(right.task);
-#endif  // NDEBUG
-  if (left.task->delayed_run_time > right.task->delayed_run_time)
-    return true;
   if (left.task->delayed_run_time < right.task->delayed_run_time)
+    return true;
+  if (left.task->delayed_run_time > right.task->delayed_run_time)
     return false;
-  return left.index > right.index;
+  return left.index < right.index;
 }
 
 TimeTicks DelayedTaskManager::Now() const {
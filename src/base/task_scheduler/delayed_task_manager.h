@@ -8,8 +8,6 @@
 #include <stdint.h>
 
 #include <memory>
-#include <queue>
-#include <vector>
 
 #include "base/base_export.h"
 #include "base/callback.h"
@@ -18,6 +16,7 @@
 #include "base/task_scheduler/scheduler_lock.h"
 #include "base/task_scheduler/sequence.h"
 #include "base/task_scheduler/task.h"
+#include "base/task_scheduler/timer_wheel.h"
 #include "base/time/time.h"
 
 namespace base {
@@ -27,7 +26,10 @@ class SchedulerWorker;
 class SchedulerWorkerPool;
 
 // A DelayedTaskManager holds delayed Tasks until they become ripe for
-// execution. This class is thread-safe.
+// execution. A Task becomes ripe for execution at its delayed run time rounded
+// up to a window that doesn't exceed the leeway of its traits, so that Tasks
+// whose delayed run times fall in the same window are posted together. This
+// class is thread-safe.
 class BASE_EXPORT DelayedTaskManager {
  public:
   // |on_delayed_run_time_updated| is invoked when the delayed run time is
@@ -37,7 +39,10 @@ class BASE_EXPORT DelayedTaskManager {
 
   // Adds |task| to a queue of delayed tasks. The task will be posted to
   // |worker_pool| with |sequence| and |worker| the first time that
-  // PostReadyTasks() is called while Now() is passed |task->delayed_run_time|.
+  // PostReadyTasks() is called while Now() is passed the coalesced run time of
+  // |task|: |task->delayed_run_time| rounded up to a multiple of the largest
+  // power of two number of milliseconds that doesn't exceed
+  // |task->traits.leeway()|.
   // |worker| is a SchedulerWorker owned by |worker_pool| or nullptr.
   //
   // TODO(robliao): Find a concrete way to manage the memory of |worker| and
@@ -48,7 +53,8 @@ class BASE_EXPORT DelayedTaskManager {
                       SchedulerWorker* worker,
                       SchedulerWorkerPool* worker_pool);
 
-  // Posts delayed tasks that are ripe for execution.
+  // Posts delayed tasks that are ripe for execution, in order of delayed run
+  // time.
   void PostReadyTasks();
 
   // Returns the next time at which a delayed task will become ripe for
@@ -61,6 +67,7 @@ class BASE_EXPORT DelayedTaskManager {
  private:
   struct DelayedTask;
   struct DelayedTaskComparator {
+    // Returns true if |left| must be posted before |right|.
     bool operator()(const DelayedTask& left, const DelayedTask& right) const;
   };
 
@@ -69,12 +76,9 @@ class BASE_EXPORT DelayedTaskManager {
   // Synchronizes access to all members below.
   mutable SchedulerLock lock_;
 
-  // Priority queue of delayed tasks. The delayed task with the smallest
-  // |task->delayed_run_time| is in front of the priority queue.
-  using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                               std::vector<DelayedTask>,
-                                               DelayedTaskComparator>;
-  DelayedTaskQueue delayed_tasks_;
+  // Delayed tasks keyed by coalesced run time. Created with the first delayed
+  // task so that its current time comes from Now().
+  std::unique_ptr<TimerWheel<DelayedTask>> delayed_tasks_;
 
   // The index to assign to the next delayed task added to the manager.
   uint64_t delayed_task_index_ = 0;
@@ -0,0 +1,178 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task_scheduler/delayed_task_manager.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/stringprintf.h"
+#include "base/task_scheduler/scheduler_worker_pool.h"
+#include "base/task_scheduler/sequence.h"
+#include "base/task_scheduler/task.h"
+#include "base/task_scheduler/task_traits.h"
+#include "base/task_scheduler/timer_wheel.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+const size_t kNumDelayedTasks = 100000;
+
+// Delayed tasks are spread over this period, like short network retries and
+// idle timeouts.
+const int kDelaySpreadSeconds = 10;
+
+// Returns a delay in [0, |kDelaySpreadSeconds|) for the |index|th delayed task.
+// Deterministic so that runs are comparable.
+TimeDelta GetDelay(size_t index) {
+  const uint64_t hash = (index + 1) * UINT64_C(0x9E3779B97F4A7C15);
+  return TimeDelta::FromMicroseconds(static_cast<int64_t>(
+      hash % (kDelaySpreadSeconds * Time::kMicrosecondsPerSecond)));
+}
+
+// A DelayedTaskManager whose time only advances when SetCurrentTime() is
+// called, to simulate the service thread without sleeping.
+class SimulatedDelayedTaskManager : public DelayedTaskManager {
+ public:
+  SimulatedDelayedTaskManager() : DelayedTaskManager(Bind(&DoNothing)) {}
+
+  void SetCurrentTime(TimeTicks now) { now_ = now; }
+
+  // DelayedTaskManager:
+  TimeTicks Now() const override { return now_; }
+
+ private:
+  TimeTicks now_ = TimeTicks::Now();
+
+  DISALLOW_COPY_AND_ASSIGN(SimulatedDelayedTaskManager);
+};
+
+// A SchedulerWorkerPool which counts the Tasks posted by a DelayedTaskManager.
+class CountingSchedulerWorkerPool : public SchedulerWorkerPool {
+ public:
+  CountingSchedulerWorkerPool() = default;
+
+  size_t num_posted_tasks() const { return num_posted_tasks_; }
+
+  // SchedulerWorkerPool:
+  scoped_refptr<TaskRunner> CreateTaskRunnerWithTraits(
+      const TaskTraits& traits,
+      ExecutionMode execution_mode) override {
+    NOTREACHED();
+    return nullptr;
+  }
+
+  void ReEnqueueSequence(scoped_refptr<Sequence> sequence,
+                         const SequenceSortKey& sequence_sort_key) override {
+    NOTREACHED();
+  }
+
+  bool PostTaskWithSequence(std::unique_ptr<Task> task,
+                            scoped_refptr<Sequence> sequence,
+                            SchedulerWorker* worker) override {
+    NOTREACHED();
+    return true;
+  }
+
+  void PostTaskWithSequenceNow(std::unique_ptr<Task> task,
+                               scoped_refptr<Sequence> sequence,
+                               SchedulerWorker* worker) override {
+    ++num_posted_tasks_;
+  }
+
+ private:
+  size_t num_posted_tasks_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingSchedulerWorkerPool);
+};
+
+// Adds |kNumDelayedTasks| delayed tasks with |leeway| to a DelayedTaskManager
+// and simulates the service thread waking up at each delayed run time until
+// all tasks are posted. Prints the number of wakeups per second of delay.
+void RunWakeUpsTest(TimeDelta leeway) {
+  SimulatedDelayedTaskManager manager;
+  CountingSchedulerWorkerPool worker_pool;
+  const TaskTraits traits = TaskTraits().WithLeeway(leeway);
+  const TimeTicks start_time = manager.Now();
+
+  for (size_t i = 0; i < kNumDelayedTasks; ++i) {
+    std::unique_ptr<Task> task(
+        new Task(FROM_HERE, Bind(&DoNothing), traits, TimeDelta()));
+    task->delayed_run_time = start_time + GetDelay(i);
+    manager.AddDelayedTask(std::move(task), make_scoped_refptr(new Sequence),
+                           nullptr, &worker_pool);
+  }
+
+  size_t num_wakeups = 0;
+  for (TimeTicks next_time = manager.GetDelayedRunTime(); !next_time.is_null();
+       next_time = manager.GetDelayedRunTime()) {
+    manager.SetCurrentTime(next_time);
+    manager.PostReadyTasks();
+    ++num_wakeups;
+  }
+  EXPECT_EQ(kNumDelayedTasks, worker_pool.num_posted_tasks());
+
+  perf_test::PrintResult(
+      "delayed_task_manager_wakeups", "",
+      StringPrintf("leeway_%dms", static_cast<int>(leeway.InMilliseconds())),
+      static_cast<double>(num_wakeups) / kDelaySpreadSeconds, "wakeups/s",
+      true);
+}
+
+}  // namespace
+
+// Measures how many times the service thread wakes up per second for short
+// delayed tasks, depending on the leeway of their traits.
+TEST(TaskSchedulerDelayedTaskManagerPerfTest, WakeUps) {
+  RunWakeUpsTest(TimeDelta());
+  RunWakeUpsTest(TimeDelta::FromMilliseconds(4));
+  RunWakeUpsTest(TimeDelta::FromMilliseconds(16));
+  RunWakeUpsTest(TimeDelta::FromMilliseconds(64));
+}
+
+// Measures the cost of inserting and cancelling values in the TimerWheel
+// backing the DelayedTaskManager.
+TEST(TaskSchedulerDelayedTaskManagerPerfTest, TimerWheelInsertCancel) {
+  const TimeTicks start_time = TimeTicks::Now();
+  TimerWheel<size_t> wheel(start_time, TimeDelta::FromMilliseconds(1));
+  std::vector<TimerWheel<size_t>::Handle> handles;
+  handles.reserve(kNumDelayedTasks);
+
+  const TimeTicks insert_start = TimeTicks::Now();
+  for (size_t i = 0; i < kNumDelayedTasks; ++i)
+    handles.push_back(wheel.Insert(start_time + GetDelay(i), i));
+  const TimeDelta insert_time = TimeTicks::Now() - insert_start;
+
+  const TimeTicks cancel_start = TimeTicks::Now();
+  for (TimerWheel<size_t>::Handle handle : handles)
+    EXPECT_TRUE(wheel.Cancel(handle));
+  const TimeDelta cancel_time = TimeTicks::Now() - cancel_start;
+  EXPECT_TRUE(wheel.empty());
+
+  perf_test::PrintResult("timer_wheel", "", "insert",
+                         insert_time.InMillisecondsF() * 1000000 /
+                             kNumDelayedTasks,
+                         "ns/op", true);
+  perf_test::PrintResult("timer_wheel", "", "cancel",
+                         cancel_time.InMillisecondsF() * 1000000 /
+                             kNumDelayedTasks,
+                         "ns/op", true);
+}
+
+}  // namespace internal
+}  // namespace base
@@ -241,5 +241,64 @@ TEST(TaskSchedulerDelayedTaskManagerTest, AddAndPostReadyTasks) {
   EXPECT_EQ(TimeTicks(), manager.GetDelayedRunTime());
 }
 
+// Verify that delayed tasks whose delayed run times fall in the same leeway
+// window are posted together, in order of delayed run time.
+TEST(TaskSchedulerDelayedTaskManagerTest, CoalesceTasksWithLeeway) {
+  testing::StrictMock<TestDelayedTaskManager> manager;
+
+  // Start on a multiple of 16 ms so that the leeway windows are predictable.
+  const TimeTicks start_time = TimeTicks() + TimeDelta::FromSeconds(100);
+  manager.SetCurrentTime(start_time);
+
+  scoped_refptr<Sequence> sequence(new Sequence);
+  testing::StrictMock<MockSchedulerWorkerPool> worker_pool;
+  const TaskTraits traits_with_leeway =
+      TaskTraits().WithLeeway(TimeDelta::FromMilliseconds(16));
+
+  std::unique_ptr<Task> task_a(
+      new Task(FROM_HERE, Bind(&DoNothing), traits_with_leeway, TimeDelta()));
+  task_a->delayed_run_time = start_time + TimeDelta::FromMilliseconds(10);
+  const Task* task_a_raw = task_a.get();
+
+  std::unique_ptr<Task> task_b(
+      new Task(FROM_HERE, Bind(&DoNothing), traits_with_leeway, TimeDelta()));
+  task_b->delayed_run_time = start_time + TimeDelta::FromMilliseconds(1);
+  const Task* task_b_raw = task_b.get();
+
+  std::unique_ptr<Task> task_c(
+      new Task(FROM_HERE, Bind(&DoNothing), TaskTraits(), TimeDelta()));
+  task_c->delayed_run_time = start_time + TimeDelta::FromMilliseconds(20);
+  const Task* task_c_raw = task_c.get();
+
+  // |task_a| and |task_b| are coalesced at the end of their 16 ms window.
+  EXPECT_CALL(manager, OnDelayedRunTimeUpdated());
+  manager.AddDelayedTask(std::move(task_a), sequence, nullptr, &worker_pool);
+  manager.AddDelayedTask(std::move(task_b), sequence, nullptr, &worker_pool);
+  manager.AddDelayedTask(std::move(task_c), sequence, nullptr, &worker_pool);
+  testing::Mock::VerifyAndClear(&manager);
+  const TimeTicks coalesced_run_time =
+      start_time + TimeDelta::FromMilliseconds(16);
+  EXPECT_EQ(coalesced_run_time, manager.GetDelayedRunTime());
+
+  // Nothing is posted before the coalesced run time, even though the delayed
+  // run times of |task_a| and |task_b| have expired.
+  manager.SetCurrentTime(coalesced_run_time - TimeDelta::FromMicroseconds(1));
+  manager.PostReadyTasks();
+  testing::Mock::VerifyAndClear(&worker_pool);
+
+  // |task_b| and |task_a| are posted in order of delayed run time.
+  manager.SetCurrentTime(coalesced_run_time);
+  {
+    testing::InSequence in_sequence;
+    EXPECT_CALL(worker_pool, PostTaskWithSequenceNowMock(
+                                 task_b_raw, sequence.get(), nullptr));
+    EXPECT_CALL(worker_pool, PostTaskWithSequenceNowMock(
+                                 task_a_raw, sequence.get(), nullptr));
+  }
+  manager.PostReadyTasks();
+  testing::Mock::VerifyAndClear(&worker_pool);
+  EXPECT_EQ(task_c_raw->delayed_run_time, manager.GetDelayedRunTime());
+}
+
 }  // namespace internal
 }  // namespace base
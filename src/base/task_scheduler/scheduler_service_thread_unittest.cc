@@ -56,6 +56,7 @@ class TaskSchedulerServiceThreadTest : public testing::Test {
     scheduler_worker_pool_ = SchedulerWorkerPoolImpl::Create(
         "TestWorkerPoolForSchedulerServiceThread", ThreadPriority::BACKGROUND,
         1u, SchedulerWorkerPoolImpl::IORestriction::DISALLOWED,
+        SchedulerWorkerPoolImpl::WorkStealing::DISABLED,
         Bind(&ReEnqueueSequenceCallback), &task_tracker_,
         &delayed_task_manager_);
     ASSERT_TRUE(scheduler_worker_pool_);
@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <initializer_list>
 #include <utility>
 
 #include "base/bind.h"
@@ -35,6 +36,11 @@ LazyInstance<ThreadLocalPointer<const SchedulerWorker>>::Leaky
 LazyInstance<ThreadLocalPointer<const SchedulerWorkerPool>>::Leaky
     tls_current_worker_pool = LAZY_INSTANCE_INITIALIZER;
 
+// Local PriorityQueue of the SchedulerWorker that owns the current thread, if
+// it belongs to a SchedulerWorkerPoolImpl with work stealing enabled.
+LazyInstance<ThreadLocalPointer<PriorityQueue>>::Leaky
+    tls_current_local_priority_queue = LAZY_INSTANCE_INITIALIZER;
+
 // A task runner that runs tasks with the PARALLEL ExecutionMode.
 class SchedulerParallelTaskRunner : public TaskRunner {
  public:
@@ -184,7 +190,8 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
   // called with a non-single-threaded Sequence. |shared_priority_queue| is a
   // PriorityQueue whose transactions may overlap with the worker's
   // single-threaded PriorityQueue's transactions. |index| will be appended to
-  // the pool name to label the underlying worker threads.
+  // the pool name to label the underlying worker threads and is the position
+  // of the worker in |outer->workers_|.
   SchedulerWorkerDelegateImpl(
       SchedulerWorkerPoolImpl* outer,
       const ReEnqueueSequenceCallback& re_enqueue_sequence_callback,
@@ -196,6 +203,8 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
     return &single_threaded_priority_queue_;
   }
 
+  PriorityQueue* local_priority_queue() { return &local_priority_queue_; }
+
   // SchedulerWorker::Delegate:
   void OnMainEntry(SchedulerWorker* worker) override;
   scoped_refptr<Sequence> GetWork(SchedulerWorker* worker) override;
@@ -204,12 +213,24 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
   bool CanDetach(SchedulerWorker* worker) override;
 
  private:
+  // Pops the most important Sequence from |outer_->shared_priority_queue_|,
+  // |single_threaded_priority_queue_| and |local_priority_queue_|. If they are
+  // all empty, returns nullptr and, if |add_to_idle_workers_stack_if_empty| is
+  // true, adds |worker| to |outer_->idle_workers_stack_|.
+  scoped_refptr<Sequence> PopSequence(SchedulerWorker* worker,
+                                      bool add_to_idle_workers_stack_if_empty);
+
   SchedulerWorkerPoolImpl* outer_;
   const ReEnqueueSequenceCallback re_enqueue_sequence_callback_;
 
   // Single-threaded PriorityQueue for the worker.
   PriorityQueue single_threaded_priority_queue_;
 
+  // PriorityQueue in which the worker keeps the Sequences it re-enqueues in
+  // |outer_| when work stealing is enabled. Other workers of |outer_| may pop
+  // Sequences from it.
+  PriorityQueue local_priority_queue_;
+
   // True if the last Sequence returned by GetWork() was extracted from
   // |single_threaded_priority_queue_|.
   bool last_sequence_is_single_threaded_ = false;
@@ -231,12 +252,13 @@ std::unique_ptr<SchedulerWorkerPoolImpl> SchedulerWorkerPoolImpl::Create(
     ThreadPriority thread_priority,
     size_t max_threads,
     IORestriction io_restriction,
+    WorkStealing work_stealing,
     const ReEnqueueSequenceCallback& re_enqueue_sequence_callback,
     TaskTracker* task_tracker,
     DelayedTaskManager* delayed_task_manager) {
   std::unique_ptr<SchedulerWorkerPoolImpl> worker_pool(
-      new SchedulerWorkerPoolImpl(name, io_restriction, task_tracker,
-                                  delayed_task_manager));
+      new SchedulerWorkerPoolImpl(name, io_restriction, work_stealing,
+                                  task_tracker, delayed_task_manager));
   if (worker_pool->Initialize(thread_priority, max_threads,
                               re_enqueue_sequence_callback)) {
     return worker_pool;
@@ -291,6 +313,21 @@ scoped_refptr<TaskRunner> SchedulerWorkerPoolImpl::CreateTaskRunnerWithTraits(
 void SchedulerWorkerPoolImpl::ReEnqueueSequence(
     scoped_refptr<Sequence> sequence,
     const SequenceSortKey& sequence_sort_key) {
+  if (work_stealing_ == WorkStealing::ENABLED &&
+      tls_current_worker_pool.Get().Get() == this) {
+    // The thread calling this method is a worker of this pool. Keep |sequence|
+    // in its local PriorityQueue to avoid contention on
+    // |shared_priority_queue_|. There is no need to wake up another worker:
+    // the current worker wakes up a peer in GetWork() if it leaves Sequences
+    // behind in its local PriorityQueue.
+    PriorityQueue* const local_priority_queue =
+        tls_current_local_priority_queue.Get().Get();
+    DCHECK(local_priority_queue);
+    local_priority_queue->BeginTransaction()->Push(std::move(sequence),
+                                                   sequence_sort_key);
+    return;
+  }
+
   shared_priority_queue_.BeginTransaction()->Push(std::move(sequence),
                                                   sequence_sort_key);
 
@@ -377,6 +414,7 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
     : outer_(outer),
       re_enqueue_sequence_callback_(re_enqueue_sequence_callback),
       single_threaded_priority_queue_(shared_priority_queue),
+      local_priority_queue_(&single_threaded_priority_queue_),
       index_(index) {}
 
 SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
@@ -384,12 +422,10 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
 
 void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::OnMainEntry(
     SchedulerWorker* worker) {
-#if DCHECK_IS_ON()
   // Wait for |outer_->workers_created_| to avoid traversing
   // |outer_->workers_| while it is being filled by Initialize().
   outer_->workers_created_.Wait();
   DCHECK(ContainsWorker(outer_->workers_, worker));
-#endif
 
   PlatformThread::SetName(
       StringPrintf("%sWorker%d", outer_->name_.c_str(), index_));
@@ -398,6 +434,8 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::OnMainEntry(
   DCHECK(!tls_current_worker_pool.Get().Get());
   tls_current_worker.Get().Set(worker);
   tls_current_worker_pool.Get().Set(outer_);
+  if (outer_->work_stealing_ == WorkStealing::ENABLED)
+    tls_current_local_priority_queue.Get().Set(&local_priority_queue_);
 
   ThreadRestrictions::SetIOAllowed(outer_->io_restriction_ ==
                                    IORestriction::ALLOWED);
@@ -408,54 +446,31 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
     SchedulerWorker* worker) {
   DCHECK(ContainsWorker(outer_->workers_, worker));
 
-  scoped_refptr<Sequence> sequence;
-  {
-    std::unique_ptr<PriorityQueue::Transaction> shared_transaction(
-        outer_->shared_priority_queue_.BeginTransaction());
-    std::unique_ptr<PriorityQueue::Transaction> single_threaded_transaction(
-        single_threaded_priority_queue_.BeginTransaction());
-
-    if (shared_transaction->IsEmpty() &&
-        single_threaded_transaction->IsEmpty()) {
-      single_threaded_transaction.reset();
+  const bool work_stealing_enabled =
+      outer_->work_stealing_ == WorkStealing::ENABLED;
 
-      // |shared_transaction| is kept alive while |worker| is added to
-      // |idle_workers_stack_| to avoid this race:
-      // 1. This thread creates a Transaction, finds |shared_priority_queue_|
-      //    empty and ends the Transaction.
-      // 2. Other thread creates a Transaction, inserts a Sequence into
-      //    |shared_priority_queue_| and ends the Transaction. This can't happen
-      //    if the Transaction of step 1 is still active because because there
-      //    can only be one active Transaction per PriorityQueue at a time.
-      // 3. Other thread calls WakeUpOneWorker(). No thread is woken up because
-      //    |idle_workers_stack_| is empty.
-      // 4. This thread adds itself to |idle_workers_stack_| and goes to sleep.
-      //    No thread runs the Sequence inserted in step 2.
-      outer_->AddToIdleWorkersStack(worker);
-      return nullptr;
-    }
+  scoped_refptr<Sequence> sequence =
+      PopSequence(worker, !work_stealing_enabled);
+  if (!sequence && work_stealing_enabled) {
+    sequence = outer_->StealSequence(static_cast<size_t>(index_));
+    last_sequence_is_single_threaded_ = false;
 
-    // True if both PriorityQueues have Sequences and the Sequence at the top of
-    // the shared PriorityQueue is more important.
-    const bool shared_sequence_is_more_important =
-        !shared_transaction->IsEmpty() &&
-        !single_threaded_transaction->IsEmpty() &&
-        shared_transaction->PeekSortKey() >
-            single_threaded_transaction->PeekSortKey();
-
-    if (single_threaded_transaction->IsEmpty() ||
-        shared_sequence_is_more_important) {
-      sequence = shared_transaction->PopSequence();
-      last_sequence_is_single_threaded_ = false;
-    } else {
-      DCHECK(!single_threaded_transaction->IsEmpty());
-      sequence = single_threaded_transaction->PopSequence();
-      last_sequence_is_single_threaded_ = true;
-    }
+    // Check the PriorityQueues again before going to sleep: a Sequence may have
+    // been posted while no Transaction was active.
+    if (!sequence)
+      sequence = PopSequence(worker, true);
   }
-  DCHECK(sequence);
+  if (!sequence)
+    return nullptr;
 
   outer_->RemoveFromIdleWorkersStack(worker);
+
+  // |worker| will only run |sequence| next. Wake up a peer to steal the
+  // Sequences left in |local_priority_queue_|, if any.
+  if (work_stealing_enabled &&
+      !local_priority_queue_.BeginTransaction()->IsEmpty()) {
+    outer_->WakeUpOneWorker();
+  }
   return sequence;
 }
 
@@ -484,22 +499,76 @@ bool SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::CanDetach(
   return false;
 }
 
+scoped_refptr<Sequence>
+SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::PopSequence(
+    SchedulerWorker* worker,
+    bool add_to_idle_workers_stack_if_empty) {
+  std::unique_ptr<PriorityQueue::Transaction> shared_transaction(
+      outer_->shared_priority_queue_.BeginTransaction());
+  std::unique_ptr<PriorityQueue::Transaction> single_threaded_transaction(
+      single_threaded_priority_queue_.BeginTransaction());
+  std::unique_ptr<PriorityQueue::Transaction> local_transaction;
+  if (outer_->work_stealing_ == WorkStealing::ENABLED)
+    local_transaction = local_priority_queue_.BeginTransaction();
+
+  // Select the PriorityQueue whose top Sequence is the most important. On a
+  // tie, the single-threaded PriorityQueue wins over the local PriorityQueue
+  // which wins over the shared PriorityQueue.
+  PriorityQueue::Transaction* selected_transaction = nullptr;
+  for (PriorityQueue::Transaction* transaction :
+       {single_threaded_transaction.get(), local_transaction.get(),
+        shared_transaction.get()}) {
+    if (!transaction || transaction->IsEmpty())
+      continue;
+    if (!selected_transaction ||
+        transaction->PeekSortKey() > selected_transaction->PeekSortKey()) {
+      selected_transaction = transaction;
+    }
+  }
+
+  if (!selected_transaction) {
+    if (add_to_idle_workers_stack_if_empty) {
+      local_transaction.reset();
+      single_threaded_transaction.reset();
+
+      // |shared_transaction| is kept alive while |worker| is added to
+      // |idle_workers_stack_| to avoid this race:
+      // 1. This thread creates a Transaction, finds |shared_priority_queue_|
+      //    empty and ends the Transaction.
+      // 2. Other thread creates a Transaction, inserts a Sequence into
+      //    |shared_priority_queue_| and ends the Transaction. This can't happen
+      //    if the Transaction of step 1 is still active because because there
+      //    can only be one active Transaction per PriorityQueue at a time.
+      // 3. Other thread calls WakeUpOneWorker(). No thread is woken up because
+      //    |idle_workers_stack_| is empty.
+      // 4. This thread adds itself to |idle_workers_stack_| and goes to sleep.
+      //    No thread runs the Sequence inserted in step 2.
+      outer_->AddToIdleWorkersStack(worker);
+    }
+    return nullptr;
+  }
+
+  last_sequence_is_single_threaded_ =
+      selected_transaction == single_threaded_transaction.get();
+  return selected_transaction->PopSequence();
+}
+
 SchedulerWorkerPoolImpl::SchedulerWorkerPoolImpl(
     StringPiece name,
     IORestriction io_restriction,
+    WorkStealing work_stealing,
     TaskTracker* task_tracker,
     DelayedTaskManager* delayed_task_manager)
     : name_(name.as_string()),
       io_restriction_(io_restriction),
+      work_stealing_(work_stealing),
       idle_workers_stack_lock_(shared_priority_queue_.container_lock()),
       idle_workers_stack_cv_for_testing_(
           idle_workers_stack_lock_.CreateConditionVariable()),
       join_for_testing_returned_(WaitableEvent::ResetPolicy::MANUAL,
                                  WaitableEvent::InitialState::NOT_SIGNALED),
-#if DCHECK_IS_ON()
       workers_created_(WaitableEvent::ResetPolicy::MANUAL,
                        WaitableEvent::InitialState::NOT_SIGNALED),
-#endif
       task_tracker_(task_tracker),
       delayed_task_manager_(delayed_task_manager) {
   DCHECK(task_tracker_);
@@ -528,9 +597,7 @@ bool SchedulerWorkerPoolImpl::Initialize(
     workers_.push_back(std::move(worker));
   }
 
-#if DCHECK_IS_ON()
   workers_created_.Signal();
-#endif
 
   return !workers_.empty();
 }
@@ -561,5 +628,25 @@ void SchedulerWorkerPoolImpl::RemoveFromIdleWorkersStack(
   idle_workers_stack_.Remove(worker);
 }
 
+scoped_refptr<Sequence> SchedulerWorkerPoolImpl::StealSequence(
+    size_t thief_index) {
+  DCHECK_EQ(WorkStealing::ENABLED, work_stealing_);
+  DCHECK_LT(thief_index, workers_.size());
+
+  const size_t num_workers = workers_.size();
+  for (size_t i = 1; i < num_workers; ++i) {
+    // Because workers of this pool are created in Initialize(), the type of
+    // their delegate is SchedulerWorkerDelegateImpl.
+    SchedulerWorkerDelegateImpl* const victim =
+        static_cast<SchedulerWorkerDelegateImpl*>(
+            workers_[(thief_index + i) % num_workers]->delegate());
+    std::unique_ptr<PriorityQueue::Transaction> victim_transaction(
+        victim->local_priority_queue()->BeginTransaction());
+    if (!victim_transaction->IsEmpty())
+      return victim_transaction->PopSequence();
+  }
+  return nullptr;
+}
+
 }  // namespace internal
 }  // namespace base
@@ -43,6 +43,16 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
     DISALLOWED,
   };
 
+  enum class WorkStealing {
+    // All Sequences that aren't single-threaded go through
+    // |shared_priority_queue_|.
+    DISABLED,
+    // Sequences re-enqueued by a worker of this pool are kept in a
+    // PriorityQueue local to that worker. Idle workers steal from their
+    // peers' local PriorityQueues before going to sleep.
+    ENABLED,
+  };
+
   // Callback invoked when a Sequence isn't empty after a worker pops a Task
   // from it.
   using ReEnqueueSequenceCallback = Callback<void(scoped_refptr<Sequence>)>;
@@ -55,6 +65,8 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
   // Creates a SchedulerWorkerPoolImpl labeled |name| with up to |max_threads|
   // threads of priority |thread_priority|. |io_restriction| indicates whether
   // Tasks on the constructed worker pool are allowed to make I/O calls.
+  // |work_stealing| indicates whether workers keep the Sequences they
+  // re-enqueue in a local PriorityQueue from which idle peers can steal.
   // |re_enqueue_sequence_callback| will be invoked after a worker of this
   // worker pool tries to run a Task. |task_tracker| is used to handle shutdown
   // behavior of Tasks. |delayed_task_manager| handles Tasks posted with a
@@ -65,6 +77,7 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
       ThreadPriority thread_priority,
       size_t max_threads,
       IORestriction io_restriction,
+      WorkStealing work_stealing,
       const ReEnqueueSequenceCallback& re_enqueue_sequence_callback,
       TaskTracker* task_tracker,
       DelayedTaskManager* delayed_task_manager);
@@ -94,6 +107,7 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
 
   SchedulerWorkerPoolImpl(StringPiece name,
                           IORestriction io_restriction,
+                          WorkStealing work_stealing,
                           TaskTracker* task_tracker,
                           DelayedTaskManager* delayed_task_manager);
 
@@ -111,6 +125,13 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
   // Removes |worker| from |idle_workers_stack_|.
   void RemoveFromIdleWorkersStack(SchedulerWorker* worker);
 
+  // Pops a Sequence from the local PriorityQueue of one of the workers of this
+  // pool other than the worker at |thief_index| in |workers_|. Peers are
+  // visited in order, starting right after |thief_index|. Returns nullptr if
+  // all local PriorityQueues are empty. Must not be called with an active
+  // PriorityQueue Transaction.
+  scoped_refptr<Sequence> StealSequence(size_t thief_index);
+
   // The name of this worker pool, used to label its worker threads.
   const std::string name_;
 
@@ -131,6 +152,10 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
   // Indicates whether Tasks on this worker pool are allowed to make I/O calls.
   const IORestriction io_restriction_;
 
+  // Indicates whether workers of this pool keep the Sequences they re-enqueue
+  // in a local PriorityQueue.
+  const WorkStealing work_stealing_;
+
   // Synchronizes access to |idle_workers_stack_| and
   // |idle_workers_stack_cv_for_testing_|. Has |shared_priority_queue_|'s
   // lock as its predecessor so that a worker can be pushed to
@@ -147,10 +172,10 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
   // Signaled once JoinForTesting() has returned.
   WaitableEvent join_for_testing_returned_;
 
-#if DCHECK_IS_ON()
-  // Signaled when all workers have been created.
+  // Signaled when all workers have been created. Workers wait on it before
+  // entering their main loop so that |workers_| can be traversed without a
+  // lock when stealing.
   WaitableEvent workers_created_;
-#endif
 
   TaskTracker* const task_tracker_;
   DelayedTaskManager* const delayed_task_manager_;
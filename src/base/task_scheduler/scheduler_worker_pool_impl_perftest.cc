@@ -0,0 +1,134 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task_scheduler/scheduler_worker_pool_impl.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/sys_info.h"
+#include "base/task_runner.h"
+#include "base/task_scheduler/delayed_task_manager.h"
+#include "base/task_scheduler/sequence.h"
+#include "base/task_scheduler/sequence_sort_key.h"
+#include "base/task_scheduler/task_tracker.h"
+#include "base/task_scheduler/task_traits.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace internal {
+namespace {
+
+using WorkStealing = SchedulerWorkerPoolImpl::WorkStealing;
+
+// Number of SEQUENCED TaskRunners used to post tasks. Each Sequence gets
+// re-enqueued after every task, which is what work stealing optimizes.
+const size_t kNumSequences = 64;
+const size_t kNumTasksPerSequence = 2000;
+
+class TaskSchedulerWorkerPoolImplPerfTest
+    : public testing::TestWithParam<WorkStealing> {
+ protected:
+  TaskSchedulerWorkerPoolImplPerfTest()
+      : delayed_task_manager_(Bind(&DoNothing)),
+        all_tasks_ran_(WaitableEvent::ResetPolicy::AUTOMATIC,
+                       WaitableEvent::InitialState::NOT_SIGNALED) {}
+
+  // Runs |kNumSequences| * |kNumTasksPerSequence| empty tasks on a pool of
+  // |num_threads| threads and prints the number of tasks run per second.
+  void RunThroughputTest(size_t num_threads) {
+    worker_pool_ = SchedulerWorkerPoolImpl::Create(
+        "PerfTestWorkerPool", ThreadPriority::NORMAL, num_threads,
+        SchedulerWorkerPoolImpl::IORestriction::DISALLOWED, GetParam(),
+        Bind(&TaskSchedulerWorkerPoolImplPerfTest::ReEnqueueSequenceCallback,
+             Unretained(this)),
+        &task_tracker_, &delayed_task_manager_);
+    ASSERT_TRUE(worker_pool_);
+
+    std::vector<scoped_refptr<TaskRunner>> task_runners;
+    for (size_t i = 0; i < kNumSequences; ++i) {
+      task_runners.push_back(worker_pool_->CreateTaskRunnerWithTraits(
+          TaskTraits(), ExecutionMode::SEQUENCED));
+    }
+
+    const size_t num_tasks = kNumSequences * kNumTasksPerSequence;
+    subtle::NoBarrier_Store(&num_pending_tasks_,
+                            static_cast<subtle::Atomic32>(num_tasks));
+
+    const TimeTicks start = TimeTicks::Now();
+    for (size_t i = 0; i < kNumTasksPerSequence; ++i) {
+      for (const auto& task_runner : task_runners) {
+        task_runner->PostTask(
+            FROM_HERE, Bind(&TaskSchedulerWorkerPoolImplPerfTest::RunTask,
+                            Unretained(this)));
+      }
+    }
+    all_tasks_ran_.Wait();
+    const TimeDelta elapsed = TimeTicks::Now() - start;
+
+    worker_pool_->WaitForAllWorkersIdleForTesting();
+    worker_pool_->JoinForTesting();
+    worker_pool_.reset();
+
+    perf_test::PrintResult(
+        "task_throughput",
+        GetParam() == WorkStealing::ENABLED ? "_work_stealing" : "",
+        StringPrintf("threads_%u", static_cast<unsigned>(num_threads)),
+        num_tasks / elapsed.InSecondsF(), "tasks/s", true);
+  }
+
+ private:
+  void RunTask() {
+    if (!subtle::Barrier_AtomicIncrement(&num_pending_tasks_, -1))
+      all_tasks_ran_.Signal();
+  }
+
+  void ReEnqueueSequenceCallback(scoped_refptr<Sequence> sequence) {
+    const SequenceSortKey sort_key(sequence->GetSortKey());
+    worker_pool_->ReEnqueueSequence(std::move(sequence), sort_key);
+  }
+
+  TaskTracker task_tracker_;
+  DelayedTaskManager delayed_task_manager_;
+  std::unique_ptr<SchedulerWorkerPoolImpl> worker_pool_;
+
+  subtle::Atomic32 num_pending_tasks_ = 0;
+  WaitableEvent all_tasks_ran_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskSchedulerWorkerPoolImplPerfTest);
+};
+
+}  // namespace
+
+// Measures how the throughput of the pool scales with the number of threads,
+// up to the number of cores of the machine.
+TEST_P(TaskSchedulerWorkerPoolImplPerfTest, ThroughputByNumThreads) {
+  const size_t num_cores = static_cast<size_t>(SysInfo::NumberOfProcessors());
+  for (size_t num_threads = 1; num_threads < num_cores; num_threads *= 2)
+    RunThroughputTest(num_threads);
+  RunThroughputTest(num_cores);
+}
+
+INSTANTIATE_TEST_CASE_P(WorkStealingDisabled,
+                        TaskSchedulerWorkerPoolImplPerfTest,
+                        ::testing::Values(WorkStealing::DISABLED));
+INSTANTIATE_TEST_CASE_P(WorkStealingEnabled,
+                        TaskSchedulerWorkerPoolImplPerfTest,
+                        ::testing::Values(WorkStealing::ENABLED));
+
+}  // namespace internal
+}  // namespace base
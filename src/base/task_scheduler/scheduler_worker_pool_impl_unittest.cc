@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include <memory>
+#include <tuple>
 #include <unordered_set>
 #include <vector>
 
@@ -40,6 +41,7 @@ const size_t kNumThreadsPostingTasks = 4;
 const size_t kNumTasksPostedPerThread = 150;
 
 using IORestriction = SchedulerWorkerPoolImpl::IORestriction;
+using WorkStealing = SchedulerWorkerPoolImpl::WorkStealing;
 
 class TestDelayedTaskManager : public DelayedTaskManager {
  public:
@@ -57,14 +59,17 @@ class TestDelayedTaskManager : public DelayedTaskManager {
 };
 
 class TaskSchedulerWorkerPoolImplTest
-    : public testing::TestWithParam<ExecutionMode> {
+    : public testing::TestWithParam<std::tuple<ExecutionMode, WorkStealing>> {
  protected:
   TaskSchedulerWorkerPoolImplTest() = default;
 
+  ExecutionMode GetExecutionMode() const { return std::get<0>(GetParam()); }
+
   void SetUp() override {
     worker_pool_ = SchedulerWorkerPoolImpl::Create(
         "TestWorkerPoolWithFileIO", ThreadPriority::NORMAL,
         kNumWorkersInWorkerPool, IORestriction::ALLOWED,
+        std::get<1>(GetParam()),
         Bind(&TaskSchedulerWorkerPoolImplTest::ReEnqueueSequenceCallback,
              Unretained(this)),
         &task_tracker_, &delayed_task_manager_);
@@ -158,7 +163,7 @@ TEST_P(TaskSchedulerWorkerPoolImplTest, PostTasks) {
   std::vector<std::unique_ptr<ThreadPostingTasks>> threads_posting_tasks;
   for (size_t i = 0; i < kNumThreadsPostingTasks; ++i) {
     threads_posting_tasks.push_back(WrapUnique(new ThreadPostingTasks(
-        worker_pool_.get(), GetParam(), WaitBeforePostTask::NO_WAIT,
+        worker_pool_.get(), GetExecutionMode(), WaitBeforePostTask::NO_WAIT,
         PostNestedTask::NO)));
     threads_posting_tasks.back()->Start();
   }
@@ -181,7 +186,7 @@ TEST_P(TaskSchedulerWorkerPoolImplTest, PostTasksWaitAllWorkersIdle) {
   std::vector<std::unique_ptr<ThreadPostingTasks>> threads_posting_tasks;
   for (size_t i = 0; i < kNumThreadsPostingTasks; ++i) {
     threads_posting_tasks.push_back(WrapUnique(new ThreadPostingTasks(
-        worker_pool_.get(), GetParam(),
+        worker_pool_.get(), GetExecutionMode(),
         WaitBeforePostTask::WAIT_FOR_ALL_WORKERS_IDLE, PostNestedTask::NO)));
     threads_posting_tasks.back()->Start();
   }
@@ -203,7 +208,7 @@ TEST_P(TaskSchedulerWorkerPoolImplTest, NestedPostTasks) {
   std::vector<std::unique_ptr<ThreadPostingTasks>> threads_posting_tasks;
   for (size_t i = 0; i < kNumThreadsPostingTasks; ++i) {
     threads_posting_tasks.push_back(WrapUnique(new ThreadPostingTasks(
-        worker_pool_.get(), GetParam(), WaitBeforePostTask::NO_WAIT,
+        worker_pool_.get(), GetExecutionMode(), WaitBeforePostTask::NO_WAIT,
         PostNestedTask::YES)));
     threads_posting_tasks.back()->Start();
   }
@@ -228,8 +233,9 @@ TEST_P(TaskSchedulerWorkerPoolImplTest, PostTasksWithOneAvailableWorker) {
   std::vector<std::unique_ptr<test::TestTaskFactory>> blocked_task_factories;
   for (size_t i = 0; i < (kNumWorkersInWorkerPool - 1); ++i) {
     blocked_task_factories.push_back(WrapUnique(new test::TestTaskFactory(
-        worker_pool_->CreateTaskRunnerWithTraits(TaskTraits(), GetParam()),
-        GetParam())));
+        worker_pool_->CreateTaskRunnerWithTraits(TaskTraits(),
+                                                 GetExecutionMode()),
+        GetExecutionMode())));
     EXPECT_TRUE(blocked_task_factories.back()->PostTask(
         PostNestedTask::NO, Bind(&WaitableEvent::Wait, Unretained(&event))));
     blocked_task_factories.back()->WaitForAllTasksToRun();
@@ -238,8 +244,9 @@ TEST_P(TaskSchedulerWorkerPoolImplTest, PostTasksWithOneAvailableWorker) {
   // Post |kNumTasksPostedPerThread| tasks that should all run despite the fact
   // that only one worker in |worker_pool_| isn't busy.
   test::TestTaskFactory short_task_factory(
-      worker_pool_->CreateTaskRunnerWithTraits(TaskTraits(), GetParam()),
-      GetParam());
+      worker_pool_->CreateTaskRunnerWithTraits(TaskTraits(),
+                                               GetExecutionMode()),
+      GetExecutionMode());
   for (size_t i = 0; i < kNumTasksPostedPerThread; ++i)
     EXPECT_TRUE(short_task_factory.PostTask(PostNestedTask::NO, Closure()));
   short_task_factory.WaitForAllTasksToRun();
@@ -262,8 +269,9 @@ TEST_P(TaskSchedulerWorkerPoolImplTest, Saturate) {
   std::vector<std::unique_ptr<test::TestTaskFactory>> factories;
   for (size_t i = 0; i < kNumWorkersInWorkerPool; ++i) {
     factories.push_back(WrapUnique(new test::TestTaskFactory(
-        worker_pool_->CreateTaskRunnerWithTraits(TaskTraits(), GetParam()),
-        GetParam())));
+        worker_pool_->CreateTaskRunnerWithTraits(TaskTraits(),
+                                                 GetExecutionMode()),
+        GetExecutionMode())));
     EXPECT_TRUE(factories.back()->PostTask(
         PostNestedTask::NO, Bind(&WaitableEvent::Wait, Unretained(&event))));
     factories.back()->WaitForAllTasksToRun();
@@ -279,8 +287,8 @@ TEST_P(TaskSchedulerWorkerPoolImplTest, Saturate) {
 
 // Verify that a Task can't be posted after shutdown.
 TEST_P(TaskSchedulerWorkerPoolImplTest, PostTaskAfterShutdown) {
-  auto task_runner =
-      worker_pool_->CreateTaskRunnerWithTraits(TaskTraits(), GetParam());
+  auto task_runner = worker_pool_->CreateTaskRunnerWithTraits(
+      TaskTraits(), GetExecutionMode());
   task_tracker_.Shutdown();
   EXPECT_FALSE(task_runner->PostTask(FROM_HERE, Bind(&ShouldNotRunCallback)));
 }
@@ -293,7 +301,8 @@ TEST_P(TaskSchedulerWorkerPoolImplTest, PostDelayedTask) {
   // Post a delayed task.
   WaitableEvent task_ran(WaitableEvent::ResetPolicy::MANUAL,
                          WaitableEvent::InitialState::NOT_SIGNALED);
-  EXPECT_TRUE(worker_pool_->CreateTaskRunnerWithTraits(TaskTraits(), GetParam())
+  EXPECT_TRUE(worker_pool_
+                  ->CreateTaskRunnerWithTraits(TaskTraits(), GetExecutionMode())
                   ->PostDelayedTask(FROM_HERE, Bind(&WaitableEvent::Signal,
                                                     Unretained(&task_ran)),
                                     TimeDelta::FromSeconds(10)));
@@ -315,13 +324,22 @@ TEST_P(TaskSchedulerWorkerPoolImplTest, PostDelayedTask) {
 
 INSTANTIATE_TEST_CASE_P(Parallel,
                         TaskSchedulerWorkerPoolImplTest,
-                        ::testing::Values(ExecutionMode::PARALLEL));
+                        ::testing::Combine(
+                            ::testing::Values(ExecutionMode::PARALLEL),
+                            ::testing::Values(WorkStealing::DISABLED,
+                                              WorkStealing::ENABLED)));
 INSTANTIATE_TEST_CASE_P(Sequenced,
                         TaskSchedulerWorkerPoolImplTest,
-                        ::testing::Values(ExecutionMode::SEQUENCED));
+                        ::testing::Combine(
+                            ::testing::Values(ExecutionMode::SEQUENCED),
+                            ::testing::Values(WorkStealing::DISABLED,
+                                              WorkStealing::ENABLED)));
 INSTANTIATE_TEST_CASE_P(SingleThreaded,
                         TaskSchedulerWorkerPoolImplTest,
-                        ::testing::Values(ExecutionMode::SINGLE_THREADED));
+                        ::testing::Combine(
+                            ::testing::Values(ExecutionMode::SINGLE_THREADED),
+                            ::testing::Values(WorkStealing::DISABLED,
+                                              WorkStealing::ENABLED)));
 
 namespace {
 
@@ -364,8 +382,8 @@ TEST_P(TaskSchedulerWorkerPoolImplIORestrictionTest, IORestriction) {
 
   auto worker_pool = SchedulerWorkerPoolImpl::Create(
       "TestWorkerPoolWithParam", ThreadPriority::NORMAL, 1U, GetParam(),
-      Bind(&NotReachedReEnqueueSequenceCallback), &task_tracker,
-      &delayed_task_manager);
+      WorkStealing::DISABLED, Bind(&NotReachedReEnqueueSequenceCallback),
+      &task_tracker, &delayed_task_manager);
   ASSERT_TRUE(worker_pool);
 
   WaitableEvent task_ran(WaitableEvent::ResetPolicy::MANUAL,
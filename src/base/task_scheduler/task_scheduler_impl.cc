@@ -97,7 +97,8 @@ void TaskSchedulerImpl::Initialize(
     // can't be deleted before all its worker pools have been joined.
     worker_pools_.push_back(SchedulerWorkerPoolImpl::Create(
         worker_pool.name, worker_pool.thread_priority, worker_pool.max_threads,
-        worker_pool.io_restriction, re_enqueue_sequence_callback,
+        worker_pool.io_restriction, worker_pool.work_stealing,
+        re_enqueue_sequence_callback,
         &task_tracker_, &delayed_task_manager_));
     CHECK(worker_pools_.back());
   }
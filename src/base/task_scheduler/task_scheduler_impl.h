@@ -46,6 +46,9 @@ class BASE_EXPORT TaskSchedulerImpl : public TaskScheduler {
 
     // Maximum number of threads in the pool.
     size_t max_threads;
+
+    // Whether idle threads of the pool steal work from their peers.
+    SchedulerWorkerPoolImpl::WorkStealing work_stealing;
   };
 
   // Returns the index of the worker pool in which a task with |traits| should
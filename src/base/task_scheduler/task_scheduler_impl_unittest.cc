@@ -159,27 +159,30 @@ class TaskSchedulerImplTest
 
   void SetUp() override {
     using IORestriction = SchedulerWorkerPoolImpl::IORestriction;
+    using WorkStealing = SchedulerWorkerPoolImpl::WorkStealing;
 
     std::vector<TaskSchedulerImpl::WorkerPoolCreationArgs> worker_pools;
 
     ASSERT_EQ(BACKGROUND_WORKER_POOL, worker_pools.size());
     worker_pools.push_back({"TaskSchedulerBackground",
                             ThreadPriority::BACKGROUND,
-                            IORestriction::DISALLOWED, 1U});
+                            IORestriction::DISALLOWED, 1U,
+                            WorkStealing::DISABLED});
 
     ASSERT_EQ(BACKGROUND_FILE_IO_WORKER_POOL, worker_pools.size());
     worker_pools.push_back({"TaskSchedulerBackgroundFileIO",
                             ThreadPriority::BACKGROUND, IORestriction::ALLOWED,
-                            3U});
+                            3U, WorkStealing::DISABLED});
 
     ASSERT_EQ(FOREGROUND_WORKER_POOL, worker_pools.size());
     worker_pools.push_back({"TaskSchedulerForeground", ThreadPriority::NORMAL,
-                            IORestriction::DISALLOWED, 4U});
+                            IORestriction::DISALLOWED, 4U,
+                            WorkStealing::ENABLED});
 
     ASSERT_EQ(FOREGROUND_FILE_IO_WORKER_POOL, worker_pools.size());
     worker_pools.push_back({"TaskSchedulerForegroundFileIO",
                             ThreadPriority::NORMAL, IORestriction::ALLOWED,
-                            12U});
+                            12U, WorkStealing::DISABLED});
 
     scheduler_ = TaskSchedulerImpl::Create(worker_pools,
                                            Bind(&GetThreadPoolIndexForTraits));
@@ -4,9 +4,15 @@
 
 #include "base/task_scheduler/task_tracker.h"
 
+#include <algorithm>
+#include <string>
+
 #include "base/callback.h"
 #include "base/debug/task_annotator.h"
+#include "base/metrics/histogram.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/metrics/metrics_hashes.h"
+#include "base/metrics/sparse_histogram.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -23,6 +29,18 @@ const char kQueueFunctionName[] = "base::PostTask";
 // its implementation details.
 const char kRunFunctionName[] = "TaskSchedulerRunTask";
 
+// Category of the trace events linking the post and the run of each task.
+const char kFlowCategory[] = TRACE_DISABLED_BY_DEFAULT("task_scheduler.flow");
+
+// Upper bound for the queueing delay and run time histograms, in microseconds.
+const HistogramBase::Sample kMaxTaskTimeMicroseconds =
+    60 * Time::kMicrosecondsPerSecond;
+const size_t kNumTaskTimeHistogramBuckets = 50;
+
+// The posting location of a task whose queueing delay or run time is at least
+// this long is recorded.
+const int kLongTaskTimeMilliseconds = 100;
+
 // Upper bound for the
 // TaskScheduler.BlockShutdownTasksPostedDuringShutdown histogram.
 const HistogramBase::Sample kMaxBlockShutdownTasksPostedDuringShutdown = 1000;
@@ -34,9 +52,82 @@ void RecordNumBlockShutdownTasksPostedDuringShutdown(
       kMaxBlockShutdownTasksPostedDuringShutdown, 50);
 }
 
+const char* GetTaskPriorityHistogramSuffix(TaskPriority priority) {
+  switch (priority) {
+    case TaskPriority::BACKGROUND:
+      return "Background";
+    case TaskPriority::USER_VISIBLE:
+      return "UserVisible";
+    case TaskPriority::USER_BLOCKING:
+      return "UserBlocking";
+  }
+  NOTREACHED();
+  return "";
+}
+
+const char* GetTaskShutdownBehaviorHistogramSuffix(
+    TaskShutdownBehavior shutdown_behavior) {
+  switch (shutdown_behavior) {
+    case TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN:
+      return "ContinueOnShutdown";
+    case TaskShutdownBehavior::SKIP_ON_SHUTDOWN:
+      return "SkipOnShutdown";
+    case TaskShutdownBehavior::BLOCK_SHUTDOWN:
+      return "BlockShutdown";
+  }
+  NOTREACHED();
+  return "";
+}
+
+// Returns the histogram named |name_prefix|.<priority>.<shutdown behavior>.
+HistogramBase* GetTaskTimeHistogram(const char* name_prefix,
+                                    TaskPriority priority,
+                                    TaskShutdownBehavior shutdown_behavior) {
+  return Histogram::FactoryGet(
+      std::string(name_prefix) + "." +
+          GetTaskPriorityHistogramSuffix(priority) + "." +
+          GetTaskShutdownBehaviorHistogramSuffix(shutdown_behavior),
+      1, kMaxTaskTimeMicroseconds, kNumTaskTimeHistogramBuckets,
+      HistogramBase::kUmaTargetedHistogramFlag);
+}
+
+HistogramBase::Sample ToMicrosecondsSample(TimeDelta time) {
+  return static_cast<HistogramBase::Sample>(
+      std::min(time.InMicroseconds(),
+               static_cast<int64_t>(kMaxTaskTimeMicroseconds)));
+}
+
+// Returns the bucket of |location| in the long task location histograms.
+HistogramBase::Sample GetLocationBucket(
+    const tracked_objects::Location& location) {
+  return static_cast<HistogramBase::Sample>(
+      HashMetricName(location.ToString()));
+}
+
 }  // namespace
 
-TaskTracker::TaskTracker() = default;
+TaskTracker::TaskTracker()
+    : long_queueing_delay_location_histogram_(SparseHistogram::FactoryGet(
+          "TaskScheduler.LongTaskQueueingDelay.PostLocation",
+          HistogramBase::kUmaTargetedHistogramFlag)),
+      long_run_time_location_histogram_(SparseHistogram::FactoryGet(
+          "TaskScheduler.LongTaskRunTime.PostLocation",
+          HistogramBase::kUmaTargetedHistogramFlag)) {
+  for (size_t i = 0; i < kNumTaskPriorities; ++i) {
+    for (size_t j = 0; j < kNumTaskShutdownBehaviors; ++j) {
+      const TaskPriority priority = static_cast<TaskPriority>(i);
+      const TaskShutdownBehavior shutdown_behavior =
+          static_cast<TaskShutdownBehavior>(j);
+      queueing_delay_histograms_[i][j] = GetTaskTimeHistogram(
+          "TaskScheduler.TaskQueueingDelayMicroseconds", priority,
+          shutdown_behavior);
+      run_time_histograms_[i][j] = GetTaskTimeHistogram(
+          "TaskScheduler.TaskRunTimeMicroseconds", priority,
+          shutdown_behavior);
+    }
+  }
+}
+
 TaskTracker::~TaskTracker() = default;
 
 void TaskTracker::Shutdown() {
@@ -74,6 +165,8 @@ bool TaskTracker::WillPostTask(const Task* task) {
 
   debug::TaskAnnotator task_annotator;
   task_annotator.DidQueueTask(kQueueFunctionName, *task);
+  TRACE_EVENT_WITH_FLOW0(kFlowCategory, kQueueFunctionName,
+                         TRACE_ID_MANGLE(task), TRACE_EVENT_FLAG_FLOW_OUT);
 
   return true;
 }
@@ -93,6 +186,8 @@ void TaskTracker::RunTask(const Task* task) {
       task->traits.shutdown_behavior() !=
       TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN);
 
+  const TimeTicks start_time = TimeTicks::Now();
+
   {
     // Set up TaskRunnerHandle as expected for the scope of the task.
     std::unique_ptr<SequencedTaskRunnerHandle> sequenced_task_runner_handle;
@@ -108,11 +203,19 @@ void TaskTracker::RunTask(const Task* task) {
     }
 
     TRACE_TASK_EXECUTION(kRunFunctionName, *task);
+    TRACE_EVENT_WITH_FLOW2(
+        kFlowCategory, kRunFunctionName, TRACE_ID_MANGLE(task),
+        TRACE_EVENT_FLAG_FLOW_IN, "priority",
+        static_cast<int>(task->traits.priority()), "queueing_delay_us",
+        task->sequenced_time.is_null()
+            ? 0
+            : (start_time - task->sequenced_time).InMicroseconds());
 
     debug::TaskAnnotator task_annotator;
     task_annotator.RunTask(kQueueFunctionName, *task);
   }
 
+  RecordTaskTimes(task, start_time, TimeTicks::Now());
   AfterRunTask(shutdown_behavior);
 }
 
@@ -208,5 +311,35 @@ void TaskTracker::AfterRunTask(TaskShutdownBehavior shutdown_behavior) {
   }
 }
 
+void TaskTracker::RecordTaskTimes(const Task* task,
+                                  TimeTicks start_time,
+                                  TimeTicks end_time) {
+  const size_t priority_index = static_cast<size_t>(task->traits.priority());
+  const size_t shutdown_behavior_index =
+      static_cast<size_t>(task->traits.shutdown_behavior());
+  const TimeDelta long_task_time =
+      TimeDelta::FromMilliseconds(kLongTaskTimeMilliseconds);
+
+  // |sequenced_time| is null if |task| was run without being inserted in a
+  // Sequence.
+  if (!task->sequenced_time.is_null()) {
+    const TimeDelta queueing_delay = start_time - task->sequenced_time;
+    queueing_delay_histograms_[priority_index][shutdown_behavior_index]->Add(
+        ToMicrosecondsSample(queueing_delay));
+    if (queueing_delay >= long_task_time) {
+      long_queueing_delay_location_histogram_->Add(
+          GetLocationBucket(task->posted_from));
+    }
+  }
+
+  const TimeDelta run_time = end_time - start_time;
+  run_time_histograms_[priority_index][shutdown_behavior_index]->Add(
+      ToMicrosecondsSample(run_time));
+  if (run_time >= long_task_time) {
+    long_run_time_location_histogram_->Add(
+        GetLocationBucket(task->posted_from));
+  }
+}
+
 }  // namespace internal
 }  // namespace base
@@ -15,6 +15,7 @@
 #include "base/task_scheduler/scheduler_lock.h"
 #include "base/task_scheduler/task.h"
 #include "base/task_scheduler/task_traits.h"
+#include "base/time/time.h"
 
 namespace base {
 namespace internal {
@@ -22,8 +23,13 @@ namespace internal {
 // All tasks go through the scheduler's TaskTracker when they are posted and
 // when they are executed. The TaskTracker enforces shutdown semantics and takes
 // care of tracing and profiling. This class is thread-safe.
+//
+// The TaskTracker records the queueing delay and the run time of each task in
+// histograms. They are backed by persistent memory if a
+// GlobalHistogramAllocator exists when the TaskTracker is constructed.
 class BASE_EXPORT TaskTracker {
  public:
+
   TaskTracker();
   ~TaskTracker();
 
@@ -54,6 +60,11 @@ class BASE_EXPORT TaskTracker {
   }
 
  private:
+  static const size_t kNumTaskPriorities =
+      static_cast<size_t>(TaskPriority::HIGHEST) + 1;
+  static const size_t kNumTaskShutdownBehaviors =
+      static_cast<size_t>(TaskShutdownBehavior::BLOCK_SHUTDOWN) + 1;
+
   // Called before WillPostTask() informs the tracing system that a task has
   // been posted. Updates |num_tasks_blocking_shutdown_| if necessary and
   // returns true if the current shutdown state allows the task to be posted.
@@ -69,6 +80,13 @@ class BASE_EXPORT TaskTracker {
   // necessary.
   void AfterRunTask(TaskShutdownBehavior shutdown_behavior);
 
+  // Records the queueing delay and the run time of |task| in histograms.
+  // |start_time| and |end_time| are the times at which |task| started and
+  // finished running.
+  void RecordTaskTimes(const Task* task,
+                       TimeTicks start_time,
+                       TimeTicks end_time);
+
   // Synchronizes access to all members.
   mutable SchedulerLock lock_;
 
@@ -85,6 +103,18 @@ class BASE_EXPORT TaskTracker {
   // True once Shutdown() has returned. No new task can be scheduled after this.
   bool shutdown_completed_ = false;
 
+  // Histograms of queueing delay and run time, indexed by TaskPriority and by
+  // TaskShutdownBehavior.
+  HistogramBase* queueing_delay_histograms_[kNumTaskPriorities]
+                                           [kNumTaskShutdownBehaviors];
+  HistogramBase* run_time_histograms_[kNumTaskPriorities]
+                                     [kNumTaskShutdownBehaviors];
+
+  // Sparse histograms of the posting location of tasks whose queueing delay or
+  // run time is long. Samples are hashes of the posting location.
+  HistogramBase* long_queueing_delay_location_histogram_;
+  HistogramBase* long_run_time_location_histogram_;
+
   DISALLOW_COPY_AND_ASSIGN(TaskTracker);
 };
 
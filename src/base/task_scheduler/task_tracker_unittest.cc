@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
@@ -17,6 +18,7 @@
 #include "base/task_scheduler/task.h"
 #include "base/task_scheduler/task_traits.h"
 #include "base/task_scheduler/test_utils.h"
+#include "base/test/histogram_tester.h"
 #include "base/test/test_simple_task_runner.h"
 #include "base/threading/platform_thread.h"
 #include "base/threading/sequenced_task_runner_handle.h"
@@ -409,6 +411,31 @@ TEST_P(TaskSchedulerTaskTrackerTest,
   RunTaskRunnerHandleVerificationTask(&tracker_, verify_task.get());
 }
 
+// Verify that the queueing delay and the run time of a task are recorded in
+// the histograms of its priority and shutdown behavior.
+TEST(TaskSchedulerTaskTrackerHistogramTest, RecordTaskTimes) {
+  HistogramTester histogram_tester;
+  TaskTracker tracker;
+
+  const TaskTraits traits =
+      TaskTraits()
+          .WithPriority(TaskPriority::USER_BLOCKING)
+          .WithShutdownBehavior(TaskShutdownBehavior::SKIP_ON_SHUTDOWN);
+  std::unique_ptr<Task> task(
+      new Task(FROM_HERE, Bind(&DoNothing), traits, TimeDelta()));
+  EXPECT_TRUE(tracker.WillPostTask(task.get()));
+  task->sequenced_time = TimeTicks::Now();
+  tracker.RunTask(task.get());
+
+  histogram_tester.ExpectTotalCount(
+      "TaskScheduler.TaskQueueingDelayMicroseconds.UserBlocking.SkipOnShutdown",
+      1);
+  histogram_tester.ExpectTotalCount(
+      "TaskScheduler.TaskRunTimeMicroseconds.UserBlocking.SkipOnShutdown", 1);
+  histogram_tester.ExpectTotalCount(
+      "TaskScheduler.TaskRunTimeMicroseconds.Background.SkipOnShutdown", 0);
+}
+
 INSTANTIATE_TEST_CASE_P(
     ContinueOnShutdown,
     TaskSchedulerTaskTrackerTest,
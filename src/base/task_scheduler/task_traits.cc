@@ -8,6 +8,8 @@
 
 #include <ostream>
 
+#include "base/logging.h"
+
 namespace base {
 
 // Do not rely on defaults hard-coded below beyond the guarantees described in
@@ -36,6 +38,12 @@ TaskTraits& TaskTraits::WithShutdownBehavior(
   return *this;
 }
 
+TaskTraits& TaskTraits::WithLeeway(TimeDelta leeway) {
+  DCHECK_GE(leeway, TimeDelta());
+  leeway_ = leeway;
+  return *this;
+}
+
 std::ostream& operator<<(std::ostream& os, const TaskPriority& task_priority) {
   switch (task_priority) {
     case TaskPriority::BACKGROUND:
@@ -10,6 +10,7 @@
 #include <iosfwd>
 
 #include "base/base_export.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 
 namespace base {
@@ -80,8 +81,9 @@ class BASE_EXPORT TaskTraits {
  public:
   // Constructs a default TaskTraits for tasks with
   //     (1) no I/O,
-  //     (2) low priority, and
-  //     (3) may block shutdown or be skipped on shutdown.
+  //     (2) low priority,
+  //     (3) may block shutdown or be skipped on shutdown, and
+  //     (4) no leeway on the delay of delayed tasks.
   // Tasks that require stricter guarantees should highlight those by requesting
   // explicit traits below.
   TaskTraits();
@@ -98,6 +100,11 @@ class BASE_EXPORT TaskTraits {
   // Applies |shutdown_behavior| to tasks with these traits.
   TaskTraits& WithShutdownBehavior(TaskShutdownBehavior shutdown_behavior);
 
+  // Allows delayed tasks with these traits to run up to |leeway| after their
+  // delay expires, so that their wakeup can be coalesced with the wakeup of
+  // other delayed tasks.
+  TaskTraits& WithLeeway(TimeDelta leeway);
+
   // Returns true if file I/O is allowed by these traits.
   bool with_file_io() const { return with_file_io_; }
 
@@ -107,10 +114,14 @@ class BASE_EXPORT TaskTraits {
   // Returns the shutdown behavior of tasks with these traits.
   TaskShutdownBehavior shutdown_behavior() const { return shutdown_behavior_; }
 
+  // Returns the leeway of delayed tasks with these traits.
+  TimeDelta leeway() const { return leeway_; }
+
  private:
   bool with_file_io_;
   TaskPriority priority_;
   TaskShutdownBehavior shutdown_behavior_;
+  TimeDelta leeway_;
 };
 
 // Describes how tasks are executed by a task runner.
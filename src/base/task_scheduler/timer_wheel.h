@@ -0,0 +1,306 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TASK_SCHEDULER_TIMER_WHEEL_H_
+#define BASE_TASK_SCHEDULER_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/containers/linked_list.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+
+namespace base {
+namespace internal {
+
+// A hierarchical timer wheel holding values of type T until their fire time
+// is reached. Insert() and Cancel() are O(1). AdvanceTo() is amortized O(1) per
+// value: a value moves down at most once per level before it is extracted.
+//
+// Level 0 has one slot per tick. Each slot of level N spans all slots of level
+// N-1. A value is kept in the lowest level at which its fire tick and the
+// current tick only differ in the slot index. When the current tick reaches
+// the first tick of a slot of level N > 0, the values of that slot are moved
+// down to lower levels. Values whose fire tick is beyond the span of the top
+// level are kept in an overflow list which is redistributed each time the
+// current tick crosses a multiple of that span.
+//
+// This class is not thread-safe.
+template <typename T>
+class TimerWheel {
+ public:
+  // Identifies a value inserted in the wheel.
+  using Handle = uint64_t;
+
+  // Constructs a TimerWheel whose current time is |now|. Fire times are
+  // rounded down to a multiple of |tick| to select a slot, but a value is
+  // never extracted before its exact fire time.
+  TimerWheel(TimeTicks now, TimeDelta tick)
+      : tick_us_(tick.InMicroseconds()),
+        current_tick_(GetTick(now)),
+        occupied_slots_() {
+    DCHECK_GT(tick_us_, 0);
+  }
+
+  ~TimerWheel() {
+    for (const auto& handle_and_entry : entries_)
+      delete handle_and_entry.second;
+  }
+
+  // Inserts |value| in the wheel. It will be extracted by the first call to
+  // AdvanceTo() with a time that is equal to or after |fire_time|. The returned
+  // Handle can be passed to Cancel() until |value| is extracted.
+  Handle Insert(TimeTicks fire_time, T value) {
+    Entry* const entry =
+        new Entry(++last_handle_, fire_time, GetTick(fire_time),
+                  std::move(value));
+    entries_[entry->handle] = entry;
+    Place(entry);
+
+    if (!next_fire_time_.is_null() && fire_time < next_fire_time_)
+      next_fire_time_ = fire_time;
+    return entry->handle;
+  }
+
+  // Deletes the value identified by |handle| from the wheel. Returns false if
+  // it was already extracted or cancelled.
+  bool Cancel(Handle handle) {
+    const auto it = entries_.find(handle);
+    if (it == entries_.end())
+      return false;
+    Entry* const entry = it->second;
+    entries_.erase(it);
+
+    entry->RemoveFromList();
+    if (entry->level != kOverflowLevel &&
+        slots_[entry->level][entry->slot].empty()) {
+      occupied_slots_[entry->level] &= ~(uint64_t(1) << entry->slot);
+    }
+    if (entry->fire_time == next_fire_time_)
+      next_fire_time_ = TimeTicks();
+    delete entry;
+    return true;
+  }
+
+  // Advances the wheel to |now| and appends all values whose fire time is
+  // equal to or before |now| to |ready_values|, in no particular order.
+  void AdvanceTo(TimeTicks now, std::vector<T>* ready_values) {
+    DCHECK(ready_values);
+    const int64_t now_tick = GetTick(now);
+
+    while (true) {
+      int level;
+      int slot;
+      const bool has_occupied_slot = GetFirstOccupiedSlot(&level, &slot);
+      int64_t next_tick;
+      if (has_occupied_slot)
+        next_tick = GetFirstTickOfSlot(level, slot);
+      else if (!overflow_.empty())
+        next_tick = GetFirstTickOfNextOverflowSpan();
+      else
+        break;
+
+      if (next_tick > now_tick)
+        break;
+      current_tick_ = next_tick;
+      next_fire_time_ = TimeTicks();
+
+      if (!has_occupied_slot) {
+        // All slots are empty and the current tick entered a new span of the
+        // top level: redistribute the overflow list.
+        for (Entry* entry : TakeAll(&overflow_))
+          Place(entry);
+        continue;
+      }
+
+      occupied_slots_[level] &= ~(uint64_t(1) << slot);
+      for (Entry* entry : TakeAll(&slots_[level][slot])) {
+        if (level == 0 && entry->fire_time <= now) {
+          entries_.erase(entry->handle);
+          ready_values->push_back(std::move(entry->value));
+          delete entry;
+        } else {
+          Place(entry);
+        }
+      }
+
+      // A slot of level 0 which is still occupied holds values that fire later
+      // during |now_tick|.
+      if (level == 0 && (occupied_slots_[0] & (uint64_t(1) << slot)))
+        break;
+    }
+
+    // All remaining values fire after |now_tick|, so advancing the current tick
+    // doesn't move any of them to a different slot.
+    current_tick_ = std::max(current_tick_, now_tick);
+  }
+
+  // Returns the earliest fire time of a value in the wheel, or a null
+  // TimeTicks if the wheel is empty.
+  TimeTicks GetNextFireTime() const {
+    if (!next_fire_time_.is_null() || entries_.empty())
+      return next_fire_time_;
+
+    // The earliest value is in the first occupied slot of the lowest occupied
+    // level, or in the overflow list if all slots are empty.
+    int level;
+    int slot;
+    const LinkedList<Entry>& list = GetFirstOccupiedSlot(&level, &slot)
+                                        ? slots_[level][slot]
+                                        : overflow_;
+    DCHECK(!list.empty());
+    for (const LinkNode<Entry>* node = list.head(); node != list.end();
+         node = node->next()) {
+      const TimeTicks fire_time = node->value()->fire_time;
+      if (next_fire_time_.is_null() || fire_time < next_fire_time_)
+        next_fire_time_ = fire_time;
+    }
+    return next_fire_time_;
+  }
+
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+ private:
+  static const int kNumLevels = 4;
+  static const int kBitsPerLevel = 6;
+  static const int kSlotsPerLevel = 1 << kBitsPerLevel;
+  static const int64_t kSlotMask = kSlotsPerLevel - 1;
+  static const int kOverflowLevel = -1;
+
+  struct Entry : public LinkNode<Entry> {
+    Entry(Handle handle, TimeTicks fire_time, int64_t fire_tick, T value)
+        : handle(handle),
+          fire_time(fire_time),
+          fire_tick(fire_tick),
+          value(std::move(value)) {}
+
+    const Handle handle;
+    const TimeTicks fire_time;
+    const int64_t fire_tick;
+    T value;
+
+    // Position of the entry in |slots_|, or kOverflowLevel if the entry is in
+    // |overflow_|.
+    int level = kOverflowLevel;
+    int slot = 0;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(Entry);
+  };
+
+  int64_t GetTick(TimeTicks time) const {
+    return (time - TimeTicks()).InMicroseconds() / tick_us_;
+  }
+
+  // Inserts |entry| in the lowest level at which its fire tick shares all the
+  // bits of higher levels with |current_tick_|.
+  void Place(Entry* entry) {
+    const int64_t tick = std::max(entry->fire_tick, current_tick_);
+    for (int level = 0; level < kNumLevels; ++level) {
+      const int higher_levels_shift = kBitsPerLevel * (level + 1);
+      if ((tick >> higher_levels_shift) ==
+          (current_tick_ >> higher_levels_shift)) {
+        const int slot =
+            static_cast<int>((tick >> (kBitsPerLevel * level)) & kSlotMask);
+        entry->level = level;
+        entry->slot = slot;
+        slots_[level][slot].Append(entry);
+        occupied_slots_[level] |= uint64_t(1) << slot;
+        return;
+      }
+    }
+    entry->level = kOverflowLevel;
+    overflow_.Append(entry);
+  }
+
+  // Sets |level| and |slot| to the position of the first slot that holds a
+  // value and returns true, or returns false if all slots are empty.
+  bool GetFirstOccupiedSlot(int* level, int* slot) const {
+    for (int i = 0; i < kNumLevels; ++i) {
+      if (occupied_slots_[i]) {
+        *level = i;
+        *slot = CountTrailingZeroBits(occupied_slots_[i]);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns the first tick covered by |slot| of |level| in the current span of
+  // |level|.
+  int64_t GetFirstTickOfSlot(int level, int slot) const {
+    const int level_shift = kBitsPerLevel * level;
+    const int higher_levels_shift = level_shift + kBitsPerLevel;
+    return ((current_tick_ >> higher_levels_shift) << higher_levels_shift) |
+           (static_cast<int64_t>(slot) << level_shift);
+  }
+
+  int64_t GetFirstTickOfNextOverflowSpan() const {
+    const int top_level_shift = kBitsPerLevel * kNumLevels;
+    return ((current_tick_ >> top_level_shift) + 1) << top_level_shift;
+  }
+
+  // Removes all entries from |list| and returns them.
+  static std::vector<Entry*> TakeAll(LinkedList<Entry>* list) {
+    std::vector<Entry*> entries;
+    while (!list->empty()) {
+      LinkNode<Entry>* const node = list->head();
+      node->RemoveFromList();
+      entries.push_back(node->value());
+    }
+    return entries;
+  }
+
+  static int CountTrailingZeroBits(uint64_t bits) {
+    DCHECK(bits);
+#if defined(COMPILER_GCC)
+    return __builtin_ctzll(bits);
+#else
+    int count = 0;
+    while (!(bits & 1)) {
+      bits >>= 1;
+      ++count;
+    }
+    return count;
+#endif
+  }
+
+  const int64_t tick_us_;
+
+  // Tick up to which the wheel has been advanced.
+  int64_t current_tick_;
+
+  LinkedList<Entry> slots_[kNumLevels][kSlotsPerLevel];
+
+  // Bit i of |occupied_slots_[level]| is set if |slots_[level][i]| isn't
+  // empty.
+  uint64_t occupied_slots_[kNumLevels];
+
+  // Entries whose fire tick is beyond the current span of the top level.
+  LinkedList<Entry> overflow_;
+
+  // All entries in the wheel, owned.
+  std::unordered_map<Handle, Entry*> entries_;
+
+  Handle last_handle_ = 0;
+
+  // Cached result of GetNextFireTime(). Null when it must be recomputed.
+  mutable TimeTicks next_fire_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_TASK_SCHEDULER_TIMER_WHEEL_H_
@@ -0,0 +1,127 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task_scheduler/timer_wheel.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+const TimeTicks kStartTime = TimeTicks() + TimeDelta::FromSeconds(1000);
+
+std::vector<int> AdvanceTo(TimerWheel<int>* wheel, TimeTicks now) {
+  std::vector<int> ready_values;
+  wheel->AdvanceTo(now, &ready_values);
+  std::sort(ready_values.begin(), ready_values.end());
+  return ready_values;
+}
+
+}  // namespace
+
+TEST(TaskSchedulerTimerWheelTest, Empty) {
+  TimerWheel<int> wheel(kStartTime, TimeDelta::FromMilliseconds(1));
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(TimeTicks(), wheel.GetNextFireTime());
+  EXPECT_TRUE(AdvanceTo(&wheel, kStartTime + TimeDelta::FromDays(1)).empty());
+}
+
+// Verify that a value is extracted at its exact fire time, even when the fire
+// time isn't a multiple of the tick.
+TEST(TaskSchedulerTimerWheelTest, ExtractAtFireTime) {
+  TimerWheel<int> wheel(kStartTime, TimeDelta::FromMilliseconds(1));
+  const TimeTicks fire_time = kStartTime + TimeDelta::FromMicroseconds(2500);
+  wheel.Insert(fire_time, 1);
+  EXPECT_EQ(1U, wheel.size());
+  EXPECT_EQ(fire_time, wheel.GetNextFireTime());
+
+  EXPECT_TRUE(
+      AdvanceTo(&wheel, fire_time - TimeDelta::FromMicroseconds(1)).empty());
+  EXPECT_EQ(fire_time, wheel.GetNextFireTime());
+
+  EXPECT_EQ(std::vector<int>({1}), AdvanceTo(&wheel, fire_time));
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(TimeTicks(), wheel.GetNextFireTime());
+}
+
+// Verify that a value with a fire time in the past is extracted by the next
+// call to AdvanceTo().
+TEST(TaskSchedulerTimerWheelTest, FireTimeInThePast) {
+  TimerWheel<int> wheel(kStartTime, TimeDelta::FromMilliseconds(1));
+  wheel.Insert(kStartTime - TimeDelta::FromSeconds(1), 1);
+  EXPECT_EQ(std::vector<int>({1}), AdvanceTo(&wheel, kStartTime));
+}
+
+// Verify that values spread across all levels and the overflow list are
+// extracted in order when the wheel advances.
+TEST(TaskSchedulerTimerWheelTest, Cascade) {
+  TimerWheel<int> wheel(kStartTime, TimeDelta::FromMilliseconds(1));
+  const TimeDelta delays[] = {
+      TimeDelta::FromMilliseconds(3),  TimeDelta::FromMilliseconds(100),
+      TimeDelta::FromSeconds(2),       TimeDelta::FromMinutes(5),
+      TimeDelta::FromHours(3),         TimeDelta::FromDays(2),
+  };
+  for (size_t i = 0; i < arraysize(delays); ++i)
+    wheel.Insert(kStartTime + delays[i], static_cast<int>(i));
+
+  for (size_t i = 0; i < arraysize(delays); ++i) {
+    const TimeTicks fire_time = kStartTime + delays[i];
+    EXPECT_EQ(fire_time, wheel.GetNextFireTime());
+    EXPECT_TRUE(
+        AdvanceTo(&wheel, fire_time - TimeDelta::FromMicroseconds(1)).empty());
+    EXPECT_EQ(std::vector<int>({static_cast<int>(i)}),
+              AdvanceTo(&wheel, fire_time));
+  }
+  EXPECT_TRUE(wheel.empty());
+}
+
+// Verify that all values whose fire time has passed are extracted by a single
+// call to AdvanceTo().
+TEST(TaskSchedulerTimerWheelTest, ExtractMany) {
+  TimerWheel<int> wheel(kStartTime, TimeDelta::FromMilliseconds(1));
+  for (int i = 0; i < 1000; ++i)
+    wheel.Insert(kStartTime + TimeDelta::FromMilliseconds(i * 7), i);
+
+  std::vector<int> ready_values =
+      AdvanceTo(&wheel, kStartTime + TimeDelta::FromMilliseconds(7 * 499));
+  EXPECT_EQ(500U, ready_values.size());
+  EXPECT_EQ(0, ready_values.front());
+  EXPECT_EQ(499, ready_values.back());
+  EXPECT_EQ(kStartTime + TimeDelta::FromMilliseconds(7 * 500),
+            wheel.GetNextFireTime());
+
+  EXPECT_EQ(500U,
+            AdvanceTo(&wheel, kStartTime + TimeDelta::FromHours(1)).size());
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TaskSchedulerTimerWheelTest, Cancel) {
+  TimerWheel<int> wheel(kStartTime, TimeDelta::FromMilliseconds(1));
+  const TimeTicks fire_time_a = kStartTime + TimeDelta::FromMilliseconds(10);
+  const TimeTicks fire_time_b = kStartTime + TimeDelta::FromSeconds(10);
+  const TimerWheel<int>::Handle handle_a = wheel.Insert(fire_time_a, 1);
+  const TimerWheel<int>::Handle handle_b = wheel.Insert(fire_time_b, 2);
+  EXPECT_EQ(fire_time_a, wheel.GetNextFireTime());
+
+  // Cancelling the earliest value updates the next fire time.
+  EXPECT_TRUE(wheel.Cancel(handle_a));
+  EXPECT_FALSE(wheel.Cancel(handle_a));
+  EXPECT_EQ(fire_time_b, wheel.GetNextFireTime());
+  EXPECT_TRUE(AdvanceTo(&wheel, fire_time_a).empty());
+
+  // A value can't be cancelled once it has been extracted.
+  EXPECT_EQ(std::vector<int>({2}), AdvanceTo(&wheel, fire_time_b));
+  EXPECT_FALSE(wheel.Cancel(handle_b));
+  EXPECT_TRUE(wheel.empty());
+}
+
+}  // namespace internal
+}  // namespace base
@@ -5,6 +5,7 @@
 #include "base/trace_event/heap_profiler_allocation_context_tracker.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 
 #include "base/atomicops.h"
@@ -23,6 +24,8 @@ namespace trace_event {
 subtle::Atomic32 AllocationContextTracker::capture_mode_ =
     static_cast<int32_t>(AllocationContextTracker::CaptureMode::DISABLED);
 
+subtle::AtomicWord AllocationContextTracker::sampling_interval_ = 0;
+
 namespace {
 
 const size_t kMaxStackDepth = 128u;
@@ -82,9 +85,17 @@ AllocationContextTracker::GetInstanceForCurrentThread() {
 }
 
 AllocationContextTracker::AllocationContextTracker()
-    : thread_name_(nullptr), ignore_scope_depth_(0) {
+    : thread_name_(nullptr),
+      ignore_scope_depth_(0),
+      bytes_until_sample_(0),
+      // Seed each thread differently without making a system call.
+      random_state_(reinterpret_cast<uintptr_t>(this) ^
+                    static_cast<uint64_t>(PlatformThread::CurrentId())) {
   pseudo_stack_.reserve(kMaxStackDepth);
   task_contexts_.reserve(kMaxTaskDepth);
+  const size_t interval = sampling_interval();
+  if (interval)
+    bytes_until_sample_ = GetNextSampleInterval(interval);
 }
 AllocationContextTracker::~AllocationContextTracker() {}
 
@@ -107,6 +118,45 @@ void AllocationContextTracker::SetCaptureMode(CaptureMode mode) {
   subtle::Release_Store(&capture_mode_, static_cast<int32_t>(mode));
 }
 
+// static
+void AllocationContextTracker::SetSamplingInterval(
+    size_t sampling_interval_bytes) {
+  subtle::NoBarrier_Store(
+      &sampling_interval_,
+      static_cast<subtle::AtomicWord>(sampling_interval_bytes));
+}
+
+bool AllocationContextTracker::ShouldSampleAllocation(size_t size) {
+  const size_t interval = sampling_interval();
+  if (!interval)
+    return true;
+
+  bytes_until_sample_ -= static_cast<int64_t>(size);
+  if (bytes_until_sample_ > 0)
+    return false;
+
+  // The process is memoryless, so the next interval can start at the end of
+  // this allocation even if it spans several points of the process.
+  bytes_until_sample_ = GetNextSampleInterval(interval);
+  return true;
+}
+
+int64_t AllocationContextTracker::GetNextSampleInterval(
+    size_t sampling_interval) {
+  // splitmix64, see http://xoshiro.di.unimi.it/splitmix64.c.
+  random_state_ += UINT64_C(0x9E3779B97F4A7C15);
+  uint64_t random = random_state_;
+  random = (random ^ (random >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+  random = (random ^ (random >> 27)) * UINT64_C(0x94D049BB133111EB);
+  random ^= random >> 31;
+
+  // A uniform value in (0, 1], from the 53 high bits.
+  const double uniform =
+      (static_cast<double>(random >> 11) + 1) / (UINT64_C(1) << 53);
+  const double interval = -std::log(uniform) * sampling_interval;
+  return std::max<int64_t>(1, static_cast<int64_t>(interval));
+}
+
 void AllocationContextTracker::PushPseudoStackFrame(
     const char* trace_event_name) {
   // Impose a limit on the height to verify that every push is popped, because
@@ -5,6 +5,9 @@
 #ifndef BASE_TRACE_EVENT_HEAP_PROFILER_ALLOCATION_CONTEXT_TRACKER_H_
 #define BASE_TRACE_EVENT_HEAP_PROFILER_ALLOCATION_CONTEXT_TRACKER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <vector>
 
 #include "base/atomicops.h"
@@ -50,6 +53,15 @@ class BASE_EXPORT AllocationContextTracker {
     return static_cast<CaptureMode>(subtle::Acquire_Load(&capture_mode_));
   }
 
+  // Globally sets the mean number of bytes allocated between two allocations
+  // that are recorded by the heap profiler, or 0 to record all allocations.
+  static void SetSamplingInterval(size_t sampling_interval_bytes);
+
+  // Returns the global sampling interval, or 0 if allocations aren't sampled.
+  inline static size_t sampling_interval() {
+    return static_cast<size_t>(subtle::NoBarrier_Load(&sampling_interval_));
+  }
+
   // Returns the thread-local instance, creating one if necessary. Returns
   // always a valid instance, unless it is called re-entrantly, in which case
   // returns nullptr in the nested calls.
@@ -82,12 +94,26 @@ class BASE_EXPORT AllocationContextTracker {
   // Returns a snapshot of the current thread-local context.
   AllocationContext GetContextSnapshot();
 
+  // Returns whether an allocation of |size| bytes by the current thread should
+  // be recorded. When sampling, the recorded allocations are those in which
+  // the bytes allocated by the thread cross the points of a Poisson process of
+  // mean interval sampling_interval(), so that an allocation of |size| bytes is
+  // recorded with probability 1 - exp(-size / sampling_interval()). This is
+  // cheaper than GetContextSnapshot(), which should only be called for the
+  // recorded allocations.
+  bool ShouldSampleAllocation(size_t size);
+
   ~AllocationContextTracker();
 
  private:
   AllocationContextTracker();
 
+  // Returns an exponentially distributed number of bytes to allocate until
+  // the next recorded allocation.
+  int64_t GetNextSampleInterval(size_t sampling_interval);
+
   static subtle::Atomic32 capture_mode_;
+  static subtle::AtomicWord sampling_interval_;
 
   // The pseudo stack where frames are |TRACE_EVENT| names.
   std::vector<const char*> pseudo_stack_;
@@ -101,6 +127,13 @@ class BASE_EXPORT AllocationContextTracker {
 
   uint32_t ignore_scope_depth_;
 
+  // Bytes that the thread will allocate until the next recorded allocation.
+  int64_t bytes_until_sample_;
+
+  // State of the pseudo-random generator of the sampling intervals. The
+  // generator can't allocate, since it runs in the allocator hooks.
+  uint64_t random_state_;
+
   DISALLOW_COPY_AND_ASSIGN(AllocationContextTracker);
 };
 
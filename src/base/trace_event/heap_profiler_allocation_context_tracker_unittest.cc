@@ -4,6 +4,7 @@
 
 #include <stddef.h>
 
+#include <cmath>
 #include <iterator>
 
 #include "base/memory/ref_counted.h"
@@ -281,5 +282,40 @@ TEST_F(AllocationContextTrackerTest, IgnoreAllocationTest) {
   ASSERT_EQ(1u, ctx.backtrace.frame_count);
 }
 
+TEST_F(AllocationContextTrackerTest, SampleAllocations) {
+  AllocationContextTracker* tracker =
+      AllocationContextTracker::GetInstanceForCurrentThread();
+
+  // All allocations are recorded unless a sampling interval is set.
+  ASSERT_EQ(0u, AllocationContextTracker::sampling_interval());
+  for (size_t i = 0; i < 100; i++)
+    ASSERT_TRUE(tracker->ShouldSampleAllocation(1));
+
+  const size_t kSamplingInterval = 1024;
+  const size_t kAllocationSize = 64;
+  const size_t kNumAllocations = 100000;
+  AllocationContextTracker::SetSamplingInterval(kSamplingInterval);
+  size_t num_sampled = 0;
+  for (size_t i = 0; i < kNumAllocations; i++) {
+    if (tracker->ShouldSampleAllocation(kAllocationSize))
+      num_sampled++;
+  }
+
+  // Allocations much larger than the interval are (almost) always sampled.
+  size_t num_large_sampled = 0;
+  for (size_t i = 0; i < 100; i++) {
+    if (tracker->ShouldSampleAllocation(kSamplingInterval * 100))
+      num_large_sampled++;
+  }
+  AllocationContextTracker::SetSamplingInterval(0);
+
+  // Each allocation is sampled with probability 1 - exp(-size / interval).
+  const double expected_sampled =
+      kNumAllocations *
+      -std::expm1(-static_cast<double>(kAllocationSize) / kSamplingInterval);
+  EXPECT_NEAR(expected_sampled, num_sampled, expected_sampled * 0.05);
+  EXPECT_EQ(100u, num_large_sampled);
+}
+
 }  // namespace trace_event
 }  // namespace base
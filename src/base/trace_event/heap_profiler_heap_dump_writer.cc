@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <tuple>
 #include <utility>
@@ -308,6 +309,27 @@ std::unique_ptr<TracedValue> Serialize(const std::set<Entry>& entries) {
 
 }  // namespace internal
 
+void AddAllocationToMetrics(
+    const AllocationContext& context,
+    size_t size,
+    size_t sampling_interval,
+    hash_map<AllocationContext, AllocationMetrics>* metrics_by_context) {
+  AllocationMetrics& metrics = (*metrics_by_context)[context];
+  if (!sampling_interval) {
+    metrics.size += size;
+    metrics.count++;
+    return;
+  }
+
+  // An allocation of |size| bytes is sampled with probability
+  // 1 - exp(-size / sampling_interval), so each sampled one stands for the
+  // inverse of that many allocations.
+  const double scale =
+      1 / -std::expm1(-static_cast<double>(size) / sampling_interval);
+  metrics.size += static_cast<size_t>(std::llround(size * scale));
+  metrics.count += static_cast<size_t>(std::llround(scale));
+}
+
 std::unique_ptr<TracedValue> ExportHeapDump(
     const hash_map<AllocationContext, AllocationMetrics>& metrics_by_context,
     const MemoryDumpSessionState& session_state) {
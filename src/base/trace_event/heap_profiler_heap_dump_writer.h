@@ -31,6 +31,17 @@ BASE_EXPORT std::unique_ptr<TracedValue> ExportHeapDump(
     const hash_map<AllocationContext, AllocationMetrics>& metrics_by_context,
     const MemoryDumpSessionState& session_state);
 
+// Adds an allocation of |size| bytes made in |context| to
+// |metrics_by_context|. If allocations are sampled by AllocationContextTracker
+// with a mean interval of |sampling_interval| bytes, the allocation is scaled
+// up to the expected size and count of the allocations it stands for; pass 0
+// if allocations aren't sampled.
+BASE_EXPORT void AddAllocationToMetrics(
+    const AllocationContext& context,
+    size_t size,
+    size_t sampling_interval,
+    hash_map<AllocationContext, AllocationMetrics>* metrics_by_context);
+
 namespace internal {
 
 namespace {
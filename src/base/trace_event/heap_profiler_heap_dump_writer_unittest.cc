@@ -328,6 +328,30 @@ TEST(HeapDumpWriterTest, InsignificantValuesNotDumped) {
   AssertNotDumped(dump, bt_initialize, -1);
 }
 
+TEST(HeapDumpWriterTest, SampledAllocationsAreScaledUp) {
+  hash_map<AllocationContext, AllocationMetrics> metrics_by_context;
+  AllocationContext ctx;
+
+  // Without sampling, allocations are added as they are.
+  AddAllocationToMetrics(ctx, 20, 0, &metrics_by_context);
+  AddAllocationToMetrics(ctx, 30, 0, &metrics_by_context);
+  EXPECT_EQ(50u, metrics_by_context[ctx].size);
+  EXPECT_EQ(2u, metrics_by_context[ctx].count);
+  metrics_by_context.clear();
+
+  // An allocation much larger than the sampling interval is always sampled,
+  // so it stands for itself only.
+  AddAllocationToMetrics(ctx, 1024 * 1024, 1024, &metrics_by_context);
+  EXPECT_EQ(1024u * 1024u, metrics_by_context[ctx].size);
+  EXPECT_EQ(1u, metrics_by_context[ctx].count);
+  metrics_by_context.clear();
+
+  // A small sampled allocation stands for about |sampling_interval| bytes.
+  AddAllocationToMetrics(ctx, 16, 1024 * 1024, &metrics_by_context);
+  EXPECT_NEAR(1024 * 1024, metrics_by_context[ctx].size, 16);
+  EXPECT_NEAR(1024 * 1024 / 16, metrics_by_context[ctx].count, 1);
+}
+
 }  // namespace internal
 }  // namespace trace_event
 }  // namespace base
@@ -10,6 +10,7 @@
 #include <string>
 #include <utility>
 
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/trace_event/trace_event_argument.h"
 #include "base/trace_event/trace_event_memory_overhead.h"
@@ -17,6 +18,39 @@
 namespace base {
 namespace trace_event {
 
+namespace {
+
+// Writes the "name" and "parent" of |frame_node| to the current dictionary of
+// |value|. |stringify_buffer| is scratch space, to save allocations.
+void AppendFrameNodeInto(const StackFrameDeduplicator::FrameNode& frame_node,
+                         std::string* stringify_buffer,
+                         TracedValue* value) {
+  const StackFrame& frame = frame_node.frame;
+  switch (frame.type) {
+    case StackFrame::Type::TRACE_EVENT_NAME:
+      value->SetString("name", static_cast<const char*>(frame.value));
+      break;
+    case StackFrame::Type::THREAD_NAME:
+      SStringPrintf(stringify_buffer,
+                    "[Thread: %s]",
+                    static_cast<const char*>(frame.value));
+      value->SetString("name", *stringify_buffer);
+      break;
+    case StackFrame::Type::PROGRAM_COUNTER:
+      SStringPrintf(stringify_buffer,
+                    "pc:%" PRIxPTR,
+                    reinterpret_cast<uintptr_t>(frame.value));
+      value->SetString("name", *stringify_buffer);
+      break;
+  }
+  if (frame_node.parent_frame_index >= 0) {
+    SStringPrintf(stringify_buffer, "%d", frame_node.parent_frame_index);
+    value->SetString("parent", *stringify_buffer);
+  }
+}
+
+}  // namespace
+
 StackFrameDeduplicator::FrameNode::FrameNode(StackFrame frame,
                                              int parent_frame_index)
     : frame(frame), parent_frame_index(parent_frame_index) {}
@@ -79,29 +113,7 @@ void StackFrameDeduplicator::AppendAsTraceFormat(std::string* out) const {
     out->append(stringify_buffer);
 
     std::unique_ptr<TracedValue> frame_node_value(new TracedValue);
-    const StackFrame& frame = frame_node->frame;
-    switch (frame.type) {
-      case StackFrame::Type::TRACE_EVENT_NAME:
-        frame_node_value->SetString(
-            "name", static_cast<const char*>(frame.value));
-        break;
-      case StackFrame::Type::THREAD_NAME:
-        SStringPrintf(&stringify_buffer,
-                      "[Thread: %s]",
-                      static_cast<const char*>(frame.value));
-        frame_node_value->SetString("name", stringify_buffer);
-        break;
-      case StackFrame::Type::PROGRAM_COUNTER:
-        SStringPrintf(&stringify_buffer,
-                      "pc:%" PRIxPTR,
-                      reinterpret_cast<uintptr_t>(frame.value));
-        frame_node_value->SetString("name", stringify_buffer);
-        break;
-    }
-    if (frame_node->parent_frame_index >= 0) {
-      SStringPrintf(&stringify_buffer, "%d", frame_node->parent_frame_index);
-      frame_node_value->SetString("parent", stringify_buffer);
-    }
+    AppendFrameNodeInto(*frame_node, &stringify_buffer, frame_node_value.get());
     frame_node_value->AppendAsTraceFormat(out);
 
     i++;
@@ -114,6 +126,17 @@ void StackFrameDeduplicator::AppendAsTraceFormat(std::string* out) const {
   out->append("}");  // End the |stackFrames| dictionary.
 }
 
+void StackFrameDeduplicator::AppendFramesFromIndexInto(
+    size_t first_index,
+    TracedValue* value) const {
+  std::string stringify_buffer;
+  for (size_t i = first_index; i < frames_.size(); i++) {
+    value->BeginDictionaryWithCopiedName(SizeTToString(i));
+    AppendFrameNodeInto(frames_[i], &stringify_buffer, value);
+    value->EndDictionary();
+  }
+}
+
 void StackFrameDeduplicator::EstimateTraceMemoryOverhead(
     TraceEventMemoryOverhead* overhead) {
   // The sizes here are only estimates; they fail to take into account the
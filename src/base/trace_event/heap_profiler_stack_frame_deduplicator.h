@@ -18,6 +18,7 @@ namespace base {
 namespace trace_event {
 
 class TraceEventMemoryOverhead;
+class TracedValue;
 
 // A data structure that allows grouping a set of backtraces in a space-
 // efficient manner by creating a call tree and writing it as a set of (node,
@@ -59,10 +60,19 @@ class BASE_EXPORT StackFrameDeduplicator : public ConvertableToTraceFormat {
   ConstIterator begin() const { return frames_.begin(); }
   ConstIterator end() const { return frames_.end(); }
 
+  // Returns the number of frame nodes in the call tree. Nodes are never
+  // removed, so frames with an index above a previous size() are new.
+  size_t size() const { return frames_.size(); }
+
   // Writes the |stackFrames| dictionary as defined in https://goo.gl/GerkV8 to
   // the trace log.
   void AppendAsTraceFormat(std::string* out) const override;
 
+  // Writes the frame nodes with an index of |first_index| or above to the
+  // current dictionary of |value|, in the |stackFrames| format. This allows
+  // sending the call tree incrementally with each memory dump.
+  void AppendFramesFromIndexInto(size_t first_index, TracedValue* value) const;
+
   // Estimates memory overhead including |sizeof(StackFrameDeduplicator)|.
   void EstimateTraceMemoryOverhead(TraceEventMemoryOverhead* overhead) override;
 
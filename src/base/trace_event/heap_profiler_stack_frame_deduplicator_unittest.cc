@@ -9,6 +9,7 @@
 
 #include "base/macros.h"
 #include "base/trace_event/heap_profiler_allocation_context.h"
+#include "base/trace_event/trace_event_argument.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
@@ -148,5 +149,23 @@ TEST(StackFrameDeduplicatorTest, Deduplication) {
   ASSERT_EQ(dedup->begin() + 3, dedup->end());
 }
 
+TEST(StackFrameDeduplicatorTest, AppendFramesFromIndex) {
+  StackFrame bt0[] = {kBrowserMain, kCreateWidget};
+  StackFrame bt1[] = {kBrowserMain, kInitialize};
+
+  std::unique_ptr<StackFrameDeduplicator> dedup(new StackFrameDeduplicator);
+  dedup->Insert(std::begin(bt0), std::end(bt0));
+  ASSERT_EQ(2u, dedup->size());
+  dedup->Insert(std::begin(bt1), std::end(bt1));
+  ASSERT_EQ(3u, dedup->size());
+
+  // Only the frame added by the second backtrace is written.
+  TracedValue value;
+  dedup->AppendFramesFromIndexInto(2, &value);
+  std::string json;
+  value.AppendAsTraceFormat(&json);
+  ASSERT_EQ("{\"2\":{\"name\":\"Initialize\",\"parent\":\"0\"}}", json);
+}
+
 }  // namespace trace_event
 }  // namespace base
@@ -10,7 +10,9 @@
 #include <utility>
 
 #include "base/json/string_escape.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "base/trace_event/trace_event_argument.h"
 #include "base/trace_event/trace_event_memory_overhead.h"
 
 namespace base {
@@ -93,6 +95,24 @@ void TypeNameDeduplicator::AppendAsTraceFormat(std::string* out) const {
   out->append("}");  // End the type names dictionary.
 }
 
+void TypeNameDeduplicator::AppendTypeNamesFromIdInto(
+    int first_id,
+    TracedValue* value) const {
+  for (const auto& type_name_and_id : type_ids_) {
+    if (type_name_and_id.second < first_id)
+      continue;
+    const std::string id = IntToString(type_name_and_id.second);
+    if (!type_name_and_id.first) {
+      value->SetStringWithCopiedName(id, "[unknown]");
+      continue;
+    }
+    // TODO(ssid): crbug.com/594803 the type name is misused for file name in
+    // some cases.
+    value->SetStringWithCopiedName(
+        id, ExtractDirNameFromFileName(type_name_and_id.first));
+  }
+}
+
 void TypeNameDeduplicator::EstimateTraceMemoryOverhead(
     TraceEventMemoryOverhead* overhead) {
   // The size here is only an estimate; it fails to take into account the size
@@ -16,6 +16,7 @@ namespace base {
 namespace trace_event {
 
 class TraceEventMemoryOverhead;
+class TracedValue;
 
 // Data structure that assigns a unique numeric ID to |const char*|s.
 class BASE_EXPORT TypeNameDeduplicator : public ConvertableToTraceFormat {
@@ -26,9 +27,18 @@ class BASE_EXPORT TypeNameDeduplicator : public ConvertableToTraceFormat {
   // Inserts a type name and returns its ID.
   int Insert(const char* type_name);
 
+  // Returns the number of type IDs, including the ID 0 of unknown types. IDs
+  // are assigned sequentially, so IDs above a previous size() are new.
+  size_t size() const { return type_ids_.size(); }
+
   // Writes the type ID -> type name mapping to the trace log.
   void AppendAsTraceFormat(std::string* out) const override;
 
+  // Writes the type names with an ID of |first_id| or above to the current
+  // dictionary of |value|, in the same format as AppendAsTraceFormat(). This
+  // allows sending the mapping incrementally with each memory dump.
+  void AppendTypeNamesFromIdInto(int first_id, TracedValue* value) const;
+
   // Estimates memory overhead including |sizeof(TypeNameDeduplicator)|.
   void EstimateTraceMemoryOverhead(TraceEventMemoryOverhead* overhead) override;
 
@@ -183,10 +183,11 @@ bool MallocDumpProvider::OnMemoryDump(const MemoryDumpArgs& args,
       AutoLock lock(allocation_register_lock_);
       if (allocation_register_) {
         if (args.level_of_detail == MemoryDumpLevelOfDetail::DETAILED) {
+          const size_t sampling_interval =
+              AllocationContextTracker::sampling_interval();
           for (const auto& alloc_size : *allocation_register_) {
-            AllocationMetrics& metrics = metrics_by_context[alloc_size.context];
-            metrics.size += alloc_size.size;
-            metrics.count++;
+            AddAllocationToMetrics(alloc_size.context, alloc_size.size,
+                                   sampling_interval, &metrics_by_context);
           }
         }
         allocation_register_->EstimateTraceMemoryOverhead(&overhead);
@@ -232,6 +233,10 @@ void MallocDumpProvider::InsertAllocation(void* address, size_t size) {
   auto* tracker = AllocationContextTracker::GetInstanceForCurrentThread();
   if (!tracker)
     return;
+  // The unsampled allocations are never inserted. Their removal still looks
+  // them up in the register, which is cheaper than taking a snapshot.
+  if (!tracker->ShouldSampleAllocation(size))
+    return;
   AllocationContext context = tracker->GetContextSnapshot();
 
   AutoLock lock(allocation_register_lock_);
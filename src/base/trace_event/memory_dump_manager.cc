@@ -14,6 +14,7 @@
 #include "base/debug/debugging_flags.h"
 #include "base/debug/stack_trace.h"
 #include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/heap_profiler.h"
@@ -159,6 +160,20 @@ void MemoryDumpManager::EnableHeapProfilingIfNeeded() {
 
   std::string profiling_mode = CommandLine::ForCurrentProcess()
       ->GetSwitchValueASCII(switches::kEnableHeapProfiling);
+
+  // Set before the capture mode, so that every thread samples from its first
+  // allocation.
+  const std::string sampling_interval =
+      CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+          switches::kHeapProfilingSamplingInterval);
+  if (!sampling_interval.empty()) {
+    size_t sampling_interval_bytes = 0;
+    CHECK(StringToSizeT(sampling_interval, &sampling_interval_bytes))
+        << "Invalid value '" << sampling_interval << "' for "
+        << switches::kHeapProfilingSamplingInterval << " flag.";
+    AllocationContextTracker::SetSamplingInterval(sampling_interval_bytes);
+  }
+
   if (profiling_mode == "") {
     AllocationContextTracker::SetCaptureMode(
         AllocationContextTracker::CaptureMode::PSEUDO_STACK);
@@ -610,7 +625,17 @@ void MemoryDumpManager::FinalizeDumpAndAddToTrace(
     ProcessId pid = kv.first;  // kNullProcessId for the current process.
     ProcessMemoryDump* process_memory_dump = kv.second.get();
     std::unique_ptr<TracedValue> traced_value(new TracedValue);
-    process_memory_dump->AsValueInto(traced_value.get());
+    const scoped_refptr<MemoryDumpSessionState>& session_state =
+        process_memory_dump->session_state();
+    if (session_state && session_state->memory_dump_config().delta_dumps) {
+      process_memory_dump->AsDeltaValueInto(pid, traced_value.get());
+      // The heap profiler deduplicators belong to the current process.
+      if (pid == kNullProcessId)
+        session_state->AppendNewHeapProfilerEntriesInto(traced_value.get());
+      traced_value->SetBoolean("is_delta", true);
+    } else {
+      process_memory_dump->AsValueInto(traced_value.get());
+    }
     traced_value->SetString("level_of_detail",
                             MemoryDumpLevelOfDetailToString(
                                 pmd_async_state->req_args.level_of_detail));
@@ -671,24 +696,27 @@ void MemoryDumpManager::OnTraceLogEnabled() {
   if (heap_profiling_enabled_) {
     // If heap profiling is enabled, the stack frame deduplicator and type name
     // deduplicator will be in use. Add a metadata events to write the frames
-    // and type IDs.
+    // and type IDs, unless delta dumps write them along with each dump.
     session_state->SetStackFrameDeduplicator(
         WrapUnique(new StackFrameDeduplicator));
 
     session_state->SetTypeNameDeduplicator(
         WrapUnique(new TypeNameDeduplicator));
 
-    TRACE_EVENT_API_ADD_METADATA_EVENT(
-        TraceLog::GetCategoryGroupEnabled("__metadata"), "stackFrames",
-        "stackFrames",
-        WrapUnique(new SessionStateConvertableProxy<StackFrameDeduplicator>(
-            session_state, &MemoryDumpSessionState::stack_frame_deduplicator)));
-
-    TRACE_EVENT_API_ADD_METADATA_EVENT(
-        TraceLog::GetCategoryGroupEnabled("__metadata"), "typeNames",
-        "typeNames",
-        WrapUnique(new SessionStateConvertableProxy<TypeNameDeduplicator>(
-            session_state, &MemoryDumpSessionState::type_name_deduplicator)));
+    if (!trace_config.memory_dump_config().delta_dumps) {
+      TRACE_EVENT_API_ADD_METADATA_EVENT(
+          TraceLog::GetCategoryGroupEnabled("__metadata"), "stackFrames",
+          "stackFrames",
+          WrapUnique(new SessionStateConvertableProxy<StackFrameDeduplicator>(
+              session_state,
+              &MemoryDumpSessionState::stack_frame_deduplicator)));
+
+      TRACE_EVENT_API_ADD_METADATA_EVENT(
+          TraceLog::GetCategoryGroupEnabled("__metadata"), "typeNames",
+          "typeNames",
+          WrapUnique(new SessionStateConvertableProxy<TypeNameDeduplicator>(
+              session_state, &MemoryDumpSessionState::type_name_deduplicator)));
+    }
   }
 
   {
@@ -4,10 +4,18 @@
 
 #include "base/trace_event/memory_dump_session_state.h"
 
+#include "base/trace_event/trace_event_argument.h"
+
 namespace base {
 namespace trace_event {
 
-MemoryDumpSessionState::MemoryDumpSessionState() {}
+MemoryDumpSessionState::SentAllocatorDumps::SentAllocatorDumps()
+    : dump_count(0) {}
+
+MemoryDumpSessionState::SentAllocatorDumps::~SentAllocatorDumps() {}
+
+MemoryDumpSessionState::MemoryDumpSessionState()
+    : num_sent_stack_frames_(0), num_sent_type_names_(0) {}
 
 MemoryDumpSessionState::~MemoryDumpSessionState() {}
 
@@ -28,5 +36,64 @@ void MemoryDumpSessionState::SetMemoryDumpConfig(
   memory_dump_config_ = config;
 }
 
+void MemoryDumpSessionState::AppendNewHeapProfilerEntriesInto(
+    TracedValue* value) {
+  AutoLock lock(lock_);
+  if (stack_frame_deduplicator_ &&
+      stack_frame_deduplicator_->size() > num_sent_stack_frames_) {
+    value->BeginDictionary("stackFrames");
+    stack_frame_deduplicator_->AppendFramesFromIndexInto(num_sent_stack_frames_,
+                                                         value);
+    value->EndDictionary();
+    num_sent_stack_frames_ = stack_frame_deduplicator_->size();
+  }
+  if (type_name_deduplicator_ &&
+      type_name_deduplicator_->size() > num_sent_type_names_) {
+    value->BeginDictionary("typeNames");
+    type_name_deduplicator_->AppendTypeNamesFromIdInto(
+        static_cast<int>(num_sent_type_names_), value);
+    value->EndDictionary();
+    num_sent_type_names_ = type_name_deduplicator_->size();
+  }
+}
+
+bool MemoryDumpSessionState::UpdateSentAllocatorDump(
+    ProcessId pid,
+    const std::string& absolute_name,
+    const std::string& serialized_dump) {
+  AutoLock lock(lock_);
+  SentAllocatorDumps& sent_dumps = sent_allocator_dumps_[pid];
+  auto it = sent_dumps.dumps.find(absolute_name);
+  if (it == sent_dumps.dumps.end()) {
+    sent_dumps.dumps.insert(std::make_pair(
+        absolute_name,
+        SentAllocatorDump{serialized_dump, sent_dumps.dump_count}));
+    return true;
+  }
+
+  it->second.last_dump = sent_dumps.dump_count;
+  if (it->second.serialized_dump == serialized_dump)
+    return false;
+  it->second.serialized_dump = serialized_dump;
+  return true;
+}
+
+std::vector<std::string> MemoryDumpSessionState::TakeRemovedAllocatorDumps(
+    ProcessId pid) {
+  AutoLock lock(lock_);
+  SentAllocatorDumps& sent_dumps = sent_allocator_dumps_[pid];
+  std::vector<std::string> removed_dumps;
+  for (auto it = sent_dumps.dumps.begin(); it != sent_dumps.dumps.end();) {
+    if (it->second.last_dump != sent_dumps.dump_count) {
+      removed_dumps.push_back(it->first);
+      it = sent_dumps.dumps.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  sent_dumps.dump_count++;
+  return removed_dumps;
+}
+
 }  // namespace trace_event
 }  // namespace base
@@ -5,9 +5,18 @@
 #ifndef BASE_TRACE_EVENT_MEMORY_DUMP_SESSION_STATE_H_
 #define BASE_TRACE_EVENT_MEMORY_DUMP_SESSION_STATE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "base/base_export.h"
+#include "base/process/process_handle.h"
+#include "base/synchronization/lock.h"
 #include "base/trace_event/heap_profiler_stack_frame_deduplicator.h"
 #include "base/trace_event/heap_profiler_type_name_deduplicator.h"
 #include "base/trace_event/trace_config.h"
@@ -15,6 +24,8 @@
 namespace base {
 namespace trace_event {
 
+class TracedValue;
+
 // Container for state variables that should be shared across all the memory
 // dumps in a tracing session.
 class BASE_EXPORT MemoryDumpSessionState
@@ -46,8 +57,49 @@ class BASE_EXPORT MemoryDumpSessionState
 
   void SetMemoryDumpConfig(const TraceConfig::MemoryDumpConfig& config);
 
+  // The methods below keep track of what was already sent to the trace for
+  // delta dumps (see TraceConfig::MemoryDumpConfig::delta_dumps).
+
+  // Writes the stack frames and type names which weren't written by a
+  // previous call to the "stackFrames" and "typeNames" dictionaries of
+  // |value|. This replaces the metadata events which write the complete
+  // deduplicators when the trace is finalized.
+  void AppendNewHeapProfilerEntriesInto(TracedValue* value);
+
+  // Returns false if |serialized_dump| is what the previous dump of process
+  // |pid| sent for the allocator dump |absolute_name|. Otherwise, records it as
+  // sent and returns true.
+  bool UpdateSentAllocatorDump(ProcessId pid,
+                               const std::string& absolute_name,
+                               const std::string& serialized_dump);
+
+  // Forgets the allocator dumps of process |pid| that were sent before but
+  // weren't passed to UpdateSentAllocatorDump() since the previous call, and
+  // returns their names. Must be called once at the end of each dump.
+  std::vector<std::string> TakeRemovedAllocatorDumps(ProcessId pid);
+
  private:
   friend class RefCountedThreadSafe<MemoryDumpSessionState>;
+
+  struct SentAllocatorDump {
+    std::string serialized_dump;
+
+    // The value of |SentAllocatorDumps::dump_count| when the allocator dump
+    // was last part of a dump.
+    uint32_t last_dump;
+  };
+
+  struct SentAllocatorDumps {
+    SentAllocatorDumps();
+    ~SentAllocatorDumps();
+
+    // Number of dumps of the process so far.
+    uint32_t dump_count;
+
+    // Maps allocator dumps absolute names to what was sent for them.
+    std::unordered_map<std::string, SentAllocatorDump> dumps;
+  };
+
   ~MemoryDumpSessionState();
 
   // Deduplicates backtraces in heap dumps so they can be written once when the
@@ -61,6 +113,16 @@ class BASE_EXPORT MemoryDumpSessionState
   // The memory dump config, copied at the time when the tracing session was
   // started.
   TraceConfig::MemoryDumpConfig memory_dump_config_;
+
+  // Protects the members below, which are only used by delta dumps.
+  Lock lock_;
+
+  // Number of frames of |stack_frame_deduplicator_| and type names of
+  // |type_name_deduplicator_| written by AppendNewHeapProfilerEntriesInto().
+  size_t num_sent_stack_frames_;
+  size_t num_sent_type_names_;
+
+  std::map<ProcessId, SentAllocatorDumps> sent_allocator_dumps_;
 };
 
 }  // namespace trace_event
@@ -23,6 +23,7 @@ const char* const kDumpProviderWhitelist[] = {
     "HostDiscardableSharedMemoryManager",
     "IndexedDBBackingStore",
     "JavaHeap",
+    "LevelDBSharedBlockCache",
     "LeveldbValueStore",
     "Malloc",
     "PartitionAlloc",
@@ -46,6 +47,7 @@ const char* const kAllocatorDumpNameWhitelist[] = {
     "java_heap",
     "java_heap/allocated_objects",
     "leveldb/index_db/0x?",
+    "leveldb/shared_block_cache",
     "leveldb/value_store/Extensions.Database.Open.Settings/0x?",
     "leveldb/value_store/Extensions.Database.Open.Rules/0x?",
     "leveldb/value_store/Extensions.Database.Open.State/0x?",
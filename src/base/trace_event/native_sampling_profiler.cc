@@ -0,0 +1,209 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/native_sampling_profiler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/format_macros.h"
+#include "base/logging.h"
+#include "base/memory/singleton.h"
+#include "base/profiler/native_stack_sampler.h"
+#include "base/profiler/stack_sampling_profiler.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/cancellation_flag.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_argument.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+const int kSamplingIntervalMilliseconds = 10;
+const int kHiresSamplingIntervalMilliseconds = 1;
+
+std::string AddressToString(uintptr_t address) {
+  return StringPrintf("0x%" PRIx64, static_cast<uint64_t>(address));
+}
+
+std::unique_ptr<ConvertableToTraceFormat> SampleToTraceFormat(
+    const StackSamplingProfiler::Sample& sample) {
+  std::unique_ptr<TracedValue> data(new TracedValue());
+  data->BeginArray("stack");
+  for (const StackSamplingProfiler::Frame& frame : sample)
+    data->AppendString(AddressToString(frame.instruction_pointer));
+  data->EndArray();
+  return std::move(data);
+}
+
+std::unique_ptr<ConvertableToTraceFormat> ModuleToTraceFormat(
+    const StackSamplingProfiler::Module& module) {
+  std::unique_ptr<TracedValue> data(new TracedValue());
+  data->SetString("base_address", AddressToString(module.base_address));
+  data->SetString("id", module.id);
+  data->SetString("path", module.filename.AsUTF8Unsafe());
+  return std::move(data);
+}
+
+}  // namespace
+
+// Samples the threads in turn and adds the samples to the trace, until
+// stopped.
+class NativeSamplingProfiler::SamplingThread
+    : public PlatformThread::Delegate {
+ public:
+  SamplingThread(const std::vector<PlatformThreadId>& thread_ids,
+                 TimeDelta sampling_interval);
+  ~SamplingThread() override;
+
+  // PlatformThread::Delegate:
+  void ThreadMain() override;
+
+  void Start();
+  void Stop();
+
+ private:
+  const std::vector<PlatformThreadId> thread_ids_;
+  const TimeDelta sampling_interval_;
+  CancellationFlag cancellation_flag_;
+  PlatformThreadHandle sampling_thread_handle_;
+
+  DISALLOW_COPY_AND_ASSIGN(SamplingThread);
+};
+
+NativeSamplingProfiler::SamplingThread::SamplingThread(
+    const std::vector<PlatformThreadId>& thread_ids,
+    TimeDelta sampling_interval)
+    : thread_ids_(thread_ids), sampling_interval_(sampling_interval) {}
+
+NativeSamplingProfiler::SamplingThread::~SamplingThread() {}
+
+void NativeSamplingProfiler::SamplingThread::ThreadMain() {
+  PlatformThread::SetName("NativeSamplingProfilerThread");
+
+  // All the samplers share the module list, so that each module is added to
+  // the trace once.
+  std::vector<StackSamplingProfiler::Module> modules;
+  std::vector<PlatformThreadId> sampled_thread_ids;
+  std::vector<std::unique_ptr<NativeStackSampler>> samplers;
+  for (PlatformThreadId thread_id : thread_ids_) {
+    std::unique_ptr<NativeStackSampler> sampler =
+        NativeStackSampler::Create(thread_id, nullptr);
+    if (!sampler)
+      continue;
+    sampler->ProfileRecordingStarting(&modules);
+    sampled_thread_ids.push_back(thread_id);
+    samplers.push_back(std::move(sampler));
+  }
+
+  size_t traced_modules = 0;
+  StackSamplingProfiler::Sample sample;
+  while (!samplers.empty() && !cancellation_flag_.IsSet()) {
+    TimeTicks next_sample_time = TimeTicks::Now() + sampling_interval_;
+    for (size_t i = 0; i < samplers.size(); ++i) {
+      TimeTicks timestamp = TimeTicks::Now();
+      samplers[i]->RecordStackSample(&sample);
+      if (sample.empty())
+        continue;
+      TRACE_EVENT_SAMPLE_WITH_TID_AND_TIMESTAMP1(
+          TRACE_DISABLED_BY_DEFAULT("cpu_profiler"), "NativeSample",
+          sampled_thread_ids[i], (timestamp - TimeTicks()).InMicroseconds(),
+          "data", SampleToTraceFormat(sample));
+    }
+    for (; traced_modules < modules.size(); ++traced_modules) {
+      TRACE_EVENT_METADATA1(TRACE_DISABLED_BY_DEFAULT("cpu_profiler"),
+                            "NativeModule", "data",
+                            ModuleToTraceFormat(modules[traced_modules]));
+    }
+    PlatformThread::Sleep(
+        std::max(next_sample_time - TimeTicks::Now(), TimeDelta()));
+  }
+
+  for (const std::unique_ptr<NativeStackSampler>& sampler : samplers)
+    sampler->ProfileRecordingStopped();
+}
+
+void NativeSamplingProfiler::SamplingThread::Start() {
+  if (!PlatformThread::Create(0, this, &sampling_thread_handle_))
+    DLOG(ERROR) << "failed to create sampling thread";
+}
+
+void NativeSamplingProfiler::SamplingThread::Stop() {
+  if (sampling_thread_handle_.is_null())
+    return;
+  cancellation_flag_.Set();
+  // The thread exits within one sampling interval, so joining it is quick
+  // enough for any thread that disables tracing.
+  ThreadRestrictions::ScopedAllowIO allow_io;
+  PlatformThread::Join(sampling_thread_handle_);
+  sampling_thread_handle_ = PlatformThreadHandle();
+}
+
+// static
+NativeSamplingProfiler* NativeSamplingProfiler::GetInstance() {
+  return Singleton<NativeSamplingProfiler,
+                   LeakySingletonTraits<NativeSamplingProfiler>>::get();
+}
+
+NativeSamplingProfiler::NativeSamplingProfiler() {
+  // Force the "cpu_profiler*" categories to show up in the trace viewer.
+  TraceLog::GetCategoryGroupEnabled(TRACE_DISABLED_BY_DEFAULT("cpu_profiler"));
+  TraceLog::GetCategoryGroupEnabled(
+      TRACE_DISABLED_BY_DEFAULT("cpu_profiler.hires"));
+  TraceLog::GetInstance()->AddEnabledStateObserver(this);
+}
+
+NativeSamplingProfiler::~NativeSamplingProfiler() {
+  TraceLog::GetInstance()->RemoveEnabledStateObserver(this);
+}
+
+void NativeSamplingProfiler::RegisterCurrentThread() {
+  AutoLock lock(lock_);
+  PlatformThreadId thread_id = PlatformThread::CurrentId();
+  if (std::find(thread_ids_.begin(), thread_ids_.end(), thread_id) ==
+      thread_ids_.end()) {
+    thread_ids_.push_back(thread_id);
+  }
+}
+
+void NativeSamplingProfiler::OnTraceLogEnabled() {
+  bool enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("cpu_profiler"),
+                                     &enabled);
+  if (!enabled)
+    return;
+  bool enabled_hires;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(
+      TRACE_DISABLED_BY_DEFAULT("cpu_profiler.hires"), &enabled_hires);
+
+  AutoLock lock(lock_);
+  if (sampling_thread_ || thread_ids_.empty())
+    return;
+  sampling_thread_.reset(new SamplingThread(
+      thread_ids_,
+      TimeDelta::FromMilliseconds(enabled_hires
+                                      ? kHiresSamplingIntervalMilliseconds
+                                      : kSamplingIntervalMilliseconds)));
+  sampling_thread_->Start();
+}
+
+void NativeSamplingProfiler::OnTraceLogDisabled() {
+  std::unique_ptr<SamplingThread> sampling_thread;
+  {
+    AutoLock lock(lock_);
+    sampling_thread = std::move(sampling_thread_);
+  }
+  if (sampling_thread)
+    sampling_thread->Stop();
+}
+
+}  // namespace trace_event
+}  // namespace base
@@ -0,0 +1,70 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TRACE_EVENT_NATIVE_SAMPLING_PROFILER_H_
+#define BASE_TRACE_EVENT_NATIVE_SAMPLING_PROFILER_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+#include "base/trace_event/trace_log.h"
+
+namespace base {
+
+template <typename T>
+struct DefaultSingletonTraits;
+
+namespace trace_event {
+
+// Records native stack samples of the registered threads into the trace while
+// the "disabled-by-default-cpu_profiler" category is enabled, every 10ms, or
+// every 1ms with "disabled-by-default-cpu_profiler.hires".
+//
+// Each "NativeSample" event carries the absolute addresses of the sampled
+// frames, innermost first. A "NativeModule" metadata event is added for every
+// module seen in a sample, with its base address, build ID and path, which is
+// enough to symbolize the samples offline. Sampling is only supported where
+// NativeStackSampler is, and relies on frame pointers on Linux and Android.
+class BASE_EXPORT NativeSamplingProfiler
+    : public TraceLog::EnabledStateObserver {
+ public:
+  static NativeSamplingProfiler* GetInstance();
+
+  // Adds the calling thread to the sampled threads, typically the main thread
+  // of a process. Takes effect the next time tracing is enabled.
+  void RegisterCurrentThread();
+
+  // TraceLog::EnabledStateObserver implementation.
+  void OnTraceLogEnabled() override;
+  void OnTraceLogDisabled() override;
+
+ private:
+  friend std::default_delete<NativeSamplingProfiler>;  // For tests.
+  friend struct DefaultSingletonTraits<NativeSamplingProfiler>;
+  friend class NativeSamplingProfilerTest;
+
+  class SamplingThread;
+
+  NativeSamplingProfiler();
+  ~NativeSamplingProfiler() override;
+
+  // Guards the members below.
+  Lock lock_;
+
+  std::vector<PlatformThreadId> thread_ids_;
+
+  // Runs while tracing with the category enabled.
+  std::unique_ptr<SamplingThread> sampling_thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(NativeSamplingProfiler);
+};
+
+}  // namespace trace_event
+}  // namespace base
+
+#endif  // BASE_TRACE_EVENT_NATIVE_SAMPLING_PROFILER_H_
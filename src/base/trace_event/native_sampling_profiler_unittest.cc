@@ -0,0 +1,114 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/native_sampling_profiler.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/test/trace_event_analyzer.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_buffer.h"
+#include "base/trace_event/trace_event.h"
+#include "build/build_config.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+void OnTraceDataCollected(Closure quit_closure,
+                          TraceResultBuffer* buffer,
+                          const scoped_refptr<RefCountedString>& json,
+                          bool has_more_events) {
+  buffer->AddFragment(json->data());
+  if (!has_more_events)
+    quit_closure.Run();
+}
+
+// Keeps the thread busy so that it has a stack to sample.
+NOINLINE int Spin(TimeDelta duration) {
+  TimeTicks end = TimeTicks::Now() + duration;
+  int iterations = 0;
+  while (TimeTicks::Now() < end)
+    iterations++;
+  return iterations;
+}
+
+}  // namespace
+
+class NativeSamplingProfilerTest : public testing::Test {
+ public:
+  NativeSamplingProfilerTest() : profiler_(new NativeSamplingProfiler) {}
+
+ protected:
+  std::unique_ptr<trace_analyzer::TraceAnalyzer> Flush() {
+    TraceResultBuffer buffer;
+    TraceResultBuffer::SimpleOutput trace_output;
+    buffer.SetOutputCallback(trace_output.GetCallback());
+    RunLoop run_loop;
+    buffer.Start();
+    TraceLog::GetInstance()->Flush(Bind(&OnTraceDataCollected,
+                                        run_loop.QuitClosure(),
+                                        Unretained(&buffer)));
+    run_loop.Run();
+    buffer.Finish();
+    return WrapUnique(
+        trace_analyzer::TraceAnalyzer::Create(trace_output.json_output));
+  }
+
+  MessageLoop message_loop_;
+  std::unique_ptr<NativeSamplingProfiler> profiler_;
+};
+
+#if (defined(OS_LINUX) || defined(OS_ANDROID)) && \
+    (defined(ARCH_CPU_X86_FAMILY) || defined(ARCH_CPU_ARM64))
+#define MAYBE_SamplesRegisteredThread SamplesRegisteredThread
+#else
+#define MAYBE_SamplesRegisteredThread DISABLED_SamplesRegisteredThread
+#endif
+TEST_F(NativeSamplingProfilerTest, MAYBE_SamplesRegisteredThread) {
+  using trace_analyzer::Query;
+  profiler_->RegisterCurrentThread();
+
+  TraceLog::GetInstance()->SetEnabled(
+      TraceConfig(TRACE_DISABLED_BY_DEFAULT("cpu_profiler"), ""),
+      TraceLog::RECORDING_MODE);
+  EXPECT_GT(Spin(TimeDelta::FromMilliseconds(200)), 0);
+  TraceLog::GetInstance()->SetDisabled();
+
+  std::unique_ptr<trace_analyzer::TraceAnalyzer> analyzer = Flush();
+  trace_analyzer::TraceEventVector samples;
+  analyzer->FindEvents(Query::EventNameIs("NativeSample"), &samples);
+  ASSERT_FALSE(samples.empty());
+  EXPECT_EQ(static_cast<int>(PlatformThread::CurrentId()),
+            samples[0]->thread.thread_id);
+  EXPECT_TRUE(samples[0]->HasArg("data"));
+
+  trace_analyzer::TraceEventVector modules;
+  analyzer->FindEvents(Query::EventNameIs("NativeModule"), &modules);
+  EXPECT_FALSE(modules.empty());
+}
+
+TEST_F(NativeSamplingProfilerTest, NoSamplesWhenCategoryDisabled) {
+  using trace_analyzer::Query;
+  profiler_->RegisterCurrentThread();
+
+  TraceLog::GetInstance()->SetEnabled(TraceConfig("*", ""),
+                                      TraceLog::RECORDING_MODE);
+  Spin(TimeDelta::FromMilliseconds(50));
+  TraceLog::GetInstance()->SetDisabled();
+
+  trace_analyzer::TraceEventVector samples;
+  Flush()->FindEvents(Query::EventNameIs("NativeSample"), &samples);
+  EXPECT_TRUE(samples.empty());
+}
+
+}  // namespace trace_event
+}  // namespace base
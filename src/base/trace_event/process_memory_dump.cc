@@ -6,6 +6,7 @@
 
 #include <errno.h>
 
+#include <string>
 #include <vector>
 
 #include "base/memory/ptr_util.h"
@@ -300,6 +301,18 @@ void ProcessMemoryDump::TakeAllDumpsFrom(ProcessMemoryDump* other) {
 }
 
 void ProcessMemoryDump::AsValueInto(TracedValue* value) const {
+  AsValueIntoInternal(false /* is_delta */, kNullProcessId, value);
+}
+
+void ProcessMemoryDump::AsDeltaValueInto(ProcessId pid,
+                                         TracedValue* value) const {
+  DCHECK(session_state_);
+  AsValueIntoInternal(true /* is_delta */, pid, value);
+}
+
+void ProcessMemoryDump::AsValueIntoInternal(bool is_delta,
+                                            ProcessId pid,
+                                            TracedValue* value) const {
   if (has_process_totals_) {
     value->BeginDictionary("process_totals");
     process_totals_.AsValueInto(value);
@@ -312,7 +325,37 @@ void ProcessMemoryDump::AsValueInto(TracedValue* value) const {
     value->EndDictionary();
   }
 
-  if (allocator_dumps_.size() > 0) {
+  if (is_delta) {
+    // Serialize each allocator dump on its own to tell whether it changed.
+    bool has_allocators = false;
+    std::string serialized_dump;
+    for (const auto& allocator_dump_it : allocator_dumps_) {
+      TracedValue dump_value;
+      allocator_dump_it.second->AsValueInto(&dump_value);
+      serialized_dump.clear();
+      dump_value.AppendAsTraceFormat(&serialized_dump);
+      if (!session_state_->UpdateSentAllocatorDump(
+              pid, allocator_dump_it.first, serialized_dump)) {
+        continue;
+      }
+      if (!has_allocators) {
+        value->BeginDictionary("allocators");
+        has_allocators = true;
+      }
+      allocator_dump_it.second->AsValueInto(value);
+    }
+    if (has_allocators)
+      value->EndDictionary();
+
+    const std::vector<std::string> removed_dumps =
+        session_state_->TakeRemovedAllocatorDumps(pid);
+    if (!removed_dumps.empty()) {
+      value->BeginArray("removed_allocators");
+      for (const std::string& absolute_name : removed_dumps)
+        value->AppendString(absolute_name);
+      value->EndArray();
+    }
+  } else if (allocator_dumps_.size() > 0) {
     value->BeginDictionary("allocators");
     for (const auto& allocator_dump_it : allocator_dumps_)
       allocator_dump_it.second->AsValueInto(value);
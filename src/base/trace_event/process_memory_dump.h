@@ -14,6 +14,7 @@
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_vector.h"
+#include "base/process/process_handle.h"
 #include "base/trace_event/memory_allocator_dump.h"
 #include "base/trace_event/memory_allocator_dump_guid.h"
 #include "base/trace_event/memory_dump_request_args.h"
@@ -167,6 +168,12 @@ class BASE_EXPORT ProcessMemoryDump {
   // Called at trace generation time to populate the TracedValue.
   void AsValueInto(TracedValue* value) const;
 
+  // Like AsValueInto(), but for delta dumps: leaves out the allocator dumps
+  // which are identical to the ones sent by the previous dump of process |pid|
+  // in the session, and lists the names of the ones which are gone in
+  // "removed_allocators". Requires a session state.
+  void AsDeltaValueInto(ProcessId pid, TracedValue* value) const;
+
   ProcessMemoryTotals* process_totals() { return &process_totals_; }
   bool has_process_totals() const { return has_process_totals_; }
   void set_has_process_totals() { has_process_totals_ = true; }
@@ -187,6 +194,11 @@ class BASE_EXPORT ProcessMemoryDump {
 
   MemoryAllocatorDump* GetBlackHoleMad();
 
+  // Implements AsValueInto() and, if |is_delta| is true, AsDeltaValueInto().
+  void AsValueIntoInternal(bool is_delta,
+                           ProcessId pid,
+                           TracedValue* value) const;
+
   ProcessMemoryTotals process_totals_;
   bool has_process_totals_;
 
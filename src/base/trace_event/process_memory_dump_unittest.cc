@@ -6,12 +6,14 @@
 
 #include <stddef.h>
 
+#include "base/json/json_reader.h"
 #include "base/memory/aligned_memory.h"
 #include "base/memory/ptr_util.h"
 #include "base/process/process_metrics.h"
 #include "base/trace_event/memory_allocator_dump_guid.h"
 #include "base/trace_event/memory_infra_background_whitelist.h"
 #include "base/trace_event/trace_event_argument.h"
+#include "base/values.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
@@ -29,6 +31,14 @@ TracedValue* GetHeapDump(const ProcessMemoryDump& pmd, const char* name) {
   return it == pmd.heap_dumps().end() ? nullptr : it->second.get();
 }
 
+std::unique_ptr<DictionaryValue> GetDeltaDump(const ProcessMemoryDump& pmd) {
+  TracedValue traced_value;
+  pmd.AsDeltaValueInto(kNullProcessId, &traced_value);
+  std::string json;
+  traced_value.AppendAsTraceFormat(&json);
+  return DictionaryValue::From(JSONReader::Read(json));
+}
+
 }  // namespace
 
 TEST(ProcessMemoryDumpTest, Clear) {
@@ -209,6 +219,54 @@ TEST(ProcessMemoryDumpTest, Suballocations) {
   pmd.reset();
 }
 
+TEST(ProcessMemoryDumpTest, DeltaDumps) {
+  scoped_refptr<MemoryDumpSessionState> session_state =
+      new MemoryDumpSessionState;
+  std::unique_ptr<ProcessMemoryDump> pmd(
+      new ProcessMemoryDump(session_state, kDetailedDumpArgs));
+  pmd->CreateAllocatorDump("mad1")->AddScalar("size", "bytes", 1);
+  pmd->CreateAllocatorDump("mad2")->AddScalar("size", "bytes", 2);
+
+  // The first dump contains all the allocator dumps.
+  std::unique_ptr<DictionaryValue> dump = GetDeltaDump(*pmd);
+  ASSERT_TRUE(dump);
+  EXPECT_TRUE(dump->HasKey("allocators.mad1"));
+  EXPECT_TRUE(dump->HasKey("allocators.mad2"));
+  EXPECT_FALSE(dump->HasKey("removed_allocators"));
+
+  // Unchanged allocator dumps are left out.
+  pmd.reset(new ProcessMemoryDump(session_state, kDetailedDumpArgs));
+  pmd->CreateAllocatorDump("mad1")->AddScalar("size", "bytes", 1);
+  pmd->CreateAllocatorDump("mad2")->AddScalar("size", "bytes", 3);
+  dump = GetDeltaDump(*pmd);
+  ASSERT_TRUE(dump);
+  EXPECT_FALSE(dump->HasKey("allocators.mad1"));
+  EXPECT_TRUE(dump->HasKey("allocators.mad2"));
+  EXPECT_FALSE(dump->HasKey("removed_allocators"));
+
+  pmd.reset(new ProcessMemoryDump(session_state, kDetailedDumpArgs));
+  pmd->CreateAllocatorDump("mad2")->AddScalar("size", "bytes", 3);
+  dump = GetDeltaDump(*pmd);
+  ASSERT_TRUE(dump);
+  EXPECT_FALSE(dump->HasKey("allocators"));
+  const ListValue* removed_allocators = nullptr;
+  ASSERT_TRUE(dump->GetList("removed_allocators", &removed_allocators));
+  ASSERT_EQ(1u, removed_allocators->GetSize());
+  std::string removed_name;
+  ASSERT_TRUE(removed_allocators->GetString(0, &removed_name));
+  EXPECT_EQ("mad1", removed_name);
+
+  // An allocator dump which comes back is sent again.
+  pmd.reset(new ProcessMemoryDump(session_state, kDetailedDumpArgs));
+  pmd->CreateAllocatorDump("mad1")->AddScalar("size", "bytes", 1);
+  pmd->CreateAllocatorDump("mad2")->AddScalar("size", "bytes", 3);
+  dump = GetDeltaDump(*pmd);
+  ASSERT_TRUE(dump);
+  EXPECT_TRUE(dump->HasKey("allocators.mad1"));
+  EXPECT_FALSE(dump->HasKey("allocators.mad2"));
+  EXPECT_FALSE(dump->HasKey("removed_allocators"));
+}
+
 TEST(ProcessMemoryDumpTest, GlobalAllocatorDumpTest) {
   std::unique_ptr<ProcessMemoryDump> pmd(
       new ProcessMemoryDump(nullptr, kDetailedDumpArgs));
@@ -4,12 +4,19 @@
 
 #include "base/trace_event/trace_buffer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "base/debug/leak_annotations.h"
 #include "base/macros.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
 #include "base/trace_event/heap_profiler.h"
+#include "base/trace_event/trace_event_binary_writer.h"
 #include "base/trace_event/trace_event_impl.h"
 
 namespace base {
@@ -240,6 +247,332 @@ class TraceBufferVector : public TraceBuffer {
   DISALLOW_COPY_AND_ASSIGN(TraceBufferVector);
 };
 
+// A bounded multi-producer multi-consumer queue of chunk indices, after Dmitry
+// Vyukov's algorithm: the sequence number of each cell tells whether it can be
+// written or read during the current lap around the array.
+class ChunkIndexQueue {
+ public:
+  // |min_capacity| is rounded up to a power of 2.
+  explicit ChunkIndexQueue(size_t min_capacity)
+      : capacity_(RoundUpToPowerOfTwo(min_capacity)),
+        cells_(new Cell[capacity_]),
+        enqueue_pos_(0),
+        dequeue_pos_(0) {
+    for (size_t i = 0; i < capacity_; ++i)
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  // Returns false if the queue is full.
+  bool TryPush(size_t value) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell* const cell = &cells_[pos & (capacity_ - 1)];
+      const intptr_t diff =
+          static_cast<intptr_t>(
+              cell->sequence.load(std::memory_order_acquire)) -
+          static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          cell->value = value;
+          cell->sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Returns false if the queue is empty.
+  bool TryPop(size_t* value) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell* const cell = &cells_[pos & (capacity_ - 1)];
+      const intptr_t diff =
+          static_cast<intptr_t>(
+              cell->sequence.load(std::memory_order_acquire)) -
+          static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          *value = cell->value;
+          cell->sequence.store(pos + capacity_, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    size_t value;
+  };
+
+  static size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value)
+      power <<= 1;
+    return power;
+  }
+
+  const size_t capacity_;
+  const std::unique_ptr<Cell[]> cells_;
+  std::atomic<size_t> enqueue_pos_;
+  std::atomic<size_t> dequeue_pos_;
+
+  DISALLOW_COPY_AND_ASSIGN(ChunkIndexQueue);
+};
+
+// Streams the chunks returned to it to a file from a background thread. Chunks
+// move between the recording threads and the writer thread through
+// |free_chunks_| and |returned_chunks_|; the slot of a chunk in |chunks_| is
+// only accessed by the thread which popped its index from one of them.
+//
+// Instances are leaked once stopped, so that threads which still hold a chunk
+// at the end of the session can safely return it.
+class TraceBufferStreamingCore : public TraceBuffer,
+                                 public PlatformThread::Delegate {
+ public:
+  TraceBufferStreamingCore(size_t max_chunks, File output)
+      : max_chunks_(max_chunks),
+        chunks_(new std::unique_ptr<TraceBufferChunk>[max_chunks]),
+        free_chunks_(max_chunks),
+        returned_chunks_(max_chunks),
+        wake_up_threshold_(std::max<size_t>(max_chunks / 4, 1)),
+        output_(std::move(output)),
+        wake_up_(WaitableEvent::ResetPolicy::AUTOMATIC,
+                 WaitableEvent::InitialState::NOT_SIGNALED),
+        next_chunk_seq_(1),
+        num_returned_chunks_(0),
+        num_allocated_chunks_(0),
+        num_dropped_events_(0),
+        output_buffer_capacity_(0),
+        stopped_(false) {
+    for (size_t i = 0; i < max_chunks; ++i)
+      free_chunks_.TryPush(i);
+    TraceEventBinaryWriter::AppendHeader(&output_buffer_);
+    if (!PlatformThread::CreateNonJoinable(0, this)) {
+      DLOG(ERROR) << "Failed to create the trace streaming thread";
+      stopped_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // Makes the writer thread write the chunks returned so far, close the output
+  // and exit. Chunks returned afterwards are deleted.
+  void Stop() {
+    stopped_.store(true, std::memory_order_release);
+    wake_up_.Signal();
+  }
+
+  std::unique_ptr<TraceBufferChunk> GetChunk(size_t* index) override {
+    HEAP_PROFILER_SCOPED_IGNORE;
+
+    if (stopped_.load(std::memory_order_acquire))
+      return nullptr;
+    if (!free_chunks_.TryPop(index)) {
+      // The writer thread can't keep up. Drop the event rather than blocking
+      // the recording thread.
+      num_dropped_events_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    std::unique_ptr<TraceBufferChunk> chunk = std::move(chunks_[*index]);
+    const uint32_t seq =
+        next_chunk_seq_.fetch_add(1, std::memory_order_relaxed);
+    if (chunk) {
+      chunk->Reset(seq);
+    } else {
+      chunk.reset(new TraceBufferChunk(seq));
+      num_allocated_chunks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return chunk;
+  }
+
+  void ReturnChunk(size_t index,
+                   std::unique_ptr<TraceBufferChunk> chunk) override {
+    DCHECK(chunk);
+    DCHECK_LT(index, max_chunks_);
+    if (stopped_.load(std::memory_order_acquire))
+      return;
+
+    chunks_[index] = std::move(chunk);
+    // Can't fail: the queue can hold all the chunks.
+    const bool pushed = returned_chunks_.TryPush(index);
+    DCHECK(pushed);
+
+    // The writer thread wakes up periodically. Wake it up early if chunks are
+    // returned faster than it writes them.
+    if (num_returned_chunks_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+        wake_up_threshold_) {
+      wake_up_.Signal();
+    }
+  }
+
+  bool IsFull() const override { return false; }
+
+  size_t Size() const override {
+    // This is approximate because not all of the chunks are full.
+    return num_allocated_chunks_.load(std::memory_order_relaxed) *
+           TraceBufferChunk::kTraceBufferChunkSize;
+  }
+
+  size_t Capacity() const override {
+    return max_chunks_ * TraceBufferChunk::kTraceBufferChunkSize;
+  }
+
+  // Returned chunks are owned by the writer thread.
+  TraceEvent* GetEventByHandle(TraceEventHandle handle) override {
+    return NULL;
+  }
+
+  // The events aren't retained once written.
+  const TraceBufferChunk* NextChunk() override { return NULL; }
+
+  void EstimateTraceMemoryOverhead(
+      TraceEventMemoryOverhead* overhead) override {
+    // The chunks can't be inspected while other threads use them.
+    overhead->Add("TraceBufferStreaming",
+                  sizeof(*this) +
+                      max_chunks_ * sizeof(std::unique_ptr<TraceBufferChunk>) +
+                      num_allocated_chunks_.load(std::memory_order_relaxed) *
+                          sizeof(TraceBufferChunk) +
+                      output_buffer_capacity_.load(std::memory_order_relaxed));
+  }
+
+  TraceBuffer* GetLockFreeChunkBuffer() override { return this; }
+
+  // PlatformThread::Delegate:
+  void ThreadMain() override {
+    PlatformThread::SetName("TraceStreamingWriter");
+    while (!stopped_.load(std::memory_order_acquire)) {
+      wake_up_.TimedWait(TimeDelta::FromMilliseconds(kWriteIntervalMs));
+      WriteReturnedChunks();
+    }
+    // Write the chunks returned before Stop() and release the memory of the
+    // free chunks, since this object is leaked.
+    WriteReturnedChunks();
+    output_.Close();
+    size_t index;
+    while (free_chunks_.TryPop(&index))
+      chunks_[index].reset();
+    output_buffer_.clear();
+    output_buffer_.shrink_to_fit();
+  }
+
+ private:
+  static const int kWriteIntervalMs = 500;
+  static const size_t kOutputBufferSize = 64 * 1024;
+
+  void WriteReturnedChunks() {
+    size_t index;
+    while (returned_chunks_.TryPop(&index)) {
+      num_returned_chunks_.fetch_sub(1, std::memory_order_relaxed);
+      TraceBufferChunk* chunk = chunks_[index].get();
+      for (size_t i = 0; i < chunk->size(); ++i)
+        writer_.AppendEvent(*chunk->GetEventAt(i), &output_buffer_);
+      // Release what the events hold here rather than on the recording thread
+      // which gets the chunk next.
+      chunk->Reset(0);
+      free_chunks_.TryPush(index);
+
+      if (output_buffer_.size() >= kOutputBufferSize)
+        WriteOutputBuffer();
+    }
+
+    const size_t num_dropped_events =
+        num_dropped_events_.exchange(0, std::memory_order_relaxed);
+    if (num_dropped_events)
+      writer_.AppendDroppedEvents(num_dropped_events, &output_buffer_);
+    WriteOutputBuffer();
+  }
+
+  void WriteOutputBuffer() {
+    if (output_buffer_.empty())
+      return;
+    const int size = static_cast<int>(output_buffer_.size());
+    if (output_.IsValid() &&
+        output_.WriteAtCurrentPos(output_buffer_.data(), size) != size) {
+      DPLOG(ERROR) << "Failed to write the trace stream";
+      output_.Close();
+    }
+    output_buffer_.clear();
+    output_buffer_capacity_.store(output_buffer_.capacity(),
+                                  std::memory_order_relaxed);
+  }
+
+  const size_t max_chunks_;
+  const std::unique_ptr<std::unique_ptr<TraceBufferChunk>[]> chunks_;
+  ChunkIndexQueue free_chunks_;
+  ChunkIndexQueue returned_chunks_;
+  const size_t wake_up_threshold_;
+
+  // Only accessed by the writer thread.
+  File output_;
+  TraceEventBinaryWriter writer_;
+  std::string output_buffer_;
+
+  WaitableEvent wake_up_;
+  std::atomic<uint32_t> next_chunk_seq_;
+  std::atomic<size_t> num_returned_chunks_;
+  std::atomic<size_t> num_allocated_chunks_;
+  std::atomic<size_t> num_dropped_events_;
+  std::atomic<size_t> output_buffer_capacity_;
+  std::atomic<bool> stopped_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceBufferStreamingCore);
+};
+
+// Owns a leaked TraceBufferStreamingCore for TraceLog, and stops it when
+// TraceLog is done with the buffer.
+class TraceBufferStreaming : public TraceBuffer {
+ public:
+  TraceBufferStreaming(size_t max_chunks, File output)
+      : core_(new TraceBufferStreamingCore(max_chunks, std::move(output))) {
+    ANNOTATE_LEAKING_OBJECT_PTR(core_);
+  }
+
+  ~TraceBufferStreaming() override { core_->Stop(); }
+
+  std::unique_ptr<TraceBufferChunk> GetChunk(size_t* index) override {
+    return core_->GetChunk(index);
+  }
+
+  void ReturnChunk(size_t index,
+                   std::unique_ptr<TraceBufferChunk> chunk) override {
+    core_->ReturnChunk(index, std::move(chunk));
+  }
+
+  bool IsFull() const override { return core_->IsFull(); }
+  size_t Size() const override { return core_->Size(); }
+  size_t Capacity() const override { return core_->Capacity(); }
+
+  TraceEvent* GetEventByHandle(TraceEventHandle handle) override {
+    return core_->GetEventByHandle(handle);
+  }
+
+  const TraceBufferChunk* NextChunk() override { return core_->NextChunk(); }
+
+  void EstimateTraceMemoryOverhead(
+      TraceEventMemoryOverhead* overhead) override {
+    core_->EstimateTraceMemoryOverhead(overhead);
+  }
+
+  TraceBuffer* GetLockFreeChunkBuffer() override { return core_; }
+
+ private:
+  TraceBufferStreamingCore* const core_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceBufferStreaming);
+};
+
 }  // namespace
 
 TraceBufferChunk::TraceBufferChunk(uint32_t seq) : next_free_(0), seq_(seq) {}
@@ -340,5 +673,10 @@ TraceBuffer* TraceBuffer::CreateTraceBufferVectorOfSize(size_t max_chunks) {
   return new TraceBufferVector(max_chunks);
 }
 
+TraceBuffer* TraceBuffer::CreateTraceBufferStreaming(size_t max_chunks,
+                                                     File output) {
+  return new TraceBufferStreaming(max_chunks, std::move(output));
+}
+
 }  // namespace trace_event
 }  // namespace base
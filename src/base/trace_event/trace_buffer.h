@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include "base/base_export.h"
+#include "base/files/file.h"
 #include "base/trace_event/trace_event.h"
 #include "base/trace_event/trace_event_impl.h"
 
@@ -77,8 +78,23 @@ class BASE_EXPORT TraceBuffer {
   virtual void EstimateTraceMemoryOverhead(
       TraceEventMemoryOverhead* overhead) = 0;
 
+  // Returns a buffer whose GetChunk() and ReturnChunk() can be called without
+  // holding the TraceLog lock, or NULL if this buffer requires the lock. The
+  // returned buffer outlives this one.
+  virtual TraceBuffer* GetLockFreeChunkBuffer() { return NULL; }
+
   static TraceBuffer* CreateTraceBufferRingBuffer(size_t max_chunks);
   static TraceBuffer* CreateTraceBufferVectorOfSize(size_t max_chunks);
+
+  // Creates a buffer which writes the chunks returned to it to |output| in the
+  // format of TraceEventBinaryWriter, from a background thread, and recycles
+  // them. Chunks are claimed and returned with atomic operations. Events are
+  // dropped while all |max_chunks| chunks are in use. Events can't be
+  // retrieved by handle once their chunk is returned, and NextChunk() returns
+  // NULL. |output| is closed after the buffer is deleted and the chunks
+  // returned until then are written.
+  static TraceBuffer* CreateTraceBufferStreaming(size_t max_chunks,
+                                                 File output);
 };
 
 // TraceResultBuffer collects and converts trace fragments returned by TraceLog
@@ -53,6 +53,7 @@ const char kPeriodicIntervalParam[] = "periodic_interval_ms";
 const char kModeParam[] = "mode";
 const char kHeapProfilerOptions[] = "heap_profiler_options";
 const char kBreakdownThresholdBytes[] = "breakdown_threshold_bytes";
+const char kDeltaDumpsParam[] = "delta_dumps";
 
 // Default configuration of memory dumps.
 const TraceConfig::MemoryDumpConfig::Trigger kDefaultHeavyMemoryDumpTrigger = {
@@ -101,7 +102,7 @@ void TraceConfig::ResetMemoryDumpConfig(
   memory_dump_config_ = memory_dump_config;
 }
 
-TraceConfig::MemoryDumpConfig::MemoryDumpConfig() {};
+TraceConfig::MemoryDumpConfig::MemoryDumpConfig() : delta_dumps(false) {};
 
 TraceConfig::MemoryDumpConfig::MemoryDumpConfig(
     const MemoryDumpConfig& other) = default;
@@ -112,6 +113,7 @@ void TraceConfig::MemoryDumpConfig::Clear() {
   allowed_dump_modes.clear();
   triggers.clear();
   heap_profiler_options.Clear();
+  delta_dumps = false;
 }
 
 TraceConfig::TraceConfig() {
@@ -582,6 +584,12 @@ void TraceConfig::SetMemoryDumpConfigFromConfigDict(
           MemoryDumpConfig::HeapProfiler::kDefaultBreakdownThresholdBytes;
     }
   }
+
+  // Set delta dumps
+  bool delta_dumps = false;
+  memory_dump_config_.delta_dumps =
+      memory_dump_config.GetBoolean(kDeltaDumpsParam, &delta_dumps) &&
+      delta_dumps;
 }
 
 void TraceConfig::SetDefaultMemoryDumpConfig() {
@@ -670,6 +678,8 @@ void TraceConfig::ToDict(base::DictionaryValue& dict) const {
       memory_dump_config->Set(kHeapProfilerOptions,
                               std::move(heap_profiler_options));
     }
+    if (memory_dump_config_.delta_dumps)
+      memory_dump_config->SetBoolean(kDeltaDumpsParam, true);
     dict.Set(kMemoryDumpConfigParam, std::move(memory_dump_config));
   }
 }
@@ -77,6 +77,11 @@ class BASE_EXPORT TraceConfig {
 
     std::vector<Trigger> triggers;
     HeapProfiler heap_profiler_options;
+
+    // If true, each memory dump only contains the allocator dumps and the heap
+    // profiler stack frames and type names which changed since the previous
+    // dump of the session, instead of complete dumps.
+    bool delta_dumps;
   };
 
   TraceConfig();
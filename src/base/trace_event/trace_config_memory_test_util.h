@@ -95,6 +95,25 @@ class TraceConfigMemoryTestUtil {
           "\"record_mode\":\"record-until-full\""
         "}", MemoryDumpManager::kTraceCategory, period_ms);
   }
+
+  static std::string GetTraceConfig_DeltaDumps() {
+    return StringPrintf(
+        "{"
+          "\"enable_argument_filter\":false,"
+          "\"enable_sampling\":false,"
+          "\"enable_systrace\":false,"
+          "\"included_categories\":["
+            "\"%s\""
+          "],"
+          "\"memory_dump_config\":{"
+            "\"allowed_dump_modes\":[\"background\",\"light\",\"detailed\"],"
+            "\"delta_dumps\":true,"
+            "\"triggers\":["
+            "]"
+          "},"
+          "\"record_mode\":\"record-until-full\""
+        "}", MemoryDumpManager::kTraceCategory);
+  }
 };
 
 }  // namespace trace_event
@@ -656,6 +656,12 @@ TEST(TraceConfigTest, TraceConfigFromMemoryConfigString) {
   EXPECT_EQ(1u, tc2.memory_dump_config_.triggers[0].periodic_interval_ms);
   EXPECT_EQ(MemoryDumpLevelOfDetail::BACKGROUND,
             tc2.memory_dump_config_.triggers[0].level_of_detail);
+  EXPECT_FALSE(tc2.memory_dump_config_.delta_dumps);
+
+  std::string tc_str3 = TraceConfigMemoryTestUtil::GetTraceConfig_DeltaDumps();
+  TraceConfig tc3(tc_str3);
+  EXPECT_EQ(tc_str3, tc3.ToString());
+  EXPECT_TRUE(tc3.memory_dump_config_.delta_dumps);
 }
 
 TEST(TraceConfigTest, EmptyMemoryDumpConfigTest) {
@@ -0,0 +1,177 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/trace_event_binary_writer.h"
+
+#include <string.h>
+
+#include "base/logging.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_impl.h"
+#include "base/trace_event/trace_log.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+const char kMagic[] = "TRCB";
+
+// String references below this value aren't ids of interned strings.
+const uint64_t kNullString = 0;
+const uint64_t kInlineString = 1;
+const uint64_t kFirstStringId = 2;
+
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendSignedVarint(int64_t value, std::string* out) {
+  // Zigzag encoding keeps small negative values short.
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^
+                   static_cast<uint64_t>(value >> 63),
+               out);
+}
+
+void AppendBytes(const char* str, size_t length, std::string* out) {
+  AppendVarint(length, out);
+  out->append(str, length);
+}
+
+// Durations are stored plus one so that 0 means "not set".
+void AppendDuration(TimeDelta duration, std::string* out) {
+  const int64_t duration_us = duration.ToInternalValue();
+  AppendVarint(duration_us < 0 ? 0 : static_cast<uint64_t>(duration_us) + 1,
+               out);
+}
+
+}  // namespace
+
+TraceEventBinaryWriter::TraceEventBinaryWriter()
+    : next_string_id_(kFirstStringId), last_timestamp_us_(0) {}
+
+TraceEventBinaryWriter::~TraceEventBinaryWriter() {}
+
+// static
+void TraceEventBinaryWriter::AppendHeader(std::string* out) {
+  out->append(kMagic, arraysize(kMagic) - 1);
+  out->push_back(static_cast<char>(kVersion));
+}
+
+void TraceEventBinaryWriter::AppendEvent(const TraceEvent& event,
+                                         std::string* out) {
+  event_record_.clear();
+  event_record_.push_back(static_cast<char>(kEventRecord));
+  event_record_.push_back(event.phase());
+  AppendVarint(event.flags(), &event_record_);
+
+  const int64_t timestamp_us = event.timestamp().ToInternalValue();
+  AppendSignedVarint(timestamp_us - last_timestamp_us_, &event_record_);
+  last_timestamp_us_ = timestamp_us;
+  AppendSignedVarint(event.thread_id(), &event_record_);
+  AppendSignedVarint(event.thread_timestamp().ToInternalValue(),
+                     &event_record_);
+  if (event.phase() == TRACE_EVENT_PHASE_COMPLETE) {
+    AppendDuration(event.duration(), &event_record_);
+    AppendDuration(event.thread_duration(), &event_record_);
+  }
+
+  const bool copy = !!(event.flags() & TRACE_EVENT_FLAG_COPY);
+  AppendString(TraceLog::GetCategoryGroupName(event.category_group_enabled()),
+               false, out);
+  AppendString(event.name(), copy, out);
+  AppendString(event.scope(), copy, out);
+  AppendVarint(event.id(), &event_record_);
+  AppendVarint(event.bind_id(), &event_record_);
+
+  int num_args = 0;
+  while (num_args < kTraceMaxNumArgs && event.arg_name(num_args))
+    ++num_args;
+  event_record_.push_back(static_cast<char>(num_args));
+  for (int i = 0; i < num_args; ++i) {
+    AppendString(event.arg_name(i), copy, out);
+    const unsigned char type = event.arg_type(i);
+    event_record_.push_back(static_cast<char>(type));
+
+    const TraceEvent::TraceValue value = event.arg_value(i);
+    switch (type) {
+      case TRACE_VALUE_TYPE_BOOL:
+        event_record_.push_back(value.as_bool ? 1 : 0);
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        AppendVarint(value.as_uint, &event_record_);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        AppendSignedVarint(value.as_int, &event_record_);
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE: {
+        uint64_t bits;
+        static_assert(sizeof(bits) == sizeof(value.as_double),
+                      "double must be 64 bits");
+        memcpy(&bits, &value.as_double, sizeof(bits));
+        for (int byte = 0; byte < 8; ++byte)
+          event_record_.push_back(static_cast<char>(bits >> (8 * byte)));
+        break;
+      }
+      case TRACE_VALUE_TYPE_POINTER:
+        AppendVarint(reinterpret_cast<uintptr_t>(value.as_pointer),
+                     &event_record_);
+        break;
+      case TRACE_VALUE_TYPE_STRING:
+        AppendString(value.as_string, false, out);
+        break;
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        AppendString(value.as_string, true, out);
+        break;
+      case TRACE_VALUE_TYPE_CONVERTABLE: {
+        const std::string json = event.arg_convertable_value(i)->ToString();
+        AppendVarint(kInlineString, &event_record_);
+        AppendBytes(json.data(), json.size(), &event_record_);
+        break;
+      }
+      default:
+        NOTREACHED() << "Don't know how to serialize this value";
+        AppendVarint(kNullString, &event_record_);
+        break;
+    }
+  }
+
+  out->append(event_record_);
+}
+
+void TraceEventBinaryWriter::AppendDroppedEvents(uint64_t count,
+                                                 std::string* out) {
+  out->push_back(static_cast<char>(kDroppedEventsRecord));
+  AppendVarint(count, out);
+}
+
+void TraceEventBinaryWriter::AppendString(const char* str,
+                                          bool copy,
+                                          std::string* out) {
+  if (!str) {
+    AppendVarint(kNullString, &event_record_);
+    return;
+  }
+  if (copy) {
+    AppendVarint(kInlineString, &event_record_);
+    AppendBytes(str, strlen(str), &event_record_);
+    return;
+  }
+
+  auto it = interned_strings_.find(str);
+  if (it == interned_strings_.end()) {
+    it = interned_strings_.insert(std::make_pair(str, next_string_id_++)).first;
+    out->push_back(static_cast<char>(kStringRecord));
+    AppendVarint(it->second, out);
+    AppendBytes(str, strlen(str), out);
+  }
+  AppendVarint(it->second, &event_record_);
+}
+
+}  // namespace trace_event
+}  // namespace base
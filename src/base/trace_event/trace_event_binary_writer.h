@@ -0,0 +1,91 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TRACE_EVENT_TRACE_EVENT_BINARY_WRITER_H_
+#define BASE_TRACE_EVENT_TRACE_EVENT_BINARY_WRITER_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/base_export.h"
+#include "base/containers/hash_tables.h"
+#include "base/macros.h"
+
+namespace base {
+namespace trace_event {
+
+class TraceEvent;
+
+// Serializes TraceEvents in a compact binary format, used to stream long
+// tracing sessions out of the process without the cost of JSON. The stream is
+// a header followed by records:
+//
+//   header      := "TRCB" version:u8
+//   record      := kStringRecord id:varint length:varint bytes
+//                | kEventRecord event
+//                | kDroppedEventsRecord count:varint
+//   event       := phase:u8 flags:varint timestamp_delta:svarint
+//                  thread_id:svarint thread_timestamp:svarint
+//                  [duration:varint thread_duration:varint]  // COMPLETE only.
+//                  category:string name:string scope:string id:varint
+//                  bind_id:varint num_args:u8 (name:string type:u8 value)*
+//   string      := 0 (null) | 1 length:varint bytes (inline) | id:varint
+//
+// varint is an unsigned LEB128 integer and svarint a zigzag-encoded signed
+// one. Times are in microseconds; |timestamp_delta| is relative to the
+// previous event record of the stream and durations are stored plus one so
+// that 0 means "not set". Strings which are guaranteed to outlive the process
+// (names of events without TRACE_EVENT_FLAG_COPY, category groups, string
+// arguments which aren't copied) are interned: a kStringRecord defines |id|
+// before the first record that refers to it. Argument values are encoded after
+// their TRACE_VALUE_TYPE_*: u8 for bools, varint for unsigned integers and
+// pointers, svarint for signed integers, 8 little-endian bytes for doubles
+// and a string for strings and convertables (as their JSON).
+//
+// This class is not thread-safe.
+class BASE_EXPORT TraceEventBinaryWriter {
+ public:
+  enum RecordType : uint8_t {
+    kStringRecord = 1,
+    kEventRecord = 2,
+    kDroppedEventsRecord = 3,
+  };
+
+  static const uint8_t kVersion = 1;
+
+  TraceEventBinaryWriter();
+  ~TraceEventBinaryWriter();
+
+  // Appends the header of a stream to |out|. Must be called once, before any
+  // record.
+  static void AppendHeader(std::string* out);
+
+  // Appends |event| to |out|, preceded by the definitions of the strings it
+  // interns for the first time.
+  void AppendEvent(const TraceEvent& event, std::string* out);
+
+  // Appends a record telling that |count| events couldn't be recorded.
+  void AppendDroppedEvents(uint64_t count, std::string* out);
+
+ private:
+  // Appends a string reference to |event_record_|. Interns |str| unless
+  // |copy| is true, in which case it is written inline.
+  void AppendString(const char* str, bool copy, std::string* out);
+
+  hash_map<const char*, uint64_t> interned_strings_;
+  uint64_t next_string_id_;
+  int64_t last_timestamp_us_;
+
+  // Scratch buffer holding the event being serialized, so that the strings it
+  // interns can be defined before it.
+  std::string event_record_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceEventBinaryWriter);
+};
+
+}  // namespace trace_event
+}  // namespace base
+
+#endif  // BASE_TRACE_EVENT_TRACE_EVENT_BINARY_WRITER_H_
@@ -14,6 +14,7 @@
 
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/files/file.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/location.h"
@@ -35,6 +36,10 @@
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+#if defined(OS_POSIX)
+#include <unistd.h>
+#endif
+
 namespace base {
 namespace trace_event {
 
@@ -2869,6 +2874,50 @@ TEST_F(TraceEventTestFixture, TraceBufferRingBufferFullIteration) {
   TraceLog::GetInstance()->SetDisabled();
 }
 
+#if defined(OS_POSIX)
+TEST_F(TraceEventTestFixture, TraceBufferStreaming) {
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  File read_end(fds[0]);
+  TraceLog::GetInstance()->SetStreamingOutput(File(fds[1]));
+  TraceLog::GetInstance()->SetEnabled(
+      TraceConfig(kRecordAllCategoryFilter, RECORD_CONTINUOUSLY),
+      TraceLog::RECORDING_MODE);
+  TraceBuffer* buffer = TraceLog::GetInstance()->trace_buffer();
+  EXPECT_TRUE(buffer->GetLockFreeChunkBuffer());
+  EXPECT_FALSE(buffer->IsFull());
+
+  const size_t kNumEvents = 10 * TraceBufferChunk::kTraceBufferChunkSize;
+  for (size_t i = 0; i < kNumEvents; ++i)
+    TRACE_EVENT_INSTANT0("all", "streamed event", TRACE_EVENT_SCOPE_THREAD);
+  EndTraceAndFlush();
+
+  // The events are written to the stream instead of being flushed.
+  EXPECT_FALSE(FindNamePhase("streamed event", "i"));
+
+  // The stream is closed once the flush has deleted the buffer.
+  std::string stream;
+  char data[4096];
+  int bytes_read;
+  while ((bytes_read = read_end.ReadAtCurrentPos(data, sizeof(data))) > 0)
+    stream.append(data, bytes_read);
+  EXPECT_EQ(0u, stream.find("TRCB"));
+  // The name of the event is interned.
+  const size_t name_pos = stream.find("streamed event");
+  EXPECT_NE(std::string::npos, name_pos);
+  EXPECT_EQ(std::string::npos, stream.find("streamed event", name_pos + 1));
+  EXPECT_GE(stream.size(), kNumEvents);
+
+  // The streaming output is only used by one session.
+  TraceLog::GetInstance()->SetEnabled(
+      TraceConfig(kRecordAllCategoryFilter, RECORD_CONTINUOUSLY),
+      TraceLog::RECORDING_MODE);
+  buffer = TraceLog::GetInstance()->trace_buffer();
+  EXPECT_FALSE(buffer->GetLockFreeChunkBuffer());
+  EndTraceAndFlush();
+}
+#endif  // defined(OS_POSIX)
+
 TEST_F(TraceEventTestFixture, TraceRecordAsMuchAsPossibleMode) {
   TraceLog::GetInstance()->SetEnabled(
     TraceConfig(kRecordAllCategoryFilter, RECORD_AS_MUCH_AS_POSSIBLE),
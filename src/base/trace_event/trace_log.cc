@@ -80,6 +80,10 @@ static_assert(
     "Too many vector buffer chunks");
 const size_t kTraceEventRingBufferChunks = kTraceEventVectorBufferChunks / 4;
 
+// Chunks in flight between the recording threads and the thread streaming them
+// out.
+const size_t kTraceEventStreamingBufferChunks = kTraceEventRingBufferChunks;
+
 // ECHO_TO_CONSOLE needs a small buffer to hold the unfinished COMPLETE events.
 const size_t kEchoToConsoleTraceEventBufferChunks = 256;
 
@@ -225,6 +229,8 @@ class TraceLog::ThreadLocalEventBuffer
 
   int generation() const { return generation_; }
 
+  bool is_streaming() const { return !!lock_free_buffer_; }
+
  private:
   // MessageLoop::DestructionObserver
   void WillDestroyCurrentMessageLoop() override;
@@ -246,13 +252,18 @@ class TraceLog::ThreadLocalEventBuffer
   size_t chunk_index_;
   int generation_;
 
+  // Set if the chunks can be claimed and returned without the TraceLog lock.
+  // Outlives the trace buffer of |generation_|.
+  TraceBuffer* lock_free_buffer_;
+
   DISALLOW_COPY_AND_ASSIGN(ThreadLocalEventBuffer);
 };
 
 TraceLog::ThreadLocalEventBuffer::ThreadLocalEventBuffer(TraceLog* trace_log)
     : trace_log_(trace_log),
       chunk_index_(0),
-      generation_(trace_log->generation()) {
+      generation_(trace_log->generation()),
+      lock_free_buffer_(NULL) {
   // ThreadLocalEventBuffer is created only if the thread has a message loop, so
   // the following message_loop won't be NULL.
   MessageLoop* message_loop = MessageLoop::current();
@@ -264,6 +275,7 @@ TraceLog::ThreadLocalEventBuffer::ThreadLocalEventBuffer(TraceLog* trace_log)
 
   AutoLock lock(trace_log->lock_);
   trace_log->thread_message_loops_.insert(message_loop);
+  lock_free_buffer_ = trace_log->logged_events_->GetLockFreeChunkBuffer();
 }
 
 TraceLog::ThreadLocalEventBuffer::~ThreadLocalEventBuffer() {
@@ -283,15 +295,22 @@ TraceEvent* TraceLog::ThreadLocalEventBuffer::AddTraceEvent(
     TraceEventHandle* handle) {
   CheckThisIsCurrentBuffer();
 
-  if (chunk_ && chunk_->IsFull()) {
-    AutoLock lock(trace_log_->lock_);
-    FlushWhileLocked();
-    chunk_.reset();
-  }
-  if (!chunk_) {
-    AutoLock lock(trace_log_->lock_);
-    chunk_ = trace_log_->logged_events_->GetChunk(&chunk_index_);
-    trace_log_->CheckIfBufferIsFullWhileLocked();
+  if (lock_free_buffer_) {
+    if (chunk_ && chunk_->IsFull())
+      lock_free_buffer_->ReturnChunk(chunk_index_, std::move(chunk_));
+    if (!chunk_)
+      chunk_ = lock_free_buffer_->GetChunk(&chunk_index_);
+  } else {
+    if (chunk_ && chunk_->IsFull()) {
+      AutoLock lock(trace_log_->lock_);
+      FlushWhileLocked();
+      chunk_.reset();
+    }
+    if (!chunk_) {
+      AutoLock lock(trace_log_->lock_);
+      chunk_ = trace_log_->logged_events_->GetChunk(&chunk_index_);
+      trace_log_->CheckIfBufferIsFullWhileLocked();
+    }
   }
   if (!chunk_)
     return NULL;
@@ -325,7 +344,9 @@ void TraceLog::ThreadLocalEventBuffer::FlushWhileLocked() {
     return;
 
   trace_log_->lock_.AssertAcquired();
-  if (trace_log_->CheckGeneration(generation_)) {
+  if (lock_free_buffer_) {
+    lock_free_buffer_->ReturnChunk(chunk_index_, std::move(chunk_));
+  } else if (trace_log_->CheckGeneration(generation_)) {
     // Return the chunk to the buffer only if the generation matches.
     trace_log_->logged_events_->ReturnChunk(chunk_index_, std::move(chunk_));
   }
@@ -620,7 +641,9 @@ void TraceLog::SetEnabled(const TraceConfig& trace_config, Mode mode) {
 
     mode_ = mode;
 
-    if (new_options != old_options) {
+    // A pending streaming output needs a new buffer even if the options are
+    // the same.
+    if (new_options != old_options || streaming_output_.IsValid()) {
       subtle::NoBarrier_Store(&trace_options_, new_options);
       UseNextTraceBuffer();
     }
@@ -700,6 +723,11 @@ TraceConfig TraceLog::GetCurrentTraceConfig() const {
   return trace_config_;
 }
 
+void TraceLog::SetStreamingOutput(File output) {
+  AutoLock lock(lock_);
+  streaming_output_ = std::move(output);
+}
+
 void TraceLog::SetDisabled() {
   AutoLock lock(lock_);
   SetDisabledWhileLocked();
@@ -1475,6 +1503,9 @@ void TraceLog::UpdateTraceEventDuration(
 #if defined(OS_ANDROID)
       trace_event->SendToATrace();
 #endif
+    } else if (handle.chunk_seq) {
+      trace_event = AddEndEventForStreamedCompleteEvent(
+          category_group_enabled, name, now, thread_now, &lock);
     }
 
     if (trace_options() & kInternalEchoToConsole) {
@@ -1639,6 +1670,39 @@ TraceEvent* TraceLog::GetEventByHandleInternal(TraceEventHandle handle,
   return logged_events_->GetEventByHandle(handle);
 }
 
+TraceEvent* TraceLog::AddEndEventForStreamedCompleteEvent(
+    const unsigned char* category_group_enabled,
+    const char* name,
+    const TimeTicks& now,
+    const ThreadTicks& thread_now,
+    OptionalAutoLock* lock) {
+  TraceEvent* trace_event = NULL;
+  ThreadLocalEventBuffer* thread_local_event_buffer =
+      thread_local_event_buffer_.Get();
+  if (thread_local_event_buffer) {
+    // Only the lock-free path of AddTraceEvent() can be taken here, since
+    // |lock| may be held.
+    if (!thread_local_event_buffer->is_streaming())
+      return NULL;
+    trace_event = thread_local_event_buffer->AddTraceEvent(NULL);
+  } else {
+    lock->EnsureAcquired();
+    if (!logged_events_->GetLockFreeChunkBuffer())
+      return NULL;
+    trace_event = AddEventToThreadSharedChunkWhileLocked(NULL, false);
+  }
+  if (!trace_event)
+    return NULL;
+
+  trace_event->Initialize(
+      static_cast<int>(PlatformThread::CurrentId()), now, thread_now,
+      TRACE_EVENT_PHASE_END, category_group_enabled, name,
+      trace_event_internal::kGlobalScope, trace_event_internal::kNoId,
+      trace_event_internal::kNoId, 0, NULL, NULL, NULL, NULL,
+      TRACE_EVENT_FLAG_NONE);
+  return trace_event;
+}
+
 void TraceLog::SetProcessID(int process_id) {
   process_id_ = process_id;
   // Create a FNV hash from the process ID for XORing.
@@ -1702,6 +1766,12 @@ void TraceLog::SetCurrentThreadBlocksMessageLoop() {
 TraceBuffer* TraceLog::CreateTraceBuffer() {
   HEAP_PROFILER_SCOPED_IGNORE;
   InternalTraceOptions options = trace_options();
+  if ((options & kInternalRecordContinuously) &&
+      !(options & kInternalEnableArgumentFilter) &&
+      streaming_output_.IsValid()) {
+    return TraceBuffer::CreateTraceBufferStreaming(
+        kTraceEventStreamingBufferChunks, std::move(streaming_output_));
+  }
   if (options & kInternalRecordContinuously)
     return TraceBuffer::CreateTraceBufferRingBuffer(
         kTraceEventRingBufferChunks);
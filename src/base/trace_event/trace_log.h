@@ -14,6 +14,7 @@
 
 #include "base/atomicops.h"
 #include "base/containers/hash_tables.h"
+#include "base/files/file.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/scoped_vector.h"
@@ -85,6 +86,15 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   // Disables normal tracing for all categories.
   void SetDisabled();
 
+  // Makes the next tracing session in RECORD_CONTINUOUSLY mode stream its
+  // events to |output| in the format of TraceEventBinaryWriter instead of
+  // keeping them for Flush(). Chunks of events are written from a background
+  // thread as threads fill them, so that long sessions don't need a large
+  // buffer. The Flush() which ends the session closes |output| and outputs no
+  // events. Ignored by sessions which filter arguments, since filtering is only
+  // implemented for JSON.
+  void SetStreamingOutput(File output);
+
   bool IsEnabled() { return mode_ != DISABLED; }
 
   // The number of times we have begun recording traces. If tracing is off,
@@ -356,6 +366,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
                            TraceBufferRingBufferHalfIteration);
   FRIEND_TEST_ALL_PREFIXES(TraceEventTestFixture,
                            TraceBufferRingBufferFullIteration);
+  FRIEND_TEST_ALL_PREFIXES(TraceEventTestFixture, TraceBufferStreaming);
   FRIEND_TEST_ALL_PREFIXES(TraceEventTestFixture, TraceBufferVectorReportFull);
   FRIEND_TEST_ALL_PREFIXES(TraceEventTestFixture,
                            ConvertTraceConfigToInternalOptions);
@@ -414,6 +425,16 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   TraceEvent* GetEventByHandleInternal(TraceEventHandle handle,
                                        OptionalAutoLock* lock);
 
+  // Records the end of a COMPLETE event of the current thread whose chunk has
+  // already been streamed out, as an END event. Returns NULL if events aren't
+  // streamed.
+  TraceEvent* AddEndEventForStreamedCompleteEvent(
+      const unsigned char* category_group_enabled,
+      const char* name,
+      const TimeTicks& now,
+      const ThreadTicks& thread_now,
+      OptionalAutoLock* lock);
+
   void FlushInternal(const OutputCallback& cb,
                      bool use_worker_thread,
                      bool discard_events);
@@ -522,6 +543,9 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   subtle::AtomicWord generation_;
   bool use_worker_thread_;
 
+  // Passed to the next trace buffer which streams events.
+  File streaming_output_;
+
   DISALLOW_COPY_AND_ASSIGN(TraceLog);
 };
 
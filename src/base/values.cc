@@ -21,6 +21,12 @@ namespace base {
 
 namespace {
 
+// Orders the entries of a DictionaryValue against a key.
+bool EntryKeyIsLess(const DictionaryValue::Storage::value_type& entry,
+                    const std::string& key) {
+  return entry.first < key;
+}
+
 std::unique_ptr<Value> CopyWithoutEmptyChildren(const Value& node);
 
 // Make a deep copy of |node|, but don't include empty lists or dictionaries
@@ -366,7 +372,7 @@ bool DictionaryValue::GetAsDictionary(const DictionaryValue** out_value) const {
 
 bool DictionaryValue::HasKey(const std::string& key) const {
   DCHECK(IsStringUTF8(key));
-  auto current_entry = dictionary_.find(key);
+  auto current_entry = Find(key);
   DCHECK((current_entry == dictionary_.end()) || current_entry->second);
   return current_entry != dictionary_.end();
 }
@@ -429,7 +435,18 @@ void DictionaryValue::SetString(const std::string& path,
 
 void DictionaryValue::SetWithoutPathExpansion(const std::string& key,
                                               std::unique_ptr<Value> in_value) {
-  dictionary_[key] = std::move(in_value);
+  // Keys usually arrive in order, so try appending before searching.
+  if (dictionary_.empty() || dictionary_.back().first < key) {
+    dictionary_.emplace_back(key, std::move(in_value));
+    return;
+  }
+
+  auto entry_iterator = std::lower_bound(
+      dictionary_.begin(), dictionary_.end(), key, &EntryKeyIsLess);
+  if (entry_iterator != dictionary_.end() && entry_iterator->first == key)
+    entry_iterator->second = std::move(in_value);
+  else
+    dictionary_.emplace(entry_iterator, key, std::move(in_value));
 }
 
 void DictionaryValue::SetWithoutPathExpansion(const std::string& key,
@@ -613,7 +630,7 @@ bool DictionaryValue::GetList(const std::string& path, ListValue** out_value) {
 bool DictionaryValue::GetWithoutPathExpansion(const std::string& key,
                                               const Value** out_value) const {
   DCHECK(IsStringUTF8(key));
-  auto entry_iterator = dictionary_.find(key);
+  auto entry_iterator = Find(key);
   if (entry_iterator == dictionary_.end())
     return false;
 
@@ -742,7 +759,7 @@ bool DictionaryValue::RemoveWithoutPathExpansion(
     const std::string& key,
     std::unique_ptr<Value>* out_value) {
   DCHECK(IsStringUTF8(key));
-  auto entry_iterator = dictionary_.find(key);
+  auto entry_iterator = Find(key);
   if (entry_iterator == dictionary_.end())
     return false;
 
@@ -804,7 +821,7 @@ void DictionaryValue::Swap(DictionaryValue* other) {
 
 DictionaryValue::Iterator::Iterator(const DictionaryValue& target)
     : target_(target),
-      it_(target.dictionary_.begin()) {}
+      index_(0) {}
 
 DictionaryValue::Iterator::Iterator(const Iterator& other) = default;
 
@@ -812,6 +829,7 @@ DictionaryValue::Iterator::~Iterator() {}
 
 DictionaryValue* DictionaryValue::DeepCopy() const {
   DictionaryValue* result = new DictionaryValue;
+  result->dictionary_.reserve(dictionary_.size());
 
   for (const auto& current_entry : dictionary_) {
     result->SetWithoutPathExpansion(current_entry.first,
@@ -847,6 +865,24 @@ bool DictionaryValue::Equals(const Value* other) const {
   return true;
 }
 
+DictionaryValue::Storage::iterator DictionaryValue::Find(
+    const std::string& key) {
+  auto entry_iterator = std::lower_bound(
+      dictionary_.begin(), dictionary_.end(), key, &EntryKeyIsLess);
+  if (entry_iterator != dictionary_.end() && entry_iterator->first != key)
+    return dictionary_.end();
+  return entry_iterator;
+}
+
+DictionaryValue::Storage::const_iterator DictionaryValue::Find(
+    const std::string& key) const {
+  auto entry_iterator = std::lower_bound(
+      dictionary_.begin(), dictionary_.end(), key, &EntryKeyIsLess);
+  if (entry_iterator != dictionary_.end() && entry_iterator->first != key)
+    return dictionary_.end();
+  return entry_iterator;
+}
+
 ///////////////////// ListValue ////////////////////
 
 // static
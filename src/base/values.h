@@ -206,9 +206,15 @@ class BASE_EXPORT BinaryValue: public Value {
 // DictionaryValue provides a key-value dictionary with (optional) "path"
 // parsing for recursive access; see the comment at the top of the file. Keys
 // are |std::string|s and should be UTF-8 encoded.
+//
+// Entries are kept in a vector sorted by key rather than in a tree, which
+// saves a node allocation per entry and makes lookups cache friendly. Adding
+// or removing a key in the middle of a large dictionary is linear in its
+// size, but keys that arrive in order, as when parsing JSON written by
+// JSONWriter or when copying, are appended in constant time.
 class BASE_EXPORT DictionaryValue : public Value {
  public:
-  using Storage = std::map<std::string, std::unique_ptr<Value>>;
+  using Storage = std::vector<std::pair<std::string, std::unique_ptr<Value>>>;
   // Returns |value| if it is a dictionary, nullptr otherwise.
   static std::unique_ptr<DictionaryValue> From(std::unique_ptr<Value> value);
 
@@ -363,15 +369,17 @@ class BASE_EXPORT DictionaryValue : public Value {
     Iterator(const Iterator& other);
     ~Iterator();
 
-    bool IsAtEnd() const { return it_ == target_.dictionary_.end(); }
-    void Advance() { ++it_; }
+    bool IsAtEnd() const { return index_ >= target_.dictionary_.size(); }
+    void Advance() { ++index_; }
 
-    const std::string& key() const { return it_->first; }
-    const Value& value() const { return *it_->second; }
+    const std::string& key() const { return target_.dictionary_[index_].first; }
+    const Value& value() const { return *target_.dictionary_[index_].second; }
 
    private:
     const DictionaryValue& target_;
-    Storage::const_iterator it_;
+    // An index rather than a Storage iterator, so that adding to the
+    // dictionary while iterating over it cannot leave the iterator dangling.
+    size_t index_;
   };
 
   // Overridden from Value:
@@ -381,6 +389,10 @@ class BASE_EXPORT DictionaryValue : public Value {
   bool Equals(const Value* other) const override;
 
  private:
+  // Returns the entry for |key|, or the end of |dictionary_| if there is none.
+  Storage::iterator Find(const std::string& key);
+  Storage::const_iterator Find(const std::string& key) const;
+
   Storage dictionary_;
 
   DISALLOW_COPY_AND_ASSIGN(DictionaryValue);
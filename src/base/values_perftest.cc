@@ -0,0 +1,118 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/values.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <malloc.h>
+#endif
+
+namespace base {
+
+namespace {
+
+const int kNumSites = 5000;
+const int kNumExtensions = 200;
+const int kNumLookups = 1000000;
+
+// Builds a dictionary shaped like a large Preferences file: per-site content
+// settings and per-extension state, the parts that grow with use.
+std::unique_ptr<DictionaryValue> CreatePreferences() {
+  std::unique_ptr<DictionaryValue> prefs(new DictionaryValue);
+  std::unique_ptr<DictionaryValue> exceptions(new DictionaryValue);
+  for (int i = 0; i < kNumSites; ++i) {
+    std::unique_ptr<DictionaryValue> exception(new DictionaryValue);
+    exception->SetString("last_modified", "13112345678901234");
+    exception->SetInteger("setting", i % 3);
+    exceptions->SetWithoutPathExpansion(
+        StringPrintf("https://site%d.example.com:443,*", i),
+        std::move(exception));
+  }
+  prefs->Set("profile.content_settings.exceptions.media_engagement",
+             std::move(exceptions));
+  for (int i = 0; i < kNumExtensions; ++i) {
+    std::unique_ptr<DictionaryValue> extension(new DictionaryValue);
+    extension->SetBoolean("active_bit", false);
+    extension->SetInteger("location", 1);
+    extension->SetString("path", StringPrintf("extension%d/1.0_0", i));
+    extension->SetDouble("install_time", 13112345678.0 + i);
+    prefs->Set(StringPrintf("extensions.settings.ext%032d", i),
+               std::move(extension));
+  }
+  return prefs;
+}
+
+// Returns the number of bytes currently allocated on the heap, or 0 where
+// that is not available.
+size_t GetAllocatedBytes() {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  return mallinfo().uordblks;
+#else
+  return 0;
+#endif
+}
+
+}  // namespace
+
+TEST(ValuesPerfTest, Preferences) {
+  std::string json;
+  ASSERT_TRUE(JSONWriter::Write(*CreatePreferences(), &json));
+
+  size_t bytes_before = GetAllocatedBytes();
+  TimeTicks start = TimeTicks::Now();
+  std::unique_ptr<Value> prefs =
+      JSONReader::Read(json, JSON_DETACHABLE_CHILDREN);
+  TimeDelta parse_time = TimeTicks::Now() - start;
+  size_t parsed_bytes = GetAllocatedBytes() - bytes_before;
+  ASSERT_TRUE(prefs);
+
+  const DictionaryValue* exceptions = NULL;
+  ASSERT_TRUE(static_cast<DictionaryValue*>(prefs.get())->GetDictionary(
+      "profile.content_settings.exceptions.media_engagement", &exceptions));
+  std::vector<std::string> keys;
+  for (DictionaryValue::Iterator it(*exceptions); !it.IsAtEnd(); it.Advance())
+    keys.push_back(it.key());
+
+  start = TimeTicks::Now();
+  for (int i = 0; i < kNumLookups; ++i) {
+    const Value* value = NULL;
+    ASSERT_TRUE(
+        exceptions->GetWithoutPathExpansion(keys[i % keys.size()], &value));
+  }
+  TimeDelta lookup_time = TimeTicks::Now() - start;
+
+  start = TimeTicks::Now();
+  std::unique_ptr<Value> copy = prefs->CreateDeepCopy();
+  TimeDelta copy_time = TimeTicks::Now() - start;
+
+  perf_test::PrintResult("json_size", "", "preferences", json.size(), "bytes",
+                         true);
+  if (parsed_bytes) {
+    perf_test::PrintResult("heap_size", "", "preferences", parsed_bytes,
+                           "bytes", true);
+  }
+  perf_test::PrintResult("parse_time", "", "preferences",
+                         parse_time.InMillisecondsF(), "ms", true);
+  perf_test::PrintResult("lookup_time", "", "preferences",
+                         lookup_time.InMillisecondsF() * 1e6 / kNumLookups,
+                         "ns", true);
+  perf_test::PrintResult("deep_copy_time", "", "preferences",
+                         copy_time.InMillisecondsF(), "ms", true);
+}
+
+}  // namespace base
@@ -12,6 +12,7 @@
 
 #include "base/memory/ptr_util.h"
 #include "base/strings/string16.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -868,6 +869,36 @@ TEST(ValuesTest, DictionaryIterator) {
   EXPECT_TRUE(seen2);
 }
 
+// Keys are kept sorted whatever order they are added in.
+TEST(ValuesTest, DictionaryKeyOrder) {
+  DictionaryValue dict;
+  for (int i = 99; i >= 0; i -= 2)
+    dict.SetIntegerWithoutPathExpansion(StringPrintf("key%02d", i), i);
+  for (int i = 0; i < 100; i += 2)
+    dict.SetIntegerWithoutPathExpansion(StringPrintf("key%02d", i), i);
+  EXPECT_EQ(100u, dict.size());
+
+  // Replacing a value keeps its place.
+  dict.SetIntegerWithoutPathExpansion("key50", -50);
+  EXPECT_EQ(100u, dict.size());
+  EXPECT_TRUE(dict.RemoveWithoutPathExpansion("key07", NULL));
+  EXPECT_FALSE(dict.RemoveWithoutPathExpansion("key07", NULL));
+  EXPECT_FALSE(dict.HasKey("key7"));
+  EXPECT_FALSE(dict.HasKey("key100"));
+
+  int expected = 0;
+  for (DictionaryValue::Iterator it(dict); !it.IsAtEnd(); it.Advance()) {
+    if (expected == 7)
+      ++expected;
+    EXPECT_EQ(StringPrintf("key%02d", expected), it.key());
+    int value = 0;
+    EXPECT_TRUE(it.value().GetAsInteger(&value));
+    EXPECT_EQ(expected == 50 ? -50 : expected, value);
+    ++expected;
+  }
+  EXPECT_EQ(100, expected);
+}
+
 // DictionaryValue/ListValue's Get*() methods should accept NULL as an out-value
 // and still return true/false based on success.
 TEST(ValuesTest, GetWithNullOutValue) {
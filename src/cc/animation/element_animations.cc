@@ -980,7 +980,13 @@ void ElementAnimations::TickAnimations(base::TimeTicks monotonic_time) {
         }
 
         case TargetProperty::BACKGROUND_COLOR: {
-          // Not yet implemented.
+          const ColorAnimationCurve* color_animation_curve =
+              animations_[i]->curve()->ToColorAnimationCurve();
+          const SkColor background_color =
+              color_animation_curve->GetValue(trimmed);
+          NotifyClientBackgroundColorAnimated(
+              background_color, animations_[i]->affects_active_elements(),
+              animations_[i]->affects_pending_elements());
           break;
         }
 
@@ -1062,6 +1068,16 @@ void ElementAnimations::NotifyClientFilterAnimated(
     OnFilterAnimated(ElementListType::PENDING, filters);
 }
 
+void ElementAnimations::NotifyClientBackgroundColorAnimated(
+    SkColor background_color,
+    bool notify_active_elements,
+    bool notify_pending_elements) {
+  if (notify_active_elements && has_element_in_active_list())
+    OnBackgroundColorAnimated(ElementListType::ACTIVE, background_color);
+  if (notify_pending_elements && has_element_in_pending_list())
+    OnBackgroundColorAnimated(ElementListType::PENDING, background_color);
+}
+
 void ElementAnimations::NotifyClientScrollOffsetAnimated(
     const gfx::ScrollOffset& scroll_offset,
     bool notify_active_elements,
@@ -1382,6 +1398,15 @@ void ElementAnimations::OnFilterAnimated(ElementListType list_type,
       element_id(), list_type, filters);
 }
 
+void ElementAnimations::OnBackgroundColorAnimated(ElementListType list_type,
+                                                  SkColor background_color) {
+  DCHECK(element_id());
+  DCHECK(animation_host());
+  DCHECK(animation_host()->mutator_host_client());
+  animation_host()->mutator_host_client()->SetElementBackgroundColorMutated(
+      element_id(), list_type, background_color);
+}
+
 void ElementAnimations::OnOpacityAnimated(ElementListType list_type,
                                           float opacity) {
   DCHECK(element_id());
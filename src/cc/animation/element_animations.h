@@ -219,6 +219,9 @@ class CC_EXPORT ElementAnimations : public base::RefCounted<ElementAnimations> {
   void NotifyClientFilterAnimated(const FilterOperations& filter,
                                   bool notify_active_elements,
                                   bool notify_pending_elements);
+  void NotifyClientBackgroundColorAnimated(SkColor background_color,
+                                           bool notify_active_elements,
+                                           bool notify_pending_elements);
 #if defined(OS_WEBOS)
   void NotifyClientScrollOffsetAnimated(const gfx::ScrollOffset& scroll_offset,
                                         bool notify_active_elements,
@@ -246,6 +249,8 @@ class CC_EXPORT ElementAnimations : public base::RefCounted<ElementAnimations> {
                            const gfx::Transform& transform);
   void OnScrollOffsetAnimated(ElementListType list_type,
                               const gfx::ScrollOffset& scroll_offset);
+  void OnBackgroundColorAnimated(ElementListType list_type,
+                                 SkColor background_color);
   void OnAnimationWaitingForDeletion();
   void IsAnimatingChanged(ElementListType list_type,
                           TargetProperty::Type property,
@@ -751,6 +751,45 @@ TEST_F(ElementAnimationsTest, FilterTransition) {
   EXPECT_FALSE(event);
 }
 
+TEST_F(ElementAnimationsTest, BackgroundColorTransition) {
+  CreateTestLayer(true, false);
+  AttachTimelinePlayerLayer();
+
+  scoped_refptr<ElementAnimations> animations = element_animations();
+
+  auto events = host_impl_->CreateEvents();
+
+  std::unique_ptr<KeyframedColorAnimationCurve> curve(
+      KeyframedColorAnimationCurve::Create());
+  curve->AddKeyframe(
+      ColorKeyframe::Create(base::TimeDelta(), SK_ColorRED, nullptr));
+  curve->AddKeyframe(ColorKeyframe::Create(base::TimeDelta::FromSecondsD(1.0),
+                                           SK_ColorBLUE, nullptr));
+
+  std::unique_ptr<Animation> animation(Animation::Create(
+      std::move(curve), 1, 0, TargetProperty::BACKGROUND_COLOR));
+  animations->AddAnimation(std::move(animation));
+
+  animations->Animate(kInitialTickTime);
+  animations->UpdateState(true, events.get());
+  EXPECT_TRUE(animations->HasActiveAnimation());
+  EXPECT_EQ(SK_ColorRED,
+            client_.GetBackgroundColor(element_id_, ElementListType::ACTIVE));
+
+  animations->Animate(kInitialTickTime + TimeDelta::FromMilliseconds(500));
+  animations->UpdateState(true, events.get());
+  SkColor halfway =
+      client_.GetBackgroundColor(element_id_, ElementListType::ACTIVE);
+  EXPECT_NE(SK_ColorRED, halfway);
+  EXPECT_NE(SK_ColorBLUE, halfway);
+
+  animations->Animate(kInitialTickTime + TimeDelta::FromMilliseconds(1000));
+  animations->UpdateState(true, events.get());
+  EXPECT_EQ(SK_ColorBLUE,
+            client_.GetBackgroundColor(element_id_, ElementListType::ACTIVE));
+  EXPECT_FALSE(animations->HasActiveAnimation());
+}
+
 TEST_F(ElementAnimationsTest, ScrollOffsetTransition) {
   CreateTestLayer(true, false);
   AttachTimelinePlayerLayer();
@@ -44,6 +44,16 @@ const char kSlowDownRasterScaleFactor[] = "slow-down-raster-scale-factor";
 // Compress tile textures for GPUs supporting it.
 const char kEnableTileCompression[] = "enable-tile-compression";
 
+// Compress the textures of opaque tiles that stayed resident for a while, for
+// GPUs supporting it.
+const char kEnableStableTileCompression[] = "enable-stable-tile-compression";
+
+// Waits for the BeginImplFrame deadline to draw a frame that is ready when the
+// estimated draw and activation durations allow it, so that later input is
+// drawn in the same frame.
+const char kEnablePredictiveBeginFrameDeadline[] =
+    "enable-predictive-begin-frame-deadline";
+
 // Use a BeginFrame signal from browser to renderer to schedule rendering.
 const char kEnableBeginFrameScheduling[] = "enable-begin-frame-scheduling";
 
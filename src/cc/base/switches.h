@@ -26,6 +26,8 @@ CC_EXPORT extern const char kTopControlsShowThreshold[];
 CC_EXPORT extern const char kSlowDownRasterScaleFactor[];
 CC_EXPORT extern const char kStrictLayerPropertyChangeChecking[];
 CC_EXPORT extern const char kEnableTileCompression[];
+CC_EXPORT extern const char kEnableStableTileCompression[];
+CC_EXPORT extern const char kEnablePredictiveBeginFrameDeadline[];
 
 // Switches for both the renderer and ui compositors.
 CC_EXPORT extern const char kEnableBeginFrameScheduling[];
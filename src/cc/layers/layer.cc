@@ -1686,6 +1686,10 @@ void Layer::OnScrollOffsetAnimated(const gfx::ScrollOffset& scroll_offset) {
   // compositor-driven scrolling.
 }
 
+void Layer::OnBackgroundColorAnimated(SkColor background_color) {
+  background_color_ = background_color;
+}
+
 void Layer::OnTransformIsCurrentlyAnimatingChanged(
     bool is_currently_animating) {
   DCHECK(layer_tree_host_);
@@ -629,6 +629,13 @@ void LayerImpl::OnScrollOffsetAnimated(const gfx::ScrollOffset& scroll_offset) {
   layer_tree_impl_->DidAnimateScrollOffset();
 }
 
+void LayerImpl::OnBackgroundColorAnimated(SkColor background_color) {
+  if (background_color_ == background_color)
+    return;
+  SetBackgroundColor(background_color);
+  SetNeedsPushProperties();
+}
+
 void LayerImpl::OnTransformIsCurrentlyAnimatingChanged(
     bool is_currently_animating) {
   DCHECK(layer_tree_impl_);
@@ -96,6 +96,7 @@ class CC_EXPORT LayerImpl {
   void OnOpacityAnimated(float opacity);
   void OnTransformAnimated(const gfx::Transform& transform);
   void OnScrollOffsetAnimated(const gfx::ScrollOffset& scroll_offset);
+  void OnBackgroundColorAnimated(SkColor background_color);
   void OnTransformIsCurrentlyAnimatingChanged(bool is_currently_animating);
   void OnTransformIsPotentiallyAnimatingChanged(bool has_potential_animation);
   void OnOpacityIsCurrentlyAnimatingChanged(bool is_currently_animating);
@@ -424,7 +424,9 @@ void DirectRenderer::DrawRenderPassAndExecuteCopyRequests(
     return;
   }
 
+  WillDrawRenderPass(frame);
   DrawRenderPass(frame, render_pass);
+  DidDrawRenderPass(frame);
 
   bool first_request = true;
   for (auto& copy_request : render_pass->copy_requests) {
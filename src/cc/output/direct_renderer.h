@@ -146,6 +146,10 @@ class CC_EXPORT DirectRenderer : public Renderer {
                           const gfx::QuadF* clip_region) = 0;
   virtual void BeginDrawingFrame(DrawingFrame* frame) = 0;
   virtual void FinishDrawingFrame(DrawingFrame* frame) = 0;
+  // Called around the drawing of each render pass, but not around the copy
+  // requests of the pass.
+  virtual void WillDrawRenderPass(DrawingFrame* frame) {}
+  virtual void DidDrawRenderPass(DrawingFrame* frame) {}
   virtual void FinishDrawingQuadList();
   virtual bool FlippedFramebuffer(const DrawingFrame* frame) const = 0;
   virtual void EnsureScissorTestEnabled() = 0;
@@ -31,6 +31,7 @@
 #include "cc/output/dynamic_geometry_binding.h"
 #include "cc/output/gl_frame_data.h"
 #include "cc/output/gl_renderer.h"
+#include "cc/output/gpu_timer.h"
 #include "cc/output/layer_quad.h"
 #include "cc/output/output_surface.h"
 #include "cc/output/render_surface_filters.h"
@@ -369,6 +370,8 @@ GLRenderer::GLRenderer(RendererClient* client,
     capabilities_.max_msaa_samples = context_caps.max_samples;
 
   use_sync_query_ = context_caps.sync_query;
+  if (context_caps.timer_queries)
+    gpu_timer_.reset(new GpuTimer(gl_));
   use_blend_equation_advanced_ = context_caps.blend_equation_advanced;
   use_blend_equation_advanced_coherent_ =
       context_caps.blend_equation_advanced_coherent;
@@ -2616,7 +2619,20 @@ void GLRenderer::DrawIOSurfaceQuad(const DrawingFrame* frame,
   gl_->BindTexture(GL_TEXTURE_RECTANGLE_ARB, 0);
 }
 
+void GLRenderer::WillDrawRenderPass(DrawingFrame* frame) {
+  if (gpu_timer_)
+    gpu_timer_->StartInterval();
+}
+
+void GLRenderer::DidDrawRenderPass(DrawingFrame* frame) {
+  if (gpu_timer_)
+    gpu_timer_->StopInterval();
+}
+
 void GLRenderer::FinishDrawingFrame(DrawingFrame* frame) {
+  if (gpu_timer_)
+    gpu_timer_->EndSample();
+
   if (use_sync_query_) {
     DCHECK(current_sync_query_);
     current_sync_query_->End();
@@ -2857,6 +2873,12 @@ void GLRenderer::DidReceiveTextureInUseResponses(
   }
 }
 
+void GLRenderer::TakeCompletedGpuDrawDurations(
+    std::vector<base::TimeDelta>* durations) {
+  if (gpu_timer_)
+    gpu_timer_->TakeCompletedSamples(durations);
+}
+
 void GLRenderer::EnforceMemoryPolicy() {
   if (!visible()) {
     TRACE_EVENT0("cc", "GLRenderer::EnforceMemoryPolicy dropping resources");
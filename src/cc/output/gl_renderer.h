@@ -34,6 +34,7 @@ class GLES2Interface;
 namespace cc {
 
 class GLRendererShaderTest;
+class GpuTimer;
 class OutputSurface;
 class PictureDrawQuad;
 class ScopedResource;
@@ -70,6 +71,9 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   void DidReceiveTextureInUseResponses(
       const gpu::TextureInUseResponses& responses) override;
 
+  void TakeCompletedGpuDrawDurations(
+      std::vector<base::TimeDelta>* durations) override;
+
   virtual bool IsContextLost();
 
  protected:
@@ -114,6 +118,8 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
                   const gfx::QuadF* draw_region) override;
   void BeginDrawingFrame(DrawingFrame* frame) override;
   void FinishDrawingFrame(DrawingFrame* frame) override;
+  void WillDrawRenderPass(DrawingFrame* frame) override;
+  void DidDrawRenderPass(DrawingFrame* frame) override;
   bool FlippedFramebuffer(const DrawingFrame* frame) const override;
   bool FlippedRootFramebuffer() const;
   void EnsureScissorTestEnabled() override;
@@ -525,6 +531,10 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   std::deque<std::unique_ptr<SyncQuery>> available_sync_queries_;
   std::unique_ptr<SyncQuery> current_sync_query_;
   bool use_sync_query_;
+
+  // Times the render passes of each frame on the GPU. Null when the context
+  // has no timer queries.
+  std::unique_ptr<GpuTimer> gpu_timer_;
   bool use_blend_equation_advanced_;
   bool use_blend_equation_advanced_coherent_;
 
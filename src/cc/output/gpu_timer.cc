@@ -0,0 +1,110 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/output/gpu_timer.h"
+
+#include <stdint.h>
+
+#include "base/logging.h"
+#include "gpu/GLES2/gl2extchromium.h"
+#include "gpu/command_buffer/client/gles2_interface.h"
+
+namespace cc {
+
+namespace {
+
+// A few frames' worth. Beyond that the GPU is so far behind that the timings
+// would arrive too late to be of use.
+const size_t kMaxPendingSamples = 8;
+
+}  // namespace
+
+GpuTimer::GpuTimer(gpu::gles2::GLES2Interface* gl)
+    : gl_(gl), current_query_(0u) {
+  DCHECK(gl_);
+}
+
+GpuTimer::~GpuTimer() {
+  if (current_query_) {
+    gl_->EndQueryEXT(GL_TIME_ELAPSED_EXT);
+    available_queries_.push_back(current_query_);
+  }
+  for (const auto& queries : pending_samples_)
+    available_queries_.insert(available_queries_.end(), queries.begin(),
+                              queries.end());
+  available_queries_.insert(available_queries_.end(),
+                            current_sample_queries_.begin(),
+                            current_sample_queries_.end());
+  if (!available_queries_.empty()) {
+    gl_->DeleteQueriesEXT(static_cast<int>(available_queries_.size()),
+                          available_queries_.data());
+  }
+}
+
+void GpuTimer::StartInterval() {
+  DCHECK(!current_query_);
+  if (pending_samples_.size() >= kMaxPendingSamples)
+    return;
+
+  if (available_queries_.empty()) {
+    gl_->GenQueriesEXT(1, &current_query_);
+  } else {
+    current_query_ = available_queries_.back();
+    available_queries_.pop_back();
+  }
+  gl_->BeginQueryEXT(GL_TIME_ELAPSED_EXT, current_query_);
+}
+
+void GpuTimer::StopInterval() {
+  if (!current_query_)
+    return;
+
+  gl_->EndQueryEXT(GL_TIME_ELAPSED_EXT);
+  current_sample_queries_.push_back(current_query_);
+  current_query_ = 0u;
+}
+
+void GpuTimer::EndSample() {
+  DCHECK(!current_query_);
+  if (current_sample_queries_.empty())
+    return;
+
+  pending_samples_.push_back(std::vector<unsigned>());
+  pending_samples_.back().swap(current_sample_queries_);
+}
+
+void GpuTimer::TakeCompletedSamples(std::vector<base::TimeDelta>* durations) {
+  std::vector<base::TimeDelta> completed;
+  while (!pending_samples_.empty()) {
+    const std::vector<unsigned>& queries = pending_samples_.front();
+    // Queries complete in the order they were issued, so the sample is done
+    // once its last query is.
+    unsigned available = 0;
+    gl_->GetQueryObjectuivEXT(queries.back(), GL_QUERY_RESULT_AVAILABLE_EXT,
+                              &available);
+    if (!available)
+      break;
+
+    uint64_t elapsed_ns = 0;
+    for (unsigned query : queries) {
+      GLuint64 result = 0;
+      gl_->GetQueryObjectui64vEXT(query, GL_QUERY_RESULT_EXT, &result);
+      elapsed_ns += result;
+      available_queries_.push_back(query);
+    }
+    completed.push_back(base::TimeDelta::FromMicroseconds(
+        elapsed_ns / base::Time::kNanosecondsPerMicrosecond));
+    pending_samples_.pop_front();
+  }
+
+  // The disjoint flag is reset when read, so it tells whether anything timed
+  // since the last poll is unreliable.
+  int disjoint = 0;
+  gl_->GetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+  if (disjoint)
+    return;
+  durations->insert(durations->end(), completed.begin(), completed.end());
+}
+
+}  // namespace cc
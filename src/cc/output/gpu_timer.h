@@ -0,0 +1,65 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_OUTPUT_GPU_TIMER_H_
+#define CC_OUTPUT_GPU_TIMER_H_
+
+#include <deque>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "cc/base/cc_export.h"
+
+namespace gpu {
+namespace gles2 {
+class GLES2Interface;
+}
+}
+
+namespace cc {
+
+// Measures how long the GPU takes to run groups of GL commands, like the
+// render passes of a frame, with a pool of GL_TIME_ELAPSED_EXT queries. The
+// results are polled and never waited for, so timing can stay on all the time.
+// The context must support timer queries, and the timer must only be used
+// where the context can be.
+class CC_EXPORT GpuTimer {
+ public:
+  explicit GpuTimer(gpu::gles2::GLES2Interface* gl);
+  ~GpuTimer();
+
+  // Times the GL commands issued between the two calls. Intervals can't
+  // overlap. While the GPU is too far behind with the previous samples, new
+  // intervals aren't timed.
+  void StartInterval();
+  void StopInterval();
+
+  // Makes the intervals timed since the previous call one sample.
+  void EndSample();
+
+  // Appends the durations of the samples the GPU is done with to |durations|,
+  // oldest first. Samples that overlap a disjoint operation of the GPU, like a
+  // change of its clock frequency, are dropped, as their timings can't be
+  // trusted.
+  void TakeCompletedSamples(std::vector<base::TimeDelta>* durations);
+
+  size_t pending_sample_count_for_testing() const {
+    return pending_samples_.size();
+  }
+
+ private:
+  gpu::gles2::GLES2Interface* const gl_;
+
+  std::vector<unsigned> available_queries_;
+  unsigned current_query_;
+  std::vector<unsigned> current_sample_queries_;
+  std::deque<std::vector<unsigned>> pending_samples_;
+
+  DISALLOW_COPY_AND_ASSIGN(GpuTimer);
+};
+
+}  // namespace cc
+
+#endif  // CC_OUTPUT_GPU_TIMER_H_
@@ -0,0 +1,194 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/output/gpu_timer.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "base/macros.h"
+#include "gpu/GLES2/gl2extchromium.h"
+#include "gpu/command_buffer/client/gles2_interface_stub.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+// Runs the timer queries on a fake GPU whose clock only moves when told to.
+class TimerQueryGLES2Interface : public gpu::gles2::GLES2InterfaceStub {
+ public:
+  TimerQueryGLES2Interface()
+      : next_query_id_(1u),
+        active_query_(0u),
+        elapsed_ns_(0u),
+        disjoint_(false) {}
+
+  void GenQueriesEXT(GLsizei n, GLuint* queries) override {
+    for (GLsizei i = 0; i < n; ++i) {
+      queries[i] = next_query_id_++;
+      live_queries_.insert(queries[i]);
+    }
+  }
+  void DeleteQueriesEXT(GLsizei n, const GLuint* queries) override {
+    for (GLsizei i = 0; i < n; ++i)
+      EXPECT_EQ(1u, live_queries_.erase(queries[i]));
+  }
+  void BeginQueryEXT(GLenum target, GLuint id) override {
+    EXPECT_EQ(static_cast<GLenum>(GL_TIME_ELAPSED_EXT), target);
+    EXPECT_EQ(0u, active_query_);
+    EXPECT_EQ(1u, live_queries_.count(id));
+    active_query_ = id;
+    query_start_ns_ = elapsed_ns_;
+    results_.erase(id);
+  }
+  void EndQueryEXT(GLenum target) override {
+    EXPECT_NE(0u, active_query_);
+    pending_results_[active_query_] = elapsed_ns_ - query_start_ns_;
+    active_query_ = 0u;
+  }
+  void GetQueryObjectuivEXT(GLuint id, GLenum pname, GLuint* params) override {
+    EXPECT_EQ(static_cast<GLenum>(GL_QUERY_RESULT_AVAILABLE_EXT), pname);
+    *params = results_.count(id);
+  }
+  void GetQueryObjectui64vEXT(GLuint id,
+                              GLenum pname,
+                              GLuint64* params) override {
+    EXPECT_EQ(static_cast<GLenum>(GL_QUERY_RESULT_EXT), pname);
+    ASSERT_EQ(1u, results_.count(id));
+    *params = results_[id];
+  }
+  void GetIntegerv(GLenum pname, GLint* params) override {
+    if (pname == GL_GPU_DISJOINT_EXT) {
+      *params = disjoint_;
+      disjoint_ = false;
+    }
+  }
+
+  // Runs |ns| nanoseconds of GPU work.
+  void RunGpu(uint64_t ns) { elapsed_ns_ += ns; }
+
+  // Makes the results of the queries ended so far available.
+  void FinishGpuWork() {
+    results_.insert(pending_results_.begin(), pending_results_.end());
+    pending_results_.clear();
+  }
+
+  void set_disjoint() { disjoint_ = true; }
+  size_t live_query_count() const { return live_queries_.size(); }
+
+ private:
+  GLuint next_query_id_;
+  std::set<GLuint> live_queries_;
+  GLuint active_query_;
+  uint64_t query_start_ns_;
+  uint64_t elapsed_ns_;
+  std::map<GLuint, uint64_t> pending_results_;
+  std::map<GLuint, uint64_t> results_;
+  bool disjoint_;
+};
+
+class GpuTimerTest : public testing::Test {
+ protected:
+  GpuTimerTest() : timer_(&gl_) {}
+
+  // Times a sample of |interval_count| intervals of |interval_us| each.
+  void TimeSample(int interval_count, int64_t interval_us) {
+    for (int i = 0; i < interval_count; ++i) {
+      timer_.StartInterval();
+      gl_.RunGpu(interval_us * 1000);
+      timer_.StopInterval();
+      // GPU work between the intervals is not timed.
+      gl_.RunGpu(1000000);
+    }
+    timer_.EndSample();
+  }
+
+  TimerQueryGLES2Interface gl_;
+  GpuTimer timer_;
+};
+
+TEST_F(GpuTimerTest, SumsIntervalsOfSamples) {
+  TimeSample(3, 100);
+  TimeSample(1, 250);
+
+  std::vector<base::TimeDelta> durations;
+  timer_.TakeCompletedSamples(&durations);
+  EXPECT_TRUE(durations.empty());
+  EXPECT_EQ(2u, timer_.pending_sample_count_for_testing());
+
+  gl_.FinishGpuWork();
+  timer_.TakeCompletedSamples(&durations);
+  ASSERT_EQ(2u, durations.size());
+  EXPECT_EQ(base::TimeDelta::FromMicroseconds(300), durations[0]);
+  EXPECT_EQ(base::TimeDelta::FromMicroseconds(250), durations[1]);
+  EXPECT_EQ(0u, timer_.pending_sample_count_for_testing());
+
+  // The queries are reused.
+  TimeSample(4, 10);
+  gl_.FinishGpuWork();
+  durations.clear();
+  timer_.TakeCompletedSamples(&durations);
+  ASSERT_EQ(1u, durations.size());
+  EXPECT_EQ(base::TimeDelta::FromMicroseconds(40), durations[0]);
+  EXPECT_EQ(4u, gl_.live_query_count());
+}
+
+TEST_F(GpuTimerTest, EmptySamplesAreSkipped) {
+  timer_.EndSample();
+  TimeSample(0, 100);
+  EXPECT_EQ(0u, timer_.pending_sample_count_for_testing());
+}
+
+TEST_F(GpuTimerTest, DropsSamplesOnDisjoint) {
+  TimeSample(1, 100);
+  gl_.FinishGpuWork();
+  gl_.set_disjoint();
+
+  std::vector<base::TimeDelta> durations;
+  timer_.TakeCompletedSamples(&durations);
+  EXPECT_TRUE(durations.empty());
+  EXPECT_EQ(0u, timer_.pending_sample_count_for_testing());
+
+  TimeSample(1, 100);
+  gl_.FinishGpuWork();
+  timer_.TakeCompletedSamples(&durations);
+  EXPECT_EQ(1u, durations.size());
+}
+
+TEST_F(GpuTimerTest, StopsTimingWhileGpuIsBehind) {
+  for (int i = 0; i < 20; ++i)
+    TimeSample(1, 100);
+  EXPECT_GT(20u, timer_.pending_sample_count_for_testing());
+  EXPECT_EQ(timer_.pending_sample_count_for_testing(), gl_.live_query_count());
+
+  gl_.FinishGpuWork();
+  std::vector<base::TimeDelta> durations;
+  timer_.TakeCompletedSamples(&durations);
+  EXPECT_EQ(gl_.live_query_count(), durations.size());
+
+  // Timing resumes once the GPU catches up.
+  TimeSample(1, 100);
+  EXPECT_EQ(1u, timer_.pending_sample_count_for_testing());
+}
+
+TEST(GpuTimerDestructionTest, DeletesAllQueries) {
+  TimerQueryGLES2Interface gl;
+  {
+    GpuTimer timer(&gl);
+    timer.StartInterval();
+    timer.StopInterval();
+    timer.EndSample();
+    timer.StartInterval();
+    timer.StopInterval();
+    timer.StartInterval();
+    EXPECT_EQ(3u, gl.live_query_count());
+  }
+  EXPECT_EQ(0u, gl.live_query_count());
+}
+
+}  // namespace
+}  // namespace cc
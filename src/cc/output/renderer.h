@@ -6,8 +6,10 @@
 #define CC_OUTPUT_RENDERER_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "cc/base/cc_export.h"
 #include "cc/output/compositor_frame_metadata.h"
 #include "cc/output/renderer_capabilities.h"
@@ -83,6 +85,12 @@ class CC_EXPORT Renderer {
   virtual void SwapBuffers(CompositorFrameMetadata metadata) = 0;
   virtual void ReceiveSwapBuffersAck(const CompositorFrameAck& ack) {}
 
+  // Appends how long the GPU took to draw each of the frames it finished since
+  // the previous call, oldest first. Renderers that can't time the GPU append
+  // nothing.
+  virtual void TakeCompletedGpuDrawDurations(
+      std::vector<base::TimeDelta>* durations) {}
+
   bool visible() const { return visible_; }
   void SetVisible(bool visible);
 
@@ -33,6 +33,7 @@ class CC_EXPORT ClipDisplayItem : public DisplayItem {
   void AsValueInto(const gfx::Rect& visual_rect,
                    base::trace_event::TracedValue* array) const override;
   size_t ExternalMemoryUsage() const override;
+  bool IsBeginItem() const override { return true; }
 
   int ApproximateOpCount() const { return 1; }
 
@@ -58,6 +59,7 @@ class CC_EXPORT EndClipDisplayItem : public DisplayItem {
   void AsValueInto(const gfx::Rect& visual_rect,
                    base::trace_event::TracedValue* array) const override;
   size_t ExternalMemoryUsage() const override;
+  bool IsEndItem() const override { return true; }
 
   int ApproximateOpCount() const { return 0; }
 };
@@ -39,6 +39,7 @@ class CC_EXPORT CompositingDisplayItem : public DisplayItem {
   void AsValueInto(const gfx::Rect& visual_rect,
                    base::trace_event::TracedValue* array) const override;
   size_t ExternalMemoryUsage() const override;
+  bool IsBeginItem() const override { return true; }
 
   int ApproximateOpCount() const { return 1; }
 
@@ -73,6 +74,7 @@ class CC_EXPORT EndCompositingDisplayItem : public DisplayItem {
   void AsValueInto(const gfx::Rect& visual_rect,
                    base::trace_event::TracedValue* array) const override;
   size_t ExternalMemoryUsage() const override;
+  bool IsEndItem() const override { return true; }
 
   int ApproximateOpCount() const { return 0; }
 };
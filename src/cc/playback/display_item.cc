@@ -13,4 +13,16 @@ sk_sp<const SkPicture> DisplayItem::GetPicture() const {
   return nullptr;
 }
 
+bool DisplayItem::IsBeginItem() const {
+  return false;
+}
+
+bool DisplayItem::IsEndItem() const {
+  return false;
+}
+
+bool DisplayItem::MovesPixels() const {
+  return false;
+}
+
 }  // namespace cc
@@ -35,6 +35,14 @@ class CC_EXPORT DisplayItem {
   // For tracing.
   virtual size_t ExternalMemoryUsage() const = 0;
 
+  // Begin items apply state, such as a clip or a transform, to the items that
+  // follow them up to their matching end item.
+  virtual bool IsBeginItem() const;
+  virtual bool IsEndItem() const;
+  // Whether the items up to the matching end item may draw outside of their
+  // visual rects. Only called on begin items.
+  virtual bool MovesPixels() const;
+
  protected:
   DisplayItem();
 };
@@ -6,6 +6,8 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <limits>
 #include <string>
 
 #include "base/numerics/safe_conversions.h"
@@ -26,6 +28,7 @@
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/utils/SkPictureUtils.h"
 #include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/rect_conversions.h"
 #include "ui/gfx/skia_util.h"
 
 namespace cc {
@@ -45,6 +48,13 @@ bool DisplayItemsTracingEnabled() {
 
 const int kDefaultNumDisplayItemsToReserve = 100;
 
+// The bounds of items that may draw anywhere, such as the items under a
+// filter that moves pixels. Leaves room for unions with the other bounds.
+constexpr gfx::Rect kUnboundedRect(std::numeric_limits<int>::min() / 2,
+                                   std::numeric_limits<int>::min() / 2,
+                                   std::numeric_limits<int>::max(),
+                                   std::numeric_limits<int>::max());
+
 }  // namespace
 
 scoped_refptr<DisplayItemList> DisplayItemList::Create(
@@ -83,6 +93,7 @@ DisplayItemList::DisplayItemList(gfx::Rect layer_rect,
              LargestDisplayItemSize() * kDefaultNumDisplayItemsToReserve),
       settings_(settings),
       retain_individual_display_items_(retain_individual_display_items),
+      use_rtree_(false),
       layer_rect_(layer_rect),
       is_suitable_for_gpu_rasterization_(true),
       approximate_op_count_(0),
@@ -137,8 +148,21 @@ void DisplayItemList::Raster(SkCanvas* canvas,
 void DisplayItemList::Raster(SkCanvas* canvas,
                              SkPicture::AbortCallback* callback) const {
   if (!settings_.use_cached_picture) {
-    for (const auto& item : items_)
-      item.Raster(canvas, callback);
+    SkRect clip_bounds;
+    if (!canvas->getClipBounds(&clip_bounds))
+      return;
+    gfx::Rect query = gfx::ToEnclosingRect(gfx::SkRectToRectF(clip_bounds));
+    if (!use_rtree_ || query.Contains(rtree_.GetBounds())) {
+      for (const auto& item : items_)
+        item.Raster(canvas, callback);
+      return;
+    }
+
+    std::vector<size_t> indices;
+    rtree_.Search(query, &indices);
+    std::sort(indices.begin(), indices.end());
+    for (size_t index : indices)
+      items_[index].Raster(canvas, callback);
   } else {
     DCHECK(picture_);
 
@@ -188,9 +212,9 @@ void DisplayItemList::Finalize() {
       << "items.size() " << items_.size() << " visual_rects.size() "
       << visual_rects_.size();
 
-  // TODO(vmpstr): Build and make use of an RTree from the visual
-  // rects. For now we just clear them out since we won't ever need
-  // them to stick around post-Finalize. http://crbug.com/527245
+  if (!settings_.use_cached_picture)
+    BuildRTree();
+
   // This clears both the vector and the vector's capacity, since visual_rects_
   // won't be used anymore.
   std::vector<gfx::Rect>().swap(visual_rects_);
@@ -207,6 +231,60 @@ void DisplayItemList::Finalize() {
   }
 }
 
+void DisplayItemList::BuildRTree() {
+  DCHECK(retain_individual_display_items_);
+  DCHECK(!use_rtree_);
+
+  // Grow the bounds of each begin item to cover the items up to its end item,
+  // and use them for the end item as well.
+  std::vector<gfx::Rect> bounds(visual_rects_);
+  std::vector<size_t> begin_items;
+  for (size_t i = 0; i < items_.size(); ++i) {
+    const DisplayItem& item = items_[i];
+    if (item.IsBeginItem()) {
+      begin_items.push_back(i);
+      continue;
+    }
+    if (item.IsEndItem()) {
+      // Without a matching begin item there is no telling which items the
+      // end item affects.
+      if (begin_items.empty())
+        return;
+      size_t begin = begin_items.back();
+      begin_items.pop_back();
+      if (items_[begin].MovesPixels())
+        bounds[begin] = kUnboundedRect;
+      bounds[i] = bounds[begin];
+    } else if (bounds[i].IsEmpty()) {
+      // Drawings without a visual rect could draw anywhere.
+      return;
+    }
+    if (!begin_items.empty())
+      bounds[begin_items.back()].Union(bounds[i]);
+  }
+  if (!begin_items.empty())
+    return;
+
+  // The items under a filter that moves pixels can't be culled individually,
+  // since they may be moved into the clip.
+  size_t unbounded_depth = 0;
+  for (size_t i = 0; i < items_.size(); ++i) {
+    const DisplayItem& item = items_[i];
+    if (unbounded_depth) {
+      bounds[i] = kUnboundedRect;
+      if (item.IsBeginItem())
+        ++unbounded_depth;
+      else if (item.IsEndItem())
+        --unbounded_depth;
+    } else if (item.IsBeginItem() && item.MovesPixels()) {
+      unbounded_depth = 1;
+    }
+  }
+
+  rtree_.Build(bounds);
+  use_rtree_ = true;
+}
+
 bool DisplayItemList::IsSuitableForGpuRasterization() const {
   return is_suitable_for_gpu_rasterization_;
 }
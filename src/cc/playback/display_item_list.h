@@ -16,6 +16,7 @@
 #include "base/trace_event/trace_event.h"
 #include "cc/base/cc_export.h"
 #include "cc/base/contiguous_container.h"
+#include "cc/base/rtree.h"
 #include "cc/playback/discardable_image_map.h"
 #include "cc/playback/display_item.h"
 #include "cc/playback/display_item_list_settings.h"
@@ -126,6 +127,9 @@ class CC_EXPORT DisplayItemList
 
   void ProcessAppendedItem(const DisplayItem* item);
 
+  // Builds |rtree_| from |visual_rects_|, unless the items can't be culled.
+  void BuildRTree();
+
   ContiguousContainer<DisplayItem> items_;
   // The visual rects associated with each of the display items in the
   // display item list. There is one rect per display item, and the
@@ -133,6 +137,12 @@ class CC_EXPORT DisplayItemList
   // |items_| . These rects are intentionally kept separate
   // because they are not needed while walking the |items_| for raster.
   std::vector<gfx::Rect> visual_rects_;
+  // Indexes |items_| by the rects they may draw into, so that Raster() only
+  // plays the items that intersect the canvas clip. A begin item and its end
+  // item cover all the items between them, so they are played whenever any
+  // of those items is. Only used if |use_rtree_| is set.
+  RTree rtree_;
+  bool use_rtree_;
   sk_sp<SkPicture> picture_;
 
   std::unique_ptr<SkPictureRecorder> recorder_;
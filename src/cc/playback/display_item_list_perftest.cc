@@ -0,0 +1,95 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+#include "cc/debug/lap_timer.h"
+#include "cc/playback/clip_display_item.h"
+#include "cc/playback/display_item_list.h"
+#include "cc/playback/display_item_list_settings.h"
+#include "cc/playback/drawing_display_item.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/skia_util.h"
+
+namespace cc {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 10;
+
+const int kPageWidth = 1000;
+const int kRowHeight = 20;
+const int kTileSize = 256;
+
+class DisplayItemListPerfTest : public testing::Test {
+ public:
+  DisplayItemListPerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+  // Creates a long page of |row_count| rows, each with a clipped drawing.
+  scoped_refptr<DisplayItemList> CreatePage(int row_count) {
+    gfx::Rect layer_rect(kPageWidth, row_count * kRowHeight);
+    DisplayItemListSettings settings;
+    settings.use_cached_picture = false;
+    scoped_refptr<DisplayItemList> list =
+        DisplayItemList::Create(layer_rect, settings);
+
+    SkPaint paint;
+    paint.setColor(SK_ColorBLUE);
+    for (int i = 0; i < row_count; ++i) {
+      gfx::Rect row(0, i * kRowHeight, kPageWidth, kRowHeight);
+      SkPictureRecorder recorder;
+      SkCanvas* canvas = recorder.beginRecording(gfx::RectToSkRect(row));
+      canvas->drawRect(gfx::RectToSkRect(row), paint);
+
+      list->CreateAndAppendItem<ClipDisplayItem>(
+          row, row, std::vector<SkRRect>(), false);
+      list->CreateAndAppendItem<DrawingDisplayItem>(
+          row, recorder.finishRecordingAsPicture());
+      list->CreateAndAppendItem<EndClipDisplayItem>(row);
+    }
+    list->Finalize();
+    return list;
+  }
+
+  void RunRasterTileTest(const std::string& test_name, int row_count) {
+    scoped_refptr<DisplayItemList> list = CreatePage(row_count);
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(kTileSize, kTileSize);
+    SkCanvas canvas(bitmap);
+    // Raster a tile halfway down the page.
+    canvas.translate(0, -row_count * kRowHeight / 2);
+
+    timer_.Reset();
+    do {
+      list->Raster(&canvas, nullptr);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("display_item_list_raster_tile", "", test_name,
+                           timer_.LapsPerSecond(), "runs/s", true);
+  }
+
+ private:
+  LapTimer timer_;
+};
+
+TEST_F(DisplayItemListPerfTest, RasterTile) {
+  RunRasterTileTest("100_rows", 100);
+  RunRasterTileTest("1000_rows", 1000);
+  RunRasterTileTest("10000_rows", 10000);
+}
+
+}  // namespace
+}  // namespace cc
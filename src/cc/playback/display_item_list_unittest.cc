@@ -109,6 +109,29 @@ void ValidateDisplayItemListSerialization(const gfx::Size& layer_size,
                                                list.get(), new_list.get()));
 }
 
+// Creates a picture that fills |layer_rect| with |color|, whatever the visual
+// rect of its item says.
+sk_sp<const SkPicture> CreateFilledPicture(const gfx::Rect& layer_rect,
+                                           SkColor color) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(gfx::RectToSkRect(layer_rect));
+  canvas->drawColor(color);
+  return recorder.finishRecordingAsPicture();
+}
+
+SkColor RasterAndGetColor(scoped_refptr<DisplayItemList> list,
+                          const gfx::Rect& layer_rect,
+                          const gfx::Rect& clip_rect,
+                          const gfx::Point& point) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(layer_rect.width(), layer_rect.height());
+  bitmap.eraseColor(SK_ColorTRANSPARENT);
+  SkCanvas canvas(bitmap);
+  canvas.clipRect(gfx::RectToSkRect(clip_rect));
+  list->Raster(&canvas, nullptr);
+  return bitmap.getColor(point.x(), point.y());
+}
+
 }  // namespace
 
 TEST(DisplayItemListTest, SerializeDisplayItemListSettings) {
@@ -474,6 +497,64 @@ TEST(DisplayItemListTest, FilterItem) {
   EXPECT_EQ(0, memcmp(pixels, expected_pixels, 4 * 100 * 100));
 }
 
+TEST(DisplayItemListTest, RasterSkipsItemsOutsideOfTheClip) {
+  gfx::Rect layer_rect(100, 100);
+  DisplayItemListSettings settings;
+  settings.use_cached_picture = false;
+  scoped_refptr<DisplayItemList> list =
+      DisplayItemList::Create(layer_rect, settings);
+
+  gfx::Rect top_left(0, 0, 10, 10);
+  gfx::Rect bottom_right(90, 90, 10, 10);
+  list->CreateAndAppendItem<DrawingDisplayItem>(
+      top_left, CreateFilledPicture(layer_rect, SK_ColorRED));
+  list->CreateAndAppendItem<ClipDisplayItem>(
+      top_left, gfx::Rect(50, 0, 50, 100), std::vector<SkRRect>(), false);
+  list->CreateAndAppendItem<DrawingDisplayItem>(
+      bottom_right, CreateFilledPicture(layer_rect, SK_ColorBLUE));
+  list->CreateAndAppendItem<EndClipDisplayItem>(top_left);
+  list->Finalize();
+
+  // Only the first drawing intersects the clip, so the second one does not
+  // paint over it.
+  EXPECT_EQ(SK_ColorRED, RasterAndGetColor(list, layer_rect, top_left,
+                                           gfx::Point(5, 5)));
+  // The clip item is played along with the second drawing.
+  EXPECT_EQ(SK_ColorBLUE, RasterAndGetColor(list, layer_rect, bottom_right,
+                                            gfx::Point(95, 95)));
+  EXPECT_EQ(SK_ColorTRANSPARENT,
+            RasterAndGetColor(list, layer_rect, gfx::Rect(0, 90, 10, 10),
+                              gfx::Point(5, 95)));
+  // Everything is played when the clip covers all the items.
+  EXPECT_EQ(SK_ColorBLUE, RasterAndGetColor(list, layer_rect, layer_rect,
+                                            gfx::Point(55, 5)));
+}
+
+TEST(DisplayItemListTest, RasterPlaysItemsUnderFiltersThatMovePixels) {
+  gfx::Rect layer_rect(100, 100);
+  DisplayItemListSettings settings;
+  settings.use_cached_picture = false;
+  scoped_refptr<DisplayItemList> list =
+      DisplayItemList::Create(layer_rect, settings);
+
+  gfx::Rect top_left(0, 0, 10, 10);
+  gfx::Rect bottom_right(90, 90, 10, 10);
+  FilterOperations filters;
+  filters.Append(FilterOperation::CreateBlurFilter(1.f));
+  ASSERT_TRUE(filters.HasFilterThatMovesPixels());
+  list->CreateAndAppendItem<FilterDisplayItem>(top_left, filters,
+                                               gfx::RectF(layer_rect));
+  list->CreateAndAppendItem<DrawingDisplayItem>(
+      top_left, CreateFilledPicture(layer_rect, SK_ColorRED));
+  list->CreateAndAppendItem<EndFilterDisplayItem>(top_left);
+  list->Finalize();
+
+  // The drawing may be blurred into the clip, so it is played.
+  EXPECT_NE(SK_ColorTRANSPARENT,
+            RasterAndGetColor(list, layer_rect, bottom_right,
+                              gfx::Point(95, 95)));
+}
+
 TEST(DisplayItemListTest, CompactingItems) {
   gfx::Rect layer_rect(100, 100);
   SkPictureRecorder recorder;
@@ -31,6 +31,10 @@ class CC_EXPORT FilterDisplayItem : public DisplayItem {
   void AsValueInto(const gfx::Rect& visual_rect,
                    base::trace_event::TracedValue* array) const override;
   size_t ExternalMemoryUsage() const override;
+  bool IsBeginItem() const override { return true; }
+  bool MovesPixels() const override {
+    return filters_.HasFilterThatMovesPixels();
+  }
 
   int ApproximateOpCount() const { return 1; }
 
@@ -57,6 +61,7 @@ class CC_EXPORT EndFilterDisplayItem : public DisplayItem {
   void AsValueInto(const gfx::Rect& visual_rect,
                    base::trace_event::TracedValue* array) const override;
   size_t ExternalMemoryUsage() const override;
+  bool IsEndItem() const override { return true; }
 
   int ApproximateOpCount() const { return 0; }
 };
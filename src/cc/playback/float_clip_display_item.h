@@ -31,6 +31,7 @@ class CC_EXPORT FloatClipDisplayItem : public DisplayItem {
   void AsValueInto(const gfx::Rect& visual_rect,
                    base::trace_event::TracedValue* array) const override;
   size_t ExternalMemoryUsage() const override;
+  bool IsBeginItem() const override { return true; }
 
   int ApproximateOpCount() const { return 1; }
 
@@ -56,6 +57,7 @@ class CC_EXPORT EndFloatClipDisplayItem : public DisplayItem {
   void AsValueInto(const gfx::Rect& visual_rect,
                    base::trace_event::TracedValue* array) const override;
   size_t ExternalMemoryUsage() const override;
+  bool IsEndItem() const override { return true; }
 
   int ApproximateOpCount() const { return 0; }
 };
@@ -12,6 +12,7 @@
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/trace_event/trace_event.h"
+#include "cc/output/gpu_timer.h"
 #include "cc/playback/image_hijack_canvas.h"
 #include "cc/playback/raster_source.h"
 #include "cc/raster/scoped_gpu_raster.h"
@@ -168,10 +169,19 @@ GpuRasterBufferProvider::GpuRasterBufferProvider(
       async_worker_context_enabled_(async_worker_context_enabled) {
   DCHECK(compositor_context_provider);
   DCHECK(worker_context_provider);
+
+  ContextProvider::ScopedContextLock scoped_context(worker_context_provider_);
+  if (worker_context_provider_->ContextCapabilities().timer_queries)
+    raster_timer_.reset(new GpuTimer(scoped_context.ContextGL()));
 }
 
 GpuRasterBufferProvider::~GpuRasterBufferProvider() {
   DCHECK(pending_raster_buffers_.empty());
+
+  if (raster_timer_) {
+    ContextProvider::ScopedContextLock scoped_context(worker_context_provider_);
+    raster_timer_.reset();
+  }
 }
 
 std::unique_ptr<RasterBuffer> GpuRasterBufferProvider::AcquireBufferForRaster(
@@ -223,6 +233,14 @@ bool GpuRasterBufferProvider::GetResourceRequiresSwizzle(
   return false;
 }
 
+void GpuRasterBufferProvider::TakeCompletedGpuRasterDurations(
+    std::vector<base::TimeDelta>* durations) {
+  if (!raster_timer_)
+    return;
+  ContextProvider::ScopedContextLock scoped_context(worker_context_provider_);
+  raster_timer_->TakeCompletedSamples(durations);
+}
+
 void GpuRasterBufferProvider::Shutdown() {
   pending_raster_buffers_.clear();
 }
@@ -254,11 +272,17 @@ void GpuRasterBufferProvider::PlaybackOnWorkerThread(
       raster_source, resource_has_previous_content, resource_lock->size(),
       raster_full_rect, raster_dirty_rect, scale, playback_settings);
 
+  if (raster_timer_)
+    raster_timer_->StartInterval();
   RasterizePicture(picture.get(), worker_context_provider_, resource_lock,
                    async_worker_context_enabled_, use_distance_field_text_,
                    raster_source->CanUseLCDText(), msaa_sample_count_,
                    raster_source->image_decode_controller(),
                    playback_settings.use_image_hijack_canvas);
+  if (raster_timer_) {
+    raster_timer_->StopInterval();
+    raster_timer_->EndSample();
+  }
 
   const uint64_t fence_sync = gl->InsertFenceSyncCHROMIUM();
 
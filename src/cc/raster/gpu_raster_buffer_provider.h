@@ -7,6 +7,10 @@
 
 #include <stdint.h>
 
+#include <memory>
+#include <set>
+#include <vector>
+
 #include "base/macros.h"
 #include "cc/raster/raster_buffer_provider.h"
 #include "cc/resources/resource_provider.h"
@@ -14,6 +18,7 @@
 
 namespace cc {
 class ContextProvider;
+class GpuTimer;
 
 class CC_EXPORT GpuRasterBufferProvider : public RasterBufferProvider {
  public:
@@ -34,6 +39,8 @@ class CC_EXPORT GpuRasterBufferProvider : public RasterBufferProvider {
   void OrderingBarrier() override;
   ResourceFormat GetResourceFormat(bool must_support_alpha) const override;
   bool GetResourceRequiresSwizzle(bool must_support_alpha) const override;
+  void TakeCompletedGpuRasterDurations(
+      std::vector<base::TimeDelta>* durations) override;
   void Shutdown() override;
 
   void PlaybackOnWorkerThread(
@@ -89,6 +96,10 @@ class CC_EXPORT GpuRasterBufferProvider : public RasterBufferProvider {
 
   std::set<RasterBufferImpl*> pending_raster_buffers_;
 
+  // Times the raster tasks on the worker context, if it supports timer
+  // queries. Only used with the worker context lock held.
+  std::unique_ptr<GpuTimer> raster_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(GpuRasterBufferProvider);
 };
 
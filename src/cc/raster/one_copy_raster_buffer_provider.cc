@@ -152,6 +152,14 @@ bool OneCopyRasterBufferProvider::GetResourceRequiresSwizzle(
   return ResourceFormatRequiresSwizzle(GetResourceFormat(must_support_alpha));
 }
 
+ResourceFormat OneCopyRasterBufferProvider::GetCompressedResourceFormat()
+    const {
+  // Playback to memory compresses ETC1 resources on the worker thread.
+  if (resource_provider_->IsResourceFormatSupported(ETC1))
+    return ETC1;
+  return GetResourceFormat(false);
+}
+
 void OneCopyRasterBufferProvider::Shutdown() {
   staging_pool_.Shutdown();
   pending_raster_buffers_.clear();
@@ -168,17 +176,10 @@ void OneCopyRasterBufferProvider::PlaybackAndCopyOnWorkerThread(
     const RasterSource::PlaybackSettings& playback_settings,
     uint64_t previous_content_id,
     uint64_t new_content_id) {
-  if (async_worker_context_enabled_) {
-    // Early out if sync token is invalid. This happens if the compositor
-    // context was lost before ScheduleTasks was called.
-    if (!sync_token.HasData())
-      return;
-    ContextProvider::ScopedContextLock scoped_context(worker_context_provider_);
-    gpu::gles2::GLES2Interface* gl = scoped_context.ContextGL();
-    DCHECK(gl);
-    // Synchronize with compositor.
-    gl->WaitSyncTokenCHROMIUM(sync_token.GetConstData());
-  }
+  // Early out if sync token is invalid. This happens if the compositor
+  // context was lost before ScheduleTasks was called.
+  if (async_worker_context_enabled_ && !sync_token.HasData())
+    return;
 
   std::unique_ptr<StagingBuffer> staging_buffer =
       staging_pool_.AcquireStagingBuffer(resource, previous_content_id);
@@ -268,6 +269,11 @@ void OneCopyRasterBufferProvider::CopyOnWorkerThread(
   gpu::gles2::GLES2Interface* gl = scoped_context.ContextGL();
   DCHECK(gl);
 
+  // Synchronize with compositor. The resource is only used by the copy, so
+  // waiting here avoids locking the worker context one more time per tile.
+  if (async_worker_context_enabled_)
+    gl->WaitSyncTokenCHROMIUM(sync_token.GetConstData());
+
   // Create texture after synchronizing with compositor.
   ResourceProvider::ScopedTextureProvider scoped_texture(
       gl, resource_lock, async_worker_context_enabled_);
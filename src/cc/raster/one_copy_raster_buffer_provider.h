@@ -41,6 +41,7 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
   void OrderingBarrier() override;
   ResourceFormat GetResourceFormat(bool must_support_alpha) const override;
   bool GetResourceRequiresSwizzle(bool must_support_alpha) const override;
+  ResourceFormat GetCompressedResourceFormat() const override;
   void Shutdown() override;
 
   // Playback raster source and copy result into |resource|.
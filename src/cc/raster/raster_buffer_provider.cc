@@ -42,6 +42,13 @@ bool IsSupportedPlaybackToMemoryFormat(ResourceFormat format) {
 
 }  // anonymous namespace
 
+ResourceFormat RasterBufferProvider::GetCompressedResourceFormat() const {
+  return GetResourceFormat(false);
+}
+
+void RasterBufferProvider::TakeCompletedGpuRasterDurations(
+    std::vector<base::TimeDelta>* durations) {}
+
 // static
 void RasterBufferProvider::PlaybackToMemory(
     void* memory,
@@ -7,6 +7,9 @@
 
 #include <stddef.h>
 
+#include <vector>
+
+#include "base/time/time.h"
 #include "cc/playback/raster_source.h"
 #include "cc/raster/raster_buffer.h"
 #include "cc/raster/task_graph_runner.h"
@@ -62,6 +65,17 @@ class CC_EXPORT RasterBufferProvider {
   // Determine if the resource requires swizzling.
   virtual bool GetResourceRequiresSwizzle(bool must_support_alpha) const = 0;
 
+  // Returns the compressed format that opaque tiles can be rastered into to
+  // reduce their memory usage, or GetResourceFormat(false) if this provider
+  // can not raster into compressed resources.
+  virtual ResourceFormat GetCompressedResourceFormat() const;
+
+  // Appends how long the GPU took to raster the tiles of the completed tasks
+  // to |durations|, for providers that raster on the GPU and can time it.
+  // Each duration covers the tiles played back by one task.
+  virtual void TakeCompletedGpuRasterDurations(
+      std::vector<base::TimeDelta>* durations);
+
   // Shutdown for doing cleanup.
   virtual void Shutdown() = 0;
 
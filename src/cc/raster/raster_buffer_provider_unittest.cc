@@ -164,7 +164,8 @@ class RasterBufferProviderTest
       case RASTER_BUFFER_PROVIDER_TYPE_ZERO_COPY:
         Create3dOutputSurfaceAndResourceProvider();
         raster_buffer_provider_ = ZeroCopyRasterBufferProvider::Create(
-            resource_provider_.get(), PlatformColor::BestTextureFormat());
+            resource_provider_.get(), PlatformColor::BestTextureFormat(),
+            false);
         break;
       case RASTER_BUFFER_PROVIDER_TYPE_ONE_COPY:
         Create3dOutputSurfaceAndResourceProvider();
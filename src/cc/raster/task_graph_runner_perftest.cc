@@ -10,10 +10,14 @@
 
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 #include "cc/base/completion_event.h"
 #include "cc/debug/lap_timer.h"
+#include "cc/raster/single_thread_task_graph_runner.h"
 #include "cc/raster/synchronous_task_graph_runner.h"
+#include "cc/raster/task_category.h"
+#include "cc/raster/work_stealing_task_graph_runner.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 
@@ -41,6 +45,31 @@ class PerfTaskImpl : public Task {
   DISALLOW_COPY_AND_ASSIGN(PerfTaskImpl);
 };
 
+// Spins for a fixed number of iterations, to give worker threads something
+// to do that is comparable to a small raster task.
+class BusyPerfTaskImpl : public Task {
+ public:
+  typedef std::vector<scoped_refptr<BusyPerfTaskImpl>> Vector;
+
+  explicit BusyPerfTaskImpl(int iterations) : iterations_(iterations) {}
+
+  // Overridden from Task:
+  void RunOnWorkerThread() override {
+    volatile int sum = 0;
+    for (int i = 0; i < iterations_; ++i)
+      sum = sum + i;
+  }
+
+  void Reset() { state().Reset(); }
+
+ private:
+  ~BusyPerfTaskImpl() override {}
+
+  const int iterations_;
+
+  DISALLOW_COPY_AND_ASSIGN(BusyPerfTaskImpl);
+};
+
 class TaskGraphRunnerPerfTest : public testing::Test {
  public:
   TaskGraphRunnerPerfTest()
@@ -326,5 +355,86 @@ TEST_F(TaskGraphRunnerPerfTest, ScheduleAndExecuteTasks) {
   RunScheduleAndExecuteTasksTest("2_32_1", 2, 32, 1);
 }
 
+// Compares the threaded TaskGraphRunner implementations running the same
+// graphs of independent tasks to completion.
+class ThreadedTaskGraphRunnerPerfTest : public testing::Test {
+ public:
+  ThreadedTaskGraphRunnerPerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+  void RunExecuteTasksTest(TaskGraphRunner* task_graph_runner,
+                           const std::string& modifier,
+                           const std::string& test_name,
+                           int num_tasks,
+                           int task_iterations) {
+    NamespaceToken token = task_graph_runner->GetNamespaceToken();
+
+    BusyPerfTaskImpl::Vector tasks;
+    for (int i = 0; i < num_tasks; ++i)
+      tasks.push_back(
+          make_scoped_refptr(new BusyPerfTaskImpl(task_iterations)));
+
+    // Avoid unnecessary heap allocations by reusing the same graph and
+    // completed tasks vector.
+    TaskGraph graph;
+    Task::Vector completed_tasks;
+
+    timer_.Reset();
+    do {
+      graph.Reset();
+      for (size_t i = 0; i < tasks.size(); ++i) {
+        tasks[i]->Reset();
+        graph.nodes.push_back(TaskGraph::Node(tasks[i].get(),
+                                              TASK_CATEGORY_FOREGROUND,
+                                              static_cast<uint16_t>(i), 0u));
+      }
+      task_graph_runner->ScheduleTasks(token, &graph);
+      task_graph_runner->WaitForTasksToFinishRunning(token);
+      task_graph_runner->CollectCompletedTasks(token, &completed_tasks);
+      DCHECK_EQ(tasks.size(), completed_tasks.size());
+      completed_tasks.clear();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("execute_tasks", modifier, test_name,
+                           timer_.LapsPerSecond(), "runs/s", true);
+  }
+
+  void RunExecuteTasksTests(TaskGraphRunner* task_graph_runner,
+                            const std::string& modifier) {
+    RunExecuteTasksTest(task_graph_runner, modifier, "1_0", 1, 0);
+    RunExecuteTasksTest(task_graph_runner, modifier, "32_0", 32, 0);
+    RunExecuteTasksTest(task_graph_runner, modifier, "256_0", 256, 0);
+    RunExecuteTasksTest(task_graph_runner, modifier, "32_10000", 32, 10000);
+    RunExecuteTasksTest(task_graph_runner, modifier, "256_10000", 256, 10000);
+  }
+
+ private:
+  LapTimer timer_;
+};
+
+TEST_F(ThreadedTaskGraphRunnerPerfTest, SingleThread) {
+  SingleThreadTaskGraphRunner task_graph_runner;
+  task_graph_runner.Start("PerfTestWorker", base::SimpleThread::Options());
+  RunExecuteTasksTests(&task_graph_runner,
+                       "_single_thread_task_graph_runner");
+  task_graph_runner.Shutdown();
+}
+
+TEST_F(ThreadedTaskGraphRunnerPerfTest, WorkStealing) {
+  const size_t kNumWorkers = 4;
+  WorkStealingTaskGraphRunner task_graph_runner;
+  task_graph_runner.Start(
+      "PerfTestWorker",
+      std::vector<std::vector<TaskCategory>>(
+          kNumWorkers, std::vector<TaskCategory>(1, TASK_CATEGORY_FOREGROUND)),
+      base::SimpleThread::Options());
+  RunExecuteTasksTests(&task_graph_runner,
+                       "_work_stealing_task_graph_runner");
+  task_graph_runner.Shutdown();
+}
+
 }  // namespace
 }  // namespace cc
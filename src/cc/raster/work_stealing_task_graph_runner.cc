@@ -0,0 +1,383 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/work_stealing_task_graph_runner.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "base/memory/ptr_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
+
+namespace cc {
+
+namespace {
+
+// The largest number of tasks a worker claims at once. Claimed tasks can not
+// be canceled or reprioritized, so this bounds the work done on tasks that
+// are no longer needed.
+const size_t kMaxTasksPerClaim = 4;
+
+}  // namespace
+
+// A worker thread and the tasks it claimed but did not run yet, in order of
+// priority.
+class WorkStealingTaskGraphRunner::Worker : public base::SimpleThread {
+ public:
+  Worker(const std::string& name,
+         const Options& options,
+         WorkStealingTaskGraphRunner* runner,
+         const std::vector<TaskCategory>& categories)
+      : SimpleThread(name, options), runner_(runner), categories_(categories) {}
+
+  // Overridden from base::SimpleThread:
+  void Run() override { runner_->RunWorker(this); }
+
+  const std::vector<TaskCategory>& categories() const { return categories_; }
+
+  bool RunsCategory(uint16_t category) const {
+    return std::find(categories_.begin(), categories_.end(), category) !=
+           categories_.end();
+  }
+
+  void PushTask(const PrioritizedTask& task) {
+    base::AutoLock lock(lock_);
+    ready_to_run_tasks_.push_back(task);
+  }
+
+  // The owner takes the most important task.
+  bool PopTask(PrioritizedTask* task) {
+    base::AutoLock lock(lock_);
+    if (ready_to_run_tasks_.empty())
+      return false;
+    *task = ready_to_run_tasks_.front();
+    ready_to_run_tasks_.pop_front();
+    return true;
+  }
+
+  // Thieves take the least important task they can run, which is the one the
+  // owner would run last.
+  bool StealTask(const Worker& thief, PrioritizedTask* task) {
+    base::AutoLock lock(lock_);
+    for (auto it = ready_to_run_tasks_.rbegin();
+         it != ready_to_run_tasks_.rend(); ++it) {
+      if (thief.RunsCategory(it->category)) {
+        *task = *it;
+        ready_to_run_tasks_.erase(std::next(it).base());
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool HasTaskForWorker(const Worker& thief) {
+    base::AutoLock lock(lock_);
+    return std::any_of(ready_to_run_tasks_.begin(), ready_to_run_tasks_.end(),
+                       [&thief](const PrioritizedTask& task) {
+                         return thief.RunsCategory(task.category);
+                       });
+  }
+
+  size_t NumReadyToRunTasks() {
+    base::AutoLock lock(lock_);
+    return ready_to_run_tasks_.size();
+  }
+
+ private:
+  WorkStealingTaskGraphRunner* const runner_;
+  const std::vector<TaskCategory> categories_;
+
+  // Protects |ready_to_run_tasks_|, which is accessed by the owner, by
+  // thieves, and by the runner when claiming tasks.
+  base::Lock lock_;
+  std::deque<PrioritizedTask> ready_to_run_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+WorkStealingTaskGraphRunner::WorkStealingTaskGraphRunner()
+    : lock_(),
+      has_ready_to_run_tasks_cv_(&lock_),
+      has_namespaces_with_finished_running_tasks_cv_(&lock_),
+      shutdown_(false) {}
+
+WorkStealingTaskGraphRunner::~WorkStealingTaskGraphRunner() {}
+
+void WorkStealingTaskGraphRunner::Start(
+    const std::string& thread_name_prefix,
+    const std::vector<std::vector<TaskCategory>>& thread_categories,
+    const base::SimpleThread::Options& thread_options) {
+  DCHECK(workers_.empty());
+  DCHECK(!thread_categories.empty());
+
+  for (const auto& categories : thread_categories) {
+    workers_.push_back(base::WrapUnique(new Worker(
+        base::StringPrintf("%s%u", thread_name_prefix.c_str(),
+                           static_cast<unsigned>(workers_.size() + 1)),
+        thread_options, this, categories)));
+  }
+  // Only start the threads once |workers_| is complete, as they steal from
+  // each other.
+  for (const auto& worker : workers_)
+    worker->Start();
+}
+
+void WorkStealingTaskGraphRunner::Shutdown() {
+  {
+    base::AutoLock lock(lock_);
+
+    DCHECK(!work_queue_.HasReadyToRunTasks());
+    DCHECK(!work_queue_.HasAnyNamespaces());
+
+    DCHECK(!shutdown_);
+    shutdown_ = true;
+
+    // Wake up all workers so they know they should exit.
+    has_ready_to_run_tasks_cv_.Broadcast();
+  }
+  for (const auto& worker : workers_)
+    worker->Join();
+  workers_.clear();
+}
+
+NamespaceToken WorkStealingTaskGraphRunner::GetNamespaceToken() {
+  base::AutoLock lock(lock_);
+  return work_queue_.GetNamespaceToken();
+}
+
+void WorkStealingTaskGraphRunner::ScheduleTasks(NamespaceToken token,
+                                                TaskGraph* graph) {
+  TRACE_EVENT2("cc", "WorkStealingTaskGraphRunner::ScheduleTasks", "num_nodes",
+               graph->nodes.size(), "num_edges", graph->edges.size());
+
+  DCHECK(token.IsValid());
+  DCHECK(!TaskGraphWorkQueue::DependencyMismatch(graph));
+
+  {
+    base::AutoLock lock(lock_);
+
+    DCHECK(!shutdown_);
+
+    work_queue_.ScheduleTasks(token, graph);
+
+    // If there is more work available, wake up the workers. Each of them only
+    // runs some of the categories, so signaling a single one is not enough.
+    if (work_queue_.HasReadyToRunTasks())
+      has_ready_to_run_tasks_cv_.Broadcast();
+  }
+}
+
+void WorkStealingTaskGraphRunner::WaitForTasksToFinishRunning(
+    NamespaceToken token) {
+  TRACE_EVENT0("cc",
+               "WorkStealingTaskGraphRunner::WaitForTasksToFinishRunning");
+
+  DCHECK(token.IsValid());
+
+  {
+    base::AutoLock lock(lock_);
+    base::ThreadRestrictions::ScopedAllowWait allow_wait;
+
+    auto* task_namespace = work_queue_.GetNamespaceForToken(token);
+
+    if (!task_namespace)
+      return;
+
+    while (!work_queue_.HasFinishedRunningTasksInNamespace(task_namespace))
+      has_namespaces_with_finished_running_tasks_cv_.Wait();
+
+    // There may be other namespaces that have finished running tasks, so wake
+    // up another origin thread.
+    has_namespaces_with_finished_running_tasks_cv_.Signal();
+  }
+}
+
+void WorkStealingTaskGraphRunner::CollectCompletedTasks(
+    NamespaceToken token,
+    Task::Vector* completed_tasks) {
+  TRACE_EVENT0("cc", "WorkStealingTaskGraphRunner::CollectCompletedTasks");
+
+  DCHECK(token.IsValid());
+
+  {
+    base::AutoLock lock(lock_);
+    work_queue_.CollectCompletedTasks(token, completed_tasks);
+  }
+}
+
+void WorkStealingTaskGraphRunner::RunWorker(Worker* worker) {
+  std::vector<PrioritizedTask> completed_tasks;
+  PrioritizedTask task(nullptr, nullptr, 0u, 0u);
+
+  while (true) {
+    if (worker->PopTask(&task)) {
+      TRACE_EVENT0("toplevel", "TaskGraphRunner::RunTask");
+      task.task->RunOnWorkerThread();
+      completed_tasks.push_back(task);
+      continue;
+    }
+
+    {
+      base::AutoLock lock(lock_);
+
+      // Report what ran since the last visit in the same lock acquisition as
+      // claiming new tasks.
+      CompleteTasksWithLockAcquired(&completed_tasks);
+      bool claimed = ClaimTasksWithLockAcquired(worker);
+
+      // Wake up other workers if there is more work than this one claimed, or
+      // if it claimed several tasks that they could steal.
+      if (work_queue_.HasReadyToRunTasks() ||
+          (claimed && worker->NumReadyToRunTasks() > 1)) {
+        has_ready_to_run_tasks_cv_.Broadcast();
+      }
+      if (claimed)
+        continue;
+    }
+
+    if (StealTask(worker, &task)) {
+      TRACE_EVENT0("toplevel", "TaskGraphRunner::RunTask");
+      task.task->RunOnWorkerThread();
+      completed_tasks.push_back(task);
+      continue;
+    }
+
+    base::AutoLock lock(lock_);
+    while (!HasWorkForWorkerWithLockAcquired(worker)) {
+      // Exit when shutdown is set and no more tasks are pending.
+      if (shutdown_)
+        return;
+
+      // Wait for more tasks.
+      has_ready_to_run_tasks_cv_.Wait();
+    }
+  }
+}
+
+void WorkStealingTaskGraphRunner::CompleteTasksWithLockAcquired(
+    std::vector<PrioritizedTask>* completed_tasks) {
+  lock_.AssertAcquired();
+
+  bool has_finished_namespace = false;
+  for (const auto& completed_task : *completed_tasks) {
+    work_queue_.CompleteTask(completed_task);
+    if (TaskGraphWorkQueue::HasFinishedRunningTasksInNamespace(
+            completed_task.task_namespace)) {
+      has_finished_namespace = true;
+    }
+  }
+  completed_tasks->clear();
+
+  // If a namespace has finished running all tasks, wake up origin thread.
+  if (has_finished_namespace)
+    has_namespaces_with_finished_running_tasks_cv_.Signal();
+}
+
+bool WorkStealingTaskGraphRunner::ClaimTasksWithLockAcquired(Worker* worker) {
+  lock_.AssertAcquired();
+
+  for (TaskCategory category : worker->categories()) {
+    if (!ShouldRunTaskForCategoryWithLockAcquired(category))
+      continue;
+
+    // Only claim several tasks when there are enough for all workers, and
+    // never for the categories that limit how many tasks run at a time.
+    size_t num_tasks = 1;
+    if (category != TASK_CATEGORY_NONCONCURRENT_FOREGROUND &&
+        category != TASK_CATEGORY_BACKGROUND) {
+      num_tasks = std::min(
+          kMaxTasksPerClaim,
+          std::max<size_t>(
+              1u, NumReadyToRunTasksForCategoryWithLockAcquired(category) /
+                      workers_.size()));
+    }
+
+    for (size_t i = 0;
+         i < num_tasks && work_queue_.HasReadyToRunTasksForCategory(category);
+         ++i) {
+      worker->PushTask(work_queue_.GetNextTaskToRun(category));
+    }
+    return true;
+  }
+  return false;
+}
+
+bool WorkStealingTaskGraphRunner::ShouldRunTaskForCategoryWithLockAcquired(
+    uint16_t category) {
+  lock_.AssertAcquired();
+
+  if (!work_queue_.HasReadyToRunTasksForCategory(category))
+    return false;
+
+  if (category == TASK_CATEGORY_BACKGROUND) {
+    // Only run background tasks if there are no foreground tasks running or
+    // ready to run. Claimed tasks count as running.
+    size_t num_running_foreground_tasks =
+        work_queue_.NumRunningTasksForCategory(
+            TASK_CATEGORY_NONCONCURRENT_FOREGROUND) +
+        work_queue_.NumRunningTasksForCategory(TASK_CATEGORY_FOREGROUND);
+    bool has_ready_to_run_foreground_tasks =
+        work_queue_.HasReadyToRunTasksForCategory(
+            TASK_CATEGORY_NONCONCURRENT_FOREGROUND) ||
+        work_queue_.HasReadyToRunTasksForCategory(TASK_CATEGORY_FOREGROUND);
+
+    if (num_running_foreground_tasks > 0 || has_ready_to_run_foreground_tasks)
+      return false;
+  }
+
+  // Enforce that only one nonconcurrent task runs at a time.
+  if (category == TASK_CATEGORY_NONCONCURRENT_FOREGROUND &&
+      work_queue_.NumRunningTasksForCategory(
+          TASK_CATEGORY_NONCONCURRENT_FOREGROUND) > 0) {
+    return false;
+  }
+
+  return true;
+}
+
+size_t
+WorkStealingTaskGraphRunner::NumReadyToRunTasksForCategoryWithLockAcquired(
+    uint16_t category) {
+  lock_.AssertAcquired();
+
+  size_t count = 0;
+  auto found = work_queue_.ready_to_run_namespaces().find(category);
+  if (found == work_queue_.ready_to_run_namespaces().end())
+    return count;
+  for (const auto* task_namespace : found->second) {
+    auto tasks = task_namespace->ready_to_run_tasks.find(category);
+    if (tasks != task_namespace->ready_to_run_tasks.end())
+      count += tasks->second.size();
+  }
+  return count;
+}
+
+bool WorkStealingTaskGraphRunner::StealTask(Worker* thief,
+                                            PrioritizedTask* task) {
+  for (const auto& victim : workers_) {
+    if (victim.get() != thief && victim->StealTask(*thief, task))
+      return true;
+  }
+  return false;
+}
+
+bool WorkStealingTaskGraphRunner::HasWorkForWorkerWithLockAcquired(
+    Worker* worker) {
+  lock_.AssertAcquired();
+
+  for (TaskCategory category : worker->categories()) {
+    if (ShouldRunTaskForCategoryWithLockAcquired(category))
+      return true;
+  }
+  for (const auto& victim : workers_) {
+    if (victim.get() != worker && victim->HasTaskForWorker(*worker))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace cc
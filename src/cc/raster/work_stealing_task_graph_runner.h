@@ -0,0 +1,110 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_RASTER_WORK_STEALING_TASK_GRAPH_RUNNER_H_
+#define CC_RASTER_WORK_STEALING_TASK_GRAPH_RUNNER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/simple_thread.h"
+#include "cc/base/cc_export.h"
+#include "cc/raster/task_category.h"
+#include "cc/raster/task_graph_runner.h"
+#include "cc/raster/task_graph_work_queue.h"
+
+namespace cc {
+
+// Runs TaskGraphs on a pool of worker threads without taking the lock of the
+// shared TaskGraphWorkQueue for every task. When many tasks are ready, each
+// worker claims a small batch of them into its own ready queue, and reports
+// the ones it completed when it comes back for more. Idle workers steal tasks
+// from the ready queues of the other workers before going to sleep.
+//
+// Claimed tasks count as running for the TaskGraphWorkQueue, so their
+// dependents only become ready once they were reported, and ScheduleTasks()
+// no longer cancels them. Categories are prioritized like in
+// content::CategorizedWorkerPool: each worker prefers its categories in the
+// order given to Start(), only one TASK_CATEGORY_NONCONCURRENT_FOREGROUND task
+// runs at a time, and TASK_CATEGORY_BACKGROUND tasks only run while no
+// foreground task is running or ready to run.
+class CC_EXPORT WorkStealingTaskGraphRunner : public TaskGraphRunner {
+ public:
+  WorkStealingTaskGraphRunner();
+  ~WorkStealingTaskGraphRunner() override;
+
+  // Overridden from TaskGraphRunner:
+  NamespaceToken GetNamespaceToken() override;
+  void ScheduleTasks(NamespaceToken token, TaskGraph* graph) override;
+  void WaitForTasksToFinishRunning(NamespaceToken token) override;
+  void CollectCompletedTasks(NamespaceToken token,
+                             Task::Vector* completed_tasks) override;
+
+  // Starts one worker thread for each entry of |thread_categories|, which
+  // lists the categories run by that thread from the most preferred one.
+  void Start(const std::string& thread_name_prefix,
+             const std::vector<std::vector<TaskCategory>>& thread_categories,
+             const base::SimpleThread::Options& thread_options);
+  void Shutdown();
+
+ private:
+  class Worker;
+  using PrioritizedTask = TaskGraphWorkQueue::PrioritizedTask;
+
+  // Runs tasks on the thread of |worker| until shutdown.
+  void RunWorker(Worker* worker);
+
+  // Reports |completed_tasks| to |work_queue_| and clears it.
+  void CompleteTasksWithLockAcquired(
+      std::vector<PrioritizedTask>* completed_tasks);
+
+  // Moves ready tasks of the most preferred category of |worker| that can run
+  // to the ready queue of |worker|. Returns false if there were none.
+  bool ClaimTasksWithLockAcquired(Worker* worker);
+
+  bool ShouldRunTaskForCategoryWithLockAcquired(uint16_t category);
+  size_t NumReadyToRunTasksForCategoryWithLockAcquired(uint16_t category);
+
+  // Moves a task that |thief| can run from the ready queue of another worker
+  // to |task|. Returns false if there was none.
+  bool StealTask(Worker* thief, PrioritizedTask* task);
+
+  bool HasWorkForWorkerWithLockAcquired(Worker* worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Lock to exclusively access all the following members that are used to
+  // implement the TaskRunner interfaces. Also held while claiming tasks into
+  // the ready queue of a worker, so it is acquired before the lock of a
+  // Worker.
+  base::Lock lock_;
+
+  // Stores the tasks to be run by this runner, sorted by priority.
+  TaskGraphWorkQueue work_queue_;
+
+  // Condition variable that is waited on by workers until new tasks are ready
+  // to run or shutdown starts.
+  base::ConditionVariable has_ready_to_run_tasks_cv_;
+
+  // Condition variable that is waited on by origin threads until a namespace
+  // has finished running all associated tasks.
+  base::ConditionVariable has_namespaces_with_finished_running_tasks_cv_;
+
+  // Set during shutdown. Tells workers to return when no more tasks are
+  // pending.
+  bool shutdown_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingTaskGraphRunner);
+};
+
+}  // namespace cc
+
+#endif  // CC_RASTER_WORK_STEALING_TASK_GRAPH_RUNNER_H_
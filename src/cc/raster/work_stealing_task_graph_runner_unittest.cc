@@ -0,0 +1,50 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/work_stealing_task_graph_runner.h"
+
+#include <vector>
+
+#include "base/threading/simple_thread.h"
+#include "cc/raster/task_category.h"
+#include "cc/test/task_graph_runner_test_template.h"
+
+namespace cc {
+namespace {
+
+class WorkStealingTaskGraphRunnerTestDelegate {
+ public:
+  WorkStealingTaskGraphRunnerTestDelegate() {}
+
+  void StartTaskGraphRunner() {
+    const size_t kNumForegroundWorkers = 3;
+    std::vector<std::vector<TaskCategory>> thread_categories(
+        kNumForegroundWorkers,
+        {TASK_CATEGORY_NONCONCURRENT_FOREGROUND, TASK_CATEGORY_FOREGROUND});
+    thread_categories.push_back({TASK_CATEGORY_BACKGROUND});
+    work_stealing_task_graph_runner_.Start(
+        "WorkStealingTaskGraphRunnerTestDelegate", thread_categories,
+        base::SimpleThread::Options());
+  }
+
+  TaskGraphRunner* GetTaskGraphRunner() {
+    return &work_stealing_task_graph_runner_;
+  }
+
+  void StopTaskGraphRunner() {}
+
+  ~WorkStealingTaskGraphRunnerTestDelegate() {
+    work_stealing_task_graph_runner_.Shutdown();
+  }
+
+ private:
+  WorkStealingTaskGraphRunner work_stealing_task_graph_runner_;
+};
+
+INSTANTIATE_TYPED_TEST_CASE_P(WorkStealingTaskGraphRunner,
+                              TaskGraphRunnerTest,
+                              WorkStealingTaskGraphRunnerTestDelegate);
+
+}  // namespace
+}  // namespace cc
@@ -25,8 +25,22 @@ namespace {
 class RasterBufferImpl : public RasterBuffer {
  public:
   RasterBufferImpl(ResourceProvider* resource_provider,
-                   const Resource* resource)
-      : lock_(resource_provider, resource->id()), resource_(resource) {}
+                   const Resource* resource,
+                   bool use_partial_raster,
+                   uint64_t resource_content_id,
+                   uint64_t previous_content_id)
+      : lock_(resource_provider,
+              resource->id(),
+              // Partial raster needs the contents of the buffer to persist
+              // from one raster to the next.
+              use_partial_raster
+                  ? gfx::BufferUsage::GPU_READ_CPU_READ_WRITE_PERSISTENT
+                  : gfx::BufferUsage::GPU_READ_CPU_READ_WRITE),
+        resource_(resource),
+        resource_has_previous_content_(use_partial_raster &&
+                                       resource_content_id &&
+                                       resource_content_id ==
+                                           previous_content_id) {}
 
   // Overridden from RasterBuffer:
   void Playback(
@@ -48,10 +62,15 @@ class RasterBufferImpl : public RasterBuffer {
     // RasterBufferProvider::PlaybackToMemory only supports unsigned strides.
     DCHECK_GE(buffer->stride(0), 0);
 
-    // TODO(danakj): Implement partial raster with raster_dirty_rect.
+    gfx::Rect playback_rect = raster_full_rect;
+    if (resource_has_previous_content_)
+      playback_rect.Intersect(raster_dirty_rect);
+    DCHECK(!playback_rect.IsEmpty())
+        << "Why are we rastering a tile that's not dirty?";
+
     RasterBufferProvider::PlaybackToMemory(
         buffer->memory(0), resource_->format(), resource_->size(),
-        buffer->stride(0), raster_source, raster_full_rect, raster_full_rect,
+        buffer->stride(0), raster_source, raster_full_rect, playback_rect,
         scale, playback_settings);
     buffer->Unmap();
   }
@@ -59,6 +78,7 @@ class RasterBufferImpl : public RasterBuffer {
  private:
   ResourceProvider::ScopedWriteLockGpuMemoryBuffer lock_;
   const Resource* resource_;
+  bool resource_has_previous_content_;
 
   DISALLOW_COPY_AND_ASSIGN(RasterBufferImpl);
 };
@@ -68,17 +88,20 @@ class RasterBufferImpl : public RasterBuffer {
 // static
 std::unique_ptr<RasterBufferProvider> ZeroCopyRasterBufferProvider::Create(
     ResourceProvider* resource_provider,
-    ResourceFormat preferred_tile_format) {
+    ResourceFormat preferred_tile_format,
+    bool use_partial_raster) {
   return base::WrapUnique<RasterBufferProvider>(
-      new ZeroCopyRasterBufferProvider(resource_provider,
-                                       preferred_tile_format));
+      new ZeroCopyRasterBufferProvider(resource_provider, preferred_tile_format,
+                                       use_partial_raster));
 }
 
 ZeroCopyRasterBufferProvider::ZeroCopyRasterBufferProvider(
     ResourceProvider* resource_provider,
-    ResourceFormat preferred_tile_format)
+    ResourceFormat preferred_tile_format,
+    bool use_partial_raster)
     : resource_provider_(resource_provider),
-      preferred_tile_format_(preferred_tile_format) {}
+      preferred_tile_format_(preferred_tile_format),
+      use_partial_raster_(use_partial_raster) {}
 
 ZeroCopyRasterBufferProvider::~ZeroCopyRasterBufferProvider() {}
 
@@ -88,7 +111,8 @@ ZeroCopyRasterBufferProvider::AcquireBufferForRaster(
     uint64_t resource_content_id,
     uint64_t previous_content_id) {
   return base::WrapUnique<RasterBuffer>(
-      new RasterBufferImpl(resource_provider_, resource));
+      new RasterBufferImpl(resource_provider_, resource, use_partial_raster_,
+                           resource_content_id, previous_content_id));
 }
 
 void ZeroCopyRasterBufferProvider::ReleaseBufferForRaster(
@@ -116,6 +140,14 @@ bool ZeroCopyRasterBufferProvider::GetResourceRequiresSwizzle(
   return ResourceFormatRequiresSwizzle(GetResourceFormat(must_support_alpha));
 }
 
+ResourceFormat ZeroCopyRasterBufferProvider::GetCompressedResourceFormat()
+    const {
+  // Playback to memory compresses ETC1 resources on the worker thread.
+  if (resource_provider_->IsResourceFormatSupported(ETC1))
+    return ETC1;
+  return GetResourceFormat(false);
+}
+
 void ZeroCopyRasterBufferProvider::Shutdown() {}
 
 }  // namespace cc
@@ -27,7 +27,8 @@ class CC_EXPORT ZeroCopyRasterBufferProvider : public RasterBufferProvider {
 
   static std::unique_ptr<RasterBufferProvider> Create(
       ResourceProvider* resource_provider,
-      ResourceFormat preferred_tile_format);
+      ResourceFormat preferred_tile_format,
+      bool use_partial_raster);
 
   // Overridden from RasterBufferProvider:
   std::unique_ptr<RasterBuffer> AcquireBufferForRaster(
@@ -38,11 +39,13 @@ class CC_EXPORT ZeroCopyRasterBufferProvider : public RasterBufferProvider {
   void OrderingBarrier() override;
   ResourceFormat GetResourceFormat(bool must_support_alpha) const override;
   bool GetResourceRequiresSwizzle(bool must_support_alpha) const override;
+  ResourceFormat GetCompressedResourceFormat() const override;
   void Shutdown() override;
 
  protected:
   ZeroCopyRasterBufferProvider(ResourceProvider* resource_provider,
-                               ResourceFormat preferred_tile_format);
+                               ResourceFormat preferred_tile_format,
+                               bool use_partial_raster);
 
  private:
   std::unique_ptr<base::trace_event::ConvertableToTraceFormat> StateAsValue()
@@ -50,6 +53,7 @@ class CC_EXPORT ZeroCopyRasterBufferProvider : public RasterBufferProvider {
 
   ResourceProvider* resource_provider_;
   ResourceFormat preferred_tile_format_;
+  const bool use_partial_raster_;
 
   DISALLOW_COPY_AND_ASSIGN(ZeroCopyRasterBufferProvider);
 };
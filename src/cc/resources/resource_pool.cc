@@ -68,6 +68,8 @@ ResourcePool::ResourcePool(ResourceProvider* resource_provider,
       in_use_memory_usage_bytes_(0),
       total_memory_usage_bytes_(0),
       total_resource_count_(0),
+      reused_resource_count_(0),
+      allocated_resource_count_(0),
       task_runner_(task_runner),
       evict_expired_resources_pending_(false),
       resource_expiration_delay_(
@@ -99,29 +101,37 @@ ResourcePool::~ResourcePool() {
   DCHECK_EQ(0u, total_resource_count_);
 }
 
+// static
+ResourcePool::ResourceKey ResourcePool::MakeResourceKey(
+    const gfx::Size& size,
+    ResourceFormat format) {
+  return std::make_tuple(format, size.width(), size.height());
+}
+
 Resource* ResourcePool::AcquireResource(const gfx::Size& size,
                                         ResourceFormat format) {
-  // Finding resources in |unused_resources_| from MRU to LRU direction, touches
-  // LRU resources only if needed, which increases possibility of expiring more
-  // LRU resources within kResourceExpirationDelayMs.
-  for (ResourceDeque::iterator it = unused_resources_.begin();
-       it != unused_resources_.end(); ++it) {
-    ScopedResource* resource = it->get();
-    DCHECK(resource_provider_->CanLockForWrite(resource->id()));
-
-    if (resource->format() != format)
-      continue;
-    if (resource->size() != size)
-      continue;
+  // Reusing the MRU resource of the bucket touches LRU resources only if
+  // needed, which increases possibility of expiring more LRU resources within
+  // kResourceExpirationDelayMs.
+  UnusedResourceMap::iterator bucket_it =
+      unused_resources_.find(MakeResourceKey(size, format));
+  if (bucket_it != unused_resources_.end()) {
+    std::unique_ptr<PoolResource> pool_resource =
+        TakeUnusedResource(bucket_it, bucket_it->second.begin());
+    DCHECK(resource_provider_->CanLockForWrite(pool_resource->id()));
+    DCHECK_EQ(format, pool_resource->format());
+    DCHECK(size == pool_resource->size());
+    ++reused_resource_count_;
 
     // Transfer resource to |in_use_resources_|.
-    in_use_resources_[resource->id()] = std::move(*it);
-    unused_resources_.erase(it);
+    Resource* resource = pool_resource.get();
+    in_use_resources_[resource->id()] = std::move(pool_resource);
     in_use_memory_usage_bytes_ += ResourceUtil::UncheckedSizeInBytes<size_t>(
         resource->size(), resource->format());
     return resource;
   }
 
+  ++allocated_resource_count_;
   std::unique_ptr<PoolResource> pool_resource =
       PoolResource::Create(resource_provider_);
 
@@ -148,23 +158,30 @@ Resource* ResourcePool::AcquireResource(const gfx::Size& size,
 Resource* ResourcePool::TryAcquireResourceWithContentId(uint64_t content_id) {
   DCHECK(content_id);
 
-  auto it = std::find_if(
-      unused_resources_.begin(), unused_resources_.end(),
-      [content_id](const std::unique_ptr<PoolResource>& pool_resource) {
-        return pool_resource->content_id() == content_id;
-      });
-  if (it == unused_resources_.end())
-    return nullptr;
+  for (UnusedResourceMap::iterator bucket_it = unused_resources_.begin();
+       bucket_it != unused_resources_.end(); ++bucket_it) {
+    ResourceDeque& bucket = bucket_it->second;
+    auto it = std::find_if(
+        bucket.begin(), bucket.end(),
+        [content_id](const std::unique_ptr<PoolResource>& pool_resource) {
+          return pool_resource->content_id() == content_id;
+        });
+    if (it == bucket.end())
+      continue;
 
-  Resource* resource = it->get();
-  DCHECK(resource_provider_->CanLockForWrite(resource->id()));
+    std::unique_ptr<PoolResource> pool_resource =
+        TakeUnusedResource(bucket_it, it);
+    DCHECK(resource_provider_->CanLockForWrite(pool_resource->id()));
+    ++reused_resource_count_;
 
-  // Transfer resource to |in_use_resources_|.
-  in_use_resources_[resource->id()] = std::move(*it);
-  unused_resources_.erase(it);
-  in_use_memory_usage_bytes_ += ResourceUtil::UncheckedSizeInBytes<size_t>(
-      resource->size(), resource->format());
-  return resource;
+    // Transfer resource to |in_use_resources_|.
+    Resource* resource = pool_resource.get();
+    in_use_resources_[resource->id()] = std::move(pool_resource);
+    in_use_memory_usage_bytes_ += ResourceUtil::UncheckedSizeInBytes<size_t>(
+        resource->size(), resource->format());
+    return resource;
+  }
+  return nullptr;
 }
 
 void ResourcePool::ReleaseResource(Resource* resource, uint64_t content_id) {
@@ -190,12 +207,14 @@ void ResourcePool::ReleaseResource(Resource* resource, uint64_t content_id) {
     CHECK(found_busy == busy_resources_.end());
 
     // Also check if the resource exists in our unused resources list.
-    auto found_unused = std::find_if(
-        unused_resources_.begin(), unused_resources_.end(),
-        [resource](const std::unique_ptr<PoolResource>& pool_resource) {
-          return pool_resource->id() == resource->id();
-        });
-    CHECK(found_unused == unused_resources_.end());
+    for (const auto& bucket : unused_resources_) {
+      auto found_unused = std::find_if(
+          bucket.second.begin(), bucket.second.end(),
+          [resource](const std::unique_ptr<PoolResource>& pool_resource) {
+            return pool_resource->id() == resource->id();
+          });
+      CHECK(found_unused == bucket.second.end());
+    }
 
     // Resource doesn't exist in any of our lists. CHECK.
     CHECK(false);
@@ -241,7 +260,8 @@ void ResourcePool::ReduceResourceUsage() {
     // can't be locked for write might also not be truly free-able.
     // We can free the resource here but it doesn't mean that the
     // memory is necessarily returned to the OS.
-    DeleteResource(PopBack(&unused_resources_));
+    UnusedResourceMap::iterator bucket_it = GetBucketForLRUUnusedResource();
+    DeleteResource(TakeUnusedResource(bucket_it, --bucket_it->second.end()));
   }
 }
 
@@ -278,9 +298,32 @@ void ResourcePool::CheckBusyResources() {
   }
 }
 
+std::unique_ptr<ResourcePool::PoolResource> ResourcePool::TakeUnusedResource(
+    UnusedResourceMap::iterator bucket_it,
+    ResourceDeque::iterator it) {
+  std::unique_ptr<PoolResource> resource = std::move(*it);
+  bucket_it->second.erase(it);
+  if (bucket_it->second.empty())
+    unused_resources_.erase(bucket_it);
+  return resource;
+}
+
+ResourcePool::UnusedResourceMap::iterator
+ResourcePool::GetBucketForLRUUnusedResource() {
+  DCHECK(!unused_resources_.empty());
+  // There are only a few distinct tile sizes, so there are few buckets.
+  return std::min_element(
+      unused_resources_.begin(), unused_resources_.end(),
+      [](const UnusedResourceMap::value_type& a,
+         const UnusedResourceMap::value_type& b) {
+        return a.second.back()->last_usage() < b.second.back()->last_usage();
+      });
+}
+
 void ResourcePool::DidFinishUsingResource(
     std::unique_ptr<PoolResource> resource) {
-  unused_resources_.push_front(std::move(resource));
+  ResourceKey key = MakeResourceKey(resource->size(), resource->format());
+  unused_resources_[key].push_front(std::move(resource));
 }
 
 void ResourcePool::ScheduleEvictExpiredResourcesIn(
@@ -315,14 +358,15 @@ void ResourcePool::EvictExpiredResources() {
 
 void ResourcePool::EvictResourcesNotUsedSince(base::TimeTicks time_limit) {
   while (!unused_resources_.empty()) {
-    // |unused_resources_| is not strictly ordered with regards to last_usage,
-    // as this may not exactly line up with the time a resource became non-busy.
-    // However, this should be roughly ordered, and will only introduce slight
-    // delays in freeing expired resources.
-    if (unused_resources_.back()->last_usage() > time_limit)
+    // The buckets of |unused_resources_| are not strictly ordered with
+    // regards to last_usage, as this may not exactly line up with the time a
+    // resource became non-busy. However, this should be roughly ordered, and
+    // will only introduce slight delays in freeing expired resources.
+    UnusedResourceMap::iterator bucket_it = GetBucketForLRUUnusedResource();
+    if (bucket_it->second.back()->last_usage() > time_limit)
       return;
 
-    DeleteResource(PopBack(&unused_resources_));
+    DeleteResource(TakeUnusedResource(bucket_it, --bucket_it->second.end()));
   }
 
   // Also free busy resources older than the delay. With a sufficiently large
@@ -337,9 +381,9 @@ void ResourcePool::EvictResourcesNotUsedSince(base::TimeTicks time_limit) {
   }
 }
 
-base::TimeTicks ResourcePool::GetUsageTimeForLRUResource() const {
+base::TimeTicks ResourcePool::GetUsageTimeForLRUResource() {
   if (!unused_resources_.empty()) {
-    return unused_resources_.back()->last_usage();
+    return GetBucketForLRUUnusedResource()->second.back()->last_usage();
   }
 
   // This is only called when we have at least one evictable resource.
@@ -349,8 +393,9 @@ base::TimeTicks ResourcePool::GetUsageTimeForLRUResource() const {
 
 bool ResourcePool::OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
                                 base::trace_event::ProcessMemoryDump* pmd) {
-  for (const auto& resource : unused_resources_) {
-    resource->OnMemoryDump(pmd, resource_provider_, true /* is_free */);
+  for (const auto& bucket : unused_resources_) {
+    for (const auto& resource : bucket.second)
+      resource->OnMemoryDump(pmd, resource_provider_, true /* is_free */);
   }
   for (const auto& resource : busy_resources_) {
     resource->OnMemoryDump(pmd, resource_provider_, false /* is_free */);
@@ -358,6 +403,19 @@ bool ResourcePool::OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
   for (const auto& entry : in_use_resources_) {
     entry.second->OnMemoryDump(pmd, resource_provider_, false /* is_free */);
   }
+
+  // Report how often resources were reused, for all the layers that share
+  // this pool.
+  std::string dump_name = base::StringPrintf(
+      "cc/resource_pool_0x%" PRIXPTR, reinterpret_cast<uintptr_t>(this));
+  base::trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump(dump_name);
+  dump->AddScalar("reused_count",
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  reused_resource_count_);
+  dump->AddScalar("allocated_count",
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  allocated_resource_count_);
   return true;
 }
 
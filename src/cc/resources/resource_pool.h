@@ -11,6 +11,7 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <tuple>
 
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
@@ -74,6 +75,12 @@ class CC_EXPORT ResourcePool : public base::trace_event::MemoryDumpProvider {
   void SetResourceExpirationDelayForTesting(base::TimeDelta delay) {
     resource_expiration_delay_ = delay;
   }
+  size_t GetReusedResourceCountForTesting() const {
+    return reused_resource_count_;
+  }
+  size_t GetAllocatedResourceCountForTesting() const {
+    return allocated_resource_count_;
+  }
 
  protected:
   ResourcePool(ResourceProvider* resource_provider,
@@ -106,6 +113,26 @@ class CC_EXPORT ResourcePool : public base::trace_event::MemoryDumpProvider {
     base::TimeTicks last_usage_;
   };
 
+  // Holds most recently used resources at the front of the queue.
+  using ResourceDeque = std::deque<std::unique_ptr<PoolResource>>;
+
+  // Unused resources are bucketed by format and size, so that they can be
+  // reused without looking at the resources of other sizes.
+  using ResourceKey = std::tuple<ResourceFormat, int, int>;
+  using UnusedResourceMap = std::map<ResourceKey, ResourceDeque>;
+  static ResourceKey MakeResourceKey(const gfx::Size& size,
+                                     ResourceFormat format);
+
+  // Moves |it| out of the bucket |bucket_it|, and removes the bucket if it is
+  // left empty.
+  std::unique_ptr<PoolResource> TakeUnusedResource(
+      UnusedResourceMap::iterator bucket_it,
+      ResourceDeque::iterator it);
+
+  // Returns the bucket holding the least recently used unused resource at its
+  // back. |unused_resources_| must not be empty.
+  UnusedResourceMap::iterator GetBucketForLRUUnusedResource();
+
   void DidFinishUsingResource(std::unique_ptr<PoolResource> resource);
   void DeleteResource(std::unique_ptr<PoolResource> resource);
 
@@ -114,7 +141,7 @@ class CC_EXPORT ResourcePool : public base::trace_event::MemoryDumpProvider {
   void EvictExpiredResources();
   void EvictResourcesNotUsedSince(base::TimeTicks time_limit);
   bool HasEvictableResources() const;
-  base::TimeTicks GetUsageTimeForLRUResource() const;
+  base::TimeTicks GetUsageTimeForLRUResource();
 
 #if defined(OS_WEBOS)
   void OnMemoryPressure(
@@ -129,9 +156,12 @@ class CC_EXPORT ResourcePool : public base::trace_event::MemoryDumpProvider {
   size_t total_memory_usage_bytes_;
   size_t total_resource_count_;
 
-  // Holds most recently used resources at the front of the queue.
-  using ResourceDeque = std::deque<std::unique_ptr<PoolResource>>;
-  ResourceDeque unused_resources_;
+  // Number of calls to AcquireResource() that reused an unused resource, or
+  // had to allocate a new one.
+  size_t reused_resource_count_;
+  size_t allocated_resource_count_;
+
+  UnusedResourceMap unused_resources_;
   ResourceDeque busy_resources_;
 
   std::map<ResourceId, std::unique_ptr<PoolResource>> in_use_resources_;
@@ -220,5 +220,39 @@ TEST_F(ResourcePoolTest, UnusedResourcesEventuallyFreed) {
   EXPECT_EQ(0u, resource_pool_->GetTotalMemoryUsageForTesting());
 }
 
+TEST_F(ResourcePoolTest, ReuseAcrossSizes) {
+  // Limits high enough to not be hit by this test.
+  size_t bytes_limit = 10 * 1024 * 1024;
+  size_t count_limit = 100;
+  resource_pool_->SetResourceUsageLimits(bytes_limit, count_limit);
+
+  gfx::Size small_size(50, 50);
+  gfx::Size large_size(100, 100);
+  ResourceFormat format = RGBA_8888;
+
+  // Release the small resource first, so it is the least recently used one.
+  Resource* small_resource =
+      resource_pool_->AcquireResource(small_size, format);
+  Resource* large_resource =
+      resource_pool_->AcquireResource(large_size, format);
+  resource_pool_->ReleaseResource(small_resource, 0u);
+  resource_pool_->ReleaseResource(large_resource, 0u);
+  resource_pool_->CheckBusyResources();
+  EXPECT_EQ(2u, resource_provider_->num_resources());
+  EXPECT_EQ(0u, resource_pool_->GetReusedResourceCountForTesting());
+  EXPECT_EQ(2u, resource_pool_->GetAllocatedResourceCountForTesting());
+
+  // Eviction picks the least recently used resource of all sizes.
+  resource_pool_->SetResourceUsageLimits(bytes_limit, 1u);
+  EXPECT_EQ(1u, resource_provider_->num_resources());
+
+  Resource* resource = resource_pool_->AcquireResource(large_size, format);
+  EXPECT_EQ(large_size, resource->size());
+  EXPECT_EQ(1u, resource_provider_->num_resources());
+  EXPECT_EQ(1u, resource_pool_->GetReusedResourceCountForTesting());
+  EXPECT_EQ(2u, resource_pool_->GetAllocatedResourceCountForTesting());
+  resource_pool_->ReleaseResource(resource, 0u);
+}
+
 }  // namespace
 }  // namespace cc
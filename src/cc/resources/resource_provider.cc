@@ -1232,7 +1232,18 @@ ResourceProvider::ScopedWriteLockSoftware::~ScopedWriteLockSoftware() {
 ResourceProvider::ScopedWriteLockGpuMemoryBuffer::
     ScopedWriteLockGpuMemoryBuffer(ResourceProvider* resource_provider,
                                    ResourceId resource_id)
-    : resource_provider_(resource_provider), resource_id_(resource_id) {
+    : ScopedWriteLockGpuMemoryBuffer(
+          resource_provider,
+          resource_id,
+          gfx::BufferUsage::GPU_READ_CPU_READ_WRITE) {}
+
+ResourceProvider::ScopedWriteLockGpuMemoryBuffer::
+    ScopedWriteLockGpuMemoryBuffer(ResourceProvider* resource_provider,
+                                   ResourceId resource_id,
+                                   gfx::BufferUsage usage)
+    : resource_provider_(resource_provider),
+      resource_id_(resource_id),
+      usage_(usage) {
   Resource* resource = resource_provider->LockForWrite(resource_id);
   DCHECK(IsGpuResourceType(resource->type));
   format_ = resource->format;
@@ -1268,8 +1279,7 @@ ResourceProvider::ScopedWriteLockGpuMemoryBuffer::GetGpuMemoryBuffer() {
   if (!gpu_memory_buffer_) {
     gpu_memory_buffer_ =
         resource_provider_->gpu_memory_buffer_manager_->AllocateGpuMemoryBuffer(
-            size_, BufferFormat(format_),
-            gfx::BufferUsage::GPU_READ_CPU_READ_WRITE, gpu::kNullSurfaceHandle);
+            size_, BufferFormat(format_), usage_, gpu::kNullSurfaceHandle);
   }
   return gpu_memory_buffer_.get();
 }
@@ -389,6 +389,12 @@ class CC_EXPORT ResourceProvider
    public:
     ScopedWriteLockGpuMemoryBuffer(ResourceProvider* resource_provider,
                                    ResourceId resource_id);
+    // |usage| is used if a GpuMemoryBuffer needs to be allocated for the
+    // resource. Use GPU_READ_CPU_READ_WRITE_PERSISTENT to keep the contents of
+    // the buffer across locks.
+    ScopedWriteLockGpuMemoryBuffer(ResourceProvider* resource_provider,
+                                   ResourceId resource_id,
+                                   gfx::BufferUsage usage);
     ~ScopedWriteLockGpuMemoryBuffer();
 
     gfx::GpuMemoryBuffer* GetGpuMemoryBuffer();
@@ -398,6 +404,7 @@ class CC_EXPORT ResourceProvider
     ResourceId resource_id_;
     ResourceFormat format_;
     gfx::Size size_;
+    gfx::BufferUsage usage_;
     std::unique_ptr<gfx::GpuMemoryBuffer> gpu_memory_buffer_;
     base::ThreadChecker thread_checker_;
 
@@ -37,6 +37,8 @@ class CompositorTimingHistory::UMAReporter {
   virtual void AddActivateDuration(base::TimeDelta duration) = 0;
   virtual void AddDrawDuration(base::TimeDelta duration) = 0;
   virtual void AddSwapToAckLatency(base::TimeDelta duration) = 0;
+  virtual void AddGpuDrawDuration(base::TimeDelta duration) = 0;
+  virtual void AddGpuRasterDuration(base::TimeDelta duration) = 0;
 
   // Synchronization measurements
   virtual void AddMainAndImplFrameTimeDelta(base::TimeDelta delta) = 0;
@@ -57,6 +59,8 @@ const double kCommitToReadyToActivateEstimationPercentile = 90.0;
 const double kPrepareTilesEstimationPercentile = 90.0;
 const double kActivateEstimationPercentile = 90.0;
 const double kDrawEstimationPercentile = 90.0;
+const double kGpuDrawEstimationPercentile = 90.0;
+const double kGpuRasterEstimationPercentile = 90.0;
 
 const int kUmaDurationMinMicros = 1;
 const int64_t kUmaDurationMaxMicros = base::Time::kMicrosecondsPerSecond / 5;
@@ -191,6 +195,16 @@ class RendererUMAReporter : public CompositorTimingHistory::UMAReporter {
                                         duration);
   }
 
+  void AddGpuDrawDuration(base::TimeDelta duration) override {
+    UMA_HISTOGRAM_CUSTOM_TIMES_DURATION("Scheduling.Renderer.GpuDrawDuration",
+                                        duration);
+  }
+
+  void AddGpuRasterDuration(base::TimeDelta duration) override {
+    UMA_HISTOGRAM_CUSTOM_TIMES_DURATION("Scheduling.Renderer.GpuRasterDuration",
+                                        duration);
+  }
+
   void AddMainAndImplFrameTimeDelta(base::TimeDelta delta) override {
     UMA_HISTOGRAM_CUSTOM_TIMES_VSYNC_ALIGNED(
         "Scheduling.Renderer.MainAndImplFrameTimeDelta", delta);
@@ -264,6 +278,16 @@ class BrowserUMAReporter : public CompositorTimingHistory::UMAReporter {
                                         duration);
   }
 
+  void AddGpuDrawDuration(base::TimeDelta duration) override {
+    UMA_HISTOGRAM_CUSTOM_TIMES_DURATION("Scheduling.Browser.GpuDrawDuration",
+                                        duration);
+  }
+
+  void AddGpuRasterDuration(base::TimeDelta duration) override {
+    UMA_HISTOGRAM_CUSTOM_TIMES_DURATION("Scheduling.Browser.GpuRasterDuration",
+                                        duration);
+  }
+
   void AddMainAndImplFrameTimeDelta(base::TimeDelta delta) override {
     UMA_HISTOGRAM_CUSTOM_TIMES_VSYNC_ALIGNED(
         "Scheduling.Browser.MainAndImplFrameTimeDelta", delta);
@@ -289,6 +313,8 @@ class NullUMAReporter : public CompositorTimingHistory::UMAReporter {
   void AddActivateDuration(base::TimeDelta duration) override {}
   void AddDrawDuration(base::TimeDelta duration) override {}
   void AddSwapToAckLatency(base::TimeDelta duration) override {}
+  void AddGpuDrawDuration(base::TimeDelta duration) override {}
+  void AddGpuRasterDuration(base::TimeDelta duration) override {}
   void AddMainAndImplFrameTimeDelta(base::TimeDelta delta) override {}
 };
 
@@ -314,6 +340,8 @@ CompositorTimingHistory::CompositorTimingHistory(
       prepare_tiles_duration_history_(kDurationHistorySize),
       activate_duration_history_(kDurationHistorySize),
       draw_duration_history_(kDurationHistorySize),
+      gpu_draw_duration_history_(kDurationHistorySize),
+      gpu_raster_duration_history_(kDurationHistorySize),
       begin_main_frame_on_critical_path_(false),
       uma_reporter_(CreateUMAReporter(uma_category)),
       rendering_stats_instrumentation_(rendering_stats_instrumentation) {}
@@ -357,6 +385,10 @@ void CompositorTimingHistory::AsValueInto(
                    ActivateDurationEstimate().InMillisecondsF());
   state->SetDouble("draw_estimate_ms",
                    DrawDurationEstimate().InMillisecondsF());
+  state->SetDouble("gpu_draw_estimate_ms",
+                   GpuDrawDurationEstimate().InMillisecondsF());
+  state->SetDouble("gpu_raster_estimate_ms",
+                   GpuRasterDurationEstimate().InMillisecondsF());
 }
 
 base::TimeTicks CompositorTimingHistory::Now() const {
@@ -439,6 +471,15 @@ base::TimeDelta CompositorTimingHistory::DrawDurationEstimate() const {
   return draw_duration_history_.Percentile(kDrawEstimationPercentile);
 }
 
+base::TimeDelta CompositorTimingHistory::GpuDrawDurationEstimate() const {
+  return gpu_draw_duration_history_.Percentile(kGpuDrawEstimationPercentile);
+}
+
+base::TimeDelta CompositorTimingHistory::GpuRasterDurationEstimate() const {
+  return gpu_raster_duration_history_.Percentile(
+      kGpuRasterEstimationPercentile);
+}
+
 void CompositorTimingHistory::DidCreateAndInitializeOutputSurface() {
   // After we get a new output surface, we won't get a spurious
   // swap ack from the old output surface.
@@ -706,4 +747,19 @@ void CompositorTimingHistory::DidSwapBuffersComplete() {
   swap_start_time_ = base::TimeTicks();
 }
 
+void CompositorTimingHistory::DidMeasureGpuTimes(
+    const std::vector<base::TimeDelta>& draw_durations,
+    const std::vector<base::TimeDelta>& raster_durations) {
+  for (base::TimeDelta duration : draw_durations) {
+    uma_reporter_->AddGpuDrawDuration(duration);
+    if (enabled_)
+      gpu_draw_duration_history_.InsertSample(duration);
+  }
+  for (base::TimeDelta duration : raster_durations) {
+    uma_reporter_->AddGpuRasterDuration(duration);
+    if (enabled_)
+      gpu_raster_duration_history_.InsertSample(duration);
+  }
+}
+
 }  // namespace cc
@@ -6,6 +6,7 @@
 #define CC_SCHEDULER_COMPOSITOR_TIMING_HISTORY_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
 #include "cc/base/rolling_time_delta_history.h"
@@ -47,6 +48,10 @@ class CC_EXPORT CompositorTimingHistory {
   virtual base::TimeDelta PrepareTilesDurationEstimate() const;
   virtual base::TimeDelta ActivateDurationEstimate() const;
   virtual base::TimeDelta DrawDurationEstimate() const;
+  // How long the GPU takes to execute the draw of a frame, and the raster of
+  // one task's tiles, when the compositor can time it.
+  virtual base::TimeDelta GpuDrawDurationEstimate() const;
+  virtual base::TimeDelta GpuRasterDurationEstimate() const;
 
   // State that affects when events should be expected/recorded/reported.
   void SetRecordingEnabled(bool enabled);
@@ -74,6 +79,10 @@ class CC_EXPORT CompositorTimingHistory {
   void DidSwapBuffers();
   void DidSwapBuffersComplete();
 
+  // GPU timings arrive some frames after the work they measure was issued.
+  void DidMeasureGpuTimes(const std::vector<base::TimeDelta>& draw_durations,
+                          const std::vector<base::TimeDelta>& raster_durations);
+
  protected:
   void DidBeginMainFrame();
 
@@ -104,6 +113,8 @@ class CC_EXPORT CompositorTimingHistory {
   RollingTimeDeltaHistory prepare_tiles_duration_history_;
   RollingTimeDeltaHistory activate_duration_history_;
   RollingTimeDeltaHistory draw_duration_history_;
+  RollingTimeDeltaHistory gpu_draw_duration_history_;
+  RollingTimeDeltaHistory gpu_raster_duration_history_;
 
   bool begin_main_frame_on_critical_path_;
   base::TimeTicks begin_main_frame_frame_time_;
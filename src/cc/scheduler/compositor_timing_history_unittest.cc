@@ -268,5 +268,32 @@ TEST_F(CompositorTimingHistoryTest, BeginMainFrames_NewCriticalSlower) {
             timing_history_.BeginMainFrameStartToCommitDurationEstimate());
 }
 
+TEST_F(CompositorTimingHistoryTest, GpuTimes) {
+  base::TimeDelta fast = base::TimeDelta::FromMilliseconds(2);
+  base::TimeDelta slow = base::TimeDelta::FromMilliseconds(12);
+
+  EXPECT_EQ(base::TimeDelta(), timing_history_.GpuDrawDurationEstimate());
+  EXPECT_EQ(base::TimeDelta(), timing_history_.GpuRasterDurationEstimate());
+
+  // Frames that take the GPU a while to draw, along with quick raster tasks.
+  for (int i = 0; i < 10; i++) {
+    timing_history_.DidMeasureGpuTimes(
+        std::vector<base::TimeDelta>(1, slow),
+        std::vector<base::TimeDelta>(3, fast));
+  }
+  EXPECT_EQ(slow, timing_history_.GpuDrawDurationEstimate());
+  EXPECT_EQ(fast, timing_history_.GpuRasterDurationEstimate());
+
+  // Nothing is recorded while recording is disabled.
+  timing_history_.SetRecordingEnabled(false);
+  for (int i = 0; i < 100; i++) {
+    timing_history_.DidMeasureGpuTimes(
+        std::vector<base::TimeDelta>(1, fast),
+        std::vector<base::TimeDelta>(1, slow));
+  }
+  EXPECT_EQ(slow, timing_history_.GpuDrawDurationEstimate());
+  EXPECT_EQ(fast, timing_history_.GpuRasterDurationEstimate());
+}
+
 }  // namespace
 }  // namespace cc
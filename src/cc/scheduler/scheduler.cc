@@ -200,6 +200,13 @@ void Scheduler::DidPrepareTiles() {
   state_machine_.DidPrepareTiles();
 }
 
+void Scheduler::DidMeasureGpuTimes(
+    const std::vector<base::TimeDelta>& draw_durations,
+    const std::vector<base::TimeDelta>& raster_durations) {
+  compositor_timing_history_->DidMeasureGpuTimes(draw_durations,
+                                                 raster_durations);
+}
+
 void Scheduler::DidLoseOutputSurface() {
   TRACE_EVENT0("cc", "Scheduler::DidLoseOutputSurface");
   begin_retro_frame_args_.clear();
@@ -443,6 +450,16 @@ void Scheduler::BeginImplFrameWithDeadline(const BeginFrameArgs& args) {
   state_machine_.SetCriticalBeginMainFrameToActivateIsFast(
       bmf_to_activate_estimate_critical < args.interval);
 
+  // A commit that waits for the active tree to be drawn starts at the deadline
+  // at the latest, and should still activate before the next deadline.
+  if (settings_.use_predictive_begin_frame_deadline) {
+    base::TimeDelta commit_to_activate_estimate =
+        compositor_timing_history_->CommitToReadyToActivateDurationEstimate() +
+        compositor_timing_history_->ActivateDurationEstimate();
+    state_machine_.SetDrawCanWaitForDeadline(commit_to_activate_estimate <
+                                             args.interval);
+  }
+
   // Update the BeginMainFrame args now that we know whether the main
   // thread will be on the critical path or not.
   begin_main_frame_args_ = adjusted_args;
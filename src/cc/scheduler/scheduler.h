@@ -8,6 +8,7 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/cancelable_callback.h"
 #include "base/macros.h"
@@ -102,6 +103,8 @@ class CC_EXPORT Scheduler : public BeginFrameObserverBase {
 
   void WillPrepareTiles();
   void DidPrepareTiles();
+  void DidMeasureGpuTimes(const std::vector<base::TimeDelta>& draw_durations,
+                          const std::vector<base::TimeDelta>& raster_durations);
   void DidLoseOutputSurface();
   void DidCreateAndInitializeOutputSurface();
 
@@ -12,6 +12,7 @@ SchedulerSettings::SchedulerSettings()
     : use_external_begin_frame_source(false),
       main_frame_while_swap_throttled_enabled(false),
       main_frame_before_activation_enabled(false),
+      use_predictive_begin_frame_deadline(false),
       commit_to_active_tree(false),
       timeout_and_draw_when_animation_checkerboards(true),
       using_synchronous_renderer_compositor(false),
@@ -34,6 +35,8 @@ SchedulerSettings::AsValue() const {
                     main_frame_while_swap_throttled_enabled);
   state->SetBoolean("main_frame_before_activation_enabled",
                     main_frame_before_activation_enabled);
+  state->SetBoolean("use_predictive_begin_frame_deadline",
+                    use_predictive_begin_frame_deadline);
   state->SetBoolean("commit_to_active_tree", commit_to_active_tree);
   state->SetBoolean("timeout_and_draw_when_animation_checkerboards",
                     timeout_and_draw_when_animation_checkerboards);
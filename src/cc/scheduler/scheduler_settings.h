@@ -29,6 +29,7 @@ class CC_EXPORT SchedulerSettings {
   bool use_external_begin_frame_source;
   bool main_frame_while_swap_throttled_enabled;
   bool main_frame_before_activation_enabled;
+  bool use_predictive_begin_frame_deadline;
   bool commit_to_active_tree;
   bool timeout_and_draw_when_animation_checkerboards;
   bool using_synchronous_renderer_compositor;
@@ -53,6 +53,7 @@ SchedulerStateMachine::SchedulerStateMachine(const SchedulerSettings& settings)
       scroll_handler_state_(
           ScrollHandlerState::SCROLL_DOES_NOT_AFFECT_SCROLL_HANDLER),
       critical_begin_main_frame_to_activate_is_fast_(true),
+      draw_can_wait_for_deadline_(false),
       main_thread_missed_last_deadline_(false),
       skip_next_begin_main_frame_to_reduce_latency_(false),
       defer_commits_(false),
@@ -250,6 +251,7 @@ void SchedulerStateMachine::AsValueInto(
                    ScrollHandlerStateToString(scroll_handler_state_));
   state->SetBoolean("critical_begin_main_frame_to_activate_is_fast_",
                     critical_begin_main_frame_to_activate_is_fast_);
+  state->SetBoolean("draw_can_wait_for_deadline", draw_can_wait_for_deadline_);
   state->SetBoolean("main_thread_missed_last_deadline",
                     main_thread_missed_last_deadline_);
   state->SetBoolean("skip_next_begin_main_frame_to_reduce_latency",
@@ -906,6 +908,12 @@ bool SchedulerStateMachine::ShouldTriggerBeginImplFrameDeadlineImmediately()
   if (SwapThrottled())
     return false;
 
+  // Wait for the regular deadline, which is as late as the draw estimate
+  // allows, so that input arriving until then makes it into this frame. A
+  // pending tree can't activate before the draw, so don't make it wait.
+  if (draw_can_wait_for_deadline_ && needs_redraw_ && !has_pending_tree_)
+    return false;
+
   if (active_tree_needs_first_draw_)
     return true;
 
@@ -1003,6 +1011,10 @@ void SchedulerStateMachine::SetCriticalBeginMainFrameToActivateIsFast(
   critical_begin_main_frame_to_activate_is_fast_ = is_fast;
 }
 
+void SchedulerStateMachine::SetDrawCanWaitForDeadline(bool can_wait) {
+  draw_can_wait_for_deadline_ = can_wait;
+}
+
 bool SchedulerStateMachine::ImplLatencyTakesPriority() const {
   // Attempt to synchronize with the main thread if it has a scroll listener
   // and is fast.
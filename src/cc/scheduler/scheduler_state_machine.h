@@ -208,6 +208,10 @@ class CC_EXPORT SchedulerStateMachine {
   // Indicates if the main thread will likely respond within 1 vsync.
   void SetCriticalBeginMainFrameToActivateIsFast(bool is_fast);
 
+  // Indicates if a draw that is ready can wait for the deadline without
+  // delaying the next commit past the next frame.
+  void SetDrawCanWaitForDeadline(bool can_wait);
+
   // A function of SetTreePrioritiesAndScrollState and
   // SetCriticalBeginMainFrameToActivateIsFast.
   bool ImplLatencyTakesPriority() const;
@@ -339,6 +343,7 @@ class CC_EXPORT SchedulerStateMachine {
   TreePriority tree_priority_;
   ScrollHandlerState scroll_handler_state_;
   bool critical_begin_main_frame_to_activate_is_fast_;
+  bool draw_can_wait_for_deadline_;
   bool main_thread_missed_last_deadline_;
   bool skip_next_begin_main_frame_to_reduce_latency_;
   bool defer_commits_;
@@ -1187,6 +1187,44 @@ TEST_F(SchedulerTest, TriggerBeginFrameDeadlineEarly) {
   EXPECT_EQ(base::TimeTicks(), client->posted_begin_impl_frame_deadline());
 }
 
+TEST_F(SchedulerTest, PredictiveDeadlineWaitsToDraw) {
+  scheduler_settings_.use_external_begin_frame_source = true;
+  scheduler_settings_.use_predictive_begin_frame_deadline = true;
+  SetUpScheduler(true);
+  fake_compositor_timing_history_->SetAllEstimatesTo(kFastDuration);
+
+  scheduler_->SetNeedsRedraw();
+  client_->Reset();
+  EXPECT_SCOPED(AdvanceFrame());
+  EXPECT_SINGLE_ACTION("WillBeginImplFrame", client_);
+
+  // The draw waits for the deadline since a commit could still activate in
+  // time for the next frame.
+  EXPECT_LT(base::TimeDelta(), task_runner().DelayToNextTaskTime());
+  EXPECT_GT(BeginFrameArgs::DefaultInterval(),
+            task_runner().DelayToNextTaskTime());
+
+  client_->Reset();
+  task_runner().RunPendingTasks();  // Run posted deadline.
+  EXPECT_ACTION("ScheduledActionDrawAndSwapIfPossible", client_, 0, 1);
+}
+
+TEST_F(SchedulerTest, PredictiveDeadlineDrawsEarlyWhenActivationIsSlow) {
+  scheduler_settings_.use_external_begin_frame_source = true;
+  scheduler_settings_.use_predictive_begin_frame_deadline = true;
+  SetUpScheduler(true);
+  fake_compositor_timing_history_->SetAllEstimatesTo(kFastDuration);
+  fake_compositor_timing_history_->SetActivateDurationEstimate(kSlowDuration);
+
+  scheduler_->SetNeedsRedraw();
+  client_->Reset();
+  EXPECT_SCOPED(AdvanceFrame());
+  EXPECT_SINGLE_ACTION("WillBeginImplFrame", client_);
+
+  // Waiting would delay a commit past the next frame, so draw right away.
+  EXPECT_EQ(base::TimeDelta(), task_runner().DelayToNextTaskTime());
+}
+
 TEST_F(SchedulerTest, WaitForReadyToDrawDoNotPostDeadline) {
   SchedulerClientNeedsPrepareTilesInDraw* client =
       new SchedulerClientNeedsPrepareTilesInDraw;
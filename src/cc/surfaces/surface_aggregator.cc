@@ -24,6 +24,7 @@
 #include "cc/quads/solid_color_draw_quad.h"
 #include "cc/quads/surface_draw_quad.h"
 #include "cc/quads/texture_draw_quad.h"
+#include "cc/resources/resource_provider.h"
 #include "cc/surfaces/surface.h"
 #include "cc/surfaces/surface_factory.h"
 #include "cc/surfaces/surface_manager.h"
@@ -116,6 +117,34 @@ class SurfaceAggregator::RenderPassIdAllocator {
   DISALLOW_COPY_AND_ASSIGN(RenderPassIdAllocator);
 };
 
+struct SurfaceAggregator::PrewalkData {
+  // A quad of the frame that embeds other content, either a SurfaceDrawQuad
+  // or a RenderPassDrawQuad.
+  struct EmbeddingQuad {
+    DrawQuad::Material material;
+    // Only set for SURFACE_CONTENT quads.
+    SurfaceId surface_id;
+    gfx::Transform target_to_surface_transform;
+    // Only set for RENDER_PASS quads. The pass id is remapped.
+    RenderPassId render_pass_id;
+    bool filters_move_pixels;
+    bool background_filters_move_pixels;
+  };
+
+  struct Pass {
+    // Remapped id of the pass.
+    RenderPassId id;
+    std::vector<EmbeddingQuad> quads;
+  };
+
+  // The frame the data was gathered from.
+  const DelegatedFrameData* frame_data;
+  int frame_index;
+  // The passes of the frame, from the root pass to the first one.
+  std::vector<Pass> passes;
+  ResourceProvider::ResourceIdSet referenced_resources;
+};
+
 static void UnrefHelper(base::WeakPtr<SurfaceFactory> surface_factory,
                         const ReturnedResourceArray& resources,
                         BlockingTaskRunner* main_thread_task_runner) {
@@ -530,6 +559,7 @@ void SurfaceAggregator::ProcessAddedAndRemovedSurfaces() {
         provider_->DestroyChild(it->second);
         surface_id_to_resource_child_id_.erase(it);
       }
+      prewalk_data_map_.erase(surface.first);
 
       // Notify client of removed surface.
       Surface* surface_ptr = manager_->GetSurfaceForId(surface.first);
@@ -540,6 +570,54 @@ void SurfaceAggregator::ProcessAddedAndRemovedSurfaces() {
   }
 }
 
+std::unique_ptr<SurfaceAggregator::PrewalkData>
+SurfaceAggregator::CreatePrewalkData(SurfaceId surface_id,
+                                     int frame_index,
+                                     const DelegatedFrameData* frame_data) {
+  std::unique_ptr<PrewalkData> data(new PrewalkData);
+  data->frame_data = frame_data;
+  data->frame_index = frame_index;
+  data->passes.reserve(frame_data->render_pass_list.size());
+  data->referenced_resources.reserve(frame_data->resource_list.size());
+
+  for (const auto& render_pass : base::Reversed(frame_data->render_pass_list)) {
+    data->passes.push_back(PrewalkData::Pass());
+    PrewalkData::Pass& pass = data->passes.back();
+    pass.id = RemapPassId(render_pass->id, surface_id);
+    for (const auto& quad : render_pass->quad_list) {
+      if (quad->material == DrawQuad::SURFACE_CONTENT) {
+        const SurfaceDrawQuad* surface_quad =
+            SurfaceDrawQuad::MaterialCast(quad);
+        PrewalkData::EmbeddingQuad embedding_quad;
+        embedding_quad.material = quad->material;
+        embedding_quad.surface_id = surface_quad->surface_id;
+        embedding_quad.target_to_surface_transform = gfx::Transform(
+            render_pass->transform_to_root_target,
+            surface_quad->shared_quad_state->quad_to_target_transform);
+        embedding_quad.filters_move_pixels = false;
+        embedding_quad.background_filters_move_pixels = false;
+        pass.quads.push_back(embedding_quad);
+      } else if (quad->material == DrawQuad::RENDER_PASS) {
+        const RenderPassDrawQuad* render_pass_quad =
+            RenderPassDrawQuad::MaterialCast(quad);
+        PrewalkData::EmbeddingQuad embedding_quad;
+        embedding_quad.material = quad->material;
+        embedding_quad.render_pass_id =
+            RemapPassId(render_pass_quad->render_pass_id, surface_id);
+        embedding_quad.filters_move_pixels =
+            render_pass_quad->filters.HasFilterThatMovesPixels();
+        embedding_quad.background_filters_move_pixels =
+            render_pass_quad->background_filters.HasFilterThatMovesPixels();
+        pass.quads.push_back(embedding_quad);
+      }
+
+      for (ResourceId resource_id : quad->resources)
+        data->referenced_resources.insert(resource_id);
+    }
+  }
+  return data;
+}
+
 // Walk the Surface tree from surface_id. Validate the resources of the current
 // surface and its descendants, check if there are any copy requests, and
 // return the combined damage rect.
@@ -575,11 +653,6 @@ gfx::Rect SurfaceAggregator::PrewalkTree(SurfaceId surface_id,
   }
   CHECK(debug_weak_this.get());
 
-  ResourceProvider::ResourceIdSet referenced_resources;
-  size_t reserve_size = frame_data->resource_list.size();
-  referenced_resources.reserve(reserve_size);
-
-  bool invalid_frame = false;
   ResourceProvider::ResourceIdMap empty_map;
   const ResourceProvider::ResourceIdMap& child_to_parent_map =
       provider_ ? provider_->GetChildToParentMap(child_id) : empty_map;
@@ -602,42 +675,38 @@ gfx::Rect SurfaceAggregator::PrewalkTree(SurfaceId surface_id,
   };
   std::vector<SurfaceInfo> child_surfaces;
 
-  for (const auto& render_pass : base::Reversed(frame_data->render_pass_list)) {
-    RenderPassId remapped_pass_id = RemapPassId(render_pass->id, surface_id);
-    bool in_moved_pixel_pass = !!moved_pixel_passes_.count(remapped_pass_id);
-    for (const auto& quad : render_pass->quad_list) {
-      if (quad->material == DrawQuad::SURFACE_CONTENT) {
-        const SurfaceDrawQuad* surface_quad =
-            SurfaceDrawQuad::MaterialCast(quad);
-        gfx::Transform target_to_surface_transform(
-            render_pass->transform_to_root_target,
-            surface_quad->shared_quad_state->quad_to_target_transform);
+  std::unique_ptr<PrewalkData>& prewalk_data = prewalk_data_map_[surface_id];
+  if (!prewalk_data || prewalk_data->frame_data != frame_data ||
+      prewalk_data->frame_index != surface->frame_index()) {
+    prewalk_data =
+        CreatePrewalkData(surface_id, surface->frame_index(), frame_data);
+  }
+
+  for (const auto& pass : prewalk_data->passes) {
+    bool in_moved_pixel_pass = !!moved_pixel_passes_.count(pass.id);
+    for (const auto& quad : pass.quads) {
+      if (quad.material == DrawQuad::SURFACE_CONTENT) {
         child_surfaces.push_back(
-            SurfaceInfo{surface_quad->surface_id, in_moved_pixel_pass,
-                        remapped_pass_id, target_to_surface_transform});
-      } else if (quad->material == DrawQuad::RENDER_PASS) {
-        const RenderPassDrawQuad* render_pass_quad =
-            RenderPassDrawQuad::MaterialCast(quad);
-        if (in_moved_pixel_pass ||
-            render_pass_quad->filters.HasFilterThatMovesPixels()) {
-          moved_pixel_passes_.insert(
-              RemapPassId(render_pass_quad->render_pass_id, surface_id));
-        }
-        if (render_pass_quad->background_filters.HasFilterThatMovesPixels()) {
+            SurfaceInfo{quad.surface_id, in_moved_pixel_pass, pass.id,
+                        quad.target_to_surface_transform});
+      } else {
+        if (in_moved_pixel_pass || quad.filters_move_pixels)
+          moved_pixel_passes_.insert(quad.render_pass_id);
+        if (quad.background_filters_move_pixels)
           in_moved_pixel_pass = true;
-        }
-        render_pass_dependencies_[remapped_pass_id].insert(
-            RemapPassId(render_pass_quad->render_pass_id, surface_id));
+        render_pass_dependencies_[pass.id].insert(quad.render_pass_id);
       }
+    }
+  }
 
-      if (!provider_)
-        continue;
-      for (ResourceId resource_id : quad->resources) {
-        if (!child_to_parent_map.count(resource_id)) {
-          invalid_frame = true;
-          break;
-        }
-        referenced_resources.insert(resource_id);
+  const ResourceProvider::ResourceIdSet& referenced_resources =
+      prewalk_data->referenced_resources;
+  bool invalid_frame = false;
+  if (provider_) {
+    for (ResourceId resource_id : referenced_resources) {
+      if (!child_to_parent_map.count(resource_id)) {
+        invalid_frame = true;
+        break;
       }
     }
   }
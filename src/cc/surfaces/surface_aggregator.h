@@ -85,6 +85,11 @@ class CC_SURFACES_EXPORT SurfaceAggregator {
       const ClipData& clip_rect,
       RenderPass* dest_pass,
       SurfaceId surface_id);
+  struct PrewalkData;
+  std::unique_ptr<PrewalkData> CreatePrewalkData(
+      SurfaceId surface_id,
+      int frame_index,
+      const DelegatedFrameData* frame_data);
   gfx::Rect PrewalkTree(SurfaceId surface_id,
                         bool in_moved_pixel_pass,
                         RenderPassId parent_pass,
@@ -122,6 +127,14 @@ class CC_SURFACES_EXPORT SurfaceAggregator {
       std::unordered_map<SurfaceId, int, SurfaceIdHash>;
   SurfaceToResourceChildIdMap surface_id_to_resource_child_id_;
 
+  // For each Surface used in the last aggregation, the data PrewalkTree found
+  // in the quads of its frame. It is reused until the Surface draws another
+  // frame, so that the quads of unchanged Surfaces are not walked again.
+  using PrewalkDataMap = std::unordered_map<SurfaceId,
+                                            std::unique_ptr<PrewalkData>,
+                                            SurfaceIdHash>;
+  PrewalkDataMap prewalk_data_map_;
+
   // The following state is only valid for the duration of one Aggregate call
   // and is only stored on the class to avoid having to pass through every
   // function call.
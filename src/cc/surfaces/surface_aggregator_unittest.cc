@@ -284,6 +284,74 @@ TEST_F(SurfaceAggregatorValidSurfaceTest, SimpleSurfaceReference) {
   factory_.Destroy(embedded_surface_id);
 }
 
+// Tests that aggregating an unchanged surface again reuses what was found in
+// its quads, while a new frame of one of its children is walked again.
+TEST_F(SurfaceAggregatorValidSurfaceTest, ChildSurfaceChangesEmbedding) {
+  SurfaceId child_surface_id = allocator_.GenerateId();
+  factory_.Create(child_surface_id);
+  SurfaceId first_surface_id = allocator_.GenerateId();
+  factory_.Create(first_surface_id);
+  SurfaceId second_surface_id = allocator_.GenerateId();
+  factory_.Create(second_surface_id);
+
+  test::Quad first_quads[] = {test::Quad::SolidColorQuad(SK_ColorGREEN)};
+  test::Pass first_passes[] = {test::Pass(first_quads, arraysize(first_quads))};
+  SubmitCompositorFrame(first_passes, arraysize(first_passes),
+                        first_surface_id);
+
+  test::Quad second_quads[] = {test::Quad::SolidColorQuad(SK_ColorBLUE)};
+  test::Pass second_passes[] = {
+      test::Pass(second_quads, arraysize(second_quads))};
+  SubmitCompositorFrame(second_passes, arraysize(second_passes),
+                        second_surface_id);
+
+  test::Quad child_quads[] = {test::Quad::SurfaceQuad(first_surface_id, 1.f)};
+  test::Pass child_passes[] = {test::Pass(child_quads, arraysize(child_quads))};
+  SubmitCompositorFrame(child_passes, arraysize(child_passes),
+                        child_surface_id);
+
+  test::Quad root_quads[] = {test::Quad::SolidColorQuad(SK_ColorWHITE),
+                             test::Quad::SurfaceQuad(child_surface_id, 1.f)};
+  test::Pass root_passes[] = {test::Pass(root_quads, arraysize(root_quads))};
+  SubmitCompositorFrame(root_passes, arraysize(root_passes), root_surface_id_);
+
+  test::Quad expected_first_quads[] = {
+      test::Quad::SolidColorQuad(SK_ColorWHITE),
+      test::Quad::SolidColorQuad(SK_ColorGREEN)};
+  test::Pass expected_first_passes[] = {
+      test::Pass(expected_first_quads, arraysize(expected_first_quads))};
+  SurfaceId first_ids[] = {root_surface_id_, child_surface_id,
+                           first_surface_id};
+  AggregateAndVerify(expected_first_passes, arraysize(expected_first_passes),
+                     first_ids, arraysize(first_ids));
+
+  // Nothing changed.
+  AggregateAndVerify(expected_first_passes, arraysize(expected_first_passes),
+                     first_ids, arraysize(first_ids));
+
+  // Only the child draws a new frame, embedding the other surface.
+  test::Quad new_child_quads[] = {
+      test::Quad::SurfaceQuad(second_surface_id, 1.f)};
+  test::Pass new_child_passes[] = {
+      test::Pass(new_child_quads, arraysize(new_child_quads))};
+  SubmitCompositorFrame(new_child_passes, arraysize(new_child_passes),
+                        child_surface_id);
+
+  test::Quad expected_second_quads[] = {
+      test::Quad::SolidColorQuad(SK_ColorWHITE),
+      test::Quad::SolidColorQuad(SK_ColorBLUE)};
+  test::Pass expected_second_passes[] = {
+      test::Pass(expected_second_quads, arraysize(expected_second_quads))};
+  SurfaceId second_ids[] = {root_surface_id_, child_surface_id,
+                            second_surface_id};
+  AggregateAndVerify(expected_second_passes, arraysize(expected_second_passes),
+                     second_ids, arraysize(second_ids));
+
+  factory_.Destroy(second_surface_id);
+  factory_.Destroy(first_surface_id);
+  factory_.Destroy(child_surface_id);
+}
+
 TEST_F(SurfaceAggregatorValidSurfaceTest, CopyRequest) {
   SurfaceId embedded_surface_id = allocator_.GenerateId();
   factory_.Create(embedded_surface_id);
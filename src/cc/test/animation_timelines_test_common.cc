@@ -29,6 +29,7 @@ void TestLayer::ClearMutatedProperties() {
   opacity_ = 0;
   filters_ = FilterOperations();
   scroll_offset_ = gfx::ScrollOffset();
+  background_color_ = SK_ColorTRANSPARENT;
   has_potential_transform_animation_ = false;
   transform_is_currently_animating_ = false;
   has_potential_opacity_animation_ = false;
@@ -124,6 +125,15 @@ void TestHostClient::SetElementScrollOffsetMutated(
     layer->set_scroll_offset(scroll_offset);
 }
 
+void TestHostClient::SetElementBackgroundColorMutated(
+    ElementId element_id,
+    ElementListType list_type,
+    SkColor background_color) {
+  TestLayer* layer = FindTestLayer(element_id, list_type);
+  if (layer)
+    layer->set_background_color(background_color);
+}
+
 void TestHostClient::ElementTransformIsAnimatingChanged(
     ElementId element_id,
     ElementListType list_type,
@@ -240,6 +250,13 @@ gfx::ScrollOffset TestHostClient::GetScrollOffset(
   return layer->scroll_offset();
 }
 
+SkColor TestHostClient::GetBackgroundColor(ElementId element_id,
+                                           ElementListType list_type) const {
+  TestLayer* layer = FindTestLayer(element_id, list_type);
+  EXPECT_TRUE(layer);
+  return layer->background_color();
+}
+
 bool TestHostClient::GetTransformIsCurrentlyAnimating(
     ElementId element_id,
     ElementListType list_type) const {
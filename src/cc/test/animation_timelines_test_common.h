@@ -51,6 +51,12 @@ class TestLayer {
     mutated_properties_[TargetProperty::SCROLL_OFFSET] = true;
   }
 
+  SkColor background_color() const { return background_color_; }
+  void set_background_color(SkColor background_color) {
+    background_color_ = background_color;
+    mutated_properties_[TargetProperty::BACKGROUND_COLOR] = true;
+  }
+
   bool transform_is_currently_animating() const {
     return transform_is_currently_animating_;
   }
@@ -90,6 +96,7 @@ class TestLayer {
   float opacity_;
   FilterOperations filters_;
   gfx::ScrollOffset scroll_offset_;
+  SkColor background_color_;
   bool has_potential_transform_animation_;
   bool transform_is_currently_animating_;
   bool has_potential_opacity_animation_;
@@ -128,6 +135,10 @@ class TestHostClient : public MutatorHostClient {
       ElementListType list_type,
       const gfx::ScrollOffset& scroll_offset) override;
 
+  void SetElementBackgroundColorMutated(ElementId element_id,
+                                        ElementListType list_type,
+                                        SkColor background_color) override;
+
   void ElementTransformIsAnimatingChanged(ElementId element_id,
                                           ElementListType list_type,
                                           AnimationChangeType change_type,
@@ -166,6 +177,8 @@ class TestHostClient : public MutatorHostClient {
                               ElementListType list_type) const;
   gfx::ScrollOffset GetScrollOffset(ElementId element_id,
                                     ElementListType list_type) const;
+  SkColor GetBackgroundColor(ElementId element_id,
+                             ElementListType list_type) const;
   bool GetHasPotentialTransformAnimation(ElementId element_id,
                                          ElementListType list_type) const;
   bool GetTransformIsCurrentlyAnimating(ElementId element_id,
@@ -39,6 +39,9 @@ class FakeLayerTreeHostImplClient : public LayerTreeHostImplClient {
   void DidActivateSyncTree() override {}
   void WillPrepareTiles() override {}
   void DidPrepareTiles() override {}
+  void DidMeasureGpuTimesOnImplThread(
+      const std::vector<base::TimeDelta>& draw_durations,
+      const std::vector<base::TimeDelta>& raster_durations) override {}
   void DidCompletePageScaleAnimationOnImplThread() override {}
   void OnDrawForOutputSurface(bool resourceless_software_draw) override {}
 };
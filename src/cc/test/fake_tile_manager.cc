@@ -33,7 +33,9 @@ FakeTileManager::FakeTileManager(TileManagerClient* client)
                   base::ThreadTaskRunnerHandle::Get().get(),
                   std::numeric_limits<size_t>::max(),
                   false /* use_partial_raster */,
-                  LayerTreeSettings().max_preraster_distance_in_screen_pixels),
+                  false /* use_stable_tile_compression */,
+                  LayerTreeSettings().max_preraster_distance_in_screen_pixels,
+                  LayerTreeSettings().image_predecode_budget_bytes),
       image_decode_controller_(
           ResourceFormat::RGBA_8888,
           LayerTreeSettings().software_decoded_image_budget_bytes) {
@@ -49,7 +51,9 @@ FakeTileManager::FakeTileManager(TileManagerClient* client,
                   base::ThreadTaskRunnerHandle::Get().get(),
                   std::numeric_limits<size_t>::max(),
                   false /* use_partial_raster */,
-                  LayerTreeSettings().max_preraster_distance_in_screen_pixels),
+                  false /* use_stable_tile_compression */,
+                  LayerTreeSettings().max_preraster_distance_in_screen_pixels,
+                  LayerTreeSettings().image_predecode_budget_bytes),
       image_decode_controller_(
           ResourceFormat::RGBA_8888,
           LayerTreeSettings().software_decoded_image_budget_bytes) {
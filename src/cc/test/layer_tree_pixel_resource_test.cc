@@ -149,7 +149,7 @@ void LayerTreeHostPixelResourceTest::CreateResourceAndRasterBufferProvider(
       EXPECT_TRUE(host_impl->GetRendererCapabilities().using_image);
 
       *raster_buffer_provider = ZeroCopyRasterBufferProvider::Create(
-          resource_provider, PlatformColor::BestTextureFormat());
+          resource_provider, PlatformColor::BestTextureFormat(), false);
       break;
     case RASTER_BUFFER_PROVIDER_TYPE_ONE_COPY:
       EXPECT_TRUE(compositor_context_provider);
@@ -71,6 +71,10 @@ void CreateTilingSetEvictionQueues(
   DCHECK(queues->empty());
 
   for (auto* layer : layers) {
+    // Layers without tiles have nothing to evict.
+    if (!layer->picture_layer_tiling_set()->HasTiles())
+      continue;
+
     std::unique_ptr<TilingSetEvictionQueue> tiling_set_queue = base::WrapUnique(
         new TilingSetEvictionQueue(layer->picture_layer_tiling_set()));
     // Queues will only contain non empty tiling sets.
@@ -287,6 +287,22 @@ int PictureLayerTilingSet::NumHighResTilings() const {
                        });
 }
 
+bool PictureLayerTilingSet::AllTilingsDone() const {
+  for (const auto& tiling : tilings_) {
+    if (tiling->has_tiles() && !tiling->all_tiles_done())
+      return false;
+  }
+  return true;
+}
+
+bool PictureLayerTilingSet::HasTiles() const {
+  for (const auto& tiling : tilings_) {
+    if (tiling->has_tiles())
+      return true;
+  }
+  return false;
+}
+
 PictureLayerTiling* PictureLayerTilingSet::FindTilingWithScale(
     float scale) const {
   for (size_t i = 0; i < tilings_.size(); ++i) {
@@ -86,6 +86,15 @@ class CC_EXPORT PictureLayerTilingSet {
   }
   WhichTree tree() const { return tree_; }
 
+  // Returns true if no tiling has tiles that may need raster, in which case
+  // raster queues built for this set are empty. Tilings stop being done when
+  // tiles are created, need raster again or change occlusion, so this only
+  // changes as priority rects and tile states are updated.
+  bool AllTilingsDone() const;
+
+  // Returns true if any tiling has tiles, regardless of their state.
+  bool HasTiles() const;
+
   PictureLayerTiling* FindTilingWithScale(float scale) const;
   PictureLayerTiling* FindTilingWithResolution(TileResolution resolution) const;
 
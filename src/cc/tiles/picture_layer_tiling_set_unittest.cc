@@ -87,6 +87,42 @@ TEST(PictureLayerTilingSetTest, NoResources) {
   EXPECT_TRUE(remaining.IsEmpty());
 }
 
+TEST(PictureLayerTilingSetTest, AllTilingsDone) {
+  FakePictureLayerTilingClient client;
+  gfx::Size layer_bounds(1000, 800);
+  std::unique_ptr<TestablePictureLayerTilingSet> set = CreateTilingSet(&client);
+  client.SetTileSize(gfx::Size(256, 256));
+
+  // A set without tilings has nothing to raster.
+  EXPECT_TRUE(set->AllTilingsDone());
+  EXPECT_FALSE(set->HasTiles());
+
+  scoped_refptr<FakeRasterSource> raster_source =
+      FakeRasterSource::CreateFilled(layer_bounds);
+  PictureLayerTiling* high_res_tiling = set->AddTiling(1.0, raster_source);
+  PictureLayerTiling* low_res_tiling = set->AddTiling(0.5, raster_source);
+
+  // Tilings without tiles are done.
+  EXPECT_TRUE(set->AllTilingsDone());
+  EXPECT_FALSE(set->HasTiles());
+
+  // Creating tiles makes a tiling not done until the raster queue found all
+  // of its tiles to be done.
+  high_res_tiling->CreateAllTilesForTesting();
+  EXPECT_FALSE(set->AllTilingsDone());
+  EXPECT_TRUE(set->HasTiles());
+
+  high_res_tiling->set_all_tiles_done(true);
+  EXPECT_TRUE(set->AllTilingsDone());
+
+  low_res_tiling->CreateAllTilesForTesting();
+  EXPECT_FALSE(set->AllTilingsDone());
+
+  low_res_tiling->set_all_tiles_done(true);
+  EXPECT_TRUE(set->AllTilingsDone());
+  EXPECT_TRUE(set->HasTiles());
+}
+
 TEST(PictureLayerTilingSetTest, TilingRange) {
   FakePictureLayerTilingClient client;
   gfx::Size layer_bounds(10, 10);
@@ -61,6 +61,12 @@ void CreateTilingSetRasterQueues(
       continue;
 
     PictureLayerTilingSet* tiling_set = layer->picture_layer_tiling_set();
+    // Layers whose tilings are all done would only produce an empty queue, so
+    // skip them without building one. On pages with many layers, most of them
+    // are in this state on most frames.
+    if (tiling_set->AllTilingsDone())
+      continue;
+
     bool prioritize_low_res = tree_priority == SMOOTHNESS_TAKES_PRIORITY;
     std::unique_ptr<TilingSetRasterQueueAll> tiling_set_queue =
         base::WrapUnique(
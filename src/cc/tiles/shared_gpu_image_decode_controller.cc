@@ -0,0 +1,193 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/tiles/shared_gpu_image_decode_controller.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/synchronization/lock.h"
+#include "cc/raster/tile_task.h"
+#include "cc/tiles/gpu_image_decode_controller.h"
+
+namespace cc {
+
+struct SharedGpuImageDecodeController::SharedState {
+  SharedState(ContextProvider* context,
+              ResourceFormat decode_format,
+              size_t max_gpu_image_bytes)
+      : controller(context, decode_format, max_gpu_image_bytes) {}
+
+  // A pending task given to |owner|, which is the only one to schedule it.
+  struct ClaimedTask {
+    scoped_refptr<TileTask> task;
+    const SharedGpuImageDecodeController* owner;
+  };
+
+  GpuImageDecodeController controller;
+
+  // The following members are only accessed while holding the lock of the
+  // Registry.
+  size_t controller_count = 0;
+  size_t aggressively_freeing_controller_count = 0;
+  std::vector<ClaimedTask> claimed_tasks;
+};
+
+namespace {
+
+using SharedState = SharedGpuImageDecodeController::SharedState;
+
+struct Registry {
+  base::Lock lock;
+  std::unordered_map<ContextProvider*, std::unique_ptr<SharedState>>
+      shared_states;
+};
+
+base::LazyInstance<Registry>::Leaky g_registry = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// static
+std::unique_ptr<SharedGpuImageDecodeController>
+SharedGpuImageDecodeController::Create(ContextProvider* context,
+                                       ResourceFormat decode_format,
+                                       size_t max_gpu_image_bytes) {
+  Registry& registry = g_registry.Get();
+  base::AutoLock lock(registry.lock);
+  std::unique_ptr<SharedState>& shared_state = registry.shared_states[context];
+  if (!shared_state) {
+    shared_state = base::WrapUnique(
+        new SharedState(context, decode_format, max_gpu_image_bytes));
+  }
+  return base::WrapUnique(
+      new SharedGpuImageDecodeController(context, shared_state.get()));
+}
+
+SharedGpuImageDecodeController::SharedGpuImageDecodeController(
+    ContextProvider* context,
+    SharedState* shared_state)
+    : context_(context),
+      shared_state_(shared_state),
+      aggressively_free_resources_(false) {
+  ++shared_state_->controller_count;
+}
+
+SharedGpuImageDecodeController::~SharedGpuImageDecodeController() {
+  std::unique_ptr<SharedState> last_shared_state;
+  Registry& registry = g_registry.Get();
+  {
+    base::AutoLock lock(registry.lock);
+    auto& claimed_tasks = shared_state_->claimed_tasks;
+    claimed_tasks.erase(
+        std::remove_if(claimed_tasks.begin(), claimed_tasks.end(),
+                       [this](const SharedState::ClaimedTask& claimed_task) {
+                         return claimed_task.owner == this;
+                       }),
+        claimed_tasks.end());
+    if (aggressively_free_resources_)
+      --shared_state_->aggressively_freeing_controller_count;
+    if (--shared_state_->controller_count == 0) {
+      auto it = registry.shared_states.find(context_);
+      DCHECK(it != registry.shared_states.end());
+      last_shared_state = std::move(it->second);
+      registry.shared_states.erase(it);
+    }
+  }
+  // Destroy the GpuImageDecodeController without holding the lock, since it
+  // acquires the context lock.
+  last_shared_state.reset();
+}
+
+bool SharedGpuImageDecodeController::GetTaskForImageAndRef(
+    const DrawImage& image,
+    const TracingInfo& tracing_info,
+    scoped_refptr<TileTask>* task) {
+  bool need_unref = shared_state_->controller.GetTaskForImageAndRef(
+      image, tracing_info, task);
+  if (*task) {
+    base::AutoLock lock(g_registry.Get().lock);
+    if (!ClaimTaskWithLockAcquired(task->get()))
+      *task = nullptr;
+  }
+  return need_unref;
+}
+
+void SharedGpuImageDecodeController::UnrefImage(const DrawImage& image) {
+  shared_state_->controller.UnrefImage(image);
+}
+
+DecodedDrawImage SharedGpuImageDecodeController::GetDecodedImageForDraw(
+    const DrawImage& image) {
+  return shared_state_->controller.GetDecodedImageForDraw(image);
+}
+
+void SharedGpuImageDecodeController::DrawWithImageFinished(
+    const DrawImage& image,
+    const DecodedDrawImage& decoded_image) {
+  shared_state_->controller.DrawWithImageFinished(image, decoded_image);
+}
+
+void SharedGpuImageDecodeController::ReduceCacheUsage() {
+  shared_state_->controller.ReduceCacheUsage();
+}
+
+void SharedGpuImageDecodeController::SetShouldAggressivelyFreeResources(
+    bool aggressively_free_resources) {
+  bool all_aggressively_free_resources;
+  {
+    base::AutoLock lock(g_registry.Get().lock);
+    if (aggressively_free_resources_ != aggressively_free_resources) {
+      aggressively_free_resources_ = aggressively_free_resources;
+      if (aggressively_free_resources_)
+        ++shared_state_->aggressively_freeing_controller_count;
+      else
+        --shared_state_->aggressively_freeing_controller_count;
+    }
+    all_aggressively_free_resources =
+        shared_state_->aggressively_freeing_controller_count ==
+        shared_state_->controller_count;
+  }
+  shared_state_->controller.SetShouldAggressivelyFreeResources(
+      all_aggressively_free_resources);
+}
+
+bool SharedGpuImageDecodeController::ClaimTaskWithLockAcquired(
+    TileTask* task) {
+  // Tasks that completed no longer need an owner.
+  auto& claimed_tasks = shared_state_->claimed_tasks;
+  claimed_tasks.erase(
+      std::remove_if(claimed_tasks.begin(), claimed_tasks.end(),
+                     [](const SharedState::ClaimedTask& claimed_task) {
+                       return claimed_task.task->HasCompleted();
+                     }),
+      claimed_tasks.end());
+
+  std::vector<TileTask*> tasks(1, task);
+  for (const auto& dependency : task->dependencies()) {
+    if (!dependency->HasCompleted())
+      tasks.push_back(dependency.get());
+  }
+
+  std::vector<TileTask*> unclaimed_tasks;
+  for (TileTask* task_to_claim : tasks) {
+    auto it = std::find_if(claimed_tasks.begin(), claimed_tasks.end(),
+                           [task_to_claim](const SharedState::ClaimedTask& t) {
+                             return t.task.get() == task_to_claim;
+                           });
+    if (it == claimed_tasks.end())
+      unclaimed_tasks.push_back(task_to_claim);
+    else if (it->owner != this)
+      return false;
+  }
+
+  for (TileTask* unclaimed_task : unclaimed_tasks)
+    claimed_tasks.push_back({make_scoped_refptr(unclaimed_task), this});
+  return true;
+}
+
+}  // namespace cc
@@ -0,0 +1,75 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_TILES_SHARED_GPU_IMAGE_DECODE_CONTROLLER_H_
+#define CC_TILES_SHARED_GPU_IMAGE_DECODE_CONTROLLER_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "base/macros.h"
+#include "cc/base/cc_export.h"
+#include "cc/resources/resource_format.h"
+#include "cc/tiles/image_decode_controller.h"
+
+namespace cc {
+
+class ContextProvider;
+
+// An ImageDecodeController backed by a GpuImageDecodeController that is
+// shared by all the SharedGpuImageDecodeControllers created for the same
+// worker context. Compositors that share a worker context, such as the ones
+// of the tabs and webviews of a renderer, then upload each image only once,
+// and all their uploads count against a single budget.
+//
+// A pending decode or upload task is only ever given to the compositor that
+// got it first, since a task can't be scheduled by several TileTaskManagers.
+// Other compositors that need the image in the meantime decode and upload it
+// at raster, unless that task completed by then.
+class CC_EXPORT SharedGpuImageDecodeController : public ImageDecodeController {
+ public:
+  // The budget and format of the first controller created for |context| are
+  // used until all the controllers of |context| are destroyed.
+  static std::unique_ptr<SharedGpuImageDecodeController> Create(
+      ContextProvider* context,
+      ResourceFormat decode_format,
+      size_t max_gpu_image_bytes);
+  ~SharedGpuImageDecodeController() override;
+
+  // The state shared by the controllers of a worker context.
+  struct SharedState;
+
+  // ImageDecodeController overrides.
+  bool GetTaskForImageAndRef(const DrawImage& image,
+                             const TracingInfo& tracing_info,
+                             scoped_refptr<TileTask>* task) override;
+  void UnrefImage(const DrawImage& image) override;
+  DecodedDrawImage GetDecodedImageForDraw(const DrawImage& image) override;
+  void DrawWithImageFinished(const DrawImage& image,
+                             const DecodedDrawImage& decoded_image) override;
+  void ReduceCacheUsage() override;
+  // Resources are only freed aggressively once all the controllers sharing
+  // them asked for it.
+  void SetShouldAggressivelyFreeResources(
+      bool aggressively_free_resources) override;
+
+ private:
+  SharedGpuImageDecodeController(ContextProvider* context,
+                                 SharedState* shared_state);
+
+  // Returns true if |task| and its dependencies were not given to another
+  // controller, and records that they were given to this one.
+  bool ClaimTaskWithLockAcquired(TileTask* task);
+
+  ContextProvider* const context_;
+  SharedState* const shared_state_;
+  bool aggressively_free_resources_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedGpuImageDecodeController);
+};
+
+}  // namespace cc
+
+#endif  // CC_TILES_SHARED_GPU_IMAGE_DECODE_CONTROLLER_H_
@@ -0,0 +1,102 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/tiles/shared_gpu_image_decode_controller.h"
+
+#include "cc/playback/draw_image.h"
+#include "cc/raster/tile_task.h"
+#include "cc/test/test_context_provider.h"
+#include "cc/test/test_tile_task_runner.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+
+namespace cc {
+namespace {
+
+size_t kGpuMemoryLimitBytes = 96 * 1024 * 1024;
+
+std::unique_ptr<SharedGpuImageDecodeController> CreateController(
+    ContextProvider* context) {
+  return SharedGpuImageDecodeController::Create(
+      context, ResourceFormat::RGBA_8888, kGpuMemoryLimitBytes);
+}
+
+DrawImage CreateDrawImage(sk_sp<SkImage> image) {
+  SkMatrix matrix;
+  matrix.setScale(0.5f, 0.5f);
+  SkIRect src_rect = SkIRect::MakeWH(image->width(), image->height());
+  return DrawImage(std::move(image), src_rect, kHigh_SkFilterQuality, matrix);
+}
+
+sk_sp<SkImage> CreateImage(int width, int height) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeN32Premul(width, height));
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+TEST(SharedGpuImageDecodeControllerTest, UploadsImageOnce) {
+  auto context_provider = TestContextProvider::Create();
+  context_provider->BindToCurrentThread();
+  std::unique_ptr<SharedGpuImageDecodeController> controller =
+      CreateController(context_provider.get());
+  std::unique_ptr<SharedGpuImageDecodeController> other_controller =
+      CreateController(context_provider.get());
+  DrawImage draw_image = CreateDrawImage(CreateImage(100, 100));
+
+  scoped_refptr<TileTask> task;
+  EXPECT_TRUE(controller->GetTaskForImageAndRef(
+      draw_image, ImageDecodeController::TracingInfo(), &task));
+  EXPECT_TRUE(task);
+
+  // The pending task belongs to the first controller.
+  scoped_refptr<TileTask> other_task;
+  EXPECT_TRUE(other_controller->GetTaskForImageAndRef(
+      draw_image, ImageDecodeController::TracingInfo(), &other_task));
+  EXPECT_FALSE(other_task);
+
+  TestTileTaskRunner::ProcessTask(task->dependencies()[0].get());
+  TestTileTaskRunner::ProcessTask(task.get());
+
+  // Once uploaded, the image is shared without any task.
+  EXPECT_TRUE(other_controller->GetTaskForImageAndRef(
+      draw_image, ImageDecodeController::TracingInfo(), &other_task));
+  EXPECT_FALSE(other_task);
+
+  controller->UnrefImage(draw_image);
+  other_controller->UnrefImage(draw_image);
+  other_controller->UnrefImage(draw_image);
+}
+
+TEST(SharedGpuImageDecodeControllerTest, SharesOnlyWithSameContext) {
+  auto context_provider = TestContextProvider::Create();
+  context_provider->BindToCurrentThread();
+  auto other_context_provider = TestContextProvider::Create();
+  other_context_provider->BindToCurrentThread();
+  std::unique_ptr<SharedGpuImageDecodeController> controller =
+      CreateController(context_provider.get());
+  std::unique_ptr<SharedGpuImageDecodeController> other_controller =
+      CreateController(other_context_provider.get());
+  DrawImage draw_image = CreateDrawImage(CreateImage(100, 100));
+
+  scoped_refptr<TileTask> task;
+  EXPECT_TRUE(controller->GetTaskForImageAndRef(
+      draw_image, ImageDecodeController::TracingInfo(), &task));
+  EXPECT_TRUE(task);
+  scoped_refptr<TileTask> other_task;
+  EXPECT_TRUE(other_controller->GetTaskForImageAndRef(
+      draw_image, ImageDecodeController::TracingInfo(), &other_task));
+  EXPECT_TRUE(other_task);
+  EXPECT_NE(task, other_task);
+
+  TestTileTaskRunner::ProcessTask(task->dependencies()[0].get());
+  TestTileTaskRunner::ProcessTask(task.get());
+  TestTileTaskRunner::ProcessTask(other_task->dependencies()[0].get());
+  TestTileTaskRunner::ProcessTask(other_task.get());
+
+  controller->UnrefImage(draw_image);
+  other_controller->UnrefImage(draw_image);
+}
+
+}  // namespace
+}  // namespace cc
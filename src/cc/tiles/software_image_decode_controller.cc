@@ -539,6 +539,28 @@ SoftwareImageDecodeController::GetScaledImageDecode(
       << original_size_key.ToString();
   DCHECK(full_image_rect.size() == original_size_key.target_size());
 
+  // Unless the original size decode is around already, scale the image while
+  // decoding it, so that the original size decode doesn't take room in the
+  // cache. This also lets generators that can decode at a smaller scale, like
+  // the JPEG one, skip the full size decode.
+  if (key.src_rect() == full_image_rect) {
+    bool has_original_size_decode;
+    {
+      base::AutoLock lock(lock_);
+      has_original_size_decode =
+          decoded_images_.Peek(original_size_key) != decoded_images_.end() ||
+          at_raster_decoded_images_.Peek(original_size_key) !=
+              at_raster_decoded_images_.end();
+    }
+    if (!has_original_size_decode) {
+      std::unique_ptr<DecodedImage> decoded_image =
+          GetDirectlyScaledImageDecode(key,
+                                       original_size_draw_image.image().get());
+      if (decoded_image)
+        return decoded_image;
+    }
+  }
+
   auto decoded_draw_image = GetDecodedImageForDrawInternal(
       original_size_key, original_size_draw_image);
   if (!decoded_draw_image.image()) {
@@ -590,6 +612,42 @@ SoftwareImageDecodeController::GetScaledImageDecode(
                        next_tracing_id_.GetNext()));
 }
 
+std::unique_ptr<SoftwareImageDecodeController::DecodedImage>
+SoftwareImageDecodeController::GetDirectlyScaledImageDecode(
+    const ImageKey& key,
+    const SkImage* image) {
+  DCHECK(!key.target_size().IsEmpty());
+  SkImageInfo scaled_info = CreateImageInfo(
+      key.target_size().width(), key.target_size().height(), format_);
+  std::unique_ptr<base::DiscardableMemory> scaled_pixels;
+  {
+    TRACE_EVENT0("disabled-by-default-cc.debug",
+                 "SoftwareImageDecodeController::GetDirectlyScaledImageDecode "
+                 "- allocate scaled pixels");
+    scaled_pixels = base::DiscardableMemoryAllocator::GetInstance()
+                        ->AllocateLockedDiscardableMemory(
+                            scaled_info.minRowBytes() * scaled_info.height());
+  }
+  SkPixmap scaled_pixmap(scaled_info, scaled_pixels->data(),
+                         scaled_info.minRowBytes());
+  {
+    TRACE_EVENT0("disabled-by-default-cc.debug",
+                 "SoftwareImageDecodeController::GetDirectlyScaledImageDecode "
+                 "- scale pixels");
+    // Skia must not cache the original size decode either.
+    bool result = image->scalePixels(scaled_pixmap, key.filter_quality(),
+                                     SkImage::kDisallow_CachingHint);
+    if (!result) {
+      scaled_pixels->Unlock();
+      return nullptr;
+    }
+  }
+  return base::WrapUnique(new DecodedImage(scaled_info,
+                                           std::move(scaled_pixels),
+                                           SkSize::Make(0, 0),
+                                           next_tracing_id_.GetNext()));
+}
+
 void SoftwareImageDecodeController::DrawWithImageFinished(
     const DrawImage& image,
     const DecodedDrawImage& decoded_image) {
@@ -241,6 +241,14 @@ class CC_EXPORT SoftwareImageDecodeController
       const ImageKey& key,
       sk_sp<const SkImage> image);
 
+  // Decodes |image| straight at the target size of |key|, without going
+  // through a cached original size decode. Like GetScaledImageDecode, it
+  // should be called with no lock acquired and it returns nullptr if the
+  // decoding failed.
+  std::unique_ptr<DecodedImage> GetDirectlyScaledImageDecode(
+      const ImageKey& key,
+      const SkImage* image);
+
   void SanityCheckState(int line, bool lock_acquired);
   void RefImage(const ImageKey& key);
   void RefAtRasterImage(const ImageKey& key);
@@ -1431,5 +1431,48 @@ TEST(SoftwareImageDecodeControllerTest,
   controller.UnrefImage(draw_image_49);
 }
 
+TEST(SoftwareImageDecodeControllerTest,
+     MediumQualityScaledDecodeDoesNotCacheOriginalDecode) {
+  TestSoftwareImageDecodeController controller;
+  bool is_decomposable = true;
+
+  sk_sp<SkImage> image = CreateImage(500, 200);
+  DrawImage scaled_draw_image(
+      image, SkIRect::MakeWH(image->width(), image->height()),
+      kMedium_SkFilterQuality,
+      CreateMatrix(SkSize::Make(0.25f, 0.25f), is_decomposable));
+  DrawImage original_draw_image(
+      image, SkIRect::MakeWH(image->width(), image->height()),
+      kNone_SkFilterQuality,
+      CreateMatrix(SkSize::Make(1.f, 1.f), is_decomposable));
+
+  scoped_refptr<TileTask> scaled_task;
+  bool need_unref = controller.GetTaskForImageAndRef(
+      scaled_draw_image, ImageDecodeController::TracingInfo(), &scaled_task);
+  EXPECT_TRUE(scaled_task);
+  EXPECT_TRUE(need_unref);
+
+  TestTileTaskRunner::ProcessTask(scaled_task.get());
+
+  DecodedDrawImage decoded_draw_image =
+      controller.GetDecodedImageForDraw(scaled_draw_image);
+  EXPECT_TRUE(decoded_draw_image.image());
+  EXPECT_EQ(125, decoded_draw_image.image()->width());
+  EXPECT_EQ(50, decoded_draw_image.image()->height());
+  controller.DrawWithImageFinished(scaled_draw_image, decoded_draw_image);
+
+  // The original size decode still has to be done.
+  scoped_refptr<TileTask> original_task;
+  need_unref = controller.GetTaskForImageAndRef(
+      original_draw_image, ImageDecodeController::TracingInfo(),
+      &original_task);
+  EXPECT_TRUE(original_task);
+  EXPECT_TRUE(need_unref);
+
+  TestTileTaskRunner::ProcessTask(original_task.get());
+  controller.UnrefImage(original_draw_image);
+  controller.UnrefImage(scaled_draw_image);
+}
+
 }  // namespace
 }  // namespace cc
@@ -34,7 +34,8 @@ Tile::Tile(TileManager* tile_manager,
       required_for_draw_(false),
       id_(tile_manager->GetUniqueTileId()),
       invalidated_id_(0),
-      scheduled_priority_(0) {}
+      scheduled_priority_(0),
+      rastered_prepare_tiles_count_(0) {}
 
 Tile::~Tile() {
   TRACE_EVENT_OBJECT_DELETED_WITH_ID(
@@ -145,6 +145,9 @@ class CC_EXPORT Tile {
 
   unsigned scheduled_priority_;
 
+  // The PrepareTiles count at which the resource of this tile was rastered.
+  uint64_t rastered_prepare_tiles_count_;
+
   scoped_refptr<TileTask> raster_task_;
 
   DISALLOW_COPY_AND_ASSIGN(Tile);
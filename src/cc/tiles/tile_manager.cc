@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <string>
 
@@ -37,6 +38,14 @@ namespace {
 // a tile is of solid color.
 const bool kUseColorEstimator = true;
 
+// Number of PrepareTiles a tile needs to keep its resource for before it is
+// considered stable enough to be rastered again into a compressed resource.
+const uint64_t kStableTilePrepareTilesCount = 10u;
+
+// Limits the number of compression tasks scheduled at once, as each of them
+// briefly holds a compressed resource in addition to the one it replaces.
+const size_t kMaxTilesToCompress = 4u;
+
 DEFINE_SCOPED_UMA_HISTOGRAM_AREA_TIMER(
     ScopedRasterTaskTimer,
     "Compositing.%s.RasterTask.RasterUs",
@@ -288,6 +297,16 @@ class TaskSetFinishedTaskImpl : public TileTask {
   DISALLOW_COPY_AND_ASSIGN(TaskSetFinishedTaskImpl);
 };
 
+// Estimates the size of the decode of |draw_image|. Images are never decoded
+// at a larger scale than their original size.
+size_t EstimateDecodedImageBytes(const DrawImage& draw_image) {
+  const SkImage* image = draw_image.image().get();
+  float scale_x = std::min(std::abs(draw_image.scale().width()), 1.f);
+  float scale_y = std::min(std::abs(draw_image.scale().height()), 1.f);
+  return 4u * static_cast<size_t>(std::ceil(image->width() * scale_x)) *
+         static_cast<size_t>(std::ceil(image->height() * scale_y));
+}
+
 }  // namespace
 
 RasterTaskCompletionStats::RasterTaskCompletionStats()
@@ -308,13 +327,16 @@ TileManager::TileManager(TileManagerClient* client,
                          base::SequencedTaskRunner* task_runner,
                          size_t scheduled_raster_task_limit,
                          bool use_partial_raster,
-                         int max_preraster_distance_in_screen_pixels)
+                         bool use_stable_tile_compression,
+                         int max_preraster_distance_in_screen_pixels,
+                         size_t image_predecode_budget_bytes)
     : client_(client),
       task_runner_(task_runner),
       resource_pool_(nullptr),
       tile_task_manager_(nullptr),
       scheduled_raster_task_limit_(scheduled_raster_task_limit),
       use_partial_raster_(use_partial_raster),
+      use_stable_tile_compression_(use_stable_tile_compression),
       use_gpu_rasterization_(false),
       all_tiles_that_need_to_be_rasterized_are_scheduled_(true),
       did_check_for_completed_tasks_since_last_schedule_tasks_(true),
@@ -331,6 +353,7 @@ TileManager::TileManager(TileManagerClient* client,
       next_tile_id_(0u),
       max_preraster_distance_in_screen_pixels_(
           max_preraster_distance_in_screen_pixels),
+      image_predecode_budget_bytes_(image_predecode_budget_bytes),
       task_set_finished_weak_ptr_factory_(this) {}
 
 TileManager::~TileManager() {
@@ -574,6 +597,49 @@ TileManager::FreeTileResourcesWithLowerPriorityUntilUsageIsWithinLimit(
   return eviction_priority_queue;
 }
 
+bool TileManager::ShouldCompressTile(const Tile* tile) const {
+  const TileDrawInfo& draw_info = tile->draw_info();
+  if (!tile->is_opaque() || !draw_info.has_resource() ||
+      draw_info.has_compressed_resource()) {
+    return false;
+  }
+
+  // A tile that already has a raster task along with a resource is being
+  // compressed, and needs to be scheduled again to keep its task.
+  if (tile->HasRasterTask())
+    return true;
+
+  // Compressed formats work on blocks of 4x4 pixels.
+  const gfx::Size& size = tile->desired_texture_size();
+  if (size.width() % 4 || size.height() % 4)
+    return false;
+
+  return prepare_tiles_count_ - tile->rastered_prepare_tiles_count_ >=
+         kStableTilePrepareTilesCount;
+}
+
+void TileManager::AssignTilesToCompress(
+    PrioritizedWorkToSchedule* work_to_schedule) {
+  ResourceFormat compressed_format =
+      raster_buffer_provider_->GetCompressedResourceFormat();
+  if (!IsResourceFormatCompressed(compressed_format))
+    return;
+
+  TRACE_EVENT0("cc", "TileManager::AssignTilesToCompress");
+
+  // Start with the tiles that are least likely to be looked at closely, as
+  // compression loses some quality.
+  std::unique_ptr<EvictionTilePriorityQueue> eviction_priority_queue =
+      client_->BuildEvictionQueue(global_state_.tree_priority);
+  for (; !eviction_priority_queue->IsEmpty() &&
+         work_to_schedule->tiles_to_compress.size() < kMaxTilesToCompress;
+       eviction_priority_queue->Pop()) {
+    const PrioritizedTile& prioritized_tile = eviction_priority_queue->Top();
+    if (ShouldCompressTile(prioritized_tile.tile()))
+      work_to_schedule->tiles_to_compress.push_back(prioritized_tile);
+  }
+}
+
 bool TileManager::TilePriorityViolatesMemoryPolicy(
     const TilePriority& priority) {
   switch (global_state_.memory_limit_policy) {
@@ -608,6 +674,11 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
   unsigned schedule_priority = 1u;
   all_tiles_that_need_to_be_rasterized_are_scheduled_ = true;
   bool had_enough_memory_to_schedule_tiles_needed_now = true;
+  bool reached_memory_limit = false;
+  // Set once no more tiles can be scheduled for raster. The images of the
+  // following tiles are then decoded ahead of time, within their own budget.
+  bool predecoding_images = false;
+  size_t predecode_bytes = 0;
 
   MemoryUsage hard_memory_limit(global_state_.hard_memory_limit_in_bytes,
                                 global_state_.num_resources_limit);
@@ -633,6 +704,14 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
       break;
     }
 
+    if (predecoding_images) {
+      if (!AddTileToPredecodeImages(prioritized_tile, &predecode_bytes,
+                                    &work_to_schedule)) {
+        break;
+      }
+      continue;
+    }
+
     bool tile_is_needed_now = priority.priority_bin == TilePriority::NOW;
     if (tile->use_picture_analysis() && kUseColorEstimator) {
       // We analyze for solid color here, to decide to continue
@@ -661,11 +740,17 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
       continue;
     }
 
-    // We won't be able to schedule this tile, so break out early.
+    // We won't be able to schedule this tile, so break out early unless its
+    // images can be predecoded.
     if (work_to_schedule.tiles_to_raster.size() >=
         scheduled_raster_task_limit_) {
       all_tiles_that_need_to_be_rasterized_are_scheduled_ = false;
-      break;
+      predecoding_images = true;
+      if (!AddTileToPredecodeImages(prioritized_tile, &predecode_bytes,
+                                    &work_to_schedule)) {
+        break;
+      }
+      continue;
     }
 
     tile->scheduled_priority_ = schedule_priority++;
@@ -703,7 +788,13 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
       if (tile_is_needed_now)
         had_enough_memory_to_schedule_tiles_needed_now = false;
       all_tiles_that_need_to_be_rasterized_are_scheduled_ = false;
-      break;
+      reached_memory_limit = true;
+      predecoding_images = true;
+      if (!AddTileToPredecodeImages(prioritized_tile, &predecode_bytes,
+                                    &work_to_schedule)) {
+        break;
+      }
+      continue;
     }
 
     memory_usage += memory_required_by_tile_to_be_scheduled;
@@ -723,6 +814,11 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
   eviction_priority_queue = FreeTileResourcesUntilUsageIsWithinLimit(
       std::move(eviction_priority_queue), hard_memory_limit, &memory_usage);
 
+  // When tiles did not fit into the memory budget, make room for them in the
+  // following PrepareTiles by compressing the resources of stable tiles.
+  if (use_stable_tile_compression_ && reached_memory_limit)
+    AssignTilesToCompress(&work_to_schedule);
+
   UMA_HISTOGRAM_BOOLEAN("TileManager.ExceededMemoryBudget",
                         !had_enough_memory_to_schedule_tiles_needed_now);
   did_oom_on_last_assign_ = !had_enough_memory_to_schedule_tiles_needed_now;
@@ -742,6 +838,35 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
   return work_to_schedule;
 }
 
+bool TileManager::AddTileToPredecodeImages(
+    const PrioritizedTile& prioritized_tile,
+    size_t* predecode_bytes,
+    PrioritizedWorkToSchedule* work_to_schedule) {
+  if (*predecode_bytes >= image_predecode_budget_bytes_)
+    return false;
+
+  // Images are not drawn into LOW_RESOLUTION tiles.
+  if (prioritized_tile.priority().resolution == LOW_RESOLUTION)
+    return true;
+
+  Tile* tile = prioritized_tile.tile();
+  std::vector<DrawImage> images;
+  prioritized_tile.raster_source()->GetDiscardableImagesInRect(
+      tile->enclosing_layer_rect(), tile->contents_scale(), &images);
+  if (images.empty())
+    return true;
+
+  size_t tile_decoded_bytes = 0;
+  for (const DrawImage& image : images)
+    tile_decoded_bytes += EstimateDecodedImageBytes(image);
+  if (tile_decoded_bytes > image_predecode_budget_bytes_ - *predecode_bytes)
+    return false;
+
+  *predecode_bytes += tile_decoded_bytes;
+  work_to_schedule->tiles_to_process_for_images.push_back(prioritized_tile);
+  return true;
+}
+
 void TileManager::FreeResourcesForTile(Tile* tile) {
   TileDrawInfo& draw_info = tile->draw_info();
   if (draw_info.resource_) {
@@ -805,8 +930,10 @@ void TileManager::ScheduleTasks(
     DCHECK(tile->draw_info().requires_resource());
     DCHECK(!tile->draw_info().resource_);
 
-    if (!tile->raster_task_)
-      tile->raster_task_ = CreateRasterTask(prioritized_tile);
+    if (!tile->raster_task_) {
+      tile->raster_task_ =
+          CreateRasterTask(prioritized_tile, DetermineResourceFormat(tile));
+    }
 
     TileTask* task = tile->raster_task_.get();
 
@@ -835,6 +962,29 @@ void TileManager::ScheduleTasks(
                              use_foreground_category);
   }
 
+  // Compression tasks run after all raster work, and the tiles stay ready to
+  // draw with their current resource until they complete.
+  for (auto& prioritized_tile : work_to_schedule.tiles_to_compress) {
+    Tile* tile = prioritized_tile.tile();
+
+    DCHECK(tile->draw_info().has_resource());
+
+    if (!tile->raster_task_) {
+      tile->raster_task_ = CreateRasterTask(
+          prioritized_tile,
+          raster_buffer_provider_->GetCompressedResourceFormat());
+    }
+
+    TileTask* task = tile->raster_task_.get();
+
+    DCHECK(!task->HasCompleted());
+
+    all_count++;
+    graph_.edges.push_back(TaskGraph::Edge(task, all_done_task.get()));
+    InsertNodesForRasterTask(&graph_, task, task->dependencies(), priority++,
+                             false /* use_foreground_category */);
+  }
+
   const std::vector<PrioritizedTile>& tiles_to_process_for_images =
       work_to_schedule.tiles_to_process_for_images;
   std::vector<std::pair<DrawImage, scoped_refptr<TileTask>>> new_locked_images;
@@ -926,13 +1076,16 @@ void TileManager::ScheduleTasks(
 }
 
 scoped_refptr<TileTask> TileManager::CreateRasterTask(
-    const PrioritizedTile& prioritized_tile) {
+    const PrioritizedTile& prioritized_tile,
+    ResourceFormat format) {
   Tile* tile = prioritized_tile.tile();
 
-  // Get the resource.
+  // Get the resource. Tiles that are compressed already have a resource, so
+  // the resource of the tile they replaced is not reused.
   uint64_t resource_content_id = 0;
   Resource* resource = nullptr;
-  if (use_partial_raster_ && tile->invalidated_id()) {
+  if (use_partial_raster_ && tile->invalidated_id() &&
+      !tile->draw_info().has_resource()) {
     // TODO(danakj): For resources that are in use, we should still grab them
     // and copy from them instead of rastering everything. crbug.com/492754
     resource =
@@ -940,10 +1093,10 @@ scoped_refptr<TileTask> TileManager::CreateRasterTask(
   }
   if (resource) {
     resource_content_id = tile->invalidated_id();
-    DCHECK_EQ(DetermineResourceFormat(tile), resource->format());
+    DCHECK_EQ(format, resource->format());
   } else {
-    resource = resource_pool_->AcquireResource(tile->desired_texture_size(),
-                                               DetermineResourceFormat(tile));
+    resource =
+        resource_pool_->AcquireResource(tile->desired_texture_size(), format);
   }
 
   // For LOW_RESOLUTION tiles, we don't draw or predecode images.
@@ -1021,9 +1174,17 @@ void TileManager::OnRasterTaskCompleted(
 
   ++flush_stats_.completed_count;
 
+  // Compressing a tile replaces the resource it was drawn with so far.
+  if (draw_info.resource_)
+    FreeResourcesForTile(tile);
+
   draw_info.set_use_resource();
   draw_info.resource_ = resource;
-  draw_info.contents_swizzled_ = DetermineResourceRequiresSwizzle(tile);
+  // Compressed resources are never swizzled.
+  draw_info.contents_swizzled_ =
+      !IsResourceFormatCompressed(resource->format()) &&
+      DetermineResourceRequiresSwizzle(tile);
+  tile->rastered_prepare_tiles_count_ = prepare_tiles_count_;
 
   DCHECK(draw_info.IsReadyToDraw());
   draw_info.set_was_ever_ready_to_draw();
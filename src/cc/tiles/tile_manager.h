@@ -99,7 +99,9 @@ class CC_EXPORT TileManager {
               base::SequencedTaskRunner* task_runner,
               size_t scheduled_raster_task_limit,
               bool use_partial_raster,
-              int max_preraster_distance_in_screen_pixels);
+              bool use_stable_tile_compression,
+              int max_preraster_distance_in_screen_pixels,
+              size_t image_predecode_budget_bytes);
   virtual ~TileManager();
 
   // Assigns tile memory and schedules work to prepare tiles for drawing.
@@ -253,12 +255,23 @@ class CC_EXPORT TileManager {
 
     std::vector<PrioritizedTile> tiles_to_raster;
     std::vector<PrioritizedTile> tiles_to_process_for_images;
+    // Ready to draw tiles to raster again into a compressed resource.
+    std::vector<PrioritizedTile> tiles_to_compress;
   };
 
   void FreeResourcesForTile(Tile* tile);
   void FreeResourcesForTileAndNotifyClientIfTileWasReadyToDraw(Tile* tile);
+
+  // Adds |prioritized_tile| to the tiles to process for images if the size
+  // of its decoded images fits in what is left of the predecode budget after
+  // |predecode_bytes|, and adds that size to |predecode_bytes|. Returns false
+  // once the budget is exceeded.
+  bool AddTileToPredecodeImages(const PrioritizedTile& prioritized_tile,
+                                size_t* predecode_bytes,
+                                PrioritizedWorkToSchedule* work_to_schedule);
   scoped_refptr<TileTask> CreateRasterTask(
-      const PrioritizedTile& prioritized_tile);
+      const PrioritizedTile& prioritized_tile,
+      ResourceFormat format);
 
   std::unique_ptr<EvictionTilePriorityQueue>
   FreeTileResourcesUntilUsageIsWithinLimit(
@@ -272,6 +285,8 @@ class CC_EXPORT TileManager {
       const TilePriority& oother_priority,
       MemoryUsage* usage);
   bool TilePriorityViolatesMemoryPolicy(const TilePriority& priority);
+  bool ShouldCompressTile(const Tile* tile) const;
+  void AssignTilesToCompress(PrioritizedWorkToSchedule* work_to_schedule);
   bool AreRequiredTilesReadyToDraw(RasterTilePriorityQueue::Type type) const;
   void CheckIfMoreTilesNeedToBePrepared();
   void CheckAndIssueSignals();
@@ -301,6 +316,7 @@ class CC_EXPORT TileManager {
   GlobalStateThatImpactsTilePriority global_state_;
   size_t scheduled_raster_task_limit_;
   const bool use_partial_raster_;
+  const bool use_stable_tile_compression_;
   bool use_gpu_rasterization_;
 
   std::unordered_map<Tile::Id, Tile*> tiles_;
@@ -337,6 +353,7 @@ class CC_EXPORT TileManager {
 
   std::unordered_map<Tile::Id, std::vector<DrawImage>> scheduled_draw_images_;
   const int max_preraster_distance_in_screen_pixels_;
+  const size_t image_predecode_budget_bytes_;
   std::vector<std::pair<DrawImage, scoped_refptr<TileTask>>> locked_images_;
 
   base::WeakPtrFactory<TileManager> task_set_finished_weak_ptr_factory_;
@@ -312,10 +312,19 @@ TEST_F(TileManagerPerfTest, PrepareTiles) {
   RunPrepareTilesTest("50_1000", 100, 1000);
 }
 
+// Pages with hundreds of small layers, most of which have no tiles left to
+// raster after the first frame.
+TEST_F(TileManagerPerfTest, PrepareTilesManyLayers) {
+  RunPrepareTilesTest("200_10", 200, 10);
+  RunPrepareTilesTest("500_10", 500, 10);
+  RunPrepareTilesTest("500_50", 500, 50);
+}
+
 TEST_F(TileManagerPerfTest, RasterTileQueueConstruct) {
   RunRasterQueueConstructTest("2", 2);
   RunRasterQueueConstructTest("10", 10);
   RunRasterQueueConstructTest("50", 50);
+  RunRasterQueueConstructTest("500", 500);
 }
 
 TEST_F(TileManagerPerfTest, RasterTileQueueConstructAndIterate) {
@@ -337,6 +346,7 @@ TEST_F(TileManagerPerfTest, EvictionTileQueueConstruct) {
   RunEvictionQueueConstructTest("2", 2);
   RunEvictionQueueConstructTest("10", 10);
   RunEvictionQueueConstructTest("50", 50);
+  RunEvictionQueueConstructTest("500", 500);
 }
 
 TEST_F(TileManagerPerfTest, EvictionTileQueueConstructAndIterate) {
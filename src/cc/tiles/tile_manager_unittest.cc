@@ -5,6 +5,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
+
 #include "base/memory/ptr_util.h"
 #include "base/run_loop.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -24,6 +26,7 @@
 #include "cc/test/fake_recording_source.h"
 #include "cc/test/fake_tile_manager.h"
 #include "cc/test/fake_tile_task_manager.h"
+#include "cc/test/skia_common.h"
 #include "cc/test/test_gpu_memory_buffer_manager.h"
 #include "cc/test/test_layer_tree_host_base.h"
 #include "cc/test/test_shared_bitmap_manager.h"
@@ -1886,5 +1889,163 @@ TEST_F(TileManagerTest, PartialRasterSuccessfullyDisabled) {
   RunPartialRasterCheck(TakeHostImpl(), false /* partial_raster_enabled */);
 }
 
+class StableTileCompressionTileManagerTest : public TestLayerTreeHostBase {
+ public:
+  LayerTreeSettings CreateSettings() override {
+    LayerTreeSettings settings = TestLayerTreeHostBase::CreateSettings();
+    settings.use_stable_tile_compression = true;
+    return settings;
+  }
+};
+
+// FakeRasterBufferProviderImpl that supports ETC1 and records the format of
+// the resources it is asked to raster into.
+class RecordFormatRasterBufferProvider : public FakeRasterBufferProviderImpl {
+ public:
+  RecordFormatRasterBufferProvider() {}
+  ~RecordFormatRasterBufferProvider() override {}
+
+  // RasterBufferProvider methods.
+  std::unique_ptr<RasterBuffer> AcquireBufferForRaster(
+      const Resource* resource,
+      uint64_t resource_content_id,
+      uint64_t previous_content_id) override {
+    formats_.push_back(resource->format());
+    return nullptr;
+  }
+  ResourceFormat GetCompressedResourceFormat() const override { return ETC1; }
+
+  size_t CountFormat(ResourceFormat format) const {
+    return std::count(formats_.begin(), formats_.end(), format);
+  }
+
+ private:
+  std::vector<ResourceFormat> formats_;
+};
+
+// Ensures that opaque tiles that kept their resource for a while are rastered
+// again into a compressed resource when other tiles do not fit in memory.
+TEST_F(StableTileCompressionTileManagerTest, CompressesStableTilesWhenOOM) {
+  // Create a FakeTileTaskManagerImpl so that all scheduled work is immediately
+  // cancelled, and the tiles keep their resources.
+  FakeTileTaskManagerImpl tile_task_manager;
+  host_impl()->tile_manager()->SetTileTaskManagerForTesting(&tile_task_manager);
+
+  RecordFormatRasterBufferProvider raster_buffer_provider;
+  host_impl()->tile_manager()->SetRasterBufferProviderForTesting(
+      &raster_buffer_provider);
+
+  const int kLayerId = 7;
+  scoped_refptr<FakeRasterSource> pending_raster_source =
+      FakeRasterSource::CreateFilled(gfx::Size(1000, 1000));
+  host_impl()->CreatePendingTree();
+  LayerTreeImpl* pending_tree = host_impl()->pending_tree();
+
+  std::unique_ptr<FakePictureLayerImpl> pending_layer =
+      FakePictureLayerImpl::CreateWithRasterSource(pending_tree, kLayerId,
+                                                   pending_raster_source);
+  pending_layer->SetDrawsContent(true);
+  pending_layer->SetHasRenderSurface(true);
+  pending_layer->SetContentsOpaque(true);
+  pending_layer->SetBounds(pending_layer->raster_source()->GetSize());
+  pending_tree->SetRootLayerForTesting(std::move(pending_layer));
+
+  // Add tilings/tiles for the layer.
+  host_impl()->pending_tree()->BuildLayerListAndPropertyTreesForTesting();
+  host_impl()->pending_tree()->UpdateDrawProperties(
+      false /* update_lcd_text */);
+
+  // Give a resource to all the tiles but the one with the lowest priority, and
+  // only leave room for the ones they have.
+  std::vector<Tile*> tiles = host_impl()->tile_manager()->AllTilesForTesting();
+  ASSERT_GT(tiles.size(), 1u);
+  host_impl()->tile_manager()->InitializeTilesWithResourcesForTesting(tiles);
+  std::unique_ptr<EvictionTilePriorityQueue> queue(
+      host_impl()->BuildEvictionQueue(SAME_PRIORITY_FOR_BOTH_TREES));
+  ASSERT_FALSE(queue->IsEmpty());
+  host_impl()->tile_manager()->ReleaseTileResourcesForTesting(
+      std::vector<Tile*>(1, queue->Top().tile()));
+
+  auto global_state = host_impl()->global_tile_state();
+  global_state.hard_memory_limit_in_bytes =
+      host_impl()->resource_pool()->memory_usage_bytes();
+  global_state.soft_memory_limit_in_bytes =
+      global_state.hard_memory_limit_in_bytes;
+
+  // Tiles are not compressed until they are stable.
+  for (int i = 0; i < 9; ++i)
+    host_impl()->tile_manager()->PrepareTiles(global_state);
+  EXPECT_EQ(0u, raster_buffer_provider.CountFormat(ETC1));
+  EXPECT_LT(0u, raster_buffer_provider.CountFormat(RGBA_8888));
+
+  host_impl()->tile_manager()->PrepareTiles(global_state);
+  EXPECT_LT(0u, raster_buffer_provider.CountFormat(ETC1));
+  EXPECT_GE(4u, raster_buffer_provider.CountFormat(ETC1));
+
+  // Free our host_impl_ before the tile_task_manager we passed it, as it
+  // will use that class in clean up.
+  TakeHostImpl();
+}
+
+class ImagePredecodeTileManagerTest : public TestLayerTreeHostBase {
+ public:
+  LayerTreeSettings CreateSettings() override {
+    LayerTreeSettings settings = TestLayerTreeHostBase::CreateSettings();
+    settings.image_predecode_budget_bytes = 64 * 1024 * 1024;
+    return settings;
+  }
+};
+
+// FakeTileTaskManagerImpl that records the size of the last scheduled graph.
+class CountingTileTaskManager : public FakeTileTaskManagerImpl {
+ public:
+  CountingTileTaskManager() : scheduled_task_count_(0) {}
+  ~CountingTileTaskManager() override {}
+
+  void ScheduleTasks(TaskGraph* graph) override {
+    scheduled_task_count_ = graph->nodes.size();
+    FakeTileTaskManagerImpl::ScheduleTasks(graph);
+  }
+
+  size_t scheduled_task_count() const { return scheduled_task_count_; }
+
+ private:
+  size_t scheduled_task_count_;
+};
+
+// Ensures that the images of tiles that don't fit in the raster task limit
+// are decoded ahead of time.
+TEST_F(ImagePredecodeTileManagerTest, PredecodesImagesOverRasterTaskLimit) {
+  CountingTileTaskManager tile_task_manager;
+  host_impl()->tile_manager()->SetTileTaskManagerForTesting(&tile_task_manager);
+
+  // Spread 100 images over the layer, so that every tile has some.
+  gfx::Size layer_bounds(1000, 1000);
+  std::unique_ptr<FakeRecordingSource> recording_source =
+      FakeRecordingSource::CreateFilledRecordingSource(layer_bounds);
+  recording_source->SetGenerateDiscardableImagesMetadata(true);
+  for (int x = 0; x < layer_bounds.width(); x += 100) {
+    for (int y = 0; y < layer_bounds.height(); y += 100) {
+      recording_source->add_draw_image(
+          CreateDiscardableImage(gfx::Size(50, 50)), gfx::Point(x, y));
+    }
+  }
+  recording_source->Rerecord();
+  scoped_refptr<RasterSource> raster_source =
+      RasterSource::CreateFromRecordingSource(recording_source.get(), false);
+  SetupPendingTree(raster_source);
+
+  host_impl()->tile_manager()->SetScheduledRasterTaskLimitForTesting(1);
+  host_impl()->tile_manager()->PrepareTiles(host_impl()->global_tile_state());
+
+  // Without predecodes, the graph would only have the raster task of one tile,
+  // the decode tasks of at most 9 images in it, and 3 task set finished tasks.
+  EXPECT_LT(13u, tile_task_manager.scheduled_task_count());
+
+  // Free our host_impl_ before the tile_task_manager we passed it, as it
+  // will use that class in clean up.
+  TakeHostImpl();
+}
+
 }  // namespace
 }  // namespace cc
@@ -315,11 +315,18 @@ void CalculateVisibleRects(
     const TransformTree& transform_tree,
     const EffectTree& effect_tree,
     bool non_root_surfaces_enabled) {
+  // Looking for copy requests walks up the effect tree from every layer, so
+  // skip it when the tree has none.
+  const bool has_copy_requests =
+      effect_tree.size() > 1 &&
+      effect_tree.Node(1)->data.num_copy_requests_in_subtree > 0;
   for (auto& layer : visible_layer_list) {
     gfx::Size layer_bounds = layer->bounds();
 
     int effect_ancestor_with_copy_request =
-        effect_tree.ClosestAncestorWithCopyRequest(layer->effect_tree_index());
+        has_copy_requests ? effect_tree.ClosestAncestorWithCopyRequest(
+                                layer->effect_tree_index())
+                          : -1;
     if (effect_ancestor_with_copy_request > 1) {
       // Non root copy request.
       ConditionalClip accumulated_clip_rect = ComputeAccumulatedClip(
@@ -1430,6 +1430,15 @@ void LayerTreeHost::SetElementScrollOffsetMutated(
   layer->OnScrollOffsetAnimated(scroll_offset);
 }
 
+void LayerTreeHost::SetElementBackgroundColorMutated(
+    ElementId element_id,
+    ElementListType list_type,
+    SkColor background_color) {
+  Layer* layer = LayerByElementId(element_id);
+  DCHECK(layer);
+  layer->OnBackgroundColorAnimated(background_color);
+}
+
 void LayerTreeHost::ElementTransformIsAnimatingChanged(
     ElementId element_id,
     ElementListType list_type,
@@ -382,6 +382,9 @@ class CC_EXPORT LayerTreeHost : public MutatorHostClient {
       ElementId element_id,
       ElementListType list_type,
       const gfx::ScrollOffset& scroll_offset) override;
+  void SetElementBackgroundColorMutated(ElementId element_id,
+                                        ElementListType list_type,
+                                        SkColor background_color) override;
   void ElementTransformIsAnimatingChanged(ElementId element_id,
                                           ElementListType list_type,
                                           AnimationChangeType change_type,
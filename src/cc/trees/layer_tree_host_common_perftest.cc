@@ -16,6 +16,7 @@
 #include "base/time/time.h"
 #include "cc/debug/lap_timer.h"
 #include "cc/layers/layer.h"
+#include "cc/layers/picture_layer.h"
 #include "cc/output/bsp_tree.h"
 #include "cc/quads/draw_polygon.h"
 #include "cc/quads/draw_quad.h"
@@ -40,7 +41,9 @@ class LayerTreeHostCommonPerfTest : public LayerTreeTest {
   LayerTreeHostCommonPerfTest()
       : timer_(kWarmupRuns,
                base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
-               kTimeCheckInterval) {}
+               kTimeCheckInterval),
+        generated_tree_width_(0),
+        generated_tree_depth_(0) {}
 
   void ReadTestFile(const std::string& name) {
     base::FilePath test_data_dir;
@@ -49,11 +52,45 @@ class LayerTreeHostCommonPerfTest : public LayerTreeTest {
     ASSERT_TRUE(base::ReadFileToString(json_file, &json_));
   }
 
+  // Uses a tree of |width| chains of |depth| nested layers instead of a test
+  // file.
+  void GenerateTree(int width, int depth) {
+    generated_tree_width_ = width;
+    generated_tree_depth_ = depth;
+  }
+
+  scoped_refptr<Layer> CreateGeneratedTree(const gfx::Size& viewport) {
+    scoped_refptr<Layer> root = Layer::Create();
+    root->SetBounds(viewport);
+    for (int i = 0; i < generated_tree_width_; ++i) {
+      scoped_refptr<Layer> parent = root;
+      for (int j = 0; j < generated_tree_depth_; ++j) {
+        scoped_refptr<PictureLayer> layer =
+            PictureLayer::Create(&content_layer_client_);
+        layer->SetIsDrawable(true);
+        layer->SetBounds(gfx::Size(100, 100));
+        layer->SetPosition(gfx::PointF(i % 7, j % 5));
+        // Give every layer its own transform node, and every other layer a
+        // clip node.
+        gfx::Transform transform;
+        transform.Rotate(1.0);
+        layer->SetTransform(transform);
+        layer->SetMasksToBounds(j % 2 == 0);
+        parent->AddChild(layer);
+        parent = layer;
+      }
+    }
+    return root;
+  }
+
   void SetupTree() override {
     gfx::Size viewport = gfx::Size(720, 1038);
     layer_tree_host()->SetViewportSize(viewport);
-    scoped_refptr<Layer> root =
-        ParseTreeFromJson(json_, &content_layer_client_);
+    scoped_refptr<Layer> root;
+    if (generated_tree_width_)
+      root = CreateGeneratedTree(viewport);
+    else
+      root = ParseTreeFromJson(json_, &content_layer_client_);
     ASSERT_TRUE(root.get());
     layer_tree_host()->SetRootLayer(root);
     content_layer_client_.set_bounds(viewport);
@@ -76,6 +113,8 @@ class LayerTreeHostCommonPerfTest : public LayerTreeTest {
   LapTimer timer_;
   std::string test_name_;
   std::string json_;
+  int generated_tree_width_;
+  int generated_tree_depth_;
 };
 
 class CalcDrawPropsTest : public LayerTreeHostCommonPerfTest {
@@ -211,6 +250,24 @@ TEST_F(CalcDrawPropsTest, TouchRegionHeavy) {
   RunCalcDrawProps();
 }
 
+TEST_F(CalcDrawPropsTest, Deep) {
+  SetTestName("deep_1_200");
+  GenerateTree(1, 200);
+  RunCalcDrawProps();
+}
+
+TEST_F(CalcDrawPropsTest, Wide) {
+  SetTestName("wide_1000_1");
+  GenerateTree(1000, 1);
+  RunCalcDrawProps();
+}
+
+TEST_F(CalcDrawPropsTest, WideAndDeep) {
+  SetTestName("wide_and_deep_50_20");
+  GenerateTree(50, 20);
+  RunCalcDrawProps();
+}
+
 TEST_F(BspTreePerfTest, LayerSorterCubes) {
   SetTestName("layer_sort_cubes");
   ReadTestFile("layer_sort_cubes");
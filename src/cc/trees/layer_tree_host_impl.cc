@@ -74,6 +74,7 @@
 #include "cc/tiles/gpu_image_decode_controller.h"
 #include "cc/tiles/picture_layer_tiling.h"
 #include "cc/tiles/raster_tile_priority_queue.h"
+#include "cc/tiles/shared_gpu_image_decode_controller.h"
 #include "cc/tiles/software_image_decode_controller.h"
 #include "cc/tiles/tile_task_manager.h"
 #include "cc/trees/damage_tracker.h"
@@ -229,7 +230,9 @@ LayerTreeHostImpl::LayerTreeHostImpl(
                         ? std::numeric_limits<size_t>::max()
                         : settings.scheduled_raster_task_limit,
                     settings.use_partial_raster,
-                    settings.max_preraster_distance_in_screen_pixels),
+                    settings.use_stable_tile_compression,
+                    settings.max_preraster_distance_in_screen_pixels,
+                    settings.image_predecode_budget_bytes),
       pinch_gesture_active_(false),
       pinch_gesture_end_should_clear_scrolling_layer_(false),
       fps_counter_(
@@ -1736,6 +1739,19 @@ void LayerTreeHostImpl::DrawLayers(FrameData* frame) {
   // The render passes should be consumed by the renderer.
   DCHECK(frame->render_passes.empty());
 
+  // The GPU timings of earlier frames and raster tasks that completed by now.
+  std::vector<base::TimeDelta> gpu_draw_durations;
+  std::vector<base::TimeDelta> gpu_raster_durations;
+  renderer_->TakeCompletedGpuDrawDurations(&gpu_draw_durations);
+  if (raster_buffer_provider_) {
+    raster_buffer_provider_->TakeCompletedGpuRasterDurations(
+        &gpu_raster_durations);
+  }
+  if (!gpu_draw_durations.empty() || !gpu_raster_durations.empty()) {
+    client_->DidMeasureGpuTimesOnImplThread(gpu_draw_durations,
+                                            gpu_raster_durations);
+  }
+
   // The next frame should start by assuming nothing has changed, and changes
   // are noted as they occur.
   // TODO(boliu): If we did a temporary software renderer frame, propogate the
@@ -2266,7 +2282,12 @@ void LayerTreeHostImpl::CreateTileManagerResources() {
   CreateResourceAndRasterBufferProvider(&raster_buffer_provider_,
                                         &resource_pool_);
 
-  if (use_gpu_rasterization_) {
+  if (use_gpu_rasterization_ && settings_.share_gpu_decoded_images) {
+    image_decode_controller_ = SharedGpuImageDecodeController::Create(
+        output_surface_->worker_context_provider(),
+        settings_.renderer_settings.preferred_tile_format,
+        settings_.gpu_decoded_image_budget_bytes);
+  } else if (use_gpu_rasterization_) {
     image_decode_controller_ = base::WrapUnique(new GpuImageDecodeController(
         output_surface_->worker_context_provider(),
         settings_.renderer_settings.preferred_tile_format,
@@ -2353,7 +2374,8 @@ void LayerTreeHostImpl::CreateResourceAndRasterBufferProvider(
 
     *raster_buffer_provider = ZeroCopyRasterBufferProvider::Create(
         resource_provider_.get(),
-        settings_.renderer_settings.preferred_tile_format);
+        settings_.renderer_settings.preferred_tile_format,
+        settings_.use_partial_raster);
     return;
   }
 
@@ -4012,6 +4034,18 @@ void LayerTreeHostImpl::SetTreeLayerScrollOffsetMutated(
   }
 }
 
+void LayerTreeHostImpl::SetTreeLayerBackgroundColorMutated(
+    ElementId element_id,
+    LayerTreeImpl* tree,
+    SkColor background_color) {
+  if (!tree)
+    return;
+
+  LayerImpl* layer = tree->LayerByElementId(element_id);
+  if (layer)
+    layer->OnBackgroundColorAnimated(background_color);
+}
+
 bool LayerTreeHostImpl::AnimationsPreserveAxisAlignment(
     const LayerImpl* layer) const {
   return animation_host_->AnimationsPreserveAxisAlignment(layer->element_id());
@@ -4064,6 +4098,21 @@ void LayerTreeHostImpl::SetElementScrollOffsetMutated(
   }
 }
 
+void LayerTreeHostImpl::SetElementBackgroundColorMutated(
+    ElementId element_id,
+    ElementListType list_type,
+    SkColor background_color) {
+  if (list_type == ElementListType::ACTIVE) {
+    SetTreeLayerBackgroundColorMutated(element_id, active_tree(),
+                                       background_color);
+  } else {
+    SetTreeLayerBackgroundColorMutated(element_id, pending_tree(),
+                                       background_color);
+    SetTreeLayerBackgroundColorMutated(element_id, recycle_tree(),
+                                       background_color);
+  }
+}
+
 #if defined(OS_WEBOS)
 void LayerTreeHostImpl::WebOSClearCurrentlyScrollingLayer() {
   ClearCurrentlyScrollingLayer();
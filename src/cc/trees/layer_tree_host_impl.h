@@ -127,6 +127,12 @@ class LayerTreeHostImplClient {
   virtual void WillPrepareTiles() = 0;
   virtual void DidPrepareTiles() = 0;
 
+  // Called with how long the GPU took to draw frames and to raster tiles, as
+  // the timings become available, which is some frames after the fact.
+  virtual void DidMeasureGpuTimesOnImplThread(
+      const std::vector<base::TimeDelta>& draw_durations,
+      const std::vector<base::TimeDelta>& raster_durations) = 0;
+
   // Called when page scale animation has completed on the impl thread.
   virtual void DidCompletePageScaleAnimationOnImplThread() = 0;
 
@@ -261,6 +267,9 @@ class CC_EXPORT LayerTreeHostImpl
   void SetTreeLayerScrollOffsetMutated(ElementId element_id,
                                        LayerTreeImpl* tree,
                                        const gfx::ScrollOffset& scroll_offset);
+  void SetTreeLayerBackgroundColorMutated(ElementId element_id,
+                                          LayerTreeImpl* tree,
+                                          SkColor background_color);
   bool AnimationsPreserveAxisAlignment(const LayerImpl* layer) const;
 
   // MutatorHostClient implementation.
@@ -281,6 +290,9 @@ class CC_EXPORT LayerTreeHostImpl
       ElementId element_id,
       ElementListType list_type,
       const gfx::ScrollOffset& scroll_offset) override;
+  void SetElementBackgroundColorMutated(ElementId element_id,
+                                        ElementListType list_type,
+                                        SkColor background_color) override;
 #if defined(OS_WEBOS)
   void WebOSClearCurrentlyScrollingLayer() override;
   void WebOSSetCurrentlyScrollingElement(ElementId element_id) override;
@@ -162,6 +162,9 @@ class LayerTreeHostImplTest : public testing::Test,
   void DidActivateSyncTree() override {}
   void WillPrepareTiles() override {}
   void DidPrepareTiles() override {}
+  void DidMeasureGpuTimesOnImplThread(
+      const std::vector<base::TimeDelta>& draw_durations,
+      const std::vector<base::TimeDelta>& raster_durations) override {}
   void DidCompletePageScaleAnimationOnImplThread() override {
     did_complete_page_scale_animation_ = true;
   }
@@ -67,6 +67,8 @@ bool LayerTreeSettings::operator==(const LayerTreeSettings& other) const {
              other.use_external_begin_frame_source &&
          main_frame_before_activation_enabled ==
              other.main_frame_before_activation_enabled &&
+         use_predictive_begin_frame_deadline ==
+             other.use_predictive_begin_frame_deadline &&
          using_synchronous_renderer_compositor ==
              other.using_synchronous_renderer_compositor &&
          can_use_lcd_text == other.can_use_lcd_text &&
@@ -107,6 +109,7 @@ bool LayerTreeSettings::operator==(const LayerTreeSettings& other) const {
              other.max_memory_for_prepaint_percentage &&
          use_zero_copy == other.use_zero_copy &&
          use_partial_raster == other.use_partial_raster &&
+         use_stable_tile_compression == other.use_stable_tile_compression &&
          enable_elastic_overscroll == other.enable_elastic_overscroll &&
          use_image_texture_targets == other.use_image_texture_targets &&
          ignore_root_layer_flings == other.ignore_root_layer_flings &&
@@ -131,6 +134,8 @@ void LayerTreeSettings::ToProtobuf(proto::LayerTreeSettings* proto) const {
   proto->set_use_external_begin_frame_source(use_external_begin_frame_source);
   proto->set_main_frame_before_activation_enabled(
       main_frame_before_activation_enabled);
+  proto->set_use_predictive_begin_frame_deadline(
+      use_predictive_begin_frame_deadline);
   proto->set_using_synchronous_renderer_compositor(
       using_synchronous_renderer_compositor);
   proto->set_can_use_lcd_text(can_use_lcd_text);
@@ -169,6 +174,7 @@ void LayerTreeSettings::ToProtobuf(proto::LayerTreeSettings* proto) const {
       max_memory_for_prepaint_percentage);
   proto->set_use_zero_copy(use_zero_copy);
   proto->set_use_partial_raster(use_partial_raster);
+  proto->set_use_stable_tile_compression(use_stable_tile_compression);
   proto->set_enable_elastic_overscroll(enable_elastic_overscroll);
   proto->set_ignore_root_layer_flings(ignore_root_layer_flings);
   proto->set_scheduled_raster_task_limit(scheduled_raster_task_limit);
@@ -193,6 +199,8 @@ void LayerTreeSettings::FromProtobuf(const proto::LayerTreeSettings& proto) {
   use_external_begin_frame_source = proto.use_external_begin_frame_source();
   main_frame_before_activation_enabled =
       proto.main_frame_before_activation_enabled();
+  use_predictive_begin_frame_deadline =
+      proto.use_predictive_begin_frame_deadline();
   using_synchronous_renderer_compositor =
       proto.using_synchronous_renderer_compositor();
   can_use_lcd_text = proto.can_use_lcd_text();
@@ -231,6 +239,7 @@ void LayerTreeSettings::FromProtobuf(const proto::LayerTreeSettings& proto) {
       proto.max_memory_for_prepaint_percentage();
   use_zero_copy = proto.use_zero_copy();
   use_partial_raster = proto.use_partial_raster();
+  use_stable_tile_compression = proto.use_stable_tile_compression();
   enable_elastic_overscroll = proto.enable_elastic_overscroll();
   // |use_image_texture_targets| contains default values, so clear first.
   use_image_texture_targets.clear();
@@ -256,6 +265,8 @@ SchedulerSettings LayerTreeSettings::ToSchedulerSettings() const {
       use_external_begin_frame_source;
   scheduler_settings.main_frame_before_activation_enabled =
       main_frame_before_activation_enabled;
+  scheduler_settings.use_predictive_begin_frame_deadline =
+      use_predictive_begin_frame_deadline;
   scheduler_settings.timeout_and_draw_when_animation_checkerboards =
       timeout_and_draw_when_animation_checkerboards;
   scheduler_settings.using_synchronous_renderer_compositor =
@@ -43,6 +43,7 @@ class CC_EXPORT LayerTreeSettings {
   // TODO(enne): Temporary staging for unified begin frame source work.
   bool use_output_surface_begin_frame_source = false;
   bool main_frame_before_activation_enabled = false;
+  bool use_predictive_begin_frame_deadline = false;
   bool using_synchronous_renderer_compositor = false;
   bool can_use_lcd_text = true;
   bool use_distance_field_text = false;
@@ -84,6 +85,9 @@ class CC_EXPORT LayerTreeSettings {
   size_t max_memory_for_prepaint_percentage = 100;
   bool use_zero_copy = false;
   bool use_partial_raster = false;
+  // Raster opaque tiles that stayed resident for a while again into a
+  // compressed resource, to fit more tiles in the same memory budget.
+  bool use_stable_tile_compression = false;
   bool enable_elastic_overscroll = false;
   // An array of image texture targets for each GpuMemoryBuffer format.
   std::vector<unsigned> use_image_texture_targets;
@@ -98,8 +102,15 @@ class CC_EXPORT LayerTreeSettings {
   int max_staging_buffer_usage_in_bytes = 32 * 1024 * 1024;
   ManagedMemoryPolicy memory_policy_;
   size_t gpu_decoded_image_budget_bytes = 96 * 1024 * 1024;
+  // Share the uploaded images, and their budget, with the other compositors
+  // that use the same worker context.
+  bool share_gpu_decoded_images = false;
   size_t software_decoded_image_budget_bytes = 128 * 1024 * 1024;
   int max_preraster_distance_in_screen_pixels = 1000;
+  // Budget for decoding the images of prepaint tiles that didn't fit in the
+  // raster limits, so that they are decoded by the time those tiles raster.
+  // Zero disables these predecodes.
+  size_t image_predecode_budget_bytes = 0;
 
   // If set to true, the display item list will internally cache a SkPicture for
   // raster rather than directly using the display items.
@@ -35,6 +35,8 @@ TEST(LayerTreeSettingsTest, AllMembersChanged) {
       !settings.use_external_begin_frame_source;
   settings.main_frame_before_activation_enabled =
       !settings.main_frame_before_activation_enabled;
+  settings.use_predictive_begin_frame_deadline =
+      !settings.use_predictive_begin_frame_deadline;
   settings.using_synchronous_renderer_compositor =
       !settings.using_synchronous_renderer_compositor;
   settings.can_use_lcd_text = !settings.can_use_lcd_text;
@@ -76,6 +78,7 @@ TEST(LayerTreeSettingsTest, AllMembersChanged) {
       settings.max_memory_for_prepaint_percentage * 3 + 1;
   settings.use_zero_copy = !settings.use_zero_copy;
   settings.use_partial_raster = !settings.use_partial_raster;
+  settings.use_stable_tile_compression = !settings.use_stable_tile_compression;
   settings.enable_elastic_overscroll = !settings.enable_elastic_overscroll;
   settings.use_image_texture_targets.push_back(54);
   settings.use_image_texture_targets.push_back(55);
@@ -104,6 +107,7 @@ TEST(LayerTreeSettingsTest, ArbitraryValues) {
   settings.single_thread_proxy_scheduler = true;
   settings.use_external_begin_frame_source = true;
   settings.main_frame_before_activation_enabled = true;
+  settings.use_predictive_begin_frame_deadline = true;
   settings.using_synchronous_renderer_compositor = false;
   settings.can_use_lcd_text = false;
   settings.use_distance_field_text = false;
@@ -134,6 +138,7 @@ TEST(LayerTreeSettingsTest, ArbitraryValues) {
   settings.max_memory_for_prepaint_percentage = 62;
   settings.use_zero_copy = true;
   settings.use_partial_raster = true;
+  settings.use_stable_tile_compression = true;
   settings.enable_elastic_overscroll = false;
   settings.use_image_texture_targets.push_back(10);
   settings.use_image_texture_targets.push_back(19);
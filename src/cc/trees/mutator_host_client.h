@@ -6,6 +6,7 @@
 #define CC_TREES_MUTATOR_HOST_CLIENT_H_
 
 #include "cc/animation/element_id.h"
+#include "third_party/skia/include/core/SkColor.h"
 
 namespace gfx {
 class Transform;
@@ -41,6 +42,9 @@ class MutatorHostClient {
       ElementId element_id,
       ElementListType list_type,
       const gfx::ScrollOffset& scroll_offset) = 0;
+  virtual void SetElementBackgroundColorMutated(ElementId element_id,
+                                                ElementListType list_type,
+                                                SkColor background_color) = 0;
 
   virtual void ElementTransformIsAnimatingChanged(
       ElementId element_id,
@@ -493,6 +493,13 @@ void ProxyImpl::DidPrepareTiles() {
   scheduler_->DidPrepareTiles();
 }
 
+void ProxyImpl::DidMeasureGpuTimesOnImplThread(
+    const std::vector<base::TimeDelta>& draw_durations,
+    const std::vector<base::TimeDelta>& raster_durations) {
+  DCHECK(IsImplThread());
+  scheduler_->DidMeasureGpuTimes(draw_durations, raster_durations);
+}
+
 void ProxyImpl::DidCompletePageScaleAnimationOnImplThread() {
   DCHECK(IsImplThread());
   channel_impl_->DidCompletePageScaleAnimation();
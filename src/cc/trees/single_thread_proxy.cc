@@ -485,6 +485,16 @@ void SingleThreadProxy::DidPrepareTiles() {
     scheduler_on_impl_thread_->DidPrepareTiles();
 }
 
+void SingleThreadProxy::DidMeasureGpuTimesOnImplThread(
+    const std::vector<base::TimeDelta>& draw_durations,
+    const std::vector<base::TimeDelta>& raster_durations) {
+  DCHECK(task_runner_provider_->IsImplThread());
+  if (scheduler_on_impl_thread_) {
+    scheduler_on_impl_thread_->DidMeasureGpuTimes(draw_durations,
+                                                  raster_durations);
+  }
+}
+
 void SingleThreadProxy::DidCompletePageScaleAnimationOnImplThread() {
   layer_tree_host_->DidCompletePageScaleAnimation();
 }
@@ -104,6 +104,9 @@ class CC_EXPORT SingleThreadProxy : public Proxy,
   void DidActivateSyncTree() override;
   void WillPrepareTiles() override;
   void DidPrepareTiles() override;
+  void DidMeasureGpuTimesOnImplThread(
+      const std::vector<base::TimeDelta>& draw_durations,
+      const std::vector<base::TimeDelta>& raster_durations) override;
   void DidCompletePageScaleAnimationOnImplThread() override;
   void OnDrawForOutputSurface(bool resourceless_software_draw) override;
 
@@ -781,3 +781,12 @@ void ChromeMetricsServiceClient::OnURLOpenedFromOmnibox(OmniboxLog* log) {
 bool ChromeMetricsServiceClient::IsUMACellularUploadLogicEnabled() {
   return metrics::IsCellularLogicEnabled();
 }
+
+scoped_refptr<base::TaskRunner>
+ChromeMetricsServiceClient::GetLogSerializationTaskRunner() {
+  // A log that isn't stored before shutdown is lost either way, so don't
+  // block shutdown on it.
+  return content::BrowserThread::GetBlockingPool()
+      ->GetTaskRunnerWithShutdownBehavior(
+          base::SequencedWorkerPool::SKIP_ON_SHUTDOWN);
+}
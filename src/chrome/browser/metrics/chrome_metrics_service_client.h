@@ -79,6 +79,7 @@ class ChromeMetricsServiceClient
   bool IsReportingPolicyManaged() override;
   metrics::EnableMetricsDefault GetMetricsReportingDefaultState() override;
   bool IsUMACellularUploadLogicEnabled() override;
+  scoped_refptr<base::TaskRunner> GetLogSerializationTaskRunner() override;
 
   // Persistent browser metrics need to be persisted somewhere. This constant
   // provides a known string to be used for both the allocator's internal name
@@ -2,9 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include <algorithm>
-#include <iterator>
 #include <utility>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/memory/ptr_util.h"
@@ -19,6 +18,7 @@
 #include "components/subresource_filter/core/browser/ruleset_service.h"
 #include "components/subresource_filter/core/browser/subresource_filter_features.h"
 #include "components/subresource_filter/core/browser/subresource_filter_features_test_support.h"
+#include "components/subresource_filter/core/common/indexed_ruleset.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/test/browser_test_utils.h"
@@ -87,10 +87,14 @@ class SubresourceFilterBrowserTest : public InProcessBrowserTest {
   }
 
   void SetRulesetToDisallowURLsWithPathSuffix(const std::string& suffix) {
-    static_assert(sizeof(char) == sizeof(uint8_t), "Assumed char was byte.");
-    std::vector<uint8_t> buffer;
-    std::transform(suffix.begin(), suffix.end(), std::back_inserter(buffer),
-                   [](char c) { return static_cast<uint8_t>(c); });
+    UrlRule rule;
+    rule.url_pattern = suffix;
+    rule.anchor_right = UrlRule::ANCHOR_BOUNDARY;
+    RulesetIndexer indexer;
+    ASSERT_TRUE(indexer.AddUrlRule(rule));
+    indexer.Finish();
+    std::vector<uint8_t> buffer(indexer.data(),
+                                indexer.data() + indexer.size());
     RulesetDistributionListener* listener = new RulesetDistributionListener();
     g_browser_process->subresource_filter_ruleset_service()
         ->RegisterDistributor(base::WrapUnique(listener));
@@ -19,6 +19,10 @@
 namespace history {
 namespace {
 
+// The number of URLs that IterateUrlsDBTask enumerates before letting the
+// other tasks on the history thread run.
+const int kURLsPerBatch = 1000;
+
 // URLIterator from std::vector<GURL>
 class URLIteratorFromURLs : public visitedlink::VisitedLinkMaster::URLIterator {
  public:
@@ -37,7 +41,9 @@ class URLIteratorFromURLs : public visitedlink::VisitedLinkMaster::URLIterator {
 };
 
 // IterateUrlsDBTask bridge HistoryBackend::URLEnumerator to
-// visitedlink::VisitedLinkDelegate::URLEnumerator.
+// visitedlink::VisitedLinkDelegate::URLEnumerator. With a large history this
+// takes a while, so the URLs are enumerated in batches, yielding to the other
+// tasks on the history thread in between.
 class IterateUrlsDBTask : public HistoryDBTask {
  public:
   explicit IterateUrlsDBTask(const scoped_refptr<
@@ -51,12 +57,15 @@ class IterateUrlsDBTask : public HistoryDBTask {
 
   scoped_refptr<visitedlink::VisitedLinkDelegate::URLEnumerator> enumerator_;
 
+  // The id of the last URL enumerated.
+  URLID last_url_id_;
+
   DISALLOW_COPY_AND_ASSIGN(IterateUrlsDBTask);
 };
 
 IterateUrlsDBTask::IterateUrlsDBTask(const scoped_refptr<
     visitedlink::VisitedLinkDelegate::URLEnumerator>& enumerator)
-    : enumerator_(enumerator) {
+    : enumerator_(enumerator), last_url_id_(0) {
 }
 
 IterateUrlsDBTask::~IterateUrlsDBTask() {
@@ -64,17 +73,23 @@ IterateUrlsDBTask::~IterateUrlsDBTask() {
 
 bool IterateUrlsDBTask::RunOnDBThread(HistoryBackend* backend,
                                       HistoryDatabase* db) {
-  bool success = false;
-  if (db) {
-    HistoryDatabase::URLEnumerator iter;
-    if (db->InitURLEnumeratorForEverything(&iter)) {
-      URLRow row;
-      while (iter.GetNextURL(&row))
-        enumerator_->OnURL(row.url());
-      success = true;
-    }
+  HistoryDatabase::URLEnumerator iter;
+  if (!db || !db->InitURLEnumeratorForBatch(last_url_id_, kURLsPerBatch,
+                                            &iter)) {
+    enumerator_->OnComplete(false);
+    return true;
   }
-  enumerator_->OnComplete(success);
+
+  URLRow row;
+  int url_count = 0;
+  for (; iter.GetNextURL(&row); ++url_count) {
+    enumerator_->OnURL(row.url());
+    last_url_id_ = row.id();
+  }
+  if (url_count == kURLsPerBatch)
+    return false;  // Continue after the other tasks.
+
+  enumerator_->OnComplete(true);
   return true;
 }
 
@@ -459,6 +459,10 @@ void HistoryBackend::AddPage(const HistoryAddPageArgs& request) {
   if (!db_)
     return;
 
+  // Leave the updates of the URL rows visited pending, so that a burst of
+  // navigations writes each row once in the next commit.
+  HistoryDatabase::ScopedURLRowBatch url_row_batch(db_.get());
+
   // Will be filled with the URL ID and the visit ID of the last addition.
   std::pair<URLID, VisitID> last_ids(
       0, tracker_.GetLastVisit(request.context_id, request.nav_entry_id,
@@ -2207,7 +2211,13 @@ void HistoryBackend::Commit() {
   // some cases) but it hasn't been important yet.
   CancelScheduledCommit();
 
+  base::TimeTicks commit_start_time = base::TimeTicks::Now();
+  size_t url_rows_written = db_->FlushPendingURLRowUpdates();
   db_->CommitTransaction();
+  UMA_HISTOGRAM_TIMES("History.CommitTime",
+                      base::TimeTicks::Now() - commit_start_time);
+  UMA_HISTOGRAM_COUNTS_1000("History.CommitURLRowsWritten",
+                            static_cast<int>(url_rows_written));
   DCHECK_EQ(db_->transaction_nesting(), 0)
       << "Somebody left a transaction open";
   db_->BeginTransaction();
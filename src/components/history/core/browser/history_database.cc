@@ -47,7 +47,8 @@ HistoryDatabase::HistoryDatabase(
     DownloadInterruptReason download_interrupt_reason_none,
     DownloadInterruptReason download_interrupt_reason_crash)
     : DownloadDatabase(download_interrupt_reason_none,
-                       download_interrupt_reason_crash) {
+                       download_interrupt_reason_crash),
+      url_row_batch_depth_(0) {
 }
 
 HistoryDatabase::~HistoryDatabase() {
@@ -112,7 +113,13 @@ sql::InitStatus HistoryDatabase::Init(const base::FilePath& history_name) {
   if (version_status != sql::INIT_OK)
     return version_status;
 
-  return committer.Commit() ? sql::INIT_OK : sql::INIT_FAILURE;
+  if (!committer.Commit())
+    return sql::INIT_FAILURE;
+
+  // The urls row of a page is updated on every visit to it, so repeated
+  // updates are written once per commit. See ScopedURLRowBatch.
+  set_defer_url_row_updates(true);
+  return sql::INIT_OK;
 }
 
 void HistoryDatabase::ComputeDatabaseMetrics(
@@ -124,7 +131,8 @@ void HistoryDatabase::ComputeDatabaseMetrics(
   int file_mb = static_cast<int>(file_size / (1024 * 1024));
   UMA_HISTOGRAM_MEMORY_MB("History.DatabaseFileMB", file_mb);
 
-  sql::Statement url_count(db_.GetUniqueStatement("SELECT count(*) FROM urls"));
+  sql::Statement url_count(
+      GetDB().GetUniqueStatement("SELECT count(*) FROM urls"));
   if (!url_count.Step())
     return;
   UMA_HISTOGRAM_COUNTS("History.URLTableCount", url_count.ColumnInt(0));
@@ -164,7 +172,7 @@ void HistoryDatabase::ComputeDatabaseMetrics(
     start_time = base::TimeTicks::Now();
 
     // Collect all URLs visited within the last month.
-    sql::Statement url_sql(db_.GetUniqueStatement(
+    sql::Statement url_sql(GetDB().GetUniqueStatement(
         "SELECT url, last_visit_time FROM urls WHERE last_visit_time > ?"));
     url_sql.BindInt64(0, one_month_ago.ToInternalValue());
 
@@ -200,7 +208,7 @@ TopHostsList HistoryDatabase::TopHosts(size_t num_hosts) {
   base::Time one_month_ago =
       std::max(base::Time::Now() - base::TimeDelta::FromDays(30), base::Time());
 
-  sql::Statement url_sql(db_.GetUniqueStatement(
+  sql::Statement url_sql(GetDB().GetUniqueStatement(
       "SELECT url, visit_count FROM urls WHERE last_visit_time > ?"));
   url_sql.BindInt64(0, one_month_ago.ToInternalValue());
 
@@ -255,10 +263,13 @@ void HistoryDatabase::BeginTransaction() {
 }
 
 void HistoryDatabase::CommitTransaction() {
+  FlushPendingURLRowUpdates();
   db_.CommitTransaction();
 }
 
 void HistoryDatabase::RollbackTransaction() {
+  // Deferred updates were made in this transaction, so go with it.
+  FlushPendingURLRowUpdates();
   db_.RollbackTransaction();
 }
 
@@ -293,6 +304,7 @@ void HistoryDatabase::TrimMemory(bool aggressively) {
 }
 
 bool HistoryDatabase::Raze() {
+  FlushPendingURLRowUpdates();
   return db_.Raze();
 }
 
@@ -341,7 +353,20 @@ void HistoryDatabase::UpdateEarlyExpirationThreshold(base::Time threshold) {
   cached_early_expiration_threshold_ = threshold;
 }
 
+HistoryDatabase::ScopedURLRowBatch::ScopedURLRowBatch(HistoryDatabase* db)
+    : db_(db) {
+  db_->url_row_batch_depth_++;
+}
+
+HistoryDatabase::ScopedURLRowBatch::~ScopedURLRowBatch() {
+  db_->url_row_batch_depth_--;
+}
+
 sql::Connection& HistoryDatabase::GetDB() {
+  // Queries other than URLDatabase's row lookups don't see deferred updates,
+  // so they're written first unless a batch is open.
+  if (!url_row_batch_depth_ && HasCachedURLRows())
+    FlushPendingURLRowUpdates();
   return db_;
 }
 
@@ -63,6 +63,24 @@ class HistoryDatabase : public DownloadDatabase,
     HistoryDatabase* db_;
   };
 
+  // Keeps URL row updates deferred while it is alive, see
+  // URLDatabase::set_defer_url_row_updates(). Without one, any query other
+  // than URLDatabase's row lookups writes the deferred updates out first.
+  // Code run inside one must not depend on the urls table being up to date,
+  // except through GetURLRow() and GetRowForURL(). HistoryBackend opens one
+  // around AddPage(), so that a burst of navigations updates each URL row
+  // once per commit.
+  class ScopedURLRowBatch {
+   public:
+    explicit ScopedURLRowBatch(HistoryDatabase* db);
+    ~ScopedURLRowBatch();
+
+   private:
+    HistoryDatabase* db_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedURLRowBatch);
+  };
+
   // Must call Init() to complete construction. Although it can be created on
   // any thread, it must be destructed on the history thread for proper
   // database cleanup.
@@ -196,6 +214,9 @@ class HistoryDatabase : public DownloadDatabase,
 
   base::Time cached_early_expiration_threshold_;
 
+  // Number of ScopedURLRowBatch instances alive.
+  int url_row_batch_depth_;
+
   DISALLOW_COPY_AND_ASSIGN(HistoryDatabase);
 };
 
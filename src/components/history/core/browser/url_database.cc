@@ -41,7 +41,8 @@ bool URLDatabase::URLEnumerator::GetNextURL(URLRow* r) {
 }
 
 URLDatabase::URLDatabase()
-    : has_keyword_search_terms_(false) {
+    : has_keyword_search_terms_(false),
+      defer_url_row_updates_(false) {
 }
 
 URLDatabase::~URLDatabase() {
@@ -73,6 +74,12 @@ void URLDatabase::FillURLRow(sql::Statement& s, URLRow* i) {
 }
 
 bool URLDatabase::GetURLRow(URLID url_id, URLRow* info) {
+  auto cached = cached_url_rows_.find(url_id);
+  if (cached != cached_url_rows_.end()) {
+    *info = cached->second.row;
+    return true;
+  }
+
   // TODO(brettw) We need check for empty URLs to handle the case where
   // there are old URLs in the database that are empty that got in before
   // we added any checks. We should eventually be able to remove it
@@ -101,9 +108,16 @@ bool URLDatabase::GetAllTypedUrls(URLRows* urls) {
 }
 
 URLID URLDatabase::GetRowForURL(const GURL& url, URLRow* info) {
+  std::string url_string = GURLToDatabaseURL(url);
+  auto cached = cached_url_ids_.find(url_string);
+  if (cached != cached_url_ids_.end()) {
+    if (info)
+      *info = cached_url_rows_[cached->second].row;
+    return cached->second;
+  }
+
   sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
       "SELECT" HISTORY_URL_ROW_FIELDS "FROM urls WHERE url=?"));
-  std::string url_string = GURLToDatabaseURL(url);
   statement.BindString(0, url_string);
 
   if (!statement.Step())
@@ -115,6 +129,58 @@ URLID URLDatabase::GetRowForURL(const GURL& url, URLRow* info) {
 }
 
 bool URLDatabase::UpdateURLRow(URLID url_id, const URLRow& info) {
+  if (!defer_url_row_updates_)
+    return WriteURLRow(url_id, info);
+
+  // The first update of a row since the last flush is written straight away,
+  // which checks that the row exists. Later ones can then be deferred.
+  auto cached = cached_url_rows_.find(url_id);
+  if (cached == cached_url_rows_.end()) {
+    if (!WriteURLRow(url_id, info))
+      return false;
+    CachedURLRow& cached_row = cached_url_rows_[url_id];
+    cached_row.row = info;
+    cached_row.row.set_id(url_id);
+    cached_row.dirty = false;
+    cached_url_ids_[GURLToDatabaseURL(info.url())] = url_id;
+    return true;
+  }
+
+  // Like the UPDATE statement, this can't change the URL.
+  URLRow& row = cached->second.row;
+  row.set_title(info.title());
+  row.set_visit_count(info.visit_count());
+  row.set_typed_count(info.typed_count());
+  row.set_last_visit(info.last_visit());
+  row.set_hidden(info.hidden());
+  cached->second.dirty = true;
+  return true;
+}
+
+size_t URLDatabase::FlushPendingURLRowUpdates() {
+  // Swap the rows out first: writing them goes through GetDB(), which may
+  // flush again.
+  std::map<URLID, CachedURLRow> rows;
+  rows.swap(cached_url_rows_);
+  cached_url_ids_.clear();
+
+  size_t written = 0;
+  for (const auto& row : rows) {
+    if (row.second.dirty && WriteURLRow(row.first, row.second.row))
+      written++;
+  }
+  return written;
+}
+
+void URLDatabase::ForgetCachedURLRow(URLID url_id) {
+  auto cached = cached_url_rows_.find(url_id);
+  if (cached == cached_url_rows_.end())
+    return;
+  cached_url_ids_.erase(GURLToDatabaseURL(cached->second.row.url()));
+  cached_url_rows_.erase(cached);
+}
+
+bool URLDatabase::WriteURLRow(URLID url_id, const URLRow& info) {
   sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
       "UPDATE urls SET title=?,visit_count=?,typed_count=?,last_visit_time=?,"
         "hidden=?"
@@ -167,6 +233,8 @@ URLID URLDatabase::AddURLInternal(const URLRow& info, bool is_temporary) {
 }
 
 bool URLDatabase::InsertOrUpdateURLRowByID(const URLRow& info) {
+  ForgetCachedURLRow(info.id());
+
   // SQLite does not support INSERT OR UPDATE, however, it does have INSERT OR
   // REPLACE, which is feasible to use, because of the following.
   //  * Before INSERTing, REPLACE will delete all pre-existing rows that cause
@@ -196,6 +264,8 @@ bool URLDatabase::InsertOrUpdateURLRowByID(const URLRow& info) {
 }
 
 bool URLDatabase::DeleteURLRow(URLID id) {
+  ForgetCachedURLRow(id);
+
   sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
       "DELETE FROM urls WHERE id = ?"));
   statement.BindInt64(0, id);
@@ -243,6 +313,20 @@ bool URLDatabase::InitURLEnumeratorForEverything(URLEnumerator* enumerator) {
   return enumerator->statement_.is_valid();
 }
 
+bool URLDatabase::InitURLEnumeratorForBatch(URLID after_id,
+                                            int max_count,
+                                            URLEnumerator* enumerator) {
+  DCHECK(!enumerator->initialized_);
+  std::string sql("SELECT ");
+  sql.append(kURLRowFields);
+  sql.append(" FROM urls WHERE id > ? ORDER BY id LIMIT ?");
+  enumerator->statement_.Assign(GetDB().GetUniqueStatement(sql.c_str()));
+  enumerator->statement_.BindInt64(0, after_id);
+  enumerator->statement_.BindInt(1, max_count);
+  enumerator->initialized_ = enumerator->statement_.is_valid();
+  return enumerator->statement_.is_valid();
+}
+
 bool URLDatabase::InitURLEnumeratorForSignificant(URLEnumerator* enumerator) {
   DCHECK(!enumerator->initialized_);
   std::string sql("SELECT ");
@@ -306,6 +390,10 @@ bool URLDatabase::AutocompleteForPrefix(const std::string& prefix,
 }
 
 bool URLDatabase::IsTypedHost(const std::string& host) {
+  // This runs inside HistoryDatabase::ScopedURLRowBatch, so pending typed
+  // counts have to be written before the query sees them.
+  FlushPendingURLRowUpdates();
+
   const char* schemes[] = {
     url::kHttpScheme,
     url::kHttpsScheme,
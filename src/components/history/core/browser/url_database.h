@@ -7,6 +7,9 @@
 
 #include <stddef.h>
 
+#include <map>
+#include <string>
+
 #include "base/macros.h"
 #include "components/history/core/browser/keyword_id.h"
 #include "components/history/core/browser/url_row.h"
@@ -97,6 +100,21 @@ class URLDatabase {
   // may refer to the URL row. Returns true if the row existed and was deleted.
   bool DeleteURLRow(URLID id);
 
+  // Deferred URL row updates --------------------------------------------------
+
+  // While enabled, the rows written by UpdateURLRow() are remembered until the
+  // next FlushPendingURLRowUpdates(), and further updates of those rows only
+  // change the remembered copy. A row updated on every visit then costs one
+  // statement per flush rather than one per visit. GetURLRow() and
+  // GetRowForURL() read the remembered rows, but no other query sees the
+  // deferred changes, so the subclass must flush before running any of them;
+  // see HistoryDatabase::GetDB().
+  void set_defer_url_row_updates(bool defer) { defer_url_row_updates_ = defer; }
+
+  // Writes out the deferred updates and forgets the remembered rows. Returns
+  // the number of rows written.
+  size_t FlushPendingURLRowUpdates();
+
   // URL mass-deleting ---------------------------------------------------------
 
   // Begins the mass-deleting operation by creating a temporary URL table.
@@ -149,6 +167,15 @@ class URLDatabase {
   // Initializes the given enumerator to enumerator all URLs in the database.
   bool InitURLEnumeratorForEverything(URLEnumerator* enumerator);
 
+  // Initializes the given enumerator to enumerate, in id order, at most
+  // |max_count| URLs whose id is greater than |after_id|. Enumerating all the
+  // URLs one batch at a time this way, starting after 0 and then after the id
+  // of the last URL of each batch, doesn't keep a statement open between the
+  // batches, so other operations on the database can run in between.
+  bool InitURLEnumeratorForBatch(URLID after_id,
+                                 int max_count,
+                                 URLEnumerator* enumerator);
+
   // Initializes the given enumerator to enumerator all URLs in the database
   // that are historically significant: ones having been visited within 3 days,
   // having their URL manually typed more than once, or having been visited
@@ -284,11 +311,35 @@ class URLDatabase {
   // this class implements these functions to return its objects.
   virtual sql::Connection& GetDB() = 0;
 
+  // Returns true if rows are remembered, which FlushPendingURLRowUpdates()
+  // must be called to write out or forget before other queries run.
+  bool HasCachedURLRows() const { return !cached_url_rows_.empty(); }
+
  private:
+  // A row remembered while updates are deferred.
+  struct CachedURLRow {
+    URLRow row;
+    // True if |row| has changes which haven't been written yet.
+    bool dirty;
+  };
+
+  // Writes |info| to the row |url_id|. Returns true if the row exists.
+  bool WriteURLRow(URLID url_id, const URLRow& info);
+
+  // Forgets the remembered copy of the row |url_id|, after it has been
+  // written or deleted behind UpdateURLRow()'s back.
+  void ForgetCachedURLRow(URLID url_id);
+
   // True if InitKeywordSearchTermsTable() has been invoked. Not all subclasses
   // have keyword search terms.
   bool has_keyword_search_terms_;
 
+  bool defer_url_row_updates_;
+
+  // The rows remembered since the last flush, by ID, and their IDs by URL.
+  std::map<URLID, CachedURLRow> cached_url_rows_;
+  std::map<std::string, URLID> cached_url_ids_;
+
   query_parser::QueryParser query_parser_;
 
   DISALLOW_COPY_AND_ASSIGN(URLDatabase);
@@ -5,10 +5,12 @@
 #include "base/files/file_path.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "components/history/core/browser/keyword_search_term.h"
 #include "components/history/core/browser/url_database.h"
 #include "sql/connection.h"
+#include "sql/statement.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 using base::Time;
@@ -252,6 +254,33 @@ TEST_F(URLDatabaseTest, EnumeratorForSignificant) {
   EXPECT_EQ(3, row_count);
 }
 
+TEST_F(URLDatabaseTest, EnumeratorForBatch) {
+  std::vector<URLID> url_ids;
+  for (int i = 0; i < 5; ++i) {
+    URLRow row(GURL(base::StringPrintf("http://www.url%d.com/", i)));
+    url_ids.push_back(AddURL(row));
+    ASSERT_NE(0, url_ids.back());
+  }
+
+  // Enumerate the URLs two at a time, resuming after the last one seen.
+  std::vector<URLID> enumerated_ids;
+  URLID after_id = 0;
+  while (true) {
+    URLDatabase::URLEnumerator history_enum;
+    EXPECT_TRUE(InitURLEnumeratorForBatch(after_id, 2, &history_enum));
+    URLRow row;
+    int row_count = 0;
+    for (; history_enum.GetNextURL(&row); ++row_count) {
+      enumerated_ids.push_back(row.id());
+      after_id = row.id();
+    }
+    EXPECT_LE(row_count, 2);
+    if (row_count < 2)
+      break;
+  }
+  EXPECT_EQ(url_ids, enumerated_ids);
+}
+
 // Test GetKeywordSearchTermRows and DeleteSearchTerm
 TEST_F(URLDatabaseTest, GetAndDeleteKeywordSearchTermByTerm) {
   URLRow url_info1(GURL("http://www.google.com/"));
@@ -328,4 +357,47 @@ TEST_F(URLDatabaseTest, GetAndDeleteKeywordSearchTermByTerm) {
   EXPECT_TRUE(rows.empty());
 }
 
+
+// Test that deferred URL row updates are visible through the URLDatabase
+// right away but are only written to the table when flushed.
+TEST_F(URLDatabaseTest, DeferredURLRowUpdates) {
+  const GURL url("http://www.google.com/");
+  URLRow url_info(url);
+  url_info.set_visit_count(1);
+  url_info.set_last_visit(Time::Now());
+  URLID id = AddURL(url_info);
+  ASSERT_TRUE(id);
+
+  set_defer_url_row_updates(true);
+
+  // The first update of a row is written through.
+  url_info.set_visit_count(2);
+  EXPECT_TRUE(UpdateURLRow(id, url_info));
+  url_info.set_visit_count(3);
+  url_info.set_typed_count(1);
+  EXPECT_TRUE(UpdateURLRow(id, url_info));
+
+  sql::Statement statement(GetDB().GetUniqueStatement(
+      "SELECT visit_count, typed_count FROM urls WHERE id = ?"));
+  statement.BindInt64(0, id);
+  ASSERT_TRUE(statement.Step());
+  EXPECT_EQ(2, statement.ColumnInt(0));
+  EXPECT_EQ(0, statement.ColumnInt(1));
+  statement.Reset(true);
+
+  URLRow info;
+  EXPECT_TRUE(GetURLRow(id, &info));
+  EXPECT_EQ(3, info.visit_count());
+  EXPECT_EQ(id, GetRowForURL(url, &info));
+  EXPECT_EQ(1, info.typed_count());
+
+  EXPECT_EQ(1u, FlushPendingURLRowUpdates());
+  EXPECT_EQ(0u, FlushPendingURLRowUpdates());
+
+  statement.BindInt64(0, id);
+  ASSERT_TRUE(statement.Step());
+  EXPECT_EQ(3, statement.ColumnInt(0));
+  EXPECT_EQ(1, statement.ColumnInt(1));
+}
+
 }  // namespace history
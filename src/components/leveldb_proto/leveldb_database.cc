@@ -4,6 +4,9 @@
 
 #include "components/leveldb_proto/leveldb_database.h"
 
+#include <inttypes.h>
+#include <stdint.h>
+
 #include <string>
 #include <vector>
 
@@ -11,8 +14,13 @@
 #include "base/files/file_util.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_checker.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "third_party/leveldatabase/env_chromium.h"
+#include "third_party/leveldatabase/leveldb_chrome.h"
 #include "third_party/leveldatabase/src/helpers/memenv/memenv.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
 #include "third_party/leveldatabase/src/include/leveldb/env.h"
@@ -31,7 +39,11 @@ bool LevelDB::Destroy(const base::FilePath& database_dir) {
   return s.ok();
 }
 
-LevelDB::LevelDB(const char* client_name) : open_histogram_(nullptr) {
+LevelDB::LevelDB(const char* client_name)
+    : open_histogram_(nullptr),
+      client_name_(client_name),
+      uses_shared_block_cache_(false),
+      registered_for_memory_dumps_(false) {
   // Used in lieu of UMA_HISTOGRAM_ENUMERATION because the histogram name is
   // not a constant.
   open_histogram_ = base::LinearHistogram::FactoryGet(
@@ -42,6 +54,10 @@ LevelDB::LevelDB(const char* client_name) : open_histogram_(nullptr) {
 
 LevelDB::~LevelDB() {
   DFAKE_SCOPED_LOCK(thread_checker_);
+  if (registered_for_memory_dumps_) {
+    base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+        this);
+  }
 }
 
 bool LevelDB::InitWithOptions(const base::FilePath& database_dir,
@@ -62,6 +78,17 @@ bool LevelDB::InitWithOptions(const base::FilePath& database_dir,
   if (status.ok()) {
     CHECK(db);
     db_.reset(db);
+    uses_shared_block_cache_ =
+        options.block_cache == leveldb_chrome::GetSharedBrowserBlockCache();
+    // The database is used on a sequence, where it is dumped too.
+    if (!registered_for_memory_dumps_ &&
+        base::SequencedTaskRunnerHandle::IsSet()) {
+      base::trace_event::MemoryDumpManager::GetInstance()
+          ->RegisterDumpProviderWithSequencedTaskRunner(
+              this, "LevelDB", base::SequencedTaskRunnerHandle::Get(),
+              base::trace_event::MemoryDumpProvider::Options());
+      registered_for_memory_dumps_ = true;
+    }
     return true;
   }
 
@@ -75,6 +102,8 @@ bool LevelDB::Init(const base::FilePath& database_dir) {
   options.create_if_missing = true;
   options.max_open_files = 0;  // Use minimum.
   options.reuse_logs = leveldb_env::kDefaultLogReuseOptionValue;
+  options.block_cache = leveldb_chrome::GetSharedBrowserBlockCache();
+  options.write_buffer_size = leveldb_chrome::kSmallDatabaseWriteBufferSize;
   if (database_dir.empty()) {
     env_.reset(leveldb::NewMemEnv(leveldb::Env::Default()));
     options.env = env_.get();
@@ -144,4 +173,30 @@ bool LevelDB::Get(const std::string& key, bool* found, std::string* entry) {
   return false;
 }
 
+bool LevelDB::OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                           base::trace_event::ProcessMemoryDump* pmd) {
+  DFAKE_SCOPED_LOCK(thread_checker_);
+  // Return true so that the provider is not disabled.
+  if (!db_)
+    return true;
+
+  auto* dump = pmd->CreateAllocatorDump(base::StringPrintf(
+      "leveldb/leveldb_proto/%s/0x%" PRIXPTR, client_name_.c_str(),
+      reinterpret_cast<uintptr_t>(this)));
+  dump->AddScalar(
+      base::trace_event::MemoryAllocatorDump::kNameSize,
+      base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+      leveldb_chrome::GetApproximateMemoryUsage(db_.get(),
+                                                uses_shared_block_cache_));
+
+  // Memory is allocated from system allocator (malloc).
+  const char* system_allocator_name =
+      base::trace_event::MemoryDumpManager::GetInstance()
+          ->system_allocator_pool_name();
+  if (system_allocator_name)
+    pmd->AddSuballocation(dump->guid(), system_allocator_name);
+
+  return true;
+}
+
 }  // namespace leveldb_proto
@@ -7,7 +7,10 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/bind.h"
+#include "base/location.h"
 #include "base/strings/string_util.h"
+#include "base/task_runner.h"
 #include "components/metrics/metrics_log.h"
 #include "components/metrics/metrics_pref_names.h"
 
@@ -37,6 +40,22 @@ const size_t kStorageByteLimitPerLogType = 300000;
 
 }  // namespace
 
+struct MetricsLogManager::CompressedLog {
+  // Serializes and compresses |log|. Runs on the serialization task runner.
+  void Init(std::unique_ptr<MetricsLog> log) {
+    std::string log_data;
+    log->GetEncodedLog(&log_data);
+    if (log_data.empty())
+      return;
+    succeeded =
+        PersistedLogs::CompressLog(log_data, &compressed_log_data, &hash);
+  }
+
+  bool succeeded = false;
+  std::string compressed_log_data;
+  std::string hash;
+};
+
 MetricsLogManager::MetricsLogManager(PrefService* local_state,
                                      size_t max_ongoing_log_size)
     : unsent_logs_loaded_(false),
@@ -49,7 +68,8 @@ MetricsLogManager::MetricsLogManager(PrefService* local_state,
                          prefs::kMetricsOngoingLogs,
                          kOngoingLogsPersistLimit,
                          kStorageByteLimitPerLogType,
-                         max_ongoing_log_size) {}
+                         max_ongoing_log_size),
+      weak_ptr_factory_(this) {}
 
 MetricsLogManager::~MetricsLogManager() {}
 
@@ -68,6 +88,36 @@ void MetricsLogManager::FinishCurrentLog() {
   current_log_.reset();
 }
 
+void MetricsLogManager::FinishCurrentLogOnTaskRunner(
+    const scoped_refptr<base::TaskRunner>& task_runner,
+    const base::Closure& done_callback) {
+  DCHECK(current_log_.get());
+  current_log_->CloseLog();
+  const MetricsLog::LogType log_type = current_log_->log_type();
+  CompressedLog* compressed_log = new CompressedLog;
+  task_runner->PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(&CompressedLog::Init, base::Unretained(compressed_log),
+                 base::Passed(&current_log_)),
+      base::Bind(&MetricsLogManager::OnLogCompressed,
+                 weak_ptr_factory_.GetWeakPtr(), log_type, done_callback,
+                 base::Owned(compressed_log)));
+  DCHECK(!current_log_);
+}
+
+void MetricsLogManager::OnLogCompressed(MetricsLog::LogType log_type,
+                                        const base::Closure& done_callback,
+                                        const CompressedLog* compressed_log) {
+  if (compressed_log->succeeded) {
+    PersistedLogs* log_queue = log_type == MetricsLog::INITIAL_STABILITY_LOG
+                                   ? &initial_log_queue_
+                                   : &ongoing_log_queue_;
+    log_queue->StoreCompressedLog(compressed_log->compressed_log_data,
+                                  compressed_log->hash);
+  }
+  done_callback.Run();
+}
+
 void MetricsLogManager::StageNextLogForUpload() {
   DCHECK(!has_staged_log());
   if (!initial_log_queue_.empty())
@@ -11,10 +11,17 @@
 #include <string>
 #include <vector>
 
+#include "base/callback_forward.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "components/metrics/metrics_log.h"
 #include "components/metrics/persisted_logs.h"
 
+namespace base {
+class TaskRunner;
+}
+
 namespace metrics {
 
 // Manages all the log objects used by a MetricsService implementation. Keeps
@@ -39,6 +46,14 @@ class MetricsLogManager {
   // later, leaving current_log() NULL.
   void FinishCurrentLog();
 
+  // Like FinishCurrentLog(), but serializes and compresses the closed log on
+  // |task_runner|, so that large logs don't block the calling thread. The
+  // result is stored back on the calling thread, which then runs
+  // |done_callback|. The log is lost if this manager is destroyed before then.
+  void FinishCurrentLogOnTaskRunner(
+      const scoped_refptr<base::TaskRunner>& task_runner,
+      const base::Closure& done_callback);
+
   // Returns true if there are any logs waiting to be uploaded.
   bool has_unsent_logs() const {
     return initial_log_queue_.size() || ongoing_log_queue_.size();
@@ -97,6 +112,14 @@ class MetricsLogManager {
   void StoreLog(const std::string& log_data, MetricsLog::LogType log_type);
 
  private:
+  struct CompressedLog;
+
+  // Stores a log that FinishCurrentLogOnTaskRunner() compressed, then runs
+  // |done_callback|.
+  void OnLogCompressed(MetricsLog::LogType log_type,
+                       const base::Closure& done_callback,
+                       const CompressedLog* compressed_log);
+
   // Tracks whether unsent logs (if any) have been loaded from the serializer.
   bool unsent_logs_loaded_;
 
@@ -110,6 +133,8 @@ class MetricsLogManager {
   PersistedLogs initial_log_queue_;
   PersistedLogs ongoing_log_queue_;
 
+  base::WeakPtrFactory<MetricsLogManager> weak_ptr_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(MetricsLogManager);
 };
 
@@ -10,13 +10,18 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/memory/ptr_util.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/test/test_simple_task_runner.h"
 #include "components/metrics/metrics_log.h"
 #include "components/metrics/metrics_pref_names.h"
 #include "components/metrics/test_metrics_service_client.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/zlib/google/compression_utils.h"
 
 namespace metrics {
 
@@ -41,6 +46,10 @@ class TestLogPrefService : public TestingPrefServiceSimple {
   }
 };
 
+void SetTrue(bool* value) {
+  *value = true;
+}
+
 }  // namespace
 
 TEST(MetricsLogManagerTest, StandardFlow) {
@@ -82,6 +91,40 @@ TEST(MetricsLogManagerTest, StandardFlow) {
   EXPECT_FALSE(log_manager.has_unsent_logs());
 }
 
+TEST(MetricsLogManagerTest, FinishCurrentLogOnTaskRunner) {
+  base::MessageLoop message_loop;
+  scoped_refptr<base::TestSimpleTaskRunner> task_runner(
+      new base::TestSimpleTaskRunner);
+  TestMetricsServiceClient client;
+  TestLogPrefService pref_service;
+  MetricsLogManager log_manager(&pref_service, 0);
+
+  log_manager.BeginLoggingWithLog(base::WrapUnique(new MetricsLog(
+      "id", 0, MetricsLog::ONGOING_LOG, &client, &pref_service)));
+  bool done = false;
+  log_manager.FinishCurrentLogOnTaskRunner(
+      task_runner, base::Bind(&SetTrue, &done));
+  EXPECT_EQ(NULL, log_manager.current_log());
+
+  // Nothing is stored until the log has been compressed in the background.
+  EXPECT_FALSE(log_manager.has_unsent_logs());
+  ASSERT_TRUE(task_runner->HasPendingTask());
+  task_runner->RunUntilIdle();
+  EXPECT_FALSE(log_manager.has_unsent_logs());
+  EXPECT_FALSE(done);
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(done);
+  ASSERT_TRUE(log_manager.has_unsent_logs());
+
+  log_manager.StageNextLogForUpload();
+  std::string uncompressed_log;
+  EXPECT_TRUE(
+      compression::GzipUncompress(log_manager.staged_log(), &uncompressed_log));
+  EXPECT_FALSE(uncompressed_log.empty());
+  EXPECT_FALSE(log_manager.staged_log_hash().empty());
+}
+
 TEST(MetricsLogManagerTest, AbandonedLog) {
   TestMetricsServiceClient client;
   TestLogPrefService pref_service;
@@ -142,6 +142,7 @@
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task_runner.h"
 #include "base/threading/platform_thread.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_restrictions.h"
@@ -734,6 +735,11 @@ void MetricsService::CloseCurrentLog() {
   if (!log_manager_.current_log())
     return;
 
+  RecordFinalElementsOfCurrentLog();
+  log_manager_.FinishCurrentLog();
+}
+
+void MetricsService::RecordFinalElementsOfCurrentLog() {
   // TODO(jar): Integrate bounds on log recording more consistently, so that we
   // can stop recording logs that are too big much sooner.
   if (log_manager_.current_log()->num_events() > kEventLimit) {
@@ -765,8 +771,6 @@ void MetricsService::CloseCurrentLog() {
 
   current_log->RecordGeneralMetrics(metrics_providers_.get());
   RecordCurrentHistograms();
-
-  log_manager_.FinishCurrentLog();
 }
 
 void MetricsService::PushPendingLogsToPersistentStorage() {
@@ -843,6 +847,19 @@ void MetricsService::OnFinalLogInfoCollectionDone() {
     PrepareInitialMetricsLog();
   } else {
     DCHECK_EQ(SENDING_LOGS, state_);
+    // Histogram deltas are snapshotted here, but serializing and compressing
+    // a large log is left to a background task runner when there is one, and
+    // the log is sent once it has been stored.
+    scoped_refptr<base::TaskRunner> task_runner =
+        client_->GetLogSerializationTaskRunner();
+    if (task_runner && log_manager_.current_log()) {
+      RecordFinalElementsOfCurrentLog();
+      log_manager_.FinishCurrentLogOnTaskRunner(
+          task_runner, base::Bind(&MetricsService::SendNextLog,
+                                  self_ptr_factory_.GetWeakPtr()));
+      OpenNewLog();
+      return;
+    }
     CloseCurrentLog();
     OpenNewLog();
   }
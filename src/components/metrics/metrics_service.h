@@ -314,6 +314,10 @@ class MetricsService : public base::HistogramFlattener {
   // Closes out the current log after adding any last information.
   void CloseCurrentLog();
 
+  // Adds the last information, including the histogram deltas, to the current
+  // log before it is closed.
+  void RecordFinalElementsOfCurrentLog();
+
   // Pushes the text of the current and staged logs into persistent storage.
   // Called when Chrome shuts down.
   void PushPendingLogsToPersistentStorage();
@@ -4,6 +4,8 @@
 
 #include "components/metrics/metrics_service_client.h"
 
+#include "base/task_runner.h"
+
 namespace metrics {
 
 base::string16 MetricsServiceClient::GetRegistryBackupKey() {
@@ -22,4 +24,9 @@ bool MetricsServiceClient::IsUMACellularUploadLogicEnabled() {
   return false;
 }
 
+scoped_refptr<base::TaskRunner>
+MetricsServiceClient::GetLogSerializationTaskRunner() {
+  return nullptr;
+}
+
 }  // namespace metrics
@@ -11,6 +11,7 @@
 #include <string>
 
 #include "base/callback_forward.h"
+#include "base/memory/ref_counted.h"
 #include "base/strings/string16.h"
 #include "base/time/time.h"
 #include "components/metrics/metrics_reporting_default_state.h"
@@ -18,6 +19,7 @@
 
 namespace base {
 class FilePath;
+class TaskRunner;
 }
 
 namespace metrics {
@@ -109,6 +111,11 @@ class MetricsServiceClient {
 
   // Returns whether cellular logic is enabled for metrics reporting.
   virtual bool IsUMACellularUploadLogicEnabled();
+
+  // Returns a background task runner on which closed ongoing logs are
+  // serialized and compressed before they are stored, or null to do that
+  // synchronously on the thread of the MetricsService.
+  virtual scoped_refptr<base::TaskRunner> GetLogSerializationTaskRunner();
 };
 
 }  // namespace metrics
@@ -47,18 +47,25 @@ void AppendBase64String(const std::string& str, base::ListValue* list_value) {
 }  // namespace
 
 void PersistedLogs::LogHashPair::Init(const std::string& log_data) {
+  if (!CompressLog(log_data, &compressed_log_data, &hash))
+    NOTREACHED();
+}
+
+// static
+bool PersistedLogs::CompressLog(const std::string& log_data,
+                                std::string* compressed_log_data,
+                                std::string* log_hash) {
   DCHECK(!log_data.empty());
 
-  if (!compression::GzipCompress(log_data, &compressed_log_data)) {
-    NOTREACHED();
-    return;
-  }
+  if (!compression::GzipCompress(log_data, compressed_log_data))
+    return false;
 
   UMA_HISTOGRAM_PERCENTAGE(
       "UMA.ProtoCompressionRatio",
-      static_cast<int>(100 * compressed_log_data.size() / log_data.size()));
+      static_cast<int>(100 * compressed_log_data->size() / log_data.size()));
 
-  hash = base::SHA1HashString(log_data);
+  *log_hash = base::SHA1HashString(log_data);
+  return true;
 }
 
 PersistedLogs::PersistedLogs(PrefService* local_state,
@@ -93,6 +100,13 @@ void PersistedLogs::StoreLog(const std::string& log_data) {
   list_.back().Init(log_data);
 }
 
+void PersistedLogs::StoreCompressedLog(const std::string& compressed_log_data,
+                                       const std::string& log_hash) {
+  list_.push_back(LogHashPair());
+  list_.back().compressed_log_data = compressed_log_data;
+  list_.back().hash = log_hash;
+}
+
 void PersistedLogs::StageLog() {
   // CHECK, rather than DCHECK, because swap()ing with an empty list causes
   // hard-to-identify crashes much later.
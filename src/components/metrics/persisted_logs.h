@@ -65,6 +65,17 @@ class PersistedLogs {
   // Adds a log to the list.
   void StoreLog(const std::string& log_data);
 
+  // Adds a log that was already compressed by CompressLog() to the list.
+  void StoreCompressedLog(const std::string& compressed_log_data,
+                          const std::string& log_hash);
+
+  // Gzips the uncompressed |log_data| into |compressed_log_data| and computes
+  // its SHA1 |log_hash|, the way StoreLog() does. Can be called on any thread.
+  // Returns false if the compression failed.
+  static bool CompressLog(const std::string& log_data,
+                          std::string* compressed_log_data,
+                          std::string* log_hash);
+
   // Stages the most recent log.  The staged_log will remain the same even if
   // additional logs are added.
   void StageLog();
@@ -0,0 +1,453 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/offline_pages/archive_resource_store.h"
+
+#include <set>
+
+#include "base/base64.h"
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/files/file.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/location.h"
+#include "base/pickle.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "crypto/sha2.h"
+#include "net/http/http_util.h"
+
+namespace offline_pages {
+
+namespace {
+
+const base::FilePath::CharType kIndexesDirName[] = FILE_PATH_LITERAL("indexes");
+const base::FilePath::CharType kResourcesDirName[] =
+    FILE_PATH_LITERAL("resources");
+const base::FilePath::CharType kIndexFilePattern[] =
+    FILE_PATH_LITERAL("*.index");
+
+// Must be incremented whenever the format of the index changes.
+const int kIndexVersion = 1;
+
+// A MIME part of an archive, stored as a resource file named by |hash|.
+struct PartInfo {
+  std::string hash;
+  std::string content_type;
+  std::string content_location;
+  std::string transfer_encoding;
+  // The offset of the body from the start of the part.
+  uint64_t body_offset;
+};
+
+// The parts of an archive and the bytes around them. Concatenating
+// |preamble|, each part preceded by |delimiter|, and |delimiter| followed by
+// |epilogue| gives back the archive.
+struct ArchiveIndex {
+  std::string delimiter;
+  std::string preamble;
+  std::string epilogue;
+  std::vector<PartInfo> parts;
+};
+
+base::FilePath GetIndexPath(const base::FilePath& store_dir,
+                            int64_t offline_id) {
+  return store_dir.Append(kIndexesDirName)
+      .AppendASCII(base::Int64ToString(offline_id) + ".index");
+}
+
+base::FilePath GetResourcePath(const base::FilePath& store_dir,
+                               const std::string& hash) {
+  return store_dir.Append(kResourcesDirName).AppendASCII(hash);
+}
+
+// Returns the value of the |lowercase_name| header of a MIME entity, whose
+// |headers| are separated by CRLFs.
+std::string GetHeaderValue(const std::string& headers,
+                           const char* lowercase_name) {
+  net::HttpUtil::HeadersIterator it(headers.begin(), headers.end(), "\r\n");
+  if (!it.AdvanceTo(lowercase_name))
+    return std::string();
+  return it.values();
+}
+
+// Splits |archive| at the delimiters of the boundary of its top-level
+// multipart Content-Type, filling in |index| except for its parts, which are
+// returned in |parts| instead. Returns false if |archive| is not multipart.
+bool SplitArchive(base::StringPiece archive,
+                  ArchiveIndex* index,
+                  std::vector<base::StringPiece>* parts) {
+  const size_t headers_end = archive.find("\r\n\r\n");
+  if (headers_end == base::StringPiece::npos)
+    return false;
+
+  // The Content-Type of MHTML archives is usually folded over several lines.
+  std::string headers = archive.substr(0, headers_end).as_string();
+  base::ReplaceSubstringsAfterOffset(&headers, 0, "\r\n\t", " ");
+  base::ReplaceSubstringsAfterOffset(&headers, 0, "\r\n ", " ");
+  std::string mime_type;
+  std::string charset;
+  bool had_charset = false;
+  std::string boundary;
+  net::HttpUtil::ParseContentType(GetHeaderValue(headers, "content-type"),
+                                  &mime_type, &charset, &had_charset,
+                                  &boundary);
+  boundary = net::HttpUtil::Unquote(boundary);
+  if (!base::StartsWith(mime_type, "multipart/",
+                        base::CompareCase::SENSITIVE) ||
+      boundary.empty()) {
+    return false;
+  }
+
+  // The delimiter of the first part includes the CRLF ending the headers.
+  index->delimiter = "\r\n--" + boundary;
+  size_t delimiter_start = archive.find(index->delimiter, headers_end);
+  if (delimiter_start == base::StringPiece::npos)
+    return false;
+  index->preamble = archive.substr(0, delimiter_start).as_string();
+
+  while (true) {
+    const size_t part_start = delimiter_start + index->delimiter.size();
+    base::StringPiece rest = archive.substr(part_start);
+    // The delimiter of the end of the archive is followed by "--".
+    if (rest.starts_with("--")) {
+      index->epilogue = rest.as_string();
+      return !parts->empty();
+    }
+    delimiter_start = archive.find(index->delimiter, part_start);
+    if (delimiter_start == base::StringPiece::npos)
+      return false;
+    parts->push_back(
+        archive.substr(part_start, delimiter_start - part_start));
+  }
+}
+
+// Fills in the headers of |info| from the headers of |part|.
+void ParsePartHeaders(base::StringPiece part, PartInfo* info) {
+  // A part starts with the CRLF ending its delimiter line, so a part without
+  // headers starts with the blank line.
+  size_t headers_end = part.find("\r\n\r\n");
+  if (headers_end == base::StringPiece::npos) {
+    info->body_offset = part.size();
+    return;
+  }
+  info->body_offset = headers_end + 4;
+  std::string headers = part.substr(0, headers_end).as_string();
+  info->content_type = GetHeaderValue(headers, "content-type");
+  info->content_location = GetHeaderValue(headers, "content-location");
+  info->transfer_encoding =
+      base::ToLowerASCII(GetHeaderValue(headers, "content-transfer-encoding"));
+}
+
+std::string DecodeQuotedPrintable(base::StringPiece encoded) {
+  std::string decoded;
+  decoded.reserve(encoded.size());
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    if (encoded[i] != '=') {
+      decoded.push_back(encoded[i]);
+      continue;
+    }
+    // Soft line breaks are dropped.
+    if (encoded.substr(i + 1, 2) == "\r\n") {
+      i += 2;
+      continue;
+    }
+    if (i + 2 < encoded.size() && base::IsHexDigit(encoded[i + 1]) &&
+        base::IsHexDigit(encoded[i + 2])) {
+      decoded.push_back(static_cast<char>(
+          base::HexDigitToInt(encoded[i + 1]) * 16 +
+          base::HexDigitToInt(encoded[i + 2])));
+      i += 2;
+      continue;
+    }
+    decoded.push_back(encoded[i]);
+  }
+  return decoded;
+}
+
+// Decodes the body of a part from its Content-Transfer-Encoding. Returns
+// false if the body is not valid for the encoding.
+bool DecodeBody(base::StringPiece body,
+                const std::string& transfer_encoding,
+                std::string* decoded) {
+  if (transfer_encoding == "quoted-printable") {
+    *decoded = DecodeQuotedPrintable(body);
+    return true;
+  }
+  if (transfer_encoding == "base64") {
+    std::string base64;
+    base::RemoveChars(body.as_string(), "\r\n", &base64);
+    return base::Base64Decode(base64, decoded);
+  }
+  // 7bit, 8bit and binary bodies are not encoded.
+  body.CopyToString(decoded);
+  return true;
+}
+
+bool WriteIndex(const base::FilePath& index_path, const ArchiveIndex& index) {
+  base::Pickle pickle;
+  pickle.WriteInt(kIndexVersion);
+  pickle.WriteString(index.delimiter);
+  pickle.WriteString(index.preamble);
+  pickle.WriteString(index.epilogue);
+  pickle.WriteUInt32(static_cast<uint32_t>(index.parts.size()));
+  for (const PartInfo& part : index.parts) {
+    pickle.WriteString(part.hash);
+    pickle.WriteString(part.content_type);
+    pickle.WriteString(part.content_location);
+    pickle.WriteString(part.transfer_encoding);
+    pickle.WriteUInt64(part.body_offset);
+  }
+  return base::ImportantFileWriter::WriteFileAtomically(
+      index_path, base::StringPiece(static_cast<const char*>(pickle.data()),
+                                    pickle.size()));
+}
+
+bool ReadIndex(const base::FilePath& index_path, ArchiveIndex* index) {
+  std::string data;
+  if (!base::ReadFileToString(index_path, &data))
+    return false;
+  base::Pickle pickle(data.data(), data.size());
+  base::PickleIterator it(pickle);
+  int version = 0;
+  uint32_t part_count = 0;
+  if (!it.ReadInt(&version) || version != kIndexVersion ||
+      !it.ReadString(&index->delimiter) || !it.ReadString(&index->preamble) ||
+      !it.ReadString(&index->epilogue) || !it.ReadUInt32(&part_count)) {
+    return false;
+  }
+  index->parts.clear();
+  for (uint32_t i = 0; i < part_count; ++i) {
+    PartInfo part;
+    if (!it.ReadString(&part.hash) || !it.ReadString(&part.content_type) ||
+        !it.ReadString(&part.content_location) ||
+        !it.ReadString(&part.transfer_encoding) ||
+        !it.ReadUInt64(&part.body_offset)) {
+      return false;
+    }
+    index->parts.push_back(part);
+  }
+  return !index->parts.empty();
+}
+
+ArchiveResourceStore::ImportResult ImportArchiveSync(
+    const base::FilePath& store_dir,
+    const base::FilePath& archive_path,
+    int64_t offline_id,
+    ArchiveResourceStore::ImportStats* stats) {
+  base::MemoryMappedFile archive_file;
+  if (!archive_file.Initialize(archive_path))
+    return ArchiveResourceStore::ImportResult::ARCHIVE_UNREADABLE;
+  base::StringPiece archive(reinterpret_cast<const char*>(archive_file.data()),
+                            archive_file.length());
+
+  ArchiveIndex index;
+  std::vector<base::StringPiece> parts;
+  if (!SplitArchive(archive, &index, &parts))
+    return ArchiveResourceStore::ImportResult::NOT_MHTML;
+
+  if (!base::CreateDirectory(store_dir.Append(kIndexesDirName)) ||
+      !base::CreateDirectory(store_dir.Append(kResourcesDirName))) {
+    return ArchiveResourceStore::ImportResult::STORE_WRITE_FAILED;
+  }
+
+  for (const base::StringPiece& part : parts) {
+    PartInfo info;
+    ParsePartHeaders(part, &info);
+    const std::string hash = crypto::SHA256HashString(part);
+    info.hash = base::HexEncode(hash.data(), hash.size());
+    index.parts.push_back(info);
+
+    const base::FilePath resource_path = GetResourcePath(store_dir, info.hash);
+    if (base::PathExists(resource_path)) {
+      stats->deduplicated_count++;
+      stats->deduplicated_size += part.size();
+    } else if (!base::ImportantFileWriter::WriteFileAtomically(resource_path,
+                                                               part)) {
+      return ArchiveResourceStore::ImportResult::STORE_WRITE_FAILED;
+    }
+  }
+  stats->resource_count = static_cast<int>(parts.size());
+
+  if (!WriteIndex(GetIndexPath(store_dir, offline_id), index))
+    return ArchiveResourceStore::ImportResult::STORE_WRITE_FAILED;
+  return ArchiveResourceStore::ImportResult::SUCCESS;
+}
+
+void ImportArchiveImpl(
+    const base::FilePath& store_dir,
+    const base::FilePath& archive_path,
+    int64_t offline_id,
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    const ArchiveResourceStore::ImportCallback& callback) {
+  ArchiveResourceStore::ImportStats stats = {0, 0, 0};
+  ArchiveResourceStore::ImportResult result =
+      ImportArchiveSync(store_dir, archive_path, offline_id, &stats);
+  task_runner->PostTask(FROM_HERE, base::Bind(callback, result, stats));
+}
+
+bool ReadMainResourceSync(const base::FilePath& store_dir,
+                          int64_t offline_id,
+                          ArchiveResourceStore::Resource* resource) {
+  ArchiveIndex index;
+  if (!ReadIndex(GetIndexPath(store_dir, offline_id), &index))
+    return false;
+  const PartInfo& main_part = index.parts.front();
+  std::string part;
+  if (!base::ReadFileToString(GetResourcePath(store_dir, main_part.hash),
+                              &part) ||
+      main_part.body_offset > part.size()) {
+    return false;
+  }
+  resource->content_type = main_part.content_type;
+  resource->content_location = main_part.content_location;
+  return DecodeBody(base::StringPiece(part).substr(main_part.body_offset),
+                    main_part.transfer_encoding, &resource->body);
+}
+
+void ReadMainResourceImpl(
+    const base::FilePath& store_dir,
+    int64_t offline_id,
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    const ArchiveResourceStore::ReadResourceCallback& callback) {
+  ArchiveResourceStore::Resource resource;
+  bool result = ReadMainResourceSync(store_dir, offline_id, &resource);
+  task_runner->PostTask(FROM_HERE, base::Bind(callback, result, resource));
+}
+
+bool WriteToFile(base::File* file, const std::string& data) {
+  return file->WriteAtCurrentPos(data.data(), static_cast<int>(data.size())) ==
+         static_cast<int>(data.size());
+}
+
+bool WriteArchiveSync(const base::FilePath& store_dir,
+                      int64_t offline_id,
+                      const base::FilePath& archive_path) {
+  ArchiveIndex index;
+  if (!ReadIndex(GetIndexPath(store_dir, offline_id), &index))
+    return false;
+  base::File file(archive_path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  if (!file.IsValid() || !WriteToFile(&file, index.preamble))
+    return false;
+  // The parts are read one at a time, so that only one of them is in memory.
+  std::string part;
+  for (const PartInfo& info : index.parts) {
+    if (!base::ReadFileToString(GetResourcePath(store_dir, info.hash),
+                                &part) ||
+        !WriteToFile(&file, index.delimiter) || !WriteToFile(&file, part)) {
+      return false;
+    }
+  }
+  return WriteToFile(&file, index.delimiter) &&
+         WriteToFile(&file, index.epilogue);
+}
+
+void WriteArchiveImpl(const base::FilePath& store_dir,
+                      int64_t offline_id,
+                      const base::FilePath& archive_path,
+                      scoped_refptr<base::SequencedTaskRunner> task_runner,
+                      const base::Callback<void(bool)>& callback) {
+  bool result = WriteArchiveSync(store_dir, offline_id, archive_path);
+  if (!result)
+    base::DeleteFile(archive_path, false);
+  task_runner->PostTask(FROM_HERE, base::Bind(callback, result));
+}
+
+// Deletes the resources that are not referenced by any index. Keeps all of
+// them if an index can't be read, since its resources are unknown.
+void DeleteUnreferencedResources(const base::FilePath& store_dir) {
+  std::set<base::FilePath> referenced_paths;
+  base::FileEnumerator indexes(store_dir.Append(kIndexesDirName), false,
+                               base::FileEnumerator::FILES, kIndexFilePattern);
+  for (base::FilePath index_path = indexes.Next(); !index_path.empty();
+       index_path = indexes.Next()) {
+    ArchiveIndex index;
+    if (!ReadIndex(index_path, &index))
+      return;
+    for (const PartInfo& part : index.parts)
+      referenced_paths.insert(GetResourcePath(store_dir, part.hash));
+  }
+
+  base::FileEnumerator resources(store_dir.Append(kResourcesDirName), false,
+                                 base::FileEnumerator::FILES);
+  for (base::FilePath resource_path = resources.Next(); !resource_path.empty();
+       resource_path = resources.Next()) {
+    if (!referenced_paths.count(resource_path))
+      base::DeleteFile(resource_path, false);
+  }
+}
+
+void DeleteArchivesImpl(const base::FilePath& store_dir,
+                        const std::vector<int64_t>& offline_ids,
+                        scoped_refptr<base::SequencedTaskRunner> task_runner,
+                        const base::Callback<void(bool)>& callback) {
+  bool result = true;
+  for (int64_t offline_id : offline_ids) {
+    // Make sure delete happens on the left of && so that it is always
+    // executed.
+    result = base::DeleteFile(GetIndexPath(store_dir, offline_id), false) &&
+             result;
+  }
+  DeleteUnreferencedResources(store_dir);
+  task_runner->PostTask(FROM_HERE, base::Bind(callback, result));
+}
+
+}  // namespace
+
+ArchiveResourceStore::Resource::Resource() {}
+
+ArchiveResourceStore::Resource::Resource(const Resource& other) = default;
+
+ArchiveResourceStore::Resource::~Resource() {}
+
+ArchiveResourceStore::ArchiveResourceStore(
+    const base::FilePath& store_dir,
+    const scoped_refptr<base::SequencedTaskRunner>& task_runner)
+    : store_dir_(store_dir), task_runner_(task_runner) {}
+
+ArchiveResourceStore::~ArchiveResourceStore() {}
+
+void ArchiveResourceStore::ImportArchive(const base::FilePath& archive_path,
+                                         int64_t offline_id,
+                                         const ImportCallback& callback) {
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(ImportArchiveImpl, store_dir_, archive_path, offline_id,
+                 base::ThreadTaskRunnerHandle::Get(), callback));
+}
+
+void ArchiveResourceStore::ReadMainResource(
+    int64_t offline_id,
+    const ReadResourceCallback& callback) {
+  task_runner_->PostTask(
+      FROM_HERE, base::Bind(ReadMainResourceImpl, store_dir_, offline_id,
+                            base::ThreadTaskRunnerHandle::Get(), callback));
+}
+
+void ArchiveResourceStore::WriteArchive(
+    int64_t offline_id,
+    const base::FilePath& archive_path,
+    const base::Callback<void(bool)>& callback) {
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(WriteArchiveImpl, store_dir_, offline_id, archive_path,
+                 base::ThreadTaskRunnerHandle::Get(), callback));
+}
+
+void ArchiveResourceStore::DeleteArchives(
+    const std::vector<int64_t>& offline_ids,
+    const base::Callback<void(bool)>& callback) {
+  task_runner_->PostTask(
+      FROM_HERE, base::Bind(DeleteArchivesImpl, store_dir_, offline_ids,
+                            base::ThreadTaskRunnerHandle::Get(), callback));
+}
+
+}  // namespace offline_pages
@@ -0,0 +1,106 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_OFFLINE_PAGES_ARCHIVE_RESOURCE_STORE_H_
+#define COMPONENTS_OFFLINE_PAGES_ARCHIVE_RESOURCE_STORE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/callback_forward.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace offline_pages {
+
+// Stores the resources of MHTML archives of offline pages by the SHA-256 hash
+// of their MIME parts, so that the resources saved by many pages, like
+// framework scripts and fonts, are stored only once. Each imported archive is
+// described by an index, from which its main resource can be read without
+// parsing the MHTML, and from which the MHTML can be reassembled byte for
+// byte.
+// All file operations are performed using |task_runner_|.
+class ArchiveResourceStore {
+ public:
+  enum class ImportResult {
+    SUCCESS,
+    // The archive could not be read.
+    ARCHIVE_UNREADABLE,
+    // The archive is not a multipart MHTML archive.
+    NOT_MHTML,
+    // A resource or the index could not be written to the store.
+    STORE_WRITE_FAILED,
+  };
+
+  struct ImportStats {
+    // The number of resources in the archive.
+    int resource_count;
+    // The number and the size of the resources of the archive that were
+    // already in the store.
+    int deduplicated_count;
+    int64_t deduplicated_size;
+  };
+
+  // A resource of an archive, with its body decoded from the
+  // Content-Transfer-Encoding of its MIME part.
+  struct Resource {
+    Resource();
+    Resource(const Resource& other);
+    ~Resource();
+
+    std::string content_type;
+    std::string content_location;
+    std::string body;
+  };
+
+  typedef base::Callback<void(ImportResult, const ImportStats&)>
+      ImportCallback;
+  typedef base::Callback<void(bool, const Resource&)> ReadResourceCallback;
+
+  ArchiveResourceStore(
+      const base::FilePath& store_dir,
+      const scoped_refptr<base::SequencedTaskRunner>& task_runner);
+  virtual ~ArchiveResourceStore();
+
+  // Splits the MHTML archive at |archive_path| into its resources, adds the
+  // ones that are not in the store yet, and indexes them under |offline_id|,
+  // replacing any previous index for it. The archive is memory-mapped rather
+  // than read into memory. The archive itself is left as it is.
+  virtual void ImportArchive(const base::FilePath& archive_path,
+                             int64_t offline_id,
+                             const ImportCallback& callback);
+
+  // Reads the main resource of the archive indexed under |offline_id|, which
+  // is the first part of the MHTML. Only that resource is read from the store.
+  virtual void ReadMainResource(int64_t offline_id,
+                                const ReadResourceCallback& callback);
+
+  // Reassembles the MHTML archive indexed under |offline_id| into
+  // |archive_path|.
+  virtual void WriteArchive(int64_t offline_id,
+                            const base::FilePath& archive_path,
+                            const base::Callback<void(bool)>& callback);
+
+  // Deletes the indices of |offline_ids|, and then the resources that are no
+  // longer indexed under any offline ID. It is considered successful to delete
+  // an index that does not exist.
+  virtual void DeleteArchives(const std::vector<int64_t>& offline_ids,
+                              const base::Callback<void(bool)>& callback);
+
+ private:
+  // Path under which the indices and the resources are stored.
+  base::FilePath store_dir_;
+  // Task runner for running file operations.
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+};
+
+}  // namespace offline_pages
+
+#endif  // COMPONENTS_OFFLINE_PAGES_ARCHIVE_RESOURCE_STORE_H_
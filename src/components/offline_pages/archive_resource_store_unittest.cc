@@ -0,0 +1,305 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/offline_pages/archive_resource_store.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/test_simple_task_runner.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace offline_pages {
+
+namespace {
+
+const int64_t kOfflineId1 = 1234LL;
+const int64_t kOfflineId2 = 5678LL;
+
+// Returns an MHTML archive, as saved by Blink, of a page with the |title|
+// which uses a script and an image shared with other pages.
+std::string MakeArchive(const std::string& title) {
+  const std::string boundary = "----MultipartBoundary--" + title + "----";
+  return "From: <Saved by Blink>\r\n"
+         "Subject: " + title + "\r\n"
+         "MIME-Version: 1.0\r\n"
+         "Content-Type: multipart/related;\r\n"
+         "\ttype=\"text/html\";\r\n"
+         "\tboundary=\"" + boundary + "\"\r\n"
+         "\r\n"
+         "--" + boundary + "\r\n"
+         "Content-Type: text/html\r\n"
+         "Content-Transfer-Encoding: quoted-printable\r\n"
+         "Content-Location: http://example.com/" + title + ".html\r\n"
+         "\r\n"
+         "<html><head><title>" + title + "</title><meta charset=3D\"utf-8\">"
+         "</head>=\r\n"
+         "<body><script src=3D\"app.js\"></script></body></html>\r\n"
+         "--" + boundary + "\r\n"
+         "Content-Type: application/javascript\r\n"
+         "Content-Transfer-Encoding: quoted-printable\r\n"
+         "Content-Location: http://example.com/app.js\r\n"
+         "\r\n"
+         "document.title =3D 'shared';\r\n"
+         "--" + boundary + "\r\n"
+         "Content-Type: image/png\r\n"
+         "Content-Transfer-Encoding: base64\r\n"
+         "Content-Location: http://example.com/logo.png\r\n"
+         "\r\n"
+         "iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAYAAAAfFcSJ\r\n"
+         "AAAADUlEQVR42mNk+M9QDwADhgGAWjR9awAAAABJRU5ErkJggg==\r\n"
+         "--" + boundary + "--\r\n";
+}
+
+}  // namespace
+
+class ArchiveResourceStoreTest : public testing::Test {
+ public:
+  ArchiveResourceStoreTest();
+  void SetUp() override;
+
+  void PumpLoop();
+
+  // Writes |contents| to a file in the temp directory and returns its path.
+  base::FilePath WriteArchiveFile(const std::string& name,
+                                  const std::string& contents);
+  int CountResources();
+
+  void ImportCallback(ArchiveResourceStore::ImportResult result,
+                      const ArchiveResourceStore::ImportStats& stats);
+  void ReadResourceCallback(bool result,
+                            const ArchiveResourceStore::Resource& resource);
+  void Callback(bool result);
+
+  ArchiveResourceStore* store() { return store_.get(); }
+  const base::FilePath& temp_path() const { return temp_dir_.path(); }
+  ArchiveResourceStore::ImportResult last_import_result() const {
+    return last_import_result_;
+  }
+  const ArchiveResourceStore::ImportStats& last_import_stats() const {
+    return last_import_stats_;
+  }
+  const ArchiveResourceStore::Resource& last_resource() const {
+    return last_resource_;
+  }
+  bool last_result() const { return last_result_; }
+
+ private:
+  scoped_refptr<base::TestSimpleTaskRunner> task_runner_;
+  base::ThreadTaskRunnerHandle task_runner_handle_;
+  base::ScopedTempDir temp_dir_;
+
+  std::unique_ptr<ArchiveResourceStore> store_;
+  ArchiveResourceStore::ImportResult last_import_result_;
+  ArchiveResourceStore::ImportStats last_import_stats_;
+  ArchiveResourceStore::Resource last_resource_;
+  bool last_result_;
+};
+
+ArchiveResourceStoreTest::ArchiveResourceStoreTest()
+    : task_runner_(new base::TestSimpleTaskRunner),
+      task_runner_handle_(task_runner_),
+      last_import_result_(
+          ArchiveResourceStore::ImportResult::STORE_WRITE_FAILED),
+      last_import_stats_({0, 0, 0}),
+      last_result_(false) {}
+
+void ArchiveResourceStoreTest::SetUp() {
+  ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  store_.reset(new ArchiveResourceStore(
+      temp_dir_.path().AppendASCII("store"), task_runner_));
+}
+
+void ArchiveResourceStoreTest::PumpLoop() {
+  task_runner_->RunUntilIdle();
+}
+
+base::FilePath ArchiveResourceStoreTest::WriteArchiveFile(
+    const std::string& name,
+    const std::string& contents) {
+  base::FilePath path = temp_path().AppendASCII(name);
+  EXPECT_EQ(static_cast<int>(contents.size()),
+            base::WriteFile(path, contents.data(), contents.size()));
+  return path;
+}
+
+int ArchiveResourceStoreTest::CountResources() {
+  base::FileEnumerator resources(
+      temp_path().AppendASCII("store").AppendASCII("resources"), false,
+      base::FileEnumerator::FILES);
+  int count = 0;
+  while (!resources.Next().empty())
+    ++count;
+  return count;
+}
+
+void ArchiveResourceStoreTest::ImportCallback(
+    ArchiveResourceStore::ImportResult result,
+    const ArchiveResourceStore::ImportStats& stats) {
+  last_import_result_ = result;
+  last_import_stats_ = stats;
+}
+
+void ArchiveResourceStoreTest::ReadResourceCallback(
+    bool result,
+    const ArchiveResourceStore::Resource& resource) {
+  last_result_ = result;
+  last_resource_ = resource;
+}
+
+void ArchiveResourceStoreTest::Callback(bool result) {
+  last_result_ = result;
+}
+
+TEST_F(ArchiveResourceStoreTest, ImportDeduplicatesSharedResources) {
+  base::FilePath archive1 = WriteArchiveFile("1.mhtml", MakeArchive("one"));
+  store()->ImportArchive(
+      archive1, kOfflineId1,
+      base::Bind(&ArchiveResourceStoreTest::ImportCallback,
+                 base::Unretained(this)));
+  PumpLoop();
+  EXPECT_EQ(ArchiveResourceStore::ImportResult::SUCCESS, last_import_result());
+  EXPECT_EQ(3, last_import_stats().resource_count);
+  EXPECT_EQ(0, last_import_stats().deduplicated_count);
+  EXPECT_EQ(3, CountResources());
+
+  // Only the main resource of the second page needs to be stored.
+  base::FilePath archive2 = WriteArchiveFile("2.mhtml", MakeArchive("two"));
+  store()->ImportArchive(
+      archive2, kOfflineId2,
+      base::Bind(&ArchiveResourceStoreTest::ImportCallback,
+                 base::Unretained(this)));
+  PumpLoop();
+  EXPECT_EQ(ArchiveResourceStore::ImportResult::SUCCESS, last_import_result());
+  EXPECT_EQ(3, last_import_stats().resource_count);
+  EXPECT_EQ(2, last_import_stats().deduplicated_count);
+  EXPECT_LT(0, last_import_stats().deduplicated_size);
+  EXPECT_EQ(4, CountResources());
+}
+
+TEST_F(ArchiveResourceStoreTest, ImportRejectsInvalidArchives) {
+  store()->ImportArchive(
+      temp_path().AppendASCII("missing.mhtml"), kOfflineId1,
+      base::Bind(&ArchiveResourceStoreTest::ImportCallback,
+                 base::Unretained(this)));
+  PumpLoop();
+  EXPECT_EQ(ArchiveResourceStore::ImportResult::ARCHIVE_UNREADABLE,
+            last_import_result());
+
+  base::FilePath not_mhtml = WriteArchiveFile(
+      "page.html", "Content-Type: text/html\r\n\r\n<html></html>");
+  store()->ImportArchive(
+      not_mhtml, kOfflineId1,
+      base::Bind(&ArchiveResourceStoreTest::ImportCallback,
+                 base::Unretained(this)));
+  PumpLoop();
+  EXPECT_EQ(ArchiveResourceStore::ImportResult::NOT_MHTML,
+            last_import_result());
+
+  // An archive that is cut short is not imported either.
+  std::string archive = MakeArchive("one");
+  base::FilePath truncated = WriteArchiveFile(
+      "truncated.mhtml", archive.substr(0, archive.size() / 2));
+  store()->ImportArchive(
+      truncated, kOfflineId1,
+      base::Bind(&ArchiveResourceStoreTest::ImportCallback,
+                 base::Unretained(this)));
+  PumpLoop();
+  EXPECT_EQ(ArchiveResourceStore::ImportResult::NOT_MHTML,
+            last_import_result());
+}
+
+TEST_F(ArchiveResourceStoreTest, ReadMainResource) {
+  base::FilePath archive = WriteArchiveFile("1.mhtml", MakeArchive("one"));
+  store()->ImportArchive(
+      archive, kOfflineId1,
+      base::Bind(&ArchiveResourceStoreTest::ImportCallback,
+                 base::Unretained(this)));
+  PumpLoop();
+  ASSERT_EQ(ArchiveResourceStore::ImportResult::SUCCESS, last_import_result());
+
+  store()->ReadMainResource(
+      kOfflineId1, base::Bind(&ArchiveResourceStoreTest::ReadResourceCallback,
+                              base::Unretained(this)));
+  PumpLoop();
+  EXPECT_TRUE(last_result());
+  EXPECT_EQ("text/html", last_resource().content_type);
+  EXPECT_EQ("http://example.com/one.html", last_resource().content_location);
+  EXPECT_EQ(
+      "<html><head><title>one</title><meta charset=\"utf-8\"></head>"
+      "<body><script src=\"app.js\"></script></body></html>",
+      last_resource().body);
+
+  store()->ReadMainResource(
+      kOfflineId2, base::Bind(&ArchiveResourceStoreTest::ReadResourceCallback,
+                              base::Unretained(this)));
+  PumpLoop();
+  EXPECT_FALSE(last_result());
+}
+
+TEST_F(ArchiveResourceStoreTest, WriteArchive) {
+  const std::string contents = MakeArchive("one");
+  base::FilePath archive = WriteArchiveFile("1.mhtml", contents);
+  store()->ImportArchive(
+      archive, kOfflineId1,
+      base::Bind(&ArchiveResourceStoreTest::ImportCallback,
+                 base::Unretained(this)));
+  PumpLoop();
+  ASSERT_EQ(ArchiveResourceStore::ImportResult::SUCCESS, last_import_result());
+
+  base::FilePath restored = temp_path().AppendASCII("restored.mhtml");
+  store()->WriteArchive(kOfflineId1, restored,
+                        base::Bind(&ArchiveResourceStoreTest::Callback,
+                                   base::Unretained(this)));
+  PumpLoop();
+  EXPECT_TRUE(last_result());
+  std::string restored_contents;
+  ASSERT_TRUE(base::ReadFileToString(restored, &restored_contents));
+  EXPECT_EQ(contents, restored_contents);
+}
+
+TEST_F(ArchiveResourceStoreTest, DeleteKeepsSharedResources) {
+  store()->ImportArchive(
+      WriteArchiveFile("1.mhtml", MakeArchive("one")), kOfflineId1,
+      base::Bind(&ArchiveResourceStoreTest::ImportCallback,
+                 base::Unretained(this)));
+  store()->ImportArchive(
+      WriteArchiveFile("2.mhtml", MakeArchive("two")), kOfflineId2,
+      base::Bind(&ArchiveResourceStoreTest::ImportCallback,
+                 base::Unretained(this)));
+  PumpLoop();
+  ASSERT_EQ(4, CountResources());
+
+  std::vector<int64_t> offline_ids = {kOfflineId1};
+  store()->DeleteArchives(offline_ids,
+                          base::Bind(&ArchiveResourceStoreTest::Callback,
+                                     base::Unretained(this)));
+  PumpLoop();
+  EXPECT_TRUE(last_result());
+  EXPECT_EQ(3, CountResources());
+
+  // The second archive can still be restored.
+  store()->WriteArchive(kOfflineId2, temp_path().AppendASCII("restored.mhtml"),
+                        base::Bind(&ArchiveResourceStoreTest::Callback,
+                                   base::Unretained(this)));
+  PumpLoop();
+  EXPECT_TRUE(last_result());
+
+  offline_ids = {kOfflineId2};
+  store()->DeleteArchives(offline_ids,
+                          base::Bind(&ArchiveResourceStoreTest::Callback,
+                                     base::Unretained(this)));
+  PumpLoop();
+  EXPECT_TRUE(last_result());
+  EXPECT_EQ(0, CountResources());
+}
+
+}  // namespace offline_pages
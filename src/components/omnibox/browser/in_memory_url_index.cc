@@ -7,6 +7,7 @@
 #include "base/files/file_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/trace_event/trace_event.h"
+#include "components/history/core/browser/history_database.h"
 #include "components/history/core/browser/history_service.h"
 #include "components/history/core/browser/url_database.h"
 #include "components/omnibox/browser/url_index_private_data.h"
@@ -70,6 +71,39 @@ InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask::
     ~RebuildPrivateDataFromHistoryDBTask() {
 }
 
+// UpdatePrivateDataFromHistoryDBTask ------------------------------------------
+
+InMemoryURLIndex::UpdatePrivateDataFromHistoryDBTask::
+    UpdatePrivateDataFromHistoryDBTask(InMemoryURLIndex* index,
+                                       base::Time since)
+    : index_(index), since_(since) {}
+
+bool InMemoryURLIndex::UpdatePrivateDataFromHistoryDBTask::RunOnDBThread(
+    history::HistoryBackend* backend,
+    history::HistoryDatabase* db) {
+  history::VisitVector visits;
+  if (!db || !db->GetAllVisitsInRange(since_, base::Time(), 0, &visits))
+    return true;
+  std::set<history::URLID> url_ids;
+  for (const history::VisitRow& visit : visits) {
+    if (!url_ids.insert(visit.url_id).second)
+      continue;
+    history::URLRow row;
+    if (db->GetURLRow(visit.url_id, &row))
+      rows_.push_back(row);
+  }
+  return true;
+}
+
+void InMemoryURLIndex::UpdatePrivateDataFromHistoryDBTask::
+    DoneRunOnMainThread() {
+  index_->DoneUpdatingPrivateDataFromHistoryDB(rows_);
+}
+
+InMemoryURLIndex::UpdatePrivateDataFromHistoryDBTask::
+    ~UpdatePrivateDataFromHistoryDBTask() {
+}
+
 // InMemoryURLIndex ------------------------------------------------------------
 
 InMemoryURLIndex::InMemoryURLIndex(
@@ -166,32 +200,30 @@ void InMemoryURLIndex::OnURLsDeleted(history::HistoryService* history_service,
                                      bool expired,
                                      const history::URLRows& deleted_rows,
                                      const std::set<GURL>& favicon_urls) {
+  bool deleted = false;
   if (all_history) {
     ClearPrivateData();
-    needs_to_be_cached_ = true;
+    deleted = true;
   } else {
     for (const auto& row : deleted_rows)
-      needs_to_be_cached_ |= private_data_->DeleteURL(row.url());
+      deleted |= private_data_->DeleteURL(row.url());
   }
-  // If we made changes, destroy the previous cache.  Otherwise, if we go
-  // through an unclean shutdown (and therefore fail to write a new cache file),
-  // when Chrome restarts and we restore from the previous cache, we'll end up
-  // searching over URLs that may be deleted.  This would be wrong, and
+  if (!deleted)
+    return;
+  needs_to_be_cached_ = true;
+  // Expired URLs are only dropped from the cache when it is next saved.
+  if (expired)
+    return;
+  // Write the updated index right away. Otherwise, if we go through an
+  // unclean shutdown (and therefore fail to write a new cache file), when
+  // Chrome restarts and we restore from the previous cache, we'll end up
+  // searching over URLs that may be deleted. This would be wrong, and
   // surprising to the user who bothered to delete some URLs from their
-  // history.  In this situation, deleting the cache is a better solution than
-  // writing a new cache (after deleting the URLs from the in-memory structure)
-  // because deleting the cache forces it to be rebuilt from history upon
-  // startup.  If we instead write a new, updated cache then at the time of next
-  // startup (after an unclean shutdown) we will not rebuild the in-memory data
-  // structures from history but rather use the cache.  This solution is
-  // mediocre because this cache may not have the most-recently-visited URLs
-  // in it (URLs visited after user deleted some URLs from history), which
-  // would be odd and confusing.  It's better to force a rebuild.
-  base::FilePath path;
-  if (needs_to_be_cached_ && GetCacheFilePath(&path))
-    task_runner_->PostTask(
-        FROM_HERE,
-        base::Bind(base::IgnoreResult(base::DeleteFile), path, false));
+  // history. The URLs visited after the deletion that the cache then misses
+  // are picked up from history once it is restored, see OnCacheLoadDone().
+  // This used to delete the cache instead, which forced a full rebuild from
+  // history upon startup.
+  PostSaveToCacheFileTask();
 }
 
 void InMemoryURLIndex::OnHistoryServiceLoaded(
@@ -230,6 +262,13 @@ void InMemoryURLIndex::OnCacheLoadDone(
     restored_ = true;
     if (restore_cache_observer_)
       restore_cache_observer_->OnCacheRestoreFinished(true);
+    // The cache is only written at shutdown and when URLs are deleted, so it
+    // misses the visits made after a crash. Catch up with them from history,
+    // which is much cheaper than a rebuild.
+    if (history_service_) {
+      ScheduleUpdateFromHistory(private_data_->GetLastVisitTime() +
+                                base::TimeDelta::FromMicroseconds(1));
+    }
   } else if (history_service_) {
     // When unable to restore from the cache file delete the cache file, if
     // it exists, and then rebuild from the history database if it's available,
@@ -299,6 +338,26 @@ void InMemoryURLIndex::DoneRebuidingPrivateDataFromHistoryDB(
     restore_cache_observer_->OnCacheRestoreFinished(succeeded);
 }
 
+void InMemoryURLIndex::ScheduleUpdateFromHistory(base::Time since) {
+  DCHECK(history_service_);
+  history_service_->ScheduleDBTask(
+      std::unique_ptr<history::HistoryDBTask>(
+          new InMemoryURLIndex::UpdatePrivateDataFromHistoryDBTask(this,
+                                                                   since)),
+      &cache_reader_tracker_);
+}
+
+void InMemoryURLIndex::DoneUpdatingPrivateDataFromHistoryDB(
+    const history::URLRows& rows) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  for (const auto& row : rows) {
+    needs_to_be_cached_ |= private_data_->UpdateURL(history_service_,
+                                                    row,
+                                                    scheme_whitelist_,
+                                                    &private_data_tracker_);
+  }
+}
+
 void InMemoryURLIndex::RebuildFromHistory(
     history::HistoryDatabase* history_db) {
   private_data_tracker_.TryCancelAll();
@@ -22,6 +22,7 @@
 #include "base/task/cancelable_task_tracker.h"
 #include "base/threading/sequenced_worker_pool.h"
 #include "base/threading/thread_checker.h"
+#include "base/time/time.h"
 #include "components/history/core/browser/history_db_task.h"
 #include "components/history/core/browser/history_service_observer.h"
 #include "components/history/core/browser/history_types.h"
@@ -33,7 +34,6 @@ class HistoryQuickProviderTest;
 
 namespace base {
 class SequencedTaskRunner;
-class Time;
 }
 
 namespace bookmarks {
@@ -150,6 +150,7 @@ class InMemoryURLIndex : public KeyedService,
   friend class ::HistoryQuickProviderTest;
   friend class InMemoryURLIndexTest;
   friend class InMemoryURLIndexCacheTest;
+  FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest, DeleteRowsUpdatesCache);
   FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest, ExpireRow);
   FRIEND_TEST_ALL_PREFIXES(LimitedInMemoryURLIndexTest, Initialization);
 
@@ -174,6 +175,28 @@ class InMemoryURLIndex : public KeyedService,
     DISALLOW_COPY_AND_ASSIGN(RebuildPrivateDataFromHistoryDBTask);
   };
 
+  // HistoryDBTask used to fetch the URLs visited since |since|, so that an
+  // index restored from a cache file which missed them, for instance after
+  // a crash, can be brought up to date without a rebuild.
+  class UpdatePrivateDataFromHistoryDBTask : public history::HistoryDBTask {
+   public:
+    UpdatePrivateDataFromHistoryDBTask(InMemoryURLIndex* index,
+                                       base::Time since);
+
+    bool RunOnDBThread(history::HistoryBackend* backend,
+                       history::HistoryDatabase* db) override;
+    void DoneRunOnMainThread() override;
+
+   private:
+    ~UpdatePrivateDataFromHistoryDBTask() override;
+
+    InMemoryURLIndex* index_;  // Call back to this index at completion.
+    base::Time since_;  // Visits made from this time on are fetched.
+    history::URLRows rows_;  // The URLs visited since |since_|.
+
+    DISALLOW_COPY_AND_ASSIGN(UpdatePrivateDataFromHistoryDBTask);
+  };
+
   // Initializes all index data members in preparation for restoring the index
   // from the cache or a complete rebuild from the history database.
   void ClearPrivateData();
@@ -200,6 +223,14 @@ class InMemoryURLIndex : public KeyedService,
       bool succeeded,
       scoped_refptr<URLIndexPrivateData> private_data);
 
+  // Schedules a history task to update our private data with the URLs visited
+  // since |since|.
+  void ScheduleUpdateFromHistory(base::Time since);
+
+  // Callback used by UpdatePrivateDataFromHistoryDBTask to hand over the
+  // |rows| visited since the private data was cached.
+  void DoneUpdatingPrivateDataFromHistoryDB(const history::URLRows& rows);
+
   // Rebuilds the history index from the history database in |history_db|.
   // Used for unit testing only.
   void RebuildFromHistory(history::HistoryDatabase* history_db);
@@ -207,9 +238,9 @@ class InMemoryURLIndex : public KeyedService,
   // Determines if the private data was successfully reloaded from the cache
   // file or if the private data must be rebuilt from the history database.
   // |private_data_ptr|'s data will be NULL if the cache file load failed. If
-  // successful, sets the private data and notifies any
-  // |restore_cache_observer_|. Otherwise, kicks off a rebuild from the history
-  // database.
+  // successful, sets the private data, notifies any |restore_cache_observer_|
+  // and catches up with the visits the cache missed. Otherwise, kicks off a
+  // rebuild from the history database.
   void OnCacheLoadDone(scoped_refptr<URLIndexPrivateData> private_data_ptr);
 
   // Callback function that sets the private data from the just-restored-from-
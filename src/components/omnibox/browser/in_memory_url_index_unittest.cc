@@ -1176,6 +1176,85 @@ TEST_F(InMemoryURLIndexTest, RebuildFromHistoryIfCacheOld) {
   ExpectPrivateDataEqual(*old_data.get(), new_data);
 }
 
+TEST_F(InMemoryURLIndexTest, CacheRestoreCatchesUpWithHistory) {
+  base::ScopedTempDir temp_directory;
+  ASSERT_TRUE(temp_directory.CreateUniqueTempDir());
+  set_history_dir(temp_directory.path());
+
+  {
+    base::RunLoop run_loop;
+    CacheFileSaverObserver save_observer(run_loop.QuitClosure());
+    url_index_->set_save_cache_observer(&save_observer);
+    PostSaveToCacheFileTask();
+    run_loop.Run();
+    EXPECT_TRUE(save_observer.succeeded());
+  }
+
+  // Visit a URL after the cache was saved, as if the browser crashed before
+  // saving it again.
+  history::URLRow new_row(GURL("http://www.catchupwithhistory.com/"));
+  new_row.set_typed_count(1);
+  new_row.set_visit_count(1);
+  new_row.set_last_visit(base::Time::Now());
+  history::URLID new_row_id = history_database_->AddURL(new_row);
+  ASSERT_NE(0, new_row_id);
+  history::VisitRow visit(new_row_id, new_row.last_visit(), 0,
+                          ui::PAGE_TRANSITION_TYPED, 0);
+  ASSERT_NE(0, history_database_->AddVisit(&visit, history::SOURCE_BROWSED));
+
+  ClearPrivateData();
+  {
+    base::RunLoop run_loop;
+    HistoryIndexRestoreObserver restore_observer(run_loop.QuitClosure());
+    url_index_->set_restore_cache_observer(&restore_observer);
+    PostRestoreFromCacheFileTask();
+    run_loop.Run();
+    EXPECT_TRUE(restore_observer.succeeded());
+  }
+  EXPECT_GT(GetPrivateData()->restored_cache_version_, 0);
+
+  // The URL is added once the history has been searched for it.
+  history::BlockUntilHistoryProcessesPendingRequests(history_service_.get());
+  EXPECT_EQ(1U, url_index_->HistoryItemsForTerms(
+                    ASCIIToUTF16("catchupwithhistory"), base::string16::npos,
+                    kMaxMatches).size());
+}
+
+TEST_F(InMemoryURLIndexTest, DeleteRowsUpdatesCache) {
+  base::ScopedTempDir temp_directory;
+  ASSERT_TRUE(temp_directory.CreateUniqueTempDir());
+  set_history_dir(temp_directory.path());
+
+  ScoredHistoryMatches matches = url_index_->HistoryItemsForTerms(
+      ASCIIToUTF16("DrudgeReport"), base::string16::npos, kMaxMatches);
+  ASSERT_EQ(1U, matches.size());
+
+  // Deleting a URL writes the updated index to the cache.
+  history::URLRows deleted_rows;
+  deleted_rows.push_back(matches[0].url_info);
+  {
+    base::RunLoop run_loop;
+    CacheFileSaverObserver save_observer(run_loop.QuitClosure());
+    url_index_->set_save_cache_observer(&save_observer);
+    url_index_->OnURLsDeleted(nullptr, false, false, deleted_rows,
+                              std::set<GURL>());
+    run_loop.Run();
+    EXPECT_TRUE(save_observer.succeeded());
+  }
+
+  base::FilePath path;
+  ASSERT_TRUE(GetCacheFilePath(&path));
+  scoped_refptr<URLIndexPrivateData> restored_data =
+      URLIndexPrivateData::RestoreFromFile(path);
+  ASSERT_TRUE(restored_data);
+  ExpectPrivateDataEqual(*GetPrivateData(), *restored_data.get());
+  EXPECT_TRUE(restored_data
+                  ->HistoryItemsForTerms(ASCIIToUTF16("DrudgeReport"),
+                                         base::string16::npos, kMaxMatches,
+                                         nullptr, nullptr)
+                  .empty());
+}
+
 TEST_F(InMemoryURLIndexTest, AddHistoryMatch) {
   const struct {
     const char* search_string;
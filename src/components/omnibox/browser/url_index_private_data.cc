@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <functional>
 #include <iterator>
 #include <limits>
@@ -14,6 +15,8 @@
 #include <vector>
 
 #include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/i18n/break_iterator.h"
 #include "base/i18n/case_conversion.h"
 #include "base/macros.h"
@@ -412,15 +415,20 @@ scoped_refptr<URLIndexPrivateData> URLIndexPrivateData::RestoreFromFile(
   base::TimeTicks beginning_time = base::TimeTicks::Now();
   if (!base::PathExists(file_path))
     return nullptr;
-  std::string data;
   // If there is no cache file then simply give up. This will cause us to
-  // attempt to rebuild from the history database.
-  if (!base::ReadFileToString(file_path, &data))
+  // attempt to rebuild from the history database. The cache is parsed right
+  // from the mapped file, which spares reading a copy of it into memory.
+  base::MemoryMappedFile mapped_file;
+  if (!mapped_file.Initialize(file_path) ||
+      mapped_file.length() > static_cast<size_t>(
+                                 std::numeric_limits<int>::max())) {
     return nullptr;
+  }
 
   scoped_refptr<URLIndexPrivateData> restored_data(new URLIndexPrivateData);
   InMemoryURLIndexCacheItem index_cache;
-  if (!index_cache.ParseFromArray(data.c_str(), data.size())) {
+  if (!index_cache.ParseFromArray(mapped_file.data(),
+                                  static_cast<int>(mapped_file.length()))) {
     LOG(WARNING) << "Failed to parse URLIndexPrivateData cache data read from "
                  << file_path.value();
     return restored_data;
@@ -433,7 +441,7 @@ scoped_refptr<URLIndexPrivateData> URLIndexPrivateData::RestoreFromFile(
                       base::TimeTicks::Now() - beginning_time);
   UMA_HISTOGRAM_COUNTS("History.InMemoryURLHistoryItems",
                        restored_data->history_id_word_map_.size());
-  UMA_HISTOGRAM_COUNTS("History.InMemoryURLCacheSize", data.size());
+  UMA_HISTOGRAM_COUNTS("History.InMemoryURLCacheSize", mapped_file.length());
   UMA_HISTOGRAM_COUNTS_10000("History.InMemoryURLWords",
                              restored_data->word_map_.size());
   UMA_HISTOGRAM_COUNTS_10000("History.InMemoryURLChars",
@@ -506,6 +514,15 @@ bool URLIndexPrivateData::Empty() const {
   return history_info_map_.empty();
 }
 
+base::Time URLIndexPrivateData::GetLastVisitTime() const {
+  base::Time last_visit_time;
+  for (const auto& entry : history_info_map_) {
+    last_visit_time =
+        std::max(last_visit_time, entry.second.url_row.last_visit());
+  }
+  return last_visit_time;
+}
+
 void URLIndexPrivateData::Clear() {
   last_time_rebuilt_from_history_ = base::Time();
   word_list_.clear();
@@ -896,8 +913,10 @@ bool URLIndexPrivateData::SaveToFile(const base::FilePath& file_path) {
     return false;
   }
 
-  int size = data.size();
-  if (base::WriteFile(file_path, data.c_str(), size) != size) {
+  // The cache is now also written while browsing, see
+  // InMemoryURLIndex::OnURLsDeleted(), so write it atomically to never leave
+  // a truncated file behind.
+  if (!base::ImportantFileWriter::WriteFileAtomically(file_path, data)) {
     LOG(WARNING) << "Failed to write " << file_path.value();
     return false;
   }
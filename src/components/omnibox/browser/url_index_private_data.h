@@ -132,6 +132,10 @@ class URLIndexPrivateData
   // Returns true if there is no data in the index.
   bool Empty() const;
 
+  // Returns the most recent last visit time of the URLs in the index, which
+  // for restored data tells which visits were made after the cache was saved.
+  base::Time GetLastVisitTime() const;
+
   // Initializes all index data members in preparation for restoring the index
   // from the cache or a complete rebuild from the history database.
   void Clear();
@@ -144,6 +148,8 @@ class URLIndexPrivateData
   friend class ::HistoryQuickProviderTest;
   friend class InMemoryURLIndexTest;
   FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest, AddHistoryMatch);
+  FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest,
+                           CacheRestoreCatchesUpWithHistory);
   FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest, CacheSaveRestore);
   FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest, HugeResultSet);
   FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest, ReadVisitsFromHistory);
@@ -109,6 +109,35 @@ void RecordJsonDataSizeHistogram(const base::FilePath& path, size_t size) {
   histogram->Add(static_cast<int>(size) / 1024);
 }
 
+// Serializes |prefs| into |output|, recording the time taken in the
+// Settings.JsonDataSerializeTime histogram suffixed with the base name of the
+// JSON file under |path|. Runs on the file task runner.
+bool SerializePrefsSnapshot(const base::FilePath& path,
+                            const base::DictionaryValue* prefs,
+                            std::string* output) {
+  base::TimeTicks start_time = base::TimeTicks::Now();
+  JSONStringValueSerializer serializer(output);
+  // Not pretty-printing prefs shrinks pref file size by ~30%. To obtain
+  // readable prefs for debugging purposes, you can dump your prefs into any
+  // command-line or online JSON pretty printing tool.
+  serializer.set_pretty_print(false);
+  bool result = serializer.Serialize(*prefs);
+
+  std::string spaceless_basename;
+  base::ReplaceChars(path.BaseName().MaybeAsASCII(), " ", "_",
+                     &spaceless_basename);
+
+  // The histogram below is an expansion of the UMA_HISTOGRAM_TIMES macro
+  // adapted to allow for a dynamically suffixed histogram name.
+  // Note: The factory creates and owns the histogram.
+  base::HistogramBase* histogram = base::Histogram::FactoryTimeGet(
+      "Settings.JsonDataSerializeTime." + spaceless_basename,
+      base::TimeDelta::FromMilliseconds(1), base::TimeDelta::FromSeconds(10),
+      50, base::HistogramBase::kUmaTargetedHistogramFlag);
+  histogram->AddTime(base::TimeTicks::Now() - start_time);
+  return result;
+}
+
 std::unique_ptr<JsonPrefStore::ReadResult> ReadPrefsFromDisk(
     const base::FilePath& path,
     const base::FilePath& alternate_path) {
@@ -309,7 +338,7 @@ void JsonPrefStore::CommitPendingWrite() {
 
 void JsonPrefStore::SchedulePendingLossyWrites() {
   if (pending_lossy_write_)
-    writer_.ScheduleWrite(this);
+    writer_.ScheduleWriteWithBackgroundDataSerializer(this);
 }
 
 void JsonPrefStore::ReportValueChanged(const std::string& key, uint32_t flags) {
@@ -394,7 +423,8 @@ JsonPrefStore::~JsonPrefStore() {
   CommitPendingWrite();
 }
 
-bool JsonPrefStore::SerializeData(std::string* output) {
+base::ImportantFileWriter::BackgroundDataProducer
+JsonPrefStore::GetSerializedDataProducerForBackgroundSequence() {
   DCHECK(CalledOnValidThread());
 
   pending_lossy_write_ = false;
@@ -404,12 +434,10 @@ bool JsonPrefStore::SerializeData(std::string* output) {
   if (pref_filter_)
     pref_filter_->FilterSerializeData(prefs_.get());
 
-  JSONStringValueSerializer serializer(output);
-  // Not pretty-printing prefs shrinks pref file size by ~30%. To obtain
-  // readable prefs for debugging purposes, you can dump your prefs into any
-  // command-line or online JSON pretty printing tool.
-  serializer.set_pretty_print(false);
-  return serializer.Serialize(*prefs_);
+  // Only the copy is made on this thread; encoding the (possibly large)
+  // dictionary happens on |sequenced_task_runner_| along with the write.
+  return base::Bind(&SerializePrefsSnapshot, path_,
+                    base::Owned(prefs_->DeepCopy()));
 }
 
 void JsonPrefStore::FinalizeFileRead(
@@ -451,7 +479,7 @@ void JsonPrefStore::ScheduleWrite(uint32_t flags) {
   if (flags & LOSSY_PREF_WRITE_FLAG)
     pending_lossy_write_ = true;
   else
-    writer_.ScheduleWrite(this);
+    writer_.ScheduleWriteWithBackgroundDataSerializer(this);
 }
 
 // NOTE: This value should NOT be changed without renaming the histogram
@@ -43,7 +43,7 @@ FORWARD_DECLARE_TEST(JsonPrefStoreTest, WriteCountHistogramTestPeriodWithGaps);
 // A writable PrefStore implementation that is used for user preferences.
 class COMPONENTS_PREFS_EXPORT JsonPrefStore
     : public PersistentPrefStore,
-      public base::ImportantFileWriter::DataSerializer,
+      public base::ImportantFileWriter::BackgroundDataSerializer,
       public base::SupportsWeakPtr<JsonPrefStore>,
       public base::NonThreadSafe {
  public:
@@ -182,8 +182,9 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
   // is invoked directly.
   void OnFileRead(std::unique_ptr<ReadResult> read_result);
 
-  // ImportantFileWriter::DataSerializer overrides:
-  bool SerializeData(std::string* output) override;
+  // ImportantFileWriter::BackgroundDataSerializer overrides:
+  base::ImportantFileWriter::BackgroundDataProducer
+  GetSerializedDataProducerForBackgroundSequence() override;
 
   // This method is called after the JSON file has been read and the result has
   // potentially been intercepted and modified by |pref_filter_|.
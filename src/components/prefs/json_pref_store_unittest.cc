@@ -357,6 +357,33 @@ TEST_F(JsonPrefStoreTest, PreserveEmptyValues) {
   EXPECT_TRUE(DictionaryValue().Equals(result));
 }
 
+// Tests that a write serializes the prefs as they were when it was started,
+// and reports the time spent serializing them.
+TEST_F(JsonPrefStoreTest, WriteSerializesSnapshot) {
+  base::HistogramTester histogram_tester;
+  FilePath pref_file = temp_dir_.path().AppendASCII("snapshot.json");
+
+  scoped_refptr<JsonPrefStore> pref_store = new JsonPrefStore(
+      pref_file, message_loop_.task_runner(), std::unique_ptr<PrefFilter>());
+
+  pref_store->SetValue("key", base::WrapUnique(new StringValue("old")),
+                       WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  pref_store->CommitPendingWrite();
+
+  // Modify the prefs before the write task gets to run.
+  base::Value* value = NULL;
+  ASSERT_TRUE(pref_store->GetMutableValue("key", &value));
+  ASSERT_TRUE(value->IsType(base::Value::TYPE_STRING));
+  static_cast<StringValue*>(value)->GetString()->assign("new");
+  RunLoop().RunUntilIdle();
+
+  std::string output;
+  ASSERT_TRUE(base::ReadFileToString(pref_file, &output));
+  EXPECT_EQ("{\"key\":\"old\"}", output);
+  histogram_tester.ExpectTotalCount(
+      "Settings.JsonDataSerializeTime.snapshot.json", 1);
+}
+
 // This test is just documenting some potentially non-obvious behavior. It
 // shouldn't be taken as normative.
 TEST_F(JsonPrefStoreTest, RemoveClearsEmptyParent) {
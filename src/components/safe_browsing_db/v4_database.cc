@@ -137,7 +137,10 @@ void V4Database::UpdatedStoreReady(UpdateListIdentifier identifier,
                                    std::unique_ptr<V4Store> new_store) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   DCHECK(pending_store_updates_);
-  (*store_map_)[identifier] = std::move(new_store);
+  // A null store means that the update could not be applied; keep the old
+  // store, which the next update request will report the state of.
+  if (new_store)
+    (*store_map_)[identifier] = std::move(new_store);
 
   pending_store_updates_--;
   if (!pending_store_updates_) {
@@ -107,7 +107,8 @@ class V4Database {
 
   // Callback called when a new store has been created and is ready to be used.
   // This method updates the store_map_ to point to the new store, which causes
-  // the old store to get deleted.
+  // the old store to get deleted. A null |store| means that the update failed,
+  // and the old store is kept.
   void UpdatedStoreReady(UpdateListIdentifier identifier,
                          std::unique_ptr<V4Store> store);
 
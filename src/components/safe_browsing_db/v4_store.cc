@@ -2,11 +2,18 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/metrics/sparse_histogram.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/stringprintf.h"
 #include "components/safe_browsing_db/v4_store.h"
 #include "components/safe_browsing_db/v4_store.pb.h"
@@ -18,6 +25,9 @@ const uint32_t kFileMagic = 0x600D71FE;
 
 const uint32_t kFileVersion = 9;
 
+const PrefixSize kMinHashPrefixLength = 4;
+const PrefixSize kMaxHashPrefixLength = 32;
+
 void RecordStoreReadResult(StoreReadResult result) {
   UMA_HISTOGRAM_ENUMERATION("SafeBrowsing.V4StoreReadResult", result,
                             STORE_READ_RESULT_MAX);
@@ -28,6 +38,50 @@ void RecordStoreWriteResult(StoreWriteResult result) {
                             STORE_WRITE_RESULT_MAX);
 }
 
+void RecordApplyUpdateResult(ApplyUpdateResult result) {
+  UMA_HISTOGRAM_ENUMERATION("SafeBrowsing.V4StoreApplyUpdateResult", result,
+                            APPLY_UPDATE_RESULT_MAX);
+}
+
+// Returns the |index|-th prefix of |prefix_size| bytes in |prefixes|.
+base::StringPiece PrefixAt(const HashPrefixes& prefixes,
+                           PrefixSize prefix_size,
+                           size_t index) {
+  return base::StringPiece(prefixes.data() + index * prefix_size, prefix_size);
+}
+
+// Sorts the |prefixes| of |prefix_size| bytes each and removes the duplicates.
+// The server sends them sorted already, so this is only a linear check in the
+// common case.
+void SortAndRemoveDuplicates(PrefixSize prefix_size, HashPrefixes* prefixes) {
+  const size_t count = prefixes->size() / prefix_size;
+  bool is_sorted_and_unique = true;
+  for (size_t i = 1; i < count && is_sorted_and_unique; ++i) {
+    is_sorted_and_unique = PrefixAt(*prefixes, prefix_size, i - 1) <
+                           PrefixAt(*prefixes, prefix_size, i);
+  }
+  if (is_sorted_and_unique)
+    return;
+
+  std::vector<size_t> order(count);
+  for (size_t i = 0; i < count; ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return PrefixAt(*prefixes, prefix_size, lhs) <
+           PrefixAt(*prefixes, prefix_size, rhs);
+  });
+
+  HashPrefixes sorted;
+  sorted.reserve(prefixes->size());
+  for (size_t i = 0; i < count; ++i) {
+    base::StringPiece prefix = PrefixAt(*prefixes, prefix_size, order[i]);
+    if (i > 0 && prefix == PrefixAt(*prefixes, prefix_size, order[i - 1]))
+      continue;
+    prefix.AppendToString(&sorted);
+  }
+  prefixes->swap(sorted);
+}
+
 // Returns the name of the temporary file used to buffer data for
 // |filename|.  Exported for unit tests.
 const base::FilePath TemporaryFileForFilename(const base::FilePath& filename) {
@@ -74,6 +128,7 @@ std::string V4Store::DebugString() const {
 bool V4Store::Reset() {
   // TODO(vakh): Implement skeleton.
   state_ = "";
+  hash_prefix_map_.clear();
   return true;
 }
 
@@ -84,16 +139,15 @@ void V4Store::ApplyUpdate(
   std::unique_ptr<V4Store> new_store(
       new V4Store(this->task_runner_, this->store_path_));
 
-  new_store->state_ = response->new_client_state();
-  // TODO(vakh):
-  // 1. Merge the old store and the new update in new_store.
-  // 2. Create a ListUpdateResponse containing RICE encoded hash-prefixes and
-  // response_type as FULL_UPDATE, and write that to disk.
-  // 3. Remove this if condition after completing 1. and 2.
-  if (response->has_response_type() &&
-      response->response_type() == ListUpdateResponse::FULL_UPDATE) {
-    StoreWriteResult result = new_store->WriteToDisk(std::move(response));
-    RecordStoreWriteResult(result);
+  ApplyUpdateResult apply_update_result =
+      new_store->UpdateHashPrefixMap(response.get(), &hash_prefix_map_);
+  RecordApplyUpdateResult(apply_update_result);
+  if (apply_update_result == APPLY_UPDATE_SUCCESS) {
+    new_store->state_ = response->new_client_state();
+    RecordStoreWriteResult(new_store->WriteHashPrefixMapToDisk());
+  } else {
+    DVLOG(1) << "Failed to apply update: " << apply_update_result;
+    new_store.reset();
   }
 
   // new_store is done updating, pass it to the callback.
@@ -101,21 +155,257 @@ void V4Store::ApplyUpdate(
       FROM_HERE, base::Bind(callback, base::Passed(&new_store)));
 }
 
+ApplyUpdateResult V4Store::UpdateHashPrefixMap(ListUpdateResponse* response,
+                                               HashPrefixMap* base) {
+  const bool is_full_update =
+      response->response_type() == ListUpdateResponse::FULL_UPDATE;
+
+  std::vector<int32_t> removals;
+  for (const ThreatEntrySet& removal : response->removals()) {
+    if (removal.compression_type() != RAW || !removal.has_raw_indices())
+      return UNEXPECTED_COMPRESSION_TYPE_REMOVALS_FAILURE;
+    const auto& indices = removal.raw_indices().indices();
+    removals.insert(removals.end(), indices.begin(), indices.end());
+  }
+  if (is_full_update && !removals.empty())
+    return UNEXPECTED_REMOVALS_IN_FULL_UPDATE_FAILURE;
+
+  size_t base_count = 0;
+  if (base && !is_full_update) {
+    for (const auto& entry : *base)
+      base_count += entry.second.size() / entry.first;
+  }
+  std::sort(removals.begin(), removals.end());
+  if (!removals.empty() &&
+      (removals.front() < 0 ||
+       static_cast<size_t>(removals.back()) >= base_count ||
+       std::adjacent_find(removals.begin(), removals.end()) !=
+           removals.end())) {
+    return REMOVALS_INDEX_OUT_OF_RANGE_FAILURE;
+  }
+
+  HashPrefixMap additions_map;
+  ApplyUpdateResult result =
+      GetAdditionsMap(response->mutable_additions(), &additions_map);
+  if (result != APPLY_UPDATE_SUCCESS)
+    return result;
+
+  // The update is valid, so nothing can fail from here on. Take over the hash
+  // prefixes of |base| rather than copying them: with the tens of thousands of
+  // prefixes in a list, holding two copies would double the peak memory of
+  // every update. A full update drops them instead.
+  if (base) {
+    if (is_full_update)
+      base->clear();
+    else
+      hash_prefix_map_.swap(*base);
+  }
+  RemovePrefixesAtIndices(removals, &hash_prefix_map_);
+
+  for (auto& entry : additions_map) {
+    HashPrefixes& prefixes = hash_prefix_map_[entry.first];
+    if (prefixes.empty())
+      prefixes.swap(entry.second);
+    else
+      MergeSortedPrefixes(entry.first, entry.second, &prefixes);
+  }
+  for (auto it = hash_prefix_map_.begin(); it != hash_prefix_map_.end();) {
+    if (it->second.empty())
+      it = hash_prefix_map_.erase(it);
+    else
+      ++it;
+  }
+
+  return APPLY_UPDATE_SUCCESS;
+}
+
+// static
+ApplyUpdateResult V4Store::GetAdditionsMap(
+    google::protobuf::RepeatedPtrField<ThreatEntrySet>* additions,
+    HashPrefixMap* additions_map) {
+  // Check all the additions before moving any of them out of the response.
+  for (const ThreatEntrySet& addition : *additions) {
+    if (addition.compression_type() != RAW || !addition.has_raw_hashes())
+      return UNEXPECTED_COMPRESSION_TYPE_ADDITIONS_FAILURE;
+    const RawHashes& raw_hashes = addition.raw_hashes();
+    if (raw_hashes.prefix_size() < static_cast<int>(kMinHashPrefixLength))
+      return PREFIX_SIZE_TOO_SMALL_FAILURE;
+    if (raw_hashes.prefix_size() > static_cast<int>(kMaxHashPrefixLength))
+      return PREFIX_SIZE_TOO_LARGE_FAILURE;
+    if (raw_hashes.raw_hashes().size() % raw_hashes.prefix_size() != 0)
+      return ADDITIONS_SIZE_UNEXPECTED_FAILURE;
+  }
+
+  for (ThreatEntrySet& addition : *additions) {
+    RawHashes* raw_hashes = addition.mutable_raw_hashes();
+    HashPrefixes& prefixes = (*additions_map)[raw_hashes->prefix_size()];
+    if (prefixes.empty())
+      prefixes.swap(*raw_hashes->mutable_raw_hashes());
+    else
+      prefixes.append(raw_hashes->raw_hashes());
+  }
+  for (auto& entry : *additions_map)
+    SortAndRemoveDuplicates(entry.first, &entry.second);
+
+  return APPLY_UPDATE_SUCCESS;
+}
+
+// static
+void V4Store::MergeSortedPrefixes(PrefixSize prefix_size,
+                                  const HashPrefixes& additions,
+                                  HashPrefixes* prefixes) {
+  if (additions.empty())
+    return;
+
+  size_t old_end = prefixes->size();
+  size_t additions_end = additions.size();
+  prefixes->resize(old_end + additions_end);
+  char* data = &(*prefixes)[0];
+
+  // Merge from the back, so that the prefixes that have not been merged yet
+  // are never overwritten.
+  size_t write = prefixes->size();
+  while (additions_end > 0) {
+    write -= prefix_size;
+    if (old_end > 0 &&
+        memcmp(data + old_end - prefix_size,
+               additions.data() + additions_end - prefix_size,
+               prefix_size) > 0) {
+      old_end -= prefix_size;
+      memmove(data + write, data + old_end, prefix_size);
+    } else {
+      additions_end -= prefix_size;
+      memcpy(data + write, additions.data() + additions_end, prefix_size);
+    }
+  }
+
+  // Additions that were already in the store are now next to their copy.
+  size_t unique_end = prefix_size;
+  for (size_t read = prefix_size; read < prefixes->size();
+       read += prefix_size) {
+    if (memcmp(data + unique_end - prefix_size, data + read, prefix_size) ==
+        0) {
+      continue;
+    }
+    if (unique_end != read)
+      memmove(data + unique_end, data + read, prefix_size);
+    unique_end += prefix_size;
+  }
+  prefixes->resize(unique_end);
+}
+
+// static
+void V4Store::RemovePrefixesAtIndices(const std::vector<int32_t>& indices,
+                                      HashPrefixMap* prefix_map) {
+  if (indices.empty())
+    return;
+
+  struct Cursor {
+    PrefixSize prefix_size;
+    HashPrefixes* prefixes;
+    size_t read;
+    size_t write;
+  };
+  std::vector<Cursor> cursors;
+  for (auto& entry : *prefix_map)
+    cursors.push_back({entry.first, &entry.second, 0, 0});
+
+  // Visit the prefixes of all the sizes in lexicographic order, like a k-way
+  // merge, until the last index to remove, and compact them as we go.
+  auto next_removal = indices.begin();
+  for (int32_t index = 0; next_removal != indices.end(); ++index) {
+    Cursor* smallest = nullptr;
+    for (Cursor& cursor : cursors) {
+      if (cursor.read == cursor.prefixes->size())
+        continue;
+      if (!smallest ||
+          base::StringPiece(cursor.prefixes->data() + cursor.read,
+                            cursor.prefix_size) <
+              base::StringPiece(smallest->prefixes->data() + smallest->read,
+                                smallest->prefix_size)) {
+        smallest = &cursor;
+      }
+    }
+    DCHECK(smallest);
+
+    if (index == *next_removal) {
+      ++next_removal;
+    } else {
+      if (smallest->write != smallest->read) {
+        char* data = &(*smallest->prefixes)[0];
+        memmove(data + smallest->write, data + smallest->read,
+                smallest->prefix_size);
+      }
+      smallest->write += smallest->prefix_size;
+    }
+    smallest->read += smallest->prefix_size;
+  }
+
+  for (Cursor& cursor : cursors) {
+    size_t remaining = cursor.prefixes->size() - cursor.read;
+    if (remaining && cursor.write != cursor.read) {
+      char* data = &(*cursor.prefixes)[0];
+      memmove(data + cursor.write, data + cursor.read, remaining);
+    }
+    cursor.prefixes->resize(cursor.write + remaining);
+  }
+}
+
+HashPrefix V4Store::GetMatchingHashPrefix(const FullHash& full_hash) const {
+  for (const auto& entry : hash_prefix_map_) {
+    if (HashPrefixMatches(full_hash, entry.first, entry.second))
+      return full_hash.substr(0, entry.first);
+  }
+  return HashPrefix();
+}
+
+// static
+bool V4Store::HashPrefixMatches(const FullHash& full_hash,
+                                PrefixSize prefix_size,
+                                const HashPrefixes& prefixes) {
+  if (full_hash.size() < prefix_size)
+    return false;
+  base::StringPiece prefix(full_hash.data(), prefix_size);
+
+  size_t begin = 0;
+  size_t end = prefixes.size() / prefix_size;
+  while (begin < end) {
+    size_t mid = begin + (end - begin) / 2;
+    int comparison = PrefixAt(prefixes, prefix_size, mid).compare(prefix);
+    if (comparison == 0)
+      return true;
+    if (comparison < 0)
+      begin = mid + 1;
+    else
+      end = mid;
+  }
+  return false;
+}
+
 StoreReadResult V4Store::ReadFromDisk() {
   DCHECK(task_runner_->RunsTasksOnCurrentThread());
 
-  std::string contents;
-  bool read_success = base::ReadFileToString(store_path_, &contents);
-  if (!read_success) {
+  int64_t file_size;
+  if (!base::GetFileSize(store_path_, &file_size)) {
     return FILE_UNREADABLE_FAILURE;
   }
 
-  if (contents.empty()) {
+  if (file_size == 0) {
     return FILE_EMPTY_FAILURE;
   }
 
+  // Parse the file straight from the page cache, instead of reading it into a
+  // string first, which would double the peak memory usage at startup.
+  base::MemoryMappedFile mapped_file;
+  if (!mapped_file.Initialize(store_path_)) {
+    return FILE_UNREADABLE_FAILURE;
+  }
+
+  const size_t kMaxParsableSize = std::numeric_limits<int>::max();
   V4StoreFileFormat file_format;
-  if (!file_format.ParseFromString(contents)) {
+  if (mapped_file.length() > kMaxParsableSize ||
+      !file_format.ParseFromArray(mapped_file.data(),
+                                  static_cast<int>(mapped_file.length()))) {
     return PROTO_PARSING_FAILURE;
   }
 
@@ -137,15 +427,44 @@ StoreReadResult V4Store::ReadFromDisk() {
     return HASH_PREFIX_INFO_MISSING_FAILURE;
   }
 
-  ListUpdateResponse list_update_response = file_format.list_update_response();
-  state_ = list_update_response.new_client_state();
-  // TODO(vakh): Do more with what's read from the disk.
+  ListUpdateResponse* list_update_response =
+      file_format.mutable_list_update_response();
+  ApplyUpdateResult apply_update_result =
+      UpdateHashPrefixMap(list_update_response, nullptr);
+  RecordApplyUpdateResult(apply_update_result);
+  if (apply_update_result != APPLY_UPDATE_SUCCESS) {
+    hash_prefix_map_.clear();
+    return HASH_PREFIX_MAP_GENERATION_FAILURE;
+  }
 
+  state_ = list_update_response->new_client_state();
   return READ_SUCCESS;
 }
 
-StoreWriteResult V4Store::WriteToDisk(
-    std::unique_ptr<ListUpdateResponse> response) const {
+StoreWriteResult V4Store::WriteHashPrefixMapToDisk() {
+  ListUpdateResponse response;
+  response.set_response_type(ListUpdateResponse::FULL_UPDATE);
+  response.set_new_client_state(state_);
+  for (auto& entry : hash_prefix_map_) {
+    ThreatEntrySet* additions = response.add_additions();
+    additions->set_compression_type(RAW);
+    RawHashes* raw_hashes = additions->mutable_raw_hashes();
+    raw_hashes->set_prefix_size(entry.first);
+    raw_hashes->mutable_raw_hashes()->swap(entry.second);
+  }
+
+  StoreWriteResult result = WriteToDisk(&response);
+
+  // Take the hash prefixes back.
+  for (ThreatEntrySet& additions : *response.mutable_additions()) {
+    RawHashes* raw_hashes = additions.mutable_raw_hashes();
+    hash_prefix_map_[raw_hashes->prefix_size()].swap(
+        *raw_hashes->mutable_raw_hashes());
+  }
+  return result;
+}
+
+StoreWriteResult V4Store::WriteToDisk(ListUpdateResponse* response) const {
   // Do not write partial updates to the disk.
   // After merging the updates, the ListUpdateResponse passed to this method
   // should be a FULL_UPDATE.
@@ -165,12 +484,16 @@ StoreWriteResult V4Store::WriteToDisk(
   file_format.set_version_number(kFileVersion);
   ListUpdateResponse* response_to_write =
       file_format.mutable_list_update_response();
-  response_to_write->Swap(response.get());
+  response_to_write->Swap(response);
   std::string file_format_string;
   file_format.SerializeToString(&file_format_string);
-  size_t written = base::WriteFile(new_filename, file_format_string.data(),
-                                   file_format_string.size());
-  DCHECK_EQ(file_format_string.size(), written);
+  response_to_write->Swap(response);
+  int written = base::WriteFile(new_filename, file_format_string.data(),
+                                file_format_string.size());
+  if (written < 0 ||
+      static_cast<size_t>(written) != file_format_string.size()) {
+    return UNEXPECTED_BYTES_WRITTEN_FAILURE;
+  }
 
   if (!base::Move(new_filename, store_path_)) {
     DVLOG(1) << "store_path_: " << store_path_.value();
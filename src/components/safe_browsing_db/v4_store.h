@@ -5,6 +5,10 @@
 #ifndef COMPONENTS_SAFE_BROWSING_DB_V4_STORE_H_
 #define COMPONENTS_SAFE_BROWSING_DB_V4_STORE_H_
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequenced_task_runner.h"
@@ -15,9 +19,26 @@ namespace safe_browsing {
 
 class V4Store;
 
-typedef base::Callback<void(std::unique_ptr<V4Store>)>
+// The |store| is null if the update could not be applied, in which case the
+// store that the update was applied to is left untouched.
+typedef base::Callback<void(std::unique_ptr<V4Store> store)>
     UpdatedStoreReadyCallback;
 
+// The sizes of the hash prefixes are between 4 and 32 bytes.
+typedef size_t PrefixSize;
+
+// A hash prefix, or a full SHA256 hash of a URL expression.
+typedef std::string HashPrefix;
+typedef std::string FullHash;
+
+// The hash prefixes of one size, sorted lexicographically and concatenated
+// without separators. The layout is as compact as the wire format and can be
+// binary searched directly, without any per-prefix allocations.
+typedef std::string HashPrefixes;
+
+// Maps each prefix size to the hash prefixes of that size.
+typedef std::map<PrefixSize, HashPrefixes> HashPrefixMap;
+
 // Enumerate different failure events while parsing the file read from disk for
 // histogramming purposes.  DO NOT CHANGE THE ORDERING OF THESE VALUES.
 enum StoreReadResult {
@@ -50,6 +71,9 @@ enum StoreReadResult {
   // disk or if there was disk corruption.
   HASH_PREFIX_INFO_MISSING_FAILURE = 7,
 
+  // The hash prefixes in the file were malformed.
+  HASH_PREFIX_MAP_GENERATION_FAILURE = 8,
+
   // Memory space for histograms is determined by the max.  ALWAYS
   // ADD NEW VALUES BEFORE THIS ONE.
   STORE_READ_RESULT_MAX
@@ -79,6 +103,42 @@ enum StoreWriteResult {
   STORE_WRITE_RESULT_MAX
 };
 
+// Enumerate the results of applying an update, or of loading the hash prefixes
+// read from disk, for histogramming purposes.
+// DO NOT CHANGE THE ORDERING OF THESE VALUES.
+enum ApplyUpdateResult {
+  // No errors.
+  APPLY_UPDATE_SUCCESS = 0,
+
+  // Reserved for errors in parsing this enum.
+  UNEXPECTED_APPLY_UPDATE_FAILURE = 1,
+
+  // The prefix size was smaller than the minimum of 4 bytes.
+  PREFIX_SIZE_TOO_SMALL_FAILURE = 2,
+
+  // The prefix size was larger than the maximum of 32 bytes.
+  PREFIX_SIZE_TOO_LARGE_FAILURE = 3,
+
+  // The length of the additions was not a multiple of the prefix size.
+  ADDITIONS_SIZE_UNEXPECTED_FAILURE = 4,
+
+  // The additions were not in the RAW format, the only one requested.
+  UNEXPECTED_COMPRESSION_TYPE_ADDITIONS_FAILURE = 5,
+
+  // The removals were not in the RAW format, the only one requested.
+  UNEXPECTED_COMPRESSION_TYPE_REMOVALS_FAILURE = 6,
+
+  // A removal index was negative, repeated, or past the last hash prefix.
+  REMOVALS_INDEX_OUT_OF_RANGE_FAILURE = 7,
+
+  // A full update contained removals.
+  UNEXPECTED_REMOVALS_IN_FULL_UPDATE_FAILURE = 8,
+
+  // Memory space for histograms is determined by the max.  ALWAYS
+  // ADD NEW VALUES BEFORE THIS ONE.
+  APPLY_UPDATE_RESULT_MAX
+};
+
 // Factory for creating V4Store. Tests implement this factory to create fake
 // stores for testing.
 class V4StoreFactory {
@@ -102,9 +162,23 @@ class V4Store {
 
   const base::FilePath& store_path() const { return store_path_; }
 
-  void ApplyUpdate(std::unique_ptr<ListUpdateResponse> response,
-                   const scoped_refptr<base::SingleThreadTaskRunner>&,
-                   UpdatedStoreReadyCallback);
+  const HashPrefixMap& hash_prefix_map() const { return hash_prefix_map_; }
+
+  // Applies the |response| to the hash prefixes of this store, writes the
+  // result to disk, and passes a new store holding it to the |callback| on the
+  // |callback_task_runner|. The update is validated before anything is
+  // modified: if it is malformed, the |callback| gets a null store and this
+  // store is left untouched. Otherwise, the hash prefixes are moved into the
+  // new store and merged there in place, rather than copied, so this store
+  // must not be used for lookups after it has been replaced.
+  void ApplyUpdate(
+      std::unique_ptr<ListUpdateResponse> response,
+      const scoped_refptr<base::SingleThreadTaskRunner>& callback_task_runner,
+      UpdatedStoreReadyCallback callback);
+
+  // Returns the hash prefix of |full_hash| that is in this store, or an empty
+  // string if there is none.
+  HashPrefix GetMatchingHashPrefix(const FullHash& full_hash) const;
 
   std::string DebugString() const;
 
@@ -127,18 +201,67 @@ class V4Store {
   FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestWritePartialResponseType);
   FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestWriteFullResponseType);
   FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestReadFromFileWithUnknownProto);
+  FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestReadFromFileWithHashPrefixes);
+  FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestReadFromFileWithBadPrefixSize);
+  FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestApplyFullUpdate);
+  FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestApplyPartialUpdate);
+  FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestApplyUpdateFailureKeepsStore);
+  FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestGetMatchingHashPrefix);
 
   // Reads the state of the store from the file on disk and returns the reason
-  // for the failure or reports success.
+  // for the failure or reports success. The file is memory-mapped and parsed
+  // in place, so its contents are never copied into a temporary buffer.
   StoreReadResult ReadFromDisk();
 
   // Writes the FULL_UPDATE |response| to disk as a V4StoreFileFormat proto.
-  StoreWriteResult WriteToDisk(
-      std::unique_ptr<ListUpdateResponse> response) const;
+  // The |response| is swapped into the file proto while it is serialized and
+  // then swapped back, so that the hash prefixes are not copied.
+  StoreWriteResult WriteToDisk(ListUpdateResponse* response) const;
+
+  // Writes the state and the hash prefixes of this store to disk as a
+  // FULL_UPDATE.
+  StoreWriteResult WriteHashPrefixMapToDisk();
+
+  // Merges the additions and the removals in |response| into
+  // |hash_prefix_map_|. A FULL_UPDATE replaces the hash prefixes of |base|,
+  // any other update is merged into them; |base| may be null when there are no
+  // hash prefixes to merge into. Nothing is modified unless the whole update
+  // is valid. The hash prefixes of |base| are moved, not copied, and the
+  // additions are swapped out of the |response|.
+  ApplyUpdateResult UpdateHashPrefixMap(ListUpdateResponse* response,
+                                        HashPrefixMap* base);
+
+  // Moves the hash prefixes in the |additions| into |additions_map|, sorted
+  // and without duplicates.
+  static ApplyUpdateResult GetAdditionsMap(
+      google::protobuf::RepeatedPtrField<ThreatEntrySet>* additions,
+      HashPrefixMap* additions_map);
+
+  // Merges the sorted |additions| into the sorted |prefixes| in place, growing
+  // |prefixes| only by the size of |additions|.
+  static void MergeSortedPrefixes(PrefixSize prefix_size,
+                                  const HashPrefixes& additions,
+                                  HashPrefixes* prefixes);
+
+  // Drops the hash prefixes at the sorted |indices| of the lexicographically
+  // ordered union of all the hash prefixes in |prefix_map|, which is how the
+  // server refers to them. Each HashPrefixes is compacted in place.
+  static void RemovePrefixesAtIndices(const std::vector<int32_t>& indices,
+                                      HashPrefixMap* prefix_map);
+
+  // Returns whether any of the sorted |prefixes| of |prefix_size| bytes each
+  // is a prefix of |full_hash|.
+  static bool HashPrefixMatches(const FullHash& full_hash,
+                                PrefixSize prefix_size,
+                                const HashPrefixes& prefixes);
 
   // The state of the store as returned by the PVer4 server in the last applied
   // update response.
   std::string state_;
+
+  // The hash prefixes in this store.
+  HashPrefixMap hash_prefix_map_;
+
   const base::FilePath store_path_;
   const scoped_refptr<base::SequencedTaskRunner> task_runner_;
 };
@@ -2,11 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/memory/ptr_util.h"
 #include "base/run_loop.h"
 #include "base/test/test_simple_task_runner.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "components/safe_browsing_db/v4_store.h"
 #include "components/safe_browsing_db/v4_store.pb.h"
@@ -17,7 +19,9 @@ namespace safe_browsing {
 
 class V4StoreTest : public PlatformTest {
  public:
-  V4StoreTest() : task_runner_(new base::TestSimpleTaskRunner) {}
+  V4StoreTest()
+      : task_runner_(new base::TestSimpleTaskRunner),
+        called_back_(false) {}
 
   void SetUp() override {
     PlatformTest::SetUp();
@@ -50,10 +54,50 @@ class V4StoreTest : public PlatformTest {
                     file_format_string.size());
   }
 
+  // Adds |hashes|, the concatenated hash prefixes of |prefix_size| bytes each,
+  // to the additions of |response|.
+  static void AddRawHashes(int prefix_size,
+                           const std::string& hashes,
+                           ListUpdateResponse* response) {
+    ThreatEntrySet* additions = response->add_additions();
+    additions->set_compression_type(RAW);
+    additions->mutable_raw_hashes()->set_prefix_size(prefix_size);
+    additions->mutable_raw_hashes()->set_raw_hashes(hashes);
+  }
+
+  static void AddRawIndices(const std::vector<int32_t>& indices,
+                            ListUpdateResponse* response) {
+    ThreatEntrySet* removals = response->add_removals();
+    removals->set_compression_type(RAW);
+    for (int32_t index : indices)
+      removals->mutable_raw_indices()->add_indices(index);
+  }
+
+  // Applies |response| to |store| and returns the store passed to the
+  // callback.
+  std::unique_ptr<V4Store> ApplyUpdate(
+      V4Store* store,
+      std::unique_ptr<ListUpdateResponse> response) {
+    called_back_ = false;
+    store->ApplyUpdate(
+        std::move(response), base::ThreadTaskRunnerHandle::Get(),
+        base::Bind(&V4StoreTest::UpdatedStoreReady, base::Unretained(this)));
+    base::RunLoop().RunUntilIdle();
+    EXPECT_TRUE(called_back_);
+    return std::move(updated_store_);
+  }
+
+  void UpdatedStoreReady(std::unique_ptr<V4Store> store) {
+    called_back_ = true;
+    updated_store_ = std::move(store);
+  }
+
   base::ScopedTempDir temp_dir_;
   base::FilePath store_path_;
   scoped_refptr<base::TestSimpleTaskRunner> task_runner_;
   content::TestBrowserThreadBundle thread_bundle_;
+  bool called_back_;
+  std::unique_ptr<V4Store> updated_store_;
 };
 
 TEST_F(V4StoreTest, TestReadFromEmptyFile) {
@@ -114,31 +158,151 @@ TEST_F(V4StoreTest, TestReadFromNoHashPrefixesFile) {
 }
 
 TEST_F(V4StoreTest, TestWriteNoResponseType) {
+  ListUpdateResponse list_update_response;
   EXPECT_EQ(INVALID_RESPONSE_TYPE_FAILURE,
             V4Store(task_runner_, store_path_)
-                .WriteToDisk(base::WrapUnique(new ListUpdateResponse)));
+                .WriteToDisk(&list_update_response));
 }
 
 TEST_F(V4StoreTest, TestWritePartialResponseType) {
-  std::unique_ptr<ListUpdateResponse> list_update_response(
-      new ListUpdateResponse);
-  list_update_response->set_response_type(ListUpdateResponse::PARTIAL_UPDATE);
+  ListUpdateResponse list_update_response;
+  list_update_response.set_response_type(ListUpdateResponse::PARTIAL_UPDATE);
   EXPECT_EQ(INVALID_RESPONSE_TYPE_FAILURE,
             V4Store(task_runner_, store_path_)
-                .WriteToDisk(std::move(list_update_response)));
+                .WriteToDisk(&list_update_response));
 }
 
 TEST_F(V4StoreTest, TestWriteFullResponseType) {
-  std::unique_ptr<ListUpdateResponse> list_update_response(
-      new ListUpdateResponse);
-  list_update_response->set_response_type(ListUpdateResponse::FULL_UPDATE);
-  list_update_response->set_new_client_state("test_client_state");
+  ListUpdateResponse list_update_response;
+  list_update_response.set_response_type(ListUpdateResponse::FULL_UPDATE);
+  list_update_response.set_new_client_state("test_client_state");
   EXPECT_EQ(WRITE_SUCCESS, V4Store(task_runner_, store_path_)
-                               .WriteToDisk(std::move(list_update_response)));
+                               .WriteToDisk(&list_update_response));
+  // The response is left intact.
+  EXPECT_EQ("test_client_state", list_update_response.new_client_state());
 
   std::unique_ptr<V4Store> read_store(new V4Store(task_runner_, store_path_));
   EXPECT_EQ(READ_SUCCESS, read_store->ReadFromDisk());
   EXPECT_EQ("test_client_state", read_store->state_);
 }
 
+TEST_F(V4StoreTest, TestReadFromFileWithHashPrefixes) {
+  ListUpdateResponse list_update_response;
+  list_update_response.set_response_type(ListUpdateResponse::FULL_UPDATE);
+  list_update_response.set_new_client_state("test_client_state");
+  // Unsorted and with a duplicate, which the store must tolerate.
+  AddRawHashes(4, "ccccaaaabbbbaaaa", &list_update_response);
+  AddRawHashes(32, std::string(32, 'z'), &list_update_response);
+  WriteFileFormatProtoToFile(0x600D71FE, 9, &list_update_response);
+
+  V4Store store(task_runner_, store_path_);
+  EXPECT_EQ(READ_SUCCESS, store.ReadFromDisk());
+  EXPECT_EQ("test_client_state", store.state());
+  ASSERT_EQ(2u, store.hash_prefix_map().size());
+  EXPECT_EQ("aaaabbbbcccc", store.hash_prefix_map().at(4));
+  EXPECT_EQ(std::string(32, 'z'), store.hash_prefix_map().at(32));
+}
+
+TEST_F(V4StoreTest, TestReadFromFileWithBadPrefixSize) {
+  ListUpdateResponse list_update_response;
+  list_update_response.set_response_type(ListUpdateResponse::FULL_UPDATE);
+  AddRawHashes(3, "aaabbb", &list_update_response);
+  WriteFileFormatProtoToFile(0x600D71FE, 9, &list_update_response);
+
+  V4Store store(task_runner_, store_path_);
+  EXPECT_EQ(HASH_PREFIX_MAP_GENERATION_FAILURE, store.ReadFromDisk());
+  EXPECT_TRUE(store.hash_prefix_map().empty());
+}
+
+TEST_F(V4StoreTest, TestApplyFullUpdate) {
+  V4Store store(task_runner_, store_path_);
+  store.hash_prefix_map_[4] = "xxxx";
+
+  std::unique_ptr<ListUpdateResponse> response(new ListUpdateResponse);
+  response->set_response_type(ListUpdateResponse::FULL_UPDATE);
+  response->set_new_client_state("full_state");
+  AddRawHashes(4, "bbbbaaaa", response.get());
+  AddRawHashes(5, "ccccc", response.get());
+
+  std::unique_ptr<V4Store> new_store = ApplyUpdate(&store, std::move(response));
+  ASSERT_TRUE(new_store);
+  EXPECT_EQ("full_state", new_store->state());
+  HashPrefixMap expected_map;
+  expected_map[4] = "aaaabbbb";
+  expected_map[5] = "ccccc";
+  EXPECT_EQ(expected_map, new_store->hash_prefix_map());
+
+  // The merged hash prefixes are written to disk.
+  V4Store read_store(task_runner_, store_path_);
+  EXPECT_EQ(READ_SUCCESS, read_store.ReadFromDisk());
+  EXPECT_EQ("full_state", read_store.state());
+  EXPECT_EQ(expected_map, read_store.hash_prefix_map());
+}
+
+TEST_F(V4StoreTest, TestApplyPartialUpdate) {
+  V4Store store(task_runner_, store_path_);
+  store.hash_prefix_map_[4] = "aaaabbbbdddd";
+  store.hash_prefix_map_[5] = "ccccc";
+
+  std::unique_ptr<ListUpdateResponse> response(new ListUpdateResponse);
+  response->set_response_type(ListUpdateResponse::PARTIAL_UPDATE);
+  response->set_new_client_state("partial_state");
+  // The indices refer to the lexicographic order of the prefixes of all sizes:
+  // "aaaa", "bbbb", "ccccc", "dddd".
+  AddRawIndices({2, 1}, response.get());
+  AddRawHashes(4, "ccccaaaa", response.get());
+  AddRawHashes(6, "eeeeee", response.get());
+
+  std::unique_ptr<V4Store> new_store = ApplyUpdate(&store, std::move(response));
+  ASSERT_TRUE(new_store);
+  EXPECT_EQ("partial_state", new_store->state());
+  HashPrefixMap expected_map;
+  expected_map[4] = "aaaaccccdddd";
+  expected_map[6] = "eeeeee";
+  EXPECT_EQ(expected_map, new_store->hash_prefix_map());
+
+  // The hash prefixes were moved to the new store rather than copied.
+  EXPECT_TRUE(store.hash_prefix_map().empty());
+}
+
+TEST_F(V4StoreTest, TestApplyUpdateFailureKeepsStore) {
+  V4Store store(task_runner_, store_path_);
+  store.state_ = "old_state";
+  store.hash_prefix_map_[4] = "aaaabbbb";
+
+  std::unique_ptr<ListUpdateResponse> response(new ListUpdateResponse);
+  response->set_response_type(ListUpdateResponse::PARTIAL_UPDATE);
+  response->set_new_client_state("new_state");
+  AddRawHashes(4, "cccc", response.get());
+  AddRawIndices({2}, response.get());
+  EXPECT_FALSE(ApplyUpdate(&store, std::move(response)));
+
+  response.reset(new ListUpdateResponse);
+  response->set_response_type(ListUpdateResponse::PARTIAL_UPDATE);
+  AddRawHashes(4, "cccccc", response.get());
+  EXPECT_FALSE(ApplyUpdate(&store, std::move(response)));
+
+  response.reset(new ListUpdateResponse);
+  response->set_response_type(ListUpdateResponse::FULL_UPDATE);
+  AddRawIndices({0}, response.get());
+  EXPECT_FALSE(ApplyUpdate(&store, std::move(response)));
+
+  EXPECT_EQ("old_state", store.state());
+  EXPECT_EQ("aaaabbbb", store.hash_prefix_map().at(4));
+  EXPECT_FALSE(base::PathExists(store_path_));
+}
+
+TEST_F(V4StoreTest, TestGetMatchingHashPrefix) {
+  V4Store store(task_runner_, store_path_);
+  store.hash_prefix_map_[4] = "aaaabbbbdddd";
+  store.hash_prefix_map_[32] = std::string(32, 'c');
+
+  EXPECT_EQ("aaaa", store.GetMatchingHashPrefix("aaaa" + std::string(28, 'x')));
+  EXPECT_EQ("dddd", store.GetMatchingHashPrefix("dddd" + std::string(28, 'x')));
+  EXPECT_EQ(std::string(32, 'c'),
+            store.GetMatchingHashPrefix(std::string(32, 'c')));
+  EXPECT_EQ("", store.GetMatchingHashPrefix("cccc" + std::string(28, 'x')));
+  EXPECT_EQ("", store.GetMatchingHashPrefix("eeee" + std::string(28, 'x')));
+}
+
 }  // namespace safe_browsing
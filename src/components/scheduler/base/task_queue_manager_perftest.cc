@@ -87,6 +87,32 @@ class TaskQueueManagerPerfTest : public testing::Test {
     TestDelayedTask();
   }
 
+  void TestImmediateTask() {
+    if (--num_tasks_to_run_ == 0) {
+      message_loop_->QuitWhenIdle();
+    }
+
+    num_tasks_in_flight_--;
+    // Keep up to max_tasks_in_flight_ tasks pending, spread evenly over the
+    // queues so that selection has to pick between many non-empty queues.
+    while (num_tasks_in_flight_ < max_tasks_in_flight_ &&
+           num_tasks_to_post_ > 0) {
+      unsigned int queue = num_tasks_to_post_ % num_queues_;
+      queues_[queue]->PostTask(
+          FROM_HERE, base::Bind(&TaskQueueManagerPerfTest::TestImmediateTask,
+                                base::Unretained(this)));
+      num_tasks_in_flight_++;
+      num_tasks_to_post_--;
+    }
+  }
+
+  void ResetAndCallTestImmediateTask(unsigned int num_tasks_to_run) {
+    num_tasks_in_flight_ = 1;
+    num_tasks_to_post_ = num_tasks_to_run;
+    num_tasks_to_run_ = num_tasks_to_run;
+    TestImmediateTask();
+  }
+
   void Benchmark(const std::string& trace, const base::Closure& test_task) {
     base::ThreadTicks start = base::ThreadTicks::Now();
     base::ThreadTicks now;
@@ -152,12 +178,59 @@ TEST_F(TaskQueueManagerPerfTest, RunTenThousandDelayedTasks_ThirtyTwoQueues) {
   Initialize(32u);
 
   max_tasks_in_flight_ = 200;
-  Benchmark("run 10000 delayed tasks with eight queues",
+  Benchmark("run 10000 delayed tasks with thirty two queues",
             base::Bind(&TaskQueueManagerPerfTest::ResetAndCallTestDelayedTask,
                        base::Unretained(this), 10000));
 }
 
-// TODO(alexclarke): Add additional tests with different mixes of non-delayed vs
-// delayed tasks.
+TEST_F(TaskQueueManagerPerfTest, RunTenThousandImmediateTasks_OneQueue) {
+  if (!base::ThreadTicks::IsSupported())
+    return;
+  Initialize(1u);
+
+  max_tasks_in_flight_ = 200;
+  Benchmark(
+      "run 10000 immediate tasks with one queue",
+      base::Bind(&TaskQueueManagerPerfTest::ResetAndCallTestImmediateTask,
+                 base::Unretained(this), 10000));
+}
+
+TEST_F(TaskQueueManagerPerfTest, RunTenThousandImmediateTasks_EightQueues) {
+  if (!base::ThreadTicks::IsSupported())
+    return;
+  Initialize(8u);
+
+  max_tasks_in_flight_ = 200;
+  Benchmark(
+      "run 10000 immediate tasks with eight queues",
+      base::Bind(&TaskQueueManagerPerfTest::ResetAndCallTestImmediateTask,
+                 base::Unretained(this), 10000));
+}
+
+TEST_F(TaskQueueManagerPerfTest, RunTenThousandImmediateTasks_ThirtyTwoQueues) {
+  if (!base::ThreadTicks::IsSupported())
+    return;
+  Initialize(32u);
+
+  max_tasks_in_flight_ = 200;
+  Benchmark(
+      "run 10000 immediate tasks with thirty two queues",
+      base::Bind(&TaskQueueManagerPerfTest::ResetAndCallTestImmediateTask,
+                 base::Unretained(this), 10000));
+}
+
+// A renderer main thread with many frames has roughly this many queues.
+TEST_F(TaskQueueManagerPerfTest,
+       RunTenThousandImmediateTasks_OneHundredTwentyEightQueues) {
+  if (!base::ThreadTicks::IsSupported())
+    return;
+  Initialize(128u);
+
+  max_tasks_in_flight_ = 200;
+  Benchmark(
+      "run 10000 immediate tasks with one hundred twenty eight queues",
+      base::Bind(&TaskQueueManagerPerfTest::ResetAndCallTestImmediateTask,
+                 base::Unretained(this), 10000));
+}
 
 }  // namespace scheduler
@@ -7,6 +7,11 @@
 namespace scheduler {
 namespace switches {
 
+// The share of the main thread which the timer and loading tasks of a
+// background page may use, e.g. "0.01" for 1%.
+const char kBackgroundCPUTimeBudgetRecoveryRate[] =
+    "background-cpu-time-budget-recovery-rate";
+
 // Disable task throttling of timer tasks from background pages.
 const char kDisableBackgroundTimerThrottling[] =
     "disable-background-timer-throttling";
@@ -8,6 +8,7 @@
 namespace scheduler {
 namespace switches {
 
+extern const char kBackgroundCPUTimeBudgetRecoveryRate[];
 extern const char kDisableBackgroundTimerThrottling[];
 
 }  // namespace switches
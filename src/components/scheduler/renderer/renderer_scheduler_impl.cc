@@ -105,10 +105,12 @@ RendererSchedulerImpl::MainThreadOnly::MainThreadOnly(
     base::TickClock* time_source)
     : loading_task_cost_estimator(time_source,
                                   kLoadingTaskEstimationSampleCount,
-                                  kLoadingTaskEstimationPercentile),
+                                  kLoadingTaskEstimationPercentile,
+                                  "RendererScheduler.LoadingTaskDuration"),
       timer_task_cost_estimator(time_source,
                                 kTimerTaskEstimationSampleCount,
-                                kTimerTaskEstimationPercentile),
+                                kTimerTaskEstimationPercentile,
+                                "RendererScheduler.TimerTaskDuration"),
       idle_time_estimator(compositor_task_runner,
                           time_source,
                           kShortIdlePeriodDurationSampleCount,
@@ -1183,7 +1185,6 @@ RendererSchedulerImpl::AsValueLocked(base::TimeTicks optional_now) const {
                    MainThreadOnly()
                        .timer_task_cost_estimator.expected_task_duration()
                        .InMillisecondsF());
-  // TODO(skyostil): Can we somehow trace how accurate these estimates were?
   state->SetDouble(
       "longest_jank_free_task_duration",
       MainThreadOnly().longest_jank_free_task_duration.InMillisecondsF());
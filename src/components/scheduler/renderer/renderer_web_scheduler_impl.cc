@@ -5,9 +5,11 @@
 #include "components/scheduler/renderer/renderer_web_scheduler_impl.h"
 
 #include <memory>
+#include <utility>
 
 #include "base/command_line.h"
 #include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "components/scheduler/base/task_queue.h"
 #include "components/scheduler/common/scheduler_switches.h"
 #include "components/scheduler/renderer/renderer_scheduler_impl.h"
@@ -37,9 +39,19 @@ void RendererWebSchedulerImpl::resumeTimerQueue() {
 std::unique_ptr<blink::WebViewScheduler>
 RendererWebSchedulerImpl::createWebViewScheduler(blink::WebView* web_view) {
   base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
-  return base::WrapUnique(new WebViewSchedulerImpl(
-      web_view, renderer_scheduler_,
-      command_line->HasSwitch(switches::kDisableBackgroundTimerThrottling)));
+  bool disable_background_timer_throttling =
+      command_line->HasSwitch(switches::kDisableBackgroundTimerThrottling);
+  std::unique_ptr<WebViewSchedulerImpl> web_view_scheduler(
+      new WebViewSchedulerImpl(web_view, renderer_scheduler_,
+                               disable_background_timer_throttling));
+  double recovery_rate;
+  if (base::StringToDouble(command_line->GetSwitchValueASCII(
+                               switches::kBackgroundCPUTimeBudgetRecoveryRate),
+                           &recovery_rate) &&
+      recovery_rate > 0) {
+    web_view_scheduler->SetBackgroundCPUTimeBudgetRecoveryRate(recovery_rate);
+  }
+  return std::move(web_view_scheduler);
 }
 
 void RendererWebSchedulerImpl::onNavigationStarted() {
@@ -5,16 +5,19 @@
 #include "components/scheduler/renderer/task_cost_estimator.h"
 
 #include "base/time/default_tick_clock.h"
+#include "base/trace_event/trace_event.h"
 
 namespace scheduler {
 
 TaskCostEstimator::TaskCostEstimator(base::TickClock* time_source,
                                      int sample_count,
-                                     double estimation_percentile)
+                                     double estimation_percentile,
+                                     const char* tracing_name)
     : rolling_time_delta_history_(sample_count),
       time_source_(time_source),
       outstanding_task_count_(0),
-      estimation_percentile_(estimation_percentile) {}
+      estimation_percentile_(estimation_percentile),
+      tracing_name_(tracing_name) {}
 
 TaskCostEstimator::~TaskCostEstimator() {}
 
@@ -27,6 +30,15 @@ void TaskCostEstimator::WillProcessTask(const base::PendingTask& pending_task) {
 void TaskCostEstimator::DidProcessTask(const base::PendingTask& pending_task) {
   if (--outstanding_task_count_ == 0) {
     base::TimeDelta duration = time_source_->NowTicks() - task_start_time_;
+    bool tracing_enabled;
+    TRACE_EVENT_CATEGORY_GROUP_ENABLED(
+        TRACE_DISABLED_BY_DEFAULT("renderer.scheduler"), &tracing_enabled);
+    if (tracing_enabled) {
+      TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("renderer.scheduler"),
+                     tracing_name_, "expected_ms",
+                     expected_task_duration().InMillisecondsF(), "actual_ms",
+                     duration.InMillisecondsF());
+    }
     rolling_time_delta_history_.InsertSample(duration);
   }
 }
@@ -37,7 +49,6 @@ base::TimeDelta TaskCostEstimator::expected_task_duration() const {
 
 void TaskCostEstimator::Clear() {
   rolling_time_delta_history_.Clear();
-  expected_task_duration_ = base::TimeDelta();
 }
 
 }  // namespace scheduler
@@ -17,13 +17,17 @@ class TickClock;
 
 namespace scheduler {
 
-// Estimates the cost of running tasks based on historical timing data.
+// Estimates the cost of running tasks based on historical timing data. While
+// the "renderer.scheduler" tracing category is enabled, the estimate in effect
+// when each task started and the task's actual duration are traced as a
+// counter named |tracing_name|, which must be a string literal.
 class SCHEDULER_EXPORT TaskCostEstimator
     : public base::MessageLoop::TaskObserver {
  public:
   TaskCostEstimator(base::TickClock* time_source,
                     int sample_count,
-                    double estimation_percentile);
+                    double estimation_percentile,
+                    const char* tracing_name);
   ~TaskCostEstimator() override;
 
   base::TimeDelta expected_task_duration() const;
@@ -39,8 +43,8 @@ class SCHEDULER_EXPORT TaskCostEstimator
   base::TickClock* time_source_;  // NOT OWNED
   int outstanding_task_count_;
   double estimation_percentile_;
+  const char* tracing_name_;
   base::TimeTicks task_start_time_;
-  base::TimeDelta expected_task_duration_;
 
   DISALLOW_COPY_AND_ASSIGN(TaskCostEstimator);
 };
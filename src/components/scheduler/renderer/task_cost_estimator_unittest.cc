@@ -33,7 +33,8 @@ class TaskCostEstimatorForTest : public TaskCostEstimator {
                            double estimation_percentile)
       : TaskCostEstimator(test_time_source,
                           sample_count,
-                          estimation_percentile) {}
+                          estimation_percentile,
+                          "TestTaskDuration") {}
 };
 
 TEST_F(TaskCostEstimatorTest, BasicEstimation) {
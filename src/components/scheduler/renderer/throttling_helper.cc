@@ -4,7 +4,10 @@
 
 #include "components/scheduler/renderer/throttling_helper.h"
 
+#include <algorithm>
+
 #include "base/logging.h"
+#include "base/memory/ptr_util.h"
 #include "components/scheduler/base/real_time_domain.h"
 #include "components/scheduler/child/scheduler_tqm_delegate.h"
 #include "components/scheduler/renderer/renderer_scheduler_impl.h"
@@ -14,6 +17,77 @@
 
 namespace scheduler {
 
+namespace {
+
+// By default budgeted queues may use 1% of the main thread, in bursts of up to
+// 100ms.
+const double kDefaultCPUTimeBudgetRecoveryRate = 0.01;
+const int kMaxCPUTimeBudgetMilliseconds = 100;
+
+}  // namespace
+
+ThrottlingHelper::CPUTimeBudgetPool::CPUTimeBudgetPool(
+    const char* name,
+    ThrottlingHelper* throttling_helper,
+    base::TimeTicks now)
+    : name_(name),
+      throttling_helper_(throttling_helper),
+      recovery_rate_(kDefaultCPUTimeBudgetRecoveryRate),
+      budget_(base::TimeDelta::FromMilliseconds(kMaxCPUTimeBudgetMilliseconds)),
+      last_update_(now),
+      exhausted_(false) {}
+
+ThrottlingHelper::CPUTimeBudgetPool::~CPUTimeBudgetPool() {}
+
+void ThrottlingHelper::CPUTimeBudgetPool::SetRecoveryRate(
+    double recovery_rate) {
+  DCHECK_GT(recovery_rate, 0);
+  Update(throttling_helper_->tick_clock_->NowTicks());
+  recovery_rate_ = recovery_rate;
+}
+
+base::TimeDelta ThrottlingHelper::CPUTimeBudgetPool::Budget(
+    base::TimeTicks now) {
+  Update(now);
+  return budget_;
+}
+
+void ThrottlingHelper::CPUTimeBudgetPool::Update(base::TimeTicks now) {
+  if (now <= last_update_)
+    return;
+  budget_ += base::TimeDelta::FromSecondsD(
+      (now - last_update_).InSecondsF() * recovery_rate_);
+  budget_ = std::min(budget_, base::TimeDelta::FromMilliseconds(
+                                  kMaxCPUTimeBudgetMilliseconds));
+  last_update_ = now;
+}
+
+base::TimeTicks ThrottlingHelper::CPUTimeBudgetPool::RecoveryTime(
+    base::TimeTicks now) {
+  Update(now);
+  if (budget_ >= base::TimeDelta())
+    return now;
+  return now + base::TimeDelta::FromSecondsD(-budget_.InSecondsF() /
+                                             recovery_rate_);
+}
+
+void ThrottlingHelper::CPUTimeBudgetPool::WillProcessTask(
+    const base::PendingTask& pending_task) {
+  task_start_time_ = throttling_helper_->tick_clock_->NowTicks();
+}
+
+void ThrottlingHelper::CPUTimeBudgetPool::DidProcessTask(
+    const base::PendingTask& pending_task) {
+  base::TimeTicks now = throttling_helper_->tick_clock_->NowTicks();
+  Update(now);
+  budget_ -= now - task_start_time_;
+  TRACE_COUNTER_ID1(throttling_helper_->tracing_category_,
+                    "ThrottlingHelper::CPUTimeBudget", this,
+                    budget_.InMicroseconds());
+  if (!exhausted_ && budget_ < base::TimeDelta())
+    throttling_helper_->OnCPUTimeBudgetExhausted(this, now);
+}
+
 ThrottlingHelper::ThrottlingHelper(RendererSchedulerImpl* renderer_scheduler,
                                    const char* tracing_category)
     : task_runner_(renderer_scheduler->ControlTaskRunner()),
@@ -32,6 +106,9 @@ ThrottlingHelper::ThrottlingHelper(RendererSchedulerImpl* renderer_scheduler,
 }
 
 ThrottlingHelper::~ThrottlingHelper() {
+  for (const auto& map_entry : cpu_time_budget_pool_for_queue_)
+    map_entry.first->RemoveTaskObserver(map_entry.second);
+
   // It's possible for queues to be still throttled, so we need to tidy up
   // before unregistering the time domain.
   for (const TaskQueueMap::value_type& map_entry : throttled_queues_) {
@@ -102,7 +179,84 @@ void ThrottlingHelper::DecreaseThrottleRefCount(TaskQueue* task_queue) {
 }
 
 void ThrottlingHelper::UnregisterTaskQueue(TaskQueue* task_queue) {
+  // Erase the throttling metadata first so that leaving an exhausted pool
+  // doesn't touch the queue's time domain.
   throttled_queues_.erase(task_queue);
+  RemoveQueueFromCPUTimeBudgetPool(task_queue);
+}
+
+ThrottlingHelper::CPUTimeBudgetPool* ThrottlingHelper::CreateCPUTimeBudgetPool(
+    const char* name) {
+  CPUTimeBudgetPool* pool =
+      new CPUTimeBudgetPool(name, this, tick_clock_->NowTicks());
+  cpu_time_budget_pools_[pool] = base::WrapUnique(pool);
+  return pool;
+}
+
+void ThrottlingHelper::DeleteCPUTimeBudgetPool(CPUTimeBudgetPool* pool) {
+  DCHECK(cpu_time_budget_pools_.find(pool) != cpu_time_budget_pools_.end());
+  if (pool->exhausted_)
+    OnCPUTimeBudgetRecovered(pool);
+  for (TaskQueue* task_queue : pool->queues_) {
+    task_queue->RemoveTaskObserver(pool);
+    cpu_time_budget_pool_for_queue_.erase(task_queue);
+  }
+  cpu_time_budget_pools_.erase(pool);
+}
+
+void ThrottlingHelper::AddQueueToCPUTimeBudgetPool(CPUTimeBudgetPool* pool,
+                                                   TaskQueue* task_queue) {
+  std::pair<std::map<TaskQueue*, CPUTimeBudgetPool*>::iterator, bool>
+      insert_result =
+          cpu_time_budget_pool_for_queue_.insert(std::make_pair(task_queue,
+                                                                pool));
+  if (!insert_result.second) {
+    DCHECK_EQ(pool, insert_result.first->second);
+    return;
+  }
+  pool->queues_.insert(task_queue);
+  task_queue->AddTaskObserver(pool);
+  if (pool->exhausted_) {
+    IncreaseThrottleRefCount(task_queue);
+    task_queue->SetQueueEnabled(false);
+  }
+}
+
+void ThrottlingHelper::RemoveQueueFromCPUTimeBudgetPool(TaskQueue* task_queue) {
+  auto find_it = cpu_time_budget_pool_for_queue_.find(task_queue);
+  if (find_it == cpu_time_budget_pool_for_queue_.end())
+    return;
+  CPUTimeBudgetPool* pool = find_it->second;
+  cpu_time_budget_pool_for_queue_.erase(find_it);
+  pool->queues_.erase(task_queue);
+  task_queue->RemoveTaskObserver(pool);
+  if (pool->exhausted_)
+    DecreaseThrottleRefCount(task_queue);
+}
+
+void ThrottlingHelper::OnCPUTimeBudgetExhausted(CPUTimeBudgetPool* pool,
+                                                base::TimeTicks now) {
+  TRACE_EVENT_ASYNC_BEGIN1(tracing_category_,
+                           "ThrottlingHelper::CPUTimeBudgetExhausted", pool,
+                           "pool", pool->name_);
+  pool->exhausted_ = true;
+  // Queues which were not throttled before, e.g. loading queues, are only
+  // throttled until the budget recovers. Throttled queues stop running the
+  // tasks released by the current pump.
+  for (TaskQueue* task_queue : pool->queues_) {
+    IncreaseThrottleRefCount(task_queue);
+    task_queue->SetQueueEnabled(false);
+  }
+  MaybeSchedulePumpThrottledTasksLocked(FROM_HERE, now,
+                                        pool->RecoveryTime(now));
+}
+
+void ThrottlingHelper::OnCPUTimeBudgetRecovered(CPUTimeBudgetPool* pool) {
+  TRACE_EVENT_ASYNC_END0(tracing_category_,
+                         "ThrottlingHelper::CPUTimeBudgetExhausted", pool);
+  pool->exhausted_ = false;
+  for (TaskQueue* task_queue : pool->queues_)
+    DecreaseThrottleRefCount(task_queue);
 }
 
 void ThrottlingHelper::OnTimeDomainHasImmediateWork() {
@@ -134,17 +288,42 @@ void ThrottlingHelper::PumpThrottledTasks() {
   pending_pump_throttled_tasks_runtime_ = base::TimeTicks();
 
   LazyNow lazy_low(tick_clock_);
+  for (const auto& map_entry : cpu_time_budget_pools_) {
+    CPUTimeBudgetPool* pool = map_entry.first;
+    if (pool->exhausted_ && pool->Budget(lazy_low.Now()) >= base::TimeDelta())
+      OnCPUTimeBudgetRecovered(pool);
+  }
+
+  base::TimeTicks budget_recovery_time;
   for (const TaskQueueMap::value_type& map_entry : throttled_queues_) {
     TaskQueue* task_queue = map_entry.first;
     if (task_queue->IsEmpty())
       continue;
 
+    // Leave the queue disabled until its budget has recovered.
+    auto pool_it = cpu_time_budget_pool_for_queue_.find(task_queue);
+    if (pool_it != cpu_time_budget_pool_for_queue_.end() &&
+        pool_it->second->exhausted_) {
+      base::TimeTicks recovery_time =
+          pool_it->second->RecoveryTime(lazy_low.Now());
+      if (budget_recovery_time.is_null() ||
+          recovery_time < budget_recovery_time) {
+        budget_recovery_time = recovery_time;
+      }
+      continue;
+    }
+
     task_queue->SetQueueEnabled(map_entry.second.enabled);
     task_queue->PumpQueue(&lazy_low, false);
   }
   // Make sure NextScheduledRunTime gives us an up-to date result.
   time_domain_->ClearExpiredWakeups();
 
+  if (!budget_recovery_time.is_null()) {
+    MaybeSchedulePumpThrottledTasksLocked(FROM_HERE, lazy_low.Now(),
+                                          budget_recovery_time);
+  }
+
   base::TimeTicks next_scheduled_delayed_task;
   // Maybe schedule a call to ThrottlingHelper::PumpThrottledTasks if there is
   // a pending delayed task. NOTE posting a non-delayed task in the future will
@@ -5,9 +5,13 @@
 #ifndef COMPONENTS_SCHEDULER_RENDERER_THROTTLING_HELPER_H_
 #define COMPONENTS_SCHEDULER_RENDERER_THROTTLING_HELPER_H_
 
+#include <map>
+#include <memory>
 #include <set>
 
 #include "base/macros.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
 #include "components/scheduler/base/cancelable_closure_holder.h"
 #include "components/scheduler/base/time_domain.h"
 #include "components/scheduler/scheduler_export.h"
@@ -19,8 +23,55 @@ class RendererSchedulerImpl;
 class ThrottledTimeDomain;
 class WebFrameSchedulerImpl;
 
+// Throttled queues only run tasks once per second, aligned on second
+// boundaries. Queues can additionally be put in a CPU time budget pool, e.g.
+// one per background page, whose budget their tasks use up and which slowly
+// recovers. While the budget is negative the queues of the pool are throttled
+// and not run.
 class SCHEDULER_EXPORT ThrottlingHelper : public TimeDomain::Observer {
  public:
+  class SCHEDULER_EXPORT CPUTimeBudgetPool
+      : public base::MessageLoop::TaskObserver {
+   public:
+    ~CPUTimeBudgetPool() override;
+
+    // Sets how much budget is gained per second of wall time, e.g. 0.01 lets
+    // the queues of the pool use 1% of the thread.
+    void SetRecoveryRate(double recovery_rate);
+
+    // Returns the budget left at |now|, which is negative when the queues of
+    // the pool have used more than their share.
+    base::TimeDelta Budget(base::TimeTicks now);
+
+    // base::MessageLoop::TaskObserver implementation:
+    void WillProcessTask(const base::PendingTask& pending_task) override;
+    void DidProcessTask(const base::PendingTask& pending_task) override;
+
+   private:
+    friend class ThrottlingHelper;
+
+    CPUTimeBudgetPool(const char* name,
+                      ThrottlingHelper* throttling_helper,
+                      base::TimeTicks now);
+
+    void Update(base::TimeTicks now);
+
+    // Returns when the budget will be non-negative again.
+    base::TimeTicks RecoveryTime(base::TimeTicks now);
+
+    const char* name_;                     // NOT OWNED
+    ThrottlingHelper* throttling_helper_;  // NOT OWNED
+    double recovery_rate_;
+    base::TimeDelta budget_;
+    base::TimeTicks last_update_;
+    base::TimeTicks task_start_time_;
+    std::set<TaskQueue*> queues_;
+    // Whether the queues are throttled because the budget ran out.
+    bool exhausted_;
+
+    DISALLOW_COPY_AND_ASSIGN(CPUTimeBudgetPool);
+  };
+
   ThrottlingHelper(RendererSchedulerImpl* renderer_scheduler,
                    const char* tracing_category);
 
@@ -47,9 +98,21 @@ class SCHEDULER_EXPORT ThrottlingHelper : public TimeDomain::Observer {
   // zero this function does nothing.
   void DecreaseThrottleRefCount(TaskQueue* task_queue);
 
-  // Removes |task_queue| from |throttled_queues_|.
+  // Removes |task_queue| from |throttled_queues_| and from its CPU time
+  // budget pool.
   void UnregisterTaskQueue(TaskQueue* task_queue);
 
+  // Returns a new CPU time budget pool named |name| for tracing, which is
+  // owned by the ThrottlingHelper until passed to DeleteCPUTimeBudgetPool.
+  CPUTimeBudgetPool* CreateCPUTimeBudgetPool(const char* name);
+  void DeleteCPUTimeBudgetPool(CPUTimeBudgetPool* pool);
+
+  // Makes the tasks of |task_queue| use up the budget of |pool|. A queue is in
+  // at most one pool.
+  void AddQueueToCPUTimeBudgetPool(CPUTimeBudgetPool* pool,
+                                   TaskQueue* task_queue);
+  void RemoveQueueFromCPUTimeBudgetPool(TaskQueue* task_queue);
+
   const ThrottledTimeDomain* time_domain() const { return time_domain_.get(); }
 
   static base::TimeTicks ThrottledRunTime(base::TimeTicks unthrottled_runtime);
@@ -70,6 +133,10 @@ class SCHEDULER_EXPORT ThrottlingHelper : public TimeDomain::Observer {
 
   void PumpThrottledTasks();
 
+  // Throttles the queues of |pool| until its budget has recovered.
+  void OnCPUTimeBudgetExhausted(CPUTimeBudgetPool* pool, base::TimeTicks now);
+  void OnCPUTimeBudgetRecovered(CPUTimeBudgetPool* pool);
+
   // Note |unthrottled_runtime| might be in the past. When this happens we
   // compute the delay to the next runtime based on now rather than
   // unthrottled_runtime.
@@ -89,6 +156,10 @@ class SCHEDULER_EXPORT ThrottlingHelper : public TimeDomain::Observer {
   CancelableClosureHolder suspend_timers_when_backgrounded_closure_;
   base::TimeTicks pending_pump_throttled_tasks_runtime_;
 
+  std::map<CPUTimeBudgetPool*, std::unique_ptr<CPUTimeBudgetPool>>
+      cpu_time_budget_pools_;
+  std::map<TaskQueue*, CPUTimeBudgetPool*> cpu_time_budget_pool_for_queue_;
+
   base::WeakPtrFactory<ThrottlingHelper> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(ThrottlingHelper);
@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include <memory>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/macros.h"
@@ -452,4 +453,99 @@ TEST_F(ThrottlingHelperTest, DoubleIncrementDoubleDecrement) {
   EXPECT_TRUE(timer_queue_->IsQueueEnabled());
 }
 
+namespace {
+void ExpensiveTestTask(std::vector<base::TimeTicks>* run_times,
+                       base::SimpleTestTickClock* clock) {
+  run_times->push_back(clock->NowTicks());
+  clock->Advance(base::TimeDelta::FromMilliseconds(200));
+}
+}  // namespace
+
+TEST_F(ThrottlingHelperTest, CPUTimeBudget) {
+  std::vector<base::TimeTicks> run_times;
+  ThrottlingHelper::CPUTimeBudgetPool* pool =
+      throttling_helper_->CreateCPUTimeBudgetPool("test");
+  throttling_helper_->IncreaseThrottleRefCount(timer_queue_.get());
+  throttling_helper_->AddQueueToCPUTimeBudgetPool(pool, timer_queue_.get());
+
+  timer_queue_->PostTask(
+      FROM_HERE, base::Bind(&ExpensiveTestTask, &run_times, clock_.get()));
+  timer_queue_->PostTask(
+      FROM_HERE, base::Bind(&ExpensiveTestTask, &run_times, clock_.get()));
+  timer_queue_->PostDelayedTask(
+      FROM_HERE, base::Bind(&ExpensiveTestTask, &run_times, clock_.get()),
+      base::TimeDelta::FromMilliseconds(1500));
+  mock_task_runner_->RunUntilIdle();
+
+  // The first task overdraws the 100ms budget by 100ms, so the second one has
+  // to wait ~10s for it to recover, and then overdraws it by ~200ms, which
+  // takes ~20s to recover.
+  ASSERT_EQ(3u, run_times.size());
+  EXPECT_EQ(base::TimeTicks() + base::TimeDelta::FromSeconds(1), run_times[0]);
+  EXPECT_LE(base::TimeTicks() + base::TimeDelta::FromSeconds(11),
+            run_times[1]);
+  EXPECT_LE(run_times[1] + base::TimeDelta::FromSeconds(19), run_times[2]);
+  EXPECT_GT(base::TimeDelta(), pool->Budget(clock_->NowTicks()));
+
+  throttling_helper_->DeleteCPUTimeBudgetPool(pool);
+}
+
+TEST_F(ThrottlingHelperTest, CPUTimeBudget_RecoveryRate) {
+  std::vector<base::TimeTicks> run_times;
+  ThrottlingHelper::CPUTimeBudgetPool* pool =
+      throttling_helper_->CreateCPUTimeBudgetPool("test");
+  pool->SetRecoveryRate(0.1);
+  throttling_helper_->IncreaseThrottleRefCount(timer_queue_.get());
+  throttling_helper_->AddQueueToCPUTimeBudgetPool(pool, timer_queue_.get());
+
+  timer_queue_->PostTask(
+      FROM_HERE, base::Bind(&ExpensiveTestTask, &run_times, clock_.get()));
+  timer_queue_->PostTask(
+      FROM_HERE, base::Bind(&ExpensiveTestTask, &run_times, clock_.get()));
+  mock_task_runner_->RunUntilIdle();
+
+  // At 10% the 100ms overdraft is recovered after 1s.
+  ASSERT_EQ(2u, run_times.size());
+  EXPECT_EQ(base::TimeTicks() + base::TimeDelta::FromSeconds(1), run_times[0]);
+  EXPECT_EQ(base::TimeTicks() + base::TimeDelta::FromSeconds(3), run_times[1]);
+
+  throttling_helper_->DeleteCPUTimeBudgetPool(pool);
+}
+
+TEST_F(ThrottlingHelperTest, CPUTimeBudget_UnthrottledQueue) {
+  std::vector<base::TimeTicks> run_times;
+  scoped_refptr<TaskQueue> loading_queue =
+      scheduler_->NewLoadingTaskRunner("test_loading_queue");
+  ThrottlingHelper::CPUTimeBudgetPool* pool =
+      throttling_helper_->CreateCPUTimeBudgetPool("test");
+  throttling_helper_->AddQueueToCPUTimeBudgetPool(pool, loading_queue.get());
+
+  loading_queue->PostTask(
+      FROM_HERE, base::Bind(&ExpensiveTestTask, &run_times, clock_.get()));
+  loading_queue->PostTask(
+      FROM_HERE, base::Bind(&ExpensiveTestTask, &run_times, clock_.get()));
+  mock_task_runner_->RunUntilIdle();
+
+  // The queue isn't throttled while within budget, and is throttled until the
+  // budget has recovered after that.
+  ASSERT_EQ(2u, run_times.size());
+  EXPECT_EQ(base::TimeTicks() + base::TimeDelta::FromMilliseconds(5),
+            run_times[0]);
+  EXPECT_EQ(base::TimeTicks() + base::TimeDelta::FromSeconds(11),
+            run_times[1]);
+
+  // Once the budget has recovered the queue runs tasks straight away again.
+  EXPECT_LE(base::TimeDelta(), pool->Budget(clock_->NowTicks()));
+  EXPECT_TRUE(loading_queue->IsQueueEnabled());
+  base::TimeTicks post_time = clock_->NowTicks();
+  loading_queue->PostTask(
+      FROM_HERE, base::Bind(&ExpensiveTestTask, &run_times, clock_.get()));
+  mock_task_runner_->RunUntilIdle();
+  ASSERT_EQ(3u, run_times.size());
+  EXPECT_EQ(post_time, run_times[2]);
+
+  throttling_helper_->DeleteCPUTimeBudgetPool(pool);
+  loading_queue->UnregisterTaskQueue();
+}
+
 }  // namespace scheduler
@@ -64,6 +64,10 @@ blink::WebTaskRunner* WebFrameSchedulerImpl::loadingTaskRunner() {
     if (parent_web_view_scheduler_->virtual_time_domain()) {
       loading_task_queue_->SetTimeDomain(
           parent_web_view_scheduler_->virtual_time_domain());
+    } else if (!page_visible_) {
+      renderer_scheduler_->throttling_helper()->AddQueueToCPUTimeBudgetPool(
+          parent_web_view_scheduler_->background_cpu_time_budget_pool(),
+          loading_task_queue_.get());
     }
     loading_web_task_runner_.reset(new WebTaskRunnerImpl(loading_task_queue_));
   }
@@ -82,6 +86,9 @@ blink::WebTaskRunner* WebFrameSchedulerImpl::timerTaskRunner() {
     } else if (!page_visible_) {
       renderer_scheduler_->throttling_helper()->IncreaseThrottleRefCount(
           timer_task_queue_.get());
+      renderer_scheduler_->throttling_helper()->AddQueueToCPUTimeBudgetPool(
+          parent_web_view_scheduler_->background_cpu_time_budget_pool(),
+          timer_task_queue_.get());
     }
     timer_web_task_runner_.reset(new WebTaskRunnerImpl(timer_task_queue_));
   }
@@ -111,17 +118,36 @@ void WebFrameSchedulerImpl::setPageVisible(bool page_visible) {
 
   page_visible_ = page_visible;
 
-  if (!timer_web_task_runner_ ||
-      parent_web_view_scheduler_->virtual_time_domain()) {
+  if (parent_web_view_scheduler_->virtual_time_domain())
     return;
+
+  ThrottlingHelper* throttling_helper =
+      renderer_scheduler_->throttling_helper();
+  ThrottlingHelper::CPUTimeBudgetPool* budget_pool =
+      parent_web_view_scheduler_->background_cpu_time_budget_pool();
+
+  if (timer_web_task_runner_) {
+    if (page_visible_) {
+      throttling_helper->DecreaseThrottleRefCount(timer_task_queue_.get());
+      throttling_helper->RemoveQueueFromCPUTimeBudgetPool(
+          timer_task_queue_.get());
+    } else {
+      throttling_helper->IncreaseThrottleRefCount(timer_task_queue_.get());
+      throttling_helper->AddQueueToCPUTimeBudgetPool(budget_pool,
+                                                     timer_task_queue_.get());
+    }
   }
 
-  if (page_visible_) {
-    renderer_scheduler_->throttling_helper()->DecreaseThrottleRefCount(
-        timer_task_queue_.get());
-  } else {
-    renderer_scheduler_->throttling_helper()->IncreaseThrottleRefCount(
-        timer_task_queue_.get());
+  // Loading tasks aren't throttled, but they count against the budget of the
+  // page, which stops them once it runs out.
+  if (loading_web_task_runner_) {
+    if (page_visible_) {
+      throttling_helper->RemoveQueueFromCPUTimeBudgetPool(
+          loading_task_queue_.get());
+    } else {
+      throttling_helper->AddQueueToCPUTimeBudgetPool(budget_pool,
+                                                     loading_task_queue_.get());
+    }
   }
 }
 
@@ -137,6 +163,8 @@ void WebFrameSchedulerImpl::OnVirtualTimeDomainChanged() {
   }
 
   if (loading_task_queue_) {
+    renderer_scheduler_->throttling_helper()->RemoveQueueFromCPUTimeBudgetPool(
+        loading_task_queue_.get());
     loading_task_queue_->SetTimeDomain(
         parent_web_view_scheduler_->virtual_time_domain());
   }
@@ -24,6 +24,9 @@ WebViewSchedulerImpl::WebViewSchedulerImpl(
     : virtual_time_pump_policy_(TaskQueue::PumpPolicy::AUTO),
       web_view_(web_view),
       renderer_scheduler_(renderer_scheduler),
+      background_cpu_time_budget_pool_(
+          renderer_scheduler->throttling_helper()->CreateCPUTimeBudgetPool(
+              "WebViewSchedulerImpl")),
       page_visible_(true),
       disable_background_timer_throttling_(disable_background_timer_throttling),
       allow_virtual_time_to_advance_(true) {
@@ -37,6 +40,11 @@ WebViewSchedulerImpl::~WebViewSchedulerImpl() {
     frame_scheduler->DetachFromWebViewScheduler();
   }
   renderer_scheduler_->RemoveWebViewScheduler(this);
+  // The ThrottlingHelper and its pools are gone after Shutdown.
+  if (renderer_scheduler_->throttling_helper()) {
+    renderer_scheduler_->throttling_helper()->DeleteCPUTimeBudgetPool(
+        background_cpu_time_budget_pool_);
+  }
   if (virtual_time_domain_)
     renderer_scheduler_->UnregisterTimeDomain(virtual_time_domain_.get());
 }
@@ -52,6 +60,11 @@ void WebViewSchedulerImpl::setPageVisible(bool page_visible) {
   }
 }
 
+void WebViewSchedulerImpl::SetBackgroundCPUTimeBudgetRecoveryRate(
+    double recovery_rate) {
+  background_cpu_time_budget_pool_->SetRecoveryRate(recovery_rate);
+}
+
 std::unique_ptr<WebFrameSchedulerImpl>
 WebViewSchedulerImpl::createWebFrameSchedulerImpl(
     base::trace_event::BlameContext* blame_context) {
@@ -11,6 +11,7 @@
 
 #include "base/macros.h"
 #include "components/scheduler/base/task_queue.h"
+#include "components/scheduler/renderer/throttling_helper.h"
 #include "components/scheduler/scheduler_export.h"
 #include "third_party/WebKit/public/platform/WebViewScheduler.h"
 
@@ -50,6 +51,10 @@ class SCHEDULER_EXPORT WebViewSchedulerImpl : public blink::WebViewScheduler {
   // Virtual for testing.
   virtual void AddConsoleWarning(const std::string& message);
 
+  // Sets the share of the main thread which the timer and loading tasks of
+  // the page may use while it is hidden, e.g. 0.01 for 1%.
+  void SetBackgroundCPUTimeBudgetRecoveryRate(double recovery_rate);
+
   std::unique_ptr<WebFrameSchedulerImpl> createWebFrameSchedulerImpl(
       base::trace_event::BlameContext* blame_context);
 
@@ -62,11 +67,19 @@ class SCHEDULER_EXPORT WebViewSchedulerImpl : public blink::WebViewScheduler {
     return virtual_time_domain_.get();
   }
 
+  ThrottlingHelper::CPUTimeBudgetPool* background_cpu_time_budget_pool()
+      const {
+    return background_cpu_time_budget_pool_;
+  }
+
   std::set<WebFrameSchedulerImpl*> frame_schedulers_;
   std::unique_ptr<AutoAdvancingVirtualTimeDomain> virtual_time_domain_;
   TaskQueue::PumpPolicy virtual_time_pump_policy_;
   blink::WebView* web_view_;
   RendererSchedulerImpl* renderer_scheduler_;
+  // Shared by the frames of the page while it is hidden. Owned by the
+  // ThrottlingHelper.
+  ThrottlingHelper::CPUTimeBudgetPool* background_cpu_time_budget_pool_;
   bool page_visible_;
   bool disable_background_timer_throttling_;
   bool allow_virtual_time_to_advance_;
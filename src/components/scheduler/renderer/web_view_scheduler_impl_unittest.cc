@@ -5,6 +5,7 @@
 #include "components/scheduler/renderer/web_view_scheduler_impl.h"
 
 #include <memory>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/memory/ptr_util.h"
@@ -133,6 +134,42 @@ TEST_F(WebViewSchedulerImplTest, RepeatingLoadingTask_PageInBackground) {
   EXPECT_EQ(1000, run_count);  // Loading tasks should not be throttled
 }
 
+namespace {
+class ExpensiveTask : public blink::WebTaskRunner::Task {
+ public:
+  ExpensiveTask(base::SimpleTestTickClock* clock,
+                std::vector<base::TimeTicks>* run_times)
+      : clock_(clock), run_times_(run_times) {}
+
+  ~ExpensiveTask() override {}
+
+  void run() override {
+    run_times_->push_back(clock_->NowTicks());
+    clock_->Advance(base::TimeDelta::FromMilliseconds(200));
+  }
+
+ private:
+  base::SimpleTestTickClock* clock_;         // NOT OWNED
+  std::vector<base::TimeTicks>* run_times_;  // NOT OWNED
+};
+}  // namespace
+
+TEST_F(WebViewSchedulerImplTest, ExpensiveLoadingTasks_PageInBackground) {
+  web_view_scheduler_->setPageVisible(false);
+
+  std::vector<base::TimeTicks> run_times;
+  web_frame_scheduler_->loadingTaskRunner()->postTask(
+      BLINK_FROM_HERE, new ExpensiveTask(clock_.get(), &run_times));
+  web_frame_scheduler_->loadingTaskRunner()->postTask(
+      BLINK_FROM_HERE, new ExpensiveTask(clock_.get(), &run_times));
+
+  mock_task_runner_->RunUntilIdle();
+  ASSERT_EQ(2u, run_times.size());
+  // The first task uses up the CPU time budget of the page, so the second one
+  // has to wait for it to recover.
+  EXPECT_LE(run_times[0] + base::TimeDelta::FromSeconds(10), run_times[1]);
+}
+
 TEST_F(WebViewSchedulerImplTest, RepeatingTimers_OneBackgroundOneForeground) {
   std::unique_ptr<WebViewSchedulerImpl> web_view_scheduler2(
       new WebViewSchedulerImpl(nullptr, scheduler_.get(), false));
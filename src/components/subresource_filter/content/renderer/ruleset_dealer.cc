@@ -9,6 +9,7 @@
 #include "base/files/file.h"
 #include "base/logging.h"
 #include "components/subresource_filter/content/common/subresource_filter_messages.h"
+#include "components/subresource_filter/core/common/indexed_ruleset.h"
 #include "components/subresource_filter/core/common/memory_mapped_ruleset.h"
 #include "ipc/ipc_message_macros.h"
 
@@ -32,6 +33,12 @@ void RulesetDealer::OnSetRulesetForProcess(
   base::File file = IPC::PlatformFileForTransitToFile(platform_file);
   DCHECK(file.IsValid());
   ruleset_ = new MemoryMappedRuleset(std::move(file));
+
+  // Verify the ruleset once here, so that filters can use it without checks.
+  if (!IndexedRulesetMatcher::Verify(ruleset_->data(), ruleset_->length())) {
+    DLOG(ERROR) << "Ignoring malformed subresource filtering ruleset.";
+    ruleset_ = nullptr;
+  }
 }
 
 }  // namespace subresource_filter
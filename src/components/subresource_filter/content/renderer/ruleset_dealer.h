@@ -20,7 +20,8 @@ class MemoryMappedRuleset;
 
 // Memory maps the subresource filtering ruleset file received over IPC from the
 // RulesetDistributor, and makes it available to all SubresourceFilterAgents
-// within the current render process.
+// within the current render process. Rulesets that are not well-formed indexed
+// rulesets are dropped.
 //
 // See the distribution pipeline diagram in content_ruleset_distributor.h.
 class RulesetDealer : public content::RenderThreadObserver {
@@ -4,13 +4,10 @@
 
 #include "components/subresource_filter/content/renderer/subresource_filter_agent.h"
 
-#include <climits>
-
 #include "base/memory/ref_counted.h"
-#include "base/strings/string_piece.h"
-#include "base/strings/string_util.h"
 #include "components/subresource_filter/content/common/subresource_filter_messages.h"
 #include "components/subresource_filter/content/renderer/ruleset_dealer.h"
+#include "components/subresource_filter/core/common/indexed_ruleset.h"
 #include "components/subresource_filter/core/common/memory_mapped_ruleset.h"
 #include "content/public/renderer/render_frame.h"
 #include "ipc/ipc_message.h"
@@ -19,37 +16,32 @@
 #include "third_party/WebKit/public/platform/WebURLRequest.h"
 #include "third_party/WebKit/public/web/WebDataSource.h"
 #include "third_party/WebKit/public/web/WebLocalFrame.h"
+#include "url/gurl.h"
 
 namespace subresource_filter {
 
 namespace {
 
-// Placeholder subresource filter implementation that treats the entire ruleset
-// as the UTF-8 representation of a string, and will disallow subresource loads
-// from URL paths having this string as a suffix.
-// TODO(engedy): Replace this with the actual filtering logic.
-class PathSuffixFilter : public blink::WebDocumentSubresourceFilter {
+// Subresource filter that matches the URLs of subresources against the
+// indexed ruleset, in place in the memory-mapped file. The ruleset is verified
+// by the RulesetDealer.
+class IndexedRulesetFilter : public blink::WebDocumentSubresourceFilter {
  public:
-  explicit PathSuffixFilter(const scoped_refptr<MemoryMappedRuleset>& ruleset)
-      : ruleset_(ruleset) {
-    static_assert(CHAR_BIT == 8, "Assumed char was 8 bits.");
-    disallowed_suffix_ = base::StringPiece(
-        reinterpret_cast<const char*>(ruleset_->data()), ruleset_->length());
-  }
-  ~PathSuffixFilter() override {}
+  explicit IndexedRulesetFilter(
+      const scoped_refptr<MemoryMappedRuleset>& ruleset)
+      : ruleset_(ruleset), matcher_(ruleset_->data(), ruleset_->length()) {}
+  ~IndexedRulesetFilter() override {}
 
   bool allowLoad(const blink::WebURL& resourceUrl,
                  blink::WebURLRequest::RequestContext) override {
-    return disallowed_suffix_.empty() ||
-           !base::EndsWith(GURL(resourceUrl).path(), disallowed_suffix_,
-                           base::CompareCase::SENSITIVE);
+    return !matcher_.ShouldDisallowSubresourceLoad(GURL(resourceUrl));
   }
 
  private:
   scoped_refptr<MemoryMappedRuleset> ruleset_;
-  base::StringPiece disallowed_suffix_;
+  IndexedRulesetMatcher matcher_;
 
-  DISALLOW_COPY_AND_ASSIGN(PathSuffixFilter);
+  DISALLOW_COPY_AND_ASSIGN(IndexedRulesetFilter);
 };
 
 }  // namespace
@@ -78,7 +70,7 @@ void SubresourceFilterAgent::DidCommitProvisionalLoad(
       ruleset_dealer_->ruleset()) {
     blink::WebLocalFrame* web_frame = render_frame()->GetWebFrame();
     web_frame->dataSource()->setSubresourceFilter(
-        new PathSuffixFilter(ruleset_dealer_->ruleset()));
+        new IndexedRulesetFilter(ruleset_dealer_->ruleset()));
   }
 }
 
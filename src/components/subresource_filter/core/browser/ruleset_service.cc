@@ -22,6 +22,7 @@
 #include "components/prefs/pref_service.h"
 #include "components/subresource_filter/core/browser/ruleset_distributor.h"
 #include "components/subresource_filter/core/browser/subresource_filter_constants.h"
+#include "components/subresource_filter/core/common/indexed_ruleset.h"
 
 namespace subresource_filter {
 
@@ -29,9 +30,6 @@ namespace subresource_filter {
 
 namespace {
 
-// The current binary format version of the serialized ruleset.
-const int kCurrentRulesetFormatVersion = 10;
-
 // Names of the preferences storing the most recent ruleset version that
 // was successfully stored to disk.
 const char kSubresourceFilterRulesetContentVersion[] =
@@ -80,7 +78,7 @@ void RulesetVersion::RegisterPrefs(PrefRegistrySimple* registry) {
 
 // static
 int RulesetVersion::CurrentFormatVersion() {
-  return kCurrentRulesetFormatVersion;
+  return RulesetIndexer::kIndexedFormatVersion;
 }
 
 void RulesetVersion::ReadFromPrefs(PrefService* local_state) {
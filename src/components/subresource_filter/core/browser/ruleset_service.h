@@ -75,9 +75,10 @@ class RulesetService : public base::SupportsWeakPtr<RulesetService> {
                                              const base::Version& version);
 
   // Persists a new |content_version| of the |ruleset_data|, then, on success,
-  // publishes it through the registered distributors. The |ruleset_data| must
-  // be a function of the |content_version| in the mathematical sense, i.e.
-  // different |ruleset_data| contents should have different |content_versions|.
+  // publishes it through the registered distributors. The |ruleset_data| is
+  // an indexed ruleset built by RulesetIndexer. It must be a function of the
+  // |content_version| in the mathematical sense, i.e. different |ruleset_data|
+  // contents should have different |content_versions|.
   //
   // Trying to store a ruleset with the same version for a second time will
   // silenty fail on Windows if the previously stored copy of the rules is
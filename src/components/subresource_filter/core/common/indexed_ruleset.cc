@@ -0,0 +1,481 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/subresource_filter/core/common/indexed_ruleset.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "base/logging.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "components/subresource_filter/core/common/closed_hash_map.h"
+#include "components/subresource_filter/core/common/fuzzy_pattern_matching.h"
+#include "components/subresource_filter/core/common/ngram_extractor.h"
+#include "components/subresource_filter/core/common/uint64_hasher.h"
+#include "url/gurl.h"
+#include "url/third_party/mozilla/url_parse.h"
+
+namespace subresource_filter {
+
+namespace {
+
+// The binary layout of the ruleset. All values are native-endian uint32_t
+// values at offsets that are multiples of 4, as the ruleset is built and used
+// on the same device.
+//
+//   Header:
+//     magic, format version, blacklist index offset, whitelist index offset
+//   Rule:
+//     flags, pattern size, pattern characters padded to a multiple of 4
+//   Rule list:
+//     number of rules, rule offsets
+//   Index:
+//     hash table size (a power of two), offset of the list of rules without
+//     N-grams, hash table slots
+//   Hash table slot:
+//     N-gram low 32 bits, N-gram high 32 bits, rule list offset or 0 if empty
+
+const uint32_t kMagic = 0x49465253;  // "SRFI"
+
+const size_t kHeaderSize = 4 * sizeof(uint32_t);
+const size_t kRuleHeaderSize = 2 * sizeof(uint32_t);
+const size_t kIndexHeaderSize = 2 * sizeof(uint32_t);
+const size_t kSlotSize = 3 * sizeof(uint32_t);
+
+const uint32_t kAnchorMask = 0x3;
+const int kAnchorLeftShift = 0;
+const int kAnchorRightShift = 2;
+const uint32_t kMatchCaseFlag = 1 << 4;
+
+const size_t kNGramSize = 5;
+
+// Wildcards and separator placeholders don't stand for fixed characters of the
+// URL, so they can't be part of the N-grams of a pattern.
+bool IsPatternSeparator(char c) {
+  return c == '*' || c == kSeparatorPlaceholder;
+}
+
+// Hashes N-grams to 32 bits, so that 32-bit and 64-bit processes probe the
+// hash table in the same way.
+class NGramHasher {
+ public:
+  size_t operator()(uint64_t ngram) const {
+    return Uint64Hash<uint32_t>(ngram);
+  }
+};
+
+using NGramProber = DefaultProber<uint64_t, NGramHasher>;
+
+uint32_t ReadUint32(const uint8_t* buffer, size_t offset) {
+  return *reinterpret_cast<const uint32_t*>(buffer + offset);
+}
+
+// Returns whether |length| bytes at |offset| fit into a buffer of |size| bytes
+// and the |offset| is properly aligned.
+bool IsValidRange(size_t size, size_t offset, size_t length) {
+  return offset % sizeof(uint32_t) == 0 && offset <= size &&
+         length <= size - offset;
+}
+
+// Pattern matching -----------------------------------------------------------
+
+// Returns whether the whole |text| is a fuzzy occurrence of |subpattern|.
+bool IsFullFuzzyMatch(base::StringPiece text, base::StringPiece subpattern) {
+  return (subpattern.size() == text.size() ||
+          subpattern.size() == text.size() + 1) &&
+         StartsWithFuzzy(text, subpattern);
+}
+
+// Returns the end of the leftmost fuzzy occurrence of |subpattern| in |text|,
+// or base::StringPiece::npos if there is none.
+size_t FindFuzzy(base::StringPiece text, base::StringPiece subpattern) {
+  if (subpattern.empty())
+    return 0;
+  // A trailing placeholder can be matched by the end of the |text|.
+  for (size_t i = 0; i + subpattern.size() <= text.size() + 1; ++i) {
+    if (StartsWithFuzzy(text.substr(i), subpattern))
+      return std::min(i + subpattern.size(), text.size());
+  }
+  return base::StringPiece::npos;
+}
+
+// Returns the end of the leftmost fuzzy occurrence of |subpattern| in |url|
+// that starts at the beginning of the |host| or of one of its subdomains, and,
+// if |to_end| is set, spans to the end of the |url|. Returns
+// base::StringPiece::npos if there is none.
+size_t FindSubdomainAnchored(base::StringPiece url,
+                             const url::Component& host,
+                             base::StringPiece subpattern,
+                             bool to_end) {
+  if (host.len <= 0)
+    return base::StringPiece::npos;
+  for (size_t i = host.begin; i < static_cast<size_t>(host.end()); ++i) {
+    if (i != static_cast<size_t>(host.begin) && url[i - 1] != '.')
+      continue;
+    const base::StringPiece text = url.substr(i);
+    if (to_end ? IsFullFuzzyMatch(text, subpattern)
+               : StartsWithFuzzy(text, subpattern)) {
+      return std::min(i + subpattern.size(), url.size());
+    }
+  }
+  return base::StringPiece::npos;
+}
+
+// Returns whether the |url| with the given |host| matches the |pattern|.
+bool IsUrlPatternMatch(base::StringPiece url,
+                       const url::Component& host,
+                       base::StringPiece pattern,
+                       UrlRule::AnchorType anchor_left,
+                       UrlRule::AnchorType anchor_right) {
+  size_t position = 0;
+  if (anchor_left != UrlRule::ANCHOR_NONE) {
+    const size_t first_end = pattern.find('*');
+    const base::StringPiece first = pattern.substr(0, first_end);
+    const bool to_end = first_end == base::StringPiece::npos &&
+                        anchor_right == UrlRule::ANCHOR_BOUNDARY;
+    if (anchor_left == UrlRule::ANCHOR_SUBDOMAIN) {
+      position = FindSubdomainAnchored(url, host, first, to_end);
+      if (position == base::StringPiece::npos)
+        return false;
+    } else {
+      if (to_end ? !IsFullFuzzyMatch(url, first)
+                 : !StartsWithFuzzy(url, first)) {
+        return false;
+      }
+      position = std::min(first.size(), url.size());
+    }
+    if (first_end == base::StringPiece::npos)
+      return true;
+    pattern.remove_prefix(first_end + 1);
+  }
+
+  // All subpatterns but the last one are matched at their leftmost occurrence,
+  // which leaves the most room for the subpatterns that follow.
+  for (size_t star = pattern.find('*'); star != base::StringPiece::npos;
+       star = pattern.find('*')) {
+    const size_t end = FindFuzzy(url.substr(position), pattern.substr(0, star));
+    if (end == base::StringPiece::npos)
+      return false;
+    position += end;
+    pattern.remove_prefix(star + 1);
+  }
+
+  if (anchor_right == UrlRule::ANCHOR_BOUNDARY)
+    return pattern.empty() || EndsWithFuzzy(url.substr(position), pattern);
+  return FindFuzzy(url.substr(position), pattern) != base::StringPiece::npos;
+}
+
+// Reading the ruleset ---------------------------------------------------------
+
+// The URL being matched, in the forms needed by the rules.
+struct UrlToMatch {
+  base::StringPiece spec;
+  base::StringPiece lower_case_spec;
+  url::Component host;
+};
+
+bool IsRuleMatch(const uint8_t* buffer,
+                 uint32_t rule_offset,
+                 const UrlToMatch& url) {
+  const uint32_t flags = ReadUint32(buffer, rule_offset);
+  const base::StringPiece pattern(
+      reinterpret_cast<const char*>(buffer + rule_offset + kRuleHeaderSize),
+      ReadUint32(buffer, rule_offset + sizeof(uint32_t)));
+  return IsUrlPatternMatch(
+      (flags & kMatchCaseFlag) ? url.spec : url.lower_case_spec, url.host,
+      pattern, static_cast<UrlRule::AnchorType>(
+                   (flags >> kAnchorLeftShift) & kAnchorMask),
+      static_cast<UrlRule::AnchorType>((flags >> kAnchorRightShift) &
+                                       kAnchorMask));
+}
+
+bool IsAnyRuleInListMatch(const uint8_t* buffer,
+                          uint32_t list_offset,
+                          const UrlToMatch& url) {
+  const uint32_t number_of_rules = ReadUint32(buffer, list_offset);
+  for (uint32_t i = 0; i < number_of_rules; ++i) {
+    const size_t offset = list_offset + (i + 1) * sizeof(uint32_t);
+    if (IsRuleMatch(buffer, ReadUint32(buffer, offset), url))
+      return true;
+  }
+  return false;
+}
+
+bool IsAnyRuleInIndexMatch(const uint8_t* buffer,
+                           uint32_t index_offset,
+                           const UrlToMatch& url) {
+  if (IsAnyRuleInListMatch(
+          buffer, ReadUint32(buffer, index_offset + sizeof(uint32_t)), url)) {
+    return true;
+  }
+
+  const uint32_t table_size = ReadUint32(buffer, index_offset);
+  const size_t slots_offset = index_offset + kIndexHeaderSize;
+  const NGramProber prober;
+  for (uint64_t ngram : CreateNGramExtractor<kNGramSize, uint64_t>(
+           url.lower_case_spec, [](char) { return false; })) {
+    const size_t slot = prober.FindSlot(
+        ngram, table_size, [buffer, slots_offset](uint64_t ngram, size_t slot) {
+          const size_t offset = slots_offset + slot * kSlotSize;
+          if (!ReadUint32(buffer, offset + 2 * sizeof(uint32_t)))
+            return true;
+          return ReadUint32(buffer, offset) == static_cast<uint32_t>(ngram) &&
+                 ReadUint32(buffer, offset + sizeof(uint32_t)) ==
+                     static_cast<uint32_t>(ngram >> 32);
+        });
+    const uint32_t list_offset = ReadUint32(
+        buffer, slots_offset + slot * kSlotSize + 2 * sizeof(uint32_t));
+    if (list_offset && IsAnyRuleInListMatch(buffer, list_offset, url))
+      return true;
+  }
+  return false;
+}
+
+// Verifying the ruleset -------------------------------------------------------
+
+bool VerifyRule(const uint8_t* buffer, size_t size, uint32_t offset) {
+  if (!IsValidRange(size, offset, kRuleHeaderSize))
+    return false;
+  const uint32_t flags = ReadUint32(buffer, offset);
+  if (((flags >> kAnchorLeftShift) & kAnchorMask) > UrlRule::ANCHOR_SUBDOMAIN ||
+      ((flags >> kAnchorRightShift) & kAnchorMask) > UrlRule::ANCHOR_BOUNDARY) {
+    return false;
+  }
+  const uint32_t pattern_size = ReadUint32(buffer, offset + sizeof(uint32_t));
+  return pattern_size <= size - offset - kRuleHeaderSize;
+}
+
+bool VerifyRuleList(const uint8_t* buffer, size_t size, uint32_t offset) {
+  if (!offset || !IsValidRange(size, offset, sizeof(uint32_t)))
+    return false;
+  const uint32_t number_of_rules = ReadUint32(buffer, offset);
+  if (number_of_rules > (size - offset) / sizeof(uint32_t) - 1)
+    return false;
+  for (uint32_t i = 0; i < number_of_rules; ++i) {
+    const size_t rule_offset_offset = offset + (i + 1) * sizeof(uint32_t);
+    if (!VerifyRule(buffer, size, ReadUint32(buffer, rule_offset_offset)))
+      return false;
+  }
+  return true;
+}
+
+bool VerifyIndex(const uint8_t* buffer, size_t size, uint32_t offset) {
+  if (!IsValidRange(size, offset, kIndexHeaderSize))
+    return false;
+  const uint32_t table_size = ReadUint32(buffer, offset);
+  if (!table_size || (table_size & (table_size - 1)) ||
+      table_size > (size - offset - kIndexHeaderSize) / kSlotSize) {
+    return false;
+  }
+  if (!VerifyRuleList(buffer, size,
+                      ReadUint32(buffer, offset + sizeof(uint32_t)))) {
+    return false;
+  }
+
+  // Probing only terminates if there is at least one empty slot.
+  bool has_empty_slot = false;
+  for (uint32_t slot = 0; slot < table_size; ++slot) {
+    const uint32_t list_offset = ReadUint32(
+        buffer, offset + kIndexHeaderSize + slot * kSlotSize +
+                    2 * sizeof(uint32_t));
+    if (!list_offset)
+      has_empty_slot = true;
+    else if (!VerifyRuleList(buffer, size, list_offset))
+      return false;
+  }
+  return has_empty_slot;
+}
+
+}  // namespace
+
+// UrlRule ---------------------------------------------------------------------
+
+UrlRule::UrlRule() = default;
+UrlRule::UrlRule(const UrlRule& other) = default;
+UrlRule::~UrlRule() = default;
+
+// RulesetIndexer --------------------------------------------------------------
+
+// Collects the rules of one kind, filed under their N-grams.
+class RulesetIndexer::UrlPatternIndexBuilder {
+ public:
+  using NGramIndex =
+      ClosedHashMap<uint64_t, std::vector<uint32_t>, NGramProber>;
+
+  UrlPatternIndexBuilder() {}
+
+  // Files the rule at |rule_offset| under the N-gram of its lower case
+  // |pattern| that has the fewest rules so far, or under no N-gram if the
+  // |pattern| has none.
+  void AddRule(base::StringPiece pattern, uint32_t rule_offset) {
+    uint64_t best_ngram = 0;
+    size_t best_ngram_rules = std::numeric_limits<size_t>::max();
+    for (uint64_t ngram :
+         CreateNGramExtractor<kNGramSize, uint64_t>(pattern,
+                                                    IsPatternSeparator)) {
+      const std::vector<uint32_t>* rules = ngram_index_.Get(ngram);
+      const size_t number_of_rules = rules ? rules->size() : 0;
+      if (number_of_rules < best_ngram_rules) {
+        best_ngram = ngram;
+        best_ngram_rules = number_of_rules;
+      }
+    }
+
+    if (best_ngram_rules == std::numeric_limits<size_t>::max())
+      fallback_rules_.push_back(rule_offset);
+    else
+      ngram_index_[best_ngram].push_back(rule_offset);
+  }
+
+  const NGramIndex& ngram_index() const { return ngram_index_; }
+  const std::vector<uint32_t>& fallback_rules() const {
+    return fallback_rules_;
+  }
+
+ private:
+  NGramIndex ngram_index_;
+  std::vector<uint32_t> fallback_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(UrlPatternIndexBuilder);
+};
+
+// static
+const int RulesetIndexer::kIndexedFormatVersion = 11;
+
+RulesetIndexer::RulesetIndexer()
+    : buffer_(kHeaderSize),
+      blacklist_(new UrlPatternIndexBuilder),
+      whitelist_(new UrlPatternIndexBuilder) {}
+
+RulesetIndexer::~RulesetIndexer() {}
+
+bool RulesetIndexer::AddUrlRule(const UrlRule& rule) {
+  DCHECK(!finished_);
+  if (rule.anchor_right == UrlRule::ANCHOR_SUBDOMAIN ||
+      !base::IsValueInRangeForNumericType<uint32_t>(rule.url_pattern.size())) {
+    return false;
+  }
+
+  const std::string lower_case_pattern = base::ToLowerASCII(rule.url_pattern);
+  const uint32_t rule_offset = base::checked_cast<uint32_t>(buffer_.size());
+  AppendUint32((rule.anchor_left << kAnchorLeftShift) |
+               (rule.anchor_right << kAnchorRightShift) |
+               (rule.match_case ? kMatchCaseFlag : 0));
+  AppendUint32(static_cast<uint32_t>(rule.url_pattern.size()));
+  const std::string& pattern =
+      rule.match_case ? rule.url_pattern : lower_case_pattern;
+  buffer_.insert(buffer_.end(), pattern.begin(), pattern.end());
+  buffer_.resize((buffer_.size() + sizeof(uint32_t) - 1) &
+                 ~(sizeof(uint32_t) - 1));
+
+  (rule.is_whitelist ? whitelist_ : blacklist_)
+      ->AddRule(lower_case_pattern, rule_offset);
+  return true;
+}
+
+void RulesetIndexer::Finish() {
+  DCHECK(!finished_);
+  finished_ = true;
+  SetUint32(0, kMagic);
+  SetUint32(sizeof(uint32_t), kIndexedFormatVersion);
+  SetUint32(2 * sizeof(uint32_t), SerializeIndex(*blacklist_));
+  SetUint32(3 * sizeof(uint32_t), SerializeIndex(*whitelist_));
+  blacklist_.reset();
+  whitelist_.reset();
+}
+
+void RulesetIndexer::AppendUint32(uint32_t value) {
+  buffer_.resize(buffer_.size() + sizeof(value));
+  SetUint32(buffer_.size() - sizeof(value), value);
+}
+
+void RulesetIndexer::SetUint32(size_t offset, uint32_t value) {
+  DCHECK_LE(offset + sizeof(value), buffer_.size());
+  memcpy(&buffer_[offset], &value, sizeof(value));
+}
+
+uint32_t RulesetIndexer::SerializeIndex(const UrlPatternIndexBuilder& builder) {
+  const UrlPatternIndexBuilder::NGramIndex& ngram_index =
+      builder.ngram_index();
+
+  // Write the rule lists first, so that the hash table can refer to them.
+  std::vector<uint32_t> list_offsets;
+  list_offsets.reserve(ngram_index.size());
+  for (const auto& entry : ngram_index.entries()) {
+    list_offsets.push_back(base::checked_cast<uint32_t>(buffer_.size()));
+    AppendUint32(base::checked_cast<uint32_t>(entry.second.size()));
+    for (uint32_t rule_offset : entry.second)
+      AppendUint32(rule_offset);
+  }
+  const uint32_t fallback_list_offset =
+      base::checked_cast<uint32_t>(buffer_.size());
+  AppendUint32(base::checked_cast<uint32_t>(builder.fallback_rules().size()));
+  for (uint32_t rule_offset : builder.fallback_rules())
+    AppendUint32(rule_offset);
+
+  // The slots are laid out as in the |ngram_index|, so that lookups with the
+  // same prober find the same slots.
+  const uint32_t index_offset = base::checked_cast<uint32_t>(buffer_.size());
+  AppendUint32(base::checked_cast<uint32_t>(ngram_index.table_size()));
+  AppendUint32(fallback_list_offset);
+  for (uint32_t entry_index : ngram_index.hash_table()) {
+    if (entry_index >= ngram_index.size()) {
+      AppendUint32(0);
+      AppendUint32(0);
+      AppendUint32(0);
+      continue;
+    }
+    const uint64_t ngram = ngram_index.entries()[entry_index].first;
+    AppendUint32(static_cast<uint32_t>(ngram));
+    AppendUint32(static_cast<uint32_t>(ngram >> 32));
+    AppendUint32(list_offsets[entry_index]);
+  }
+  return index_offset;
+}
+
+// IndexedRulesetMatcher -------------------------------------------------------
+
+// static
+bool IndexedRulesetMatcher::Verify(const uint8_t* buffer, size_t size) {
+  if (reinterpret_cast<uintptr_t>(buffer) % sizeof(uint32_t) != 0 ||
+      size < kHeaderSize) {
+    return false;
+  }
+  return ReadUint32(buffer, 0) == kMagic &&
+         ReadUint32(buffer, sizeof(uint32_t)) ==
+             static_cast<uint32_t>(RulesetIndexer::kIndexedFormatVersion) &&
+         VerifyIndex(buffer, size, ReadUint32(buffer, 2 * sizeof(uint32_t))) &&
+         VerifyIndex(buffer, size, ReadUint32(buffer, 3 * sizeof(uint32_t)));
+}
+
+IndexedRulesetMatcher::IndexedRulesetMatcher(const uint8_t* buffer,
+                                             size_t size)
+    : buffer_(buffer) {
+  DCHECK(Verify(buffer, size));
+}
+
+IndexedRulesetMatcher::~IndexedRulesetMatcher() {}
+
+bool IndexedRulesetMatcher::ShouldDisallowSubresourceLoad(
+    const GURL& url) const {
+  if (!url.is_valid())
+    return false;
+
+  const std::string lower_case_spec = base::ToLowerASCII(url.spec());
+  UrlToMatch url_to_match;
+  url_to_match.spec = url.spec();
+  url_to_match.lower_case_spec = lower_case_spec;
+  url_to_match.host = url.parsed_for_possibly_invalid_spec().host;
+
+  const uint32_t blacklist_offset = ReadUint32(buffer_, 2 * sizeof(uint32_t));
+  const uint32_t whitelist_offset = ReadUint32(buffer_, 3 * sizeof(uint32_t));
+  return IsAnyRuleInIndexMatch(buffer_, blacklist_offset, url_to_match) &&
+         !IsAnyRuleInIndexMatch(buffer_, whitelist_offset, url_to_match);
+}
+
+}  // namespace subresource_filter
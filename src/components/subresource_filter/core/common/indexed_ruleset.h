@@ -0,0 +1,124 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_SUBRESOURCE_FILTER_CORE_COMMON_INDEXED_RULESET_H_
+#define COMPONENTS_SUBRESOURCE_FILTER_CORE_COMMON_INDEXED_RULESET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+class GURL;
+
+namespace subresource_filter {
+
+// A rule that matches URLs against a pattern, in the subset of the EasyList
+// syntax that the indexed ruleset supports. The |url_pattern| can contain the
+// '*' wildcard, matching any sequence of characters, and the '^' separator
+// placeholder, see fuzzy_pattern_matching.h.
+struct UrlRule {
+  enum AnchorType {
+    // The pattern can match anywhere.
+    ANCHOR_NONE,
+    // The pattern must match at the beginning (the "|" prefix) or at the end
+    // (the "|" suffix) of the URL.
+    ANCHOR_BOUNDARY,
+    // The pattern must match at the beginning of the host or of one of its
+    // subdomains (the "||" prefix). Only valid as |anchor_left|.
+    ANCHOR_SUBDOMAIN,
+  };
+
+  UrlRule();
+  UrlRule(const UrlRule& other);
+  ~UrlRule();
+
+  std::string url_pattern;
+  AnchorType anchor_left = ANCHOR_NONE;
+  AnchorType anchor_right = ANCHOR_NONE;
+
+  // Whether the pattern is case sensitive ("match-case" option).
+  bool match_case = false;
+
+  // Whether the rule allows the loads that blacklist rules disallow ("@@").
+  bool is_whitelist = false;
+};
+
+// Builds the binary representation of a ruleset, which is meant to be built
+// once, stored to disk, and memory-mapped read-only by IndexedRulesetMatcher
+// in every renderer, so that no parsing is needed before matching and all
+// renderers share the same physical pages.
+//
+// Each rule is filed under one N-gram of its pattern, the one shared by the
+// fewest other rules, which any matching URL must contain. Matching a URL
+// then looks up the N-grams of the URL in an open addressing hash table and
+// only checks the rules filed under them, plus the few rules whose patterns
+// have no N-grams at all.
+class RulesetIndexer {
+ public:
+  // The binary format version of the indexed ruleset. Must be incremented
+  // whenever the format changes.
+  static const int kIndexedFormatVersion;
+
+  RulesetIndexer();
+  ~RulesetIndexer();
+
+  // Adds |rule| to the ruleset. Returns false and ignores the rule if it is
+  // not supported. Must not be called after Finish().
+  bool AddUrlRule(const UrlRule& rule);
+
+  // Writes the indices. Must be called exactly once, after all the rules are
+  // added, and before accessing data().
+  void Finish();
+
+  const uint8_t* data() const { return buffer_.data(); }
+  size_t size() const { return buffer_.size(); }
+
+ private:
+  class UrlPatternIndexBuilder;
+
+  void AppendUint32(uint32_t value);
+  void SetUint32(size_t offset, uint32_t value);
+
+  // Appends the index built by |builder| to the buffer and returns its offset.
+  uint32_t SerializeIndex(const UrlPatternIndexBuilder& builder);
+
+  std::vector<uint8_t> buffer_;
+  std::unique_ptr<UrlPatternIndexBuilder> blacklist_;
+  std::unique_ptr<UrlPatternIndexBuilder> whitelist_;
+  bool finished_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(RulesetIndexer);
+};
+
+// Matches URLs against a ruleset built by RulesetIndexer, directly from its
+// binary representation, without copying it.
+class IndexedRulesetMatcher {
+ public:
+  // Returns whether the |size| bytes at |buffer| are a well-formed ruleset of
+  // the current format version, which can be safely passed to the constructor.
+  static bool Verify(const uint8_t* buffer, size_t size);
+
+  // The |buffer| must be verified with Verify(), and must outlive this
+  // instance.
+  IndexedRulesetMatcher(const uint8_t* buffer, size_t size);
+  ~IndexedRulesetMatcher();
+
+  // Returns whether the |url| is matched by a blacklist rule, and not by any
+  // whitelist rule.
+  bool ShouldDisallowSubresourceLoad(const GURL& url) const;
+
+ private:
+  const uint8_t* buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(IndexedRulesetMatcher);
+};
+
+}  // namespace subresource_filter
+
+#endif  // COMPONENTS_SUBRESOURCE_FILTER_CORE_COMMON_INDEXED_RULESET_H_
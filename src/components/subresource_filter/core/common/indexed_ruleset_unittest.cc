@@ -0,0 +1,227 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/subresource_filter/core/common/indexed_ruleset.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace subresource_filter {
+
+namespace {
+
+UrlRule MakeRule(const std::string& url_pattern,
+                 UrlRule::AnchorType anchor_left = UrlRule::ANCHOR_NONE,
+                 UrlRule::AnchorType anchor_right = UrlRule::ANCHOR_NONE) {
+  UrlRule rule;
+  rule.url_pattern = url_pattern;
+  rule.anchor_left = anchor_left;
+  rule.anchor_right = anchor_right;
+  return rule;
+}
+
+// Builds a ruleset and matches URLs against it.
+class TestRuleset {
+ public:
+  TestRuleset() {}
+
+  bool AddRule(const UrlRule& rule) { return indexer_.AddUrlRule(rule); }
+
+  void Finish() {
+    indexer_.Finish();
+    // Copy the ruleset into a buffer of uint32_t to get the alignment that the
+    // memory-mapped file has.
+    buffer_.resize((size() + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+    memcpy(buffer_.data(), indexer_.data(), size());
+    ASSERT_TRUE(IndexedRulesetMatcher::Verify(data(), size()));
+    matcher_.reset(new IndexedRulesetMatcher(data(), size()));
+  }
+
+  bool ShouldDisallow(const std::string& url) const {
+    return matcher_->ShouldDisallowSubresourceLoad(GURL(url));
+  }
+
+  const uint8_t* data() const {
+    return reinterpret_cast<const uint8_t*>(buffer_.data());
+  }
+  size_t size() const { return indexer_.size(); }
+  std::vector<uint32_t>& buffer() { return buffer_; }
+
+ private:
+  RulesetIndexer indexer_;
+  std::vector<uint32_t> buffer_;
+  std::unique_ptr<IndexedRulesetMatcher> matcher_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestRuleset);
+};
+
+// Returns whether a ruleset with only the |rule| disallows the |url|.
+bool IsMatch(const UrlRule& rule, const std::string& url) {
+  TestRuleset ruleset;
+  EXPECT_TRUE(ruleset.AddRule(rule));
+  ruleset.Finish();
+  return ruleset.ShouldDisallow(url);
+}
+
+}  // namespace
+
+TEST(IndexedRulesetTest, EmptyRuleset) {
+  TestRuleset ruleset;
+  ruleset.Finish();
+  EXPECT_FALSE(ruleset.ShouldDisallow("http://example.com/"));
+  EXPECT_FALSE(ruleset.ShouldDisallow("invalid"));
+}
+
+TEST(IndexedRulesetTest, UrlPatterns) {
+  const struct {
+    UrlRule rule;
+    const char* url;
+    bool expect_match;
+  } kTestCases[] = {
+      {MakeRule("ads"), "http://example.com/ads/banner.png", true},
+      {MakeRule("ads"), "http://example.com/a/d/s", false},
+      {MakeRule("advertisement"), "http://example.com/advertisement", true},
+      {MakeRule("advertisement"), "http://example.com/advertisment", false},
+      // Matching is case insensitive unless match_case is set.
+      {MakeRule("AdBanner"), "http://example.com/adbanner.gif", true},
+      {MakeRule("adbanner"), "http://example.com/ADBANNER.gif", true},
+      // Wildcards.
+      {MakeRule("banner*.gif"), "http://example.com/banner/top.gif", true},
+      {MakeRule("banner*.gif"), "http://example.com/banner/top.png", false},
+      {MakeRule("a*b*c"), "http://example.com/axxbyyc", true},
+      {MakeRule("a*b*c"), "http://example.com/cba", false},
+      // Separator placeholders.
+      {MakeRule("example.com^"), "http://example.com/", true},
+      {MakeRule("example.com^"), "http://example.com:8080/", true},
+      {MakeRule("example.com^"), "http://example.company.org/", false},
+      {MakeRule("/ads^"), "http://example.com/ads", true},
+      {MakeRule("/ads^"), "http://example.com/ads?x", true},
+      {MakeRule("/ads^"), "http://example.com/ads.js", false},
+      // Left and right anchors.
+      {MakeRule("http://ads", UrlRule::ANCHOR_BOUNDARY),
+       "http://ads.example.com/", true},
+      {MakeRule("http://ads", UrlRule::ANCHOR_BOUNDARY),
+       "http://example.com/?http://ads", false},
+      {MakeRule(".swf", UrlRule::ANCHOR_NONE, UrlRule::ANCHOR_BOUNDARY),
+       "http://example.com/movie.swf", true},
+      {MakeRule(".swf", UrlRule::ANCHOR_NONE, UrlRule::ANCHOR_BOUNDARY),
+       "http://example.com/movie.swf.html", false},
+      {MakeRule("http://example.com/", UrlRule::ANCHOR_BOUNDARY,
+                UrlRule::ANCHOR_BOUNDARY),
+       "http://example.com/", true},
+      {MakeRule("http://example.com/", UrlRule::ANCHOR_BOUNDARY,
+                UrlRule::ANCHOR_BOUNDARY),
+       "http://example.com/a", false},
+      {MakeRule("http://*.js", UrlRule::ANCHOR_BOUNDARY,
+                UrlRule::ANCHOR_BOUNDARY),
+       "http://example.com/script.js", true},
+      // Subdomain anchors.
+      {MakeRule("example.com^", UrlRule::ANCHOR_SUBDOMAIN),
+       "http://example.com/", true},
+      {MakeRule("example.com^", UrlRule::ANCHOR_SUBDOMAIN),
+       "https://ads.example.com/a.js", true},
+      {MakeRule("example.com^", UrlRule::ANCHOR_SUBDOMAIN),
+       "http://notexample.com/", false},
+      {MakeRule("example.com^", UrlRule::ANCHOR_SUBDOMAIN),
+       "http://other.com/example.com/", false},
+      {MakeRule("ads.example.com/*.js", UrlRule::ANCHOR_SUBDOMAIN),
+       "http://x.ads.example.com/a/b.js", true},
+      // Short patterns are matched without an N-gram.
+      {MakeRule("ad"), "http://example.com/ad", true},
+      {MakeRule("^ad^"), "http://example.com/ad/", true},
+      {MakeRule("^ad^"), "http://example.com/adx/", false},
+  };
+
+  for (const auto& test_case : kTestCases) {
+    SCOPED_TRACE(base::StringPrintf(
+        "Pattern: %s, anchors: %d %d, URL: %s",
+        test_case.rule.url_pattern.c_str(), test_case.rule.anchor_left,
+        test_case.rule.anchor_right, test_case.url));
+    EXPECT_EQ(test_case.expect_match, IsMatch(test_case.rule, test_case.url));
+  }
+}
+
+TEST(IndexedRulesetTest, MatchCase) {
+  UrlRule rule = MakeRule("AdBanner");
+  rule.match_case = true;
+  EXPECT_TRUE(IsMatch(rule, "http://example.com/AdBanner.gif"));
+  EXPECT_FALSE(IsMatch(rule, "http://example.com/adbanner.gif"));
+}
+
+TEST(IndexedRulesetTest, UnsupportedRule) {
+  TestRuleset ruleset;
+  EXPECT_FALSE(ruleset.AddRule(MakeRule("example.com", UrlRule::ANCHOR_NONE,
+                                        UrlRule::ANCHOR_SUBDOMAIN)));
+}
+
+TEST(IndexedRulesetTest, Whitelist) {
+  TestRuleset ruleset;
+  ASSERT_TRUE(ruleset.AddRule(MakeRule("ads")));
+  UrlRule whitelist_rule = MakeRule("example.com/ads/allowed");
+  whitelist_rule.is_whitelist = true;
+  ASSERT_TRUE(ruleset.AddRule(whitelist_rule));
+  ruleset.Finish();
+
+  EXPECT_TRUE(ruleset.ShouldDisallow("http://example.com/ads/banner.gif"));
+  EXPECT_FALSE(ruleset.ShouldDisallow("http://example.com/ads/allowed.gif"));
+  EXPECT_FALSE(ruleset.ShouldDisallow("http://example.com/allowed.gif"));
+}
+
+TEST(IndexedRulesetTest, ManyRules) {
+  TestRuleset ruleset;
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(
+        ruleset.AddRule(MakeRule(base::StringPrintf("ads%d.example.com^", i),
+                                 UrlRule::ANCHOR_SUBDOMAIN)));
+    ASSERT_TRUE(ruleset.AddRule(MakeRule(base::StringPrintf("/banner%d.", i))));
+  }
+  ruleset.Finish();
+
+  EXPECT_TRUE(ruleset.ShouldDisallow("http://ads42.example.com/"));
+  EXPECT_TRUE(ruleset.ShouldDisallow("http://www.ads999.example.com/a.js"));
+  EXPECT_FALSE(ruleset.ShouldDisallow("http://ads1000.example.com/"));
+  EXPECT_TRUE(ruleset.ShouldDisallow("http://example.com/img/banner7.png"));
+  EXPECT_FALSE(ruleset.ShouldDisallow("http://example.com/img/banner.png"));
+}
+
+TEST(IndexedRulesetTest, VerifyRejectsMalformedRulesets) {
+  TestRuleset ruleset;
+  ASSERT_TRUE(ruleset.AddRule(MakeRule("ads")));
+  ASSERT_TRUE(ruleset.AddRule(MakeRule("advertisement")));
+  ruleset.Finish();
+  const uint8_t* data = ruleset.data();
+  const size_t size = ruleset.size();
+  std::vector<uint32_t>& buffer = ruleset.buffer();
+
+  EXPECT_FALSE(IndexedRulesetMatcher::Verify(data, 0));
+  EXPECT_FALSE(IndexedRulesetMatcher::Verify(data, size / 2));
+  EXPECT_FALSE(IndexedRulesetMatcher::Verify(data + 1, size - 1));
+
+  // Wrong format version.
+  buffer[1] += 1;
+  EXPECT_FALSE(IndexedRulesetMatcher::Verify(data, size));
+  buffer[1] -= 1;
+
+  // Offsets pointing out of the buffer must be rejected without reading out
+  // of bounds.
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    const uint32_t original = buffer[i];
+    buffer[i] = 0xFFFFFFF0u;
+    IndexedRulesetMatcher::Verify(data, size);
+    buffer[i] = original;
+  }
+  EXPECT_TRUE(IndexedRulesetMatcher::Verify(data, size));
+}
+
+}  // namespace subresource_filter
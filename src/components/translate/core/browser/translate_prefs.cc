@@ -498,23 +498,26 @@ void TranslatePrefs::MigrateUserPrefs(PrefService* user_prefs,
   DictionaryPrefUpdate update(user_prefs, kPrefTranslateWhitelists);
   base::DictionaryValue* dict = update.Get();
   if (dict && !dict->empty()) {
-    base::DictionaryValue::Iterator iter(*dict);
-    while (!iter.IsAtEnd()) {
+    // Removals are deferred until after the iteration, which they would
+    // otherwise disturb.
+    std::vector<std::string> keys_to_remove;
+    for (base::DictionaryValue::Iterator iter(*dict); !iter.IsAtEnd();
+         iter.Advance()) {
       const base::ListValue* list = NULL;
       if (!iter.value().GetAsList(&list) || !list)
         break;  // Dictionary has either been migrated or new format.
       std::string key = iter.key();
-      // Advance the iterator before removing the current element.
-      iter.Advance();
       std::string target_lang;
       if (list->empty() ||
           !list->GetString(list->GetSize() - 1, &target_lang) ||
           target_lang.empty()) {
-        dict->Remove(key, NULL);
+        keys_to_remove.push_back(key);
       } else {
         dict->SetString(key, target_lang);
       }
     }
+    for (const std::string& key : keys_to_remove)
+      dict->Remove(key, NULL);
   }
 }
 
@@ -21,6 +21,11 @@ bool ComparePatterns(const StringPattern* a, const StringPattern* b) {
   return a->pattern() < b->pattern();
 }
 
+// Compares an edge of an AhoCorasickNode with an edge label.
+bool CompareEdgeLabel(const std::pair<char, uint32_t>& edge, char label) {
+  return edge.first < label;
+}
+
 // Given the set of patterns, compute how many nodes will the corresponding
 // Aho-Corasick tree have. Note that |patterns| need to be sorted.
 uint32_t TreeSize(const std::vector<const StringPattern*>& patterns) {
@@ -125,8 +130,16 @@ bool SubstringSetMatcher::Match(const std::string& text,
     }
     if (edge_from_current != AhoCorasickNode::kNoSuchEdge) {
       current_node = edge_from_current;
-      matches->insert(tree_[current_node].matches().begin(),
-                      tree_[current_node].matches().end());
+      // Report the patterns ending here and, following the output links, the
+      // ones ending at the nodes of the failure chain.
+      uint32_t node = current_node;
+      if (tree_[node].matches().empty())
+        node = tree_[node].output_link();
+      while (node != AhoCorasickNode::kNoSuchEdge) {
+        matches->insert(tree_[node].matches().begin(),
+                        tree_[node].matches().end());
+        node = tree_[node].output_link();
+      }
     } else {
       DCHECK_EQ(0u, current_node);
     }
@@ -140,6 +153,13 @@ bool SubstringSetMatcher::IsEmpty() const {
   return patterns_.empty() && tree_.size() == 1u;
 }
 
+size_t SubstringSetMatcher::EstimateMemoryUsage() const {
+  size_t result = tree_.capacity() * sizeof(AhoCorasickNode);
+  for (const AhoCorasickNode& node : tree_)
+    result += node.EstimateMemoryUsage();
+  return result;
+}
+
 void SubstringSetMatcher::RebuildAhoCorasickTree(
     const SubstringPatternVector& sorted_patterns) {
   tree_.clear();
@@ -196,11 +216,13 @@ void SubstringSetMatcher::CreateFailureEdges() {
 
   AhoCorasickNode& root = tree_[0];
   root.set_failure(0);
+  root.set_output_link(AhoCorasickNode::kNoSuchEdge);
   const Edges& root_edges = root.edges();
   for (Edges::const_iterator e = root_edges.begin(); e != root_edges.end();
        ++e) {
     const uint32_t& leads_to = e->second;
     tree_[leads_to].set_failure(0);
+    tree_[leads_to].set_output_link(AhoCorasickNode::kNoSuchEdge);
     queue.push(leads_to);
   }
 
@@ -225,7 +247,13 @@ void SubstringSetMatcher::CreateFailureEdges() {
           edge_from_failure != AhoCorasickNode::kNoSuchEdge ? edge_from_failure
                                                             : 0;
       tree_[leads_to].set_failure(follow_in_case_of_failure);
-      tree_[leads_to].AddMatches(tree_[follow_in_case_of_failure].matches());
+
+      // The matches of the root are reported separately.
+      const AhoCorasickNode& failure_node = tree_[follow_in_case_of_failure];
+      tree_[leads_to].set_output_link(
+          follow_in_case_of_failure != 0 && !failure_node.matches().empty()
+              ? follow_in_case_of_failure
+              : failure_node.output_link());
     }
   }
 }
@@ -233,7 +261,7 @@ void SubstringSetMatcher::CreateFailureEdges() {
 const uint32_t SubstringSetMatcher::AhoCorasickNode::kNoSuchEdge = 0xFFFFFFFF;
 
 SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode()
-    : failure_(kNoSuchEdge) {}
+    : failure_(kNoSuchEdge), output_link_(kNoSuchEdge) {}
 
 SubstringSetMatcher::AhoCorasickNode::~AhoCorasickNode() {}
 
@@ -241,6 +269,7 @@ SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode(
     const SubstringSetMatcher::AhoCorasickNode& other)
     : edges_(other.edges_),
       failure_(other.failure_),
+      output_link_(other.output_link_),
       matches_(other.matches_) {}
 
 SubstringSetMatcher::AhoCorasickNode&
@@ -248,26 +277,34 @@ SubstringSetMatcher::AhoCorasickNode::operator=(
     const SubstringSetMatcher::AhoCorasickNode& other) {
   edges_ = other.edges_;
   failure_ = other.failure_;
+  output_link_ = other.output_link_;
   matches_ = other.matches_;
   return *this;
 }
 
 uint32_t SubstringSetMatcher::AhoCorasickNode::GetEdge(char c) const {
-  Edges::const_iterator i = edges_.find(c);
-  return i == edges_.end() ? kNoSuchEdge : i->second;
+  Edges::const_iterator i =
+      std::lower_bound(edges_.begin(), edges_.end(), c, CompareEdgeLabel);
+  return i != edges_.end() && i->first == c ? i->second : kNoSuchEdge;
 }
 
 void SubstringSetMatcher::AhoCorasickNode::SetEdge(char c, uint32_t node) {
-  edges_[c] = node;
+  Edges::iterator i =
+      std::lower_bound(edges_.begin(), edges_.end(), c, CompareEdgeLabel);
+  if (i != edges_.end() && i->first == c)
+    i->second = node;
+  else
+    edges_.insert(i, std::make_pair(c, node));
 }
 
 void SubstringSetMatcher::AhoCorasickNode::AddMatch(StringPattern::ID id) {
-  matches_.insert(id);
+  if (std::find(matches_.begin(), matches_.end(), id) == matches_.end())
+    matches_.push_back(id);
 }
 
-void SubstringSetMatcher::AhoCorasickNode::AddMatches(
-    const SubstringSetMatcher::AhoCorasickNode::Matches& matches) {
-  matches_.insert(matches.begin(), matches.end());
+size_t SubstringSetMatcher::AhoCorasickNode::EstimateMemoryUsage() const {
+  return edges_.capacity() * sizeof(Edges::value_type) +
+         matches_.capacity() * sizeof(Matches::value_type);
 }
 
 }  // namespace url_matcher
@@ -5,12 +5,13 @@
 #ifndef COMPONENTS_URL_MATCHER_SUBSTRING_SET_MATCHER_H_
 #define COMPONENTS_URL_MATCHER_SUBSTRING_SET_MATCHER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
-#include <limits>
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/macros.h"
@@ -50,6 +51,10 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   // Returns true if this object retains no allocated data. Only for debugging.
   bool IsEmpty() const;
 
+  // Returns an estimate of the heap memory used by the tree, in bytes. Used to
+  // measure the cost of large pattern sets.
+  size_t EstimateMemoryUsage() const;
+
  private:
   // A node of an Aho Corasick Tree. This is implemented according to
   // http://www.cs.uku.fi/~kilpelai/BSA05/lectures/slides04.pdf
@@ -81,11 +86,19 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   // If your brain thinks "Forget it, let's go shopping.", don't worry.
   // Take a nap and read an introductory text on the Aho Corasick algorithm.
   // It will make sense. Eventually.
+  //
+  // A node only stores the IDs of the patterns ending at it. The patterns that
+  // end at nodes on its failure chain are reached through the output link,
+  // which points to the nearest such node, so that matches are not copied
+  // along failure edges. With many patterns, that copying dominated the size
+  // of the tree.
   class AhoCorasickNode {
    public:
-    // Key: label of the edge, value: node index in |tree_| of parent class.
-    typedef std::map<char, uint32_t> Edges;
-    typedef std::set<StringPattern::ID> Matches;
+    // Pairs of edge label and node index in |tree_| of parent class, sorted
+    // by label. Most nodes have one or two edges, for which a flat array is
+    // both smaller and faster to search than a map.
+    typedef std::vector<std::pair<char, uint32_t>> Edges;
+    typedef std::vector<StringPattern::ID> Matches;
 
     static const uint32_t kNoSuchEdge;  // Represents an invalid node index.
 
@@ -101,10 +114,14 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     uint32_t failure() const { return failure_; }
     void set_failure(uint32_t failure) { failure_ = failure; }
 
+    uint32_t output_link() const { return output_link_; }
+    void set_output_link(uint32_t node) { output_link_ = node; }
+
     void AddMatch(StringPattern::ID id);
-    void AddMatches(const Matches& matches);
     const Matches& matches() const { return matches_; }
 
+    size_t EstimateMemoryUsage() const;
+
    private:
     // Outgoing edges of current node.
     Edges edges_;
@@ -112,7 +129,11 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     // Node index that failure edge leads to.
     uint32_t failure_;
 
-    // Identifiers of matches.
+    // Index of the nearest node other than the root on the failure chain that
+    // has matches, or kNoSuchEdge.
+    uint32_t output_link_;
+
+    // Identifiers of the patterns ending at this node.
     Matches matches_;
   };
 
@@ -126,6 +147,8 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   // |pattern->id()| to the set of matches. Ownership of |pattern| remains with
   // the caller.
   void InsertPatternIntoAhoCorasickTree(const StringPattern* pattern);
+
+  // Computes the failure edges and output links of all nodes.
   void CreateFailureEdges();
 
   // Set of all registered StringPatterns. Used to regenerate the
@@ -0,0 +1,88 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/url_matcher/substring_set_matcher.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace url_matcher {
+
+namespace {
+
+// The size of a large content filtering policy.
+const int kNumPatterns = 50000;
+const int kNumURLs = 1000;
+const int kIterations = 10;
+
+// Returns a pattern that looks like the host and path filters of a policy,
+// e.g. "ads42.tracker7.com/banner".
+std::string MakePattern(int i) {
+  return base::StringPrintf("ads%d.tracker%d.com/banner", i, i % 97);
+}
+
+// Returns a URL in the form that URLMatcher searches for full URL matches,
+// which matches a pattern for one in ten URLs.
+std::string MakeURL(int i) {
+  if (i % 10 == 0) {
+    return base::StringPrintf("https://%s?id=%d", MakePattern(i * 7).c_str(),
+                              i);
+  }
+  return base::StringPrintf(
+      "https://www.site%d.com/articles/%d/some-article-title.html?utm_source="
+      "newsletter&utm_medium=email&ref=%d",
+      i, i * 31, i);
+}
+
+}  // namespace
+
+TEST(SubstringSetMatcherPerfTest, LargePatternSet) {
+  std::vector<std::unique_ptr<StringPattern>> owned_patterns;
+  std::vector<const StringPattern*> patterns;
+  for (int i = 0; i < kNumPatterns; ++i) {
+    owned_patterns.push_back(
+        std::unique_ptr<StringPattern>(new StringPattern(MakePattern(i), i)));
+    patterns.push_back(owned_patterns.back().get());
+  }
+
+  std::vector<std::string> urls;
+  for (int i = 0; i < kNumURLs; ++i)
+    urls.push_back(MakeURL(i));
+
+  SubstringSetMatcher matcher;
+  base::TimeTicks start = base::TimeTicks::Now();
+  matcher.RegisterPatterns(patterns);
+  base::TimeDelta build_time = base::TimeTicks::Now() - start;
+
+  size_t total_matches = 0;
+  start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (const std::string& url : urls) {
+      std::set<StringPattern::ID> matches;
+      matcher.Match(url, &matches);
+      total_matches += matches.size();
+    }
+  }
+  base::TimeDelta match_time = base::TimeTicks::Now() - start;
+  EXPECT_EQ(static_cast<size_t>(kIterations * kNumURLs / 10), total_matches);
+
+  perf_test::PrintResult("substring_set_matcher", "", "build_time",
+                         build_time.InMillisecondsF(), "ms", true);
+  perf_test::PrintResult(
+      "substring_set_matcher", "", "match_throughput",
+      kIterations * kNumURLs / match_time.InSecondsF(), "urls/s", true);
+  perf_test::PrintResult("substring_set_matcher", "", "memory",
+                         matcher.EstimateMemoryUsage() / 1024, "KB", true);
+}
+
+}  // namespace url_matcher
@@ -123,6 +123,39 @@ TEST(SubstringSetMatcherTest, TestMatcher) {
   TestTwoPatterns("abcde", std::string(), "abcdef", true, false);
 }
 
+TEST(SubstringSetMatcherTest, TestMatchesOnFailureChain) {
+  // String    abcd
+  // Pattern 1 abcd
+  // Pattern 2  bcdx
+  // Pattern 3   cd
+  // Pattern 4    d
+  // The failure chain of "abcd" goes through "bcd", which is not a pattern.
+  StringPattern pattern_1("abcd", 1);
+  StringPattern pattern_2("bcdx", 2);
+  StringPattern pattern_3("cd", 3);
+  StringPattern pattern_4("d", 4);
+  std::vector<const StringPattern*> patterns;
+  patterns.push_back(&pattern_1);
+  patterns.push_back(&pattern_2);
+  patterns.push_back(&pattern_3);
+  patterns.push_back(&pattern_4);
+  SubstringSetMatcher matcher;
+  matcher.RegisterPatterns(patterns);
+
+  std::set<int> matches;
+  matcher.Match("abcd", &matches);
+  EXPECT_EQ(3u, matches.size());
+  EXPECT_TRUE(matches.end() != matches.find(1));
+  EXPECT_TRUE(matches.end() != matches.find(3));
+  EXPECT_TRUE(matches.end() != matches.find(4));
+
+  matches.clear();
+  matcher.Match("xbcd", &matches);
+  EXPECT_EQ(2u, matches.size());
+  EXPECT_TRUE(matches.end() != matches.find(3));
+  EXPECT_TRUE(matches.end() != matches.find(4));
+}
+
 TEST(SubstringSetMatcherTest, RegisterAndRemove) {
   SubstringSetMatcher matcher;
 
@@ -56,6 +56,11 @@ const unsigned VisitedLinkMaster::kDefaultTableSize = 16381;
 
 const size_t VisitedLinkMaster::kBigDeleteThreshold = 64;
 
+// Copying this many entries takes well under a millisecond.
+const int32_t VisitedLinkMaster::kResizeEntriesPerTask = 65536;
+
+const size_t VisitedLinkMaster::kRebuildBatchSize = 10000;
+
 namespace {
 
 // Fills the given salt structure with some quasi-random values
@@ -161,6 +166,32 @@ VisitedLinkMaster::LoadFromFileResult::LoadFromFileResult(
 VisitedLinkMaster::LoadFromFileResult::~LoadFromFileResult() {
 }
 
+// PendingTable ---------------------------------------------------------------
+
+// How resizing works
+// ------------------
+//
+// Resizing allocates a new table and copies the entries of the current table
+// to it, in slot order. Small tables are copied all at once. Large tables that
+// grow are copied kResizeEntriesPerTask entries at a time, in tasks posted to
+// the main thread, so that other events can be processed in between.
+//
+// The current table stays complete and in use by the child processes while
+// the new one is filled: fingerprints are still added to it, and also to the
+// new table if their slot has already been copied. Deleting a fingerprint
+// moves others around in the current table, so it finishes the resize
+// first. Once all the slots are copied, the new table replaces the current
+// one and the child processes are sent its handle.
+struct VisitedLinkMaster::PendingTable {
+  std::unique_ptr<base::SharedMemory> shared_memory;
+  Fingerprint* hash_table = nullptr;
+  int32_t table_length = 0;
+  int32_t used_items = 0;
+
+  // The slots of the current table before this one have been copied.
+  int32_t next_slot = 0;
+};
+
 // TableBuilder ---------------------------------------------------------------
 
 // How rebuilding from history works
@@ -171,10 +202,10 @@ VisitedLinkMaster::LoadFromFileResult::~LoadFromFileResult() {
 // will be called on the history thread by the history system for every URL
 // in the database.
 //
-// The builder will store the fingerprints for those URLs, and then marshalls
-// back to the main thread where the VisitedLinkMaster will be notified. The
-// master then replaces its table with a new table containing the computed
-// fingerprints.
+// The builder will store the fingerprints for those URLs, and marshall them
+// back to the main thread in batches of kRebuildBatchSize, where the
+// VisitedLinkMaster adds them to its table as they come, growing it as
+// needed. Once the last batch is added, the master writes the table to disk.
 //
 // The builder must remain active while the history system is using it.
 // Sometimes, the master will be deleted before the rebuild is complete, in
@@ -198,6 +229,10 @@ class VisitedLinkMaster::TableBuilder
  private:
   ~TableBuilder() override {}
 
+  // OnURL marshals every batch of fingerprints to this function on the main
+  // thread.
+  void OnFingerprintsMainThread(const Fingerprints& fingerprints);
+
   // OnComplete mashals to this function on the main thread to do the
   // notification.
   void OnCompleteMainThread();
@@ -227,6 +262,7 @@ VisitedLinkMaster::VisitedLinkMaster(content::BrowserContext* browser_context,
       listener_(new VisitedLinkEventListener(this, browser_context)),
       persist_to_disk_(persist_to_disk),
       table_is_loading_from_file_(false),
+      resize_weak_ptr_factory_(this),
       weak_ptr_factory_(this) {
   InitMembers();
 }
@@ -241,6 +277,7 @@ VisitedLinkMaster::VisitedLinkMaster(Listener* listener,
       delegate_(delegate),
       persist_to_disk_(persist_to_disk),
       table_is_loading_from_file_(false),
+      resize_weak_ptr_factory_(this),
       weak_ptr_factory_(this) {
   listener_.reset(listener);
   DCHECK(listener_.get());
@@ -396,6 +433,8 @@ void VisitedLinkMaster::DeleteAllURLs() {
   deleted_since_load_.clear();
   table_is_loading_from_file_ = false;
 
+  CancelPendingResize();
+
   // Clear the hash table.
   used_items_ = 0;
   memset(hash_table_, 0, this->table_length_ * sizeof(Fingerprint));
@@ -478,6 +517,8 @@ VisitedLinkMaster::Hash VisitedLinkMaster::AddFingerprint(
       // End of probe sequence found, insert here.
       hash_table_[cur_hash] = fingerprint;
       used_items_++;
+      if (pending_table_ && cur_hash < pending_table_->next_slot)
+        AddFingerprintToPendingTable(fingerprint);
       // If allowed, notify listener that a new visited link was added.
       if (send_notifications)
         listener_->Add(fingerprint);
@@ -523,6 +564,11 @@ bool VisitedLinkMaster::DeleteFingerprint(Fingerprint fingerprint,
   if (!IsVisited(fingerprint))
     return false;  // Not in the database to delete.
 
+  // Deleting moves the fingerprints that follow around, possibly from slots
+  // that haven't been copied to ones that have.
+  if (pending_table_)
+    FinishPendingResize();
+
   // First update the header used count.
   used_items_--;
   if (update_file && persist_to_disk_)
@@ -684,6 +730,7 @@ void VisitedLinkMaster::OnTableLoadComplete(
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
   DCHECK(persist_to_disk_);
   DCHECK(!table_builder_.get());
+  DCHECK(!pending_table_);
 
   // When the apart table was loading from the database file the current table
   // have been cleared.
@@ -914,25 +961,6 @@ bool VisitedLinkMaster::CreateApartURLTable(
   return true;
 }
 
-bool VisitedLinkMaster::BeginReplaceURLTable(int32_t num_entries) {
-  base::SharedMemory *old_shared_memory = shared_memory_;
-  Fingerprint* old_hash_table = hash_table_;
-  int32_t old_table_length = table_length_;
-  if (!CreateURLTable(num_entries)) {
-    // Try to put back the old state.
-    shared_memory_ = old_shared_memory;
-    hash_table_ = old_hash_table;
-    table_length_ = old_table_length;
-    return false;
-  }
-
-#ifndef NDEBUG
-  DebugValidate();
-#endif
-
-  return true;
-}
-
 void VisitedLinkMaster::FreeURLTable() {
   if (shared_memory_) {
     delete shared_memory_;
@@ -955,7 +983,18 @@ bool VisitedLinkMaster::ResizeTableIfNecessary() {
   const float max_table_load = 0.5f;  // Grow when we're > this full.
   const float min_table_load = 0.2f;  // Shrink when we're < this full.
 
+  // While the table is being resized incrementally, it keeps filling up. If
+  // the resize can't keep up, finish it now and see if we must grow again.
+  const float max_table_load_while_resizing = 0.75f;
+
   float load = ComputeTableLoad();
+  if (pending_table_) {
+    if (load < max_table_load_while_resizing)
+      return false;
+    FinishPendingResize();
+    load = ComputeTableLoad();
+  }
+
   if (load < max_table_load &&
       (table_length_ <= static_cast<float>(kDefaultTableSize) ||
        load > min_table_load))
@@ -965,35 +1004,95 @@ bool VisitedLinkMaster::ResizeTableIfNecessary() {
   int new_size = NewTableSizeForCount(used_items_);
   DCHECK(new_size > used_items_);
   DCHECK(load <= min_table_load || new_size > table_length_);
-  ResizeTable(new_size);
+
+  // Shrinking follows deletions, which reset the child processes anyway.
+  if (new_size < table_length_ || table_length_ <= kResizeEntriesPerTask) {
+    ResizeTable(new_size);
+    return true;
+  }
+
+  if (StartResize(new_size))
+    ContinuePendingResize();
   return true;
 }
 
 void VisitedLinkMaster::ResizeTable(int32_t new_size) {
   DCHECK(shared_memory_ && shared_memory_->memory() && hash_table_);
+  CancelPendingResize();
+  if (StartResize(new_size))
+    FinishPendingResize();
+}
+
+bool VisitedLinkMaster::StartResize(int32_t new_size) {
+  DCHECK(!pending_table_);
   shared_memory_serial_++;
 
 #ifndef NDEBUG
   DebugValidate();
 #endif
 
-  base::SharedMemory* old_shared_memory = shared_memory_;
-  Fingerprint* old_hash_table = hash_table_;
-  int32_t old_table_length = table_length_;
-  if (!BeginReplaceURLTable(new_size))
-    return;
+  std::unique_ptr<PendingTable> pending_table(new PendingTable);
+  if (!CreateApartURLTable(new_size, salt_, &pending_table->shared_memory,
+                           &pending_table->hash_table)) {
+    return false;
+  }
+  pending_table->table_length = new_size;
+  pending_table_ = std::move(pending_table);
+  return true;
+}
 
-  // Now we have two tables, our local copy which is the old one, and the new
-  // one loaded into this object where we need to copy the data.
-  for (int32_t i = 0; i < old_table_length; i++) {
-    Fingerprint cur = old_hash_table[i];
+void VisitedLinkMaster::AddFingerprintToPendingTable(Fingerprint fingerprint) {
+  Fingerprint* hash_table = pending_table_->hash_table;
+  int32_t table_length = pending_table_->table_length;
+
+  // See AddFingerprint, which this must stay in sync with. The new table is
+  // bigger than the current one, so it can't be full.
+  Hash cur_hash = HashFingerprint(fingerprint, table_length);
+  while (hash_table[cur_hash] != null_fingerprint_) {
+    if (hash_table[cur_hash] == fingerprint)
+      return;
+    cur_hash = cur_hash >= table_length - 1 ? 0 : cur_hash + 1;
+  }
+  hash_table[cur_hash] = fingerprint;
+  pending_table_->used_items++;
+}
+
+void VisitedLinkMaster::CopyToPendingTable(int32_t end_slot) {
+  for (int32_t i = pending_table_->next_slot; i < end_slot; i++) {
+    Fingerprint cur = hash_table_[i];
     if (cur)
-      AddFingerprint(cur, false);
+      AddFingerprintToPendingTable(cur);
+  }
+  pending_table_->next_slot = end_slot;
+}
+
+void VisitedLinkMaster::ContinuePendingResize() {
+  DCHECK(pending_table_);
+  CopyToPendingTable(std::min(table_length_,
+                              pending_table_->next_slot +
+                                  kResizeEntriesPerTask));
+  if (pending_table_->next_slot < table_length_) {
+    BrowserThread::PostTask(
+        BrowserThread::UI, FROM_HERE,
+        base::Bind(&VisitedLinkMaster::ContinuePendingResize,
+                   resize_weak_ptr_factory_.GetWeakPtr()));
+    return;
   }
+  FinishPendingResize();
+}
+
+void VisitedLinkMaster::FinishPendingResize() {
+  DCHECK(pending_table_);
+  CopyToPendingTable(table_length_);
+  DCHECK_EQ(used_items_, pending_table_->used_items);
 
   // On error unmapping, just forget about it since we can't do anything
   // else to release it.
-  delete old_shared_memory;
+  delete shared_memory_;
+  shared_memory_ = pending_table_->shared_memory.release();
+  hash_table_ = pending_table_->hash_table;
+  table_length_ = pending_table_->table_length;
+  CancelPendingResize();
 
   // Send an update notification to all child processes so they read the new
   // table.
@@ -1003,11 +1102,17 @@ void VisitedLinkMaster::ResizeTable(int32_t new_size) {
   DebugValidate();
 #endif
 
-  // The new table needs to be written to disk.
-  if (persist_to_disk_)
+  // The new table needs to be written to disk, unless we are rebuilding, in
+  // which case it will be written once the rebuild is complete.
+  if (persist_to_disk_ && !table_builder_.get())
     WriteFullTable();
 }
 
+void VisitedLinkMaster::CancelPendingResize() {
+  pending_table_.reset();
+  resize_weak_ptr_factory_.InvalidateWeakPtrs();
+}
+
 uint32_t VisitedLinkMaster::DefaultTableSize() const {
   if (table_size_override_)
     return table_size_override_;
@@ -1057,52 +1162,39 @@ bool VisitedLinkMaster::RebuildTableFromDelegate() {
   return true;
 }
 
+// See the TableBuilder declaration above for how this works.
+void VisitedLinkMaster::OnTableRebuildProgress(
+    const std::vector<Fingerprint>& fingerprints) {
+  AddRebuiltFingerprints(fingerprints);
+
+  // Let the child processes color the links found so far.
+  listener_->Reset(false);
+}
+
 // See the TableBuilder declaration above for how this works.
 void VisitedLinkMaster::OnTableRebuildComplete(
     bool success,
     const std::vector<Fingerprint>& fingerprints) {
   if (success) {
-    // Replace the old table with a new blank one.
-    shared_memory_serial_++;
-
-    // We are responsible for freeing it AFTER it has been replaced if
-    // replacement succeeds.
-    base::SharedMemory* old_shared_memory = shared_memory_;
-
-    int new_table_size = NewTableSizeForCount(
-        static_cast<int>(fingerprints.size() + added_since_rebuild_.size()));
-    if (BeginReplaceURLTable(new_table_size)) {
-      // Free the old table.
-      delete old_shared_memory;
-
-      // Add the stored fingerprints to the hash table.
-      for (const auto& fingerprint : fingerprints)
-        AddFingerprint(fingerprint, false);
-
-      // Also add anything that was added while we were asynchronously
-      // generating the new table.
-      for (const auto& fingerprint : added_since_rebuild_)
-        AddFingerprint(fingerprint, false);
-      added_since_rebuild_.clear();
-
-      // Now handle deletions. Do not shrink the table now, we'll shrink it when
-      // adding or deleting an url the next time.
-      for (const auto& fingerprint : deleted_since_rebuild_)
-        DeleteFingerprint(fingerprint, false);
-      deleted_since_rebuild_.clear();
-
-      // Send an update notification to all child processes.
-      listener_->NewTable(shared_memory_);
-      // All tabs which was loaded when table was being rebuilt
-      // invalidate their links again.
-      listener_->Reset(false);
-
-      if (persist_to_disk_)
-        WriteFullTable();
-    }
+    AddRebuiltFingerprints(fingerprints);
+
+    // Also add anything that was added while we were asynchronously
+    // generating the new table and was dropped because the table was full.
+    AddRebuiltFingerprints(std::vector<Fingerprint>(
+        added_since_rebuild_.begin(), added_since_rebuild_.end()));
+    added_since_rebuild_.clear();
+    deleted_since_rebuild_.clear();
+
+    // All tabs which was loaded when table was being rebuilt
+    // invalidate their links again.
+    listener_->Reset(false);
   }
   table_builder_ = NULL;  // Will release our reference to the builder.
 
+  // A resize in progress writes the table once it's done.
+  if (success && persist_to_disk_ && !pending_table_)
+    WriteFullTable();
+
   // Notify the unit test that the rebuild is complete (will be NULL in prod.)
   if (!rebuild_complete_task_.is_null()) {
     rebuild_complete_task_.Run();
@@ -1110,6 +1202,17 @@ void VisitedLinkMaster::OnTableRebuildComplete(
   }
 }
 
+void VisitedLinkMaster::AddRebuiltFingerprints(
+    const std::vector<Fingerprint>& fingerprints) {
+  for (const auto& fingerprint : fingerprints) {
+    // The history may have been enumerated before these were deleted.
+    if (deleted_since_rebuild_.count(fingerprint))
+      continue;
+    if (AddFingerprint(fingerprint, false) != null_hash_)
+      ResizeTableIfNecessary();
+  }
+}
+
 void VisitedLinkMaster::WriteToFile(FILE** file,
                                     off_t offset,
                                     void* data,
@@ -1179,10 +1282,20 @@ void VisitedLinkMaster::TableBuilder::DisownMaster() {
 }
 
 void VisitedLinkMaster::TableBuilder::OnURL(const GURL& url) {
-  if (!url.is_empty()) {
-    fingerprints_.push_back(VisitedLinkMaster::ComputeURLFingerprint(
-        url.spec().data(), url.spec().length(), salt_));
-  }
+  if (url.is_empty())
+    return;
+
+  fingerprints_.push_back(VisitedLinkMaster::ComputeURLFingerprint(
+      url.spec().data(), url.spec().length(), salt_));
+  if (fingerprints_.size() < kRebuildBatchSize)
+    return;
+
+  Fingerprints fingerprints;
+  fingerprints.reserve(kRebuildBatchSize);
+  fingerprints.swap(fingerprints_);
+  BrowserThread::PostTask(
+      BrowserThread::UI, FROM_HERE,
+      base::Bind(&TableBuilder::OnFingerprintsMainThread, this, fingerprints));
 }
 
 void VisitedLinkMaster::TableBuilder::OnComplete(bool success) {
@@ -1196,6 +1309,12 @@ void VisitedLinkMaster::TableBuilder::OnComplete(bool success) {
       base::Bind(&TableBuilder::OnCompleteMainThread, this));
 }
 
+void VisitedLinkMaster::TableBuilder::OnFingerprintsMainThread(
+    const Fingerprints& fingerprints) {
+  if (master_)
+    master_->OnTableRebuildProgress(fingerprints);
+}
+
 void VisitedLinkMaster::TableBuilder::OnCompleteMainThread() {
   if (master_)
     master_->OnTableRebuildComplete(success_, fingerprints_);
@@ -170,6 +170,8 @@ class VisitedLinkMaster : public VisitedLinkCommon {
   FRIEND_TEST_ALL_PREFIXES(VisitedLinkTest, Delete);
   FRIEND_TEST_ALL_PREFIXES(VisitedLinkTest, BigDelete);
   FRIEND_TEST_ALL_PREFIXES(VisitedLinkTest, BigImport);
+  FRIEND_TEST_ALL_PREFIXES(VisitedLinkTest, IncrementalResizing);
+  FRIEND_TEST_ALL_PREFIXES(VisitedLinkTest, BigRebuild);
 
   // Keeps the result of loading the table from the database file to the UI
   // thread.
@@ -182,6 +184,9 @@ class VisitedLinkMaster : public VisitedLinkCommon {
   // Object to rebuild the table on the history thread (see the .cc file).
   class TableBuilder;
 
+  // The table that a resize in progress is filling (see the .cc file).
+  struct PendingTable;
+
   // Byte offsets of values in the header.
   static const int32_t kFileHeaderSignatureOffset;
   static const int32_t kFileHeaderVersionOffset;
@@ -206,6 +211,15 @@ class VisitedLinkMaster : public VisitedLinkCommon {
   // we will write the whole table to disk at once instead of individual items.
   static const size_t kBigDeleteThreshold;
 
+  // Growing a table with more entries than this is spread over several tasks
+  // on the main thread, copying this many entries of the old table per task,
+  // so that a large table doesn't block the main thread while it is rehashed.
+  static const int32_t kResizeEntriesPerTask;
+
+  // While rebuilding from history, the fingerprints are handed over from the
+  // history thread in batches of this size.
+  static const size_t kRebuildBatchSize;
+
   // Backend for the constructors initializing the members.
   void InitMembers();
 
@@ -290,9 +304,13 @@ class VisitedLinkMaster : public VisitedLinkCommon {
   // Called to add a fingerprint to the table. If |send_notifications| is true
   // and the item is added successfully, Listener::Add will be invoked.
   // Returns the index of the inserted fingerprint or null_hash_ if there was a
-  // duplicate and this item was skippped.
+  // duplicate and this item was skippped. If a resize is in progress, the
+  // fingerprint is also added to the new table once its slot has been copied.
   Hash AddFingerprint(Fingerprint fingerprint, bool send_notifications);
 
+  // Adds a fingerprint to the table that the resize in progress is filling.
+  void AddFingerprintToPendingTable(Fingerprint fingerprint);
+
   // Deletes all fingerprints from the given vector from the current hash table
   // and syncs it to disk if there are changes. This does not update the
   // deleted_since_rebuild_ list, the caller must update this itself if there
@@ -326,29 +344,42 @@ class VisitedLinkMaster : public VisitedLinkCommon {
       std::unique_ptr<base::SharedMemory>* shared_memory,
       VisitedLinkCommon::Fingerprint** hash_table);
 
-  // A wrapper for CreateURLTable, this will allocate a new table, initialized
-  // to empty. The caller is responsible for saving the shared memory pointer
-  // and handles before this call (they will be replaced with new ones) and
-  // releasing them later. This is designed for callers that make a new table
-  // and then copy values from the old table to the new one, then release the
-  // old table.
-  //
-  // Returns true on success. On failure, the old table will be restored. The
-  // caller should not attemp to release the pointer/handle in this case.
-  bool BeginReplaceURLTable(int32_t num_entries);
-
   // unallocates the Fingerprint table
   void FreeURLTable();
 
   // For growing the table. ResizeTableIfNecessary will check to see if the
-  // table should be resized and calls ResizeTable if needed. Returns true if
-  // we decided to resize the table.
+  // table should be resized and resizes it if needed, incrementally for large
+  // tables that grow. Returns true if we decided to resize the table, in
+  // which case the new table will be written to disk once it replaces the
+  // current one.
   bool ResizeTableIfNecessary();
 
   // Resizes the table (growing or shrinking) as necessary to accomodate the
-  // current count.
+  // current count. Unlike ResizeTableIfNecessary, this replaces the table
+  // before returning, dropping any resize in progress.
   void ResizeTable(int32_t new_size);
 
+  // Allocates the table that a resize to |new_size| entries fills. Returns
+  // false on failure, in which case the current table is left as it is.
+  bool StartResize(int32_t new_size);
+
+  // Copies the entries of the current table, up to but excluding |end_slot|,
+  // to the table that the resize in progress is filling.
+  void CopyToPendingTable(int32_t end_slot);
+
+  // Copies the next entries of the current table as part of an incremental
+  // resize, and posts a task to continue or replaces the table when done.
+  void ContinuePendingResize();
+
+  // Copies the remaining entries and replaces the current table with the one
+  // that the resize in progress has filled. Child processes are sent the new
+  // table, and it is written to disk unless we are rebuilding.
+  void FinishPendingResize();
+
+  // Drops the resize in progress, if any. The current table is complete, so
+  // nothing is lost.
+  void CancelPendingResize();
+
   // Returns the default table size. It can be overrided in unit tests.
   uint32_t DefaultTableSize() const;
 
@@ -370,13 +401,23 @@ class VisitedLinkMaster : public VisitedLinkCommon {
   // the database because something failed.
   bool RebuildTableFromDelegate();
 
+  // Callback that the table rebuilder uses for every batch of fingerprints it
+  // computes. They are added to the current table right away, so that child
+  // processes can color the links found so far without waiting for the whole
+  // history to be enumerated.
+  void OnTableRebuildProgress(const std::vector<Fingerprint>& fingerprints);
+
   // Callback that the table rebuilder uses when the rebuild is complete.
   // |success| is true if the fingerprint generation succeeded, in which case
-  // |fingerprints| will contain the computed fingerprints. On failure, there
-  // will be no fingerprints.
+  // |fingerprints| will contain the last computed fingerprints. On failure,
+  // there will be no fingerprints.
   void OnTableRebuildComplete(bool success,
                               const std::vector<Fingerprint>& fingerprints);
 
+  // Adds the |fingerprints| computed by the table rebuilder to the table,
+  // growing it as needed, except for the ones deleted since the rebuild began.
+  void AddRebuiltFingerprints(const std::vector<Fingerprint>& fingerprints);
+
   // Increases or decreases the given hash value by one, wrapping around as
   // necessary. Used for probing.
   inline Hash IncrementHash(Hash hash) {
@@ -444,6 +485,10 @@ class VisitedLinkMaster : public VisitedLinkCommon {
   // Number of non-empty items in the table, used to compute fullness.
   int32_t used_items_;
 
+  // When non-NULL, a resize is in progress and this is the table it is
+  // filling. The current table stays in use until this one replaces it.
+  std::unique_ptr<PendingTable> pending_table_;
+
   // We set this to true to avoid writing to the database file.
   bool table_is_loading_from_file_;
 
@@ -470,6 +515,10 @@ class VisitedLinkMaster : public VisitedLinkCommon {
   // will be false in production.
   bool suppress_rebuild_;
 
+  // Vends the pointers that the tasks of an incremental resize are bound to,
+  // so that they can be canceled along with the resize.
+  base::WeakPtrFactory<VisitedLinkMaster> resize_weak_ptr_factory_;
+
   base::WeakPtrFactory<VisitedLinkMaster> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(VisitedLinkMaster);
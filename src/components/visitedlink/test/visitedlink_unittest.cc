@@ -421,6 +421,55 @@ TEST_F(VisitedLinkTest, Resizing) {
   Reload();
 }
 
+// Tests that large tables grow over several tasks, during which the old table
+// stays in use, and that the URLs added meanwhile make it to the new table.
+TEST_F(VisitedLinkTest, IncrementalResizing) {
+  const int32_t initial_size = VisitedLinkMaster::kResizeEntriesPerTask * 2 + 1;
+  ASSERT_TRUE(InitVisited(initial_size, true, true));
+
+  VisitedLinkSlave slave;
+  base::SharedMemoryHandle new_handle = base::SharedMemory::NULLHandle();
+  master_->shared_memory()->ShareToProcess(
+      base::GetCurrentProcessHandle(), &new_handle);
+  slave.OnUpdateVisitedLinks(new_handle);
+  g_slaves.push_back(&slave);
+
+  // Fill the table up to the point where it has to grow.
+  int url_count = initial_size / 2 + 1;
+  for (int i = 0; i < url_count; i++)
+    master_->AddURL(TestURL(i));
+  ASSERT_TRUE(master_->pending_table_);
+
+  int32_t table_size;
+  VisitedLinkCommon::Fingerprint* table;
+  master_->GetUsageStatistics(&table_size, &table);
+  EXPECT_EQ(initial_size, table_size);
+
+  // Add some more while the new table is being filled.
+  for (int i = url_count; i < url_count + 100; i++)
+    master_->AddURL(TestURL(i));
+  url_count += 100;
+  for (int i = 0; i < url_count; i++)
+    ASSERT_TRUE(slave.IsVisited(TestURL(i))) << "URL " << i;
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(master_->pending_table_);
+  master_->GetUsageStatistics(&table_size, &table);
+  EXPECT_GT(table_size, initial_size);
+  EXPECT_EQ(url_count, master_->GetUsedCount());
+  master_->DebugValidate();
+
+  // The slave got the new table.
+  int32_t child_table_size;
+  VisitedLinkCommon::Fingerprint* child_table;
+  slave.GetUsageStatistics(&child_table_size, &child_table);
+  EXPECT_EQ(table_size, child_table_size);
+  for (int i = 0; i < url_count; i++)
+    ASSERT_TRUE(slave.IsVisited(TestURL(i))) << "URL " << i;
+
+  g_slaves.clear();
+}
+
 // Tests that if the database doesn't exist, it will be rebuilt from history.
 TEST_F(VisitedLinkTest, Rebuild) {
   // Add half of our URLs to history. This needs to be done before we
@@ -485,6 +534,32 @@ TEST_F(VisitedLinkTest, BigImport) {
   ASSERT_EQ(used_count, total_count);
 }
 
+// Tests that a history of several rebuild batches is added batch by batch,
+// growing the table as needed.
+TEST_F(VisitedLinkTest, BigRebuild) {
+  const int history_count =
+      static_cast<int>(VisitedLinkMaster::kRebuildBatchSize) * 2 + 1;
+  for (int i = 0; i < history_count; i++)
+    delegate_.AddURLForRebuild(TestURL(i));
+
+  ASSERT_TRUE(InitVisited(0, false, false));
+
+  base::RunLoop run_loop;
+  master_->set_rebuild_complete_task(run_loop.QuitClosure());
+  run_loop.Run();
+
+  EXPECT_EQ(history_count, master_->GetUsedCount());
+  for (int i = 0; i < history_count; i++)
+    ASSERT_TRUE(master_->IsVisited(TestURL(i))) << "URL " << i;
+  master_->DebugValidate();
+
+  // The links were reset after each of the two full batches, and once the
+  // rebuild was complete.
+  TrackingVisitedLinkEventListener* listener =
+      static_cast<TrackingVisitedLinkEventListener*>(master_->GetListener());
+  EXPECT_EQ(3, listener->reset_count());
+}
+
 TEST_F(VisitedLinkTest, Listener) {
   ASSERT_TRUE(InitVisited(0, true, true));
 
@@ -718,6 +718,13 @@ class ContentMainRunnerImpl : public ContentMainRunner {
     CHECK(base::i18n::InitializeICU());
 #endif  // OS_ANDROID
 
+#if defined(OS_LINUX) && ICU_UTIL_DATA_IMPL == ICU_UTIL_DATA_FILE
+    // Renderers forked from the zygote lay out text right away; have the ICU
+    // tables they need read in while the zygote is still idle.
+    if (process_type.empty() || process_type == switches::kZygoteProcess)
+      base::i18n::PrefetchHotIcuData();
+#endif
+
     base::StatisticsRecorder::Initialize();
 
 #if defined(V8_USE_EXTERNAL_STARTUP_DATA)
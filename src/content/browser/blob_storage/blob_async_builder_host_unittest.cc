@@ -9,9 +9,12 @@
 #include <string.h>
 
 #include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/logging.h"
 #include "base/memory/shared_memory.h"
 #include "base/run_loop.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "content/public/test/test_browser_thread_bundle.h"
 #include "storage/browser/blob/blob_data_builder.h"
 #include "storage/browser/blob/blob_data_handle.h"
@@ -76,6 +79,7 @@ class BlobAsyncBuilderHostTest : public testing::Test {
     request_called_ = false;
     requests_.clear();
     memory_handles_.clear();
+    files_.clear();
     host_.SetMemoryConstantsForTesting(kTestBlobStorageIPCThresholdBytes,
                                        kTestBlobStorageMaxSharedMemoryBytes,
                                        kTestBlobStorageMaxFileSizeBytes);
@@ -92,9 +96,12 @@ class BlobAsyncBuilderHostTest : public testing::Test {
       std::unique_ptr<std::vector<base::File>> files) {
     requests_ = std::move(*requests);
     memory_handles_ = std::move(*shared_memory_handles);
+    files_ = std::move(*files);
     request_called_ = true;
   }
 
+  void CancelCallback(IPCBlobCreationCancelCode code) { cancel_code_ = code; }
+
   BlobTransportResult BuildBlobAsync(
       const std::vector<DataElement>& descriptions,
       const std::set<std::string>& referenced_blob_uuids,
@@ -109,6 +116,8 @@ class BlobAsyncBuilderHostTest : public testing::Test {
     return host_.StartBuildingBlob(
         kBlobUUID, descriptions, memory_available, &context_,
         base::Bind(&BlobAsyncBuilderHostTest::RequestMemoryCallback,
+                   base::Unretained(this)),
+        base::Bind(&BlobAsyncBuilderHostTest::CancelCallback,
                    base::Unretained(this)));
   }
 
@@ -128,6 +137,7 @@ class BlobAsyncBuilderHostTest : public testing::Test {
   bool request_called_;
   std::vector<storage::BlobItemBytesRequest> requests_;
   std::vector<base::SharedMemoryHandle> memory_handles_;
+  std::vector<base::File> files_;
   std::set<std::string> completed_blob_uuid_set_;
 
   std::unique_ptr<BlobDataHandle> completed_blob_handle_;
@@ -267,6 +277,96 @@ TEST_F(BlobAsyncBuilderHostTest, TestMultipleSharedMemRequests) {
   EXPECT_EQ(expected, *blob_data);
 };
 
+TEST_F(BlobAsyncBuilderHostTest, TestFileRequests) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  context_.EnableDisk(temp_dir.path().AppendASCII("blobs"),
+                      base::ThreadTaskRunnerHandle::Get());
+  std::vector<DataElement> descriptions;
+  const size_t kSize = kTestBlobStorageMaxFileSizeBytes + 50;
+  AddMemoryItem(kSize, &descriptions);
+
+  // The blob doesn't fit in memory, so it is written to two files, which are
+  // created before the requests are sent.
+  EXPECT_EQ(BlobTransportResult::PENDING_RESPONSES,
+            BuildBlobAsync(descriptions, std::set<std::string>(), kSize - 1));
+  EXPECT_FALSE(request_called_);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(request_called_);
+  ASSERT_EQ(2u, requests_.size());
+  ASSERT_EQ(2u, files_.size());
+  EXPECT_TRUE(memory_handles_.empty());
+  EXPECT_EQ(BlobItemBytesRequest::CreateFileRequest(
+                0, 0, 0, kTestBlobStorageMaxFileSizeBytes, 0, 0),
+            requests_.at(0));
+  EXPECT_EQ(BlobItemBytesRequest::CreateFileRequest(
+                1, 0, kTestBlobStorageMaxFileSizeBytes, 50, 1, 0),
+            requests_.at(1));
+  EXPECT_EQ(kSize, context_.disk_usage());
+
+  char data[kSize];
+  PopulateBytes(data, kSize);
+  std::vector<BlobItemBytesResponse> responses;
+  for (const BlobItemBytesRequest& request : requests_) {
+    base::File& file = files_[request.handle_index];
+    ASSERT_EQ(static_cast<int>(request.size),
+              file.Write(request.handle_offset,
+                         data + request.renderer_item_offset, request.size));
+    base::File::Info info;
+    ASSERT_TRUE(file.GetInfo(&info));
+    responses.push_back(BlobItemBytesResponse(request.request_number));
+    responses.back().time_file_modified = info.last_modified;
+  }
+  files_.clear();
+
+  EXPECT_EQ(BlobTransportResult::DONE,
+            host_.OnMemoryResponses(kBlobUUID, responses, &context_));
+  EXPECT_EQ(0u, host_.blob_building_count());
+  std::unique_ptr<BlobDataHandle> blob_handle =
+      context_.GetBlobDataFromUUID(kBlobUUID);
+  EXPECT_FALSE(blob_handle->IsBroken());
+  std::unique_ptr<BlobDataSnapshot> blob_data = blob_handle->CreateSnapshot();
+  ASSERT_EQ(2u, blob_data->items().size());
+  base::FilePath first_path = blob_data->items()[0]->path();
+  EXPECT_EQ(DataElement::TYPE_FILE, blob_data->items()[0]->type());
+  EXPECT_EQ(kTestBlobStorageMaxFileSizeBytes,
+            blob_data->items()[0]->length());
+  EXPECT_EQ(DataElement::TYPE_FILE, blob_data->items()[1]->type());
+  EXPECT_EQ(50u, blob_data->items()[1]->length());
+  EXPECT_TRUE(temp_dir.path().IsParent(first_path));
+  EXPECT_EQ(0u, context_.memory_usage());
+
+  // Releasing the blob deletes its files.
+  blob_data.reset();
+  blob_handle.reset();
+  DecrementBlobRefCount(kBlobUUID);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0u, context_.disk_usage());
+  EXPECT_FALSE(base::PathExists(first_path));
+}
+
+TEST_F(BlobAsyncBuilderHostTest, TestFileCreationFailure) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  // A directory can't be created under a file.
+  base::FilePath file_path = temp_dir.path().AppendASCII("file");
+  ASSERT_EQ(1, base::WriteFile(file_path, "x", 1));
+  context_.EnableDisk(file_path.AppendASCII("blobs"),
+                      base::ThreadTaskRunnerHandle::Get());
+  std::vector<DataElement> descriptions;
+  AddMemoryItem(kTestBlobStorageMaxFileSizeBytes, &descriptions);
+
+  EXPECT_EQ(BlobTransportResult::PENDING_RESPONSES,
+            BuildBlobAsync(descriptions, std::set<std::string>(), 1));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(request_called_);
+  EXPECT_EQ(IPCBlobCreationCancelCode::FILE_WRITE_FAILED, cancel_code_);
+  EXPECT_EQ(0u, host_.blob_building_count());
+  std::unique_ptr<BlobDataHandle> blob_handle =
+      context_.GetBlobDataFromUUID(kBlobUUID);
+  EXPECT_TRUE(blob_handle->IsBroken());
+}
+
 TEST_F(BlobAsyncBuilderHostTest, TestBasicIPCAndStopBuilding) {
   std::vector<DataElement> descriptions;
 
@@ -345,6 +445,8 @@ TEST_F(BlobAsyncBuilderHostTest, TestBreakingAllBuilding) {
             host_.StartBuildingBlob(
                 kBlob1, descriptions, 2, &context_,
                 base::Bind(&BlobAsyncBuilderHostTest::RequestMemoryCallback,
+                           base::Unretained(this)),
+                base::Bind(&BlobAsyncBuilderHostTest::CancelCallback,
                            base::Unretained(this))));
   EXPECT_TRUE(request_called_);
 
@@ -462,6 +564,8 @@ TEST_F(BlobAsyncBuilderHostTest, WaitOnReferencedBlob) {
             host_.StartBuildingBlob(
                 kBlob3, descriptions, 2, &context_,
                 base::Bind(&BlobAsyncBuilderHostTest::RequestMemoryCallback,
+                           base::Unretained(this)),
+                base::Bind(&BlobAsyncBuilderHostTest::CancelCallback,
                            base::Unretained(this))));
   EXPECT_FALSE(request_called_);
   EXPECT_TRUE(host_.IsBeingBuilt(kBlob3));
@@ -474,6 +578,8 @@ TEST_F(BlobAsyncBuilderHostTest, WaitOnReferencedBlob) {
             host_.StartBuildingBlob(
                 kBlob1, descriptions, 2, &context_,
                 base::Bind(&BlobAsyncBuilderHostTest::RequestMemoryCallback,
+                           base::Unretained(this)),
+                base::Bind(&BlobAsyncBuilderHostTest::CancelCallback,
                            base::Unretained(this))));
   EXPECT_FALSE(request_called_);
   EXPECT_FALSE(host_.IsBeingBuilt(kBlob1));
@@ -491,6 +597,8 @@ TEST_F(BlobAsyncBuilderHostTest, WaitOnReferencedBlob) {
             host_.StartBuildingBlob(
                 kBlob2, descriptions, 2, &context_,
                 base::Bind(&BlobAsyncBuilderHostTest::RequestMemoryCallback,
+                           base::Unretained(this)),
+                base::Bind(&BlobAsyncBuilderHostTest::CancelCallback,
                            base::Unretained(this))));
   EXPECT_FALSE(request_called_);
   EXPECT_FALSE(host_.IsBeingBuilt(kBlob2));
@@ -536,6 +644,8 @@ TEST_F(BlobAsyncBuilderHostTest, IncorrectBlobDependencies) {
             host_.StartBuildingBlob(
                 kBlob2, descriptions, 2, &context_,
                 base::Bind(&BlobAsyncBuilderHostTest::RequestMemoryCallback,
+                           base::Unretained(this)),
+                base::Bind(&BlobAsyncBuilderHostTest::CancelCallback,
                            base::Unretained(this))));
   EXPECT_FALSE(host_.IsBeingBuilt(kBlob2));
 
@@ -549,6 +659,8 @@ TEST_F(BlobAsyncBuilderHostTest, IncorrectBlobDependencies) {
             host_.StartBuildingBlob(
                 kBlob3, descriptions, 2, &context_,
                 base::Bind(&BlobAsyncBuilderHostTest::RequestMemoryCallback,
+                           base::Unretained(this)),
+                base::Bind(&BlobAsyncBuilderHostTest::CancelCallback,
                            base::Unretained(this))));
   EXPECT_FALSE(host_.IsBeingBuilt(kBlob3));
 };
@@ -575,6 +687,8 @@ TEST_F(BlobAsyncBuilderHostTest, BlobBreaksWhenReferenceBreaks) {
             host_.StartBuildingBlob(
                 kBlob2, descriptions, 2, &context_,
                 base::Bind(&BlobAsyncBuilderHostTest::RequestMemoryCallback,
+                           base::Unretained(this)),
+                base::Bind(&BlobAsyncBuilderHostTest::CancelCallback,
                            base::Unretained(this))));
   EXPECT_FALSE(request_called_);
   EXPECT_TRUE(host_.IsBeingBuilt(kBlob2));
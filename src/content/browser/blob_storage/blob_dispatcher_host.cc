@@ -140,7 +140,9 @@ void BlobDispatcherHost::OnStartBuildingBlob(
   BlobTransportResult result = async_builder_.StartBuildingBlob(
       uuid, descriptions, context->memory_available(), context,
       base::Bind(&BlobDispatcherHost::SendMemoryRequest, base::Unretained(this),
-                 uuid));
+                 uuid),
+      base::Bind(&BlobDispatcherHost::SendCancelBuildingBlob,
+                 base::Unretained(this), uuid));
   SendIPCResponse(uuid, result);
 }
 
@@ -309,12 +311,19 @@ void BlobDispatcherHost::SendMemoryRequest(
     std::unique_ptr<std::vector<base::File>> files) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   std::vector<IPC::PlatformFileForTransit> file_handles;
-  // TODO(dmurph): Support file-backed blob transportation.
-  DCHECK(files->empty());
+  for (base::File& file : *files)
+    file_handles.push_back(IPC::TakePlatformFileForTransit(std::move(file)));
   Send(new BlobStorageMsg_RequestMemoryItem(uuid, *requests, *memory_handles,
                                             file_handles));
 }
 
+void BlobDispatcherHost::SendCancelBuildingBlob(
+    const std::string& uuid,
+    IPCBlobCreationCancelCode code) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  Send(new BlobStorageMsg_CancelBuildingBlob(uuid, code));
+}
+
 void BlobDispatcherHost::SendIPCResponse(const std::string& uuid,
                                          storage::BlobTransportResult result) {
   switch (result) {
@@ -122,6 +122,11 @@ class CONTENT_EXPORT BlobDispatcherHost : public BrowserMessageFilter {
       std::unique_ptr<std::vector<base::SharedMemoryHandle>> memory_handles,
       std::unique_ptr<std::vector<base::File>> files);
 
+  // Tells the renderer that the browser cancelled building the blob after
+  // the call that started it had returned.
+  void SendCancelBuildingBlob(const std::string& uuid,
+                              storage::IPCBlobCreationCancelCode code);
+
   // Send the appropriate IPC response to the renderer for the given result.
   void SendIPCResponse(const std::string& uuid,
                        storage::BlobTransportResult result);
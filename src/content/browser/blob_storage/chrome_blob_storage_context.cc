@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/files/file_path.h"
 #include "base/guid.h"
 #include "content/public/browser/blob_handle.h"
 #include "content/public/browser/browser_context.h"
@@ -23,6 +24,8 @@ namespace content {
 namespace {
 
 const char kBlobStorageContextKeyName[] = "content_blob_storage_context";
+const base::FilePath::CharType kBlobStorageDirectoryName[] =
+    FILE_PATH_LITERAL("blob_storage");
 
 class BlobHandleImpl : public BlobHandle {
  public:
@@ -49,11 +52,18 @@ ChromeBlobStorageContext* ChromeBlobStorageContext::GetFor(
     context->SetUserData(
         kBlobStorageContextKeyName,
         new UserDataAdapter<ChromeBlobStorageContext>(blob.get()));
+    // Blobs of incognito profiles are never written to disk.
+    base::FilePath blob_storage_dir;
+    if (!context->IsOffTheRecord() && !context->GetPath().empty())
+      blob_storage_dir = context->GetPath().Append(kBlobStorageDirectoryName);
     // Check first to avoid memory leak in unittests.
     if (BrowserThread::IsMessageLoopValid(BrowserThread::IO)) {
       BrowserThread::PostTask(
           BrowserThread::IO, FROM_HERE,
-          base::Bind(&ChromeBlobStorageContext::InitializeOnIOThread, blob));
+          base::Bind(&ChromeBlobStorageContext::InitializeOnIOThread, blob,
+                     blob_storage_dir,
+                     BrowserThread::GetMessageLoopProxyForThread(
+                         BrowserThread::FILE)));
     }
   }
 
@@ -61,9 +71,13 @@ ChromeBlobStorageContext* ChromeBlobStorageContext::GetFor(
       context, kBlobStorageContextKeyName);
 }
 
-void ChromeBlobStorageContext::InitializeOnIOThread() {
+void ChromeBlobStorageContext::InitializeOnIOThread(
+    const base::FilePath& blob_storage_dir,
+    scoped_refptr<base::SequencedTaskRunner> file_runner) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   context_.reset(new BlobStorageContext());
+  if (!blob_storage_dir.empty())
+    context_->EnableDisk(blob_storage_dir, std::move(file_runner));
 }
 
 std::unique_ptr<BlobHandle> ChromeBlobStorageContext::CreateMemoryBackedBlob(
@@ -16,6 +16,7 @@
 
 namespace base {
 class FilePath;
+class SequencedTaskRunner;
 class Time;
 }
 
@@ -44,7 +45,11 @@ class CONTENT_EXPORT ChromeBlobStorageContext
   static ChromeBlobStorageContext* GetFor(
       BrowserContext* browser_context);
 
-  void InitializeOnIOThread();
+  // Blobs are paged to |blob_storage_dir| on |file_runner| while they are
+  // transported, unless |blob_storage_dir| is empty.
+  void InitializeOnIOThread(
+      const base::FilePath& blob_storage_dir,
+      scoped_refptr<base::SequencedTaskRunner> file_runner);
 
   storage::BlobStorageContext* context() const { return context_.get(); }
 
@@ -30,6 +30,7 @@
 #include "content/public/browser/blob_handle.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/content_browser_client.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/site_instance.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/common/mojo_shell_connection.h"
@@ -330,6 +331,9 @@ void BrowserContext::NotifyWillBeDestroyed(BrowserContext* browser_context) {
   // render process hosts die before their profile (browser context) dies.
   ForEachStoragePartition(browser_context,
                           base::Bind(ShutdownServiceWorkerContext));
+
+  // Spare renderer processes would likewise outlive the browser context.
+  RenderProcessHost::DiscardSpareRenderProcessHosts();
 }
 
 void BrowserContext::EnsureResourceContextInitialized(BrowserContext* context) {
@@ -20,6 +20,7 @@
 #include "base/memory/ptr_util.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/metrics/user_metrics.h"
 #include "base/pending_task.h"
 #include "base/power_monitor/power_monitor.h"
@@ -34,6 +35,7 @@
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/timer/hi_res_timer_manager.h"
 #include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/native_sampling_profiler.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "components/tracing/browser/trace_config_file.h"
@@ -146,6 +148,8 @@
 #if defined(OS_CHROMEOS)
 #include "base/memory/memory_pressure_monitor_chromeos.h"
 #include "chromeos/chromeos_switches.h"
+#elif defined(OS_LINUX)
+#include "base/memory/memory_pressure_monitor_linux.h"
 #endif
 
 #if defined(USE_GLIB)
@@ -450,6 +454,7 @@ void BrowserMainLoop::Init() {
 
 void BrowserMainLoop::EarlyInitialization() {
   TRACE_EVENT0("startup", "BrowserMainLoop::EarlyInitialization");
+  SCOPED_UMA_HISTOGRAM_TIMER("Startup.BrowserMainLoop.EarlyInitialization");
 
 #if defined(OS_POSIX) && !defined(OS_MACOSX) && !defined(OS_ANDROID)
   // No thread should be created before this call, as SetupSandbox()
@@ -522,6 +527,7 @@ void BrowserMainLoop::EarlyInitialization() {
 }
 
 void BrowserMainLoop::PreMainMessageLoopStart() {
+  SCOPED_UMA_HISTOGRAM_TIMER("Startup.BrowserMainLoop.PreMainMessageLoopStart");
   if (parts_) {
     TRACE_EVENT0("startup",
         "BrowserMainLoop::MainMessageLoopStart:PreMainMessageLoopStart");
@@ -543,6 +549,7 @@ void BrowserMainLoop::MainMessageLoopStart() {
   // PostMainMessageLoopStart() below.
 
   TRACE_EVENT0("startup", "BrowserMainLoop::MainMessageLoopStart");
+  SCOPED_UMA_HISTOGRAM_TIMER("Startup.BrowserMainLoop.MainMessageLoopStart");
 
   // Create a MessageLoop if one does not already exist for the current thread.
   if (!base::MessageLoop::current())
@@ -552,6 +559,8 @@ void BrowserMainLoop::MainMessageLoopStart() {
 }
 
 void BrowserMainLoop::PostMainMessageLoopStart() {
+  SCOPED_UMA_HISTOGRAM_TIMER(
+      "Startup.BrowserMainLoop.PostMainMessageLoopStart");
   {
     TRACE_EVENT0("startup", "BrowserMainLoop::Subsystem:SystemMonitor");
     system_monitor_.reset(new base::SystemMonitor);
@@ -593,6 +602,12 @@ void BrowserMainLoop::PostMainMessageLoopStart() {
             base::ThreadTaskRunnerHandle::Get()));
   }
 
+  {
+    // Lets the "cpu_profiler" tracing category sample the UI thread.
+    base::trace_event::NativeSamplingProfiler::GetInstance()
+        ->RegisterCurrentThread();
+  }
+
   {
     base::SetRecordActionTaskRunner(
         BrowserThread::GetMessageLoopProxyForThread(BrowserThread::UI));
@@ -705,6 +720,7 @@ void BrowserMainLoop::PostMainMessageLoopStart() {
 }
 
 int BrowserMainLoop::PreCreateThreads() {
+  SCOPED_UMA_HISTOGRAM_TIMER("Startup.BrowserMainLoop.PreCreateThreads");
   if (parts_) {
     TRACE_EVENT0("startup",
         "BrowserMainLoop::CreateThreads:PreCreateThreads");
@@ -732,6 +748,8 @@ int BrowserMainLoop::PreCreateThreads() {
 #elif defined(OS_WIN)
   memory_pressure_monitor_.reset(CreateWinMemoryPressureMonitor(
       parsed_command_line_));
+#elif defined(OS_LINUX)
+  memory_pressure_monitor_.reset(new base::MemoryPressureMonitorLinux());
 #endif
 
 #if defined(ENABLE_PLUGINS)
@@ -826,6 +844,7 @@ void BrowserMainLoop::CreateStartupTasks() {
 
 int BrowserMainLoop::CreateThreads() {
   TRACE_EVENT0("startup", "BrowserMainLoop::CreateThreads");
+  SCOPED_UMA_HISTOGRAM_TIMER("Startup.BrowserMainLoop.CreateThreads");
 
   base::Thread::Options io_message_loop_options;
   io_message_loop_options.message_loop_type = base::MessageLoop::TYPE_IO;
@@ -926,6 +945,7 @@ int BrowserMainLoop::CreateThreads() {
 }
 
 int BrowserMainLoop::PreMainMessageLoopRun() {
+  SCOPED_UMA_HISTOGRAM_TIMER("Startup.BrowserMainLoop.PreMainMessageLoopRun");
   if (parts_) {
     TRACE_EVENT0("startup",
         "BrowserMainLoop::CreateThreads:PreMainMessageLoopRun");
@@ -1167,6 +1187,7 @@ void BrowserMainLoop::InitializeMainThread() {
 
 int BrowserMainLoop::BrowserThreadsStarted() {
   TRACE_EVENT0("startup", "BrowserMainLoop::BrowserThreadsStarted");
+  SCOPED_UMA_HISTOGRAM_TIMER("Startup.BrowserMainLoop.BrowserThreadsStarted");
 
   // Bring up Mojo IPC and shell as early as possible.
 
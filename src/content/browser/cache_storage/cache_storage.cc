@@ -293,6 +293,8 @@ class CacheStorage::SimpleCacheLoader : public CacheStorage::CacheLoader {
       const BoolCallback& callback,
       scoped_refptr<base::SingleThreadTaskRunner> original_task_runner) {
     bool rv = base::DeleteFile(cache_path, true);
+    base::DeleteFile(CacheStorageCache::GetRequestIndexPath(cache_path),
+                     false /* recursive */);
     original_task_runner->PostTask(FROM_HERE, base::Bind(callback, rv));
   }
 
@@ -390,7 +392,8 @@ class CacheStorage::SimpleCacheLoader : public CacheStorage::CacheLoader {
   ~SimpleCacheLoader() override {}
 
   // Iterates over the caches and deletes any directory not found in
-  // |cache_dirs|. Runs on cache_task_runner_
+  // |cache_dirs|, along with any request index left behind by such a cache.
+  // Runs on cache_task_runner_
   static void DeleteUnreferencedCachesInPool(
       const base::FilePath& cache_base_dir,
       std::unique_ptr<std::set<std::string>> cache_dirs) {
@@ -405,6 +408,17 @@ class CacheStorage::SimpleCacheLoader : public CacheStorage::CacheLoader {
 
     for (const base::FilePath& cache_path : dirs_to_delete)
       base::DeleteFile(cache_path, true /* recursive */);
+
+    base::FileEnumerator index_enum(
+        cache_base_dir, false /* recursive */, base::FileEnumerator::FILES,
+        CacheStorageCache::GetRequestIndexPath(base::FilePath(
+            FILE_PATH_LITERAL("*"))).value());
+    base::FilePath index_path;
+    while (!(index_path = index_enum.Next()).empty()) {
+      if (!ContainsKey(*cache_dirs,
+                       index_path.BaseName().RemoveExtension().AsUTF8Unsafe()))
+        base::DeleteFile(index_path, false /* recursive */);
+    }
   }
 
   // Runs on cache_task_runner_
@@ -10,11 +10,14 @@
 
 #include "base/barrier_closure.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/guid.h"
 #include "base/macros.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "base/task_runner_util.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/browser/cache_storage/cache_storage.pb.h"
 #include "content/browser/cache_storage/cache_storage_blob_to_disk_cache.h"
@@ -63,6 +66,9 @@ typedef base::Callback<void(std::unique_ptr<CacheMetadata>)> MetadataCallback;
 // is controlled per-origin by the QuotaManager.
 const int kMaxCacheBytes = std::numeric_limits<int>::max();
 
+const base::FilePath::CharType kRequestIndexExtension[] =
+    FILE_PATH_LITERAL("index");
+
 blink::WebServiceWorkerResponseType ProtoResponseTypeToWebResponseType(
     CacheResponse::ResponseType response_type) {
   switch (response_type) {
@@ -185,6 +191,47 @@ void ReadMetadataDidReadMetadata(disk_cache::Entry* entry,
   callback.Run(std::move(metadata));
 }
 
+void PopulateRequestMetadata(const ServiceWorkerFetchRequest& request,
+                             CacheRequest* request_metadata) {
+  request_metadata->set_method(request.method);
+  for (ServiceWorkerHeaderMap::const_iterator it = request.headers.begin();
+       it != request.headers.end(); ++it) {
+    DCHECK_EQ(std::string::npos, it->first.find('\0'));
+    DCHECK_EQ(std::string::npos, it->second.find('\0'));
+    CacheHeaderMap* header_map = request_metadata->add_headers();
+    header_map->set_name(it->first);
+    header_map->set_value(it->second);
+  }
+}
+
+// Returns null if there is no index at |index_path| or it can't be parsed.
+// Runs on the cache thread.
+std::unique_ptr<CacheRequestIndex> ReadRequestIndexFile(
+    const base::FilePath& index_path) {
+  std::string body;
+  if (!base::ReadFileToString(index_path, &body))
+    return std::unique_ptr<CacheRequestIndex>();
+
+  std::unique_ptr<CacheRequestIndex> index(new CacheRequestIndex);
+  if (!index->ParseFromString(body))
+    return std::unique_ptr<CacheRequestIndex>();
+  return index;
+}
+
+// Runs on the cache thread.
+void WriteRequestIndexFile(const base::FilePath& index_path,
+                           const std::string& data) {
+  base::FilePath tmp_path = index_path.AddExtension(FILE_PATH_LITERAL("tmp"));
+  int bytes_written = base::WriteFile(tmp_path, data.c_str(), data.size());
+  if (bytes_written != base::checked_cast<int>(data.size())) {
+    base::DeleteFile(tmp_path, /* recursive */ false);
+    return;
+  }
+
+  // Atomically rename the temporary index file to become the real one.
+  base::ReplaceFile(tmp_path, index_path, nullptr);
+}
+
 }  // namespace
 
 // The state needed to iterate all entries in the cache.
@@ -233,30 +280,30 @@ struct CacheStorageCache::MatchAllContext {
   std::unique_ptr<Responses> out_responses;
   std::unique_ptr<BlobDataHandles> out_blob_data_handles;
 
-  // The context holding open entries.
-  std::unique_ptr<OpenAllEntriesContext> entries_context;
+  // The keys of the entries that match the request, taken from the request
+  // index.
+  EntryKeys keys;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(MatchAllContext);
 };
 
-// The state needed to pass between CacheStorageCache::Keys callbacks.
-struct CacheStorageCache::KeysContext {
-  explicit KeysContext(const CacheStorageCache::RequestsCallback& callback)
-      : original_callback(callback), out_keys(new Requests()) {}
-  ~KeysContext() {}
+// The state needed to build the request index from the entries.
+struct CacheStorageCache::BuildRequestIndexContext {
+  explicit BuildRequestIndexContext(const ErrorCallback& callback)
+      : callback(callback), index(new RequestIndex) {}
+  ~BuildRequestIndexContext() {}
 
-  // The callback passed to the Keys() function.
-  RequestsCallback original_callback;
+  // The callback passed to LoadRequestIndex().
+  ErrorCallback callback;
 
-  // The output of the Keys function.
-  std::unique_ptr<Requests> out_keys;
+  std::unique_ptr<RequestIndex> index;
 
   // The context holding open entries.
   std::unique_ptr<OpenAllEntriesContext> entries_context;
 
  private:
-  DISALLOW_COPY_AND_ASSIGN(KeysContext);
+  DISALLOW_COPY_AND_ASSIGN(BuildRequestIndexContext);
 };
 
 // The state needed to pass between CacheStorageCache::Put callbacks.
@@ -314,6 +361,12 @@ base::WeakPtr<CacheStorageCache> CacheStorageCache::AsWeakPtr() {
   return weak_ptr_factory_.GetWeakPtr();
 }
 
+// static
+base::FilePath CacheStorageCache::GetRequestIndexPath(
+    const base::FilePath& cache_path) {
+  return cache_path.AddExtension(kRequestIndexExtension);
+}
+
 void CacheStorageCache::Match(
     std::unique_ptr<ServiceWorkerFetchRequest> request,
     const ResponseCallback& callback) {
@@ -538,6 +591,10 @@ void CacheStorageCache::GetSizeThenClose(const SizeCallback& callback) {
 }
 
 CacheStorageCache::~CacheStorageCache() {
+  // Caches are usually destroyed, rather than closed, once they are no longer
+  // referenced.
+  if (backend_state_ == BACKEND_OPEN)
+    SaveRequestIndex();
   quota_manager_proxy_->NotifyOriginNoLongerInUse(origin_);
 }
 
@@ -635,6 +692,144 @@ void CacheStorageCache::DidOpenNextEntry(
     open_entry_callback.Run(rv);
 }
 
+void CacheStorageCache::LoadRequestIndex(const ErrorCallback& callback) {
+  if (request_index_) {
+    callback.Run(CACHE_STORAGE_OK);
+    return;
+  }
+
+  if (memory_only_) {
+    LoadRequestIndexDidReadFile(callback,
+                                std::unique_ptr<CacheRequestIndex>());
+    return;
+  }
+
+  PostTaskAndReplyWithResult(
+      BrowserThread::GetMessageLoopProxyForThread(BrowserThread::CACHE).get(),
+      FROM_HERE, base::Bind(&ReadRequestIndexFile, GetRequestIndexPath(path_)),
+      base::Bind(&CacheStorageCache::LoadRequestIndexDidReadFile,
+                 weak_ptr_factory_.GetWeakPtr(), callback));
+}
+
+void CacheStorageCache::LoadRequestIndexDidReadFile(
+    const ErrorCallback& callback,
+    std::unique_ptr<CacheRequestIndex> index) {
+  if (backend_state_ != BACKEND_OPEN) {
+    callback.Run(CACHE_STORAGE_ERROR_STORAGE);
+    return;
+  }
+
+  // The file is only kept while nothing has changed since it was written, but
+  // entries left over from a session that ended abruptly are caught by the
+  // count check.
+  if (index && request_index_file_current_ &&
+      index->entry_size() == backend_->GetEntryCount()) {
+    request_index_.reset(new RequestIndex);
+    for (const CacheRequestIndex::Entry& entry : index->entry())
+      (*request_index_)[entry.key()] = entry.request();
+    callback.Run(CACHE_STORAGE_OK);
+    return;
+  }
+
+  InvalidateRequestIndexFile();
+
+  std::unique_ptr<BuildRequestIndexContext> context(
+      new BuildRequestIndexContext(callback));
+  OpenAllEntries(
+      base::Bind(&CacheStorageCache::BuildRequestIndexDidOpenAllEntries,
+                 weak_ptr_factory_.GetWeakPtr(),
+                 base::Passed(std::move(context))));
+}
+
+void CacheStorageCache::BuildRequestIndexDidOpenAllEntries(
+    std::unique_ptr<BuildRequestIndexContext> context,
+    std::unique_ptr<OpenAllEntriesContext> entries_context,
+    CacheStorageError error) {
+  if (error != CACHE_STORAGE_OK) {
+    context->callback.Run(error);
+    return;
+  }
+
+  context->entries_context.swap(entries_context);
+  Entries::iterator iter = context->entries_context->entries.begin();
+  BuildRequestIndexProcessNextEntry(std::move(context), iter);
+}
+
+void CacheStorageCache::BuildRequestIndexProcessNextEntry(
+    std::unique_ptr<BuildRequestIndexContext> context,
+    const Entries::iterator& iter) {
+  if (iter == context->entries_context->entries.end()) {
+    request_index_ = std::move(context->index);
+    context->callback.Run(CACHE_STORAGE_OK);
+    return;
+  }
+
+  ReadMetadata(*iter,
+               base::Bind(&CacheStorageCache::BuildRequestIndexDidReadMetadata,
+                          weak_ptr_factory_.GetWeakPtr(),
+                          base::Passed(std::move(context)), iter));
+}
+
+void CacheStorageCache::BuildRequestIndexDidReadMetadata(
+    std::unique_ptr<BuildRequestIndexContext> context,
+    const Entries::iterator& iter,
+    std::unique_ptr<CacheMetadata> metadata) {
+  disk_cache::Entry* entry = *iter;
+
+  if (metadata)
+    (*context->index)[entry->GetKey()] = metadata->request();
+  else
+    entry->Doom();
+
+  BuildRequestIndexProcessNextEntry(std::move(context), iter + 1);
+}
+
+void CacheStorageCache::AddToRequestIndex(
+    const ServiceWorkerFetchRequest& request) {
+  InvalidateRequestIndexFile();
+  if (request_index_)
+    PopulateRequestMetadata(request, &(*request_index_)[request.url.spec()]);
+}
+
+void CacheStorageCache::RemoveFromRequestIndex(const std::string& key) {
+  InvalidateRequestIndexFile();
+  if (request_index_)
+    request_index_->erase(key);
+}
+
+void CacheStorageCache::InvalidateRequestIndexFile() {
+  if (memory_only_ || !request_index_file_current_)
+    return;
+
+  request_index_file_current_ = false;
+  BrowserThread::PostTask(
+      BrowserThread::CACHE, FROM_HERE,
+      base::Bind(base::IgnoreResult(&base::DeleteFile),
+                 GetRequestIndexPath(path_), false /* recursive */));
+}
+
+void CacheStorageCache::SaveRequestIndex() {
+  if (memory_only_ || !request_index_ || request_index_file_current_)
+    return;
+
+  CacheRequestIndex index;
+  for (const auto& key_and_request : *request_index_) {
+    CacheRequestIndex::Entry* entry = index.add_entry();
+    entry->set_key(key_and_request.first);
+    *entry->mutable_request() = key_and_request.second;
+  }
+
+  std::string serialized;
+  if (!index.SerializeToString(&serialized))
+    return;
+
+  request_index_file_current_ = true;
+  BrowserThread::PostTask(
+      BrowserThread::CACHE, FROM_HERE,
+      base::Bind(&WriteRequestIndexFile, GetRequestIndexPath(path_),
+                 serialized));
+}
+
 void CacheStorageCache::MatchImpl(
     std::unique_ptr<ServiceWorkerFetchRequest> request,
     const ResponseCallback& callback) {
@@ -742,14 +937,13 @@ void CacheStorageCache::MatchAllImpl(std::unique_ptr<MatchAllContext> context) {
     return;
   }
 
-  OpenAllEntries(base::Bind(&CacheStorageCache::MatchAllDidOpenAllEntries,
-                            weak_ptr_factory_.GetWeakPtr(),
-                            base::Passed(std::move(context))));
+  LoadRequestIndex(base::Bind(&CacheStorageCache::MatchAllDidLoadRequestIndex,
+                              weak_ptr_factory_.GetWeakPtr(),
+                              base::Passed(std::move(context))));
 }
 
-void CacheStorageCache::MatchAllDidOpenAllEntries(
+void CacheStorageCache::MatchAllDidLoadRequestIndex(
     std::unique_ptr<MatchAllContext> context,
-    std::unique_ptr<OpenAllEntriesContext> entries_context,
     CacheStorageError error) {
   if (error != CACHE_STORAGE_OK) {
     context->original_callback.Run(error, std::unique_ptr<Responses>(),
@@ -757,15 +951,29 @@ void CacheStorageCache::MatchAllDidOpenAllEntries(
     return;
   }
 
-  context->entries_context.swap(entries_context);
-  Entries::iterator iter = context->entries_context->entries.begin();
+  // Only the matching entries are opened.
+  GURL request_url_without_query;
+  if (context->options.ignore_search) {
+    DCHECK(context->request);
+    request_url_without_query = RemoveQueryParam(context->request->url);
+  }
+  for (const auto& key_and_request : *request_index_) {
+    if (context->options.ignore_search &&
+        request_url_without_query !=
+            RemoveQueryParam(GURL(key_and_request.first))) {
+      continue;
+    }
+    context->keys.push_back(key_and_request.first);
+  }
+
+  EntryKeys::const_iterator iter = context->keys.begin();
   MatchAllProcessNextEntry(std::move(context), iter);
 }
 
 void CacheStorageCache::MatchAllProcessNextEntry(
     std::unique_ptr<MatchAllContext> context,
-    const Entries::iterator& iter) {
-  if (iter == context->entries_context->entries.end()) {
+    const EntryKeys::const_iterator& iter) {
+  if (iter == context->keys.end()) {
     // All done. Return all of the responses.
     context->original_callback.Run(CACHE_STORAGE_OK,
                                    std::move(context->out_responses),
@@ -773,32 +981,49 @@ void CacheStorageCache::MatchAllProcessNextEntry(
     return;
   }
 
-  if (context->options.ignore_search) {
-    DCHECK(context->request);
-    disk_cache::Entry* entry(*iter);
-    if (RemoveQueryParam(context->request->url) !=
-        RemoveQueryParam(GURL(entry->GetKey()))) {
-      // In this case, we don't need to read data.
-      MatchAllProcessNextEntry(std::move(context), iter + 1);
-      return;
-    }
+  std::unique_ptr<disk_cache::Entry*> scoped_entry_ptr(
+      new disk_cache::Entry*());
+  disk_cache::Entry** entry_ptr = scoped_entry_ptr.get();
+  const std::string& key = *iter;
+
+  net::CompletionCallback open_entry_callback = base::Bind(
+      &CacheStorageCache::MatchAllDidOpenEntry, weak_ptr_factory_.GetWeakPtr(),
+      base::Passed(std::move(context)), iter,
+      base::Passed(std::move(scoped_entry_ptr)));
+
+  int rv = backend_->OpenEntry(key, entry_ptr, open_entry_callback);
+  if (rv != net::ERR_IO_PENDING)
+    open_entry_callback.Run(rv);
+}
+
+void CacheStorageCache::MatchAllDidOpenEntry(
+    std::unique_ptr<MatchAllContext> context,
+    const EntryKeys::const_iterator& iter,
+    std::unique_ptr<disk_cache::Entry*> entry_ptr,
+    int rv) {
+  if (rv != net::OK) {
+    RemoveFromRequestIndex(*iter);
+    MatchAllProcessNextEntry(std::move(context), iter + 1);
+    return;
   }
+  disk_cache::ScopedEntryPtr entry(*entry_ptr);
 
-  ReadMetadata(*iter, base::Bind(&CacheStorageCache::MatchAllDidReadMetadata,
-                                 weak_ptr_factory_.GetWeakPtr(),
-                                 base::Passed(std::move(context)), iter));
+  MetadataCallback headers_callback = base::Bind(
+      &CacheStorageCache::MatchAllDidReadMetadata,
+      weak_ptr_factory_.GetWeakPtr(), base::Passed(std::move(context)), iter,
+      base::Passed(std::move(entry)));
+
+  ReadMetadata(*entry_ptr, headers_callback);
 }
 
 void CacheStorageCache::MatchAllDidReadMetadata(
     std::unique_ptr<MatchAllContext> context,
-    const Entries::iterator& iter,
+    const EntryKeys::const_iterator& iter,
+    disk_cache::ScopedEntryPtr entry,
     std::unique_ptr<CacheMetadata> metadata) {
-  // Move ownership of the entry from the context.
-  disk_cache::ScopedEntryPtr entry(*iter);
-  *iter = nullptr;
-
   if (!metadata) {
     entry->Doom();
+    RemoveFromRequestIndex(*iter);
     MatchAllProcessNextEntry(std::move(context), iter + 1);
     return;
   }
@@ -1052,17 +1277,7 @@ void CacheStorageCache::PutDidCreateEntry(
   }
 
   CacheMetadata metadata;
-  CacheRequest* request_metadata = metadata.mutable_request();
-  request_metadata->set_method(put_context->request->method);
-  for (ServiceWorkerHeaderMap::const_iterator it =
-           put_context->request->headers.begin();
-       it != put_context->request->headers.end(); ++it) {
-    DCHECK_EQ(std::string::npos, it->first.find('\0'));
-    DCHECK_EQ(std::string::npos, it->second.find('\0'));
-    CacheHeaderMap* header_map = request_metadata->add_headers();
-    header_map->set_name(it->first);
-    header_map->set_value(it->second);
-  }
+  PopulateRequestMetadata(*put_context->request, metadata.mutable_request());
 
   CacheResponse* response_metadata = metadata.mutable_response();
   response_metadata->set_status_code(put_context->response->status_code);
@@ -1122,6 +1337,7 @@ void CacheStorageCache::PutDidWriteHeaders(
   // from the blob into the cache entry.
 
   if (put_context->response->blob_uuid.empty()) {
+    AddToRequestIndex(*put_context->request);
     UpdateCacheSize();
     put_context->callback.Run(CACHE_STORAGE_OK);
     return;
@@ -1164,6 +1380,7 @@ void CacheStorageCache::PutDidWriteBlobToCache(
     return;
   }
 
+  AddToRequestIndex(*put_context->request);
   UpdateCacheSize();
   put_context->callback.Run(CACHE_STORAGE_OK);
 }
@@ -1263,8 +1480,10 @@ void CacheStorageCache::DeleteDidOpenAllEntries(
   for (Entries::iterator iter = entries_context->entries.begin();
        iter != entries_context->entries.end(); iter++) {
     disk_cache::Entry* entry(*iter);
-    if (request_url_without_query == RemoveQueryParam(GURL(entry->GetKey())))
+    if (request_url_without_query == RemoveQueryParam(GURL(entry->GetKey()))) {
       entry->Doom();
+      RemoveFromRequestIndex(entry->GetKey());
+    }
   }
 
   entries_context.reset();
@@ -1289,6 +1508,7 @@ void CacheStorageCache::DeleteDidOpenEntry(
 
   entry->Doom();
   entry.reset();
+  RemoveFromRequestIndex(request->url.spec());
 
   UpdateCacheSize();
   callback.Run(CACHE_STORAGE_OK);
@@ -1301,80 +1521,43 @@ void CacheStorageCache::KeysImpl(const RequestsCallback& callback) {
     return;
   }
 
-  // 1. Iterate through all of the entries, open them, and add them to a vector.
-  // 2. For each open entry:
-  //  2.1. Read the headers into a protobuf.
-  //  2.2. Copy the protobuf into a ServiceWorkerFetchRequest (a "key").
-  //  2.3. Push the response into a vector of requests to be returned.
-  // 3. Return the vector of requests (keys).
-
-  // The entries have to be loaded into a vector first because enumeration loops
-  // forever if you read data from a cache entry while enumerating.
-
-  OpenAllEntries(base::Bind(&CacheStorageCache::KeysDidOpenAllEntries,
-                            weak_ptr_factory_.GetWeakPtr(), callback));
+  LoadRequestIndex(base::Bind(&CacheStorageCache::KeysDidLoadRequestIndex,
+                              weak_ptr_factory_.GetWeakPtr(), callback));
 }
 
-void CacheStorageCache::KeysDidOpenAllEntries(
+void CacheStorageCache::KeysDidLoadRequestIndex(
     const RequestsCallback& callback,
-    std::unique_ptr<OpenAllEntriesContext> entries_context,
     CacheStorageError error) {
   if (error != CACHE_STORAGE_OK) {
     callback.Run(error, std::unique_ptr<Requests>());
     return;
   }
 
-  std::unique_ptr<KeysContext> keys_context(new KeysContext(callback));
-  keys_context->entries_context.swap(entries_context);
-  Entries::iterator iter = keys_context->entries_context->entries.begin();
-  KeysProcessNextEntry(std::move(keys_context), iter);
-}
-
-void CacheStorageCache::KeysProcessNextEntry(
-    std::unique_ptr<KeysContext> keys_context,
-    const Entries::iterator& iter) {
-  if (iter == keys_context->entries_context->entries.end()) {
-    // All done. Return all of the keys.
-    keys_context->original_callback.Run(CACHE_STORAGE_OK,
-                                        std::move(keys_context->out_keys));
-    return;
-  }
-
-  ReadMetadata(*iter, base::Bind(&CacheStorageCache::KeysDidReadMetadata,
-                                 weak_ptr_factory_.GetWeakPtr(),
-                                 base::Passed(std::move(keys_context)), iter));
-}
-
-void CacheStorageCache::KeysDidReadMetadata(
-    std::unique_ptr<KeysContext> keys_context,
-    const Entries::iterator& iter,
-    std::unique_ptr<CacheMetadata> metadata) {
-  disk_cache::Entry* entry = *iter;
-
-  if (metadata) {
-    keys_context->out_keys->push_back(ServiceWorkerFetchRequest(
-        GURL(entry->GetKey()), metadata->request().method(),
+  std::unique_ptr<Requests> out_keys(new Requests());
+  out_keys->reserve(request_index_->size());
+  for (const auto& key_and_request : *request_index_) {
+    const CacheRequest& request = key_and_request.second;
+    out_keys->push_back(ServiceWorkerFetchRequest(
+        GURL(key_and_request.first), request.method(),
         ServiceWorkerHeaderMap(), Referrer(), false));
 
-    ServiceWorkerHeaderMap& req_headers =
-        keys_context->out_keys->back().headers;
-
-    for (int i = 0; i < metadata->request().headers_size(); ++i) {
-      const CacheHeaderMap header = metadata->request().headers(i);
+    ServiceWorkerHeaderMap& req_headers = out_keys->back().headers;
+    for (int i = 0; i < request.headers_size(); ++i) {
+      const CacheHeaderMap& header = request.headers(i);
       DCHECK_EQ(std::string::npos, header.name().find('\0'));
       DCHECK_EQ(std::string::npos, header.value().find('\0'));
       req_headers.insert(std::make_pair(header.name(), header.value()));
     }
-  } else {
-    entry->Doom();
   }
 
-  KeysProcessNextEntry(std::move(keys_context), iter + 1);
+  callback.Run(CACHE_STORAGE_OK, std::move(out_keys));
 }
 
 void CacheStorageCache::CloseImpl(const base::Closure& callback) {
   DCHECK_NE(BACKEND_CLOSED, backend_state_);
 
+  if (backend_state_ == BACKEND_OPEN)
+    SaveRequestIndex();
   backend_state_ = BACKEND_CLOSED;
   backend_.reset();
   callback.Run();
@@ -7,6 +7,9 @@
 
 #include <stdint.h>
 
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "base/callback.h"
@@ -36,6 +39,8 @@ class CacheStorage;
 class CacheStorageBlobToDiskCache;
 class CacheStorageCacheHandle;
 class CacheMetadata;
+class CacheRequest;
+class CacheRequestIndex;
 class CacheStorageScheduler;
 class TestCacheStorageCache;
 
@@ -152,13 +157,18 @@ class CONTENT_EXPORT CacheStorageCache {
 
   base::WeakPtr<CacheStorageCache> AsWeakPtr();
 
+  // Returns the path of the request index kept for the cache at |cache_path|.
+  // It lives beside the cache's directory rather than in it, so that writing
+  // it doesn't make the disk cache's own index look stale.
+  static base::FilePath GetRequestIndexPath(const base::FilePath& cache_path);
+
  private:
   friend class base::RefCounted<CacheStorageCache>;
   friend class TestCacheStorageCache;
 
   struct OpenAllEntriesContext;
   struct MatchAllContext;
-  struct KeysContext;
+  struct BuildRequestIndexContext;
   struct PutContext;
 
   // The backend progresses from uninitialized, to open, to closed, and cannot
@@ -170,6 +180,9 @@ class CONTENT_EXPORT CacheStorageCache {
   };
 
   using Entries = std::vector<disk_cache::Entry*>;
+  using EntryKeys = std::vector<std::string>;
+  // The request metadata of each entry, keyed by entry key (the request URL).
+  using RequestIndex = std::map<std::string, CacheRequest>;
   using ScopedBackendPtr = std::unique_ptr<disk_cache::Backend>;
   using BlobToDiskCacheIDMap =
       IDMap<CacheStorageBlobToDiskCache, IDMapOwnPointer>;
@@ -195,6 +208,33 @@ class CONTENT_EXPORT CacheStorageCache {
                         const OpenAllEntriesCallback& callback,
                         int rv);
 
+  // Runs |callback| once |request_index_| describes every entry. The index is
+  // read from the file saved by the last session if that is still accurate,
+  // and otherwise built by reading the metadata of every entry.
+  void LoadRequestIndex(const ErrorCallback& callback);
+  void LoadRequestIndexDidReadFile(const ErrorCallback& callback,
+                                   std::unique_ptr<CacheRequestIndex> index);
+  void BuildRequestIndexDidOpenAllEntries(
+      std::unique_ptr<BuildRequestIndexContext> context,
+      std::unique_ptr<OpenAllEntriesContext> entries_context,
+      CacheStorageError error);
+  void BuildRequestIndexProcessNextEntry(
+      std::unique_ptr<BuildRequestIndexContext> context,
+      const Entries::iterator& iter);
+  void BuildRequestIndexDidReadMetadata(
+      std::unique_ptr<BuildRequestIndexContext> context,
+      const Entries::iterator& iter,
+      std::unique_ptr<CacheMetadata> metadata);
+
+  // Keep |request_index_| in step with the entries, if it has been loaded.
+  // Either also deletes the saved index file, which no longer matches.
+  void AddToRequestIndex(const ServiceWorkerFetchRequest& request);
+  void RemoveFromRequestIndex(const std::string& key);
+  void InvalidateRequestIndexFile();
+
+  // Writes |request_index_| to disk if it is loaded and the file is stale.
+  void SaveRequestIndex();
+
   // Match callbacks
   void MatchImpl(std::unique_ptr<ServiceWorkerFetchRequest> request,
                  const ResponseCallback& callback);
@@ -209,14 +249,17 @@ class CONTENT_EXPORT CacheStorageCache {
 
   // MatchAll callbacks
   void MatchAllImpl(std::unique_ptr<MatchAllContext> context);
-  void MatchAllDidOpenAllEntries(
-      std::unique_ptr<MatchAllContext> context,
-      std::unique_ptr<OpenAllEntriesContext> entries_context,
-      CacheStorageError error);
+  void MatchAllDidLoadRequestIndex(std::unique_ptr<MatchAllContext> context,
+                                   CacheStorageError error);
   void MatchAllProcessNextEntry(std::unique_ptr<MatchAllContext> context,
-                                const Entries::iterator& iter);
+                                const EntryKeys::const_iterator& iter);
+  void MatchAllDidOpenEntry(std::unique_ptr<MatchAllContext> context,
+                            const EntryKeys::const_iterator& iter,
+                            std::unique_ptr<disk_cache::Entry*> entry_ptr,
+                            int rv);
   void MatchAllDidReadMetadata(std::unique_ptr<MatchAllContext> context,
-                               const Entries::iterator& iter,
+                               const EntryKeys::const_iterator& iter,
+                               disk_cache::ScopedEntryPtr entry,
                                std::unique_ptr<CacheMetadata> metadata);
 
   // WriteSideData callbacks
@@ -308,15 +351,8 @@ class CONTENT_EXPORT CacheStorageCache {
 
   // Keys callbacks.
   void KeysImpl(const RequestsCallback& callback);
-  void KeysDidOpenAllEntries(
-      const RequestsCallback& callback,
-      std::unique_ptr<OpenAllEntriesContext> entries_context,
-      CacheStorageError error);
-  void KeysProcessNextEntry(std::unique_ptr<KeysContext> keys_context,
-                            const Entries::iterator& iter);
-  void KeysDidReadMetadata(std::unique_ptr<KeysContext> keys_context,
-                           const Entries::iterator& iter,
-                           std::unique_ptr<CacheMetadata> metadata);
+  void KeysDidLoadRequestIndex(const RequestsCallback& callback,
+                               CacheStorageError error);
 
   void CloseImpl(const base::Closure& callback);
 
@@ -387,6 +423,13 @@ class CONTENT_EXPORT CacheStorageCache {
   // Whether or not to store data in disk or memory.
   bool memory_only_;
 
+  // Null until the first operation that needs it loads it.
+  std::unique_ptr<RequestIndex> request_index_;
+
+  // False once the entries may have diverged from the saved request index
+  // file, which is deleted at that point and rewritten when the cache closes.
+  bool request_index_file_current_ = true;
+
   base::WeakPtrFactory<CacheStorageCache> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(CacheStorageCache);
@@ -11,6 +11,7 @@
 #include <utility>
 
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
@@ -356,11 +357,24 @@ class CacheStorageCacheTest : public testing::Test {
 
     CreateRequests(blob_storage_context);
 
+    CreateCache();
+  }
+
+  // The cache lives in a subdirectory so that its request index, which is
+  // written beside it, also ends up in |temp_dir_|.
+  base::FilePath CachePath() {
+    if (MemoryOnly())
+      return base::FilePath();
+    return temp_dir_.path().AppendASCII("cache");
+  }
+
+  // Replaces |cache_| with a new cache object for the same directory.
+  void CreateCache() {
     cache_ = base::MakeUnique<TestCacheStorageCache>(
-        GURL(kOrigin), kCacheName, temp_dir_.path(), nullptr /* CacheStorage */,
+        GURL(kOrigin), kCacheName, CachePath(), nullptr /* CacheStorage */,
         BrowserContext::GetDefaultStoragePartition(&browser_context_)
             ->GetURLRequestContext(),
-        quota_manager_proxy_, blob_storage_context->context()->AsWeakPtr());
+        quota_manager_proxy_, blob_storage_context_->AsWeakPtr());
   }
 
   void TearDown() override {
@@ -1035,6 +1049,52 @@ TEST_P(CacheStorageCacheTestP, TwoKeysThenOne) {
   EXPECT_TRUE(VerifyKeys(expected_key));
 }
 
+TEST_F(CacheStorageCacheTest, KeysFromSavedRequestIndex) {
+  base::FilePath index_path =
+      CacheStorageCache::GetRequestIndexPath(CachePath());
+  EXPECT_TRUE(Put(no_body_request_, no_body_response_));
+  EXPECT_TRUE(Put(body_request_, body_response_));
+  EXPECT_TRUE(Keys());
+  EXPECT_TRUE(Close());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(base::PathExists(index_path));
+
+  CreateCache();
+  EXPECT_TRUE(Keys());
+  std::vector<std::string> expected_keys;
+  expected_keys.push_back(no_body_request_.url.spec());
+  expected_keys.push_back(body_request_.url.spec());
+  EXPECT_TRUE(VerifyKeys(expected_keys));
+
+  // Any change makes the saved index stale.
+  EXPECT_TRUE(Delete(body_request_));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(index_path));
+  EXPECT_TRUE(Keys());
+  expected_keys.pop_back();
+  EXPECT_TRUE(VerifyKeys(expected_keys));
+}
+
+TEST_F(CacheStorageCacheTest, KeysIgnoreCorruptRequestIndex) {
+  EXPECT_TRUE(Put(no_body_request_, no_body_response_));
+  EXPECT_TRUE(Put(body_request_, body_response_));
+  cache_.reset();
+  base::RunLoop().RunUntilIdle();
+
+  std::string garbage = "garbage";
+  base::FilePath index_path =
+      CacheStorageCache::GetRequestIndexPath(CachePath());
+  ASSERT_EQ(static_cast<int>(garbage.size()),
+            base::WriteFile(index_path, garbage.data(), garbage.size()));
+
+  CreateCache();
+  EXPECT_TRUE(Keys());
+  std::vector<std::string> expected_keys;
+  expected_keys.push_back(no_body_request_.url.spec());
+  expected_keys.push_back(body_request_.url.spec());
+  EXPECT_TRUE(VerifyKeys(expected_keys));
+}
+
 TEST_P(CacheStorageCacheTestP, DeleteNoBody) {
   EXPECT_TRUE(Put(no_body_request_, no_body_response_));
   EXPECT_TRUE(Match(no_body_request_));
@@ -119,10 +119,11 @@ bool DOMStorageDatabase::CommitChanges(bool clear_all_first,
   }
 
   if (!known_to_be_empty_ && did_delete && !did_insert) {
+    // Only emptiness matters here, so stop at the first row rather than
+    // counting them all.
     sql::Statement statement(db_->GetCachedStatement(SQL_FROM_HERE,
-        "SELECT count(key) from ItemTable"));
-    if (statement.Step())
-      known_to_be_empty_ = statement.ColumnInt(0) == 0;
+        "SELECT 1 FROM ItemTable LIMIT 1"));
+    known_to_be_empty_ = !statement.Step() && statement.Succeeded();
   }
 
   bool success = transaction.Commit();
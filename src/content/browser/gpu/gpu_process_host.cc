@@ -732,8 +732,12 @@ void GpuProcessHost::EstablishGpuChannel(
     callback.Run(IPC::ChannelHandle(), gpu::GPUInfo());
   }
 
-  if (!base::CommandLine::ForCurrentProcess()->HasSwitch(
-      switches::kDisableGpuShaderDiskCache)) {
+  // The GPU process persists the programs itself when it has a program disk
+  // cache.
+  const base::CommandLine* command_line =
+      base::CommandLine::ForCurrentProcess();
+  if (!command_line->HasSwitch(switches::kDisableGpuShaderDiskCache) &&
+      !command_line->HasSwitch(switches::kGpuProgramDiskCacheDir)) {
     CreateChannelCache(client_id);
   }
 }
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/feature_list.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/format_macros.h"
@@ -38,6 +39,7 @@
 #include "content/common/indexed_db/indexed_db_key_path.h"
 #include "content/common/indexed_db/indexed_db_key_range.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/common/content_features.h"
 #include "net/url_request/url_request_context.h"
 #include "storage/browser/blob/blob_data_handle.h"
 #include "storage/browser/fileapi/file_stream_writer.h"
@@ -307,7 +309,10 @@ const char* IndexedDBBackingStore::Comparator::Name() const {
 // 1 - Adds UserIntVersion to DatabaseMetaData.
 // 2 - Adds DataVersion to to global metadata.
 // 3 - Adds metadata needed for blob support.
-static const int64_t kLatestKnownSchemaVersion = 3;
+// 4 - Object store values may be snappy-compressed (see EncodeIDBValueBits).
+//     Only upgraded to when kIndexedDBValueCompression is enabled.
+static const int64_t kLatestKnownSchemaVersion = 4;
+static const int64_t kCompressedValuesSchemaVersion = 4;
 WARN_UNUSED_RESULT static bool IsSchemaKnown(LevelDBDatabase* db, bool* known) {
   int64_t db_schema_version = 0;
   bool found = false;
@@ -352,6 +357,10 @@ WARN_UNUSED_RESULT static bool IsSchemaKnown(LevelDBDatabase* db, bool* known) {
 WARN_UNUSED_RESULT leveldb::Status IndexedDBBackingStore::SetUpMetadata() {
   const uint32_t latest_known_data_version =
       blink::kSerializedScriptValueVersion;
+  const int64_t target_schema_version =
+      base::FeatureList::IsEnabled(features::kIndexedDBValueCompression)
+          ? kCompressedValuesSchemaVersion
+          : kCompressedValuesSchemaVersion - 1;
   const std::string schema_version_key = SchemaVersionKey::Encode();
   const std::string data_version_key = DataVersionKey::Encode();
 
@@ -369,7 +378,7 @@ WARN_UNUSED_RESULT leveldb::Status IndexedDBBackingStore::SetUpMetadata() {
   }
   if (!found) {
     // Initialize new backing store.
-    db_schema_version = kLatestKnownSchemaVersion;
+    db_schema_version = target_schema_version;
     PutInt(transaction.get(), schema_version_key, db_schema_version);
     db_data_version = latest_known_data_version;
     PutInt(transaction.get(), data_version_key, db_data_version);
@@ -423,6 +432,11 @@ WARN_UNUSED_RESULT leveldb::Status IndexedDBBackingStore::SetUpMetadata() {
         return IOErrorStatus();
       }
     }
+    // Existing values are left as they are; they are still readable.
+    if (db_schema_version < target_schema_version) {
+      db_schema_version = target_schema_version;
+      PutInt(transaction.get(), schema_version_key, db_schema_version);
+    }
   }
 
   if (!s.ok()) {
@@ -446,12 +460,18 @@ WARN_UNUSED_RESULT leveldb::Status IndexedDBBackingStore::SetUpMetadata() {
     PutInt(transaction.get(), data_version_key, db_data_version);
   }
 
-  DCHECK_EQ(db_schema_version, kLatestKnownSchemaVersion);
+  // A store that was upgraded for compression stays at that version even if
+  // the feature is later disabled.
+  DCHECK_GE(db_schema_version, target_schema_version);
+  DCHECK_LE(db_schema_version, kLatestKnownSchemaVersion);
   DCHECK_EQ(db_data_version, latest_known_data_version);
 
   s = transaction->Commit();
-  if (!s.ok())
+  if (!s.ok()) {
     INTERNAL_WRITE_ERROR_UNTESTED(SET_UP_METADATA);
+    return s;
+  }
+  compress_values_ = target_schema_version >= kCompressedValuesSchemaVersion;
   return s;
 }
 
@@ -761,7 +781,8 @@ IndexedDBBackingStore::IndexedDBBackingStore(
       db_(std::move(db)),
       comparator_(std::move(comparator)),
       active_blob_registry_(this),
-      committing_transaction_count_(0) {}
+      committing_transaction_count_(0),
+      compress_values_(false) {}
 
 IndexedDBBackingStore::~IndexedDBBackingStore() {
   if (!blob_path_.empty() && !child_process_ids_granted_.empty()) {
@@ -1865,7 +1886,10 @@ leveldb::Status IndexedDBBackingStore::GetRecord(
     return InternalInconsistencyStatus();
   }
 
-  record->bits = slice.as_string();
+  if (!DecodeIDBValueBits(&slice, &record->bits)) {
+    INTERNAL_READ_ERROR_UNTESTED(GET_RECORD);
+    return InternalInconsistencyStatus();
+  }
   return transaction->GetBlobInfoForRecord(database_id, leveldb_key, record);
 }
 
@@ -1926,7 +1950,7 @@ leveldb::Status IndexedDBBackingStore::PutRecord(
 
   std::string v;
   EncodeVarInt(version, &v);
-  v.append(value->bits);
+  EncodeIDBValueBits(value->bits, compress_values_, &v);
 
   leveldb_transaction->Put(object_store_data_key, &v);
   s = transaction->PutBlobInfoIfNeeded(database_id,
@@ -2210,8 +2234,15 @@ class IndexedDBBackingStore::Transaction::ChainedBlobWriterImpl
         database_id_(database_id),
         backing_store_(backing_store),
         callback_(callback),
-        aborted_(false) {
+        aborted_(false),
+        start_time_(base::TimeTicks::Now()) {
     blobs_.swap(*blobs);
+    // Write the files in key order, so that the pass walks each blob
+    // directory once rather than hopping between them.
+    std::sort(blobs_.begin(), blobs_.end(),
+              [](const WriteDescriptor& a, const WriteDescriptor& b) {
+                return a.key() < b.key();
+              });
     iter_ = blobs_.begin();
     backing_store->task_runner()->PostTask(
         FROM_HERE, base::Bind(&ChainedBlobWriterImpl::WriteNextFile, this));
@@ -2260,6 +2291,10 @@ class IndexedDBBackingStore::Transaction::ChainedBlobWriterImpl
     }
     if (iter_ == blobs_.end()) {
       DCHECK(!self_ref_.get());
+      UMA_HISTOGRAM_TIMES("WebCore.IndexedDB.BackingStore.BlobWriteTime",
+                          base::TimeTicks::Now() - start_time_);
+      UMA_HISTOGRAM_COUNTS_100("WebCore.IndexedDB.BackingStore.BlobWriteCount",
+                               blobs_.size());
       callback_->Run(true);
       return;
     } else {
@@ -2280,6 +2315,7 @@ class IndexedDBBackingStore::Transaction::ChainedBlobWriterImpl
   scoped_refptr<IndexedDBBackingStore::BlobWriteCallback> callback_;
   std::unique_ptr<FileWriterDelegate> delegate_;
   bool aborted_;
+  const base::TimeTicks start_time_;
 
   DISALLOW_COPY_AND_ASSIGN(ChainedBlobWriterImpl);
 };
@@ -3507,7 +3543,11 @@ bool ObjectStoreCursorImpl::LoadCurrentRow(leveldb::Status* s) {
   if (!s->ok())
     return false;
 
-  current_value_.bits = value_slice.as_string();
+  if (!DecodeIDBValueBits(&value_slice, &current_value_.bits)) {
+    INTERNAL_READ_ERROR_UNTESTED(LOAD_CURRENT_ROW);
+    *s = InternalInconsistencyStatus();
+    return false;
+  }
   return true;
 }
 
@@ -3741,7 +3781,11 @@ bool IndexCursorImpl::LoadCurrentRow(leveldb::Status* s) {
     return false;
   }
 
-  current_value_.bits = slice.as_string();
+  if (!DecodeIDBValueBits(&slice, &current_value_.bits)) {
+    INTERNAL_READ_ERROR_UNTESTED(LOAD_CURRENT_ROW);
+    *s = InternalInconsistencyStatus();
+    return false;
+  }
   *s = transaction_->GetBlobInfoForRecord(database_id_, primary_leveldb_key_,
                                           &current_value_);
   return s->ok();
@@ -669,6 +669,10 @@ class CONTENT_EXPORT IndexedDBBackingStore
   // journal cleaning must be deferred.
   size_t committing_transaction_count_;
 
+  // Whether new values may be stored compressed. Set by SetUpMetadata() once
+  // the schema is at a version that can hold compressed values.
+  bool compress_values_;
+
   DISALLOW_COPY_AND_ASSIGN(IndexedDBBackingStore);
 };
 
@@ -286,6 +286,43 @@ static void BlobLookupForCursorPrefetch(
       new IndexedDBMsg_CallbacksSuccessCursorPrefetch(*params));
 }
 
+// Sends the getAll() result in |params|, split into chunks of about
+// kIDBGetAllChunkSizeInBytes so that a large result doesn't have to be
+// serialized into a single message. Consumes the values in |params|.
+static void SendSuccessArray(IndexedDBMsg_CallbacksSuccessArray_Params* params,
+                             IndexedDBDispatcherHost* dispatcher_host) {
+  size_t total_size = 0;
+  for (const auto& value : params->values)
+    total_size += value.bits.size() + value.primary_key.size_estimate();
+  if (total_size <= kIDBGetAllChunkSizeInBytes) {
+    dispatcher_host->Send(new IndexedDBMsg_CallbacksSuccessArray(*params));
+    return;
+  }
+
+  IndexedDBMsg_CallbacksSuccessArray_Params chunk;
+  chunk.ipc_thread_id = params->ipc_thread_id;
+  chunk.ipc_callbacks_id = params->ipc_callbacks_id;
+  size_t chunk_size = 0;
+  for (auto& value : params->values) {
+    size_t value_size = value.bits.size() + value.primary_key.size_estimate();
+    if (!chunk.values.empty() &&
+        chunk_size + value_size > kIDBGetAllChunkSizeInBytes) {
+      dispatcher_host->Send(
+          new IndexedDBMsg_CallbacksSuccessArrayChunk(chunk));
+      chunk.values.clear();
+      chunk_size = 0;
+    }
+    chunk.values.push_back(IndexedDBMsg_ReturnValue());
+    IndexedDBMsg_ReturnValue& chunk_value = chunk.values.back();
+    chunk_value.bits.swap(value.bits);
+    chunk_value.blob_or_file_info.swap(value.blob_or_file_info);
+    chunk_value.primary_key = value.primary_key;
+    chunk_value.key_path = value.key_path;
+    chunk_size += value_size;
+  }
+  dispatcher_host->Send(new IndexedDBMsg_CallbacksSuccessArray(chunk));
+}
+
 static void BlobLookupForGetAll(
     IndexedDBMsg_CallbacksSuccessArray_Params* params,
     scoped_refptr<IndexedDBDispatcherHost> dispatcher_host,
@@ -299,7 +336,7 @@ static void BlobLookupForGetAll(
       return;
   }
 
-  dispatcher_host->Send(new IndexedDBMsg_CallbacksSuccessArray(*params));
+  SendSuccessArray(params, dispatcher_host.get());
 }
 
 static void FillInBlobData(
@@ -560,8 +597,7 @@ void IndexedDBCallbacks::OnSuccessArray(
         base::Bind(BlobLookupForGetAll, base::Owned(params.release()),
                    dispatcher_host_, *values));
   } else {
-    dispatcher_host_->Send(
-        new IndexedDBMsg_CallbacksSuccessArray(*params.get()));
+    SendSuccessArray(params.get(), dispatcher_host_.get());
   }
   dispatcher_host_ = NULL;
 }
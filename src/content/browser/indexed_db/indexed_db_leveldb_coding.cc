@@ -14,6 +14,7 @@
 #include "base/sys_byteorder.h"
 #include "content/common/indexed_db/indexed_db_key.h"
 #include "content/common/indexed_db/indexed_db_key_path.h"
+#include "third_party/snappy/src/snappy.h"
 
 // See leveldb_coding_scheme.md for detailed documentation of the coding
 // scheme implemented here.
@@ -51,6 +52,18 @@ static const unsigned char kIndexedDBKeyBinaryTypeByte = 6;
 static const unsigned char kIndexedDBKeyPathTypeCodedByte1 = 0;
 static const unsigned char kIndexedDBKeyPathTypeCodedByte2 = 0;
 
+static const unsigned char kIndexedDBValueTypeCodedByte1 = 0;
+static const unsigned char kIndexedDBValueTypeCodedByte2 = 0;
+
+static const unsigned char kIndexedDBValueRaw = 0;
+static const unsigned char kIndexedDBValueSnappy = 1;
+
+// Values smaller than this are never compressed, and compressed values are
+// only kept if they save at least 1/kIndexedDBValueMinSavingsFraction of the
+// size.
+static const size_t kIndexedDBValueCompressionThreshold = 1024;
+static const size_t kIndexedDBValueMinSavingsFraction = 8;
+
 static const unsigned char kIndexedDBKeyPathNullTypeByte = 0;
 static const unsigned char kIndexedDBKeyPathStringTypeByte = 1;
 static const unsigned char kIndexedDBKeyPathArrayTypeByte = 2;
@@ -256,6 +269,33 @@ void EncodeBlobJournal(const BlobJournalType& journal, std::string* into) {
   }
 }
 
+void EncodeIDBValueBits(const std::string& bits,
+                        bool compress,
+                        std::string* into) {
+  if (compress && bits.size() >= kIndexedDBValueCompressionThreshold) {
+    std::string compressed;
+    snappy::Compress(bits.data(), bits.size(), &compressed);
+    if (compressed.size() <=
+        bits.size() - bits.size() / kIndexedDBValueMinSavingsFraction) {
+      EncodeByte(kIndexedDBValueTypeCodedByte1, into);
+      EncodeByte(kIndexedDBValueTypeCodedByte2, into);
+      EncodeByte(kIndexedDBValueSnappy, into);
+      into->append(compressed);
+      return;
+    }
+  }
+
+  // Serialized script values never start with the coded prefix, but wrap
+  // anything that does so that it can't be mistaken for a coded value.
+  if (bits.size() >= 2 && bits[0] == kIndexedDBValueTypeCodedByte1 &&
+      bits[1] == kIndexedDBValueTypeCodedByte2) {
+    EncodeByte(kIndexedDBValueTypeCodedByte1, into);
+    EncodeByte(kIndexedDBValueTypeCodedByte2, into);
+    EncodeByte(kIndexedDBValueRaw, into);
+  }
+  into->append(bits);
+}
+
 bool DecodeByte(StringPiece* slice, unsigned char* value) {
   if (slice->empty())
     return false;
@@ -509,6 +549,33 @@ bool DecodeBlobJournal(StringPiece* slice, BlobJournalType* journal) {
   return true;
 }
 
+bool DecodeIDBValueBits(StringPiece* slice, std::string* bits) {
+  // May be coded, or may be a raw serialized script value. As with key
+  // paths, an invalid leading byte sequence identifies coded values.
+  if (slice->size() < 3 || (*slice)[0] != kIndexedDBValueTypeCodedByte1 ||
+      (*slice)[1] != kIndexedDBValueTypeCodedByte2) {
+    slice->CopyToString(bits);
+    slice->clear();
+    return true;
+  }
+
+  const unsigned char type = (*slice)[2];
+  slice->remove_prefix(3);
+  switch (type) {
+    case kIndexedDBValueRaw:
+      slice->CopyToString(bits);
+      break;
+    case kIndexedDBValueSnappy:
+      if (!snappy::Uncompress(slice->data(), slice->size(), bits))
+        return false;
+      break;
+    default:
+      return false;
+  }
+  slice->clear();
+  return true;
+}
+
 bool ConsumeEncodedIDBKey(StringPiece* slice) {
   unsigned char type = (*slice)[0];
   slice->remove_prefix(1);
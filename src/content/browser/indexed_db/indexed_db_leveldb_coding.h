@@ -47,6 +47,12 @@ CONTENT_EXPORT void EncodeIDBKeyPath(const IndexedDBKeyPath& value,
                                      std::string* into);
 CONTENT_EXPORT void EncodeBlobJournal(const BlobJournalType& journal,
                                       std::string* into);
+// Appends the serialized script value |bits|, snappy-compressed if
+// |compress| is set and it is large enough to benefit. Values written with
+// |compress| set are only readable by backing stores at schema version 4.
+CONTENT_EXPORT void EncodeIDBValueBits(const std::string& bits,
+                                       bool compress,
+                                       std::string* into);
 
 CONTENT_EXPORT WARN_UNUSED_RESULT bool DecodeByte(base::StringPiece* slice,
                                                   unsigned char* value);
@@ -74,6 +80,10 @@ CONTENT_EXPORT WARN_UNUSED_RESULT bool DecodeIDBKeyPath(
 CONTENT_EXPORT WARN_UNUSED_RESULT bool DecodeBlobJournal(
     base::StringPiece* slice,
     BlobJournalType* journal);
+// Consumes all of |slice|.
+CONTENT_EXPORT WARN_UNUSED_RESULT bool DecodeIDBValueBits(
+    base::StringPiece* slice,
+    std::string* bits);
 
 CONTENT_EXPORT int CompareEncodedStringsWithLength(base::StringPiece* slice1,
                                                    base::StringPiece* slice2,
@@ -761,6 +761,48 @@ TEST(IndexedDBLevelDBCodingTest, EncodeDecodeBlobJournal) {
   }
 }
 
+TEST(IndexedDBLevelDBCodingTest, EncodeDecodeIDBValueBits) {
+  std::vector<std::string> values;
+  values.push_back(std::string());
+  values.push_back(std::string("\xff\x09", 2));
+  // Compressible, and large enough to be compressed.
+  values.push_back(std::string("\xff\x09") + std::string(4096, 'x'));
+  // Starts with the coded prefix.
+  values.push_back(std::string("\0\0\1abc", 6));
+
+  for (const std::string& value : values) {
+    for (bool compress : {false, true}) {
+      std::string encoding;
+      EncodeIDBValueBits(value, compress, &encoding);
+      StringPiece slice(encoding);
+      std::string decoded;
+      EXPECT_TRUE(DecodeIDBValueBits(&slice, &decoded));
+      EXPECT_EQ(value, decoded);
+      EXPECT_TRUE(slice.empty());
+    }
+  }
+
+  // Only the large value is worth compressing, and only when asked to.
+  std::string encoding;
+  EncodeIDBValueBits(values[2], false, &encoding);
+  EXPECT_EQ(values[2], encoding);
+  encoding.clear();
+  EncodeIDBValueBits(values[2], true, &encoding);
+  EXPECT_LT(encoding.size(), values[2].size() / 2);
+  encoding.clear();
+  EncodeIDBValueBits(values[1], true, &encoding);
+  EXPECT_EQ(values[1], encoding);
+
+  // Unknown coding, and corrupt compressed data.
+  std::string unknown("\0\0\x7fabc", 6);
+  StringPiece slice(unknown);
+  std::string decoded;
+  EXPECT_FALSE(DecodeIDBValueBits(&slice, &decoded));
+  std::string corrupt("\0\0\1\xff\xff\xff\xff\xff", 8);
+  slice = StringPiece(corrupt);
+  EXPECT_FALSE(DecodeIDBValueBits(&slice, &decoded));
+}
+
 TEST(IndexedDBLevelDBCodingTest, DecodeLegacyIDBKeyPath) {
   // Legacy encoding of string key paths.
   std::vector<IndexedDBKeyPath> key_paths;
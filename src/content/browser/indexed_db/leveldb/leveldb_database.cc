@@ -17,7 +17,6 @@
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string16.h"
-#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
@@ -32,6 +31,7 @@
 #include "content/browser/indexed_db/leveldb/leveldb_iterator_impl.h"
 #include "content/browser/indexed_db/leveldb/leveldb_write_batch.h"
 #include "third_party/leveldatabase/env_chromium.h"
+#include "third_party/leveldatabase/leveldb_chrome.h"
 #include "third_party/leveldatabase/src/helpers/memenv/memenv.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
 #include "third_party/leveldatabase/src/include/leveldb/env.h"
@@ -131,6 +131,9 @@ static leveldb::Status OpenDB(
   // https://code.google.com/p/chromium/issues/detail?id=227313#c11
   options.max_open_files = 80;
   options.env = env;
+  // Cache blocks within the budget shared by all the databases, rather than
+  // in a cache of each origin's own.
+  options.block_cache = leveldb_chrome::GetSharedBrowserBlockCache();
 
   // ChromiumEnv assumes UTF8, converts back to FilePath before using.
   leveldb::Status s = leveldb::DB::Open(options, path.AsUTF8Unsafe(), db);
@@ -455,11 +458,8 @@ bool LevelDBDatabase::OnMemoryDump(
   if (!db_)
     return false;
 
-  std::string value;
-  uint64_t size;
-  bool res = db_->GetProperty("leveldb.approximate-memory-usage", &value);
-  DCHECK(res);
-  base::StringToUint64(value, &size);
+  uint64_t size = leveldb_chrome::GetApproximateMemoryUsage(
+      db_.get(), true /* uses_shared_block_cache */);
 
   auto dump = pmd->CreateAllocatorDump(base::StringPrintf(
       "leveldb/index_db/0x%" PRIXPTR, reinterpret_cast<uintptr_t>(db_.get())));
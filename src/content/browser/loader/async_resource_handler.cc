@@ -23,6 +23,7 @@
 #include "content/browser/loader/resource_dispatcher_host_impl.h"
 #include "content/browser/loader/resource_message_filter.h"
 #include "content/browser/loader/resource_request_info_impl.h"
+#include "content/common/resource_buffer_control.h"
 #include "content/common/resource_messages.h"
 #include "content/common/resource_request_completion_status.h"
 #include "content/common/view_messages.h"
@@ -198,6 +199,7 @@ AsyncResourceHandler::AsyncResourceHandler(
       ResourceMessageDelegate(request),
       rdh_(rdh),
       pending_data_count_(0),
+      control_tail_(0),
       allocation_size_(0),
       did_defer_(false),
       has_checked_for_sufficient_resources_(false),
@@ -220,6 +222,8 @@ bool AsyncResourceHandler::OnMessageReceived(const IPC::Message& message) {
   IPC_BEGIN_MESSAGE_MAP(AsyncResourceHandler, message)
     IPC_MESSAGE_HANDLER(ResourceHostMsg_FollowRedirect, OnFollowRedirect)
     IPC_MESSAGE_HANDLER(ResourceHostMsg_DataReceived_ACK, OnDataReceivedACK)
+    IPC_MESSAGE_HANDLER(ResourceHostMsg_DataBufferReleased,
+                        OnDataBufferReleased)
     IPC_MESSAGE_HANDLER(ResourceHostMsg_UploadProgress_ACK, OnUploadProgressACK)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
@@ -245,6 +249,14 @@ void AsyncResourceHandler::OnDataReceivedACK(int request_id) {
   }
 }
 
+void AsyncResourceHandler::OnDataBufferReleased(int request_id) {
+  if (!buffer_.get() || !buffer_->IsInitialized())
+    return;
+  RecycleReleasedData();
+  if (buffer_->CanAllocate())
+    ResumeIfDeferred();
+}
+
 void AsyncResourceHandler::OnUploadProgressACK(int request_id) {
   waiting_for_upload_progress_ack_ = false;
 }
@@ -418,6 +430,8 @@ bool AsyncResourceHandler::OnWillRead(scoped_refptr<net::IOBuffer>* buf,
   if (!EnsureResourceBufferIsInitialized())
     return false;
 
+  // Recycling here lets Allocate() return larger chunks.
+  RecycleReleasedData();
   DCHECK(buffer_->CanAllocate());
   char* memory = buffer_->Allocate(&allocation_size_);
   CHECK(memory);
@@ -453,7 +467,7 @@ bool AsyncResourceHandler::OnReadCompleted(int bytes_read, bool* defer) {
     if (!base::SharedMemory::IsHandleValid(handle))
       return false;
     filter->Send(new ResourceMsg_SetDataBuffer(
-        GetRequestID(), handle, buffer_->GetSharedMemory().mapped_size(),
+        GetRequestID(), handle, buffer_->GetBufferSize(), true,
         filter->peer_pid()));
     sent_data_buffer_msg_ = true;
   }
@@ -464,7 +478,7 @@ bool AsyncResourceHandler::OnReadCompleted(int bytes_read, bool* defer) {
       GetRequestID(), data_offset, bytes_read, encoded_data_length));
   ++pending_data_count_;
 
-  if (!buffer_->CanAllocate()) {
+  if (!WaitForSpaceIfNeeded()) {
     *defer = did_defer_ = true;
     OnDefer();
   }
@@ -550,6 +564,39 @@ bool AsyncResourceHandler::EnsureResourceBufferIsInitialized() {
                              kMaxAllocationSize);
 }
 
+void AsyncResourceHandler::RecycleReleasedData() {
+  ResourceBufferControl* control = buffer_->GetControl();
+  base::subtle::Atomic32 tail = base::subtle::Acquire_Load(&control->tail);
+  // The renderer can write anything to |tail|, so it cannot release more than
+  // what it was sent, like with DataReceived_ACK messages.
+  uint32_t released = static_cast<uint32_t>(tail) - control_tail_;
+  released = std::min(released, static_cast<uint32_t>(pending_data_count_));
+  control_tail_ += released;
+  pending_data_count_ -= released;
+  for (; released; --released)
+    buffer_->RecycleLeastRecentlyAllocated();
+}
+
+bool AsyncResourceHandler::WaitForSpaceIfNeeded() {
+  RecycleReleasedData();
+  if (buffer_->CanAllocate())
+    return true;
+
+  // See resource_buffer_control.h: the renderer clears |producer_waiting| after
+  // advancing |tail|, so checking |tail| again after setting the flag makes
+  // sure that a release is either seen here or followed by a wake-up message.
+  ResourceBufferControl* control = buffer_->GetControl();
+  base::subtle::NoBarrier_Store(&control->producer_waiting, 1);
+  base::subtle::MemoryBarrier();
+  RecycleReleasedData();
+  if (!buffer_->CanAllocate())
+    return false;
+
+  // A wake-up message may still arrive, which is harmless.
+  base::subtle::NoBarrier_Store(&control->producer_waiting, 0);
+  return true;
+}
+
 void AsyncResourceHandler::ResumeIfDeferred() {
   if (did_defer_) {
     did_defer_ = false;
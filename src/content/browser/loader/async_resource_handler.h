@@ -61,11 +61,19 @@ class AsyncResourceHandler : public ResourceHandler,
   // IPC message handlers:
   void OnFollowRedirect(int request_id);
   void OnDataReceivedACK(int request_id);
+  void OnDataBufferReleased(int request_id);
   void OnUploadProgressACK(int request_id);
 
   void ReportUploadProgress();
 
   bool EnsureResourceBufferIsInitialized();
+  // Recycles the data the renderer released through the ResourceBufferControl
+  buffer_|buffer_|.
+  void RecycleReleasedData();
+  // Returns true if |buffer_| has space left, possibly after recycling data
+  // the renderer released. Otherwise asks the renderer to send a
+  // DataBufferReleased message once it releases data, and returns false.
+  bool WaitForSpaceIfNeeded();
   void ResumeIfDeferred();
   void OnDefer();
   bool CheckForSufficientResource();
@@ -79,6 +87,10 @@ class AsyncResourceHandler : public ResourceHandler,
   // ACK for. This allows us to avoid having too many messages in flight.
   int pending_data_count_;
 
+  // The value of the |tail| of the ResourceBufferControl of |buffer_| when
+  // data was last recycled.
+  uint32_t control_tail_;
+
   int allocation_size_;
 
   bool did_defer_;
@@ -54,7 +54,14 @@ bool ResourceBuffer::Initialize(int buffer_size,
   min_alloc_size_ = min_allocation_size;
   max_alloc_size_ = max_allocation_size;
 
-  return shared_mem_.CreateAndMapAnonymous(buf_size_);
+  if (!shared_mem_.CreateAndMapAnonymous(buf_size_ +
+                                         sizeof(ResourceBufferControl))) {
+    return false;
+  }
+  ResourceBufferControl* control = GetControl();
+  base::subtle::NoBarrier_Store(&control->tail, 0);
+  base::subtle::NoBarrier_Store(&control->producer_waiting, 0);
+  return true;
 }
 
 bool ResourceBuffer::IsInitialized() const {
@@ -66,6 +73,17 @@ base::SharedMemory& ResourceBuffer::GetSharedMemory() {
   return shared_mem_;
 }
 
+int ResourceBuffer::GetBufferSize() const {
+  CHECK(IsInitialized());
+  return buf_size_;
+}
+
+ResourceBufferControl* ResourceBuffer::GetControl() {
+  CHECK(IsInitialized());
+  return reinterpret_cast<ResourceBufferControl*>(
+      static_cast<char*>(shared_mem_.memory()) + buf_size_);
+}
+
 bool ResourceBuffer::CanAllocate() const {
   CHECK(IsInitialized());
 
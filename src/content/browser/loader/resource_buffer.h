@@ -11,6 +11,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/shared_memory.h"
 #include "content/common/content_export.h"
+#include "content/common/resource_buffer_control.h"
 
 namespace content {
 
@@ -61,11 +62,11 @@ class CONTENT_EXPORT ResourceBuffer
   ResourceBuffer();
 
   // Initialize the shared memory buffer.  It will be buffer_size bytes in
-  // length.  The min/max_allocation_size parameters control the behavior of
-  // the Allocate method.  It will prefer to return segments that are
-  // max_allocation_size in length, but will return segments less than that if
-  // space is limited.  It will not return allocations smaller than
-  // min_allocation_size.
+  // length, followed by a ResourceBufferControl.  The min/max_allocation_size
+  // parameters control the behavior of the Allocate method.  It will prefer to
+  // return segments that are max_allocation_size in length, but will return
+  // segments less than that if space is limited.  It will not return
+  // allocations smaller than min_allocation_size.
   bool Initialize(int buffer_size,
                   int min_allocation_size,
                   int max_allocation_size);
@@ -74,6 +75,14 @@ class CONTENT_EXPORT ResourceBuffer
   // Returns a reference to the underlying shared memory.
   base::SharedMemory& GetSharedMemory();
 
+  // Returns the size of the data in the shared memory, which excludes the
+  // ResourceBufferControl.
+  int GetBufferSize() const;
+
+  // Returns the ResourceBufferControl that follows the data in the shared
+  // memory.
+  ResourceBufferControl* GetControl();
+
   // Returns true if Allocate will succeed.
   bool CanAllocate() const;
 
@@ -5,6 +5,7 @@
 #include "content/browser/loader/resource_scheduler.h"
 
 #include <stdint.h>
+#include <algorithm>
 #include <set>
 #include <string>
 #include <utility>
@@ -16,6 +17,7 @@
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
 #include "base/supports_user_data.h"
 #include "content/common/resource_messages.h"
 #include "content/public/browser/resource_controller.h"
@@ -25,6 +27,7 @@
 #include "net/base/load_flags.h"
 #include "net/base/request_priority.h"
 #include "net/http/http_server_properties.h"
+#include "net/nqe/network_quality_estimator.h"
 #include "net/url_request/url_request.h"
 #include "net/url_request/url_request_context.h"
 #include "url/scheme_host_port.h"
@@ -42,6 +45,21 @@ enum StartMode {
 const char kRequestLimitFieldTrial[] = "OutstandingRequestLimiting";
 const char kRequestLimitFieldTrialGroupPrefix[] = "Limit";
 
+// Field trial that makes the limit on in-flight delayable requests per client
+// depend on the effective connection type estimated from the RTT and
+// throughput observed by the NetworkQualityEstimator. Its group name is
+// "Enabled", optionally followed by limits that override the defaults below
+// for some connection types, as in "Enabled_Slow2G=1_4G=20".
+const char kNetworkQualityFieldTrial[] = "ResourceSchedulerNetworkQuality";
+const char kNetworkQualityFieldTrialEnabledGroup[] = "Enabled";
+
+// How long an effective connection type read from a NetworkQualityEstimator
+// is used before it is read again.
+const int kEffectiveConnectionTypeCacheSeconds = 1;
+
+using EffectiveConnectionType =
+    net::NetworkQualityEstimator::EffectiveConnectionType;
+
 // Flags identifying various attributes of the request that are used
 // when making scheduling decisions.
 using RequestAttributes = uint8_t;
@@ -60,6 +78,22 @@ static const size_t kMaxNumDelayableRequestsPerClient = 10;
 // host.
 static const size_t kMaxNumDelayableRequestsPerHostPerClient = 6;
 
+// The default limits on in-flight delayable requests per client used by the
+// kNetworkQualityFieldTrial. Slow links get fewer concurrent delayable
+// requests, so that they don't compete for bandwidth with the requests that
+// block rendering. Fast links get more. Types that aren't listed use
+// kMaxNumDelayableRequestsPerClient.
+static const struct {
+  EffectiveConnectionType type;
+  size_t max_delayable_requests;
+} kNetworkQualityDelayableRequestLimits[] = {
+    {net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_SLOW_2G, 2},
+    {net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_2G, 4},
+    {net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_3G, 8},
+    {net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_4G, 16},
+    {net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_BROADBAND, 20},
+};
+
 // The maximum number of delayable requests to allow to be in-flight at any
 // point in time while in the layout-blocking phase of loading.
 static const size_t kMaxNumDelayableWhileLayoutBlockingPerClient = 1;
@@ -533,8 +567,8 @@ class ResourceScheduler::Client {
     return attributes;
   }
 
-  bool ShouldKeepSearching(
-      const net::HostPortPair& active_request_host) const {
+  bool ShouldKeepSearching(const net::HostPortPair& active_request_host,
+                           size_t max_delayable_requests_per_host) const {
     size_t same_host_count = 0;
     for (RequestSet::const_iterator it = in_flight_requests_.begin();
          it != in_flight_requests_.end(); ++it) {
@@ -542,7 +576,7 @@ class ResourceScheduler::Client {
           net::HostPortPair::FromURL((*it)->url_request()->url());
       if (active_request_host.Equals(host_port_pair)) {
         same_host_count++;
-        if (same_host_count >= kMaxNumDelayableRequestsPerHostPerClient)
+        if (same_host_count >= max_delayable_requests_per_host)
           return true;
       }
     }
@@ -589,8 +623,11 @@ class ResourceScheduler::Client {
   //     if there's an outstanding request limit in place).
   //   * If no high priority or layout-blocking requests are in flight, start
   //     loading delayable requests.
-  //   * Never exceed 10 delayable requests in flight per client.
-  //   * Never exceed 6 delayable requests for a given host.
+  //   * Never exceed 10 delayable requests in flight per client, or the limit
+  //     for the effective connection type if the kNetworkQualityFieldTrial is
+  //     enabled.
+  //   * Never exceed 6 delayable requests for a given host, or the limit per
+  //     client if it's lower.
 
   ShouldStartReqResult ShouldStartRequest(
       ScheduledResourceRequest* request) const {
@@ -630,10 +667,14 @@ class ResourceScheduler::Client {
     if (!RequestAttributesAreSet(request->attributes(), kAttributeDelayable))
       return START_REQUEST;
 
-    if (in_flight_delayable_count_ >= kMaxNumDelayableRequestsPerClient)
+    size_t max_delayable_requests =
+        scheduler_->GetMaxDelayableRequests(url_request);
+    if (in_flight_delayable_count_ >= max_delayable_requests)
       return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
 
-    if (ShouldKeepSearching(host_port_pair)) {
+    size_t max_delayable_requests_per_host = std::min(
+        max_delayable_requests, kMaxNumDelayableRequestsPerHostPerClient);
+    if (ShouldKeepSearching(host_port_pair, max_delayable_requests_per_host)) {
       // There may be other requests for other hosts that may be allowed,
       // so keep checking.
       return DO_NOT_START_REQUEST_AND_KEEP_SEARCHING;
@@ -720,7 +761,10 @@ class ResourceScheduler::Client {
 
 ResourceScheduler::ResourceScheduler()
     : limit_outstanding_requests_(false),
-      outstanding_request_limit_(0) {
+      outstanding_request_limit_(0),
+      max_num_delayable_requests_(kMaxNumDelayableRequestsPerClient),
+      cached_effective_connection_type_(
+          net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_UNKNOWN) {
   std::string outstanding_limit_trial_group =
       base::FieldTrialList::FindFullName(kRequestLimitFieldTrial);
   std::vector<std::string> split_group(
@@ -734,6 +778,9 @@ ResourceScheduler::ResourceScheduler()
     limit_outstanding_requests_ = true;
     outstanding_request_limit_ = outstanding_limit;
   }
+
+  InitializeNetworkQualityLimits(
+      base::FieldTrialList::FindFullName(kNetworkQualityFieldTrial));
 }
 
 ResourceScheduler::~ResourceScheduler() {
@@ -924,6 +971,59 @@ void ResourceScheduler::ReprioritizeRequest(net::URLRequest* request,
                               new_priority_params);
 }
 
+size_t ResourceScheduler::GetMaxDelayableRequests(
+    const net::URLRequest& url_request) {
+  net::NetworkQualityEstimator* estimator =
+      url_request.context()->network_quality_estimator();
+  if (max_delayable_requests_for_type_.empty() || !estimator)
+    return max_num_delayable_requests();
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (effective_connection_type_read_time_.is_null() ||
+      now - effective_connection_type_read_time_ >
+          base::TimeDelta::FromSeconds(kEffectiveConnectionTypeCacheSeconds)) {
+    cached_effective_connection_type_ = estimator->GetEffectiveConnectionType();
+    effective_connection_type_read_time_ = now;
+  }
+  return max_delayable_requests_for_type_[cached_effective_connection_type_];
+}
+
+void ResourceScheduler::InitializeNetworkQualityLimits(
+    const std::string& group_name) {
+  std::vector<std::string> split_group(base::SplitString(
+      group_name, "_", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY));
+  if (split_group.empty() ||
+      split_group[0] != kNetworkQualityFieldTrialEnabledGroup) {
+    return;
+  }
+
+  max_delayable_requests_for_type_.assign(
+      net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_LAST,
+      max_num_delayable_requests());
+  for (const auto& limit : kNetworkQualityDelayableRequestLimits)
+    max_delayable_requests_for_type_[limit.type] = limit.max_delayable_requests;
+
+  // Apply the overrides, ignoring any that can't be parsed.
+  for (size_t i = 1; i < split_group.size(); ++i) {
+    std::vector<std::string> type_and_limit(
+        base::SplitString(split_group[i], "=", base::TRIM_WHITESPACE,
+                          base::SPLIT_WANT_ALL));
+    unsigned limit = 0;
+    if (type_and_limit.size() != 2 ||
+        !base::StringToUint(type_and_limit[1], &limit) || limit == 0) {
+      continue;
+    }
+    for (size_t type = 0; type < max_delayable_requests_for_type_.size();
+         ++type) {
+      if (type_and_limit[0] ==
+          net::NetworkQualityEstimator::GetNameForEffectiveConnectionType(
+              static_cast<EffectiveConnectionType>(type))) {
+        max_delayable_requests_for_type_[type] = limit;
+      }
+    }
+  }
+}
+
 ResourceScheduler::ClientId ResourceScheduler::MakeClientId(
     int child_id, int route_id) {
   return (static_cast<ResourceScheduler::ClientId>(child_id) << 32) | route_id;
@@ -11,13 +11,17 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "base/threading/non_thread_safe.h"
+#include "base/time/time.h"
 #include "content/common/content_export.h"
 #include "net/base/priority_queue.h"
 #include "net/base/request_priority.h"
+#include "net/nqe/network_quality_estimator.h"
 
 namespace net {
 class HostPortPair;
@@ -122,6 +126,16 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
     return max_num_delayable_requests_;
   }
 
+  // Returns the maximum number of delayable requests of a client to be
+  // in-flight at any point in time (across all hosts), given the quality of
+  // the network |url_request| is made on. This is max_num_delayable_requests()
+  // unless the kNetworkQualityFieldTrial is enabled.
+  size_t GetMaxDelayableRequests(const net::URLRequest& url_request);
+
+  // Parses the group name of the kNetworkQualityFieldTrial into
+  // |max_delayable_requests_for_type_|.
+  void InitializeNetworkQualityLimits(const std::string& group_name);
+
   class RequestQueue;
   class ScheduledResourceRequest;
   struct RequestPriorityParams;
@@ -150,6 +164,15 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   size_t max_num_delayable_requests_;
   RequestSet unowned_requests_;
 
+  // The limit on delayable requests per client for each effective connection
+  // type, indexed by type. Empty if the kNetworkQualityFieldTrial is disabled.
+  std::vector<size_t> max_delayable_requests_for_type_;
+  // The effective connection type last read from a NetworkQualityEstimator,
+  // and when it was read. It is read again once it is older than a second.
+  net::NetworkQualityEstimator::EffectiveConnectionType
+      cached_effective_connection_type_;
+  base::TimeTicks effective_connection_type_read_time_;
+
   DISALLOW_COPY_AND_ASSIGN(ResourceScheduler);
 };
 
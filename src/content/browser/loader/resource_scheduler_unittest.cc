@@ -27,6 +27,7 @@
 #include "net/base/host_port_pair.h"
 #include "net/base/request_priority.h"
 #include "net/http/http_server_properties_impl.h"
+#include "net/nqe/network_quality_estimator.h"
 #include "net/url_request/url_request.h"
 #include "net/url_request/url_request_test_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -124,6 +125,31 @@ class FakeResourceContext : public ResourceContext {
   net::URLRequestContext* GetRequestContext() override { return NULL; }
 };
 
+class TestNetworkQualityEstimator : public net::NetworkQualityEstimator {
+ public:
+  TestNetworkQualityEstimator()
+      : net::NetworkQualityEstimator(nullptr,
+                                     std::map<std::string, std::string>()),
+        type_(net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_UNKNOWN) {
+  }
+  ~TestNetworkQualityEstimator() override {}
+
+  net::NetworkQualityEstimator::EffectiveConnectionType
+  GetEffectiveConnectionType() const override {
+    return type_;
+  }
+
+  void set_effective_connection_type(
+      net::NetworkQualityEstimator::EffectiveConnectionType type) {
+    type_ = type;
+  }
+
+ private:
+  net::NetworkQualityEstimator::EffectiveConnectionType type_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestNetworkQualityEstimator);
+};
+
 class ResourceSchedulerTest : public testing::Test {
  protected:
   ResourceSchedulerTest()
@@ -243,6 +269,25 @@ class ResourceSchedulerTest : public testing::Test {
     request->ChangePriority(new_priority, intra_priority);
   }
 
+  // Makes requests estimate the effective connection type |type|.
+  void SetEffectiveConnectionType(
+      net::NetworkQualityEstimator::EffectiveConnectionType type) {
+    network_quality_estimator_.set_effective_connection_type(type);
+    context_.set_network_quality_estimator(&network_quality_estimator_);
+  }
+
+  // Starts delayable requests to different hosts until one isn't started, and
+  // returns the number of requests that were started.
+  size_t CountStartableDelayableRequests(ScopedVector<TestRequest>* requests) {
+    for (size_t i = 0; i < 100; ++i) {
+      std::string url = "http://host" + base::SizeTToString(i) + "/low";
+      requests->push_back(NewRequest(url.c_str(), net::LOWEST));
+      if (!requests->back()->started())
+        return i;
+    }
+    return requests->size();
+  }
+
   void FireCoalescingTimer() {
     EXPECT_TRUE(mock_timer_->IsRunning());
     mock_timer_->Fire();
@@ -260,6 +305,7 @@ class ResourceSchedulerTest : public testing::Test {
   base::FieldTrialList field_trial_list_;
   base::MockTimer* mock_timer_;
   net::HttpServerPropertiesImpl http_server_properties_;
+  TestNetworkQualityEstimator network_quality_estimator_;
   net::TestURLRequestContext context_;
 };
 
@@ -767,6 +813,56 @@ TEST_F(ResourceSchedulerTest, OustandingRequestLimitEnforced) {
   // Async revalidations which are not started when the tab is closed must be
 // started at some point, or they will hang around forever and prevent other
 // async revalidations to the same URL from being issued.
+TEST_F(ResourceSchedulerTest, NetworkQualityIgnoredByDefault) {
+  SetEffectiveConnectionType(
+      net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_SLOW_2G);
+  scheduler()->OnWillInsertBody(kChildId, kRouteId);
+
+  const size_t kMaxNumDelayableRequestsPerClient = 10;  // Should match the .cc.
+  ScopedVector<TestRequest> requests;
+  EXPECT_EQ(kMaxNumDelayableRequestsPerClient,
+            CountStartableDelayableRequests(&requests));
+}
+
+TEST_F(ResourceSchedulerTest, NetworkQualityThrottlesSlowLinks) {
+  ASSERT_TRUE(
+      InitializeFieldTrials("ResourceSchedulerNetworkQuality/Enabled/"));
+  InitializeScheduler();
+  SetEffectiveConnectionType(
+      net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_SLOW_2G);
+  scheduler()->OnWillInsertBody(kChildId, kRouteId);
+
+  const size_t kSlow2GLimit = 2;  // Should match the .cc.
+  ScopedVector<TestRequest> requests;
+  EXPECT_EQ(kSlow2GLimit, CountStartableDelayableRequests(&requests));
+
+  // Finishing a request lets the next one start.
+  TestRequest* pending = requests.back();
+  requests.erase(requests.begin());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(pending->started());
+}
+
+TEST_F(ResourceSchedulerTest, NetworkQualityLimitsUseFieldTrialOverrides) {
+  ASSERT_TRUE(InitializeFieldTrials(
+      "ResourceSchedulerNetworkQuality/Enabled_Slow2G=1_4G=12/"));
+  InitializeScheduler();
+  SetEffectiveConnectionType(
+      net::NetworkQualityEstimator::EFFECTIVE_CONNECTION_TYPE_4G);
+  scheduler()->OnWillInsertBody(kChildId, kRouteId);
+
+  ScopedVector<TestRequest> requests;
+  EXPECT_EQ(12u, CountStartableDelayableRequests(&requests));
+
+  // The per-host limit still applies on fast links.
+  const size_t kMaxNumDelayableRequestsPerHost = 6;  // Should match the .cc.
+  requests.clear();
+  for (size_t i = 0; i <= kMaxNumDelayableRequestsPerHost; ++i)
+    requests.push_back(NewRequest("http://host/low", net::LOWEST));
+  EXPECT_TRUE(requests[kMaxNumDelayableRequestsPerHost - 1]->started());
+  EXPECT_FALSE(requests[kMaxNumDelayableRequestsPerHost]->started());
+}
+
 TEST_F(ResourceSchedulerTest, RequestStartedAfterClientDeleted) {
   scheduler_->OnClientCreated(kChildId2, kRouteId2);
   std::unique_ptr<TestRequest> high(NewRequestWithChildAndRoute(
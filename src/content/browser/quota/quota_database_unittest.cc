@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <iterator>
 #include <set>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/callback.h"
@@ -27,6 +28,7 @@
 
 using storage::kStorageTypePersistent;
 using storage::kStorageTypeTemporary;
+using storage::QuotaClient;
 using storage::QuotaDatabase;
 
 namespace content {
@@ -81,6 +83,69 @@ class QuotaDatabaseTest : public testing::Test {
 
     EXPECT_TRUE(db.db_->DoesTableExist("EvictionInfoTable"));
     EXPECT_TRUE(db.db_->DoesIndexExist("sqlite_autoindex_EvictionInfoTable_1"));
+    EXPECT_TRUE(db.db_->DoesTableExist("OriginUsageTable"));
+  }
+
+  void OriginUsage(const base::FilePath& kDbFile) {
+    typedef QuotaDatabase::OriginUsageTableEntry Entry;
+    QuotaDatabase db(kDbFile);
+    ASSERT_TRUE(db.LazyOpen(true));
+
+    const GURL kOrigin1("http://a/");
+    const GURL kOrigin2("http://b/");
+
+    std::vector<Entry> entries;
+    EXPECT_TRUE(db.GetOriginUsages(&entries));
+    EXPECT_TRUE(entries.empty());
+
+    std::vector<Entry> updates;
+    updates.push_back(Entry(kOrigin1, kStorageTypeTemporary,
+                            QuotaClient::kFileSystem, 10));
+    updates.push_back(Entry(kOrigin1, kStorageTypeTemporary,
+                            QuotaClient::kDatabase, 20));
+    updates.push_back(Entry(kOrigin2, kStorageTypePersistent,
+                            QuotaClient::kFileSystem, 30));
+    EXPECT_TRUE(db.SetOriginUsages(updates));
+
+    EXPECT_TRUE(db.GetOriginUsages(&entries));
+    ASSERT_EQ(3U, entries.size());
+    int64_t total = 0;
+    for (const auto& entry : entries)
+      total += entry.usage;
+    EXPECT_EQ(60, total);
+
+    // A new value replaces the old one, and zero usage removes the row.
+    updates.clear();
+    updates.push_back(Entry(kOrigin1, kStorageTypeTemporary,
+                            QuotaClient::kFileSystem, 15));
+    updates.push_back(Entry(kOrigin1, kStorageTypeTemporary,
+                            QuotaClient::kDatabase, 0));
+    EXPECT_TRUE(db.SetOriginUsages(updates));
+
+    EXPECT_TRUE(db.GetOriginUsages(&entries));
+    ASSERT_EQ(2U, entries.size());
+    for (const auto& entry : entries) {
+      if (entry.origin == kOrigin1) {
+        EXPECT_EQ(kStorageTypeTemporary, entry.type);
+        EXPECT_EQ(QuotaClient::kFileSystem, entry.client_id);
+        EXPECT_EQ(15, entry.usage);
+      } else {
+        EXPECT_EQ(kOrigin2, entry.origin);
+        EXPECT_EQ(kStorageTypePersistent, entry.type);
+        EXPECT_EQ(30, entry.usage);
+      }
+    }
+
+    int client_mask = 0;
+    EXPECT_FALSE(
+        db.GetCompleteUsageCacheClients(kStorageTypeTemporary, &client_mask));
+    EXPECT_TRUE(db.SetCompleteUsageCacheClients(kStorageTypeTemporary,
+                                                QuotaClient::kFileSystem));
+    EXPECT_TRUE(
+        db.GetCompleteUsageCacheClients(kStorageTypeTemporary, &client_mask));
+    EXPECT_EQ(QuotaClient::kFileSystem, client_mask);
+    EXPECT_FALSE(
+        db.GetCompleteUsageCacheClients(kStorageTypePersistent, &client_mask));
   }
 
   void HostQuota(const base::FilePath& kDbFile) {
@@ -639,6 +704,14 @@ TEST_F(QuotaDatabaseTest, OriginLastEvicted) {
   OriginLastEvicted(base::FilePath());
 }
 
+TEST_F(QuotaDatabaseTest, OriginUsage) {
+  base::ScopedTempDir data_dir;
+  ASSERT_TRUE(data_dir.CreateUniqueTempDir());
+  const base::FilePath kDbFile = data_dir.path().AppendASCII(kDBFileName);
+  OriginUsage(kDbFile);
+  OriginUsage(base::FilePath());
+}
+
 TEST_F(QuotaDatabaseTest, BootstrapFlag) {
   base::ScopedTempDir data_dir;
   ASSERT_TRUE(data_dir.CreateUniqueTempDir());
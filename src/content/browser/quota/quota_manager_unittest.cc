@@ -163,6 +163,10 @@ class QuotaManagerTest : public testing::Test {
                                  weak_factory_.GetWeakPtr()));
   }
 
+  void ReconcileUsageCache() {
+    quota_manager_->ReconcileUsageCache();
+  }
+
   void GetUsageAndQuotaForStorageClient(const GURL& origin,
                                         StorageType type) {
     quota_status_ = kQuotaStatusUnknown;
@@ -772,6 +776,46 @@ TEST_F(QuotaManagerTest, GetTemporaryUsage_WithModify) {
   GetUsage_WithModifyTestBody(kTemp);
 }
 
+TEST_F(QuotaManagerTest, UsageCachePersistsAcrossRestart) {
+  static const MockOriginData kData[] = {
+    { "http://foo.com/", kTemp, 10 },
+  };
+  MockStorageClient* client = CreateClient(kData, arraysize(kData),
+      QuotaClient::kFileSystem);
+  RegisterClient(client);
+
+  GetUsageAndQuotaForWebApps(GURL("http://foo.com/"), kTemp);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(kQuotaStatusOk, status());
+  EXPECT_EQ(10, usage());
+
+  client->ModifyOriginAndNotify(GURL("http://foo.com/"), kTemp, 5);
+
+  // Destroying the manager writes the modified usage back.
+  ResetQuotaManager(false /* is_incognito */);
+  base::RunLoop().RunUntilIdle();
+
+  // The new client reports different usage, but the first query is answered
+  // from the persisted cache until the cache is reconciled.
+  static const MockOriginData kRestartData[] = {
+    { "http://foo.com/", kTemp, 100 },
+  };
+  RegisterClient(CreateClient(kRestartData, arraysize(kRestartData),
+      QuotaClient::kFileSystem));
+
+  GetUsageAndQuotaForWebApps(GURL("http://foo.com/"), kTemp);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(kQuotaStatusOk, status());
+  EXPECT_EQ(15, usage());
+
+  ReconcileUsageCache();
+  base::RunLoop().RunUntilIdle();
+  GetUsageAndQuotaForWebApps(GURL("http://foo.com/"), kTemp);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(kQuotaStatusOk, status());
+  EXPECT_EQ(100, usage());
+}
+
 TEST_F(QuotaManagerTest, GetTemporaryUsageAndQuota_WithAdditionalTasks) {
   static const MockOriginData kData[] = {
     { "http://foo.com/",        kTemp, 10 },
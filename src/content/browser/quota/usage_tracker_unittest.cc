@@ -4,6 +4,8 @@
 
 #include <stdint.h>
 
+#include <map>
+
 #include "base/bind.h"
 #include "base/location.h"
 #include "base/macros.h"
@@ -12,11 +14,13 @@
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/public/test/mock_special_storage_policy.h"
 #include "net/base/url_util.h"
+#include "storage/browser/quota/client_usage_tracker.h"
 #include "storage/browser/quota/usage_tracker.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 using storage::kQuotaStatusOk;
 using storage::kStorageTypeTemporary;
+using storage::ClientUsageTracker;
 using storage::QuotaClient;
 using storage::QuotaClientList;
 using storage::SpecialStoragePolicy;
@@ -198,6 +202,10 @@ class UsageTrackerTest : public testing::Test {
         quota_client_.id(), origin, enabled);
   }
 
+  ClientUsageTracker* client_tracker() {
+    return usage_tracker_.GetClientTracker(quota_client_.id());
+  }
+
  private:
   QuotaClientList GetUsageTrackerList() {
     QuotaClientList client_list;
@@ -334,5 +342,54 @@ TEST_F(UsageTrackerTest, LimitedGlobalUsageTest) {
   EXPECT_EQ(2 + 32, unlimited_usage);
 }
 
+TEST_F(UsageTrackerTest, SeededUsageCache) {
+  const GURL kOrigin("http://example.com");
+  const GURL kRemovedOrigin("http://removed.com");
+  const std::string host(net::GetHostOrSpecFromURL(kOrigin));
+
+  // The client holds more than the snapshot knows about.
+  UpdateUsageWithoutNotification(kOrigin, 300);
+
+  std::map<GURL, int64_t> snapshot;
+  snapshot[kOrigin] = 100;
+  snapshot[kRemovedOrigin] = 50;
+  client_tracker()->SeedUsageCache(snapshot, true);
+
+  // Seeded values are answered without asking the client and are not dirty.
+  int64_t usage = 0;
+  int64_t unlimited_usage = 0;
+  int64_t host_usage = 0;
+  GetHostUsage(host, &host_usage);
+  GetGlobalUsage(&usage, &unlimited_usage);
+  EXPECT_EQ(100, host_usage);
+  EXPECT_EQ(150, usage);
+
+  std::map<GURL, int64_t> dirty;
+  client_tracker()->TakeDirtyOriginsUsage(&dirty);
+  EXPECT_TRUE(dirty.empty());
+
+  // Modifications are tracked incrementally on top of the seeded value.
+  UpdateUsage(kOrigin, 10);
+  client_tracker()->TakeDirtyOriginsUsage(&dirty);
+  ASSERT_EQ(1U, dirty.size());
+  EXPECT_EQ(110, dirty[kOrigin]);
+  dirty.clear();
+  client_tracker()->TakeDirtyOriginsUsage(&dirty);
+  EXPECT_TRUE(dirty.empty());
+
+  // Reconciling picks up the client's actual usage and drops the origin the
+  // client no longer has.
+  client_tracker()->ReconcileUsageCache();
+  base::RunLoop().RunUntilIdle();
+  GetHostUsage(host, &host_usage);
+  GetGlobalUsage(&usage, &unlimited_usage);
+  EXPECT_EQ(310, host_usage);
+  EXPECT_EQ(310, usage);
+
+  client_tracker()->TakeDirtyOriginsUsage(&dirty);
+  ASSERT_EQ(2U, dirty.size());
+  EXPECT_EQ(310, dirty[kOrigin]);
+  EXPECT_EQ(0, dirty[kRemovedOrigin]);
+}
 
 }  // namespace content
@@ -24,6 +24,7 @@
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/shared_memory.h"
 #include "base/memory/shared_memory_handle.h"
 #include "base/metrics/histogram.h"
@@ -128,6 +129,7 @@
 #include "content/common/content_switches_internal.h"
 #include "content/common/frame_messages.h"
 #include "content/common/gpu_host_messages.h"
+#include "content/common/host_discardable_shared_memory_manager.h"
 #include "content/common/in_process_child_thread_params.h"
 #include "content/common/mojo/mojo_shell_connection_impl.h"
 #include "content/common/render_process_messages.h"
@@ -452,6 +454,106 @@ std::string UintVectorToString(const std::vector<unsigned>& vector) {
   return str;
 }
 
+// Keeps renderer processes that were launched ahead of time, until a
+// SiteInstance takes one over or they are discarded.
+class SpareRenderProcessHosts : public RenderProcessHostObserver {
+ public:
+  SpareRenderProcessHosts()
+      : memory_pressure_listener_(
+            base::Bind(&SpareRenderProcessHosts::OnMemoryPressure,
+                       base::Unretained(this))) {}
+  ~SpareRenderProcessHosts() override {}
+
+  void Warmup(BrowserContext* browser_context, size_t count) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    if (RenderProcessHost::run_renderer_in_process())
+      return;
+    size_t spare_count = 0;
+    for (RenderProcessHost* host : hosts_) {
+      if (host->GetBrowserContext() == browser_context)
+        ++spare_count;
+    }
+    StoragePartitionImpl* partition = static_cast<StoragePartitionImpl*>(
+        BrowserContext::GetDefaultStoragePartition(browser_context));
+    for (; spare_count < count; ++spare_count) {
+      RenderProcessHost* host =
+          new RenderProcessHostImpl(browser_context, partition, false);
+      if (!host->Init()) {
+        host->Cleanup();
+        return;
+      }
+      host->AddObserver(this);
+      hosts_.push_back(host);
+    }
+  }
+
+  RenderProcessHost* Take(BrowserContext* browser_context,
+                          const GURL& site_url) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    for (auto it = hosts_.begin(); it != hosts_.end(); ++it) {
+      RenderProcessHost* host = *it;
+      if (RenderProcessHostImpl::IsSuitableHost(host, browser_context,
+                                                site_url)) {
+        host->RemoveObserver(this);
+        hosts_.erase(it);
+        return host;
+      }
+    }
+    return nullptr;
+  }
+
+  bool Contains(RenderProcessHost* host) const {
+    return std::find(hosts_.begin(), hosts_.end(), host) != hosts_.end();
+  }
+
+  void DiscardAll() {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    std::vector<RenderProcessHost*> hosts;
+    hosts.swap(hosts_);
+    for (RenderProcessHost* host : hosts) {
+      host->RemoveObserver(this);
+      host->Cleanup();
+    }
+  }
+
+  // RenderProcessHostObserver:
+  void RenderProcessExited(RenderProcessHost* host,
+                           base::TerminationStatus status,
+                           int exit_code) override {
+    // A spare that died would only be relaunched by whoever takes it over,
+    // which defeats the point of having it.
+    Remove(host);
+    host->Cleanup();
+  }
+
+  void RenderProcessHostDestroyed(RenderProcessHost* host) override {
+    Remove(host);
+  }
+
+ private:
+  void Remove(RenderProcessHost* host) {
+    auto it = std::find(hosts_.begin(), hosts_.end(), host);
+    if (it == hosts_.end())
+      return;
+    host->RemoveObserver(this);
+    hosts_.erase(it);
+  }
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level) {
+    if (level != base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+      DiscardAll();
+  }
+
+  std::vector<RenderProcessHost*> hosts_;
+  base::MemoryPressureListener memory_pressure_listener_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpareRenderProcessHosts);
+};
+
+base::LazyInstance<SpareRenderProcessHosts>::Leaky g_spare_hosts =
+    LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 RendererMainThreadFactoryFunction g_renderer_main_thread_factory = NULL;
@@ -1517,6 +1619,8 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     cc::switches::kEnableBeginFrameScheduling,
     cc::switches::kEnableGpuBenchmarking,
     cc::switches::kEnableLayerLists,
+    cc::switches::kEnablePredictiveBeginFrameDeadline,
+    cc::switches::kEnableStableTileCompression,
     cc::switches::kEnableTileCompression,
     cc::switches::kShowCompositedLayerBorders,
     cc::switches::kShowFPSCounter,
@@ -1529,6 +1633,7 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     cc::switches::kTopControlsHideThreshold,
     cc::switches::kTopControlsShowThreshold,
 
+    scheduler::switches::kBackgroundCPUTimeBudgetRecoveryRate,
     scheduler::switches::kDisableBackgroundTimerThrottling,
 
 #if defined(ENABLE_PLUGINS)
@@ -2285,7 +2390,9 @@ RenderProcessHost* RenderProcessHost::GetExistingProcessHost(
 
   iterator iter(AllHostsIterator());
   while (!iter.IsAtEnd()) {
-    if (GetContentClient()->browser()->MayReuseHost(iter.GetCurrentValue()) &&
+    // Spare processes are reserved for SiteInstances that need a new process.
+    if (!g_spare_hosts.Get().Contains(iter.GetCurrentValue()) &&
+        GetContentClient()->browser()->MayReuseHost(iter.GetCurrentValue()) &&
         RenderProcessHostImpl::IsSuitableHost(iter.GetCurrentValue(),
                                               browser_context, site_url)) {
       suitable_renderers.push_back(iter.GetCurrentValue());
@@ -2329,6 +2436,25 @@ bool RenderProcessHost::ShouldUseProcessPerSite(BrowserContext* browser_context,
                                                                 url);
 }
 
+// static
+void RenderProcessHost::WarmupSpareRenderProcessHosts(
+    BrowserContext* browser_context,
+    size_t count) {
+  g_spare_hosts.Get().Warmup(browser_context, count);
+}
+
+// static
+void RenderProcessHost::DiscardSpareRenderProcessHosts() {
+  g_spare_hosts.Get().DiscardAll();
+}
+
+// static
+RenderProcessHost* RenderProcessHostImpl::TakeSpareRenderProcessHost(
+    BrowserContext* browser_context,
+    const GURL& site_url) {
+  return g_spare_hosts.Get().Take(browser_context, site_url);
+}
+
 // static
 RenderProcessHost* RenderProcessHostImpl::GetProcessHostForSite(
     BrowserContext* browser_context,
@@ -2548,6 +2674,20 @@ void RenderProcessHostImpl::UpdateProcessPriority() {
       !base::CommandLine::ForCurrentProcess()->HasSwitch(
           switches::kDisableRendererBackgrounding);
 
+  // Let hidden processes give up their discardable memory first. This also
+  // tracks visibility changes which don't change the process priority.
+  HostDiscardableSharedMemoryManager::ProcessPriority discardable_priority =
+      HostDiscardableSharedMemoryManager::ProcessPriority::FOREGROUND;
+  if (should_background) {
+    discardable_priority =
+        HostDiscardableSharedMemoryManager::ProcessPriority::BACKGROUND;
+  } else if (visible_widgets_ == 0) {
+    discardable_priority =
+        HostDiscardableSharedMemoryManager::ProcessPriority::PERCEPTIBLE;
+  }
+  HostDiscardableSharedMemoryManager::current()->SetProcessPriority(
+      GetID(), discardable_priority);
+
 // TODO(sebsg): Remove this ifdef when https://crbug.com/537671 is fixed.
 #if !defined(OS_ANDROID)
   if (is_process_backgrounded_ == should_background)
@@ -217,6 +217,14 @@ class CONTENT_EXPORT RenderProcessHostImpl
                              BrowserContext* browser_context,
                              const GURL& site_url);
 
+  // Returns a spare RenderProcessHost started by
+  // WarmupSpareRenderProcessHosts() that is suitable for |site_url| in
+  // |browser_context|, removing it from the spares, or nullptr if there is
+  // none.
+  static RenderProcessHost* TakeSpareRenderProcessHost(
+      BrowserContext* browser_context,
+      const GURL& site_url);
+
   // Returns an existing RenderProcessHost for |url| in |browser_context|,
   // if one exists.  Otherwise a new RenderProcessHost should be created and
   // registered using RegisterProcessHostForSite().
@@ -1581,10 +1581,10 @@ bool RenderWidgetHostImpl::OnSwapCompositorFrame(
 
   latency_tracker_.OnSwapCompositorFrame(&frame.metadata.latency_info);
 
+  // Hand the frame to the view, which submits it to the display compositor,
+  // before acting on its metadata so that a slow metadata handler doesn't
+  // delay the frame.
   bool is_mobile_optimized = IsMobileOptimizedFrame(frame.metadata);
-  input_router_->NotifySiteIsMobileOptimized(is_mobile_optimized);
-  if (touch_emulator_)
-    touch_emulator_->SetDoubleTapSupportForPageEnabled(!is_mobile_optimized);
 
   if (view_) {
     view_->OnSwapCompositorFrame(output_surface_id, std::move(frame));
@@ -1601,6 +1601,10 @@ bool RenderWidgetHostImpl::OnSwapCompositorFrame(
                                process_->GetID(), ack);
   }
 
+  input_router_->NotifySiteIsMobileOptimized(is_mobile_optimized);
+  if (touch_emulator_)
+    touch_emulator_->SetDoubleTapSupportForPageEnabled(!is_mobile_optimized);
+
   RenderProcessHost* rph = GetProcess();
   for (std::vector<IPC::Message>::const_iterator i =
            messages_to_deliver_with_frame.begin();
@@ -153,8 +153,9 @@ void ServiceWorkerStorage::FindRegistrationForDocument(
   }
   DCHECK_EQ(INITIALIZED, state_);
 
-  // See if there are any stored registrations for the origin.
-  if (!ContainsKey(registered_origins_, document_url.GetOrigin())) {
+  // See if there are any stored registrations for the document.
+  int64_t registration_id = FindStoredRegistrationIdForDocument(document_url);
+  if (registration_id == kInvalidServiceWorkerRegistrationId) {
     // Look for something currently being installed.
     scoped_refptr<ServiceWorkerRegistration> installing_registration =
         FindInstallingRegistrationForDocument(document_url);
@@ -173,6 +174,13 @@ void ServiceWorkerStorage::FindRegistrationForDocument(
     return;
   }
 
+  scoped_refptr<ServiceWorkerRegistration> registration =
+      context_->GetLiveRegistration(registration_id);
+  if (registration) {
+    CompleteFindNow(registration, SERVICE_WORKER_OK, callback);
+    return;
+  }
+
   // To connect this TRACE_EVENT with the callback, TimeTicks is used for
   // callback id.
   int64_t callback_id = base::TimeTicks::Now().ToInternalValue();
@@ -184,10 +192,11 @@ void ServiceWorkerStorage::FindRegistrationForDocument(
   database_task_manager_->GetTaskRunner()->PostTask(
       FROM_HERE,
       base::Bind(
-          &FindForDocumentInDB,
+          &FindForIdInDB,
           database_.get(),
           base::ThreadTaskRunnerHandle::Get(),
-          document_url,
+          registration_id,
+          document_url.GetOrigin(),
           base::Bind(&ServiceWorkerStorage::DidFindRegistrationForDocument,
                      weak_factory_.GetWeakPtr(),
                      document_url,
@@ -209,8 +218,9 @@ void ServiceWorkerStorage::FindRegistrationForPattern(
   }
   DCHECK_EQ(INITIALIZED, state_);
 
-  // See if there are any stored registrations for the origin.
-  if (!ContainsKey(registered_origins_, scope.GetOrigin())) {
+  // See if there is a stored registration for the pattern.
+  int64_t registration_id = FindStoredRegistrationIdForPattern(scope);
+  if (registration_id == kInvalidServiceWorkerRegistrationId) {
     // Look for something currently being installed.
     scoped_refptr<ServiceWorkerRegistration> installing_registration =
         FindInstallingRegistrationForPattern(scope);
@@ -224,10 +234,11 @@ void ServiceWorkerStorage::FindRegistrationForPattern(
   database_task_manager_->GetTaskRunner()->PostTask(
       FROM_HERE,
       base::Bind(
-          &FindForPatternInDB,
+          &FindForIdInDB,
           database_.get(),
           base::ThreadTaskRunnerHandle::Get(),
-          scope,
+          registration_id,
+          scope.GetOrigin(),
           base::Bind(&ServiceWorkerStorage::DidFindRegistrationForPattern,
                      weak_factory_.GetWeakPtr(),
                      scope,
@@ -860,6 +871,7 @@ void ServiceWorkerStorage::DidReadInitialData(
     next_resource_id_ = data->next_resource_id;
     registered_origins_.swap(data->origins);
     foreign_fetch_origins_.swap(data->foreign_fetch_origins);
+    registered_scopes_.swap(data->scopes);
     state_ = INITIALIZED;
   } else {
     DVLOG(2) << "Failed to initialize: "
@@ -1098,6 +1110,7 @@ void ServiceWorkerStorage::DidStoreRegistration(
     return;
   }
   registered_origins_.insert(origin);
+  registered_scopes_[origin][new_version.scope] = new_version.registration_id;
   if (!new_version.foreign_fetch_scopes.empty())
     foreign_fetch_origins_.insert(origin);
 
@@ -1153,6 +1166,15 @@ void ServiceWorkerStorage::DidDeleteRegistration(
         storage::StorageType::kStorageTypeTemporary,
         -deleted_version.resources_total_size_bytes);
   }
+  RegistrationIdsByScope& scopes = registered_scopes_[params.origin];
+  for (auto it = scopes.begin(); it != scopes.end(); ++it) {
+    if (it->second == params.registration_id) {
+      scopes.erase(it);
+      break;
+    }
+  }
+  if (scopes.empty())
+    registered_scopes_.erase(params.origin);
   if (origin_state == OriginState::DELETE_FROM_ALL)
     registered_origins_.erase(params.origin);
   if (origin_state == OriginState::DELETE_FROM_ALL ||
@@ -1261,6 +1283,34 @@ ServiceWorkerStorage::GetOrCreateRegistration(
   return registration;
 }
 
+int64_t ServiceWorkerStorage::FindStoredRegistrationIdForDocument(
+    const GURL& document_url) {
+  DCHECK(!document_url.has_ref());
+
+  auto found = registered_scopes_.find(document_url.GetOrigin());
+  if (found == registered_scopes_.end())
+    return kInvalidServiceWorkerRegistrationId;
+
+  LongestScopeMatcher matcher(document_url);
+  int64_t match = kInvalidServiceWorkerRegistrationId;
+  for (const auto& scope_and_id : found->second)
+    if (matcher.MatchLongest(scope_and_id.first))
+      match = scope_and_id.second;
+  return match;
+}
+
+int64_t ServiceWorkerStorage::FindStoredRegistrationIdForPattern(
+    const GURL& scope) {
+  auto found = registered_scopes_.find(scope.GetOrigin());
+  if (found == registered_scopes_.end())
+    return kInvalidServiceWorkerRegistrationId;
+
+  auto found_scope = found->second.find(scope);
+  if (found_scope == found->second.end())
+    return kInvalidServiceWorkerRegistrationId;
+  return found_scope->second;
+}
+
 ServiceWorkerRegistration*
 ServiceWorkerStorage::FindInstallingRegistrationForDocument(
     const GURL& document_url) {
@@ -1502,6 +1552,18 @@ void ServiceWorkerStorage::ReadInitialDataFromDB(
 
   status = database->GetOriginsWithForeignFetchRegistrations(
       &data->foreign_fetch_origins);
+  if (status != ServiceWorkerDatabase::STATUS_OK) {
+    original_task_runner->PostTask(
+        FROM_HERE, base::Bind(callback, base::Passed(std::move(data)), status));
+    return;
+  }
+
+  RegistrationList registrations;
+  status = database->GetAllRegistrations(&registrations);
+  for (const auto& registration : registrations) {
+    data->scopes[registration.scope.GetOrigin()][registration.scope] =
+        registration.registration_id;
+  }
   original_task_runner->PostTask(
       FROM_HERE, base::Bind(callback, base::Passed(std::move(data)), status));
 }
@@ -1572,79 +1634,6 @@ void ServiceWorkerStorage::WriteRegistrationInDB(
                                             status));
 }
 
-void ServiceWorkerStorage::FindForDocumentInDB(
-    ServiceWorkerDatabase* database,
-    scoped_refptr<base::SequencedTaskRunner> original_task_runner,
-    const GURL& document_url,
-    const FindInDBCallback& callback) {
-  GURL origin = document_url.GetOrigin();
-  RegistrationList registration_data_list;
-  ServiceWorkerDatabase::Status status = database->GetRegistrationsForOrigin(
-      origin, &registration_data_list, nullptr);
-  if (status != ServiceWorkerDatabase::STATUS_OK) {
-    original_task_runner->PostTask(
-        FROM_HERE,
-        base::Bind(callback,
-                   ServiceWorkerDatabase::RegistrationData(),
-                   ResourceList(),
-                   status));
-    return;
-  }
-
-  ServiceWorkerDatabase::RegistrationData data;
-  ResourceList resources;
-  status = ServiceWorkerDatabase::STATUS_ERROR_NOT_FOUND;
-
-  // Find one with a pattern match.
-  LongestScopeMatcher matcher(document_url);
-  int64_t match = kInvalidServiceWorkerRegistrationId;
-  for (const auto& registration_data : registration_data_list)
-    if (matcher.MatchLongest(registration_data.scope))
-      match = registration_data.registration_id;
-  if (match != kInvalidServiceWorkerRegistrationId)
-    status = database->ReadRegistration(match, origin, &data, &resources);
-
-  original_task_runner->PostTask(
-      FROM_HERE,
-      base::Bind(callback, data, resources, status));
-}
-
-void ServiceWorkerStorage::FindForPatternInDB(
-    ServiceWorkerDatabase* database,
-    scoped_refptr<base::SequencedTaskRunner> original_task_runner,
-    const GURL& scope,
-    const FindInDBCallback& callback) {
-  GURL origin = scope.GetOrigin();
-  RegistrationList registration_data_list;
-  ServiceWorkerDatabase::Status status = database->GetRegistrationsForOrigin(
-      origin, &registration_data_list, nullptr);
-  if (status != ServiceWorkerDatabase::STATUS_OK) {
-    original_task_runner->PostTask(
-        FROM_HERE,
-        base::Bind(callback,
-                   ServiceWorkerDatabase::RegistrationData(),
-                   ResourceList(),
-                   status));
-    return;
-  }
-
-  // Find one with an exact matching scope.
-  ServiceWorkerDatabase::RegistrationData data;
-  ResourceList resources;
-  status = ServiceWorkerDatabase::STATUS_ERROR_NOT_FOUND;
-  for (const auto& registration_data : registration_data_list) {
-    if (scope != registration_data.scope)
-      continue;
-    status = database->ReadRegistration(registration_data.registration_id,
-                                        origin, &data, &resources);
-    break;  // We're done looping.
-  }
-
-  original_task_runner->PostTask(
-      FROM_HERE,
-      base::Bind(callback, data, resources, status));
-}
-
 void ServiceWorkerStorage::FindForIdInDB(
     ServiceWorkerDatabase* database,
     scoped_refptr<base::SequencedTaskRunner> original_task_runner,
@@ -262,12 +262,16 @@ class CONTENT_EXPORT ServiceWorkerStorage
   FRIEND_TEST_ALL_PREFIXES(ServiceWorkerResourceStorageDiskTest,
                            DeleteAndStartOver_OpenedFileExists);
 
+  // The stored registration ids of one origin, by scope.
+  typedef std::map<GURL, int64_t> RegistrationIdsByScope;
+
   struct InitialData {
     int64_t next_registration_id;
     int64_t next_version_id;
     int64_t next_resource_id;
     std::set<GURL> origins;
     std::set<GURL> foreign_fetch_origins;
+    std::map<GURL, RegistrationIdsByScope> scopes;
 
     InitialData();
     ~InitialData();
@@ -409,6 +413,12 @@ class CONTENT_EXPORT ServiceWorkerStorage
   scoped_refptr<ServiceWorkerRegistration> GetOrCreateRegistration(
       const ServiceWorkerDatabase::RegistrationData& data,
       const ResourceList& resources);
+  // Look up the stored registration for a document or pattern in
+  // |registered_scopes_|. Return kInvalidServiceWorkerRegistrationId if none
+  // matches.
+  int64_t FindStoredRegistrationIdForDocument(const GURL& document_url);
+  int64_t FindStoredRegistrationIdForPattern(const GURL& scope);
+
   ServiceWorkerRegistration* FindInstallingRegistrationForDocument(
       const GURL& document_url);
   ServiceWorkerRegistration* FindInstallingRegistrationForPattern(
@@ -458,16 +468,6 @@ class CONTENT_EXPORT ServiceWorkerStorage
       const ServiceWorkerDatabase::RegistrationData& registration,
       const ResourceList& resources,
       const WriteRegistrationCallback& callback);
-  static void FindForDocumentInDB(
-      ServiceWorkerDatabase* database,
-      scoped_refptr<base::SequencedTaskRunner> original_task_runner,
-      const GURL& document_url,
-      const FindInDBCallback& callback);
-  static void FindForPatternInDB(
-      ServiceWorkerDatabase* database,
-      scoped_refptr<base::SequencedTaskRunner> original_task_runner,
-      const GURL& scope,
-      const FindInDBCallback& callback);
   static void FindForIdInDB(
       ServiceWorkerDatabase* database,
       scoped_refptr<base::SequencedTaskRunner> original_task_runner,
@@ -511,6 +511,12 @@ class CONTENT_EXPORT ServiceWorkerStorage
   std::set<GURL> registered_origins_;
   std::set<GURL> foreign_fetch_origins_;
 
+  // The scopes of all stored registrations, by origin. Read along with the
+  // other initial data so that finding the registration for a document or a
+  // pattern never needs the database to rule one out, and reads only the
+  // matching registration otherwise.
+  std::map<GURL, RegistrationIdsByScope> registered_scopes_;
+
   // Pending database tasks waiting for initialization.
   std::vector<base::Closure> pending_tasks_;
 
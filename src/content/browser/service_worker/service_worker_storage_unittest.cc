@@ -1744,4 +1744,58 @@ TEST_F(ServiceWorkerStorageDiskTest, OriginHasForeignFetchRegistrations) {
   EXPECT_FALSE(storage()->OriginHasForeignFetchRegistrations(kOrigin2));
 }
 
+TEST_F(ServiceWorkerStorageDiskTest, FindRegistrationForDocumentAfterRestart) {
+  LazyInitialize();
+
+  const GURL kScope("http://www.example.com/scope/");
+  const GURL kScript("http://www.example.com/script.js");
+  const int64_t kRegistrationId = 1;
+  const int64_t kVersionId = 1;
+  scoped_refptr<ServiceWorkerRegistration> live_registration =
+      new ServiceWorkerRegistration(kScope, kRegistrationId,
+                                    context()->AsWeakPtr());
+  scoped_refptr<ServiceWorkerVersion> live_version = new ServiceWorkerVersion(
+      live_registration.get(), kScript, kVersionId, context()->AsWeakPtr());
+  std::vector<ServiceWorkerDatabase::ResourceRecord> records;
+  records.push_back(ServiceWorkerDatabase::ResourceRecord(
+      1, live_version->script_url(), 100));
+  live_version->script_cache_map()->SetResources(records);
+  live_version->SetStatus(ServiceWorkerVersion::INSTALLED);
+  live_registration->SetWaitingVersion(live_version);
+  EXPECT_EQ(SERVICE_WORKER_OK,
+            StoreRegistration(live_registration, live_version));
+
+  // Simulate browser shutdown and restart.
+  live_registration = nullptr;
+  live_version = nullptr;
+  InitializeTestHelper();
+  LazyInitialize();
+
+  // A document outside every stored scope is ruled out without waiting on the
+  // database, even though its origin has a registration.
+  bool was_called = false;
+  ServiceWorkerStatusCode result = SERVICE_WORKER_ERROR_MAX_VALUE;
+  scoped_refptr<ServiceWorkerRegistration> found_registration;
+  storage()->FindRegistrationForDocument(
+      GURL("http://www.example.com/other/page"),
+      MakeFindCallback(&was_called, &result, &found_registration));
+  EXPECT_TRUE(was_called);
+  EXPECT_EQ(SERVICE_WORKER_ERROR_NOT_FOUND, result);
+  EXPECT_FALSE(found_registration);
+
+  // A document within the scope still finds the stored registration.
+  EXPECT_EQ(SERVICE_WORKER_OK,
+            FindRegistrationForDocument(GURL("http://www.example.com/scope/a"),
+                                        &found_registration));
+  ASSERT_TRUE(found_registration);
+  EXPECT_EQ(kRegistrationId, found_registration->id());
+
+  // Once deleted, the registration is no longer found for its scope.
+  found_registration = nullptr;
+  EXPECT_EQ(SERVICE_WORKER_OK,
+            DeleteRegistration(kRegistrationId, kScope.GetOrigin()));
+  EXPECT_EQ(SERVICE_WORKER_ERROR_NOT_FOUND,
+            FindRegistrationForPattern(kScope, &found_registration));
+}
+
 }  // namespace content
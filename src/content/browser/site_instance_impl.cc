@@ -110,6 +110,13 @@ RenderProcessHost* SiteInstanceImpl::GetProcess() {
                                                                site_);
     }
 
+    // If not, see if a process was launched ahead of time.
+    if (!process_ && !g_render_process_host_factory_ &&
+        !site_.SchemeIs(kGuestScheme)) {
+      process_ = RenderProcessHostImpl::TakeSpareRenderProcessHost(
+          browser_context, site_);
+    }
+
     // Otherwise (or if that fails), create a new one.
     if (!process_) {
       if (g_render_process_host_factory_) {
@@ -32,6 +32,9 @@ namespace {
 // Default allocation size.
 const size_t kAllocationSize = 4 * 1024 * 1024;
 
+// Interval at which free memory is released while the process is backgrounded.
+const int kBackgroundReleaseFreeMemoryIntervalSeconds = 10;
+
 // Global atomic to generate unique discardable shared memory IDs.
 base::StaticAtomicSequenceNumber g_next_discardable_shared_memory_id;
 
@@ -250,6 +253,20 @@ void ChildDiscardableSharedMemoryManager::ReleaseFreeMemory() {
     MemoryUsageChanged(heap_.GetSize(), heap_.GetSizeOfFreeLists());
 }
 
+void ChildDiscardableSharedMemoryManager::SetProcessBackgrounded(
+    bool backgrounded) {
+  if (!backgrounded) {
+    background_release_timer_.Stop();
+    return;
+  }
+
+  ReleaseFreeMemory();
+  background_release_timer_.Start(
+      FROM_HERE,
+      base::TimeDelta::FromSeconds(kBackgroundReleaseFreeMemoryIntervalSeconds),
+      this, &ChildDiscardableSharedMemoryManager::ReleaseFreeMemory);
+}
+
 bool ChildDiscardableSharedMemoryManager::LockSpan(
     DiscardableSharedMemoryHeap::Span* span) {
   base::AutoLock lock(lock_);
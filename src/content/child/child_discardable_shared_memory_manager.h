@@ -11,6 +11,7 @@
 #include "base/memory/discardable_memory_allocator.h"
 #include "base/memory/ref_counted.h"
 #include "base/synchronization/lock.h"
+#include "base/timer/timer.h"
 #include "base/trace_event/memory_dump_provider.h"
 #include "content/child/thread_safe_sender.h"
 #include "content/common/content_export.h"
@@ -39,6 +40,12 @@ class CONTENT_EXPORT ChildDiscardableSharedMemoryManager
   // Release memory and associated resources that have been purged.
   void ReleaseFreeMemory();
 
+  // While the process is backgrounded, free memory is released periodically so
+  // that the browser can give it to foreground processes before the system
+  // runs out of memory. Must be called on the thread the manager was created
+  // on.
+  void SetProcessBackgrounded(bool backgrounded);
+
   bool LockSpan(DiscardableSharedMemoryHeap::Span* span);
   void UnlockSpan(DiscardableSharedMemoryHeap::Span* span);
   void ReleaseSpan(std::unique_ptr<DiscardableSharedMemoryHeap::Span> span);
@@ -58,6 +65,7 @@ class CONTENT_EXPORT ChildDiscardableSharedMemoryManager
   mutable base::Lock lock_;
   DiscardableSharedMemoryHeap heap_;
   scoped_refptr<ThreadSafeSender> sender_;
+  base::RepeatingTimer background_release_timer_;
 
   DISALLOW_COPY_AND_ASSIGN(ChildDiscardableSharedMemoryManager);
 };
@@ -701,6 +701,9 @@ void ChildThreadImpl::OnProcessBackgrounded(bool backgrounded) {
   if (backgrounded)
     timer_slack = base::TIMER_SLACK_MAXIMUM;
   base::MessageLoop::current()->SetTimerSlack(timer_slack);
+
+  if (discardable_shared_memory_manager_)
+    discardable_shared_memory_manager_->SetProcessBackgrounded(backgrounded);
 }
 
 void ChildThreadImpl::OnProcessPurgeAndSuspend() {
@@ -142,6 +142,8 @@ void IndexedDBDispatcher::OnMessageReceived(const IPC::Message& msg) {
     IPC_MESSAGE_HANDLER(IndexedDBMsg_CallbacksSuccessStringList,
                         OnSuccessStringList)
     IPC_MESSAGE_HANDLER(IndexedDBMsg_CallbacksSuccessArray, OnSuccessArray)
+    IPC_MESSAGE_HANDLER(IndexedDBMsg_CallbacksSuccessArrayChunk,
+                        OnSuccessArrayChunk)
     IPC_MESSAGE_HANDLER(IndexedDBMsg_CallbacksSuccessValue, OnSuccessValue)
     IPC_MESSAGE_HANDLER(IndexedDBMsg_CallbacksSuccessInteger, OnSuccessInteger)
     IPC_MESSAGE_HANDLER(IndexedDBMsg_CallbacksSuccessUndefined,
@@ -434,6 +436,8 @@ void IndexedDBDispatcher::RequestIDBDatabaseOpenCursor(
   DCHECK(cursor_transaction_ids_.find(params.ipc_callbacks_id) ==
          cursor_transaction_ids_.end());
   cursor_transaction_ids_[params.ipc_callbacks_id] = transaction_id;
+  pending_cursor_sources_[params.ipc_callbacks_id] =
+      CursorSource(ipc_database_id, object_store_id, index_id);
 }
 
 void IndexedDBDispatcher::RequestIDBDatabaseCount(
@@ -486,12 +490,28 @@ void IndexedDBDispatcher::RequestIDBDatabaseClear(
 }
 
 void IndexedDBDispatcher::CursorDestroyed(int32_t ipc_cursor_id) {
+  const auto cursor_iter = cursors_.find(ipc_cursor_id);
+  const auto source_iter = cursor_sources_.find(ipc_cursor_id);
+  if (cursor_iter != cursors_.end() && source_iter != cursor_sources_.end()) {
+    RecordCursorContinueCount(source_iter->second,
+                              cursor_iter->second->total_continue_count());
+  }
+  if (source_iter != cursor_sources_.end())
+    cursor_sources_.erase(source_iter);
   cursors_.erase(ipc_cursor_id);
 }
 
 void IndexedDBDispatcher::DatabaseDestroyed(int32_t ipc_database_id) {
   DCHECK_EQ(databases_.count(ipc_database_id), 1u);
   databases_.erase(ipc_database_id);
+
+  auto iter = cursor_continue_counts_.begin();
+  while (iter != cursor_continue_counts_.end()) {
+    if (std::get<0>(iter->first) == ipc_database_id)
+      cursor_continue_counts_.erase(iter++);
+    else
+      ++iter;
+  }
 }
 
 void IndexedDBDispatcher::OnSuccessIDBDatabase(
@@ -579,15 +599,34 @@ void IndexedDBDispatcher::OnSuccessArray(
     const IndexedDBMsg_CallbacksSuccessArray_Params& p) {
   DCHECK_EQ(p.ipc_thread_id, CurrentWorkerId());
   int32_t ipc_callbacks_id = p.ipc_callbacks_id;
-  blink::WebVector<WebIDBValue> web_values(p.values.size());
+  std::vector<WebIDBValue> chunk_values;
+  const auto chunks_iter = pending_array_values_.find(ipc_callbacks_id);
+  if (chunks_iter != pending_array_values_.end()) {
+    chunk_values.swap(chunks_iter->second);
+    pending_array_values_.erase(chunks_iter);
+  }
+  blink::WebVector<WebIDBValue> web_values(chunk_values.size() +
+                                           p.values.size());
+  for (size_t i = 0; i < chunk_values.size(); ++i)
+    web_values[i] = chunk_values[i];
   for (size_t i = 0; i < p.values.size(); ++i)
-    PrepareReturnWebValue(p.values[i], &web_values[i]);
+    PrepareReturnWebValue(p.values[i], &web_values[chunk_values.size() + i]);
   WebIDBCallbacks* callbacks = pending_callbacks_.Lookup(ipc_callbacks_id);
   DCHECK(callbacks);
   callbacks->onSuccess(web_values);
   pending_callbacks_.Remove(ipc_callbacks_id);
 }
 
+void IndexedDBDispatcher::OnSuccessArrayChunk(
+    const IndexedDBMsg_CallbacksSuccessArray_Params& p) {
+  DCHECK_EQ(p.ipc_thread_id, CurrentWorkerId());
+  std::vector<WebIDBValue>& values = pending_array_values_[p.ipc_callbacks_id];
+  size_t offset = values.size();
+  values.resize(offset + p.values.size());
+  for (size_t i = 0; i < p.values.size(); ++i)
+    PrepareReturnWebValue(p.values[i], &values[offset + i]);
+}
+
 void IndexedDBDispatcher::OnSuccessValue(
     const IndexedDBMsg_CallbacksSuccessValue_Params& params) {
   DCHECK_EQ(params.ipc_thread_id, CurrentWorkerId());
@@ -603,6 +642,7 @@ void IndexedDBDispatcher::OnSuccessValue(
   }
   callbacks->onSuccess(web_value);
   cursor_transaction_ids_.erase(params.ipc_callbacks_id);
+  pending_cursor_sources_.erase(params.ipc_callbacks_id);
   pending_callbacks_.Remove(params.ipc_callbacks_id);
 }
 
@@ -641,6 +681,10 @@ void IndexedDBDispatcher::OnSuccessOpenCursor(
          cursor_transaction_ids_.end());
   int64_t transaction_id = cursor_transaction_ids_[ipc_callbacks_id];
   cursor_transaction_ids_.erase(ipc_callbacks_id);
+  const auto source_iter = pending_cursor_sources_.find(ipc_callbacks_id);
+  DCHECK(source_iter != pending_cursor_sources_.end());
+  const CursorSource source = source_iter->second;
+  pending_cursor_sources_.erase(source_iter);
 
   WebIDBCallbacks* callbacks = pending_callbacks_.Lookup(ipc_callbacks_id);
   if (!callbacks)
@@ -649,6 +693,10 @@ void IndexedDBDispatcher::OnSuccessOpenCursor(
   WebIDBCursorImpl* cursor = new WebIDBCursorImpl(
       ipc_object_id, transaction_id, thread_safe_sender_.get());
   cursors_[ipc_object_id] = cursor;
+  cursor_sources_[ipc_object_id] = source;
+  const auto count_iter = cursor_continue_counts_.find(source);
+  if (count_iter != cursor_continue_counts_.end())
+    cursor->SetPrefetchHint(count_iter->second);
   callbacks->onSuccess(cursor, WebIDBKeyBuilder::Build(key),
                        WebIDBKeyBuilder::Build(primary_key), web_value);
 
@@ -741,6 +789,8 @@ void IndexedDBDispatcher::OnError(int32_t ipc_thread_id,
     callbacks->onError(WebIDBDatabaseError(code, message));
   pending_callbacks_.Remove(ipc_callbacks_id);
   cursor_transaction_ids_.erase(ipc_callbacks_id);
+  pending_cursor_sources_.erase(ipc_callbacks_id);
+  pending_array_values_.erase(ipc_callbacks_id);
 }
 
 void IndexedDBDispatcher::OnAbort(int32_t ipc_thread_id,
@@ -806,4 +856,13 @@ void IndexedDBDispatcher::ResetCursorPrefetchCaches(
   }
 }
 
+void IndexedDBDispatcher::RecordCursorContinueCount(const CursorSource& source,
+                                                    int continue_count) {
+  auto iter = cursor_continue_counts_.find(source);
+  if (iter == cursor_continue_counts_.end())
+    cursor_continue_counts_[source] = continue_count;
+  else
+    iter->second = (iter->second * 3 + continue_count) / 4;
+}
+
 }  // namespace content
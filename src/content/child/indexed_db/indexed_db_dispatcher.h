@@ -10,6 +10,7 @@
 
 #include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "base/gtest_prod_util.h"
@@ -25,6 +26,7 @@
 #include "third_party/WebKit/public/platform/modules/indexeddb/WebIDBCallbacks.h"
 #include "third_party/WebKit/public/platform/modules/indexeddb/WebIDBDatabaseCallbacks.h"
 #include "third_party/WebKit/public/platform/modules/indexeddb/WebIDBTypes.h"
+#include "third_party/WebKit/public/platform/modules/indexeddb/WebIDBValue.h"
 #include "url/origin.h"
 
 struct IndexedDBDatabaseMetadata;
@@ -184,13 +186,19 @@ class CONTENT_EXPORT IndexedDBDispatcher : public WorkerThread::Observer {
   void DatabaseDestroyed(int32_t ipc_database_id);
 
  private:
+  FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorPrefetchHint);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorReset);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorTransactionId);
+  FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, SuccessArrayChunks);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, ValueSizeTest);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, KeyAndValueSizeTest);
 
   enum { kAllCursors = -1 };
 
+  // The database connection, object store id and index id a cursor was
+  // opened on.
+  typedef std::tuple<int32_t, int64_t, int64_t> CursorSource;
+
   static int32_t CurrentWorkerId() { return WorkerThread::GetCurrentId(); }
 
   template <typename T>
@@ -221,6 +229,7 @@ class CONTENT_EXPORT IndexedDBDispatcher : public WorkerThread::Observer {
                            const std::vector<base::string16>& value);
   void OnSuccessValue(const IndexedDBMsg_CallbacksSuccessValue_Params& p);
   void OnSuccessArray(const IndexedDBMsg_CallbacksSuccessArray_Params& p);
+  void OnSuccessArrayChunk(const IndexedDBMsg_CallbacksSuccessArray_Params& p);
   void OnSuccessInteger(int32_t ipc_thread_id,
                         int32_t ipc_callbacks_id,
                         int64_t value);
@@ -251,6 +260,11 @@ class CONTENT_EXPORT IndexedDBDispatcher : public WorkerThread::Observer {
   void ResetCursorPrefetchCaches(int64_t transaction_id,
                                  int32_t ipc_exception_cursor_id);
 
+  // Folds the number of continue() calls made on a cursor over |source| into
+  // the typical count used to tune the prefetching of later cursors.
+  void RecordCursorContinueCount(const CursorSource& source,
+                                 int continue_count);
+
   scoped_refptr<ThreadSafeSender> thread_safe_sender_;
 
   // Maximum size (in bytes) of value/key pair allowed for put requests. Any
@@ -273,6 +287,20 @@ class CONTENT_EXPORT IndexedDBDispatcher : public WorkerThread::Observer {
   // Map from cursor id to WebIDBCursorImpl.
   std::map<int32_t, WebIDBCursorImpl*> cursors_;
 
+  // Maps the ipc_callback_id from an open cursor request, and then the id of
+  // the cursor it opened, to the source of the cursor.
+  std::map<int32_t, CursorSource> pending_cursor_sources_;
+  std::map<int32_t, CursorSource> cursor_sources_;
+
+  // Running average of the continue() calls made on the cursors over each
+  // source, weighted towards recent cursors.
+  std::map<CursorSource, int> cursor_continue_counts_;
+
+  // Values received in IndexedDBMsg_CallbacksSuccessArrayChunk messages, by
+  // ipc_callbacks_id, until the IndexedDBMsg_CallbacksSuccessArray that
+  // completes the request arrives.
+  std::map<int32_t, std::vector<blink::WebIDBValue>> pending_array_values_;
+
   std::map<int32_t, WebIDBDatabaseImpl*> databases_;
 
   DISALLOW_COPY_AND_ASSIGN(IndexedDBDispatcher);
@@ -231,6 +231,87 @@ TEST_F(IndexedDBDispatcherTest, CursorTransactionId) {
   }
 }
 
+TEST_F(IndexedDBDispatcherTest, CursorPrefetchHint) {
+  const int32_t ipc_database_id = 1;
+  const int64_t transaction_id = 1234;
+  const int64_t object_store_id = 2;
+  const int64_t index_id = 3;
+  const int kContinueCount = 40;
+
+  MockDispatcher dispatcher(thread_safe_sender_.get());
+  WebIDBKey null_key;
+  null_key.assignNull();
+
+  for (int i = 0; i < 2; ++i) {
+    std::unique_ptr<WebIDBCursor> cursor;
+    auto callbacks = new StrictMock<MockWebIDBCallbacks>();
+    ON_CALL(*callbacks, onSuccess(testing::A<WebIDBCursor*>(), _, _, _))
+        .WillByDefault(
+            WithArgs<0>(Invoke(&cursor.operator=(nullptr),
+                               &std::unique_ptr<WebIDBCursor>::reset)));
+    EXPECT_CALL(*callbacks, onSuccess(testing::A<WebIDBCursor*>(), _, _, _))
+        .Times(1);
+
+    dispatcher.RequestIDBDatabaseOpenCursor(
+        ipc_database_id, transaction_id, object_store_id, index_id,
+        IndexedDBKeyRange(), blink::WebIDBCursorDirectionNext, false,
+        blink::WebIDBTaskTypeNormal, callbacks);
+    IndexedDBMsg_CallbacksSuccessIDBCursor_Params params;
+    params.ipc_thread_id = dispatcher.CurrentWorkerId();
+    params.ipc_callbacks_id =
+        dispatcher.cursor_transaction_ids_.begin()->first;
+    params.ipc_cursor_id = WebIDBCursorImpl::kInvalidCursorId;
+    dispatcher.OnSuccessOpenCursor(params);
+    ASSERT_TRUE(cursor.get());
+    WebIDBCursorImpl* impl = static_cast<WebIDBCursorImpl*>(cursor.get());
+
+    if (i == 0) {
+      // Nothing has been learned about the object store yet.
+      EXPECT_EQ(static_cast<int>(WebIDBCursorImpl::kPrefetchContinueThreshold),
+                impl->prefetch_continue_threshold_);
+      EXPECT_EQ(static_cast<int>(WebIDBCursorImpl::kMinPrefetchAmount),
+                impl->prefetch_amount_);
+      for (int j = 0; j < kContinueCount; ++j) {
+        impl->continueFunction(null_key,
+                               new StrictMock<MockWebIDBCallbacks>());
+      }
+      EXPECT_EQ(kContinueCount, impl->total_continue_count());
+    } else {
+      // The second cursor prefetches right away, in one batch.
+      EXPECT_EQ(0, impl->prefetch_continue_threshold_);
+      EXPECT_EQ(kContinueCount, impl->prefetch_amount_);
+    }
+  }
+
+  EXPECT_TRUE(dispatcher.cursor_sources_.empty());
+  EXPECT_TRUE(dispatcher.pending_cursor_sources_.empty());
+}
+
+TEST_F(IndexedDBDispatcherTest, SuccessArrayChunks) {
+  MockDispatcher dispatcher(thread_safe_sender_.get());
+
+  auto callbacks = new StrictMock<MockWebIDBCallbacks>();
+  EXPECT_CALL(*callbacks,
+              onSuccess(testing::Property(
+                  &WebVector<blink::WebIDBValue>::size, 3u)))
+      .Times(1);
+  dispatcher.RequestIDBDatabaseGetAll(1, 1, 1, 0, IndexedDBKeyRange(), false,
+                                      10, callbacks);
+  // The only pending callbacks get the first id.
+  const int32_t ipc_callbacks_id = 1;
+
+  IndexedDBMsg_CallbacksSuccessArray_Params params;
+  params.ipc_thread_id = dispatcher.CurrentWorkerId();
+  params.ipc_callbacks_id = ipc_callbacks_id;
+  params.values.resize(2);
+  dispatcher.OnSuccessArrayChunk(params);
+  EXPECT_EQ(1u, dispatcher.pending_array_values_.size());
+
+  params.values.resize(1);
+  dispatcher.OnSuccessArray(params);
+  EXPECT_TRUE(dispatcher.pending_array_values_.empty());
+}
+
 namespace {
 
 class MockCursor : public WebIDBCursorImpl {
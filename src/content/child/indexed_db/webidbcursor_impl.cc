@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,9 @@ WebIDBCursorImpl::WebIDBCursorImpl(int32_t ipc_cursor_id,
     : ipc_cursor_id_(ipc_cursor_id),
       transaction_id_(transaction_id),
       continue_count_(0),
+      total_continue_count_(0),
+      prefetch_continue_threshold_(kPrefetchContinueThreshold),
+      initial_prefetch_amount_(kMinPrefetchAmount),
       used_prefetches_(0),
       pending_onsuccess_callbacks_(0),
       prefetch_amount_(kMinPrefetchAmount),
@@ -80,6 +84,7 @@ void WebIDBCursorImpl::continueFunction(const WebIDBKey& key,
       primary_key.keyType() == blink::WebIDBKeyTypeNull) {
     // No key(s), so this would qualify for a prefetch.
     ++continue_count_;
+    ++total_continue_count_;
 
     if (!prefetch_keys_.empty()) {
       // We have a prefetch cache, so serve the result from that.
@@ -87,7 +92,7 @@ void WebIDBCursorImpl::continueFunction(const WebIDBKey& key,
       return;
     }
 
-    if (continue_count_ > kPrefetchContinueThreshold) {
+    if (continue_count_ > prefetch_continue_threshold_) {
       // Request pre-fetch.
       ++pending_onsuccess_callbacks_;
       dispatcher->RequestIDBCursorPrefetch(
@@ -125,6 +130,20 @@ void WebIDBCursorImpl::postSuccessHandlerCallback() {
     ResetPrefetchCache();
 }
 
+void WebIDBCursorImpl::SetPrefetchHint(int expected_continue_count) {
+  if (expected_continue_count <= kPrefetchContinueThreshold) {
+    prefetch_continue_threshold_ = kPrefetchContinueThreshold;
+    initial_prefetch_amount_ = kMinPrefetchAmount;
+  } else {
+    prefetch_continue_threshold_ = 0;
+    initial_prefetch_amount_ = std::min<int>(
+        std::max<int>(expected_continue_count, kMinPrefetchAmount),
+        kMaxPrefetchAmount);
+  }
+  if (!continue_count_)
+    prefetch_amount_ = initial_prefetch_amount_;
+}
+
 void WebIDBCursorImpl::SetPrefetchData(
     const std::vector<IndexedDBKey>& keys,
     const std::vector<IndexedDBKey>& primary_keys,
@@ -184,7 +203,7 @@ void WebIDBCursorImpl::CachedContinue(WebIDBCallbacks* callbacks) {
 
 void WebIDBCursorImpl::ResetPrefetchCache() {
   continue_count_ = 0;
-  prefetch_amount_ = kMinPrefetchAmount;
+  prefetch_amount_ = initial_prefetch_amount_;
 
   if (!prefetch_keys_.size()) {
     // No prefetch cache, so no need to reset the cursor in the back-end.
@@ -49,12 +49,21 @@ class CONTENT_EXPORT WebIDBCursorImpl
   // This method is virtual so it can be overridden in unit tests.
   virtual void ResetPrefetchCache();
 
+  // Tunes prefetching for a cursor expected to be continued about
+  // |expected_continue_count| times, as learned from earlier cursors over the
+  // same source. Long iterations prefetch from the first continue(), with a
+  // first batch sized to match; short ones keep the default heuristic.
+  void SetPrefetchHint(int expected_continue_count);
+
   int64_t transaction_id() const { return transaction_id_; }
+  int total_continue_count() const { return total_continue_count_; }
 
  private:
+  FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorPrefetchHint);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorReset);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorTransactionId);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdvancePrefetchTest);
+  FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchHint);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchReset);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchTest);
 
@@ -74,6 +83,15 @@ class CONTENT_EXPORT WebIDBCursorImpl
   // Number of continue calls that would qualify for a pre-fetch.
   int continue_count_;
 
+  // Number of continue calls that would qualify for a pre-fetch over the
+  // lifetime of the cursor; unlike |continue_count_| it is never reset.
+  int total_continue_count_;
+
+  // Number of qualifying continue calls after which prefetching starts, and
+  // the size of the first prefetch. Set by SetPrefetchHint().
+  int prefetch_continue_threshold_;
+  int initial_prefetch_amount_;
+
   // Number of items used from the last prefetch.
   int used_prefetches_;
 
@@ -292,6 +292,44 @@ TEST_F(WebIDBCursorImplTest, AdvancePrefetchTest) {
             dispatcher_->continue_calls());
 }
 
+TEST_F(WebIDBCursorImplTest, PrefetchHint) {
+  const int64_t transaction_id = 1;
+  const int kExpectedContinueCount = 40;
+
+  // A hint of a short iteration keeps the default behavior.
+  {
+    WebIDBCursorImpl cursor(WebIDBCursorImpl::kInvalidCursorId,
+                            transaction_id, thread_safe_sender_.get());
+    cursor.SetPrefetchHint(1);
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+    EXPECT_EQ(1, dispatcher_->continue_calls());
+    EXPECT_EQ(0, dispatcher_->prefetch_calls());
+  }
+
+  // A hint of a long one prefetches on the first continue(), sized to the
+  // expected iteration.
+  WebIDBCursorImpl cursor(WebIDBCursorImpl::kInvalidCursorId, transaction_id,
+                          thread_safe_sender_.get());
+  cursor.SetPrefetchHint(kExpectedContinueCount);
+  cursor.continueFunction(null_key_, new MockContinueCallbacks());
+  EXPECT_EQ(1, dispatcher_->continue_calls());
+  EXPECT_EQ(1, dispatcher_->prefetch_calls());
+  EXPECT_EQ(kExpectedContinueCount, dispatcher_->last_prefetch_count());
+
+  // Resetting the cache goes back to the hinted amount, not the minimum.
+  std::vector<IndexedDBKey> keys(kExpectedContinueCount);
+  std::vector<IndexedDBKey> primary_keys(kExpectedContinueCount);
+  std::vector<WebIDBValue> values(kExpectedContinueCount);
+  cursor.SetPrefetchData(keys, primary_keys, values);
+  MockContinueCallbacks callbacks;
+  cursor.CachedContinue(&callbacks);
+  cursor.ResetPrefetchCache();
+  cursor.continueFunction(null_key_, new MockContinueCallbacks());
+  EXPECT_EQ(2, dispatcher_->prefetch_calls());
+  EXPECT_EQ(kExpectedContinueCount, dispatcher_->last_prefetch_count());
+  EXPECT_EQ(2, cursor.total_continue_count());
+}
+
 TEST_F(WebIDBCursorImplTest, PrefetchReset) {
   const int64_t transaction_id = 1;
   WebIDBCursorImpl cursor(WebIDBCursorImpl::kInvalidCursorId,
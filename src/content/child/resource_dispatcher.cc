@@ -30,6 +30,7 @@
 #include "content/child/sync_load_response.h"
 #include "content/common/inter_process_time_ticks_converter.h"
 #include "content/common/navigation_params.h"
+#include "content/common/resource_buffer_control.h"
 #include "content/common/resource_messages.h"
 #include "content/common/resource_request.h"
 #include "content/common/resource_request_completion_status.h"
@@ -189,6 +190,7 @@ void ResourceDispatcher::OnReceivedCachedMetadata(
 void ResourceDispatcher::OnSetDataBuffer(int request_id,
                                          base::SharedMemoryHandle shm_handle,
                                          int shm_size,
+                                         bool has_buffer_control,
                                          base::ProcessId renderer_pid) {
   TRACE_EVENT0("loader", "ResourceDispatcher::OnSetDataBuffer");
   PendingRequestInfo* request_info = GetPendingRequestInfo(request_id);
@@ -198,13 +200,14 @@ void ResourceDispatcher::OnSetDataBuffer(int request_id,
   bool shm_valid = base::SharedMemory::IsHandleValid(shm_handle);
   CHECK((shm_valid && shm_size > 0) || (!shm_valid && !shm_size));
 
+  // The data is only read, but the ResourceBufferControl is written.
   request_info->buffer.reset(
-      new base::SharedMemory(shm_handle, true));  // read only
-  request_info->received_data_factory =
-      make_scoped_refptr(new SharedMemoryReceivedDataFactory(
-          message_sender_, request_id, request_info->buffer));
+      new base::SharedMemory(shm_handle, !has_buffer_control));
 
-  bool ok = request_info->buffer->Map(shm_size);
+  size_t map_size = shm_size;
+  if (has_buffer_control)
+    map_size += sizeof(ResourceBufferControl);
+  bool ok = request_info->buffer->Map(map_size);
   if (!ok) {
     // Added to help debug crbug/160401.
     base::ProcessId renderer_pid_copy = renderer_pid;
@@ -217,6 +220,15 @@ void ResourceDispatcher::OnSetDataBuffer(int request_id,
     return;
   }
 
+  ResourceBufferControl* control = nullptr;
+  if (has_buffer_control) {
+    control = reinterpret_cast<ResourceBufferControl*>(
+        static_cast<char*>(request_info->buffer->memory()) + shm_size);
+  }
+  request_info->received_data_factory =
+      make_scoped_refptr(new SharedMemoryReceivedDataFactory(
+          message_sender_, request_id, request_info->buffer, control));
+
   // TODO(jose.dapena): reenable this check. We should know why we need
   // to allocate 1MB buffers, instead of upstream 512KB maximum.
 #if !defined(OS_WEBOS)
@@ -175,6 +175,7 @@ class CONTENT_EXPORT ResourceDispatcher : public IPC::Listener {
   void OnSetDataBuffer(int request_id,
                        base::SharedMemoryHandle shm_handle,
                        int shm_size,
+                       bool has_buffer_control,
                        base::ProcessId renderer_pid);
   void OnReceivedInlinedDataChunk(int request_id,
                                   const std::vector<char>& data,
@@ -267,7 +267,8 @@ class ResourceDispatcherTest : public testing::Test, public IPC::Sender {
     EXPECT_TRUE(shared_memory->ShareToProcess(base::GetCurrentProcessHandle(),
                                               &duplicate_handle));
     EXPECT_TRUE(dispatcher_->OnMessageReceived(ResourceMsg_SetDataBuffer(
-        request_id, duplicate_handle, shared_memory->requested_size(), 0)));
+        request_id, duplicate_handle, shared_memory->requested_size(), false,
+        0)));
   }
 
   void NotifyDataReceived(int request_id, const std::string& data) {
@@ -8,6 +8,7 @@
 
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "content/common/resource_buffer_control.h"
 #include "content/common/resource_messages.h"
 #include "ipc/ipc_sender.h"
 
@@ -48,13 +49,15 @@ class SharedMemoryReceivedDataFactory::SharedMemoryReceivedData final
 SharedMemoryReceivedDataFactory::SharedMemoryReceivedDataFactory(
     IPC::Sender* message_sender,
     int request_id,
-    linked_ptr<base::SharedMemory> memory)
+    linked_ptr<base::SharedMemory> memory,
+    ResourceBufferControl* control)
     : id_(0),
       oldest_(0),
       message_sender_(message_sender),
       request_id_(request_id),
       is_stopped_(false),
-      memory_(memory) {
+      memory_(memory),
+      control_(control) {
 }
 
 SharedMemoryReceivedDataFactory::~SharedMemoryReceivedDataFactory() {
@@ -125,6 +128,20 @@ void SharedMemoryReceivedDataFactory::Reclaim(TicketId id) {
 }
 
 void SharedMemoryReceivedDataFactory::SendAck(size_t count) {
+  if (control_) {
+    if (!count)
+      return;
+    // See resource_buffer_control.h for why |tail| is advanced before
+    // |producer_waiting| is cleared.
+    base::subtle::Barrier_AtomicIncrement(&control_->tail,
+                                          static_cast<int32_t>(count));
+    if (base::subtle::NoBarrier_AtomicExchange(&control_->producer_waiting,
+                                               0)) {
+      message_sender_->Send(
+          new ResourceHostMsg_DataBufferReleased(request_id_));
+    }
+    return;
+  }
   for (size_t i = 0; i < count; ++i) {
     message_sender_->Send(new ResourceHostMsg_DataReceived_ACK(request_id_));
   }
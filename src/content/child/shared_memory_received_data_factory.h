@@ -24,12 +24,18 @@ class Sender;
 
 namespace content {
 
+struct ResourceBufferControl;
+
 class CONTENT_EXPORT SharedMemoryReceivedDataFactory final
     : public base::RefCounted<SharedMemoryReceivedDataFactory> {
  public:
+  // If |control| is not null, it lives in |memory| and released data is
+  // reported through it. Otherwise each released data is acknowledged with a
+  // DataReceived_ACK message.
   SharedMemoryReceivedDataFactory(IPC::Sender* message_sender,
                                   int request_id,
-                                  linked_ptr<base::SharedMemory> memory);
+                                  linked_ptr<base::SharedMemory> memory,
+                                  ResourceBufferControl* control);
 
   std::unique_ptr<RequestPeer::ReceivedData> Create(int offset,
                                                     int length,
@@ -62,6 +68,7 @@ class CONTENT_EXPORT SharedMemoryReceivedDataFactory final
   bool is_stopped_;
   // Just to keep the payload alive while issued data is alive.
   linked_ptr<base::SharedMemory> memory_;
+  ResourceBufferControl* const control_;
 
   DISALLOW_COPY_AND_ASSIGN(SharedMemoryReceivedDataFactory);
 };
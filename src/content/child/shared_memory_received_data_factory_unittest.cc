@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <tuple>
 
+#include "content/common/resource_buffer_control.h"
 #include "content/common/resource_messages.h"
 #include "ipc/ipc_message.h"
 #include "ipc/ipc_sender.h"
@@ -51,7 +52,7 @@ class SharedMemoryReceivedDataFactoryTest : public ::testing::Test {
     request_id_ = 0xdeadbeaf;
     memory_.reset(new base::SharedMemory);
     factory_ = make_scoped_refptr(new SharedMemoryReceivedDataFactory(
-        sender_.get(), request_id_, memory_));
+        sender_.get(), request_id_, memory_, nullptr));
     ASSERT_TRUE(memory_->CreateAndMapAnonymous(memory_size));
 
     ON_CALL(*sender_, SendAck(_)).WillByDefault(Return(true));
@@ -221,6 +222,29 @@ TEST_F(SharedMemoryReceivedDataFactoryTest, Stop) {
   checkpoint.Call(3);
 }
 
+TEST_F(SharedMemoryReceivedDataFactoryTest, ReleaseThroughControl) {
+  ResourceBufferControl control = {0, 0};
+  scoped_refptr<SharedMemoryReceivedDataFactory> factory(
+      new SharedMemoryReceivedDataFactory(sender_.get(), request_id_, memory_,
+                                          &control));
+
+  std::unique_ptr<ReceivedData> data1 = factory->Create(0, 1, 1);
+  std::unique_ptr<ReceivedData> data2 = factory->Create(1, 1, 1);
+  std::unique_ptr<ReceivedData> data3 = factory->Create(2, 1, 1);
+
+  // No message is sent while the browser is not waiting.
+  data2.reset();
+  EXPECT_EQ(0, control.tail);
+  data1.reset();
+  EXPECT_EQ(2, control.tail);
+
+  control.producer_waiting = 1;
+  EXPECT_CALL(*sender_, SendOtherwise(_));
+  data3.reset();
+  EXPECT_EQ(3, control.tail);
+  EXPECT_EQ(0, control.producer_waiting);
+}
+
 }  // namespace
 
 }  // namespace content
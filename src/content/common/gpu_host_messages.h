@@ -93,6 +93,7 @@ IPC_STRUCT_TRAITS_BEGIN(gpu::GpuPreferences)
   IPC_STRUCT_TRAITS_MEMBER(force_gpu_mem_available)
   IPC_STRUCT_TRAITS_MEMBER(gpu_program_cache_size)
   IPC_STRUCT_TRAITS_MEMBER(disable_gpu_shader_disk_cache)
+  IPC_STRUCT_TRAITS_MEMBER(gpu_program_disk_cache_dir)
   IPC_STRUCT_TRAITS_MEMBER(enable_share_group_async_texture_upload)
   IPC_STRUCT_TRAITS_MEMBER(enable_threaded_texture_mailboxes)
   IPC_STRUCT_TRAITS_MEMBER(gl_shader_interm_output)
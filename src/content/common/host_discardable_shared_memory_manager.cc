@@ -185,6 +185,39 @@ base::LazyInstance<HostDiscardableSharedMemoryManager>
 
 const int kEnforceMemoryPolicyDelayMs = 1000;
 
+// Returns the weight of a process with |priority| when sharing the memory limit
+// between processes. Under memory pressure, the share of backgrounded processes
+// and then of other hidden processes drops to 0, so that foreground processes
+// keep their memory as long as possible.
+int GetProcessBudgetWeight(
+    HostDiscardableSharedMemoryManager::ProcessPriority priority,
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  using ProcessPriority = HostDiscardableSharedMemoryManager::ProcessPriority;
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      if (priority == ProcessPriority::BACKGROUND)
+        return 0;
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      if (priority != ProcessPriority::FOREGROUND)
+        return 0;
+      break;
+  }
+
+  switch (priority) {
+    case ProcessPriority::FOREGROUND:
+      return 4;
+    case ProcessPriority::PERCEPTIBLE:
+      return 2;
+    case ProcessPriority::BACKGROUND:
+      return 1;
+  }
+  NOTREACHED();
+  return 0;
+}
+
 // Global atomic to generate unique discardable shared memory IDs.
 base::StaticAtomicSequenceNumber g_next_discardable_shared_memory_id;
 
@@ -356,11 +389,23 @@ void HostDiscardableSharedMemoryManager::ProcessRemoved(int child_process_id) {
     ReleaseMemory(segment_it.second->memory());
 
   processes_.erase(process_it);
+  process_priorities_.erase(child_process_id);
 
   if (bytes_allocated_ != bytes_allocated_before_releasing_memory)
     BytesAllocatedChanged(bytes_allocated_);
 }
 
+void HostDiscardableSharedMemoryManager::SetProcessPriority(
+    int child_process_id,
+    ProcessPriority priority) {
+  base::AutoLock lock(lock_);
+
+  if (priority == ProcessPriority::FOREGROUND)
+    process_priorities_.erase(child_process_id);
+  else
+    process_priorities_[child_process_id] = priority;
+}
+
 void HostDiscardableSharedMemoryManager::SetMemoryLimit(size_t limit) {
   base::AutoLock lock(lock_);
 
@@ -473,32 +518,37 @@ void HostDiscardableSharedMemoryManager::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   base::AutoLock lock(lock_);
 
+  size_t limit = memory_limit_;
 #if defined(OS_WEBOS)
   switch (memory_pressure_level) {
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
-      break;
+      return;
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
-      ReduceMemoryUsageUntilWithinLimit(std::max(
-          memory_limit_ / kModerateMemoryPressureDivider, kMinimalLimitBytes));
+      limit = std::max(memory_limit_ / kModerateMemoryPressureDivider,
+                       kMinimalLimitBytes);
       break;
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
-      ReduceMemoryUsageUntilWithinLimit(kMinimalLimitBytes);
+      limit = kMinimalLimitBytes;
       break;
   }
 #else
   switch (memory_pressure_level) {
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
-      break;
+      return;
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
       // Purge memory until usage is within half of |memory_limit_|.
-      ReduceMemoryUsageUntilWithinLimit(memory_limit_ / 2);
+      limit = memory_limit_ / 2;
       break;
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
       // Purge everything possible when pressure is critical.
-      ReduceMemoryUsageUntilWithinLimit(0);
+      limit = 0;
       break;
   }
 #endif
+
+  // Give up the memory of hidden processes first.
+  ReduceMemoryUsageOfProcessesOverBudget(limit, memory_pressure_level);
+  ReduceMemoryUsageUntilWithinLimit(limit);
 }
 
 void
@@ -528,6 +578,12 @@ void HostDiscardableSharedMemoryManager::ReduceMemoryUsageUntilWithinLimit(
 
   lock_.AssertAcquired();
   size_t bytes_allocated_before_purging = bytes_allocated_;
+
+  // Processes which exceed their share of |limit| are purged first. The LRU
+  // order below only applies to the remaining memory.
+  ReduceMemoryUsageOfProcessesOverBudget(
+      limit, base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE);
+
   while (!segments_.empty()) {
     if (bytes_allocated_ <= limit)
       break;
@@ -562,6 +618,112 @@ void HostDiscardableSharedMemoryManager::ReduceMemoryUsageUntilWithinLimit(
     BytesAllocatedChanged(bytes_allocated_);
 }
 
+void HostDiscardableSharedMemoryManager::
+    ReduceMemoryUsageOfProcessesOverBudget(
+        size_t limit,
+        base::MemoryPressureListener::MemoryPressureLevel
+            memory_pressure_level) {
+  lock_.AssertAcquired();
+
+  if (bytes_allocated_ <= limit)
+    return;
+
+  struct ProcessUsage {
+    int client_process_id;
+    ProcessPriority priority;
+    size_t bytes_allocated;
+  };
+  std::vector<ProcessUsage> process_usages;
+  int total_weight = 0;
+  for (const auto& process_entry : processes_) {
+    size_t process_bytes_allocated = 0;
+    for (const auto& segment_entry : process_entry.second)
+      process_bytes_allocated += segment_entry.second->memory()->mapped_size();
+    if (!process_bytes_allocated)
+      continue;
+
+    const ProcessPriority priority = GetProcessPriority(process_entry.first);
+    process_usages.push_back(
+        {process_entry.first, priority, process_bytes_allocated});
+    total_weight += GetProcessBudgetWeight(priority, memory_pressure_level);
+  }
+
+  // Lowest priorities first.
+  std::sort(process_usages.begin(), process_usages.end(),
+            [](const ProcessUsage& a, const ProcessUsage& b) {
+              return a.priority > b.priority;
+            });
+
+  base::Time current_time = Now();
+  bool purged_memory = false;
+  for (ProcessUsage& process_usage : process_usages) {
+    if (bytes_allocated_ <= limit)
+      break;
+
+    // 64-bit math so that this can't overflow on 32-bit systems.
+    const int weight =
+        GetProcessBudgetWeight(process_usage.priority, memory_pressure_level);
+    const size_t budget =
+        total_weight ? static_cast<size_t>(static_cast<uint64_t>(limit) *
+                                           weight / total_weight)
+                     : 0;
+    if (process_usage.bytes_allocated <= budget)
+      continue;
+
+    ReduceMemoryUsageOfProcessUntilWithinBudget(
+        processes_[process_usage.client_process_id], budget, current_time,
+        &process_usage.bytes_allocated);
+    purged_memory = true;
+  }
+
+  // Purge attempts update the usage time of segments, which can break the
+  // ordering of |segments_|.
+  if (purged_memory)
+    std::make_heap(segments_.begin(), segments_.end(), CompareMemoryUsageTime);
+}
+
+void HostDiscardableSharedMemoryManager::
+    ReduceMemoryUsageOfProcessUntilWithinBudget(
+        const MemorySegmentMap& process_segments,
+        size_t budget,
+        base::Time current_time,
+        size_t* process_bytes_allocated) {
+  lock_.AssertAcquired();
+
+  MemorySegmentVector segments;
+  for (const auto& segment_entry : process_segments) {
+    if (segment_entry.second->memory()->mapped_size())
+      segments.push_back(segment_entry.second);
+  }
+  // CompareMemoryUsageTime() orders a heap, so this sorts the LRU segment last.
+  std::sort(segments.begin(), segments.end(), CompareMemoryUsageTime);
+
+  while (!segments.empty() && *process_bytes_allocated > budget) {
+    scoped_refptr<MemorySegment> segment = segments.back();
+    segments.pop_back();
+
+    // Segments in use can't be purged.
+    if (segment->memory()->last_known_usage() >= current_time)
+      continue;
+
+    size_t size = segment->memory()->mapped_size();
+    if (segment->memory()->Purge(current_time)) {
+      ReleaseMemory(segment->memory());
+      *process_bytes_allocated -= size;
+    }
+  }
+}
+
+HostDiscardableSharedMemoryManager::ProcessPriority
+HostDiscardableSharedMemoryManager::GetProcessPriority(
+    int client_process_id) const {
+  lock_.AssertAcquired();
+
+  auto it = process_priorities_.find(client_process_id);
+  return it == process_priorities_.end() ? ProcessPriority::FOREGROUND
+                                         : it->second;
+}
+
 void HostDiscardableSharedMemoryManager::ReleaseMemory(
     base::DiscardableSharedMemory* memory) {
   lock_.AssertAcquired();
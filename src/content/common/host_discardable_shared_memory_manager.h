@@ -37,6 +37,19 @@ class CONTENT_EXPORT HostDiscardableSharedMemoryManager
     : public base::DiscardableMemoryAllocator,
       public base::trace_event::MemoryDumpProvider {
  public:
+  // Priority of a client process. The memory limit is shared between client
+  // processes according to their priority, and processes which exceed their
+  // share have their memory purged first, the lowest priorities first.
+  enum class ProcessPriority {
+    // The process has visible content. This is the default.
+    FOREGROUND,
+    // The process has no visible content but is still perceptible to the user,
+    // e.g. it plays audio.
+    PERCEPTIBLE,
+    // The process is backgrounded.
+    BACKGROUND,
+  };
+
   HostDiscardableSharedMemoryManager();
   ~HostDiscardableSharedMemoryManager() override;
 
@@ -70,6 +83,11 @@ class CONTENT_EXPORT HostDiscardableSharedMemoryManager
   // memory segments allocated for child process to the OS.
   void ProcessRemoved(int child_process_id);
 
+  // Call this to notify the manager that the priority of the child process
+  // associated with |child_process_id| changed. This doesn't purge memory
+  // right away; the new priority is used the next time memory is reduced.
+  void SetProcessPriority(int child_process_id, ProcessPriority priority);
+
   // The maximum number of bytes of memory that may be allocated. This will
   // cause memory usage to be reduced if currently above |limit|.
   void SetMemoryLimit(size_t limit);
@@ -103,6 +121,10 @@ class CONTENT_EXPORT HostDiscardableSharedMemoryManager
     return a->memory()->last_known_usage() > b->memory()->last_known_usage();
   }
 
+  typedef base::hash_map<DiscardableSharedMemoryId,
+                         scoped_refptr<MemorySegment>> MemorySegmentMap;
+  typedef base::hash_map<int, MemorySegmentMap> ProcessMap;
+
   void AllocateLockedDiscardableSharedMemory(
       base::ProcessHandle process_handle,
       int client_process_id,
@@ -115,6 +137,20 @@ class CONTENT_EXPORT HostDiscardableSharedMemoryManager
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
   void ReduceMemoryUsageUntilWithinMemoryLimit();
   void ReduceMemoryUsageUntilWithinLimit(size_t limit);
+  // Shares |limit| between client processes according to their priority and
+  // |memory_pressure_level|, and purges the processes which exceed their share
+  // until usage is within |limit|, starting with the lowest priorities.
+  void ReduceMemoryUsageOfProcessesOverBudget(
+      size_t limit,
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+  // Purges the segments of |process_segments| with the oldest usage first,
+  // until |*process_bytes_allocated| is within |budget|.
+  void ReduceMemoryUsageOfProcessUntilWithinBudget(
+      const MemorySegmentMap& process_segments,
+      size_t budget,
+      base::Time current_time,
+      size_t* process_bytes_allocated);
+  ProcessPriority GetProcessPriority(int client_process_id) const;
   void ReleaseMemory(base::DiscardableSharedMemory* memory);
   void BytesAllocatedChanged(size_t new_bytes_allocated) const;
 
@@ -123,10 +159,9 @@ class CONTENT_EXPORT HostDiscardableSharedMemoryManager
   virtual void ScheduleEnforceMemoryPolicy();
 
   base::Lock lock_;
-  typedef base::hash_map<DiscardableSharedMemoryId,
-                         scoped_refptr<MemorySegment>> MemorySegmentMap;
-  typedef base::hash_map<int, MemorySegmentMap> ProcessMap;
   ProcessMap processes_;
+  // Processes which aren't in this map have the FOREGROUND priority.
+  base::hash_map<int, ProcessPriority> process_priorities_;
   // Note: The elements in |segments_| are arranged in such a way that they form
   // a heap. The LRU memory segment always first.
   typedef std::vector<scoped_refptr<MemorySegment>> MemorySegmentVector;
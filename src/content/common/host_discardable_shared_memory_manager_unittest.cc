@@ -159,6 +159,55 @@ TEST_F(HostDiscardableSharedMemoryManagerTest, Purge) {
   EXPECT_EQ(base::DiscardableSharedMemory::SUCCESS, lock_rv);
 }
 
+TEST_F(HostDiscardableSharedMemoryManagerTest, PurgeBackgroundProcessFirst) {
+  const int kDataSize = 1024;
+  const int kForegroundProcessId = 1;
+  const int kBackgroundProcessId = 2;
+
+  base::SharedMemoryHandle shared_handle1;
+  manager_->AllocateLockedDiscardableSharedMemoryForChild(
+      base::GetCurrentProcessHandle(), kForegroundProcessId, kDataSize, 1,
+      &shared_handle1);
+  ASSERT_TRUE(base::SharedMemory::IsHandleValid(shared_handle1));
+
+  TestDiscardableSharedMemory memory1(shared_handle1);
+  bool rv = memory1.Map(kDataSize);
+  ASSERT_TRUE(rv);
+
+  base::SharedMemoryHandle shared_handle2;
+  manager_->AllocateLockedDiscardableSharedMemoryForChild(
+      base::GetCurrentProcessHandle(), kBackgroundProcessId, kDataSize, 2,
+      &shared_handle2);
+  ASSERT_TRUE(base::SharedMemory::IsHandleValid(shared_handle2));
+
+  TestDiscardableSharedMemory memory2(shared_handle2);
+  rv = memory2.Map(kDataSize);
+  ASSERT_TRUE(rv);
+
+  manager_->SetProcessPriority(
+      kBackgroundProcessId,
+      HostDiscardableSharedMemoryManager::ProcessPriority::BACKGROUND);
+
+  // The segment of the foreground process is the LRU one.
+  memory1.SetNow(base::Time::FromDoubleT(1));
+  memory1.Unlock(0, 0);
+  memory2.SetNow(base::Time::FromDoubleT(2));
+  memory2.Unlock(0, 0);
+
+  // Just enough memory for one allocation.
+  manager_->SetNow(base::Time::FromDoubleT(3));
+  manager_->SetMemoryLimit(memory1.mapped_size());
+  EXPECT_FALSE(manager_->enforce_memory_policy_pending());
+
+  // The background process is above its share of the limit, so its memory is
+  // purged even though it was used more recently.
+  EXPECT_TRUE(memory1.IsMemoryResident());
+  EXPECT_FALSE(memory2.IsMemoryResident());
+
+  ASSERT_EQ(base::DiscardableSharedMemory::SUCCESS, memory1.Lock(0, 0));
+  EXPECT_EQ(base::DiscardableSharedMemory::FAILED, memory2.Lock(0, 0));
+}
+
 TEST_F(HostDiscardableSharedMemoryManagerTest, EnforceMemoryPolicy) {
   const int kDataSize = 1024;
 
@@ -19,6 +19,10 @@ const size_t kMaxIDBMessageOverhead = 1024 * 1024;  // 1MB; arbitrarily chosen.
 const size_t kMaxIDBMessageSizeInBytes =
     IPC::Channel::kMaximumMessageSize - kMaxIDBMessageOverhead;
 
+// getAll() results larger than this are sent to the renderer in several
+// messages of about this size, rather than one message holding them all.
+const size_t kIDBGetAllChunkSizeInBytes = 1024 * 1024;
+
 }  // namespace content
 
 #endif  // CONTENT_COMMON_INDEXED_DB_INDEXED_DB_CONSTANTS_H_
@@ -380,6 +380,11 @@ IPC_MESSAGE_CONTROL1(IndexedDBMsg_CallbacksSuccessCursorPrefetch,
 IPC_MESSAGE_CONTROL1(IndexedDBMsg_CallbacksSuccessArray,
                      IndexedDBMsg_CallbacksSuccessArray_Params)
 
+// Leading part of a large getAll() result. The values are prepended to those
+// of the IndexedDBMsg_CallbacksSuccessArray that completes the request.
+IPC_MESSAGE_CONTROL1(IndexedDBMsg_CallbacksSuccessArrayChunk,
+                     IndexedDBMsg_CallbacksSuccessArray_Params)
+
 IPC_MESSAGE_CONTROL5(IndexedDBMsg_CallbacksSuccessIDBDatabase,
                      int32_t /* ipc_thread_id */,
                      int32_t /* ipc_callbacks_id */,
@@ -0,0 +1,36 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_COMMON_RESOURCE_BUFFER_CONTROL_H_
+#define CONTENT_COMMON_RESOURCE_BUFFER_CONTROL_H_
+
+#include "base/atomicops.h"
+
+namespace content {
+
+// Follows the data of the shared memory buffer sent with
+// ResourceMsg_SetDataBuffer when |has_buffer_control| is set. The browser is
+// the single producer of the chunks of the buffer, and announces each of them
+// with a ResourceMsg_DataReceived message. The renderer is the single
+// consumer, and releases the chunks in the order they were received by
+// advancing |tail| instead of sending one ResourceHostMsg_DataReceived_ACK per
+// chunk.
+//
+// The browser only needs to hear from the renderer when it ran out of space:
+// it then sets |producer_waiting| and checks |tail| again, while the renderer
+// advances |tail| and then clears |producer_waiting|. Whoever sees the other's
+// write first is responsible for resuming, so at most one wake-up message is
+// sent per time the buffer fills up.
+struct ResourceBufferControl {
+  // Number of chunks released by the renderer. Only written by the renderer,
+  // so the browser must not trust it beyond the number of chunks it sent.
+  base::subtle::Atomic32 tail;
+
+  // Non-zero while the browser is waiting for the renderer to release chunks.
+  base::subtle::Atomic32 producer_waiting;
+};
+
+}  // namespace content
+
+#endif  // CONTENT_COMMON_RESOURCE_BUFFER_CONTROL_H_
@@ -295,13 +295,18 @@ IPC_MESSAGE_CONTROL3(ResourceMsg_ReceivedRedirect,
 // NOTE: The shared memory handle should already be mapped into the process
 // that receives this message.
 //
+// If |has_buffer_control| is true, the |shm_size| bytes of data are followed
+// by a content::ResourceBufferControl, through which the renderer releases the
+// byte ranges instead of acknowledging each DataReceived message.
+//
 // TODO(darin): The |renderer_pid| parameter is just a temporary parameter,
 // added to help in debugging crbug/160401.
 //
-IPC_MESSAGE_CONTROL4(ResourceMsg_SetDataBuffer,
+IPC_MESSAGE_CONTROL5(ResourceMsg_SetDataBuffer,
                      int /* request_id */,
                      base::SharedMemoryHandle /* shm_handle */,
                      int /* shm_size */,
+                     bool /* has_buffer_control */,
                      base::ProcessId /* renderer_pid */)
 
 // Sent when a chunk of data from a resource request is ready, and the resource
@@ -362,6 +367,11 @@ IPC_SYNC_MESSAGE_ROUTED2_1(ResourceHostMsg_SyncLoad,
 IPC_MESSAGE_CONTROL1(ResourceHostMsg_DataReceived_ACK,
                      int /* request_id */)
 
+// Sent when the renderer released data through the ResourceBufferControl of
+// the data buffer while the browser was waiting for space in it.
+IPC_MESSAGE_CONTROL1(ResourceHostMsg_DataBufferReleased,
+                     int /* request_id */)
+
 // Sent when the renderer has processed a DataDownloaded message.
 IPC_MESSAGE_CONTROL1(ResourceHostMsg_DataDownloaded_ACK,
                      int /* request_id */)
@@ -417,6 +417,10 @@ void GpuChildThread::OnInitialize(const gpu::GpuPreferences& gpu_preferences) {
                             ChildProcess::current()->io_task_runner(),
                             ChildProcess::current()->GetShutDownEvent(),
                             sync_point_manager, gpu_memory_buffer_factory_));
+  // Program binaries can only be loaded by the driver that produced them.
+  gpu_channel_manager_->InitializeProgramDiskCache(
+      gpu_info_.gl_vendor + "|" + gpu_info_.gl_renderer + "|" +
+      gpu_info_.gl_version + "|" + gpu_info_.driver_version);
 
   media_service_.reset(new media::MediaService(gpu_channel_manager_.get()));
 
@@ -85,6 +85,8 @@ const gpu::GpuPreferences GetGpuPreferencesFromCommandLine() {
   }
   gpu_preferences.disable_gpu_shader_disk_cache =
       command_line->HasSwitch(switches::kDisableGpuShaderDiskCache);
+  gpu_preferences.gpu_program_disk_cache_dir =
+      command_line->GetSwitchValuePath(switches::kGpuProgramDiskCacheDir);
   gpu_preferences.enable_share_group_async_texture_upload =
       command_line->HasSwitch(switches::kEnableShareGroupAsyncTextureUpload);
   gpu_preferences.enable_threaded_texture_mailboxes =
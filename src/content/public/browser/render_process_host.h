@@ -370,6 +370,20 @@ class CONTENT_EXPORT RenderProcessHost : public IPC::Sender,
   // Returns the current maximum number of renderer process hosts kept by the
   // content module.
   static size_t GetMaxRendererProcessCount();
+
+  // Launches renderer processes for |browser_context| ahead of time, until
+  // |count| spare ones are waiting to be used. A spare process has already
+  // initialized V8 and Blink, so the next SiteInstance that needs a new
+  // process in the default storage partition starts without waiting for a
+  // launch. Spare processes are not replaced once used; call this again when
+  // the browser is idle. Does nothing in single-process mode.
+  static void WarmupSpareRenderProcessHosts(
+      content::BrowserContext* browser_context,
+      size_t count);
+
+  // Shuts down all the spare renderer processes. They are also shut down
+  // under memory pressure and when their browser context is destroyed.
+  static void DiscardSpareRenderProcessHosts();
 };
 
 }  // namespace content.
@@ -44,6 +44,11 @@ const base::Feature kDocumentWriteEvaluator{"DocumentWriteEvaluator",
 const base::Feature kFontCacheScaling{"FontCacheScaling",
                                       base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Stores large IndexedDB values snappy-compressed. Enabling this upgrades the
+// backing store schema, so the data can't be opened by older versions.
+const base::Feature kIndexedDBValueCompression{
+    "IndexedDBValueCompression", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Can main thread be pipelined with activation. Always disabled for devices
 // with fewer than 4 cores irrespective of this flag. Can also be overridden by
 // --enable(disable)-main-frame-before-activation command line flag.
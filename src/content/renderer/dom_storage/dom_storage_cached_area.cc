@@ -52,8 +52,8 @@ bool DOMStorageCachedArea::SetItem(int connection_id,
     return false;
 
   PrimeIfNeeded(connection_id);
-  base::NullableString16 unused;
-  if (!map_->SetItem(key, value, &unused))
+  base::NullableString16 old_value;
+  if (!map_->SetItem(key, value, &old_value))
     return false;
 
   // Ignore mutations to 'key' until OnSetItemComplete.
@@ -61,7 +61,7 @@ bool DOMStorageCachedArea::SetItem(int connection_id,
   proxy_->SetItem(
       connection_id, key, value, page_url,
       base::Bind(&DOMStorageCachedArea::OnSetItemComplete,
-                 weak_factory_.GetWeakPtr(), key));
+                 weak_factory_.GetWeakPtr(), key, old_value));
   return true;
 }
 
@@ -115,14 +115,17 @@ void DOMStorageCachedArea::ApplyMutation(
         base::NullableString16 unused;
         map_->SetItem(iter->first, value.string(), &unused);
       }
+      keys_with_dropped_mutations_.insert(iter->first);
       ++iter;
     }
     return;
   }
 
   // We have to retain local changes.
-  if (should_ignore_key_mutation(key.string()))
+  if (should_ignore_key_mutation(key.string())) {
+    keys_with_dropped_mutations_.insert(key.string());
     return;
+  }
 
   if (new_value.is_null()) {
     // It's a remove item event.
@@ -140,6 +143,10 @@ void DOMStorageCachedArea::ApplyMutation(
   map_->set_quota(kPerStorageAreaQuota);
 }
 
+size_t DOMStorageCachedArea::map_usage_in_bytes() const {
+  return map_ ? map_->bytes_used() : 0;
+}
+
 void DOMStorageCachedArea::Prime(int connection_id) {
   DCHECK(!map_.get());
 
@@ -191,6 +198,7 @@ void DOMStorageCachedArea::Reset() {
   map_ = NULL;
   weak_factory_.InvalidateWeakPtrs();
   ignore_key_mutations_.clear();
+  keys_with_dropped_mutations_.clear();
   ignore_all_mutations_ = false;
 }
 
@@ -200,17 +208,36 @@ void DOMStorageCachedArea::OnLoadComplete(bool success) {
   ignore_all_mutations_ = false;
 }
 
-void DOMStorageCachedArea::OnSetItemComplete(const base::string16& key,
-                                             bool success) {
-  if (!success) {
-    Reset();
-    return;
-  }
+void DOMStorageCachedArea::OnSetItemComplete(
+    const base::string16& key,
+    const base::NullableString16& old_value,
+    bool success) {
   std::map<base::string16, int>::iterator found =
       ignore_key_mutations_.find(key);
   DCHECK(found != ignore_key_mutations_.end());
-  if (--found->second == 0)
+  if (!success) {
+    // The browser kept its value for |key|. When this was the only pending
+    // change to |key| and nothing from other processes was dropped meanwhile,
+    // that is still |old_value|, so only that entry needs to be rolled back.
+    // Otherwise the cache can't be trusted and is reloaded.
+    if (found->second != 1 || keys_with_dropped_mutations_.count(key)) {
+      Reset();
+      return;
+    }
+    if (old_value.is_null()) {
+      base::string16 unused;
+      map_->RemoveItem(key, &unused);
+    } else {
+      base::NullableString16 unused;
+      map_->set_quota(std::numeric_limits<int32_t>::max());
+      map_->SetItem(key, old_value.string(), &unused);
+      map_->set_quota(kPerStorageAreaQuota);
+    }
+  }
+  if (--found->second == 0) {
     ignore_key_mutations_.erase(found);
+    keys_with_dropped_mutations_.erase(key);
+  }
 }
 
 void DOMStorageCachedArea::OnRemoveItemComplete(const base::string16& key,
@@ -219,8 +246,10 @@ void DOMStorageCachedArea::OnRemoveItemComplete(const base::string16& key,
   std::map<base::string16, int>::iterator found =
       ignore_key_mutations_.find(key);
   DCHECK(found != ignore_key_mutations_.end());
-  if (--found->second == 0)
+  if (--found->second == 0) {
     ignore_key_mutations_.erase(found);
+    keys_with_dropped_mutations_.erase(key);
+  }
 }
 
 void DOMStorageCachedArea::OnClearComplete(bool success) {
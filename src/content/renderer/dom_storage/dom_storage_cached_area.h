@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include <map>
+#include <set>
 
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
@@ -52,6 +53,10 @@ class CONTENT_EXPORT DOMStorageCachedArea
   void ApplyMutation(const base::NullableString16& key,
                      const base::NullableString16& new_value);
 
+  // Returns the size of the cached key/value pairs, or 0 if the cache is not
+  // primed.
+  size_t map_usage_in_bytes() const;
+
  private:
   friend class DOMStorageCachedAreaTest;
   friend class base::RefCounted<DOMStorageCachedArea>;
@@ -72,7 +77,9 @@ class CONTENT_EXPORT DOMStorageCachedArea
   // mutation events from other processes from overwriting local
   // changes made after the mutation.
   void OnLoadComplete(bool success);
-  void OnSetItemComplete(const base::string16& key, bool success);
+  void OnSetItemComplete(const base::string16& key,
+                         const base::NullableString16& old_value,
+                         bool success);
   void OnClearComplete(bool success);
   void OnRemoveItemComplete(const base::string16& key, bool success);
 
@@ -82,6 +89,9 @@ class CONTENT_EXPORT DOMStorageCachedArea
 
   bool ignore_all_mutations_;
   std::map<base::string16, int> ignore_key_mutations_;
+  // Keys in |ignore_key_mutations_| for which a mutation from another process
+  // was dropped, so a failed local change to them can't simply be undone.
+  std::set<base::string16> keys_with_dropped_mutations_;
 
   int64_t namespace_id_;
   GURL origin_;
@@ -346,10 +346,33 @@ TEST_F(DOMStorageCachedAreaTest, KeyMutationsAreIgnoredUntilCompletion) {
   mock_proxy_->CompleteOnePendingCallback(true);  // remove completion
   EXPECT_FALSE(IsIgnoringKeyMutations(cached_area.get(), kKey));
 
-  // A failed set item operation should Reset the cache.
+  // A failed set item operation should only undo that change.
+  const base::string16 kOtherKey = base::ASCIIToUTF16("other");
+  EXPECT_TRUE(
+      cached_area->SetItem(kConnectionId, kOtherKey, kValue, kPageUrl));
+  mock_proxy_->CompleteOnePendingCallback(true);
   EXPECT_TRUE(cached_area->SetItem(kConnectionId, kKey, kValue, kPageUrl));
   EXPECT_TRUE(IsIgnoringKeyMutations(cached_area.get(), kKey));
   mock_proxy_->CompleteOnePendingCallback(false);
+  EXPECT_TRUE(IsPrimed(cached_area.get()));
+  EXPECT_FALSE(IsIgnoringKeyMutations(cached_area.get(), kKey));
+  EXPECT_TRUE(cached_area->GetItem(kConnectionId, kKey).is_null());
+  EXPECT_EQ(kValue, cached_area->GetItem(kConnectionId, kOtherKey).string());
+
+  // A failed overwrite restores the previous value.
+  const base::string16 kNewValue = base::ASCIIToUTF16("new");
+  EXPECT_TRUE(
+      cached_area->SetItem(kConnectionId, kOtherKey, kNewValue, kPageUrl));
+  mock_proxy_->CompleteOnePendingCallback(false);
+  EXPECT_TRUE(IsPrimed(cached_area.get()));
+  EXPECT_EQ(kValue, cached_area->GetItem(kConnectionId, kOtherKey).string());
+
+  // If a mutation from another process was dropped while the failed set item
+  // operation was pending, the cache should be Reset.
+  EXPECT_TRUE(cached_area->SetItem(kConnectionId, kKey, kValue, kPageUrl));
+  cached_area->ApplyMutation(base::NullableString16(kKey, false),
+                             base::NullableString16(kNewValue, false));
+  mock_proxy_->CompleteOnePendingCallback(false);
   EXPECT_FALSE(IsPrimed(cached_area.get()));
 }
 
@@ -4,11 +4,18 @@
 
 #include "content/renderer/dom_storage/dom_storage_dispatcher.h"
 
+#include <inttypes.h>
+
+#include <cctype>  // for std::isalnum
 #include <list>
 #include <map>
 
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "base/synchronization/lock.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "content/common/dom_storage/dom_storage_messages.h"
 #include "content/common/dom_storage/dom_storage_types.h"
 #include "content/renderer/dom_storage/dom_storage_cached_area.h"
@@ -106,6 +113,8 @@ class DomStorageDispatcher::ProxyImpl : public DOMStorageProxy {
                                          const GURL& origin);
   void CompleteOnePendingCallback(bool success);
   void Shutdown();
+  void OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd);
 
   // DOMStorageProxy interface for use by DOMStorageCachedArea.
   void LoadArea(int connection_id,
@@ -230,6 +239,51 @@ void DomStorageDispatcher::ProxyImpl::Shutdown() {
   pending_callbacks_.clear();
 }
 
+void DomStorageDispatcher::ProxyImpl::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  const char* system_allocator_name =
+      base::trace_event::MemoryDumpManager::GetInstance()
+          ->system_allocator_pool_name();
+
+  // Background dumps must not name origins, so only the total is reported.
+  if (args.level_of_detail ==
+      base::trace_event::MemoryDumpLevelOfDetail::BACKGROUND) {
+    size_t total_size = 0;
+    for (const auto& it : cached_areas_)
+      total_size += it.second.area_->map_usage_in_bytes();
+    auto mad = pmd->CreateAllocatorDump("dom_storage/cache_size");
+    mad->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                   base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                   total_size);
+    mad->AddScalar("total_areas",
+                   base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                   cached_areas_.size());
+    if (system_allocator_name)
+      pmd->AddSuballocation(mad->guid(), system_allocator_name);
+    return;
+  }
+
+  for (const auto& it : cached_areas_) {
+    const DOMStorageCachedArea* area = it.second.area_.get();
+    // Limit the url length to 50 and strip special characters, as the browser
+    // side dumps do.
+    std::string url = area->origin().spec().substr(0, 50);
+    for (size_t index = 0; index < url.size(); ++index) {
+      if (!std::isalnum(url[index]))
+        url[index] = '_';
+    }
+    auto mad = pmd->CreateAllocatorDump(
+        base::StringPrintf("dom_storage/%s/0x%" PRIXPTR "/cache_map",
+                           url.c_str(), reinterpret_cast<uintptr_t>(area)));
+    mad->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                   base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                   area->map_usage_in_bytes());
+    if (system_allocator_name)
+      pmd->AddSuballocation(mad->guid(), system_allocator_name);
+  }
+}
+
 void DomStorageDispatcher::ProxyImpl::LoadArea(
     int connection_id, DOMStorageValuesMap* values,
     const CompletionCallback& callback) {
@@ -267,9 +321,13 @@ void DomStorageDispatcher::ProxyImpl::ClearArea(int connection_id,
 
 DomStorageDispatcher::DomStorageDispatcher()
     : proxy_(new ProxyImpl(RenderThreadImpl::current())) {
+  base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      this, "DOMStorage", base::ThreadTaskRunnerHandle::Get());
 }
 
 DomStorageDispatcher::~DomStorageDispatcher() {
+  base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+      this);
   proxy_->Shutdown();
 }
 
@@ -301,6 +359,13 @@ bool DomStorageDispatcher::OnMessageReceived(const IPC::Message& msg) {
   return handled;
 }
 
+bool DomStorageDispatcher::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  proxy_->OnMemoryDump(args, pmd);
+  return true;
+}
+
 void DomStorageDispatcher::OnStorageEvent(
     const DOMStorageMsg_Event_Params& params) {
   WebStorageAreaImpl* originating_area = NULL;
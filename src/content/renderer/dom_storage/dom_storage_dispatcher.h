@@ -7,7 +7,9 @@
 
 #include <stdint.h>
 
+#include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/trace_event/memory_dump_provider.h"
 
 class GURL;
 struct DOMStorageMsg_Event_Params;
@@ -25,10 +27,10 @@ class DOMStorageCachedArea;
 // are dispatched on the main renderer thread. The RenderThreadImpl
 // creates an instance and delegates calls to it. This classes also manages
 // the collection of DOMStorageCachedAreas that are active in the process.
-class DomStorageDispatcher {
+class DomStorageDispatcher : public base::trace_event::MemoryDumpProvider {
  public:
   DomStorageDispatcher();
-  ~DomStorageDispatcher();
+  ~DomStorageDispatcher() override;
 
   // Each call to open should be balanced with a call to close.
   scoped_refptr<DOMStorageCachedArea> OpenCachedArea(int connection_id,
@@ -38,6 +40,11 @@ class DomStorageDispatcher {
 
   bool OnMessageReceived(const IPC::Message& msg);
 
+  // base::trace_event::MemoryDumpProvider implementation. Reports the size of
+  // each cached area, so per-origin usage shows up in renderer dumps.
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
  private:
   class ProxyImpl;
 
@@ -46,6 +53,8 @@ class DomStorageDispatcher {
   void OnAsyncOperationComplete(bool success);
 
   scoped_refptr<ProxyImpl> proxy_;
+
+  DISALLOW_COPY_AND_ASSIGN(DomStorageDispatcher);
 };
 
 }  // namespace content
@@ -50,6 +50,7 @@
 #include "content/renderer/input/input_handler_manager.h"
 #include "gpu/command_buffer/client/gles2_interface.h"
 #include "gpu/command_buffer/service/gpu_switches.h"
+#include "ipc/ipc_sync_channel.h"
 #include "third_party/WebKit/public/platform/WebCompositeAndReadbackAsyncCallback.h"
 #include "third_party/WebKit/public/platform/WebCompositorMutatorClient.h"
 #include "third_party/WebKit/public/platform/WebLayoutAndPaintAsyncCallback.h"
@@ -288,6 +289,8 @@ cc::LayerTreeSettings RenderWidgetCompositor::GenerateLayerTreeSettings(
   }
   settings.main_frame_before_activation_enabled =
       cmd.HasSwitch(cc::switches::kEnableMainFrameBeforeActivation);
+  settings.use_predictive_begin_frame_deadline =
+      cmd.HasSwitch(cc::switches::kEnablePredictiveBeginFrameDeadline);
 
   // TODO(danakj): This should not be a setting O_O; it should change when the
   // device scale factor on LayerTreeHost changes.
@@ -499,6 +502,8 @@ cc::LayerTreeSettings RenderWidgetCompositor::GenerateLayerTreeSettings(
   if (cmd.HasSwitch(cc::switches::kEnableTileCompression)) {
     settings.renderer_settings.preferred_tile_format = cc::ETC1;
   }
+  settings.use_stable_tile_compression =
+      cmd.HasSwitch(cc::switches::kEnableStableTileCompression);
 
   settings.max_staging_buffer_usage_in_bytes = 32 * 1024 * 1024;  // 32MB
   // Use 1/4th of staging buffers on low-end devices.
@@ -1021,6 +1026,7 @@ void RenderWidgetCompositor::DidBeginMainFrame() {
 void RenderWidgetCompositor::BeginMainFrame(const cc::BeginFrameArgs& args) {
   compositor_deps_->GetRendererScheduler()->WillBeginFrame(args);
   double frame_time_sec = (args.frame_time - base::TimeTicks()).InSecondsF();
+  IPC::SyncChannel::ScopedSyncAudit sync_audit;
   delegate_->BeginMainFrame(frame_time_sec);
 }
 
@@ -1029,7 +1035,10 @@ void RenderWidgetCompositor::BeginMainFrameNotExpectedSoon() {
 }
 
 void RenderWidgetCompositor::UpdateLayerTreeHost() {
-  delegate_->UpdateVisualState();
+  {
+    IPC::SyncChannel::ScopedSyncAudit sync_audit;
+    delegate_->UpdateVisualState();
+  }
   if (temporary_copy_output_request_) {
     // For WebViewImpl, this will always have a root layer.  For other widgets,
     // the widget may be closed before servicing this request, so ignore it.
@@ -18,6 +18,8 @@
 #include "content/renderer/input/input_handler_manager_client.h"
 #include "content/renderer/input/input_handler_wrapper.h"
 #include "ui/events/blink/input_handler_proxy.h"
+#include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/vector2d_f.h"
 
 using blink::WebInputEvent;
 using ui::InputHandlerProxy;
@@ -208,6 +210,33 @@ void InputHandlerManager::NotifyInputEventHandledOnCompositorThread(
   client_->NotifyInputEventHandled(routing_id, handled_type, ack_result);
 }
 
+void InputHandlerManager::AnimateScrollOnMainThread(
+    int routing_id,
+    const gfx::Point& viewport_point,
+    const gfx::Vector2dF& scroll_delta,
+    const base::Closure& fallback) {
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(&InputHandlerManager::AnimateScrollOnCompositorThread,
+                 base::Unretained(this), routing_id, viewport_point,
+                 scroll_delta, base::ThreadTaskRunnerHandle::Get(), fallback));
+}
+
+void InputHandlerManager::AnimateScrollOnCompositorThread(
+    int routing_id,
+    const gfx::Point& viewport_point,
+    const gfx::Vector2dF& scroll_delta,
+    const scoped_refptr<base::SingleThreadTaskRunner>& main_task_runner,
+    const base::Closure& fallback) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end() ||
+      !it->second->input_handler_proxy()->AnimateScroll(viewport_point,
+                                                        scroll_delta)) {
+    main_task_runner->PostTask(FROM_HERE, fallback);
+  }
+}
+
 InputEventAckState InputHandlerManager::HandleInputEvent(
     int routing_id,
     const WebInputEvent* input_event,
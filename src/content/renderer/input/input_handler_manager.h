@@ -5,6 +5,7 @@
 #ifndef CONTENT_RENDERER_INPUT_INPUT_HANDLER_MANAGER_H_
 #define CONTENT_RENDERER_INPUT_INPUT_HANDLER_MANAGER_H_
 
+#include "base/callback_forward.h"
 #include "base/containers/scoped_ptr_hash_map.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
@@ -26,6 +27,11 @@ class WebInputEvent;
 class WebMouseWheelEvent;
 }
 
+namespace gfx {
+class Point;
+class Vector2dF;
+}
+
 namespace scheduler {
 class RendererScheduler;
 }
@@ -70,6 +76,15 @@ class CONTENT_EXPORT InputHandlerManager {
                                            blink::WebInputEvent::Type,
                                            InputEventAckState);
 
+  // Asks the compositor to animate a scroll by |scroll_delta| of the layer
+  // under |viewport_point|, so that it runs at the display rate even while
+  // the main thread is busy. If the compositor can't, |fallback| is posted
+  // back to the main thread to run the scroll there.
+  void AnimateScrollOnMainThread(int routing_id,
+                                 const gfx::Point& viewport_point,
+                                 const gfx::Vector2dF& scroll_delta,
+                                 const base::Closure& fallback);
+
   // Callback only from the compositor's thread.
   void RemoveInputHandler(int routing_id);
 
@@ -115,6 +130,13 @@ class CONTENT_EXPORT InputHandlerManager {
                                                  blink::WebInputEvent::Type,
                                                  InputEventAckState);
 
+  void AnimateScrollOnCompositorThread(
+      int routing_id,
+      const gfx::Point& viewport_point,
+      const gfx::Vector2dF& scroll_delta,
+      const scoped_refptr<base::SingleThreadTaskRunner>& main_task_runner,
+      const base::Closure& fallback);
+
   typedef base::ScopedPtrHashMap<int,  // routing_id
                                  std::unique_ptr<InputHandlerWrapper>>
       InputHandlerMap;
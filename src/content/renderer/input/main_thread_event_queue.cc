@@ -6,6 +6,55 @@
 
 namespace content {
 
+namespace {
+
+// Queues |event| if an event of the same kind is in flight to the main
+// thread, coalescing it with the last queued one when possible. Otherwise
+// sends it straight away.
+template <typename T>
+void QueueOrSendEvent(MainThreadEventQueueClient* client,
+                      int routing_id,
+                      WebInputEventQueue<T>* queue,
+                      const T& event,
+                      bool non_blocking,
+                      InputEventDispatchType original_dispatch_type) {
+  if (queue->state() == WebInputEventQueueState::ITEM_PENDING) {
+    queue->Queue(event);
+  } else {
+    if (non_blocking) {
+      queue->set_state(WebInputEventQueueState::ITEM_PENDING);
+      client->SendEventToMainThread(routing_id, &event.event, event.latency,
+                                    event.type);
+    } else {
+      // If there is nothing in the event queue and the event is
+      // blocking pass the |original_dispatch_type| to avoid
+      // having the main thread call us back as an optimization.
+      client->SendEventToMainThread(routing_id, &event.event, event.latency,
+                                    original_dispatch_type);
+    }
+  }
+}
+
+// Sends the next queued event to the main thread now that the one in flight
+// has been handled.
+template <typename T>
+void SendNextEvent(MainThreadEventQueueClient* client,
+                   int routing_id,
+                   WebInputEventQueue<T>* queue,
+                   std::unique_ptr<T>* in_flight_event) {
+  if (!queue->empty()) {
+    *in_flight_event = queue->Pop();
+    client->SendEventToMainThread(routing_id, &(*in_flight_event)->event,
+                                  (*in_flight_event)->latency,
+                                  (*in_flight_event)->type);
+  } else {
+    in_flight_event->reset();
+    queue->set_state(WebInputEventQueueState::ITEM_NOT_PENDING);
+  }
+}
+
+}  // namespace
+
 MainThreadEventQueue::MainThreadEventQueue(int routing_id,
                                            MainThreadEventQueueClient* client)
     : routing_id_(routing_id), client_(client), is_flinging_(false) {}
@@ -42,23 +91,9 @@ bool MainThreadEventQueue::HandleEvent(
           blink::WebInputEvent::ListenersNonBlockingPassive;
     }
 
-    if (wheel_events_.state() == WebInputEventQueueState::ITEM_PENDING) {
-      wheel_events_.Queue(modified_dispatch_type_event);
-    } else {
-      if (non_blocking) {
-        wheel_events_.set_state(WebInputEventQueueState::ITEM_PENDING);
-        client_->SendEventToMainThread(routing_id_,
-                                       &modified_dispatch_type_event.event,
-                                       latency, dispatch_type);
-      } else {
-        // If there is nothing in the event queue and the event is
-        // blocking pass the |original_dispatch_type| to avoid
-        // having the main thread call us back as an optimization.
-        client_->SendEventToMainThread(routing_id_,
-                                       &modified_dispatch_type_event.event,
-                                       latency, original_dispatch_type);
-      }
-    }
+    QueueOrSendEvent(client_, routing_id_, &wheel_events_,
+                     modified_dispatch_type_event, non_blocking,
+                     original_dispatch_type);
   } else if (blink::WebInputEvent::isTouchEventType(event->type)) {
     PendingTouchEvent modified_dispatch_type_event =
         PendingTouchEvent(*static_cast<const blink::WebTouchEvent*>(event),
@@ -72,23 +107,23 @@ bool MainThreadEventQueue::HandleEvent(
           blink::WebInputEvent::ListenersNonBlockingPassive;
     }
 
-    if (touch_events_.state() == WebInputEventQueueState::ITEM_PENDING) {
-      touch_events_.Queue(modified_dispatch_type_event);
-    } else {
-      if (non_blocking) {
-        touch_events_.set_state(WebInputEventQueueState::ITEM_PENDING);
-        client_->SendEventToMainThread(routing_id_,
-                                       &modified_dispatch_type_event.event,
-                                       latency, dispatch_type);
-      } else {
-        // If there is nothing in the event queue and the event is
-        // blocking pass the |original_dispatch_type| to avoid
-        // having the main thread call us back as an optimization.
-        client_->SendEventToMainThread(routing_id_,
-                                       &modified_dispatch_type_event.event,
-                                       latency, original_dispatch_type);
-      }
-    }
+    QueueOrSendEvent(client_, routing_id_, &touch_events_,
+                     modified_dispatch_type_event, non_blocking,
+                     original_dispatch_type);
+  } else if (blink::WebInputEvent::isMouseEventType(event->type)) {
+    // All mouse events go through the same queue so that a click can't
+    // overtake the mousemoves queued before it.
+    QueueOrSendEvent(
+        client_, routing_id_, &mouse_events_,
+        PendingMouseEvent(*static_cast<const blink::WebMouseEvent*>(event),
+                          latency, dispatch_type),
+        non_blocking, original_dispatch_type);
+  } else if (blink::WebInputEvent::isGestureEventType(event->type)) {
+    QueueOrSendEvent(
+        client_, routing_id_, &gesture_events_,
+        PendingGestureEvent(*static_cast<const blink::WebGestureEvent*>(event),
+                            latency, dispatch_type),
+        non_blocking, original_dispatch_type);
   } else {
     client_->SendEventToMainThread(routing_id_, event, latency,
                                    original_dispatch_type);
@@ -105,15 +140,8 @@ void MainThreadEventQueue::EventHandled(blink::WebInputEvent::Type type,
     DCHECK(!in_flight_wheel_event_ ||
            in_flight_wheel_event_->eventsToAck.size() == 0);
 
-    if (!wheel_events_.empty()) {
-      in_flight_wheel_event_ = wheel_events_.Pop();
-      client_->SendEventToMainThread(
-          routing_id_, &in_flight_wheel_event_->event,
-          in_flight_wheel_event_->latency, in_flight_wheel_event_->type);
-    } else {
-      in_flight_wheel_event_.reset();
-      wheel_events_.set_state(WebInputEventQueueState::ITEM_NOT_PENDING);
-    }
+    SendNextEvent(client_, routing_id_, &wheel_events_,
+                  &in_flight_wheel_event_);
   } else if (blink::WebInputEvent::isTouchEventType(type)) {
     if (in_flight_touch_event_) {
       // Send acks for blocking touch events.
@@ -121,15 +149,14 @@ void MainThreadEventQueue::EventHandled(blink::WebInputEvent::Type type,
         client_->SendInputEventAck(routing_id_, type, ack_result, id);
     }
 
-    if (!touch_events_.empty()) {
-      in_flight_touch_event_ = touch_events_.Pop();
-      client_->SendEventToMainThread(
-          routing_id_, &in_flight_touch_event_->event,
-          in_flight_touch_event_->latency, in_flight_touch_event_->type);
-    } else {
-      in_flight_touch_event_.reset();
-      touch_events_.set_state(WebInputEventQueueState::ITEM_NOT_PENDING);
-    }
+    SendNextEvent(client_, routing_id_, &touch_events_,
+                  &in_flight_touch_event_);
+  } else if (blink::WebInputEvent::isMouseEventType(type)) {
+    SendNextEvent(client_, routing_id_, &mouse_events_,
+                  &in_flight_mouse_event_);
+  } else if (blink::WebInputEvent::isGestureEventType(type)) {
+    SendNextEvent(client_, routing_id_, &gesture_events_,
+                  &in_flight_gesture_event_);
   } else {
     NOTREACHED() << "Invalid passive event type";
   }
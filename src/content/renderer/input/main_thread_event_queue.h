@@ -52,6 +52,12 @@ using PendingMouseWheelEvent =
 using PendingTouchEvent =
     EventWithDispatchType<TouchEventWithLatencyInfo, blink::WebTouchEvent>;
 
+using PendingMouseEvent =
+    EventWithDispatchType<MouseEventWithLatencyInfo, blink::WebMouseEvent>;
+
+using PendingGestureEvent =
+    EventWithDispatchType<GestureEventWithLatencyInfo, blink::WebGestureEvent>;
+
 class CONTENT_EXPORT MainThreadEventQueueClient {
  public:
   // Send an |event| that was previously queued (possibly
@@ -68,15 +74,16 @@ class CONTENT_EXPORT MainThreadEventQueueClient {
                                  uint32_t touch_event_id) = 0;
 };
 
-// MainThreadEventQueue implements a series of queues (one touch
-// and one mouse wheel) for events that need to be queued between
+// MainThreadEventQueue implements a series of queues (touch, mouse
+// wheel, mouse and gesture) for events that need to be queued between
 // the compositor and main threads. When an event is sent
 // from the compositor to main it can either be sent directly if no
 // outstanding events of that type are in flight; or it needs to
 // wait in a queue until the main thread has finished processing
-// the in-flight event. This class tracks the state and queues
-// for the event types. Methods on this class should only be called
-// from the compositor thread.
+// the in-flight event. Continuous events such as touchmoves, mousemoves
+// and gesture scroll updates are coalesced while they wait. This class
+// tracks the state and queues for the event types. Methods on this class
+// should only be called from the compositor thread.
 //
 // Below some example flows are how the code behaves.
 // Legend: B=Browser, C=Compositor, M=Main Thread, NB=Non-blocking
@@ -129,12 +136,16 @@ class CONTENT_EXPORT MainThreadEventQueue {
   MainThreadEventQueueClient* client_;
   WebInputEventQueue<PendingMouseWheelEvent> wheel_events_;
   WebInputEventQueue<PendingTouchEvent> touch_events_;
+  WebInputEventQueue<PendingMouseEvent> mouse_events_;
+  WebInputEventQueue<PendingGestureEvent> gesture_events_;
   bool is_flinging_;
 
   // TODO(dtapuska): These can be removed when the queues are dequeued
   // on the main thread. See crbug.com/624021
   std::unique_ptr<PendingMouseWheelEvent> in_flight_wheel_event_;
   std::unique_ptr<PendingTouchEvent> in_flight_touch_event_;
+  std::unique_ptr<PendingMouseEvent> in_flight_mouse_event_;
+  std::unique_ptr<PendingGestureEvent> in_flight_gesture_event_;
 
   DISALLOW_COPY_AND_ASSIGN(MainThreadEventQueue);
 };
@@ -14,6 +14,7 @@
 #include "content/renderer/input/main_thread_event_queue.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+using blink::WebGestureEvent;
 using blink::WebInputEvent;
 using blink::WebMouseEvent;
 using blink::WebMouseWheelEvent;
@@ -55,6 +56,14 @@ class MainThreadEventQueueTest : public testing::Test,
     return queue_.touch_events_;
   }
 
+  WebInputEventQueue<PendingMouseEvent>& mouse_event_queue() {
+    return queue_.mouse_events_;
+  }
+
+  WebInputEventQueue<PendingGestureEvent>& gesture_event_queue() {
+    return queue_.gesture_events_;
+  }
+
  protected:
   MainThreadEventQueue queue_;
   std::vector<unsigned char> last_event_;
@@ -179,4 +188,75 @@ TEST_F(MainThreadEventQueueTest, BlockingTouch) {
   ASSERT_EQ(kEvents[3].uniqueTouchEventId, additional_acked_events_.at(1));
 }
 
+TEST_F(MainThreadEventQueueTest, NonBlockingMouseMove) {
+  WebMouseEvent kEvents[4] = {
+      SyntheticWebMouseEventBuilder::Build(WebInputEvent::MouseMove, 10, 10, 0),
+      SyntheticWebMouseEventBuilder::Build(WebInputEvent::MouseMove, 20, 20, 0),
+      SyntheticWebMouseEventBuilder::Build(WebInputEvent::MouseMove, 30, 30, 0),
+      SyntheticWebMouseEventBuilder::Build(WebInputEvent::MouseDown, 30, 30, 0),
+  };
+
+  ASSERT_EQ(WebInputEventQueueState::ITEM_NOT_PENDING,
+            mouse_event_queue().state());
+  queue_.HandleEvent(&kEvents[0], ui::LatencyInfo(), DISPATCH_TYPE_NON_BLOCKING,
+                     INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  ASSERT_EQ(WebInputEventQueueState::ITEM_PENDING, mouse_event_queue().state());
+  ASSERT_EQ(kEvents[0].size, last_event_.size());
+  ASSERT_TRUE(memcmp(&last_event_[0], &kEvents[0], kEvents[0].size) == 0);
+
+  // The moves are coalesced, but the click is not moved ahead of them.
+  queue_.HandleEvent(&kEvents[1], ui::LatencyInfo(), DISPATCH_TYPE_NON_BLOCKING,
+                     INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  queue_.HandleEvent(&kEvents[2], ui::LatencyInfo(), DISPATCH_TYPE_NON_BLOCKING,
+                     INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  queue_.HandleEvent(&kEvents[3], ui::LatencyInfo(), DISPATCH_TYPE_BLOCKING,
+                     INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  ASSERT_EQ(2u, mouse_event_queue().size());
+
+  queue_.EventHandled(WebInputEvent::MouseMove,
+                      INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  ASSERT_EQ(kEvents[2].size, last_event_.size());
+  ASSERT_TRUE(memcmp(&last_event_[0], &kEvents[2], kEvents[2].size) == 0);
+  queue_.EventHandled(WebInputEvent::MouseMove,
+                      INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  ASSERT_EQ(kEvents[3].size, last_event_.size());
+  ASSERT_TRUE(memcmp(&last_event_[0], &kEvents[3], kEvents[3].size) == 0);
+  queue_.EventHandled(WebInputEvent::MouseDown,
+                      INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  ASSERT_EQ(WebInputEventQueueState::ITEM_NOT_PENDING,
+            mouse_event_queue().state());
+}
+
+TEST_F(MainThreadEventQueueTest, NonBlockingGestureScrollUpdate) {
+  WebGestureEvent kEvents[3] = {
+      SyntheticWebGestureEventBuilder::BuildScrollUpdate(
+          0, -10, 0, blink::WebGestureDeviceTouchscreen),
+      SyntheticWebGestureEventBuilder::BuildScrollUpdate(
+          0, -20, 0, blink::WebGestureDeviceTouchscreen),
+      SyntheticWebGestureEventBuilder::BuildScrollUpdate(
+          0, -30, 0, blink::WebGestureDeviceTouchscreen),
+  };
+
+  queue_.HandleEvent(&kEvents[0], ui::LatencyInfo(), DISPATCH_TYPE_NON_BLOCKING,
+                     INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  queue_.HandleEvent(&kEvents[1], ui::LatencyInfo(), DISPATCH_TYPE_NON_BLOCKING,
+                     INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  queue_.HandleEvent(&kEvents[2], ui::LatencyInfo(), DISPATCH_TYPE_NON_BLOCKING,
+                     INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  ASSERT_EQ(1u, gesture_event_queue().size());
+  ASSERT_EQ(WebInputEventQueueState::ITEM_PENDING,
+            gesture_event_queue().state());
+
+  queue_.EventHandled(WebInputEvent::GestureScrollUpdate,
+                      INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  const WebGestureEvent* coalesced_event =
+      reinterpret_cast<const WebGestureEvent*>(&last_event_[0]);
+  EXPECT_EQ(WebInputEvent::GestureScrollUpdate, coalesced_event->type);
+  EXPECT_EQ(-50, coalesced_event->data.scrollUpdate.deltaY);
+  queue_.EventHandled(WebInputEvent::GestureScrollUpdate,
+                      INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  ASSERT_EQ(WebInputEventQueueState::ITEM_NOT_PENDING,
+            gesture_event_queue().state());
+}
+
 }  // namespace content
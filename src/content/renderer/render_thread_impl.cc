@@ -22,6 +22,7 @@
 #include "base/memory/shared_memory.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/path_service.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string16.h"
@@ -34,6 +35,7 @@
 #include "base/threading/thread_local.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/native_sampling_profiler.h"
 #include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "build/build_config.h"
@@ -637,6 +639,7 @@ RenderThreadImpl::RenderThreadImpl(
 void RenderThreadImpl::Init(
     scoped_refptr<base::SingleThreadTaskRunner>& resource_task_queue) {
   TRACE_EVENT0("startup", "RenderThreadImpl::Init");
+  SCOPED_UMA_HISTOGRAM_TIMER("Renderer.RenderThreadImpl.InitTime");
 
   base::trace_event::TraceLog::GetInstance()->SetThreadSortIndex(
       base::PlatformThread::CurrentId(),
@@ -652,7 +655,11 @@ void RenderThreadImpl::Init(
   // Register this object as the main thread.
   ChildProcess::current()->set_main_thread(this);
 
-  InitializeWebKit(resource_task_queue);
+  {
+    SCOPED_UMA_HISTOGRAM_TIMER(
+        "Renderer.RenderThreadImpl.InitializeWebKitTime");
+    InitializeWebKit(resource_task_queue);
+  }
 
   // In single process the single process is all there is.
   webkit_shared_timer_suspended_ = false;
@@ -1298,6 +1305,8 @@ void RenderThreadImpl::InitializeWebKit(
   AddFilter(devtools_agent_message_filter_.get());
 
   v8_sampling_profiler_.reset(new V8SamplingProfiler());
+  base::trace_event::NativeSamplingProfiler::GetInstance()
+      ->RegisterCurrentThread();
 
   if (GetContentClient()->renderer()->RunIdleHandlerWhenWidgetsHidden()) {
     ScheduleIdleHandler(kLongIdleHandlerDelayMs);
@@ -1834,7 +1843,33 @@ void RenderThreadImpl::OnProcessPurgeAndSuspend() {
   ChildThreadImpl::OnProcessPurgeAndSuspend();
   if (is_renderer_suspended_)
     return;
-  // TODO(hajimehoshi): Implement purging e.g. cache (crbug/607077)
+  TRACE_EVENT0("memory", "RenderThreadImpl::OnProcessPurgeAndSuspend");
+
+  // Drops Blink's decoded images, font cache and memory cache, and Skia's
+  // font cache.
+  OnMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  SkGraphics::PurgeAllCaches();
+
+  // Hidden widgets have already released their tiles; also free what the
+  // shared contexts keep cached for them.
+  if (shared_main_thread_contexts_)
+    shared_main_thread_contexts_->DeleteCachedResources();
+  if (shared_worker_context_provider_) {
+    cc::ContextProvider::ScopedContextLock lock(
+        shared_worker_context_provider_.get());
+    shared_worker_context_provider_->DeleteCachedResources();
+  }
+
+  // Collect all garbage, including compiled code, before the suspended
+  // renderer stops running idle GC tasks.
+  if (blink::mainThreadIsolate()) {
+    blink::mainThreadIsolate()->LowMemoryNotification();
+    blink::MemoryPressureNotificationToWorkerThreadIsolates(
+        v8::MemoryPressureLevel::kCritical);
+  }
+  ReleaseFreeMemory();
+
   is_renderer_suspended_ = true;
   renderer_scheduler_->SuspendRenderer();
 }
@@ -1889,6 +1924,11 @@ scoped_refptr<gpu::GpuChannelHost> RenderThreadImpl::EstablishGpuChannelSync(
     gpu_channel_ = NULL;
   }
 
+  // This blocks the main thread until the browser has launched the GPU process
+  // if needed, and is typically on the path to the first compositor frame.
+  SCOPED_UMA_HISTOGRAM_TIMER(
+      "Renderer.RenderThreadImpl.EstablishGpuChannelSyncTime");
+
   // Ask the browser for the channel name.
   int client_id = 0;
   IPC::ChannelHandle channel_handle;
@@ -200,6 +200,7 @@
 #endif
 
 #if defined(OS_WEBOS) && defined(USE_UMEDIASERVER)
+#include "media/webos/base/lunaservice_client.h"
 #include "media/webos/base/media_apis_wrapper.h"
 #endif
 
@@ -2680,6 +2681,10 @@ void RenderViewImpl::OnSetRendererPrefs(
   std::string media_codec_capability = renderer_preferences_.media_codec_capability;
   if(!media_codec_capability.empty())
     media::MediaAPIsWrapper::CheckCodecInfo(media_codec_capability);
+
+  // Register the shared Luna bus connection used by the media pipelines now,
+  // so that it is not part of the first media load.
+  media::LunaServiceClient::PrepareBus(media::LunaServiceClient::PrivateBus);
 #endif
 
 #if defined(USE_DEFAULT_RENDER_THEME)
@@ -16,10 +16,15 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <vector>
 
 #include "base/logging.h"
+#include "base/macros.h"
+#include "base/sys_info.h"
+#include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 
 #include "courgette/crc.h"
@@ -33,6 +38,62 @@
 
 namespace courgette {
 
+namespace {
+
+// Disassembling and adjusting a large element holds a few times its size in
+// memory, so only a handful of elements are transformed at once.
+const int kMaxTransformThreads = 4;
+
+// Transforms one element with its generator. The elements of an ensemble are
+// independent, so several can be transformed at once on a thread pool.
+class TransformElementTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit TransformElementTask(TransformationPatchGenerator* generator)
+      : generator_(generator), status_(C_GENERAL_ERROR) {}
+
+  // Overridden from base::DelegateSimpleThread::Delegate:
+  void Run() override {
+    status_ = generator_->Transform(&parameters_, &predicted_element_,
+                                    &corrected_element_);
+  }
+
+  SourceStreamSet* parameters() { return &parameters_; }
+  SinkStreamSet* predicted_element() { return &predicted_element_; }
+  SinkStreamSet* corrected_element() { return &corrected_element_; }
+  Status status() const { return status_; }
+
+ private:
+  TransformationPatchGenerator* const generator_;
+  SourceStreamSet parameters_;
+  SinkStreamSet predicted_element_;
+  SinkStreamSet corrected_element_;
+  Status status_;
+
+  DISALLOW_COPY_AND_ASSIGN(TransformElementTask);
+};
+
+// Runs |tasks|, in parallel if there are several of them.
+void RunTransformElementTasks(
+    const std::vector<std::unique_ptr<TransformElementTask>>& tasks) {
+  const int thread_count =
+      std::min(std::min(base::SysInfo::NumberOfProcessors(),
+                        kMaxTransformThreads),
+               static_cast<int>(tasks.size()));
+  if (thread_count <= 1) {
+    for (const auto& task : tasks)
+      task->Run();
+    return;
+  }
+
+  base::DelegateSimpleThreadPool pool("CourgetteTransform", thread_count);
+  for (const auto& task : tasks)
+    pool.AddWork(task.get());
+  pool.Start();
+  pool.JoinAll();
+}
+
+}  // namespace
+
 TransformationPatchGenerator::TransformationPatchGenerator(
     Element* old_element,
     Element* new_element,
@@ -335,31 +396,38 @@ Status GenerateEnsemblePatch(SourceStream* base,
   SinkStreamSet predicted_transformed_elements;
   SinkStreamSet corrected_transformed_elements;
 
+  std::vector<std::unique_ptr<TransformElementTask>> transform_tasks;
   for (size_t i = 0;  i < number_of_transformations;  ++i) {
-    SourceStreamSet single_parameters;
-    if (!corrected_parameters_source_set.ReadSet(&single_parameters))
-      return C_STREAM_ERROR;
-    SinkStreamSet single_predicted_transformed_element;
-    SinkStreamSet single_corrected_transformed_element;
-    Status status = generators[i]->Transform(
-        &single_parameters,
-        &single_predicted_transformed_element,
-        &single_corrected_transformed_element);
-    if (status != C_OK)
-      return status;
-    if (!single_parameters.Empty())
-      return C_STREAM_NOT_CONSUMED;
-    if (!predicted_transformed_elements.WriteSet(
-            &single_predicted_transformed_element))
-      return C_STREAM_ERROR;
-    if (!corrected_transformed_elements.WriteSet(
-            &single_corrected_transformed_element))
+    transform_tasks.push_back(
+        std::unique_ptr<TransformElementTask>(
+            new TransformElementTask(generators[i])));
+    if (!corrected_parameters_source_set.ReadSet(
+            transform_tasks.back()->parameters()))
       return C_STREAM_ERROR;
   }
 
   if (!corrected_parameters_source_set.Empty())
     return C_STREAM_NOT_CONSUMED;
 
+  base::Time start_transform_time = base::Time::Now();
+  RunTransformElementTasks(transform_tasks);
+  VLOG(1) << "done Transform "
+          << (base::Time::Now() - start_transform_time).InSecondsF() << "s";
+
+  // The transformed elements are written in order, so the patch is the same
+  // however many threads made it.
+  for (const auto& task : transform_tasks) {
+    if (task->status() != C_OK)
+      return task->status();
+    if (!task->parameters()->Empty())
+      return C_STREAM_NOT_CONSUMED;
+    if (!predicted_transformed_elements.WriteSet(task->predicted_element()))
+      return C_STREAM_ERROR;
+    if (!corrected_transformed_elements.WriteSet(task->corrected_element()))
+      return C_STREAM_ERROR;
+  }
+  transform_tasks.clear();
+
   SinkStream linearized_predicted_transformed_elements;
   SinkStream linearized_corrected_transformed_elements;
 
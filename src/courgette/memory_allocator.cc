@@ -12,11 +12,14 @@
 #include "base/files/file_util.h"
 #include "base/strings/stringprintf.h"
 
-#if defined(OS_WIN)
+#if defined(OS_POSIX)
+#include <sys/mman.h>
+#endif
 
 namespace {
 
-// The file is created in the %TEMP% folder.
+// The file is created in the temporary folder, %TEMP% on Windows. On POSIX it
+// is unlinked as soon as it is opened.
 // NOTE: Since the file will be used as backing for a memory allocation,
 // it will never be so big that size_t cannot represent its size.
 base::File CreateTempFile() {
@@ -36,6 +39,8 @@ namespace courgette {
 
 // FileMapping
 
+#if defined(OS_WIN)
+
 FileMapping::FileMapping() : mapping_(NULL), view_(NULL) {
 }
 
@@ -54,7 +59,7 @@ bool FileMapping::InitializeView(size_t size) {
   return true;
 }
 
-bool FileMapping::Create(HANDLE file, size_t size) {
+bool FileMapping::Create(base::PlatformFile file, size_t size) {
   DCHECK(file != INVALID_HANDLE_VALUE);
   DCHECK(!valid());
   mapping_ = ::CreateFileMapping(file, NULL, PAGE_READWRITE, 0, 0, NULL);
@@ -81,6 +86,43 @@ void* FileMapping::view() const {
   return view_;
 }
 
+#else  // OS_WIN
+
+FileMapping::FileMapping() : size_(0), view_(NULL) {
+}
+
+FileMapping::~FileMapping() {
+  Close();
+}
+
+bool FileMapping::Create(base::PlatformFile file, size_t size) {
+  DCHECK_NE(base::kInvalidPlatformFile, file);
+  DCHECK(!valid());
+  void* view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+  if (view == MAP_FAILED)
+    return false;
+  view_ = view;
+  size_ = size;
+  return true;
+}
+
+void FileMapping::Close() {
+  if (view_)
+    munmap(view_, size_);
+  view_ = NULL;
+  size_ = 0;
+}
+
+bool FileMapping::valid() const {
+  return view_ != NULL;
+}
+
+void* FileMapping::view() const {
+  return view_;
+}
+
+#endif  // OS_WIN
+
 // TempMapping
 
 TempMapping::TempMapping() {
@@ -135,5 +177,3 @@ TempMapping* TempMapping::GetMappingFromPtr(void* mem) {
 }
 
 }  // namespace courgette
-
-#endif  // OS_WIN
@@ -84,8 +84,6 @@ struct UncheckedDeleter {
   inline void operator()(T* ptr) const { UncheckedDelete(ptr); }
 };
 
-#if defined(OS_WIN)
-
 // Manages a read/write virtual mapping of a physical file.
 class FileMapping {
  public:
@@ -93,7 +91,7 @@ class FileMapping {
   ~FileMapping();
 
   // Map a file from beginning to |size|.
-  bool Create(HANDLE file, size_t size);
+  bool Create(base::PlatformFile file, size_t size);
   void Close();
 
   // Returns true iff a mapping has been created.
@@ -104,9 +102,13 @@ class FileMapping {
   void* view() const;
 
  protected:
+#if defined(OS_WIN)
   bool InitializeView(size_t size);
 
   HANDLE mapping_;
+#else
+  size_t size_;
+#endif
   void* view_;
 };
 
@@ -149,6 +151,9 @@ class TempMapping {
 // allocation.  This can happen because these resources are too small, or
 // already committed to other processes.  Provided there is enough disk, the
 // temporary file acts like a pagefile that other processes can't access.
+// On devices without swap it also bounds how much of the heap patching the
+// largest binaries needs, as the kernel can write the mapped pages back to the
+// file and reclaim them under memory pressure.
 template<class T>
 class MemoryAllocator {
  public:
@@ -180,16 +185,16 @@ class MemoryAllocator {
     typedef MemoryAllocator<OtherT> other;
   };
 
-  MemoryAllocator() _THROW0() {
+  MemoryAllocator() {
   }
 
   // We can't use an explicit constructor here, as dictated by our style guide.
   // The implementation of basic_string in Visual Studio 2010 prevents this.
-  MemoryAllocator(const MemoryAllocator<T>& other) _THROW0() {  // NOLINT
+  MemoryAllocator(const MemoryAllocator<T>& other) {  // NOLINT
   }
 
   template<class OtherT>
-  MemoryAllocator(const MemoryAllocator<OtherT>& other) _THROW0() {  // NOLINT
+  MemoryAllocator(const MemoryAllocator<OtherT>& other) {  // NOLINT
   }
 
   ~MemoryAllocator() {
@@ -251,78 +256,12 @@ class MemoryAllocator {
     ptr->~T();
   }
 
-  size_type max_size() const _THROW0() {
-    size_type count = static_cast<size_type>(-1) / sizeof(T);
-    return (0 < count ? count : 1);
-  }
-};
-
-#else  // OS_WIN
-
-// On Mac, Linux, we use a bare bones implementation that only does
-// heap allocations.
-template<class T>
-class MemoryAllocator {
- public:
-  typedef T value_type;
-  typedef value_type* pointer;
-  typedef value_type& reference;
-  typedef const value_type* const_pointer;
-  typedef const value_type& const_reference;
-  typedef size_t size_type;
-  typedef ptrdiff_t difference_type;
-
-  template<class OtherT>
-  struct rebind {
-    // convert a MemoryAllocator<T> to a MemoryAllocator<OtherT>
-    typedef MemoryAllocator<OtherT> other;
-  };
-
-  MemoryAllocator() {
-  }
-
-  explicit MemoryAllocator(const MemoryAllocator<T>& other) {
-  }
-
-  template<class OtherT>
-  explicit MemoryAllocator(const MemoryAllocator<OtherT>& other) {
-  }
-
-  ~MemoryAllocator() {
-  }
-
-  void deallocate(pointer ptr, size_type size) { free(ptr); }
-
-  pointer allocate(size_type count) {
-    if (count > max_size())
-      return NULL;
-    pointer result = nullptr;
-    return base::UncheckedMalloc(count * sizeof(T),
-                                 reinterpret_cast<void**>(&result))
-               ? result
-               : nullptr;
-  }
-
-  pointer allocate(size_type count, const void* hint) {
-    return allocate(count);
-  }
-
-  void construct(pointer ptr, const T& value) {
-    ::new(ptr) T(value);
-  }
-
-  void destroy(pointer ptr) {
-    ptr->~T();
-  }
-
   size_type max_size() const {
     size_type count = static_cast<size_type>(-1) / sizeof(T);
     return (0 < count ? count : 1);
   }
 };
 
-#endif  // OS_WIN
-
 // Manages a growable buffer.  The buffer allocation is done by the
 // MemoryAllocator class.  This class will not throw exceptions so call sites
 // must be prepared to handle memory allocation failures.
@@ -5,6 +5,7 @@
 #include "courgette/memory_allocator.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <algorithm>
 
@@ -77,3 +78,24 @@ TEST(MemoryAllocatorTest, NoThrowBuffer) {
     EXPECT_TRUE(buf2.empty());
   }
 }
+
+TEST(MemoryAllocatorTest, FileBackedAllocation) {
+  // Allocations past the heap threshold are backed by a temporary file.
+  const size_t kSize = courgette::MemoryAllocator<
+                           uint32_t>::kMaxHeapAllocationSize + 1;
+
+  courgette::NoThrowBuffer<uint32_t> buf;
+  ASSERT_TRUE(buf.resize(kSize, 0));
+  for (size_t i = 0; i < kSize; ++i)
+    buf[i] = static_cast<uint32_t>(i);
+
+  // Growing the buffer copies it into a new mapping.
+  ASSERT_TRUE(buf.push_back(7));
+  EXPECT_EQ(kSize + 1, buf.size());
+  for (size_t i = 0; i < kSize; i += 4093)
+    EXPECT_EQ(static_cast<uint32_t>(i), buf[i]);
+  EXPECT_EQ(7U, buf.back());
+
+  buf.clear();
+  EXPECT_TRUE(buf.empty());
+}
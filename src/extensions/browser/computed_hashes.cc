@@ -4,12 +4,24 @@
 
 #include "extensions/browser/computed_hashes.h"
 
+#include <stdint.h>
+
+#include <algorithm>
+
 #include "base/base64.h"
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/stl_util.h"
+#include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task_runner.h"
 #include "base/values.h"
 #include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
@@ -21,6 +33,178 @@ const char kFileHashesKey[] = "file_hashes";
 const char kPathKey[] = "path";
 const char kVersionKey[] = "version";
 const int kVersion = 2;
+
+// The number of blocks hashed at a time by ComputeHashesForFiles(), which
+// bounds the memory each of its threads takes.
+const int64_t kBlocksPerRange = 256;
+
+// The number of tasks ComputeHashesForFiles() posts to help the calling
+// thread.
+const size_t kMaxHelperTasks = 3;
+
+// The state shared by the threads of ComputedHashes::ComputeHashesForFiles().
+// The files are split into ranges of blocks, which the threads take in turn
+// until none is left. The calling thread hashes ranges too, so it only ever
+// waits for the ranges that other threads have started, and never for a task
+// which has yet to run.
+class ParallelFileHasher
+    : public base::RefCountedThreadSafe<ParallelFileHasher> {
+ public:
+  ParallelFileHasher(const std::vector<base::FilePath>& paths,
+                     size_t block_size,
+                     const base::Callback<bool()>& is_cancelled);
+
+  size_t range_count() const { return ranges_.size(); }
+
+  // Hashes ranges of blocks until none is left to start.
+  void HashRanges();
+
+  // Waits for all the ranges to be hashed, and moves the hashes of the files
+  // to |hashes|. Returns false if the hashing was cancelled.
+  bool WaitForHashes(std::vector<std::vector<std::string>>* hashes);
+
+ private:
+  friend class base::RefCountedThreadSafe<ParallelFileHasher>;
+
+  struct Range {
+    size_t file_index;
+    size_t first_block;
+    int64_t offset;
+    int size;
+  };
+
+  ~ParallelFileHasher() {}
+
+  // Reads and hashes the blocks of |range|. Returns false on read errors.
+  bool HashRange(const Range& range);
+
+  const std::vector<base::FilePath> paths_;
+  const size_t block_size_;
+  const base::Callback<bool()> is_cancelled_;
+  std::vector<Range> ranges_;
+
+  // The block hashes of each file. The vectors are sized up front, so that
+  // the threads can write the hashes of different ranges concurrently.
+  std::vector<std::vector<std::string>> hashes_;
+
+  // Protects the members below.
+  base::Lock lock_;
+
+  size_t next_range_;
+  size_t unfinished_ranges_;
+  std::vector<bool> failed_;
+  bool cancelled_;
+
+  // Signaled once all the ranges are hashed.
+  base::WaitableEvent done_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelFileHasher);
+};
+
+ParallelFileHasher::ParallelFileHasher(
+    const std::vector<base::FilePath>& paths,
+    size_t block_size,
+    const base::Callback<bool()>& is_cancelled)
+    : paths_(paths),
+      block_size_(block_size),
+      is_cancelled_(is_cancelled),
+      hashes_(paths.size()),
+      next_range_(0),
+      unfinished_ranges_(0),
+      failed_(paths.size(), false),
+      cancelled_(false),
+      done_(base::WaitableEvent::ResetPolicy::MANUAL,
+            base::WaitableEvent::InitialState::NOT_SIGNALED) {
+  const int64_t block_size64 = static_cast<int64_t>(block_size);
+  for (size_t i = 0; i < paths_.size(); ++i) {
+    int64_t file_size = 0;
+    if (!base::GetFileSize(paths_[i], &file_size)) {
+      failed_[i] = true;
+      continue;
+    }
+    // Even an empty file has the hash of the empty string as its only block.
+    int64_t block_count =
+        std::max<int64_t>(1, (file_size + block_size64 - 1) / block_size64);
+    hashes_[i].resize(block_count);
+    for (int64_t block = 0; block < block_count; block += kBlocksPerRange) {
+      Range range;
+      range.file_index = i;
+      range.first_block = block;
+      range.offset = block * block_size64;
+      range.size = static_cast<int>(std::min(kBlocksPerRange * block_size64,
+                                             file_size - range.offset));
+      ranges_.push_back(range);
+    }
+  }
+  unfinished_ranges_ = ranges_.size();
+}
+
+void ParallelFileHasher::HashRanges() {
+  for (;;) {
+    Range range;
+    {
+      base::AutoLock lock(lock_);
+      if (next_range_ == ranges_.size())
+        return;
+      range = ranges_[next_range_++];
+    }
+    // Once cancelled, the remaining ranges are skipped.
+    bool cancelled = !is_cancelled_.is_null() && is_cancelled_.Run();
+    bool succeeded = !cancelled && HashRange(range);
+
+    base::AutoLock lock(lock_);
+    cancelled_ |= cancelled;
+    if (!succeeded)
+      failed_[range.file_index] = true;
+    if (--unfinished_ranges_ == 0)
+      done_.Signal();
+  }
+}
+
+bool ParallelFileHasher::WaitForHashes(
+    std::vector<std::vector<std::string>>* hashes) {
+  if (!ranges_.empty())
+    done_.Wait();
+
+  base::AutoLock lock(lock_);
+  if (cancelled_)
+    return false;
+  for (size_t i = 0; i < hashes_.size(); ++i) {
+    if (failed_[i])
+      hashes_[i].clear();
+  }
+  hashes->swap(hashes_);
+  return true;
+}
+
+bool ParallelFileHasher::HashRange(const Range& range) {
+  base::File file(paths_[range.file_index],
+                  base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return false;
+  std::string buffer(range.size, 0);
+  int bytes_read = 0;
+  while (bytes_read < range.size) {
+    int result = file.Read(range.offset + bytes_read,
+                           string_as_array(&buffer) + bytes_read,
+                           range.size - bytes_read);
+    if (result <= 0)
+      return false;
+    bytes_read += result;
+  }
+
+  std::vector<std::string>& hashes = hashes_[range.file_index];
+  size_t block = range.first_block;
+  size_t offset = 0;
+  do {
+    size_t bytes_to_hash = std::min(buffer.size() - offset, block_size_);
+    hashes[block++] = crypto::SHA256HashString(
+        base::StringPiece(buffer.data() + offset, bytes_to_hash));
+    offset += bytes_to_hash;
+  } while (offset < buffer.size());
+  return true;
+}
+
 }  // namespace
 
 namespace extensions {
@@ -194,4 +378,23 @@ void ComputedHashes::ComputeHashesForContent(const std::string& contents,
   } while (offset < contents.size());
 }
 
+// static
+bool ComputedHashes::ComputeHashesForFiles(
+    const std::vector<base::FilePath>& paths,
+    size_t block_size,
+    base::TaskRunner* task_runner,
+    const base::Callback<bool()>& is_cancelled,
+    std::vector<std::vector<std::string>>* hashes) {
+  scoped_refptr<ParallelFileHasher> hasher(
+      new ParallelFileHasher(paths, block_size, is_cancelled));
+  size_t helper_count = std::min(
+      kMaxHelperTasks, hasher->range_count() ? hasher->range_count() - 1 : 0);
+  for (size_t i = 0; i < helper_count; ++i) {
+    task_runner->PostTask(
+        FROM_HERE, base::Bind(&ParallelFileHasher::HashRanges, hasher));
+  }
+  hasher->HashRanges();
+  return hasher->WaitForHashes(hashes);
+}
+
 }  // namespace extensions
@@ -12,10 +12,12 @@
 #include <string>
 #include <vector>
 
+#include "base/callback_forward.h"
 
 namespace base {
 class FilePath;
 class ListValue;
+class TaskRunner;
 }
 
 namespace extensions {
@@ -67,6 +69,20 @@ class ComputedHashes {
   static void ComputeHashesForContent(const std::string& contents,
                                       size_t block_size,
                                       std::vector<std::string>* hashes);
+
+  // Computes the block hashes of each file in |paths| like
+  // ComputeHashesForContent() would, placing them in the same order into
+  // |hashes|, without reading the files into memory whole. Ranges of blocks
+  // are hashed in parallel by tasks posted to |task_runner| and by the calling
+  // thread, which blocks until all of them are hashed. The hashes of the files
+  // that can't be read are left empty. Returns false if |is_cancelled|, which
+  // is run on all these threads, returned true along the way.
+  static bool ComputeHashesForFiles(
+      const std::vector<base::FilePath>& paths,
+      size_t block_size,
+      base::TaskRunner* task_runner,
+      const base::Callback<bool()>& is_cancelled,
+      std::vector<std::vector<std::string>>* hashes);
 };
 
 }  // namespace extensions
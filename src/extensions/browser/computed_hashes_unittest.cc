@@ -3,8 +3,12 @@
 // found in the LICENSE file.
 
 #include "base/base64.h"
+#include "base/bind.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/computed_hashes.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -18,6 +22,10 @@ std::string Base64Encode(const std::string& data) {
   return result;
 }
 
+bool ReturnTrue() {
+  return true;
+}
+
 }  // namespace
 
 namespace extensions {
@@ -122,4 +130,51 @@ TEST(ComputedHashes, ComputeHashesForContent) {
             Base64Encode(hashes3[0]));
 }
 
+TEST(ComputedHashes, ComputeHashesForFiles) {
+  base::ScopedTempDir scoped_dir;
+  ASSERT_TRUE(scoped_dir.CreateUniqueTempDir());
+  base::Thread helper_thread("ComputedHashesHelper");
+  ASSERT_TRUE(helper_thread.Start());
+  const int block_size = 1024;
+
+  // An empty file, a small one, and files spanning several ranges of blocks,
+  // one of which ends with a partial block.
+  const size_t sizes[] = {0, 11, 1024 * 600, 1024 * 600 + 17};
+  std::vector<base::FilePath> paths;
+  std::vector<std::string> contents;
+  for (size_t i = 0; i < arraysize(sizes); ++i) {
+    std::string content;
+    while (content.size() < sizes[i])
+      content += base::StringPrintf("%d hello world ", static_cast<int>(i));
+    content.resize(sizes[i]);
+    base::FilePath path =
+        scoped_dir.path().AppendASCII(base::StringPrintf("file%d.txt",
+                                                         static_cast<int>(i)));
+    ASSERT_EQ(static_cast<int>(content.size()),
+              base::WriteFile(path, content.data(), content.size()));
+    paths.push_back(path);
+    contents.push_back(content);
+  }
+  // A file that can't be read.
+  paths.push_back(scoped_dir.path().AppendASCII("missing.txt"));
+
+  std::vector<std::vector<std::string>> hashes;
+  ASSERT_TRUE(ComputedHashes::ComputeHashesForFiles(
+      paths, block_size, helper_thread.task_runner().get(),
+      base::Callback<bool()>(), &hashes));
+  ASSERT_EQ(paths.size(), hashes.size());
+  for (size_t i = 0; i < contents.size(); ++i) {
+    std::vector<std::string> expected_hashes;
+    ComputedHashes::ComputeHashesForContent(contents[i], block_size,
+                                            &expected_hashes);
+    EXPECT_EQ(expected_hashes, hashes[i]) << "file " << i;
+  }
+  EXPECT_TRUE(hashes.back().empty());
+
+  // Nothing is returned once cancelled.
+  EXPECT_FALSE(ComputedHashes::ComputeHashesForFiles(
+      paths, block_size, helper_thread.task_runner().get(),
+      base::Bind(&ReturnTrue), &hashes));
+}
+
 }  // namespace extensions
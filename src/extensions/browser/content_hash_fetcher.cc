@@ -17,6 +17,7 @@
 #include "base/metrics/histogram.h"
 #include "base/synchronization/lock.h"
 #include "base/task_runner_util.h"
+#include "base/threading/sequenced_worker_pool.h"
 #include "base/timer/elapsed_timer.h"
 #include "base/version.h"
 #include "content/public/browser/browser_context.h"
@@ -372,12 +373,10 @@ bool ContentHashFetcherJob::CreateHashes(const base::FilePath& hashes_file) {
     paths.insert(full_path);
   }
 
-  // Now iterate over all the paths in sorted order and compute the block hashes
-  // for each one.
-  ComputedHashes::Writer writer;
+  // Keep the paths of the files to hash, in sorted order.
+  std::vector<base::FilePath> full_paths;
+  std::vector<base::FilePath> relative_paths;
   for (SortedFilePathSet::iterator i = paths.begin(); i != paths.end(); ++i) {
-    if (IsCancelled())
-      return false;
     const base::FilePath& full_path = *i;
     base::FilePath relative_path;
     extension_path_.AppendRelativePath(full_path, &relative_path);
@@ -385,17 +384,34 @@ bool ContentHashFetcherJob::CreateHashes(const base::FilePath& hashes_file) {
 
     if (!verified_contents_->HasTreeHashRoot(relative_path))
       continue;
+    full_paths.push_back(full_path);
+    relative_paths.push_back(relative_path);
+  }
 
-    std::string contents;
-    if (!base::ReadFileToString(full_path, &contents)) {
-      LOG(ERROR) << "Could not read " << full_path.MaybeAsASCII();
+  // Compute the block hashes of the files. Packaged apps can be large, so the
+  // blocks are read in chunks rather than whole files at once, and hashed in
+  // parallel on the blocking pool.
+  scoped_refptr<base::TaskRunner> task_runner =
+      content::BrowserThread::GetBlockingPool()
+          ->GetTaskRunnerWithShutdownBehavior(
+              base::SequencedWorkerPool::SKIP_ON_SHUTDOWN);
+  std::vector<std::vector<std::string>> all_hashes;
+  if (!ComputedHashes::ComputeHashesForFiles(
+          full_paths, block_size_, task_runner.get(),
+          base::Bind(&ContentHashFetcherJob::IsCancelled, this),
+          &all_hashes)) {
+    return false;
+  }
+
+  ComputedHashes::Writer writer;
+  for (size_t i = 0; i < full_paths.size(); ++i) {
+    const base::FilePath& relative_path = relative_paths[i];
+    const std::vector<std::string>& hashes = all_hashes[i];
+    if (hashes.empty()) {
+      LOG(ERROR) << "Could not read " << full_paths[i].MaybeAsASCII();
       continue;
     }
 
-    // Iterate through taking the hash of each block of size (block_size_) of
-    // the file.
-    std::vector<std::string> hashes;
-    ComputedHashes::ComputeHashesForContent(contents, block_size_, &hashes);
     std::string root =
         ComputeTreeHashRoot(hashes, block_size_ / crypto::kSHA256Length);
     if (!verified_contents_->TreeHashRootEquals(relative_path, root)) {
@@ -10,6 +10,7 @@
 #include "base/strings/string_util.h"
 #include "content/public/browser/browser_thread.h"
 #include "third_party/leveldatabase/env_chromium.h"
+#include "third_party/leveldatabase/leveldb_chrome.h"
 #include "third_party/leveldatabase/src/include/leveldb/iterator.h"
 #include "third_party/leveldatabase/src/include/leveldb/write_batch.h"
 
@@ -66,6 +67,9 @@ LazyLevelDb::LazyLevelDb(const std::string& uma_client_name,
   open_options_.create_if_missing = true;
   open_options_.paranoid_checks = true;
   open_options_.reuse_logs = leveldb_env::kDefaultLogReuseOptionValue;
+  open_options_.block_cache = leveldb_chrome::GetSharedBrowserBlockCache();
+  open_options_.write_buffer_size =
+      leveldb_chrome::kSmallDatabaseWriteBufferSize;
 
   read_options_.verify_checksums = true;
 
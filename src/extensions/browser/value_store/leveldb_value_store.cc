@@ -14,7 +14,6 @@
 #include "base/json/json_writer.h"
 #include "base/logging.h"
 #include "base/macros.h"
-#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/sys_string_conversions.h"
@@ -23,6 +22,7 @@
 #include "base/trace_event/process_memory_dump.h"
 #include "content/public/browser/browser_thread.h"
 #include "third_party/leveldatabase/env_chromium.h"
+#include "third_party/leveldatabase/leveldb_chrome.h"
 #include "third_party/leveldatabase/src/include/leveldb/iterator.h"
 #include "third_party/leveldatabase/src/include/leveldb/write_batch.h"
 
@@ -245,12 +245,8 @@ bool LeveldbValueStore::OnMemoryDump(
   if (!db())
     return true;
 
-  std::string value;
-  uint64_t size;
-  bool res = db()->GetProperty("leveldb.approximate-memory-usage", &value);
-  DCHECK(res);
-  res = base::StringToUint64(value, &size);
-  DCHECK(res);
+  uint64_t size = leveldb_chrome::GetApproximateMemoryUsage(
+      db(), true /* uses_shared_block_cache */);
 
   auto* dump = pmd->CreateAllocatorDump(base::StringPrintf(
       "leveldb/value_store/%s/0x%" PRIXPTR, open_histogram_name().c_str(),
@@ -23,6 +23,7 @@ TransferBuffer::TransferBuffer(
       default_buffer_size_(0),
       min_buffer_size_(0),
       max_buffer_size_(0),
+      desired_buffer_size_(0),
       alignment_(0),
       size_to_flush_(0),
       bytes_since_last_flush_(0),
@@ -130,6 +131,7 @@ void TransferBuffer::ReallocateRingBuffer(unsigned int size) {
   unsigned int needed_buffer_size = ComputePOTSize(size + result_size_);
   needed_buffer_size = std::max(needed_buffer_size, min_buffer_size_);
   needed_buffer_size = std::max(needed_buffer_size, default_buffer_size_);
+  needed_buffer_size = std::max(needed_buffer_size, desired_buffer_size_);
   needed_buffer_size = std::min(needed_buffer_size, max_buffer_size_);
 
   if (usable_ && (!HaveBuffer() || needed_buffer_size > buffer_->size())) {
@@ -153,7 +155,7 @@ void* TransferBuffer::AllocUpTo(
   unsigned int max_size = ring_buffer_->GetLargestFreeOrPendingSize();
   *size_allocated = std::min(max_size, size);
   bytes_since_last_flush_ += *size_allocated;
-  return ring_buffer_->Alloc(*size_allocated);
+  return AllocFromRingBuffer(*size_allocated);
 }
 
 void* TransferBuffer::Alloc(unsigned int size) {
@@ -169,7 +171,27 @@ void* TransferBuffer::Alloc(unsigned int size) {
   }
 
   bytes_since_last_flush_ += size;
-  return ring_buffer_->Alloc(size);
+  return AllocFromRingBuffer(size);
+}
+
+void* TransferBuffer::AllocFromRingBuffer(unsigned int size) {
+  if (size <= ring_buffer_->GetLargestFreeSizeNoWaiting())
+    return ring_buffer_->Alloc(size);
+
+  // The uploads outpace the service, so wait for it to consume the previous
+  // ones, and grow the buffer the next time it is reallocated.
+  base::TimeTicks wait_start = base::TimeTicks::Now();
+  void* ptr = ring_buffer_->Alloc(size);
+  stall_time_ += base::TimeTicks::Now() - wait_start;
+  TRACE_COUNTER_ID1("gpu", "TransferBufferStallTimeMs", this,
+                    stall_time_.InMilliseconds());
+
+  unsigned int buffer_size = static_cast<unsigned int>(buffer_->size());
+  if (buffer_size < max_buffer_size_) {
+    unsigned int grown_size = std::min(buffer_size * 2, max_buffer_size_);
+    desired_buffer_size_ = std::max(desired_buffer_size_, grown_size);
+  }
+  return ptr;
 }
 
 void* TransferBuffer::GetResultBuffer() {
@@ -12,6 +12,7 @@
 
 #include "base/compiler_specific.h"
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "gpu/command_buffer/client/ring_buffer.h"
 #include "gpu/command_buffer/common/buffer.h"
 #include "gpu/command_buffer/common/gles2_cmd_utils.h"
@@ -97,6 +98,10 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
 
   void AllocateRingBuffer(unsigned int size);
 
+  // Allocates |size| bytes from the ring buffer, and records how long it had
+  // to wait for the service to consume the previous allocations.
+  void* AllocFromRingBuffer(unsigned int size);
+
   CommandBufferHelper* helper_;
   std::unique_ptr<RingBuffer> ring_buffer_;
 
@@ -112,6 +117,13 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
   // max size we'll let the buffer grow
   unsigned int max_buffer_size_;
 
+  // Size the buffer grows to the next time it is reallocated, because the
+  // uploads waited for the ring buffer to be consumed. 0 if they didn't.
+  unsigned int desired_buffer_size_;
+
+  // Total time spent waiting for the ring buffer to be consumed.
+  base::TimeDelta stall_time_;
+
   // alignment for allocations
   unsigned int alignment_;
 
@@ -375,6 +375,42 @@ TEST_F(TransferBufferExpandContractTest, Expand) {
   transfer_buffer_->FreePendingToken(ptr, 1);
 }
 
+TEST_F(TransferBufferExpandContractTest, GrowsAfterWaitingForTokens) {
+  const size_t kSize = kStartTransferBufferSize - kStartingOffset;
+  unsigned int size_allocated = 0;
+  void* ptr = transfer_buffer_->AllocUpTo(kSize, &size_allocated);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(kSize, size_allocated);
+  // Use a token that did not pass yet.
+  const unsigned int kPendingToken = helper_->last_token_read() + 1;
+  transfer_buffer_->FreePendingToken(ptr, kPendingToken);
+
+  // The buffer is still in use, so this waits for the token without growing
+  // the buffer.
+  EXPECT_CALL(*command_buffer(), Flush(_)).Times(1).RetiresOnSaturation();
+  ptr = transfer_buffer_->AllocUpTo(kSize, &size_allocated);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(kSize, size_allocated);
+  transfer_buffer_->FreePendingToken(ptr, 1);
+
+  // Since the uploads had to wait, the buffer grows on the next allocation.
+  EXPECT_CALL(*command_buffer(), DestroyTransferBuffer(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  EXPECT_CALL(*command_buffer(),
+              CreateTransferBuffer(kStartTransferBufferSize * 2, _))
+      .WillOnce(Invoke(
+          command_buffer(),
+          &MockClientCommandBufferCanFail::RealCreateTransferBuffer))
+      .RetiresOnSaturation();
+  ptr = transfer_buffer_->AllocUpTo(kSize, &size_allocated);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(kSize, size_allocated);
+  EXPECT_EQ(kStartTransferBufferSize * 2 - kStartingOffset,
+            transfer_buffer_->GetCurrentMaxAllocationWithoutRealloc());
+  transfer_buffer_->FreePendingToken(ptr, 1);
+}
+
 TEST_F(TransferBufferExpandContractTest, Contract) {
   // Check it starts at starting size.
   EXPECT_EQ(
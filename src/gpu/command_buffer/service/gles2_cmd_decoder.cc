@@ -103,6 +103,10 @@ const GLfloat kIdentityMatrix[16] = {1.0f, 0.0f, 0.0f, 0.0f,
                                      0.0f, 0.0f, 1.0f, 0.0f,
                                      0.0f, 0.0f, 0.0f, 1.0f};
 
+// The maximum number of fixed-size commands validated in a single pass before
+// being dispatched.
+const int kMaxFixedSizeCommandRun = 32;
+
 bool PrecisionMeetsSpecForHighpFloat(GLint rangeMin,
                                             GLint rangeMax,
                                             GLint precision) {
@@ -4987,6 +4991,59 @@ error::Error GLES2DecoderImpl::DoCommandsImpl(unsigned int num_commands,
 
   while (process_pos < num_entries && result == error::kNoError &&
          commands_to_process_--) {
+    // Most of the commands, such as uniform and draw calls, have a fixed size,
+    // so without debugging, a run of them is validated in a single pass over
+    // copies of their headers, and then dispatched without checking them
+    // again.
+    if (!DebugImpl) {
+      const CommandInfo* run[kMaxFixedSizeCommandRun];
+      int run_length = 0;
+      int run_entries = 0;
+      const int available_entries = num_entries - process_pos;
+      while (run_length < kMaxFixedSizeCommandRun &&
+             run_entries < available_entries) {
+        const CommandHeader header = cmd_data[run_entries].value_header;
+        unsigned int command_index = header.command - kFirstGLES2Command;
+        if (command_index >= arraysize(command_info))
+          break;
+        const CommandInfo& info = command_info[command_index];
+        if (info.arg_flags != cmd::kFixed ||
+            header.size != info.arg_count + 1u ||
+            static_cast<int>(header.size) > available_entries - run_entries) {
+          break;
+        }
+        run[run_length++] = &info;
+        run_entries += header.size;
+      }
+
+      if (run_length) {
+        for (int i = 0; i < run_length; ++i) {
+          // The first command was already counted by the loop.
+          if (i > 0) {
+            if (!commands_to_process_)
+              break;
+            --commands_to_process_;
+          }
+          const CommandInfo& info = *run[i];
+          command = kFirstGLES2Command +
+                    static_cast<unsigned int>(run[i] - command_info);
+          result = (this->*info.cmd_handler)(0, cmd_data);
+          if (result == error::kNoError &&
+              current_decoder_error_ != error::kNoError) {
+            result = current_decoder_error_;
+            current_decoder_error_ = error::kNoError;
+          }
+          if (result == error::kDeferCommandUntilLater)
+            break;
+          process_pos += info.arg_count + 1;
+          cmd_data += info.arg_count + 1;
+          if (result != error::kNoError)
+            break;
+        }
+        continue;
+      }
+    }
+
     const unsigned int size = cmd_data->value_header.size;
     command = cmd_data->value_header.command;
 
@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 
+#include "base/files/file_path.h"
 #include "base/macros.h"
 #include "build/build_config.h"
 #include "gpu/command_buffer/common/constants.h"
@@ -100,6 +101,10 @@ struct GPU_EXPORT GpuPreferences {
   // Disables the GPU shader on disk cache.
   bool disable_gpu_shader_disk_cache = false;
 
+  // Directory where the GPU process persists its program binaries itself.
+  // Empty to use the shader disk cache of the browser instead.
+  base::FilePath gpu_program_disk_cache_dir;
+
   // Allows async texture uploads (off main thread) via GL context sharing.
   bool enable_share_group_async_texture_upload = false;
 
@@ -50,6 +50,12 @@ const char kGpuProgramCacheSizeKb[]         = "gpu-program-cache-size-kb";
 // Disables the GPU shader on disk cache.
 const char kDisableGpuShaderDiskCache[]     = "disable-gpu-shader-disk-cache";
 
+// Makes the GPU process persist its program binaries to the given directory
+// itself, instead of sending them to the shader disk cache of the browser.
+// The GPU process must be able to access the directory, so this is only
+// useful with the GPU sandbox disabled.
+const char kGpuProgramDiskCacheDir[]        = "gpu-program-disk-cache-dir";
+
 // Allows async texture uploads (off main thread) via GL context sharing.
 const char kEnableShareGroupAsyncTextureUpload[] =
     "enable-share-group-async-texture-upload";
@@ -13,6 +13,7 @@
 #include "base/command_line.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/sha1.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/trace_event/trace_event.h"
 #include "ui/gl/gl_implementation.h"
@@ -39,6 +40,9 @@ class ShaderTranslatorInitializer {
 base::LazyInstance<ShaderTranslatorInitializer> g_translator_initializer =
     LAZY_INSTANCE_INITIALIZER;
 
+// Maximum number of translated shaders kept by a translator.
+const size_t kMaxCachedTranslations = 128;
+
 void GetAttributes(ShHandle compiler, AttributeMap* var_map) {
   if (!var_map)
     return;
@@ -159,10 +163,16 @@ ShaderTranslator::DestructionObserver::DestructionObserver() {
 ShaderTranslator::DestructionObserver::~DestructionObserver() {
 }
 
+ShaderTranslator::Translation::Translation()
+    : success(false), shader_version(0) {}
+
+ShaderTranslator::Translation::~Translation() {}
+
 ShaderTranslator::ShaderTranslator()
     : compiler_(NULL),
       driver_bug_workarounds_(static_cast<ShCompileOptions>(0)),
-      gl_shader_interm_output_(false) {
+      gl_shader_interm_output_(false),
+      translation_cache_(kMaxCachedTranslations) {
 }
 
 bool ShaderTranslator::Init(GLenum shader_type,
@@ -218,39 +228,69 @@ bool ShaderTranslator::Translate(const std::string& shader_source,
   // Make sure this instance is initialized.
   DCHECK(compiler_ != NULL);
 
-  bool success = false;
+  const std::string source_hash = base::SHA1HashString(shader_source);
+  TranslationCache::iterator it = translation_cache_.Get(source_hash);
+  if (it == translation_cache_.end()) {
+    it = translation_cache_.Put(source_hash,
+                                TranslateWithCompiler(shader_source));
+  }
+  const Translation& translation = *it->second;
+
+  if (translation.success) {
+    if (translated_source)
+      *translated_source = translation.translated_source;
+    *shader_version = translation.shader_version;
+    if (attrib_map)
+      *attrib_map = translation.attrib_map;
+    if (uniform_map)
+      *uniform_map = translation.uniform_map;
+    if (varying_map)
+      *varying_map = translation.varying_map;
+    if (interface_block_map)
+      *interface_block_map = translation.interface_block_map;
+    if (output_variable_list)
+      *output_variable_list = translation.output_variable_list;
+    if (name_map)
+      *name_map = translation.name_map;
+  }
+  if (info_log)
+    *info_log = translation.info_log;
+
+  return translation.success;
+}
+
+std::unique_ptr<ShaderTranslator::Translation>
+ShaderTranslator::TranslateWithCompiler(
+    const std::string& shader_source) const {
+  std::unique_ptr<Translation> translation(new Translation);
   {
     TRACE_EVENT0("gpu", "ShCompile");
     const char* const shader_strings[] = { shader_source.c_str() };
-    success = ShCompile(
+    translation->success = ShCompile(
         compiler_, shader_strings, 1, GetCompileOptions());
   }
-  if (success) {
+  if (translation->success) {
     // Get translated shader.
-    if (translated_source) {
-      *translated_source = ShGetObjectCode(compiler_);
-    }
+    translation->translated_source = ShGetObjectCode(compiler_);
     // Get shader version.
-    *shader_version = ShGetShaderVersion(compiler_);
+    translation->shader_version = ShGetShaderVersion(compiler_);
     // Get info for attribs, uniforms, varyings and output variables.
-    GetAttributes(compiler_, attrib_map);
-    GetUniforms(compiler_, uniform_map);
-    GetVaryings(compiler_, varying_map);
-    GetInterfaceBlocks(compiler_, interface_block_map);
-    GetOutputVariables(compiler_, output_variable_list);
+    GetAttributes(compiler_, &translation->attrib_map);
+    GetUniforms(compiler_, &translation->uniform_map);
+    GetVaryings(compiler_, &translation->varying_map);
+    GetInterfaceBlocks(compiler_, &translation->interface_block_map);
+    GetOutputVariables(compiler_, &translation->output_variable_list);
     // Get info for name hashing.
-    GetNameHashingInfo(compiler_, name_map);
+    GetNameHashingInfo(compiler_, &translation->name_map);
   }
 
   // Get info log.
-  if (info_log) {
-    *info_log = ShGetInfoLog(compiler_);
-  }
+  translation->info_log = ShGetInfoLog(compiler_);
 
   // We don't need results in the compiler anymore.
   ShClearResults(compiler_);
 
-  return success;
+  return translation;
 }
 
 std::string ShaderTranslator::GetStringForOptionsThatWouldAffectCompilation()
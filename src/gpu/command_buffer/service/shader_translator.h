@@ -5,9 +5,11 @@
 #ifndef GPU_COMMAND_BUFFER_SERVICE_SHADER_TRANSLATOR_H_
 #define GPU_COMMAND_BUFFER_SERVICE_SHADER_TRANSLATOR_H_
 
+#include <memory>
 #include <string>
 
 #include "base/containers/hash_tables.h"
+#include "base/containers/mru_cache.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/observer_list.h"
@@ -121,14 +123,43 @@ class GPU_EXPORT ShaderTranslator
   void RemoveDestructionObserver(DestructionObserver* observer);
 
  private:
+  // The results of translating a shader source.
+  struct Translation {
+    Translation();
+    ~Translation();
+
+    bool success;
+    std::string info_log;
+    std::string translated_source;
+    int shader_version;
+    AttributeMap attrib_map;
+    UniformMap uniform_map;
+    VaryingMap varying_map;
+    InterfaceBlockMap interface_block_map;
+    OutputVariableList output_variable_list;
+    NameMap name_map;
+  };
+
+  // Maps the hash of a shader source to the results of translating it. The
+  // compile options are the same for all the sources given to a translator,
+  // and translators are shared by the contexts that use the same options, so
+  // the shaders that are compiled repeatedly skip ANGLE.
+  typedef base::HashingMRUCache<std::string, std::unique_ptr<Translation>>
+      TranslationCache;
+
   ~ShaderTranslator() override;
 
   int GetCompileOptions() const;
 
+  // Translates |shader_source| with ANGLE.
+  std::unique_ptr<Translation> TranslateWithCompiler(
+      const std::string& shader_source) const;
+
   ShHandle compiler_;
   ShCompileOptions driver_bug_workarounds_;
   bool gl_shader_interm_output_;
   base::ObserverList<DestructionObserver> destruction_observers_;
+  mutable TranslationCache translation_cache_;
 };
 
 }  // namespace gles2
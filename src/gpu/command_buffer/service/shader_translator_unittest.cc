@@ -330,6 +330,66 @@ TEST_F(ShaderTranslatorTest, GetUniforms) {
 }
 
 
+TEST_F(ShaderTranslatorTest, RepeatedTranslationsGiveSameResults) {
+  const char* shader =
+      "attribute vec4 vPosition;\n"
+      "uniform vec4 uColor;\n"
+      "varying vec4 vColor;\n"
+      "void main() {\n"
+      "  vColor = uColor;\n"
+      "  gl_Position = vPosition;\n"
+      "}";
+
+  std::string info_log, translated_source;
+  int shader_version;
+  AttributeMap attrib_map;
+  UniformMap uniform_map;
+  VaryingMap varying_map;
+  InterfaceBlockMap interface_block_map;
+  OutputVariableList output_variable_list;
+  NameMap name_map;
+  EXPECT_TRUE(vertex_translator_->Translate(
+      shader, &info_log, &translated_source, &shader_version, &attrib_map,
+      &uniform_map, &varying_map, &interface_block_map, &output_variable_list,
+      &name_map));
+
+  // Translating the same source again, e.g. for another context, gives the
+  // results of the first translation.
+  std::string info_log2, translated_source2;
+  int shader_version2;
+  AttributeMap attrib_map2;
+  UniformMap uniform_map2;
+  VaryingMap varying_map2;
+  InterfaceBlockMap interface_block_map2;
+  OutputVariableList output_variable_list2;
+  NameMap name_map2;
+  EXPECT_TRUE(vertex_translator_->Translate(
+      shader, &info_log2, &translated_source2, &shader_version2, &attrib_map2,
+      &uniform_map2, &varying_map2, &interface_block_map2,
+      &output_variable_list2, &name_map2));
+  EXPECT_EQ(info_log, info_log2);
+  EXPECT_EQ(translated_source, translated_source2);
+  EXPECT_EQ(shader_version, shader_version2);
+  ASSERT_EQ(1u, attrib_map2.size());
+  EXPECT_TRUE(attrib_map2.find("vPosition") != attrib_map2.end());
+  ASSERT_EQ(1u, uniform_map2.size());
+  EXPECT_TRUE(uniform_map2.find("uColor") != uniform_map2.end());
+  EXPECT_EQ(varying_map.size(), varying_map2.size());
+
+  // A failed translation keeps failing.
+  const char* bad_shader = "foo-bar";
+  EXPECT_FALSE(vertex_translator_->Translate(
+      bad_shader, &info_log, &translated_source, &shader_version, &attrib_map,
+      &uniform_map, &varying_map, &interface_block_map, &output_variable_list,
+      &name_map));
+  EXPECT_FALSE(info_log.empty());
+  EXPECT_FALSE(vertex_translator_->Translate(
+      bad_shader, &info_log2, &translated_source2, &shader_version2,
+      &attrib_map2, &uniform_map2, &varying_map2, &interface_block_map2,
+      &output_variable_list2, &name_map2));
+  EXPECT_EQ(info_log, info_log2);
+}
+
 TEST_F(ES3ShaderTranslatorTest, InvalidInterfaceBlocks) {
   const char* shader =
       "#version 300 es\n"
@@ -363,6 +363,7 @@ void SyncPointClient::ReleaseFenceSync(uint64_t release) {
   // Validate that this Release call is between BeginProcessingOrderNumber() and
   // FinishProcessingOrderNumber(), or else we may deadlock.
   DCHECK(client_state_->order_data()->IsProcessingOrderNumber());
+  fence_sync_release_ = release;
   client_state_->ReleaseFenceSync(release);
 }
 
@@ -373,7 +374,8 @@ void SyncPointClient::SetOnWaitCallback(const OnWaitCallback& callback) {
 SyncPointClient::SyncPointClient()
     : sync_point_manager_(nullptr),
       namespace_id_(gpu::CommandBufferNamespace::INVALID),
-      client_id_() {}
+      client_id_(),
+      fence_sync_release_(0) {}
 
 SyncPointClient::SyncPointClient(SyncPointManager* sync_point_manager,
                                  scoped_refptr<SyncPointOrderData> order_data,
@@ -382,7 +384,8 @@ SyncPointClient::SyncPointClient(SyncPointManager* sync_point_manager,
     : sync_point_manager_(sync_point_manager),
       client_state_(new SyncPointClientState(order_data)),
       namespace_id_(namespace_id),
-      client_id_(client_id) {}
+      client_id_(client_id),
+      fence_sync_release_(0) {}
 
 SyncPointManager::SyncPointManager(bool allow_threaded_wait) {
   global_order_num_.GetNext();
@@ -258,6 +258,14 @@ class GPU_EXPORT SyncPointClient {
 
   void ReleaseFenceSync(uint64_t release);
 
+  // Returns true if |release| was released through this client. Unlike
+  // SyncPointClientState::IsFenceSyncReleased(), this takes no lock, so it
+  // must only be called on the thread which releases the fences of this
+  // client, for example by a client waiting on the same thread.
+  bool IsFenceSyncReleasedOnClientThread(uint64_t release) const {
+    return release <= fence_sync_release_;
+  }
+
   // This callback is called with the namespace and id of the waiting client
   // when a release callback is queued. The callback is called on the thread
   // where the Wait... happens and synchronization is the responsibility of the
@@ -285,6 +293,10 @@ class GPU_EXPORT SyncPointClient {
   const CommandBufferNamespace namespace_id_;
   const CommandBufferId client_id_;
 
+  // Last fence sync released through this client, only accessed on the thread
+  // of the client.
+  uint64_t fence_sync_release_;
+
   DISALLOW_COPY_AND_ASSIGN(SyncPointClient);
 };
 
@@ -153,6 +153,8 @@ TEST_F(SyncPointManagerTest, BasicFenceSyncRelease) {
 
   EXPECT_EQ(1u, client_state->fence_sync_release());
   EXPECT_TRUE(client_state->IsFenceSyncReleased(1));
+  EXPECT_TRUE(client->IsFenceSyncReleasedOnClientThread(1));
+  EXPECT_FALSE(client->IsFenceSyncReleasedOnClientThread(2));
 }
 
 TEST_F(SyncPointManagerTest, MultipleClientsPerOrderData) {
@@ -341,6 +341,7 @@
         'ipc/service/gpu_channel_test_common.cc',
         'ipc/service/gpu_channel_test_common.h',
         'ipc/service/gpu_channel_unittest.cc',
+        'ipc/service/gpu_program_disk_cache_unittest.cc',
       ],
       'include_dirs': [
         '../third_party/mesa/src/include',
@@ -382,6 +383,7 @@
         'command_buffer_service',
       ],
       'sources': [
+        'perftests/decoder_perftest.cc',
         'perftests/measurements.cc',
         'perftests/run_all_tests.cc',
         'perftests/texture_upload_perftest.cc',
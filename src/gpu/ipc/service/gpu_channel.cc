@@ -39,6 +39,7 @@
 #include "gpu/ipc/service/gpu_channel_manager.h"
 #include "gpu/ipc/service/gpu_channel_manager_delegate.h"
 #include "gpu/ipc/service/gpu_memory_buffer_factory.h"
+#include "gpu/ipc/service/gpu_program_disk_cache.h"
 #include "ipc/ipc_channel.h"
 #include "ipc/message_filter.h"
 #include "ui/gl/gl_context.h"
@@ -162,6 +163,11 @@ bool GpuChannelMessageQueue::IsScheduled() const {
   return scheduled_;
 }
 
+bool GpuChannelMessageQueue::HasQueuedMessages() const {
+  base::AutoLock lock(channel_lock_);
+  return !channel_messages_.empty();
+}
+
 void GpuChannelMessageQueue::OnRescheduled(bool scheduled) {
   base::AutoLock lock(channel_lock_);
   DCHECK(enabled_);
@@ -779,6 +785,13 @@ void GpuChannel::PostHandleOutOfOrderMessage(const IPC::Message& msg) {
 
 void GpuChannel::HandleMessage(
     const scoped_refptr<GpuChannelMessageQueue>& message_queue) {
+  // Every scheduled stream with messages has a task posted, so try again once
+  // the higher priority streams had their turn.
+  if (HasHigherPriorityMessages(message_queue.get())) {
+    PostHandleMessage(message_queue);
+    return;
+  }
+
   const GpuChannelMessage* channel_msg =
       message_queue->BeginMessageProcessing();
   if (!channel_msg)
@@ -806,6 +819,18 @@ void GpuChannel::HandleMessage(
   }
 }
 
+bool GpuChannel::HasHigherPriorityMessages(
+    const GpuChannelMessageQueue* message_queue) const {
+  for (const auto& kv : streams_) {
+    const GpuChannelMessageQueue* queue = kv.second.get();
+    if (queue->stream_priority() < message_queue->stream_priority() &&
+        queue->IsScheduled() && queue->HasQueuedMessages()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void GpuChannel::HandleMessageHelper(const IPC::Message& msg) {
   int32_t routing_id = msg.routing_id();
 
@@ -1014,6 +1039,10 @@ void GpuChannel::OnGetDriverBugWorkArounds(
 
 void GpuChannel::CacheShader(const std::string& key,
                              const std::string& shader) {
+  if (gpu_channel_manager_->program_disk_cache()) {
+    gpu_channel_manager_->program_disk_cache()->StoreProgram(key, shader);
+    return;
+  }
   gpu_channel_manager_->delegate()->StoreShaderToDisk(client_id_, key, shader);
 }
 
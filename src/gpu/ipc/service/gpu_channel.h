@@ -185,6 +185,12 @@ class GPU_EXPORT GpuChannel
 
   void HandleMessage(const scoped_refptr<GpuChannelMessageQueue>& queue);
 
+  // Returns true if a scheduled stream of a higher priority than |queue| has
+  // messages to process. The messages of a stream are only processed once
+  // there are none left on the streams of a higher priority, so that a busy
+  // context such as a WebGL one cannot delay the compositor's frames.
+  bool HasHigherPriorityMessages(const GpuChannelMessageQueue* queue) const;
+
   // Some messages such as WaitForGetOffsetInRange and WaitForTokenInRange are
   // processed as soon as possible because the client is blocked until they
   // are completed.
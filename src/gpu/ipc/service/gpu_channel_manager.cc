@@ -25,6 +25,7 @@
 #include "gpu/ipc/service/gpu_channel_manager_delegate.h"
 #include "gpu/ipc/service/gpu_memory_buffer_factory.h"
 #include "gpu/ipc/service/gpu_memory_manager.h"
+#include "gpu/ipc/service/gpu_program_disk_cache.h"
 #include "ui/gl/gl_bindings.h"
 #include "ui/gl/gl_share_group.h"
 #include "ui/gl/init/gl_factory.h"
@@ -40,6 +41,11 @@ const int kMaxGpuIdleTimeMs = 40;
 const int kMaxKeepAliveTimeMs = 200;
 #endif
 
+// Number of programs of the program disk cache that are loaded into the
+// program cache at startup, and that are kept on disk.
+const size_t kMaxPreloadedPrograms = 32;
+const size_t kMaxCachedPrograms = 256;
+
 }
 
 GpuChannelManager::GpuChannelManager(
@@ -190,6 +196,28 @@ void GpuChannelManager::PopulateShaderCache(const std::string& program_proto) {
     program_cache()->LoadProgram(program_proto);
 }
 
+void GpuChannelManager::InitializeProgramDiskCache(
+    const std::string& driver_version) {
+  DCHECK(!program_disk_cache_);
+  if (gpu_preferences_.gpu_program_disk_cache_dir.empty() ||
+      gpu_preferences_.disable_gpu_shader_disk_cache || !program_cache()) {
+    return;
+  }
+  program_disk_cache_.reset(new GpuProgramDiskCache(
+      gpu_preferences_.gpu_program_disk_cache_dir, driver_version,
+      kMaxPreloadedPrograms, kMaxCachedPrograms));
+  program_disk_cache_->PreloadPrograms(base::Bind(
+      &GpuChannelManager::OnProgramsPreloaded, weak_factory_.GetWeakPtr()));
+}
+
+void GpuChannelManager::OnProgramsPreloaded(
+    const std::vector<std::string>& programs) {
+  TRACE_EVENT1("gpu", "GpuChannelManager::OnProgramsPreloaded", "count",
+               programs.size());
+  for (const std::string& program : programs)
+    PopulateShaderCache(program);
+}
+
 uint32_t GpuChannelManager::GetUnprocessedOrderNum() const {
   uint32_t unprocessed_order_num = 0;
   for (auto& kv : gpu_channels_) {
@@ -56,6 +56,7 @@ namespace gpu {
 class GpuChannel;
 class GpuChannelManagerDelegate;
 class GpuMemoryBufferFactory;
+class GpuProgramDiskCache;
 class GpuWatchdog;
 
 // A GpuChannelManager is a thread responsible for issuing rendering commands
@@ -82,6 +83,16 @@ class GPU_EXPORT GpuChannelManager {
                                       bool allow_real_time_streams);
 
   void PopulateShaderCache(const std::string& shader);
+
+  // Creates the program disk cache if |gpu_preferences().
+  // gpu_program_disk_cache_dir| is set, and starts preloading the most
+  // recently used programs of |driver_version| into the program cache.
+  void InitializeProgramDiskCache(const std::string& driver_version);
+  // Returns null if the programs are persisted by the delegate instead.
+  GpuProgramDiskCache* program_disk_cache() const {
+    return program_disk_cache_.get();
+  }
+
   void DestroyGpuMemoryBuffer(gfx::GpuMemoryBufferId id,
                               int client_id,
                               const SyncToken& sync_token);
@@ -161,6 +172,7 @@ class GPU_EXPORT GpuChannelManager {
   base::ScopedPtrHashMap<int32_t, std::unique_ptr<GpuChannel>> gpu_channels_;
 
  private:
+  void OnProgramsPreloaded(const std::vector<std::string>& programs);
   void InternalDestroyGpuMemoryBuffer(gfx::GpuMemoryBufferId id, int client_id);
   void InternalDestroyGpuMemoryBufferOnIO(gfx::GpuMemoryBufferId id,
                                           int client_id);
@@ -186,6 +198,7 @@ class GPU_EXPORT GpuChannelManager {
   SyncPointManager* sync_point_manager_;
   std::unique_ptr<SyncPointClient> sync_point_client_waiter_;
   std::unique_ptr<gles2::ProgramCache> program_cache_;
+  std::unique_ptr<GpuProgramDiskCache> program_disk_cache_;
   scoped_refptr<gles2::ShaderTranslatorCache> shader_translator_cache_;
   scoped_refptr<gles2::FramebufferCompletenessCache>
       framebuffer_completeness_cache_;
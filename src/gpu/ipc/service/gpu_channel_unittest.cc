@@ -375,6 +375,58 @@ TEST_F(GpuChannelTest, StreamLifetime) {
   EXPECT_TRUE(stub);
 }
 
+TEST_F(GpuChannelTest, HigherPriorityStreamsAreHandledFirst) {
+  int32_t kClientId = 1;
+  GpuChannel* channel = CreateChannel(kClientId, true, false);
+  ASSERT_TRUE(channel);
+
+  int32_t kLowRouteId = 1;
+  int32_t kLowStreamId = 1;
+  int32_t kHighRouteId = 2;
+  int32_t kHighStreamId = 2;
+  GPUCreateCommandBufferConfig init_params;
+  init_params.surface_handle = kNullSurfaceHandle;
+  init_params.share_group_id = MSG_ROUTING_NONE;
+  init_params.stream_id = kLowStreamId;
+  init_params.stream_priority = GpuStreamPriority::LOW;
+  init_params.attribs = gles2::ContextCreationAttribHelper();
+  init_params.active_url = GURL();
+  bool result = false;
+  gpu::Capabilities capabilities;
+  HandleMessage(channel, new GpuChannelMsg_CreateCommandBuffer(
+                             init_params, kLowRouteId, GetSharedHandle(),
+                             &result, &capabilities));
+  EXPECT_TRUE(result);
+
+  init_params.stream_id = kHighStreamId;
+  init_params.stream_priority = GpuStreamPriority::HIGH;
+  HandleMessage(channel, new GpuChannelMsg_CreateCommandBuffer(
+                             init_params, kHighRouteId, GetSharedHandle(),
+                             &result, &capabilities));
+  EXPECT_TRUE(result);
+
+  // The low priority stream received its messages first, but the ones of the
+  // high priority stream are handled before them.
+  uint32_t kInvalidQueryId = 0;
+  channel->filter()->OnMessageReceived(
+      GpuCommandBufferMsg_SignalQuery(kLowRouteId, kInvalidQueryId, 1));
+  channel->filter()->OnMessageReceived(
+      GpuCommandBufferMsg_SignalQuery(kLowRouteId, kInvalidQueryId, 2));
+  channel->filter()->OnMessageReceived(
+      GpuCommandBufferMsg_SignalQuery(kHighRouteId, kInvalidQueryId, 3));
+  task_runner()->RunUntilIdle();
+
+  IPC::TestSink* sink = static_cast<TestGpuChannel*>(channel)->sink();
+  ASSERT_EQ(3u, sink->message_count());
+  EXPECT_EQ(kHighRouteId, sink->GetMessageAt(0)->routing_id());
+  EXPECT_EQ(kLowRouteId, sink->GetMessageAt(1)->routing_id());
+  EXPECT_EQ(kLowRouteId, sink->GetMessageAt(2)->routing_id());
+  sink->ClearMessages();
+
+  HandleMessage(channel, new GpuChannelMsg_DestroyCommandBuffer(kLowRouteId));
+  HandleMessage(channel, new GpuChannelMsg_DestroyCommandBuffer(kHighRouteId));
+}
+
 TEST_F(GpuChannelTest, RealTimeStreamsDisallowed) {
   int32_t kClientId = 1;
   bool allow_real_time_streams = false;
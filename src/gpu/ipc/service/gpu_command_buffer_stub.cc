@@ -192,6 +192,7 @@ GpuCommandBufferStub::GpuCommandBufferStub(
       route_id_(route_id),
       last_flush_count_(0),
       waiting_for_sync_point_(false),
+      sync_point_wait_count_(0),
       previous_processed_num_(0),
       active_url_(init_params.active_url),
       active_url_hash_(base::Hash(active_url_.possibly_invalid_spec())) {}
@@ -926,6 +927,13 @@ bool GpuCommandBufferStub::OnWaitFenceSync(
   DCHECK(!waiting_for_sync_point_);
   DCHECK(executor_->scheduled());
 
+  sync_point_wait_count_++;
+  if (IsFenceSyncReleasedOnThisThread(namespace_id, command_buffer_id,
+                                      release)) {
+    PullTextureUpdates(namespace_id, command_buffer_id, release);
+    return true;
+  }
+
   scoped_refptr<SyncPointClientState> release_state =
       channel_->sync_point_manager()->GetSyncPointClientState(
           namespace_id, command_buffer_id);
@@ -941,6 +949,7 @@ bool GpuCommandBufferStub::OnWaitFenceSync(
   TRACE_EVENT_ASYNC_BEGIN1("gpu", "WaitFenceSync", this, "GpuCommandBufferStub",
                            this);
   waiting_for_sync_point_ = true;
+  sync_point_wait_start_time_ = base::TimeTicks::Now();
   sync_point_client_->WaitNonThreadSafe(
       release_state.get(), release, channel_->task_runner(),
       base::Bind(&GpuCommandBufferStub::OnWaitFenceSyncCompleted,
@@ -954,6 +963,25 @@ bool GpuCommandBufferStub::OnWaitFenceSync(
   return false;
 }
 
+bool GpuCommandBufferStub::IsFenceSyncReleasedOnThisThread(
+    CommandBufferNamespace namespace_id,
+    CommandBufferId command_buffer_id,
+    uint64_t release) const {
+  if (namespace_id != CommandBufferNamespace::GPU_IO)
+    return false;
+
+  // See GetCommandBufferID().
+  const uint64_t id = command_buffer_id.GetUnsafeValue();
+  GpuChannel* channel = channel_->gpu_channel_manager()->LookupChannel(
+      static_cast<int32_t>(id >> 32));
+  if (!channel)
+    return false;
+  GpuCommandBufferStub* stub =
+      channel->LookupCommandBuffer(static_cast<int32_t>(id & 0xFFFFFFFF));
+  return stub && stub->sync_point_client_ &&
+         stub->sync_point_client_->IsFenceSyncReleasedOnClientThread(release);
+}
+
 void GpuCommandBufferStub::OnWaitFenceSyncCompleted(
     CommandBufferNamespace namespace_id,
     CommandBufferId command_buffer_id,
@@ -961,6 +989,7 @@ void GpuCommandBufferStub::OnWaitFenceSyncCompleted(
   DCHECK(waiting_for_sync_point_);
   TRACE_EVENT_ASYNC_END1("gpu", "WaitFenceSync", this, "GpuCommandBufferStub",
                          this);
+  sync_point_wait_time_ += base::TimeTicks::Now() - sync_point_wait_start_time_;
   PullTextureUpdates(namespace_id, command_buffer_id, release);
   waiting_for_sync_point_ = false;
   executor_->SetScheduled(true);
@@ -1110,6 +1139,11 @@ void GpuCommandBufferStub::MarkContextLost() {
 
 void GpuCommandBufferStub::SendSwapBuffersCompleted(
     const GpuCommandBufferMsg_SwapBuffersCompleted_Params& params) {
+  TRACE_COUNTER_ID2("gpu", "GpuCommandBufferStub::SyncPointWaits", this,
+                    "count", sync_point_wait_count_, "time_us",
+                    sync_point_wait_time_.InMicroseconds());
+  sync_point_wait_count_ = 0;
+  sync_point_wait_time_ = base::TimeDelta();
   Send(new GpuCommandBufferMsg_SwapBuffersCompleted(route_id_, params));
 }
 
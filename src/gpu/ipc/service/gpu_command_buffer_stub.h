@@ -181,6 +181,14 @@ class GPU_EXPORT GpuCommandBufferStub
                                 CommandBufferId command_buffer_id,
                                 uint64_t release);
 
+  // Returns true if the fence sync |release| of the command buffer
+  // |command_buffer_id| was released by a stub of this process. The stubs of
+  // all the channels run on the same thread, so this doesn't need to go
+  // through the SyncPointManager, which takes locks.
+  bool IsFenceSyncReleasedOnThisThread(CommandBufferNamespace namespace_id,
+                                       CommandBufferId command_buffer_id,
+                                       uint64_t release) const;
+
   void OnDescheduleUntilFinished();
   void OnRescheduleAfterFinished();
 
@@ -239,6 +247,12 @@ class GPU_EXPORT GpuCommandBufferStub
 
   bool waiting_for_sync_point_;
 
+  // Number of fence sync waits, and time spent waiting for them, since the
+  // last frame.
+  uint32_t sync_point_wait_count_;
+  base::TimeDelta sync_point_wait_time_;
+  base::TimeTicks sync_point_wait_start_time_;
+
   base::TimeTicks process_delayed_work_time_;
   uint32_t previous_processed_num_;
   base::TimeTicks last_idle_time_;
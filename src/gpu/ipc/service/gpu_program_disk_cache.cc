@@ -0,0 +1,120 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gpu/ipc/service/gpu_program_disk_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/logging.h"
+#include "base/sha1.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task_runner_util.h"
+#include "base/time/time.h"
+
+namespace gpu {
+
+namespace {
+
+const base::FilePath::CharType kProgramExtension[] = FILE_PATH_LITERAL(".bin");
+const base::FilePath::CharType kProgramPattern[] = FILE_PATH_LITERAL("*.bin");
+
+std::vector<std::string> ReadPrograms(const base::FilePath& cache_dir,
+                                      size_t max_preloaded_programs,
+                                      size_t max_cached_programs) {
+  // Writing or using a program updates its last modified time, so it tells
+  // the order in which programs were last used.
+  std::vector<std::pair<base::Time, base::FilePath>> files;
+  base::FileEnumerator enumerator(
+      cache_dir, false, base::FileEnumerator::FILES, kProgramPattern);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    files.push_back(
+        std::make_pair(enumerator.GetInfo().GetLastModifiedTime(), path));
+  }
+  std::sort(files.begin(), files.end(),
+            [](const std::pair<base::Time, base::FilePath>& a,
+               const std::pair<base::Time, base::FilePath>& b) {
+              return a.first > b.first;
+            });
+
+  std::vector<std::string> programs;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (i >= max_cached_programs) {
+      base::DeleteFile(files[i].second, false);
+      continue;
+    }
+    if (programs.size() >= max_preloaded_programs)
+      continue;
+    std::string program;
+    if (base::ReadFileToString(files[i].second, &program))
+      programs.push_back(std::move(program));
+  }
+  return programs;
+}
+
+void WriteProgram(const base::FilePath& path, const std::string& program) {
+  if (base::PathExists(path)) {
+    base::Time now = base::Time::Now();
+    base::TouchFile(path, now, now);
+    return;
+  }
+  if (!base::CreateDirectory(path.DirName()) ||
+      !base::ImportantFileWriter::WriteFileAtomically(path, program)) {
+    DLOG(ERROR) << "Failed to write program to " << path.value();
+  }
+}
+
+}  // namespace
+
+GpuProgramDiskCache::GpuProgramDiskCache(const base::FilePath& cache_dir,
+                                         const std::string& driver_version,
+                                         size_t max_preloaded_programs,
+                                         size_t max_cached_programs)
+    : cache_dir_(cache_dir.AppendASCII(
+          base::HexEncode(base::SHA1HashString(driver_version).data(),
+                          base::kSHA1Length))),
+      max_preloaded_programs_(max_preloaded_programs),
+      max_cached_programs_(max_cached_programs),
+      thread_("GpuProgramDiskCacheThread") {
+  base::Thread::Options options;
+  options.priority = base::ThreadPriority::BACKGROUND;
+  thread_.StartWithOptions(options);
+}
+
+GpuProgramDiskCache::~GpuProgramDiskCache() {
+  thread_.Stop();
+}
+
+void GpuProgramDiskCache::PreloadPrograms(
+    const ProgramsLoadedCallback& callback) {
+  base::PostTaskAndReplyWithResult(
+      thread_.task_runner().get(), FROM_HERE,
+      base::Bind(&ReadPrograms, cache_dir_, max_preloaded_programs_,
+                 max_cached_programs_),
+      callback);
+}
+
+void GpuProgramDiskCache::StoreProgram(const std::string& key,
+                                       const std::string& program) {
+  thread_.task_runner()->PostTask(
+      FROM_HERE, base::Bind(&WriteProgram, GetProgramPath(key), program));
+}
+
+base::FilePath GpuProgramDiskCache::GetProgramPathForTesting(
+    const std::string& key) const {
+  return GetProgramPath(key);
+}
+
+base::FilePath GpuProgramDiskCache::GetProgramPath(
+    const std::string& key) const {
+  return cache_dir_.AppendASCII(base::HexEncode(key.data(), key.size()))
+      .AddExtension(kProgramExtension);
+}
+
+}  // namespace gpu
@@ -0,0 +1,66 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef GPU_IPC_SERVICE_GPU_PROGRAM_DISK_CACHE_H_
+#define GPU_IPC_SERVICE_GPU_PROGRAM_DISK_CACHE_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/threading/thread.h"
+#include "gpu/gpu_export.h"
+
+namespace gpu {
+
+// Persists the linked programs of the GPU process to a directory, without
+// going through the shader disk cache of the browser. Programs are the
+// serialized GpuProgramProtos given to the ShaderCacheCallback of the
+// ProgramCache, and are kept in a subdirectory specific to the driver version,
+// since the binaries of a driver can't be loaded by another one.
+//
+// All the file operations happen on a thread owned by the cache, and the ones
+// that are pending when the cache is destroyed are completed first.
+class GPU_EXPORT GpuProgramDiskCache {
+ public:
+  using ProgramsLoadedCallback =
+      base::Callback<void(const std::vector<std::string>& programs)>;
+
+  // Up to |max_preloaded_programs| programs are preloaded, and only the
+  // |max_cached_programs| most recently used ones are kept on disk.
+  GpuProgramDiskCache(const base::FilePath& cache_dir,
+                      const std::string& driver_version,
+                      size_t max_preloaded_programs,
+                      size_t max_cached_programs);
+  ~GpuProgramDiskCache();
+
+  // Reads the most recently used programs, and runs |callback| with them on
+  // the calling thread, from the most recently used one. Also deletes the
+  // programs that don't fit in the cache anymore.
+  void PreloadPrograms(const ProgramsLoadedCallback& callback);
+
+  // Writes |program| under |key|, or only marks it as the most recently used
+  // one if it was already stored.
+  void StoreProgram(const std::string& key, const std::string& program);
+
+  base::FilePath GetProgramPathForTesting(const std::string& key) const;
+
+ private:
+  base::FilePath GetProgramPath(const std::string& key) const;
+
+  const base::FilePath cache_dir_;
+  const size_t max_preloaded_programs_;
+  const size_t max_cached_programs_;
+  base::Thread thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(GpuProgramDiskCache);
+};
+
+}  // namespace gpu
+
+#endif  // GPU_IPC_SERVICE_GPU_PROGRAM_DISK_CACHE_H_
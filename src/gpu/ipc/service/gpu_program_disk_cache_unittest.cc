@@ -0,0 +1,134 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gpu/ipc/service/gpu_program_disk_cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace gpu {
+namespace {
+
+const char kDriverVersion[] = "driver 1.0";
+const size_t kMaxPreloadedPrograms = 2;
+const size_t kMaxCachedPrograms = 3;
+
+class GpuProgramDiskCacheTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  std::unique_ptr<GpuProgramDiskCache> CreateCache(
+      const std::string& driver_version) {
+    return std::unique_ptr<GpuProgramDiskCache>(
+        new GpuProgramDiskCache(temp_dir_.path(), driver_version,
+                                kMaxPreloadedPrograms, kMaxCachedPrograms));
+  }
+
+  std::vector<std::string> PreloadPrograms(GpuProgramDiskCache* cache) {
+    std::vector<std::string> programs;
+    base::RunLoop run_loop;
+    cache->PreloadPrograms(base::Bind(&GpuProgramDiskCacheTest::OnPreloaded,
+                                      run_loop.QuitClosure(), &programs));
+    run_loop.Run();
+    return programs;
+  }
+
+  // Makes the program of |key| look like it was last used |seconds_ago|.
+  void SetLastUsedTime(GpuProgramDiskCache* cache,
+                       const std::string& key,
+                       int seconds_ago) {
+    base::Time time =
+        base::Time::Now() - base::TimeDelta::FromSeconds(seconds_ago);
+    ASSERT_TRUE(
+        base::TouchFile(cache->GetProgramPathForTesting(key), time, time));
+  }
+
+ private:
+  static void OnPreloaded(const base::Closure& quit_closure,
+                          std::vector<std::string>* programs,
+                          const std::vector<std::string>& preloaded) {
+    *programs = preloaded;
+    quit_closure.Run();
+  }
+
+  base::MessageLoop message_loop_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(GpuProgramDiskCacheTest, PreloadsStoredPrograms) {
+  std::unique_ptr<GpuProgramDiskCache> cache = CreateCache(kDriverVersion);
+  cache->StoreProgram("key", "program");
+  // Destroying the cache completes its writes.
+  cache.reset();
+
+  cache = CreateCache(kDriverVersion);
+  std::vector<std::string> programs = PreloadPrograms(cache.get());
+  ASSERT_EQ(1u, programs.size());
+  EXPECT_EQ("program", programs[0]);
+}
+
+TEST_F(GpuProgramDiskCacheTest, PreloadsMostRecentlyUsedPrograms) {
+  std::unique_ptr<GpuProgramDiskCache> cache = CreateCache(kDriverVersion);
+  cache->StoreProgram("key1", "program1");
+  cache->StoreProgram("key2", "program2");
+  cache->StoreProgram("key3", "program3");
+  cache->StoreProgram("key4", "program4");
+  cache.reset();
+
+  cache = CreateCache(kDriverVersion);
+  SetLastUsedTime(cache.get(), "key1", 10);
+  SetLastUsedTime(cache.get(), "key2", 30);
+  SetLastUsedTime(cache.get(), "key3", 20);
+  SetLastUsedTime(cache.get(), "key4", 40);
+  std::vector<std::string> programs = PreloadPrograms(cache.get());
+  ASSERT_EQ(kMaxPreloadedPrograms, programs.size());
+  EXPECT_EQ("program1", programs[0]);
+  EXPECT_EQ("program3", programs[1]);
+
+  // The least recently used program doesn't fit in the cache.
+  EXPECT_TRUE(base::PathExists(cache->GetProgramPathForTesting("key2")));
+  EXPECT_FALSE(base::PathExists(cache->GetProgramPathForTesting("key4")));
+}
+
+TEST_F(GpuProgramDiskCacheTest, StoringAgainMarksProgramAsUsed) {
+  std::unique_ptr<GpuProgramDiskCache> cache = CreateCache(kDriverVersion);
+  cache->StoreProgram("key1", "program1");
+  cache->StoreProgram("key2", "program2");
+  cache->StoreProgram("key3", "program3");
+  cache.reset();
+
+  cache = CreateCache(kDriverVersion);
+  SetLastUsedTime(cache.get(), "key1", 30);
+  SetLastUsedTime(cache.get(), "key2", 20);
+  SetLastUsedTime(cache.get(), "key3", 10);
+  cache->StoreProgram("key1", "program1");
+  cache.reset();
+
+  cache = CreateCache(kDriverVersion);
+  std::vector<std::string> programs = PreloadPrograms(cache.get());
+  ASSERT_EQ(kMaxPreloadedPrograms, programs.size());
+  EXPECT_EQ("program1", programs[0]);
+  EXPECT_EQ("program3", programs[1]);
+}
+
+TEST_F(GpuProgramDiskCacheTest, ProgramsAreNotSharedBetweenDrivers) {
+  std::unique_ptr<GpuProgramDiskCache> cache = CreateCache(kDriverVersion);
+  cache->StoreProgram("key", "program");
+  cache.reset();
+
+  cache = CreateCache("driver 2.0");
+  EXPECT_TRUE(PreloadPrograms(cache.get()).empty());
+}
+
+}  // namespace
+}  // namespace gpu
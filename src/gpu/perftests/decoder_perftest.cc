@@ -0,0 +1,177 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "gpu/command_buffer/common/gles2_cmd_format.h"
+#include "gpu/command_buffer/service/context_group.h"
+#include "gpu/command_buffer/service/feature_info.h"
+#include "gpu/command_buffer/service/framebuffer_completeness_cache.h"
+#include "gpu/command_buffer/service/gles2_cmd_decoder.h"
+#include "gpu/command_buffer/service/gpu_preferences.h"
+#include "gpu/command_buffer/service/mailbox_manager_impl.h"
+#include "gpu/command_buffer/service/shader_translator_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "ui/gfx/geometry/size.h"
+#include "ui/gl/gl_context.h"
+#include "ui/gl/gl_surface.h"
+#include "ui/gl/init/gl_factory.h"
+
+#if defined(USE_OZONE)
+#include "base/message_loop/message_loop.h"
+#endif
+
+namespace gpu {
+namespace gles2 {
+namespace {
+
+const int kWarmupRuns = 5;
+const int kTimeLimitMillis = 2000;
+const int kCommandCount = 10000;
+
+// Measures how many commands per second the decoder processes, which for
+// cheap commands is mostly the cost of parsing and dispatching them.
+class DecoderPerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+#if defined(USE_OZONE)
+    // On Ozone, the backend initializes the event system using a UI
+    // thread.
+    base::MessageLoopForUI main_loop;
+#endif
+    static bool gl_initialized = gl::init::InitializeGLOneOff();
+    DCHECK(gl_initialized);
+    surface_ = gl::init::CreateOffscreenGLSurface(gfx::Size());
+    ASSERT_TRUE(surface_.get());
+    context_ = gl::init::CreateGLContext(nullptr,  // share_group
+                                         surface_.get(),
+                                         gl::PreferIntegratedGpu);
+    ASSERT_TRUE(context_.get());
+    ASSERT_TRUE(context_->MakeCurrent(surface_.get()));
+
+    scoped_refptr<ContextGroup> group = new ContextGroup(
+        gpu_preferences_, new MailboxManagerImpl, nullptr,
+        new ShaderTranslatorCache(gpu_preferences_),
+        new FramebufferCompletenessCache, new FeatureInfo, true, nullptr);
+    decoder_.reset(GLES2Decoder::Create(group.get()));
+    ContextCreationAttribHelper attribs;
+    attribs.offscreen_framebuffer_size = gfx::Size(1, 1);
+    ASSERT_TRUE(decoder_->Initialize(surface_, context_, true,
+                                     DisallowedFeatures(), attribs));
+  }
+
+  void TearDown() override {
+    decoder_->Destroy(true);
+    decoder_.reset();
+    context_ = nullptr;
+    surface_ = nullptr;
+  }
+
+ protected:
+  // Appends the space of a command of type |T|, of |size| bytes, to the
+  // command stream.
+  template <typename T>
+  T* AppendCommand(size_t size) {
+    DCHECK_EQ(0u, size % sizeof(CommandBufferEntry));
+    size_t offset = commands_.size();
+    commands_.resize(offset + size / sizeof(CommandBufferEntry));
+    return reinterpret_cast<T*>(&commands_[offset]);
+  }
+
+  template <typename T>
+  T* AppendCommand() {
+    return AppendCommand<T>(sizeof(T));
+  }
+
+  // Appends a fixed-size command that changes some state.
+  void AppendStateCommand(int i) {
+    switch (i % 3) {
+      case 0:
+        AppendCommand<cmds::Viewport>()->Init(0, 0, 1 + i % 2, 1);
+        break;
+      case 1:
+        AppendCommand<cmds::Scissor>()->Init(0, 0, 1 + i % 2, 1);
+        break;
+      case 2:
+        AppendCommand<cmds::BlendColor>()->Init(i % 2, 0.f, 0.f, 1.f);
+        break;
+    }
+  }
+
+  // Appends a command with immediate data, that interrupts a run of
+  // fixed-size commands.
+  void AppendImmediateCommand() {
+    // Deleting a texture that doesn't exist is silently ignored.
+    const GLuint texture = 1;
+    AppendCommand<cmds::DeleteTexturesImmediate>(
+        cmds::DeleteTexturesImmediate::ComputeSize(1))
+        ->Init(1, &texture);
+  }
+
+  void RunDoCommandsTest(const std::string& test_name) {
+    for (int i = 0; i < kWarmupRuns; ++i)
+      DoCommands();
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    base::TimeDelta elapsed;
+    int runs = 0;
+    do {
+      DoCommands();
+      ++runs;
+      elapsed = base::TimeTicks::Now() - start;
+    } while (elapsed < base::TimeDelta::FromMilliseconds(kTimeLimitMillis));
+
+    perf_test::PrintResult("decoder_do_commands", "", test_name,
+                           runs * num_commands_ / elapsed.InSecondsF(),
+                           "commands/s", true);
+  }
+
+  int num_commands_ = 0;
+  std::vector<CommandBufferEntry> commands_;
+
+ private:
+  void DoCommands() {
+    int entries_processed = 0;
+    error::Error error =
+        decoder_->DoCommands(num_commands_, commands_.data(),
+                             static_cast<int>(commands_.size()),
+                             &entries_processed);
+    CHECK_EQ(error::kNoError, error);
+    CHECK_EQ(commands_.size(), static_cast<size_t>(entries_processed));
+  }
+
+  GpuPreferences gpu_preferences_;
+  scoped_refptr<gl::GLSurface> surface_;
+  scoped_refptr<gl::GLContext> context_;
+  std::unique_ptr<GLES2Decoder> decoder_;
+};
+
+TEST_F(DecoderPerfTest, FixedSizeCommands) {
+  for (int i = 0; i < kCommandCount; ++i)
+    AppendStateCommand(i);
+  num_commands_ = kCommandCount;
+  RunDoCommandsTest("fixed_size");
+}
+
+TEST_F(DecoderPerfTest, InterleavedImmediateCommands) {
+  for (int i = 0; i < kCommandCount / 2; ++i) {
+    AppendStateCommand(i);
+    AppendImmediateCommand();
+  }
+  num_commands_ = kCommandCount;
+  RunDoCommandsTest("interleaved_immediate");
+}
+
+}  // namespace
+}  // namespace gles2
+}  // namespace gpu
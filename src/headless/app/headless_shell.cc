@@ -2,20 +2,35 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <stddef.h>
+
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/format_macros.h"
 #include "base/json/json_writer.h"
 #include "base/location.h"
+#include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/sys_info.h"
+#include "base/task_runner_util.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/public/common/content_switches.h"
 #include "headless/app/headless_shell_switches.h"
 #include "headless/public/domains/page.h"
@@ -29,6 +44,7 @@
 #include "net/base/ip_address.h"
 #include "net/base/net_errors.h"
 #include "ui/gfx/geometry/size.h"
+#include "url/gurl.h"
 
 using headless::HeadlessBrowser;
 using headless::HeadlessDevToolsClient;
@@ -41,6 +57,11 @@ namespace {
 const char kDevToolsHttpServerAddress[] = "127.0.0.1";
 // Default file name for screenshot. Can be overriden by "--screenshot" switch.
 const char kDefaultScreenshotFileName[] = "screenshot.png";
+// Number of pages rendered at the same time in --batch mode, unless
+// overridden by the "--batch-concurrency" switch.
+const size_t kDefaultBatchConcurrency = 4;
+// How long a page in --batch mode gets to load before it is given up on.
+const int kBatchPageLoadTimeoutSeconds = 30;
 }
 
 // A sample application which demonstrates the use of the headless API.
@@ -284,6 +305,264 @@ class HeadlessShell : public HeadlessWebContents::Observer, page::Observer {
   DISALLOW_COPY_AND_ASSIGN(HeadlessShell);
 };
 
+// Loads a page into a web contents that is kept around for the next one and
+// captures a screenshot of it once it has loaded.
+class BatchPage : public HeadlessWebContents::Observer, page::Observer {
+ public:
+  // Called when the page is ready for a URL to load, with the screenshot of
+  // the URL it was loading before, if any. The screenshot is null if the URL
+  // could not be rendered.
+  using IdleCallback =
+      base::Callback<void(BatchPage* page,
+                          std::unique_ptr<page::CaptureScreenshotResult>)>;
+
+  BatchPage(HeadlessBrowser* browser, const IdleCallback& idle_callback)
+      : browser_(browser),
+        idle_callback_(idle_callback),
+        devtools_client_(HeadlessDevToolsClient::Create()),
+        web_contents_(nullptr),
+        loading_(false) {}
+  ~BatchPage() override {}
+
+  bool Start() {
+    web_contents_ = browser_->CreateWebContentsBuilder().Build();
+    if (!web_contents_)
+      return false;
+    web_contents_->AddObserver(this);
+    return true;
+  }
+
+  void Load(const GURL& url) {
+    DCHECK(!loading_);
+    loading_ = true;
+    load_timeout_.Start(
+        FROM_HERE, base::TimeDelta::FromSeconds(kBatchPageLoadTimeoutSeconds),
+        base::Bind(&BatchPage::OnLoadTimeout, base::Unretained(this)));
+    devtools_client_->GetPage()->Navigate(url.spec());
+  }
+
+  void Close() {
+    if (!web_contents_)
+      return;
+    devtools_client_->GetPage()->RemoveObserver(this);
+    web_contents_->GetDevToolsTarget()->DetachClient(devtools_client_.get());
+    web_contents_->RemoveObserver(this);
+    web_contents_->Close();
+    web_contents_ = nullptr;
+  }
+
+  // HeadlessWebContents::Observer implementation:
+  void DevToolsTargetReady() override {
+    web_contents_->GetDevToolsTarget()->AttachClient(devtools_client_.get());
+    devtools_client_->GetPage()->AddObserver(this);
+    devtools_client_->GetPage()->Enable();
+    idle_callback_.Run(this, nullptr);
+  }
+
+  // page::Observer implementation:
+  void OnLoadEventFired(const page::LoadEventFiredParams& params) override {
+    if (!loading_)
+      return;
+    loading_ = false;
+    load_timeout_.Stop();
+    devtools_client_->GetPage()->GetExperimental()->CaptureScreenshot(
+        page::CaptureScreenshotParams::Builder().Build(),
+        base::Bind(&BatchPage::OnScreenshotCaptured, base::Unretained(this)));
+  }
+
+ private:
+  void OnLoadTimeout() {
+    // Loading the next URL cancels this one.
+    loading_ = false;
+    idle_callback_.Run(this, nullptr);
+  }
+
+  void OnScreenshotCaptured(
+      std::unique_ptr<page::CaptureScreenshotResult> result) {
+    idle_callback_.Run(this, std::move(result));
+  }
+
+  HeadlessBrowser* browser_;  // Not owned.
+  IdleCallback idle_callback_;
+  std::unique_ptr<HeadlessDevToolsClient> devtools_client_;
+  HeadlessWebContents* web_contents_;
+  bool loading_;
+  base::OneShotTimer load_timeout_;
+
+  DISALLOW_COPY_AND_ASSIGN(BatchPage);
+};
+
+// Renders a list of URLs into screenshots with a fixed number of pages in
+// flight, and reports how many pages per second it got through. Each page
+// keeps its web contents and DevTools client from one URL to the next, so
+// only the first URL of each pays for setting them up.
+class HeadlessBatchRenderer {
+ public:
+  HeadlessBatchRenderer(std::vector<GURL> urls,
+                        size_t concurrency,
+                        const base::FilePath& output_dir)
+      : urls_(std::move(urls)),
+        concurrency_(concurrency),
+        output_dir_(output_dir),
+        browser_(nullptr),
+        next_url_(0),
+        closed_page_count_(0),
+        pending_write_count_(0),
+        rendered_count_(0) {}
+  ~HeadlessBatchRenderer() {}
+
+  void OnStart(HeadlessBrowser* browser) {
+    browser_ = browser;
+    start_time_ = base::TimeTicks::Now();
+    const size_t page_count = std::min(concurrency_, urls_.size());
+    for (size_t i = 0; i < page_count; ++i) {
+      std::unique_ptr<BatchPage> page(new BatchPage(
+          browser_, base::Bind(&HeadlessBatchRenderer::OnPageIdle,
+                               base::Unretained(this))));
+      if (!page->Start()) {
+        LOG(ERROR) << "Failed to create a page";
+        continue;
+      }
+      pages_.push_back(std::move(page));
+    }
+    MaybeFinish();
+  }
+
+ private:
+  void OnPageIdle(BatchPage* page,
+                  std::unique_ptr<page::CaptureScreenshotResult> result) {
+    auto it = pages_in_flight_.find(page);
+    if (it != pages_in_flight_.end()) {
+      const size_t index = it->second;
+      pages_in_flight_.erase(it);
+      if (result) {
+        SaveScreenshot(index, result->GetData());
+      } else {
+        LOG(ERROR) << "Failed to render " << urls_[index].spec();
+      }
+    }
+
+    if (next_url_ < urls_.size()) {
+      pages_in_flight_[page] = next_url_;
+      page->Load(urls_[next_url_++]);
+      return;
+    }
+    page->Close();
+    closed_page_count_++;
+    MaybeFinish();
+  }
+
+  void SaveScreenshot(size_t index, const std::string& base64_png) {
+    const base::FilePath file_name = output_dir_.AppendASCII(
+        base::StringPrintf("page_%04" PRIuS ".png", index));
+    pending_write_count_++;
+    base::PostTaskAndReplyWithResult(
+        browser_->BrowserFileThread().get(), FROM_HERE,
+        base::Bind(&WriteScreenshot, file_name, base64_png),
+        base::Bind(&HeadlessBatchRenderer::OnScreenshotWritten,
+                   base::Unretained(this), file_name));
+  }
+
+  static bool WriteScreenshot(const base::FilePath& file_name,
+                              const std::string& base64_png) {
+    std::string png;
+    if (!base::Base64Decode(base64_png, &png))
+      return false;
+    return base::WriteFile(file_name, png.data(), png.size()) ==
+           static_cast<int>(png.size());
+  }
+
+  void OnScreenshotWritten(const base::FilePath& file_name, bool success) {
+    pending_write_count_--;
+    if (success) {
+      rendered_count_++;
+    } else {
+      LOG(ERROR) << "Writing screenshot to file " << file_name.value()
+                 << " was unsuccessful";
+    }
+    MaybeFinish();
+  }
+
+  void MaybeFinish() {
+    if (closed_page_count_ < pages_.size() || pending_write_count_)
+      return;
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start_time_;
+    std::cout << "Rendered " << rendered_count_ << " of " << urls_.size()
+              << " pages in " << elapsed.InSecondsF() << " s ("
+              << rendered_count_ / elapsed.InSecondsF() << " pages/s)."
+              << std::endl;
+    browser_->Shutdown();
+  }
+
+  const std::vector<GURL> urls_;
+  const size_t concurrency_;
+  const base::FilePath output_dir_;
+  HeadlessBrowser* browser_;  // Not owned.
+  std::vector<std::unique_ptr<BatchPage>> pages_;
+  // The index in |urls_| of the URL each busy page is rendering.
+  std::map<BatchPage*, size_t> pages_in_flight_;
+  size_t next_url_;
+  size_t closed_page_count_;
+  size_t pending_write_count_;
+  size_t rendered_count_;
+  base::TimeTicks start_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeadlessBatchRenderer);
+};
+
+// Sets up --batch mode from the command line. Returns null if the switches
+// are invalid.
+std::unique_ptr<HeadlessBatchRenderer> CreateBatchRenderer(
+    const base::CommandLine& command_line,
+    HeadlessBrowser::Options::Builder* builder) {
+  std::string url_list;
+  if (!base::ReadFileToString(
+          command_line.GetSwitchValuePath(headless::switches::kBatch),
+          &url_list)) {
+    LOG(ERROR) << "Could not read the list of URLs to render";
+    return nullptr;
+  }
+  std::vector<GURL> urls;
+  for (const std::string& line :
+       base::SplitString(url_list, "\n", base::TRIM_WHITESPACE,
+                         base::SPLIT_WANT_NONEMPTY)) {
+    GURL url(line);
+    if (!url.is_valid()) {
+      LOG(ERROR) << "Invalid URL to render: " << line;
+      return nullptr;
+    }
+    urls.push_back(url);
+  }
+
+  size_t concurrency = kDefaultBatchConcurrency;
+  if (command_line.HasSwitch(headless::switches::kBatchConcurrency) &&
+      (!base::StringToSizeT(command_line.GetSwitchValueASCII(
+                                headless::switches::kBatchConcurrency),
+                            &concurrency) ||
+       !concurrency)) {
+    LOG(ERROR) << "Invalid batch concurrency";
+    return nullptr;
+  }
+
+  base::FilePath output_dir =
+      command_line.GetSwitchValuePath(headless::switches::kBatchOutputDir);
+  if (!output_dir.empty() && !base::CreateDirectory(output_dir)) {
+    LOG(ERROR) << "Could not create " << output_dir.value();
+    return nullptr;
+  }
+
+  // Have the pages share renderers rather than start one each, unless told
+  // otherwise. More renderers than cores would only compete for them.
+  if (!command_line.HasSwitch(switches::kRendererProcessLimit)) {
+    builder->SetRendererProcessLimit(std::min(
+        concurrency,
+        static_cast<size_t>(base::SysInfo::NumberOfProcessors())));
+  }
+
+  return base::WrapUnique(
+      new HeadlessBatchRenderer(std::move(urls), concurrency, output_dir));
+}
+
 int main(int argc, const char** argv) {
   headless::RunChildProcessIfNeeded(argc, argv);
   HeadlessShell shell;
@@ -334,6 +613,16 @@ int main(int argc, const char** argv) {
         command_line.GetSwitchValueASCII(switches::kHostResolverRules));
   }
 
+  if (command_line.HasSwitch(headless::switches::kBatch)) {
+    std::unique_ptr<HeadlessBatchRenderer> batch_renderer =
+        CreateBatchRenderer(command_line, &builder);
+    if (!batch_renderer)
+      return EXIT_FAILURE;
+    return HeadlessBrowserMain(
+        builder.Build(), base::Bind(&HeadlessBatchRenderer::OnStart,
+                                    base::Unretained(batch_renderer.get())));
+  }
+
   return HeadlessBrowserMain(
       builder.Build(),
       base::Bind(&HeadlessShell::OnStart, base::Unretained(&shell)));
@@ -7,6 +7,18 @@
 namespace headless {
 namespace switches {
 
+// Renders each of the URLs listed, one per line, in the given file and saves
+// a screenshot of every page in --batch-output-dir. Pages are rendered
+// --batch-concurrency at a time and share renderer processes.
+const char kBatch[] = "batch";
+
+// The number of pages rendered at the same time in --batch mode.
+const char kBatchConcurrency[] = "batch-concurrency";
+
+// The directory the screenshots of --batch mode are saved in. Defaults to the
+// current directory.
+const char kBatchOutputDir[] = "batch-output-dir";
+
 // Instructs headless_shell to print document.body.innerHTML to stdout.
 const char kDumpDom[] = "dump-dom";
 
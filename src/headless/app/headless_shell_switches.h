@@ -7,6 +7,9 @@
 
 namespace headless {
 namespace switches {
+extern const char kBatch[];
+extern const char kBatchConcurrency[];
+extern const char kBatchOutputDir[];
 extern const char kDumpDom[];
 extern const char kProxyServer[];
 extern const char kRemoteDebuggingAddress[];
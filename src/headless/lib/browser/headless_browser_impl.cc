@@ -11,6 +11,7 @@
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/public/app/content_main.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/content_switches.h"
 #include "headless/lib/browser/headless_browser_context_impl.h"
@@ -158,6 +159,10 @@ void HeadlessBrowserImpl::DestroyWebContents(
 void HeadlessBrowserImpl::SetOptionsForTesting(
     HeadlessBrowser::Options options) {
   options_ = std::move(options);
+  if (options_.renderer_process_limit) {
+    content::RenderProcessHost::SetMaxRendererProcessCount(
+        options_.renderer_process_limit);
+  }
   browser_main_parts()->default_browser_context()->SetOptionsForTesting(
       &options_);
 }
@@ -5,6 +5,7 @@
 #include "headless/lib/browser/headless_browser_main_parts.h"
 
 #include "components/devtools_http_handler/devtools_http_handler.h"
+#include "content/public/browser/render_process_host.h"
 #include "headless/lib/browser/headless_browser_context_impl.h"
 #include "headless/lib/browser/headless_browser_impl.h"
 #include "headless/lib/browser/headless_devtools.h"
@@ -32,6 +33,10 @@ HeadlessBrowserMainParts::HeadlessBrowserMainParts(HeadlessBrowserImpl* browser)
 HeadlessBrowserMainParts::~HeadlessBrowserMainParts() {}
 
 void HeadlessBrowserMainParts::PreMainMessageLoopRun() {
+  if (browser_->options()->renderer_process_limit) {
+    content::RenderProcessHost::SetMaxRendererProcessCount(
+        browser_->options()->renderer_process_limit);
+  }
   browser_context_.reset(new HeadlessBrowserContextImpl(ProtocolHandlerMap(),
                                                         browser_->options()));
   if (browser_->options()->devtools_endpoint.address().IsValid()) {
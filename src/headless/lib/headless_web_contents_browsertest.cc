@@ -6,7 +6,9 @@
 #include <string>
 #include <vector>
 
+#include "content/public/browser/web_contents.h"
 #include "content/public/test/browser_test.h"
+#include "headless/lib/browser/headless_web_contents_impl.h"
 #include "headless/public/domains/page.h"
 #include "headless/public/headless_browser.h"
 #include "headless/public/headless_devtools_client.h"
@@ -53,6 +55,35 @@ IN_PROC_BROWSER_TEST_F(HeadlessWebContentsTest, WindowOpen) {
   EXPECT_EQ(static_cast<size_t>(2), all_web_contents.size());
 }
 
+IN_PROC_BROWSER_TEST_F(HeadlessWebContentsTest, RendererProcessLimit) {
+  EXPECT_TRUE(embedded_test_server()->Start());
+
+  HeadlessBrowser::Options::Builder builder;
+  builder.SetRendererProcessLimit(1);
+  SetBrowserOptions(builder.Build());
+
+  // Past the limit, new pages reuse the renderer of the earlier ones.
+  HeadlessWebContents* web_contents =
+      browser()
+          ->CreateWebContentsBuilder()
+          .SetInitialURL(embedded_test_server()->GetURL("/hello.html"))
+          .Build();
+  EXPECT_TRUE(WaitForLoad(web_contents));
+  HeadlessWebContents* web_contents2 =
+      browser()
+          ->CreateWebContentsBuilder()
+          .SetInitialURL(embedded_test_server()->GetURL("/hello.html"))
+          .Build();
+  EXPECT_TRUE(WaitForLoad(web_contents2));
+
+  EXPECT_EQ(static_cast<HeadlessWebContentsImpl*>(web_contents)
+                ->web_contents()
+                ->GetRenderProcessHost(),
+            static_cast<HeadlessWebContentsImpl*>(web_contents2)
+                ->web_contents()
+                ->GetRenderProcessHost());
+}
+
 class HeadlessWebContentsScreenshotTest
     : public HeadlessAsyncDevTooledBrowserTest {
  public:
@@ -20,7 +20,8 @@ Options::Options(int argc, const char** argv)
       argv(argv),
       user_agent(content::BuildUserAgentFromProduct(kProductName)),
       message_pump(nullptr),
-      single_process_mode(false) {}
+      single_process_mode(false),
+      renderer_process_limit(0) {}
 
 Options::Options(Options&& options) = default;
 
@@ -64,6 +65,11 @@ Builder& Builder::SetSingleProcessMode(bool single_process_mode) {
   return *this;
 }
 
+Builder& Builder::SetRendererProcessLimit(size_t renderer_process_limit) {
+  options_.renderer_process_limit = renderer_process_limit;
+  return *this;
+}
+
 Builder& Builder::SetProtocolHandlers(ProtocolHandlerMap protocol_handlers) {
   options_.protocol_handlers = std::move(protocol_handlers);
   return *this;
@@ -5,6 +5,8 @@
 #ifndef HEADLESS_PUBLIC_HEADLESS_BROWSER_H_
 #define HEADLESS_PUBLIC_HEADLESS_BROWSER_H_
 
+#include <stddef.h>
+
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -108,6 +110,12 @@ struct HeadlessBrowser::Options {
   // web content, which can be a security risk.
   bool single_process_mode;
 
+  // Maximum number of renderer processes. Once it is reached, new pages share
+  // the already running renderers instead of each starting its own, which
+  // keeps the cost of process startup out of workloads that go through many
+  // pages. Zero, the default, leaves the limit to content.
+  size_t renderer_process_limit;
+
   // Custom network protocol handlers. These can be used to override URL
   // fetching for different network schemes.
   ProtocolHandlerMap protocol_handlers;
@@ -130,6 +138,7 @@ class HeadlessBrowser::Options::Builder {
   Builder& SetProxyServer(const net::HostPortPair& proxy_server);
   Builder& SetHostResolverRules(const std::string& host_resolver_rules);
   Builder& SetSingleProcessMode(bool single_process_mode);
+  Builder& SetRendererProcessLimit(size_t renderer_process_limit);
   Builder& SetProtocolHandlers(ProtocolHandlerMap protocol_handlers);
 
   Options Build();
@@ -106,10 +106,12 @@
         'ipc_channel_unittest.cc',
         'ipc_fuzzing_tests.cc',
         'ipc_message_attachment_set_posix_unittest.cc',
+        'ipc_message_stats_unittest.cc',
         'ipc_message_unittest.cc',
         'ipc_message_utils_unittest.cc',
         'ipc_mojo_bootstrap_unittest.cc',
         'ipc_send_fds_test.cc',
+        'ipc_shared_memory_ring_unittest.cc',
         'ipc_sync_channel_unittest.cc',
         'ipc_sync_message_unittest.cc',
         'ipc_sync_message_unittest.h',
@@ -90,7 +90,16 @@ class IPC_EXPORT Channel : public Endpoint {
     // The client will return the message with hops = 1, *after* it
     // has received the message that contains the FD. When we
     // receive it again on the sender side, we close the FD.
-    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1
+    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1,
+    // The SHARED_MEMORY_RING_MESSAGE_TYPE carries the file descriptor and the
+    // capacity of the shared memory ring which the sender passes the contents
+    // of large messages through. It is sent once per connection, before the
+    // first SHARED_MEMORY_MESSAGE_TYPE.
+    SHARED_MEMORY_RING_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 2,
+    // The SHARED_MEMORY_MESSAGE_TYPE stands for the message written at the
+    // offset and of the size it contains in the shared memory ring. The
+    // receiver handles that message in its place.
+    SHARED_MEMORY_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 3
   };
 
   // The maximum message size in bytes. Attempting to receive a message of this
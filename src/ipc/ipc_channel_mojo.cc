@@ -22,6 +22,7 @@
 #include "ipc/ipc_logging.h"
 #include "ipc/ipc_message_attachment_set.h"
 #include "ipc/ipc_message_macros.h"
+#include "ipc/ipc_message_stats.h"
 #include "ipc/ipc_mojo_bootstrap.h"
 #include "ipc/ipc_mojo_handle_attachment.h"
 #include "mojo/public/cpp/bindings/binding.h"
@@ -356,6 +357,8 @@ void ChannelMojo::OnPipeError() {
 }
 
 bool ChannelMojo::Send(Message* message) {
+  MessageStats::GetInstance()->RecordSend(*message);
+
   bool sent = false;
   {
     base::AutoLock lock(lock_);
@@ -397,6 +400,7 @@ void ChannelMojo::OnMessageReceived(const Message& message) {
   TRACE_EVENT2("ipc,toplevel", "ChannelMojo::OnMessageReceived",
                "class", IPC_MESSAGE_ID_CLASS(message.type()),
                "line", IPC_MESSAGE_ID_LINE(message.type()));
+  MessageStats::GetInstance()->RecordReceive(message);
   if (AttachmentBroker* broker = AttachmentBroker::GetGlobal()) {
     if (broker->OnMessageReceived(message))
       return;
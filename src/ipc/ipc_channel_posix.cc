@@ -51,6 +51,7 @@
 #include "ipc/ipc_message_attachment_set.h"
 #include "ipc/ipc_message_utils.h"
 #include "ipc/ipc_platform_file_attachment_posix.h"
+#include "ipc/ipc_shared_memory_ring.h"
 #include "ipc/ipc_switches.h"
 #include "ipc/unix_domain_socket_util.h"
 
@@ -197,8 +198,15 @@ ChannelPosix::ChannelPosix(const IPC::ChannelHandle& channel_handle,
       waiting_connect_(true),
       message_send_bytes_written_(0),
       pipe_name_(channel_handle.name),
+      use_shared_memory_ring_(false),
       in_dtor_(false),
       must_unlink_(false) {
+  if (base::CommandLine::InitializedForCurrentProcess() &&
+      base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableIPCSharedMemoryRing)) {
+    EnableSharedMemoryRing();
+  }
+
   if (!CreatePipe(channel_handle)) {
     // The pipe may have been closed already.
     const char *modestr = (mode_ & MODE_SERVER_FLAG) ? "server" : "client";
@@ -595,6 +603,10 @@ void ChannelPosix::ResetToAcceptingConnectionState() {
   // Close any outstanding, received file descriptors.
   ClearInputFDs();
 
+  // A new connection gets new rings.
+  output_ring_.reset();
+  input_ring_.reset();
+
 #if defined(OS_MACOSX)
   // Clear any outstanding, sent file descriptors.
   for (std::set<int>::iterator i = fds_to_close_.begin();
@@ -728,6 +740,7 @@ bool ChannelPosix::ProcessMessageForDelivery(Message* message) {
                          TRACE_EVENT_FLAG_FLOW_OUT);
 
   // |output_queue_| takes ownership of |message|.
+  message = MoveToSharedMemoryRing(message);
   OutputElement* element = new OutputElement(message);
   output_queue_.push(element);
 
@@ -823,6 +836,98 @@ int ChannelPosix::GetHelloMessageProcId() const {
 #endif  // defined(OS_NACL_NONSFI)
 }
 
+void ChannelPosix::EnableSharedMemoryRing() {
+#if IPC_USES_SHARED_MEMORY_RING
+  use_shared_memory_ring_ = true;
+#endif
+}
+
+Message* ChannelPosix::MoveToSharedMemoryRing(Message* message) {
+  if (!use_shared_memory_ring_ ||
+      message->size() < kSharedMemoryMessageThreshold ||
+      message->HasAttachments()) {
+    return message;
+  }
+
+  if (!output_ring_ && !CreateOutputRing()) {
+    // Don't try again for every message.
+    use_shared_memory_ring_ = false;
+    return message;
+  }
+
+  // If the message doesn't fit because the peer hasn't read enough of the
+  // ring yet, it is sent over the socket.
+  internal::SharedMemoryRing::Record record;
+  if (!output_ring_->Write(message->data(), message->size(), &record))
+    return message;
+
+  Message* shared_memory_message = new Message(
+      MSG_ROUTING_NONE, SHARED_MEMORY_MESSAGE_TYPE, message->priority());
+  if (!shared_memory_message->WriteUInt32(record.offset) ||
+      !shared_memory_message->WriteUInt32(record.size)) {
+    NOTREACHED() << "Unable to pickle shared memory message.";
+  }
+  delete message;
+  return shared_memory_message;
+}
+
+bool ChannelPosix::CreateOutputRing() {
+#if IPC_USES_SHARED_MEMORY_RING
+  std::unique_ptr<internal::SharedMemoryRing> ring =
+      internal::SharedMemoryRing::Create(kSharedMemoryRingCapacity);
+  if (!ring)
+    return false;
+
+  base::ScopedFD fd(base::SharedMemory::GetFdFromSharedMemoryHandle(
+      ring->ShareHandle()));
+  if (!fd.is_valid())
+    return false;
+
+  std::unique_ptr<Message> msg(new Message(MSG_ROUTING_NONE,
+                                           SHARED_MEMORY_RING_MESSAGE_TYPE,
+                                           IPC::Message::PRIORITY_NORMAL));
+  // Internal messages aren't given their attachments when they're received,
+  // so the descriptor isn't referred to from the payload.
+  if (!msg->WriteUInt32(ring->capacity()) ||
+      !msg->attachment_set()->AddAttachment(
+          new internal::PlatformFileAttachment(std::move(fd)))) {
+    return false;
+  }
+  OutputElement* element = new OutputElement(msg.release());
+  output_queue_.push(element);
+  output_ring_ = std::move(ring);
+  return true;
+#else
+  NOTREACHED();
+  return false;
+#endif  // IPC_USES_SHARED_MEMORY_RING
+}
+
+void ChannelPosix::HandleSharedMemoryRingMessage(const Message& msg) {
+  // The descriptor of the ring wasn't moved to the attachments of |msg|.
+  if (msg.header()->num_fds != 1 || input_fds_.empty()) {
+    LOG(ERROR) << "Shared memory ring message without a descriptor";
+    return;
+  }
+  base::ScopedFD fd(input_fds_.front());
+  input_fds_.erase(input_fds_.begin());
+
+#if IPC_USES_SHARED_MEMORY_RING
+  base::PickleIterator iter(msg);
+  uint32_t capacity;
+  if (!iter.ReadUInt32(&capacity)) {
+    LOG(ERROR) << "Invalid shared memory ring message";
+    return;
+  }
+
+  // The shared memory messages sent through a ring which can't be mapped
+  // will be channel errors.
+  input_ring_ = internal::SharedMemoryRing::Map(
+      base::SharedMemoryHandle(fd.release(), true), capacity);
+  LOG_IF(ERROR, !input_ring_) << "Unable to map shared memory ring";
+#endif  // IPC_USES_SHARED_MEMORY_RING
+}
+
 void ChannelPosix::QueueHelloMessage() {
   // Create the Hello message
   std::unique_ptr<Message> msg(new Message(MSG_ROUTING_NONE, HELLO_MESSAGE_TYPE,
@@ -1044,7 +1149,28 @@ void ChannelPosix::HandleInternalMessage(const Message& msg) {
       }
       break;
 #endif
+
+    case Channel::SHARED_MEMORY_RING_MESSAGE_TYPE:
+      HandleSharedMemoryRingMessage(msg);
+      break;
+  }
+}
+
+bool ChannelPosix::ReadSharedMemoryMessage(const Message& msg,
+                                           std::string* message_data) {
+  if (!input_ring_) {
+    LOG(WARNING) << "Shared memory message without a shared memory ring";
+    return false;
   }
+
+  base::PickleIterator iter(msg);
+  internal::SharedMemoryRing::Record record;
+  if (!iter.ReadUInt32(&record.offset) || !iter.ReadUInt32(&record.size) ||
+      !input_ring_->Read(record, message_data)) {
+    LOG(WARNING) << "Invalid shared memory message";
+    return false;
+  }
+  return true;
 }
 
 base::ProcessId ChannelPosix::GetSenderPID() {
@@ -8,8 +8,10 @@
 #include "ipc/ipc_channel.h"
 
 #include <stddef.h>
+#include <stdint.h>
 #include <sys/socket.h>  // for CMSG macros
 
+#include <memory>
 #include <queue>
 #include <set>
 #include <string>
@@ -23,8 +25,21 @@
 #include "ipc/ipc_channel_reader.h"
 #include "ipc/ipc_message_attachment_set.h"
 
+// Large messages can be passed through a shared memory ring, whose file
+// descriptor is sent over the socket. On Mac, shared memory handles are Mach
+// ports, and nacl_helper_nonsfi can't create shared memory.
+#if !defined(OS_MACOSX) && !defined(OS_NACL_NONSFI)
+#define IPC_USES_SHARED_MEMORY_RING 1
+#else
+#define IPC_USES_SHARED_MEMORY_RING 0
+#endif
+
 namespace IPC {
 
+namespace internal {
+class SharedMemoryRing;
+}  // namespace internal
+
 class IPC_EXPORT ChannelPosix : public Channel,
                                 public internal::ChannelReader,
                                 public base::MessageLoopForIO::Watcher {
@@ -56,6 +71,14 @@ class IPC_EXPORT ChannelPosix : public Channel,
   // for more connections.
   void ResetToAcceptingConnectionState();
 
+  // Makes the channel pass the contents of messages of at least
+  // |kSharedMemoryMessageThreshold| bytes through shared memory instead of
+  // the socket, which saves copying them through the kernel. Messages with
+  // attachments are always sent over the socket. This is also enabled by
+  // the --enable-ipc-shared-memory-ring switch. Receiving such messages is
+  // always supported.
+  void EnableSharedMemoryRing();
+
   // Returns true if the peer process' effective user id can be determined, in
   // which case the supplied peer_euid is updated with it.
   bool GetPeerEuid(uid_t* peer_euid) const;
@@ -87,12 +110,26 @@ class IPC_EXPORT ChannelPosix : public Channel,
   void CloseFileDescriptors(Message* msg);
   void QueueCloseFDMessage(int fd, int hops);
 
+  // If |message| should be passed through the shared memory ring, writes it
+  // there and returns the SHARED_MEMORY_MESSAGE_TYPE message to send in its
+  // place, deleting |message|. Otherwise returns |message|.
+  Message* MoveToSharedMemoryRing(Message* message);
+
+  // Creates |output_ring_| and queues the message which shares it with the
+  // peer. Returns false on failure.
+  bool CreateOutputRing();
+
+  // Maps |input_ring_| from a SHARED_MEMORY_RING_MESSAGE_TYPE message.
+  void HandleSharedMemoryRingMessage(const Message& msg);
+
   // ChannelReader implementation.
   ReadState ReadData(char* buffer, int buffer_len, int* bytes_read) override;
   bool ShouldDispatchInputMessage(Message* msg) override;
   bool GetNonBrokeredAttachments(Message* msg) override;
   bool DidEmptyInputBuffers() override;
   void HandleInternalMessage(const Message& msg) override;
+  bool ReadSharedMemoryMessage(const Message& msg,
+                               std::string* message_data) override;
   base::ProcessId GetSenderPID() override;
   bool IsAttachmentBrokerEndpoint() override;
 
@@ -173,6 +210,15 @@ class IPC_EXPORT ChannelPosix : public Channel,
 
   // We assume a worst case: kReadBufferSize bytes of messages, where each
   // message has no payload and a full complement of descriptors.
+  // Messages of at least this size are passed through the shared memory ring
+  // when it is enabled. Below this, the extra message sent over the socket
+  // costs more than the copies it saves.
+  static const size_t kSharedMemoryMessageThreshold = 16 * 1024;
+
+  // Capacity of the shared memory ring. Larger messages are sent over the
+  // socket.
+  static const uint32_t kSharedMemoryRingCapacity = 2 * 1024 * 1024;
+
   static const size_t kMaxReadFDs =
       (Channel::kReadBufferSize / sizeof(IPC::Message::Header)) *
       MessageAttachmentSet::kMaxDescriptorsPerMessage;
@@ -195,6 +241,15 @@ class IPC_EXPORT ChannelPosix : public Channel,
   // implementation!
   std::vector<int> input_fds_;
 
+  // Whether large messages are sent through |output_ring_|.
+  bool use_shared_memory_ring_;
+
+  // The ring large messages are written to, created when the first one is
+  // sent on a connection.
+  std::unique_ptr<internal::SharedMemoryRing> output_ring_;
+
+  // The ring the peer writes large messages to.
+  std::unique_ptr<internal::SharedMemoryRing> input_ring_;
 
   void ResetSafely(base::ScopedFD* fd);
   bool in_dtor_;
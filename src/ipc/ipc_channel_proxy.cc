@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/compiler_specific.h"
 #include "base/location.h"
 #include "base/memory/ptr_util.h"
@@ -17,11 +18,14 @@
 #include "base/profiler/scoped_tracker.h"
 #include "base/single_thread_task_runner.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "ipc/ipc_channel_factory.h"
 #include "ipc/ipc_listener.h"
 #include "ipc/ipc_logging.h"
 #include "ipc/ipc_message_macros.h"
+#include "ipc/ipc_message_stats.h"
+#include "ipc/ipc_switches.h"
 #include "ipc/message_filter.h"
 #include "ipc/message_filter_router.h"
 
@@ -39,7 +43,10 @@ ChannelProxy::Context::Context(
       channel_send_thread_safe_(false),
       message_filter_router_(new MessageFilterRouter()),
       peer_pid_(base::kNullProcessId),
-      attachment_broker_endpoint_(false) {
+      attachment_broker_endpoint_(false),
+      batched_dispatch_(base::CommandLine::InitializedForCurrentProcess() &&
+                        base::CommandLine::ForCurrentProcess()->HasSwitch(
+                            switches::kEnableIPCBatchedDispatch)) {
   DCHECK(ipc_task_runner_.get());
   // The Listener thread where Messages are handled must be a separate thread
   // to avoid oversubscribing the IO thread. If you trigger this error, you
@@ -79,6 +86,7 @@ bool ChannelProxy::Context::TryFilters(const Message& message) {
 
   if (message_filter_router_->TryFilters(message)) {
     if (message.dispatch_error()) {
+      FlushDispatchBatch();
       listener_task_runner_->PostTask(
           FROM_HERE, base::Bind(&Context::OnDispatchBadMessage, this, message));
     }
@@ -101,11 +109,35 @@ bool ChannelProxy::Context::OnMessageReceived(const Message& message) {
 
 // Called on the IPC::Channel thread
 bool ChannelProxy::Context::OnMessageReceivedNoFilter(const Message& message) {
+  if (batched_dispatch_) {
+    // The channel reads and handles all the messages it can before returning
+    // to the message loop, so this runs once they're all in the batch.
+    if (dispatch_batch_.empty()) {
+      base::ThreadTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::Bind(&Context::FlushDispatchBatch, this));
+    }
+    dispatch_batch_.push_back(base::WrapUnique(new Message(message)));
+    return true;
+  }
+
   listener_task_runner_->PostTask(
       FROM_HERE, base::Bind(&Context::OnDispatchMessage, this, message));
   return true;
 }
 
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::FlushDispatchBatch() {
+  if (dispatch_batch_.empty())
+    return;
+
+  std::unique_ptr<std::vector<std::unique_ptr<Message>>> batch(
+      new std::vector<std::unique_ptr<Message>>);
+  batch->swap(dispatch_batch_);
+  listener_task_runner_->PostTask(
+      FROM_HERE, base::Bind(&Context::OnDispatchMessageBatch, this,
+                            base::Passed(&batch)));
+}
+
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnChannelConnected(int32_t peer_pid) {
   // We cache off the peer_pid so it can be safely accessed from both threads.
@@ -118,6 +150,7 @@ void ChannelProxy::Context::OnChannelConnected(int32_t peer_pid) {
   OnAddFilter();
 
   // See above comment about using listener_task_runner_ here.
+  FlushDispatchBatch();
   listener_task_runner_->PostTask(
       FROM_HERE, base::Bind(&Context::OnDispatchConnected, this));
 }
@@ -128,6 +161,7 @@ void ChannelProxy::Context::OnChannelError() {
     filters_[i]->OnChannelError();
 
   // See above comment about using listener_task_runner_ here.
+  FlushDispatchBatch();
   listener_task_runner_->PostTask(
       FROM_HERE, base::Bind(&Context::OnDispatchError, this));
 }
@@ -281,7 +315,10 @@ void ChannelProxy::Context::OnDispatchMessage(const Message& message) {
     logger->OnPreDispatchMessage(message);
 #endif
 
-  listener_->OnMessageReceived(message);
+  {
+    MessageStats::ScopedDispatch scoped_dispatch(message);
+    listener_->OnMessageReceived(message);
+  }
   if (message.dispatch_error())
     listener_->OnBadMessageReceived(message);
 
@@ -291,6 +328,15 @@ void ChannelProxy::Context::OnDispatchMessage(const Message& message) {
 #endif
 }
 
+// Called on the listener's thread
+void ChannelProxy::Context::OnDispatchMessageBatch(
+    std::unique_ptr<std::vector<std::unique_ptr<Message>>> batch) {
+  TRACE_EVENT1("ipc", "ChannelProxy::Context::OnDispatchMessageBatch",
+               "batch_size", batch->size());
+  for (const std::unique_ptr<Message>& message : *batch)
+    OnDispatchMessage(*message);
+}
+
 // Called on the listener's thread
 void ChannelProxy::Context::OnDispatchConnected() {
   if (channel_connected_called_)
@@ -198,6 +198,12 @@ class IPC_EXPORT ChannelProxy : public Endpoint, public base::NonThreadSafe {
     // Like OnMessageReceived but doesn't try the filters.
     bool OnMessageReceivedNoFilter(const Message& message);
 
+    // Posts the messages in |dispatch_batch_| to the listener thread. Called
+    // on the IPC thread once the messages received by the current read are
+    // handled, and before anything else is posted to the listener thread so
+    // that it stays ordered with the messages.
+    void FlushDispatchBatch();
+
     // Gives the filters a chance at processing |message|.
     // Returns true if the message was processed, false otherwise.
     bool TryFilters(const Message& message);
@@ -234,6 +240,8 @@ class IPC_EXPORT ChannelProxy : public Endpoint, public base::NonThreadSafe {
     void OnDispatchConnected();
     void OnDispatchError();
     void OnDispatchBadMessage(const Message& message);
+    void OnDispatchMessageBatch(
+        std::unique_ptr<std::vector<std::unique_ptr<Message>>> batch);
 
     void SendFromThisThread(Message* message);
     void ClearChannel();
@@ -277,6 +285,17 @@ class IPC_EXPORT ChannelProxy : public Endpoint, public base::NonThreadSafe {
     // Whether this channel is used as an endpoint for sending and receiving
     // brokerable attachment messages to/from the broker process.
     bool attachment_broker_endpoint_;
+
+    // Whether the messages which aren't handled by a filter are dispatched to
+    // the listener in one task per read from the channel, instead of one task
+    // per message. Set by the --enable-ipc-batched-dispatch switch. The order
+    // of the messages is kept, as is the order with the bad message, connected
+    // and error notifications, but tasks posted to the listener thread by
+    // filters may now run before messages which were received earlier.
+    const bool batched_dispatch_;
+
+    // Messages received on the IPC thread and waiting for FlushDispatchBatch().
+    std::vector<std::unique_ptr<Message>> dispatch_batch_;
   };
 
   Context* context() { return context_.get(); }
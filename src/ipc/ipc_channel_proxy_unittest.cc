@@ -10,8 +10,10 @@
 
 #include "base/pickle.h"
 #include "base/run_loop.h"
+#include "base/test/scoped_command_line.h"
 #include "base/threading/thread.h"
 #include "ipc/ipc_message.h"
+#include "ipc/ipc_switches.h"
 #include "ipc/ipc_test_base.h"
 #include "ipc/message_filter.h"
 
@@ -50,10 +52,14 @@ namespace {
 
 class QuitListener : public IPC::Listener {
  public:
-  QuitListener() : bad_message_received_(false) {}
+  QuitListener()
+      : bad_message_received_(false),
+        bounces_received_(0),
+        bounces_received_before_quit_(-1) {}
 
   bool OnMessageReceived(const IPC::Message& message) override {
     IPC_BEGIN_MESSAGE_MAP(QuitListener, message)
+      IPC_MESSAGE_HANDLER(WorkerMsg_Bounce, OnBounce)
       IPC_MESSAGE_HANDLER(WorkerMsg_Quit, OnQuit)
       IPC_MESSAGE_HANDLER(TestMsg_BadMessage, OnBadMessage)
     IPC_END_MESSAGE_MAP()
@@ -64,7 +70,12 @@ class QuitListener : public IPC::Listener {
     bad_message_received_ = true;
   }
 
+  void OnBounce() {
+    ++bounces_received_;
+  }
+
   void OnQuit() {
+    bounces_received_before_quit_ = bounces_received_;
     base::MessageLoop::current()->QuitWhenIdle();
   }
 
@@ -74,6 +85,8 @@ class QuitListener : public IPC::Listener {
   }
 
   bool bad_message_received_;
+  int bounces_received_;
+  int bounces_received_before_quit_;
 };
 
 class ChannelReflectorListener : public IPC::Listener {
@@ -269,6 +282,10 @@ class IPCChannelProxyTest : public IPCTestBase {
     return listener_->bad_message_received_;
   }
 
+  int GetListenerBouncesBeforeQuit() {
+    return listener_->bounces_received_before_quit_;
+  }
+
  private:
   std::unique_ptr<base::Thread> thread_;
   std::unique_ptr<QuitListener> listener_;
@@ -353,6 +370,37 @@ TEST_F(IPCChannelProxyTest, FilterRemoval) {
   EXPECT_EQ(0U, global_filter->messages_received());
 }
 
+class IPCChannelProxyBatchedDispatchTest : public IPCChannelProxyTest {
+ public:
+  void SetUp() override {
+    scoped_command_line_.GetProcessCommandLine()->AppendSwitch(
+        switches::kEnableIPCBatchedDispatch);
+    IPCChannelProxyTest::SetUp();
+  }
+
+ private:
+  base::test::ScopedCommandLine scoped_command_line_;
+};
+
+TEST_F(IPCChannelProxyBatchedDispatchTest, MessagesStayOrdered) {
+  scoped_refptr<MessageCountFilter> class_filter(
+      new MessageCountFilter(TestMsgStart));
+  class_filter->set_message_filtering_enabled(true);
+  channel_proxy()->AddFilter(class_filter.get());
+
+  // The client bounces the messages back in bursts, which are dispatched in
+  // batches. The test messages are handled by the filter only.
+  const int kBounces = 100;
+  for (int i = 0; i < kBounces; ++i) {
+    sender()->Send(new WorkerMsg_Bounce());
+    sender()->Send(new TestMsg_Bounce());
+  }
+
+  SendQuitMessageAndWaitForIdle();
+  EXPECT_EQ(kBounces, GetListenerBouncesBeforeQuit());
+  EXPECT_EQ(static_cast<size_t>(kBounces), class_filter->messages_received());
+}
+
 // The test that follow trigger DCHECKS in debug build.
 #if defined(NDEBUG) && !defined(DCHECK_ALWAYS_ON)
 
@@ -81,7 +81,7 @@ ChannelReader::DispatchState ChannelReader::AsyncReadComplete(int bytes_read) {
 
 bool ChannelReader::IsInternalMessage(const Message& m) {
   return m.routing_id() == MSG_ROUTING_NONE &&
-      m.type() >= Channel::CLOSE_FD_MESSAGE_TYPE &&
+      m.type() >= Channel::SHARED_MEMORY_MESSAGE_TYPE &&
       m.type() <= Channel::HELLO_MESSAGE_TYPE;
 }
 
@@ -189,6 +189,11 @@ bool ChannelReader::TranslateInputData(const char* input_data,
 bool ChannelReader::HandleTranslatedMessage(
     Message* translated_message,
     const AttachmentIdVector& attachment_ids) {
+  if (translated_message->routing_id() == MSG_ROUTING_NONE &&
+      translated_message->type() == Channel::SHARED_MEMORY_MESSAGE_TYPE) {
+    return HandleSharedMemoryMessage(*translated_message);
+  }
+
   // Immediately handle internal messages.
   if (IsInternalMessage(*translated_message)) {
     EMIT_TRACE_EVENT(*translated_message);
@@ -212,6 +217,38 @@ bool ChannelReader::HandleTranslatedMessage(
   return HandleExternalMessage(translated_message, attachment_ids);
 }
 
+bool ChannelReader::HandleSharedMemoryMessage(const Message& msg) {
+  std::string message_data;
+  if (!ReadSharedMemoryMessage(msg, &message_data))
+    return false;
+
+  // The data must hold exactly one message. Messages with attachments and
+  // shared memory messages are never passed through shared memory.
+  const char* start = message_data.data();
+  const char* end = start + message_data.size();
+  Message::NextMessageInfo info;
+  Message::FindNext(start, end, &info);
+  if (!info.message_found || info.message_end != end ||
+      !info.attachment_ids.empty()) {
+    return false;
+  }
+  Message message(start, static_cast<int>(info.pickle_end - start));
+  if (message.header()->num_fds != 0 ||
+      (message.routing_id() == MSG_ROUTING_NONE &&
+       message.type() == Channel::SHARED_MEMORY_MESSAGE_TYPE)) {
+    return false;
+  }
+
+  // |message| only refers to |message_data|, HandleExternalMessage() makes a
+  // copy if it needs to queue it.
+  return HandleTranslatedMessage(&message, AttachmentIdVector());
+}
+
+bool ChannelReader::ReadSharedMemoryMessage(const Message& msg,
+                                            std::string* message_data) {
+  return false;
+}
+
 bool ChannelReader::HandleExternalMessage(
     Message* external_message,
     const AttachmentIdVector& attachment_ids) {
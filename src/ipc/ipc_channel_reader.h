@@ -8,6 +8,7 @@
 #include <stddef.h>
 
 #include <set>
+#include <string>
 
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
@@ -114,6 +115,13 @@ class IPC_EXPORT ChannelReader : public SupportsAttachmentBrokering,
   // Handles internal messages, like the hello message sent on channel startup.
   virtual void HandleInternalMessage(const Message& msg) = 0;
 
+  // Copies the data of the message which |msg|, a SHARED_MEMORY_MESSAGE_TYPE
+  // message, stands for to |message_data|. Returns false on failure, which is
+  // a fatal channel error. Channels which don't pass messages through shared
+  // memory don't need to override this.
+  virtual bool ReadSharedMemoryMessage(const Message& msg,
+                                       std::string* message_data);
+
   // Exposed for testing purposes only.
   ScopedVector<Message>* get_queued_messages() { return &queued_messages_; }
 
@@ -148,6 +156,11 @@ class IPC_EXPORT ChannelReader : public SupportsAttachmentBrokering,
   bool HandleTranslatedMessage(Message* translated_message,
                                const AttachmentIdVector& attachment_ids);
 
+  // Handles the message which the SHARED_MEMORY_MESSAGE_TYPE message |msg|
+  // stands for as if it had been read from the channel.
+  // Returns |false| on unrecoverable error.
+  bool HandleSharedMemoryMessage(const Message& msg);
+
   // Populates the message with brokered and non-brokered attachments. If
   // possible, the message is immediately dispatched. Otherwise, a deep copy of
   // the message is added to |queued_messages_|. |blocked_ids_| are updated if
@@ -0,0 +1,216 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ipc/ipc_message_stats.h"
+
+#include <utility>
+
+#include "base/atomicops.h"
+#include "base/command_line.h"
+#include "base/json/json_writer.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/singleton.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_argument.h"
+#include "base/values.h"
+#include "ipc/ipc_message.h"
+#include "ipc/ipc_message_macros.h"
+#include "ipc/ipc_switches.h"
+
+namespace IPC {
+
+namespace {
+
+const char kTraceCategory[] = TRACE_DISABLED_BY_DEFAULT("ipc.stats");
+
+enum EnabledState {
+  ENABLED_STATE_UNKNOWN = 0,
+  ENABLED_STATE_OFF,
+  ENABLED_STATE_ON,
+};
+
+// Caches whether --enable-ipc-message-stats was given. Racing initializations
+// all compute the same value, so no lock is needed.
+base::subtle::Atomic32 g_enabled_state = ENABLED_STATE_UNKNOWN;
+
+bool IsEnabledByCommandLine() {
+  base::subtle::Atomic32 state = base::subtle::NoBarrier_Load(&g_enabled_state);
+  if (state == ENABLED_STATE_UNKNOWN) {
+    state = base::CommandLine::InitializedForCurrentProcess() &&
+                    base::CommandLine::ForCurrentProcess()->HasSwitch(
+                        switches::kEnableIPCMessageStats)
+                ? ENABLED_STATE_ON
+                : ENABLED_STATE_OFF;
+    base::subtle::NoBarrier_Store(&g_enabled_state, state);
+  }
+  return state == ENABLED_STATE_ON;
+}
+
+}  // namespace
+
+MessageStats::Entry::Entry()
+    : type(0),
+      sent_count(0),
+      sent_bytes(0),
+      received_count(0),
+      received_bytes(0),
+      dispatch_count(0),
+      sync_send_count(0) {}
+
+MessageStats::ScopedDispatch::ScopedDispatch(const Message& message)
+    : type_(message.type()),
+      start_time_(MessageStats::IsEnabled() ? base::TimeTicks::Now()
+                                            : base::TimeTicks()) {}
+
+MessageStats::ScopedDispatch::~ScopedDispatch() {
+  if (start_time_.is_null())
+    return;
+  MessageStats::GetInstance()->RecordDispatch(
+      type_, base::TimeTicks::Now() - start_time_);
+}
+
+// static
+MessageStats* MessageStats::GetInstance() {
+  return base::Singleton<MessageStats>::get();
+}
+
+// static
+bool MessageStats::IsEnabled() {
+  if (IsEnabledByCommandLine())
+    return true;
+  bool tracing_enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(kTraceCategory, &tracing_enabled);
+  return tracing_enabled;
+}
+
+void MessageStats::RecordSend(const Message& message) {
+  if (!IsEnabled())
+    return;
+  base::AutoLock lock(lock_);
+  Entry* entry = GetEntryLocked(message.type());
+  entry->sent_count++;
+  entry->sent_bytes += message.size();
+  MaybeTraceEntry(*entry, entry->sent_count);
+}
+
+void MessageStats::RecordReceive(const Message& message) {
+  if (!IsEnabled())
+    return;
+  base::AutoLock lock(lock_);
+  Entry* entry = GetEntryLocked(message.type());
+  entry->received_count++;
+  entry->received_bytes += message.size();
+  MaybeTraceEntry(*entry, entry->received_count);
+}
+
+void MessageStats::RecordDispatch(uint32_t type, base::TimeDelta duration) {
+  base::AutoLock lock(lock_);
+  Entry* entry = GetEntryLocked(type);
+  entry->dispatch_count++;
+  entry->dispatch_time += duration;
+}
+
+void MessageStats::RecordSyncSend(uint32_t type, base::TimeDelta blocked_time) {
+  if (!IsEnabled())
+    return;
+  base::AutoLock lock(lock_);
+  Entry* entry = GetEntryLocked(type);
+  entry->sync_send_count++;
+  entry->sync_blocked_time += blocked_time;
+}
+
+void MessageStats::GetEntries(std::vector<Entry>* entries) const {
+  base::AutoLock lock(lock_);
+  entries->clear();
+  entries->reserve(entries_.size());
+  for (const auto& entry : entries_)
+    entries->push_back(entry.second);
+}
+
+std::unique_ptr<base::DictionaryValue> MessageStats::AsValue() const {
+  std::vector<Entry> entries;
+  GetEntries(&entries);
+
+  std::unique_ptr<base::ListValue> messages(new base::ListValue);
+  for (const Entry& entry : entries) {
+    std::unique_ptr<base::DictionaryValue> message(new base::DictionaryValue);
+    message->SetInteger("class", IPC_MESSAGE_ID_CLASS(entry.type));
+    message->SetInteger("line", IPC_MESSAGE_ID_LINE(entry.type));
+    // Values are doubles so that large counts survive the JSON round trip.
+    message->SetDouble("sent_count", static_cast<double>(entry.sent_count));
+    message->SetDouble("sent_bytes", static_cast<double>(entry.sent_bytes));
+    message->SetDouble("received_count",
+                       static_cast<double>(entry.received_count));
+    message->SetDouble("received_bytes",
+                       static_cast<double>(entry.received_bytes));
+    message->SetDouble("dispatch_count",
+                       static_cast<double>(entry.dispatch_count));
+    message->SetDouble("dispatch_time_ms",
+                       entry.dispatch_time.InMillisecondsF());
+    message->SetDouble("sync_send_count",
+                       static_cast<double>(entry.sync_send_count));
+    message->SetDouble("sync_blocked_time_ms",
+                       entry.sync_blocked_time.InMillisecondsF());
+    messages->Append(std::move(message));
+  }
+
+  std::unique_ptr<base::DictionaryValue> value(new base::DictionaryValue);
+  value->Set("messages", std::move(messages));
+  return value;
+}
+
+std::string MessageStats::AsJSON() const {
+  std::string json;
+  base::JSONWriter::Write(*AsValue(), &json);
+  return json;
+}
+
+void MessageStats::Reset() {
+  base::AutoLock lock(lock_);
+  entries_.clear();
+}
+
+void MessageStats::SetEnabledForTesting(bool enabled) {
+  base::subtle::NoBarrier_Store(
+      &g_enabled_state, enabled ? ENABLED_STATE_ON : ENABLED_STATE_OFF);
+}
+
+MessageStats::MessageStats() {}
+
+MessageStats::~MessageStats() {}
+
+MessageStats::Entry* MessageStats::GetEntryLocked(uint32_t type) {
+  lock_.AssertAcquired();
+  Entry* entry = &entries_[type];
+  entry->type = type;
+  return entry;
+}
+
+// static
+void MessageStats::MaybeTraceEntry(const Entry& entry, uint64_t count) {
+  if (count % kTraceSampleInterval != 0)
+    return;
+  bool tracing_enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(kTraceCategory, &tracing_enabled);
+  if (!tracing_enabled)
+    return;
+
+  std::unique_ptr<base::trace_event::TracedValue> value(
+      new base::trace_event::TracedValue);
+  value->SetInteger("class", IPC_MESSAGE_ID_CLASS(entry.type));
+  value->SetInteger("line", IPC_MESSAGE_ID_LINE(entry.type));
+  value->SetDouble("sent_count", static_cast<double>(entry.sent_count));
+  value->SetDouble("sent_bytes", static_cast<double>(entry.sent_bytes));
+  value->SetDouble("received_count",
+                   static_cast<double>(entry.received_count));
+  value->SetDouble("received_bytes",
+                   static_cast<double>(entry.received_bytes));
+  value->SetDouble("dispatch_time_ms", entry.dispatch_time.InMillisecondsF());
+  value->SetDouble("sync_blocked_time_ms",
+                   entry.sync_blocked_time.InMillisecondsF());
+  TRACE_EVENT_INSTANT1(kTraceCategory, "IPC::MessageStats",
+                       TRACE_EVENT_SCOPE_THREAD, "stats", std::move(value));
+}
+
+}  // namespace IPC
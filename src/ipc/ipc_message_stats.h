@@ -0,0 +1,129 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef IPC_IPC_MESSAGE_STATS_H_
+#define IPC_IPC_MESSAGE_STATS_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "ipc/ipc_export.h"
+
+namespace base {
+class DictionaryValue;
+template <typename T> struct DefaultSingletonTraits;
+}
+
+namespace IPC {
+
+class Message;
+
+// Keeps process-wide counts of the IPC messages sent, received and dispatched
+// by each message type, along with their total size and the time spent
+// dispatching them. Unlike IPC::Logging this is available in release builds,
+// so that the chattiest messages can be found in the field.
+//
+// Collection is off unless the process was started with
+// --enable-ipc-message-stats, or the "disabled-by-default-ipc.stats" tracing
+// category is enabled. In the latter case every kTraceSampleInterval-th
+// message of each type also emits a trace event with the running totals for
+// that type.
+class IPC_EXPORT MessageStats {
+ public:
+  // The totals for one message type.
+  struct IPC_EXPORT Entry {
+    Entry();
+
+    uint32_t type;
+    uint64_t sent_count;
+    uint64_t sent_bytes;
+    uint64_t received_count;
+    uint64_t received_bytes;
+    uint64_t dispatch_count;
+    base::TimeDelta dispatch_time;
+    // Sync messages of this type sent, and the time the senders were blocked
+    // waiting for their replies.
+    uint64_t sync_send_count;
+    base::TimeDelta sync_blocked_time;
+  };
+
+  // Records the time spent dispatching a message in its scope.
+  class IPC_EXPORT ScopedDispatch {
+   public:
+    explicit ScopedDispatch(const Message& message);
+    ~ScopedDispatch();
+
+   private:
+    const uint32_t type_;
+    const base::TimeTicks start_time_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedDispatch);
+  };
+
+  static const uint64_t kTraceSampleInterval = 64;
+
+  static MessageStats* GetInstance();
+
+  // Returns whether messages should be recorded. This is cheap enough to call
+  // for every message.
+  static bool IsEnabled();
+
+  // Called by channels when |message| is sent or received. Does nothing if
+  // collection is disabled.
+  void RecordSend(const Message& message);
+  void RecordReceive(const Message& message);
+
+  // Adds |duration| to the dispatch time of messages of |type|.
+  void RecordDispatch(uint32_t type, base::TimeDelta duration);
+
+  // Adds |blocked_time| to the time spent waiting for replies to sync
+  // messages of |type|. Does nothing if collection is disabled.
+  void RecordSyncSend(uint32_t type, base::TimeDelta blocked_time);
+
+  // Fills |entries| with the totals for every message type seen so far,
+  // ordered by type.
+  void GetEntries(std::vector<Entry>* entries) const;
+
+  // Returns the totals as a dictionary holding a "messages" list, with the
+  // class and line of each type split out as in IPC_MESSAGE_ID_CLASS() and
+  // IPC_MESSAGE_ID_LINE().
+  std::unique_ptr<base::DictionaryValue> AsValue() const;
+
+  // Returns AsValue() serialized to JSON, for dumping from a debug page or a
+  // test.
+  std::string AsJSON() const;
+
+  void Reset();
+
+  // Forces collection on or off regardless of the command line. For tests.
+  void SetEnabledForTesting(bool enabled);
+
+ private:
+  friend struct base::DefaultSingletonTraits<MessageStats>;
+
+  MessageStats();
+  ~MessageStats();
+
+  // Returns the entry for |type|, adding it if needed. |lock_| must be held.
+  Entry* GetEntryLocked(uint32_t type);
+
+  // Emits a trace event with the totals in |entry| if it is sampled.
+  static void MaybeTraceEntry(const Entry& entry, uint64_t count);
+
+  mutable base::Lock lock_;
+  std::map<uint32_t, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(MessageStats);
+};
+
+}  // namespace IPC
+
+#endif  // IPC_IPC_MESSAGE_STATS_H_
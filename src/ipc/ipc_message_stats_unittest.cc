@@ -0,0 +1,123 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ipc/ipc_message_stats.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/json/json_reader.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "ipc/ipc_message.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace IPC {
+namespace {
+
+const uint32_t kTypeA = (1 << 16) | 1;
+const uint32_t kTypeB = (2 << 16) | 7;
+
+class MessageStatsTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    stats_ = MessageStats::GetInstance();
+    stats_->SetEnabledForTesting(true);
+    stats_->Reset();
+  }
+
+  void TearDown() override {
+    stats_->Reset();
+    stats_->SetEnabledForTesting(false);
+  }
+
+  static std::unique_ptr<Message> CreateMessage(uint32_t type,
+                                                size_t payload_size) {
+    std::unique_ptr<Message> message(
+        new Message(MSG_ROUTING_CONTROL, type, Message::PRIORITY_NORMAL));
+    message->WriteString(std::string(payload_size, 'x'));
+    return message;
+  }
+
+  MessageStats* stats_;
+};
+
+TEST_F(MessageStatsTest, RecordsPerType) {
+  std::unique_ptr<Message> a = CreateMessage(kTypeA, 100);
+  std::unique_ptr<Message> b = CreateMessage(kTypeB, 10);
+
+  stats_->RecordSend(*a);
+  stats_->RecordSend(*a);
+  stats_->RecordReceive(*b);
+  stats_->RecordDispatch(kTypeB, base::TimeDelta::FromMilliseconds(3));
+
+  std::vector<MessageStats::Entry> entries;
+  stats_->GetEntries(&entries);
+  ASSERT_EQ(2u, entries.size());
+
+  EXPECT_EQ(kTypeA, entries[0].type);
+  EXPECT_EQ(2u, entries[0].sent_count);
+  EXPECT_EQ(2 * a->size(), entries[0].sent_bytes);
+  EXPECT_EQ(0u, entries[0].received_count);
+
+  EXPECT_EQ(kTypeB, entries[1].type);
+  EXPECT_EQ(0u, entries[1].sent_count);
+  EXPECT_EQ(1u, entries[1].received_count);
+  EXPECT_EQ(b->size(), entries[1].received_bytes);
+  EXPECT_EQ(1u, entries[1].dispatch_count);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(3), entries[1].dispatch_time);
+}
+
+TEST_F(MessageStatsTest, ScopedDispatch) {
+  std::unique_ptr<Message> a = CreateMessage(kTypeA, 0);
+  { MessageStats::ScopedDispatch scoped_dispatch(*a); }
+
+  std::vector<MessageStats::Entry> entries;
+  stats_->GetEntries(&entries);
+  ASSERT_EQ(1u, entries.size());
+  EXPECT_EQ(1u, entries[0].dispatch_count);
+}
+
+TEST_F(MessageStatsTest, Disabled) {
+  stats_->SetEnabledForTesting(false);
+  std::unique_ptr<Message> a = CreateMessage(kTypeA, 0);
+  stats_->RecordSend(*a);
+  stats_->RecordReceive(*a);
+  { MessageStats::ScopedDispatch scoped_dispatch(*a); }
+
+  std::vector<MessageStats::Entry> entries;
+  stats_->GetEntries(&entries);
+  EXPECT_TRUE(entries.empty());
+}
+
+TEST_F(MessageStatsTest, AsJSON) {
+  std::unique_ptr<Message> b = CreateMessage(kTypeB, 10);
+  stats_->RecordSend(*b);
+
+  std::unique_ptr<base::Value> value = base::JSONReader::Read(stats_->AsJSON());
+  ASSERT_TRUE(value);
+  base::DictionaryValue* dict;
+  ASSERT_TRUE(value->GetAsDictionary(&dict));
+  base::ListValue* messages;
+  ASSERT_TRUE(dict->GetList("messages", &messages));
+  ASSERT_EQ(1u, messages->GetSize());
+
+  base::DictionaryValue* message;
+  ASSERT_TRUE(messages->GetDictionary(0, &message));
+  int message_class;
+  int line;
+  double sent_bytes;
+  EXPECT_TRUE(message->GetInteger("class", &message_class));
+  EXPECT_TRUE(message->GetInteger("line", &line));
+  EXPECT_TRUE(message->GetDouble("sent_bytes", &sent_bytes));
+  EXPECT_EQ(2, message_class);
+  EXPECT_EQ(7, line);
+  EXPECT_EQ(static_cast<double>(b->size()), sent_bytes);
+}
+
+}  // namespace
+}  // namespace IPC
@@ -6,6 +6,7 @@
 #define IPC_IPC_MESSAGE_TEMPLATES_IMPL_H_
 
 #include <tuple>
+#include <type_traits>
 
 namespace IPC {
 
@@ -22,11 +23,28 @@ class ParamDeserializer : public MessageReplyDeserializer {
   std::tuple<Ts&...> out_;
 };
 
+// Writes the parameters of a message, sizing them first if any of their types
+// asks for it (see PresizesMessage). Only the presizing overload needs the
+// parameters to define GetSize().
+template <typename... Ts>
+void WriteMessageParams(Message* msg,
+                        const std::tuple<const Ts&...>& p,
+                        std::false_type presize) {
+  WriteParam(msg, p);
+}
+
+template <typename... Ts>
+void WriteMessageParams(Message* msg,
+                        const std::tuple<const Ts&...>& p,
+                        std::true_type presize) {
+  WriteParamPresized(msg, p);
+}
+
 template <typename Meta, typename... Ins>
 MessageT<Meta, std::tuple<Ins...>, void>::MessageT(Routing routing,
                                                     const Ins&... ins)
     : Message(routing.id, ID, PRIORITY_NORMAL) {
-  WriteParam(this, std::tie(ins...));
+  WriteMessageParams(this, std::tie(ins...), AnyPresizesMessage<Ins...>());
 }
 
 template <typename Meta, typename... Ins>
@@ -59,7 +77,7 @@ MessageT<Meta, std::tuple<Ins...>, std::tuple<Outs...>>::MessageT(
           ID,
           PRIORITY_NORMAL,
           new ParamDeserializer<Outs...>(std::tie(*outs...))) {
-  WriteParam(this, std::tie(ins...));
+  WriteMessageParams(this, std::tie(ins...), AnyPresizesMessage<Ins...>());
 }
 
 template <typename Meta, typename... Ins, typename... Outs>
@@ -83,7 +101,7 @@ void MessageT<Meta,
               std::tuple<Ins...>,
               std::tuple<Outs...>>::WriteReplyParams(Message* reply,
                                                       const Outs&... outs) {
-  WriteParam(reply, std::tie(outs...));
+  WriteMessageParams(reply, std::tie(outs...), AnyPresizesMessage<Outs...>());
 }
 
 template <typename Meta, typename... Ins, typename... Outs>
@@ -10,6 +10,8 @@
 
 #include <limits>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
@@ -18,6 +20,37 @@
 #include "ipc/ipc_message_utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+
+// A large parameter whose messages are sized before they are written.
+struct PresizedStrings {
+  std::vector<std::string> strings;
+};
+
+}  // namespace
+
+namespace IPC {
+
+template <>
+struct ParamTraits<PresizedStrings> {
+  typedef PresizedStrings param_type;
+  static const bool kPresizeMessage = true;
+  static void GetSize(base::PickleSizer* sizer, const param_type& p) {
+    GetParamSize(sizer, p.strings);
+  }
+  static void Write(base::Pickle* m, const param_type& p) {
+    WriteParam(m, p.strings);
+  }
+  static bool Read(const base::Pickle* m,
+                   base::PickleIterator* iter,
+                   param_type* r) {
+    return ReadParam(m, iter, &r->strings);
+  }
+  static void Log(const param_type& p, std::string* l) {}
+};
+
+}  // namespace IPC
+
 // IPC messages for testing ----------------------------------------------------
 
 #define IPC_MESSAGE_IMPL
@@ -31,6 +64,10 @@ IPC_MESSAGE_CONTROL1(TestMsgClassI, int)
 
 IPC_SYNC_MESSAGE_CONTROL1_1(TestMsgClassIS, int, std::string)
 
+IPC_MESSAGE_CONTROL1(TestMsgClassStrings, std::vector<std::string>)
+
+IPC_MESSAGE_CONTROL2(TestMsgClassPresized, int, PresizedStrings)
+
 namespace IPC {
 
 TEST(IPCMessageTest, BasicMessageTest) {
@@ -214,6 +251,31 @@ TEST(IPCMessageTest, FindNextOverflow) {
 #endif
 }
 
+TEST(IPCMessageTest, PresizedParams) {
+  static_assert(!AnyPresizesMessage<int, std::vector<std::string>>::value,
+                "vectors of strings are not presized");
+  static_assert(AnyPresizesMessage<int, PresizedStrings>::value,
+                "PresizedStrings is presized");
+
+  PresizedStrings param;
+  for (int i = 0; i < 100; ++i)
+    param.strings.push_back(std::string(1000, 'a' + i % 26));
+
+  // The presized message is allocated at its final size, rounded up to the
+  // 64 byte unit pickles grow by.
+  TestMsgClassPresized presized(42, param);
+  EXPECT_LT(presized.GetTotalAllocatedSize(), presized.size() + 64);
+
+  TestMsgClassStrings plain(param.strings);
+  EXPECT_EQ(plain.payload_size() + sizeof(int), presized.payload_size());
+  EXPECT_LT(presized.GetTotalAllocatedSize(), plain.GetTotalAllocatedSize());
+
+  TestMsgClassPresized::Param read;
+  ASSERT_TRUE(TestMsgClassPresized::Read(&presized, &read));
+  EXPECT_EQ(42, std::get<0>(read));
+  EXPECT_EQ(param.strings, std::get<1>(read).strings);
+}
+
 namespace {
 
 class IPCMessageParameterTest : public testing::Test {
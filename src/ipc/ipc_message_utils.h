@@ -15,6 +15,7 @@
 #include <set>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "base/containers/small_map.h"
@@ -118,6 +119,49 @@ static inline void LogParam(const P& p, std::string* l) {
   ParamTraits<Type>::Log(static_cast<const Type& >(p), l);
 }
 
+// Writes |p| after reserving exactly the space GetParamSize() reports for it,
+// so that the pickle is grown once instead of doubling repeatedly as |p| is
+// written. ParamTraits<P> must define GetSize(); for IPC_STRUCT types that
+// means the message generator has to include ipc/param_traits_size_macros.h.
+template <class P>
+static inline void WriteParamPresized(base::Pickle* m, const P& p) {
+  base::PickleSizer sizer;
+  GetParamSize(&sizer, p);
+  m->Reserve(sizer.payload_size());
+  WriteParam(m, p);
+}
+
+// Messages are written into a buffer that doubles as it fills. The ParamTraits
+// of a type that is routinely tens of kilobytes can declare
+//
+//   static const bool kPresizeMessage = true;
+//
+// so that messages carrying it are written with WriteParamPresized(). Every
+// parameter of such a message then needs a GetSize() definition.
+template <class P>
+struct PresizesMessage {
+ private:
+  typedef typename SimilarTypeTraits<P>::Type Type;
+
+  template <class T>
+  static std::integral_constant<bool, ParamTraits<T>::kPresizeMessage> Test(
+      int);
+  template <class T>
+  static std::false_type Test(...);
+
+ public:
+  static const bool value = decltype(Test<Type>(0))::value;
+};
+
+template <class... Ps>
+struct AnyPresizesMessage : std::false_type {};
+
+template <class P, class... Ps>
+struct AnyPresizesMessage<P, Ps...>
+    : std::integral_constant<bool,
+                             PresizesMessage<P>::value ||
+                                 AnyPresizesMessage<Ps...>::value> {};
+
 // Primitive ParamTraits -------------------------------------------------------
 
 template <>
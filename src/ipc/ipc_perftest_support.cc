@@ -245,6 +245,16 @@ IPCChannelPerfTestBase::GetDefaultTestParams() {
   return list;
 }
 
+// static
+std::vector<PingPongTestParams>
+IPCChannelPerfTestBase::GetLargeMessageTestParams() {
+  std::vector<PingPongTestParams> list;
+  list.push_back(PingPongTestParams(65536, 5000));
+  list.push_back(PingPongTestParams(248832, 1000));
+  list.push_back(PingPongTestParams(1048576, 250));
+  return list;
+}
+
 void IPCChannelPerfTestBase::RunTestChannelPingPong(
     const std::vector<PingPongTestParams>& params) {
   Init("PerformanceClient");
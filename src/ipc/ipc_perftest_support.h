@@ -42,6 +42,10 @@ class IPCChannelPerfTestBase : public IPCTestBase {
 
   static std::vector<PingPongTestParams> GetDefaultTestParams();
 
+  // Returns parameters for messages large enough to be passed through shared
+  // memory when the channel supports it.
+  static std::vector<PingPongTestParams> GetLargeMessageTestParams();
+
   void RunTestChannelPingPong(
       const std::vector<PingPongTestParams>& params_list);
   void RunTestChannelProxyPingPong(
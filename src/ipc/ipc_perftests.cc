@@ -2,7 +2,20 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "base/test/scoped_command_line.h"
+#include "build/build_config.h"
+#include "ipc/ipc_message.h"
+#include "ipc/ipc_message_utils.h"
 #include "ipc/ipc_perftest_support.h"
+#include "ipc/ipc_switches.h"
 
 namespace {
 
@@ -17,10 +30,61 @@ TEST_F(IPCChannelPerfTest, ChannelPingPong) {
   RunTestChannelPingPong(GetDefaultTestParams());
 }
 
+TEST_F(IPCChannelPerfTest, ChannelPingPongLargeMessages) {
+  RunTestChannelPingPong(GetLargeMessageTestParams());
+}
+
+#if defined(OS_POSIX) && !defined(OS_MACOSX)
+// Same as ChannelPingPongLargeMessages, with the messages passed through a
+// shared memory ring. The client inherits the command line.
+TEST_F(IPCChannelPerfTest, ChannelPingPongSharedMemoryRing) {
+  base::test::ScopedCommandLine scoped_command_line;
+  scoped_command_line.GetProcessCommandLine()->AppendSwitch(
+      switches::kEnableIPCSharedMemoryRing);
+  RunTestChannelPingPong(GetLargeMessageTestParams());
+}
+#endif
+
 TEST_F(IPCChannelPerfTest, ChannelProxyPingPong) {
   RunTestChannelProxyPingPong(GetDefaultTestParams());
 }
 
+// Times writing a large parameter into messages, with and without reserving
+// its size first, and logs the bytes each message ends up allocating.
+TEST(IPCMessagePerfTest, PresizedWrite) {
+  const int kIterations = 10000;
+  const std::vector<std::string> strings(200, std::string(500, 'x'));
+
+  size_t plain_bytes = 0;
+  {
+    base::PerfTimeLogger logger("IPC_Message_Write_Plain");
+    for (int i = 0; i < kIterations; ++i) {
+      IPC::Message message(0, 2, IPC::Message::PRIORITY_NORMAL);
+      IPC::WriteParam(&message, strings);
+      plain_bytes = message.GetTotalAllocatedSize();
+    }
+  }
+
+  size_t presized_bytes = 0;
+  size_t message_size = 0;
+  {
+    base::PerfTimeLogger logger("IPC_Message_Write_Presized");
+    for (int i = 0; i < kIterations; ++i) {
+      IPC::Message message(0, 2, IPC::Message::PRIORITY_NORMAL);
+      IPC::WriteParamPresized(&message, strings);
+      presized_bytes = message.GetTotalAllocatedSize();
+      message_size = message.size();
+    }
+  }
+
+  base::LogPerfResult("IPC_Message_Allocated_Plain", plain_bytes, "bytes");
+  base::LogPerfResult("IPC_Message_Allocated_Presized", presized_bytes,
+                      "bytes");
+  // The presized message is allocated once, rounded up to a 64 byte unit.
+  EXPECT_LT(presized_bytes, message_size + 64);
+  EXPECT_LT(presized_bytes, plain_bytes);
+}
+
 MULTIPROCESS_IPC_TEST_CLIENT_MAIN(PerformanceClient) {
   IPC::test::PingPongTestClient client;
   return client.RunMain();
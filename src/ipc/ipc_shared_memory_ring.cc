@@ -0,0 +1,164 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ipc/ipc_shared_memory_ring.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "build/build_config.h"
+
+namespace IPC {
+namespace internal {
+
+namespace {
+
+// Rings are at most 1GB. This keeps offsets and sizes well within uint32_t.
+const uint32_t kMaximumCapacity = 1u << 30;
+
+bool IsValidCapacity(uint32_t capacity) {
+  return capacity > 0 && capacity <= kMaximumCapacity &&
+         (capacity & (capacity - 1)) == 0;
+}
+
+}  // namespace
+
+// The start of the shared memory, followed by the ring. Only the consumer
+// writes to it.
+struct SharedMemoryRing::Header {
+  // Position up to which the consumer has read the ring.
+  base::subtle::Atomic32 read_position;
+  // Keeps the ring on its own cache line.
+  char padding[60];
+};
+
+SharedMemoryRing::~SharedMemoryRing() {}
+
+// static
+std::unique_ptr<SharedMemoryRing> SharedMemoryRing::Create(uint32_t capacity) {
+  if (!IsValidCapacity(capacity))
+    return nullptr;
+
+  // Anonymous shared memory is zero initialized, i.e. the ring is empty.
+  std::unique_ptr<base::SharedMemory> shared_memory(new base::SharedMemory);
+  if (!shared_memory->CreateAndMapAnonymous(GetMappedSize(capacity)))
+    return nullptr;
+  return std::unique_ptr<SharedMemoryRing>(
+      new SharedMemoryRing(std::move(shared_memory), capacity));
+}
+
+// static
+std::unique_ptr<SharedMemoryRing> SharedMemoryRing::Map(
+    const base::SharedMemoryHandle& handle,
+    uint32_t capacity) {
+  std::unique_ptr<base::SharedMemory> shared_memory(
+      new base::SharedMemory(handle, false));
+  if (!IsValidCapacity(capacity))
+    return nullptr;
+
+#if defined(OS_POSIX) && !defined(OS_ANDROID)
+  // Mapping more than the size of the memory would succeed, but accessing
+  // the part past its end would crash. Ashmem refuses such mappings.
+  size_t size = 0;
+  if (!base::SharedMemory::GetSizeFromSharedMemoryHandle(handle, &size) ||
+      size < GetMappedSize(capacity)) {
+    return nullptr;
+  }
+#endif
+
+  if (!shared_memory->Map(GetMappedSize(capacity)))
+    return nullptr;
+  return std::unique_ptr<SharedMemoryRing>(
+      new SharedMemoryRing(std::move(shared_memory), capacity));
+}
+
+// static
+size_t SharedMemoryRing::GetMappedSize(uint32_t capacity) {
+  static_assert(sizeof(Header) == 64, "the ring should start on a cache line");
+  return sizeof(Header) + capacity;
+}
+
+bool SharedMemoryRing::Write(const void* data, uint32_t size, Record* record) {
+  if (size == 0 || size > capacity_)
+    return false;
+
+  uint32_t padding = 0;
+  const uint32_t offset = GetRecordOffset(size, &padding);
+
+  // The space between the read position and |position_| is in use. The
+  // consumer may have corrupted the read position, in which case nothing
+  // more is written.
+  const uint32_t read_position = static_cast<uint32_t>(
+      base::subtle::Acquire_Load(&header()->read_position));
+  const uint32_t used = position_ - read_position;
+  if (used > capacity_ || capacity_ - used < padding + size)
+    return false;
+
+  // The consumer only reads the record after it receives |record| through
+  // the channel, which orders this write before that read.
+  memcpy(this->data() + offset, data, size);
+  position_ += padding + size;
+
+  record->offset = offset;
+  record->size = size;
+  return true;
+}
+
+bool SharedMemoryRing::Read(const Record& record, std::string* data) {
+  if (record.size == 0 || record.size > capacity_)
+    return false;
+
+  uint32_t padding = 0;
+  const uint32_t offset = GetRecordOffset(record.size, &padding);
+  if (record.offset != offset)
+    return false;
+
+  data->assign(this->data() + offset, record.size);
+  position_ += padding + record.size;
+  base::subtle::Release_Store(&header()->read_position,
+                              static_cast<base::subtle::Atomic32>(position_));
+  return true;
+}
+
+base::SharedMemoryHandle SharedMemoryRing::ShareHandle() const {
+  return base::SharedMemory::DuplicateHandle(shared_memory_->handle());
+}
+
+SharedMemoryRing::SharedMemoryRing(
+    std::unique_ptr<base::SharedMemory> shared_memory,
+    uint32_t capacity)
+    : shared_memory_(std::move(shared_memory)),
+      capacity_(capacity),
+      position_(0) {
+  DCHECK(IsValidCapacity(capacity_));
+  DCHECK(shared_memory_->memory());
+}
+
+uint32_t SharedMemoryRing::GetRecordOffset(uint32_t size,
+                                           uint32_t* padding) const {
+  DCHECK_LE(size, capacity_);
+  const uint32_t offset = position_ & (capacity_ - 1);
+  if (size > capacity_ - offset) {
+    // Records are never split, so there is no need to copy them to a
+    // contiguous buffer when they're read.
+    *padding = capacity_ - offset;
+    return 0;
+  }
+  *padding = 0;
+  return offset;
+}
+
+SharedMemoryRing::Header* SharedMemoryRing::header() const {
+  return static_cast<Header*>(shared_memory_->memory());
+}
+
+char* SharedMemoryRing::data() const {
+  return static_cast<char*>(shared_memory_->memory()) + sizeof(Header);
+}
+
+}  // namespace internal
+}  // namespace IPC
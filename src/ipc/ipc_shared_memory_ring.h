@@ -0,0 +1,103 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef IPC_IPC_SHARED_MEMORY_RING_H_
+#define IPC_IPC_SHARED_MEMORY_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/memory/shared_memory.h"
+#include "ipc/ipc_export.h"
+
+namespace IPC {
+namespace internal {
+
+// A single producer, single consumer ring buffer in shared memory, which
+// channels use to pass the contents of large messages without copying them
+// through the socket. The producer writes a record to the ring and sends
+// the Record describing it to the consumer over the channel; the consumer
+// copies the record out and marks its space as free again. Since records are
+// read in the order they are written, only the read position needs to be
+// shared.
+//
+// The consumer doesn't trust the producer: any Record it is given is checked
+// against the bounds of the ring, and the contents are copied out before they
+// are used, so the producer changing them afterwards has no effect.
+class IPC_EXPORT SharedMemoryRing {
+ public:
+  // Describes a record written to the ring.
+  struct Record {
+    // Offset of the record in the ring.
+    uint32_t offset;
+    // Size of the record in bytes.
+    uint32_t size;
+  };
+
+  ~SharedMemoryRing();
+
+  // Creates the producer end of a ring of |capacity| bytes, which must be a
+  // power of two. Returns null on failure.
+  static std::unique_ptr<SharedMemoryRing> Create(uint32_t capacity);
+
+  // Maps the consumer end of the ring shared through |handle|, which takes
+  // ownership of it. Returns null if |capacity| isn't a power of two or the
+  // memory can't be mapped.
+  static std::unique_ptr<SharedMemoryRing> Map(
+      const base::SharedMemoryHandle& handle,
+      uint32_t capacity);
+
+  // Returns the size of the shared memory needed by a ring of |capacity|
+  // bytes.
+  static size_t GetMappedSize(uint32_t capacity);
+
+  // Producer: copies |size| bytes from |data| to the ring, and fills in
+  // |record|. Returns false if there isn't enough free space, in which case
+  // nothing is written.
+  bool Write(const void* data, uint32_t size, Record* record);
+
+  // Consumer: copies the contents of |record| to |data| and frees its space.
+  // Returns false if |record| isn't where the next record can be, or if it is
+  // out of the bounds of the ring.
+  bool Read(const Record& record, std::string* data);
+
+  // Producer: returns a duplicate of the handle of the shared memory, to send
+  // to the consumer.
+  base::SharedMemoryHandle ShareHandle() const;
+
+  uint32_t capacity() const { return capacity_; }
+
+ private:
+  struct Header;
+
+  // Returns the offset of a record of |size| bytes written at |position_|,
+  // and sets |padding| to the number of bytes skipped at the end of the ring
+  // so that it isn't split.
+  uint32_t GetRecordOffset(uint32_t size, uint32_t* padding) const;
+
+  SharedMemoryRing(std::unique_ptr<base::SharedMemory> shared_memory,
+                   uint32_t capacity);
+
+  Header* header() const;
+  char* data() const;
+
+  std::unique_ptr<base::SharedMemory> shared_memory_;
+  const uint32_t capacity_;
+
+  // The position the next record is written at by the producer, or read from
+  // by the consumer. Positions increase monotonically and wrap around at 2^32,
+  // the offset in the ring is the position modulo |capacity_|.
+  uint32_t position_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemoryRing);
+};
+
+}  // namespace internal
+}  // namespace IPC
+
+#endif  // IPC_IPC_SHARED_MEMORY_RING_H_
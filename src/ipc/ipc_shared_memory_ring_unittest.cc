@@ -0,0 +1,117 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ipc/ipc_shared_memory_ring.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace IPC {
+namespace internal {
+namespace {
+
+const uint32_t kCapacity = 4096;
+
+class SharedMemoryRingTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    producer_ = SharedMemoryRing::Create(kCapacity);
+    ASSERT_TRUE(producer_);
+    consumer_ = SharedMemoryRing::Map(producer_->ShareHandle(), kCapacity);
+    ASSERT_TRUE(consumer_);
+  }
+
+  // Writes |data| and reads it back.
+  void WriteAndRead(const std::string& data, uint32_t expected_offset) {
+    SharedMemoryRing::Record record;
+    ASSERT_TRUE(producer_->Write(data.data(), data.size(), &record));
+    EXPECT_EQ(expected_offset, record.offset);
+    EXPECT_EQ(data.size(), record.size);
+
+    std::string read_data;
+    ASSERT_TRUE(consumer_->Read(record, &read_data));
+    EXPECT_EQ(data, read_data);
+  }
+
+  std::unique_ptr<SharedMemoryRing> producer_;
+  std::unique_ptr<SharedMemoryRing> consumer_;
+};
+
+TEST_F(SharedMemoryRingTest, WriteAndRead) {
+  WriteAndRead(std::string(100, 'a'), 0);
+  WriteAndRead(std::string(200, 'b'), 100);
+  WriteAndRead(std::string(kCapacity - 300, 'c'), 300);
+  WriteAndRead(std::string(kCapacity, 'd'), 0);
+}
+
+TEST_F(SharedMemoryRingTest, RecordsAreNotSplit) {
+  WriteAndRead(std::string(kCapacity - 100, 'a'), 0);
+  // Doesn't fit in the last 100 bytes, so it is written at the start.
+  WriteAndRead(std::string(200, 'b'), 0);
+  WriteAndRead(std::string(100, 'c'), 200);
+}
+
+TEST_F(SharedMemoryRingTest, Full) {
+  const std::string data(kCapacity / 4, 'a');
+  SharedMemoryRing::Record records[4];
+  for (SharedMemoryRing::Record& record : records)
+    ASSERT_TRUE(producer_->Write(data.data(), data.size(), &record));
+
+  SharedMemoryRing::Record record;
+  EXPECT_FALSE(producer_->Write(data.data(), 1, &record));
+
+  // Reading a record frees its space.
+  std::string read_data;
+  ASSERT_TRUE(consumer_->Read(records[0], &read_data));
+  ASSERT_TRUE(producer_->Write(data.data(), data.size(), &record));
+  EXPECT_EQ(0u, record.offset);
+  EXPECT_FALSE(producer_->Write(data.data(), 1, &record));
+}
+
+TEST_F(SharedMemoryRingTest, TooLarge) {
+  const std::string data(kCapacity + 1, 'a');
+  SharedMemoryRing::Record record;
+  EXPECT_FALSE(producer_->Write(data.data(), data.size(), &record));
+  EXPECT_FALSE(producer_->Write(data.data(), 0, &record));
+}
+
+TEST_F(SharedMemoryRingTest, InvalidRecord) {
+  const std::string data(100, 'a');
+  SharedMemoryRing::Record record;
+  ASSERT_TRUE(producer_->Write(data.data(), data.size(), &record));
+
+  std::string read_data;
+  SharedMemoryRing::Record invalid_record = {1, 100};
+  EXPECT_FALSE(consumer_->Read(invalid_record, &read_data));
+  invalid_record = {0, kCapacity + 1};
+  EXPECT_FALSE(consumer_->Read(invalid_record, &read_data));
+  invalid_record = {0, 0};
+  EXPECT_FALSE(consumer_->Read(invalid_record, &read_data));
+
+  // Invalid records are ignored.
+  ASSERT_TRUE(consumer_->Read(record, &read_data));
+  EXPECT_EQ(data, read_data);
+}
+
+TEST(SharedMemoryRingCreateTest, InvalidCapacity) {
+  EXPECT_FALSE(SharedMemoryRing::Create(0));
+  EXPECT_FALSE(SharedMemoryRing::Create(3000));
+  EXPECT_FALSE(SharedMemoryRing::Create(1u << 31));
+}
+
+TEST(SharedMemoryRingCreateTest, MapLargerThanShared) {
+  std::unique_ptr<SharedMemoryRing> producer =
+      SharedMemoryRing::Create(kCapacity);
+  ASSERT_TRUE(producer);
+  EXPECT_FALSE(SharedMemoryRing::Map(producer->ShareHandle(), kCapacity * 2));
+  EXPECT_FALSE(SharedMemoryRing::Map(producer->ShareHandle(), 3000));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace IPC
@@ -15,5 +15,21 @@ namespace switches {
 // IPC channel the browser expects to use to communicate with it.
 const char kProcessChannelID[]              = "channel";
 
+// Makes IPC channels pass large messages through shared memory, see
+// IPC::ChannelPosix::EnableSharedMemoryRing().
+const char kEnableIPCSharedMemoryRing[]     = "enable-ipc-shared-memory-ring";
+
+// Makes IPC::ChannelProxy dispatch the messages received by one read from the
+// channel in a single task on the listener thread.
+const char kEnableIPCBatchedDispatch[]      = "enable-ipc-batched-dispatch";
+
+// Makes IPC channels keep per message type counts, sizes and dispatch times,
+// see IPC::MessageStats.
+const char kEnableIPCMessageStats[]        = "enable-ipc-message-stats";
+
+// Logs and traces sync IPC messages sent inside an
+// IPC::SyncChannel::ScopedSyncAudit, e.g. during frame production.
+const char kEnableIPCSyncAudit[]           = "enable-ipc-sync-audit";
+
 }  // namespace switches
 
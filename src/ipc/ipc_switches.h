@@ -12,6 +12,10 @@
 namespace switches {
 
 IPC_EXPORT extern const char kProcessChannelID[];
+IPC_EXPORT extern const char kEnableIPCSharedMemoryRing[];
+IPC_EXPORT extern const char kEnableIPCBatchedDispatch[];
+IPC_EXPORT extern const char kEnableIPCMessageStats[];
+IPC_EXPORT extern const char kEnableIPCSyncAudit[];
 
 }  // namespace switches
 
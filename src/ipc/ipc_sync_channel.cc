@@ -10,10 +10,13 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/lazy_instance.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/metrics/sparse_histogram.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/synchronization/waitable_event_watcher.h"
 #include "base/threading/thread_local.h"
@@ -22,6 +25,8 @@
 #include "ipc/ipc_channel_factory.h"
 #include "ipc/ipc_logging.h"
 #include "ipc/ipc_message_macros.h"
+#include "ipc/ipc_message_stats.h"
+#include "ipc/ipc_switches.h"
 #include "ipc/ipc_sync_message.h"
 
 using base::TimeDelta;
@@ -471,6 +476,54 @@ scoped_refptr<SyncMessageFilter> SyncChannel::CreateSyncMessageFilter() {
   return filter;
 }
 
+namespace {
+
+// Sync sends blocked for longer than this, about a frame at 60Hz, have their
+// message type recorded so that the worst offenders can be found.
+const int kLongSyncSendThresholdMs = 16;
+
+base::LazyInstance<base::ThreadLocalBoolean>::Leaky g_sync_audit_active =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Records the time a sync send of |type| blocked the sending thread.
+void RecordSyncSendBlockedTime(uint32_t type, base::TimeDelta blocked_time) {
+  UMA_HISTOGRAM_TIMES("IPC.SyncSend.BlockedTime", blocked_time);
+  if (blocked_time.InMilliseconds() >= kLongSyncSendThresholdMs)
+    UMA_HISTOGRAM_SPARSE_SLOWLY("IPC.SyncSend.LongBlockMessageType", type);
+  MessageStats::GetInstance()->RecordSyncSend(type, blocked_time);
+
+  if (!SyncChannel::ScopedSyncAudit::IsActive())
+    return;
+  UMA_HISTOGRAM_SPARSE_SLOWLY("IPC.SyncSend.AuditedMessageType", type);
+  if (!base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableIPCSyncAudit)) {
+    return;
+  }
+  TRACE_EVENT_INSTANT2("ipc", "SyncChannel::AuditedSend",
+                       TRACE_EVENT_SCOPE_THREAD,
+                       "type", type,
+                       "blocked_time_ms", blocked_time.InMillisecondsF());
+  LOG(WARNING) << "Sync IPC " << IPC_MESSAGE_ID_CLASS(type) << ":"
+               << IPC_MESSAGE_ID_LINE(type) << " blocked an audited scope for "
+               << blocked_time.InMillisecondsF() << " ms";
+}
+
+}  // namespace
+
+SyncChannel::ScopedSyncAudit::ScopedSyncAudit()
+    : was_active_(g_sync_audit_active.Get().Get()) {
+  g_sync_audit_active.Get().Set(true);
+}
+
+SyncChannel::ScopedSyncAudit::~ScopedSyncAudit() {
+  g_sync_audit_active.Get().Set(was_active_);
+}
+
+// static
+bool SyncChannel::ScopedSyncAudit::IsActive() {
+  return g_sync_audit_active.Get().Get();
+}
+
 bool SyncChannel::Send(Message* message) {
 #ifdef IPC_MESSAGE_LOG_ENABLED
   std::string name;
@@ -497,12 +550,15 @@ bool SyncChannel::Send(Message* message) {
   SyncMessage* sync_msg = static_cast<SyncMessage*>(message);
   context->Push(sync_msg);
   WaitableEvent* pump_messages_event = sync_msg->pump_messages_event();
+  const uint32_t type = message->type();
+  const TimeTicks send_time = TimeTicks::Now();
 
   ChannelProxy::Send(message);
 
   // Wait for reply, or for any other incoming synchronous messages.
   // *this* might get deleted, so only call static functions at this point.
   WaitForReply(context.get(), pump_messages_event);
+  RecordSyncSendBlockedTime(type, TimeTicks::Now() - send_time);
 
   TRACE_EVENT_FLOW_END0(TRACE_DISABLED_BY_DEFAULT("ipc.flow"),
                         "SyncChannel::Send", context->GetSendDoneEvent());
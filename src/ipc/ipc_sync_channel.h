@@ -68,6 +68,25 @@ class IPC_EXPORT SyncChannel : public ChannelProxy {
     kRestrictDispatchGroup_None = 0,
   };
 
+  // Marks a latency critical section on the current thread, such as frame
+  // production on the renderer main thread. Sync messages sent from inside
+  // one are counted in UMA, and with --enable-ipc-sync-audit they are also
+  // logged and traced, so the worst stalls can be tracked down. Scopes may
+  // nest.
+  class IPC_EXPORT ScopedSyncAudit {
+   public:
+    ScopedSyncAudit();
+    ~ScopedSyncAudit();
+
+    // Returns whether the current thread is in a ScopedSyncAudit.
+    static bool IsActive();
+
+   private:
+    const bool was_active_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedSyncAudit);
+  };
+
   // Creates and initializes a sync channel. If create_pipe_now is specified,
   // the channel will be initialized synchronously.
   // The naming pattern follows IPC::Channel.
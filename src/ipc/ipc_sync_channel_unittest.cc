@@ -25,6 +25,7 @@
 #include "build/build_config.h"
 #include "ipc/ipc_listener.h"
 #include "ipc/ipc_message.h"
+#include "ipc/ipc_message_stats.h"
 #include "ipc/ipc_sender.h"
 #include "ipc/ipc_sync_message_filter.h"
 #include "ipc/ipc_sync_message_unittest.h"
@@ -322,8 +323,10 @@ void Simple(bool pump_during_send) {
 
 #if defined(OS_ANDROID)
 #define MAYBE_Simple DISABLED_Simple
+#define MAYBE_SyncSendStats DISABLED_SyncSendStats
 #else
 #define MAYBE_Simple Simple
+#define MAYBE_SyncSendStats SyncSendStats
 #endif
 // Tests basic synchronous call
 TEST_F(IPCSyncChannelTest, MAYBE_Simple) {
@@ -331,6 +334,43 @@ TEST_F(IPCSyncChannelTest, MAYBE_Simple) {
   Simple(true);
 }
 
+// Tests that the time blocked on a sync call is recorded for its type.
+TEST_F(IPCSyncChannelTest, MAYBE_SyncSendStats) {
+  MessageStats* stats = MessageStats::GetInstance();
+  stats->SetEnabledForTesting(true);
+  stats->Reset();
+
+  Simple(false);
+
+  std::vector<MessageStats::Entry> entries;
+  stats->GetEntries(&entries);
+  bool found = false;
+  for (const MessageStats::Entry& entry : entries) {
+    if (entry.type != SyncChannelTestMsg_AnswerToLife::ID)
+      continue;
+    found = true;
+    EXPECT_EQ(1u, entry.sync_send_count);
+  }
+  EXPECT_TRUE(found);
+
+  stats->Reset();
+  stats->SetEnabledForTesting(false);
+}
+
+TEST_F(IPCSyncChannelTest, ScopedSyncAudit) {
+  EXPECT_FALSE(SyncChannel::ScopedSyncAudit::IsActive());
+  {
+    SyncChannel::ScopedSyncAudit outer;
+    EXPECT_TRUE(SyncChannel::ScopedSyncAudit::IsActive());
+    {
+      SyncChannel::ScopedSyncAudit inner;
+      EXPECT_TRUE(SyncChannel::ScopedSyncAudit::IsActive());
+    }
+    EXPECT_TRUE(SyncChannel::ScopedSyncAudit::IsActive());
+  }
+  EXPECT_FALSE(SyncChannel::ScopedSyncAudit::IsActive());
+}
+
 //------------------------------------------------------------------------------
 
 // Worker classes which override how the sync channel is created to use the
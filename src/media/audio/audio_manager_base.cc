@@ -14,6 +14,7 @@
 #include "build/build_config.h"
 #include "media/audio/audio_device_description.h"
 #include "media/audio/audio_output_dispatcher_impl.h"
+#include "media/audio/audio_output_mixer.h"
 #include "media/audio/audio_output_proxy.h"
 #include "media/audio/audio_output_resampler.h"
 #include "media/audio/fake_audio_input_stream.h"
@@ -254,7 +255,12 @@ AudioOutputStream* AudioManagerBase::MakeAudioOutputStreamProxy(
   const base::TimeDelta kCloseDelay =
       base::TimeDelta::FromSeconds(kStreamCloseDelaySeconds);
   scoped_refptr<AudioOutputDispatcher> dispatcher;
-  if (output_params.format() != AudioParameters::AUDIO_FAKE) {
+  if (output_params.format() != AudioParameters::AUDIO_FAKE &&
+      base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableAudioOutputMixer)) {
+    dispatcher = new AudioOutputMixer(this, params, output_params,
+                                      output_device_id, kCloseDelay);
+  } else if (output_params.format() != AudioParameters::AUDIO_FAKE) {
     dispatcher = new AudioOutputResampler(this, params, output_params,
                                           output_device_id,
                                           kCloseDelay);
@@ -0,0 +1,248 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/audio/audio_output_mixer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/single_thread_task_runner.h"
+#include "media/audio/audio_manager.h"
+#include "media/audio/audio_output_proxy.h"
+#include "media/base/audio_bus.h"
+
+namespace media {
+
+// The AudioConverter input of a playing proxy.
+class AudioOutputMixer::MixerInput : public AudioConverter::InputCallback {
+ public:
+  MixerInput(AudioOutputStream::AudioSourceCallback* source_callback,
+             double volume,
+             const AudioParameters& input_params,
+             const AudioParameters& output_params,
+             const uint32_t* current_total_bytes_delay)
+      : source_callback_(source_callback),
+        volume_(volume),
+        io_ratio_(static_cast<double>(input_params.GetBytesPerSecond()) /
+                  output_params.GetBytesPerSecond()),
+        input_bytes_per_frame_(input_params.GetBytesPerFrame()),
+        current_total_bytes_delay_(current_total_bytes_delay) {}
+  ~MixerInput() override {}
+
+  AudioOutputStream::AudioSourceCallback* source_callback() const {
+    return source_callback_;
+  }
+
+  void set_volume(double volume) { volume_ = volume; }
+
+  // AudioConverter::InputCallback implementation.
+  double ProvideInput(AudioBus* dest, uint32_t frames_delayed) override {
+    // |current_total_bytes_delay_| is in bytes of the output and
+    // |frames_delayed| in frames of the input.
+    const uint32_t total_bytes_delay = base::saturated_cast<uint32_t>(
+        io_ratio_ * *current_total_bytes_delay_ +
+        frames_delayed * input_bytes_per_frame_);
+    const int frames =
+        source_callback_->OnMoreData(dest, total_bytes_delay, 0);
+
+    // Zero any unfilled frames if anything was filled, otherwise we'll just
+    // return a volume of zero and let AudioConverter drop the output.
+    if (frames > 0 && frames < dest->frames())
+      dest->ZeroFramesPartial(frames, dest->frames() - frames);
+    return frames > 0 ? volume_ : 0;
+  }
+
+ private:
+  AudioOutputStream::AudioSourceCallback* const source_callback_;
+  double volume_;
+
+  // Ratio of input bytes to output bytes, to convert the output delay.
+  const double io_ratio_;
+  const int input_bytes_per_frame_;
+
+  // Owned by the AudioOutputMixer, only read while holding its lock.
+  const uint32_t* const current_total_bytes_delay_;
+
+  DISALLOW_COPY_AND_ASSIGN(MixerInput);
+};
+
+AudioOutputMixer::AudioOutputMixer(AudioManager* audio_manager,
+                                   const AudioParameters& input_params,
+                                   const AudioParameters& output_params,
+                                   const std::string& output_device_id,
+                                   const base::TimeDelta& close_delay)
+    : AudioOutputDispatcher(audio_manager, input_params, output_device_id),
+      output_params_(output_params),
+      open_proxies_(0),
+      physical_stream_(nullptr),
+      close_timer_(FROM_HERE,
+                   close_delay,
+                   this,
+                   &AudioOutputMixer::ClosePhysicalStreamIfUnused),
+      current_total_bytes_delay_(0),
+      audio_converter_(input_params, output_params, false),
+      audio_log_(
+          audio_manager->CreateAudioLog(AudioLogFactory::AUDIO_OUTPUT_STREAM)) {
+  DCHECK(input_params.IsValid());
+  DCHECK(output_params.IsValid());
+}
+
+AudioOutputMixer::~AudioOutputMixer() {
+  CHECK_EQ(open_proxies_, 0u);
+  CHECK(inputs_.empty());
+  CHECK(!physical_stream_);
+}
+
+bool AudioOutputMixer::OpenStream() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  if (!physical_stream_) {
+    AudioOutputStream* stream = audio_manager_->MakeAudioOutputStream(
+        output_params_, device_id_,
+        base::Bind(&AudioLog::OnLogMessage, base::Unretained(audio_log_.get()),
+                   0));
+    if (!stream)
+      return false;
+
+    if (!stream->Open()) {
+      stream->Close();
+      return false;
+    }
+
+    // The volume of each proxy is applied while mixing.
+    stream->SetVolume(1.0);
+    audio_log_->OnCreated(0, output_params_, device_id_);
+    physical_stream_ = stream;
+  }
+
+  ++open_proxies_;
+  close_timer_.Reset();
+  return true;
+}
+
+bool AudioOutputMixer::StartStream(
+    AudioOutputStream::AudioSourceCallback* callback,
+    AudioOutputProxy* stream_proxy) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  DCHECK(inputs_.find(stream_proxy) == inputs_.end());
+  DCHECK(physical_stream_);
+
+  double volume = 0;
+  stream_proxy->GetVolume(&volume);
+  std::unique_ptr<MixerInput> input(new MixerInput(
+      callback, volume, params_, output_params_, &current_total_bytes_delay_));
+
+  const bool start_physical_stream = inputs_.empty();
+  {
+    base::AutoLock auto_lock(lock_);
+    audio_converter_.AddInput(input.get());
+    inputs_[stream_proxy] = std::move(input);
+  }
+
+  if (start_physical_stream) {
+    physical_stream_->Start(this);
+    audio_log_->OnStarted(0);
+  }
+  return true;
+}
+
+void AudioOutputMixer::StopStream(AudioOutputProxy* stream_proxy) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  InputMap::iterator it = inputs_.find(stream_proxy);
+  if (it == inputs_.end())
+    return;
+
+  // Stop the physical stream before removing the last input, so that
+  // OnMoreData() isn't called anymore.  It can't be done while holding
+  // |lock_| since OnMoreData() may be waiting for it.
+  if (inputs_.size() == 1) {
+    physical_stream_->Stop();
+    audio_log_->OnStopped(0);
+  }
+
+  base::AutoLock auto_lock(lock_);
+  audio_converter_.RemoveInput(it->second.get());
+  inputs_.erase(it);
+}
+
+void AudioOutputMixer::StreamVolumeSet(AudioOutputProxy* stream_proxy,
+                                       double volume) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  InputMap::iterator it = inputs_.find(stream_proxy);
+  if (it != inputs_.end()) {
+    base::AutoLock auto_lock(lock_);
+    it->second->set_volume(volume);
+  }
+}
+
+void AudioOutputMixer::CloseStream(AudioOutputProxy* stream_proxy) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  DCHECK_GT(open_proxies_, 0u);
+  --open_proxies_;
+
+  // Keep the physical stream open until the close timer fires, to help cycle
+  // time when streams are opened and closed repeatedly.
+  close_timer_.Reset();
+}
+
+void AudioOutputMixer::Shutdown() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  // No AudioOutputProxy objects should hold a reference to us when we get
+  // to this stage.
+  DCHECK(HasOneRef()) << "Only the AudioManager should hold a reference";
+
+  LOG_IF(WARNING, open_proxies_ > 0u) << "Open proxy streams during shutdown: "
+                                      << open_proxies_;
+  LOG_IF(WARNING, !inputs_.empty()) << "Active proxy streams during shutdown: "
+                                    << inputs_.size();
+
+  if (!inputs_.empty()) {
+    physical_stream_->Stop();
+    base::AutoLock auto_lock(lock_);
+    for (const auto& input : inputs_)
+      audio_converter_.RemoveInput(input.second.get());
+    inputs_.clear();
+  }
+  ClosePhysicalStream();
+}
+
+int AudioOutputMixer::OnMoreData(AudioBus* dest,
+                                 uint32_t total_bytes_delay,
+                                 uint32_t frames_skipped) {
+  base::AutoLock auto_lock(lock_);
+  current_total_bytes_delay_ = total_bytes_delay;
+  audio_converter_.Convert(dest);
+
+  // Always return the full number of frames requested, the inputs pad with
+  // silence if they weren't able to provide enough data.
+  return dest->frames();
+}
+
+void AudioOutputMixer::OnError(AudioOutputStream* stream) {
+  base::AutoLock auto_lock(lock_);
+  for (const auto& input : inputs_)
+    input.second->source_callback()->OnError(stream);
+}
+
+void AudioOutputMixer::ClosePhysicalStreamIfUnused() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  if (open_proxies_ == 0)
+    ClosePhysicalStream();
+}
+
+void AudioOutputMixer::ClosePhysicalStream() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  DCHECK(inputs_.empty());
+  if (!physical_stream_)
+    return;
+
+  physical_stream_->Close();
+  audio_log_->OnClosed(0);
+  physical_stream_ = nullptr;
+}
+
+}  // namespace media
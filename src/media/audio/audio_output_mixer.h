@@ -0,0 +1,112 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// AudioOutputMixer is an implementation of AudioOutputDispatcher which plays
+// all of its proxies through a single physical output stream.
+//
+// The audio of the playing proxies is mixed by one AudioConverter, so however
+// many proxies play there is one resampler and one physical stream for each
+// set of input parameters, instead of one of each per proxy as with
+// AudioOutputResampler.  This matters for pages playing several short sounds
+// at once and for audio devices which only support a few streams.
+//
+// As AudioOutputDispatcherImpl does, the mixer keeps its physical stream open
+// for |close_delay| after the last proxy is closed.
+
+#ifndef MEDIA_AUDIO_AUDIO_OUTPUT_MIXER_H_
+#define MEDIA_AUDIO_AUDIO_OUTPUT_MIXER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "media/audio/audio_io.h"
+#include "media/audio/audio_logging.h"
+#include "media/audio/audio_output_dispatcher.h"
+#include "media/base/audio_converter.h"
+#include "media/base/audio_parameters.h"
+
+namespace media {
+
+class AudioOutputProxy;
+
+class MEDIA_EXPORT AudioOutputMixer
+    : public AudioOutputDispatcher,
+      public AudioOutputStream::AudioSourceCallback {
+ public:
+  AudioOutputMixer(AudioManager* audio_manager,
+                   const AudioParameters& input_params,
+                   const AudioParameters& output_params,
+                   const std::string& output_device_id,
+                   const base::TimeDelta& close_delay);
+
+  // AudioOutputDispatcher interface.
+  bool OpenStream() override;
+  bool StartStream(AudioOutputStream::AudioSourceCallback* callback,
+                   AudioOutputProxy* stream_proxy) override;
+  void StopStream(AudioOutputProxy* stream_proxy) override;
+  void StreamVolumeSet(AudioOutputProxy* stream_proxy, double volume) override;
+  void CloseStream(AudioOutputProxy* stream_proxy) override;
+  void Shutdown() override;
+
+  // AudioSourceCallback interface, called by the physical stream on the audio
+  // device thread.
+  int OnMoreData(AudioBus* dest,
+                 uint32_t total_bytes_delay,
+                 uint32_t frames_skipped) override;
+  void OnError(AudioOutputStream* stream) override;
+
+ private:
+  class MixerInput;
+
+  friend class base::RefCountedThreadSafe<AudioOutputMixer>;
+  ~AudioOutputMixer() override;
+
+  // Closes |physical_stream_| if no proxy is open anymore.
+  void ClosePhysicalStreamIfUnused();
+
+  // Closes |physical_stream_|, if open.  No proxy may be playing.
+  void ClosePhysicalStream();
+
+  const AudioParameters output_params_;
+
+  // Number of proxies opened and not closed yet.
+  size_t open_proxies_;
+
+  // The stream all the proxies play through, nullptr when closed.
+  AudioOutputStream* physical_stream_;
+
+  // Closes |physical_stream_| when no proxy was opened for |close_delay|.
+  base::DelayTimer close_timer_;
+
+  // Inputs of the playing proxies.  Only added to and removed from while
+  // holding |lock_|.
+  typedef std::map<AudioOutputProxy*, std::unique_ptr<MixerInput>> InputMap;
+  InputMap inputs_;
+
+  // Protects |audio_converter_|, |current_total_bytes_delay_| and the state
+  // of the inputs, which are used on the audio device thread.
+  base::Lock lock_;
+
+  // Last |total_bytes_delay| received via OnMoreData(), which the inputs add
+  // the conversion delay to.
+  uint32_t current_total_bytes_delay_;
+
+  // Mixes, and resamples and rechannels as needed, the audio of all inputs.
+  AudioConverter audio_converter_;
+
+  std::unique_ptr<AudioLog> audio_log_;
+
+  DISALLOW_COPY_AND_ASSIGN(AudioOutputMixer);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_AUDIO_AUDIO_OUTPUT_MIXER_H_
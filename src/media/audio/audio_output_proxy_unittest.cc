@@ -15,6 +15,7 @@
 #include "media/audio/audio_manager.h"
 #include "media/audio/audio_manager_base.h"
 #include "media/audio/audio_output_dispatcher_impl.h"
+#include "media/audio/audio_output_mixer.h"
 #include "media/audio/audio_output_proxy.h"
 #include "media/audio/audio_output_resampler.h"
 #include "media/audio/fake_audio_log_factory.h"
@@ -455,6 +456,18 @@ class AudioOutputResamplerTest : public AudioOutputProxyTest {
   scoped_refptr<AudioOutputResampler> resampler_;
 };
 
+class AudioOutputMixerTest : public AudioOutputResamplerTest {
+ public:
+  void InitDispatcher(base::TimeDelta close_delay) override {
+    AudioOutputResamplerTest::InitDispatcher(close_delay);
+    mixer_ = new AudioOutputMixer(&manager(), params_, resampler_params_,
+                                  std::string(), close_delay);
+  }
+
+ protected:
+  scoped_refptr<AudioOutputMixer> mixer_;
+};
+
 TEST_F(AudioOutputProxyTest, CreateAndClose) {
   AudioOutputProxy* proxy = new AudioOutputProxy(dispatcher_impl_.get());
   proxy->Close();
@@ -541,6 +554,54 @@ TEST_F(AudioOutputResamplerTest, StartFailed) {
   StartFailed(resampler_.get());
 }
 
+TEST_F(AudioOutputMixerTest, OpenAndClose) {
+  OpenAndClose(mixer_.get());
+}
+
+TEST_F(AudioOutputMixerTest, StartAndStop) {
+  StartAndStop(mixer_.get());
+}
+
+TEST_F(AudioOutputMixerTest, TwoStreams) {
+  TwoStreams(mixer_.get());
+}
+
+TEST_F(AudioOutputMixerTest, OpenFailed) {
+  OpenFailed(mixer_.get());
+}
+
+// Two streams, both are playing.  The mixer should play both through a single
+// physical stream, which keeps playing until both are stopped.
+TEST_F(AudioOutputMixerTest, TwoStreams_BothPlaying) {
+  MockAudioOutputStream stream(&manager_, resampler_params_);
+
+  EXPECT_CALL(manager(), MakeAudioOutputStream(_, _, _))
+      .WillOnce(Return(&stream));
+  EXPECT_CALL(stream, Open())
+      .WillOnce(Return(true));
+  EXPECT_CALL(stream, SetVolume(_))
+      .Times(1);
+
+  MockAudioSourceCallback callback2;
+  AudioOutputProxy* proxy1 = new AudioOutputProxy(mixer_.get());
+  AudioOutputProxy* proxy2 = new AudioOutputProxy(mixer_.get());
+  EXPECT_TRUE(proxy1->Open());
+  EXPECT_TRUE(proxy2->Open());
+
+  proxy1->Start(&callback_);
+  proxy2->Start(&callback2);
+  OnStart();
+  proxy1->Stop();
+  EXPECT_FALSE(stream.stop_called());
+  OnStart();
+  proxy2->Stop();
+  EXPECT_TRUE(stream.stop_called());
+
+  proxy1->Close();
+  CloseAndWaitForCloseTimer(proxy2, &stream);
+  EXPECT_TRUE(stream.start_called());
+}
+
 // Simulate AudioOutputStream::Create() failure with a low latency stream and
 // ensure AudioOutputResampler falls back to the high latency path.
 TEST_F(AudioOutputResamplerTest, LowLatencyCreateFailedFallback) {
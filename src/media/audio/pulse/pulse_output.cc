@@ -7,16 +7,23 @@
 #include <pulse/pulseaudio.h>
 #include <stdint.h>
 
+#include "base/command_line.h"
 #include "base/single_thread_task_runner.h"
 #include "media/audio/audio_device_description.h"
 #include "media/audio/audio_manager_base.h"
 #include "media/audio/pulse/pulse_util.h"
+#include "media/base/media_switches.h"
 
 namespace media {
 
 using pulse::AutoPulseLock;
 using pulse::WaitForOperationCompletion;
 
+// Number of buffers PulseAudio keeps queued for regular streams.  Low latency
+// streams start with a single buffer and grow up to this on underflows.
+static const int kDefaultTargetBuffers = 3;
+static const int kLowLatencyInitialTargetBuffers = 1;
+
 // static, pa_stream_notify_cb
 void PulseAudioOutputStream::StreamNotifyCallback(pa_stream* s, void* p_this) {
   PulseAudioOutputStream* stream = static_cast<PulseAudioOutputStream*>(p_this);
@@ -39,6 +46,12 @@ void PulseAudioOutputStream::StreamRequestCallback(pa_stream* s, size_t len,
   static_cast<PulseAudioOutputStream*>(p_this)->FulfillWriteRequest(len);
 }
 
+// static, pa_stream_notify_cb_t
+void PulseAudioOutputStream::StreamUnderflowCallback(pa_stream* s,
+                                                     void* p_this) {
+  static_cast<PulseAudioOutputStream*>(p_this)->OnUnderflow();
+}
+
 PulseAudioOutputStream::PulseAudioOutputStream(const AudioParameters& params,
                                                const std::string& device_id,
                                                AudioManagerBase* manager)
@@ -49,6 +62,10 @@ PulseAudioOutputStream::PulseAudioOutputStream(const AudioParameters& params,
       pa_mainloop_(NULL),
       pa_stream_(NULL),
       volume_(1.0f),
+      low_latency_(base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableLowLatencyPulseAudioOutput)),
+      target_buffers_(low_latency_ ? kLowLatencyInitialTargetBuffers
+                                   : kDefaultTargetBuffers),
       source_callback_(NULL) {
   CHECK(params_.IsValid());
   audio_bus_ = AudioBus::Create(params_);
@@ -64,10 +81,19 @@ PulseAudioOutputStream::~PulseAudioOutputStream() {
 
 bool PulseAudioOutputStream::Open() {
   DCHECK(thread_checker_.CalledOnValidThread());
-  return pulse::CreateOutputStream(
-      &pa_mainloop_, &pa_context_, &pa_stream_, params_, device_id_,
-      AudioManager::GetGlobalAppName(), &StreamNotifyCallback,
-      &StreamRequestCallback, this);
+  if (!pulse::CreateOutputStream(
+          &pa_mainloop_, &pa_context_, &pa_stream_, params_, target_buffers_,
+          device_id_, AudioManager::GetGlobalAppName(), &StreamNotifyCallback,
+          &StreamRequestCallback, this)) {
+    return false;
+  }
+
+  if (low_latency_) {
+    AutoPulseLock auto_lock(pa_mainloop_);
+    pa_stream_set_underflow_callback(pa_stream_, &StreamUnderflowCallback,
+                                     this);
+  }
+  return true;
 }
 
 void PulseAudioOutputStream::Reset() {
@@ -91,6 +117,7 @@ void PulseAudioOutputStream::Reset() {
       pa_stream_disconnect(pa_stream_);
       pa_stream_set_write_callback(pa_stream_, NULL, NULL);
       pa_stream_set_state_callback(pa_stream_, NULL, NULL);
+      pa_stream_set_underflow_callback(pa_stream_, NULL, NULL);
       pa_stream_unref(pa_stream_);
       pa_stream_ = NULL;
     }
@@ -179,6 +206,25 @@ void PulseAudioOutputStream::FulfillWriteRequest(size_t requested_bytes) {
   }
 }
 
+void PulseAudioOutputStream::OnUnderflow() {
+  // Underflows while stopping, e.g. from the flush in Stop(), are expected.
+  if (!source_callback_ || target_buffers_ >= kDefaultTargetBuffers)
+    return;
+
+  ++target_buffers_;
+  DVLOG(1) << "Output underflow, growing the PulseAudio buffer to "
+           << target_buffers_ << " buffers";
+
+  // We're on the PulseAudio thread, so we can't wait for the new attributes
+  // to be applied.
+  const pa_buffer_attr buffer_attributes =
+      pulse::GetOutputBufferAttributes(params_, target_buffers_);
+  pa_operation* operation =
+      pa_stream_set_buffer_attr(pa_stream_, &buffer_attributes, NULL, NULL);
+  if (operation)
+    pa_operation_unref(operation);
+}
+
 void PulseAudioOutputStream::Start(AudioSourceCallback* callback) {
   DCHECK(thread_checker_.CalledOnValidThread());
   CHECK(callback);
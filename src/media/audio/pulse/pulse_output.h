@@ -63,6 +63,14 @@ class PulseAudioOutputStream : public AudioOutputStream {
   // Called by PulseAudio when it needs more audio data.
   static void StreamRequestCallback(pa_stream* s, size_t len, void* p_this);
 
+  // Called by PulseAudio when |pa_stream_| ran out of audio data.  In the low
+  // latency mode this grows the stream's buffer.
+  static void StreamUnderflowCallback(pa_stream* s, void* p_this);
+
+  // Grows the buffer of |pa_stream_| by one buffer of |params_| after an
+  // underflow, as long as it is smaller than regular streams' buffer.
+  void OnUnderflow();
+
   // Fulfill a write request from the write request callback.  Outputs silence
   // if the request could not be fulfilled.
   void FulfillWriteRequest(size_t requested_bytes);
@@ -87,6 +95,14 @@ class PulseAudioOutputStream : public AudioOutputStream {
   // Float representation of volume from 0.0 to 1.0.
   float volume_;
 
+  // Whether the stream starts with the smallest buffer and only grows it when
+  // it underflows, see switches::kEnableLowLatencyPulseAudioOutput.
+  const bool low_latency_;
+
+  // Number of buffers of |params_| PulseAudio is asked to keep queued.  Must
+  // only be modified while holding a lock on |pa_mainloop_|.
+  int target_buffers_;
+
   // Callback to audio data source.  Must only be modified while holding a lock
   // on |pa_mainloop_| via pa_threaded_mainloop_lock().
   AudioSourceCallback* source_callback_;
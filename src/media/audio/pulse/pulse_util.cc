@@ -152,6 +152,29 @@ int GetHardwareLatencyInBytes(pa_stream* stream,
       base::Time::kMicrosecondsPerSecond;
 }
 
+pa_buffer_attr GetOutputBufferAttributes(const AudioParameters& params,
+                                         int target_buffers) {
+  DCHECK_GT(target_buffers, 0);
+
+  // Pulse is very finicky with the small buffer sizes used by Chrome.  The
+  // settings below are mostly found through trial and error.  Essentially we
+  // want Pulse to auto size its internal buffers, but call us back nearly every
+  // |minreq| bytes.  |tlength| should be a multiple of |minreq|; too low and
+  // Pulse will issue callbacks way too fast, too high and we don't get
+  // callbacks frequently enough.
+  //
+  // Setting |minreq| to the exact buffer size leads to more callbacks than
+  // necessary, so we've clipped it to half the buffer size.  Regardless of the
+  // requested amount, we'll always fill |params.GetBytesPerBuffer()| though.
+  pa_buffer_attr pa_buffer_attributes;
+  pa_buffer_attributes.maxlength = static_cast<uint32_t>(-1);
+  pa_buffer_attributes.minreq = params.GetBytesPerBuffer() / 2;
+  pa_buffer_attributes.prebuf = static_cast<uint32_t>(-1);
+  pa_buffer_attributes.tlength = params.GetBytesPerBuffer() * target_buffers;
+  pa_buffer_attributes.fragsize = static_cast<uint32_t>(-1);
+  return pa_buffer_attributes;
+}
+
 // Helper macro for CreateInput/OutputStream() to avoid code spam and
 // string bloat.
 #define RETURN_ON_FAILURE(expression, message) do { \
@@ -235,6 +258,7 @@ bool CreateOutputStream(pa_threaded_mainloop** mainloop,
                         pa_context** context,
                         pa_stream** stream,
                         const AudioParameters& params,
+                        int target_buffers,
                         const std::string& device_id,
                         const std::string& app_name,
                         pa_stream_notify_cb_t stream_callback,
@@ -309,22 +333,8 @@ bool CreateOutputStream(pa_threaded_mainloop** mainloop,
   // stream request after setup.  write_callback() must fulfill the write.
   pa_stream_set_write_callback(*stream, write_callback, user_data);
 
-  // Pulse is very finicky with the small buffer sizes used by Chrome.  The
-  // settings below are mostly found through trial and error.  Essentially we
-  // want Pulse to auto size its internal buffers, but call us back nearly every
-  // |minreq| bytes.  |tlength| should be a multiple of |minreq|; too low and
-  // Pulse will issue callbacks way too fast, too high and we don't get
-  // callbacks frequently enough.
-  //
-  // Setting |minreq| to the exact buffer size leads to more callbacks than
-  // necessary, so we've clipped it to half the buffer size.  Regardless of the
-  // requested amount, we'll always fill |params.GetBytesPerBuffer()| though.
-  pa_buffer_attr pa_buffer_attributes;
-  pa_buffer_attributes.maxlength = static_cast<uint32_t>(-1);
-  pa_buffer_attributes.minreq = params.GetBytesPerBuffer() / 2;
-  pa_buffer_attributes.prebuf = static_cast<uint32_t>(-1);
-  pa_buffer_attributes.tlength = params.GetBytesPerBuffer() * 3;
-  pa_buffer_attributes.fragsize = static_cast<uint32_t>(-1);
+  pa_buffer_attr pa_buffer_attributes =
+      GetOutputBufferAttributes(params, target_buffers);
 
   // Connect playback stream.  Like pa_buffer_attr, the pa_stream_flags have a
   // huge impact on the performance of the stream and were chosen through trial
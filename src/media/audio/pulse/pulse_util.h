@@ -49,6 +49,11 @@ int GetHardwareLatencyInBytes(pa_stream* stream,
                               int sample_rate,
                               int bytes_per_frame);
 
+// Returns the attributes of a playback stream of |params| for which PulseAudio
+// keeps about |target_buffers| buffers of |params| queued.
+pa_buffer_attr GetOutputBufferAttributes(const AudioParameters& params,
+                                         int target_buffers);
+
 // Create a recording stream for the threaded mainloop, return true if success,
 // otherwise false. |mainloop| and |context| have to be from a valid Pulse
 // threaded mainloop and the handle of the created stream will be returned by
@@ -64,11 +69,13 @@ bool CreateInputStream(pa_threaded_mainloop* mainloop,
 // Create a playback stream for the threaded mainloop, return true if success,
 // otherwise false. This function will create a new Pulse threaded mainloop,
 // and the handles of the mainloop, context and stream will be returned by
-// |mainloop|, |context| and |stream|.
+// |mainloop|, |context| and |stream|. The stream targets |target_buffers|
+// buffers of latency, see GetOutputBufferAttributes().
 bool CreateOutputStream(pa_threaded_mainloop** mainloop,
                         pa_context** context,
                         pa_stream** stream,
                         const AudioParameters& params,
+                        int target_buffers,
                         const std::string& device_id,
                         const std::string& app_name,
                         pa_stream_notify_cb_t stream_callback,
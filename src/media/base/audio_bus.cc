@@ -12,13 +12,139 @@
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/numerics/safe_conversions.h"
+#include "build/build_config.h"
 #include "media/base/audio_parameters.h"
 #include "media/base/audio_sample_types.h"
 #include "media/base/limits.h"
 #include "media/base/vector_math.h"
 
+// NaCl does not allow intrinsics.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#define INTERLEAVE_SIMD_AVAILABLE
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+#include <arm_neon.h>
+#define INTERLEAVE_SIMD_AVAILABLE
+#endif
+
 namespace media {
 
+#if defined(INTERLEAVE_SIMD_AVAILABLE)
+// The vector versions of SignedInt16SampleTypeTraits::FromFloat() and
+// ToFloat() give the same results, clipping included, so they only process the
+// frames that fill whole vectors and return their number. The channels don't
+// need to be aligned, since they may start at any frame offset.
+static const float kInt16ScaleForNegative = 32768.0f;
+static const float kInt16ScaleForPositive = 32767.0f;
+static const float kInt16InverseScaleForNegative = 1.0f / 32768.0f;
+static const float kInt16InverseScaleForPositive = 1.0f / 32767.0f;
+#endif
+
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+static __m128i FloatToInt16Range_SSE2(__m128 samples) {
+  const __m128 negative = _mm_cmplt_ps(samples, _mm_setzero_ps());
+  const __m128 scale =
+      _mm_or_ps(_mm_and_ps(negative, _mm_set1_ps(kInt16ScaleForNegative)),
+                _mm_andnot_ps(negative, _mm_set1_ps(kInt16ScaleForPositive)));
+  __m128 scaled = _mm_mul_ps(samples, scale);
+  scaled = _mm_max_ps(scaled, _mm_set1_ps(-kInt16ScaleForNegative));
+  scaled = _mm_min_ps(scaled, _mm_set1_ps(kInt16ScaleForPositive));
+  return _mm_cvttps_epi32(scaled);
+}
+
+static __m128 Int16RangeToFloat_SSE2(__m128i samples) {
+  const __m128 values = _mm_cvtepi32_ps(samples);
+  const __m128 negative = _mm_cmplt_ps(values, _mm_setzero_ps());
+  const __m128 scale = _mm_or_ps(
+      _mm_and_ps(negative, _mm_set1_ps(kInt16InverseScaleForNegative)),
+      _mm_andnot_ps(negative, _mm_set1_ps(kInt16InverseScaleForPositive)));
+  return _mm_mul_ps(values, scale);
+}
+
+static int InterleaveStereoInt16(const float* left,
+                                 const float* right,
+                                 int frames,
+                                 int16_t* dest) {
+  int i = 0;
+  for (; i + 8 <= frames; i += 8) {
+    const __m128i left_x8 =
+        _mm_packs_epi32(FloatToInt16Range_SSE2(_mm_loadu_ps(left + i)),
+                        FloatToInt16Range_SSE2(_mm_loadu_ps(left + i + 4)));
+    const __m128i right_x8 =
+        _mm_packs_epi32(FloatToInt16Range_SSE2(_mm_loadu_ps(right + i)),
+                        FloatToInt16Range_SSE2(_mm_loadu_ps(right + i + 4)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i),
+                     _mm_unpacklo_epi16(left_x8, right_x8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i + 8),
+                     _mm_unpackhi_epi16(left_x8, right_x8));
+  }
+  return i;
+}
+
+static int DeinterleaveStereoInt16(const int16_t* source,
+                                   int frames,
+                                   float* left,
+                                   float* right) {
+  int i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    // Each 32-bit lane holds a frame, with the left sample in its low half.
+    const __m128i frames_x4 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 2 * i));
+    const __m128i left_x4 = _mm_srai_epi32(_mm_slli_epi32(frames_x4, 16), 16);
+    const __m128i right_x4 = _mm_srai_epi32(frames_x4, 16);
+    _mm_storeu_ps(left + i, Int16RangeToFloat_SSE2(left_x4));
+    _mm_storeu_ps(right + i, Int16RangeToFloat_SSE2(right_x4));
+  }
+  return i;
+}
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+static int16x4_t FloatToInt16_NEON(float32x4_t samples) {
+  const float32x4_t scale = vbslq_f32(vcltq_f32(samples, vdupq_n_f32(0.0f)),
+                                      vdupq_n_f32(kInt16ScaleForNegative),
+                                      vdupq_n_f32(kInt16ScaleForPositive));
+  float32x4_t scaled = vmulq_f32(samples, scale);
+  scaled = vmaxq_f32(scaled, vdupq_n_f32(-kInt16ScaleForNegative));
+  scaled = vminq_f32(scaled, vdupq_n_f32(kInt16ScaleForPositive));
+  return vqmovn_s32(vcvtq_s32_f32(scaled));
+}
+
+static float32x4_t Int16ToFloat_NEON(int16x4_t samples) {
+  const float32x4_t values = vcvtq_f32_s32(vmovl_s16(samples));
+  const float32x4_t scale =
+      vbslq_f32(vcltq_f32(values, vdupq_n_f32(0.0f)),
+                vdupq_n_f32(kInt16InverseScaleForNegative),
+                vdupq_n_f32(kInt16InverseScaleForPositive));
+  return vmulq_f32(values, scale);
+}
+
+static int InterleaveStereoInt16(const float* left,
+                                 const float* right,
+                                 int frames,
+                                 int16_t* dest) {
+  int i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    int16x4x2_t frames_x4;
+    frames_x4.val[0] = FloatToInt16_NEON(vld1q_f32(left + i));
+    frames_x4.val[1] = FloatToInt16_NEON(vld1q_f32(right + i));
+    vst2_s16(dest + 2 * i, frames_x4);
+  }
+  return i;
+}
+
+static int DeinterleaveStereoInt16(const int16_t* source,
+                                   int frames,
+                                   float* left,
+                                   float* right) {
+  int i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    const int16x4x2_t frames_x4 = vld2_s16(source + 2 * i);
+    vst1q_f32(left + i, Int16ToFloat_NEON(frames_x4.val[0]));
+    vst1q_f32(right + i, Int16ToFloat_NEON(frames_x4.val[1]));
+  }
+  return i;
+}
+#endif
+
 static bool IsAligned(void* ptr) {
   return (reinterpret_cast<uintptr_t>(ptr) &
           (AudioBus::kChannelAlignment - 1)) == 0U;
@@ -344,6 +470,56 @@ void AudioBus::SwapChannels(int a, int b) {
   std::swap(channel_data_[a], channel_data_[b]);
 }
 
+template <>
+void AudioBus::CopyConvertFromInterleavedSourceToAudioBus<
+    SignedInt16SampleTypeTraits>(const int16_t* source_buffer,
+                                 int write_offset_in_frames,
+                                 int num_frames_to_write,
+                                 AudioBus* dest) {
+  const int channels = dest->channels();
+  int frames_written = 0;
+#if defined(INTERLEAVE_SIMD_AVAILABLE)
+  if (channels == 2) {
+    frames_written = DeinterleaveStereoInt16(
+        source_buffer, num_frames_to_write,
+        dest->channel(0) + write_offset_in_frames,
+        dest->channel(1) + write_offset_in_frames);
+  }
+#endif
+  for (int ch = 0; ch < channels; ++ch) {
+    float* channel_data = dest->channel(ch) + write_offset_in_frames;
+    for (int i = frames_written; i < num_frames_to_write; ++i) {
+      const int16_t source_value = source_buffer[i * channels + ch];
+      channel_data[i] = SignedInt16SampleTypeTraits::ToFloat(source_value);
+    }
+  }
+}
+
+template <>
+void AudioBus::CopyConvertFromAudioBusToInterleavedTarget<
+    SignedInt16SampleTypeTraits>(const AudioBus* source,
+                                 int read_offset_in_frames,
+                                 int num_frames_to_read,
+                                 int16_t* dest_buffer) {
+  const int channels = source->channels();
+  int frames_read = 0;
+#if defined(INTERLEAVE_SIMD_AVAILABLE)
+  if (channels == 2) {
+    frames_read = InterleaveStereoInt16(
+        source->channel(0) + read_offset_in_frames,
+        source->channel(1) + read_offset_in_frames, num_frames_to_read,
+        dest_buffer);
+  }
+#endif
+  for (int ch = 0; ch < channels; ++ch) {
+    const float* channel_data = source->channel(ch) + read_offset_in_frames;
+    for (int i = frames_read; i < num_frames_to_read; ++i) {
+      dest_buffer[i * channels + ch] =
+          SignedInt16SampleTypeTraits::FromFloat(channel_data[i]);
+    }
+  }
+}
+
 scoped_refptr<AudioBusRefCounted> AudioBusRefCounted::Create(
     int channels, int frames) {
   return scoped_refptr<AudioBusRefCounted>(
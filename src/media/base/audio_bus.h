@@ -13,6 +13,7 @@
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
 #include "base/memory/ref_counted.h"
+#include "media/base/audio_sample_types.h"
 #include "media/base/media_export.h"
 
 namespace media {
@@ -223,6 +224,22 @@ class MEDIA_EXPORT AudioBus {
   DISALLOW_COPY_AND_ASSIGN(AudioBus);
 };
 
+// 16-bit samples are the most common interleaved format, so their conversions
+// use vector instructions for stereo audio where available.
+template <>
+MEDIA_EXPORT void AudioBus::CopyConvertFromInterleavedSourceToAudioBus<
+    SignedInt16SampleTypeTraits>(const int16_t* source_buffer,
+                                 int write_offset_in_frames,
+                                 int num_frames_to_write,
+                                 AudioBus* dest);
+
+template <>
+MEDIA_EXPORT void AudioBus::CopyConvertFromAudioBusToInterleavedTarget<
+    SignedInt16SampleTypeTraits>(const AudioBus* source,
+                                 int read_offset_in_frames,
+                                 int num_frames_to_read,
+                                 int16_t* dest_buffer);
+
 // Delegates to FromInterleavedPartial()
 template <class SourceSampleTypeTraits>
 void AudioBus::FromInterleaved(
@@ -633,6 +633,65 @@ TEST_F(AudioBusTest, FromInterleavedPartialDoesNotZeroOutUntouchedFrames) {
   }
 }
 
+// Verify the vectorized 16-bit stereo conversions, which start at any frame
+// offset and leave a remainder of frames, give the same results as
+// SignedInt16SampleTypeTraits, clipping included.
+TEST_F(AudioBusTest, Int16StereoConversionsMatchSampleTypeTraits) {
+  static const int kStereoChannels = 2;
+  static const int kStereoFrames = 37;
+  static const int kOffsetInFrames = 3;
+  static const int kConvertedFrames = kStereoFrames - kOffsetInFrames - 1;
+  std::unique_ptr<AudioBus> bus =
+      AudioBus::Create(kStereoChannels, kStereoFrames);
+
+  {
+    SCOPED_TRACE("ToInterleavedPartial");
+    // Ramps covering values beyond both clipping limits.
+    for (int i = 0; i < kStereoFrames; ++i) {
+      const float ramp = -1.5f + 3.0f * i / (kStereoFrames - 1);
+      bus->channel(0)[i] = ramp;
+      bus->channel(1)[i] = -ramp;
+    }
+    bus->channel(0)[kOffsetInFrames] = -1.0f;
+    bus->channel(1)[kOffsetInFrames] = 1.0f;
+
+    int16_t interleaved[kStereoChannels * kConvertedFrames];
+    bus->ToInterleavedPartial<SignedInt16SampleTypeTraits>(
+        kOffsetInFrames, kConvertedFrames, interleaved);
+    for (int i = 0; i < kConvertedFrames; ++i) {
+      for (int ch = 0; ch < kStereoChannels; ++ch) {
+        ASSERT_EQ(SignedInt16SampleTypeTraits::FromFloat(
+                      bus->channel(ch)[kOffsetInFrames + i]),
+                  interleaved[i * kStereoChannels + ch])
+            << "ch=" << ch << " i=" << i;
+      }
+    }
+  }
+
+  {
+    SCOPED_TRACE("FromInterleavedPartial");
+    int16_t interleaved[kStereoChannels * kConvertedFrames];
+    for (int i = 0; i < kStereoChannels * kConvertedFrames; ++i) {
+      interleaved[i] = static_cast<int16_t>(
+          INT16_MIN + i * (static_cast<int>(UINT16_MAX) /
+                           (kStereoChannels * kConvertedFrames - 1)));
+    }
+    interleaved[0] = INT16_MIN;
+    interleaved[1] = INT16_MAX;
+
+    bus->FromInterleavedPartial<SignedInt16SampleTypeTraits>(
+        interleaved, kOffsetInFrames, kConvertedFrames);
+    for (int i = 0; i < kConvertedFrames; ++i) {
+      for (int ch = 0; ch < kStereoChannels; ++ch) {
+        ASSERT_EQ(SignedInt16SampleTypeTraits::ToFloat(
+                      interleaved[i * kStereoChannels + ch]),
+                  bus->channel(ch)[kOffsetInFrames + i])
+            << "ch=" << ch << " i=" << i;
+      }
+    }
+  }
+}
+
 TEST_F(AudioBusTest, Scale) {
   std::unique_ptr<AudioBus> bus = AudioBus::Create(kChannels, kFrameCount);
 
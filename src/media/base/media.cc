@@ -10,6 +10,7 @@
 #include "base/metrics/field_trial.h"
 #include "base/trace_event/trace_event.h"
 #include "media/base/media_switches.h"
+#include "media/base/vector_math.h"
 #include "media/base/yuv_convert.h"
 
 #if defined(OS_ANDROID)
@@ -41,6 +42,7 @@ class MediaInitializer {
 
     // Perform initialization of libraries which require runtime CPU detection.
     InitializeCPUSpecificYUVConversions();
+    vector_math::InitializeCPUSpecificFeatures();
 
 #if !defined(MEDIA_DISABLE_FFMPEG)
     // Initialize CPU flags outside of the sandbox as this may query /proc for
@@ -13,6 +13,21 @@ const char kAudioBufferSize[] = "audio-buffer-size";
 // Set number of threads to use for video decoding.
 const char kVideoThreads[] = "video-threads";
 
+// Decodes several VP9 frames at once in software, one per decode thread. This
+// increases the decode throughput on devices without hardware VP9 decoding, at
+// the cost of a frame buffer and a frame of latency per thread.
+const char kEnableVp9FrameParallelDecoding[] =
+    "enable-vp9-frame-parallel-decoding";
+
+// Mix the output streams with the same parameters into a single physical
+// stream in the browser, instead of opening one physical stream per stream.
+const char kEnableAudioOutputMixer[] = "enable-audio-output-mixer";
+
+// Have FFmpegDemuxer keep about a second of packets queued per stream, instead
+// of reading from the data source only when a stream has a pending Read().
+// Seeks may then have to wait for a read ahead to complete.
+const char kEnableDemuxerReadAhead[] = "enable-demuxer-read-ahead";
+
 const char kMaxAudioSourceBuffer[] = "max-audio-source-buffer";
 const char kMaxVideoSourceBuffer[] = "max-video-source-buffer";
 
@@ -38,11 +53,21 @@ const char kEnableMediaThreadForMediaPlayback[] =
     "enable-media-thread-for-media-playback";
 #endif
 
+#if defined(OS_WEBOS)
+// Delivers punch-through video geometry to the media sink on compositor
+// BeginFrames instead of at paint time.
+const char kEnableVideoHoleFrameSync[] = "enable-video-hole-frame-sync";
+#endif
+
 #if defined(OS_LINUX) || defined(OS_FREEBSD) || defined(OS_SOLARIS)
 // The Alsa device to use when opening an audio input stream.
 const char kAlsaInputDevice[] = "alsa-input-device";
 // The Alsa device to use when opening an audio stream.
 const char kAlsaOutputDevice[] = "alsa-output-device";
+// Start PulseAudio output streams with the smallest server-side buffer and
+// grow it only when they underrun.
+const char kEnableLowLatencyPulseAudioOutput[] =
+    "enable-low-latency-pulseaudio-output";
 #endif
 
 // Use GpuMemoryBuffers for Video Capture when this is an option for the device.
@@ -16,6 +16,11 @@ namespace switches {
 MEDIA_EXPORT extern const char kAudioBufferSize[];
 
 MEDIA_EXPORT extern const char kVideoThreads[];
+MEDIA_EXPORT extern const char kEnableVp9FrameParallelDecoding[];
+
+MEDIA_EXPORT extern const char kEnableAudioOutputMixer[];
+
+MEDIA_EXPORT extern const char kEnableDemuxerReadAhead[];
 
 MEDIA_EXPORT extern const char kMaxAudioSourceBuffer[];
 MEDIA_EXPORT extern const char kMaxVideoSourceBuffer[];
@@ -31,9 +36,14 @@ MEDIA_EXPORT extern const char kDisableUnifiedMediaPipeline[];
 MEDIA_EXPORT extern const char kEnableMediaThreadForMediaPlayback[];
 #endif
 
+#if defined(OS_WEBOS)
+MEDIA_EXPORT extern const char kEnableVideoHoleFrameSync[];
+#endif
+
 #if defined(OS_LINUX) || defined(OS_FREEBSD) || defined(OS_SOLARIS)
 MEDIA_EXPORT extern const char kAlsaInputDevice[];
 MEDIA_EXPORT extern const char kAlsaOutputDevice[];
+MEDIA_EXPORT extern const char kEnableLowLatencyPulseAudioOutput[];
 #endif
 
 MEDIA_EXPORT extern const char kUseGpuMemoryBuffersForCapture[];
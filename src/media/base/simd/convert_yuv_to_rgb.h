@@ -104,6 +104,40 @@ MEDIA_EXPORT void LinearScaleYUVToRGB32RowWithRange_C(
     int source_dx,
     const int16_t* convert_table);
 
+MEDIA_EXPORT void ConvertYUVToRGB32_NEON(const uint8_t* yplane,
+                                         const uint8_t* uplane,
+                                         const uint8_t* vplane,
+                                         uint8_t* rgbframe,
+                                         int width,
+                                         int height,
+                                         int ystride,
+                                         int uvstride,
+                                         int rgbstride,
+                                         YUVType yuv_type);
+
+MEDIA_EXPORT void ConvertYUVToRGB32Row_NEON(const uint8_t* yplane,
+                                            const uint8_t* uplane,
+                                            const uint8_t* vplane,
+                                            uint8_t* rgbframe,
+                                            ptrdiff_t width,
+                                            const int16_t* convert_table);
+
+MEDIA_EXPORT void ScaleYUVToRGB32Row_NEON(const uint8_t* y_buf,
+                                          const uint8_t* u_buf,
+                                          const uint8_t* v_buf,
+                                          uint8_t* rgb_buf,
+                                          ptrdiff_t width,
+                                          ptrdiff_t source_dx,
+                                          const int16_t* convert_table);
+
+MEDIA_EXPORT void LinearScaleYUVToRGB32Row_NEON(const uint8_t* y_buf,
+                                                const uint8_t* u_buf,
+                                                const uint8_t* v_buf,
+                                                uint8_t* rgb_buf,
+                                                ptrdiff_t width,
+                                                ptrdiff_t source_dx,
+                                                const int16_t* convert_table);
+
 }  // namespace media
 
 // Assembly functions are declared without namespace.
@@ -0,0 +1,141 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <arm_neon.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "media/base/simd/convert_yuv_to_rgb.h"
+
+namespace media {
+
+// The NEON versions do what the MMX ones do: the Y, U and V rows of the lookup
+// table are added with signed saturation, shifted out of 10.6 fixed point and
+// packed with unsigned saturation.  This gives exactly the output of the C
+// versions.  Since the table columns are in the byte order of the pixels, the
+// packed result can be stored as is.
+
+// Converts the pixels |y0| and |y1|, which share |u| and |v|.
+static inline uint8x8_t ConvertTwoPixels(int y0,
+                                         int y1,
+                                         int u,
+                                         int v,
+                                         const int16_t* convert_table) {
+  const int16x4_t uv = vqadd_s16(vld1_s16(convert_table + 4 * (256 + u)),
+                                 vld1_s16(convert_table + 4 * (512 + v)));
+  const int16x8_t y = vcombine_s16(vld1_s16(convert_table + 4 * y0),
+                                   vld1_s16(convert_table + 4 * y1));
+  return vqmovun_s16(vshrq_n_s16(vqaddq_s16(y, vcombine_s16(uv, uv)), 6));
+}
+
+// Stores only the first pixel of |pixels|, for the last pixel of odd widths.
+static inline void StoreOnePixel(uint8x8_t pixels, uint8_t* rgb_buf) {
+  vst1_lane_u32(reinterpret_cast<uint32_t*>(rgb_buf),
+                vreinterpret_u32_u8(pixels), 0);
+}
+
+void ConvertYUVToRGB32Row_NEON(const uint8_t* y_buf,
+                               const uint8_t* u_buf,
+                               const uint8_t* v_buf,
+                               uint8_t* rgb_buf,
+                               ptrdiff_t width,
+                               const int16_t* convert_table) {
+  int x = 0;
+  for (; x < width - 1; x += 2) {
+    vst1_u8(rgb_buf, ConvertTwoPixels(y_buf[x], y_buf[x + 1], u_buf[x >> 1],
+                                      v_buf[x >> 1], convert_table));
+    rgb_buf += 8;  // Advance 2 pixels.
+  }
+  if (x < width) {
+    StoreOnePixel(ConvertTwoPixels(y_buf[x], y_buf[x], u_buf[x >> 1],
+                                   v_buf[x >> 1], convert_table),
+                  rgb_buf);
+  }
+}
+
+// See ScaleYUVToRGB32Row_C() for the 16.16 fixed point stepping.
+void ScaleYUVToRGB32Row_NEON(const uint8_t* y_buf,
+                             const uint8_t* u_buf,
+                             const uint8_t* v_buf,
+                             uint8_t* rgb_buf,
+                             ptrdiff_t width,
+                             ptrdiff_t source_dx,
+                             const int16_t* convert_table) {
+  int x = 0;
+  int i = 0;
+  for (; i < width - 1; i += 2) {
+    const int u = u_buf[x >> 17];
+    const int v = v_buf[x >> 17];
+    const int y0 = y_buf[x >> 16];
+    x += source_dx;
+    const int y1 = y_buf[x >> 16];
+    x += source_dx;
+    vst1_u8(rgb_buf, ConvertTwoPixels(y0, y1, u, v, convert_table));
+    rgb_buf += 8;
+  }
+  if (i < width) {
+    const int y = y_buf[x >> 16];
+    StoreOnePixel(
+        ConvertTwoPixels(y, y, u_buf[x >> 17], v_buf[x >> 17], convert_table),
+        rgb_buf);
+  }
+}
+
+// See LinearScaleYUVToRGB32RowWithRange_C() for the interpolation.
+void LinearScaleYUVToRGB32Row_NEON(const uint8_t* y_buf,
+                                   const uint8_t* u_buf,
+                                   const uint8_t* v_buf,
+                                   uint8_t* rgb_buf,
+                                   ptrdiff_t width,
+                                   ptrdiff_t source_dx,
+                                   const int16_t* convert_table) {
+  // Avoid point-sampling for down-scaling by > 2:1.
+  int x = 0;
+  if (source_dx >= 0x20000)
+    x += 0x8000;
+
+  for (int i = 0; i < width; i += 2) {
+    int y_frac = x & 65535;
+    const int uv_frac = (x >> 1) & 65535;
+    const int y0 = (y_frac * y_buf[(x >> 16) + 1] +
+                    (y_frac ^ 65535) * y_buf[x >> 16]) >> 16;
+    const int u = (uv_frac * u_buf[(x >> 17) + 1] +
+                   (uv_frac ^ 65535) * u_buf[x >> 17]) >> 16;
+    const int v = (uv_frac * v_buf[(x >> 17) + 1] +
+                   (uv_frac ^ 65535) * v_buf[x >> 17]) >> 16;
+    x += source_dx;
+    if ((i + 1) < width) {
+      y_frac = x & 65535;
+      const int y1 = (y_frac * y_buf[(x >> 16) + 1] +
+                      (y_frac ^ 65535) * y_buf[x >> 16]) >> 16;
+      x += source_dx;
+      vst1_u8(rgb_buf, ConvertTwoPixels(y0, y1, u, v, convert_table));
+    } else {
+      StoreOnePixel(ConvertTwoPixels(y0, y0, u, v, convert_table), rgb_buf);
+    }
+    rgb_buf += 8;
+  }
+}
+
+void ConvertYUVToRGB32_NEON(const uint8_t* yplane,
+                            const uint8_t* uplane,
+                            const uint8_t* vplane,
+                            uint8_t* rgbframe,
+                            int width,
+                            int height,
+                            int ystride,
+                            int uvstride,
+                            int rgbstride,
+                            YUVType yuv_type) {
+  const unsigned int y_shift = GetVerticalShift(yuv_type);
+  const int16_t* lookup_table = GetLookupTable(yuv_type);
+  for (int y = 0; y < height; ++y) {
+    ConvertYUVToRGB32Row_NEON(yplane + y * ystride,
+                              uplane + (y >> y_shift) * uvstride,
+                              vplane + (y >> y_shift) * uvstride,
+                              rgbframe + y * rgbstride, width, lookup_table);
+  }
+}
+
+}  // namespace media
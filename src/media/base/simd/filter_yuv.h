@@ -26,6 +26,12 @@ MEDIA_EXPORT void FilterYUVRows_SSE2(uint8_t* ybuf,
                                      int source_width,
                                      uint8_t source_y_fraction);
 
+MEDIA_EXPORT void FilterYUVRows_NEON(uint8_t* ybuf,
+                                     const uint8_t* y0_ptr,
+                                     const uint8_t* y1_ptr,
+                                     int source_width,
+                                     uint8_t source_y_fraction);
+
 }  // namespace media
 
 #endif  // MEDIA_BASE_SIMD_FILTER_YUV_H_
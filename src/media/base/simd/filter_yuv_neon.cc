@@ -0,0 +1,46 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <arm_neon.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "media/base/simd/filter_yuv.h"
+
+namespace media {
+
+void FilterYUVRows_NEON(uint8_t* dest,
+                        const uint8_t* src0,
+                        const uint8_t* src1,
+                        int width,
+                        uint8_t fraction) {
+  // The weight of |src0|, 256 - |fraction|, only fits in 8 bits when
+  // |fraction| isn't zero.  When it is, the output is |src0|.
+  if (fraction == 0) {
+    memcpy(dest, src0, width);
+    return;
+  }
+
+  const uint8x8_t src0_fraction = vdup_n_u8(256 - fraction);
+  const uint8x8_t src1_fraction = vdup_n_u8(fraction);
+  int pixel = 0;
+  for (; pixel + 16 <= width; pixel += 16) {
+    const uint8x16_t src0_pixels = vld1q_u8(src0 + pixel);
+    const uint8x16_t src1_pixels = vld1q_u8(src1 + pixel);
+    uint16x8_t low = vmull_u8(vget_low_u8(src0_pixels), src0_fraction);
+    uint16x8_t high = vmull_u8(vget_high_u8(src0_pixels), src0_fraction);
+    low = vmlal_u8(low, vget_low_u8(src1_pixels), src1_fraction);
+    high = vmlal_u8(high, vget_high_u8(src1_pixels), src1_fraction);
+    vst1q_u8(dest + pixel,
+             vcombine_u8(vshrn_n_u16(low, 8), vshrn_n_u16(high, 8)));
+  }
+
+  // Handle any remaining pixels that wouldn't fit in a NEON pass.
+  for (; pixel < width; ++pixel) {
+    dest[pixel] = (src0[pixel] * (256 - fraction) +
+                   src1[pixel] * fraction) >> 8;
+  }
+}
+
+}  // namespace media
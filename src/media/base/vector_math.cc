@@ -12,7 +12,18 @@
 
 // NaCl does not allow intrinsics.
 #if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <immintrin.h>
 #include <xmmintrin.h>
+
+#include "base/cpu.h"
+
+// The AVX versions are only used when base::CPU detects AVX support at
+// runtime, so they are compiled for AVX without the rest of this file.
+#if defined(COMPILER_GCC)
+#define AVX_TARGET __attribute__((target("avx")))
+#else
+#define AVX_TARGET
+#endif
 // Don't use custom SSE versions where the auto-vectorized C version performs
 // better, which is anywhere clang is used.
 #if !defined(__clang__)
@@ -23,25 +34,58 @@
 #define FMUL_FUNC FMUL_C
 #endif
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_SSE
+// Reductions aren't auto-vectorized, since that changes the rounding.
+#define DotProduct_FUNC DotProduct_SSE
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
 #include <arm_neon.h>
 #define FMAC_FUNC FMAC_NEON
 #define FMUL_FUNC FMUL_NEON
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_NEON
+#define DotProduct_FUNC DotProduct_NEON
 #else
 #define FMAC_FUNC FMAC_C
 #define FMUL_FUNC FMUL_C
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_C
+#define DotProduct_FUNC DotProduct_C
 #endif
 
 namespace media {
 namespace vector_math {
 
+namespace {
+
+typedef void (*ScaleProc)(const float src[], float scale, int len,
+                          float dest[]);
+typedef std::pair<float, float> (*EWMAAndMaxPowerProc)(
+    float initial_value, const float src[], int len, float smoothing_factor);
+typedef float (*DotProductProc)(const float a[], const float b[], int len);
+
+// Versions picked at compile time, possibly replaced by faster ones by
+// InitializeCPUSpecificFeatures().
+ScaleProc g_fmac_proc_ = FMAC_FUNC;
+ScaleProc g_fmul_proc_ = FMUL_FUNC;
+EWMAAndMaxPowerProc g_ewma_and_max_power_proc_ = EWMAAndMaxPower_FUNC;
+DotProductProc g_dot_product_proc_ = DotProduct_FUNC;
+
+}  // namespace
+
+void InitializeCPUSpecificFeatures() {
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  base::CPU cpu;
+  if (cpu.has_avx()) {
+    g_fmac_proc_ = FMAC_AVX;
+    g_fmul_proc_ = FMUL_AVX;
+    g_ewma_and_max_power_proc_ = EWMAAndMaxPower_AVX;
+    g_dot_product_proc_ = DotProduct_AVX;
+  }
+#endif
+}
+
 void FMAC(const float src[], float scale, int len, float dest[]) {
   // Ensure |src| and |dest| are 16-byte aligned.
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(src) & (kRequiredAlignment - 1));
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(dest) & (kRequiredAlignment - 1));
-  return FMAC_FUNC(src, scale, len, dest);
+  return g_fmac_proc_(src, scale, len, dest);
 }
 
 void FMAC_C(const float src[], float scale, int len, float dest[]) {
@@ -53,7 +97,7 @@ void FMUL(const float src[], float scale, int len, float dest[]) {
   // Ensure |src| and |dest| are 16-byte aligned.
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(src) & (kRequiredAlignment - 1));
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(dest) & (kRequiredAlignment - 1));
-  return FMUL_FUNC(src, scale, len, dest);
+  return g_fmul_proc_(src, scale, len, dest);
 }
 
 void FMUL_C(const float src[], float scale, int len, float dest[]) {
@@ -72,7 +116,7 @@ std::pair<float, float> EWMAAndMaxPower(
     float initial_value, const float src[], int len, float smoothing_factor) {
   // Ensure |src| is 16-byte aligned.
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(src) & (kRequiredAlignment - 1));
-  return EWMAAndMaxPower_FUNC(initial_value, src, len, smoothing_factor);
+  return g_ewma_and_max_power_proc_(initial_value, src, len, smoothing_factor);
 }
 
 std::pair<float, float> EWMAAndMaxPower_C(
@@ -89,6 +133,17 @@ std::pair<float, float> EWMAAndMaxPower_C(
   return result;
 }
 
+float DotProduct(const float a[], const float b[], int len) {
+  return g_dot_product_proc_(a, b, len);
+}
+
+float DotProduct_C(const float a[], const float b[], int len) {
+  float sum = 0.0f;
+  for (int i = 0; i < len; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+
 #if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
 void FMUL_SSE(const float src[], float scale, int len, float dest[]) {
   const int rem = len % 4;
@@ -192,6 +247,133 @@ std::pair<float, float> EWMAAndMaxPower_SSE(
 
   return result;
 }
+
+// The AVX versions use unaligned loads and stores, since |src| and |dest| are
+// only guaranteed to be aligned for SSE.
+AVX_TARGET void FMUL_AVX(const float src[], float scale, int len,
+                         float dest[]) {
+  const int rem = len % 8;
+  const int last_index = len - rem;
+  __m256 m_scale = _mm256_set1_ps(scale);
+  for (int i = 0; i < last_index; i += 8) {
+    _mm256_storeu_ps(dest + i,
+                     _mm256_mul_ps(_mm256_loadu_ps(src + i), m_scale));
+  }
+
+  // Handle any remaining values that wouldn't fit in an AVX pass.
+  for (int i = last_index; i < len; ++i)
+    dest[i] = src[i] * scale;
+}
+
+AVX_TARGET void FMAC_AVX(const float src[], float scale, int len,
+                         float dest[]) {
+  const int rem = len % 8;
+  const int last_index = len - rem;
+  __m256 m_scale = _mm256_set1_ps(scale);
+  for (int i = 0; i < last_index; i += 8) {
+    _mm256_storeu_ps(dest + i,
+                     _mm256_add_ps(_mm256_loadu_ps(dest + i),
+                                   _mm256_mul_ps(_mm256_loadu_ps(src + i),
+                                                 m_scale)));
+  }
+
+  // Handle any remaining values that wouldn't fit in an AVX pass.
+  for (int i = last_index; i < len; ++i)
+    dest[i] += src[i] * scale;
+}
+
+AVX_TARGET std::pair<float, float> EWMAAndMaxPower_AVX(
+    float initial_value, const float src[], int len, float smoothing_factor) {
+  // Same strategy as EWMAAndMaxPower_SSE(), with 8 lanes: lane 7 - k computes
+  // z[n-k], where z[n] = a(S[n]^2) + (1-a)^8(z[n-8]) + (1-a)^16(z[n-16]) + ...
+  const int rem = len % 8;
+  const int last_index = len - rem;
+
+  const __m256 smoothing_factor_x8 = _mm256_set1_ps(smoothing_factor);
+  const float weight_prev = 1.0f - smoothing_factor;
+  float weight_prev_8th = weight_prev;
+  for (int k = 0; k < 3; ++k)
+    weight_prev_8th *= weight_prev_8th;
+  const __m256 weight_prev_8th_x8 = _mm256_set1_ps(weight_prev_8th);
+
+  __m256 max_x8 = _mm256_setzero_ps();
+  __m256 ewma_x8 =
+      _mm256_setr_ps(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, initial_value);
+  int i;
+  for (i = 0; i < last_index; i += 8) {
+    ewma_x8 = _mm256_mul_ps(ewma_x8, weight_prev_8th_x8);
+    const __m256 sample_x8 = _mm256_loadu_ps(src + i);
+    const __m256 sample_squared_x8 = _mm256_mul_ps(sample_x8, sample_x8);
+    max_x8 = _mm256_max_ps(max_x8, sample_squared_x8);
+    ewma_x8 = _mm256_add_ps(ewma_x8,
+                            _mm256_mul_ps(sample_squared_x8,
+                                          smoothing_factor_x8));
+  }
+
+  // y[n] = z[n] + (1-a)^1(z[n-1]) + ... + (1-a)^7(z[n-7])
+  float ewma_lanes[8];
+  float max_lanes[8];
+  _mm256_storeu_ps(ewma_lanes, ewma_x8);
+  _mm256_storeu_ps(max_lanes, max_x8);
+  std::pair<float, float> result(ewma_lanes[0], max_lanes[0]);
+  for (int k = 1; k < 8; ++k) {
+    result.first = result.first * weight_prev + ewma_lanes[k];
+    result.second = std::max(result.second, max_lanes[k]);
+  }
+
+  // Handle remaining values at the end of |src|.
+  for (; i < len; ++i) {
+    result.first *= weight_prev;
+    const float sample = src[i];
+    const float sample_squared = sample * sample;
+    result.first += sample_squared * smoothing_factor;
+    result.second = std::max(result.second, sample_squared);
+  }
+
+  return result;
+}
+
+float DotProduct_SSE(const float a[], const float b[], int len) {
+  const int rem = len % 4;
+  const int last_index = len - rem;
+  __m128 sum_x4 = _mm_setzero_ps();
+  for (int i = 0; i < last_index; i += 4) {
+    sum_x4 = _mm_add_ps(
+        sum_x4, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+
+  // Fold the sums of the lanes together.
+  sum_x4 = _mm_add_ps(sum_x4, _mm_movehl_ps(sum_x4, sum_x4));
+  sum_x4 = _mm_add_ss(sum_x4, _mm_shuffle_ps(sum_x4, sum_x4, 1));
+  float sum = _mm_cvtss_f32(sum_x4);
+
+  // Handle any remaining values that wouldn't fit in an SSE pass.
+  for (int i = last_index; i < len; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+
+AVX_TARGET float DotProduct_AVX(const float a[], const float b[], int len) {
+  const int rem = len % 8;
+  const int last_index = len - rem;
+  __m256 sum_x8 = _mm256_setzero_ps();
+  for (int i = 0; i < last_index; i += 8) {
+    sum_x8 = _mm256_add_ps(sum_x8, _mm256_mul_ps(_mm256_loadu_ps(a + i),
+                                                 _mm256_loadu_ps(b + i)));
+  }
+
+  // Fold the sums of the lanes together.
+  __m128 sum_x4 = _mm_add_ps(_mm256_castps256_ps128(sum_x8),
+                             _mm256_extractf128_ps(sum_x8, 1));
+  sum_x4 = _mm_add_ps(sum_x4, _mm_movehl_ps(sum_x4, sum_x4));
+  sum_x4 = _mm_add_ss(sum_x4, _mm_shuffle_ps(sum_x4, sum_x4, 1));
+  float sum = _mm_cvtss_f32(sum_x4);
+
+  // Handle any remaining values that wouldn't fit in an AVX pass.
+  for (int i = last_index; i < len; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
 #endif
 
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
@@ -285,6 +467,24 @@ std::pair<float, float> EWMAAndMaxPower_NEON(
 
   return result;
 }
+
+float DotProduct_NEON(const float a[], const float b[], int len) {
+  const int rem = len % 4;
+  const int last_index = len - rem;
+  float32x4_t sum_x4 = vdupq_n_f32(0.0f);
+  for (int i = 0; i < last_index; i += 4)
+    sum_x4 = vmlaq_f32(sum_x4, vld1q_f32(a + i), vld1q_f32(b + i));
+
+  // Fold the sums of the lanes together.
+  float32x2_t sum_x2 = vadd_f32(vget_low_f32(sum_x4), vget_high_f32(sum_x4));
+  sum_x2 = vpadd_f32(sum_x2, sum_x2);
+  float sum = vget_lane_f32(sum_x2, 0);
+
+  // Handle any remaining values that wouldn't fit in an NEON pass.
+  for (int i = last_index; i < len; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
 #endif
 
 }  // namespace vector_math
@@ -15,6 +15,11 @@ namespace vector_math {
 // Required alignment for inputs and outputs to all vector math functions
 enum { kRequiredAlignment = 16 };
 
+// Selects the fastest versions of the functions below that the CPU supports,
+// which are otherwise picked at compile time. Called by
+// InitializeMediaLibrary(), before any other thread uses these functions.
+MEDIA_EXPORT void InitializeCPUSpecificFeatures();
+
 // Multiply each element of |src| (up to |len|) by |scale| and add to |dest|.
 // |src| and |dest| must be aligned by kRequiredAlignment.
 MEDIA_EXPORT void FMAC(const float src[], float scale, int len, float dest[]);
@@ -35,6 +40,10 @@ MEDIA_EXPORT std::pair<float, float> EWMAAndMaxPower(
 
 MEDIA_EXPORT void Crossfade(const float src[], int len, float dest[]);
 
+// Returns the sum of the products of the first |len| elements of |a| and |b|.
+// Unlike the functions above, |a| and |b| don't need to be aligned.
+MEDIA_EXPORT float DotProduct(const float a[], const float b[], int len);
+
 }  // namespace vector_math
 }  // namespace media
 
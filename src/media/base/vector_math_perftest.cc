@@ -4,6 +4,7 @@
 
 #include <memory>
 
+#include "base/cpu.h"
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
 #include "base/time/time.h"
@@ -75,6 +76,28 @@ class VectorMathPerfTest : public testing::Test {
                            true);
   }
 
+  void RunDotProductBenchmark(float (*fn)(const float[], const float[], int),
+                              const std::string& trace_name) {
+    float sum = 0.0f;
+    TimeTicks start = TimeTicks::Now();
+    for (int i = 0; i < kBenchmarkIterations; ++i) {
+      // Offsetting the inputs by a frame, like WSOLA candidates, makes them
+      // unaligned.
+      sum += fn(input_vector_.get() + 1, output_vector_.get(),
+                kVectorSize - 1);
+    }
+    double total_time_milliseconds =
+        (TimeTicks::Now() - start).InMillisecondsF();
+    // Use |sum| so the calls can't be optimized out.
+    EXPECT_EQ(0.0f, sum);
+    perf_test::PrintResult("vector_math_dot_product",
+                           "",
+                           trace_name,
+                           kBenchmarkIterations / total_time_milliseconds,
+                           "runs/ms",
+                           true);
+  }
+
  protected:
   std::unique_ptr<float, base::AlignedFreeDeleter> input_vector_;
   std::unique_ptr<float, base::AlignedFreeDeleter> output_vector_;
@@ -110,6 +133,14 @@ TEST_F(VectorMathPerfTest, FMAC) {
   RunBenchmark(
       vector_math::FMAC_FUNC, true, "vector_math_fmac", "optimized_aligned");
 #endif
+#if defined(ARCH_CPU_X86_FAMILY)
+  if (base::CPU().has_avx()) {
+    RunBenchmark(
+        vector_math::FMAC_AVX, false, "vector_math_fmac", "avx_unaligned");
+    RunBenchmark(
+        vector_math::FMAC_AVX, true, "vector_math_fmac", "avx_aligned");
+  }
+#endif
 }
 
 // Benchmark for each optimized vector_math::FMUL() method.
@@ -129,6 +160,14 @@ TEST_F(VectorMathPerfTest, FMUL) {
   RunBenchmark(
       vector_math::FMUL_FUNC, true, "vector_math_fmul", "optimized_aligned");
 #endif
+#if defined(ARCH_CPU_X86_FAMILY)
+  if (base::CPU().has_avx()) {
+    RunBenchmark(
+        vector_math::FMUL_AVX, false, "vector_math_fmul", "avx_unaligned");
+    RunBenchmark(
+        vector_math::FMUL_AVX, true, "vector_math_fmul", "avx_aligned");
+  }
+#endif
 }
 
 // Benchmark for each optimized vector_math::EWMAAndMaxPower() method.
@@ -154,6 +193,31 @@ TEST_F(VectorMathPerfTest, EWMAAndMaxPower) {
                "vector_math_ewma_and_max_power",
                "optimized_aligned");
 #endif
+#if defined(ARCH_CPU_X86_FAMILY)
+  if (base::CPU().has_avx()) {
+    RunBenchmark(vector_math::EWMAAndMaxPower_AVX,
+                 kVectorSize - 1,
+                 "vector_math_ewma_and_max_power",
+                 "avx_unaligned");
+    RunBenchmark(vector_math::EWMAAndMaxPower_AVX,
+                 kVectorSize,
+                 "vector_math_ewma_and_max_power",
+                 "avx_aligned");
+  }
+#endif
+}
+
+// Benchmark for each optimized vector_math::DotProduct() method, which
+// AudioRendererAlgorithm uses to search for the best overlap.
+TEST_F(VectorMathPerfTest, DotProduct) {
+  RunDotProductBenchmark(vector_math::DotProduct_C, "unoptimized");
+#if defined(ARCH_CPU_X86_FAMILY)
+  RunDotProductBenchmark(vector_math::DotProduct_SSE, "sse");
+  if (base::CPU().has_avx())
+    RunDotProductBenchmark(vector_math::DotProduct_AVX, "avx");
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+  RunDotProductBenchmark(vector_math::DotProduct_NEON, "neon");
+#endif
 }
 
 } // namespace media
@@ -8,6 +8,7 @@
 
 #include <memory>
 
+#include "base/cpu.h"
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
 #include "base/strings/string_number_conversions.h"
@@ -84,6 +85,14 @@ TEST_F(VectorMathTest, FMAC) {
         input_vector_.get(), kScale, kVectorSize, output_vector_.get());
     VerifyOutput(kResult);
   }
+
+  if (base::CPU().has_avx()) {
+    SCOPED_TRACE("FMAC_AVX");
+    FillTestVectors(kInputFillValue, kOutputFillValue);
+    vector_math::FMAC_AVX(
+        input_vector_.get(), kScale, kVectorSize, output_vector_.get());
+    VerifyOutput(kResult);
+  }
 #endif
 
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
@@ -125,6 +134,14 @@ TEST_F(VectorMathTest, FMUL) {
         input_vector_.get(), kScale, kVectorSize, output_vector_.get());
     VerifyOutput(kResult);
   }
+
+  if (base::CPU().has_avx()) {
+    SCOPED_TRACE("FMUL_AVX");
+    FillTestVectors(kInputFillValue, kOutputFillValue);
+    vector_math::FMUL_AVX(
+        input_vector_.get(), kScale, kVectorSize, output_vector_.get());
+    VerifyOutput(kResult);
+  }
 #endif
 
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
@@ -148,6 +165,29 @@ TEST_F(VectorMathTest, Crossfade) {
   }
 }
 
+// Ensure each optimized vector_math::DotProduct() method returns the same
+// value, for inputs that aren't aligned.
+TEST_F(VectorMathTest, DotProduct) {
+  static const int kLength = kVectorSize - 1;
+  static const float kResult = kInputFillValue * kOutputFillValue * kLength;
+  FillTestVectors(kInputFillValue, kOutputFillValue);
+  const float* a = input_vector_.get() + 1;
+  const float* b = output_vector_.get() + 1;
+
+  EXPECT_FLOAT_EQ(kResult, vector_math::DotProduct(a, b, kLength));
+  EXPECT_FLOAT_EQ(kResult, vector_math::DotProduct_C(a, b, kLength));
+
+#if defined(ARCH_CPU_X86_FAMILY)
+  EXPECT_FLOAT_EQ(kResult, vector_math::DotProduct_SSE(a, b, kLength));
+  if (base::CPU().has_avx())
+    EXPECT_FLOAT_EQ(kResult, vector_math::DotProduct_AVX(a, b, kLength));
+#endif
+
+#if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+  EXPECT_FLOAT_EQ(kResult, vector_math::DotProduct_NEON(a, b, kLength));
+#endif
+}
+
 class EWMATestScenario {
  public:
   EWMATestScenario(float initial_value, const float src[], int len,
@@ -233,6 +273,14 @@ class EWMATestScenario {
       EXPECT_NEAR(expected_final_avg_, result.first, 0.0000001f);
       EXPECT_NEAR(expected_max_, result.second, 0.0000001f);
     }
+
+    if (base::CPU().has_avx()) {
+      SCOPED_TRACE("EWMAAndMaxPower_AVX");
+      const std::pair<float, float>& result = vector_math::EWMAAndMaxPower_AVX(
+          initial_value_, data_.get(), data_len_, smoothing_factor_);
+      EXPECT_NEAR(expected_final_avg_, result.first, 0.0000001f);
+      EXPECT_NEAR(expected_max_, result.second, 0.0000001f);
+    }
 #endif
 
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
@@ -13,6 +13,41 @@
 
 namespace media {
 
+namespace {
+
+// How much larger than a request, in each dimension, a pooled frame can be
+// and still be reused: 1.5x covers a step of the usual adaptive streaming
+// ladders, like 1080p to 720p or 720p to 480p.
+const int kMaxReuseSlackNumerator = 3;
+const int kMaxReuseSlackDenominator = 2;
+
+bool CanReuseFrame(const VideoFrame& frame,
+                   VideoPixelFormat format,
+                   const gfx::Size& coded_size,
+                   const gfx::Rect& visible_rect) {
+  if (frame.format() != format)
+    return false;
+  const gfx::Size& frame_size = frame.coded_size();
+  if (frame_size == coded_size && frame.visible_rect().Contains(visible_rect))
+    return true;
+
+  // Other frames are exposed with the requested size by wrapping their planes,
+  // which is only done for the planar YUV formats.
+  if (format != PIXEL_FORMAT_YV12 && format != PIXEL_FORMAT_I420 &&
+      format != PIXEL_FORMAT_YV16 && format != PIXEL_FORMAT_YV24 &&
+      format != PIXEL_FORMAT_YV12A) {
+    return false;
+  }
+  return frame_size.width() >= coded_size.width() &&
+         frame_size.height() >= coded_size.height() &&
+         frame_size.width() * kMaxReuseSlackDenominator <=
+             coded_size.width() * kMaxReuseSlackNumerator &&
+         frame_size.height() * kMaxReuseSlackDenominator <=
+             coded_size.height() * kMaxReuseSlackNumerator;
+}
+
+}  // namespace
+
 class VideoFramePool::PoolImpl
     : public base::RefCountedThreadSafe<VideoFramePool::PoolImpl> {
  public:
@@ -63,30 +98,58 @@ scoped_refptr<VideoFrame> VideoFramePool::PoolImpl::CreateFrame(
   base::AutoLock auto_lock(lock_);
   DCHECK(!is_shutdown_);
 
-  scoped_refptr<VideoFrame> frame;
-  while (!frame.get() && !frames_.empty()) {
-      scoped_refptr<VideoFrame> pool_frame = frames_.front();
-      frames_.pop_front();
-
-      if (pool_frame->format() == format &&
-          pool_frame->coded_size() == coded_size &&
-          pool_frame->visible_rect() == visible_rect &&
-          pool_frame->natural_size() == natural_size) {
-        frame = pool_frame;
-        frame->set_timestamp(timestamp);
-        frame->metadata()->Clear();
-        break;
-      }
+  // Take the smallest frame that fits, and drop the ones that don't.
+  std::list<scoped_refptr<VideoFrame>>::iterator best_frame = frames_.end();
+  for (auto it = frames_.begin(); it != frames_.end();) {
+    if (!CanReuseFrame(**it, format, coded_size, visible_rect)) {
+      it = frames_.erase(it);
+      continue;
+    }
+    if (best_frame == frames_.end() ||
+        (*it)->coded_size().GetArea() < (*best_frame)->coded_size().GetArea()) {
+      best_frame = it;
+    }
+    ++it;
   }
 
-  if (!frame.get()) {
+  scoped_refptr<VideoFrame> frame;
+  if (best_frame != frames_.end()) {
+    frame = *best_frame;
+    frames_.erase(best_frame);
+    frame->metadata()->Clear();
+  } else {
     frame = VideoFrame::CreateZeroInitializedFrame(
         format, coded_size, visible_rect, natural_size, timestamp);
-    LOG_IF(ERROR, !frame.get()) << "Failed to create a video frame";
+    if (!frame.get()) {
+      LOG(ERROR) << "Failed to create a video frame";
+      return nullptr;
+    }
   }
 
-  scoped_refptr<VideoFrame> wrapped_frame = VideoFrame::WrapVideoFrame(
-      frame, frame->format(), frame->visible_rect(), frame->natural_size());
+  scoped_refptr<VideoFrame> wrapped_frame;
+  if (frame->coded_size() == coded_size &&
+      frame->visible_rect().Contains(visible_rect)) {
+    wrapped_frame = VideoFrame::WrapVideoFrame(frame, frame->format(),
+                                               visible_rect, natural_size);
+  } else if (format == PIXEL_FORMAT_YV12A) {
+    wrapped_frame = VideoFrame::WrapExternalYuvaData(
+        format, coded_size, visible_rect, natural_size,
+        frame->stride(VideoFrame::kYPlane), frame->stride(VideoFrame::kUPlane),
+        frame->stride(VideoFrame::kVPlane), frame->stride(VideoFrame::kAPlane),
+        frame->data(VideoFrame::kYPlane), frame->data(VideoFrame::kUPlane),
+        frame->data(VideoFrame::kVPlane), frame->data(VideoFrame::kAPlane),
+        timestamp);
+  } else {
+    wrapped_frame = VideoFrame::WrapExternalYuvData(
+        format, coded_size, visible_rect, natural_size,
+        frame->stride(VideoFrame::kYPlane), frame->stride(VideoFrame::kUPlane),
+        frame->stride(VideoFrame::kVPlane), frame->data(VideoFrame::kYPlane),
+        frame->data(VideoFrame::kUPlane), frame->data(VideoFrame::kVPlane),
+        timestamp);
+  }
+  if (!wrapped_frame)
+    return nullptr;
+  wrapped_frame->set_timestamp(timestamp);
   wrapped_frame->AddDestructionObserver(
       base::Bind(&VideoFramePool::PoolImpl::FrameReleased, this, frame));
   return wrapped_frame;
@@ -19,8 +19,12 @@ namespace media {
 // the memory is returned to the pool for use by a subsequent CreateFrame()
 // call. The memory in the pool is retained for the life of the
 // VideoFramePool object. If the parameters passed to CreateFrame() change
-// during the life of this object, then the memory used by frames with the old
-// parameter values will be purged from the pool.
+// during the life of this object, then the memory used by frames that can't
+// hold the new ones will be purged from the pool.
+//
+// Frames a little larger than requested are reused as they are, with the
+// strides of their larger size, so that the memory survives the resolution
+// switches of adaptive streams.
 class MEDIA_EXPORT VideoFramePool {
  public:
   VideoFramePool();
@@ -28,7 +32,8 @@ class MEDIA_EXPORT VideoFramePool {
 
   // Returns a frame from the pool that matches the specified
   // parameters or creates a new frame if no suitable frame exists in
-  // the pool. The pool is drained if no matching frame is found.
+  // the pool. Frames in the pool that can't be reused for these parameters
+  // are dropped.
   // The buffer for the new frame will be zero initialized.  Reused frames will
   // not be zero initialized.
   scoped_refptr<VideoFrame> CreateFrame(VideoPixelFormat format,
@@ -17,7 +17,12 @@ class VideoFramePoolTest : public ::testing::Test {
 
   scoped_refptr<VideoFrame> CreateFrame(VideoPixelFormat format,
                                         int timestamp_ms) {
-    gfx::Size coded_size(320,240);
+    return CreateFrameWithSize(format, gfx::Size(320, 240), timestamp_ms);
+  }
+
+  scoped_refptr<VideoFrame> CreateFrameWithSize(VideoPixelFormat format,
+                                                const gfx::Size& coded_size,
+                                                int timestamp_ms) {
     gfx::Rect visible_rect(coded_size);
     gfx::Size natural_size(coded_size);
 
@@ -80,6 +85,45 @@ TEST_F(VideoFramePoolTest, SimpleFormatChange) {
   CheckPoolSize(0u);
 }
 
+TEST_F(VideoFramePoolTest, SlightlyLargerFrameReuse) {
+  scoped_refptr<VideoFrame> frame =
+      CreateFrameWithSize(PIXEL_FORMAT_YV12, gfx::Size(640, 480), 10);
+  const uint8_t* old_y_data = frame->data(VideoFrame::kYPlane);
+  const int old_y_stride = frame->stride(VideoFrame::kYPlane);
+  frame = NULL;
+
+  // Verify that a frame fitting in the old one reuses its memory and strides.
+  scoped_refptr<VideoFrame> new_frame =
+      CreateFrameWithSize(PIXEL_FORMAT_YV12, gfx::Size(480, 360), 20);
+  EXPECT_EQ(old_y_data, new_frame->data(VideoFrame::kYPlane));
+  EXPECT_EQ(old_y_stride, new_frame->stride(VideoFrame::kYPlane));
+}
+
+TEST_F(VideoFramePoolTest, MuchLargerFrameNotReused) {
+  scoped_refptr<VideoFrame> frame =
+      CreateFrameWithSize(PIXEL_FORMAT_YV12, gfx::Size(640, 480), 10);
+  frame = NULL;
+  CheckPoolSize(1u);
+
+  // Verify that a frame too much larger than requested is dropped.
+  scoped_refptr<VideoFrame> new_frame = CreateFrame(PIXEL_FORMAT_YV12, 20);
+  CheckPoolSize(0u);
+}
+
+TEST_F(VideoFramePoolTest, SmallestFittingFrameReused) {
+  scoped_refptr<VideoFrame> large_frame =
+      CreateFrameWithSize(PIXEL_FORMAT_YV12, gfx::Size(400, 300), 10);
+  scoped_refptr<VideoFrame> frame = CreateFrame(PIXEL_FORMAT_YV12, 10);
+  const uint8_t* old_y_data = frame->data(VideoFrame::kYPlane);
+  large_frame = NULL;
+  frame = NULL;
+  CheckPoolSize(2u);
+
+  scoped_refptr<VideoFrame> new_frame = CreateFrame(PIXEL_FORMAT_YV12, 20);
+  EXPECT_EQ(old_y_data, new_frame->data(VideoFrame::kYPlane));
+  CheckPoolSize(1u);
+}
+
 TEST_F(VideoFramePoolTest, FrameValidAfterPoolDestruction) {
   scoped_refptr<VideoFrame> frame = CreateFrame(PIXEL_FORMAT_YV12, 10);
 
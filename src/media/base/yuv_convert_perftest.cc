@@ -5,6 +5,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
 
 #include "base/base_paths.h"
 #include "base/cpu.h"
@@ -18,6 +19,7 @@
 #include "media/base/yuv_convert.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
+#include "third_party/libyuv/include/libyuv/convert_argb.h"
 #include "third_party/libyuv/include/libyuv/row.h"
 
 namespace media {
@@ -219,4 +221,89 @@ TEST_F(YUVConvertPerfTest, LinearScaleYUVToRGB32Row_SSE) {
 
 #endif  // !defined(ARCH_CPU_ARM_FAMILY) && !defined(ARCH_CPU_MIPS_FAMILY)
 
+// The frame tests below go through the public functions, so they measure
+// whichever of the C, x86 or NEON versions the CPU selected.
+static const int k1080pWidth = 1920;
+static const int k1080pHeight = 1080;
+static const int k720pWidth = 1280;
+static const int k720pHeight = 720;
+static const int kFrameBpp = 4;
+static const int kFrameIterations = 100;
+
+class YUVConvert1080pPerfTest : public testing::Test {
+ public:
+  YUVConvert1080pPerfTest()
+      : y_plane_(new uint8_t[k1080pWidth * k1080pHeight]),
+        u_plane_(new uint8_t[k1080pWidth / 2 * k1080pHeight / 2]),
+        v_plane_(new uint8_t[k1080pWidth / 2 * k1080pHeight / 2]),
+        rgb_frame_(new uint8_t[k1080pWidth * k1080pHeight * kFrameBpp]) {
+    // The content doesn't change the cost of the conversions, but gradients
+    // keep the scalers from seeing flat rows.
+    for (int y = 0; y < k1080pHeight; ++y) {
+      for (int x = 0; x < k1080pWidth; ++x)
+        y_plane_[y * k1080pWidth + x] = (x + y) & 0xff;
+    }
+    for (int y = 0; y < k1080pHeight / 2; ++y) {
+      for (int x = 0; x < k1080pWidth / 2; ++x) {
+        u_plane_[y * k1080pWidth / 2 + x] = x & 0xff;
+        v_plane_[y * k1080pWidth / 2 + x] = y & 0xff;
+      }
+    }
+  }
+
+ protected:
+  void PrintFramesPerSecond(const std::string& trace,
+                            base::TimeTicks start) {
+    perf_test::PrintResult(
+        "yuv_convert_perftest", "", trace,
+        kFrameIterations / (base::TimeTicks::Now() - start).InSecondsF(),
+        "frames/s", true);
+  }
+
+  std::unique_ptr<uint8_t[]> y_plane_;
+  std::unique_ptr<uint8_t[]> u_plane_;
+  std::unique_ptr<uint8_t[]> v_plane_;
+  std::unique_ptr<uint8_t[]> rgb_frame_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(YUVConvert1080pPerfTest);
+};
+
+TEST_F(YUVConvert1080pPerfTest, ConvertYUVToRGB32) {
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kFrameIterations; ++i) {
+    ConvertYUVToRGB32(y_plane_.get(), u_plane_.get(), v_plane_.get(),
+                      rgb_frame_.get(), k1080pWidth, k1080pHeight,
+                      k1080pWidth, k1080pWidth / 2, k1080pWidth * kFrameBpp,
+                      YV12);
+  }
+  EmptyRegisterState();
+  PrintFramesPerSecond("ConvertYUVToRGB32_1080p", start);
+}
+
+TEST_F(YUVConvert1080pPerfTest, ScaleYUVToRGB32To720p) {
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kFrameIterations; ++i) {
+    ScaleYUVToRGB32(y_plane_.get(), u_plane_.get(), v_plane_.get(),
+                    rgb_frame_.get(), k1080pWidth, k1080pHeight, k720pWidth,
+                    k720pHeight, k1080pWidth, k1080pWidth / 2,
+                    k720pWidth * kFrameBpp, YV12, ROTATE_0, FILTER_BILINEAR);
+  }
+  EmptyRegisterState();
+  PrintFramesPerSecond("ScaleYUVToRGB32_1080p_to_720p_bilinear", start);
+}
+
+// For comparison with ConvertYUVToRGB32, libyuv is what the video renderers
+// use.
+TEST_F(YUVConvert1080pPerfTest, I420ToARGB) {
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kFrameIterations; ++i) {
+    libyuv::I420ToARGB(y_plane_.get(), k1080pWidth, u_plane_.get(),
+                       k1080pWidth / 2, v_plane_.get(), k1080pWidth / 2,
+                       rgb_frame_.get(), k1080pWidth * kFrameBpp, k1080pWidth,
+                       k1080pHeight);
+  }
+  PrintFramesPerSecond("I420ToARGB_1080p", start);
+}
+
 }  // namespace media
@@ -873,4 +873,125 @@ TEST(YUVConvertTest, LinearScaleYUVToRGB32Row_MMX_X64) {
 
 #endif  // defined(ARCH_CPU_X86_FAMILY)
 
+#if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+TEST(YUVConvertTest, ConvertYUVToRGB32Row_NEON) {
+  std::unique_ptr<uint8_t[]> yuv_bytes(new uint8_t[kYUV12Size]);
+  std::unique_ptr<uint8_t[]> rgb_bytes_reference(new uint8_t[kRGBSize]);
+  std::unique_ptr<uint8_t[]> rgb_bytes_converted(new uint8_t[kRGBSize]);
+  ReadYV12Data(&yuv_bytes);
+
+  const int kWidth = 167;
+  ConvertYUVToRGB32Row_C(yuv_bytes.get(),
+                         yuv_bytes.get() + kSourceUOffset,
+                         yuv_bytes.get() + kSourceVOffset,
+                         rgb_bytes_reference.get(),
+                         kWidth,
+                         GetLookupTable(YV12));
+  ConvertYUVToRGB32Row_NEON(yuv_bytes.get(),
+                            yuv_bytes.get() + kSourceUOffset,
+                            yuv_bytes.get() + kSourceVOffset,
+                            rgb_bytes_converted.get(),
+                            kWidth,
+                            GetLookupTable(YV12));
+  EXPECT_EQ(0, memcmp(rgb_bytes_reference.get(),
+                      rgb_bytes_converted.get(),
+                      kWidth * kBpp));
+}
+
+TEST(YUVConvertTest, ScaleYUVToRGB32Row_NEON) {
+  std::unique_ptr<uint8_t[]> yuv_bytes(new uint8_t[kYUV12Size]);
+  std::unique_ptr<uint8_t[]> rgb_bytes_reference(new uint8_t[kRGBSize]);
+  std::unique_ptr<uint8_t[]> rgb_bytes_converted(new uint8_t[kRGBSize]);
+  ReadYV12Data(&yuv_bytes);
+
+  const int kWidth = 167;
+  const int kSourceDx = 80000;  // This value means a scale down.
+  ScaleYUVToRGB32Row_C(yuv_bytes.get(),
+                       yuv_bytes.get() + kSourceUOffset,
+                       yuv_bytes.get() + kSourceVOffset,
+                       rgb_bytes_reference.get(),
+                       kWidth,
+                       kSourceDx,
+                       GetLookupTable(YV12));
+  ScaleYUVToRGB32Row_NEON(yuv_bytes.get(),
+                          yuv_bytes.get() + kSourceUOffset,
+                          yuv_bytes.get() + kSourceVOffset,
+                          rgb_bytes_converted.get(),
+                          kWidth,
+                          kSourceDx,
+                          GetLookupTable(YV12));
+  EXPECT_EQ(0, memcmp(rgb_bytes_reference.get(),
+                      rgb_bytes_converted.get(),
+                      kWidth * kBpp));
+}
+
+TEST(YUVConvertTest, LinearScaleYUVToRGB32Row_NEON) {
+  std::unique_ptr<uint8_t[]> yuv_bytes(new uint8_t[kYUV12Size]);
+  std::unique_ptr<uint8_t[]> rgb_bytes_reference(new uint8_t[kRGBSize]);
+  std::unique_ptr<uint8_t[]> rgb_bytes_converted(new uint8_t[kRGBSize]);
+  ReadYV12Data(&yuv_bytes);
+
+  const int kWidth = 167;
+  const int kSourceDx = 80000;  // This value means a scale down.
+  LinearScaleYUVToRGB32Row_C(yuv_bytes.get(),
+                             yuv_bytes.get() + kSourceUOffset,
+                             yuv_bytes.get() + kSourceVOffset,
+                             rgb_bytes_reference.get(),
+                             kWidth,
+                             kSourceDx,
+                             GetLookupTable(YV12));
+  LinearScaleYUVToRGB32Row_NEON(yuv_bytes.get(),
+                                yuv_bytes.get() + kSourceUOffset,
+                                yuv_bytes.get() + kSourceVOffset,
+                                rgb_bytes_converted.get(),
+                                kWidth,
+                                kSourceDx,
+                                GetLookupTable(YV12));
+  EXPECT_EQ(0, memcmp(rgb_bytes_reference.get(),
+                      rgb_bytes_converted.get(),
+                      kWidth * kBpp));
+}
+
+TEST(YUVConvertTest, FilterYUVRows_NEON_OutOfBounds) {
+  std::unique_ptr<uint8_t[]> src(new uint8_t[16]);
+  std::unique_ptr<uint8_t[]> dst(new uint8_t[16]);
+
+  memset(src.get(), 0xff, 16);
+  memset(dst.get(), 0, 16);
+
+  media::FilterYUVRows_NEON(dst.get(), src.get(), src.get(), 1, 255);
+
+  EXPECT_EQ(255u, dst[0]);
+  for (int i = 1; i < 16; ++i) {
+    EXPECT_EQ(0u, dst[i]);
+  }
+}
+
+TEST(YUVConvertTest, FilterYUVRows_NEON_MatchReference) {
+  const int kSize = 64;
+  std::unique_ptr<uint8_t[]> src0(new uint8_t[kSize]);
+  std::unique_ptr<uint8_t[]> src1(new uint8_t[kSize]);
+  std::unique_ptr<uint8_t[]> dst_sample(new uint8_t[kSize]);
+  std::unique_ptr<uint8_t[]> dst(new uint8_t[kSize]);
+
+  for (int i = 0; i < kSize; ++i) {
+    src0[i] = 100 + i;
+    src1[i] = 255 - 3 * i;
+  }
+
+  // Zero is handled separately since its weight for |src0| is 256.
+  const uint8_t kFractions[] = {0, 1, 128, 255};
+  for (uint8_t fraction : kFractions) {
+    memset(dst_sample.get(), 0, kSize);
+    memset(dst.get(), 0, kSize);
+    media::FilterYUVRows_C(dst_sample.get(), src0.get(), src1.get(), 37,
+                           fraction);
+    media::FilterYUVRows_NEON(dst.get(), src0.get(), src1.get(), 37,
+                              fraction);
+    EXPECT_EQ(0, memcmp(dst_sample.get(), dst.get(), kSize))
+        << "fraction " << static_cast<int>(fraction);
+  }
+}
+#endif  // defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+
 }  // namespace media
@@ -115,6 +115,8 @@
             'webos/media_info_loader.h',
             'webos/umediaclient_impl.cc',
             'webos/umediaclient_impl.h',
+            'webos/umediaclient_pool.cc',
+            'webos/umediaclient_pool.h',
             'webos/webmediaplayer_ums.cc',
             'webos/webmediaplayer_ums.h',
             'webos/webmediaplayer_mse.cc',
@@ -23,6 +23,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/task_runner_util.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "cc/blink/web_layer_impl.h"
@@ -246,6 +247,12 @@ WebMediaPlayerImpl::~WebMediaPlayerImpl() {
   // Pipeline must be stopped before it is destroyed.
   pipeline_.Stop();
 
+  if (chunk_demuxer_) {
+    memory_pressure_listener_.reset();
+    base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+        chunk_demuxer_);
+  }
+
   if (last_reported_memory_usage_)
     adjust_allocated_memory_cb_.Run(-last_reported_memory_usage_);
 
@@ -769,19 +776,24 @@ bool WebMediaPlayerImpl::copyVideoTextureToPlatformTexture(
     unsigned int type,
     bool premultiply_alpha,
     bool flip_y) {
+  DCHECK(main_task_runner_->BelongsToCurrentThread());
   TRACE_EVENT0("media", "WebMediaPlayerImpl:copyVideoTextureToPlatformTexture");
 
   scoped_refptr<VideoFrame> video_frame = GetCurrentFrameFromCompositor();
 
-  if (!video_frame.get() || !video_frame->HasTextures() ||
-      media::VideoFrame::NumPlanes(video_frame->format()) != 1) {
+  if (!video_frame.get() || !video_frame->HasTextures())
     return false;
-  }
 
-  SkCanvasVideoRenderer::CopyVideoFrameSingleTextureToGLTexture(
-      gl, video_frame.get(), texture, internal_format, type, premultiply_alpha,
-      flip_y);
-  return true;
+  // Frames with one texture per plane are converted to RGB in the shared main
+  // thread context.
+  Context3D context_3d;
+  if (media::VideoFrame::NumPlanes(video_frame->format()) > 1 &&
+      !context_3d_cb_.is_null()) {
+    context_3d = context_3d_cb_.Run();
+  }
+  return skcanvas_video_renderer_.CopyVideoFrameTexturesToGLTexture(
+      context_3d, gl, video_frame, texture, internal_format, type,
+      premultiply_alpha, flip_y);
 }
 
 void WebMediaPlayerImpl::setContentDecryptionModule(
@@ -1338,6 +1350,14 @@ void WebMediaPlayerImpl::StartPipeline() {
         BIND_TO_RENDER_LOOP(&WebMediaPlayerImpl::OnDemuxerOpened),
         encrypted_media_init_data_cb, media_log_, true);
     demuxer_.reset(chunk_demuxer_);
+
+    // |chunk_demuxer_| is destroyed on the main thread, after both of these
+    // are unregistered in ~WebMediaPlayerImpl().
+    memory_pressure_listener_.reset(new base::MemoryPressureListener(
+        base::Bind(&ChunkDemuxer::OnMemoryPressure,
+                   base::Unretained(chunk_demuxer_))));
+    base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+        chunk_demuxer_, "ChunkDemuxer", main_task_runner_);
   }
 
   // TODO(sandersd): FileSystem objects may also be non-static, but due to our
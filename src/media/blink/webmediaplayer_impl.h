@@ -15,6 +15,7 @@
 #include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "base/memory/linked_ptr.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/threading/thread.h"
@@ -463,6 +464,9 @@ class MEDIA_BLINK_EXPORT WebMediaPlayerImpl
   std::unique_ptr<Demuxer> demuxer_;
   ChunkDemuxer* chunk_demuxer_;
 
+  // Lowers the memory limits of |chunk_demuxer_| under memory pressure.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   BufferedDataSourceHostImpl buffered_data_source_host_;
   linked_ptr<UrlIndex> url_index_;
 
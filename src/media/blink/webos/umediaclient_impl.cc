@@ -8,13 +8,16 @@
 #include <algorithm>
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/callback.h"
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/logging.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_util.h"
+#include "base/trace_event/trace_event.h"
 #include "media/base/bind_to_current_loop.h"
+#include "media/blink/webos/umediaclient_pool.h"
 #include "media/webos/base/starfish_media_pipeline_error.h"
 #include "third_party/jsoncpp/source/include/json/json.h"
 
@@ -29,6 +32,16 @@ static const char* kRtspUrl = "rtsp://";
 
 namespace media {
 
+namespace {
+
+// Callbacks of a standby pipeline, until a player adopts it.
+void IgnoreString(const std::string&) {}
+void IgnoreBool(bool) {}
+void IgnorePipelineStatus(media::PipelineStatus) {}
+void IgnoreBufferingState(UMediaClientImpl::BufferingState) {}
+
+}  // namespace
+
 #define BIND_TO_RENDER_LOOP(function) \
   (DCHECK(media_task_runner_->BelongsToCurrentThread()), \
   media::BindToCurrentLoop(base::Bind(function, AsWeakPtr())))
@@ -54,6 +67,8 @@ UMediaClientImpl::UMediaClientImpl(
       buffering_(false),
       requests_play_(false),
       requests_pause_(false),
+      standby_(false),
+      zap_in_progress_(false),
       playback_rate_(0),
       playback_rate_on_eos_(0),
       playback_rate_on_paused_(0),
@@ -64,7 +79,12 @@ UMediaClientImpl::UMediaClientImpl(
 }
 
 UMediaClientImpl::~UMediaClientImpl() {
-  if (!mediaId().empty() && loaded_) {
+  if (zap_in_progress_) {
+    TRACE_EVENT_ASYNC_END1("media", "UMediaClientImpl::Zap", this,
+                           "aborted", true);
+  }
+  // Standby pipelines may be dropped from UMediaClientPool while preloaded.
+  if (!mediaId().empty() && (loaded_ || (standby_ && preloaded_))) {
     uMediaServer::uMediaClient::unload();
   }
 }
@@ -91,6 +111,31 @@ void UMediaClientImpl::load(bool video,
   DEBUG_LOG("url - %s", url.c_str());
   DEBUG_LOG("payload - %s", payload.empty()?"{}":payload.c_str());
 
+  // Spans the switch to |url| up to the first frame playing, so benchmarks
+  // can tell the zap latency and how much a standby pipeline saved.
+  zap_in_progress_ = true;
+  TRACE_EVENT_ASYNC_BEGIN1("media", "UMediaClientImpl::Zap", this, "standby",
+                           standby_);
+
+  if (standby_) {
+    // Adopted from UMediaClientPool: the pipeline is already preloaded (or
+    // preloading) for |url|, attach the player and report what happened.
+    DCHECK_EQ(url_, url);
+    standby_ = false;
+    playback_state_cb_ = playback_state_cb;
+    ended_cb_ = ended_cb;
+    seek_cb_ = seek_cb;
+    error_cb_ = error_cb;
+    buffering_state_cb_ = buffering_state_cb;
+    duration_change_cb_ = duration_change_cb;
+    video_size_change_cb_ = video_size_change_cb;
+    video_display_window_change_cb_ = video_display_window_change_cb;
+    update_ums_info_cb_ = update_ums_info_cb;
+    focus_cb_ = focus_cb;
+    ReplayStandbyState();
+    return;
+  }
+
   video_ = video;
   is_local_source_ = is_local_source;
   app_id_ = app_id;
@@ -122,6 +167,78 @@ void UMediaClientImpl::load(bool video,
   } else {
     LoadInternal();
   }
+
+  // Warm up the pipelines the app expects to switch to next, e.g. the
+  // adjacent channels.
+  for (const std::string& standby_url : standby_urls_) {
+    UMediaClientPool::GetInstance()->Standby(
+        media_task_runner_, video, is_local_source, app_id, standby_url,
+        mime_type, referrer, user_agent, cookies, payload);
+  }
+}
+
+bool UMediaClientImpl::Standby(bool video,
+                               bool is_local_source,
+                               const std::string& app_id,
+                               const std::string& url,
+                               const std::string& mime_type,
+                               const std::string& referrer,
+                               const std::string& user_agent,
+                               const std::string& cookies,
+                               const std::string& payload) {
+  DEBUG_LOG("standby url - %s", url.c_str());
+  DCHECK(!load_started_);
+
+  video_ = video;
+  is_local_source_ = is_local_source;
+  app_id_ = app_id;
+  url_ = url;
+  mime_type_ = mime_type;
+  referrer_ = referrer;
+  user_agent_ = user_agent;
+  cookies_ = cookies;
+
+  playback_state_cb_ = base::Bind(&IgnoreBool);
+  ended_cb_ = base::Bind(&base::DoNothing);
+  seek_cb_ = base::Bind(&IgnorePipelineStatus);
+  error_cb_ = base::Bind(&IgnorePipelineStatus);
+  buffering_state_cb_ = base::Bind(&IgnoreBufferingState);
+  duration_change_cb_ = base::Bind(&base::DoNothing);
+  video_size_change_cb_ = base::Bind(&base::DoNothing);
+  video_display_window_change_cb_ = base::Bind(&base::DoNothing);
+  update_ums_info_cb_ = base::Bind(&IgnoreString);
+  focus_cb_ = base::Bind(&base::DoNothing);
+
+  // A standby pipeline is always a paused preload, it is loaded once the
+  // adopting player starts playback (see SetPreload and SetPlaybackRate).
+  SetPreload(PreloadMetaData);
+  updated_payload_ = updateMediaOption(payload, 0);
+  if (!use_pipeline_preload_)
+    return false;
+
+  using std::placeholders::_1;
+  set_source_info_callback(std::bind(&UMediaClientImpl::onSourceInfoCb, this, _1));
+
+  standby_ = true;
+  uMediaServer::uMediaClient::preload(url_.c_str(), kMedia,
+                                      updated_payload_.c_str());
+  return true;
+}
+
+void UMediaClientImpl::ReplayStandbyState() {
+  if (duration_)
+    duration_change_cb_.Run();
+  if (natural_video_size_ != gfx::Size())
+    video_size_change_cb_.Run();
+
+  if (!preloaded_)
+    return;
+
+  update_ums_info_cb_.Run(mediaInfoToJson(NotifyPreloadCompleted));
+  if (updated_source_info_) {
+    buffering_state_cb_.Run(UMediaClientImpl::kHaveMetadata);
+    buffering_state_cb_.Run(UMediaClientImpl::kPreloadCompleted);
+  }
 }
 
 void UMediaClientImpl::LoadInternal() {
@@ -248,6 +365,10 @@ void UMediaClientImpl::dispatchLoadCompleted() {
 
   DEBUG_LOG("%s", __FUNCTION__);
   loaded_ = true;
+  if (zap_in_progress_) {
+    TRACE_EVENT_ASYNC_STEP_INTO0("media", "UMediaClientImpl::Zap", this,
+                                 "Loaded");
+  }
 
   update_ums_info_cb_.Run(mediaInfoToJson(NotifyLoadCompleted));
 
@@ -309,6 +430,11 @@ void UMediaClientImpl::dispatchPlaying() {
   DEBUG_LOG("%s", __FUNCTION__);
   SetPlaybackVolume(volume_, true);
   requests_play_ = false;
+  if (zap_in_progress_) {
+    zap_in_progress_ = false;
+    TRACE_EVENT_ASYNC_END1("media", "UMediaClientImpl::Zap", this, "aborted",
+                           false);
+  }
 
   playback_state_cb_.Run(true);
   update_ums_info_cb_.Run(mediaInfoToJson(NotifyPlaying));
@@ -1187,6 +1313,15 @@ std::string UMediaClientImpl::updateMediaOption(
         if (media_option["htmlMediaOption"].isMember("usePipelinePreload"))
           use_pipeline_preload =
               media_option["htmlMediaOption"]["usePipelinePreload"].asBool();
+        const Json::Value& standby_urls =
+            media_option["htmlMediaOption"]["standbyUrls"];
+        standby_urls_.clear();
+        if (standby_urls.isArray()) {
+          for (const Json::Value& standby_url : standby_urls) {
+            if (standby_url.isString())
+              standby_urls_.push_back(standby_url.asString());
+          }
+        }
         media_option.removeMember("htmlMediaOption");
       }
       if (media_option.isMember("mediaTransportType")) {
@@ -20,6 +20,7 @@
 #include <string>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "base/time/time.h"
 #include "base/memory/ref_counted.h"
@@ -88,11 +89,28 @@ class UMediaClientImpl
             const base::Closure& video_display_window_change_cb,
             const UpdateUMSInfoCB& update_ums_info_cb,
             const base::Closure& focus_cb);
+  // Preloads |url| in a paused state without a player attached, so that a
+  // later load() of the same URL can adopt the warm pipeline instead of
+  // creating a new one. Returns false if the source does not support
+  // pipeline preload. See UMediaClientPool.
+  bool Standby(bool video,
+               bool is_local_source,
+               const std::string& app_id,
+               const std::string& url,
+               const std::string& mime_type,
+               const std::string& referrer,
+               const std::string& user_agent,
+               const std::string& cookies,
+               const std::string& payload);
+  bool IsStandby() const { return standby_; }
+  const std::string& url() const { return url_; }
+
   void Seek(base::TimeDelta time, const media::PipelineStatusCB& seek_cb);
   void SetPlaybackRate(float playback_rate);
   float GetPlaybackRate() const;
   void SetPlaybackVolume(double volume, bool forced = false);
   void SetPreload(Preload preload);
+  Preload preload() const { return preload_; }
   std::string mediaId() const;
 
   // implement ums virtual functions
@@ -204,6 +222,9 @@ class UMediaClientImpl
 
   bool CheckAudioOutput(float playback_rate);
   void LoadInternal();
+  // Reports to the newly attached player what a standby pipeline got while
+  // it was preloading.
+  void ReplayStandbyState();
 
   PlaybackStateCB playback_state_cb_;
   base::Closure ended_cb_;
@@ -237,6 +258,14 @@ class UMediaClientImpl
   bool buffering_;
   bool requests_play_;
   bool requests_pause_;
+  // Set while the pipeline is preloaded on behalf of UMediaClientPool and no
+  // player is attached yet.
+  bool standby_;
+  // URLs listed in htmlMediaOption.standbyUrls, preloaded next to this one.
+  std::vector<std::string> standby_urls_;
+  // Set from load() until the first playing event, while the
+  // UMediaClientImpl::Zap trace event is open.
+  bool zap_in_progress_;
   std::string media_transport_type_;
   gfx::Size natural_video_size_;
   float playback_rate_;
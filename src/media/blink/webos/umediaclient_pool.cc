@@ -0,0 +1,124 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "media/blink/webos/umediaclient_pool.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/single_thread_task_runner.h"
+#include "media/blink/webos/umediaclient_impl.h"
+
+#define INFO_LOG(format, ...) \
+  RAW_PMLOG_INFO("UMediaClientPool", ":%04d " format, __LINE__, ##__VA_ARGS__)
+
+namespace media {
+
+namespace {
+
+// Enough for the channels right above and below the current one.
+const size_t kDefaultMaxStandbyClients = 2;
+
+base::LazyInstance<UMediaClientPool>::Leaky g_umediaclient_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+struct UMediaClientPool::Entry {
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner;
+  std::unique_ptr<UMediaClientImpl> client;
+};
+
+// static
+UMediaClientPool* UMediaClientPool::GetInstance() {
+  return g_umediaclient_pool.Pointer();
+}
+
+UMediaClientPool::UMediaClientPool()
+    : max_standby_clients_(kDefaultMaxStandbyClients) {
+  thread_checker_.DetachFromThread();
+}
+
+UMediaClientPool::~UMediaClientPool() {}
+
+void UMediaClientPool::set_max_standby_clients(size_t max_standby_clients) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  max_standby_clients_ = max_standby_clients;
+  Trim(max_standby_clients_);
+}
+
+void UMediaClientPool::Standby(
+    const scoped_refptr<base::SingleThreadTaskRunner>& task_runner,
+    bool video,
+    bool is_local_source,
+    const std::string& app_id,
+    const std::string& url,
+    const std::string& mime_type,
+    const std::string& referrer,
+    const std::string& user_agent,
+    const std::string& cookies,
+    const std::string& payload) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  if (!max_standby_clients_)
+    return;
+
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if ((*it)->client->url() == url) {
+      // Already warm, just mark it as the most recently requested one.
+      entries_.splice(entries_.end(), entries_, it);
+      return;
+    }
+  }
+
+  std::unique_ptr<Entry> entry(new Entry);
+  entry->task_runner = task_runner;
+  entry->client.reset(new UMediaClientImpl(task_runner));
+  if (!entry->client->Standby(video, is_local_source, app_id, url, mime_type,
+                              referrer, user_agent, cookies, payload)) {
+    INFO_LOG("preload is not supported for %s", url.c_str());
+    return;
+  }
+
+  Trim(max_standby_clients_ - 1);
+  entries_.push_back(std::move(entry));
+}
+
+std::unique_ptr<UMediaClientImpl> UMediaClientPool::Take(
+    const std::string& url,
+    const scoped_refptr<base::SingleThreadTaskRunner>& task_runner) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if ((*it)->client->url() != url || (*it)->task_runner != task_runner)
+      continue;
+    std::unique_ptr<UMediaClientImpl> client = std::move((*it)->client);
+    entries_.erase(it);
+    INFO_LOG("adopting standby pipeline for %s", url.c_str());
+    return client;
+  }
+  return nullptr;
+}
+
+void UMediaClientPool::Clear() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  entries_.clear();
+}
+
+void UMediaClientPool::Trim(size_t max_size) {
+  while (entries_.size() > max_size)
+    entries_.pop_front();
+}
+
+}  // namespace media
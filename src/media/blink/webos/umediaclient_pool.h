@@ -0,0 +1,90 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MEDIA_BLINK_WEBOS_UMEDIACLIENT_POOL_H_
+#define MEDIA_BLINK_WEBOS_UMEDIACLIENT_POOL_H_
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "base/lazy_instance.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/threading/thread_checker.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+}
+
+namespace media {
+
+class UMediaClientImpl;
+
+// Keeps up to max_standby_clients() uMediaServer pipelines preloaded in a
+// paused state, keyed by URL, so that a channel change can swap into a warm
+// pipeline instead of waiting for onLoadCompleted and onSourceInfo. The least
+// recently requested pipeline is dropped first. Used on the render thread
+// only.
+class UMediaClientPool {
+ public:
+  static UMediaClientPool* GetInstance();
+
+  size_t max_standby_clients() const { return max_standby_clients_; }
+  void set_max_standby_clients(size_t max_standby_clients);
+
+  // Starts preloading |url| unless a standby pipeline for it already exists.
+  void Standby(const scoped_refptr<base::SingleThreadTaskRunner>& task_runner,
+               bool video,
+               bool is_local_source,
+               const std::string& app_id,
+               const std::string& url,
+               const std::string& mime_type,
+               const std::string& referrer,
+               const std::string& user_agent,
+               const std::string& cookies,
+               const std::string& payload);
+
+  // Hands the standby pipeline for |url| over to the caller, or returns null
+  // if there is none created on |task_runner|. The caller then passes it the
+  // usual load() arguments to attach itself.
+  std::unique_ptr<UMediaClientImpl> Take(
+      const std::string& url,
+      const scoped_refptr<base::SingleThreadTaskRunner>& task_runner);
+
+  // Drops every standby pipeline, e.g. when the app goes to the background.
+  void Clear();
+
+ private:
+  struct Entry;
+
+  UMediaClientPool();
+  ~UMediaClientPool();
+
+  void Trim(size_t max_size);
+
+  friend struct base::DefaultLazyInstanceTraits<UMediaClientPool>;
+
+  size_t max_standby_clients_;
+  std::list<std::unique_ptr<Entry>> entries_;
+  base::ThreadChecker thread_checker_;
+
+  DISALLOW_COPY_AND_ASSIGN(UMediaClientPool);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_BLINK_WEBOS_UMEDIACLIENT_POOL_H_
@@ -15,6 +15,7 @@
 #include "content/public/renderer/render_frame.h"
 #include "media/base/bind_to_current_loop.h"
 #include "media/base/media_log.h"
+#include "media/base/media_switches.h"
 #include "third_party/WebKit/public/platform/WebMediaPlayerClient.h"
 #include "third_party/WebKit/public/web/WebLocalFrame.h"
 #include "third_party/WebKit/public/web/WebSettings.h"
@@ -43,7 +44,12 @@ VideoFrameProviderVTGImpl::VideoFrameProviderVTGImpl(
       active_video_region_changed_(false),
       texture_id_(0),
       stream_id_(0),
-      screen_orientation_(MEDIA_SCREEN_ORIENTATION_0) {}
+      screen_orientation_(MEDIA_SCREEN_ORIENTATION_0),
+      sync_geometry_to_begin_frame_(
+          base::CommandLine::ForCurrentProcess()->HasSwitch(
+              switches::kEnableVideoHoleFrameSync)),
+      has_pending_display_window_(false),
+      has_last_display_window_(false) {}
 
 VideoFrameProviderVTGImpl::~VideoFrameProviderVTGImpl() {
   SetVideoFrameProviderClient(NULL);
@@ -239,6 +245,11 @@ void VideoFrameProviderVTGImpl::SetVideoFrameProviderClient(
   if (video_frame_provider_client_)
     video_frame_provider_client_->StopUsingProvider();
   video_frame_provider_client_ = client;
+
+  // A new client is only ever set on the compositor thread, and it drives
+  // UpdateCurrentFrame() from BeginFrames once rendering has started.
+  if (sync_geometry_to_begin_frame_ && video_frame_provider_client_)
+    video_frame_provider_client_->StartRendering();
 }
 
 void VideoFrameProviderVTGImpl::PutCurrentFrame() {}
@@ -250,7 +261,28 @@ scoped_refptr<media::VideoFrame> VideoFrameProviderVTGImpl::GetCurrentFrame() {
 bool VideoFrameProviderVTGImpl::UpdateCurrentFrame(
     base::TimeTicks deadline_min,
     base::TimeTicks deadline_max) {
-  NOTIMPLEMENTED();
+  if (!sync_geometry_to_begin_frame_) {
+    NOTIMPLEMENTED();
+    return false;
+  }
+
+  DisplayWindowCB cb;
+  DisplayWindow window;
+  {
+    base::AutoLock auto_lock(geometry_lock_);
+    if (!has_pending_display_window_ || display_window_cb_.is_null())
+      return false;
+
+    has_pending_display_window_ = false;
+    window = pending_display_window_;
+    if (!ShouldSendDisplayWindowLocked(window))
+      return false;
+    cb = display_window_cb_;
+  }
+
+  cb.Run(window.out_rect, window.in_rect, window.fullscreen, window.forced);
+
+  // The hole frame itself does not change, only the sink's window does.
   return false;
 }
 
@@ -271,6 +303,66 @@ void VideoFrameProviderVTGImpl::setNaturalVideoSize(
       natural_video_size.IsEmpty() ? gfx::Size(1, 1) : natural_video_size;
 }
 
+void VideoFrameProviderVTGImpl::setDisplayWindowCB(const DisplayWindowCB& cb) {
+  DCHECK(main_loop_->task_runner()->BelongsToCurrentThread());
+
+  base::AutoLock auto_lock(geometry_lock_);
+  display_window_cb_ = cb;
+  has_last_display_window_ = false;
+}
+
+void VideoFrameProviderVTGImpl::updateDisplayWindow(
+    const blink::WebRect& out_rect,
+    const blink::WebRect& in_rect,
+    bool fullscreen,
+    bool forced) {
+  DCHECK(main_loop_->task_runner()->BelongsToCurrentThread());
+
+  DisplayWindow window;
+  window.out_rect = out_rect;
+  window.in_rect = in_rect;
+  window.fullscreen = fullscreen;
+  window.forced = forced;
+
+  DisplayWindowCB cb;
+  {
+    base::AutoLock auto_lock(geometry_lock_);
+    if (display_window_cb_.is_null())
+      return;
+
+    // Without a compositor client there are no BeginFrames to wait for, e.g.
+    // before the video layer is created.
+    if (sync_geometry_to_begin_frame_ && video_frame_provider_client_) {
+      // Only the latest window matters, but a forced update must stay forced
+      // if a newer window replaces it before the next BeginFrame.
+      if (has_pending_display_window_ && pending_display_window_.forced)
+        window.forced = true;
+      pending_display_window_ = window;
+      has_pending_display_window_ = true;
+      return;
+    }
+
+    if (!ShouldSendDisplayWindowLocked(window))
+      return;
+    cb = display_window_cb_;
+  }
+
+  cb.Run(window.out_rect, window.in_rect, window.fullscreen, window.forced);
+}
+
+bool VideoFrameProviderVTGImpl::ShouldSendDisplayWindowLocked(
+    const DisplayWindow& window) {
+  geometry_lock_.AssertAcquired();
+
+  if (!window.forced && has_last_display_window_ &&
+      last_display_window_ == window)
+    return false;
+
+  last_display_window_ = window;
+  has_last_display_window_ = true;
+  return true;
+}
+
 void VideoFrameProviderVTGImpl::createVideoFrameHole() {
   DCHECK(main_loop_->task_runner()->BelongsToCurrentThread());
 
@@ -17,8 +17,10 @@
 #ifndef MEDIA_BLINK_WEBOS_VIDEO_FRAME_PROVIDER_VTG_IMPL_H_
 #define MEDIA_BLINK_WEBOS_VIDEO_FRAME_PROVIDER_VTG_IMPL_H_
 
+#include "base/callback.h"
 #include "base/compiler_specific.h"
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "cc/layers/video_frame_provider.h"
 #include "content/renderer/media/webos/stream_texture_factory.h"
 #include "gpu/command_buffer/common/mailbox.h"
@@ -57,6 +59,11 @@ class MEDIA_BLINK_EXPORT VideoFrameProviderVTGImpl
     : public NON_EXPORTED_BASE(cc::VideoFrameProvider),
       public base::SupportsWeakPtr<VideoFrameProviderVTGImpl> {
  public:
+  typedef base::Callback<void(const blink::WebRect& out_rect,
+                              const blink::WebRect& in_rect,
+                              bool fullscreen,
+                              bool forced)> DisplayWindowCB;
+
   VideoFrameProviderVTGImpl(const scoped_refptr<base::SingleThreadTaskRunner>&
                                 compositor_task_runner);
 
@@ -129,6 +136,24 @@ class MEDIA_BLINK_EXPORT VideoFrameProviderVTGImpl
     return screen_orientation_;
   }
 
+  // Sets the callback that hands punch-through geometry to the media sink.
+  // It runs on the compositor thread when geometry is synced to BeginFrames,
+  // and on the main thread otherwise.
+  virtual void setDisplayWindowCB(const DisplayWindowCB& cb);
+
+  // Queues the display window of the video hole. Without BeginFrame sync the
+  // window is sent right away; with it, the latest window is sent on the next
+  // BeginFrame so it lands together with the frame that moves the hole.
+  // Unchanged windows are dropped unless |forced| is set.
+  virtual void updateDisplayWindow(const blink::WebRect& out_rect,
+                                   const blink::WebRect& in_rect,
+                                   bool fullscreen,
+                                   bool forced);
+
+  bool syncsGeometryToBeginFrame() const {
+    return sync_geometry_to_begin_frame_;
+  }
+
  protected:
   virtual scoped_refptr<VideoFrame> CreateVideoFrame(
       media::VideoFrame::StorageType frame_storage_type);
@@ -137,6 +162,24 @@ class MEDIA_BLINK_EXPORT VideoFrameProviderVTGImpl
   virtual void DeleteStreamTexture();
   virtual void CreateStreamTextureProxyIfNeeded();
 
+  struct DisplayWindow {
+    DisplayWindow() : fullscreen(false), forced(false) {}
+
+    bool operator==(const DisplayWindow& other) const {
+      return out_rect == other.out_rect && in_rect == other.in_rect &&
+             fullscreen == other.fullscreen;
+    }
+
+    blink::WebRect out_rect;
+    blink::WebRect in_rect;
+    bool fullscreen;
+    bool forced;
+  };
+
+  // Returns true and records |window| as sent unless it matches the last
+  // window sent to the sink. Must be called with |geometry_lock_| held.
+  bool ShouldSendDisplayWindowLocked(const DisplayWindow& window);
+
   static void OnReleaseTexture(
       const scoped_refptr<content::StreamTextureFactory>& factories,
       const gpu::SyncToken& release_sync_token);
@@ -192,6 +235,18 @@ class MEDIA_BLINK_EXPORT VideoFrameProviderVTGImpl
 
   ScreenOrientationType screen_orientation_;
 
+  // Set from switches::kEnableVideoHoleFrameSync.
+  const bool sync_geometry_to_begin_frame_;
+
+  // |geometry_lock_| protects the members below. The display window is queued
+  // on the main thread and consumed on the compositor thread.
+  base::Lock geometry_lock_;
+  DisplayWindowCB display_window_cb_;
+  DisplayWindow pending_display_window_;
+  bool has_pending_display_window_;
+  DisplayWindow last_display_window_;
+  bool has_last_display_window_;
+
   DISALLOW_COPY_AND_ASSIGN(VideoFrameProviderVTGImpl);
 };
 
@@ -16,6 +16,7 @@
 #include "media/blink/webmediaplayer_delegate.h"
 #include "media/blink/webmediaplayer_params.h"
 #include "media/blink/webmediaplayer_util.h"
+#include "media/blink/webos/umediaclient_pool.h"
 #include "content/renderer/media/render_media_log.h"
 #include "cc/blink/web_layer_impl.h"
 #include "content/renderer/render_thread_impl.h"
@@ -204,8 +205,16 @@ void WebMediaPlayerUMS::DidLoadMediaInfo(bool ok, const GURL& url) {
   is_local_source_ = url.SchemeIs("file");
   url_ = url.spec();
 
+  UMediaClientImpl::Preload preload = umedia_client_->preload();
+  bool adopted = AdoptStandbyClient();
+
   LoadMedia();
 
+  // A standby client was preloaded with metadata only; re-apply the
+  // element's preload hint so preload=auto still starts buffering.
+  if (adopted)
+    umedia_client_->SetPreload(preload);
+
   if (!paintTimer_.IsRunning()) {
     uint64_t paint_interval_time = kPaintTimerInterval;
     paintTimer_.Start(FROM_HERE,
@@ -215,6 +224,18 @@ void WebMediaPlayerUMS::DidLoadMediaInfo(bool ok, const GURL& url) {
   }
 }
 
+bool WebMediaPlayerUMS::AdoptStandbyClient() {
+  std::unique_ptr<UMediaClientImpl> client =
+      UMediaClientPool::GetInstance()->Take(url_, media_task_runner_);
+  if (!client)
+    return false;
+
+  DEBUG_LOG("%s - reuse standby pipeline for %s", __FUNCTION__, url_.c_str());
+  delete umedia_client_;
+  umedia_client_ = client.release();
+  return true;
+}
+
 void WebMediaPlayerUMS::LoadMedia() {
 
   DEBUG_LOG("%s", __FUNCTION__);
@@ -211,6 +211,10 @@ class WebMediaPlayerUMS : public blink::WebMediaPlayer,
   void DidLoadMediaInfo(bool ok, const GURL& redirected_url);
   virtual void LoadMedia();
 
+  // Replaces |umedia_client_| with a warm standby client for |url_| from
+  // UMediaClientPool, if one exists. Returns true if a client was adopted.
+  bool AdoptStandbyClient();
+
   // Called after asynchronous initialization of a data source completed.
   void DataSourceInitialized(const GURL& gurl, bool success);
 
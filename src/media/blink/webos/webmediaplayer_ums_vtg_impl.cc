@@ -11,6 +11,7 @@
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/command_line.h"
+#include "base/single_thread_task_runner.h"
 #include "cc/layers/video_layer.h"
 #include "media/blink/webaudiosourceprovider_impl.h"
 #include "media/blink/webmediaplayer_delegate.h"
@@ -73,6 +74,19 @@ class SyncTokenClientImpl : public media::VideoFrame::SyncTokenClient {
   gpu::gles2::GLES2Interface* gl_;
 };
 
+// Brings a display window delivered on a compositor BeginFrame back to
+// |task_runner|, which owns the uMediaServer client.
+void PostDisplayWindow(
+    const scoped_refptr<base::SingleThreadTaskRunner>& task_runner,
+    const media::VideoFrameProviderVTGImpl::DisplayWindowCB& cb,
+    const blink::WebRect& out_rect,
+    const blink::WebRect& in_rect,
+    bool fullscreen,
+    bool forced) {
+  task_runner->PostTask(
+      FROM_HERE, base::Bind(cb, out_rect, in_rect, fullscreen, forced));
+}
+
 }  // namespace
 
 namespace media {
@@ -121,6 +135,14 @@ WebMediaPlayerUMSVTGImpl::~WebMediaPlayerUMSVTGImpl() {
 }
 
 void WebMediaPlayerUMSVTGImpl::LoadMedia() {
+  VideoFrameProviderVTGImpl::DisplayWindowCB display_window_cb = base::Bind(
+      &UMediaClientImpl::setDisplayWindow, umedia_client_->AsWeakPtr());
+  if (video_frame_provider_vtg_->syncsGeometryToBeginFrame()) {
+    display_window_cb = base::Bind(&PostDisplayWindow,
+                                   main_loop_->task_runner(), display_window_cb);
+  }
+  video_frame_provider_vtg_->setDisplayWindowCB(display_window_cb);
+
   umedia_client_->SetActiveRegionCB(BIND_TO_RENDER_LOOP_VIDEO_FRAME_PROVIDER(
       &VideoFrameProviderVTGImpl::activeRegionChanged));
 
@@ -343,9 +365,9 @@ void WebMediaPlayerUMSVTGImpl::updateVideo(const blink::WebRect& rect,
       if (video_frame_provider_vtg_->getActiveVideoRegion().isEmpty())
         umedia_client_->switchToAutoLayout();
     } else {
-      umedia_client_->setDisplayWindow(display_window_out_rect,
-                                       display_window_in_rect_,
-                                       checked_fullscreen, forced);
+      video_frame_provider_vtg_->updateDisplayWindow(
+          display_window_out_rect, display_window_in_rect_, checked_fullscreen,
+          forced);
     }
   }
 }
@@ -412,7 +434,7 @@ void WebMediaPlayerUMSVTGImpl::OnVideoDisplayWindowChange() {
     if (video_frame_provider_vtg_->getActiveVideoRegion().isEmpty())
       umedia_client_->switchToAutoLayout();
   } else {
-    umedia_client_->setDisplayWindow(
+    video_frame_provider_vtg_->updateDisplayWindow(
         display_window_out_rect, display_window_in_rect_, fullscreen_, forced);
   }
 }
@@ -466,7 +488,7 @@ void WebMediaPlayerUMSVTGImpl::OnScreenOrientationUpdate(
   } else {
     video_frame_provider_vtg_->setActiveVideoRegionChanged(false);
     video_frame_provider_vtg_->setActiveVideoRegion(blink::WebRect());
-    umedia_client_->setDisplayWindow(
+    video_frame_provider_vtg_->updateDisplayWindow(
         display_window_out_rect_, display_window_in_rect_, fullscreen_, true);
   }
 }
@@ -0,0 +1,71 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "media/base/audio_buffer.h"
+#include "media/base/audio_bus.h"
+#include "media/base/audio_parameters.h"
+#include "media/base/channel_layout.h"
+#include "media/base/test_helpers.h"
+#include "media/base/timestamp_constants.h"
+#include "media/filters/audio_renderer_algorithm.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+static const int kSampleRate = 48000;
+static const int kFramesPerBuffer = 1024;
+static const int kOutputDurationInSec = 10;
+
+// Measures how long it takes to render |kOutputDurationInSec| seconds of 5.1
+// audio at |playback_rate|, which is mostly the WSOLA overlap search.
+static void RunPlaybackRateBenchmark(double playback_rate) {
+  const ChannelLayout kChannelLayout = CHANNEL_LAYOUT_5_1;
+  const int kChannels = ChannelLayoutToChannelCount(kChannelLayout);
+  AudioParameters params(AudioParameters::AUDIO_PCM_LINEAR, kChannelLayout,
+                         kSampleRate, 32, kFramesPerBuffer);
+  AudioRendererAlgorithm algorithm;
+  algorithm.Initialize(params);
+
+  // The search is as expensive whatever the content, since the decimated
+  // search looks at all the candidates.
+  scoped_refptr<AudioBuffer> buffer = MakeAudioBuffer<float>(
+      kSampleFormatPlanarF32, kChannelLayout, kChannels, kSampleRate, -1.0f,
+      2.0f / kFramesPerBuffer, kFramesPerBuffer, kNoTimestamp());
+  std::unique_ptr<AudioBus> bus =
+      AudioBus::Create(kChannels, kFramesPerBuffer);
+
+  base::TimeDelta elapsed;
+  for (int frames_rendered = 0;
+       frames_rendered < kSampleRate * kOutputDurationInSec;) {
+    while (!algorithm.IsQueueFull())
+      algorithm.EnqueueBuffer(buffer);
+    base::TimeTicks start = base::TimeTicks::Now();
+    const int frames_filled =
+        algorithm.FillBuffer(bus.get(), 0, kFramesPerBuffer, playback_rate);
+    elapsed += base::TimeTicks::Now() - start;
+    ASSERT_GT(frames_filled, 0);
+    frames_rendered += frames_filled;
+  }
+
+  perf_test::PrintResult(
+      "audio_renderer_algorithm", "",
+      base::StringPrintf("5.1_rate_%.2f", playback_rate),
+      elapsed.InMillisecondsF() / kOutputDurationInSec,
+      "ms per second of output", true);
+}
+
+TEST(AudioRendererAlgorithmPerfTest, PlaybackRates) {
+  RunPlaybackRateBenchmark(0.5);
+  RunPlaybackRateBenchmark(1.25);
+  RunPlaybackRateBenchmark(1.5);
+  RunPlaybackRateBenchmark(2.0);
+}
+
+}  // namespace media
@@ -16,6 +16,10 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "media/base/audio_decoder_config.h"
 #include "media/base/bind_to_current_loop.h"
 #include "media/base/media_tracks.h"
@@ -286,6 +290,13 @@ void ChunkDemuxerStream::SetStreamMemoryLimit(size_t memory_limit) {
   stream_->set_memory_limit(memory_limit);
 }
 
+void ChunkDemuxerStream::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  base::AutoLock auto_lock(lock_);
+  if (stream_)
+    stream_->OnMemoryPressure(memory_pressure_level);
+}
+
 void ChunkDemuxerStream::SetLiveness(Liveness liveness) {
   base::AutoLock auto_lock(lock_);
   liveness_ = liveness;
@@ -903,6 +914,34 @@ void ChunkDemuxer::SetMemoryLimits(DemuxerStream::Type type,
   }
 }
 
+void ChunkDemuxer::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  base::AutoLock auto_lock(lock_);
+  for (MediaSourceStateMap::iterator itr = source_state_map_.begin();
+       itr != source_state_map_.end(); ++itr) {
+    itr->second->OnMemoryPressure(memory_pressure_level);
+  }
+}
+
+bool ChunkDemuxer::OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                                base::trace_event::ProcessMemoryDump* pmd) {
+  base::AutoLock auto_lock(lock_);
+  for (MediaSourceStateMap::const_iterator itr = source_state_map_.begin();
+       itr != source_state_map_.end(); ++itr) {
+    base::trace_event::MemoryAllocatorDump* dump =
+        pmd->CreateAllocatorDump(base::StringPrintf(
+            "media/chunk_demuxer_%p/source_buffer_%s", this,
+            itr->first.c_str()));
+    dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                    base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                    itr->second->GetBufferedSize());
+    pmd->AddSuballocation(dump->guid(),
+                          base::trace_event::MemoryDumpManager::GetInstance()
+                              ->system_allocator_pool_name());
+  }
+  return true;
+}
+
 void ChunkDemuxer::ChangeState_Locked(State new_state) {
   lock_.AssertAcquired();
   DVLOG(1) << "ChunkDemuxer::ChangeState_Locked() : "
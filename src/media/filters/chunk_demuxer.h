@@ -15,7 +15,9 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/synchronization/lock.h"
+#include "base/trace_event/memory_dump_provider.h"
 #include "media/base/byte_queue.h"
 #include "media/base/demuxer.h"
 #include "media/base/demuxer_stream.h"
@@ -119,6 +121,10 @@ class MEDIA_EXPORT ChunkDemuxerStream : public DemuxerStream {
   // Sets the memory limit, in bytes, on the SourceBufferStream.
   void SetStreamMemoryLimit(size_t memory_limit);
 
+  // Lowers the memory limit of the SourceBufferStream under memory pressure.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
   bool supports_partial_append_window_trimming() const {
     return partial_append_window_trimming_enabled_;
   }
@@ -160,7 +166,8 @@ class MEDIA_EXPORT ChunkDemuxerStream : public DemuxerStream {
 
 // Demuxer implementation that allows chunks of media data to be passed
 // from JavaScript to the media stack.
-class MEDIA_EXPORT ChunkDemuxer : public Demuxer {
+class MEDIA_EXPORT ChunkDemuxer : public Demuxer,
+                                  public base::trace_event::MemoryDumpProvider {
  public:
   enum Status {
     kOk,              // ID added w/o error.
@@ -302,6 +309,17 @@ class MEDIA_EXPORT ChunkDemuxer : public Demuxer {
   // is allowed to hold in its buffer.
   void SetMemoryLimits(DemuxerStream::Type type, size_t memory_limit);
 
+  // Lowers the memory limits of all the streams while the system is under
+  // memory pressure, so that the next appends evict more buffered data.
+  // Streams created later use their full memory limit until the next call.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  // base::trace_event::MemoryDumpProvider implementation. Dumps the size of
+  // the data buffered by each source buffer. It can be called on any thread.
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
   // Returns the ranges representing the buffered data in the demuxer.
   // TODO(wolenetz): Remove this method once MediaSourceDelegate no longer
   // requires it for doing hack browser seeks to I-frame on Android. See
@@ -11,6 +11,7 @@
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/callback_helpers.h"
+#include "base/command_line.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
@@ -28,6 +29,7 @@
 #include "media/base/decrypt_config.h"
 #include "media/base/limits.h"
 #include "media/base/media_log.h"
+#include "media/base/media_switches.h"
 #include "media/base/media_tracks.h"
 #include "media/base/timestamp_constants.h"
 #include "media/base/video_codecs.h"
@@ -708,22 +710,29 @@ void FFmpegDemuxerStream::SatisfyPendingRead() {
   }
 
   // Have capacity? Ask for more!
-  if (HasAvailableCapacity() && !end_of_stream_) {
+  if ((HasAvailableCapacity() || HasReadAheadCapacity()) && !end_of_stream_) {
     demuxer_->NotifyCapacityAvailable();
   }
 }
 
 bool FFmpegDemuxerStream::HasAvailableCapacity() {
-  // TODO(scherkus): Remove this return and reenable time-based capacity
-  // after our data sources support canceling/concurrent reads, see
-  // http://crbug.com/165762 for details.
-#if 1
+  // TODO(scherkus): Make time-based capacity the default after our data
+  // sources support canceling/concurrent reads, see http://crbug.com/165762
+  // for details.  Until then it's only used with read ahead.
   return !read_cb_.is_null();
-#else
-  // Try to have one second's worth of encoded data per stream.
+}
+
+bool FFmpegDemuxerStream::HasReadAheadCapacity() {
+  if (type_ == TEXT || end_of_stream_)
+    return false;
+
+  // Try to have one second's worth of encoded data per stream.  The size limit
+  // bounds the queue when packets have no usable timestamps.
   const base::TimeDelta kCapacity = base::TimeDelta::FromSeconds(1);
-  return buffer_queue_.IsEmpty() || buffer_queue_.Duration() < kCapacity;
-#endif
+  const size_t kMaxCapacityBytes = 8 * 1024 * 1024;
+  return buffer_queue_.IsEmpty() ||
+         (buffer_queue_.Duration() < kCapacity &&
+          buffer_queue_.data_size() < kMaxCapacityBytes);
 }
 
 size_t FFmpegDemuxerStream::MemoryUsage() const {
@@ -782,6 +791,8 @@ FFmpegDemuxer::FFmpegDemuxer(
       preferred_stream_for_seeking_(-1, kNoTimestamp()),
       fallback_stream_for_seeking_(-1, kNoTimestamp()),
       text_enabled_(false),
+      read_ahead_(base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableDemuxerReadAhead)),
       duration_known_(false),
       encrypted_media_init_data_cb_(encrypted_media_init_data_cb),
       media_tracks_updated_cb_(media_tracks_updated_cb),
@@ -1565,13 +1576,25 @@ void FFmpegDemuxer::OnReadFrameDone(ScopedAVPacket packet, int result) {
 
 bool FFmpegDemuxer::StreamsHaveAvailableCapacity() {
   DCHECK(task_runner_->BelongsToCurrentThread());
+  bool stream_below_read_ahead_capacity = false;
+  bool stream_at_read_ahead_capacity = false;
   StreamVector::iterator iter;
   for (iter = streams_.begin(); iter != streams_.end(); ++iter) {
-    if (*iter && (*iter)->HasAvailableCapacity()) {
+    if (!*iter)
+      continue;
+    if ((*iter)->HasAvailableCapacity())
       return true;
-    }
+    if (!read_ahead_ || (*iter)->type() == DemuxerStream::TEXT)
+      continue;
+
+    // Stop reading ahead as soon as one stream is full, otherwise a stream
+    // ending before the others would have them read up to the memory limit.
+    if ((*iter)->HasReadAheadCapacity())
+      stream_below_read_ahead_capacity = true;
+    else
+      stream_at_read_ahead_capacity = true;
   }
-  return false;
+  return stream_below_read_ahead_capacity && !stream_at_read_ahead_capacity;
 }
 
 bool FFmpegDemuxer::IsMaxMemoryUsageReached() const {
@@ -123,6 +123,11 @@ class FFmpegDemuxerStream : public DemuxerStream {
   // Returns true if this stream has capacity for additional data.
   bool HasAvailableCapacity();
 
+  // Returns true if this stream has queued less than the read ahead capacity,
+  // see switches::kEnableDemuxerReadAhead.  Always false for text streams,
+  // which are too sparse to read ahead of.
+  bool HasReadAheadCapacity();
+
   // Returns the total buffer size FFMpegDemuxerStream is holding onto.
   size_t MemoryUsage() const;
 
@@ -239,7 +244,9 @@ class MEDIA_EXPORT FFmpegDemuxer : public Demuxer {
   void OnReadFrameDone(ScopedAVPacket packet, int result);
 
   // Returns true iff any stream has additional capacity. Note that streams can
-  // go over capacity depending on how the file is muxed.
+  // go over capacity depending on how the file is muxed. With |read_ahead_|,
+  // also returns true while no audio or video stream has reached its read
+  // ahead capacity.
   bool StreamsHaveAvailableCapacity();
 
   // Returns true if the maximum allowed memory usage has been reached.
@@ -322,6 +329,9 @@ class MEDIA_EXPORT FFmpegDemuxer : public Demuxer {
   // Whether text streams have been enabled for this demuxer.
   bool text_enabled_;
 
+  // Whether packets are read ahead of the streams' Read() calls.
+  const bool read_ahead_;
+
   // Set if we know duration of the audio stream. Used when processing end of
   // stream -- at this moment we definitely know duration.
   bool duration_known_;
@@ -17,10 +17,12 @@
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/single_thread_task_runner.h"
+#include "base/test/scoped_command_line.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "media/base/decrypt_config.h"
 #include "media/base/media_log.h"
+#include "media/base/media_switches.h"
 #include "media/base/media_tracks.h"
 #include "media/base/mock_demuxer_host.h"
 #include "media/base/test_helpers.h"
@@ -435,6 +437,34 @@ TEST_F(FFmpegDemuxerTest, Read_Audio) {
   EXPECT_EQ(22084, demuxer_->GetMemoryUsage());
 }
 
+TEST_F(FFmpegDemuxerTest, Read_AudioWithReadAhead) {
+  base::test::ScopedCommandLine scoped_command_line;
+  scoped_command_line.GetProcessCommandLine()->AppendSwitch(
+      switches::kEnableDemuxerReadAhead);
+  CreateDemuxer("bear-320x240.webm");
+  InitializeDemuxer();
+
+  FFmpegDemuxerStream* audio = static_cast<FFmpegDemuxerStream*>(
+      demuxer_->GetStream(DemuxerStream::AUDIO));
+  FFmpegDemuxerStream* video = static_cast<FFmpegDemuxerStream*>(
+      demuxer_->GetStream(DemuxerStream::VIDEO));
+  audio->Read(NewReadCB(FROM_HERE, 29, 0, true));
+  base::RunLoop().Run();
+
+  // Packets keep being read after the Read() is satisfied, until one stream
+  // has reached its read ahead capacity.
+  while (demuxer_->pending_read_)
+    base::RunLoop().RunUntilIdle();
+  EXPECT_GT(audio->MemoryUsage(), 0u);
+  EXPECT_GT(video->MemoryUsage(), 0u);
+  EXPECT_FALSE(audio->HasReadAheadCapacity() && video->HasReadAheadCapacity());
+  EXPECT_GT(demuxer_->GetMemoryUsage(), 22084);
+
+  // The queued packets satisfy the next reads.
+  audio->Read(NewReadCB(FROM_HERE, 27, 3000, true));
+  base::RunLoop().Run();
+}
+
 TEST_F(FFmpegDemuxerTest, Read_Video) {
   // We test that on a successful video packet read.
   CreateDemuxer("bear-320x240.webm");
@@ -449,6 +449,35 @@ void MediaSourceState::Shutdown() {
   }
 }
 
+void MediaSourceState::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  if (audio_)
+    audio_->OnMemoryPressure(memory_pressure_level);
+
+  if (video_)
+    video_->OnMemoryPressure(memory_pressure_level);
+
+  for (TextStreamMap::iterator itr = text_stream_map_.begin();
+       itr != text_stream_map_.end(); ++itr) {
+    itr->second->OnMemoryPressure(memory_pressure_level);
+  }
+}
+
+size_t MediaSourceState::GetBufferedSize() const {
+  size_t buffered_size = 0;
+  if (audio_)
+    buffered_size += audio_->GetBufferedSize();
+
+  if (video_)
+    buffered_size += video_->GetBufferedSize();
+
+  for (TextStreamMap::const_iterator itr = text_stream_map_.begin();
+       itr != text_stream_map_.end(); ++itr) {
+    buffered_size += itr->second->GetBufferedSize();
+  }
+  return buffered_size;
+}
+
 void MediaSourceState::SetMemoryLimits(DemuxerStream::Type type,
                                        size_t memory_limit) {
   switch (type) {
@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "media/base/demuxer.h"
 #include "media/base/demuxer_stream.h"
 #include "media/base/media_export.h"
@@ -112,8 +113,13 @@ class MEDIA_EXPORT MediaSourceState {
   // |memory_limit| is the maximum number of bytes each stream of type |type|
   // is allowed to hold in its buffer.
   void SetMemoryLimits(DemuxerStream::Type type, size_t memory_limit);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
   bool IsSeekWaitingForData() const;
 
+  // Returns the size of the data buffered by all the streams, in bytes.
+  size_t GetBufferedSize() const;
+
   typedef std::list<Ranges<TimeDelta>> RangesList;
   static Ranges<TimeDelta> ComputeRangesIntersection(
       const RangesList& activeRanges,
@@ -690,24 +690,25 @@ bool SourceBufferStream::GarbageCollectIfNeeded(DecodeTimestamp media_time,
   DCHECK(!end_of_stream_);
   // Compute size of |ranges_|.
   size_t ranges_size = GetBufferedSize();
+  const size_t memory_limit = GetMemoryLimit();
 
   // Sanity and overflow checks
-  if ((newDataSize > memory_limit_) ||
+  if ((newDataSize > memory_limit) ||
       (ranges_size + newDataSize < ranges_size)) {
     LIMITED_MEDIA_LOG(DEBUG, media_log_, num_garbage_collect_algorithm_logs_,
                       kMaxGarbageCollectAlgorithmWarningLogs)
         << GetStreamTypeName() << " stream: "
         << "new append of newDataSize=" << newDataSize
-        << " bytes exceeds memory_limit_=" << memory_limit_
+        << " bytes exceeds memory_limit=" << memory_limit
         << ", currently buffered ranges_size=" << ranges_size;
     return false;
   }
 
   // Return if we're under or at the memory limit.
-  if (ranges_size + newDataSize <= memory_limit_)
+  if (ranges_size + newDataSize <= memory_limit)
     return true;
 
-  size_t bytes_to_free = ranges_size + newDataSize - memory_limit_;
+  size_t bytes_to_free = ranges_size + newDataSize - memory_limit;
 
   DVLOG(2) << __FUNCTION__ << " " << GetStreamTypeName() << ": Before GC"
            << " media_time=" << media_time.InSecondsF()
@@ -715,7 +716,7 @@ bool SourceBufferStream::GarbageCollectIfNeeded(DecodeTimestamp media_time,
            << " seek_pending_=" << seek_pending_
            << " ranges_size=" << ranges_size
            << " newDataSize=" << newDataSize
-           << " memory_limit_=" << memory_limit_
+           << " memory_limit=" << memory_limit
            << " last_appended_buffer_timestamp_="
            << last_appended_buffer_timestamp_.InSecondsF();
 
@@ -830,6 +831,19 @@ bool SourceBufferStream::GarbageCollectIfNeeded(DecodeTimestamp media_time,
   return bytes_freed >= bytes_to_free;
 }
 
+size_t SourceBufferStream::GetMemoryLimit() const {
+  switch (memory_pressure_level_) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      return memory_limit_;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      return memory_limit_ / 2;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      return memory_limit_ / 4;
+  }
+  NOTREACHED();
+  return memory_limit_;
+}
+
 size_t SourceBufferStream::FreeBuffersAfterLastAppended(
     size_t total_bytes_to_free, DecodeTimestamp media_time) {
   DVLOG(4) << __FUNCTION__ << " last_appended_buffer_timestamp_="
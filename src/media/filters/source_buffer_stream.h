@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/ref_counted.h"
 #include "media/base/audio_decoder_config.h"
 #include "media/base/media_export.h"
@@ -161,6 +162,14 @@ class MEDIA_EXPORT SourceBufferStream {
     memory_limit_ = memory_limit;
   }
 
+  // Lowers the memory limit used by garbage collection while the system is
+  // under memory pressure, down to a quarter of it under critical pressure.
+  // The buffered data is freed by the next garbage collection.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+    memory_pressure_level_ = memory_pressure_level;
+  }
+
  private:
   friend class SourceBufferStreamTest;
 
@@ -179,6 +188,9 @@ class MEDIA_EXPORT SourceBufferStream {
   size_t FreeBuffersAfterLastAppended(size_t total_bytes_to_free,
                                       DecodeTimestamp media_time);
 
+  // Returns the memory limit for the current memory pressure level.
+  size_t GetMemoryLimit() const;
+
   // Gets the removal range to secure |byte_to_free| from
   // [|start_timestamp|, |end_timestamp|).
   // Returns the size of buffers to secure if future
@@ -433,6 +445,10 @@ class MEDIA_EXPORT SourceBufferStream {
   // The maximum amount of data in bytes the stream will keep in memory.
   size_t memory_limit_;
 
+  // The last memory pressure level given to OnMemoryPressure().
+  base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level_ =
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+
   // Indicates that a kConfigChanged status has been reported by GetNextBuffer()
   // and GetCurrentXXXDecoderConfig() must be called to update the current
   // config. GetNextBuffer() must not be called again until
@@ -2438,6 +2438,32 @@ TEST_F(SourceBufferStreamTest,
   CheckExpectedRangesByTimestamp("{ [50,100) [1000,1050) }");
 }
 
+TEST_F(SourceBufferStreamTest, GarbageCollection_MemoryPressure) {
+  // Set memory limit to 20 buffers.
+  SetMemoryLimit(20);
+
+  // Append 20 buffers at positions 0 through 19.
+  NewCodedFrameGroupAppend(0, 1, &kDataA);
+  for (int i = 1; i < 20; i++)
+    AppendBuffers(i, 1, &kDataA);
+  Seek(10);
+
+  // Moderate memory pressure halves the memory limit, so GC should delete the
+  // data in front of the current playback position.
+  stream_->OnMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  EXPECT_TRUE(GarbageCollectWithPlaybackAtBuffer(10, 0));
+  CheckExpectedRanges("{ [10,19) }");
+
+  // Without memory pressure, the full memory limit can be used again.
+  stream_->OnMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE);
+  EXPECT_TRUE(GarbageCollectWithPlaybackAtBuffer(10, 10));
+  AppendBuffers(20, 10, &kDataA);
+  CheckExpectedRanges("{ [10,29) }");
+  CheckExpectedBuffers(10, 29, &kDataA);
+}
+
 TEST_F(SourceBufferStreamTest, GarbageCollection_DeleteFrontGOPsAtATime) {
   // Set memory limit to 20 buffers.
   SetMemoryLimit(20);
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -21,6 +22,7 @@
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
 #include "base/sys_byteorder.h"
 #include "base/sys_info.h"
 #include "base/threading/thread.h"
@@ -116,6 +118,20 @@ static base::LazyInstance<VpxOffloadThread>::Leaky g_vpx_offload_thread =
 static const int kDecodeThreads = 2;
 static const int kMaxDecodeThreads = 16;
 
+// In frame-parallel mode each thread holds on to a frame being decoded, so the
+// thread count also bounds the added latency and memory.
+static const int kMaxFrameParallelDecodeThreads = 8;
+
+// Returns true if |config| should be decoded with a thread per frame rather
+// than a thread per tile. libvpx only supports this for VP9, and the alpha
+// plane, decoded in lockstep with the other planes, can't be made to follow.
+static bool UseFrameParallelDecoding(const VideoDecoderConfig& config) {
+  return config.codec() == kCodecVP9 &&
+         config.format() != PIXEL_FORMAT_YV12A &&
+         base::CommandLine::ForCurrentProcess()->HasSwitch(
+             switches::kEnableVp9FrameParallelDecoding);
+}
+
 // Returns the number of threads.
 static int GetThreadCount(const VideoDecoderConfig& config) {
   // Refer to http://crbug.com/93932 for tsan suppressions on decoding.
@@ -124,7 +140,11 @@ static int GetThreadCount(const VideoDecoderConfig& config) {
   const base::CommandLine* cmd_line = base::CommandLine::ForCurrentProcess();
   std::string threads(cmd_line->GetSwitchValueASCII(switches::kVideoThreads));
   if (threads.empty() || !base::StringToInt(threads, &decode_threads)) {
-    if (config.codec() == kCodecVP9) {
+    if (UseFrameParallelDecoding(config)) {
+      // Frames are decoded in parallel whatever their tiling, so use all the
+      // cores.
+      decode_threads = kMaxFrameParallelDecodeThreads;
+    } else if (config.codec() == kCodecVP9) {
       // For VP9 decode when using the default thread count, increase the number
       // of decode threads to equal the maximum number of tiles possible for
       // higher resolution streams.
@@ -145,7 +165,8 @@ static int GetThreadCount(const VideoDecoderConfig& config) {
 }
 
 static vpx_codec_ctx* InitializeVpxContext(vpx_codec_ctx* context,
-                                           const VideoDecoderConfig& config) {
+                                           const VideoDecoderConfig& config,
+                                           vpx_codec_flags_t flags) {
   context = new vpx_codec_ctx();
   vpx_codec_dec_cfg_t vpx_config = {0};
   vpx_config.w = config.coded_size().width();
@@ -155,7 +176,7 @@ static vpx_codec_ctx* InitializeVpxContext(vpx_codec_ctx* context,
   vpx_codec_err_t status = vpx_codec_dec_init(
       context,
       config.codec() == kCodecVP9 ? vpx_codec_vp9_dx() : vpx_codec_vp8_dx(),
-      &vpx_config, 0 /* flags */);
+      &vpx_config, flags);
   if (status == VPX_CODEC_OK)
     return context;
 
@@ -167,6 +188,9 @@ static vpx_codec_ctx* InitializeVpxContext(vpx_codec_ctx* context,
 // MemoryPool is a pool of simple CPU memory, allocated by hand and used by both
 // VP9 and any data consumers. This class needs to be ref-counted to hold on to
 // allocated memory via the memory-release callback of CreateFrameCallback().
+// In frame-parallel mode libvpx gets and releases frame buffers on its own
+// threads, so the frame buffers and their reference counts are guarded by a
+// lock.
 class VpxVideoDecoder::MemoryPool
     : public base::RefCountedThreadSafe<VpxVideoDecoder::MemoryPool>,
       public base::trace_event::MemoryDumpProvider {
@@ -221,6 +245,9 @@ class VpxVideoDecoder::MemoryPool
   // destroyed.
   void OnVideoFrameDestroyed(VP9FrameBuffer* frame_buffer);
 
+  // Guards |frame_buffers_| and their reference counts.
+  base::Lock lock_;
+
   // Frame buffers to be used by libvpx for VP9 Decoding.
   std::vector<VP9FrameBuffer*> frame_buffers_;
 
@@ -240,6 +267,8 @@ VpxVideoDecoder::MemoryPool::~MemoryPool() {
 
 VpxVideoDecoder::MemoryPool::VP9FrameBuffer*
 VpxVideoDecoder::MemoryPool::GetFreeFrameBuffer(size_t min_size) {
+  lock_.AssertAcquired();
+
   // Check if a free frame buffer exists.
   size_t i = 0;
   for (; i < frame_buffers_.size(); ++i) {
@@ -268,6 +297,7 @@ int32_t VpxVideoDecoder::MemoryPool::GetVP9FrameBuffer(
   VpxVideoDecoder::MemoryPool* memory_pool =
       static_cast<VpxVideoDecoder::MemoryPool*>(user_priv);
 
+  base::AutoLock auto_lock(memory_pool->lock_);
   VP9FrameBuffer* fb_to_use = memory_pool->GetFreeFrameBuffer(min_size);
   if (fb_to_use == NULL)
     return -1;
@@ -290,6 +320,10 @@ int32_t VpxVideoDecoder::MemoryPool::ReleaseVP9FrameBuffer(
   if (!fb->priv)
     return -1;
 
+  VpxVideoDecoder::MemoryPool* memory_pool =
+      static_cast<VpxVideoDecoder::MemoryPool*>(user_priv);
+
+  base::AutoLock auto_lock(memory_pool->lock_);
   VP9FrameBuffer* frame_buffer = static_cast<VP9FrameBuffer*>(fb->priv);
   --frame_buffer->ref_cnt;
   return 0;
@@ -298,7 +332,10 @@ int32_t VpxVideoDecoder::MemoryPool::ReleaseVP9FrameBuffer(
 base::Closure VpxVideoDecoder::MemoryPool::CreateFrameCallback(
     void* fb_priv_data) {
   VP9FrameBuffer* frame_buffer = static_cast<VP9FrameBuffer*>(fb_priv_data);
-  ++frame_buffer->ref_cnt;
+  {
+    base::AutoLock auto_lock(lock_);
+    ++frame_buffer->ref_cnt;
+  }
   return BindToCurrentLoop(
       base::Bind(&MemoryPool::OnVideoFrameDestroyed, this, frame_buffer));
 }
@@ -316,10 +353,13 @@ bool VpxVideoDecoder::MemoryPool::OnMemoryDump(
                             ->system_allocator_pool_name());
   size_t bytes_used = 0;
   size_t bytes_reserved = 0;
-  for (const VP9FrameBuffer* frame_buffer : frame_buffers_) {
-    if (frame_buffer->ref_cnt)
-      bytes_used += frame_buffer->data.size();
-    bytes_reserved += frame_buffer->data.size();
+  {
+    base::AutoLock auto_lock(lock_);
+    for (const VP9FrameBuffer* frame_buffer : frame_buffers_) {
+      if (frame_buffer->ref_cnt)
+        bytes_used += frame_buffer->data.size();
+      bytes_reserved += frame_buffer->data.size();
+    }
   }
 
   memory_dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
@@ -334,11 +374,15 @@ bool VpxVideoDecoder::MemoryPool::OnMemoryDump(
 
 void VpxVideoDecoder::MemoryPool::OnVideoFrameDestroyed(
     VP9FrameBuffer* frame_buffer) {
+  base::AutoLock auto_lock(lock_);
   --frame_buffer->ref_cnt;
 }
 
 VpxVideoDecoder::VpxVideoDecoder()
-    : state_(kUninitialized), vpx_codec_(nullptr), vpx_codec_alpha_(nullptr) {
+    : state_(kUninitialized),
+      vpx_codec_(nullptr),
+      vpx_codec_alpha_(nullptr),
+      frame_parallel_(false) {
   thread_checker_.DetachFromThread();
 }
 
@@ -391,11 +435,28 @@ void VpxVideoDecoder::DecodeBuffer(const scoped_refptr<DecoderBuffer>& buffer,
   }
 
   if (state_ == kNormal && buffer->end_of_stream()) {
+    // In frame-parallel mode the last frames are only output once the decoder
+    // is flushed.
+    if (frame_parallel_ && !FrameParallelDecode(buffer)) {
+      state_ = kError;
+      bound_decode_cb.Run(DecodeStatus::DECODE_ERROR);
+      return;
+    }
     state_ = kDecodeFinished;
     bound_decode_cb.Run(DecodeStatus::OK);
     return;
   }
 
+  if (frame_parallel_) {
+    if (!FrameParallelDecode(buffer)) {
+      state_ = kError;
+      bound_decode_cb.Run(DecodeStatus::DECODE_ERROR);
+      return;
+    }
+    bound_decode_cb.Run(DecodeStatus::OK);
+    return;
+  }
+
   scoped_refptr<VideoFrame> video_frame;
   if (!VpxDecode(buffer, &video_frame)) {
     state_ = kError;
@@ -437,6 +498,9 @@ void VpxVideoDecoder::Reset(const base::Closure& closure) {
   if (offload_task_runner_)
     g_vpx_offload_thread.Pointer()->WaitForOutstandingTasks();
 
+  if (frame_parallel_)
+    DiscardFrameParallelFrames();
+
   state_ = kNormal;
   // PostTask() to avoid calling |closure| inmediately.
   base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE, closure);
@@ -463,7 +527,11 @@ bool VpxVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config) {
 
   CloseDecoder();
 
-  vpx_codec_ = InitializeVpxContext(vpx_codec_, config);
+  // Frame-parallel mode only pays off for throughput, at the cost of latency,
+  // so it has to be asked for.
+  frame_parallel_ = UseFrameParallelDecoding(config);
+  vpx_codec_ = InitializeVpxContext(
+      vpx_codec_, config, frame_parallel_ ? VPX_CODEC_USE_FRAME_THREADING : 0);
   if (!vpx_codec_)
     return false;
 
@@ -495,7 +563,7 @@ bool VpxVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config) {
   if (config.format() != PIXEL_FORMAT_YV12A)
     return true;
 
-  vpx_codec_alpha_ = InitializeVpxContext(vpx_codec_alpha_, config);
+  vpx_codec_alpha_ = InitializeVpxContext(vpx_codec_alpha_, config, 0);
   return !!vpx_codec_alpha_;
 }
 
@@ -517,6 +585,7 @@ void VpxVideoDecoder::CloseDecoder() {
     delete vpx_codec_alpha_;
     vpx_codec_alpha_ = nullptr;
   }
+  pending_timestamps_.clear();
 }
 
 bool VpxVideoDecoder::VpxDecode(const scoped_refptr<DecoderBuffer>& buffer,
@@ -572,7 +641,93 @@ bool VpxVideoDecoder::VpxDecode(const scoped_refptr<DecoderBuffer>& buffer,
                       (*video_frame)->visible_rect().height());
   }
 
-  (*video_frame)->set_timestamp(base::TimeDelta::FromMicroseconds(timestamp));
+  SetFrameProperties(vpx_image, timestamp, video_frame->get());
+  return true;
+}
+
+bool VpxVideoDecoder::FrameParallelDecode(
+    const scoped_refptr<DecoderBuffer>& buffer) {
+  DCHECK(frame_parallel_);
+  DCHECK(!vpx_codec_alpha_);
+
+  vpx_codec_err_t status;
+  if (buffer->end_of_stream()) {
+    TRACE_EVENT0("media", "vpx_codec_decode_flush");
+    status = vpx_codec_decode(vpx_codec_, nullptr, 0, nullptr, 0);
+  } else {
+    // The timestamps wait in |pending_timestamps_| until their frames come out
+    // of the decoder, which can be several decodes later. Adding and removing
+    // timestamps at the ends of a deque doesn't move the others, so their
+    // addresses can be used as the user data of the frames.
+    const int64_t timestamp = buffer->timestamp().InMicroseconds();
+    pending_timestamps_.push_back(timestamp);
+    TRACE_EVENT1("media", "vpx_codec_decode", "timestamp", timestamp);
+    status =
+        vpx_codec_decode(vpx_codec_, buffer->data(), buffer->data_size(),
+                         &pending_timestamps_.back(), 0 /* deadline */);
+  }
+  if (status != VPX_CODEC_OK) {
+    DLOG(ERROR) << "vpx_codec_decode() error: "
+                << vpx_codec_err_to_string(status);
+    return false;
+  }
+
+  // Each call to vpx_codec_get_frame() with a fresh iterator returns the next
+  // finished frame, if any. Until the decoder is flushed it only waits for a
+  // frame when all the decode threads are busy.
+  while (true) {
+    vpx_codec_iter_t iter = NULL;
+    const vpx_image_t* vpx_image = vpx_codec_get_frame(vpx_codec_, &iter);
+    if (!vpx_image)
+      break;
+
+    // The frames come out in decode order, so the timestamps before the one of
+    // |vpx_image| belong to buffers that didn't output a frame.
+    std::deque<int64_t>::iterator it = std::find_if(
+        pending_timestamps_.begin(), pending_timestamps_.end(),
+        [vpx_image](const int64_t& timestamp) {
+          return &timestamp == vpx_image->user_priv;
+        });
+    if (it == pending_timestamps_.end()) {
+      DLOG(ERROR) << "Invalid output timestamp.";
+      return false;
+    }
+    const int64_t timestamp = *it;
+    pending_timestamps_.erase(pending_timestamps_.begin(), it + 1);
+
+    scoped_refptr<VideoFrame> video_frame;
+    if (!CopyVpxImageToVideoFrame(vpx_image, nullptr, &video_frame))
+      return false;
+    SetFrameProperties(vpx_image, timestamp, video_frame.get());
+
+    // Safe to call |output_cb_| here even if we're on the offload thread since
+    // it is only set once during Initialize() and never changed.
+    output_cb_.Run(video_frame);
+  }
+
+  if (buffer->end_of_stream())
+    pending_timestamps_.clear();
+  return true;
+}
+
+void VpxVideoDecoder::DiscardFrameParallelFrames() {
+  DCHECK(frame_parallel_);
+
+  // Flushing waits for the frames still being decoded, which libvpx then
+  // releases along with the returned images.
+  vpx_codec_decode(vpx_codec_, nullptr, 0, nullptr, 0);
+  while (true) {
+    vpx_codec_iter_t iter = NULL;
+    if (!vpx_codec_get_frame(vpx_codec_, &iter))
+      break;
+  }
+  pending_timestamps_.clear();
+}
+
+void VpxVideoDecoder::SetFrameProperties(const struct vpx_image* vpx_image,
+                                         int64_t timestamp,
+                                         VideoFrame* video_frame) {
+  video_frame->set_timestamp(base::TimeDelta::FromMicroseconds(timestamp));
 
   // Default to the color space from the config, but if the bistream specifies
   // one, prefer that instead.
@@ -581,10 +736,8 @@ bool VpxVideoDecoder::VpxDecode(const scoped_refptr<DecoderBuffer>& buffer,
     color_space = COLOR_SPACE_HD_REC709;
   else if (vpx_image->cs == VPX_CS_BT_601)
     color_space = COLOR_SPACE_SD_REC601;
-  (*video_frame)
-      ->metadata()
-      ->SetInteger(VideoFrameMetadata::COLOR_SPACE, color_space);
-  return true;
+  video_frame->metadata()->SetInteger(VideoFrameMetadata::COLOR_SPACE,
+                                      color_space);
 }
 
 VpxVideoDecoder::AlphaDecodeStatus VpxVideoDecoder::DecodeAlphaPlane(
@@ -5,6 +5,10 @@
 #ifndef MEDIA_FILTERS_VPX_VIDEO_DECODER_H_
 #define MEDIA_FILTERS_VPX_VIDEO_DECODER_H_
 
+#include <stdint.h>
+
+#include <deque>
+
 #include "base/callback.h"
 #include "base/macros.h"
 #include "base/threading/thread_checker.h"
@@ -81,6 +85,20 @@ class MEDIA_EXPORT VpxVideoDecoder : public VideoDecoder {
   bool VpxDecode(const scoped_refptr<DecoderBuffer>& buffer,
                  scoped_refptr<VideoFrame>* video_frame);
 
+  // Frame-parallel counterpart of VpxDecode(): queues |buffer| for decoding,
+  // or flushes the decoder if |buffer| is the end of stream, and outputs all
+  // the frames that are done. Returns true if all decoding succeeded.
+  bool FrameParallelDecode(const scoped_refptr<DecoderBuffer>& buffer);
+
+  // Drops the frames still being decoded in frame-parallel mode.
+  void DiscardFrameParallelFrames();
+
+  // Sets the timestamp and the color space of |video_frame|, decoded from
+  // |vpx_image|.
+  void SetFrameProperties(const struct vpx_image* vpx_image,
+                          int64_t timestamp,
+                          VideoFrame* video_frame);
+
   bool CopyVpxImageToVideoFrame(const struct vpx_image* vpx_image,
                                 const struct vpx_image* vpx_image_alpha,
                                 scoped_refptr<VideoFrame>* video_frame);
@@ -103,8 +121,16 @@ class MEDIA_EXPORT VpxVideoDecoder : public VideoDecoder {
   vpx_codec_ctx* vpx_codec_;
   vpx_codec_ctx* vpx_codec_alpha_;
 
-  // |memory_pool_| is a single-threaded memory pool used for VP9 decoding
-  // with no alpha. |frame_pool_| is used for all other cases.
+  // True if |vpx_codec_| decodes several frames at once, on a thread each. See
+  // switches::kEnableVp9FrameParallelDecoding.
+  bool frame_parallel_;
+
+  // Timestamps of the buffers given to |vpx_codec_| in frame-parallel mode
+  // whose frames haven't been output yet, in decode order.
+  std::deque<int64_t> pending_timestamps_;
+
+  // |memory_pool_| is a memory pool used for VP9 decoding with no alpha.
+  // |frame_pool_| is used for all other cases.
   class MemoryPool;
   scoped_refptr<MemoryPool> memory_pool_;
 
@@ -557,31 +557,45 @@ bool MP4StreamParser::EnqueueSample(BufferQueue* audio_buffers,
     subsamples = decrypt_config->subsamples();
   }
 
-  std::vector<uint8_t> frame_buf(buf, buf + runs_->sample_size());
-  if (video) {
-    if (runs_->video_description().video_codec == kCodecH264 ||
-        runs_->video_description().video_codec == kCodecHEVC) {
-      DCHECK(runs_->video_description().frame_bitstream_converter);
-      if (!runs_->video_description().frame_bitstream_converter->ConvertFrame(
-              &frame_buf, runs_->is_keyframe(), &subsamples)) {
-        MEDIA_LOG(ERROR, media_log_)
-            << "Failed to prepare video sample for decode";
-        *err = true;
-        return false;
-      }
-    }
-  }
-
-  if (audio) {
-    if (ESDescriptor::IsAAC(runs_->audio_description().esds.object_type) &&
-        !PrepareAACBuffer(runs_->audio_description().esds.aac,
-                          &frame_buf, &subsamples)) {
-      MEDIA_LOG(ERROR, media_log_) << "Failed to prepare AAC sample for decode";
+  const bool convert_video =
+      video && (runs_->video_description().video_codec == kCodecH264 ||
+                runs_->video_description().video_codec == kCodecHEVC);
+  const bool convert_audio =
+      audio && ESDescriptor::IsAAC(runs_->audio_description().esds.object_type);
+
+  // Only the samples which are rewritten for the decoders need a copy of
+  // their own. The others are copied straight from |queue_| into their
+  // StreamParserBuffer.
+  const uint8_t* frame_data = buf;
+  size_t frame_size = runs_->sample_size();
+  std::vector<uint8_t> frame_buf;
+  if (convert_video || convert_audio)
+    frame_buf.assign(buf, buf + runs_->sample_size());
+
+  if (convert_video) {
+    DCHECK(runs_->video_description().frame_bitstream_converter);
+    if (!runs_->video_description().frame_bitstream_converter->ConvertFrame(
+            &frame_buf, runs_->is_keyframe(), &subsamples)) {
+      MEDIA_LOG(ERROR, media_log_)
+          << "Failed to prepare video sample for decode";
       *err = true;
       return false;
     }
   }
 
+  if (convert_audio &&
+      !PrepareAACBuffer(runs_->audio_description().esds.aac,
+                        &frame_buf, &subsamples)) {
+    MEDIA_LOG(ERROR, media_log_) << "Failed to prepare AAC sample for decode";
+    *err = true;
+    return false;
+  }
+
+  if (convert_video || convert_audio) {
+    frame_data = frame_buf.data();
+    frame_size = frame_buf.size();
+  }
+
   if (decrypt_config) {
     if (!subsamples.empty()) {
     // Create a new config with the updated subsamples.
@@ -606,9 +620,8 @@ bool MP4StreamParser::EnqueueSample(BufferQueue* audio_buffers,
   // type and allow multiple tracks for same media type, if applicable. See
   // https://crbug.com/341581.
   scoped_refptr<StreamParserBuffer> stream_buf =
-      StreamParserBuffer::CopyFrom(&frame_buf[0], frame_buf.size(),
-                                   runs_->is_keyframe(),
-                                   buffer_type, 0);
+      StreamParserBuffer::CopyFrom(frame_data, frame_size,
+                                   runs_->is_keyframe(), buffer_type, 0);
 
   if (decrypt_config)
     stream_buf->set_decrypt_config(std::move(decrypt_config));
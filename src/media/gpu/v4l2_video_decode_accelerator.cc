@@ -14,8 +14,11 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/memory/ptr_util.h"
 #include "base/message_loop/message_loop.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/single_thread_task_runner.h"
@@ -178,6 +181,7 @@ V4L2VideoDecodeAccelerator::V4L2VideoDecodeAccelerator(
       get_gl_context_cb_(get_gl_context_cb),
       make_context_current_cb_(make_context_current_cb),
       video_profile_(VIDEO_CODEC_PROFILE_UNKNOWN),
+      output_mode_(Config::OutputMode::ALLOCATE),
       output_format_fourcc_(0),
       egl_image_format_fourcc_(0),
       egl_image_planes_count_(0),
@@ -216,8 +220,9 @@ bool V4L2VideoDecodeAccelerator::Initialize(const Config& config,
     return false;
   }
 
-  if (config.output_mode != Config::OutputMode::ALLOCATE) {
-    NOTREACHED() << "Only ALLOCATE OutputMode is supported by this VDA";
+  if (config.output_mode != Config::OutputMode::ALLOCATE &&
+      config.output_mode != Config::OutputMode::IMPORT) {
+    NOTREACHED() << "Only ALLOCATE and IMPORT OutputModes are supported";
     return false;
   }
 
@@ -238,6 +243,7 @@ bool V4L2VideoDecodeAccelerator::Initialize(const Config& config,
   }
 
   video_profile_ = config.profile;
+  output_mode_ = config.output_mode;
 
   if (egl_display_ == EGL_NO_DISPLAY) {
     LOGF(ERROR) << "could not get EGLDisplay";
@@ -271,6 +277,14 @@ bool V4L2VideoDecodeAccelerator::Initialize(const Config& config,
   if (!SetupFormats())
     return false;
 
+  // Imported buffers are decoded into directly, so there's no room for an
+  // image processor.
+  if (output_mode_ == Config::OutputMode::IMPORT && image_processor_device_) {
+    LOGF(ERROR) << "IMPORT OutputMode needs an output format usable without "
+                << "an image processor";
+    return false;
+  }
+
   // Subscribe to the resolution change event.
   struct v4l2_event_subscription sub;
   memset(&sub, 0, sizeof(sub));
@@ -335,15 +349,6 @@ void V4L2VideoDecodeAccelerator::AssignPictureBuffers(
     return;
   }
 
-  gl::GLContext* gl_context = get_gl_context_cb_.Run();
-  if (!gl_context || !make_context_current_cb_.Run()) {
-    LOGF(ERROR) << "could not make context current";
-    NOTIFY_ERROR(PLATFORM_FAILURE);
-    return;
-  }
-
-  gl::ScopedTextureBinder bind_restore(GL_TEXTURE_EXTERNAL_OES, 0);
-
   // It's safe to manipulate all the buffer state here, because the decoder
   // thread is waiting on pictures_assigned_.
 
@@ -352,7 +357,9 @@ void V4L2VideoDecodeAccelerator::AssignPictureBuffers(
   memset(&reqbufs, 0, sizeof(reqbufs));
   reqbufs.count = buffers.size();
   reqbufs.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
-  reqbufs.memory = V4L2_MEMORY_MMAP;
+  reqbufs.memory =
+      (output_mode_ == Config::OutputMode::ALLOCATE ? V4L2_MEMORY_MMAP
+                                                    : V4L2_MEMORY_DMABUF);
   IOCTL_OR_ERROR_RETURN(VIDIOC_REQBUFS, &reqbufs);
 
   if (reqbufs.count != buffers.size()) {
@@ -361,6 +368,34 @@ void V4L2VideoDecodeAccelerator::AssignPictureBuffers(
     return;
   }
 
+  if (output_mode_ == Config::OutputMode::IMPORT) {
+    output_buffer_map_.resize(buffers.size());
+    DCHECK(free_output_buffers_.empty());
+    for (size_t i = 0; i < output_buffer_map_.size(); ++i) {
+      DCHECK(buffers[i].size() == coded_size_);
+      OutputRecord& output_record = output_buffer_map_[i];
+      DCHECK_EQ(output_record.state, kFree);
+      DCHECK_EQ(output_record.picture_id, -1);
+      DCHECK(output_record.fds.empty());
+      output_record.picture_id = buffers[i].id();
+      // The buffer stays with the client until ImportBufferForPicture() gives
+      // us its DMABUFs.
+      output_record.state = kAtClient;
+      DVLOGF(3) << "buffer[" << i << "]: picture_id=" << buffers[i].id();
+    }
+    pictures_assigned_.Signal();
+    return;
+  }
+
+  gl::GLContext* gl_context = get_gl_context_cb_.Run();
+  if (!gl_context || !make_context_current_cb_.Run()) {
+    LOGF(ERROR) << "could not make context current";
+    NOTIFY_ERROR(PLATFORM_FAILURE);
+    return;
+  }
+
+  gl::ScopedTextureBinder bind_restore(GL_TEXTURE_EXTERNAL_OES, 0);
+
   if (image_processor_device_) {
     DCHECK(!image_processor_);
     image_processor_.reset(new V4L2ImageProcessor(image_processor_device_));
@@ -444,6 +479,33 @@ void V4L2VideoDecodeAccelerator::AssignPictureBuffers(
   pictures_assigned_.Signal();
 }
 
+void V4L2VideoDecodeAccelerator::ImportBufferForPicture(
+    int32_t picture_buffer_id,
+    const gfx::GpuMemoryBufferHandle& gpu_memory_buffer_handle) {
+  DVLOGF(3) << "picture_buffer_id=" << picture_buffer_id;
+  DCHECK(child_task_runner_->BelongsToCurrentThread());
+
+  auto passed_dmabuf_fds(base::WrapUnique(new std::vector<base::ScopedFD>()));
+#if defined(USE_OZONE)
+  for (const auto& fd : gpu_memory_buffer_handle.native_pixmap_handle.fds) {
+    DCHECK_NE(fd.fd, -1);
+    passed_dmabuf_fds->push_back(base::ScopedFD(fd.fd));
+  }
+#endif
+
+  if (output_mode_ != Config::OutputMode::IMPORT) {
+    LOGF(ERROR) << "Cannot import in non-import mode";
+    NOTIFY_ERROR(INVALID_ARGUMENT);
+    return;
+  }
+
+  decoder_thread_.message_loop()->PostTask(
+      FROM_HERE,
+      base::Bind(&V4L2VideoDecodeAccelerator::ImportBufferForPictureTask,
+                 base::Unretained(this), picture_buffer_id,
+                 base::Passed(&passed_dmabuf_fds)));
+}
+
 void V4L2VideoDecodeAccelerator::ReusePictureBuffer(int32_t picture_buffer_id) {
   DVLOGF(3) << "picture_buffer_id=" << picture_buffer_id;
   // Must be run on child thread, as we'll insert a sync in the EGL context.
@@ -551,6 +613,10 @@ void V4L2VideoDecodeAccelerator::DecodeTask(
   if (bitstream_buffer.size() == 0)
     return;
 
+  decode_start_times_[bitstream_buffer.id()] = base::TimeTicks::Now();
+  if (decode_start_times_.size() > kMaxDecodeStartTimes)
+    decode_start_times_.erase(decode_start_times_.begin());
+
   if (!bitstream_record->shm->Map()) {
     LOGF(ERROR) << "could not map bitstream_buffer";
     NOTIFY_ERROR(UNREADABLE_INPUT);
@@ -1142,7 +1208,9 @@ void V4L2VideoDecodeAccelerator::Dequeue() {
     memset(&dqbuf, 0, sizeof(dqbuf));
     memset(planes.get(), 0, sizeof(struct v4l2_plane) * output_planes_count_);
     dqbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
-    dqbuf.memory = V4L2_MEMORY_MMAP;
+    dqbuf.memory =
+        (output_mode_ == Config::OutputMode::ALLOCATE ? V4L2_MEMORY_MMAP
+                                                      : V4L2_MEMORY_DMABUF);
     dqbuf.m.planes = planes.get();
     dqbuf.length = output_planes_count_;
     if (device_->Ioctl(VIDIOC_DQBUF, &dqbuf) != 0) {
@@ -1156,7 +1224,8 @@ void V4L2VideoDecodeAccelerator::Dequeue() {
     }
     OutputRecord& output_record = output_buffer_map_[dqbuf.index];
     DCHECK_EQ(output_record.state, kAtDevice);
-    DCHECK_NE(output_record.egl_image, EGL_NO_IMAGE_KHR);
+    DCHECK(output_mode_ == Config::OutputMode::IMPORT ||
+           output_record.egl_image != EGL_NO_IMAGE_KHR);
     DCHECK_NE(output_record.picture_id, -1);
     output_buffer_queued_count_--;
     if (dqbuf.m.planes[0].bytesused == 0) {
@@ -1191,6 +1260,7 @@ void V4L2VideoDecodeAccelerator::Dequeue() {
       } else {
         output_record.state = kAtClient;
         decoder_frames_at_client_++;
+        TraceDecodeLatency(bitstream_buffer_id);
         const Picture picture(output_record.picture_id, bitstream_buffer_id,
                               gfx::Rect(visible_size_), false);
         pending_picture_ready_.push(
@@ -1240,7 +1310,8 @@ bool V4L2VideoDecodeAccelerator::EnqueueOutputRecord() {
   const int buffer = free_output_buffers_.front();
   OutputRecord& output_record = output_buffer_map_[buffer];
   DCHECK_EQ(output_record.state, kFree);
-  DCHECK_NE(output_record.egl_image, EGL_NO_IMAGE_KHR);
+  DCHECK(output_mode_ == Config::OutputMode::IMPORT ||
+         output_record.egl_image != EGL_NO_IMAGE_KHR);
   DCHECK_NE(output_record.picture_id, -1);
   if (output_record.egl_sync != EGL_NO_SYNC_KHR) {
     TRACE_EVENT0("Video Decoder",
@@ -1268,7 +1339,16 @@ bool V4L2VideoDecodeAccelerator::EnqueueOutputRecord() {
          sizeof(struct v4l2_plane) * output_planes_count_);
   qbuf.index = buffer;
   qbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
-  qbuf.memory = V4L2_MEMORY_MMAP;
+  if (output_mode_ == Config::OutputMode::ALLOCATE) {
+    qbuf.memory = V4L2_MEMORY_MMAP;
+  } else {
+    qbuf.memory = V4L2_MEMORY_DMABUF;
+    DCHECK_EQ(output_planes_count_, output_record.fds.size());
+    for (size_t i = 0; i < output_record.fds.size(); ++i) {
+      DCHECK(output_record.fds[i].is_valid());
+      qbuf_planes[i].m.fd = output_record.fds[i].get();
+    }
+  }
   qbuf.m.planes = qbuf_planes.get();
   qbuf.length = output_planes_count_;
   IOCTL_OR_ERROR_RETURN_FALSE(VIDIOC_QBUF, &qbuf);
@@ -1330,6 +1410,51 @@ void V4L2VideoDecodeAccelerator::ReusePictureBufferTask(
   Enqueue();
 }
 
+void V4L2VideoDecodeAccelerator::ImportBufferForPictureTask(
+    int32_t picture_buffer_id,
+    std::unique_ptr<std::vector<base::ScopedFD>> passed_dmabuf_fds) {
+  DVLOGF(3) << "picture_buffer_id=" << picture_buffer_id;
+  DCHECK(decoder_thread_.task_runner()->BelongsToCurrentThread());
+
+  if (decoder_state_ == kError) {
+    DVLOGF(2) << "early out: kError state";
+    return;
+  }
+
+  const auto iter =
+      std::find_if(output_buffer_map_.begin(), output_buffer_map_.end(),
+                   [picture_buffer_id](const OutputRecord& output_record) {
+                     return output_record.picture_id == picture_buffer_id;
+                   });
+  if (iter == output_buffer_map_.end()) {
+    // It's possible that we've already posted a DismissPictureBuffer for this
+    // picture, but it has not yet executed when this ImportBufferForPicture was
+    // posted to us by the client. In that case just ignore this (we've already
+    // dismissed it and accounted for that).
+    DVLOGF(3) << "got picture id=" << picture_buffer_id
+              << " not in use (anymore?).";
+    return;
+  }
+
+  if (iter->state != kAtClient || !iter->fds.empty()) {
+    LOGF(ERROR) << "Cannot import buffer that not owned by client";
+    NOTIFY_ERROR(INVALID_ARGUMENT);
+    return;
+  }
+
+  if (passed_dmabuf_fds->size() != output_planes_count_) {
+    LOGF(ERROR) << "Imported " << passed_dmabuf_fds->size()
+                << " planes, expected " << output_planes_count_;
+    NOTIFY_ERROR(INVALID_ARGUMENT);
+    return;
+  }
+
+  iter->fds.swap(*passed_dmabuf_fds);
+  iter->state = kFree;
+  free_output_buffers_.push(iter - output_buffer_map_.begin());
+  Enqueue();
+}
+
 void V4L2VideoDecodeAccelerator::FlushTask() {
   DVLOGF(3);
   DCHECK(decoder_thread_.task_runner()->BelongsToCurrentThread());
@@ -1454,6 +1579,7 @@ void V4L2VideoDecodeAccelerator::ResetTask() {
   // Drop all buffers in image processor.
   while (!image_processor_bitstream_buffer_ids_.empty())
     image_processor_bitstream_buffer_ids_.pop();
+  decode_start_times_.clear();
 
   // If we were flushing, we'll never return any more BitstreamBuffers or
   // PictureBuffers; they have all been dropped and returned by now.
@@ -2027,10 +2153,17 @@ bool V4L2VideoDecodeAccelerator::CreateOutputBuffers() {
   DVLOGF(3) << "buffer_count=" << buffer_count
             << ", coded_size=" << egl_image_size_.ToString();
 
+  // With ALLOCATE mode the client can sample it as RGB and doesn't need to
+  // know the precise format.
+  VideoPixelFormat pixel_format =
+      (output_mode_ == Config::OutputMode::IMPORT)
+          ? V4L2Device::V4L2PixFmtToVideoPixelFormat(output_format_fourcc_)
+          : PIXEL_FORMAT_UNKNOWN;
+
   child_task_runner_->PostTask(
       FROM_HERE, base::Bind(&Client::ProvidePictureBuffers, client_,
-                            buffer_count, PIXEL_FORMAT_UNKNOWN, 1,
-                            egl_image_size_, device_->GetTextureTarget()));
+                            buffer_count, pixel_format, 1, egl_image_size_,
+                            device_->GetTextureTarget()));
 
   // Wait for the client to call AssignPictureBuffers() on the Child thread.
   // We do this, because if we continue decoding without finishing buffer
@@ -2111,7 +2244,9 @@ bool V4L2VideoDecodeAccelerator::DestroyOutputBuffers() {
   memset(&reqbufs, 0, sizeof(reqbufs));
   reqbufs.count = 0;
   reqbufs.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
-  reqbufs.memory = V4L2_MEMORY_MMAP;
+  reqbufs.memory =
+      (output_mode_ == Config::OutputMode::ALLOCATE ? V4L2_MEMORY_MMAP
+                                                    : V4L2_MEMORY_DMABUF);
   if (device_->Ioctl(VIDIOC_REQBUFS, &reqbufs) != 0) {
     PLOGF(ERROR) << "ioctl() failed: VIDIOC_REQBUFS";
     success = false;
@@ -2186,6 +2321,17 @@ void V4L2VideoDecodeAccelerator::SendPictureReady() {
   }
 }
 
+void V4L2VideoDecodeAccelerator::TraceDecodeLatency(
+    int32_t bitstream_buffer_id) {
+  DCHECK(decoder_thread_.task_runner()->BelongsToCurrentThread());
+  const auto iter = decode_start_times_.find(bitstream_buffer_id);
+  if (iter == decode_start_times_.end())
+    return;
+  TRACE_COUNTER1("Video Decoder", "V4L2VDA::DecodeLatencyUsec",
+                 (base::TimeTicks::Now() - iter->second).InMicroseconds());
+  decode_start_times_.erase(iter);
+}
+
 void V4L2VideoDecodeAccelerator::PictureCleared() {
   DVLOGF(3) << "clearing count=" << picture_clearing_count_;
   DCHECK(decoder_thread_.task_runner()->BelongsToCurrentThread());
@@ -2213,6 +2359,7 @@ void V4L2VideoDecodeAccelerator::FrameProcessed(int32_t bitstream_buffer_id,
     output_record.state = kAtClient;
     decoder_frames_at_client_++;
     image_processor_bitstream_buffer_ids_.pop();
+    TraceDecodeLatency(bitstream_buffer_id);
     const Picture picture(output_record.picture_id, bitstream_buffer_id,
                           gfx::Rect(visible_size_), false);
     pending_picture_ready_.push(PictureRecord(output_record.cleared, picture));
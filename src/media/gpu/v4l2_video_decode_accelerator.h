@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <map>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/threading/thread.h"
+#include "base/time/time.h"
 #include "media/base/limits.h"
 #include "media/base/video_decoder_config.h"
 #include "media/gpu/gpu_video_decode_accelerator_helpers.h"
@@ -84,6 +86,12 @@ class H264Parser;
 // Resolution change: V4L2VDA destroy image processor when destroying output
 //   buffrers. We cannot drop any frame during resolution change. So V4L2VDA
 //   should destroy output buffers after image processor returns all the frames.
+//
+// In the IMPORT output mode, the decoder decodes straight into the DMABUFs of
+// the buffers the client imports with ImportBufferForPicture(), e.g. the
+// NativePixmaps the compositor scans out as overlays. V4L2VDA then creates no
+// EGLImages, and the mode is only available when the decoder outputs a format
+// the client can use without an image processor.
 class MEDIA_GPU_EXPORT V4L2VideoDecodeAccelerator
     : public VideoDecodeAccelerator {
  public:
@@ -99,6 +107,9 @@ class MEDIA_GPU_EXPORT V4L2VideoDecodeAccelerator
   bool Initialize(const Config& config, Client* client) override;
   void Decode(const BitstreamBuffer& bitstream_buffer) override;
   void AssignPictureBuffers(const std::vector<PictureBuffer>& buffers) override;
+  void ImportBufferForPicture(
+      int32_t picture_buffer_id,
+      const gfx::GpuMemoryBufferHandle& gpu_memory_buffer_handle) override;
   void ReusePictureBuffer(int32_t picture_buffer_id) override;
   void Flush() override;
   void Reset() override;
@@ -125,6 +136,10 @@ class MEDIA_GPU_EXPORT V4L2VideoDecodeAccelerator
     // limits::kMaxVideoFrames to fill up the GpuVideoDecode pipeline,
     // and +1 for a frame in transit.
     kDpbOutputBufferExtraCount = limits::kMaxVideoFrames + 1,
+    // Maximum number of bitstream buffers whose decode start time is kept to
+    // trace the decode latency. Buffers that produce no picture, like those
+    // holding only parameter sets, would otherwise be kept forever.
+    kMaxDecodeStartTimes = 32,
   };
 
   // Internal state of the decoder.
@@ -182,7 +197,8 @@ class MEDIA_GPU_EXPORT V4L2VideoDecodeAccelerator
     int32_t picture_id;     // picture buffer id as returned to PictureReady().
     bool cleared;           // Whether the texture is cleared and safe to render
                             // from. See TextureManager for details.
-    // Exported fds for image processor to import.
+    // Exported fds for image processor to import, or in IMPORT mode the fds
+    // imported from the client, which the buffer is queued with.
     std::vector<base::ScopedFD> fds;
   };
 
@@ -236,6 +252,13 @@ class MEDIA_GPU_EXPORT V4L2VideoDecodeAccelerator
   void ReusePictureBufferTask(int32_t picture_buffer_id,
                               std::unique_ptr<EGLSyncKHRRef> egl_sync_ref);
 
+  // Process an ImportBufferForPicture() API call: start using the buffer of
+  // |picture_buffer_id|, backed by the dmabuf file descriptors in
+  // |passed_dmabuf_fds|, taking ownership of them.
+  void ImportBufferForPictureTask(
+      int32_t picture_buffer_id,
+      std::unique_ptr<std::vector<base::ScopedFD>> passed_dmabuf_fds);
+
   // Flush() task.  Child thread should not submit any more buffers until it
   // receives the NotifyFlushDone callback.  This task will schedule an empty
   // BitstreamBufferRef (with input_id == kFlushBufferId) to perform the flush.
@@ -333,6 +356,10 @@ class MEDIA_GPU_EXPORT V4L2VideoDecodeAccelerator
   // Send decoded pictures to PictureReady.
   void SendPictureReady();
 
+  // Trace the time |bitstream_buffer_id| took from DecodeTask() until its
+  // picture is ready.
+  void TraceDecodeLatency(int32_t bitstream_buffer_id);
+
   // Callback that indicates a picture has been cleared.
   void PictureCleared();
 
@@ -444,6 +471,10 @@ class MEDIA_GPU_EXPORT V4L2VideoDecodeAccelerator
   // Pictures that are ready but not sent to PictureReady yet.
   std::queue<PictureRecord> pending_picture_ready_;
 
+  // Times at which the bitstream buffers still being decoded reached
+  // DecodeTask(), by bitstream buffer id.
+  std::map<int32_t, base::TimeTicks> decode_start_times_;
+
   // The number of pictures that are sent to PictureReady and will be cleared.
   int picture_clearing_count_;
 
@@ -478,6 +509,8 @@ class MEDIA_GPU_EXPORT V4L2VideoDecodeAccelerator
 
   // The codec we'll be decoding for.
   VideoCodecProfile video_profile_;
+  // Whether the client or we allocate the output buffers.
+  Config::OutputMode output_mode_;
   // Chosen output format.
   uint32_t output_format_fourcc_;
 
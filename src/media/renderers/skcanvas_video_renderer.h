@@ -14,7 +14,6 @@
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "media/base/media_export.h"
-#include "media/base/timestamp_constants.h"
 #include "media/base/video_frame.h"
 #include "media/base/video_rotation.h"
 #include "media/filters/context_3d.h"
@@ -78,6 +77,24 @@ class MEDIA_EXPORT SkCanvasVideoRenderer {
       bool premultiply_alpha,
       bool flip_y);
 
+  // Copy the contents of the textures of |video_frame| to texture |texture|
+  // of |destination_gl|.  Frames with a single texture are copied as
+  // CopyVideoFrameSingleTextureToGLTexture() does.  Frames with one texture
+  // per plane are converted to RGB on the GPU, in the context of
+  // |context_3d|, and the result is cached as Paint() does, so that copying
+  // the same frame again only costs the final copy.
+  // Returns false if the frame can't be copied, in which case the caller should
+  // fall back to painting it.
+  bool CopyVideoFrameTexturesToGLTexture(
+      const Context3D& context_3d,
+      gpu::gles2::GLES2Interface* destination_gl,
+      const scoped_refptr<VideoFrame>& video_frame,
+      unsigned int texture,
+      unsigned int internal_format,
+      unsigned int type,
+      bool premultiply_alpha,
+      bool flip_y);
+
   // In general, We hold the most recently painted frame to increase the
   // performance for the case that the same frame needs to be painted
   // repeatedly. Call this function if you are sure the most recent frame will
@@ -85,10 +102,18 @@ class MEDIA_EXPORT SkCanvasVideoRenderer {
   void ResetCache();
 
  private:
+  // Makes |last_image_| the image of |video_frame|, converting the frame only
+  // if |last_image_| isn't already generated from it.  Returns false if the
+  // image couldn't be created.
+  bool UpdateLastImage(const scoped_refptr<VideoFrame>& video_frame,
+                       const Context3D& context_3d);
+
   // Last image used to draw to the canvas.
   sk_sp<SkImage> last_image_;
-  // Timestamp of the videoframe used to generate |last_image_|.
-  base::TimeDelta last_timestamp_ = media::kNoTimestamp();
+  // VideoFrame::unique_id() of the frame used to generate |last_image_|.
+  // Unlike the timestamp, it differs for every frame, e.g. after a seek or for
+  // frames without timestamps.  Only valid if |last_image_| is set.
+  int last_frame_id_ = 0;
   // If |last_image_| is not used for a while, it's deleted to save memory.
   base::DelayTimer last_image_deleting_timer_;
 
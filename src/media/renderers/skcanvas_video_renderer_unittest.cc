@@ -311,6 +311,17 @@ TEST_F(SkCanvasVideoRendererTest, NoTimestamp) {
   EXPECT_EQ(SK_ColorRED, GetColor(target_canvas()));
 }
 
+TEST_F(SkCanvasVideoRendererTest, NewFrameWithSameTimestamp) {
+  Paint(natural_frame(), target_canvas(), kRed);
+  EXPECT_EQ(SK_ColorRED, GetColor(target_canvas()));
+
+  scoped_refptr<VideoFrame> new_frame =
+      VideoFrame::CreateBlackFrame(gfx::Size(kWidth, kHeight));
+  new_frame->set_timestamp(natural_frame()->timestamp());
+  Paint(new_frame, target_canvas(), kBlue);
+  EXPECT_EQ(SK_ColorBLUE, GetColor(target_canvas()));
+}
+
 TEST_F(SkCanvasVideoRendererTest, CroppedFrame) {
   Paint(cropped_frame(), target_canvas(), kNone);
   // Check the corners.
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "base/command_line.h"
+#include "media/base/media_switches.h"
 #include "media/base/test_data_util.h"
 #include "media/test/pipeline_integration_test_base.h"
 #include "testing/perf/perf_test.h"
@@ -52,6 +54,39 @@ static void RunVideoPlaybackBenchmark(const std::string& filename,
   RunPlaybackBenchmark(filename, name, kBenchmarkIterationsVideo, false);
 }
 
+// Reports how fast |filename| decodes when nothing waits for the clock, and
+// how many frames are dropped when it plays in real time.
+static void RunVideoDecodeBenchmark(const std::string& filename,
+                                    const std::string& name) {
+  {
+    PipelineIntegrationTestBase pipeline;
+    ASSERT_EQ(
+        PIPELINE_OK,
+        pipeline.Start(filename, PipelineIntegrationTestBase::kClockless));
+    base::TimeTicks start = base::TimeTicks::Now();
+    pipeline.Play();
+    ASSERT_TRUE(pipeline.WaitUntilOnEnded());
+    const double elapsed_seconds =
+        (base::TimeTicks::Now() - start).InSecondsF();
+    const PipelineStatistics stats = pipeline.GetStatistics();
+    pipeline.Stop();
+    perf_test::PrintResult(name, "", filename + "_decode",
+                           stats.video_frames_decoded / elapsed_seconds,
+                           "frames/s", true);
+  }
+
+  {
+    PipelineIntegrationTestBase pipeline;
+    ASSERT_EQ(PIPELINE_OK, pipeline.Start(filename));
+    pipeline.Play();
+    ASSERT_TRUE(pipeline.WaitUntilOnEnded());
+    const PipelineStatistics stats = pipeline.GetStatistics();
+    pipeline.Stop();
+    perf_test::PrintResult(name, "", filename + "_dropped",
+                           stats.video_frames_dropped, "frames", true);
+  }
+}
+
 static void RunAudioPlaybackBenchmark(const std::string& filename,
                                       const std::string& name) {
   RunPlaybackBenchmark(filename, name, kBenchmarkIterationsAudio, true);
@@ -75,6 +110,16 @@ TEST(PipelineIntegrationPerfTest, VP9PlaybackBenchmark) {
   RunVideoPlaybackBenchmark("bear-vp9.webm", "clockless_video_playback_vp9");
 }
 
+TEST(PipelineIntegrationPerfTest, VP9DecodeBenchmark) {
+  RunVideoDecodeBenchmark("bear-vp9.webm", "video_decode_vp9");
+}
+
+TEST(PipelineIntegrationPerfTest, VP9FrameParallelDecodeBenchmark) {
+  base::CommandLine::ForCurrentProcess()->AppendSwitch(
+      switches::kEnableVp9FrameParallelDecoding);
+  RunVideoDecodeBenchmark("bear-vp9.webm", "video_decode_vp9_frame_parallel");
+}
+
 // Android doesn't build Theora support.
 #if !defined(OS_ANDROID)
 TEST(PipelineIntegrationPerfTest, TheoraPlaybackBenchmark) {
@@ -395,6 +395,10 @@ base::TimeDelta PipelineIntegrationTestBase::GetAudioTime() {
   return clockless_audio_sink_->render_time();
 }
 
+PipelineStatistics PipelineIntegrationTestBase::GetStatistics() {
+  return pipeline_->GetStatistics();
+}
+
 base::TimeTicks DummyTickClock::NowTicks() {
   now_ += base::TimeDelta::FromSeconds(60);
   return now_;
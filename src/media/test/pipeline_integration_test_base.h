@@ -113,6 +113,9 @@ class PipelineIntegrationTestBase : public Pipeline::Client {
   // Pipeline must have been started with clockless playback enabled.
   base::TimeDelta GetAudioTime();
 
+  // Returns the decoding and rendering statistics of the pipeline so far.
+  PipelineStatistics GetStatistics();
+
   // Sets a callback to handle EME "encrypted" event. Must be called to test
   // potentially encrypted media.
   void set_encrypted_media_init_data_cb(
@@ -0,0 +1,143 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "media/webos/base/feed_scheduler.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "media/base/audio_decoder_config.h"
+#include "media/base/video_decoder_config.h"
+
+namespace media {
+
+namespace {
+
+const uint32_t kKiB = 1024;
+const uint32_t kMiB = 1024 * kKiB;
+
+// Video watermarks by coded resolution. HEVC and VP9 streams are typically
+// used for UHD content and compress better, so they share the same table and
+// differ only by resolution.
+const FeedScheduler::Watermarks kVideoSDWatermarks = {1 * kMiB, 3 * kMiB};
+const FeedScheduler::Watermarks kVideoHDWatermarks = {2 * kMiB, 6 * kMiB};
+const FeedScheduler::Watermarks kVideoFHDWatermarks = {3 * kMiB, 10 * kMiB};
+const FeedScheduler::Watermarks kVideoUHDWatermarks = {6 * kMiB, 16 * kMiB};
+
+// Legacy codecs need more bytes for the same duration.
+const int kLegacyVideoCodecFactor = 2;
+
+const FeedScheduler::Watermarks kAudioWatermarks = {64 * kKiB, 256 * kKiB};
+const FeedScheduler::Watermarks kAudioLosslessWatermarks = {256 * kKiB,
+                                                            1 * kMiB};
+
+// Raising the low watermark with the playback rate is capped at this factor.
+const float kMaxPlaybackRateFactor = 4.0f;
+
+FeedScheduler::Watermarks VideoWatermarks(const VideoDecoderConfig& config) {
+  int pixels = config.coded_size().GetArea();
+  FeedScheduler::Watermarks watermarks;
+  if (pixels > 1920 * 1088)
+    watermarks = kVideoUHDWatermarks;
+  else if (pixels > 1280 * 720)
+    watermarks = kVideoFHDWatermarks;
+  else if (pixels > 720 * 576)
+    watermarks = kVideoHDWatermarks;
+  else
+    watermarks = kVideoSDWatermarks;
+
+  switch (config.codec()) {
+    case kCodecMPEG2:
+    case kCodecMPEG4:
+    case kCodecVC1:
+      watermarks.low *= kLegacyVideoCodecFactor;
+      watermarks.high *= kLegacyVideoCodecFactor;
+      break;
+    default:
+      break;
+  }
+  return watermarks;
+}
+
+FeedScheduler::Watermarks AudioWatermarks(const AudioDecoderConfig& config) {
+  switch (config.codec()) {
+    case kCodecFLAC:
+    case kCodecPCM:
+    case kCodecPCM_S16BE:
+    case kCodecPCM_S24BE:
+      return kAudioLosslessWatermarks;
+    default:
+      return kAudioWatermarks;
+  }
+}
+
+}  // namespace
+
+FeedScheduler::FeedScheduler() : playback_rate_(1.0f) {
+  streams_[VIDEO].watermarks = kVideoHDWatermarks;
+  streams_[AUDIO].watermarks = kAudioWatermarks;
+  Reset();
+}
+
+FeedScheduler::~FeedScheduler() {}
+
+void FeedScheduler::ConfigureVideo(const VideoDecoderConfig& config) {
+  streams_[VIDEO].watermarks = VideoWatermarks(config);
+}
+
+void FeedScheduler::ConfigureAudio(const AudioDecoderConfig& config) {
+  streams_[AUDIO].watermarks = AudioWatermarks(config);
+}
+
+void FeedScheduler::SetPlaybackRate(float playback_rate) {
+  playback_rate_ = playback_rate;
+}
+
+void FeedScheduler::UpdateBufferLevel(Stream stream, uint32_t level) {
+  DCHECK_LE(stream, STREAM_MAX);
+  StreamState& state = streams_[stream];
+  state.level = level;
+  if (level >= state.watermarks.high)
+    state.throttled = true;
+  else if (level <= EffectiveLowWatermark(stream))
+    state.throttled = false;
+}
+
+bool FeedScheduler::CanFeed(Stream stream) const {
+  DCHECK_LE(stream, STREAM_MAX);
+  return !streams_[stream].throttled;
+}
+
+bool FeedScheduler::IsThrottled(Stream stream) const {
+  return !CanFeed(stream);
+}
+
+void FeedScheduler::Reset() {
+  for (StreamState& state : streams_) {
+    state.level = 0;
+    state.throttled = false;
+  }
+}
+
+uint32_t FeedScheduler::EffectiveLowWatermark(Stream stream) const {
+  const Watermarks& watermarks = streams_[stream].watermarks;
+  float factor =
+      std::min(std::max(playback_rate_, 1.0f), kMaxPlaybackRateFactor);
+  return std::min(static_cast<uint32_t>(watermarks.low * factor),
+                  watermarks.high);
+}
+
+}  // namespace media
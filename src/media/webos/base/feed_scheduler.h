@@ -0,0 +1,94 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MEDIA_WEBOS_BASE_FEED_SCHEDULER_H_
+#define MEDIA_WEBOS_BASE_FEED_SCHEDULER_H_
+
+#include <stdint.h>
+
+#include "base/macros.h"
+#include "media/base/media_export.h"
+
+namespace media {
+
+class AudioDecoderConfig;
+class VideoDecoderConfig;
+
+// Paces feeding of ES data to the ESPlayer with per stream high and low
+// watermarks on the buffer level reported by the player. Feeding stops once
+// the level reaches the high watermark and resumes once it drains below the
+// low watermark, which is raised with the playback rate since the player
+// consumes data faster. Watermarks are chosen from the codec and, for video,
+// the coded resolution. Not thread safe; MediaAPIsWrapper calls it under its
+// lock.
+class MEDIA_EXPORT FeedScheduler {
+ public:
+  enum Stream {
+    VIDEO = 0,
+    AUDIO,
+    STREAM_MAX = AUDIO,
+  };
+
+  // Buffer levels, in bytes queued in the ESPlayer.
+  struct Watermarks {
+    uint32_t low;
+    uint32_t high;
+  };
+
+  FeedScheduler();
+  ~FeedScheduler();
+
+  void ConfigureVideo(const VideoDecoderConfig& config);
+  void ConfigureAudio(const AudioDecoderConfig& config);
+
+  void SetPlaybackRate(float playback_rate);
+
+  // Records the buffer level last reported by the ESPlayer for |stream|.
+  void UpdateBufferLevel(Stream stream, uint32_t level);
+
+  // Returns whether more data of |stream| may be fed.
+  bool CanFeed(Stream stream) const;
+
+  // Returns whether feeding of |stream| is paused waiting for the buffer
+  // level to drop, in which case the caller should refresh the level.
+  bool IsThrottled(Stream stream) const;
+
+  // Forgets buffer levels, e.g. after the player has been flushed for a seek,
+  // so that the player is refilled as fast as possible.
+  void Reset();
+
+  Watermarks watermarks(Stream stream) const {
+    return streams_[stream].watermarks;
+  }
+
+ private:
+  struct StreamState {
+    Watermarks watermarks;
+    uint32_t level;
+    bool throttled;
+  };
+
+  uint32_t EffectiveLowWatermark(Stream stream) const;
+
+  StreamState streams_[STREAM_MAX + 1];
+  float playback_rate_;
+
+  DISALLOW_COPY_AND_ASSIGN(FeedScheduler);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_WEBOS_BASE_FEED_SCHEDULER_H_
@@ -6,8 +6,15 @@
 
 #include <glib.h>
 
+#include <utility>
+
+#include "base/bind.h"
 #include "base/callback_helpers.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread.h"
+#include "base/trace_event/trace_event.h"
 
 #define DEBUG_LOG(format, ...) \
   RAW_PMLOG_DEBUG("LunaServiceClient " format, ##__VA_ARGS__)
@@ -31,52 +38,230 @@ struct AutoLSError : LSError {
   ~AutoLSError() { LSErrorFree(this); }
 };
 
-// LunaServiceClient implematation
-LunaServiceClient::LunaServiceClient(BusType type)
-    : handle(NULL), context(NULL) {
-  AutoLSError error;
-  if (LSRegisterPubPriv(NULL, &handle, type, &error)) {
-    context = g_main_context_ref(g_main_context_default());
-    LSGmainContextAttach(handle, context, &error);
-  }
+namespace {
+
+void RunGMainLoop(GMainLoop* main_loop) {
+  g_main_loop_run(main_loop);
 }
 
-LunaServiceClient::~LunaServiceClient() {
+// A process-wide Luna bus registration. The handle is attached to a private
+// GMainContext iterated on its own thread, and replies of every client are
+// routed by message token. Never destroyed.
+class LunaServiceBus {
+ public:
+  explicit LunaServiceBus(LunaServiceClient::BusType type);
+
+  bool Call(const LunaServiceClient* owner,
+            const std::string& uri,
+            const std::string& param,
+            const LunaServiceClient::ResponseCB& callback,
+            bool subscription,
+            LSMessageToken* token);
+  bool Cancel(LSMessageToken token);
+  void CancelAll(const LunaServiceClient* owner);
+
+ private:
+  typedef std::map<LSMessageToken,
+                   std::unique_ptr<LunaServiceClient::ResponseHandlerWrapper>>
+      HandlerMap;
+
+  static bool HandleReply(LSHandle* sh, LSMessage* reply, void* ctx);
+  void DispatchReply(LSMessage* reply);
+
+  base::Thread thread_;
+  GMainContext* context_;
+  GMainLoop* main_loop_;
+  LSHandle* handle_;
+
+  // Guards |handlers_|, which is accessed from the calling threads and the
+  // dispatcher thread.
+  base::Lock lock_;
+  HandlerMap handlers_;
+
+  DISALLOW_COPY_AND_ASSIGN(LunaServiceBus);
+};
+
+LunaServiceBus::LunaServiceBus(LunaServiceClient::BusType type)
+    : thread_("LunaServiceDispatcher"),
+      context_(g_main_context_new()),
+      main_loop_(g_main_loop_new(context_, FALSE)),
+      handle_(NULL) {
+  TRACE_EVENT1("media", "LunaServiceBus::LunaServiceBus", "type", type);
   AutoLSError error;
-  LSUnregister(handle, &error);
-  g_main_context_unref(context);
+  if (!LSRegisterPubPriv(NULL, &handle_, type, &error)) {
+    LOG(ERROR) << "LSRegisterPubPriv failed: " << error.message;
+    handle_ = NULL;
+    return;
+  }
+
+  if (!LSGmainContextAttach(handle_, context_, &error)) {
+    LOG(ERROR) << "LSGmainContextAttach failed: " << error.message;
+    LSUnregister(handle_, &error);
+    handle_ = NULL;
+    return;
+  }
+
+  thread_.Start();
+  thread_.task_runner()->PostTask(FROM_HERE,
+                                  base::Bind(&RunGMainLoop, main_loop_));
 }
 
-bool handleAsync(LSHandle* sh, LSMessage* reply, void* ctx) {
-  LunaServiceClient::ResponseHandlerWrapper* wrapper =
-      static_cast<LunaServiceClient::ResponseHandlerWrapper*>(ctx);
+bool LunaServiceBus::Call(const LunaServiceClient* owner,
+                          const std::string& uri,
+                          const std::string& param,
+                          const LunaServiceClient::ResponseCB& callback,
+                          bool subscription,
+                          LSMessageToken* token) {
+  if (!handle_)
+    return false;
 
-  LSMessageRef(reply);
-  std::string dump = LSMessageGetPayload(reply);
-  DEBUG_LOG("[RES] - %s %s", wrapper->uri.c_str(), dump.c_str());
-  if (!wrapper->callback.is_null())
-    base::ResetAndReturn(&wrapper->callback).Run(dump);
+  std::unique_ptr<LunaServiceClient::ResponseHandlerWrapper> wrapper(
+      new LunaServiceClient::ResponseHandlerWrapper);
+  wrapper->callback = callback;
+  wrapper->uri = uri;
+  wrapper->param = param;
+  wrapper->owner = owner;
+  wrapper->subscription = subscription;
 
-  LSMessageUnref(reply);
+  AutoLSError error;
+  LSMessageToken call_token = LSMESSAGE_TOKEN_INVALID;
+  // Hold the lock until the handler is registered, so that a reply which
+  // arrives right away on the dispatcher thread can find it.
+  base::AutoLock auto_lock(lock_);
+  bool result =
+      subscription
+          ? LSCall(handle_, uri.c_str(), param.c_str(), HandleReply, this,
+                   &call_token, &error)
+          : LSCallOneReply(handle_, uri.c_str(), param.c_str(), HandleReply,
+                           this, &call_token, &error);
+  if (!result) {
+    DEBUG_LOG("[CALL] %s:[%s] fail[%s]", uri.c_str(), param.c_str(),
+              error.message);
+    return false;
+  }
 
-  delete wrapper;
+  handlers_[call_token] = std::move(wrapper);
+  if (token)
+    *token = call_token;
+  return true;
+}
 
+bool LunaServiceBus::Cancel(LSMessageToken token) {
+  AutoLSError error;
+  base::AutoLock auto_lock(lock_);
+  handlers_.erase(token);
+  if (!handle_ || !LSCallCancel(handle_, token, &error)) {
+    DEBUG_LOG("[UNSUB] %u fail[%s]", token, error.message);
+    return false;
+  }
   return true;
 }
 
-bool handleSubscribe(LSHandle* sh, LSMessage* reply, void* ctx) {
-  LunaServiceClient::ResponseHandlerWrapper* wrapper =
-      static_cast<LunaServiceClient::ResponseHandlerWrapper*>(ctx);
+void LunaServiceBus::CancelAll(const LunaServiceClient* owner) {
+  base::AutoLock auto_lock(lock_);
+  for (HandlerMap::iterator it = handlers_.begin(); it != handlers_.end();) {
+    if (it->second->owner != owner) {
+      ++it;
+      continue;
+    }
+    AutoLSError error;
+    LSCallCancel(handle_, it->first, &error);
+    it = handlers_.erase(it);
+  }
+}
+
+// static
+bool LunaServiceBus::HandleReply(LSHandle* sh, LSMessage* reply, void* ctx) {
+  static_cast<LunaServiceBus*>(ctx)->DispatchReply(reply);
+  return true;
+}
 
+void LunaServiceBus::DispatchReply(LSMessage* reply) {
   LSMessageRef(reply);
+  LSMessageToken token = LSMessageGetResponseToken(reply);
   std::string dump = LSMessageGetPayload(reply);
-  DEBUG_LOG("[SUB-RES] - %s %s", wrapper->uri.c_str(), dump.c_str());
-  if (!wrapper->callback.is_null())
-    wrapper->callback.Run(dump);
+
+  LunaServiceClient::ResponseCB callback;
+  {
+    base::AutoLock auto_lock(lock_);
+    HandlerMap::iterator it = handlers_.find(token);
+    if (it != handlers_.end()) {
+      DEBUG_LOG("[%s] - %s %s", it->second->subscription ? "SUB-RES" : "RES",
+                it->second->uri.c_str(), dump.c_str());
+      if (it->second->subscription) {
+        callback = it->second->callback;
+      } else {
+        callback = base::ResetAndReturn(&it->second->callback);
+        handlers_.erase(it);
+      }
+    }
+  }
+
+  // Run outside of the lock, the callback may issue new calls.
+  if (!callback.is_null())
+    callback.Run(dump);
 
   LSMessageUnref(reply);
+}
 
-  return true;
+class LunaServiceBusPool {
+ public:
+  LunaServiceBusPool() {}
+
+  LunaServiceBus* Get(LunaServiceClient::BusType type) {
+    base::AutoLock auto_lock(lock_);
+    if (!buses_[type])
+      buses_[type].reset(new LunaServiceBus(type));
+    return buses_[type].get();
+  }
+
+ private:
+  base::Lock lock_;
+  std::unique_ptr<LunaServiceBus> buses_[LunaServiceClient::PublicBus + 1];
+
+  DISALLOW_COPY_AND_ASSIGN(LunaServiceBusPool);
+};
+
+base::LazyInstance<LunaServiceBusPool>::Leaky g_bus_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+class ServiceURICache {
+ public:
+  ServiceURICache() {}
+
+  std::string Get(LunaServiceClient::URIType type,
+                  const std::string& action) {
+    base::AutoLock auto_lock(lock_);
+    std::string& uri = uris_[std::make_pair(type, action)];
+    if (uri.empty()) {
+      uri = luna_service_uris[type];
+      uri.append("/");
+      uri.append(action);
+    }
+    return uri;
+  }
+
+ private:
+  base::Lock lock_;
+  std::map<std::pair<LunaServiceClient::URIType, std::string>, std::string>
+      uris_;
+
+  DISALLOW_COPY_AND_ASSIGN(ServiceURICache);
+};
+
+base::LazyInstance<ServiceURICache>::Leaky g_service_uri_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// LunaServiceClient implematation
+LunaServiceClient::LunaServiceClient(BusType type) : bus_type_(type) {
+  // Makes sure the shared connection exists before the first call.
+  g_bus_pool.Get().Get(bus_type_);
+}
+
+LunaServiceClient::~LunaServiceClient() {
+  g_bus_pool.Get().Get(bus_type_)->CancelAll(this);
 }
 
 bool LunaServiceClient::callASync(const std::string& uri,
@@ -88,20 +273,11 @@ bool LunaServiceClient::callASync(const std::string& uri,
 bool LunaServiceClient::callASync(const std::string& uri,
                                   const std::string& param,
                                   const ResponseCB& callback) {
-  AutoLSError error;
-  ResponseHandlerWrapper* wrapper = new ResponseHandlerWrapper;
-  wrapper->callback = callback;
-  wrapper->uri = uri;
-  wrapper->param = param;
-
-  if (!wrapper)
-    return false;
-
   DEBUG_LOG("[REQ] - %s %s", uri.c_str(), param.c_str());
-  if (!LSCallOneReply(handle, uri.c_str(), param.c_str(), handleAsync, wrapper,
-                      NULL, &error)) {
-    base::ResetAndReturn(&wrapper->callback).Run("");
-    delete wrapper;
+  if (!g_bus_pool.Get().Get(bus_type_)->Call(this, uri, param, callback,
+                                             false, NULL)) {
+    if (!callback.is_null())
+      callback.Run("");
     return false;
   }
 
@@ -112,43 +288,12 @@ bool LunaServiceClient::subscribe(const std::string& uri,
                                   const std::string& param,
                                   LSMessageToken* subscribeKey,
                                   const ResponseCB& callback) {
-  AutoLSError error;
-  ResponseHandlerWrapper* wrapper = new ResponseHandlerWrapper;
-  wrapper->callback = callback;
-  wrapper->uri = uri;
-  wrapper->param = param;
-
-  if (!wrapper)
-    return false;
-
-  if (!LSCall(handle, uri.c_str(), param.c_str(), handleSubscribe, wrapper,
-              subscribeKey, &error)) {
-    DEBUG_LOG("[SUB] %s:[%s] fail[%s]", uri.c_str(), param.c_str(),
-              error.message);
-    delete wrapper;
-    return false;
-  }
-
-  handlers[*subscribeKey] = std::unique_ptr<ResponseHandlerWrapper>(wrapper);
-
-  return true;
+  return g_bus_pool.Get().Get(bus_type_)->Call(this, uri, param, callback,
+                                               true, subscribeKey);
 }
 
 bool LunaServiceClient::unsubscribe(LSMessageToken subscribeKey) {
-  AutoLSError error;
-
-  if (!LSCallCancel(handle, subscribeKey, &error)) {
-    DEBUG_LOG("[UNSUB] %u fail[%s]", subscribeKey, error.message);
-    handlers.erase(subscribeKey);
-    return false;
-  }
-
-  if (handlers[subscribeKey])
-    handlers[subscribeKey]->callback.Reset();
-
-  handlers.erase(subscribeKey);
-
-  return true;
+  return g_bus_pool.Get().Get(bus_type_)->Cancel(subscribeKey);
 }
 
 std::string LunaServiceClient::GetServiceURI(URIType type,
@@ -156,10 +301,12 @@ std::string LunaServiceClient::GetServiceURI(URIType type,
   if (type < 0 || type > LunaServiceClient::URITypeMax)
     return std::string();
 
-  std::string uri = luna_service_uris[type];
-  uri.append("/");
-  uri.append(action);
-  return uri;
+  return g_service_uri_cache.Get().Get(type, action);
+}
+
+// static
+void LunaServiceClient::PrepareBus(BusType type) {
+  g_bus_pool.Get().Get(type);
 }
 
 }  // namespace media
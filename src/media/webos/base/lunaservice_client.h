@@ -26,6 +26,11 @@
 
 namespace media {
 
+// Client for calling Luna services. All clients of the same bus type share a
+// single process-wide bus registration whose replies are dispatched on one
+// dedicated thread, so creating a client is cheap. Replies are routed to the
+// issuing client by message token. Callbacks run on the dispatcher thread;
+// callers are expected to bind them to their own loop.
 class MEDIA_EXPORT LunaServiceClient {
  public:
   enum URIType {
@@ -50,6 +55,10 @@ class MEDIA_EXPORT LunaServiceClient {
     LunaServiceClient::ResponseCB callback;
     std::string uri;
     std::string param;
+    // Client that issued the call, used to drop its pending replies and
+    // subscriptions when it goes away.
+    const LunaServiceClient* owner = nullptr;
+    bool subscription = false;
   };
 
   explicit LunaServiceClient(BusType type);
@@ -64,12 +73,16 @@ class MEDIA_EXPORT LunaServiceClient {
                  const ResponseCB& callback);
   bool unsubscribe(LSMessageToken subscribeKey);
 
+  // Returns the URI of |action| on the service of |type|. Results are cached.
   static std::string GetServiceURI(URIType type, const std::string& action);
 
+  // Registers the shared connection for |type| ahead of time, so that the
+  // first client of that bus does not pay for the registration. Safe to call
+  // more than once and from any thread.
+  static void PrepareBus(BusType type);
+
  private:
-  LSHandle* handle;
-  GMainContext* context;
-  std::map<LSMessageToken, std::unique_ptr<ResponseHandlerWrapper>> handlers;
+  BusType bus_type_;
 
   DISALLOW_COPY_AND_ASSIGN(LunaServiceClient);
 };
@@ -4,6 +4,8 @@
 
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/time/time.h"
 #include "content/public/common/content_switches.h"
 #include "media/base/bind_to_current_loop.h"
 #include "third_party/jsoncpp/source/include/json/json.h"
@@ -122,6 +124,10 @@ void MediaAPIsWrapper::Initialize(
   init_cb_ = init_cb;
   audio_config_ = audio_config;
   video_config_ = video_config;
+  if (video_config_.IsValidConfig())
+    feed_scheduler_.ConfigureVideo(video_config_);
+  if (audio_config_.IsValidConfig())
+    feed_scheduler_.ConfigureAudio(audio_config_);
 
   if (state_ != CREATED && state_ != CREATED_SUSPENDED) {
     DEBUG_LOG("bad state %d for initialization", state_);
@@ -169,6 +175,13 @@ bool MediaAPIsWrapper::Loaded() {
 
 bool MediaAPIsWrapper::Feed(
     const scoped_refptr<DecoderBuffer>& buffer, FeedType type) {
+  return FeedBatch(std::vector<scoped_refptr<DecoderBuffer>>(1, buffer), type);
+}
+
+bool MediaAPIsWrapper::FeedBatch(
+    const std::vector<scoped_refptr<DecoderBuffer>>& buffers, FeedType type) {
+  if (buffers.empty())
+    return true;
 
 #if defined(USE_BROADCOM)
   if(type == Video && video_first_frame_feeded_ == false){
@@ -183,35 +196,51 @@ bool MediaAPIsWrapper::Feed(
     can_feed_audio_ = false;
   }
 #endif
-  uint32_t videoBuffersUsed = 0;
+  uint32_t buffers_used = 0;
 
   std::lock_guard<std::recursive_mutex> lock(recursive_mutex_);
 
+  if (!playerReadyForPlayOrSeek())
+    return false;
+
   if (type == Audio)
-    current_pts_ = buffer->timestamp().InMicroseconds();
+    current_pts_ = buffers.back()->timestamp().InMicroseconds();
 
   NDL_ESP_STREAM_T buffer_type;
   buffer_type = (type == Video) ? NDL_ESP_VIDEO_ES : NDL_ESP_AUDIO_ES;
 
-  auto frame = std::make_shared<Frame>(buffer_type, buffer);
-
-  // The A/V frames are fed in to the decoder IN buffers. The feeding will return -1 in the current
-  // buffer if already full. This is possible during SEEK if the audio and
-  // the video streams at the access point closest to the selected seek point have TS's different
-  // by a few seconds. In such case the decoder will hold the audio queue filling the video queue.
-  // If the video buffer length is not long enough to compensate the difference the frames will be
-  // skipped.
-  if (frame && playerReadyForPlayOrSeek()) {
+  base::TimeTicks feed_start = base::TimeTicks::Now();
+  for (const auto& buffer : buffers) {
+    auto frame = std::make_shared<Frame>(buffer_type, buffer);
+
+    // The A/V frames are fed in to the decoder IN buffers. The feeding will
+    // return -1 in the current buffer if already full. This is possible
+    // during SEEK if the audio and the video streams at the access point
+    // closest to the selected seek point have TS's different by a few
+    // seconds. In such case the decoder will hold the audio queue filling the
+    // video queue. If the video buffer length is not long enough to
+    // compensate the difference the frames will be skipped.
     if (NDL_EsplayerFeedData(esplayer_, frame) < 0)
       INFO_LOG("feed failed, skipping %s frame",
           buffer_type == NDL_ESP_VIDEO_ES ? "video" : "audio");
+  }
+  base::TimeDelta feed_latency = base::TimeTicks::Now() - feed_start;
 
-    if (buffer_type == NDL_ESP_VIDEO_ES) {
-      if (NDL_EsplayerGetBufferLevel(esplayer_, NDL_ESP_VIDEO_ES, &videoBuffersUsed) != 0)
-        INFO_LOG("error in failed to get buffer level");
-    }
+  if (NDL_EsplayerGetBufferLevel(esplayer_, buffer_type, &buffers_used) != 0)
+    INFO_LOG("error in failed to get buffer level");
+
+  feed_scheduler_.UpdateBufferLevel(
+      type == Video ? FeedScheduler::VIDEO : FeedScheduler::AUDIO,
+      buffers_used);
+
+  if (buffer_type == NDL_ESP_VIDEO_ES) {
+    UMA_HISTOGRAM_TIMES("Media.WebOS.ESPlayer.VideoFeedLatency", feed_latency);
+    UMA_HISTOGRAM_COUNTS("Media.WebOS.ESPlayer.VideoBufferLevel",
+                         buffers_used);
   } else {
-    return false;
+    UMA_HISTOGRAM_TIMES("Media.WebOS.ESPlayer.AudioFeedLatency", feed_latency);
+    UMA_HISTOGRAM_COUNTS("Media.WebOS.ESPlayer.AudioBufferLevel",
+                         buffers_used);
   }
 
   return true;
@@ -240,6 +269,9 @@ bool MediaAPIsWrapper::Seek(base::TimeDelta time) {
     return false;
   }
 
+  // The player is empty now, refill it without waiting for the watermarks.
+  feed_scheduler_.Reset();
+
   return true;
 }
 
@@ -249,6 +281,7 @@ void MediaAPIsWrapper::SetPlaybackRate(float playback_rate) {
 
   float current_playback_rate = playback_rate_;
   playback_rate_ = playback_rate;
+  feed_scheduler_.SetPlaybackRate(playback_rate);
 
   DEBUG_LOG("SetPlaybackRate(%f) [%d]", playback_rate, state_);
   if (!esplayer_)
@@ -348,7 +381,7 @@ bool MediaAPIsWrapper::allowedFeedVideo() {
 
   //DEBUG_LOG("%s", __FUNCTION__);
 
-  return can_feed_video_;
+  return can_feed_video_ && schedulerAllowsFeed(Video);
 }
 
 bool MediaAPIsWrapper::allowedFeedAudio() {
@@ -356,7 +389,25 @@ bool MediaAPIsWrapper::allowedFeedAudio() {
 
   //DEBUG_LOG("%s", __FUNCTION__);
 
-  return can_feed_audio_;
+  return can_feed_audio_ && schedulerAllowsFeed(Audio);
+}
+
+bool MediaAPIsWrapper::schedulerAllowsFeed(FeedType type) {
+  FeedScheduler::Stream stream =
+      type == Video ? FeedScheduler::VIDEO : FeedScheduler::AUDIO;
+
+  // While throttled nothing is fed, so the level is not refreshed by
+  // FeedBatch. Poll the player until it has drained below the low watermark.
+  if (feed_scheduler_.IsThrottled(stream) && esplayer_) {
+    uint32_t buffers_used = 0;
+    if (NDL_EsplayerGetBufferLevel(
+            esplayer_, type == Video ? NDL_ESP_VIDEO_ES : NDL_ESP_AUDIO_ES,
+            &buffers_used) == 0) {
+      feed_scheduler_.UpdateBufferLevel(stream, buffers_used);
+    }
+  }
+
+  return feed_scheduler_.CanFeed(stream);
 }
 
 void MediaAPIsWrapper::Finalize() {
@@ -855,6 +906,9 @@ void MediaAPIsWrapper::SetNaturalSize(const gfx::Size& size) {}
 bool MediaAPIsWrapper::Loaded() { return false; }
 bool MediaAPIsWrapper::Feed(const scoped_refptr<DecoderBuffer>& buffer,
                             FeedType type) { return false; }
+bool MediaAPIsWrapper::FeedBatch(
+    const std::vector<scoped_refptr<DecoderBuffer>>& buffers,
+    FeedType type) { return false; }
 uint64_t MediaAPIsWrapper::GetCurrentTime() { return 0; }
 bool MediaAPIsWrapper::Seek(base::TimeDelta time) { return false; }
 void MediaAPIsWrapper::SetPlaybackRate(float playback_rate) {}
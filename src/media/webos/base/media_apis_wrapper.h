@@ -19,12 +19,14 @@
 
 #include <string>
 #include <mutex>
+#include <vector>
 
 #include "base/synchronization/lock.h"
 #include "media/base/audio_decoder_config.h"
 #include "media/base/decoder_buffer.h"
 #include "media/base/pipeline_status.h"
 #include "media/base/video_decoder_config.h"
+#include "media/webos/base/feed_scheduler.h"
 #include "media/webos/base/lunaservice_client.h"
 #include "third_party/jsoncpp/source/include/json/json.h"
 #include "third_party/WebKit/public/platform/WebRect.h"
@@ -43,16 +45,24 @@ class SingleThreadTaskRunner;
 namespace media {
 
 #if defined(USE_DIRECTMEDIA2)
+// An ES access unit handed to the ESPlayer. The frame references the storage
+// of the DecoderBuffer, which stays alive for as long as the ESPlayer holds
+// the frame, instead of copying it. Only encrypted buffers are still copied
+// on platforms whose secure path may decrypt in place.
 class Frame : public NDL_ESP_STREAM_BUFFER {
 public:
  Frame(NDL_ESP_STREAM_T type, const scoped_refptr<DecoderBuffer>& buffer)
-#if defined(PLATFORM_APOLLO)
      : decoder_buffer(buffer) {
-   data = (uint8_t*)buffer->data();
+#if !defined(PLATFORM_APOLLO)
+   owns_data = !!buffer->decrypt_config();
+   if (owns_data) {
+     data = new uint8_t[buffer->data_size()];
+     memcpy(data, buffer->data(), buffer->data_size());
+   } else {
+     data = const_cast<uint8_t*>(buffer->data());
+   }
 #else
- {
-   data = new uint8_t[buffer->data_size()];
-   memcpy(data, buffer->data(), buffer->data_size());
+   data = const_cast<uint8_t*>(buffer->data());
 #endif
    data_len = buffer->data_size();
    offset = 0;
@@ -72,12 +82,14 @@ public:
  }
  ~Frame() {
 #if !defined(PLATFORM_APOLLO)
-   delete[] data;
+   if (owns_data)
+     delete[] data;
 #endif
  }
-#if defined(PLATFORM_APOLLO)
 private:
  scoped_refptr<DecoderBuffer> decoder_buffer;
+#if !defined(PLATFORM_APOLLO)
+ bool owns_data = false;
 #endif
 };
 #endif
@@ -117,6 +129,11 @@ public:
 
   bool Loaded();
   bool Feed(const scoped_refptr<DecoderBuffer>& buffer, FeedType type);
+  // Feeds several access units of the same stream while taking the player
+  // lock and checking the player state only once, and queries the buffer
+  // level once for the whole batch.
+  bool FeedBatch(const std::vector<scoped_refptr<DecoderBuffer>>& buffers,
+                 FeedType type);
   uint64_t GetCurrentTime();
   bool Seek(base::TimeDelta time);
   void SetPlaybackRate(float playback_rate);
@@ -212,6 +229,12 @@ public:
 #endif
 #endif
 
+#if defined(USE_DIRECTMEDIA2)
+  // Paces feeding on top of can_feed_video_/can_feed_audio_, which follow
+  // the ESPlayer threshold callbacks.
+  FeedScheduler feed_scheduler_;
+#endif
+
   LunaServiceClient ls_client_;
   base::WeakPtrFactory<MediaAPIsWrapper> weak_factory_;
   // helpers
@@ -227,6 +250,7 @@ public:
   bool pause();
   void enableAVFeed();
   void disableAVFeed();
+  bool schedulerAllowsFeed(FeedType type);
   bool playerReadyForPlayOrSeek();
   std::string getMediaID(void);
 
@@ -27,13 +27,19 @@
 
 namespace media {
 
+// Number of access units that may be queued and fed to the ESPlayer in a
+// single batch.
+static const int kMaxFeedBatchSize = 4;
+
 TvVideoDecoder::TvVideoDecoder(
     const scoped_refptr<base::SingleThreadTaskRunner>& task_runner,
     const scoped_refptr<MediaAPIsWrapper>& media_apis_wrapper)
     : task_runner_(task_runner),
       state_(kUninitialized),
       decode_nalus_(false),
-      media_apis_wrapper_(media_apis_wrapper) {
+      media_apis_wrapper_(media_apis_wrapper),
+      feed_scheduled_(false),
+      weak_factory_(this) {
 }
 
 std::string TvVideoDecoder::GetDisplayName() const {
@@ -106,46 +112,93 @@ void TvVideoDecoder::Decode(const scoped_refptr<DecoderBuffer>& buffer,
   // (any state) -> kNormal:
   //     Any time Reset() is called.
 
-  bool has_produced_frame;
-  do {
-    has_produced_frame = false;
-    if (buffer->data() && buffer->data_size() > 0) {
-      if (!media_apis_wrapper_) {
-        state_ = kError;
-        decode_cb_bound.Run(DecodeStatus::DECODE_ERROR);
-        return;
-      }
-
-      if (!media_apis_wrapper_->Feed(buffer, MediaAPIsWrapper::Video)) {
-        state_ = kError;
-        decode_cb_bound.Run(DecodeStatus::DECODE_ERROR);
-        return;
-      }
-      has_produced_frame = true;
-
-      scoped_refptr<media::VideoFrame> video_frame =
-        media::VideoFrame::CreateHoleFrame(config_.natural_size());
-      video_frame->set_timestamp(buffer->timestamp());
-
-      output_cb_.Run(video_frame);
-    }
-    // Repeat to flush the decoder after receiving EOS buffer.
-  } while (buffer->end_of_stream() && has_produced_frame);
+  if (!media_apis_wrapper_) {
+    AbortPendingBuffers(DecodeStatus::DECODE_ERROR);
+    state_ = kError;
+    decode_cb_bound.Run(DecodeStatus::DECODE_ERROR);
+    return;
+  }
 
   if (buffer->end_of_stream()) {
+    // Everything queued so far must reach the ESPlayer before the EOS.
+    FeedPendingBuffers();
+    if (state_ == kError) {
+      decode_cb_bound.Run(DecodeStatus::DECODE_ERROR);
+      return;
+    }
     if (!media_apis_wrapper_->Feed(buffer, MediaAPIsWrapper::Video)) {
       state_ = kError;
       decode_cb_bound.Run(DecodeStatus::DECODE_ERROR);
       return;
     }
     state_ = kDecodeFinished;
+    decode_cb_bound.Run(DecodeStatus::OK);
+    return;
+  }
+
+  if (!buffer->data() || buffer->data_size() == 0) {
+    decode_cb_bound.Run(DecodeStatus::OK);
+    return;
+  }
+
+  // Queue the buffer and feed the queue either once it is full, or once all
+  // the Decode() calls already posted to this thread have been handled.
+  pending_buffers_.push_back(buffer);
+  pending_decode_cbs_.push_back(decode_cb_bound);
+  if (pending_buffers_.size() >= static_cast<size_t>(kMaxFeedBatchSize)) {
+    FeedPendingBuffers();
+  } else if (!feed_scheduled_) {
+    feed_scheduled_ = true;
+    task_runner_->PostTask(FROM_HERE,
+                           base::Bind(&TvVideoDecoder::FeedPendingBuffers,
+                                      weak_factory_.GetWeakPtr()));
   }
+}
+
+void TvVideoDecoder::FeedPendingBuffers() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  feed_scheduled_ = false;
+  if (pending_buffers_.empty())
+    return;
+
+  std::vector<scoped_refptr<DecoderBuffer>> buffers;
+  std::vector<DecodeCB> decode_cbs;
+  buffers.swap(pending_buffers_);
+  decode_cbs.swap(pending_decode_cbs_);
+
+  if (state_ != kNormal ||
+      !media_apis_wrapper_->FeedBatch(buffers, MediaAPIsWrapper::Video)) {
+    state_ = kError;
+    for (const auto& decode_cb : decode_cbs)
+      decode_cb.Run(DecodeStatus::DECODE_ERROR);
+    return;
+  }
+
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    scoped_refptr<media::VideoFrame> video_frame =
+      media::VideoFrame::CreateHoleFrame(config_.natural_size());
+    video_frame->set_timestamp(buffers[i]->timestamp());
+
+    output_cb_.Run(video_frame);
+    decode_cbs[i].Run(DecodeStatus::OK);
+  }
+}
+
+void TvVideoDecoder::AbortPendingBuffers(DecodeStatus status) {
+  pending_buffers_.clear();
+  std::vector<DecodeCB> decode_cbs;
+  decode_cbs.swap(pending_decode_cbs_);
+  for (const auto& decode_cb : decode_cbs)
+    decode_cb.Run(status);
+}
 
-  decode_cb_bound.Run(DecodeStatus::OK);
+int TvVideoDecoder::GetMaxDecodeRequests() const {
+  return kMaxFeedBatchSize;
 }
 
 void TvVideoDecoder::Reset(const base::Closure& closure) {
   DCHECK(task_runner_->BelongsToCurrentThread());
+  AbortPendingBuffers(DecodeStatus::ABORTED);
   state_ = kNormal;
   task_runner_->PostTask(FROM_HERE, closure);
 }
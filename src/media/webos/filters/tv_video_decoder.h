@@ -18,8 +18,10 @@
 #define MEDIA_WEBOS_FILTERS_TV_VIDEO_DECODER_H_
 
 #include <list>
+#include <vector>
 
 #include "base/callback.h"
+#include "base/memory/weak_ptr.h"
 #include "media/base/video_decoder.h"
 #include "media/base/video_decoder_config.h"
 #include "media/base/video_frame_pool.h"
@@ -53,6 +55,7 @@ class MEDIA_EXPORT TvVideoDecoder : public VideoDecoder {
   virtual void Decode(const scoped_refptr<DecoderBuffer>& buffer,
                       const DecodeCB& decode_cb) override;
   virtual void Reset(const base::Closure& closure) override;
+  int GetMaxDecodeRequests() const override;
 
  private:
   enum DecoderState {
@@ -65,6 +68,13 @@ class MEDIA_EXPORT TvVideoDecoder : public VideoDecoder {
   // Handles (re-)initializing the decoder with a (new) config.
   // Returns true if initialization was successful.
   bool ConfigureDecoder(bool low_delay);
+
+  // Feeds all buffers queued by Decode() to the ESPlayer in one batch and
+  // completes their decode callbacks.
+  void FeedPendingBuffers();
+  // Completes the decode callbacks of the queued buffers with |status|
+  // without feeding them.
+  void AbortPendingBuffers(DecodeStatus status);
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
   DecoderState state_;
@@ -78,6 +88,13 @@ class MEDIA_EXPORT TvVideoDecoder : public VideoDecoder {
   bool decode_nalus_;
   scoped_refptr<MediaAPIsWrapper> media_apis_wrapper_;
 
+  // Buffers received since the last feed, with their decode callbacks.
+  std::vector<scoped_refptr<DecoderBuffer>> pending_buffers_;
+  std::vector<DecodeCB> pending_decode_cbs_;
+  bool feed_scheduled_;
+
+  base::WeakPtrFactory<TvVideoDecoder> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(TvVideoDecoder);
 };
 
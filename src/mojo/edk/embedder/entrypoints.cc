@@ -172,6 +172,15 @@ MojoResult MojoEndWriteDataImpl(MojoHandle data_pipe_producer_handle,
   return g_core->EndWriteData(data_pipe_producer_handle, num_elements_written);
 }
 
+MojoResult MojoWriteDataSharedBufferImpl(MojoHandle data_pipe_producer_handle,
+                                         MojoHandle buffer_handle,
+                                         uint64_t offset,
+                                         uint32_t num_bytes,
+                                         MojoWriteDataFlags flags) {
+  return g_core->WriteDataSharedBuffer(data_pipe_producer_handle,
+                                       buffer_handle, offset, num_bytes, flags);
+}
+
 MojoResult MojoReadDataImpl(MojoHandle data_pipe_consumer_handle,
                             void* elements,
                             uint32_t* num_elements,
@@ -300,7 +309,8 @@ MojoSystemThunks MakeSystemThunks() {
                                     MojoWrapPlatformSharedBufferHandleImpl,
                                     MojoUnwrapPlatformSharedBufferHandleImpl,
                                     MojoNotifyBadMessageImpl,
-                                    MojoGetPropertyImpl};
+                                    MojoGetPropertyImpl,
+                                    MojoWriteDataSharedBufferImpl};
   return system_thunks;
 }
 
@@ -9,10 +9,13 @@
 #include <algorithm>
 #include <limits>
 #include <utility>
+#include <vector>
 
+#include "base/lazy_instance.h"
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
 #include "base/process/process_handle.h"
+#include "base/synchronization/lock.h"
 #include "mojo/edk/embedder/platform_handle.h"
 
 #if defined(OS_MACOSX) && !defined(OS_IOS)
@@ -34,6 +37,77 @@ static_assert(sizeof(Channel::Message::Header) == 8,
               "Header must be 8 bytes on ChromeOS and Android");
 #endif
 
+// Recycles the data buffers of small messages. Messages are created and
+// destroyed at a high rate, and usually on different threads (e.g. the sender
+// and the I/O thread), so the pool is shared by all threads.
+class MessageBufferPool {
+ public:
+  MessageBufferPool() {}
+
+  // Returns a buffer of at least |size| bytes. |*capacity| is set to the
+  // number of bytes which must be passed to Free() along with the buffer.
+  char* Allocate(size_t size, size_t* capacity) {
+    size_t size_class = GetSizeClass(size);
+    if (size_class == kNumSizeClasses) {
+      *capacity = size;
+      return static_cast<char*>(
+          base::AlignedAlloc(size, kChannelMessageAlignment));
+    }
+
+    *capacity = kSizeClassCapacities[size_class];
+    {
+      base::AutoLock lock(lock_);
+      std::vector<char*>& buffers = free_buffers_[size_class];
+      if (!buffers.empty()) {
+        char* buffer = buffers.back();
+        buffers.pop_back();
+        return buffer;
+      }
+    }
+    return static_cast<char*>(
+        base::AlignedAlloc(*capacity, kChannelMessageAlignment));
+  }
+
+  void Free(char* buffer, size_t capacity) {
+    size_t size_class = GetSizeClass(capacity);
+    if (size_class != kNumSizeClasses &&
+        kSizeClassCapacities[size_class] == capacity) {
+      base::AutoLock lock(lock_);
+      std::vector<char*>& buffers = free_buffers_[size_class];
+      if (buffers.size() < kMaxFreeBuffersPerSizeClass) {
+        buffers.push_back(buffer);
+        return;
+      }
+    }
+    base::AlignedFree(buffer);
+  }
+
+ private:
+  static const size_t kNumSizeClasses = 3;
+  static const size_t kSizeClassCapacities[kNumSizeClasses];
+  static const size_t kMaxFreeBuffersPerSizeClass = 16;
+
+  // Returns the smallest size class which fits |size| bytes, or
+  // |kNumSizeClasses| if |size| is too large to be pooled.
+  static size_t GetSizeClass(size_t size) {
+    for (size_t i = 0; i < kNumSizeClasses; ++i) {
+      if (size <= kSizeClassCapacities[i])
+        return i;
+    }
+    return kNumSizeClasses;
+  }
+
+  base::Lock lock_;
+  std::vector<char*> free_buffers_[kNumSizeClasses];
+
+  DISALLOW_COPY_AND_ASSIGN(MessageBufferPool);
+};
+
+const size_t MessageBufferPool::kSizeClassCapacities[] = {256, 1024, 4096};
+
+base::LazyInstance<MessageBufferPool>::Leaky g_message_buffer_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 const size_t kReadBufferSize = 4096;
@@ -72,8 +146,7 @@ Channel::Message::Message(size_t payload_size,
 #endif
 
   size_ = sizeof(Header) + extra_header_size + payload_size;
-  data_ = static_cast<char*>(base::AlignedAlloc(size_,
-                                                kChannelMessageAlignment));
+  data_ = g_message_buffer_pool.Get().Allocate(size_, &capacity_);
   // Only zero out the header and not the payload. Since the payload is going to
   // be memcpy'd, zeroing the payload is unnecessary work and a significant
   // performance issue when dealing with large messages. Any sanitizer errors
@@ -115,7 +188,7 @@ Channel::Message::Message(size_t payload_size,
 }
 
 Channel::Message::~Message() {
-  base::AlignedFree(data_);
+  g_message_buffer_pool.Get().Free(data_, capacity_);
 }
 
 // static
@@ -164,6 +164,8 @@ class Channel : public base::RefCountedThreadSafe<Channel> {
    private:
     size_t size_;
     size_t max_handles_;
+    // The size of the allocation at |data_|, which may be more than |size_|.
+    size_t capacity_;
     char* data_;
     Header* header_;
 
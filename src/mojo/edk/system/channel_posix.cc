@@ -33,6 +33,15 @@ namespace {
 
 const size_t kMaxBatchReadCapacity = 256 * 1024;
 
+// The size of the first read of a read event starts at this, and is adjusted
+// between it and kMaxBatchReadCapacity from the amount of data read.
+const size_t kMinReadSize = 4096;
+
+// At most this many queued messages, and this many bytes unless the first
+// message is larger, are written with a single writev() or sendmsg().
+const size_t kMaxBatchWriteMessages = 64;
+const size_t kMaxBatchWriteCapacity = 256 * 1024;
+
 // A view over a Channel::Message object. The write queue uses these since
 // large messages may need to be sent in chunks.
 class MessageView {
@@ -68,6 +77,7 @@ class MessageView {
     offset_ += num_bytes;
   }
 
+  bool has_handles() const { return handles_ && !handles_->empty(); }
   ScopedPlatformHandleVectorPtr TakeHandles() { return std::move(handles_); }
   Channel::MessagePtr TakeMessage() { return std::move(message_); }
 
@@ -267,7 +277,7 @@ class ChannelPosix : public Channel,
     CHECK_EQ(fd, handle_.get().handle);
 
     bool read_error = false;
-    size_t next_read_size = 0;
+    size_t next_read_size = read_size_;
     size_t buffer_capacity = 0;
     size_t total_bytes_read = 0;
     size_t bytes_read = 0;
@@ -302,6 +312,16 @@ class ChannelPosix : public Channel,
       read_watcher_.reset();
 
       OnError();
+      return;
+    }
+
+    // If the last read filled its buffer there is more data waiting, so the
+    // next event starts with a larger read. Shrink it again once the traffic
+    // doesn't need it, to not keep a large read buffer around.
+    if (bytes_read == buffer_capacity) {
+      read_size_ = std::min(read_size_ * 2, kMaxBatchReadCapacity);
+    } else if (total_bytes_read < read_size_ / 4) {
+      read_size_ = std::max(read_size_ / 2, kMinReadSize);
     }
   }
 
@@ -321,96 +341,101 @@ class ChannelPosix : public Channel,
   // cannot be written, it's queued and a wait is initiated to write the message
   // ASAP on the I/O thread.
   bool WriteNoLock(MessageView message_view) {
-    size_t bytes_written = 0;
-    do {
-      message_view.advance_data_offset(bytes_written);
+    DCHECK(outgoing_messages_.empty());
+    outgoing_messages_.push_back(std::move(message_view));
+    return FlushOutgoingMessagesNoLock();
+  }
+
+  // Writes the queued messages until they're all written or the channel is
+  // full, in which case a wait is initiated to write the rest ASAP on the I/O
+  // thread. Consecutive messages are written together with one writev(), or
+  // one sendmsg() if the first of them has handles to send.
+  bool FlushOutgoingMessagesNoLock() {
+    while (!outgoing_messages_.empty()) {
+      // Only the first message of the batch may have handles, they can't be
+      // split from the bytes they're sent with.
+      iovec iov[kMaxBatchWriteMessages];
+      size_t num_iov = 0;
+      size_t num_bytes = 0;
+      for (const MessageView& message_view : outgoing_messages_) {
+        if (num_iov > 0 &&
+            (num_iov == kMaxBatchWriteMessages || message_view.has_handles() ||
+             num_bytes + message_view.data_num_bytes() >
+                 kMaxBatchWriteCapacity)) {
+          break;
+        }
+        iov[num_iov].iov_base = const_cast<void*>(message_view.data());
+        iov[num_iov].iov_len = message_view.data_num_bytes();
+        num_bytes += message_view.data_num_bytes();
+        ++num_iov;
+      }
 
       ssize_t result;
-      ScopedPlatformHandleVectorPtr handles = message_view.TakeHandles();
+      ScopedPlatformHandleVectorPtr handles =
+          outgoing_messages_.front().TakeHandles();
       if (handles && handles->size()) {
-        iovec iov = {
-          const_cast<void*>(message_view.data()),
-          message_view.data_num_bytes()
-        };
         // TODO: Handle lots of handles.
         result = PlatformChannelSendmsgWithHandles(
-            handle_.get(), &iov, 1, handles->data(), handles->size());
-        if (result >= 0) {
-#if defined(OS_MACOSX)
-          // There is a bug on OSX which makes it dangerous to close
-          // a file descriptor while it is in transit. So instead we
-          // store the file descriptor in a set and send a message to
-          // the recipient, which is queued AFTER the message that
-          // sent the FD. The recipient will reply to the message,
-          // letting us know that it is now safe to close the file
-          // descriptor. For more information, see:
-          // http://crbug.com/298276
-          std::vector<int> fds;
-          for (auto& handle : *handles)
-            fds.push_back(handle.handle);
-          {
-            base::AutoLock l(handles_to_close_lock_);
-            for (auto& handle : *handles)
-              handles_to_close_->push_back(handle);
-          }
-          MessagePtr fds_message(
-              new Channel::Message(sizeof(fds[0]) * fds.size(), 0,
-                                   Message::Header::MessageType::HANDLES_SENT));
-          memcpy(fds_message->mutable_payload(), fds.data(),
-                 sizeof(fds[0]) * fds.size());
-          outgoing_messages_.emplace_back(std::move(fds_message), 0);
-          handles->clear();
-#else
-          handles.reset();
-#endif  // defined(OS_MACOSX)
-        }
+            handle_.get(), iov, num_iov, handles->data(), handles->size());
+        if (result >= 0)
+          OnHandlesSentNoLock(std::move(handles));
       } else {
-        result = PlatformChannelWrite(handle_.get(), message_view.data(),
-                                      message_view.data_num_bytes());
+        result = PlatformChannelWritev(handle_.get(), iov, num_iov);
       }
 
       if (result < 0) {
         if (errno != EAGAIN && errno != EWOULDBLOCK)
           return false;
-        message_view.SetHandles(std::move(handles));
-        outgoing_messages_.emplace_front(std::move(message_view));
+        outgoing_messages_.front().SetHandles(std::move(handles));
         WaitForWriteOnIOThreadNoLock();
         return true;
       }
 
-      bytes_written = static_cast<size_t>(result);
-    } while (bytes_written < message_view.data_num_bytes());
-
-    return FlushOutgoingMessagesNoLock();
-  }
-
-  bool FlushOutgoingMessagesNoLock() {
-    std::deque<MessageView> messages;
-    std::swap(outgoing_messages_, messages);
-
-    while (!messages.empty()) {
-      if (!WriteNoLock(std::move(messages.front())))
-        return false;
-
-      messages.pop_front();
-      if (!outgoing_messages_.empty()) {
-        // The message was requeued by WriteNoLock(), so we have to wait for
-        // pipe to become writable again. Repopulate the message queue and exit.
-        // If sending the message triggered any control messages, they may be
-        // in |outgoing_messages_| in addition to or instead of the message
-        // being sent.
-        std::swap(messages, outgoing_messages_);
-        while (!messages.empty()) {
-          outgoing_messages_.push_front(std::move(messages.back()));
-          messages.pop_back();
+      // Drop the messages which were fully written.
+      size_t bytes_written = static_cast<size_t>(result);
+      while (bytes_written > 0) {
+        MessageView& message_view = outgoing_messages_.front();
+        if (bytes_written < message_view.data_num_bytes()) {
+          message_view.advance_data_offset(bytes_written);
+          break;
         }
-        return true;
+        bytes_written -= message_view.data_num_bytes();
+        outgoing_messages_.pop_front();
       }
     }
 
     return true;
   }
 
+  // Called once |handles| have been sent.
+  void OnHandlesSentNoLock(ScopedPlatformHandleVectorPtr handles) {
+#if defined(OS_MACOSX)
+    // There is a bug on OSX which makes it dangerous to close
+    // a file descriptor while it is in transit. So instead we
+    // store the file descriptor in a set and send a message to
+    // the recipient, which is queued AFTER the message that
+    // sent the FD. The recipient will reply to the message,
+    // letting us know that it is now safe to close the file
+    // descriptor. For more information, see:
+    // http://crbug.com/298276
+    std::vector<int> fds;
+    for (auto& handle : *handles)
+      fds.push_back(handle.handle);
+    {
+      base::AutoLock l(handles_to_close_lock_);
+      for (auto& handle : *handles)
+        handles_to_close_->push_back(handle);
+    }
+    MessagePtr fds_message(
+        new Channel::Message(sizeof(fds[0]) * fds.size(), 0,
+                             Message::Header::MessageType::HANDLES_SENT));
+    memcpy(fds_message->mutable_payload(), fds.data(),
+           sizeof(fds[0]) * fds.size());
+    outgoing_messages_.emplace_back(std::move(fds_message), 0);
+    handles->clear();
+#endif  // defined(OS_MACOSX)
+  }
+
 #if defined(OS_MACOSX)
   bool OnControlMessage(Message::Header::MessageType message_type,
                         const void* payload,
@@ -490,6 +515,10 @@ class ChannelPosix : public Channel,
 
   std::deque<PlatformHandle> incoming_platform_handles_;
 
+  // The size of the first read of a read event. Only accessed on the IO
+  // thread.
+  size_t read_size_ = kMinReadSize;
+
   // Protects |pending_write_| and |outgoing_messages_|.
   base::Lock write_lock_;
   bool pending_write_ = false;
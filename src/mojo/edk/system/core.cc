@@ -888,6 +888,31 @@ MojoResult Core::EndWriteData(MojoHandle data_pipe_producer_handle,
   return dispatcher->EndWriteData(num_bytes_written);
 }
 
+MojoResult Core::WriteDataSharedBuffer(MojoHandle data_pipe_producer_handle,
+                                       MojoHandle buffer_handle,
+                                       uint64_t offset,
+                                       uint32_t num_bytes,
+                                       MojoWriteDataFlags flags) {
+  RequestContext request_context;
+  scoped_refptr<Dispatcher> producer(GetDispatcher(data_pipe_producer_handle));
+  scoped_refptr<Dispatcher> buffer(GetDispatcher(buffer_handle));
+  if (!producer || !buffer ||
+      producer->GetType() != Dispatcher::Type::DATA_PIPE_PRODUCER ||
+      buffer->GetType() != Dispatcher::Type::SHARED_BUFFER) {
+    return MOJO_RESULT_INVALID_ARGUMENT;
+  }
+
+  scoped_refptr<PlatformSharedBuffer> shared_buffer =
+      static_cast<SharedBufferDispatcher*>(buffer.get())
+          ->GetPlatformSharedBuffer();
+  if (!shared_buffer)
+    return MOJO_RESULT_INVALID_ARGUMENT;
+
+  // The whole range is always written, so |flags| makes no difference.
+  return static_cast<DataPipeProducerDispatcher*>(producer.get())
+      ->WriteDataSharedBuffer(shared_buffer, offset, num_bytes);
+}
+
 MojoResult Core::ReadData(MojoHandle data_pipe_consumer_handle,
                           void* elements,
                           uint32_t* num_bytes,
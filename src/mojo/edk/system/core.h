@@ -224,6 +224,11 @@ class MOJO_SYSTEM_IMPL_EXPORT Core {
                             MojoWriteDataFlags flags);
   MojoResult EndWriteData(MojoHandle data_pipe_producer_handle,
                           uint32_t num_bytes_written);
+  MojoResult WriteDataSharedBuffer(MojoHandle data_pipe_producer_handle,
+                                   MojoHandle buffer_handle,
+                                   uint64_t offset,
+                                   uint32_t num_bytes,
+                                   MojoWriteDataFlags flags);
   MojoResult ReadData(MojoHandle data_pipe_consumer_handle,
                       void* elements,
                       uint32_t* num_bytes,
@@ -38,12 +38,22 @@ struct SerializedState {
   uint64_t pipe_id;
   uint32_t read_offset;
   uint32_t bytes_available;
+  uint32_t num_segments;
   uint8_t flags;
-  char padding[7];
+  char padding[3];
+};
+
+// Follows SerializedState, once for each segment.
+struct SerializedSegment {
+  uint64_t offset;
+  uint32_t ring_bytes_before;
+  uint32_t num_bytes;
 };
 
 static_assert(sizeof(SerializedState) % 8 == 0,
               "Invalid SerializedState size.");
+static_assert(sizeof(SerializedSegment) % 8 == 0,
+              "Invalid SerializedSegment size.");
 
 #pragma pack(pop)
 
@@ -69,6 +79,15 @@ class DataPipeConsumerDispatcher::PortObserverThunk
   DISALLOW_COPY_AND_ASSIGN(PortObserverThunk);
 };
 
+DataPipeConsumerDispatcher::Segment::Segment() {}
+
+DataPipeConsumerDispatcher::Segment::Segment(Segment&& other) = default;
+
+DataPipeConsumerDispatcher::Segment::~Segment() {}
+
+DataPipeConsumerDispatcher::Segment&
+DataPipeConsumerDispatcher::Segment::operator=(Segment&& other) = default;
+
 DataPipeConsumerDispatcher::DataPipeConsumerDispatcher(
     NodeController* node_controller,
     const ports::PortRef& control_port,
@@ -137,7 +156,7 @@ MojoResult DataPipeConsumerDispatcher::ReadData(void* elements,
     DCHECK(!(flags & MOJO_READ_DATA_FLAG_DISCARD));  // Handled above.
     DVLOG_IF(2, elements)
         << "Query mode: ignoring non-null |elements|";
-    *num_bytes = static_cast<uint32_t>(bytes_available_);
+    *num_bytes = GetBytesAvailableNoLock();
     return MOJO_RESULT_OK;
   }
 
@@ -159,42 +178,36 @@ MojoResult DataPipeConsumerDispatcher::ReadData(void* elements,
   uint32_t min_num_bytes_to_read =
       all_or_none ? max_num_bytes_to_read : 0;
 
-  if (min_num_bytes_to_read > bytes_available_) {
+  uint32_t bytes_available = GetBytesAvailableNoLock();
+  if (min_num_bytes_to_read > bytes_available) {
     return peer_closed_ ? MOJO_RESULT_FAILED_PRECONDITION
                         : MOJO_RESULT_OUT_OF_RANGE;
   }
 
-  uint32_t bytes_to_read = std::min(max_num_bytes_to_read, bytes_available_);
+  uint32_t bytes_to_read = std::min(max_num_bytes_to_read, bytes_available);
   if (bytes_to_read == 0) {
     return peer_closed_ ? MOJO_RESULT_FAILED_PRECONDITION
                         : MOJO_RESULT_SHOULD_WAIT;
   }
 
   if (!discard) {
-    uint8_t* data = static_cast<uint8_t*>(ring_buffer_mapping_->GetBase());
-    CHECK(data);
-
     uint8_t* destination = static_cast<uint8_t*>(elements);
     CHECK(destination);
-
-    DCHECK_LE(read_offset_, options_.capacity_num_bytes);
-    uint32_t tail_bytes_to_copy =
-        std::min(options_.capacity_num_bytes - read_offset_, bytes_to_read);
-    uint32_t head_bytes_to_copy = bytes_to_read - tail_bytes_to_copy;
-    if (tail_bytes_to_copy > 0)
-      memcpy(destination, data + read_offset_, tail_bytes_to_copy);
-    if (head_bytes_to_copy > 0)
-      memcpy(destination + tail_bytes_to_copy, data, head_bytes_to_copy);
+    CopyDataNoLock(destination, bytes_to_read);
   }
   *num_bytes = bytes_to_read;
 
   bool peek = !!(flags & MOJO_READ_DATA_FLAG_PEEK);
   if (discard || !peek) {
-    read_offset_ = (read_offset_ + bytes_to_read) % options_.capacity_num_bytes;
-    bytes_available_ -= bytes_to_read;
+    uint32_t ring_bytes_read;
+    uint32_t segment_bytes_read;
+    ConsumeDataNoLock(bytes_to_read, &ring_bytes_read, &segment_bytes_read);
 
     base::AutoUnlock unlock(lock_);
-    NotifyRead(bytes_to_read);
+    if (ring_bytes_read > 0)
+      NotifyRead(ring_bytes_read);
+    if (segment_bytes_read > 0)
+      NotifySegmentRead(segment_bytes_read);
   }
 
   return MOJO_RESULT_OK;
@@ -216,21 +229,32 @@ MojoResult DataPipeConsumerDispatcher::BeginReadData(const void** buffer,
       (flags & MOJO_READ_DATA_FLAG_PEEK))
     return MOJO_RESULT_INVALID_ARGUMENT;
 
-  if (bytes_available_ == 0) {
+  if (GetBytesAvailableNoLock() == 0) {
     return peer_closed_ ? MOJO_RESULT_FAILED_PRECONDITION
                         : MOJO_RESULT_SHOULD_WAIT;
   }
 
-  DCHECK_LT(read_offset_, options_.capacity_num_bytes);
-  uint32_t bytes_to_read = std::min(bytes_available_,
-                                    options_.capacity_num_bytes - read_offset_);
+  // Two-phase reads only ever span the ring or a single segment, whichever
+  // comes next.
+  uint32_t ring_bytes = GetRingBytesBeforeSegmentNoLock(0);
+  uint32_t bytes_to_read;
+  if (ring_bytes > 0) {
+    DCHECK_LT(read_offset_, options_.capacity_num_bytes);
+    bytes_to_read = std::min(ring_bytes,
+                             options_.capacity_num_bytes - read_offset_);
 
-  CHECK(ring_buffer_mapping_);
-  uint8_t* data = static_cast<uint8_t*>(ring_buffer_mapping_->GetBase());
-  CHECK(data);
+    CHECK(ring_buffer_mapping_);
+    uint8_t* data = static_cast<uint8_t*>(ring_buffer_mapping_->GetBase());
+    CHECK(data);
+    *buffer = data + read_offset_;
+  } else {
+    const Segment& segment = segments_.front();
+    bytes_to_read = segment.num_bytes - segment.read_offset;
+    *buffer =
+        static_cast<uint8_t*>(segment.mapping->GetBase()) + segment.read_offset;
+  }
 
   in_two_phase_read_ = true;
-  *buffer = data + read_offset_;
   *buffer_num_bytes = bytes_to_read;
   two_phase_max_bytes_read_ = bytes_to_read;
 
@@ -254,14 +278,15 @@ MojoResult DataPipeConsumerDispatcher::EndReadData(uint32_t num_bytes_read) {
     rv = MOJO_RESULT_INVALID_ARGUMENT;
   } else {
     rv = MOJO_RESULT_OK;
-    read_offset_ =
-        (read_offset_ + num_bytes_read) % options_.capacity_num_bytes;
-
-    DCHECK_GE(bytes_available_, num_bytes_read);
-    bytes_available_ -= num_bytes_read;
+    uint32_t ring_bytes_read;
+    uint32_t segment_bytes_read;
+    ConsumeDataNoLock(num_bytes_read, &ring_bytes_read, &segment_bytes_read);
 
     base::AutoUnlock unlock(lock_);
-    NotifyRead(num_bytes_read);
+    if (ring_bytes_read > 0)
+      NotifyRead(ring_bytes_read);
+    if (segment_bytes_read > 0)
+      NotifySegmentRead(segment_bytes_read);
   }
 
   in_two_phase_read_ = false;
@@ -323,9 +348,10 @@ void DataPipeConsumerDispatcher::StartSerialize(uint32_t* num_bytes,
                                                 uint32_t* num_handles) {
   base::AutoLock lock(lock_);
   DCHECK(in_transit_);
-  *num_bytes = static_cast<uint32_t>(sizeof(SerializedState));
+  *num_bytes = static_cast<uint32_t>(
+      sizeof(SerializedState) + segments_.size() * sizeof(SerializedSegment));
   *num_ports = 1;
-  *num_handles = 1;
+  *num_handles = static_cast<uint32_t>(1 + segments_.size());
 }
 
 bool DataPipeConsumerDispatcher::EndSerialize(
@@ -341,6 +367,7 @@ bool DataPipeConsumerDispatcher::EndSerialize(
   state->pipe_id = pipe_id_;
   state->read_offset = read_offset_;
   state->bytes_available = bytes_available_;
+  state->num_segments = static_cast<uint32_t>(segments_.size());
   state->flags = peer_closed_ ? kFlagPeerClosed : 0;
 
   ports[0] = control_port_.name();
@@ -348,6 +375,22 @@ bool DataPipeConsumerDispatcher::EndSerialize(
   buffer_handle_for_transit_ = shared_ring_buffer_->DuplicatePlatformHandle();
   platform_handles[0] = buffer_handle_for_transit_.get();
 
+  SerializedSegment* serialized_segments =
+      reinterpret_cast<SerializedSegment*>(state + 1);
+  DCHECK(segment_handles_for_transit_.empty());
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    const Segment& segment = segments_[i];
+    serialized_segments[i].offset = segment.offset + segment.read_offset;
+    serialized_segments[i].ring_bytes_before = segment.ring_bytes_before;
+    serialized_segments[i].num_bytes = segment.num_bytes - segment.read_offset;
+
+    segment_handles_for_transit_.push_back(
+        segment.buffer->DuplicatePlatformHandle());
+    if (!segment_handles_for_transit_.back().is_valid())
+      return false;
+    platform_handles[i + 1] = segment_handles_for_transit_.back().get();
+  }
+
   return true;
 }
 
@@ -367,6 +410,9 @@ void DataPipeConsumerDispatcher::CompleteTransitAndClose() {
   in_transit_ = false;
   transferred_ = true;
   ignore_result(buffer_handle_for_transit_.release());
+  for (ScopedPlatformHandle& handle : segment_handles_for_transit_)
+    ignore_result(handle.release());
+  segment_handles_for_transit_.clear();
   CloseNoLock();
 }
 
@@ -375,6 +421,7 @@ void DataPipeConsumerDispatcher::CancelTransit() {
   DCHECK(in_transit_);
   in_transit_ = false;
   buffer_handle_for_transit_.reset();
+  segment_handles_for_transit_.clear();
   UpdateSignalsStateNoLock();
 }
 
@@ -386,12 +433,15 @@ DataPipeConsumerDispatcher::Deserialize(const void* data,
                                         size_t num_ports,
                                         PlatformHandle* handles,
                                         size_t num_handles) {
-  if (num_ports != 1 || num_handles != 1 ||
-      num_bytes != sizeof(SerializedState)) {
+  if (num_ports != 1 || num_bytes < sizeof(SerializedState))
     return nullptr;
-  }
 
   const SerializedState* state = static_cast<const SerializedState*>(data);
+  if (num_handles != 1 + static_cast<size_t>(state->num_segments) ||
+      num_bytes != sizeof(SerializedState) +
+                       state->num_segments * sizeof(SerializedSegment)) {
+    return nullptr;
+  }
 
   NodeController* node_controller = internal::g_core->GetNodeController();
   ports::PortRef port;
@@ -420,6 +470,49 @@ DataPipeConsumerDispatcher::Deserialize(const void* data,
     dispatcher->read_offset_ = state->read_offset;
     dispatcher->bytes_available_ = state->bytes_available;
     dispatcher->peer_closed_ = state->flags & kFlagPeerClosed;
+
+    const SerializedSegment* serialized_segments =
+        reinterpret_cast<const SerializedSegment*>(state + 1);
+    for (size_t i = 0; i < state->num_segments; ++i) {
+      const SerializedSegment& serialized = serialized_segments[i];
+      ScopedPlatformHandle segment_handle(handles[i + 1]);
+      handles[i + 1] = PlatformHandle();
+
+      Segment segment;
+      segment.ring_bytes_before = serialized.ring_bytes_before;
+      segment.offset = serialized.offset;
+      segment.num_bytes = serialized.num_bytes;
+      if (serialized.num_bytes == 0 ||
+          serialized.offset >
+              std::numeric_limits<size_t>::max() - serialized.num_bytes) {
+        continue;
+      }
+      segment.buffer = PlatformSharedBuffer::CreateFromPlatformHandle(
+          static_cast<size_t>(serialized.offset + serialized.num_bytes),
+          true /* read_only */, std::move(segment_handle));
+      if (segment.buffer) {
+        segment.mapping = segment.buffer->Map(
+            static_cast<size_t>(serialized.offset), serialized.num_bytes);
+      }
+      if (!segment.mapping) {
+        DLOG(ERROR) << "Failed to deserialize data pipe segment.";
+        continue;
+      }
+
+      dispatcher->ring_bytes_before_segments_ += segment.ring_bytes_before;
+      dispatcher->segment_bytes_available_ += segment.num_bytes;
+      dispatcher->segments_.push_back(std::move(segment));
+    }
+
+    if (dispatcher->segments_.size() != state->num_segments ||
+        dispatcher->ring_bytes_before_segments_ >
+            dispatcher->bytes_available_) {
+      dispatcher->segments_.clear();
+      dispatcher->ring_bytes_before_segments_ = 0;
+      dispatcher->segment_bytes_available_ = 0;
+      dispatcher->peer_closed_ = true;
+    }
+
     dispatcher->InitializeNoLock();
   }
 
@@ -457,6 +550,9 @@ MojoResult DataPipeConsumerDispatcher::CloseNoLock() {
   is_closed_ = true;
   ring_buffer_mapping_.reset();
   shared_ring_buffer_ = nullptr;
+  segments_.clear();
+  ring_bytes_before_segments_ = 0;
+  segment_bytes_available_ = 0;
 
   awakable_list_.CancelAll();
   if (!transferred_) {
@@ -472,7 +568,7 @@ DataPipeConsumerDispatcher::GetHandleSignalsStateNoLock() const {
   lock_.AssertAcquired();
 
   HandleSignalsState rv;
-  if (shared_ring_buffer_ && bytes_available_) {
+  if (shared_ring_buffer_ && GetBytesAvailableNoLock()) {
     if (!in_two_phase_read_)
       rv.satisfied_signals |= MOJO_HANDLE_SIGNAL_READABLE;
     rv.satisfiable_signals |= MOJO_HANDLE_SIGNAL_READABLE;
@@ -495,6 +591,171 @@ void DataPipeConsumerDispatcher::NotifyRead(uint32_t num_bytes) {
                              DataPipeCommand::DATA_WAS_READ, num_bytes);
 }
 
+void DataPipeConsumerDispatcher::NotifySegmentRead(uint32_t num_bytes) {
+  DVLOG(1) << "Data pipe consumer " << pipe_id_ << " notifying peer: "
+           << num_bytes << " bytes read from segments. [control_port="
+           << control_port_.name() << "]";
+
+  SendDataPipeControlMessage(node_controller_, control_port_,
+                             DataPipeCommand::DATA_SEGMENT_WAS_READ,
+                             num_bytes);
+}
+
+uint32_t DataPipeConsumerDispatcher::GetBytesAvailableNoLock() const {
+  lock_.AssertAcquired();
+  return static_cast<uint32_t>(std::min<uint64_t>(
+      bytes_available_ + segment_bytes_available_,
+      std::numeric_limits<uint32_t>::max() -
+          std::numeric_limits<uint32_t>::max() % options_.element_num_bytes));
+}
+
+uint32_t DataPipeConsumerDispatcher::GetRingBytesBeforeSegmentNoLock(
+    size_t index) const {
+  lock_.AssertAcquired();
+  if (index < segments_.size())
+    return segments_[index].ring_bytes_before;
+  DCHECK_EQ(index, segments_.size());
+  DCHECK_GE(bytes_available_, ring_bytes_before_segments_);
+  return bytes_available_ - ring_bytes_before_segments_;
+}
+
+void DataPipeConsumerDispatcher::CopyDataNoLock(uint8_t* destination,
+                                                uint32_t num_bytes) const {
+  lock_.AssertAcquired();
+
+  uint8_t* data = static_cast<uint8_t*>(ring_buffer_mapping_->GetBase());
+  CHECK(data);
+
+  uint32_t read_offset = read_offset_;
+  size_t segment_index = 0;
+  uint32_t ring_bytes = GetRingBytesBeforeSegmentNoLock(0);
+  while (num_bytes > 0) {
+    if (ring_bytes > 0) {
+      uint32_t bytes_to_copy = std::min(ring_bytes, num_bytes);
+
+      DCHECK_LE(read_offset, options_.capacity_num_bytes);
+      uint32_t tail_bytes_to_copy =
+          std::min(options_.capacity_num_bytes - read_offset, bytes_to_copy);
+      uint32_t head_bytes_to_copy = bytes_to_copy - tail_bytes_to_copy;
+      if (tail_bytes_to_copy > 0)
+        memcpy(destination, data + read_offset, tail_bytes_to_copy);
+      if (head_bytes_to_copy > 0)
+        memcpy(destination + tail_bytes_to_copy, data, head_bytes_to_copy);
+
+      read_offset = (read_offset + bytes_to_copy) % options_.capacity_num_bytes;
+      ring_bytes -= bytes_to_copy;
+      destination += bytes_to_copy;
+      num_bytes -= bytes_to_copy;
+      continue;
+    }
+
+    CHECK_LT(segment_index, segments_.size());
+    const Segment& segment = segments_[segment_index];
+    uint32_t bytes_to_copy =
+        std::min(segment.num_bytes - segment.read_offset, num_bytes);
+    memcpy(destination,
+           static_cast<uint8_t*>(segment.mapping->GetBase()) +
+               segment.read_offset,
+           bytes_to_copy);
+    destination += bytes_to_copy;
+    num_bytes -= bytes_to_copy;
+    ring_bytes = GetRingBytesBeforeSegmentNoLock(++segment_index);
+  }
+}
+
+void DataPipeConsumerDispatcher::ConsumeDataNoLock(
+    uint32_t num_bytes,
+    uint32_t* ring_bytes_read,
+    uint32_t* segment_bytes_read) {
+  lock_.AssertAcquired();
+
+  *ring_bytes_read = 0;
+  *segment_bytes_read = 0;
+  while (num_bytes > 0) {
+    uint32_t ring_bytes = GetRingBytesBeforeSegmentNoLock(0);
+    if (ring_bytes > 0) {
+      uint32_t bytes_to_read = std::min(ring_bytes, num_bytes);
+      read_offset_ =
+          (read_offset_ + bytes_to_read) % options_.capacity_num_bytes;
+      DCHECK_GE(bytes_available_, bytes_to_read);
+      bytes_available_ -= bytes_to_read;
+      if (!segments_.empty()) {
+        segments_.front().ring_bytes_before -= bytes_to_read;
+        ring_bytes_before_segments_ -= bytes_to_read;
+      }
+      *ring_bytes_read += bytes_to_read;
+      num_bytes -= bytes_to_read;
+      continue;
+    }
+
+    CHECK(!segments_.empty());
+    Segment& segment = segments_.front();
+    uint32_t bytes_to_read =
+        std::min(segment.num_bytes - segment.read_offset, num_bytes);
+    segment.read_offset += bytes_to_read;
+    segment_bytes_available_ -= bytes_to_read;
+    *segment_bytes_read += bytes_to_read;
+    num_bytes -= bytes_to_read;
+    if (segment.read_offset == segment.num_bytes)
+      segments_.pop_front();
+  }
+}
+
+bool DataPipeConsumerDispatcher::AddSegmentNoLock(PortsMessage* message) {
+  lock_.AssertAcquired();
+
+  if (!(options_.flags & MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_GROWABLE) ||
+      message->num_payload_bytes() < sizeof(DataPipeSegmentMessage) ||
+      message->num_handles() != 1) {
+    DLOG(ERROR) << "Invalid data pipe segment message.";
+    return false;
+  }
+
+  const DataPipeSegmentMessage* m =
+      static_cast<const DataPipeSegmentMessage*>(message->payload_bytes());
+  uint32_t num_bytes = m->header.num_bytes;
+  if (num_bytes == 0 || num_bytes % options_.element_num_bytes != 0 ||
+      segment_bytes_available_ + num_bytes >
+          kDataPipeMaxSegmentBytesPerCapacityByte *
+              options_.capacity_num_bytes ||
+      m->offset > std::numeric_limits<size_t>::max() - num_bytes) {
+    DLOG(ERROR) << "Producer claims to have written too many bytes.";
+    return false;
+  }
+
+  ScopedPlatformHandleVectorPtr handles = message->TakeHandles();
+  if (!handles || handles->size() != 1)
+    return false;
+
+  ScopedPlatformHandle buffer_handle(handles->at(0));
+  handles->clear();
+
+  Segment segment;
+  segment.ring_bytes_before = GetRingBytesBeforeSegmentNoLock(segments_.size());
+  segment.offset = m->offset;
+  segment.num_bytes = num_bytes;
+  segment.buffer = PlatformSharedBuffer::CreateFromPlatformHandle(
+      static_cast<size_t>(m->offset + num_bytes), true /* read_only */,
+      std::move(buffer_handle));
+  if (!segment.buffer)
+    return false;
+  segment.mapping =
+      segment.buffer->Map(static_cast<size_t>(m->offset), num_bytes);
+  if (!segment.mapping) {
+    DLOG(ERROR) << "Failed to map data pipe segment.";
+    return false;
+  }
+
+  DVLOG(1) << "Data pipe consumer " << pipe_id_ << " is aware that "
+           << num_bytes << " bytes were written to a segment. [control_port="
+           << control_port_.name() << "]";
+
+  ring_bytes_before_segments_ += segment.ring_bytes_before;
+  segment_bytes_available_ += num_bytes;
+  segments_.push_back(std::move(segment));
+  return true;
+}
+
 void DataPipeConsumerDispatcher::OnPortStatusChanged() {
   DCHECK(RequestContext::current());
 
@@ -516,6 +777,7 @@ void DataPipeConsumerDispatcher::UpdateSignalsStateNoLock() {
 
   bool was_peer_closed = peer_closed_;
   size_t previous_bytes_available = bytes_available_;
+  uint64_t previous_segment_bytes_available = segment_bytes_available_;
 
   ports::PortStatus port_status;
   int rv = node_controller_->node()->GetStatus(control_port_, &port_status);
@@ -540,6 +802,14 @@ void DataPipeConsumerDispatcher::UpdateSignalsStateNoLock() {
             static_cast<const DataPipeControlMessage*>(
                 message->payload_bytes());
 
+        if (m->command == DataPipeCommand::DATA_SEGMENT_WAS_WRITTEN) {
+          if (!AddSegmentNoLock(static_cast<PortsMessage*>(message.get()))) {
+            peer_closed_ = true;
+            break;
+          }
+          continue;
+        }
+
         if (m->command != DataPipeCommand::DATA_WAS_WRITTEN) {
           DLOG(ERROR) << "Unexpected control message from producer.";
           peer_closed_ = true;
@@ -563,7 +833,8 @@ void DataPipeConsumerDispatcher::UpdateSignalsStateNoLock() {
   }
 
   if (peer_closed_ != was_peer_closed ||
-      bytes_available_ != previous_bytes_available) {
+      bytes_available_ != previous_bytes_available ||
+      segment_bytes_available_ != previous_segment_bytes_available) {
     awakable_list_.AwakeForStateChange(GetHandleSignalsStateNoLock());
   }
 }
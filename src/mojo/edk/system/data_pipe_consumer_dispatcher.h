@@ -8,7 +8,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -26,6 +28,7 @@ namespace edk {
 
 struct DataPipeControlMessage;
 class NodeController;
+class PortsMessage;
 
 // This is the Dispatcher implementation for the consumer handle for data
 // pipes created by the Mojo primitive MojoCreateDataPipe(). This class is
@@ -84,12 +87,46 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeConsumerDispatcher final
   class PortObserverThunk;
   friend class PortObserverThunk;
 
+  // A shared buffer segment written by the producer of a growable pipe. The
+  // segment comes after |ring_bytes_before| more bytes of the ring.
+  struct Segment {
+    Segment();
+    Segment(Segment&& other);
+    ~Segment();
+
+    Segment& operator=(Segment&& other);
+
+    uint32_t ring_bytes_before = 0;
+    scoped_refptr<PlatformSharedBuffer> buffer;
+    std::unique_ptr<PlatformSharedBufferMapping> mapping;
+    // Offset of the mapping in |buffer|.
+    uint64_t offset = 0;
+    uint32_t num_bytes = 0;
+    uint32_t read_offset = 0;
+  };
+
   ~DataPipeConsumerDispatcher() override;
 
   void InitializeNoLock();
   MojoResult CloseNoLock();
   HandleSignalsState GetHandleSignalsStateNoLock() const;
   void NotifyRead(uint32_t num_bytes);
+  void NotifySegmentRead(uint32_t num_bytes);
+  // Returns the number of bytes which can be read, in the ring and in segments.
+  uint32_t GetBytesAvailableNoLock() const;
+  // Returns how many ring bytes come before segment |index|, or after the last
+  // segment if |index| is the number of segments.
+  uint32_t GetRingBytesBeforeSegmentNoLock(size_t index) const;
+  // Copies the next |num_bytes| bytes to |destination|, without consuming them.
+  void CopyDataNoLock(uint8_t* destination, uint32_t num_bytes) const;
+  // Consumes the next |num_bytes| bytes and returns how many of them were in
+  // the ring and how many in segments.
+  void ConsumeDataNoLock(uint32_t num_bytes,
+                         uint32_t* ring_bytes_read,
+                         uint32_t* segment_bytes_read);
+  // Queues the segment a DATA_SEGMENT_WAS_WRITTEN message carries. Returns
+  // false if the message is invalid.
+  bool AddSegmentNoLock(PortsMessage* message);
   void OnPortStatusChanged();
   void UpdateSignalsStateNoLock();
 
@@ -106,6 +143,7 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeConsumerDispatcher final
   scoped_refptr<PlatformSharedBuffer> shared_ring_buffer_;
   std::unique_ptr<PlatformSharedBufferMapping> ring_buffer_mapping_;
   ScopedPlatformHandle buffer_handle_for_transit_;
+  std::vector<ScopedPlatformHandle> segment_handles_for_transit_;
 
   bool in_two_phase_read_ = false;
   uint32_t two_phase_max_bytes_read_ = 0;
@@ -116,8 +154,16 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeConsumerDispatcher final
   bool transferred_ = false;
 
   uint32_t read_offset_ = 0;
+  // Bytes available in the ring.
   uint32_t bytes_available_ = 0;
 
+  // Segments which haven't been read in full, in stream order.
+  std::deque<Segment> segments_;
+  // The sum of the |ring_bytes_before| of |segments_|.
+  uint32_t ring_bytes_before_segments_ = 0;
+  // Bytes available in |segments_|.
+  uint64_t segment_bytes_available_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(DataPipeConsumerDispatcher);
 };
 
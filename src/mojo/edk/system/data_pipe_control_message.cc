@@ -31,5 +31,31 @@ void SendDataPipeControlMessage(NodeController* node_controller,
   }
 }
 
+void SendDataPipeSegmentMessage(NodeController* node_controller,
+                                const ports::PortRef& port,
+                                ScopedPlatformHandle buffer_handle,
+                                uint64_t offset,
+                                uint32_t num_bytes) {
+  std::unique_ptr<PortsMessage> message =
+      PortsMessage::NewUserMessage(sizeof(DataPipeSegmentMessage), 0, 1);
+  CHECK(message);
+
+  DataPipeSegmentMessage* data =
+      static_cast<DataPipeSegmentMessage*>(message->mutable_payload_bytes());
+  data->header.command = DataPipeCommand::DATA_SEGMENT_WAS_WRITTEN;
+  data->header.num_bytes = num_bytes;
+  data->offset = offset;
+
+  ScopedPlatformHandleVectorPtr handles(new PlatformHandleVector(1));
+  handles->at(0) = buffer_handle.release();
+  message->SetHandles(std::move(handles));
+
+  int rv = node_controller->SendMessage(port, std::move(message));
+  if (rv != ports::OK && rv != ports::ERROR_PORT_PEER_CLOSED) {
+    DLOG(ERROR) << "Unexpected failure sending data pipe segment message: "
+                << rv;
+  }
+}
+
 }  // namespace edk
 }  // namespace mojo
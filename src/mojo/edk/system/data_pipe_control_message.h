@@ -25,19 +25,45 @@ enum DataPipeCommand : uint32_t {
 
   // Signal to the producer that data has been consumed.
   DATA_WAS_READ,
+
+  // Signal to the consumer that new data is available in a shared buffer
+  // segment, whose handle the message carries. The data comes after whatever
+  // was written before it, whether in the ring or in other segments.
+  DATA_SEGMENT_WAS_WRITTEN,
+
+  // Signal to the producer that data has been consumed from segments.
+  DATA_SEGMENT_WAS_READ,
 };
 
+// A growable data pipe holds at most this many times its capacity in segments
+// the consumer hasn't read.
+const uint64_t kDataPipeMaxSegmentBytesPerCapacityByte = 16;
+
 // Message header for messages sent over a data pipe control port.
 struct MOJO_ALIGNAS(8) DataPipeControlMessage {
   DataPipeCommand command;
   uint32_t num_bytes;
 };
 
+// A DATA_SEGMENT_WAS_WRITTEN message. |header.num_bytes| is the size of the
+// segment.
+struct MOJO_ALIGNAS(8) DataPipeSegmentMessage {
+  DataPipeControlMessage header;
+  // Offset of the segment in its shared buffer.
+  uint64_t offset;
+};
+
 void SendDataPipeControlMessage(NodeController* node_controller,
                                 const ports::PortRef& port,
                                 DataPipeCommand command,
                                 uint32_t num_bytes);
 
+void SendDataPipeSegmentMessage(NodeController* node_controller,
+                                const ports::PortRef& port,
+                                ScopedPlatformHandle buffer_handle,
+                                uint64_t offset,
+                                uint32_t num_bytes);
+
 }  // namespace edk
 }  // namespace mojo
 
@@ -7,6 +7,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "base/bind.h"
@@ -37,6 +39,7 @@ struct SerializedState {
   uint64_t pipe_id;
   uint32_t write_offset;
   uint32_t available_capacity;
+  uint64_t segment_bytes_in_flight;
   uint8_t flags;
   char padding[7];
 };
@@ -87,6 +90,45 @@ DataPipeProducerDispatcher::DataPipeProducerDispatcher(
   }
 }
 
+MojoResult DataPipeProducerDispatcher::WriteDataSharedBuffer(
+    const scoped_refptr<PlatformSharedBuffer>& buffer,
+    uint64_t offset,
+    uint32_t num_bytes) {
+  base::AutoLock write_lock(write_lock_);
+  base::AutoLock lock(lock_);
+  if (!shared_ring_buffer_ || in_transit_ || !IsGrowable())
+    return MOJO_RESULT_INVALID_ARGUMENT;
+
+  if (in_two_phase_write_)
+    return MOJO_RESULT_BUSY;
+
+  if (peer_closed_)
+    return MOJO_RESULT_FAILED_PRECONDITION;
+
+  if (num_bytes == 0 || num_bytes % options_.element_num_bytes != 0 ||
+      offset > buffer->GetNumBytes() ||
+      num_bytes > buffer->GetNumBytes() - offset) {
+    return MOJO_RESULT_INVALID_ARGUMENT;
+  }
+
+  ScopedPlatformHandle buffer_handle = buffer->DuplicatePlatformHandle();
+  if (!buffer_handle.is_valid())
+    return MOJO_RESULT_RESOURCE_EXHAUSTED;
+
+  // The segment is written whatever the capacity left, but it counts towards
+  // the limit so that the pipe doesn't grow any further until it's read.
+  HandleSignalsState old_state = GetHandleSignalsStateNoLock();
+  segment_bytes_in_flight_ += num_bytes;
+  HandleSignalsState new_state = GetHandleSignalsStateNoLock();
+  if (!new_state.equals(old_state))
+    awakable_list_.AwakeForStateChange(new_state);
+
+  base::AutoUnlock unlock(lock_);
+  NotifySegmentWrite(std::move(buffer_handle), offset, num_bytes);
+
+  return MOJO_RESULT_OK;
+}
+
 Dispatcher::Type DataPipeProducerDispatcher::GetType() const {
   return Type::DATA_PIPE_PRODUCER;
 }
@@ -122,6 +164,7 @@ MojoResult DataPipeProducerDispatcher::CancelWatch(uintptr_t context) {
 MojoResult DataPipeProducerDispatcher::WriteData(const void* elements,
                                                  uint32_t* num_bytes,
                                                  MojoWriteDataFlags flags) {
+  base::AutoLock write_lock(write_lock_);
   base::AutoLock lock(lock_);
   if (!shared_ring_buffer_ || in_transit_)
     return MOJO_RESULT_INVALID_ARGUMENT;
@@ -139,7 +182,7 @@ MojoResult DataPipeProducerDispatcher::WriteData(const void* elements,
 
   bool all_or_none = flags & MOJO_WRITE_DATA_FLAG_ALL_OR_NONE;
   uint32_t min_num_bytes_to_write = all_or_none ? *num_bytes : 0;
-  if (min_num_bytes_to_write > options_.capacity_num_bytes) {
+  if (min_num_bytes_to_write > options_.capacity_num_bytes && !IsGrowable()) {
     // Don't return "should wait" since you can't wait for a specified amount of
     // data.
     return MOJO_RESULT_OUT_OF_RANGE;
@@ -147,42 +190,67 @@ MojoResult DataPipeProducerDispatcher::WriteData(const void* elements,
 
   DCHECK_LE(available_capacity_, options_.capacity_num_bytes);
   uint32_t num_bytes_to_write = std::min(*num_bytes, available_capacity_);
-  if (num_bytes_to_write == 0)
+
+  // Growable pipes write what doesn't fit in the ring to a new segment.
+  uint32_t segment_num_bytes = std::min(*num_bytes - num_bytes_to_write,
+                                        GetSegmentCapacityNoLock());
+  if (IsGrowable() &&
+      min_num_bytes_to_write > num_bytes_to_write + segment_num_bytes) {
+    return MOJO_RESULT_OUT_OF_RANGE;
+  }
+  if (num_bytes_to_write == 0 && segment_num_bytes == 0)
     return MOJO_RESULT_SHOULD_WAIT;
 
-  HandleSignalsState old_state = GetHandleSignalsStateNoLock();
+  const uint8_t* source = static_cast<const uint8_t*>(elements);
+  CHECK(source);
 
-  *num_bytes = num_bytes_to_write;
+  scoped_refptr<PlatformSharedBuffer> segment;
+  if (segment_num_bytes > 0) {
+    segment = CreateSegmentNoLock(source + num_bytes_to_write,
+                                  segment_num_bytes);
+    if (!segment) {
+      if (num_bytes_to_write == 0 || all_or_none)
+        return MOJO_RESULT_RESOURCE_EXHAUSTED;
+      segment_num_bytes = 0;
+    }
+  }
 
-  CHECK(ring_buffer_mapping_);
-  uint8_t* data = static_cast<uint8_t*>(ring_buffer_mapping_->GetBase());
-  CHECK(data);
+  HandleSignalsState old_state = GetHandleSignalsStateNoLock();
 
-  const uint8_t* source = static_cast<const uint8_t*>(elements);
-  CHECK(source);
+  *num_bytes = num_bytes_to_write + segment_num_bytes;
+
+  if (num_bytes_to_write > 0) {
+    CHECK(ring_buffer_mapping_);
+    uint8_t* data = static_cast<uint8_t*>(ring_buffer_mapping_->GetBase());
+    CHECK(data);
 
-  DCHECK_LE(write_offset_, options_.capacity_num_bytes);
-  uint32_t tail_bytes_to_write =
-      std::min(options_.capacity_num_bytes - write_offset_,
-               num_bytes_to_write);
-  uint32_t head_bytes_to_write = num_bytes_to_write - tail_bytes_to_write;
+    DCHECK_LE(write_offset_, options_.capacity_num_bytes);
+    uint32_t tail_bytes_to_write =
+        std::min(options_.capacity_num_bytes - write_offset_,
+                 num_bytes_to_write);
+    uint32_t head_bytes_to_write = num_bytes_to_write - tail_bytes_to_write;
 
-  DCHECK_GT(tail_bytes_to_write, 0u);
-  memcpy(data + write_offset_, source, tail_bytes_to_write);
-  if (head_bytes_to_write > 0)
-    memcpy(data, source + tail_bytes_to_write, head_bytes_to_write);
+    DCHECK_GT(tail_bytes_to_write, 0u);
+    memcpy(data + write_offset_, source, tail_bytes_to_write);
+    if (head_bytes_to_write > 0)
+      memcpy(data, source + tail_bytes_to_write, head_bytes_to_write);
 
-  DCHECK_LE(num_bytes_to_write, available_capacity_);
-  available_capacity_ -= num_bytes_to_write;
-  write_offset_ = (write_offset_ + num_bytes_to_write) %
-      options_.capacity_num_bytes;
+    DCHECK_LE(num_bytes_to_write, available_capacity_);
+    available_capacity_ -= num_bytes_to_write;
+    write_offset_ = (write_offset_ + num_bytes_to_write) %
+        options_.capacity_num_bytes;
+  }
+  segment_bytes_in_flight_ += segment_num_bytes;
 
   HandleSignalsState new_state = GetHandleSignalsStateNoLock();
   if (!new_state.equals(old_state))
     awakable_list_.AwakeForStateChange(new_state);
 
   base::AutoUnlock unlock(lock_);
-  NotifyWrite(num_bytes_to_write);
+  if (num_bytes_to_write > 0)
+    NotifyWrite(num_bytes_to_write);
+  if (segment_num_bytes > 0)
+    NotifySegmentWrite(segment->PassPlatformHandle(), 0, segment_num_bytes);
 
   return MOJO_RESULT_OK;
 }
@@ -200,8 +268,29 @@ MojoResult DataPipeProducerDispatcher::BeginWriteData(
     return MOJO_RESULT_FAILED_PRECONDITION;
 
   if (available_capacity_ == 0) {
-    return peer_closed_ ? MOJO_RESULT_FAILED_PRECONDITION
-                        : MOJO_RESULT_SHOULD_WAIT;
+    // Growable pipes carry on in a new segment when the ring is full.
+    uint32_t segment_num_bytes =
+        std::min(options_.capacity_num_bytes, GetSegmentCapacityNoLock());
+    if (segment_num_bytes == 0) {
+      return peer_closed_ ? MOJO_RESULT_FAILED_PRECONDITION
+                          : MOJO_RESULT_SHOULD_WAIT;
+    }
+
+    two_phase_segment_ = node_controller_->CreateSharedBuffer(
+        segment_num_bytes);
+    if (two_phase_segment_) {
+      two_phase_segment_mapping_ =
+          two_phase_segment_->Map(0, segment_num_bytes);
+    }
+    if (!two_phase_segment_mapping_) {
+      two_phase_segment_ = nullptr;
+      return MOJO_RESULT_RESOURCE_EXHAUSTED;
+    }
+
+    in_two_phase_write_ = true;
+    *buffer = two_phase_segment_mapping_->GetBase();
+    *buffer_num_bytes = segment_num_bytes;
+    return MOJO_RESULT_OK;
   }
 
   in_two_phase_write_ = true;
@@ -218,6 +307,7 @@ MojoResult DataPipeProducerDispatcher::BeginWriteData(
 
 MojoResult DataPipeProducerDispatcher::EndWriteData(
     uint32_t num_bytes_written) {
+  base::AutoLock write_lock(write_lock_);
   base::AutoLock lock(lock_);
   if (is_closed_ || in_transit_)
     return MOJO_RESULT_INVALID_ARGUMENT;
@@ -231,9 +321,24 @@ MojoResult DataPipeProducerDispatcher::EndWriteData(
   // Note: Allow successful completion of the two-phase write even if the other
   // side has been closed.
   MojoResult rv = MOJO_RESULT_OK;
-  if (num_bytes_written > available_capacity_ ||
-      num_bytes_written % options_.element_num_bytes != 0 ||
-      write_offset_ + num_bytes_written > options_.capacity_num_bytes) {
+  if (two_phase_segment_) {
+    scoped_refptr<PlatformSharedBuffer> segment = two_phase_segment_;
+    two_phase_segment_ = nullptr;
+    two_phase_segment_mapping_.reset();
+
+    if (num_bytes_written > segment->GetNumBytes() ||
+        num_bytes_written % options_.element_num_bytes != 0) {
+      rv = MOJO_RESULT_INVALID_ARGUMENT;
+    } else if (num_bytes_written > 0) {
+      segment_bytes_in_flight_ += num_bytes_written;
+
+      base::AutoUnlock unlock(lock_);
+      NotifySegmentWrite(segment->PassPlatformHandle(), 0, num_bytes_written);
+    }
+  } else if (num_bytes_written > available_capacity_ ||
+             num_bytes_written % options_.element_num_bytes != 0 ||
+             write_offset_ + num_bytes_written >
+                 options_.capacity_num_bytes) {
     rv = MOJO_RESULT_INVALID_ARGUMENT;
   } else {
     DCHECK_LE(num_bytes_written + write_offset_, options_.capacity_num_bytes);
@@ -323,6 +428,7 @@ bool DataPipeProducerDispatcher::EndSerialize(
   state->pipe_id = pipe_id_;
   state->write_offset = write_offset_;
   state->available_capacity = available_capacity_;
+  state->segment_bytes_in_flight = segment_bytes_in_flight_;
   state->flags = peer_closed_ ? kFlagPeerClosed : 0;
 
   ports[0] = control_port_.name();
@@ -401,6 +507,7 @@ DataPipeProducerDispatcher::Deserialize(const void* data,
     base::AutoLock lock(dispatcher->lock_);
     dispatcher->write_offset_ = state->write_offset;
     dispatcher->available_capacity_ = state->available_capacity;
+    dispatcher->segment_bytes_in_flight_ = state->segment_bytes_in_flight;
     dispatcher->peer_closed_ = state->flags & kFlagPeerClosed;
     dispatcher->InitializeNoLock();
   }
@@ -438,6 +545,8 @@ MojoResult DataPipeProducerDispatcher::CloseNoLock() {
   is_closed_ = true;
   ring_buffer_mapping_.reset();
   shared_ring_buffer_ = nullptr;
+  two_phase_segment_mapping_.reset();
+  two_phase_segment_ = nullptr;
 
   awakable_list_.CancelAll();
   if (!transferred_) {
@@ -454,7 +563,7 @@ HandleSignalsState DataPipeProducerDispatcher::GetHandleSignalsStateNoLock()
   HandleSignalsState rv;
   if (!peer_closed_) {
     if (!in_two_phase_write_ && shared_ring_buffer_ &&
-        available_capacity_ > 0)
+        (available_capacity_ > 0 || GetSegmentCapacityNoLock() > 0))
       rv.satisfied_signals |= MOJO_HANDLE_SIGNAL_WRITABLE;
     rv.satisfiable_signals |= MOJO_HANDLE_SIGNAL_WRITABLE;
   } else {
@@ -473,6 +582,55 @@ void DataPipeProducerDispatcher::NotifyWrite(uint32_t num_bytes) {
                              DataPipeCommand::DATA_WAS_WRITTEN, num_bytes);
 }
 
+void DataPipeProducerDispatcher::NotifySegmentWrite(
+    ScopedPlatformHandle buffer_handle,
+    uint64_t offset,
+    uint32_t num_bytes) {
+  DVLOG(1) << "Data pipe producer " << pipe_id_ << " notifying peer: "
+           << num_bytes << " bytes written to a segment. [control_port="
+           << control_port_.name() << "]";
+
+  SendDataPipeSegmentMessage(node_controller_, control_port_,
+                             std::move(buffer_handle), offset, num_bytes);
+}
+
+bool DataPipeProducerDispatcher::IsGrowable() const {
+  return !!(options_.flags & MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_GROWABLE);
+}
+
+uint32_t DataPipeProducerDispatcher::GetSegmentCapacityNoLock() const {
+  lock_.AssertAcquired();
+  if (!IsGrowable())
+    return 0;
+
+  const uint64_t max_segment_bytes =
+      kDataPipeMaxSegmentBytesPerCapacityByte * options_.capacity_num_bytes;
+  if (segment_bytes_in_flight_ >= max_segment_bytes)
+    return 0;
+
+  uint32_t capacity = static_cast<uint32_t>(
+      std::min<uint64_t>(max_segment_bytes - segment_bytes_in_flight_,
+                         std::numeric_limits<uint32_t>::max()));
+  return capacity - capacity % options_.element_num_bytes;
+}
+
+scoped_refptr<PlatformSharedBuffer>
+DataPipeProducerDispatcher::CreateSegmentNoLock(const void* data,
+                                                uint32_t num_bytes) {
+  lock_.AssertAcquired();
+  scoped_refptr<PlatformSharedBuffer> segment =
+      node_controller_->CreateSharedBuffer(num_bytes);
+  if (!segment)
+    return nullptr;
+
+  std::unique_ptr<PlatformSharedBufferMapping> mapping =
+      segment->Map(0, num_bytes);
+  if (!mapping)
+    return nullptr;
+  memcpy(mapping->GetBase(), data, num_bytes);
+  return segment;
+}
+
 void DataPipeProducerDispatcher::OnPortStatusChanged() {
   DCHECK(RequestContext::current());
 
@@ -494,6 +652,7 @@ void DataPipeProducerDispatcher::UpdateSignalsStateNoLock() {
 
   bool was_peer_closed = peer_closed_;
   size_t previous_capacity = available_capacity_;
+  uint64_t previous_segment_bytes_in_flight = segment_bytes_in_flight_;
 
   ports::PortStatus port_status;
   int rv = node_controller_->node()->GetStatus(control_port_, &port_status);
@@ -518,6 +677,20 @@ void DataPipeProducerDispatcher::UpdateSignalsStateNoLock() {
             static_cast<const DataPipeControlMessage*>(
                 message->payload_bytes());
 
+        if (m->command == DataPipeCommand::DATA_SEGMENT_WAS_READ) {
+          if (m->num_bytes > segment_bytes_in_flight_) {
+            DLOG(ERROR) << "Consumer claims to have read too many bytes.";
+            break;
+          }
+
+          DVLOG(1) << "Data pipe producer " << pipe_id_ << " is aware that "
+                   << m->num_bytes << " bytes were read from segments. "
+                   << "[control_port=" << control_port_.name() << "]";
+
+          segment_bytes_in_flight_ -= m->num_bytes;
+          continue;
+        }
+
         if (m->command != DataPipeCommand::DATA_WAS_READ) {
           DLOG(ERROR) << "Unexpected message from consumer.";
           peer_closed_ = true;
@@ -540,7 +713,8 @@ void DataPipeProducerDispatcher::UpdateSignalsStateNoLock() {
   }
 
   if (peer_closed_ != was_peer_closed ||
-      available_capacity_ != previous_capacity) {
+      available_capacity_ != previous_capacity ||
+      segment_bytes_in_flight_ != previous_segment_bytes_in_flight) {
     awakable_list_.AwakeForStateChange(GetHandleSignalsStateNoLock());
   }
 }
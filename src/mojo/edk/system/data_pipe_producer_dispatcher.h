@@ -40,6 +40,13 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeProducerDispatcher final
       bool initialized,
       uint64_t pipe_id);
 
+  // Writes |num_bytes| bytes of |buffer|, from |offset|, to the pipe as a
+  // segment the consumer reads in place. See MojoWriteDataSharedBuffer().
+  MojoResult WriteDataSharedBuffer(
+      const scoped_refptr<PlatformSharedBuffer>& buffer,
+      uint64_t offset,
+      uint32_t num_bytes);
+
   // Dispatcher:
   Type GetType() const override;
   MojoResult Close() override;
@@ -90,6 +97,17 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeProducerDispatcher final
   MojoResult CloseNoLock();
   HandleSignalsState GetHandleSignalsStateNoLock() const;
   void NotifyWrite(uint32_t num_bytes);
+  void NotifySegmentWrite(ScopedPlatformHandle buffer_handle,
+                          uint64_t offset,
+                          uint32_t num_bytes);
+  bool IsGrowable() const;
+  // Returns how many more bytes may be written to segments. Always zero if the
+  // pipe isn't growable.
+  uint32_t GetSegmentCapacityNoLock() const;
+  // Returns a new segment holding a copy of |num_bytes| bytes of |data|, or
+  // null on failure.
+  scoped_refptr<PlatformSharedBuffer> CreateSegmentNoLock(const void* data,
+                                                          uint32_t num_bytes);
   void OnPortStatusChanged();
   void UpdateSignalsStateNoLock();
   bool ProcessMessageNoLock(const DataPipeControlMessage& message,
@@ -100,6 +118,11 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeProducerDispatcher final
   const ports::PortRef control_port_;
   const uint64_t pipe_id_;
 
+  // Held during writes so that their control messages, which are sent
+  // without |lock_|, go out in the order the writes happen: the consumer
+  // relies on it to place segments in the stream. Acquired before |lock_|.
+  base::Lock write_lock_;
+
   // Guards access to the fields below.
   mutable base::Lock lock_;
 
@@ -120,6 +143,13 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeProducerDispatcher final
   uint32_t write_offset_ = 0;
   uint32_t available_capacity_;
 
+  // The segment a two-phase write writes to when the ring is full.
+  scoped_refptr<PlatformSharedBuffer> two_phase_segment_;
+  std::unique_ptr<PlatformSharedBufferMapping> two_phase_segment_mapping_;
+
+  // Bytes written to segments which the consumer hasn't read yet.
+  uint64_t segment_bytes_in_flight_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(DataPipeProducerDispatcher);
 };
 
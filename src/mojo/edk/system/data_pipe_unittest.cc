@@ -1040,6 +1040,138 @@ TEST_F(DataPipeTest, WrapAround) {
   ASSERT_EQ(0, memcmp(read_buffer, &test_data[10], 100u));
 }
 
+// Tests that a growable data pipe queues writes which don't fit in its ring in
+// segments, and that reads see all the data in order.
+TEST_F(DataPipeTest, GrowableWrite) {
+  unsigned char test_data[300];
+  for (size_t i = 0; i < arraysize(test_data); i++)
+    test_data[i] = static_cast<unsigned char>(i);
+
+  const MojoCreateDataPipeOptions options = {
+      kSizeOfOptions,                               // |struct_size|.
+      MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_GROWABLE,  // |flags|.
+      1u,                                           // |element_num_bytes|.
+      100u                                          // |capacity_num_bytes|.
+  };
+  ASSERT_EQ(MOJO_RESULT_OK, Create(&options));
+
+  // Write more than the capacity: everything goes in.
+  uint32_t num_bytes = 250u;
+  ASSERT_EQ(MOJO_RESULT_OK, WriteData(&test_data[0], &num_bytes, true));
+  ASSERT_EQ(250u, num_bytes);
+
+  // The ring is full, so a two-phase write gets a segment of its own.
+  void* write_buffer_ptr = nullptr;
+  num_bytes = 0u;
+  ASSERT_EQ(MOJO_RESULT_OK,
+            BeginWriteData(&write_buffer_ptr, &num_bytes, false));
+  ASSERT_TRUE(write_buffer_ptr);
+  ASSERT_EQ(100u, num_bytes);
+  memcpy(write_buffer_ptr, &test_data[250], 50u);
+  ASSERT_EQ(MOJO_RESULT_OK, EndWriteData(50u));
+
+  for (size_t i = 0; i < kMaxPoll; i++) {
+    num_bytes = 0u;
+    ASSERT_EQ(MOJO_RESULT_OK, QueryData(&num_bytes));
+    if (num_bytes >= 300u)
+      break;
+
+    test::Sleep(test::EpsilonDeadline());
+  }
+  ASSERT_EQ(300u, num_bytes);
+
+  // A two-phase read stops at the end of the ring data.
+  const void* read_buffer_ptr = nullptr;
+  num_bytes = 0u;
+  ASSERT_EQ(MOJO_RESULT_OK, BeginReadData(&read_buffer_ptr, &num_bytes, false));
+  ASSERT_EQ(100u, num_bytes);
+  ASSERT_EQ(0, memcmp(read_buffer_ptr, &test_data[0], 90u));
+  ASSERT_EQ(MOJO_RESULT_OK, EndReadData(90u));
+
+  // Peek across the ring and the first segment.
+  unsigned char read_buffer[300] = {0};
+  num_bytes = 20u;
+  ASSERT_EQ(MOJO_RESULT_OK, ReadData(read_buffer, &num_bytes, true, true));
+  ASSERT_EQ(20u, num_bytes);
+  ASSERT_EQ(0, memcmp(read_buffer, &test_data[90], 20u));
+
+  // Read everything, across both segments.
+  num_bytes = static_cast<uint32_t>(arraysize(read_buffer));
+  memset(read_buffer, 0, num_bytes);
+  ASSERT_EQ(MOJO_RESULT_OK, ReadData(read_buffer, &num_bytes));
+  ASSERT_EQ(210u, num_bytes);
+  ASSERT_EQ(0, memcmp(read_buffer, &test_data[90], 210u));
+
+  num_bytes = 0u;
+  ASSERT_EQ(MOJO_RESULT_OK, QueryData(&num_bytes));
+  ASSERT_EQ(0u, num_bytes);
+}
+
+// Tests writing part of a shared buffer to a growable data pipe.
+TEST_F(DataPipeTest, WriteDataSharedBuffer) {
+  const char kTestData[] = "hello world";
+  const uint32_t kTestDataSize = static_cast<uint32_t>(sizeof(kTestData));
+  const uint64_t kOffset = 5000u;
+
+  MojoCreateDataPipeOptions options = {
+      kSizeOfOptions,                           // |struct_size|.
+      MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_NONE,  // |flags|.
+      1u,                                       // |element_num_bytes|.
+      1000u                                     // |capacity_num_bytes|.
+  };
+  ASSERT_EQ(MOJO_RESULT_OK, Create(&options));
+
+  MojoHandle buffer = CreateBuffer(8192);
+  WriteToBuffer(buffer, kOffset, base::StringPiece(kTestData, kTestDataSize));
+
+  // Pipes which aren't growable can't take shared buffers.
+  EXPECT_EQ(MOJO_RESULT_INVALID_ARGUMENT,
+            MojoWriteDataSharedBuffer(producer_, buffer, kOffset,
+                                      kTestDataSize,
+                                      MOJO_WRITE_DATA_FLAG_NONE));
+  ASSERT_EQ(MOJO_RESULT_OK, CloseProducer());
+  ASSERT_EQ(MOJO_RESULT_OK, CloseConsumer());
+
+  options.flags = MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_GROWABLE;
+  ASSERT_EQ(MOJO_RESULT_OK, Create(&options));
+
+  EXPECT_EQ(MOJO_RESULT_INVALID_ARGUMENT,
+            MojoWriteDataSharedBuffer(producer_, buffer, 8190u, kTestDataSize,
+                                      MOJO_WRITE_DATA_FLAG_NONE));
+  EXPECT_EQ(MOJO_RESULT_INVALID_ARGUMENT,
+            MojoWriteDataSharedBuffer(producer_, buffer, kOffset, 0u,
+                                      MOJO_WRITE_DATA_FLAG_NONE));
+
+  uint32_t num_bytes = 4u;
+  ASSERT_EQ(MOJO_RESULT_OK, WriteData("abcd", &num_bytes, true));
+  ASSERT_EQ(MOJO_RESULT_OK,
+            MojoWriteDataSharedBuffer(producer_, buffer, kOffset,
+                                      kTestDataSize,
+                                      MOJO_WRITE_DATA_FLAG_NONE));
+  // The buffer may be closed right away.
+  ASSERT_EQ(MOJO_RESULT_OK, MojoClose(buffer));
+  ASSERT_EQ(MOJO_RESULT_OK, CloseProducer());
+  ASSERT_EQ(MOJO_RESULT_OK,
+            MojoWait(consumer_, MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+                     MOJO_DEADLINE_INDEFINITE, nullptr));
+
+  // The data comes in order, and a two-phase read sees the segment in place.
+  char read_buffer[4] = {0};
+  num_bytes = 4u;
+  ASSERT_EQ(MOJO_RESULT_OK, ReadData(read_buffer, &num_bytes, true));
+  ASSERT_EQ(0, memcmp(read_buffer, "abcd", 4u));
+
+  const void* read_buffer_ptr = nullptr;
+  num_bytes = 0u;
+  ASSERT_EQ(MOJO_RESULT_OK, BeginReadData(&read_buffer_ptr, &num_bytes, false));
+  ASSERT_EQ(kTestDataSize, num_bytes);
+  ASSERT_EQ(0, memcmp(read_buffer_ptr, kTestData, kTestDataSize));
+  ASSERT_EQ(MOJO_RESULT_OK, EndReadData(num_bytes));
+
+  num_bytes = 1u;
+  ASSERT_EQ(MOJO_RESULT_FAILED_PRECONDITION, ReadData(read_buffer, &num_bytes));
+}
+
 // Tests the behavior of writing (simple and two-phase), closing the producer,
 // then reading (simple and two-phase).
 TEST_F(DataPipeTest, WriteCloseProducerRead) {
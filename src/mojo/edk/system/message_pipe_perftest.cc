@@ -92,6 +92,77 @@ class MessagePipePerfTest : public test::MojoTestBase {
     SendQuitMessage(mp);
   }
 
+  // Writes |message_count_| messages without waiting for replies, then an
+  // empty message, and waits for the client's reply to it.
+  void MeasureStreaming(MojoHandle mp) {
+    std::string test_name =
+        base::StringPrintf("IPC_Streaming_Perf_%dx_%u", message_count_,
+                           static_cast<unsigned>(message_size_));
+    base::PerfTimeLogger logger(test_name.c_str());
+
+    for (int i = 0; i < message_count_; ++i) {
+      CHECK_EQ(MojoWriteMessage(mp, payload_.data(),
+                                static_cast<uint32_t>(payload_.size()),
+                                nullptr, 0, MOJO_WRITE_MESSAGE_FLAG_NONE),
+               MOJO_RESULT_OK);
+    }
+    SendQuitMessage(mp);
+
+    HandleSignalsState hss;
+    CHECK_EQ(MojoWait(mp, MOJO_HANDLE_SIGNAL_READABLE, MOJO_DEADLINE_INDEFINITE,
+                      &hss),
+             MOJO_RESULT_OK);
+    uint32_t read_buffer_size = static_cast<uint32_t>(read_buffer_.size());
+    CHECK_EQ(MojoReadMessage(mp, &read_buffer_[0], &read_buffer_size, nullptr,
+                             nullptr, MOJO_READ_MESSAGE_FLAG_NONE),
+             MOJO_RESULT_OK);
+    CHECK_EQ(read_buffer_size, 0u);
+
+    logger.Done();
+  }
+
+  void RunStreamingServer(MojoHandle mp) {
+    // Streams of small messages are where writes and reads are batched.
+    const size_t kMsgSize[3] = {12, 144, 1728};
+    const int kMessageCount[3] = {100000, 100000, 50000};
+
+    for (size_t i = 0; i < 3; i++) {
+      SetUpMeasurement(kMessageCount[i], kMsgSize[i]);
+      MeasureStreaming(mp);
+    }
+
+    CHECK_EQ(MojoWriteMessage(mp, "quit", 4, nullptr, 0,
+                              MOJO_WRITE_MESSAGE_FLAG_NONE),
+             MOJO_RESULT_OK);
+  }
+
+  // Reads messages and replies to each empty message with an empty message,
+  // until it receives "quit", which is shorter than the streamed messages.
+  static int RunStreamingClient(MojoHandle mp) {
+    std::string buffer(1000000, '\0');
+    while (true) {
+      HandleSignalsState hss;
+      MojoResult result =
+          MojoWait(mp, MOJO_HANDLE_SIGNAL_READABLE,
+                   MOJO_DEADLINE_INDEFINITE, &hss);
+      if (result != MOJO_RESULT_OK)
+        break;
+
+      uint32_t read_size = static_cast<uint32_t>(buffer.size());
+      CHECK_EQ(MojoReadMessage(mp, &buffer[0], &read_size, nullptr, 0,
+                               MOJO_READ_MESSAGE_FLAG_NONE),
+               MOJO_RESULT_OK);
+      if (read_size == 4 && buffer.compare(0, 4, "quit") == 0)
+        break;
+      if (read_size == 0) {
+        CHECK_EQ(MojoWriteMessage(mp, "", 0, nullptr, 0,
+                                  MOJO_WRITE_MESSAGE_FLAG_NONE),
+                 MOJO_RESULT_OK);
+      }
+    }
+    return 0;
+  }
+
   static int RunPingPongClient(MojoHandle mp) {
     std::string buffer(1000000, '\0');
     int rv = 0;
@@ -165,6 +236,18 @@ TEST_F(MessagePipePerfTest, MultiprocessPingPong) {
   END_CHILD()
 }
 
+DEFINE_TEST_CLIENT_WITH_PIPE(StreamingClient, MessagePipePerfTest, h) {
+  return RunStreamingClient(h);
+}
+
+// Measures the throughput of streams of messages from the parent to the child,
+// which doesn't reply to them.
+TEST_F(MessagePipePerfTest, MultiprocessStreaming) {
+  RUN_CHILD_ON_PIPE(StreamingClient, h)
+    RunStreamingServer(h);
+  END_CHILD()
+}
+
 }  // namespace
 }  // namespace edk
 }  // namespace mojo
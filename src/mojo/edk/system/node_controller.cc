@@ -4,8 +4,11 @@
 
 #include "mojo/edk/system/node_controller.h"
 
+#include <inttypes.h>
+
 #include <algorithm>
 #include <limits>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/location.h"
@@ -15,8 +18,14 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/process/process_handle.h"
 #include "base/rand_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
 #include "base/time/time.h"
 #include "base/timer/elapsed_timer.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "mojo/edk/embedder/embedder_internal.h"
 #include "mojo/edk/embedder/platform_channel_pair.h"
 #include "mojo/edk/system/broker.h"
@@ -134,13 +143,89 @@ class ThreadDestructionObserver :
 
 }  // namespace
 
-NodeController::~NodeController() {}
+// Dumps the number of ports and of queued messages in "mojo/ports", and in
+// detailed dumps, the message counts of each port with a backlog. The node may
+// go away while a dump is in progress, so the NodeController detaches it first.
+class NodeController::PortsDumpProvider
+    : public base::trace_event::MemoryDumpProvider {
+ public:
+  explicit PortsDumpProvider(ports::Node* node) : node_(node) {}
+  ~PortsDumpProvider() override {}
+
+  void Detach() {
+    base::AutoLock lock(lock_);
+    node_ = nullptr;
+  }
+
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override {
+    using base::trace_event::MemoryAllocatorDump;
+
+    std::vector<ports::PortMessageStats> stats;
+    {
+      base::AutoLock lock(lock_);
+      if (!node_)
+        return true;
+      node_->GetPortMessageStats(&stats);
+    }
+
+    size_t queued_message_count = 0;
+    for (const auto& port_stats : stats)
+      queued_message_count += port_stats.queued_message_count;
+
+    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump("mojo/ports");
+    dump->AddScalar("port_count", MemoryAllocatorDump::kUnitsObjects,
+                    stats.size());
+    dump->AddScalar("queued_message_count", MemoryAllocatorDump::kUnitsObjects,
+                    queued_message_count);
+
+    if (args.level_of_detail !=
+        base::trace_event::MemoryDumpLevelOfDetail::DETAILED) {
+      return true;
+    }
+
+    for (const auto& port_stats : stats) {
+      if (port_stats.queued_message_count == 0)
+        continue;
+
+      MemoryAllocatorDump* port_dump = pmd->CreateAllocatorDump(
+          base::StringPrintf("mojo/ports/0x%" PRIx64 "%016" PRIx64,
+                             port_stats.port_name.v1,
+                             port_stats.port_name.v2));
+      port_dump->AddScalar("queued_message_count",
+                           MemoryAllocatorDump::kUnitsObjects,
+                           port_stats.queued_message_count);
+      port_dump->AddScalar("messages_sent", MemoryAllocatorDump::kUnitsObjects,
+                           port_stats.num_messages_sent);
+      port_dump->AddScalar("messages_received",
+                           MemoryAllocatorDump::kUnitsObjects,
+                           port_stats.num_messages_received);
+    }
+    return true;
+  }
+
+ private:
+  base::Lock lock_;
+  ports::Node* node_;
+
+  DISALLOW_COPY_AND_ASSIGN(PortsDumpProvider);
+};
+
+NodeController::~NodeController() {
+  ports_dump_provider_->Detach();
+  base::trace_event::MemoryDumpManager::GetInstance()
+      ->UnregisterAndDeleteDumpProviderSoon(std::move(ports_dump_provider_));
+}
 
 NodeController::NodeController(Core* core)
     : core_(core),
       name_(GetRandomNodeName()),
-      node_(new ports::Node(name_, this)) {
+      node_(new ports::Node(name_, this)),
+      ports_dump_provider_(new PortsDumpProvider(node_.get())) {
   DVLOG(1) << "Initializing node " << name_;
+  base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      ports_dump_provider_.get(), "MojoPorts", nullptr);
 }
 
 #if defined(OS_MACOSX) && !defined(OS_IOS)
@@ -130,6 +130,8 @@ class NodeController : public ports::NodeDelegate,
  private:
   friend Core;
 
+  class PortsDumpProvider;
+
   using NodeMap = std::unordered_map<ports::NodeName,
                                      scoped_refptr<NodeChannel>>;
   using OutgoingMessageQueue = std::queue<Channel::MessagePtr>;
@@ -226,6 +228,9 @@ class NodeController : public ports::NodeDelegate,
   const std::unique_ptr<ports::Node> node_;
   scoped_refptr<base::TaskRunner> io_task_runner_;
 
+  // Reports the message counts of |node_|'s ports to memory-infra.
+  std::unique_ptr<PortsDumpProvider> ports_dump_provider_;
+
   // Guards |peers_| and |pending_peer_messages_|.
   base::Lock peers_lock_;
 
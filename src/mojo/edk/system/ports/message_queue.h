@@ -38,6 +38,10 @@ class MessageQueue {
 
   bool HasNextMessage() const;
 
+  // Returns the number of messages in the queue, whether or not the next one
+  // has arrived yet.
+  size_t queued_message_count() const { return heap_.size(); }
+
   // Gives ownership of the message. The selector may be null.
   void GetNextMessageIf(std::function<bool(const Message&)> selector,
                         ScopedMessage* message);
@@ -414,6 +414,22 @@ int Node::LostConnectionToNode(const NodeName& node_name) {
   return OK;
 }
 
+void Node::GetPortMessageStats(std::vector<PortMessageStats>* stats) {
+  base::AutoLock ports_lock(ports_lock_);
+  stats->reserve(stats->size() + ports_.size());
+  for (const auto& entry : ports_) {
+    Port* port = entry.second.get();
+    base::AutoLock lock(port->lock);
+
+    PortMessageStats port_stats;
+    port_stats.port_name = entry.first;
+    port_stats.queued_message_count = port->message_queue.queued_message_count();
+    port_stats.num_messages_sent = port->num_messages_sent;
+    port_stats.num_messages_received = port->num_messages_received;
+    stats->push_back(port_stats);
+  }
+}
+
 int Node::OnUserMessage(ScopedMessage message) {
   PortName port_name = GetEventHeader(*message)->port_name;
   const auto* event = GetEventData<UserEventData>(*message);
@@ -459,6 +475,7 @@ int Node::OnUserMessage(ScopedMessage message) {
     if (CanAcceptMoreMessages(port.get())) {
       message_accepted = true;
       port->message_queue.AcceptMessage(std::move(message), &has_next_message);
+      port->num_messages_received++;
 
       if (port->state == Port::kBuffering) {
         has_next_message = false;
@@ -829,6 +846,9 @@ int Node::SendMessageInternal(const PortRef& port_ref, ScopedMessage* message) {
 
   Port* port = port_ref.port();
   NodeName peer_node_name;
+  PortName local_peer_port_name;
+  scoped_refptr<Port> local_peer_port;
+  bool has_next_message = false;
   {
     // We must acquire |ports_lock_| before grabbing any port locks, because
     // WillSendMessage_Locked may need to lock multiple ports out of order.
@@ -850,7 +870,35 @@ int Node::SendMessageInternal(const PortRef& port_ref, ScopedMessage* message) {
     // do to recover. Assume that failure beyond this point must be treated as a
     // transport failure.
 
+    port->num_messages_sent++;
     peer_node_name = port->peer_node_name;
+
+    // A message which carries no ports to a receiving port on this node can be
+    // queued right away, while the locks are still held. This is what
+    // OnUserMessage() would do, without looking up and locking everything
+    // again. Anything else takes the slow path below.
+    if (peer_node_name == name_ && m->num_ports() == 0) {
+      scoped_refptr<Port> peer_port = GetPort_Locked(port->peer_port_name);
+      if (peer_port && peer_port.get() != port) {
+        base::AutoLock peer_lock(peer_port->lock);
+        if (peer_port->state == Port::kReceiving &&
+            CanAcceptMoreMessages(peer_port.get())) {
+          peer_port->message_queue.AcceptMessage(std::move(m),
+                                                 &has_next_message);
+          peer_port->num_messages_received++;
+          local_peer_port_name = port->peer_port_name;
+          local_peer_port = std::move(peer_port);
+        }
+      }
+    }
+  }
+
+  if (local_peer_port) {
+    if (has_next_message) {
+      delegate_->PortStatusChanged(
+          PortRef(local_peer_port_name, local_peer_port));
+    }
+    return OK;
   }
 
   if (peer_node_name != name_) {
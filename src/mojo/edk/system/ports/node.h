@@ -10,6 +10,7 @@
 
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -44,6 +45,13 @@ struct PortStatus {
   bool peer_closed;
 };
 
+struct PortMessageStats {
+  PortName port_name;
+  size_t queued_message_count;
+  uint64_t num_messages_sent;
+  uint64_t num_messages_received;
+};
+
 class NodeDelegate;
 
 class Node {
@@ -143,6 +151,9 @@ class Node {
   // indefinitely. This triggers cleanup of ports bound to this node.
   int LostConnectionToNode(const NodeName& node_name);
 
+  // Appends the message counts of every port on this node to |stats|.
+  void GetPortMessageStats(std::vector<PortMessageStats>* stats);
+
  private:
   class LockedPort;
 
@@ -15,7 +15,9 @@ Port::Port(uint64_t next_sequence_num_to_send,
       last_sequence_num_to_receive(0),
       message_queue(next_sequence_num_to_receive),
       remove_proxy_on_last_message(false),
-      peer_closed(false) {}
+      peer_closed(false),
+      num_messages_sent(0),
+      num_messages_received(0) {}
 
 Port::~Port() {}
 
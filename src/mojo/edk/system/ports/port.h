@@ -42,6 +42,11 @@ class Port : public base::RefCountedThreadSafe<Port> {
   bool remove_proxy_on_last_message;
   bool peer_closed;
 
+  // Counts of user messages sent from and accepted by this port, for
+  // debugging.
+  uint64_t num_messages_sent;
+  uint64_t num_messages_received;
+
   Port(uint64_t next_sequence_num_to_send,
        uint64_t next_sequence_num_to_receive);
 
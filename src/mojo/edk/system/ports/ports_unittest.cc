@@ -9,6 +9,7 @@
 #include <map>
 #include <queue>
 #include <sstream>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/rand_util.h"
@@ -712,6 +713,56 @@ TEST_F(PortsTest, GetMessage3) {
   EXPECT_TRUE(node0.CanShutdownCleanly(false));
 }
 
+TEST_F(PortsTest, PortMessageStats) {
+  NodeName node0_name(0, 1);
+  TestNodeDelegate node0_delegate(node0_name);
+  Node node0(node0_name, &node0_delegate);
+  node_map[0] = &node0;
+
+  node0_delegate.set_read_messages(false);
+
+  PortRef a0, a1;
+  EXPECT_EQ(OK, node0.CreatePortPair(&a0, &a1));
+
+  EXPECT_EQ(OK, SendStringMessage(&node0, a1, "1"));
+  EXPECT_EQ(OK, SendStringMessage(&node0, a1, "2"));
+
+  std::vector<PortMessageStats> stats;
+  node0.GetPortMessageStats(&stats);
+  ASSERT_EQ(2u, stats.size());
+  for (const auto& port_stats : stats) {
+    if (port_stats.port_name == a0.name()) {
+      EXPECT_EQ(2u, port_stats.queued_message_count);
+      EXPECT_EQ(0u, port_stats.num_messages_sent);
+      EXPECT_EQ(2u, port_stats.num_messages_received);
+    } else {
+      EXPECT_EQ(a1.name(), port_stats.port_name);
+      EXPECT_EQ(0u, port_stats.queued_message_count);
+      EXPECT_EQ(2u, port_stats.num_messages_sent);
+      EXPECT_EQ(0u, port_stats.num_messages_received);
+    }
+  }
+
+  // Messages delivered locally are read in order.
+  ScopedMessage message;
+  EXPECT_EQ(OK, node0.GetMessage(a0, &message));
+  ASSERT_TRUE(message);
+  EXPECT_EQ(0, strcmp("1", ToString(message)));
+
+  stats.clear();
+  node0.GetPortMessageStats(&stats);
+  ASSERT_EQ(2u, stats.size());
+  for (const auto& port_stats : stats) {
+    if (port_stats.port_name == a0.name())
+      EXPECT_EQ(1u, port_stats.queued_message_count);
+  }
+
+  EXPECT_EQ(OK, node0.ClosePort(a0));
+  EXPECT_EQ(OK, node0.ClosePort(a1));
+
+  EXPECT_TRUE(node0.CanShutdownCleanly(false));
+}
+
 TEST_F(PortsTest, Delegation1) {
   NodeName node0_name(0, 1);
   TestNodeDelegate node0_delegate(node0_name);
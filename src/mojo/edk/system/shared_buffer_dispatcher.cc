@@ -170,6 +170,14 @@ SharedBufferDispatcher::PassPlatformSharedBuffer() {
   return retval;
 }
 
+scoped_refptr<PlatformSharedBuffer>
+SharedBufferDispatcher::GetPlatformSharedBuffer() {
+  base::AutoLock lock(lock_);
+  if (in_transit_)
+    return nullptr;
+  return shared_buffer_;
+}
+
 Dispatcher::Type SharedBufferDispatcher::GetType() const {
   return Type::SHARED_BUFFER;
 }
@@ -67,6 +67,10 @@ class MOJO_SYSTEM_IMPL_EXPORT SharedBufferDispatcher final : public Dispatcher {
   // closed after calling this function.
   scoped_refptr<PlatformSharedBuffer> PassPlatformSharedBuffer();
 
+  // Returns the underlying platform shared buffer, which this dispatcher keeps
+  // a reference to, or null if it is closed or in transit.
+  scoped_refptr<PlatformSharedBuffer> GetPlatformSharedBuffer();
+
   // Dispatcher:
   Type GetType() const override;
   MojoResult Close() override;
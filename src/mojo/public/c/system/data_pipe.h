@@ -22,6 +22,10 @@
 //   |MojoCreateDataPipeOptionsFlags flags|: Used to specify different modes of
 //       operation.
 //     |MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_NONE|: No flags; default mode.
+//     |MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_GROWABLE|: The data pipe may queue
+//         more than its capacity: data which doesn't fit is handed to the
+//         consumer in separate shared buffer segments, up to a
+//         system-dependent limit. Also allows |MojoWriteDataSharedBuffer()|.
 //   |uint32_t element_num_bytes|: The size of an element, in bytes. All
 //       transactions and buffers will consist of an integral number of
 //       elements. Must be nonzero.
@@ -36,9 +40,13 @@ typedef uint32_t MojoCreateDataPipeOptionsFlags;
 #ifdef __cplusplus
 const MojoCreateDataPipeOptionsFlags MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_NONE =
     0;
+const MojoCreateDataPipeOptionsFlags
+    MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_GROWABLE = 1 << 0;
 #else
 #define MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_NONE \
   ((MojoCreateDataPipeOptionsFlags)0)
+#define MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_GROWABLE \
+  ((MojoCreateDataPipeOptionsFlags)1 << 0)
 #endif
 
 MOJO_STATIC_ASSERT(MOJO_ALIGNOF(int64_t) == 8, "int64_t has weird alignment");
@@ -246,6 +254,34 @@ MOJO_SYSTEM_EXPORT MojoResult
     MojoEndWriteData(MojoHandle data_pipe_producer_handle,
                      uint32_t num_bytes_written);
 
+// Writes |num_bytes| bytes of the shared buffer given by |buffer_handle|,
+// starting at |offset|, to the data pipe producer given by
+// |data_pipe_producer_handle|. The data isn't copied: the consumer reads it
+// straight from the shared buffer, so it must not be changed until it has been
+// read. The data pipe must have been created with
+// |MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_GROWABLE|. The data is written whatever
+// the space available in the data pipe, always in full, so |flags| has no
+// effect. |buffer_handle| remains valid (and may be closed right away).
+//
+// Returns:
+//   |MOJO_RESULT_OK| on success.
+//   |MOJO_RESULT_INVALID_ARGUMENT| if some argument was invalid (e.g.,
+//       |data_pipe_producer_handle| is not a handle to a growable data pipe
+//       producer, |buffer_handle| is not a shared buffer handle, or
+//       |num_bytes| is zero, not a multiple of the element size or more than
+//       the buffer holds past |offset|).
+//   |MOJO_RESULT_FAILED_PRECONDITION| if the data pipe consumer handle has been
+//       closed.
+//   |MOJO_RESULT_BUSY| if there is a two-phase write ongoing with
+//       |data_pipe_producer_handle| (i.e., |MojoBeginWriteData()| has been
+//       called, but not yet the matching |MojoEndWriteData()|).
+MOJO_SYSTEM_EXPORT MojoResult
+    MojoWriteDataSharedBuffer(MojoHandle data_pipe_producer_handle,
+                              MojoHandle buffer_handle,
+                              uint64_t offset,
+                              uint32_t num_bytes,
+                              MojoWriteDataFlags flags);
+
 // Reads data from the data pipe consumer given by |data_pipe_consumer_handle|.
 // May also be used to discard data or query the amount of data available.
 //
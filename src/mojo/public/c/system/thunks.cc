@@ -287,6 +287,17 @@ MojoResult MojoGetProperty(MojoPropertyType type, void* value) {
   return g_thunks.GetProperty(type, value);
 }
 
+MojoResult MojoWriteDataSharedBuffer(MojoHandle data_pipe_producer_handle,
+                                     MojoHandle buffer_handle,
+                                     uint64_t offset,
+                                     uint32_t num_bytes,
+                                     MojoWriteDataFlags flags) {
+  assert(g_thunks.WriteDataSharedBuffer);
+  return g_thunks.WriteDataSharedBuffer(data_pipe_producer_handle,
+                                        buffer_handle, offset, num_bytes,
+                                        flags);
+}
+
 }  // extern "C"
 
 size_t MojoEmbedderSetSystemThunks(const MojoSystemThunks* system_thunks) {
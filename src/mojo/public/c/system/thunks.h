@@ -157,6 +157,11 @@ struct MojoSystemThunks {
                                  const char* error,
                                  size_t error_num_bytes);
   MojoResult (*GetProperty)(MojoPropertyType type, void* value);
+  MojoResult (*WriteDataSharedBuffer)(MojoHandle data_pipe_producer_handle,
+                                      MojoHandle buffer_handle,
+                                      uint64_t offset,
+                                      uint32_t num_bytes,
+                                      MojoWriteDataFlags flags);
 };
 #pragma pack(pop)
 
@@ -17,6 +17,7 @@
 #include "base/compiler_specific.h"
 #include "base/logging.h"
 #include "mojo/public/c/system/data_pipe.h"
+#include "mojo/public/cpp/system/buffer.h"
 #include "mojo/public/cpp/system/handle.h"
 
 namespace mojo {
@@ -102,6 +103,18 @@ inline MojoResult EndWriteDataRaw(DataPipeProducerHandle data_pipe_producer,
   return MojoEndWriteData(data_pipe_producer.value(), num_bytes_written);
 }
 
+// Writes part of a shared buffer to a data pipe without copying it. See
+// |MojoWriteDataSharedBuffer()| for complete documentation.
+inline MojoResult WriteDataSharedBufferRaw(
+    DataPipeProducerHandle data_pipe_producer,
+    SharedBufferHandle buffer,
+    uint64_t offset,
+    uint32_t num_bytes,
+    MojoWriteDataFlags flags) {
+  return MojoWriteDataSharedBuffer(data_pipe_producer.value(), buffer.value(),
+                                   offset, num_bytes, flags);
+}
+
 // Reads from a data pipe. See |MojoReadData()| for complete documentation.
 inline MojoResult ReadDataRaw(DataPipeConsumerHandle data_pipe_consumer,
                               void* elements,
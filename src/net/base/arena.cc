@@ -46,6 +46,18 @@ void UnsafeArena::Reset() {
   blocks_.clear();
 }
 
+void UnsafeArena::ResetKeepingFirstBlock() {
+  if (blocks_.empty()) {
+    return;
+  }
+  if (blocks_.front().size != block_size_) {
+    blocks_.clear();
+    return;
+  }
+  blocks_.erase(blocks_.begin() + 1, blocks_.end());
+  blocks_.front().used = 0;
+}
+
 void UnsafeArena::Reserve(size_t additional_space) {
   if (blocks_.empty()) {
     AllocBlock(std::max(additional_space, block_size_));
@@ -37,6 +37,11 @@ class NET_EXPORT_PRIVATE UnsafeArena {
 
   void Reset();
 
+  // Like Reset(), but keeps the first block for reuse if it has the default
+  // size, so that an arena which is repeatedly filled and reset doesn't
+  // reallocate that block every time.
+  void ResetKeepingFirstBlock();
+
  private:
   struct Block {
     std::unique_ptr<char[]> data;
@@ -63,6 +63,25 @@ TEST(UnsafeArenaTest, UseAfterReset) {
   EXPECT_EQ(StringPiece(c, length), kTestString);
 }
 
+TEST(UnsafeArenaTest, ResetKeepingFirstBlock) {
+  UnsafeArena arena(40 /* block size */);
+  const size_t length = strlen(kTestString);
+  char* c1 = arena.Memdup(kTestString, length);
+  arena.Memdup(kTestString, length);
+  arena.ResetKeepingFirstBlock();
+  // The first block is reused from its start.
+  char* c2 = arena.Memdup(kTestString, length);
+  EXPECT_EQ(c1, c2);
+  EXPECT_EQ(StringPiece(c2, length), kTestString);
+
+  // An oversized first block isn't kept.
+  UnsafeArena small_arena(10 /* block size */);
+  small_arena.Memdup(kTestString, length);
+  small_arena.ResetKeepingFirstBlock();
+  char* c3 = small_arena.Memdup(kTestString, length);
+  EXPECT_EQ(StringPiece(c3, length), kTestString);
+}
+
 TEST(UnsafeArenaTest, Free) {
   UnsafeArena arena(kDefaultBlockSize);
   const size_t length = strlen(kTestString);
@@ -22,7 +22,8 @@ enum CacheType {
 enum BackendType {
   CACHE_BACKEND_DEFAULT,
   CACHE_BACKEND_BLOCKFILE,  // The |BackendImpl|.
-  CACHE_BACKEND_SIMPLE  // The |SimpleBackendImpl|.
+  CACHE_BACKEND_SIMPLE,  // The |SimpleBackendImpl|.
+  CACHE_BACKEND_TIERED  // The |SimpleBackendImpl| behind a memory tier.
 };
 
 }  // namespace disk_cache
@@ -50,6 +50,8 @@ SdchDictionary::SdchDictionary(const SdchDictionary& rhs)
       ports_(rhs.ports_) {
 }
 
+SdchDictionary::SdchDictionary(SdchDictionary&& rhs) = default;
+
 SdchDictionary::~SdchDictionary() {
 }
 
@@ -81,6 +81,10 @@ class NET_EXPORT_PRIVATE SdchDictionary {
   // CopyConstructible
   SdchDictionary(const SdchDictionary& rhs);
 
+  // Private move-constructor, so that the dictionary text can be handed to a
+  // RefCountedData<> without copying it.
+  SdchDictionary(SdchDictionary&& rhs);
+
   // The actual text of the dictionary.
   std::string text_;
 
@@ -418,8 +418,9 @@ SdchProblemCode SdchManager::AddSdchDictionary(
   SdchDictionary dictionary(dictionary_text, header_end + 2, client_hash,
                             server_hash, dictionary_url_normalized, domain,
                             path, expiration, ports);
+  // Dictionaries can be hundreds of kilobytes, so don't copy the text again.
   dictionaries_[server_hash] =
-      new base::RefCountedData<SdchDictionary>(dictionary);
+      new base::RefCountedData<SdchDictionary>(std::move(dictionary));
   if (server_hash_p)
     *server_hash_p = server_hash;
 
@@ -22,6 +22,7 @@ const unsigned kTTLSecs = 1800;  // 30 minutes.
 CachingCertVerifier::CachingCertVerifier(std::unique_ptr<CertVerifier> verifier)
     : verifier_(std::move(verifier)),
       cache_(kMaxCacheEntries),
+      persistence_delegate_(nullptr),
       requests_(0u),
       cache_hits_(0u) {
   CertDatabase::GetInstance()->AddObserver(this);
@@ -57,7 +58,9 @@ int CachingCertVerifier::Verify(const CertVerifier::RequestParams& params,
                                  caching_callback, out_req, net_log);
   if (result != ERR_IO_PENDING) {
     // Synchronous completion; add directly to cache.
-    AddResultToCache(params, start_time, *verify_result, result);
+    AddResultToCache(params, start_time,
+                     start_time + base::TimeDelta::FromSeconds(kTTLSecs),
+                     *verify_result, result);
   }
 
   return result;
@@ -71,6 +74,15 @@ bool CachingCertVerifier::AddEntry(const RequestParams& params,
                                    int error,
                                    const CertVerifyResult& verify_result,
                                    base::Time verification_time) {
+  return AddEntry(params, error, verify_result, verification_time,
+                  verification_time + base::TimeDelta::FromSeconds(kTTLSecs));
+}
+
+bool CachingCertVerifier::AddEntry(const RequestParams& params,
+                                   int error,
+                                   const CertVerifyResult& verify_result,
+                                   base::Time verification_time,
+                                   base::Time expiration_time) {
   // If the cache is full, don't bother.
   if (cache_.size() == cache_.max_entries())
     return false;
@@ -82,7 +94,8 @@ bool CachingCertVerifier::AddEntry(const RequestParams& params,
     return false;
 
   // Otherwise, go and add it.
-  AddResultToCache(params, verification_time, verify_result, error);
+  AddResultToCache(params, verification_time, expiration_time, verify_result,
+                   error);
   return true;
 }
 
@@ -138,7 +151,9 @@ void CachingCertVerifier::OnRequestFinished(const RequestParams& params,
                                             const CompletionCallback& callback,
                                             CertVerifyResult* verify_result,
                                             int error) {
-  AddResultToCache(params, start_time, *verify_result, error);
+  AddResultToCache(params, start_time,
+                   start_time + base::TimeDelta::FromSeconds(kTTLSecs),
+                   *verify_result, error);
 
   // Now chain to the user's callback, which may delete |this|.
   callback.Run(error);
@@ -147,6 +162,7 @@ void CachingCertVerifier::OnRequestFinished(const RequestParams& params,
 void CachingCertVerifier::AddResultToCache(
     const RequestParams& params,
     base::Time start_time,
+    base::Time expiration_time,
     const CertVerifyResult& verify_result,
     int error) {
   // When caching, this uses the time that validation started as the
@@ -175,10 +191,10 @@ void CachingCertVerifier::AddResultToCache(
   CachedResult cached_result;
   cached_result.error = error;
   cached_result.result = verify_result;
-  cache_.Put(
-      params, cached_result, CacheValidityPeriod(start_time),
-      CacheValidityPeriod(start_time,
-                          start_time + base::TimeDelta::FromSeconds(kTTLSecs)));
+  cache_.Put(params, cached_result, CacheValidityPeriod(start_time),
+             CacheValidityPeriod(start_time, expiration_time));
+  if (persistence_delegate_)
+    persistence_delegate_->ScheduleWrite();
 }
 
 void CachingCertVerifier::VisitEntries(CacheVisitor* visitor) const {
@@ -204,6 +220,8 @@ void CachingCertVerifier::OnCACertChanged(const X509Certificate* cert) {
 
 void CachingCertVerifier::ClearCache() {
   cache_.Clear();
+  if (persistence_delegate_)
+    persistence_delegate_->ScheduleWrite();
 }
 
 size_t CachingCertVerifier::GetCacheSize() const {
@@ -49,6 +49,17 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
                             base::Time expiration_time) = 0;
   };
 
+  // Notified of changes to the verification cache, so that its entries can be
+  // persisted.
+  class NET_EXPORT PersistenceDelegate {
+   public:
+    // Called when entries have been added to or removed from the cache.
+    virtual void ScheduleWrite() = 0;
+
+   protected:
+    virtual ~PersistenceDelegate() {}
+  };
+
   // Creates a CachingCertVerifier that will use |verifier| to perform the
   // actual verifications if they're not already cached or if the cached
   // item has expired.
@@ -77,6 +88,22 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
                 const CertVerifyResult& verify_result,
                 base::Time verification_time);
 
+  // Same as above, but the entry expires at |expiration_time| rather than
+  // after the usual cache lifetime. This is meant for results restored from
+  // disk, whose lifetime the persistence layer bounds by the validity of the
+  // verified chain.
+  bool AddEntry(const RequestParams& params,
+                int error,
+                const CertVerifyResult& verify_result,
+                base::Time verification_time,
+                base::Time expiration_time);
+
+  // Sets the delegate notified of changes to the cache. |delegate| must be
+  // unset, by passing nullptr, before it is destroyed.
+  void set_persistence_delegate(PersistenceDelegate* delegate) {
+    persistence_delegate_ = delegate;
+  }
+
   // Iterates through all of the non-expired entries in the cache, calling
   // VisitEntry on |visitor| for each, until either all entries are
   // iterated through or the |visitor| aborts.
@@ -88,6 +115,8 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, CacheHit);
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, Visitor);
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, AddsEntries);
+  FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest,
+                           AddsEntriesWithExpiration);
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, DifferentCACerts);
 
   // CachedResult contains the result of a certificate verification.
@@ -136,10 +165,11 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
                          int error);
 
   // Adds |verify_result| and |error| to the cache for |params|, whose
-  // verification attempt began at |start_time|. See the implementation
-  // for more details about the necessity of |start_time|.
+  // verification attempt began at |start_time|, until |expiration_time|. See
+  // the implementation for more details about the necessity of |start_time|.
   void AddResultToCache(const RequestParams& params,
                         base::Time start_time,
+                        base::Time expiration_time,
                         const CertVerifyResult& verify_result,
                         int error);
 
@@ -156,6 +186,8 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
 
   CertVerificationCache cache_;
 
+  PersistenceDelegate* persistence_delegate_;
+
   uint64_t requests_;
   uint64_t cache_hits_;
 
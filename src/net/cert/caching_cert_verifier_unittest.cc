@@ -43,6 +43,20 @@ class MockCacheVisitor : public CachingCertVerifier::CacheVisitor {
                     base::Time expiration_time));
 };
 
+class CountingPersistenceDelegate
+    : public CachingCertVerifier::PersistenceDelegate {
+ public:
+  CountingPersistenceDelegate() : num_writes_(0) {}
+  ~CountingPersistenceDelegate() override {}
+
+  void ScheduleWrite() override { ++num_writes_; }
+
+  int num_writes() const { return num_writes_; }
+
+ private:
+  int num_writes_;
+};
+
 }  // namespace
 
 class CachingCertVerifierTest : public ::testing::Test {
@@ -213,6 +227,51 @@ TEST_F(CachingCertVerifierTest, AddsEntries) {
   ASSERT_EQ(1u, verifier_.GetCacheSize());
 }
 
+// Tests that entries added with an expiration time outlive the usual cache
+// lifetime, and that the persistence delegate hears about changes.
+TEST_F(CachingCertVerifierTest, AddsEntriesWithExpiration) {
+  base::FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+
+  CountingPersistenceDelegate delegate;
+  verifier_.set_persistence_delegate(&delegate);
+
+  CertVerifyResult result;
+  result.verified_cert = test_cert;
+  CertVerifier::RequestParams params(test_cert, "www.example.com", 0,
+                                     std::string(), CertificateList());
+  CertVerifier::RequestParams other_params(test_cert, "www.example.org", 0,
+                                           std::string(), CertificateList());
+
+  base::Time now = base::Time::Now();
+  base::Time verification_time = now - base::TimeDelta::FromHours(2);
+  EXPECT_TRUE(verifier_.AddEntry(params, OK, result, verification_time,
+                                 now + base::TimeDelta::FromHours(1)));
+  EXPECT_TRUE(verifier_.AddEntry(other_params, OK, result, verification_time));
+  EXPECT_EQ(2, delegate.num_writes());
+
+  TestCompletionCallback callback;
+  std::unique_ptr<CertVerifier::Request> request;
+  CertVerifyResult cached_result;
+  EXPECT_EQ(OK, callback.GetResult(verifier_.Verify(
+                    params, nullptr, &cached_result, callback.callback(),
+                    &request, BoundNetLog())));
+  EXPECT_EQ(1u, verifier_.cache_hits());
+
+  // The entry added with the usual lifetime has already expired.
+  EXPECT_EQ(ERR_CERT_INVALID,
+            callback.GetResult(verifier_.Verify(
+                other_params, nullptr, &cached_result, callback.callback(),
+                &request, BoundNetLog())));
+  EXPECT_EQ(1u, verifier_.cache_hits());
+
+  verifier_.ClearCache();
+  EXPECT_EQ(4, delegate.num_writes());
+  verifier_.set_persistence_delegate(nullptr);
+}
+
 // Tests the same server certificate with different intermediate CA
 // certificates.  These should be treated as different certificate chains even
 // though the two X509Certificate objects contain the same server certificate.
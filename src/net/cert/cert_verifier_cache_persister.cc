@@ -0,0 +1,396 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/cert/cert_verifier_cache_persister.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "base/base64.h"
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/task_runner_util.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "net/base/hash_value.h"
+#include "net/base/net_errors.h"
+#include "net/cert/cert_verify_result.h"
+#include "net/cert/crl_set.h"
+#include "net/cert/x509_certificate.h"
+#include "net/ssl/ssl_config_service.h"
+
+namespace net {
+
+namespace {
+
+const char kFileName[] = "CertVerifierCache";
+
+// Version of the file format. Files of other versions are ignored.
+const int kVersion = 1;
+
+// How long after its verification a persisted result may be reused, however
+// long its chain stays valid, since revocations that aren't in the CRLSet go
+// unnoticed until the chain is verified again.
+const int kMaxPersistedAgeHours = 24;
+
+const char kVersionKey[] = "version";
+const char kCRLSetSequenceKey[] = "crl_set_sequence";
+const char kEntriesKey[] = "entries";
+
+const char kCertificateKey[] = "certificate";
+const char kHostnameKey[] = "hostname";
+const char kFlagsKey[] = "flags";
+const char kOCSPResponseKey[] = "ocsp_response";
+const char kAdditionalTrustAnchorsKey[] = "additional_trust_anchors";
+const char kVerifiedCertKey[] = "verified_cert";
+const char kCertStatusKey[] = "cert_status";
+const char kHasMD2Key[] = "has_md2";
+const char kHasMD4Key[] = "has_md4";
+const char kHasMD5Key[] = "has_md5";
+const char kHasSHA1Key[] = "has_sha1";
+const char kHasSHA1LeafKey[] = "has_sha1_leaf";
+const char kPublicKeyHashesKey[] = "public_key_hashes";
+const char kIsIssuedByKnownRootKey[] = "is_issued_by_known_root";
+const char kIsIssuedByAdditionalTrustAnchorKey[] =
+    "is_issued_by_additional_trust_anchor";
+const char kCommonNameFallbackUsedKey[] = "common_name_fallback_used";
+const char kVerificationTimeKey[] = "verification_time";
+const char kExpirationTimeKey[] = "expiration_time";
+
+std::string LoadState(const base::FilePath& path) {
+  std::string result;
+  if (!base::ReadFileToString(path, &result)) {
+    return "";
+  }
+  return result;
+}
+
+std::string GetCRLSetSequence() {
+  scoped_refptr<CRLSet> crl_set = SSLConfigService::GetCRLSet();
+  return base::UintToString(crl_set ? crl_set->sequence() : 0);
+}
+
+bool GetTime(const base::DictionaryValue& dict,
+             const char* key,
+             base::Time* time) {
+  std::string value;
+  int64_t internal_value;
+  if (!dict.GetString(key, &value) ||
+      !base::StringToInt64(value, &internal_value)) {
+    return false;
+  }
+  *time = base::Time::FromInternalValue(internal_value);
+  return true;
+}
+
+bool AppendCertificate(X509Certificate::OSCertHandle cert_handle,
+                       base::ListValue* list) {
+  std::string der;
+  if (!X509Certificate::GetDEREncoded(cert_handle, &der))
+    return false;
+  std::string encoded;
+  base::Base64Encode(der, &encoded);
+  list->AppendString(encoded);
+  return true;
+}
+
+// Returns the DER encodings of the certificates of |cert|'s chain, leaf
+// first, or nullptr on failure.
+std::unique_ptr<base::ListValue> SerializeChain(const X509Certificate& cert) {
+  std::unique_ptr<base::ListValue> chain(new base::ListValue);
+  if (!AppendCertificate(cert.os_cert_handle(), chain.get()))
+    return nullptr;
+  for (X509Certificate::OSCertHandle intermediate :
+       cert.GetIntermediateCertificates()) {
+    if (!AppendCertificate(intermediate, chain.get()))
+      return nullptr;
+  }
+  return chain;
+}
+
+// Decodes the certificates of |list| into |ders|.
+bool DecodeCertificates(const base::ListValue& list,
+                        std::vector<std::string>* ders) {
+  for (size_t i = 0; i < list.GetSize(); ++i) {
+    std::string encoded;
+    std::string der;
+    if (!list.GetString(i, &encoded) || !base::Base64Decode(encoded, &der))
+      return false;
+    ders->push_back(der);
+  }
+  return true;
+}
+
+// Inverse of SerializeChain().
+scoped_refptr<X509Certificate> DeserializeChain(const base::ListValue& list) {
+  std::vector<std::string> ders;
+  if (!DecodeCertificates(list, &ders) || ders.empty())
+    return nullptr;
+  std::vector<base::StringPiece> der_pieces(ders.begin(), ders.end());
+  return X509Certificate::CreateFromDERCertChain(der_pieces);
+}
+
+// Returns the earliest expiry of the certificates of |cert|'s chain.
+base::Time GetChainExpiry(const X509Certificate& cert) {
+  base::Time expiry = cert.valid_expiry();
+  for (X509Certificate::OSCertHandle intermediate :
+       cert.GetIntermediateCertificates()) {
+    scoped_refptr<X509Certificate> intermediate_cert =
+        X509Certificate::CreateFromHandle(intermediate,
+                                          X509Certificate::OSCertHandles());
+    expiry = std::min(expiry, intermediate_cert->valid_expiry());
+  }
+  return expiry;
+}
+
+// Appends the entries of the cache that are worth persisting to |entries|.
+class SerializingVisitor : public CachingCertVerifier::CacheVisitor {
+ public:
+  SerializingVisitor(base::Time now, base::ListValue* entries)
+      : now_(now), entries_(entries) {}
+  ~SerializingVisitor() override {}
+
+  // CachingCertVerifier::CacheVisitor:
+  bool VisitEntry(const CertVerifier::RequestParams& params,
+                  int error,
+                  const CertVerifyResult& verify_result,
+                  base::Time verification_time,
+                  base::Time expiration_time) override {
+    // Failures are left out, as they are often due to conditions, such as a
+    // bad clock, that don't outlive the session.
+    if (error != OK || !verify_result.verified_cert)
+      return true;
+
+    base::Time persisted_expiration_time = std::min(
+        verification_time + base::TimeDelta::FromHours(kMaxPersistedAgeHours),
+        GetChainExpiry(*verify_result.verified_cert));
+    if (persisted_expiration_time <= now_)
+      return true;
+
+    std::unique_ptr<base::ListValue> certificate =
+        SerializeChain(*params.certificate());
+    std::unique_ptr<base::ListValue> verified_cert =
+        SerializeChain(*verify_result.verified_cert);
+    if (!certificate || !verified_cert)
+      return true;
+    std::unique_ptr<base::ListValue> trust_anchors(new base::ListValue);
+    for (const auto& trust_anchor : params.additional_trust_anchors()) {
+      if (!AppendCertificate(trust_anchor->os_cert_handle(),
+                             trust_anchors.get())) {
+        return true;
+      }
+    }
+    std::unique_ptr<base::ListValue> hashes(new base::ListValue);
+    for (const HashValue& hash : verify_result.public_key_hashes)
+      hashes->AppendString(hash.ToString());
+    std::string ocsp_response;
+    base::Base64Encode(params.ocsp_response(), &ocsp_response);
+
+    std::unique_ptr<base::DictionaryValue> entry(new base::DictionaryValue);
+    entry->Set(kCertificateKey, std::move(certificate));
+    entry->SetString(kHostnameKey, params.hostname());
+    entry->SetInteger(kFlagsKey, params.flags());
+    entry->SetString(kOCSPResponseKey, ocsp_response);
+    entry->Set(kAdditionalTrustAnchorsKey, std::move(trust_anchors));
+    entry->Set(kVerifiedCertKey, std::move(verified_cert));
+    entry->SetInteger(kCertStatusKey,
+                      static_cast<int>(verify_result.cert_status));
+    entry->SetBoolean(kHasMD2Key, verify_result.has_md2);
+    entry->SetBoolean(kHasMD4Key, verify_result.has_md4);
+    entry->SetBoolean(kHasMD5Key, verify_result.has_md5);
+    entry->SetBoolean(kHasSHA1Key, verify_result.has_sha1);
+    entry->SetBoolean(kHasSHA1LeafKey, verify_result.has_sha1_leaf);
+    entry->Set(kPublicKeyHashesKey, std::move(hashes));
+    entry->SetBoolean(kIsIssuedByKnownRootKey,
+                      verify_result.is_issued_by_known_root);
+    entry->SetBoolean(kIsIssuedByAdditionalTrustAnchorKey,
+                      verify_result.is_issued_by_additional_trust_anchor);
+    entry->SetBoolean(kCommonNameFallbackUsedKey,
+                      verify_result.common_name_fallback_used);
+    entry->SetString(kVerificationTimeKey,
+                     base::Int64ToString(verification_time.ToInternalValue()));
+    entry->SetString(
+        kExpirationTimeKey,
+        base::Int64ToString(persisted_expiration_time.ToInternalValue()));
+    entries_->Append(std::move(entry));
+    return true;
+  }
+
+ private:
+  const base::Time now_;
+  base::ListValue* entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(SerializingVisitor);
+};
+
+// Adds the result described by |entry| to |verifier| if it is still valid at
+// |now|. Returns false if |entry| is malformed.
+bool RestoreEntry(const base::DictionaryValue& entry,
+                  base::Time now,
+                  CachingCertVerifier* verifier) {
+  const base::ListValue* certificate_list;
+  std::string hostname;
+  int flags;
+  std::string encoded_ocsp_response;
+  std::string ocsp_response;
+  const base::ListValue* trust_anchor_list;
+  const base::ListValue* verified_cert_list;
+  int cert_status;
+  const base::ListValue* hash_list;
+  base::Time verification_time;
+  base::Time expiration_time;
+  CertVerifyResult verify_result;
+  if (!entry.GetList(kCertificateKey, &certificate_list) ||
+      !entry.GetString(kHostnameKey, &hostname) ||
+      !entry.GetInteger(kFlagsKey, &flags) ||
+      !entry.GetString(kOCSPResponseKey, &encoded_ocsp_response) ||
+      !base::Base64Decode(encoded_ocsp_response, &ocsp_response) ||
+      !entry.GetList(kAdditionalTrustAnchorsKey, &trust_anchor_list) ||
+      !entry.GetList(kVerifiedCertKey, &verified_cert_list) ||
+      !entry.GetInteger(kCertStatusKey, &cert_status) ||
+      !entry.GetBoolean(kHasMD2Key, &verify_result.has_md2) ||
+      !entry.GetBoolean(kHasMD4Key, &verify_result.has_md4) ||
+      !entry.GetBoolean(kHasMD5Key, &verify_result.has_md5) ||
+      !entry.GetBoolean(kHasSHA1Key, &verify_result.has_sha1) ||
+      !entry.GetBoolean(kHasSHA1LeafKey, &verify_result.has_sha1_leaf) ||
+      !entry.GetList(kPublicKeyHashesKey, &hash_list) ||
+      !entry.GetBoolean(kIsIssuedByKnownRootKey,
+                        &verify_result.is_issued_by_known_root) ||
+      !entry.GetBoolean(kIsIssuedByAdditionalTrustAnchorKey,
+                        &verify_result.is_issued_by_additional_trust_anchor) ||
+      !entry.GetBoolean(kCommonNameFallbackUsedKey,
+                        &verify_result.common_name_fallback_used) ||
+      !GetTime(entry, kVerificationTimeKey, &verification_time) ||
+      !GetTime(entry, kExpirationTimeKey, &expiration_time)) {
+    return false;
+  }
+
+  // A clock that went backwards also invalidates the result, as in
+  // CachingCertVerifier.
+  if (now < verification_time || now >= expiration_time)
+    return true;
+
+  scoped_refptr<X509Certificate> certificate =
+      DeserializeChain(*certificate_list);
+  verify_result.verified_cert = DeserializeChain(*verified_cert_list);
+  if (!certificate || !verify_result.verified_cert)
+    return false;
+
+  std::vector<std::string> trust_anchor_ders;
+  if (!DecodeCertificates(*trust_anchor_list, &trust_anchor_ders))
+    return false;
+  CertificateList trust_anchors;
+  for (const std::string& der : trust_anchor_ders) {
+    scoped_refptr<X509Certificate> trust_anchor =
+        X509Certificate::CreateFromBytes(der.data(), der.size());
+    if (!trust_anchor)
+      return false;
+    trust_anchors.push_back(trust_anchor);
+  }
+
+  for (size_t i = 0; i < hash_list->GetSize(); ++i) {
+    std::string hash_string;
+    HashValue hash;
+    if (!hash_list->GetString(i, &hash_string) || !hash.FromString(hash_string))
+      return false;
+    verify_result.public_key_hashes.push_back(hash);
+  }
+  verify_result.cert_status = static_cast<CertStatus>(cert_status);
+
+  verifier->AddEntry(
+      CertVerifier::RequestParams(certificate, hostname, flags, ocsp_response,
+                                  trust_anchors),
+      OK, verify_result, verification_time, expiration_time);
+  return true;
+}
+
+}  // namespace
+
+CertVerifierCachePersister::CertVerifierCachePersister(
+    CachingCertVerifier* verifier,
+    const base::FilePath& profile_path,
+    const scoped_refptr<base::SequencedTaskRunner>& background_runner)
+    : verifier_(verifier),
+      writer_(profile_path.AppendASCII(kFileName), background_runner),
+      weak_ptr_factory_(this) {
+  DCHECK(verifier_);
+  verifier_->set_persistence_delegate(this);
+  base::PostTaskAndReplyWithResult(
+      background_runner.get(), FROM_HERE,
+      base::Bind(&LoadState, writer_.path()),
+      base::Bind(&CertVerifierCachePersister::CompleteLoad,
+                 weak_ptr_factory_.GetWeakPtr()));
+}
+
+CertVerifierCachePersister::~CertVerifierCachePersister() {
+  DCHECK(CalledOnValidThread());
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+  verifier_->set_persistence_delegate(nullptr);
+}
+
+void CertVerifierCachePersister::ScheduleWrite() {
+  DCHECK(CalledOnValidThread());
+  writer_.ScheduleWrite(this);
+}
+
+bool CertVerifierCachePersister::SerializeData(std::string* data) {
+  DCHECK(CalledOnValidThread());
+  std::unique_ptr<base::ListValue> entries(new base::ListValue);
+  SerializingVisitor visitor(base::Time::Now(), entries.get());
+  verifier_->VisitEntries(&visitor);
+
+  base::DictionaryValue state;
+  state.SetInteger(kVersionKey, kVersion);
+  state.SetString(kCRLSetSequenceKey, GetCRLSetSequence());
+  state.Set(kEntriesKey, std::move(entries));
+  return base::JSONWriter::Write(state, data);
+}
+
+void CertVerifierCachePersister::CompleteLoad(const std::string& serialized) {
+  DCHECK(CalledOnValidThread());
+  if (serialized.empty())
+    return;
+
+  std::unique_ptr<base::Value> value = base::JSONReader::Read(serialized);
+  base::DictionaryValue* state = nullptr;
+  int version;
+  std::string crl_set_sequence;
+  base::ListValue* entries = nullptr;
+  if (!value || !value->GetAsDictionary(&state) ||
+      !state->GetInteger(kVersionKey, &version) ||
+      !state->GetString(kCRLSetSequenceKey, &crl_set_sequence) ||
+      !state->GetList(kEntriesKey, &entries)) {
+    LOG(ERROR) << "Failed to deserialize the cert verifier cache";
+    return;
+  }
+
+  // Results verified against another CRLSet may miss its revocations.
+  if (version != kVersion || crl_set_sequence != GetCRLSetSequence())
+    return;
+
+  base::Time now = base::Time::Now();
+  bool malformed = false;
+  for (size_t i = 0; i < entries->GetSize(); ++i) {
+    const base::DictionaryValue* entry;
+    if (!entries->GetDictionary(i, &entry) ||
+        !RestoreEntry(*entry, now, verifier_)) {
+      malformed = true;
+    }
+  }
+  if (malformed)
+    LOG(ERROR) << "Failed to restore some cert verifier cache entries";
+}
+
+}  // namespace net
@@ -0,0 +1,69 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_CERT_CERT_VERIFIER_CACHE_PERSISTER_H_
+#define NET_CERT_CERT_VERIFIER_CACHE_PERSISTER_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/non_thread_safe.h"
+#include "net/base/net_export.h"
+#include "net/cert/caching_cert_verifier.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace net {
+
+// Stores the successful results of a CachingCertVerifier in a JSON file, so
+// that TLS connections made right after a restart can skip verifying chains
+// that were verified in the previous run.
+//
+// A persisted result is reused until the earliest expiry of its verified
+// chain, and for no more than a day after it was verified. The file records
+// the sequence of the CRLSet in use when it was written, and is discarded if
+// a different CRLSet is in use when it is loaded.
+//
+// Must be created, used and destroyed on the thread of the verifier.
+class NET_EXPORT CertVerifierCachePersister
+    : public CachingCertVerifier::PersistenceDelegate,
+      public base::ImportantFileWriter::DataSerializer,
+      NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  // The results are stored in a file named "CertVerifierCache" in
+  // |profile_path|, which is loaded on |background_runner|. |verifier| must
+  // outlive the persister.
+  CertVerifierCachePersister(
+      CachingCertVerifier* verifier,
+      const base::FilePath& profile_path,
+      const scoped_refptr<base::SequencedTaskRunner>& background_runner);
+  ~CertVerifierCachePersister() override;
+
+  // CachingCertVerifier::PersistenceDelegate:
+  void ScheduleWrite() override;
+
+  // ImportantFileWriter::DataSerializer:
+  bool SerializeData(std::string* data) override;
+
+ private:
+  void CompleteLoad(const std::string& serialized);
+
+  CachingCertVerifier* verifier_;
+
+  base::ImportantFileWriter writer_;
+
+  base::WeakPtrFactory<CertVerifierCachePersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(CertVerifierCachePersister);
+};
+
+}  // namespace net
+
+#endif  // NET_CERT_CERT_VERIFIER_CACHE_PERSISTER_H_
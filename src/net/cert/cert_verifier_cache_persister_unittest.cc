@@ -0,0 +1,182 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/cert/cert_verifier_cache_persister.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/ref_counted.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/strings/string_util.h"
+#include "base/time/time.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/cert/caching_cert_verifier.h"
+#include "net/cert/cert_verify_result.h"
+#include "net/cert/mock_cert_verifier.h"
+#include "net/cert/x509_certificate.h"
+#include "net/log/net_log.h"
+#include "net/test/cert_test_util.h"
+#include "net/test/test_data_directory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const char kHostname[] = "www.example.com";
+
+class CertVerifierCachePersisterTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    test_cert_ = ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem");
+    ASSERT_TRUE(test_cert_);
+  }
+
+ protected:
+  std::unique_ptr<CertVerifierCachePersister> CreatePersister(
+      CachingCertVerifier* verifier) {
+    return base::WrapUnique(new CertVerifierCachePersister(
+        verifier, temp_dir_.path(), message_loop_.task_runner()));
+  }
+
+  CertVerifier::RequestParams Params() const {
+    return CertVerifier::RequestParams(test_cert_, kHostname, 0, std::string(),
+                                       CertificateList());
+  }
+
+  // Verifies Params() with |verifier|, and returns the result in |result|.
+  int Verify(CachingCertVerifier* verifier, CertVerifyResult* result) {
+    TestCompletionCallback callback;
+    std::unique_ptr<CertVerifier::Request> request;
+    return callback.GetResult(verifier->Verify(Params(), nullptr, result,
+                                               callback.callback(), &request,
+                                               BoundNetLog()));
+  }
+
+  base::MessageLoopForIO message_loop_;
+  base::ScopedTempDir temp_dir_;
+  scoped_refptr<X509Certificate> test_cert_;
+};
+
+TEST_F(CertVerifierCachePersisterTest, PersistAcrossRestarts) {
+  CertVerifyResult verify_result;
+  verify_result.verified_cert = test_cert_;
+  verify_result.cert_status = CERT_STATUS_SHA1_SIGNATURE_PRESENT;
+  verify_result.has_sha1 = true;
+  verify_result.is_issued_by_known_root = true;
+
+  {
+    CachingCertVerifier verifier(base::MakeUnique<MockCertVerifier>());
+    std::unique_ptr<CertVerifierCachePersister> persister =
+        CreatePersister(&verifier);
+    base::RunLoop().RunUntilIdle();
+    EXPECT_TRUE(verifier.AddEntry(Params(), OK, verify_result,
+                                  base::Time::Now()));
+    // Destroying the persister writes the changes.
+    persister.reset();
+    base::RunLoop().RunUntilIdle();
+  }
+
+  // The mock would fail the verification if it ran.
+  CachingCertVerifier verifier(base::MakeUnique<MockCertVerifier>());
+  std::unique_ptr<CertVerifierCachePersister> persister =
+      CreatePersister(&verifier);
+  base::RunLoop().RunUntilIdle();
+
+  CertVerifyResult cached_result;
+  EXPECT_EQ(OK, Verify(&verifier, &cached_result));
+  EXPECT_EQ(CERT_STATUS_SHA1_SIGNATURE_PRESENT, cached_result.cert_status);
+  EXPECT_TRUE(cached_result.has_sha1);
+  EXPECT_TRUE(cached_result.is_issued_by_known_root);
+  ASSERT_TRUE(cached_result.verified_cert);
+  EXPECT_TRUE(cached_result.verified_cert->Equals(test_cert_.get()));
+}
+
+TEST_F(CertVerifierCachePersisterTest, DoesNotPersistErrors) {
+  CertVerifyResult verify_result;
+  verify_result.verified_cert = test_cert_;
+  verify_result.cert_status = CERT_STATUS_DATE_INVALID;
+
+  {
+    CachingCertVerifier verifier(base::MakeUnique<MockCertVerifier>());
+    std::unique_ptr<CertVerifierCachePersister> persister =
+        CreatePersister(&verifier);
+    base::RunLoop().RunUntilIdle();
+    EXPECT_TRUE(verifier.AddEntry(Params(), ERR_CERT_DATE_INVALID,
+                                  verify_result, base::Time::Now()));
+    persister.reset();
+    base::RunLoop().RunUntilIdle();
+  }
+
+  std::unique_ptr<MockCertVerifier> mock_verifier(new MockCertVerifier);
+  mock_verifier->set_default_result(OK);
+  CachingCertVerifier verifier(std::move(mock_verifier));
+  std::unique_ptr<CertVerifierCachePersister> persister =
+      CreatePersister(&verifier);
+  base::RunLoop().RunUntilIdle();
+
+  CertVerifyResult result;
+  EXPECT_EQ(OK, Verify(&verifier, &result));
+}
+
+TEST_F(CertVerifierCachePersisterTest, IgnoresOtherCRLSet) {
+  CertVerifyResult verify_result;
+  verify_result.verified_cert = test_cert_;
+
+  {
+    CachingCertVerifier verifier(base::MakeUnique<MockCertVerifier>());
+    std::unique_ptr<CertVerifierCachePersister> persister =
+        CreatePersister(&verifier);
+    base::RunLoop().RunUntilIdle();
+    EXPECT_TRUE(verifier.AddEntry(Params(), OK, verify_result,
+                                  base::Time::Now()));
+    persister.reset();
+    base::RunLoop().RunUntilIdle();
+  }
+
+  // Pretend that the file was written while another CRLSet was in use.
+  base::FilePath path = temp_dir_.path().AppendASCII("CertVerifierCache");
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  ASSERT_NE(std::string::npos, contents.find("\"crl_set_sequence\":\"0\""));
+  base::ReplaceFirstSubstringAfterOffset(&contents, 0,
+                                         "\"crl_set_sequence\":\"0\"",
+                                         "\"crl_set_sequence\":\"42\"");
+  ASSERT_EQ(static_cast<int>(contents.size()),
+            base::WriteFile(path, contents.data(), contents.size()));
+
+  CachingCertVerifier verifier(base::MakeUnique<MockCertVerifier>());
+  std::unique_ptr<CertVerifierCachePersister> persister =
+      CreatePersister(&verifier);
+  base::RunLoop().RunUntilIdle();
+
+  CertVerifyResult result;
+  EXPECT_EQ(ERR_CERT_INVALID, Verify(&verifier, &result));
+}
+
+TEST_F(CertVerifierCachePersisterTest, CorruptedFile) {
+  const char kCorrupted[] = "{\"version\": 1, \"entries\": [";
+  base::FilePath path = temp_dir_.path().AppendASCII("CertVerifierCache");
+  ASSERT_EQ(static_cast<int>(sizeof(kCorrupted) - 1),
+            base::WriteFile(path, kCorrupted, sizeof(kCorrupted) - 1));
+
+  CachingCertVerifier verifier(base::MakeUnique<MockCertVerifier>());
+  std::unique_ptr<CertVerifierCachePersister> persister =
+      CreatePersister(&verifier);
+  base::RunLoop().RunUntilIdle();
+
+  CertVerifyResult result;
+  EXPECT_EQ(ERR_CERT_INVALID, Verify(&verifier, &result));
+}
+
+}  // namespace
+
+}  // namespace net
@@ -334,6 +334,10 @@ size_t CountCookiesForPossibleDeletion(
 
 }  // namespace
 
+CookieMonster::SortedCookies::SortedCookies() {}
+
+CookieMonster::SortedCookies::~SortedCookies() {}
+
 CookieMonster::CookieMonster(PersistentCookieStore* store,
                              CookieMonsterDelegate* delegate)
     : CookieMonster(
@@ -1122,7 +1126,6 @@ CookieList CookieMonster::GetCookieListWithOptions(
 
   std::vector<CanonicalCookie*> cookie_ptrs;
   FindCookiesForHostAndDomain(url, options, &cookie_ptrs);
-  std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
 
   cookies.reserve(cookie_ptrs.size());
   for (std::vector<CanonicalCookie*>::const_iterator it = cookie_ptrs.begin();
@@ -1198,7 +1201,6 @@ std::string CookieMonster::GetCookiesWithOptions(const GURL& url,
 
   std::vector<CanonicalCookie*> cookies;
   FindCookiesForHostAndDomain(url, options, &cookies);
-  std::sort(cookies.begin(), cookies.end(), CookieSorter);
 
   std::string cookie_line = BuildCookieLine(cookies);
 
@@ -1583,31 +1585,75 @@ void CookieMonster::FindCookiesForKey(const std::string& key,
                                       std::vector<CanonicalCookie*>* cookies) {
   DCHECK(thread_checker_.CalledOnValidThread());
 
-  for (CookieMapItPair its = cookies_.equal_range(key);
-       its.first != its.second;) {
-    CookieMap::iterator curit = its.first;
-    CanonicalCookie* cc = curit->second;
-    ++its.first;
+  SortedCookies* sorted = GetSortedCookiesForKey(key);
+  if (!sorted)
+    return;
 
-    // If the cookie is expired, delete it.
+  // Access times need updating only once the least recently accessed cookie
+  // of the key is past the threshold.
+  bool update_access_time =
+      options.update_access_time() &&
+      (current - sorted->earliest_access_date) >= last_access_threshold_;
+  Time earliest_access_date;
+  bool found_expired = false;
+  for (CanonicalCookie* cc : sorted->cookies) {
+    // Expired cookies are deleted below, since deleting them here would
+    // invalidate |sorted|.
     if (cc->IsExpired(current)) {
-      InternalDeleteCookie(curit, true, DELETE_COOKIE_EXPIRED);
+      found_expired = true;
       continue;
     }
 
     // Filter out cookies that should not be included for a request to the
     // given |url|. HTTP only cookies are filtered depending on the passed
     // cookie |options|.
-    if (!cc->IncludeForRequestURL(url, options))
-      continue;
+    if (cc->IncludeForRequestURL(url, options)) {
+      if (update_access_time)
+        InternalUpdateCookieAccessTime(cc, current);
+      cookies->push_back(cc);
+    }
+
+    if (earliest_access_date.is_null() ||
+        cc->LastAccessDate() < earliest_access_date) {
+      earliest_access_date = cc->LastAccessDate();
+    }
+  }
+  sorted->earliest_access_date = earliest_access_date;
+
+  if (!found_expired)
+    return;
+  for (CookieMapItPair its = cookies_.equal_range(key);
+       its.first != its.second;) {
+    CookieMap::iterator curit = its.first;
+    ++its.first;
+    if (curit->second->IsExpired(current))
+      InternalDeleteCookie(curit, true, DELETE_COOKIE_EXPIRED);
+  }
+}
+
+CookieMonster::SortedCookies* CookieMonster::GetSortedCookiesForKey(
+    const std::string& key) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+
+  auto sorted_it = sorted_cookies_.find(key);
+  if (sorted_it != sorted_cookies_.end())
+    return &sorted_it->second;
+
+  CookieMapItPair its = cookies_.equal_range(key);
+  if (its.first == its.second)
+    return nullptr;
 
-    // Add this cookie to the set of matching cookies. Update the access
-    // time if we've been requested to do so.
-    if (options.update_access_time()) {
-      InternalUpdateCookieAccessTime(cc, current);
+  SortedCookies* sorted = &sorted_cookies_[key];
+  for (; its.first != its.second; ++its.first) {
+    CanonicalCookie* cc = its.first->second;
+    if (sorted->earliest_access_date.is_null() ||
+        cc->LastAccessDate() < sorted->earliest_access_date) {
+      sorted->earliest_access_date = cc->LastAccessDate();
     }
-    cookies->push_back(cc);
+    sorted->cookies.push_back(cc);
   }
+  std::sort(sorted->cookies.begin(), sorted->cookies.end(), CookieSorter);
+  return sorted;
 }
 
 bool CookieMonster::DeleteAnyEquivalentCookie(const std::string& key,
@@ -1690,6 +1736,7 @@ CookieMonster::CookieMap::iterator CookieMonster::InternalInsertCookie(
     store_->AddCookie(*cc);
   CookieMap::iterator inserted =
       cookies_.insert(CookieMap::value_type(key, cc));
+  sorted_cookies_.erase(key);
   if (delegate_.get()) {
     delegate_->OnCookieChanged(*cc, false,
                                CookieMonsterDelegate::CHANGE_COOKIE_EXPLICIT);
@@ -1868,6 +1915,7 @@ void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
       delegate_->OnCookieChanged(*cc, true, mapping.cause);
   }
   RunCookieChangedCallbacks(*cc, true);
+  sorted_cookies_.erase(it->first);
   cookies_.erase(it);
   delete cc;
 }
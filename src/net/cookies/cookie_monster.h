@@ -374,6 +374,16 @@ class NET_EXPORT CookieMonster : public CookieStore {
     kUnknownFetch,
   };
 
+  // The cookies of a key of |cookies_|, sorted the way they are sent in, and
+  // the least recent LastAccessDate() among them.
+  struct SortedCookies {
+    SortedCookies();
+    ~SortedCookies();
+
+    std::vector<CanonicalCookie*> cookies;
+    base::Time earliest_access_date;
+  };
+
   // The number of days since last access that cookies will not be subject
   // to global garbage collection.
   static const int kSafeFromGlobalPurgeDays;
@@ -480,12 +490,18 @@ class NET_EXPORT CookieMonster : public CookieStore {
                                    const CookieOptions& options,
                                    std::vector<CanonicalCookie*>* cookies);
 
+  // Appends the cookies of |key| to send to |url| to |cookies|, longest path
+  // first and then oldest first. Deletes the expired cookies of |key|.
   void FindCookiesForKey(const std::string& key,
                          const GURL& url,
                          const CookieOptions& options,
                          const base::Time& current,
                          std::vector<CanonicalCookie*>* cookies);
 
+  // Returns the sorted cookies of |key|, building them if needed, or NULL if
+  // |key| has no cookies.
+  SortedCookies* GetSortedCookiesForKey(const std::string& key);
+
   // Delete any cookies that are equivalent to |ecc| (same path, domain, etc).
   // If |skip_httponly| is true, httponly cookies will not be deleted.  The
   // return value will be true if |skip_httponly| skipped an httponly cookie or
@@ -642,6 +658,11 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   CookieMap cookies_;
 
+  // The cookies of each key of |cookies_| in the order they are sent in, so
+  // that reads don't sort them. The entry of a key is built on its first read
+  // and dropped whenever a cookie of the key is inserted or deleted.
+  std::map<std::string, SortedCookies> sorted_cookies_;
+
   // Indicates whether the cookie store has been initialized.
   bool initialized_;
 
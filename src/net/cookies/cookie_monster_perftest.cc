@@ -280,6 +280,60 @@ TEST_F(CookieMonsterTest, TestDomainLine) {
   timer2.Done();
 }
 
+// Queries a store of 3000 cookies spread over 100 sites, with cookies on a
+// couple of subdomains and paths of each, the way requests of API-heavy pages
+// do. Then does the same while some of the cookies keep being overwritten.
+TEST_F(CookieMonsterTest, TestQueryCookieHeavySites) {
+  const int kNumSites = 100;
+  const int kCookiesPerSite = 30;
+  std::unique_ptr<CookieMonster> cm(new CookieMonster(nullptr, nullptr));
+  SetCookieCallback setCookieCallback;
+  GetCookiesCallback getCookiesCallback;
+
+  std::vector<GURL> set_gurls;
+  std::vector<GURL> probe_gurls;
+  for (int site = 0; site < kNumSites; ++site) {
+    const std::string domain = base::StringPrintf("site%03d.com", site);
+    GURL api_gurl("https://api." + domain + "/");
+    GURL www_gurl("https://www." + domain + "/");
+    for (int i = 0; i < kCookiesPerSite; ++i) {
+      const std::string cookie =
+          base::StringPrintf("c%02d=value%d; domain=%s; path=/%s", i, i,
+                             domain.c_str(), (i % 3 == 0) ? "v1" : "");
+      setCookieCallback.SetCookie(cm.get(), (i % 2) ? api_gurl : www_gurl,
+                                  cookie);
+    }
+    set_gurls.push_back(www_gurl);
+    probe_gurls.push_back(GURL("https://api." + domain + "/v1/items"));
+    probe_gurls.push_back(www_gurl);
+  }
+  std::string cookie_line =
+      getCookiesCallback.GetCookies(cm.get(), probe_gurls[0]);
+  EXPECT_EQ(kCookiesPerSite, CountInString(cookie_line, '='));
+  cookie_line = getCookiesCallback.GetCookies(cm.get(), probe_gurls[1]);
+  EXPECT_EQ(kCookiesPerSite * 2 / 3, CountInString(cookie_line, '='));
+
+  base::PerfTimeLogger timer("Cookie_monster_query_cookie_heavy_sites");
+  for (int i = 0; i < kNumCookies; ++i) {
+    getCookiesCallback.GetCookies(cm.get(),
+                                  probe_gurls[i % probe_gurls.size()]);
+  }
+  timer.Done();
+
+  base::PerfTimeLogger timer2(
+      "Cookie_monster_query_cookie_heavy_sites_with_updates");
+  for (int i = 0; i < kNumCookies; ++i) {
+    if (i % 10 == 0) {
+      setCookieCallback.SetCookie(
+          cm.get(), set_gurls[(i / 10) % set_gurls.size()],
+          base::StringPrintf("c01=updated%d", i));
+    }
+    getCookiesCallback.GetCookies(cm.get(),
+                                  probe_gurls[i % probe_gurls.size()]);
+  }
+  timer2.Done();
+}
+
 TEST_F(CookieMonsterTest, TestImport) {
   scoped_refptr<MockPersistentCookieStore> store(new MockPersistentCookieStore);
   std::vector<CanonicalCookie*> initial_cookies;
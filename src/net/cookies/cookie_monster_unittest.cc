@@ -1586,6 +1586,28 @@ TEST_F(CookieMonsterTest, TestLastAccess) {
   EXPECT_FALSE(last_access_date == GetFirstCookieAccessDate(cm.get()));
 }
 
+// Tests that reading some cookies of a key doesn't keep the access dates of
+// its other cookies from being updated when they are read.
+TEST_F(CookieMonsterTest, TestLastAccessOfOtherCookiesOfKey) {
+  std::unique_ptr<CookieMonster> cm(
+      new CookieMonster(nullptr, nullptr, kLastAccessThreshold));
+  const GURL foo_url(http_www_google_.AppendPath("foo"));
+  const GURL bar_url(http_www_google_.AppendPath("bar"));
+
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_google_.url(), "A=B; path=/foo"));
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_google_.url(), "C=D; path=/bar"));
+  EXPECT_EQ("A=B", GetCookies(cm.get(), foo_url));
+
+  base::PlatformThread::Sleep(kAccessDelay);
+  EXPECT_EQ("A=B", GetCookies(cm.get(), foo_url));
+  EXPECT_EQ("C=D", GetCookies(cm.get(), bar_url));
+
+  CookieList cookies = GetAllCookies(cm.get());
+  ASSERT_EQ(2u, cookies.size());
+  for (const CanonicalCookie& cookie : cookies)
+    EXPECT_LT(cookie.CreationDate(), cookie.LastAccessDate());
+}
+
 TEST_F(CookieMonsterTest, TestHostGarbageCollection) {
   TestHostGarbageCollectHelper();
 }
@@ -1756,6 +1778,35 @@ TEST_F(CookieMonsterTest, CookieSorting) {
   EXPECT_EQ("A1", cookies[5].Value());
 }
 
+// Tests that the order of the cookies sent for a URL follows changes to the
+// cookies of its key made after they were read.
+TEST_F(CookieMonsterTest, CookieSortingAfterChanges) {
+  std::unique_ptr<CookieMonster> cm(new CookieMonster(nullptr, nullptr));
+  const GURL url(http_www_google_.AppendPath("foo/bar"));
+
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_google_.url(), "A=A1; path=/"));
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_google_.url(), "B=B1; path=/foo"));
+  EXPECT_EQ("B=B1; A=A1", GetCookies(cm.get(), url));
+
+  EXPECT_TRUE(
+      SetCookie(cm.get(), http_www_google_.url(), "C=C1; path=/foo/bar"));
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_google_.url(), "D=D1; path=/"));
+  EXPECT_EQ("C=C1; B=B1; A=A1; D=D1", GetCookies(cm.get(), url));
+
+  // Overwriting a cookie makes it the newest of its path length.
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_google_.url(), "A=A2; path=/"));
+  EXPECT_EQ("C=C1; B=B1; D=D1; A=A2", GetCookies(cm.get(), url));
+
+  DeleteCookie(cm.get(), url, "B");
+  EXPECT_EQ("C=C1; D=D1; A=A2", GetCookies(cm.get(), url));
+
+  // Domain cookies share the key of the host cookies.
+  EXPECT_TRUE(
+      SetCookie(cm.get(), http_www_google_.url(),
+                http_www_google_.Format("E=E1; domain=.%D; path=/foo")));
+  EXPECT_EQ("C=C1; E=E1; D=D1; A=A2", GetCookies(cm.get(), url));
+}
+
 TEST_F(CookieMonsterTest, DeleteCookieByName) {
   std::unique_ptr<CookieMonster> cm(new CookieMonster(nullptr, nullptr));
 
@@ -16,6 +16,7 @@
 #include "net/disk_cache/disk_cache.h"
 #include "net/disk_cache/memory/mem_backend_impl.h"
 #include "net/disk_cache/simple/simple_backend_impl.h"
+#include "net/disk_cache/tiered/tiered_backend_impl.h"
 
 namespace {
 
@@ -99,6 +100,7 @@ int CacheCreator::Run() {
   static const bool kSimpleBackendIsDefault = false;
 #endif
   if (backend_type_ == net::CACHE_BACKEND_SIMPLE ||
+      backend_type_ == net::CACHE_BACKEND_TIERED ||
       (backend_type_ == net::CACHE_BACKEND_DEFAULT &&
        kSimpleBackendIsDefault)) {
     disk_cache::SimpleBackendImpl* simple_cache =
@@ -129,6 +131,10 @@ int CacheCreator::Run() {
 void CacheCreator::DoCallback(int result) {
   DCHECK_NE(net::ERR_IO_PENDING, result);
   if (result == net::OK) {
+    if (backend_type_ == net::CACHE_BACKEND_TIERED) {
+      created_cache_ = disk_cache::TieredBackendImpl::Create(
+          std::move(created_cache_), 0, net_log_);
+    }
     *backend_ = std::move(created_cache_);
   } else {
     LOG(ERROR) << "Unable to create cache";
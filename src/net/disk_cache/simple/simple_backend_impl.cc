@@ -24,6 +24,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/metrics/sparse_histogram.h"
 #include "base/single_thread_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/sys_info.h"
 #include "base/task_runner_util.h"
 #include "base/threading/sequenced_worker_pool.h"
@@ -34,9 +35,11 @@
 #include "net/disk_cache/simple/simple_entry_format.h"
 #include "net/disk_cache/simple/simple_entry_impl.h"
 #include "net/disk_cache/simple/simple_histogram_macros.h"
+#include "net/disk_cache/simple/simple_hot_set.h"
 #include "net/disk_cache/simple/simple_index.h"
 #include "net/disk_cache/simple/simple_index_file.h"
 #include "net/disk_cache/simple/simple_synchronous_entry.h"
+#include "net/disk_cache/simple/simple_task_batcher.h"
 #include "net/disk_cache/simple/simple_util.h"
 #include "net/disk_cache/simple/simple_version_upgrade.h"
 
@@ -250,6 +253,9 @@ SimpleBackendImpl::~SimpleBackendImpl() {
 
 int SimpleBackendImpl::Init(const CompletionCallback& completion_callback) {
   worker_pool_ = g_sequenced_worker_pool.Get().GetTaskRunner();
+  task_batcher_ = new SimpleTaskBatcher(worker_pool_);
+  hot_set_.reset(
+      new SimpleHotSet(cache_type_, path_, cache_thread_, worker_pool_));
 
   index_.reset(new SimpleIndex(
       base::ThreadTaskRunnerHandle::Get(), this, cache_type_,
@@ -390,6 +396,7 @@ int SimpleBackendImpl::OpenEntry(const std::string& key,
   }
   scoped_refptr<SimpleEntryImpl> simple_entry =
       CreateOrFindActiveEntry(entry_hash, key);
+  hot_set_->OnEntryOpened(entry_hash);
   return simple_entry->OpenEntry(entry, callback);
 }
 
@@ -536,6 +543,14 @@ void SimpleBackendImpl::GetStats(base::StringPairs* stats) {
   item.first = "Cache type";
   item.second = "Simple Cache";
   stats->push_back(item);
+
+  item.first = "Hot set hits";
+  item.second = base::IntToString(hot_set_->hit_count());
+  stats->push_back(item);
+
+  item.first = "Hot set misses";
+  item.second = base::IntToString(hot_set_->miss_count());
+  stats->push_back(item);
 }
 
 void SimpleBackendImpl::OnExternalCacheHit(const std::string& key) {
@@ -547,6 +562,7 @@ void SimpleBackendImpl::InitializeIndex(const CompletionCallback& callback,
   if (result.net_error == net::OK) {
     index_->SetMaxSize(result.max_size);
     index_->Initialize(result.cache_dir_mtime);
+    hot_set_->Start();
   }
   callback.Run(result.net_error);
 }
@@ -46,7 +46,9 @@ namespace disk_cache {
 // otherwise stated.
 
 class SimpleEntryImpl;
+class SimpleHotSet;
 class SimpleIndex;
+class SimpleTaskBatcher;
 
 class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
     public SimpleIndexDelegate,
@@ -66,6 +68,9 @@ class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
 
   base::TaskRunner* worker_pool() { return worker_pool_.get(); }
 
+  // Batches the opens and creations of entries on |worker_pool_|.
+  SimpleTaskBatcher* task_batcher() { return task_batcher_.get(); }
+
   int Init(const CompletionCallback& completion_callback);
 
   // Sets the maximum size for the total amount of data stored by this instance.
@@ -200,6 +205,8 @@ class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
   std::unique_ptr<SimpleIndex> index_;
   const scoped_refptr<base::SingleThreadTaskRunner> cache_thread_;
   scoped_refptr<base::TaskRunner> worker_pool_;
+  scoped_refptr<SimpleTaskBatcher> task_batcher_;
+  std::unique_ptr<SimpleHotSet> hot_set_;
 
   int orig_max_size_;
   const SimpleEntryImpl::OperationsMode entry_operations_mode_;
@@ -28,6 +28,7 @@
 #include "net/disk_cache/simple/simple_index.h"
 #include "net/disk_cache/simple/simple_net_log_parameters.h"
 #include "net/disk_cache/simple/simple_synchronous_entry.h"
+#include "net/disk_cache/simple/simple_task_batcher.h"
 #include "net/disk_cache/simple/simple_util.h"
 #include "third_party/zlib/zlib.h"
 
@@ -173,6 +174,7 @@ SimpleEntryImpl::SimpleEntryImpl(net::CacheType cache_type,
     : backend_(backend->AsWeakPtr()),
       cache_type_(cache_type),
       worker_pool_(backend->worker_pool()),
+      task_batcher_(backend->task_batcher()),
       path_(path),
       entry_hash_(entry_hash),
       use_optimistic_operations_(operations_mode == OPTIMISTIC_OPERATIONS),
@@ -703,7 +705,7 @@ void SimpleEntryImpl::OpenEntryInternal(bool have_index,
       base::Bind(&SimpleEntryImpl::CreationOperationComplete, this, callback,
                  start_time, base::Passed(&results), out_entry,
                  net::NetLog::TYPE_SIMPLE_CACHE_ENTRY_OPEN_END);
-  worker_pool_->PostTaskAndReply(FROM_HERE, task, reply);
+  task_batcher_->PostTaskAndReply(FROM_HERE, task, reply);
 }
 
 void SimpleEntryImpl::CreateEntryInternal(bool have_index,
@@ -752,7 +754,7 @@ void SimpleEntryImpl::CreateEntryInternal(bool have_index,
                              base::Passed(&results),
                              out_entry,
                              net::NetLog::TYPE_SIMPLE_CACHE_ENTRY_CREATE_END);
-  worker_pool_->PostTaskAndReply(FROM_HERE, task, reply);
+  task_batcher_->PostTaskAndReply(FROM_HERE, task, reply);
 }
 
 void SimpleEntryImpl::CloseInternal() {
@@ -35,6 +35,7 @@ namespace disk_cache {
 class SimpleBackendImpl;
 class SimpleSynchronousEntry;
 class SimpleEntryStat;
+class SimpleTaskBatcher;
 struct SimpleEntryCreationResults;
 
 // SimpleEntryImpl is the IO thread interface to an entry in the very simple
@@ -317,6 +318,7 @@ class NET_EXPORT_PRIVATE SimpleEntryImpl : public Entry,
   const base::WeakPtr<SimpleBackendImpl> backend_;
   const net::CacheType cache_type_;
   const scoped_refptr<base::TaskRunner> worker_pool_;
+  const scoped_refptr<SimpleTaskBatcher> task_batcher_;
   const base::FilePath path_;
   const uint64_t entry_hash_;
   const bool use_optimistic_operations_;
@@ -0,0 +1,210 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_hot_set.h"
+
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/pickle.h"
+#include "base/single_thread_task_runner.h"
+#include "base/task_runner_util.h"
+#include "base/time/time.h"
+#include "net/disk_cache/simple/simple_entry_format.h"
+#include "net/disk_cache/simple/simple_histogram_macros.h"
+#include "net/disk_cache/simple/simple_index_file.h"
+#include "net/disk_cache/simple/simple_util.h"
+
+namespace disk_cache {
+
+namespace {
+
+const uint64_t kSimpleHotSetMagicNumber = UINT64_C(0x5a7e2c94b1d3f086);
+
+// Hot set files larger than this are not from this version of the code.
+const int64_t kMaxHotSetFileSize =
+    static_cast<int64_t>(SimpleHotSet::kMaxEntries) * sizeof(uint64_t) + 1024;
+
+}  // namespace
+
+const char SimpleHotSet::kHotSetFileName[] = "the-hot-set";
+
+SimpleHotSet::SimpleHotSet(
+    net::CacheType cache_type,
+    const base::FilePath& cache_directory,
+    const scoped_refptr<base::SingleThreadTaskRunner>& cache_thread,
+    const scoped_refptr<base::TaskRunner>& worker_pool)
+    : cache_type_(cache_type),
+      cache_directory_(cache_directory),
+      hot_set_file_(cache_directory_.AppendASCII(
+                        SimpleIndexFile::kIndexDirectory)
+                        .AppendASCII(kHotSetFileName)),
+      cache_thread_(cache_thread),
+      worker_pool_(worker_pool),
+      hit_count_(0),
+      miss_count_(0),
+      weak_ptr_factory_(this) {}
+
+SimpleHotSet::~SimpleHotSet() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+}
+
+void SimpleHotSet::Start() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  base::PostTaskAndReplyWithResult(
+      worker_pool_.get(), FROM_HERE,
+      base::Bind(&SimpleHotSet::SyncLoadAndPrefetch, cache_directory_,
+                 hot_set_file_),
+      base::Bind(&SimpleHotSet::OnPrefetchDone,
+                 weak_ptr_factory_.GetWeakPtr()));
+  recording_timer_.Start(FROM_HERE,
+                         base::TimeDelta::FromSeconds(kRecordingPeriodSecs),
+                         base::Bind(&SimpleHotSet::StopRecording,
+                                    base::Unretained(this)));
+}
+
+void SimpleHotSet::OnEntryOpened(uint64_t entry_hash) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  if (!is_recording() || recorded_entries_.size() >= kMaxEntries)
+    return;
+  if (!recorded_entries_set_.insert(entry_hash).second)
+    return;
+  recorded_entries_.push_back(entry_hash);
+  if (prefetched_entries_)
+    CountEntry(entry_hash);
+}
+
+bool SimpleHotSet::StopRecordingForTesting() {
+  if (!is_recording())
+    return false;
+  recording_timer_.Stop();
+  StopRecording();
+  return true;
+}
+
+// static
+std::unique_ptr<base::Pickle> SimpleHotSet::Serialize(
+    const std::vector<uint64_t>& entry_hashes) {
+  std::unique_ptr<base::Pickle> pickle(new base::Pickle());
+  pickle->WriteUInt64(kSimpleHotSetMagicNumber);
+  pickle->WriteUInt32(static_cast<uint32_t>(entry_hashes.size()));
+  for (uint64_t entry_hash : entry_hashes)
+    pickle->WriteUInt64(entry_hash);
+  return pickle;
+}
+
+// static
+bool SimpleHotSet::Deserialize(const char* data,
+                               int data_len,
+                               std::vector<uint64_t>* entry_hashes) {
+  DCHECK(entry_hashes->empty());
+  base::Pickle pickle(data, data_len);
+  if (!pickle.data())
+    return false;
+  base::PickleIterator pickle_it(pickle);
+  uint64_t magic_number;
+  uint32_t entry_count;
+  if (!pickle_it.ReadUInt64(&magic_number) ||
+      magic_number != kSimpleHotSetMagicNumber ||
+      !pickle_it.ReadUInt32(&entry_count) || entry_count > kMaxEntries) {
+    return false;
+  }
+  entry_hashes->reserve(entry_count);
+  for (uint32_t i = 0; i < entry_count; ++i) {
+    uint64_t entry_hash;
+    if (!pickle_it.ReadUInt64(&entry_hash)) {
+      entry_hashes->clear();
+      return false;
+    }
+    entry_hashes->push_back(entry_hash);
+  }
+  return true;
+}
+
+void SimpleHotSet::OnPrefetchDone(std::unique_ptr<HashSet> prefetched_entries) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  prefetched_entries_ = std::move(prefetched_entries);
+  // Count the entries opened while the prefetch was running.
+  for (uint64_t entry_hash : recorded_entries_)
+    CountEntry(entry_hash);
+}
+
+void SimpleHotSet::CountEntry(uint64_t entry_hash) {
+  DCHECK(prefetched_entries_);
+  if (prefetched_entries_->count(entry_hash))
+    ++hit_count_;
+  else
+    ++miss_count_;
+}
+
+void SimpleHotSet::StopRecording() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  if (prefetched_entries_) {
+    SIMPLE_CACHE_UMA(COUNTS, "HotSetHits", cache_type_, hit_count_);
+    SIMPLE_CACHE_UMA(COUNTS, "HotSetMisses", cache_type_, miss_count_);
+  }
+  SIMPLE_CACHE_UMA(COUNTS, "HotSetSize", cache_type_,
+                   recorded_entries_.size());
+
+  cache_thread_->PostTask(
+      FROM_HERE, base::Bind(&SimpleHotSet::SyncWrite, hot_set_file_,
+                            base::Passed(Serialize(recorded_entries_))));
+  recorded_entries_set_.clear();
+}
+
+// static
+std::unique_ptr<SimpleHotSet::HashSet> SimpleHotSet::SyncLoadAndPrefetch(
+    const base::FilePath& cache_directory,
+    const base::FilePath& hot_set_file) {
+  std::unique_ptr<HashSet> entry_set(new HashSet());
+  int64_t file_size;
+  if (!base::GetFileSize(hot_set_file, &file_size) ||
+      file_size > kMaxHotSetFileSize) {
+    return entry_set;
+  }
+  std::string contents;
+  std::vector<uint64_t> entry_hashes;
+  if (!base::ReadFileToString(hot_set_file, &contents) ||
+      !Deserialize(contents.data(), base::checked_cast<int>(contents.size()),
+                   &entry_hashes)) {
+    return entry_set;
+  }
+
+  // Prefetch in the order of the previous session, so that the first entries
+  // it needed are the first ones read from disk.
+  for (uint64_t entry_hash : entry_hashes) {
+    if (!entry_set->insert(entry_hash).second)
+      continue;
+    for (int i = 0; i < kSimpleEntryFileCount; ++i) {
+      simple_util::SimpleCachePrefetchFile(cache_directory.AppendASCII(
+          simple_util::GetFilenameFromEntryHashAndFileIndex(entry_hash, i)));
+    }
+  }
+  return entry_set;
+}
+
+// static
+void SimpleHotSet::SyncWrite(const base::FilePath& hot_set_file,
+                             std::unique_ptr<base::Pickle> pickle) {
+  // The hot set lives in the index directory, as writing to the cache
+  // directory would make the index look stale.
+  base::FilePath directory = hot_set_file.DirName();
+  if (!base::DirectoryExists(directory) && !base::CreateDirectory(directory))
+    return;
+  base::FilePath temp_file = hot_set_file.AddExtension(FILE_PATH_LITERAL("tmp"));
+  int bytes_written = base::WriteFile(
+      temp_file, static_cast<const char*>(pickle->data()), pickle->size());
+  if (bytes_written != base::checked_cast<int>(pickle->size())) {
+    simple_util::SimpleCacheDeleteFile(temp_file);
+    return;
+  }
+  base::ReplaceFile(temp_file, hot_set_file, nullptr);
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,129 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_HOT_SET_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_HOT_SET_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/thread_checker.h"
+#include "base/timer/timer.h"
+#include "net/base/cache_type.h"
+#include "net/base/net_export.h"
+
+namespace base {
+class Pickle;
+class SingleThreadTaskRunner;
+class TaskRunner;
+}
+
+namespace disk_cache {
+
+// Records the hashes of the entries opened during the first seconds of a
+// session and saves them next to the index when the recording ends. On the
+// next start, the files of these entries are prefetched into the page cache on
+// the worker pool, so that the first loads after a cold boot don't wait on
+// disk reads for the entries they always need. The entries opened while
+// recording are counted as hits if they were prefetched and as misses
+// otherwise, to measure the effect.
+//
+// Must be used on the IO thread.
+class NET_EXPORT_PRIVATE SimpleHotSet {
+ public:
+  // Entries opened later than this after Start() aren't recorded.
+  static const int kRecordingPeriodSecs = 20;
+
+  // Maximum number of entries in a hot set.
+  static const size_t kMaxEntries = 1000;
+
+  static const char kHotSetFileName[];
+
+  SimpleHotSet(net::CacheType cache_type,
+               const base::FilePath& cache_directory,
+               const scoped_refptr<base::SingleThreadTaskRunner>& cache_thread,
+               const scoped_refptr<base::TaskRunner>& worker_pool);
+  ~SimpleHotSet();
+
+  // Prefetches the hot set of the previous session and starts recording the
+  // one of this session.
+  void Start();
+
+  // Records that the entry for |entry_hash| is being opened.
+  void OnEntryOpened(uint64_t entry_hash);
+
+  // Number of entries opened while recording, which were prefetched or not.
+  // Entries opened before the prefetch started are counted once it did.
+  int hit_count() const { return hit_count_; }
+  int miss_count() const { return miss_count_; }
+
+  bool is_recording() const { return recording_timer_.IsRunning(); }
+
+  // Ends the recording period early and saves the hot set. Returns whether
+  // the recording was in progress.
+  bool StopRecordingForTesting();
+
+  // Serializes and deserializes the hashes of a hot set file. Exposed for
+  // testing.
+  static std::unique_ptr<base::Pickle> Serialize(
+      const std::vector<uint64_t>& entry_hashes);
+  static bool Deserialize(const char* data,
+                          int data_len,
+                          std::vector<uint64_t>* entry_hashes);
+
+ private:
+  typedef std::unordered_set<uint64_t> HashSet;
+
+  void OnPrefetchDone(std::unique_ptr<HashSet> prefetched_entries);
+
+  // Counts |entry_hash| as a hit or a miss.
+  void CountEntry(uint64_t entry_hash);
+
+  void StopRecording();
+
+  // Prefetches the files of the entries of |hot_set_file| and returns their
+  // hashes. Runs on the worker pool.
+  static std::unique_ptr<HashSet> SyncLoadAndPrefetch(
+      const base::FilePath& cache_directory,
+      const base::FilePath& hot_set_file);
+
+  // Writes |pickle| to |hot_set_file|. Runs on the cache thread.
+  static void SyncWrite(const base::FilePath& hot_set_file,
+                        std::unique_ptr<base::Pickle> pickle);
+
+  const net::CacheType cache_type_;
+  const base::FilePath cache_directory_;
+  const base::FilePath hot_set_file_;
+  const scoped_refptr<base::SingleThreadTaskRunner> cache_thread_;
+  const scoped_refptr<base::TaskRunner> worker_pool_;
+
+  // The entries opened while recording, in the order of their first opening.
+  std::vector<uint64_t> recorded_entries_;
+  HashSet recorded_entries_set_;
+
+  // The entries prefetched at Start(), once the prefetch is done.
+  std::unique_ptr<HashSet> prefetched_entries_;
+
+  int hit_count_;
+  int miss_count_;
+
+  base::OneShotTimer recording_timer_;
+
+  base::ThreadChecker thread_checker_;
+
+  base::WeakPtrFactory<SimpleHotSet> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleHotSet);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_HOT_SET_H_
@@ -0,0 +1,77 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_hot_set.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/pickle.h"
+#include "base/run_loop.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+
+TEST(SimpleHotSetTest, SerializeDeserialize) {
+  std::vector<uint64_t> entry_hashes = {UINT64_C(11), UINT64_C(22),
+                                        UINT64_C(0xffffffffffffffff)};
+  std::unique_ptr<base::Pickle> pickle = SimpleHotSet::Serialize(entry_hashes);
+
+  std::vector<uint64_t> read_hashes;
+  ASSERT_TRUE(SimpleHotSet::Deserialize(static_cast<const char*>(pickle->data()),
+                                        pickle->size(), &read_hashes));
+  EXPECT_EQ(entry_hashes, read_hashes);
+
+  // A truncated file is rejected.
+  read_hashes.clear();
+  EXPECT_FALSE(SimpleHotSet::Deserialize(
+      static_cast<const char*>(pickle->data()), pickle->size() - 4,
+      &read_hashes));
+  EXPECT_TRUE(read_hashes.empty());
+}
+
+TEST(SimpleHotSetTest, CountsHitsAndMissesOfTheNextSession) {
+  base::MessageLoopForIO message_loop;
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner =
+      base::ThreadTaskRunnerHandle::Get();
+
+  {
+    SimpleHotSet hot_set(net::DISK_CACHE, cache_dir.path(), task_runner,
+                         task_runner);
+    hot_set.Start();
+    hot_set.OnEntryOpened(1);
+    hot_set.OnEntryOpened(2);
+    hot_set.OnEntryOpened(1);
+    base::RunLoop().RunUntilIdle();
+    // Nothing was prefetched in the first session.
+    EXPECT_EQ(0, hot_set.hit_count());
+    EXPECT_EQ(2, hot_set.miss_count());
+    EXPECT_TRUE(hot_set.StopRecordingForTesting());
+    base::RunLoop().RunUntilIdle();
+  }
+
+  SimpleHotSet hot_set(net::DISK_CACHE, cache_dir.path(), task_runner,
+                       task_runner);
+  hot_set.Start();
+  // Counted once the prefetch is done.
+  hot_set.OnEntryOpened(2);
+  base::RunLoop().RunUntilIdle();
+  hot_set.OnEntryOpened(3);
+  EXPECT_EQ(1, hot_set.hit_count());
+  EXPECT_EQ(1, hot_set.miss_count());
+
+  EXPECT_TRUE(hot_set.StopRecordingForTesting());
+  EXPECT_FALSE(hot_set.is_recording());
+  hot_set.OnEntryOpened(1);
+  EXPECT_EQ(1, hot_set.hit_count());
+  base::RunLoop().RunUntilIdle();
+}
+
+}  // namespace disk_cache
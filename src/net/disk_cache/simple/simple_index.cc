@@ -49,6 +49,11 @@ const uint32_t kEvictionMarginDivisor = 20;
 
 const uint32_t kBytesInKb = 1024;
 
+// The journal is compacted into a new index file once it holds more records
+// than the largest of these two limits, so that loading it stays cheap.
+const int64_t kMinJournalEntriesBeforeCompaction = 1000;
+const uint32_t kJournalCompactionDivisor = 4;
+
 // Utility class used for timestamp comparisons in entry metadata while sorting.
 class CompareHashesForTimestamp {
   typedef disk_cache::SimpleIndex SimpleIndex;
@@ -152,6 +157,7 @@ SimpleIndex::SimpleIndex(
       high_watermark_(0),
       low_watermark_(0),
       eviction_in_progress_(false),
+      journal_entry_count_(-1),
       initialized_(false),
       init_method_(INITIALIZE_METHOD_MAX),
       index_file_(std::move(index_file)),
@@ -258,6 +264,7 @@ void SimpleIndex::Insert(uint64_t entry_hash) {
       entry_hash, EntryMetadata(base::Time::Now(), 0), &entries_set_);
   if (!initialized_)
     removed_entries_.erase(entry_hash);
+  changed_entries_.insert(entry_hash);
   PostponeWritingToDisk();
 }
 
@@ -271,6 +278,7 @@ void SimpleIndex::Remove(uint64_t entry_hash) {
 
   if (!initialized_)
     removed_entries_.insert(entry_hash);
+  changed_entries_.insert(entry_hash);
   PostponeWritingToDisk();
 }
 
@@ -289,6 +297,7 @@ bool SimpleIndex::UseIfExists(uint64_t entry_hash) {
     // If not initialized, always return true, forcing it to go to the disk.
     return !initialized_;
   it->second.SetLastUsedTime(base::Time::Now());
+  changed_entries_.insert(entry_hash);
   PostponeWritingToDisk();
   return true;
 }
@@ -349,6 +358,7 @@ bool SimpleIndex::UpdateEntrySize(uint64_t entry_hash, int64_t entry_size) {
     return false;
 
   UpdateEntryIteratorSize(&it, entry_size);
+  changed_entries_.insert(entry_hash);
   PostponeWritingToDisk();
   StartEvictionIfNeeded();
   return true;
@@ -387,6 +397,19 @@ void SimpleIndex::PostponeWritingToDisk() {
       FROM_HERE, base::TimeDelta::FromMilliseconds(delay), write_to_disk_cb_);
 }
 
+bool SimpleIndex::ShouldAppendToJournal(IndexWriteToDiskReason reason) const {
+  // Merges at startup follow a restore, which starts a new index file.
+  if (journal_entry_count_ < 0 || reason == INDEX_WRITE_REASON_STARTUP_MERGE)
+    return false;
+  const int64_t max_journal_entry_count =
+      std::max(kMinJournalEntriesBeforeCompaction,
+               static_cast<int64_t>(entries_set_.size() /
+                                    kJournalCompactionDivisor));
+  return journal_entry_count_ +
+             static_cast<int64_t>(changed_entries_.size()) <=
+         max_journal_entry_count;
+}
+
 void SimpleIndex::UpdateEntryIteratorSize(EntrySet::iterator* it,
                                           int64_t entry_size) {
   // Update the total cache size with the new entry size.
@@ -431,6 +454,7 @@ void SimpleIndex::MergeInitializingSet(
   cache_size_ = merged_cache_size;
   initialized_ = true;
   init_method_ = load_result->init_method;
+  journal_entry_count_ = load_result->journal_entry_count;
 
   // The actual IO is asynchronous, so calling WriteToDisk() shouldn't slow the
   // merge down much.
@@ -485,8 +509,18 @@ void SimpleIndex::WriteToDisk(IndexWriteToDiskReason reason) {
   }
   last_write_to_disk_ = start;
 
-  index_file_->WriteToDisk(reason, entries_set_, cache_size_, start,
-                           app_on_background_, base::Closure());
+  if (ShouldAppendToJournal(reason)) {
+    if (!changed_entries_.empty()) {
+      index_file_->AppendToJournal(entries_set_, changed_entries_,
+                                   base::Closure());
+      journal_entry_count_ += changed_entries_.size();
+    }
+  } else {
+    index_file_->WriteToDisk(reason, entries_set_, cache_size_, start,
+                             app_on_background_, base::Closure());
+    journal_entry_count_ = 0;
+  }
+  changed_entries_.clear();
 }
 
 }  // namespace disk_cache
@@ -169,6 +169,10 @@ class NET_EXPORT_PRIVATE SimpleIndex
 
   void PostponeWritingToDisk();
 
+  // Returns whether the changes since the last write can be appended to the
+  // journal of the index file instead of rewriting it.
+  bool ShouldAppendToJournal(IndexWriteToDiskReason reason) const;
+
   void UpdateEntryIteratorSize(EntrySet::iterator* it, int64_t entry_size);
 
   // Must run on IO Thread.
@@ -197,6 +201,15 @@ class NET_EXPORT_PRIVATE SimpleIndex
   // This stores all the entry_hash of entries that are removed during
   // initialization.
   std::unordered_set<uint64_t> removed_entries_;
+
+  // The hashes of the entries inserted, updated or removed since the index was
+  // last written to disk.
+  std::unordered_set<uint64_t> changed_entries_;
+
+  // Number of entry records in the journal of the index file, or -1 if it has
+  // no journal yet.
+  int64_t journal_entry_count_;
+
   bool initialized_;
   IndexInitMethod init_method_;
 
@@ -35,6 +35,9 @@ const int kEntryFilesSuffixLength = 2;
 
 const uint64_t kMaxEntriesInIndex = 100000000;
 
+// A journal record may hold at most this many entries.
+const uint32_t kMaxEntriesInJournalRecord = 10000000;
+
 uint32_t CalculatePickleCRC(const base::Pickle& pickle) {
   return crc32(crc32(0, Z_NULL, 0),
                reinterpret_cast<const Bytef*>(pickle.payload()),
@@ -170,7 +173,8 @@ void ProcessEntryFile(SimpleIndex::EntrySet* entries,
 SimpleIndexLoadResult::SimpleIndexLoadResult()
     : did_load(false),
       index_write_reason(SimpleIndex::INDEX_WRITE_REASON_MAX),
-      flush_required(false) {}
+      flush_required(false),
+      journal_entry_count(-1) {}
 
 SimpleIndexLoadResult::~SimpleIndexLoadResult() {
 }
@@ -179,6 +183,7 @@ void SimpleIndexLoadResult::Reset() {
   did_load = false;
   index_write_reason = SimpleIndex::INDEX_WRITE_REASON_MAX;
   flush_required = false;
+  journal_entry_count = -1;
   entries.clear();
 }
 
@@ -188,6 +193,8 @@ const char SimpleIndexFile::kIndexFileName[] = "the-real-index";
 const char SimpleIndexFile::kIndexDirectory[] = "index-dir";
 // static
 const char SimpleIndexFile::kTempIndexFileName[] = "temp-index";
+// static
+const char SimpleIndexFile::kJournalFileName[] = "the-real-index-journal";
 
 SimpleIndexFile::IndexMetadata::IndexMetadata()
     : magic_number_(kSimpleIndexMagicNumber),
@@ -246,6 +253,7 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
                                       const base::FilePath& cache_directory,
                                       const base::FilePath& index_filename,
                                       const base::FilePath& temp_index_filename,
+                                      const base::FilePath& journal_filename,
                                       std::unique_ptr<base::Pickle> pickle,
                                       const base::TimeTicks& start_time,
                                       bool app_on_background) {
@@ -274,6 +282,11 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
     return;
   }
 
+  // The journal holds updates to the old index file, so it must go away before
+  // the old index file does. Updates are only appended to an existing journal,
+  // hence if anything below fails, they won't be applied to the wrong index.
+  simple_util::SimpleCacheDeleteFile(journal_filename);
+
   // Atomically rename the temporary index file to become the real one.
   // TODO(gavinp): DCHECK when not shutting down, since that is very strange.
   // The rename failing during shutdown is legal because it's legal to begin
@@ -281,6 +294,12 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
   if (!base::ReplaceFile(temp_index_filename, index_filename, NULL))
     return;
 
+  File journal_file(journal_filename, File::FLAG_CREATE_ALWAYS |
+                                          File::FLAG_WRITE |
+                                          File::FLAG_SHARE_DELETE);
+  if (!journal_file.IsValid())
+    LOG(WARNING) << "Could not create the index journal file";
+
   if (app_on_background) {
     SIMPLE_CACHE_UMA(TIMES,
                      "IndexWriteToDiskTime.Background", cache_type,
@@ -317,7 +336,9 @@ SimpleIndexFile::SimpleIndexFile(
       index_file_(cache_directory_.AppendASCII(kIndexDirectory)
                       .AppendASCII(kIndexFileName)),
       temp_index_file_(cache_directory_.AppendASCII(kIndexDirectory)
-                           .AppendASCII(kTempIndexFileName)) {
+                           .AppendASCII(kTempIndexFileName)),
+      journal_file_(cache_directory_.AppendASCII(kIndexDirectory)
+                        .AppendASCII(kJournalFileName)) {
 }
 
 SimpleIndexFile::~SimpleIndexFile() {}
@@ -328,7 +349,7 @@ void SimpleIndexFile::LoadIndexEntries(base::Time cache_last_modified,
   base::Closure task = base::Bind(&SimpleIndexFile::SyncLoadIndexEntries,
                                   cache_type_,
                                   cache_last_modified, cache_directory_,
-                                  index_file_, out_result);
+                                  index_file_, journal_file_, out_result);
   worker_pool_->PostTaskAndReply(FROM_HERE, task, callback);
 }
 
@@ -344,23 +365,74 @@ void SimpleIndexFile::WriteToDisk(SimpleIndex::IndexWriteToDiskReason reason,
   base::Closure task =
       base::Bind(&SimpleIndexFile::SyncWriteToDisk,
                  cache_type_, cache_directory_, index_file_, temp_index_file_,
-                 base::Passed(&pickle), start, app_on_background);
+                 journal_file_, base::Passed(&pickle), start,
+                 app_on_background);
+  if (callback.is_null())
+    cache_thread_->PostTask(FROM_HERE, task);
+  else
+    cache_thread_->PostTaskAndReply(FROM_HERE, task, callback);
+}
+
+void SimpleIndexFile::AppendToJournal(
+    const SimpleIndex::EntrySet& entry_set,
+    const std::unordered_set<uint64_t>& changed_hashes,
+    const base::Closure& callback) {
+  std::unique_ptr<base::Pickle> pickle =
+      SerializeJournalRecord(entry_set, changed_hashes);
+  base::Closure task =
+      base::Bind(&SimpleIndexFile::SyncAppendToJournal, cache_directory_,
+                 journal_file_, base::Passed(&pickle));
   if (callback.is_null())
     cache_thread_->PostTask(FROM_HERE, task);
   else
     cache_thread_->PostTaskAndReply(FROM_HERE, task, callback);
 }
 
+// static
+void SimpleIndexFile::SyncAppendToJournal(
+    const base::FilePath& cache_directory,
+    const base::FilePath& journal_filename,
+    std::unique_ptr<base::Pickle> pickle) {
+  // Never create the journal: without it, the index file on disk may not be
+  // the one the updates apply to.
+  File file(journal_filename,
+            File::FLAG_OPEN | File::FLAG_APPEND | File::FLAG_SHARE_DELETE);
+  if (!file.IsValid())
+    return;
+
+  base::Time cache_dir_mtime;
+  if (!simple_util::GetMTime(cache_directory, &cache_dir_mtime)) {
+    LOG(ERROR) << "Could obtain information about cache age";
+    return;
+  }
+  SerializeFinalData(cache_dir_mtime, pickle.get());
+  const int bytes_written = file.WriteAtCurrentPos(
+      static_cast<const char*>(pickle->data()), pickle->size());
+  if (bytes_written != base::checked_cast<int>(pickle->size())) {
+    // The index file is now older than the journal said, which will make it
+    // look stale rather than silently miss updates.
+    LOG(ERROR) << "Failed to append to the index journal file";
+    file.Close();
+    simple_util::SimpleCacheDeleteFile(journal_filename);
+  }
+}
+
 // static
 void SimpleIndexFile::SyncLoadIndexEntries(
     net::CacheType cache_type,
     base::Time cache_last_modified,
     const base::FilePath& cache_directory,
     const base::FilePath& index_file_path,
+    const base::FilePath& journal_file_path,
     SimpleIndexLoadResult* out_result) {
-  // Load the index and find its age.
+  // Load the index, apply its journal and find its age.
   base::Time last_cache_seen_by_index;
   SyncLoadFromDisk(index_file_path, &last_cache_seen_by_index, out_result);
+  if (out_result->did_load) {
+    SyncLoadJournal(journal_file_path, &last_cache_seen_by_index, out_result);
+  } else {
+    simple_util::SimpleCacheDeleteFile(journal_file_path);
+  }
 
   // Consider the index loaded if it is fresh.
   const bool index_file_existed = base::PathExists(index_file_path);
@@ -389,7 +461,9 @@ void SimpleIndexFile::SyncLoadIndexEntries(
     UmaRecordIndexFileState(INDEX_STATE_STALE, cache_type);
   }
 
-  // Reconstruct the index by scanning the disk for entries.
+  // Reconstruct the index by scanning the disk for entries. The journal is
+  // started again when the restored index is written.
+  simple_util::SimpleCacheDeleteFile(journal_file_path);
   SimpleIndex::EntrySet entries_from_stale_index;
   entries_from_stale_index.swap(out_result->entries);
   const base::TimeTicks start = base::TimeTicks::Now();
@@ -449,6 +523,66 @@ void SimpleIndexFile::SyncLoadFromDisk(const base::FilePath& index_filename,
     simple_util::SimpleCacheDeleteFile(index_filename);
 }
 
+// static
+void SimpleIndexFile::SyncLoadJournal(const base::FilePath& journal_filename,
+                                      base::Time* out_last_cache_seen_by_index,
+                                      SimpleIndexLoadResult* out_result) {
+  DCHECK(out_result->did_load);
+  out_result->journal_entry_count = -1;
+
+  File file(journal_filename, File::FLAG_OPEN | File::FLAG_READ |
+                                  File::FLAG_WRITE | File::FLAG_SHARE_DELETE);
+  if (!file.IsValid())
+    return;
+  const int64_t file_length = file.GetLength();
+  if (file_length < 0)
+    return;
+  if (file_length == 0) {
+    out_result->journal_entry_count = 0;
+    return;
+  }
+
+  int64_t valid_length = 0;
+  int journal_entry_count = 0;
+  {
+    base::MemoryMappedFile journal_file_map;
+    if (!journal_file_map.Initialize(file.Duplicate())) {
+      file.Close();
+      simple_util::SimpleCacheDeleteFile(journal_filename);
+      return;
+    }
+    const char* data = reinterpret_cast<const char*>(journal_file_map.data());
+    const size_t length = journal_file_map.length();
+    size_t offset = 0;
+    while (length - offset >= sizeof(PickleHeader)) {
+      const PickleHeader* header =
+          reinterpret_cast<const PickleHeader*>(data + offset);
+      if (header->payload_size > length - offset - sizeof(PickleHeader))
+        break;
+      const size_t record_length = sizeof(PickleHeader) + header->payload_size;
+      base::Time cache_last_modified;
+      const int record_entry_count = DeserializeJournalRecord(
+          data + offset, base::checked_cast<int>(record_length),
+          &cache_last_modified, &out_result->entries);
+      if (record_entry_count < 0)
+        break;
+      journal_entry_count += record_entry_count;
+      *out_last_cache_seen_by_index = cache_last_modified;
+      offset += record_length;
+    }
+    valid_length = offset;
+  }
+
+  // Drop a torn or corrupt tail, so that later records aren't appended after
+  // it and lost.
+  if (valid_length != file_length && !file.SetLength(valid_length)) {
+    file.Close();
+    simple_util::SimpleCacheDeleteFile(journal_filename);
+    return;
+  }
+  out_result->journal_entry_count = journal_entry_count;
+}
+
 // static
 std::unique_ptr<base::Pickle> SimpleIndexFile::Serialize(
     const SimpleIndexFile::IndexMetadata& index_metadata,
@@ -465,6 +599,77 @@ std::unique_ptr<base::Pickle> SimpleIndexFile::Serialize(
   return pickle;
 }
 
+// static
+std::unique_ptr<base::Pickle> SimpleIndexFile::SerializeJournalRecord(
+    const SimpleIndex::EntrySet& entries,
+    const std::unordered_set<uint64_t>& changed_hashes) {
+  std::unique_ptr<base::Pickle> pickle(
+      new base::Pickle(sizeof(SimpleIndexFile::PickleHeader)));
+
+  pickle->WriteUInt64(kSimpleIndexJournalMagicNumber);
+  pickle->WriteUInt32(base::checked_cast<uint32_t>(changed_hashes.size()));
+  for (uint64_t hash : changed_hashes) {
+    SimpleIndex::EntrySet::const_iterator it = entries.find(hash);
+    const bool removed = it == entries.end();
+    pickle->WriteUInt64(hash);
+    pickle->WriteBool(removed);
+    if (!removed)
+      it->second.Serialize(pickle.get());
+  }
+  return pickle;
+}
+
+// static
+int SimpleIndexFile::DeserializeJournalRecord(
+    const char* data,
+    int data_len,
+    base::Time* out_cache_last_modified,
+    SimpleIndex::EntrySet* entries) {
+  DCHECK(data);
+
+  base::Pickle pickle(data, data_len);
+  if (!pickle.data())
+    return -1;
+  SimpleIndexFile::PickleHeader* header_p =
+      pickle.headerT<SimpleIndexFile::PickleHeader>();
+  if (header_p->crc != CalculatePickleCRC(pickle)) {
+    LOG(WARNING) << "Invalid CRC in Simple Index journal file.";
+    return -1;
+  }
+
+  base::PickleIterator pickle_it(pickle);
+  uint64_t magic_number;
+  uint32_t entry_count;
+  if (!pickle_it.ReadUInt64(&magic_number) ||
+      magic_number != kSimpleIndexJournalMagicNumber ||
+      !pickle_it.ReadUInt32(&entry_count) ||
+      entry_count > kMaxEntriesInJournalRecord) {
+    LOG(ERROR) << "Invalid record in Simple Index journal file.";
+    return -1;
+  }
+
+  for (uint32_t i = 0; i < entry_count; ++i) {
+    uint64_t hash_key;
+    bool removed;
+    if (!pickle_it.ReadUInt64(&hash_key) || !pickle_it.ReadBool(&removed))
+      return -1;
+    if (removed) {
+      entries->erase(hash_key);
+      continue;
+    }
+    EntryMetadata entry_metadata;
+    if (!entry_metadata.Deserialize(&pickle_it))
+      return -1;
+    (*entries)[hash_key] = entry_metadata;
+  }
+
+  int64_t cache_last_modified;
+  if (!pickle_it.ReadInt64(&cache_last_modified))
+    return -1;
+  *out_cache_last_modified = base::Time::FromInternalValue(cache_last_modified);
+  return base::checked_cast<int>(entry_count);
+}
+
 // static
 void SimpleIndexFile::Deserialize(const char* data, int data_len,
                                   base::Time* out_cache_last_modified,
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "base/files/file_path.h"
@@ -28,6 +29,7 @@ class TaskRunner;
 namespace disk_cache {
 
 const uint64_t kSimpleIndexMagicNumber = UINT64_C(0x656e74657220796f);
+const uint64_t kSimpleIndexJournalMagicNumber = UINT64_C(0x6a6f75726e616c21);
 
 struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
   SimpleIndexLoadResult();
@@ -39,6 +41,9 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
   SimpleIndex::IndexWriteToDiskReason index_write_reason;
   SimpleIndex::IndexInitMethod init_method;
   bool flush_required;
+  // Number of entry records in the journal of the loaded index, or -1 if the
+  // index has no journal that can be appended to.
+  int journal_entry_count;
 };
 
 // Simple Index File format is a pickle of IndexMetadata and EntryMetadata
@@ -47,6 +52,14 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
 // the format see |SimpleIndexFile::Serialize()| and
 // |SimpleIndexFile::LoadFromDisk()|.
 //
+// Updates between two writes of the index file are appended to a journal file
+// next to it, so that flushing a large index doesn't rewrite it entirely. The
+// journal is a sequence of pickles, each holding
+// |kSimpleIndexJournalMagicNumber|, a number of records made of an entry hash,
+// whether the entry was removed and its EntryMetadata otherwise, and the
+// modification time of the cache directory when it was written. The journal is replayed on top of the index
+// file when it is loaded, and is deleted before the index file is replaced.
+//
 // The non-static methods must run on the IO thread. All the real
 // work is done in the static methods, which are run on the cache thread
 // or in worker threads. Synchronization between methods is the
@@ -93,7 +106,8 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                                 const base::Closure& callback,
                                 SimpleIndexLoadResult* out_result);
 
-  // Write the specified set of entries to disk.
+  // Write the specified set of entries to disk, and start a new, empty
+  // journal.
   virtual void WriteToDisk(SimpleIndex::IndexWriteToDiskReason reason,
                            const SimpleIndex::EntrySet& entry_set,
                            uint64_t cache_size,
@@ -101,6 +115,19 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                            bool app_on_background,
                            const base::Closure& callback);
 
+  // Append the state in |entry_set| of the entries in |changed_hashes| to the
+  // journal of the index file. Entries missing from |entry_set| are journaled
+  // as removed. Nothing is written if the index file has no journal.
+  virtual void AppendToJournal(
+      const SimpleIndex::EntrySet& entry_set,
+      const std::unordered_set<uint64_t>& changed_hashes,
+      const base::Closure& callback);
+
+  // Name of the directory of the cache holding the index files. The cache
+  // directory itself only holds entry files, as its mtime tells whether the
+  // index is stale.
+  static const char kIndexDirectory[];
+
  private:
   friend class WrappedSimpleIndexFile;
 
@@ -116,6 +143,7 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                                    base::Time cache_last_modified,
                                    const base::FilePath& cache_directory,
                                    const base::FilePath& index_file_path,
+                                   const base::FilePath& journal_file_path,
                                    SimpleIndexLoadResult* out_result);
 
   // Load the index file from disk returning an EntrySet.
@@ -132,6 +160,29 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
       const SimpleIndexFile::IndexMetadata& index_metadata,
       const SimpleIndex::EntrySet& entries);
 
+  // Replays the journal in |journal_filename| on top of the entries of
+  // |out_result|, which must hold a loaded index, and updates
+  // |out_last_cache_seen_by_index| and |out_result->journal_entry_count|. A
+  // truncated or corrupt tail of the journal is discarded.
+  static void SyncLoadJournal(const base::FilePath& journal_filename,
+                              base::Time* out_last_cache_seen_by_index,
+                              SimpleIndexLoadResult* out_result);
+
+  // Returns a newly allocated base::Pickle holding a journal record for the
+  // entries in |changed_hashes|. Like for Serialize(), SerializeFinalData()
+  // must be called before writing it.
+  static std::unique_ptr<base::Pickle> SerializeJournalRecord(
+      const SimpleIndex::EntrySet& entries,
+      const std::unordered_set<uint64_t>& changed_hashes);
+
+  // Given a single journal record |data| of length |data_len|, applies it to
+  // |entries|. Returns the number of entry records it held, or -1 on error, in
+  // which case |entries| may be partially updated.
+  static int DeserializeJournalRecord(const char* data,
+                                      int data_len,
+                                      base::Time* out_cache_last_modified,
+                                      SimpleIndex::EntrySet* entries);
+
   // Appends cache modification time data to the serialized format. This is
   // performed on a thread accessing the disk. It is not combined with the main
   // serialization path to avoid extra thread hops or copying the pickle to the
@@ -154,15 +205,22 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
       const base::FilePath& cache_path,
       const EntryFileCallback& entry_file_callback);
 
-  // Writes the index file to disk atomically.
+  // Writes the index file to disk atomically, replacing its journal by an
+  // empty one.
   static void SyncWriteToDisk(net::CacheType cache_type,
                               const base::FilePath& cache_directory,
                               const base::FilePath& index_filename,
                               const base::FilePath& temp_index_filename,
+                              const base::FilePath& journal_filename,
                               std::unique_ptr<base::Pickle> pickle,
                               const base::TimeTicks& start_time,
                               bool app_on_background);
 
+  // Appends a journal record to the journal of the index file, if it exists.
+  static void SyncAppendToJournal(const base::FilePath& cache_directory,
+                                  const base::FilePath& journal_filename,
+                                  std::unique_ptr<base::Pickle> pickle);
+
   // Scan the index directory for entries, returning an EntrySet of all entries
   // found.
   static void SyncRestoreFromDisk(const base::FilePath& cache_directory,
@@ -186,10 +244,11 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
   const base::FilePath cache_directory_;
   const base::FilePath index_file_;
   const base::FilePath temp_index_file_;
+  const base::FilePath journal_file_;
 
-  static const char kIndexDirectory[];
   static const char kIndexFileName[];
   static const char kTempIndexFileName[];
+  static const char kJournalFileName[];
 
   DISALLOW_COPY_AND_ASSIGN(SimpleIndexFile);
 };
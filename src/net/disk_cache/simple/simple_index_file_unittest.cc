@@ -5,6 +5,7 @@
 #include "net/disk_cache/simple/simple_index_file.h"
 
 #include <memory>
+#include <unordered_set>
 
 #include "base/files/file.h"
 #include "base/files/file_util.h"
@@ -140,6 +141,8 @@ class WrappedSimpleIndexFile : public SimpleIndexFile {
     return temp_index_file_;
   }
 
+  const base::FilePath& GetJournalFilePath() const { return journal_file_; }
+
   bool CreateIndexFileDirectory() const {
     return base::CreateDirectory(index_file_.DirName());
   }
@@ -268,6 +271,61 @@ TEST_F(SimpleIndexFileTest, WriteThenLoadIndex) {
     EXPECT_EQ(1U, load_index_result.entries.count(kHashes[i]));
 }
 
+TEST_F(SimpleIndexFileTest, AppendToJournalThenLoadIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+
+  SimpleIndex::EntrySet entries;
+  SimpleIndex::InsertInEntrySet(11, EntryMetadata(Time(), 11u), &entries);
+  SimpleIndex::InsertInEntrySet(22, EntryMetadata(Time(), 22u), &entries);
+
+  net::TestClosure closure;
+  WrappedSimpleIndexFile simple_index_file(cache_dir.path());
+  simple_index_file.WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN,
+                                entries, 33u, base::TimeTicks(), false,
+                                closure.closure());
+  closure.WaitForResult();
+
+  // Remove one entry, update another and add a third one.
+  std::unordered_set<uint64_t> changed_hashes = {11, 22, 33};
+  entries.erase(11);
+  entries[22] = EntryMetadata(Time(), 222u);
+  SimpleIndex::InsertInEntrySet(33, EntryMetadata(Time(), 33u), &entries);
+  simple_index_file.AppendToJournal(entries, changed_hashes,
+                                    closure.closure());
+  closure.WaitForResult();
+
+  // Simulate a torn write at the end of the journal.
+  int64_t journal_size;
+  ASSERT_TRUE(base::GetFileSize(simple_index_file.GetJournalFilePath(),
+                                &journal_size));
+  EXPECT_LT(0, journal_size);
+  const std::string kDummyData = "torn";
+  ASSERT_TRUE(base::AppendToFile(simple_index_file.GetJournalFilePath(),
+                                 kDummyData.data(), kDummyData.size()));
+
+  base::Time fake_cache_mtime;
+  ASSERT_TRUE(simple_util::GetMTime(cache_dir.path(), &fake_cache_mtime));
+  SimpleIndexLoadResult load_index_result;
+  simple_index_file.LoadIndexEntries(fake_cache_mtime, closure.closure(),
+                                     &load_index_result);
+  closure.WaitForResult();
+
+  EXPECT_TRUE(load_index_result.did_load);
+  EXPECT_FALSE(load_index_result.flush_required);
+  EXPECT_EQ(3, load_index_result.journal_entry_count);
+  ASSERT_EQ(2u, load_index_result.entries.size());
+  EXPECT_EQ(0u, load_index_result.entries.count(11));
+  EXPECT_EQ(222u, load_index_result.entries[22].GetEntrySize());
+  EXPECT_EQ(33u, load_index_result.entries[33].GetEntrySize());
+
+  // The torn tail was dropped.
+  int64_t loaded_journal_size;
+  ASSERT_TRUE(base::GetFileSize(simple_index_file.GetJournalFilePath(),
+                                &loaded_journal_size));
+  EXPECT_EQ(journal_size, loaded_journal_size);
+}
+
 TEST_F(SimpleIndexFileTest, LoadCorruptIndex) {
   base::ScopedTempDir cache_dir;
   ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
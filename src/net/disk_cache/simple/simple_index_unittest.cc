@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <unordered_set>
 #include <utility>
 
 #include "base/files/scoped_temp_dir.h"
@@ -56,7 +57,8 @@ class MockSimpleIndexFile : public SimpleIndexFile,
       : SimpleIndexFile(NULL, NULL, net::DISK_CACHE, base::FilePath()),
         load_result_(NULL),
         load_index_entries_calls_(0),
-        disk_writes_(0) {}
+        disk_writes_(0),
+        journal_appends_(0) {}
 
   void LoadIndexEntries(base::Time cache_last_modified,
                         const base::Closure& callback,
@@ -76,6 +78,13 @@ class MockSimpleIndexFile : public SimpleIndexFile,
     disk_write_entry_set_ = entry_set;
   }
 
+  void AppendToJournal(const SimpleIndex::EntrySet& entry_set,
+                       const std::unordered_set<uint64_t>& changed_hashes,
+                       const base::Closure& callback) override {
+    journal_appends_++;
+    journal_changed_hashes_ = changed_hashes;
+  }
+
   void GetAndResetDiskWriteEntrySet(SimpleIndex::EntrySet* entry_set) {
     entry_set->swap(disk_write_entry_set_);
   }
@@ -84,6 +93,10 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   SimpleIndexLoadResult* load_result() const { return load_result_; }
   int load_index_entries_calls() const { return load_index_entries_calls_; }
   int disk_writes() const { return disk_writes_; }
+  int journal_appends() const { return journal_appends_; }
+  const std::unordered_set<uint64_t>& journal_changed_hashes() const {
+    return journal_changed_hashes_;
+  }
 
  private:
   base::Closure load_callback_;
@@ -91,6 +104,8 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   int load_index_entries_calls_;
   int disk_writes_;
   SimpleIndex::EntrySet disk_write_entry_set_;
+  int journal_appends_;
+  std::unordered_set<uint64_t> journal_changed_hashes_;
 };
 
 class SimpleIndexTest  : public testing::Test, public SimpleIndexDelegate {
@@ -644,4 +659,28 @@ TEST_F(SimpleIndexTest, DiskWritePostponed) {
   index()->write_to_disk_timer_.Stop();
 }
 
+// Confirm that once the index file has a journal, the changes since the last
+// write are appended to it instead of rewriting the index file.
+TEST_F(SimpleIndexTest, DiskWriteAppendsToJournal) {
+  index()->SetMaxSize(1000);
+  InsertIntoIndexFileReturn(hashes_.at<1>(), base::Time::Now(), 10u);
+  InsertIntoIndexFileReturn(hashes_.at<2>(), base::Time::Now(), 10u);
+  index_file_->load_result()->journal_entry_count = 0;
+  ReturnIndexFile();
+
+  index()->Insert(hashes_.at<3>());
+  index()->Remove(hashes_.at<1>());
+  index()->WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_IDLE);
+  EXPECT_EQ(0, index_file_->disk_writes());
+  EXPECT_EQ(1, index_file_->journal_appends());
+  EXPECT_EQ(2u, index_file_->journal_changed_hashes().size());
+  EXPECT_EQ(1u, index_file_->journal_changed_hashes().count(hashes_.at<1>()));
+  EXPECT_EQ(1u, index_file_->journal_changed_hashes().count(hashes_.at<3>()));
+
+  // Nothing changed, so there is nothing to append.
+  index()->WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN);
+  EXPECT_EQ(0, index_file_->disk_writes());
+  EXPECT_EQ(1, index_file_->journal_appends());
+}
+
 }  // namespace disk_cache
@@ -0,0 +1,81 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_task_batcher.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/single_thread_task_runner.h"
+#include "base/task_runner.h"
+#include "base/threading/thread_task_runner_handle.h"
+
+namespace disk_cache {
+
+// static
+const size_t SimpleTaskBatcher::kMaxTasksPerBatch;
+
+SimpleTaskBatcher::SimpleTaskBatcher(
+    const scoped_refptr<base::TaskRunner>& worker_pool)
+    : worker_pool_(worker_pool),
+      reply_task_runner_(base::ThreadTaskRunnerHandle::Get()),
+      pending_batch_count_(0) {}
+
+SimpleTaskBatcher::~SimpleTaskBatcher() {}
+
+void SimpleTaskBatcher::PostTaskAndReply(
+    const tracked_objects::Location& from_here,
+    const base::Closure& task,
+    const base::Closure& reply) {
+  DCHECK(reply_task_runner_->BelongsToCurrentThread());
+  {
+    base::AutoLock auto_lock(lock_);
+    pending_tasks_.push_back(std::make_pair(task, reply));
+    // The batches already posted will take care of the task if they have room
+    // for it.
+    if (pending_batch_count_ * kMaxTasksPerBatch >= pending_tasks_.size())
+      return;
+    ++pending_batch_count_;
+  }
+  worker_pool_->PostTask(from_here,
+                         base::Bind(&SimpleTaskBatcher::RunBatch, this));
+}
+
+void SimpleTaskBatcher::RunBatch() {
+  TaskList batch;
+  {
+    base::AutoLock auto_lock(lock_);
+    DCHECK_GT(pending_batch_count_, 0u);
+    --pending_batch_count_;
+    const size_t batch_size =
+        std::min(kMaxTasksPerBatch, pending_tasks_.size());
+    batch.insert(batch.end(), pending_tasks_.begin(),
+                 pending_tasks_.begin() + batch_size);
+    pending_tasks_.erase(pending_tasks_.begin(),
+                         pending_tasks_.begin() + batch_size);
+  }
+  if (batch.empty())
+    return;
+
+  std::unique_ptr<std::vector<base::Closure>> replies(
+      new std::vector<base::Closure>);
+  replies->reserve(batch.size());
+  for (const auto& task_and_reply : batch) {
+    task_and_reply.first.Run();
+    replies->push_back(task_and_reply.second);
+  }
+  reply_task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(&SimpleTaskBatcher::RunReplies, base::Passed(&replies)));
+}
+
+// static
+void SimpleTaskBatcher::RunReplies(
+    std::unique_ptr<std::vector<base::Closure>> replies) {
+  for (const base::Closure& reply : *replies)
+    reply.Run();
+}
+
+}  // namespace disk_cache
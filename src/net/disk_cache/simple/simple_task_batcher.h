@@ -0,0 +1,83 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_TASK_BATCHER_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_TASK_BATCHER_H_
+
+#include <stddef.h>
+
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "net/base/net_export.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+class TaskRunner;
+}
+
+namespace tracked_objects {
+class Location;
+}
+
+namespace disk_cache {
+
+// Groups the tasks posted while a batch is waiting for a worker into a single
+// task of |worker_pool|, so that the opens and creations of the entries needed
+// by a page load don't each pay for a thread hop to and from the worker pool.
+// The replies of a batch are run together, in order, on the thread which
+// created the batcher. Batches are bounded so that large bursts are still
+// spread over several workers.
+class NET_EXPORT_PRIVATE SimpleTaskBatcher
+    : public base::RefCountedThreadSafe<SimpleTaskBatcher> {
+ public:
+  // Maximum number of tasks run by a single worker task.
+  static const size_t kMaxTasksPerBatch = 16;
+
+  explicit SimpleTaskBatcher(
+      const scoped_refptr<base::TaskRunner>& worker_pool);
+
+  // Like base::TaskRunner::PostTaskAndReply(). Must be called on the thread
+  // which created the batcher.
+  void PostTaskAndReply(const tracked_objects::Location& from_here,
+                        const base::Closure& task,
+                        const base::Closure& reply);
+
+ private:
+  friend class base::RefCountedThreadSafe<SimpleTaskBatcher>;
+
+  typedef std::deque<std::pair<base::Closure, base::Closure>> TaskList;
+
+  ~SimpleTaskBatcher();
+
+  // Runs up to |kMaxTasksPerBatch| pending tasks on a worker.
+  void RunBatch();
+
+  static void RunReplies(std::unique_ptr<std::vector<base::Closure>> replies);
+
+  const scoped_refptr<base::TaskRunner> worker_pool_;
+  const scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner_;
+
+  // Protects the members below, which are accessed on the thread of
+  // |reply_task_runner_| and on workers.
+  base::Lock lock_;
+
+  // Tasks and their replies waiting for a worker.
+  TaskList pending_tasks_;
+
+  // Number of RunBatch() tasks posted to |worker_pool_| and not started yet.
+  size_t pending_batch_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleTaskBatcher);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_TASK_BATCHER_H_
@@ -0,0 +1,64 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_task_batcher.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/test/test_simple_task_runner.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+
+namespace {
+
+void AppendValue(std::vector<int>* values, int value) {
+  values->push_back(value);
+}
+
+}  // namespace
+
+TEST(SimpleTaskBatcherTest, BatchesTasksAndReplies) {
+  base::MessageLoop message_loop;
+  scoped_refptr<base::TestSimpleTaskRunner> worker_pool(
+      new base::TestSimpleTaskRunner);
+  scoped_refptr<SimpleTaskBatcher> batcher(new SimpleTaskBatcher(worker_pool));
+
+  const int kNumTasks = 2 * SimpleTaskBatcher::kMaxTasksPerBatch + 1;
+  std::vector<int> tasks_run;
+  std::vector<int> replies_run;
+  for (int i = 0; i < kNumTasks; ++i) {
+    batcher->PostTaskAndReply(FROM_HERE,
+                              base::Bind(&AppendValue, &tasks_run, i),
+                              base::Bind(&AppendValue, &replies_run, i));
+  }
+
+  // The tasks are spread over as few worker tasks as possible.
+  EXPECT_EQ(3u, worker_pool->GetPendingTasks().size());
+  worker_pool->RunPendingTasks();
+  ASSERT_EQ(static_cast<size_t>(kNumTasks), tasks_run.size());
+  EXPECT_TRUE(replies_run.empty());
+
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(static_cast<size_t>(kNumTasks), replies_run.size());
+  for (int i = 0; i < kNumTasks; ++i) {
+    EXPECT_EQ(i, tasks_run[i]);
+    EXPECT_EQ(i, replies_run[i]);
+  }
+
+  // Once the batches ran, posting a task needs a new worker task.
+  batcher->PostTaskAndReply(FROM_HERE,
+                            base::Bind(&AppendValue, &tasks_run, kNumTasks),
+                            base::Bind(&AppendValue, &replies_run, kNumTasks));
+  EXPECT_EQ(1u, worker_pool->GetPendingTasks().size());
+  worker_pool->RunPendingTasks();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(static_cast<size_t>(kNumTasks + 1), replies_run.size());
+}
+
+}  // namespace disk_cache
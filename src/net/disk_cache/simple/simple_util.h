@@ -82,6 +82,11 @@ NET_EXPORT_PRIVATE bool GetMTime(const base::FilePath& path,
 // is possible to immediately create a new file with the same name.
 NET_EXPORT_PRIVATE bool SimpleCacheDeleteFile(const base::FilePath& path);
 
+// Asks the OS to read the file at |path| into the page cache in the
+// background. Returns false if the file can't be opened or the platform has no
+// such hint.
+NET_EXPORT_PRIVATE bool SimpleCachePrefetchFile(const base::FilePath& path);
+
 }  // namespace simple_util
 
 }  // namespace disk_cache
@@ -4,7 +4,12 @@
 
 #include "net/disk_cache/simple/simple_util.h"
 
+#include <fcntl.h>
+
 #include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/posix/eintr_wrapper.h"
+#include "build/build_config.h"
 
 namespace disk_cache {
 namespace simple_util {
@@ -13,5 +18,17 @@ bool SimpleCacheDeleteFile(const base::FilePath& path) {
   return base::DeleteFile(path, false);
 }
 
+bool SimpleCachePrefetchFile(const base::FilePath& path) {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  base::ScopedFD fd(
+      HANDLE_EINTR(open(path.value().c_str(), O_RDONLY | O_CLOEXEC)));
+  if (!fd.is_valid())
+    return false;
+  return posix_fadvise(fd.get(), 0, 0, POSIX_FADV_WILLNEED) == 0;
+#else
+  return false;
+#endif
+}
+
 }  // namespace simple_util
 }  // namespace disk_cache
@@ -40,5 +40,10 @@ bool SimpleCacheDeleteFile(const base::FilePath& path) {
   return DeleteCacheFile(path);
 }
 
+bool SimpleCachePrefetchFile(const base::FilePath& path) {
+  // Windows has no advisory read-ahead for files which aren't mapped.
+  return false;
+}
+
 }  // namespace simple_util
 }  // namespace disk_cache
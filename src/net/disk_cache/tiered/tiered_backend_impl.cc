@@ -0,0 +1,269 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/tiered/tiered_backend_impl.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/memory/mem_backend_impl.h"
+#include "net/disk_cache/tiered/tiered_entry_impl.h"
+
+namespace disk_cache {
+
+namespace {
+
+// Returns true if the memory tier should keep a copy of |disk_entry|.
+bool ShouldCopyToMemory(Entry* disk_entry) {
+  int64_t total_size = 0;
+  for (int i = 0; i < TieredEntryImpl::kNumStreams; ++i)
+    total_size += disk_entry->GetDataSize(i);
+  if (total_size > TieredBackendImpl::kMaxMemoryEntrySize)
+    return false;
+  // Not all backends can tell whether an entry is sparse. Sparse data is kept
+  // apart from the data stream, which is thus empty for sparse entries.
+  return !disk_entry->CouldBeSparse() || disk_entry->GetDataSize(1) > 0;
+}
+
+}  // namespace
+
+// Wraps the entries returned by the iterator of the disk tier, so that writes
+// to them also reach the memory tier.
+class TieredBackendImpl::TieredIterator final : public Backend::Iterator {
+ public:
+  TieredIterator(const base::WeakPtr<TieredBackendImpl>& backend,
+                 std::unique_ptr<Backend::Iterator> disk_iterator)
+      : backend_(backend), disk_iterator_(std::move(disk_iterator)) {}
+
+  int OpenNextEntry(Entry** next_entry,
+                    const CompletionCallback& callback) override {
+    Entry** disk_entry = new Entry*(nullptr);
+    CompletionCallback disk_callback =
+        base::Bind(&TieredIterator::OnDiskEntryOpened, backend_, next_entry,
+                   base::Owned(disk_entry), callback);
+    int rv = disk_iterator_->OpenNextEntry(disk_entry, disk_callback);
+    if (rv == net::ERR_IO_PENDING)
+      return rv;
+    if (!backend_) {
+      if (rv == net::OK)
+        (*disk_entry)->Close();
+      return net::ERR_FAILED;
+    }
+    return backend_->OnDiskEntryReady(std::string(), next_entry, *disk_entry,
+                                      rv);
+  }
+
+ private:
+  static void OnDiskEntryOpened(const base::WeakPtr<TieredBackendImpl>& backend,
+                                Entry** next_entry,
+                                Entry** disk_entry,
+                                const CompletionCallback& callback,
+                                int result) {
+    if (!backend) {
+      if (result == net::OK)
+        (*disk_entry)->Close();
+      callback.Run(net::ERR_FAILED);
+      return;
+    }
+    callback.Run(backend->OnDiskEntryReady(std::string(), next_entry,
+                                           *disk_entry, result));
+  }
+
+  const base::WeakPtr<TieredBackendImpl> backend_;
+  std::unique_ptr<Backend::Iterator> disk_iterator_;
+
+  DISALLOW_COPY_AND_ASSIGN(TieredIterator);
+};
+
+TieredBackendImpl::TieredBackendImpl(std::unique_ptr<Backend> disk_backend,
+                                     int memory_tier_max_bytes,
+                                     net::NetLog* net_log)
+    : disk_(std::move(disk_backend)),
+      memory_(new MemBackendImpl(net_log)),
+      memory_hit_count_(0),
+      memory_miss_count_(0),
+      weak_factory_(this) {
+  memory_->SetMaxSize(memory_tier_max_bytes);
+  memory_->Init();
+  memory_pressure_listener_.reset(new base::MemoryPressureListener(
+      base::Bind(&TieredBackendImpl::OnMemoryPressure,
+                 base::Unretained(this))));
+}
+
+TieredBackendImpl::~TieredBackendImpl() {}
+
+// static
+std::unique_ptr<Backend> TieredBackendImpl::Create(
+    std::unique_ptr<Backend> disk_backend,
+    int max_bytes,
+    net::NetLog* net_log) {
+  DCHECK(disk_backend);
+  return std::unique_ptr<Backend>(new TieredBackendImpl(
+      std::move(disk_backend), max_bytes ? max_bytes : kDefaultMemoryTierSize,
+      net_log));
+}
+
+net::CacheType TieredBackendImpl::GetCacheType() const {
+  return disk_->GetCacheType();
+}
+
+int32_t TieredBackendImpl::GetEntryCount() const {
+  return disk_->GetEntryCount();
+}
+
+int TieredBackendImpl::OpenEntry(const std::string& key,
+                                 Entry** entry,
+                                 const CompletionCallback& callback) {
+  if (!keys_in_use_in_memory_.count(key)) {
+    Entry* memory_entry = nullptr;
+    if (memory_->OpenEntry(key, &memory_entry, CompletionCallback()) ==
+        net::OK) {
+      ++memory_hit_count_;
+      keys_in_use_in_memory_.insert(key);
+      TieredEntryImpl* tiered_entry = new TieredEntryImpl(
+          weak_factory_.GetWeakPtr(), key, nullptr, memory_entry, true);
+      // Released by Close().
+      tiered_entry->AddRef();
+      *entry = tiered_entry;
+      return net::OK;
+    }
+  }
+  ++memory_miss_count_;
+
+  Entry** disk_entry = new Entry*(nullptr);
+  CompletionCallback disk_callback = base::Bind(
+      &TieredBackendImpl::OnDiskOperationComplete, weak_factory_.GetWeakPtr(),
+      key, entry, base::Owned(disk_entry), callback);
+  int rv = disk_->OpenEntry(key, disk_entry, disk_callback);
+  if (rv == net::ERR_IO_PENDING)
+    return rv;
+  return OnDiskEntryReady(key, entry, *disk_entry, rv);
+}
+
+int TieredBackendImpl::CreateEntry(const std::string& key,
+                                   Entry** entry,
+                                   const CompletionCallback& callback) {
+  Entry** disk_entry = new Entry*(nullptr);
+  CompletionCallback disk_callback = base::Bind(
+      &TieredBackendImpl::OnDiskOperationComplete, weak_factory_.GetWeakPtr(),
+      key, entry, base::Owned(disk_entry), callback);
+  int rv = disk_->CreateEntry(key, disk_entry, disk_callback);
+  if (rv == net::ERR_IO_PENDING)
+    return rv;
+  return OnDiskEntryReady(key, entry, *disk_entry, rv);
+}
+
+int TieredBackendImpl::DoomEntry(const std::string& key,
+                                 const CompletionCallback& callback) {
+  memory_->DoomEntry(key, CompletionCallback());
+  return disk_->DoomEntry(key, callback);
+}
+
+int TieredBackendImpl::DoomAllEntries(const CompletionCallback& callback) {
+  memory_->DoomAllEntries(CompletionCallback());
+  return disk_->DoomAllEntries(callback);
+}
+
+// The last use times of the memory copies don't always match the ones of the
+// disk tier, so the whole memory tier goes away with any range of entries.
+int TieredBackendImpl::DoomEntriesBetween(base::Time initial_time,
+                                          base::Time end_time,
+                                          const CompletionCallback& callback) {
+  memory_->DoomAllEntries(CompletionCallback());
+  return disk_->DoomEntriesBetween(initial_time, end_time, callback);
+}
+
+int TieredBackendImpl::DoomEntriesSince(base::Time initial_time,
+                                        const CompletionCallback& callback) {
+  memory_->DoomAllEntries(CompletionCallback());
+  return disk_->DoomEntriesSince(initial_time, callback);
+}
+
+int TieredBackendImpl::CalculateSizeOfAllEntries(
+    const CompletionCallback& callback) {
+  return disk_->CalculateSizeOfAllEntries(callback);
+}
+
+std::unique_ptr<Backend::Iterator> TieredBackendImpl::CreateIterator() {
+  return std::unique_ptr<Backend::Iterator>(
+      new TieredIterator(weak_factory_.GetWeakPtr(), disk_->CreateIterator()));
+}
+
+void TieredBackendImpl::GetStats(base::StringPairs* stats) {
+  disk_->GetStats(stats);
+
+  std::pair<std::string, std::string> item;
+  item.first = "Memory tier entries";
+  item.second = base::IntToString(memory_->GetEntryCount());
+  stats->push_back(item);
+
+  item.first = "Memory tier hits";
+  item.second = base::IntToString(memory_hit_count_);
+  stats->push_back(item);
+
+  item.first = "Memory tier misses";
+  item.second = base::IntToString(memory_miss_count_);
+  stats->push_back(item);
+}
+
+void TieredBackendImpl::OnExternalCacheHit(const std::string& key) {
+  memory_->OnExternalCacheHit(key);
+  disk_->OnExternalCacheHit(key);
+}
+
+int TieredBackendImpl::OnDiskEntryReady(const std::string& key,
+                                        Entry** entry,
+                                        Entry* disk_entry,
+                                        int result) {
+  if (result != net::OK)
+    return result;
+
+  // Iterated entries are only known by their key once open.
+  const std::string entry_key = key.empty() ? disk_entry->GetKey() : key;
+  Entry* memory_entry = nullptr;
+  if (!keys_in_use_in_memory_.count(entry_key)) {
+    // A copy which isn't in use may predate writes to the disk tier.
+    memory_->DoomEntry(entry_key, CompletionCallback());
+    if (ShouldCopyToMemory(disk_entry) &&
+        memory_->CreateEntry(entry_key, &memory_entry, CompletionCallback()) ==
+            net::OK) {
+      keys_in_use_in_memory_.insert(entry_key);
+    } else {
+      memory_entry = nullptr;
+    }
+  }
+
+  TieredEntryImpl* tiered_entry =
+      new TieredEntryImpl(weak_factory_.GetWeakPtr(), entry_key, disk_entry,
+                          memory_entry, false);
+  // Released by Close().
+  tiered_entry->AddRef();
+  *entry = tiered_entry;
+  return net::OK;
+}
+
+void TieredBackendImpl::OnDiskOperationComplete(
+    const std::string& key,
+    Entry** entry,
+    Entry** disk_entry,
+    const CompletionCallback& callback,
+    int result) {
+  callback.Run(OnDiskEntryReady(key, entry, *disk_entry, result));
+}
+
+void TieredBackendImpl::OnMemoryEntryReleased(const std::string& key) {
+  keys_in_use_in_memory_.erase(key);
+}
+
+void TieredBackendImpl::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  // The memory tier only saves disk reads, so it goes away on any pressure.
+  // Copies in use are doomed too, and discarded once closed.
+  memory_->DoomAllEntries(CompletionCallback());
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,135 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// See net/disk_cache/disk_cache.h for the public interface of the cache.
+
+#ifndef NET_DISK_CACHE_TIERED_TIERED_BACKEND_IMPL_H_
+#define NET_DISK_CACHE_TIERED_TIERED_BACKEND_IMPL_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/weak_ptr.h"
+#include "base/strings/string_split.h"
+#include "base/time/time.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/disk_cache.h"
+
+namespace net {
+class NetLog;
+}  // namespace net
+
+namespace disk_cache {
+
+class MemBackendImpl;
+class TieredEntryImpl;
+
+// This class implements the Backend interface on top of another backend,
+// usually the simple backend, by keeping copies of the recently used small
+// entries in a MemBackendImpl. Opening an entry of the memory tier doesn't
+// touch the disk until the entry is written to, so repeated loads of the same
+// resources are served from memory.
+//
+// Writes go through to both tiers. An entry is copied to memory while it is
+// written, or while it is read sequentially after being opened from the disk
+// tier, and the copy is only kept if it holds all the data of the entry when
+// the entry is closed. Sparse entries and entries larger than
+// |kMaxMemoryEntrySize| stay on disk only. The memory tier is emptied on
+// memory pressure.
+class NET_EXPORT_PRIVATE TieredBackendImpl final : public Backend {
+ public:
+  // Entries larger than this aren't copied to memory.
+  static const int kMaxMemoryEntrySize = 64 * 1024;
+
+  // The size of the memory tier, when |max_bytes| of Create() is zero.
+  static const int kDefaultMemoryTierSize = 8 * 1024 * 1024;
+
+  TieredBackendImpl(std::unique_ptr<Backend> disk_backend,
+                    int memory_tier_max_bytes,
+                    net::NetLog* net_log);
+  ~TieredBackendImpl() override;
+
+  // Returns a backend using |disk_backend| as its disk tier, with a memory
+  // tier of at most |max_bytes|, or of a default size if |max_bytes| is zero.
+  static std::unique_ptr<Backend> Create(std::unique_ptr<Backend> disk_backend,
+                                         int max_bytes,
+                                         net::NetLog* net_log);
+
+  // Number of entries opened from each tier.
+  int memory_hit_count() const { return memory_hit_count_; }
+  int memory_miss_count() const { return memory_miss_count_; }
+
+  // Backend interface.
+  net::CacheType GetCacheType() const override;
+  int32_t GetEntryCount() const override;
+  int OpenEntry(const std::string& key,
+                Entry** entry,
+                const CompletionCallback& callback) override;
+  int CreateEntry(const std::string& key,
+                  Entry** entry,
+                  const CompletionCallback& callback) override;
+  int DoomEntry(const std::string& key,
+                const CompletionCallback& callback) override;
+  int DoomAllEntries(const CompletionCallback& callback) override;
+  int DoomEntriesBetween(base::Time initial_time,
+                         base::Time end_time,
+                         const CompletionCallback& callback) override;
+  int DoomEntriesSince(base::Time initial_time,
+                       const CompletionCallback& callback) override;
+  int CalculateSizeOfAllEntries(const CompletionCallback& callback) override;
+  std::unique_ptr<Iterator> CreateIterator() override;
+  void GetStats(base::StringPairs* stats) override;
+  void OnExternalCacheHit(const std::string& key) override;
+
+ private:
+  class TieredIterator;
+  friend class TieredIterator;
+  friend class TieredEntryImpl;
+
+  // Wraps |disk_entry|, the result of opening or creating |key| on the disk
+  // tier, into |*entry| if |result| is net::OK, and copies it to memory if it
+  // is small enough. |key| is empty for iterated entries.
+  int OnDiskEntryReady(const std::string& key,
+                       Entry** entry,
+                       Entry* disk_entry,
+                       int result);
+
+  void OnDiskOperationComplete(const std::string& key,
+                               Entry** entry,
+                               Entry** disk_entry,
+                               const CompletionCallback& callback,
+                               int result);
+
+  // Called by TieredEntryImpl when it doesn't use the memory copy of |key|
+  // anymore.
+  void OnMemoryEntryReleased(const std::string& key);
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  std::unique_ptr<Backend> disk_;
+  std::unique_ptr<MemBackendImpl> memory_;
+
+  // Keys whose memory copy is used by an open entry. These copies may be
+  // incomplete or about to be written, so they aren't opened again.
+  std::unordered_set<std::string> keys_in_use_in_memory_;
+
+  int memory_hit_count_;
+  int memory_miss_count_;
+
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
+  base::WeakPtrFactory<TieredBackendImpl> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(TieredBackendImpl);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_TIERED_TIERED_BACKEND_IMPL_H_
@@ -0,0 +1,153 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/tiered/tiered_backend_impl.h"
+
+#include <memory>
+#include <string>
+
+#include "base/memory/memory_pressure_listener.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/disk_cache/memory/mem_backend_impl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+
+namespace {
+
+// Uses a MemBackendImpl as the disk tier, which keeps the tests synchronous.
+class TieredBackendImplTest : public testing::Test {
+ protected:
+  TieredBackendImplTest() {
+    std::unique_ptr<MemBackendImpl> disk_backend(new MemBackendImpl(nullptr));
+    disk_backend->SetMaxSize(10 * 1024 * 1024);
+    EXPECT_TRUE(disk_backend->Init());
+    disk_backend_ = disk_backend.get();
+    backend_.reset(new TieredBackendImpl(std::move(disk_backend),
+                                         1024 * 1024, nullptr));
+  }
+
+  void CreateEntryWithData(const std::string& key, const std::string& data) {
+    net::TestCompletionCallback cb;
+    Entry* entry = nullptr;
+    ASSERT_EQ(net::OK,
+              cb.GetResult(backend_->CreateEntry(key, &entry, cb.callback())));
+    WriteStream(entry, 0, "headers");
+    WriteStream(entry, 1, data);
+    entry->Close();
+  }
+
+  void WriteStream(Entry* entry, int index, const std::string& data) {
+    scoped_refptr<net::StringIOBuffer> buffer(new net::StringIOBuffer(data));
+    net::TestCompletionCallback cb;
+    EXPECT_EQ(static_cast<int>(data.size()),
+              cb.GetResult(entry->WriteData(index, 0, buffer.get(),
+                                            data.size(), cb.callback(),
+                                            true)));
+  }
+
+  std::string ReadStream(Entry* entry, int index) {
+    scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(4096));
+    net::TestCompletionCallback cb;
+    int rv = cb.GetResult(
+        entry->ReadData(index, 0, buffer.get(), 4096, cb.callback()));
+    return rv > 0 ? std::string(buffer->data(), rv) : std::string();
+  }
+
+  Entry* OpenEntry(Backend* backend, const std::string& key) {
+    net::TestCompletionCallback cb;
+    Entry* entry = nullptr;
+    if (cb.GetResult(backend->OpenEntry(key, &entry, cb.callback())) !=
+        net::OK) {
+      return nullptr;
+    }
+    return entry;
+  }
+
+  base::MessageLoopForIO message_loop_;
+  MemBackendImpl* disk_backend_;
+  std::unique_ptr<TieredBackendImpl> backend_;
+};
+
+}  // namespace
+
+TEST_F(TieredBackendImplTest, CreatedEntriesAreOpenedFromMemory) {
+  CreateEntryWithData("key", "body");
+
+  Entry* entry = OpenEntry(backend_.get(), "key");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(1, backend_->memory_hit_count());
+  EXPECT_EQ("headers", ReadStream(entry, 0));
+  EXPECT_EQ("body", ReadStream(entry, 1));
+  entry->Close();
+}
+
+TEST_F(TieredBackendImplTest, LargeEntriesStayOnDisk) {
+  CreateEntryWithData("key",
+                      std::string(TieredBackendImpl::kMaxMemoryEntrySize, 'x'));
+
+  Entry* entry = OpenEntry(backend_.get(), "key");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(0, backend_->memory_hit_count());
+  EXPECT_EQ(1, backend_->memory_miss_count());
+  entry->Close();
+}
+
+TEST_F(TieredBackendImplTest, WritesToMemoryEntriesReachTheDisk) {
+  CreateEntryWithData("key", "body");
+
+  Entry* entry = OpenEntry(backend_.get(), "key");
+  ASSERT_TRUE(entry);
+  WriteStream(entry, 0, "new headers");
+  EXPECT_EQ("new headers", ReadStream(entry, 0));
+  entry->Close();
+
+  Entry* disk_entry = OpenEntry(disk_backend_, "key");
+  ASSERT_TRUE(disk_entry);
+  EXPECT_EQ("new headers", ReadStream(disk_entry, 0));
+  disk_entry->Close();
+
+  // The memory copy was updated too.
+  entry = OpenEntry(backend_.get(), "key");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(2, backend_->memory_hit_count());
+  EXPECT_EQ("new headers", ReadStream(entry, 0));
+  entry->Close();
+}
+
+TEST_F(TieredBackendImplTest, MemoryPressureDropsTheMemoryTier) {
+  CreateEntryWithData("key", "body");
+
+  base::MemoryPressureListener::NotifyMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  base::RunLoop().RunUntilIdle();
+
+  Entry* entry = OpenEntry(backend_.get(), "key");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(0, backend_->memory_hit_count());
+  // Reading the whole entry from disk copies it back to memory.
+  EXPECT_EQ("headers", ReadStream(entry, 0));
+  EXPECT_EQ("body", ReadStream(entry, 1));
+  entry->Close();
+
+  entry = OpenEntry(backend_.get(), "key");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(1, backend_->memory_hit_count());
+  entry->Close();
+}
+
+TEST_F(TieredBackendImplTest, DoomingRemovesBothTiers) {
+  CreateEntryWithData("key", "body");
+
+  net::TestCompletionCallback cb;
+  EXPECT_EQ(net::OK, cb.GetResult(backend_->DoomEntry("key", cb.callback())));
+  EXPECT_FALSE(OpenEntry(backend_.get(), "key"));
+  EXPECT_FALSE(OpenEntry(disk_backend_, "key"));
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,363 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/tiered/tiered_entry_impl.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/single_thread_task_runner.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/tiered/tiered_backend_impl.h"
+
+namespace disk_cache {
+
+namespace {
+
+void RunOperationAndCallback(
+    const base::Callback<int(const net::CompletionCallback&)>& operation,
+    const net::CompletionCallback& operation_callback) {
+  const int operation_result = operation.Run(operation_callback);
+  if (operation_result != net::ERR_IO_PENDING)
+    operation_callback.Run(operation_result);
+}
+
+void IgnoreResult(int result) {}
+
+}  // namespace
+
+TieredEntryImpl::TieredEntryImpl(const base::WeakPtr<TieredBackendImpl>& backend,
+                                 const std::string& key,
+                                 Entry* disk_entry,
+                                 Entry* memory_entry,
+                                 bool memory_entry_is_complete)
+    : backend_(backend),
+      key_(key),
+      disk_entry_(disk_entry),
+      memory_entry_(memory_entry),
+      memory_entry_is_complete_(memory_entry && memory_entry_is_complete),
+      opening_disk_entry_(nullptr) {
+  DCHECK(disk_entry_ || memory_entry_is_complete_);
+  for (int i = 0; i < kNumStreams; ++i)
+    copied_size_[i] = memory_entry_ ? memory_entry_->GetDataSize(i) : 0;
+}
+
+void TieredEntryImpl::Doom() {
+  if (memory_entry_)
+    memory_entry_->Doom();
+  if (disk_entry_)
+    disk_entry_->Doom();
+  else if (backend_)
+    backend_->disk_->DoomEntry(key_, base::Bind(&IgnoreResult));
+}
+
+void TieredEntryImpl::Close() {
+  Release();
+}
+
+std::string TieredEntryImpl::GetKey() const {
+  return key_;
+}
+
+base::Time TieredEntryImpl::GetLastUsed() const {
+  if (disk_entry_)
+    return disk_entry_->GetLastUsed();
+  return memory_entry_ ? memory_entry_->GetLastUsed() : base::Time();
+}
+
+base::Time TieredEntryImpl::GetLastModified() const {
+  if (disk_entry_)
+    return disk_entry_->GetLastModified();
+  return memory_entry_ ? memory_entry_->GetLastModified() : base::Time();
+}
+
+int32_t TieredEntryImpl::GetDataSize(int index) const {
+  if (disk_entry_)
+    return disk_entry_->GetDataSize(index);
+  return memory_entry_ ? memory_entry_->GetDataSize(index) : 0;
+}
+
+int TieredEntryImpl::ReadData(int index,
+                              int offset,
+                              IOBuffer* buf,
+                              int buf_len,
+                              const CompletionCallback& callback) {
+  if (pending_operations_.empty() && CanReadFromMemory(index, offset, buf_len))
+    return memory_entry_->ReadData(index, offset, buf, buf_len, callback);
+  return RunWithDiskEntry(
+      base::Bind(&TieredEntryImpl::DoReadData, this, index, offset,
+                 make_scoped_refptr(buf), buf_len),
+      callback);
+}
+
+int TieredEntryImpl::WriteData(int index,
+                               int offset,
+                               IOBuffer* buf,
+                               int buf_len,
+                               const CompletionCallback& callback,
+                               bool truncate) {
+  return RunWithDiskEntry(
+      base::Bind(&TieredEntryImpl::DoWriteData, this, index, offset,
+                 make_scoped_refptr(buf), buf_len, truncate),
+      callback);
+}
+
+// The sparse data isn't copied to memory, and the memory copy of an entry
+// which uses it wouldn't be complete.
+int TieredEntryImpl::ReadSparseData(int64_t offset,
+                                    IOBuffer* buf,
+                                    int buf_len,
+                                    const CompletionCallback& callback) {
+  if (memory_entry_)
+    ReleaseMemoryEntry(false);
+  return RunWithDiskEntry(
+      base::Bind(&TieredEntryImpl::DoReadSparseData, this, offset,
+                 make_scoped_refptr(buf), buf_len),
+      callback);
+}
+
+int TieredEntryImpl::WriteSparseData(int64_t offset,
+                                     IOBuffer* buf,
+                                     int buf_len,
+                                     const CompletionCallback& callback) {
+  if (memory_entry_)
+    ReleaseMemoryEntry(false);
+  return RunWithDiskEntry(
+      base::Bind(&TieredEntryImpl::DoWriteSparseData, this, offset,
+                 make_scoped_refptr(buf), buf_len),
+      callback);
+}
+
+int TieredEntryImpl::GetAvailableRange(int64_t offset,
+                                       int len,
+                                       int64_t* start,
+                                       const CompletionCallback& callback) {
+  if (memory_entry_)
+    ReleaseMemoryEntry(false);
+  return RunWithDiskEntry(
+      base::Bind(&TieredEntryImpl::DoGetAvailableRange, this, offset, len,
+                 start),
+      callback);
+}
+
+bool TieredEntryImpl::CouldBeSparse() const {
+  // Without the disk tier entry this can't be told, and any entry could be
+  // sparse.
+  return disk_entry_ ? disk_entry_->CouldBeSparse() : true;
+}
+
+void TieredEntryImpl::CancelSparseIO() {
+  if (disk_entry_)
+    disk_entry_->CancelSparseIO();
+}
+
+int TieredEntryImpl::ReadyForSparseIO(const CompletionCallback& callback) {
+  return disk_entry_ ? disk_entry_->ReadyForSparseIO(callback) : net::OK;
+}
+
+TieredEntryImpl::~TieredEntryImpl() {
+  DCHECK(pending_operations_.empty());
+  if (memory_entry_)
+    ReleaseMemoryEntry(MemoryCopyIsComplete());
+  if (disk_entry_)
+    disk_entry_->Close();
+}
+
+int TieredEntryImpl::RunWithDiskEntry(const Operation& operation,
+                                      const CompletionCallback& callback) {
+  if (disk_entry_)
+    return operation.Run(callback);
+
+  pending_operations_.push_back(std::make_pair(operation, callback));
+  if (pending_operations_.size() > 1)
+    return net::ERR_IO_PENDING;
+
+  int rv = net::ERR_FAILED;
+  if (backend_) {
+    rv = backend_->disk_->OpenEntry(
+        key_, &opening_disk_entry_,
+        base::Bind(&TieredEntryImpl::OnDiskEntryOpened, this));
+  }
+  if (rv != net::ERR_IO_PENDING) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::Bind(&TieredEntryImpl::OnDiskEntryOpened, this, rv));
+  }
+  return net::ERR_IO_PENDING;
+}
+
+void TieredEntryImpl::OnDiskEntryOpened(int result) {
+  if (result == net::OK) {
+    disk_entry_ = opening_disk_entry_;
+  } else {
+    // The disk tier evicted the entry, which the memory copy mustn't outlive.
+    DLOG(WARNING) << "The disk tier lost an entry of the memory tier";
+  }
+  opening_disk_entry_ = nullptr;
+
+  if (memory_entry_) {
+    bool copy_matches_disk_entry = disk_entry_;
+    for (int i = 0; i < kNumStreams && copy_matches_disk_entry; ++i) {
+      copy_matches_disk_entry =
+          copied_size_[i] == disk_entry_->GetDataSize(i);
+    }
+    if (!copy_matches_disk_entry)
+      ReleaseMemoryEntry(false);
+  }
+
+  std::vector<std::pair<Operation, CompletionCallback>> operations;
+  operations.swap(pending_operations_);
+  for (const auto& operation : operations) {
+    if (disk_entry_)
+      RunOperationAndCallback(operation.first, operation.second);
+    else
+      operation.second.Run(net::ERR_FAILED);
+  }
+}
+
+int TieredEntryImpl::DoReadData(int index,
+                                int offset,
+                                const scoped_refptr<IOBuffer>& buf,
+                                int buf_len,
+                                const CompletionCallback& callback) {
+  int rv = disk_entry_->ReadData(
+      index, offset, buf.get(), buf_len,
+      base::Bind(&TieredEntryImpl::OnDiskReadComplete, this, index, offset,
+                 buf, callback));
+  if (rv != net::ERR_IO_PENDING)
+    CopyReadToMemory(index, offset, buf.get(), rv);
+  return rv;
+}
+
+int TieredEntryImpl::DoWriteData(int index,
+                                 int offset,
+                                 const scoped_refptr<IOBuffer>& buf,
+                                 int buf_len,
+                                 bool truncate,
+                                 const CompletionCallback& callback) {
+  CopyWriteToMemory(index, offset, buf.get(), buf_len, truncate);
+  int rv = disk_entry_->WriteData(
+      index, offset, buf.get(), buf_len,
+      base::Bind(&TieredEntryImpl::OnDiskWriteComplete, this, buf_len,
+                 callback),
+      truncate);
+  if (rv != net::ERR_IO_PENDING && rv != buf_len && memory_entry_)
+    ReleaseMemoryEntry(false);
+  return rv;
+}
+
+int TieredEntryImpl::DoReadSparseData(int64_t offset,
+                                      const scoped_refptr<IOBuffer>& buf,
+                                      int buf_len,
+                                      const CompletionCallback& callback) {
+  return disk_entry_->ReadSparseData(offset, buf.get(), buf_len, callback);
+}
+
+int TieredEntryImpl::DoWriteSparseData(int64_t offset,
+                                       const scoped_refptr<IOBuffer>& buf,
+                                       int buf_len,
+                                       const CompletionCallback& callback) {
+  return disk_entry_->WriteSparseData(offset, buf.get(), buf_len, callback);
+}
+
+int TieredEntryImpl::DoGetAvailableRange(int64_t offset,
+                                         int len,
+                                         int64_t* start,
+                                         const CompletionCallback& callback) {
+  return disk_entry_->GetAvailableRange(offset, len, start, callback);
+}
+
+void TieredEntryImpl::OnDiskReadComplete(int index,
+                                         int offset,
+                                         const scoped_refptr<IOBuffer>& buf,
+                                         const CompletionCallback& callback,
+                                         int result) {
+  CopyReadToMemory(index, offset, buf.get(), result);
+  callback.Run(result);
+}
+
+void TieredEntryImpl::OnDiskWriteComplete(int buf_len,
+                                          const CompletionCallback& callback,
+                                          int result) {
+  if (result != buf_len && memory_entry_)
+    ReleaseMemoryEntry(false);
+  callback.Run(result);
+}
+
+bool TieredEntryImpl::CanReadFromMemory(int index,
+                                        int offset,
+                                        int buf_len) const {
+  if (!memory_entry_)
+    return false;
+  if (memory_entry_is_complete_)
+    return true;
+  return index >= 0 && index < kNumStreams &&
+         static_cast<int64_t>(offset) + buf_len <= copied_size_[index];
+}
+
+void TieredEntryImpl::CopyReadToMemory(int index,
+                                       int offset,
+                                       IOBuffer* buf,
+                                       int result) {
+  if (!memory_entry_ || result <= 0 || index < 0 || index >= kNumStreams ||
+      offset != copied_size_[index]) {
+    return;
+  }
+  CopyWriteToMemory(index, offset, buf, result, false);
+}
+
+void TieredEntryImpl::CopyWriteToMemory(int index,
+                                        int offset,
+                                        IOBuffer* buf,
+                                        int buf_len,
+                                        bool truncate) {
+  if (!memory_entry_)
+    return;
+  // Writes leaving a gap in the copy can't be applied to it.
+  if (index < 0 || index >= kNumStreams || offset < 0 ||
+      offset > copied_size_[index]) {
+    ReleaseMemoryEntry(false);
+    return;
+  }
+  if (memory_entry_->WriteData(index, offset, buf, buf_len,
+                               CompletionCallback(), truncate) != buf_len) {
+    ReleaseMemoryEntry(false);
+    return;
+  }
+  const int32_t end = offset + buf_len;
+  copied_size_[index] = truncate ? end : std::max(copied_size_[index], end);
+
+  int64_t total_size = 0;
+  for (int i = 0; i < kNumStreams; ++i)
+    total_size += copied_size_[i];
+  if (total_size > TieredBackendImpl::kMaxMemoryEntrySize)
+    ReleaseMemoryEntry(false);
+}
+
+bool TieredEntryImpl::MemoryCopyIsComplete() const {
+  DCHECK(memory_entry_);
+  if (!disk_entry_)
+    return memory_entry_is_complete_;
+  for (int i = 0; i < kNumStreams; ++i) {
+    if (copied_size_[i] != disk_entry_->GetDataSize(i))
+      return false;
+  }
+  return true;
+}
+
+void TieredEntryImpl::ReleaseMemoryEntry(bool keep) {
+  DCHECK(memory_entry_);
+  if (!keep)
+    memory_entry_->Doom();
+  memory_entry_->Close();
+  memory_entry_ = nullptr;
+  memory_entry_is_complete_ = false;
+  if (backend_)
+    backend_->OnMemoryEntryReleased(key_);
+}
+
+}  // namespace disk_cache
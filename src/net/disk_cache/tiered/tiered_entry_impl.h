@@ -0,0 +1,173 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_TIERED_TIERED_ENTRY_IMPL_H_
+#define NET_DISK_CACHE_TIERED_TIERED_ENTRY_IMPL_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/disk_cache.h"
+
+namespace disk_cache {
+
+class TieredBackendImpl;
+
+// This class implements the Entry interface for TieredBackendImpl. It wraps
+// the entry of the disk tier and the copy of the entry in the memory tier,
+// either of which may be missing:
+// - An entry opened from the memory tier only opens the disk tier entry when
+//   it is written to, or when the copy can't serve a read.
+// - While an entry is open, the data written to it and the data read from
+//   the disk tier in order are copied to memory. The copy is kept by the memory
+//   tier if it holds all the data of the entry when the entry is destroyed.
+// The entry is destroyed once it is closed and its operations are complete.
+class NET_EXPORT_PRIVATE TieredEntryImpl final
+    : public Entry,
+      public base::RefCounted<TieredEntryImpl> {
+ public:
+  // Number of data streams copied to memory.
+  static const int kNumStreams = 3;
+
+  // |disk_entry| and |memory_entry| may be null, and are owned by the created
+  // entry. |memory_entry_is_complete| tells whether |memory_entry| holds all
+  // the data of the entry.
+  TieredEntryImpl(const base::WeakPtr<TieredBackendImpl>& backend,
+                  const std::string& key,
+                  Entry* disk_entry,
+                  Entry* memory_entry,
+                  bool memory_entry_is_complete);
+
+  // Entry interface.
+  void Doom() override;
+  void Close() override;
+  std::string GetKey() const override;
+  base::Time GetLastUsed() const override;
+  base::Time GetLastModified() const override;
+  int32_t GetDataSize(int index) const override;
+  int ReadData(int index,
+               int offset,
+               IOBuffer* buf,
+               int buf_len,
+               const CompletionCallback& callback) override;
+  int WriteData(int index,
+                int offset,
+                IOBuffer* buf,
+                int buf_len,
+                const CompletionCallback& callback,
+                bool truncate) override;
+  int ReadSparseData(int64_t offset,
+                     IOBuffer* buf,
+                     int buf_len,
+                     const CompletionCallback& callback) override;
+  int WriteSparseData(int64_t offset,
+                      IOBuffer* buf,
+                      int buf_len,
+                      const CompletionCallback& callback) override;
+  int GetAvailableRange(int64_t offset,
+                        int len,
+                        int64_t* start,
+                        const CompletionCallback& callback) override;
+  bool CouldBeSparse() const override;
+  void CancelSparseIO() override;
+  int ReadyForSparseIO(const CompletionCallback& callback) override;
+
+ private:
+  friend class base::RefCounted<TieredEntryImpl>;
+
+  typedef base::Callback<int(const CompletionCallback&)> Operation;
+
+  ~TieredEntryImpl() override;
+
+  // Runs |operation| once the disk tier entry is open, or fails it with
+  // net::ERR_FAILED if the disk tier lost the entry.
+  int RunWithDiskEntry(const Operation& operation,
+                       const CompletionCallback& callback);
+  void OnDiskEntryOpened(int result);
+
+  // Operations run on the disk tier entry.
+  int DoReadData(int index,
+                 int offset,
+                 const scoped_refptr<IOBuffer>& buf,
+                 int buf_len,
+                 const CompletionCallback& callback);
+  int DoWriteData(int index,
+                  int offset,
+                  const scoped_refptr<IOBuffer>& buf,
+                  int buf_len,
+                  bool truncate,
+                  const CompletionCallback& callback);
+  int DoReadSparseData(int64_t offset,
+                       const scoped_refptr<IOBuffer>& buf,
+                       int buf_len,
+                       const CompletionCallback& callback);
+  int DoWriteSparseData(int64_t offset,
+                        const scoped_refptr<IOBuffer>& buf,
+                        int buf_len,
+                        const CompletionCallback& callback);
+  int DoGetAvailableRange(int64_t offset,
+                          int len,
+                          int64_t* start,
+                          const CompletionCallback& callback);
+
+  void OnDiskReadComplete(int index,
+                          int offset,
+                          const scoped_refptr<IOBuffer>& buf,
+                          const CompletionCallback& callback,
+                          int result);
+  void OnDiskWriteComplete(int buf_len,
+                           const CompletionCallback& callback,
+                           int result);
+
+  // Returns true if a read of |buf_len| bytes at |offset| of stream |index|
+  // can be served by the memory copy.
+  bool CanReadFromMemory(int index, int offset, int buf_len) const;
+
+  // Copies |result| bytes read from the disk tier to memory, if they follow
+  // the data already copied.
+  void CopyReadToMemory(int index, int offset, IOBuffer* buf, int result);
+
+  // Applies a write to the memory copy, or drops the copy if it can't hold
+  // the result.
+  void CopyWriteToMemory(int index,
+                         int offset,
+                         IOBuffer* buf,
+                         int buf_len,
+                         bool truncate);
+
+  // Returns true if the memory copy holds all the data of the entry.
+  bool MemoryCopyIsComplete() const;
+
+  // Closes the memory copy, and dooms it unless |keep| is true.
+  void ReleaseMemoryEntry(bool keep);
+
+  const base::WeakPtr<TieredBackendImpl> backend_;
+  const std::string key_;
+
+  Entry* disk_entry_;
+  Entry* memory_entry_;
+  bool memory_entry_is_complete_;
+
+  // The size of the data of each stream which is copied to memory.
+  int32_t copied_size_[kNumStreams];
+
+  // Operations waiting for the disk tier entry to be opened, and where the
+  // opened entry is stored.
+  std::vector<std::pair<Operation, CompletionCallback>> pending_operations_;
+  Entry* opening_disk_entry_;
+
+  DISALLOW_COPY_AND_ASSIGN(TieredEntryImpl);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_TIERED_TIERED_ENTRY_IMPL_H_
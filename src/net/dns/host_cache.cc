@@ -10,6 +10,9 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/trace_event/trace_event.h"
+#include "base/values.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
 #include "net/dns/dns_util.h"
 
@@ -26,6 +29,13 @@ namespace {
 #define CACHE_HISTOGRAM_ENUM(name, value, max) \
   UMA_HISTOGRAM_ENUMERATION("DNS.HostCache." name, value, max)
 
+// Keys of the dictionaries written by GetAsListValue().
+const char kHostnameKey[] = "hostname";
+const char kAddressFamilyKey[] = "address_family";
+const char kFlagsKey[] = "flags";
+const char kExpirationKey[] = "expiration";
+const char kAddressesKey[] = "addresses";
+
 }  // namespace
 
 // Used in histograms; do not modify existing values.
@@ -103,7 +113,7 @@ void HostCache::Entry::GetStaleness(base::TimeTicks now,
 }
 
 HostCache::HostCache(size_t max_entries)
-    : max_entries_(max_entries), network_changes_(0) {}
+    : max_entries_(max_entries), network_changes_(0), delegate_(nullptr) {}
 
 HostCache::~HostCache() {
   RecordEraseAll(ERASE_DESTRUCT, base::TimeTicks::Now());
@@ -186,6 +196,9 @@ void HostCache::Set(const Key& key,
   entries_.insert(
       std::make_pair(Key(key), Entry(entry, now, ttl, network_changes_)));
   DCHECK_GE(max_entries_, size());
+
+  if (delegate_)
+    delegate_->ScheduleWrite();
 }
 
 void HostCache::OnNetworkChange() {
@@ -196,6 +209,101 @@ void HostCache::clear() {
   DCHECK(CalledOnValidThread());
   RecordEraseAll(ERASE_CLEAR, base::TimeTicks::Now());
   entries_.clear();
+  if (delegate_)
+    delegate_->ScheduleWrite();
+}
+
+void HostCache::GetAsListValue(base::ListValue* entry_list) const {
+  DCHECK(CalledOnValidThread());
+  DCHECK(entry_list);
+  // TimeTicks don't survive a restart, so expirations are converted to
+  // wall-clock times.
+  base::TimeTicks now_ticks = base::TimeTicks::Now();
+  base::Time now = base::Time::Now();
+  for (const auto& it : entries_) {
+    const Key& key = it.first;
+    const Entry& entry = it.second;
+    if (entry.error() != OK)
+      continue;
+
+    std::unique_ptr<base::DictionaryValue> entry_dict(
+        new base::DictionaryValue());
+    entry_dict->SetString(kHostnameKey, key.hostname);
+    entry_dict->SetInteger(kAddressFamilyKey,
+                           static_cast<int>(key.address_family));
+    entry_dict->SetInteger(kFlagsKey, key.host_resolver_flags);
+    // base::Value has no 64-bit integers, so store the time as a string.
+    base::Time expiration = now + (entry.expires() - now_ticks);
+    entry_dict->SetString(kExpirationKey,
+                          base::Int64ToString(expiration.ToInternalValue()));
+
+    std::unique_ptr<base::ListValue> addresses(new base::ListValue());
+    for (const IPEndPoint& address : entry.addresses())
+      addresses->AppendString(address.ToStringWithoutPort());
+    entry_dict->Set(kAddressesKey, std::move(addresses));
+
+    entry_list->Append(std::move(entry_dict));
+  }
+}
+
+bool HostCache::RestoreFromListValue(const base::ListValue& entry_list) {
+  DCHECK(CalledOnValidThread());
+  base::TimeTicks now_ticks = base::TimeTicks::Now();
+  base::Time now = base::Time::Now();
+  bool all_parsed = true;
+  for (const auto& value : entry_list) {
+    if (size() >= max_entries_)
+      break;
+
+    const base::DictionaryValue* entry_dict;
+    std::string hostname;
+    int address_family;
+    int flags;
+    std::string expiration_string;
+    int64_t expiration;
+    const base::ListValue* address_list;
+    if (!value->GetAsDictionary(&entry_dict) ||
+        !entry_dict->GetString(kHostnameKey, &hostname) ||
+        !entry_dict->GetInteger(kAddressFamilyKey, &address_family) ||
+        address_family < ADDRESS_FAMILY_UNSPECIFIED ||
+        address_family > ADDRESS_FAMILY_LAST ||
+        !entry_dict->GetInteger(kFlagsKey, &flags) ||
+        !entry_dict->GetString(kExpirationKey, &expiration_string) ||
+        !base::StringToInt64(expiration_string, &expiration) ||
+        !entry_dict->GetList(kAddressesKey, &address_list)) {
+      all_parsed = false;
+      continue;
+    }
+
+    AddressList addresses;
+    bool addresses_parsed = true;
+    for (const auto& address_value : *address_list) {
+      std::string address_string;
+      IPAddress address;
+      if (!address_value->GetAsString(&address_string) ||
+          !address.AssignFromIPLiteral(address_string)) {
+        addresses_parsed = false;
+        break;
+      }
+      addresses.push_back(IPEndPoint(address, 0));
+    }
+    if (!addresses_parsed || addresses.empty()) {
+      all_parsed = false;
+      continue;
+    }
+
+    Key key(hostname, static_cast<AddressFamily>(address_family), flags);
+    // Entries resolved since the cache was written are more recent.
+    if (entries_.count(key) > 0)
+      continue;
+
+    // An entry that has expired since is restored as stale by TTL. It is
+    // still considered to be from the current network.
+    base::TimeDelta ttl = base::Time::FromInternalValue(expiration) - now;
+    entries_.insert(std::make_pair(
+        key, Entry(Entry(OK, addresses), now_ticks, ttl, network_changes_)));
+  }
+  return all_parsed;
 }
 
 size_t HostCache::size() const {
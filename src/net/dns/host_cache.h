@@ -22,6 +22,10 @@
 #include "net/base/net_export.h"
 #include "net/dns/dns_util.h"
 
+namespace base {
+class ListValue;
+}
+
 namespace net {
 
 // Cache used by HostResolver to map hostnames to their resolved result.
@@ -112,6 +116,17 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
     int stale_hits_;
   };
 
+  // Gets notified of changes to the cache, so that it can be persisted.
+  class PersistenceDelegate {
+   public:
+    // Called when the cache changed. Meant to write it out after a delay, so
+    // that nearby changes are written together.
+    virtual void ScheduleWrite() = 0;
+
+   protected:
+    virtual ~PersistenceDelegate() {}
+  };
+
   using EntryMap = std::map<Key, Entry>;
 
   // Constructs a HostCache that stores up to |max_entries|.
@@ -141,6 +156,22 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // Marks all entries as stale on account of a network change.
   void OnNetworkChange();
 
+  // Notifies |delegate| of the changes made through Set() and clear() from
+  // now on. |delegate| may be nullptr, and must outlive the cache or be reset.
+  void set_persistence_delegate(PersistenceDelegate* delegate) {
+    delegate_ = delegate;
+  }
+
+  // Appends the successful entries to |entry_list|, with their expiration as
+  // wall-clock times so that they can be restored after a restart.
+  void GetAsListValue(base::ListValue* entry_list) const;
+
+  // Adds the entries of |entry_list|, as written by GetAsListValue(), that
+  // aren't in the cache yet, up to max_entries(). Entries whose expiration
+  // has passed are restored as stale, see LookupStale(). Returns false if some
+  // entries couldn't be parsed.
+  bool RestoreFromListValue(const base::ListValue& entry_list);
+
   // Empties the cache
   void clear();
 
@@ -186,6 +217,7 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   EntryMap entries_;
   size_t max_entries_;
   int network_changes_;
+  PersistenceDelegate* delegate_;
 
   DISALLOW_COPY_AND_ASSIGN(HostCache);
 };
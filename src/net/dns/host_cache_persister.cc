@@ -0,0 +1,85 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task_runner_util.h"
+#include "base/values.h"
+
+namespace net {
+
+namespace {
+
+const char kFileName[] = "HostCache";
+
+std::string LoadState(const base::FilePath& path) {
+  std::string result;
+  if (!base::ReadFileToString(path, &result)) {
+    return "";
+  }
+  return result;
+}
+
+}  // namespace
+
+HostCachePersister::HostCachePersister(
+    HostCache* cache,
+    const base::FilePath& profile_path,
+    const scoped_refptr<base::SequencedTaskRunner>& background_runner)
+    : cache_(cache),
+      writer_(profile_path.AppendASCII(kFileName), background_runner),
+      weak_ptr_factory_(this) {
+  DCHECK(cache_);
+  cache_->set_persistence_delegate(this);
+  base::PostTaskAndReplyWithResult(
+      background_runner.get(), FROM_HERE,
+      base::Bind(&LoadState, writer_.path()),
+      base::Bind(&HostCachePersister::CompleteLoad,
+                 weak_ptr_factory_.GetWeakPtr()));
+}
+
+HostCachePersister::~HostCachePersister() {
+  DCHECK(CalledOnValidThread());
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+  cache_->set_persistence_delegate(nullptr);
+}
+
+void HostCachePersister::ScheduleWrite() {
+  DCHECK(CalledOnValidThread());
+  writer_.ScheduleWrite(this);
+}
+
+bool HostCachePersister::SerializeData(std::string* data) {
+  DCHECK(CalledOnValidThread());
+  base::ListValue entries;
+  cache_->GetAsListValue(&entries);
+  return base::JSONWriter::Write(entries, data);
+}
+
+void HostCachePersister::CompleteLoad(const std::string& serialized) {
+  DCHECK(CalledOnValidThread());
+  if (serialized.empty())
+    return;
+
+  std::unique_ptr<base::Value> value = base::JSONReader::Read(serialized);
+  base::ListValue* entries = nullptr;
+  if (!value || !value->GetAsList(&entries)) {
+    LOG(ERROR) << "Failed to deserialize the host cache";
+    return;
+  }
+  if (!cache_->RestoreFromListValue(*entries))
+    LOG(ERROR) << "Failed to restore some host cache entries";
+}
+
+}  // namespace net
@@ -0,0 +1,67 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DNS_HOST_CACHE_PERSISTER_H_
+#define NET_DNS_HOST_CACHE_PERSISTER_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/non_thread_safe.h"
+#include "net/base/net_export.h"
+#include "net/dns/host_cache.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace net {
+
+// Stores the entries of a HostCache in a JSON file, so that hostnames resolved
+// before a restart can be served from the cache, possibly as stale, without
+// waiting for DNS.
+//
+// The file is loaded on |background_runner| at construction, and its entries
+// are added to the cache once it is. Changes to the cache are written to the
+// file on |background_runner| after a short delay.
+//
+// Must be created, used and destroyed on the thread of the cache.
+class NET_EXPORT HostCachePersister
+    : public HostCache::PersistenceDelegate,
+      public base::ImportantFileWriter::DataSerializer,
+      NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  // The entries are stored in a file named "HostCache" in |profile_path|.
+  // |cache| must outlive the persister.
+  HostCachePersister(
+      HostCache* cache,
+      const base::FilePath& profile_path,
+      const scoped_refptr<base::SequencedTaskRunner>& background_runner);
+  ~HostCachePersister() override;
+
+  // HostCache::PersistenceDelegate:
+  void ScheduleWrite() override;
+
+  // ImportantFileWriter::DataSerializer:
+  bool SerializeData(std::string* data) override;
+
+ private:
+  void CompleteLoad(const std::string& serialized);
+
+  HostCache* cache_;
+
+  base::ImportantFileWriter writer_;
+
+  base::WeakPtrFactory<HostCachePersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostCachePersister);
+};
+
+}  // namespace net
+
+#endif  // NET_DNS_HOST_CACHE_PERSISTER_H_
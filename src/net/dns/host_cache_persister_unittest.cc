@@ -0,0 +1,92 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include <memory>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "net/base/address_list.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const size_t kMaxCacheEntries = 10;
+
+HostCache::Key Key(const std::string& hostname) {
+  return HostCache::Key(hostname, ADDRESS_FAMILY_UNSPECIFIED, 0);
+}
+
+class HostCachePersisterTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+ protected:
+  std::unique_ptr<HostCachePersister> CreatePersister(HostCache* cache) {
+    return std::unique_ptr<HostCachePersister>(new HostCachePersister(
+        cache, temp_dir_.path(), message_loop_.task_runner()));
+  }
+
+  base::MessageLoopForIO message_loop_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(HostCachePersisterTest, NoFile) {
+  HostCache cache(kMaxCacheEntries);
+  std::unique_ptr<HostCachePersister> persister = CreatePersister(&cache);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(HostCachePersisterTest, PersistAcrossRestarts) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(60);
+  IPAddress address(1, 2, 3, 4);
+
+  {
+    HostCache cache(kMaxCacheEntries);
+    std::unique_ptr<HostCachePersister> persister = CreatePersister(&cache);
+    base::RunLoop().RunUntilIdle();
+    cache.Set(Key("foobar.com"),
+              HostCache::Entry(OK, AddressList(IPEndPoint(address, 0))),
+              base::TimeTicks::Now(), kTTL);
+    // Destroying the persister writes the changes.
+    persister.reset();
+    base::RunLoop().RunUntilIdle();
+  }
+
+  HostCache cache(kMaxCacheEntries);
+  std::unique_ptr<HostCachePersister> persister = CreatePersister(&cache);
+  EXPECT_EQ(0u, cache.size());
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(1u, cache.size());
+  const HostCache::Entry* entry =
+      cache.Lookup(Key("foobar.com"), base::TimeTicks::Now());
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(IPEndPoint(address, 0), entry->addresses().front());
+}
+
+TEST_F(HostCachePersisterTest, CorruptedFile) {
+  const char kCorrupted[] = "[{\"hostname\": \"foobar.com\",";
+  base::FilePath path = temp_dir_.path().AppendASCII("HostCache");
+  ASSERT_EQ(static_cast<int>(sizeof(kCorrupted) - 1),
+            base::WriteFile(path, kCorrupted, sizeof(kCorrupted) - 1));
+
+  HostCache cache(kMaxCacheEntries);
+  std::unique_ptr<HostCachePersister> persister = CreatePersister(&cache);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0u, cache.size());
+}
+
+}  // namespace
+
+}  // namespace net
@@ -8,6 +8,9 @@
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/values.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -22,6 +25,25 @@ HostCache::Key Key(const std::string& hostname) {
   return HostCache::Key(hostname, ADDRESS_FAMILY_UNSPECIFIED, 0);
 }
 
+// Returns an AddressList holding |ip_literal| with port 0.
+AddressList MakeAddressList(const std::string& ip_literal) {
+  IPAddress address;
+  EXPECT_TRUE(address.AssignFromIPLiteral(ip_literal));
+  return AddressList(IPEndPoint(address, 0));
+}
+
+class CountingPersistenceDelegate : public HostCache::PersistenceDelegate {
+ public:
+  CountingPersistenceDelegate() : num_writes_(0) {}
+
+  void ScheduleWrite() override { ++num_writes_; }
+
+  int num_writes() const { return num_writes_; }
+
+ private:
+  int num_writes_;
+};
+
 }  // namespace
 
 TEST(HostCacheTest, Basic) {
@@ -395,6 +417,120 @@ TEST(HostCacheTest, Stale) {
   EXPECT_EQ(3, stale.stale_hits);
 }
 
+// Successful entries should survive serialization, keeping their expiration.
+TEST(HostCacheTest, SerializeAndRestore) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(60);
+  base::TimeTicks now = base::TimeTicks::Now();
+
+  HostCache cache(kMaxCacheEntries);
+  HostCache::Key key1 = Key("foobar.com");
+  HostCache::Key key2("foobar2.com", ADDRESS_FAMILY_IPV6,
+                      HOST_RESOLVER_CANONNAME);
+  HostCache::Key key3 = Key("negative.com");
+  cache.Set(key1, HostCache::Entry(OK, MakeAddressList("1.2.3.4")), now, kTTL);
+  cache.Set(key2, HostCache::Entry(OK, MakeAddressList("::1")), now, kTTL);
+  cache.Set(key3, HostCache::Entry(ERR_NAME_NOT_RESOLVED, AddressList()), now,
+            kTTL);
+
+  base::ListValue serialized;
+  cache.GetAsListValue(&serialized);
+  // Negative entries aren't persisted.
+  EXPECT_EQ(2u, serialized.GetSize());
+
+  HostCache restored_cache(kMaxCacheEntries);
+  EXPECT_TRUE(restored_cache.RestoreFromListValue(serialized));
+  EXPECT_EQ(2u, restored_cache.size());
+
+  const HostCache::Entry* entry1 = restored_cache.Lookup(key1, now);
+  ASSERT_TRUE(entry1);
+  EXPECT_EQ(OK, entry1->error());
+  EXPECT_EQ(MakeAddressList("1.2.3.4").front(), entry1->addresses().front());
+  const HostCache::Entry* entry2 = restored_cache.Lookup(key2, now);
+  ASSERT_TRUE(entry2);
+  EXPECT_EQ(MakeAddressList("::1").front(), entry2->addresses().front());
+  EXPECT_FALSE(restored_cache.Lookup(key3, now));
+
+  // The entries expire when they would have in |cache|, give or take the time
+  // elapsed since |now|.
+  HostCache::EntryStaleness stale;
+  EXPECT_TRUE(restored_cache.LookupStale(key1, now + kTTL * 2, &stale));
+  EXPECT_TRUE(stale.is_stale());
+  EXPECT_EQ(0, stale.network_changes);
+  EXPECT_TRUE(restored_cache.Lookup(key1, now + kTTL / 2));
+}
+
+// Restored entries are stale if they have expired, and don't replace newer
+// ones.
+TEST(HostCacheTest, RestoreExpiredAndExistingEntries) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  base::TimeTicks now = base::TimeTicks::Now();
+
+  HostCache cache(kMaxCacheEntries);
+  HostCache::Key key1 = Key("foobar.com");
+  HostCache::Key key2 = Key("foobar2.com");
+  // Expired 50 seconds ago.
+  cache.Set(key1, HostCache::Entry(OK, MakeAddressList("1.2.3.4")),
+            now - base::TimeDelta::FromSeconds(60), kTTL);
+  cache.Set(key2, HostCache::Entry(OK, MakeAddressList("1.2.3.4")), now, kTTL);
+  base::ListValue serialized;
+  cache.GetAsListValue(&serialized);
+
+  HostCache restored_cache(kMaxCacheEntries);
+  restored_cache.Set(key2, HostCache::Entry(OK, MakeAddressList("5.6.7.8")),
+                     now, kTTL);
+  EXPECT_TRUE(restored_cache.RestoreFromListValue(serialized));
+  EXPECT_EQ(2u, restored_cache.size());
+
+  HostCache::EntryStaleness stale;
+  EXPECT_FALSE(restored_cache.Lookup(key1, now));
+  ASSERT_TRUE(restored_cache.LookupStale(key1, now, &stale));
+  EXPECT_TRUE(stale.is_stale());
+  EXPECT_EQ(0, stale.network_changes);
+
+  const HostCache::Entry* entry2 = restored_cache.Lookup(key2, now);
+  ASSERT_TRUE(entry2);
+  EXPECT_EQ(MakeAddressList("5.6.7.8").front(), entry2->addresses().front());
+}
+
+TEST(HostCacheTest, RestoreMalformedEntries) {
+  base::ListValue serialized;
+  serialized.AppendString("not a dictionary");
+  std::unique_ptr<base::DictionaryValue> bad_address(
+      new base::DictionaryValue());
+  bad_address->SetString("hostname", "foobar.com");
+  bad_address->SetInteger("address_family", ADDRESS_FAMILY_UNSPECIFIED);
+  bad_address->SetInteger("flags", 0);
+  bad_address->SetString("expiration", "0");
+  std::unique_ptr<base::ListValue> addresses(new base::ListValue());
+  addresses->AppendString("not an address");
+  bad_address->Set("addresses", std::move(addresses));
+  serialized.Append(std::move(bad_address));
+
+  HostCache cache(kMaxCacheEntries);
+  EXPECT_FALSE(cache.RestoreFromListValue(serialized));
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST(HostCacheTest, PersistenceDelegate) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  base::TimeTicks now;
+
+  HostCache cache(kMaxCacheEntries);
+  CountingPersistenceDelegate delegate;
+  cache.set_persistence_delegate(&delegate);
+
+  cache.Set(Key("foobar.com"), HostCache::Entry(OK, AddressList()), now, kTTL);
+  EXPECT_EQ(1, delegate.num_writes());
+  cache.Lookup(Key("foobar.com"), now);
+  EXPECT_EQ(1, delegate.num_writes());
+  cache.clear();
+  EXPECT_EQ(2, delegate.num_writes());
+
+  cache.set_persistence_delegate(nullptr);
+  cache.Set(Key("foobar.com"), HostCache::Entry(OK, AddressList()), now, kTTL);
+  EXPECT_EQ(2, delegate.num_writes());
+}
+
 // Tests the less than and equal operators for HostCache::Key work.
 TEST(HostCacheTest, KeyComparators) {
   struct {
@@ -49,6 +49,10 @@ class NET_EXPORT HostResolver {
   // resolution. Pass HostResolver::kDefaultRetryAttempts to choose a default
   // value.
   // |enable_caching| controls whether a HostCache is used.
+  // |max_stale_age|, if positive, lets Resolve() return a successful cache
+  // entry that expired at most that long ago, while the entry is refreshed in
+  // the background. Entries cached before a network change are never served
+  // this way.
   struct NET_EXPORT Options {
     Options();
 
@@ -57,6 +61,7 @@ class NET_EXPORT HostResolver {
     size_t max_concurrent_resolves;
     size_t max_retry_attempts;
     bool enable_caching;
+    base::TimeDelta max_stale_age;
   };
 
   // The parameters for doing a Resolve(). A hostname and port are
@@ -1289,6 +1289,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
         worker_task_runner_(std::move(worker_task_runner)),
         had_non_speculative_request_(false),
         had_dns_config_(false),
+        is_stale_refresh_(false),
         num_occupied_job_slots_(0),
         dns_task_error_(OK),
         creation_time_(base::TimeTicks::Now()),
@@ -1406,7 +1407,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
                                  req->source_net_log().source(),
                                  priority()));
 
-    if (num_active_requests() > 0) {
+    if (num_active_requests() > 0 || is_stale_refresh_) {
       UpdatePriority();
     } else {
       // If we were called from a Request's callback within CompleteRequests,
@@ -1449,7 +1450,9 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
   // Attempts to serve the job from HOSTS. Returns true if succeeded and
   // this Job was destroyed.
   bool ServeFromHosts() {
-    DCHECK_GT(num_active_requests(), 0u);
+    DCHECK(num_active_requests() > 0 || is_stale_refresh_);
+    if (requests_.empty())
+      return false;
     AddressList addr_list;
     if (resolver_->ServeFromHosts(key(),
                                   requests_.front()->info(),
@@ -1463,6 +1466,10 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     return false;
   }
 
+  // Makes this Job run to completion and cache its result even when it has no
+  // active requests, to refresh a stale cache entry that was served.
+  void set_is_stale_refresh() { is_stale_refresh_ = true; }
+
   const Key& key() const { return key_; }
 
   bool is_queued() const {
@@ -1752,7 +1759,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
       handle_.Reset();
     }
 
-    if (num_active_requests() == 0) {
+    if (num_active_requests() == 0 && !is_stale_refresh_) {
       net_log_.AddEvent(NetLog::TYPE_CANCELLED);
       net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB,
                                         OK);
@@ -1762,7 +1769,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB,
                                       entry.error());
 
-    DCHECK(!requests_.empty());
+    DCHECK(!requests_.empty() || is_stale_refresh_);
 
     if (entry.error() == OK) {
       // Record this histogram here, when we know the system has a valid DNS
@@ -1773,7 +1780,10 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
 
     bool did_complete = (entry.error() != ERR_NETWORK_CHANGED) &&
                         (entry.error() != ERR_HOST_RESOLVER_QUEUE_TOO_LARGE);
-    if (did_complete)
+    // A failed refresh keeps the stale entry, which may still be served until
+    // it is too old.
+    bool keep_stale_entry = is_stale_refresh_ && entry.error() != OK;
+    if (did_complete && !keep_stale_entry)
       resolver_->CacheResult(key_, entry, ttl);
 
     // Complete all of the requests that were attached to the job.
@@ -1832,6 +1842,9 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
   // Distinguishes measurements taken while DnsClient was fully configured.
   bool had_dns_config_;
 
+  // See set_is_stale_refresh().
+  bool is_stale_refresh_;
+
   // Number of slots occupied by this Job in resolver's PrioritizedDispatcher.
   unsigned num_occupied_job_slots_;
 
@@ -1929,6 +1942,10 @@ int HostResolverImpl::Resolve(const RequestInfo& info,
 
   int rv = ResolveHelper(key, info, ip_address_ptr, addresses, false, nullptr,
                          source_net_log);
+  if (rv == ERR_DNS_CACHE_MISS &&
+      ServeStaleAndRefresh(key, info, priority, addresses, source_net_log)) {
+    rv = OK;
+  }
   if (rv != ERR_DNS_CACHE_MISS) {
     LogFinishRequest(source_net_log, info, rv);
     RecordTotalTime(HaveDnsConfig(), info.is_speculative(), base::TimeDelta());
@@ -1941,22 +1958,12 @@ int HostResolverImpl::Resolve(const RequestInfo& info,
   JobMap::iterator jobit = jobs_.find(key);
   Job* job;
   if (jobit == jobs_.end()) {
-    job = new Job(weak_ptr_factory_.GetWeakPtr(), key, priority,
-                  worker_task_runner_, source_net_log);
-    job->Schedule(false);
-
-    // Check for queue overflow.
-    if (dispatcher_->num_queued_jobs() > max_queued_jobs_) {
-      Job* evicted = static_cast<Job*>(dispatcher_->EvictOldestLowest());
-      DCHECK(evicted);
-      evicted->OnEvicted();  // Deletes |evicted|.
-      if (evicted == job) {
-        rv = ERR_HOST_RESOLVER_QUEUE_TOO_LARGE;
-        LogFinishRequest(source_net_log, info, rv);
-        return rv;
-      }
+    job = CreateAndScheduleJob(key, priority, source_net_log);
+    if (!job) {
+      rv = ERR_HOST_RESOLVER_QUEUE_TOO_LARGE;
+      LogFinishRequest(source_net_log, info, rv);
+      return rv;
     }
-    jobs_.insert(jobit, std::make_pair(key, job));
   } else {
     job = jobit->second;
   }
@@ -1986,6 +1993,7 @@ HostResolverImpl::HostResolverImpl(
       resolved_known_ipv6_hostname_(false),
       additional_resolver_flags_(0),
       fallback_to_proctask_(true),
+      max_stale_age_(options.max_stale_age),
       worker_task_runner_(std::move(worker_task_runner)),
       weak_ptr_factory_(this),
       probe_weak_ptr_factory_(this) {
@@ -2224,6 +2232,60 @@ bool HostResolverImpl::ServeFromCache(const Key& key,
   return true;
 }
 
+bool HostResolverImpl::ServeStaleAndRefresh(const Key& key,
+                                            const RequestInfo& info,
+                                            RequestPriority priority,
+                                            AddressList* addresses,
+                                            const BoundNetLog& source_net_log) {
+  DCHECK(addresses);
+  if (max_stale_age_ <= base::TimeDelta() || !info.allow_cached_response() ||
+      !cache_.get()) {
+    return false;
+  }
+
+  HostCache::EntryStaleness stale_info;
+  const HostCache::Entry* cache_entry =
+      cache_->LookupStale(key, base::TimeTicks::Now(), &stale_info);
+  // Addresses from before a network change may not be reachable anymore.
+  if (!cache_entry || cache_entry->error() != OK ||
+      stale_info.network_changes > 0 ||
+      stale_info.expired_by > max_stale_age_) {
+    return false;
+  }
+
+  *addresses = EnsurePortOnAddressList(cache_entry->addresses(), info.port());
+  source_net_log.AddEvent(NetLog::TYPE_HOST_RESOLVER_IMPL_CACHE_HIT);
+
+  // Requests that don't accept stale results may already be resolving |key|.
+  if (jobs_.find(key) != jobs_.end())
+    return true;
+  Job* job = CreateAndScheduleJob(key, priority, source_net_log);
+  if (job)
+    job->set_is_stale_refresh();
+  return true;
+}
+
+HostResolverImpl::Job* HostResolverImpl::CreateAndScheduleJob(
+    const Key& key,
+    RequestPriority priority,
+    const BoundNetLog& source_net_log) {
+  DCHECK(jobs_.find(key) == jobs_.end());
+  Job* job = new Job(weak_ptr_factory_.GetWeakPtr(), key, priority,
+                     worker_task_runner_, source_net_log);
+  job->Schedule(false);
+
+  // Check for queue overflow.
+  if (dispatcher_->num_queued_jobs() > max_queued_jobs_) {
+    Job* evicted = static_cast<Job*>(dispatcher_->EvictOldestLowest());
+    DCHECK(evicted);
+    evicted->OnEvicted();  // Deletes |evicted|.
+    if (evicted == job)
+      return nullptr;
+  }
+  jobs_.insert(std::make_pair(key, job));
+  return job;
+}
+
 bool HostResolverImpl::ServeFromHosts(const Key& key,
                                       const RequestInfo& info,
                                       AddressList* addresses) {
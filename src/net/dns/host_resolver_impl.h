@@ -229,6 +229,23 @@ class NET_EXPORT HostResolverImpl
                       bool allow_stale,
                       HostCache::EntryStaleness* stale_info);
 
+  // If stale results are enabled and the cache has a successful entry for
+  // |key| that is stale by at most |max_stale_age_|, fills |addresses| with it
+  // and returns true. Also starts a Job to refresh the entry if |key| isn't
+  // being resolved already.
+  bool ServeStaleAndRefresh(const Key& key,
+                            const RequestInfo& info,
+                            RequestPriority priority,
+                            AddressList* addresses,
+                            const BoundNetLog& source_net_log);
+
+  // Creates a Job for |key|, which must not have one, schedules it and adds it
+  // to |jobs_|. Returns nullptr if the queue of the dispatcher overflowed and
+  // the new Job was evicted.
+  Job* CreateAndScheduleJob(const Key& key,
+                            RequestPriority priority,
+                            const BoundNetLog& source_net_log);
+
   // If we have a DnsClient with a valid DnsConfig, and |key| is found in the
   // HOSTS file, returns true and fills |addresses|. Otherwise returns false.
   bool ServeFromHosts(const Key& key,
@@ -348,6 +365,10 @@ class NET_EXPORT HostResolverImpl
   // Allow fallback to ProcTask if DnsTask fails.
   bool fallback_to_proctask_;
 
+  // How long after their expiration successful cache entries may be served
+  // while they are refreshed. Zero if stale entries aren't served.
+  const base::TimeDelta max_stale_age_;
+
   // Task runner used for DNS lookups using the platform resolver, and other
   // blocking operations. Usually just the WorkerPool's task runner for slow
   // tasks, but can be overridden for tests.
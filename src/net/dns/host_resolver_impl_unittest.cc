@@ -619,6 +619,17 @@ class HostResolverImplTest : public testing::Test {
     resolver_->GetHostCache()->OnNetworkChange();
   }
 
+  // Makes every cache entry expire |expired_by| ago.
+  void ExpireCacheEntries(base::TimeDelta expired_by) {
+    DCHECK(resolver_.get());
+    HostCache* cache = resolver_->GetHostCache();
+    HostCache::EntryMap entries = cache->entries();
+    const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(1);
+    base::TimeTicks set_time = base::TimeTicks::Now() - expired_by - kTTL;
+    for (const auto& it : entries)
+      cache->Set(it.first, it.second, set_time, kTTL);
+  }
+
   scoped_refptr<MockHostResolverProc> proc_;
   std::unique_ptr<HostResolverImpl> resolver_;
   std::vector<std::unique_ptr<Request>> requests_;
@@ -846,7 +857,6 @@ TEST_F(HostResolverImplTest, CancelMultipleRequests) {
 
   // Cancel everything except request for ("a", 82).
   requests_[0]->Cancel();
-  requests_[1]->Cancel();
   requests_[2]->Cancel();
   requests_[4]->Cancel();
 
@@ -1265,7 +1275,6 @@ TEST_F(HostResolverImplTest, CancelPendingRequest) {
   }
 
   // Cancel some requests
-  requests_[1]->Cancel();
   requests_[4]->Cancel();
   requests_[5]->Cancel();
 
@@ -1425,6 +1434,85 @@ TEST_F(HostResolverImplTest, ResolveStaleFromCache) {
   EXPECT_TRUE(requests_[5]->staleness().is_stale());
 }
 
+// Test that Resolve() returns expired cache entries while a Job refreshes
+// them, unless they are too stale or from before a network change.
+TEST_F(HostResolverImplTest, ServeStaleWhileRefreshing) {
+  HostResolverImpl::Options options = DefaultOptions();
+  options.max_stale_age = base::TimeDelta::FromMinutes(10);
+  resolver_.reset(new TestHostResolverImpl(options, NULL));
+  resolver_->set_proc_params_for_test(DefaultParams(proc_.get()));
+
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("just.testing", 80)->Resolve());
+  EXPECT_EQ(OK, requests_[0]->WaitForResult());
+
+  ExpireCacheEntries(base::TimeDelta::FromMinutes(1));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.43");
+
+  // The stale entry is returned right away, and a Job refreshes it.
+  EXPECT_EQ(OK, CreateRequest("just.testing", 80)->Resolve());
+  EXPECT_TRUE(requests_[1]->HasOneAddress("192.168.1.42", 80));
+  EXPECT_TRUE(proc_->WaitFor(1u));
+
+  // A request that doesn't accept cached results joins the refresh.
+  HostResolver::RequestInfo info(HostPortPair("just.testing", 80));
+  info.set_allow_cached_response(false);
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest(info, MEDIUM)->Resolve());
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(OK, requests_[2]->WaitForResult());
+  EXPECT_TRUE(requests_[2]->HasOneAddress("192.168.1.43", 80));
+  EXPECT_EQ(2u, proc_->GetCaptureList().size());
+
+  // The refreshed entry is cached.
+  EXPECT_EQ(OK, CreateRequest("just.testing", 80)->ResolveFromCache());
+  EXPECT_TRUE(requests_[3]->HasOneAddress("192.168.1.43", 80));
+
+  // Entries that are too stale are resolved again before returning.
+  ExpireCacheEntries(base::TimeDelta::FromMinutes(11));
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("just.testing", 80)->Resolve());
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(OK, requests_[4]->WaitForResult());
+
+  // So are stale entries from before a network change.
+  ExpireCacheEntries(base::TimeDelta::FromMinutes(1));
+  MakeCacheStale();
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("just.testing", 80)->Resolve());
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(OK, requests_[5]->WaitForResult());
+}
+
+// Test that a refresh Job keeps running after its stale entry was served, and
+// that a failed refresh keeps the stale entry.
+TEST_F(HostResolverImplTest, FailedStaleRefreshKeepsEntry) {
+  HostResolverImpl::Options options = DefaultOptions();
+  options.max_stale_age = base::TimeDelta::FromMinutes(10);
+  resolver_.reset(new TestHostResolverImpl(options, NULL));
+  resolver_->set_proc_params_for_test(DefaultParams(proc_.get()));
+
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("just.testing", 80)->Resolve());
+  EXPECT_EQ(OK, requests_[0]->WaitForResult());
+
+  ExpireCacheEntries(base::TimeDelta::FromMinutes(1));
+  proc_->AddRuleForAllFamilies("just.testing", "");
+
+  EXPECT_EQ(OK, CreateRequest("just.testing", 80)->Resolve());
+  EXPECT_TRUE(requests_[1]->HasOneAddress("192.168.1.42", 80));
+
+  // Wait for the refresh to fail through a request attached to it.
+  HostResolver::RequestInfo info(HostPortPair("just.testing", 80));
+  info.set_allow_cached_response(false);
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest(info, MEDIUM)->Resolve());
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(ERR_NAME_NOT_RESOLVED, requests_[2]->WaitForResult());
+
+  EXPECT_EQ(OK, CreateRequest("just.testing", 80)->Resolve());
+  EXPECT_TRUE(requests_[3]->HasOneAddress("192.168.1.42", 80));
+  proc_->SignalMultiple(1u);
+}
+
 // Test the retry attempts simulating host resolver proc that takes too long.
 TEST_F(HostResolverImplTest, MultipleAttempts) {
   // Total number of attempts would be 3 and we want the 3rd attempt to resolve
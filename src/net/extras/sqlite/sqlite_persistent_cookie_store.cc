@@ -77,7 +77,8 @@ namespace net {
 // Subsequent to loading, mutations may be queued by any thread using
 // AddCookie, UpdateCookieAccessTime, and DeleteCookie. These are flushed to
 // disk on the BG runner every 30 seconds, 512 operations, or call to Flush(),
-// whichever occurs first.
+// whichever occurs first. Access time updates of a cookie that already has one
+// queued replace the queued one instead of adding an operation.
 class SQLitePersistentCookieStore::Backend
     : public base::RefCountedThreadSafe<SQLitePersistentCookieStore::Backend> {
  public:
@@ -138,6 +139,7 @@ class SQLitePersistentCookieStore::Backend
     DCHECK(!db_.get()) << "Close should have already been called.";
     DCHECK_EQ(0u, num_pending_);
     DCHECK(pending_.empty());
+    DCHECK(pending_access_updates_.empty());
 
     for (CanonicalCookie* cookie : cookies_) {
       delete cookie;
@@ -161,6 +163,10 @@ class SQLitePersistentCookieStore::Backend
     OperationType op() const { return op_; }
     const CanonicalCookie& cc() const { return cc_; }
 
+    void set_last_access_date(const base::Time& date) {
+      cc_.SetLastAccessDate(date);
+    }
+
    private:
     OperationType op_;
     CanonicalCookie cc_;
@@ -248,7 +254,10 @@ class SQLitePersistentCookieStore::Backend
   typedef std::list<PendingOperation*> PendingOperationsList;
   PendingOperationsList pending_;
   PendingOperationsList::size_type num_pending_;
-  // Guard |cookies_|, |pending_|, |num_pending_|.
+  // The COOKIE_UPDATEACCESS operations of |pending_| by the creation time of
+  // their cookie, for those that no later operation on the cookie follows.
+  std::map<int64_t, PendingOperation*> pending_access_updates_;
+  // Guard |cookies_|, |pending_|, |num_pending_|, |pending_access_updates_|.
   base::Lock lock_;
 
   // Temporary buffer for cookies loaded from DB. Accumulates cookies to reduce
@@ -651,6 +660,9 @@ bool SQLitePersistentCookieStore::Backend::InitializeDatabase() {
 
   db_.reset(new sql::Connection);
   db_->set_histogram_tag("Cookie");
+  // Batched commits then cost an append to the log rather than a journal
+  // and database sync each.
+  db_->set_wal_mode();
 
   // Unretained to avoid a ref loop with |db_|.
   db_->set_error_callback(
@@ -1081,9 +1093,23 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
   // We do a full copy of the cookie here, and hopefully just here.
   std::unique_ptr<PendingOperation> po(new PendingOperation(op, cc));
 
+  const int64_t creation_date = cc.CreationDate().ToInternalValue();
   PendingOperationsList::size_type num_pending;
   {
     base::AutoLock locked(lock_);
+    if (op == PendingOperation::COOKIE_UPDATEACCESS) {
+      // Coalesce with the queued access time update of the cookie, if any, so
+      // that the commit writes the row once.
+      auto it = pending_access_updates_.find(creation_date);
+      if (it != pending_access_updates_.end()) {
+        it->second->set_last_access_date(cc.LastAccessDate());
+        return;
+      }
+      pending_access_updates_[creation_date] = po.get();
+    } else {
+      // Updates queued before an add or delete must not absorb later ones.
+      pending_access_updates_.erase(creation_date);
+    }
     pending_.push_back(po.release());
     num_pending = ++num_pending_;
   }
@@ -1108,6 +1134,7 @@ void SQLitePersistentCookieStore::Backend::Commit() {
   {
     base::AutoLock locked(lock_);
     pending_.swap(ops);
+    pending_access_updates_.clear();
     num_pending_ = 0;
   }
 
@@ -284,6 +284,47 @@ TEST_F(SQLitePersistentCookieStoreTest, TestPersistance) {
   ASSERT_EQ(0U, cookies.size());
 }
 
+// Test that repeated access time updates of a cookie are coalesced into the
+// latest one, without merging updates across other operations on the cookie.
+TEST_F(SQLitePersistentCookieStoreTest, CoalesceAccessTimeUpdates) {
+  InitializeStore(false, false);
+  const base::Time creation = base::Time::Now() - base::TimeDelta::FromDays(1);
+  std::unique_ptr<CanonicalCookie> cookie(CanonicalCookie::Create(
+      "A", "B", "foo.bar", "/", creation,
+      creation + base::TimeDelta::FromDays(10), creation, false, false,
+      CookieSameSite::DEFAULT_MODE, COOKIE_PRIORITY_DEFAULT));
+  store_->AddCookie(*cookie);
+  for (int i = 1; i <= 3; ++i) {
+    cookie->SetLastAccessDate(creation + base::TimeDelta::FromMinutes(i));
+    store_->UpdateCookieAccessTime(*cookie);
+  }
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ(creation + base::TimeDelta::FromMinutes(3),
+            cookies[0]->LastAccessDate());
+
+  // An update queued after the cookie is deleted and added back must not be
+  // merged into the one queued before.
+  cookie->SetLastAccessDate(creation + base::TimeDelta::FromMinutes(4));
+  store_->UpdateCookieAccessTime(*cookie);
+  store_->DeleteCookie(*cookie);
+  cookie->SetLastAccessDate(creation);
+  store_->AddCookie(*cookie);
+  cookie->SetLastAccessDate(creation + base::TimeDelta::FromMinutes(5));
+  store_->UpdateCookieAccessTime(*cookie);
+  DestroyStore();
+  STLDeleteElements(&cookies);
+
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ(creation + base::TimeDelta::FromMinutes(5),
+            cookies[0]->LastAccessDate());
+  STLDeleteElements(&cookies);
+}
+
 TEST_F(SQLitePersistentCookieStoreTest, TestSessionCookiesDeletedOnStartup) {
   // Initialize the cookie store with 3 persistent cookies, 5 transient
   // cookies.
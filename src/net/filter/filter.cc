@@ -23,7 +23,12 @@
 
 #include "net/filter/filter.h"
 
+#include <utility>
+
 #include "base/files/file_path.h"
+#include "base/lazy_instance.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
 #include "base/strings/string_util.h"
 #include "base/values.h"
 #include "net/base/io_buffer.h"
@@ -54,6 +59,48 @@ const char kTextHtml[]             = "text/html";
 // Buffer size allocated when de-compressing data.
 const int kFilterBufSize = 32 * 1024;
 
+// The number of idle filter buffers kept for reuse.
+const size_t kMaxPooledFilterBuffers = 8;
+
+// Keeps the kFilterBufSize input buffers of destroyed filters, so that the
+// filters of later responses reuse them instead of allocating new ones.
+class FilterBufferPool {
+ public:
+  FilterBufferPool() {}
+
+  // Returns an idle buffer, or a new one if there's none.
+  scoped_refptr<IOBuffer> Take() {
+    {
+      base::AutoLock lock(lock_);
+      if (!buffers_.empty()) {
+        scoped_refptr<IOBuffer> buffer = std::move(buffers_.back());
+        buffers_.pop_back();
+        return buffer;
+      }
+    }
+    return new IOBuffer(kFilterBufSize);
+  }
+
+  // Keeps |buffer| for reuse, unless there are enough idle buffers already.
+  // |buffer| must not be referenced by anything else, as a read may still be
+  // writing to it otherwise.
+  void Release(scoped_refptr<IOBuffer> buffer) {
+    DCHECK(buffer->HasOneRef());
+    base::AutoLock lock(lock_);
+    if (buffers_.size() < kMaxPooledFilterBuffers)
+      buffers_.push_back(std::move(buffer));
+  }
+
+ private:
+  base::Lock lock_;
+  std::vector<scoped_refptr<IOBuffer>> buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(FilterBufferPool);
+};
+
+base::LazyInstance<FilterBufferPool>::Leaky g_filter_buffer_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
 void LogSdchProblem(const FilterContext& filter_context,
                     SdchProblemCode problem) {
   SdchManager::SdchErrorRecovery(problem);
@@ -89,7 +136,12 @@ std::string FilterTypeAsString(Filter::FilterType type_id) {
 FilterContext::~FilterContext() {
 }
 
-Filter::~Filter() {}
+Filter::~Filter() {
+  if (stream_buffer_ && stream_buffer_size_ == kFilterBufSize &&
+      stream_buffer_->HasOneRef()) {
+    g_filter_buffer_pool.Get().Release(std::move(stream_buffer_));
+  }
+}
 
 // static
 std::unique_ptr<Filter> Filter::Factory(
@@ -436,7 +488,10 @@ std::unique_ptr<Filter> Filter::PrependNewFilter(
 void Filter::InitBuffer(int buffer_size) {
   DCHECK(!stream_buffer());
   DCHECK_GT(buffer_size, 0);
-  stream_buffer_ = new IOBuffer(buffer_size);
+  if (buffer_size == kFilterBufSize)
+    stream_buffer_ = g_filter_buffer_pool.Get().Take();
+  else
+    stream_buffer_ = new IOBuffer(buffer_size);
   stream_buffer_size_ = buffer_size;
 }
 
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "net/base/io_buffer.h"
 #include "net/filter/mock_filter_context.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -210,4 +211,23 @@ TEST(FilterTest, ThreeFilterChain) {
   EXPECT_EQ(compare_array_index, input_array_size);
 }
 
+// The input buffers of destroyed filters are reused, unless something else
+// still refers to them.
+TEST(FilterTest, ReusesStreamBuffers) {
+  std::unique_ptr<Filter> filter = Filter::GZipFactory();
+  ASSERT_TRUE(filter);
+  IOBuffer* stream_buffer = filter->stream_buffer();
+  filter.reset();
+
+  filter = Filter::GZipFactory();
+  ASSERT_TRUE(filter);
+  EXPECT_EQ(stream_buffer, filter->stream_buffer());
+
+  scoped_refptr<IOBuffer> pending_read_buffer = filter->stream_buffer();
+  filter.reset();
+  filter = Filter::GZipFactory();
+  ASSERT_TRUE(filter);
+  EXPECT_NE(pending_read_buffer.get(), filter->stream_buffer());
+}
+
 }  // Namespace net
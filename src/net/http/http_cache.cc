@@ -96,7 +96,9 @@ HttpCache::ActiveEntry::ActiveEntry(disk_cache::Entry* entry)
     : disk_entry(entry),
       writer(NULL),
       will_process_pending_queue(false),
-      doomed(false) {
+      doomed(false),
+      writer_shares_body(false),
+      shared_body_size(0) {
 }
 
 HttpCache::ActiveEntry::~ActiveEntry() {
@@ -305,6 +307,7 @@ HttpCache::HttpCache(std::unique_ptr<HttpTransactionFactory> network_layer,
       building_backend_(false),
       bypass_lock_for_test_(false),
       fail_conditionalization_for_test_(false),
+      shared_body_reading_(false),
       mode_(NORMAL),
       network_layer_(std::move(network_layer)),
       clock_(new base::DefaultClock()),
@@ -798,6 +801,14 @@ int HttpCache::AddTransactionToEntry(ActiveEntry* entry, Transaction* trans) {
   // use (since any existing entry should have already been doomed).
 
   if (entry->writer || entry->will_process_pending_queue) {
+    // While the writer shares the body, transactions which can read it as it
+    // is stored don't have to wait, unless others are already queued.
+    if (entry->writer_shares_body && !entry->will_process_pending_queue &&
+        entry->pending_queue.empty() && trans->CanReadSharedBody()) {
+      trans->StartReadingSharedBody();
+      entry->readers.push_back(trans);
+      return OK;
+    }
     entry->pending_queue.push_back(trans);
     return ERR_IO_PENDING;
   }
@@ -828,16 +839,18 @@ void HttpCache::DoneWithEntry(ActiveEntry* entry, Transaction* trans,
                               bool cancel) {
   // If we already posted a task to move on to the next transaction and this was
   // the writer, there is nothing to cancel.
-  if (entry->will_process_pending_queue && entry->readers.empty())
+  if (entry->will_process_pending_queue && entry->readers.empty() &&
+      entry->writer != trans) {
     return;
+  }
 
-  if (entry->writer) {
-    DCHECK(trans == entry->writer);
-
+  if (entry->writer == trans) {
     // Assume there was a failure.
     bool success = false;
     if (cancel) {
       DCHECK(entry->disk_entry);
+      // The readers of the body won't get the rest of it.
+      StopSharingBody(entry, false);
       // This is a successful operation in the sense that we want to keep the
       // entry.
       success = trans->AddTruncatedFlag();
@@ -852,21 +865,27 @@ void HttpCache::DoneWithEntry(ActiveEntry* entry, Transaction* trans,
 }
 
 void HttpCache::DoneWritingToEntry(ActiveEntry* entry, bool success) {
-  DCHECK(entry->readers.empty());
+  // The readers of a shared body may remain.
+  StopSharingBody(entry, success);
 
   entry->writer = NULL;
 
   if (success) {
     ProcessPendingQueue(entry);
   } else {
-    DCHECK(!entry->will_process_pending_queue);
-
     // We failed to create this entry.
     TransactionList pending_queue;
     pending_queue.swap(entry->pending_queue);
 
-    entry->disk_entry->Doom();
-    DestroyEntry(entry);
+    if (entry->readers.empty() && !entry->will_process_pending_queue) {
+      entry->disk_entry->Doom();
+      DestroyEntry(entry);
+    } else {
+      // The readers of the shared body keep the entry until they are done,
+      // and OnProcessPendingQueue() destroys it if there are none anymore.
+      if (!entry->doomed)
+        DoomActiveEntry(entry->disk_entry->GetKey());
+    }
 
     // We need to do something about these pending entries, which now need to
     // be added to a new entry.
@@ -879,8 +898,7 @@ void HttpCache::DoneWritingToEntry(ActiveEntry* entry, bool success) {
 }
 
 void HttpCache::DoneReadingFromEntry(ActiveEntry* entry, Transaction* trans) {
-  DCHECK(!entry->writer);
-
+  // There is still a writer if |trans| was reading the body it shared.
   TransactionList::iterator it =
       std::find(entry->readers.begin(), entry->readers.end(), trans);
   DCHECK(it != entry->readers.end());
@@ -903,6 +921,32 @@ void HttpCache::ConvertWriterToReader(ActiveEntry* entry) {
   ProcessPendingQueue(entry);
 }
 
+void HttpCache::StartSharingBody(ActiveEntry* entry) {
+  DCHECK(entry->writer);
+  DCHECK(entry->readers.empty());
+  DCHECK(shared_body_reading_);
+
+  entry->writer_shares_body = true;
+  entry->shared_body_size = 0;
+  if (!entry->pending_queue.empty())
+    ProcessPendingQueue(entry);
+}
+
+void HttpCache::OnSharedBodyWritten(ActiveEntry* entry, int64_t body_size) {
+  DCHECK(entry->writer_shares_body);
+  entry->shared_body_size = body_size;
+  for (Transaction* reader : entry->readers)
+    reader->OnSharedBodyWritten(true);
+}
+
+void HttpCache::StopSharingBody(ActiveEntry* entry, bool complete) {
+  if (!entry->writer_shares_body)
+    return;
+  entry->writer_shares_body = false;
+  for (Transaction* reader : entry->readers)
+    reader->OnSharedBodyWritten(complete);
+}
+
 LoadState HttpCache::GetLoadStateForPendingTransaction(
       const Transaction* trans) {
   ActiveEntriesMap::const_iterator i = active_entries_.find(trans->key());
@@ -996,15 +1040,30 @@ void HttpCache::ProcessPendingQueue(ActiveEntry* entry) {
 
 void HttpCache::OnProcessPendingQueue(ActiveEntry* entry) {
   entry->will_process_pending_queue = false;
-  DCHECK(!entry->writer);
 
   // If no one is interested in this entry, then we can deactivate it.
   if (entry->pending_queue.empty()) {
-    if (entry->readers.empty())
+    if (entry->readers.empty() && !entry->writer)
       DestroyEntry(entry);
     return;
   }
 
+  if (entry->writer) {
+    // Only readers of the shared body can be added before the writer is done,
+    // in order.
+    Transaction* next = entry->pending_queue.front();
+    if (!entry->writer_shares_body || !next->CanReadSharedBody())
+      return;
+
+    entry->pending_queue.erase(entry->pending_queue.begin());
+    next->StartReadingSharedBody();
+    entry->readers.push_back(next);
+    if (!entry->pending_queue.empty())
+      ProcessPendingQueue(entry);
+    next->io_callback().Run(OK);
+    return;
+  }
+
   // Promote next transaction from the pending queue.
   Transaction* next = entry->pending_queue.front();
   if ((next->mode() & Transaction::WRITE) && !entry->readers.empty())
@@ -14,6 +14,8 @@
 #ifndef NET_HTTP_HTTP_CACHE_H_
 #define NET_HTTP_HTTP_CACHE_H_
 
+#include <stdint.h>
+
 #include <list>
 #include <memory>
 #include <set>
@@ -179,6 +181,14 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   void set_mode(Mode value) { mode_ = value; }
   Mode mode() { return mode_; }
 
+  // When enabled, transactions waiting for the writer of an entry can read the
+  // response body while the writer is still storing it, instead of waiting for
+  // the whole response to be stored. Only the bodies of complete 200 responses
+  // to GET requests are shared, with requests which don't need to validate
+  // them.
+  void set_shared_body_reading(bool enabled) { shared_body_reading_ = enabled; }
+  bool shared_body_reading() const { return shared_body_reading_; }
+
   // Get/Set the cache's clock. These are public only for testing.
   void SetClockForTesting(std::unique_ptr<base::Clock> clock) {
     clock_.reset(clock.release());
@@ -259,6 +269,11 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
     TransactionList    pending_queue;
     bool               will_process_pending_queue;
     bool               doomed;
+
+    // True while |writer| lets |readers| read the response body it stores.
+    bool               writer_shares_body;
+    // The size of the response body stored by |writer| so far.
+    int64_t            shared_body_size;
   };
 
   using ActiveEntriesMap = std::unordered_map<std::string, ActiveEntry*>;
@@ -361,6 +376,19 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   // transactions can start reading from this entry.
   void ConvertWriterToReader(ActiveEntry* entry);
 
+  // Called by the writer of |entry| once it is about to store the response
+  // body, to let the pending transactions which can read it as it is stored
+  // become readers.
+  void StartSharingBody(ActiveEntry* entry);
+
+  // Called by the writer of |entry| when the stored response body has grown
+  // to |body_size|.
+  void OnSharedBodyWritten(ActiveEntry* entry, int64_t body_size);
+
+  // Stops sharing the response body of |entry|, because the writer is done
+  // with it. |complete| is false if the readers won't get the whole body.
+  void StopSharingBody(ActiveEntry* entry, bool complete);
+
   // Returns the LoadState of the provided pending transaction.
   LoadState GetLoadStateForPendingTransaction(const Transaction* trans);
 
@@ -409,6 +437,7 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   bool building_backend_;
   bool bypass_lock_for_test_;
   bool fail_conditionalization_for_test_;
+  bool shared_body_reading_;
 
   Mode mode_;
 
@@ -163,6 +163,9 @@ HttpCache::Transaction::Transaction(RequestPriority priority, HttpCache* cache)
       couldnt_conditionalize_request_(false),
       bypass_lock_for_test_(false),
       fail_conditionalization_for_test_(false),
+      reading_shared_body_(false),
+      waiting_for_shared_body_(false),
+      shared_body_incomplete_(false),
       io_buf_len_(0),
       read_offset_(0),
       effective_load_flags_(0),
@@ -252,6 +255,31 @@ const BoundNetLog& HttpCache::Transaction::net_log() const {
   return net_log_;
 }
 
+bool HttpCache::Transaction::CanReadSharedBody() const {
+  // Only plain GETs which would read the entry without validating it can start
+  // before the writer is done; the others wait for the entry as usual.
+  return cache_.get() && cache_->shared_body_reading() && mode_ == READ_WRITE &&
+         !partial_ && !range_requested_ && request_->method == "GET" &&
+         !external_validation_.initialized &&
+         !(effective_load_flags_ & (LOAD_VALIDATE_CACHE | LOAD_PREFETCH));
+}
+
+void HttpCache::Transaction::StartReadingSharedBody() {
+  mode_ = READ;
+  reading_shared_body_ = true;
+}
+
+void HttpCache::Transaction::OnSharedBodyWritten(bool complete) {
+  if (!complete)
+    shared_body_incomplete_ = true;
+  if (!waiting_for_shared_body_)
+    return;
+
+  waiting_for_shared_body_ = false;
+  base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+                                                base::Bind(io_callback_, OK));
+}
+
 int HttpCache::Transaction::Start(const HttpRequestInfo* request,
                                   const CompletionCallback& callback,
                                   const BoundNetLog& net_log) {
@@ -407,6 +435,8 @@ void HttpCache::Transaction::StopCaching() {
   //                Fix this.
   if (cache_.get() && entry_ && (mode_ & WRITE) && network_trans_.get() &&
       !is_sparse_ && !range_requested_) {
+    if (entry_->writer_shares_body)
+      cache_->StopSharingBody(entry_, false);
     mode_ = NONE;
   }
 }
@@ -1274,6 +1304,17 @@ int HttpCache::Transaction::DoCacheDispatchValidation() {
   //    conditionalized request (if-modified-since / if-none-match). We check
   //    if the request headers define a validation request.
   //
+  if (reading_shared_body_ && RequiresValidation() != VALIDATION_NONE) {
+    // The response being stored by the writer can't be used as is, so give up
+    // on the entry and go to the network.
+    cache_->DoneReadingFromEntry(entry_, this);
+    entry_ = NULL;
+    mode_ = NONE;
+    reading_shared_body_ = false;
+    next_state_ = STATE_SEND_REQUEST;
+    return OK;
+  }
+
   int result = ERR_FAILED;
   switch (mode_) {
     case READ:
@@ -1672,6 +1713,10 @@ int HttpCache::Transaction::DoTruncateCachedMetadataComplete(int result) {
     }
   }
 
+  // The headers are stored, so readers can start while the body is written.
+  if (entry_ && CanShareBody())
+    cache_->StartSharingBody(entry_);
+
   next_state_ = STATE_PARTIAL_HEADERS_RECEIVED;
   return OK;
 }
@@ -1745,6 +1790,18 @@ int HttpCache::Transaction::DoCacheReadData() {
     return 0;
 
   DCHECK(entry_);
+  int read_len = io_buf_len_;
+  if (reading_shared_body_ && entry_->writer_shares_body) {
+    int64_t available = entry_->shared_body_size - read_offset_;
+    if (available <= 0) {
+      // Wait for the writer to store more of the body.
+      waiting_for_shared_body_ = true;
+      next_state_ = STATE_CACHE_READ_DATA;
+      return ERR_IO_PENDING;
+    }
+    read_len = static_cast<int>(std::min<int64_t>(read_len, available));
+  }
+
   next_state_ = STATE_CACHE_READ_DATA_COMPLETE;
 
   if (net_log_.IsCapturing())
@@ -1755,8 +1812,7 @@ int HttpCache::Transaction::DoCacheReadData() {
   }
 
   return entry_->disk_entry->ReadData(kResponseContentIndex, read_offset_,
-                                      read_buf_.get(), io_buf_len_,
-                                      io_callback_);
+                                      read_buf_.get(), read_len, io_callback_);
 }
 
 int HttpCache::Transaction::DoCacheReadDataComplete(int result) {
@@ -1775,6 +1831,13 @@ int HttpCache::Transaction::DoCacheReadDataComplete(int result) {
     return DoPartialCacheReadCompleted(result);
   }
 
+  if (result == 0 && shared_body_incomplete_) {
+    // The writer stopped before storing the whole body. The entry is dealt with
+    // by the writer, so just fail this request.
+    DLOG(ERROR) << "shared response body is incomplete";
+    return ERR_CACHE_READ_FAILURE;
+  }
+
   if (result > 0) {
     read_offset_ += result;
   } else if (result == 0) {  // End of file.
@@ -1827,6 +1890,11 @@ int HttpCache::Transaction::DoCacheWriteDataComplete(int result) {
       done_reading_ = true;
   }
 
+  if (entry_ && entry_->writer_shares_body && write_len_ > 0) {
+    cache_->OnSharedBodyWritten(
+        entry_, entry_->disk_entry->GetDataSize(kResponseContentIndex));
+  }
+
   if (partial_) {
     // This may be the last request.
     if (result != 0 || truncated_ ||
@@ -2762,6 +2830,19 @@ bool HttpCache::Transaction::CanResume(bool has_data) {
   return true;
 }
 
+bool HttpCache::Transaction::CanShareBody() const {
+  if (!cache_->shared_body_reading() || entry_->writer != this ||
+      !(mode_ & WRITE) || partial_ || truncated_) {
+    return false;
+  }
+
+  // Keep the body to the transactions which started it for anything but a
+  // plain 200 response to a GET, as the readers don't validate the entry.
+  return request_->method == "GET" &&
+         response_.headers->response_code() == 200 &&
+         !(effective_load_flags_ & LOAD_PREFETCH);
+}
+
 void HttpCache::Transaction::UpdateTransactionPattern(
     TransactionPattern new_transaction_pattern) {
   if (transaction_pattern_ == PATTERN_NOT_COVERED)
@@ -118,6 +118,18 @@ class HttpCache::Transaction : public HttpTransaction {
 
   const CompletionCallback& io_callback() { return io_callback_; }
 
+  // Returns true if this transaction can read the body of an entry while its
+  // writer is still storing it, see HttpCache::set_shared_body_reading().
+  bool CanReadSharedBody() const;
+
+  // Called by the cache when this transaction is added as a reader of an entry
+  // whose body is still being written.
+  void StartReadingSharedBody();
+
+  // Called by the cache each time the writer stores more of the shared body,
+  // and with |complete| set to false if the writer stops before the end.
+  void OnSharedBodyWritten(bool complete);
+
   const BoundNetLog& net_log() const;
 
   // Bypasses the cache lock whenever there is lock contention.
@@ -435,6 +447,10 @@ class HttpCache::Transaction : public HttpTransaction {
   // data is considered for the result.
   bool CanResume(bool has_data);
 
+  // Returns true if the body this transaction is about to write can be read by
+  // other transactions while it is being written.
+  bool CanShareBody() const;
+
   void UpdateTransactionPattern(TransactionPattern new_transaction_pattern);
   void RecordHistograms();
 
@@ -475,6 +491,9 @@ class HttpCache::Transaction : public HttpTransaction {
   bool couldnt_conditionalize_request_;
   bool bypass_lock_for_test_;  // A test is exercising the cache lock.
   bool fail_conditionalization_for_test_;  // Fail ConditionalizeRequest.
+  bool reading_shared_body_;  // The writer of |entry_| is still writing.
+  bool waiting_for_shared_body_;  // Waiting for the writer to store more data.
+  bool shared_body_incomplete_;  // The writer stopped before the end.
   scoped_refptr<IOBuffer> read_buf_;
   int io_buf_len_;
   int read_offset_;
@@ -1316,6 +1316,96 @@ TEST(HttpCache, SimpleGET_ManyReaders) {
   }
 }
 
+// Tests that readers can start while the writer is storing the response body
+// when shared body reading is enabled.
+TEST(HttpCache, SimpleGET_SharedBodyReaders) {
+  MockHttpCache cache;
+  cache.http_cache()->set_shared_body_reading(true);
+
+  MockHttpRequest request(kSimpleGET_Transaction);
+
+  std::vector<std::unique_ptr<Context>> context_list;
+  const int kNumTransactions = 5;
+
+  for (int i = 0; i < kNumTransactions; ++i) {
+    context_list.push_back(base::WrapUnique(new Context()));
+    Context* c = context_list[i].get();
+
+    c->result = cache.CreateTransaction(&c->trans);
+    ASSERT_EQ(OK, c->result);
+
+    c->result =
+        c->trans->Start(&request, c->callback.callback(), BoundNetLog());
+  }
+
+  base::RunLoop().RunUntilIdle();
+
+  // The writer is between Start and Read, but all the readers are done with
+  // their Start already.
+  for (int i = 0; i < kNumTransactions; ++i) {
+    Context* c = context_list[i].get();
+    if (c->result == ERR_IO_PENDING) {
+      ASSERT_TRUE(c->callback.have_result());
+      c->result = c->callback.WaitForResult();
+    }
+    EXPECT_EQ(OK, c->result);
+  }
+
+  for (int i = 0; i < kNumTransactions; ++i)
+    ReadAndVerifyTransaction(context_list[i]->trans.get(),
+                             kSimpleGET_Transaction);
+
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(0, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+}
+
+// Tests that readers of a shared body fail if the writer goes away before
+// storing the whole body.
+TEST(HttpCache, SimpleGET_SharedBodyWriterCancelled) {
+  MockHttpCache cache;
+  cache.http_cache()->set_shared_body_reading(true);
+
+  MockHttpRequest request(kSimpleGET_Transaction);
+
+  std::vector<std::unique_ptr<Context>> context_list;
+  const int kNumTransactions = 3;
+
+  for (int i = 0; i < kNumTransactions; ++i) {
+    context_list.push_back(base::WrapUnique(new Context()));
+    Context* c = context_list[i].get();
+
+    c->result = cache.CreateTransaction(&c->trans);
+    ASSERT_EQ(OK, c->result);
+
+    c->result =
+        c->trans->Start(&request, c->callback.callback(), BoundNetLog());
+  }
+
+  base::RunLoop().RunUntilIdle();
+
+  for (int i = 0; i < kNumTransactions; ++i) {
+    Context* c = context_list[i].get();
+    if (c->result == ERR_IO_PENDING)
+      c->result = c->callback.WaitForResult();
+    EXPECT_EQ(OK, c->result);
+  }
+
+  // Delete the writer before it reads anything.
+  context_list[0].reset();
+
+  for (int i = 1; i < kNumTransactions; ++i) {
+    Context* c = context_list[i].get();
+    scoped_refptr<IOBuffer> buf(new IOBuffer(256));
+    int rv = c->trans->Read(buf.get(), 256, c->callback.callback());
+    EXPECT_EQ(ERR_CACHE_READ_FAILURE, c->callback.GetResult(rv));
+  }
+
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(0, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+}
+
 // This is a test for http://code.google.com/p/chromium/issues/detail?id=4769.
 // If cancelling a request is racing with another request for the same resource
 // finishing, we have to make sure that we remove both transactions from the
@@ -21,6 +21,7 @@
 #include "net/http/url_security_manager.h"
 #include "net/proxy/proxy_service.h"
 #include "net/quic/crypto/quic_random.h"
+#include "net/quic/quic_chromium_packet_reader.h"
 #include "net/quic/quic_clock.h"
 #include "net/quic/quic_crypto_client_stream_factory.h"
 #include "net/quic/quic_protocol.h"
@@ -130,6 +131,7 @@ HttpNetworkSession::Params::Params()
       quic_migrate_sessions_on_network_change(false),
       quic_migrate_sessions_early(false),
       quic_disable_bidirectional_streams(false),
+      quic_packet_batch_size(kQuicDefaultPacketBatchSize),
       proxy_delegate(NULL),
       enable_token_binding(false) {
   quic_supported_versions.push_back(QUIC_VERSION_34);
@@ -208,6 +210,8 @@ HttpNetworkSession::HttpNetworkSession(const Params& params)
   DCHECK(ssl_config_service_.get());
   CHECK(http_server_properties_);
 
+  quic_stream_factory_.set_packet_batch_size(params.quic_packet_batch_size);
+
   const std::string ssl_session_cache_shard =
       "http_network_session/" + base::IntToString(g_next_shard_id.GetNext());
   normal_socket_pool_manager_.reset(CreateSocketPoolManager(
@@ -247,6 +251,11 @@ HttpNetworkSession::HttpNetworkSession(const Params& params)
 
   http_server_properties_->SetMaxServerConfigsStoredInProperties(
       params.quic_max_server_configs_stored_in_properties);
+
+  if (!params.warm_origins.empty()) {
+    warm_connection_reservoir_.reset(
+        new HttpWarmConnectionReservoir(this, params.warm_origins));
+  }
 }
 
 HttpNetworkSession::~HttpNetworkSession() {
@@ -336,6 +345,7 @@ std::unique_ptr<base::Value> HttpNetworkSession::QuicInfoToValue() const {
                    params_.quic_max_number_of_lossy_connections);
   dict->SetDouble("packet_loss_threshold", params_.quic_packet_loss_threshold);
   dict->SetBoolean("delay_tcp_race", params_.quic_delay_tcp_race);
+  dict->SetInteger("packet_batch_size", params_.quic_packet_batch_size);
   dict->SetInteger("max_server_configs_stored_in_properties",
                    params_.quic_max_server_configs_stored_in_properties);
   dict->SetInteger("idle_connection_timeout_seconds",
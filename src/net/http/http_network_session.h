@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_set>
@@ -21,6 +22,7 @@
 #include "net/dns/host_resolver.h"
 #include "net/http/http_auth_cache.h"
 #include "net/http/http_stream_factory.h"
+#include "net/http/http_warm_connection_reservoir.h"
 #include "net/quic/quic_stream_factory.h"
 #include "net/socket/next_proto.h"
 #include "net/spdy/spdy_session_pool.h"
@@ -182,10 +184,16 @@ class NET_EXPORT HttpNetworkSession
     bool quic_migrate_sessions_early;
     // If true, bidirectional streams over QUIC will be disabled.
     bool quic_disable_bidirectional_streams;
+    // Number of QUIC packets read or written by a single socket call, where
+    // the platform supports it. 1 disables batching.
+    int quic_packet_batch_size;
 
     ProxyDelegate* proxy_delegate;
     // Enable support for Token Binding.
     bool enable_token_binding;
+    // Origins for which idle connections are kept in the socket pools, with
+    // the number of connections to keep for each.
+    HttpWarmConnectionReservoir::WarmOrigins warm_origins;
   };
 
   enum SocketPoolType {
@@ -297,6 +305,9 @@ class NET_EXPORT HttpNetworkSession
   bool enabled_protocols_[NUM_VALID_ALTERNATE_PROTOCOLS];
 
   Params params_;
+
+  // Declared last so that it is destroyed before the stream factories.
+  std::unique_ptr<HttpWarmConnectionReservoir> warm_connection_reservoir_;
 };
 
 }  // namespace net
@@ -0,0 +1,120 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_server_properties_persister.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task_runner_util.h"
+#include "base/threading/thread_task_runner_handle.h"
+
+namespace net {
+
+namespace {
+
+const char kFileName[] = "HttpServerProperties";
+
+std::string LoadState(const base::FilePath& path) {
+  std::string result;
+  if (!base::ReadFileToString(path, &result)) {
+    return "";
+  }
+  return result;
+}
+
+}  // namespace
+
+HttpServerPropertiesPersister::HttpServerPropertiesPersister(
+    const base::FilePath& profile_path,
+    const scoped_refptr<base::SequencedTaskRunner>& background_runner)
+    : has_server_properties_(false),
+      writer_(profile_path.AppendASCII(kFileName), background_runner),
+      foreground_runner_(base::ThreadTaskRunnerHandle::Get()),
+      weak_ptr_factory_(this) {
+  base::PostTaskAndReplyWithResult(
+      background_runner.get(), FROM_HERE,
+      base::Bind(&LoadState, writer_.path()),
+      base::Bind(&HttpServerPropertiesPersister::CompleteLoad,
+                 weak_ptr_factory_.GetWeakPtr()));
+}
+
+HttpServerPropertiesPersister::~HttpServerPropertiesPersister() {
+  DCHECK(foreground_runner_->RunsTasksOnCurrentThread());
+  FlushPendingWrite();
+}
+
+bool HttpServerPropertiesPersister::HasServerProperties() {
+  DCHECK(foreground_runner_->RunsTasksOnCurrentThread());
+  return has_server_properties_;
+}
+
+const base::DictionaryValue&
+HttpServerPropertiesPersister::GetServerProperties() const {
+  DCHECK(foreground_runner_->RunsTasksOnCurrentThread());
+  return server_properties_;
+}
+
+void HttpServerPropertiesPersister::SetServerProperties(
+    const base::DictionaryValue& value) {
+  DCHECK(foreground_runner_->RunsTasksOnCurrentThread());
+  server_properties_.Clear();
+  server_properties_.MergeDictionary(&value);
+  has_server_properties_ = true;
+  writer_.ScheduleWrite(this);
+}
+
+void HttpServerPropertiesPersister::StartListeningForUpdates(
+    const base::Closure& callback) {
+  DCHECK(foreground_runner_->RunsTasksOnCurrentThread());
+  DCHECK(update_callback_.is_null());
+  update_callback_ = callback;
+}
+
+void HttpServerPropertiesPersister::StopListeningForUpdates() {
+  DCHECK(foreground_runner_->RunsTasksOnCurrentThread());
+  update_callback_.Reset();
+  // The manager stops listening when it shuts down, so don't wait for the
+  // commit interval to write the last changes.
+  FlushPendingWrite();
+}
+
+bool HttpServerPropertiesPersister::SerializeData(std::string* data) {
+  DCHECK(foreground_runner_->RunsTasksOnCurrentThread());
+  return base::JSONWriter::Write(server_properties_, data);
+}
+
+void HttpServerPropertiesPersister::CompleteLoad(
+    const std::string& serialized) {
+  DCHECK(foreground_runner_->RunsTasksOnCurrentThread());
+
+  // Properties set while the file was loading are newer.
+  if (serialized.empty() || has_server_properties_)
+    return;
+
+  std::unique_ptr<base::Value> value = base::JSONReader::Read(serialized);
+  base::DictionaryValue* dict_value = nullptr;
+  if (!value || !value->GetAsDictionary(&dict_value)) {
+    LOG(ERROR) << "Failed to deserialize server properties";
+    return;
+  }
+  server_properties_.Swap(dict_value);
+  has_server_properties_ = true;
+
+  if (!update_callback_.is_null())
+    update_callback_.Run();
+}
+
+void HttpServerPropertiesPersister::FlushPendingWrite() {
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+}
+
+}  // namespace net
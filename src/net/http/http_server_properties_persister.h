@@ -0,0 +1,83 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_HTTP_HTTP_SERVER_PROPERTIES_PERSISTER_H_
+#define NET_HTTP_HTTP_SERVER_PROPERTIES_PERSISTER_H_
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
+#include "net/base/net_export.h"
+#include "net/http/http_server_properties_manager.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace net {
+
+// Stores the server properties of an HttpServerPropertiesManager in a JSON
+// file, for embedders without a preferences system. Along with the alternative
+// services of the servers, this persists the QUIC server configs kept in the
+// properties, so that the first QUIC handshakes after a restart can be 0-RTT.
+//
+// The file is loaded on |background_runner| at construction, and the manager
+// is notified once it is. Changes are written to the file on
+// |background_runner| after a short delay.
+//
+// Must be created, used and destroyed on a single thread, which must then be
+// both the pref thread and the network thread of the manager.
+class NET_EXPORT HttpServerPropertiesPersister
+    : public HttpServerPropertiesManager::PrefDelegate,
+      public base::ImportantFileWriter::DataSerializer {
+ public:
+  // The properties are stored in a file named "HttpServerProperties" in
+  // |profile_path|.
+  HttpServerPropertiesPersister(
+      const base::FilePath& profile_path,
+      const scoped_refptr<base::SequencedTaskRunner>& background_runner);
+  ~HttpServerPropertiesPersister() override;
+
+  // HttpServerPropertiesManager::PrefDelegate:
+  bool HasServerProperties() override;
+  const base::DictionaryValue& GetServerProperties() const override;
+  void SetServerProperties(const base::DictionaryValue& value) override;
+  void StartListeningForUpdates(const base::Closure& callback) override;
+  void StopListeningForUpdates() override;
+
+  // ImportantFileWriter::DataSerializer:
+  bool SerializeData(std::string* data) override;
+
+ private:
+  void CompleteLoad(const std::string& serialized);
+
+  // Writes the pending changes, if any.
+  void FlushPendingWrite();
+
+  base::DictionaryValue server_properties_;
+
+  // Whether |server_properties_| were loaded from the file or set.
+  bool has_server_properties_;
+
+  // Called once the file is loaded.
+  base::Closure update_callback_;
+
+  base::ImportantFileWriter writer_;
+
+  scoped_refptr<base::SequencedTaskRunner> foreground_runner_;
+
+  base::WeakPtrFactory<HttpServerPropertiesPersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HttpServerPropertiesPersister);
+};
+
+}  // namespace net
+
+#endif  // NET_HTTP_HTTP_SERVER_PROPERTIES_PERSISTER_H_
@@ -0,0 +1,107 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_server_properties_persister.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+class HttpServerPropertiesPersisterTest : public testing::Test {
+ public:
+  HttpServerPropertiesPersisterTest() : num_updates_(0) {}
+
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+ protected:
+  std::unique_ptr<HttpServerPropertiesPersister> CreatePersister() {
+    std::unique_ptr<HttpServerPropertiesPersister> persister(
+        new HttpServerPropertiesPersister(temp_dir_.path(),
+                                          message_loop_.task_runner()));
+    persister->StartListeningForUpdates(
+        base::Bind(&HttpServerPropertiesPersisterTest::OnUpdate,
+                   base::Unretained(this)));
+    return persister;
+  }
+
+  void OnUpdate() { ++num_updates_; }
+
+  base::MessageLoopForIO message_loop_;
+  base::ScopedTempDir temp_dir_;
+  int num_updates_;
+};
+
+TEST_F(HttpServerPropertiesPersisterTest, NoFile) {
+  std::unique_ptr<HttpServerPropertiesPersister> persister = CreatePersister();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(persister->HasServerProperties());
+  EXPECT_EQ(0, num_updates_);
+}
+
+TEST_F(HttpServerPropertiesPersisterTest, PersistAcrossRestarts) {
+  base::DictionaryValue properties;
+  properties.SetInteger("version", 5);
+  properties.SetString("alternative_service", "quic");
+
+  std::unique_ptr<HttpServerPropertiesPersister> persister = CreatePersister();
+  base::RunLoop().RunUntilIdle();
+  persister->SetServerProperties(properties);
+  EXPECT_TRUE(persister->HasServerProperties());
+  // Shutting the manager down writes the changes.
+  persister->StopListeningForUpdates();
+  persister.reset();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, num_updates_);
+
+  persister = CreatePersister();
+  EXPECT_FALSE(persister->HasServerProperties());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, num_updates_);
+  ASSERT_TRUE(persister->HasServerProperties());
+  EXPECT_TRUE(properties.Equals(&persister->GetServerProperties()));
+}
+
+TEST_F(HttpServerPropertiesPersisterTest, SetWhileLoading) {
+  base::DictionaryValue old_properties;
+  old_properties.SetInteger("version", 4);
+  std::unique_ptr<HttpServerPropertiesPersister> persister = CreatePersister();
+  persister->SetServerProperties(old_properties);
+  persister.reset();
+  base::RunLoop().RunUntilIdle();
+
+  base::DictionaryValue properties;
+  properties.SetInteger("version", 5);
+  persister = CreatePersister();
+  persister->SetServerProperties(properties);
+  base::RunLoop().RunUntilIdle();
+  // The loaded properties don't overwrite the newer ones.
+  EXPECT_EQ(0, num_updates_);
+  EXPECT_TRUE(properties.Equals(&persister->GetServerProperties()));
+}
+
+TEST_F(HttpServerPropertiesPersisterTest, CorruptedFile) {
+  const char kCorrupted[] = "{\"version\": 5,";
+  base::FilePath path = temp_dir_.path().AppendASCII("HttpServerProperties");
+  ASSERT_EQ(static_cast<int>(sizeof(kCorrupted) - 1),
+            base::WriteFile(path, kCorrupted, sizeof(kCorrupted) - 1));
+
+  std::unique_ptr<HttpServerPropertiesPersister> persister = CreatePersister();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(persister->HasServerProperties());
+  EXPECT_EQ(0, num_updates_);
+}
+
+}  // namespace
+
+}  // namespace net
@@ -4,6 +4,7 @@
 
 #include "net/http/http_stream_parser.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -278,7 +279,35 @@ int HttpStreamParser::SendRequest(const std::string& request_line,
   // If we have a small request body, then we'll merge with the headers into a
   // single write.
   bool did_merge = false;
-  if (ShouldMergeRequestHeadersAndBody(request, request_->upload_data_stream)) {
+  bool should_merge =
+      ShouldMergeRequestHeadersAndBody(request, request_->upload_data_stream);
+  if (should_merge && connection_->socket()->SupportsGatheredWrite()) {
+    // The socket can send the headers and the body from separate buffers in a
+    // single write, so the body is read into |request_body_send_buf_| and
+    // neither is copied. DoSendHeaders() sends whatever is in that buffer
+    // along with the headers.
+    uint64_t todo = request_->upload_data_stream->size();
+    while (todo) {
+      int consumed = request_->upload_data_stream->Read(
+          request_body_send_buf_.get(), static_cast<int>(todo),
+          CompletionCallback());
+      // Read() must succeed synchronously if not chunked and in memory.
+      DCHECK_GT(consumed, 0);
+      request_body_send_buf_->DidAppend(consumed);
+      request_body_send_buf_->DidConsume(consumed);
+      todo -= consumed;
+    }
+    DCHECK(request_->upload_data_stream->IsEOF());
+    request_body_send_buf_->SetOffset(0);
+    did_merge = true;
+
+    net_log_.AddEvent(
+        NetLog::TYPE_HTTP_TRANSACTION_SEND_REQUEST_BODY,
+        base::Bind(&NetLogSendRequestBodyCallback,
+                   request_->upload_data_stream->size(),
+                   false, /* not chunked */
+                   true /* merged */));
+  } else if (should_merge) {
     int merged_size = static_cast<int>(
         request_headers_length_ + request_->upload_data_stream->size());
     scoped_refptr<IOBuffer> merged_request_headers_and_body(
@@ -465,6 +494,11 @@ int HttpStreamParser::DoSendHeaders() {
     response_->request_time = base::Time::Now();
 
   io_state_ = STATE_SEND_HEADERS_COMPLETE;
+  if (request_body_send_buf_ && request_body_send_buf_->BytesRemaining() > 0) {
+    return connection_->socket()->WriteGathered(
+        request_headers_.get(), bytes_remaining, request_body_send_buf_.get(),
+        request_body_send_buf_->BytesRemaining(), io_callback_);
+  }
   return connection_->socket()
       ->Write(request_headers_.get(), bytes_remaining, io_callback_);
 }
@@ -484,7 +518,12 @@ int HttpStreamParser::DoSendHeadersComplete(int result) {
   }
 
   sent_bytes_ += result;
-  request_headers_->DidConsume(result);
+  int header_bytes = std::min(result, request_headers_->BytesRemaining());
+  request_headers_->DidConsume(header_bytes);
+  // Any other bytes were written from |request_body_send_buf_| by
+  // WriteGathered().
+  if (result > header_bytes)
+    request_body_send_buf_->DidConsume(result - header_bytes);
   if (request_headers_->BytesRemaining() > 0) {
     io_state_ = STATE_SEND_HEADERS;
     return OK;
@@ -505,6 +544,13 @@ int HttpStreamParser::DoSendHeadersComplete(int result) {
     return OK;
   }
 
+  // Send the rest of a body that was only partly written along with the
+  // headers.
+  if (request_body_send_buf_ && request_body_send_buf_->BytesRemaining() > 0) {
+    io_state_ = STATE_SEND_BODY;
+    return OK;
+  }
+
   // Finished sending the request.
   return OK;
 }
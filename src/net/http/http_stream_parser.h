@@ -197,7 +197,9 @@ class NET_EXPORT_PRIVATE HttpStreamParser {
   // The request to send.
   const HttpRequestInfo* request_;
 
-  // The request header data.  May include a merged request body.
+  // The request header data.  May include a merged request body, unless the
+  // socket supports gathered writes, in which case a merged body is kept in
+  // |request_body_send_buf_| and written along with the headers.
   scoped_refptr<DrainableIOBuffer> request_headers_;
 
   // Size of just the request headers.  May be less than the length of
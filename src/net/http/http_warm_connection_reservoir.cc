@@ -0,0 +1,69 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_warm_connection_reservoir.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "net/http/http_network_session.h"
+#include "net/http/http_request_info.h"
+#include "net/http/http_stream_factory.h"
+#include "net/socket/client_socket_pool.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+// Lower bound of the refresh interval, in case the idle socket timeout of the
+// pools was lowered a lot.
+const int kMinRefreshIntervalSeconds = 1;
+
+base::TimeDelta GetRefreshInterval() {
+  // Refreshing twice per timeout bounds the time an origin spends without a
+  // warm connection to half of the timeout.
+  return std::max(ClientSocketPool::unused_idle_socket_timeout() / 2,
+                  base::TimeDelta::FromSeconds(kMinRefreshIntervalSeconds));
+}
+
+}  // namespace
+
+HttpWarmConnectionReservoir::HttpWarmConnectionReservoir(
+    HttpNetworkSession* session,
+    const WarmOrigins& origins)
+    : session_(session),
+      origins_(origins),
+      refresh_interval_(GetRefreshInterval()),
+      weak_ptr_factory_(this) {
+  DCHECK(session_);
+  if (origins_.empty())
+    return;
+  timer_.Start(FROM_HERE, refresh_interval_, this,
+               &HttpWarmConnectionReservoir::Refresh);
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::Bind(&HttpWarmConnectionReservoir::Refresh,
+                            weak_ptr_factory_.GetWeakPtr()));
+}
+
+HttpWarmConnectionReservoir::~HttpWarmConnectionReservoir() {}
+
+void HttpWarmConnectionReservoir::Refresh() {
+  DCHECK(CalledOnValidThread());
+  for (const auto& origin : origins_) {
+    if (origin.first.IsInvalid() || origin.second <= 0)
+      continue;
+    HttpRequestInfo request_info;
+    request_info.url = GURL(origin.first.Serialize());
+    request_info.method = "GET";
+    request_info.motivation = HttpRequestInfo::PRECONNECT_MOTIVATED;
+    session_->http_stream_factory()->PreconnectStreams(origin.second,
+                                                       request_info);
+  }
+}
+
+}  // namespace net
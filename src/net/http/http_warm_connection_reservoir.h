@@ -0,0 +1,63 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_HTTP_HTTP_WARM_CONNECTION_RESERVOIR_H_
+#define NET_HTTP_HTTP_WARM_CONNECTION_RESERVOIR_H_
+
+#include <map>
+
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/non_thread_safe.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "net/base/net_export.h"
+#include "url/scheme_host_port.h"
+
+namespace net {
+
+class HttpNetworkSession;
+
+// Keeps a number of idle, connected sockets in the socket pools of a session
+// for each of a set of origins, so that the first request to a known API or
+// CDN host after a quiet period does not have to wait for a TCP and TLS
+// handshake.
+//
+// The sockets are created with preconnects, which only connect as many
+// sockets as a group is short of the requested number. Refresh() is run
+// periodically, more often than the idle socket timeout of the pools, so that
+// sockets that timed out or were used by a request are replaced.
+class NET_EXPORT_PRIVATE HttpWarmConnectionReservoir
+    : NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  // Maps each origin to the number of connections to keep warm for it.
+  typedef std::map<url::SchemeHostPort, int> WarmOrigins;
+
+  // |session| must outlive the reservoir. The first Refresh() is posted to
+  // the current thread.
+  HttpWarmConnectionReservoir(HttpNetworkSession* session,
+                              const WarmOrigins& origins);
+  ~HttpWarmConnectionReservoir();
+
+  // Preconnects each origin up to its number of warm connections.
+  void Refresh();
+
+  // Returns the delay between two runs of Refresh().
+  base::TimeDelta refresh_interval() const { return refresh_interval_; }
+
+ private:
+  HttpNetworkSession* const session_;
+  const WarmOrigins origins_;
+  const base::TimeDelta refresh_interval_;
+
+  base::RepeatingTimer timer_;
+
+  base::WeakPtrFactory<HttpWarmConnectionReservoir> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HttpWarmConnectionReservoir);
+};
+
+}  // namespace net
+
+#endif  // NET_HTTP_HTTP_WARM_CONNECTION_RESERVOIR_H_
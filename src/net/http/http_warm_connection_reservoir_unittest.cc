@@ -0,0 +1,81 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_warm_connection_reservoir.h"
+
+#include <memory>
+
+#include "base/run_loop.h"
+#include "net/http/http_network_session.h"
+#include "net/socket/client_socket_pool.h"
+#include "net/socket/socket_test_util.h"
+#include "net/socket/transport_client_socket_pool.h"
+#include "net/spdy/spdy_test_util_common.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/scheme_host_port.h"
+
+namespace net {
+
+namespace {
+
+class HttpWarmConnectionReservoirTest : public testing::Test {
+ protected:
+  HttpWarmConnectionReservoirTest() : session_deps_(kProtoHTTP2) {
+    origins_[url::SchemeHostPort(GURL("http://www.example.org"))] = 2;
+    for (size_t i = 0; i < arraysize(data_); ++i) {
+      data_[i].set_connect_data(MockConnect(SYNCHRONOUS, OK));
+      session_deps_.socket_factory->AddSocketDataProvider(&data_[i]);
+    }
+  }
+
+  int IdleSocketCount(HttpNetworkSession* session) {
+    return session
+        ->GetTransportSocketPool(HttpNetworkSession::NORMAL_SOCKET_POOL)
+        ->IdleSocketCount();
+  }
+
+  SpdySessionDependencies session_deps_;
+  StaticSocketDataProvider data_[4];
+  HttpWarmConnectionReservoir::WarmOrigins origins_;
+};
+
+TEST_F(HttpWarmConnectionReservoirTest, RefreshTopsUpConnections) {
+  std::unique_ptr<HttpNetworkSession> session =
+      SpdySessionDependencies::SpdyCreateSession(&session_deps_);
+  HttpWarmConnectionReservoir reservoir(session.get(), origins_);
+  EXPECT_LT(reservoir.refresh_interval(),
+            ClientSocketPool::unused_idle_socket_timeout());
+
+  // The first refresh is posted.
+  EXPECT_EQ(0, IdleSocketCount(session.get()));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, IdleSocketCount(session.get()));
+
+  // Refreshing a full reservoir does not connect more sockets.
+  reservoir.Refresh();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, IdleSocketCount(session.get()));
+  EXPECT_EQ(2u, session_deps_.socket_factory->mock_data().next_index());
+
+  // Sockets that go away are replaced on the next refresh.
+  session->CloseIdleConnections();
+  EXPECT_EQ(0, IdleSocketCount(session.get()));
+  reservoir.Refresh();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, IdleSocketCount(session.get()));
+}
+
+TEST_F(HttpWarmConnectionReservoirTest, SessionParams) {
+  HttpNetworkSession::Params params =
+      SpdySessionDependencies::CreateSessionParams(&session_deps_);
+  params.warm_origins = origins_;
+  HttpNetworkSession session(params);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, IdleSocketCount(&session));
+}
+
+}  // namespace
+
+}  // namespace net
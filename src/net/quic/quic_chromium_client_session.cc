@@ -983,6 +983,12 @@ void QuicChromiumClientSession::StartReading() {
   }
 }
 
+void QuicChromiumClientSession::SetReadBatchSize(int batch_size) {
+  for (auto& packet_reader : packet_readers_) {
+    packet_reader->SetBatchSize(batch_size);
+  }
+}
+
 void QuicChromiumClientSession::CloseSessionOnError(int error,
                                                     QuicErrorCode quic_error) {
   RecordAndCloseSessionOnError(error, quic_error);
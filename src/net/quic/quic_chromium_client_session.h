@@ -214,6 +214,10 @@ class NET_EXPORT_PRIVATE QuicChromiumClientSession
   // and passing the data along to the QuicConnection.
   void StartReading();
 
+  // Reads up to |batch_size| packets with each read of the sockets which
+  // support it. Must be called before StartReading().
+  void SetReadBatchSize(int batch_size);
+
   // Close the session because of |error| and notifies the factory
   // that this session has been closed, which will delete the session.
   void CloseSessionOnError(int error, QuicErrorCode quic_error);
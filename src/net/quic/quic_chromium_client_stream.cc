@@ -254,6 +254,20 @@ int QuicChromiumClientStream::Read(IOBuffer* buf, int buf_len) {
   return Readv(&iov, 1);
 }
 
+int QuicChromiumClientStream::ReadWithoutCopy(int max_length,
+                                              scoped_refptr<IOBuffer>* buf) {
+  if (sequencer()->IsClosed())
+    return 0;  // EOF
+
+  if (!HasBytesToRead())
+    return ERR_IO_PENDING;
+
+  DCHECK(FinishedReadingHeaders());
+  size_t bytes_read = 0;
+  *buf = sequencer()->ReadAsIOBuffer(max_length, &bytes_read);
+  return static_cast<int>(bytes_read);
+}
+
 bool QuicChromiumClientStream::CanWrite(const CompletionCallback& callback) {
   bool can_write = session()->connection()->CanWrite(HAS_RETRANSMITTABLE_DATA);
   if (!can_write) {
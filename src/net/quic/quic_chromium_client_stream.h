@@ -107,6 +107,11 @@ class NET_EXPORT_PRIVATE QuicChromiumClientStream : public QuicSpdyStream {
   // Reads at most |buf_len| bytes into |buf|. Returns the number of bytes read.
   int Read(IOBuffer* buf, int buf_len);
 
+  // Like Read(), but stores in |buf| a buffer pointing to at most |max_length|
+  // bytes of the received data instead of copying them. Returns the number of
+  // bytes |buf| points to.
+  int ReadWithoutCopy(int max_length, scoped_refptr<IOBuffer>* buf);
+
   // Returns true if the stream can possible write data.  (The socket may
   // turn out to be write blocked, of course).  If the stream can not write,
   // this method returns false, and |callback| will be invoked when
@@ -28,6 +28,7 @@ QuicChromiumPacketReader::QuicChromiumPacketReader(
       yield_after_packets_(yield_after_packets),
       yield_after_duration_(yield_after_duration),
       yield_after_(QuicTime::Infinite()),
+      batch_size_(1),
       read_buffer_(new IOBufferWithSize(static_cast<size_t>(kMaxPacketSize))),
       net_log_(net_log),
       weak_factory_(this) {}
@@ -43,16 +44,15 @@ void QuicChromiumPacketReader::StartReading() {
 
   DCHECK(socket_);
   read_pending_ = true;
-  int rv = socket_->Read(read_buffer_.get(), read_buffer_->size(),
-                         base::Bind(&QuicChromiumPacketReader::OnReadComplete,
-                                    weak_factory_.GetWeakPtr()));
+  int rv = Read();
   UMA_HISTOGRAM_BOOLEAN("Net.QuicSession.AsyncRead", rv == ERR_IO_PENDING);
   if (rv == ERR_IO_PENDING) {
     num_packets_read_ = 0;
     return;
   }
 
-  if (++num_packets_read_ > yield_after_packets_ ||
+  num_packets_read_ += (batch_size_ > 1 && rv > 0) ? rv : 1;
+  if (num_packets_read_ > yield_after_packets_ ||
       clock_->Now() > yield_after_) {
     num_packets_read_ = 0;
     // Data was read, process it.
@@ -66,6 +66,30 @@ void QuicChromiumPacketReader::StartReading() {
   }
 }
 
+void QuicChromiumPacketReader::SetBatchSize(int batch_size) {
+  DCHECK(!read_pending_);
+  DCHECK_GT(batch_size, 0);
+  if (batch_size > 1 && !socket_->SupportsMultipleDatagrams())
+    batch_size = 1;
+  if (batch_size == batch_size_)
+    return;
+
+  batch_size_ = batch_size;
+  read_buffer_ = new IOBufferWithSize(
+      static_cast<size_t>(kMaxPacketSize) * batch_size_);
+}
+
+int QuicChromiumPacketReader::Read() {
+  CompletionCallback callback =
+      base::Bind(&QuicChromiumPacketReader::OnReadComplete,
+                 weak_factory_.GetWeakPtr());
+  if (batch_size_ == 1)
+    return socket_->Read(read_buffer_.get(), read_buffer_->size(), callback);
+  return socket_->ReadMultiple(read_buffer_.get(),
+                               static_cast<int>(kMaxPacketSize), batch_size_,
+                               &read_sizes_, callback);
+}
+
 void QuicChromiumPacketReader::OnReadComplete(int result) {
   read_pending_ = false;
   if (result == 0)
@@ -76,15 +100,32 @@ void QuicChromiumPacketReader::OnReadComplete(int result) {
     return;
   }
 
-  QuicReceivedPacket packet(read_buffer_->data(), result, clock_->Now());
+  if (batch_size_ == 1) {
+    if (!ProcessPacket(read_buffer_->data(), result))
+      return;
+  } else {
+    DCHECK_EQ(static_cast<size_t>(result), read_sizes_.size());
+    for (int i = 0; i < result; ++i) {
+      // Empty datagrams carry no QUIC packet.
+      if (read_sizes_[i] == 0)
+        continue;
+      if (!ProcessPacket(read_buffer_->data() + i * kMaxPacketSize,
+                         read_sizes_[i])) {
+        return;
+      }
+    }
+  }
+
+  StartReading();
+}
+
+bool QuicChromiumPacketReader::ProcessPacket(const char* data, int size) {
+  QuicReceivedPacket packet(data, size, clock_->Now());
   IPEndPoint local_address;
   IPEndPoint peer_address;
   socket_->GetLocalAddress(&local_address);
   socket_->GetPeerAddress(&peer_address);
-  if (!visitor_->OnPacket(packet, local_address, peer_address))
-    return;
-
-  StartReading();
+  return visitor_->OnPacket(packet, local_address, peer_address);
 }
 
 }  // namespace net
@@ -6,6 +6,8 @@
 #ifndef NET_QUIC_QUIC_CHROMIUM_PACKET_READER_H_
 #define NET_QUIC_QUIC_CHROMIUM_PACKET_READER_H_
 
+#include <vector>
+
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "net/base/io_buffer.h"
@@ -25,6 +27,10 @@ class QuicClock;
 const int kQuicYieldAfterPacketsRead = 32;
 const int kQuicYieldAfterDurationMilliseconds = 20;
 
+// Default number of packets read by a single socket read. 1 disables batched
+// reads.
+const int kQuicDefaultPacketBatchSize = 1;
+
 class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
  public:
   class NET_EXPORT_PRIVATE Visitor {
@@ -49,10 +55,23 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
   // and passing the data along to the QuicConnection.
   void StartReading();
 
+  // Reads up to |batch_size| packets with each socket read, if the socket
+  // supports DatagramClientSocket::ReadMultiple(). Must not be called while a
+  // read is pending.
+  void SetBatchSize(int batch_size);
+
  private:
-  // A completion callback invoked when a read completes.
+  // Reads one packet, or a batch of them, into |read_buffer_|.
+  int Read();
+
+  // A completion callback invoked when a read completes. |result| is a number
+  // of packets for batched reads, and a number of bytes otherwise.
   void OnReadComplete(int result);
 
+  // Passes a packet to |visitor_|. Returns false if the visitor is done with
+  // the reader.
+  bool ProcessPacket(const char* data, int size);
+
   DatagramClientSocket* socket_;
   Visitor* visitor_;
   bool read_pending_;
@@ -61,7 +80,10 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
   int yield_after_packets_;
   QuicTime::Delta yield_after_duration_;
   QuicTime yield_after_;
+  int batch_size_;
   scoped_refptr<IOBufferWithSize> read_buffer_;
+  // The size of the packets of the last batched read.
+  std::vector<int> read_sizes_;
   BoundNetLog net_log_;
 
   base::WeakPtrFactory<QuicChromiumPacketReader> weak_factory_;
@@ -4,21 +4,44 @@
 
 #include "net/quic/quic_chromium_packet_writer.h"
 
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/metrics/sparse_histogram.h"
+#include "base/single_thread_task_runner.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "net/base/io_buffer.h"
 #include "net/base/net_errors.h"
 
 namespace net {
 
-QuicChromiumPacketWriter::QuicChromiumPacketWriter() : weak_factory_(this) {}
+QuicChromiumPacketWriter::QuicChromiumPacketWriter()
+    : batch_socket_(NULL), batch_size_(1), weak_factory_(this) {}
 
 QuicChromiumPacketWriter::QuicChromiumPacketWriter(Socket* socket)
-    : socket_(socket), write_blocked_(false), weak_factory_(this) {}
+    : socket_(socket),
+      batch_socket_(NULL),
+      batch_size_(1),
+      write_blocked_(false),
+      weak_factory_(this) {}
+
+QuicChromiumPacketWriter::QuicChromiumPacketWriter(
+    DatagramClientSocket* socket,
+    int batch_size)
+    : socket_(socket),
+      batch_socket_(NULL),
+      batch_size_(1),
+      write_blocked_(false),
+      weak_factory_(this) {
+  if (batch_size > 1 && socket->SupportsMultipleDatagrams()) {
+    batch_socket_ = socket;
+    batch_size_ = batch_size;
+  }
+}
 
 QuicChromiumPacketWriter::~QuicChromiumPacketWriter() {}
 
@@ -28,13 +51,65 @@ WriteResult QuicChromiumPacketWriter::WritePacket(
     const IPAddress& self_address,
     const IPEndPoint& peer_address,
     PerPacketOptions* /*options*/) {
+  DCHECK(!IsWriteBlocked());
+  if (batch_socket_) {
+    batch_data_.append(buffer, buf_len);
+    batch_sizes_.push_back(static_cast<int>(buf_len));
+    if (batch_sizes_.size() < batch_size_) {
+      if (batch_sizes_.size() == 1) {
+        base::ThreadTaskRunnerHandle::Get()->PostTask(
+            FROM_HERE,
+            base::Bind(&QuicChromiumPacketWriter::FlushBatch,
+                       weak_factory_.GetWeakPtr()));
+      }
+      return WriteResult(WRITE_STATUS_OK, buf_len);
+    }
+    WriteResult result = WriteBatch();
+    if (result.status == WRITE_STATUS_OK)
+      result.bytes_written = buf_len;
+    return result;
+  }
+
   scoped_refptr<StringIOBuffer> buf(
       new StringIOBuffer(std::string(buffer, buf_len)));
-  DCHECK(!IsWriteBlocked());
   base::TimeTicks now = base::TimeTicks::Now();
   int rv = socket_->Write(buf.get(), buf_len,
                           base::Bind(&QuicChromiumPacketWriter::OnWriteComplete,
                                      weak_factory_.GetWeakPtr()));
+  return ToWriteResult(rv, now);
+}
+
+WriteResult QuicChromiumPacketWriter::WriteBatch() {
+  DCHECK(!batch_sizes_.empty());
+  std::unique_ptr<std::string> data(new std::string());
+  data->swap(batch_data_);
+  scoped_refptr<StringIOBuffer> buf(new StringIOBuffer(std::move(data)));
+  std::vector<int> sizes;
+  sizes.swap(batch_sizes_);
+
+  UMA_HISTOGRAM_COUNTS_100("Net.QuicSession.PacketWriteBatchSize",
+                           sizes.size());
+  base::TimeTicks now = base::TimeTicks::Now();
+  int rv = batch_socket_->WriteMultiple(
+      buf.get(), sizes, base::Bind(&QuicChromiumPacketWriter::OnWriteComplete,
+                                   weak_factory_.GetWeakPtr()));
+  return ToWriteResult(rv, now);
+}
+
+void QuicChromiumPacketWriter::FlushBatch() {
+  if (batch_sizes_.empty())
+    return;
+
+  // The packets were reported as written, so errors go to the connection as
+  // for asynchronous writes.
+  WriteResult result = WriteBatch();
+  if (result.status == WRITE_STATUS_ERROR)
+    connection_->OnWriteError(result.error_code);
+}
+
+WriteResult QuicChromiumPacketWriter::ToWriteResult(
+    int rv,
+    base::TimeTicks start_time) {
   WriteStatus status = WRITE_STATUS_OK;
   if (rv < 0) {
     if (rv != ERR_IO_PENDING) {
@@ -46,7 +121,7 @@ WriteResult QuicChromiumPacketWriter::WritePacket(
     }
   }
 
-  base::TimeDelta delta = base::TimeTicks::Now() - now;
+  base::TimeDelta delta = base::TimeTicks::Now() - start_time;
   if (status == WRITE_STATUS_OK) {
     UMA_HISTOGRAM_TIMES("Net.QuicSession.PacketWriteTime.Synchronous", delta);
   } else if (status == WRITE_STATUS_BLOCKED) {
@@ -7,6 +7,9 @@
 
 #include <stddef.h>
 
+#include <string>
+#include <vector>
+
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "net/base/ip_endpoint.h"
@@ -23,6 +26,10 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketWriter : public QuicPacketWriter {
  public:
   QuicChromiumPacketWriter();
   explicit QuicChromiumPacketWriter(Socket* socket);
+  // If |socket| supports DatagramClientSocket::WriteMultiple(), the packets
+  // written during a task are sent together at the end of the task, or as soon
+  // as |batch_size| of them are waiting.
+  QuicChromiumPacketWriter(DatagramClientSocket* socket, int batch_size);
   ~QuicChromiumPacketWriter() override;
 
   // QuicPacketWriter
@@ -43,9 +50,27 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketWriter : public QuicPacketWriter {
   void set_write_blocked(bool is_blocked) { write_blocked_ = is_blocked; }
 
  private:
+  // Sends the waiting packets with a single WriteMultiple() call.
+  WriteResult WriteBatch();
+
+  // Sends the waiting packets at the end of the task which wrote them. Packets
+  // still waiting when the writer is deleted are dropped.
+  void FlushBatch();
+
+  // Maps the result of a socket write started at |start_time|.
+  WriteResult ToWriteResult(int rv, base::TimeTicks start_time);
+
   Socket* socket_;
   QuicConnection* connection_;
 
+  // |socket_| if packets are written by batches, NULL otherwise.
+  DatagramClientSocket* batch_socket_;
+  size_t batch_size_;
+
+  // The packets waiting to be sent, back to back, and their sizes.
+  std::string batch_data_;
+  std::vector<int> batch_sizes_;
+
   // Whether a write is currently in flight.
   bool write_blocked_;
 
@@ -0,0 +1,318 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Benchmarks of the QUIC packet path: serializing packets with
+// QuicPacketCreator, encrypting and parsing them with QuicFramer, and
+// processing acks in QuicSentPacketManager. Each benchmark runs on a packet
+// mix and reports the packets processed per second and, when the allocator
+// shim is enabled, the allocations made per packet.
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "base/test/perf_log.h"
+#include "base/time/time.h"
+#include "net/quic/crypto/aes_128_gcm_12_decrypter.h"
+#include "net/quic/crypto/aes_128_gcm_12_encrypter.h"
+#include "net/quic/crypto/null_decrypter.h"
+#include "net/quic/crypto/null_encrypter.h"
+#include "net/quic/quic_connection_stats.h"
+#include "net/quic/quic_framer.h"
+#include "net/quic/quic_packet_creator.h"
+#include "net/quic/quic_protocol.h"
+#include "net/quic/quic_sent_packet_manager.h"
+#include "net/quic/quic_simple_buffer_allocator.h"
+#include "net/quic/quic_utils.h"
+#include "net/quic/test_tools/mock_clock.h"
+#include "net/quic/test_tools/mock_random.h"
+#include "net/quic/test_tools/quic_test_utils.h"
+#include "net/test/scoped_allocation_counter.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using base::StringPiece;
+using std::string;
+
+namespace net {
+namespace test {
+namespace {
+
+const QuicConnectionId kConnectionId = 42;
+const QuicStreamId kFirstStreamId = 5;
+
+// Number of times a packet mix is processed by a benchmark.
+const int kIterations = 20;
+
+// Sizes of the packet mixes.
+const size_t kLargeStreamFramesBytes = 1 << 20;
+const size_t kNumSmallStreams = 2000;
+const size_t kSmallStreamBytes = 40;
+const size_t kNumAckFrames = 2000;
+const size_t kNumAckBlocks = 30;
+
+// Logs the rate of |num_packets| processed in |elapsed| and the allocations
+// made for them.
+void ReportResults(const string& name,
+                   size_t num_packets,
+                   base::TimeDelta elapsed,
+                   const ScopedAllocationCounter& allocation_counter) {
+  base::LogPerfResult((name + "_packets_per_second").c_str(),
+                      num_packets / elapsed.InSecondsF(), "packets/s");
+  if (ScopedAllocationCounter::IsSupported()) {
+    base::LogPerfResult(
+        (name + "_allocations_per_packet").c_str(),
+        static_cast<double>(allocation_counter.GetAllocationCount()) /
+            num_packets,
+        "allocations");
+  }
+}
+
+// Stores or drops the packets serialized by a QuicPacketCreator.
+class PacketCollector : public QuicPacketCreator::DelegateInterface {
+ public:
+  PacketCollector() : save_packets_(true), num_packets_(0) {}
+  ~PacketCollector() override {}
+
+  // QuicPacketCreator::DelegateInterface:
+  void OnSerializedPacket(SerializedPacket* packet) override {
+    ++num_packets_;
+    if (save_packets_) {
+      packets_.push_back(
+          string(packet->encrypted_buffer, packet->encrypted_length));
+    }
+    QuicUtils::ClearSerializedPacket(packet);
+  }
+  void OnUnrecoverableError(QuicErrorCode error,
+                            const string& error_details,
+                            ConnectionCloseSource source) override {
+    ADD_FAILURE() << error_details;
+  }
+
+  void set_save_packets(bool save_packets) { save_packets_ = save_packets; }
+
+  const std::vector<string>& packets() const { return packets_; }
+
+  size_t num_packets() const { return num_packets_; }
+
+ private:
+  bool save_packets_;
+  std::vector<string> packets_;
+  size_t num_packets_;
+
+  DISALLOW_COPY_AND_ASSIGN(PacketCollector);
+};
+
+class QuicPacketPerfTest : public ::testing::Test {
+ public:
+  QuicPacketPerfTest()
+      : client_framer_(SupportedVersions(QuicSupportedVersions().front()),
+                       QuicTime::Zero(),
+                       Perspective::IS_CLIENT),
+        server_framer_(SupportedVersions(QuicSupportedVersions().front()),
+                       QuicTime::Zero(),
+                       Perspective::IS_SERVER),
+        creator_(kConnectionId,
+                 &client_framer_,
+                 &random_,
+                 &buffer_allocator_,
+                 &collector_),
+        data_(kLargeStreamFramesBytes, 'x'),
+        stream_offset_(0) {
+    server_framer_.set_visitor(&visitor_);
+    creator_.StopSendingVersion();
+    creator_.set_encryption_level(ENCRYPTION_FORWARD_SECURE);
+    UseNullEncryption();
+  }
+
+  void UseNullEncryption() {
+    creator_.SetEncrypter(ENCRYPTION_FORWARD_SECURE, new NullEncrypter());
+    server_framer_.SetDecrypter(ENCRYPTION_FORWARD_SECURE, new NullDecrypter());
+  }
+
+  void UseAes128Gcm12Encryption() {
+    const string key(16, 'k');
+    const string nonce_prefix(4, 'n');
+    Aes128Gcm12Encrypter* encrypter = new Aes128Gcm12Encrypter();
+    ASSERT_TRUE(encrypter->SetKey(key));
+    ASSERT_TRUE(encrypter->SetNoncePrefix(nonce_prefix));
+    Aes128Gcm12Decrypter* decrypter = new Aes128Gcm12Decrypter();
+    ASSERT_TRUE(decrypter->SetKey(key));
+    ASSERT_TRUE(decrypter->SetNoncePrefix(nonce_prefix));
+    creator_.SetEncrypter(ENCRYPTION_FORWARD_SECURE, encrypter);
+    server_framer_.SetDecrypter(ENCRYPTION_FORWARD_SECURE, decrypter);
+  }
+
+  // Serializes |kLargeStreamFramesBytes| of a single stream into full-sized
+  // packets.
+  void SerializeLargeStreamFrames() {
+    char encrypted_buffer[kMaxPacketSize];
+    struct iovec iov;
+    QuicIOVector io_vector(MakeIOVector(data_, &iov));
+    size_t offset = 0;
+    while (offset < data_.size()) {
+      size_t bytes_consumed = 0;
+      creator_.CreateAndSerializeStreamFrame(
+          kFirstStreamId, io_vector, offset, stream_offset_, true, nullptr,
+          encrypted_buffer, kMaxPacketSize, &bytes_consumed);
+      ASSERT_LT(0u, bytes_consumed);
+      offset += bytes_consumed;
+      stream_offset_ += bytes_consumed;
+    }
+  }
+
+  // Serializes the requests of |kNumSmallStreams| streams, packed together.
+  void SerializeSmallStreams() {
+    struct iovec iov;
+    QuicIOVector io_vector(
+        MakeIOVector(StringPiece(data_.data(), kSmallStreamBytes), &iov));
+    for (size_t i = 0; i < kNumSmallStreams; ++i) {
+      QuicStreamId id = kFirstStreamId + 2 * static_cast<QuicStreamId>(i);
+      QuicFrame frame;
+      if (!creator_.ConsumeData(id, io_vector, 0, 0, true, false, &frame)) {
+        // The packet was full and has been flushed.
+        ASSERT_TRUE(
+            creator_.ConsumeData(id, io_vector, 0, 0, true, false, &frame));
+      }
+    }
+    creator_.Flush();
+  }
+
+  // Serializes |kNumAckFrames| packets with an ack of |kNumAckBlocks| blocks
+  // each.
+  void SerializeAcks() {
+    for (size_t i = 0; i < kNumAckFrames; ++i) {
+      QuicAckFrame ack = MakeAckFrameWithAckBlocks(kNumAckBlocks, 1 + i);
+      ASSERT_TRUE(creator_.AddSavedFrame(QuicFrame(&ack)));
+      creator_.Flush();
+    }
+  }
+
+  void RunSerializeBenchmark(const string& name,
+                             void (QuicPacketPerfTest::*serialize)()) {
+    collector_.set_save_packets(false);
+    size_t packets_before = collector_.num_packets();
+    ScopedAllocationCounter allocation_counter;
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kIterations; ++i)
+      (this->*serialize)();
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    ReportResults(name, collector_.num_packets() - packets_before, elapsed,
+                  allocation_counter);
+  }
+
+  void RunProcessBenchmark(const string& name,
+                           void (QuicPacketPerfTest::*serialize)()) {
+    collector_.set_save_packets(true);
+    (this->*serialize)();
+    const std::vector<string>& packets = collector_.packets();
+    ASSERT_FALSE(packets.empty());
+
+    ScopedAllocationCounter allocation_counter;
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kIterations; ++i) {
+      for (const string& packet : packets) {
+        QuicEncryptedPacket encrypted_packet(packet.data(), packet.size());
+        ASSERT_TRUE(server_framer_.ProcessPacket(encrypted_packet));
+      }
+    }
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    ReportResults(name, kIterations * packets.size(), elapsed,
+                  allocation_counter);
+  }
+
+ protected:
+  MockRandom random_;
+  SimpleBufferAllocator buffer_allocator_;
+  NoOpFramerVisitor visitor_;
+  PacketCollector collector_;
+  QuicFramer client_framer_;
+  QuicFramer server_framer_;
+  QuicPacketCreator creator_;
+  const string data_;
+  QuicStreamOffset stream_offset_;
+};
+
+TEST_F(QuicPacketPerfTest, SerializeLargeStreamFrames) {
+  RunSerializeBenchmark("QuicPacketCreator_LargeStreamFrames",
+                        &QuicPacketPerfTest::SerializeLargeStreamFrames);
+}
+
+TEST_F(QuicPacketPerfTest, SerializeLargeStreamFramesAes128Gcm12) {
+  UseAes128Gcm12Encryption();
+  RunSerializeBenchmark("QuicPacketCreator_LargeStreamFrames_AES128GCM12",
+                        &QuicPacketPerfTest::SerializeLargeStreamFrames);
+}
+
+TEST_F(QuicPacketPerfTest, SerializeSmallStreams) {
+  RunSerializeBenchmark("QuicPacketCreator_SmallStreams",
+                        &QuicPacketPerfTest::SerializeSmallStreams);
+}
+
+TEST_F(QuicPacketPerfTest, SerializeAcks) {
+  RunSerializeBenchmark("QuicPacketCreator_Acks",
+                        &QuicPacketPerfTest::SerializeAcks);
+}
+
+TEST_F(QuicPacketPerfTest, ProcessLargeStreamFrames) {
+  RunProcessBenchmark("QuicFramer_LargeStreamFrames",
+                      &QuicPacketPerfTest::SerializeLargeStreamFrames);
+}
+
+TEST_F(QuicPacketPerfTest, ProcessLargeStreamFramesAes128Gcm12) {
+  UseAes128Gcm12Encryption();
+  RunProcessBenchmark("QuicFramer_LargeStreamFrames_AES128GCM12",
+                      &QuicPacketPerfTest::SerializeLargeStreamFrames);
+}
+
+TEST_F(QuicPacketPerfTest, ProcessSmallStreams) {
+  RunProcessBenchmark("QuicFramer_SmallStreams",
+                      &QuicPacketPerfTest::SerializeSmallStreams);
+}
+
+TEST_F(QuicPacketPerfTest, ProcessAcks) {
+  RunProcessBenchmark("QuicFramer_Acks", &QuicPacketPerfTest::SerializeAcks);
+}
+
+// Sends packets of retransmittable data and acks them two at a time, as a
+// receiver using delayed acks does.
+TEST_F(QuicPacketPerfTest, SentPacketManagerAcks) {
+  const QuicPacketNumber kNumPackets = 20000;
+  MockClock clock;
+  clock.AdvanceTime(QuicTime::Delta::FromSeconds(1));
+  QuicConnectionStats stats;
+  QuicSentPacketManager manager(Perspective::IS_CLIENT, kDefaultPathId, &clock,
+                                &stats, kCubic, kNack,
+                                /*delegate=*/nullptr);
+
+  ScopedAllocationCounter allocation_counter;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (QuicPacketNumber packet_number = 1; packet_number <= kNumPackets;
+       ++packet_number) {
+    SerializedPacket packet(kDefaultPathId, packet_number,
+                            PACKET_6BYTE_PACKET_NUMBER, nullptr,
+                            kDefaultMaxPacketSize, 0u, false, false);
+    packet.retransmittable_frames.push_back(QuicFrame(new QuicStreamFrame(
+        kFirstStreamId, false, (packet_number - 1) * kDefaultMaxPacketSize,
+        StringPiece())));
+    manager.OnPacketSent(&packet, kInvalidPathId, 0, clock.Now(),
+                         NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA);
+    if (packet_number % 2 == 0) {
+      clock.AdvanceTime(QuicTime::Delta::FromMilliseconds(1));
+      QuicAckFrame ack = MakeAckFrame(packet_number);
+      ack.ack_delay_time = QuicTime::Delta::Zero();
+      manager.OnIncomingAck(ack, clock.Now());
+    }
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+  EXPECT_FALSE(manager.HasUnackedPackets());
+  ReportResults("QuicSentPacketManager_Acks", kNumPackets, elapsed,
+                allocation_counter);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
@@ -679,6 +679,7 @@ QuicStreamFactory::QuicStreamFactory(
       yield_after_packets_(kQuicYieldAfterPacketsRead),
       yield_after_duration_(QuicTime::Delta::FromMilliseconds(
           kQuicYieldAfterDurationMilliseconds)),
+      packet_batch_size_(kQuicDefaultPacketBatchSize),
       close_sessions_on_ip_change_(close_sessions_on_ip_change),
       migrate_sessions_on_network_change_(
           migrate_sessions_on_network_change &&
@@ -869,29 +870,8 @@ int QuicStreamFactory::Create(const QuicServerId& server_id,
     }
   }
 
-  // TODO(rtenneti): |task_runner_| is used by the Job. Initialize task_runner_
-  // in the constructor after WebRequestActionWithThreadsTest.* tests are fixed.
-  if (!task_runner_)
-    task_runner_ = base::ThreadTaskRunnerHandle::Get().get();
-
-  QuicServerInfo* quic_server_info = nullptr;
-  if (quic_server_info_factory_.get()) {
-    bool load_from_disk_cache = !disable_disk_cache_;
-    MaybeInitialize();
-    if (!ContainsKey(quic_supported_servers_at_startup_, destination)) {
-      // If there is no entry for QUIC, consider that as a new server and
-      // don't wait for Cache thread to load the data for that server.
-      load_from_disk_cache = false;
-    }
-    if (load_from_disk_cache && CryptoConfigCacheIsEmpty(server_id)) {
-      quic_server_info = quic_server_info_factory_->GetForServer(server_id);
-    }
-  }
-
   QuicSessionKey key(destination, server_id);
-  std::unique_ptr<Job> job(
-      new Job(this, host_resolver_, key, WasQuicRecentlyBroken(server_id),
-              cert_verify_flags, quic_server_info, net_log));
+  std::unique_ptr<Job> job(CreateJob(key, cert_verify_flags, net_log));
   int rv = job->Run(base::Bind(&QuicStreamFactory::OnJobComplete,
                                base::Unretained(this), job.get()));
   if (rv == ERR_IO_PENDING) {
@@ -932,6 +912,51 @@ bool QuicStreamFactory::QuicSessionKey::operator==(
          server_id_ == other.server_id_;
 }
 
+void QuicStreamFactory::PreconnectToOrigins(
+    const std::vector<HostPortPair>& origins) {
+  for (const HostPortPair& origin : origins) {
+    QuicServerId server_id(origin, PRIVACY_MODE_DISABLED);
+    if (HasActiveSession(server_id) || HasActiveJob(server_id))
+      continue;
+
+    std::unique_ptr<Job> job(
+        CreateJob(QuicSessionKey(origin, server_id), 0,
+                  BoundNetLog::Make(net_log_, NetLog::SOURCE_NONE)));
+    int rv = job->Run(base::Bind(&QuicStreamFactory::OnJobComplete,
+                                 base::Unretained(this), job.get()));
+    if (rv == ERR_IO_PENDING)
+      active_jobs_[server_id].insert(job.release());
+  }
+}
+
+QuicStreamFactory::Job* QuicStreamFactory::CreateJob(
+    const QuicSessionKey& key,
+    int cert_verify_flags,
+    const BoundNetLog& net_log) {
+  // TODO(rtenneti): |task_runner_| is used by the Job. Initialize task_runner_
+  // in the constructor after WebRequestActionWithThreadsTest.* tests are fixed.
+  if (!task_runner_)
+    task_runner_ = base::ThreadTaskRunnerHandle::Get().get();
+
+  const QuicServerId& server_id = key.server_id();
+  QuicServerInfo* quic_server_info = nullptr;
+  if (quic_server_info_factory_.get()) {
+    bool load_from_disk_cache = !disable_disk_cache_;
+    MaybeInitialize();
+    if (!ContainsKey(quic_supported_servers_at_startup_, key.destination())) {
+      // If there is no entry for QUIC, consider that as a new server and
+      // don't wait for Cache thread to load the data for that server.
+      load_from_disk_cache = false;
+    }
+    if (load_from_disk_cache && CryptoConfigCacheIsEmpty(server_id)) {
+      quic_server_info = quic_server_info_factory_->GetForServer(server_id);
+    }
+  }
+
+  return new Job(this, host_resolver_, key, WasQuicRecentlyBroken(server_id),
+                 cert_verify_flags, quic_server_info, net_log);
+}
+
 void QuicStreamFactory::CreateAuxilaryJob(const QuicSessionKey& key,
                                           int cert_verify_flags,
                                           const BoundNetLog& net_log) {
@@ -1497,8 +1522,9 @@ void QuicStreamFactory::MigrateSessionToNetwork(
       new QuicChromiumPacketReader(socket.get(), clock_.get(), session,
                                    yield_after_packets_, yield_after_duration_,
                                    session->net_log()));
+  new_reader->SetBatchSize(packet_batch_size_);
   std::unique_ptr<QuicPacketWriter> new_writer(
-      new QuicChromiumPacketWriter(socket.get()));
+      new QuicChromiumPacketWriter(socket.get(), packet_batch_size_));
 
   if (!session->MigrateToSocket(std::move(socket), std::move(new_reader),
                                 std::move(new_writer))) {
@@ -1658,7 +1684,8 @@ int QuicStreamFactory::CreateSession(
   QuicConnectionId connection_id = random_generator_->RandUint64();
   InitializeCachedStateInCryptoConfig(server_id, server_info, &connection_id);
 
-  QuicChromiumPacketWriter* writer = new QuicChromiumPacketWriter(socket.get());
+  QuicChromiumPacketWriter* writer =
+      new QuicChromiumPacketWriter(socket.get(), packet_batch_size_);
   QuicConnection* connection = new QuicConnection(
       connection_id, addr, helper_.get(), alarm_factory_.get(), writer,
       true /* owns_writer */, Perspective::IS_CLIENT, supported_versions_);
@@ -1702,6 +1729,8 @@ int QuicStreamFactory::CreateSession(
       base::ThreadTaskRunnerHandle::Get().get(),
       std::move(socket_performance_watcher), net_log.net_log());
 
+  (*session)->SetReadBatchSize(packet_batch_size_);
+
   all_sessions_[*session] = key;  // owning pointer
 
   (*session)->Initialize();
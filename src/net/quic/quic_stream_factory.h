@@ -209,6 +209,13 @@ class NET_EXPORT_PRIVATE QuicStreamFactory
              const BoundNetLog& net_log,
              QuicStreamRequest* request);
 
+  // Starts QUIC sessions to those of |origins| which have neither a session
+  // nor a pending job, so that the first requests to them don't wait for a
+  // handshake. Meant to be called when the embedder is idle after startup,
+  // with the origins it is about to load. The handshakes are 0-RTT for the
+  // servers whose configs were persisted in HttpServerProperties.
+  void PreconnectToOrigins(const std::vector<HostPortPair>& origins);
+
   // If |packet_loss_rate| is greater than or equal to |packet_loss_threshold_|
   // it marks QUIC as recently broken for the port of the session. Increments
   // |number_of_lossy_connections_| by port. If |number_of_lossy_connections_|
@@ -346,6 +353,12 @@ class NET_EXPORT_PRIVATE QuicStreamFactory
     enable_connection_racing_ = enable_connection_racing;
   }
 
+  // Sets the number of packets read or written by a single socket call, for
+  // the sockets which support it. 1 disables batching.
+  void set_packet_batch_size(int packet_batch_size) {
+    packet_batch_size_ = packet_batch_size;
+  }
+
   int socket_receive_buffer_size() const { return socket_receive_buffer_size_; }
 
   bool delay_tcp_race() const { return delay_tcp_race_; }
@@ -376,6 +389,12 @@ class NET_EXPORT_PRIVATE QuicStreamFactory
     DISABLED  // No more streams may be created until the network changes.
   };
 
+  // Creates a job for |key|, which waits for the server config to be loaded
+  // from the disk cache if the server was known to support QUIC at startup.
+  Job* CreateJob(const QuicSessionKey& key,
+                 int cert_verify_flags,
+                 const BoundNetLog& net_log);
+
   // Creates a job which doesn't wait for server config to be loaded from the
   // disk cache. This job is started via a PostTask.
   void CreateAuxilaryJob(const QuicSessionKey& key,
@@ -549,6 +568,9 @@ class NET_EXPORT_PRIVATE QuicStreamFactory
   int yield_after_packets_;
   QuicTime::Delta yield_after_duration_;
 
+  // Number of packets read or written by a single socket call.
+  int packet_batch_size_;
+
   // Set if all sessions should be closed when any local IP address changes.
   const bool close_sessions_on_ip_change_;
 
@@ -144,6 +144,16 @@ int QuicStreamSequencer::Readv(const struct iovec* iov, size_t iov_len) {
   return static_cast<int>(bytes_read);
 }
 
+scoped_refptr<IOBuffer> QuicStreamSequencer::ReadAsIOBuffer(
+    size_t max_bytes,
+    size_t* bytes_read) {
+  DCHECK(!blocked_);
+  scoped_refptr<IOBuffer> buffer =
+      buffered_frames_.ReadAsIOBuffer(max_bytes, bytes_read);
+  stream_->AddBytesConsumed(*bytes_read);
+  return buffer;
+}
+
 bool QuicStreamSequencer::HasBytesToRead() const {
   return buffered_frames_.HasBytesToRead();
 }
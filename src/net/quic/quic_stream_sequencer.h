@@ -60,6 +60,11 @@ class NET_EXPORT_PRIVATE QuicStreamSequencer {
   // to do zero-copy reads.
   void MarkConsumed(size_t num_bytes);
 
+  // Consumes up to |max_bytes| bytes and returns them in an IOBuffer which
+  // points into the sequencer's buffer, instead of copying them like Readv().
+  // Stores the number of bytes consumed in |bytes_read|.
+  scoped_refptr<IOBuffer> ReadAsIOBuffer(size_t max_bytes, size_t* bytes_read);
+
   // Returns true if the sequncer has bytes available for reading.
   bool HasBytesToRead() const;
 
@@ -20,6 +20,21 @@ string RangeDebugString(QuicStreamOffset start, QuicStreamOffset end) {
          base::Uint64ToString(end) + ") ";
 }
 
+// An IOBuffer pointing into a block, which it keeps alive.
+class BlockIOBuffer : public WrappedIOBuffer {
+ public:
+  BlockIOBuffer(QuicStreamSequencerBuffer::BufferBlock* block,
+                size_t offset_in_block)
+      : WrappedIOBuffer(block->buffer + offset_in_block), block_(block) {}
+
+ private:
+  ~BlockIOBuffer() override {}
+
+  scoped_refptr<QuicStreamSequencerBuffer::BufferBlock> block_;
+
+  DISALLOW_COPY_AND_ASSIGN(BlockIOBuffer);
+};
+
 }  // namespace
 
 QuicStreamSequencerBuffer::Gap::Gap(QuicStreamOffset begin_offset,
@@ -63,7 +78,6 @@ void QuicStreamSequencerBuffer::Clear() {
 
 void QuicStreamSequencerBuffer::RetireBlock(size_t idx) {
   DCHECK(blocks_[idx] != nullptr);
-  delete blocks_[idx];
   blocks_[idx] = nullptr;
   DVLOG(1) << "Retired block with index: " << idx;
 }
@@ -154,6 +168,13 @@ QuicErrorCode QuicStreamSequencerBuffer::OnStreamData(
       // TODO(danzh): Investigate if using a freelist would improve performance.
       // Same as RetireBlock().
       blocks_[write_block_num] = new BufferBlock();
+    } else if (!blocks_[write_block_num]->HasOneRef()) {
+      // An IOBuffer returned by ReadAsIOBuffer() still points to the consumed
+      // data this write may overwrite, so write into a copy of the block.
+      scoped_refptr<BufferBlock> block(new BufferBlock());
+      memcpy(block->buffer, blocks_[write_block_num]->buffer,
+             GetBlockCapacity(write_block_num));
+      blocks_[write_block_num] = block;
     }
 
     const size_t bytes_to_copy = min<size_t>(bytes_avail, source_remaining);
@@ -221,7 +242,7 @@ size_t QuicStreamSequencerBuffer::Readv(const iovec* dest_iov,
       size_t bytes_to_copy =
           min<size_t>(bytes_available_in_block, dest_remaining);
       DCHECK_GT(bytes_to_copy, 0u);
-      DCHECK_NE(static_cast<BufferBlock*>(nullptr), blocks_[block_idx]);
+      DCHECK_NE(static_cast<BufferBlock*>(nullptr), blocks_[block_idx].get());
       memcpy(dest, blocks_[block_idx]->buffer + start_offset_in_block,
              bytes_to_copy);
       dest += bytes_to_copy;
@@ -283,7 +304,7 @@ int QuicStreamSequencerBuffer::GetReadableRegions(struct iovec* iov,
   int iov_used = 1;
   size_t block_idx = (start_block_idx + iov_used) % blocks_count_;
   while (block_idx != end_block_idx && iov_used < iov_count) {
-    DCHECK_NE(static_cast<BufferBlock*>(nullptr), blocks_[block_idx]);
+    DCHECK_NE(static_cast<BufferBlock*>(nullptr), blocks_[block_idx].get());
     iov[iov_used].iov_base = blocks_[block_idx]->buffer;
     iov[iov_used].iov_len = GetBlockCapacity(block_idx);
     DVLOG(1) << "Got block with index: " << block_idx;
@@ -293,7 +314,7 @@ int QuicStreamSequencerBuffer::GetReadableRegions(struct iovec* iov,
 
   // Deal with last block if |iov| can hold more.
   if (iov_used < iov_count) {
-    DCHECK_NE(static_cast<BufferBlock*>(nullptr), blocks_[block_idx]);
+    DCHECK_NE(static_cast<BufferBlock*>(nullptr), blocks_[block_idx].get());
     iov[iov_used].iov_base = blocks_[end_block_idx]->buffer;
     iov[iov_used].iov_len = end_block_offset + 1;
     DVLOG(1) << "Got last block with index: " << end_block_idx;
@@ -367,6 +388,25 @@ bool QuicStreamSequencerBuffer::MarkConsumed(size_t bytes_used) {
   return true;
 }
 
+scoped_refptr<IOBuffer> QuicStreamSequencerBuffer::ReadAsIOBuffer(
+    size_t max_bytes,
+    size_t* bytes_read) {
+  *bytes_read = 0;
+  if (ReadableBytes() == 0 || max_bytes == 0) {
+    return nullptr;
+  }
+  size_t block_idx = NextBlockToRead();
+  size_t offset_in_block = ReadOffset();
+  size_t bytes_available = min<size_t>(
+      ReadableBytes(), GetBlockCapacity(block_idx) - offset_in_block);
+  DCHECK_NE(static_cast<BufferBlock*>(nullptr), blocks_[block_idx].get());
+  scoped_refptr<IOBuffer> buffer(
+      new BlockIOBuffer(blocks_[block_idx].get(), offset_in_block));
+  *bytes_read = min<size_t>(bytes_available, max_bytes);
+  MarkConsumed(*bytes_read);
+  return buffer;
+}
+
 size_t QuicStreamSequencerBuffer::FlushBufferedFrames() {
   size_t prev_total_bytes_read = total_bytes_read_;
   total_bytes_read_ = gaps_.back().begin_offset;
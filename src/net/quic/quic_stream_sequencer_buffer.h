@@ -59,6 +59,11 @@
 //  consumed.
 //  size_t consumed = consume_iovs(iovs, iov_count);
 //  buffer.MarkConsumed(consumed);
+//
+//  // Consume up to 1024 bytes of the next readable region without copying
+//  // them. The returned IOBuffer keeps the memory it points to alive.
+//  size_t bytes_read;
+//  scoped_refptr<IOBuffer> data = buffer.ReadAsIOBuffer(1024, &bytes_read);
 
 #include <stddef.h>
 
@@ -67,6 +72,8 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "net/base/io_buffer.h"
 #include "net/quic/quic_protocol.h"
 
 namespace net {
@@ -99,9 +106,22 @@ class NET_EXPORT_PRIVATE QuicStreamSequencerBuffer {
   // which could be up to 1.5 KB.
   static const size_t kBlockSizeBytes = 8 * 1024;  // 8KB
 
-  // The basic storage block used by this buffer.
-  struct BufferBlock {
+  // The basic storage block used by this buffer. Blocks are reference counted
+  // so that the IOBuffers returned by ReadAsIOBuffer() can outlive them in the
+  // buffer.
+  class NET_EXPORT_PRIVATE BufferBlock
+      : public base::RefCounted<BufferBlock> {
+   public:
+    BufferBlock() {}
+
     char buffer[kBlockSizeBytes];
+
+   private:
+    friend class base::RefCounted<BufferBlock>;
+
+    ~BufferBlock() {}
+
+    DISALLOW_COPY_AND_ASSIGN(BufferBlock);
   };
 
   explicit QuicStreamSequencerBuffer(size_t max_capacity_bytes);
@@ -148,6 +168,12 @@ class NET_EXPORT_PRIVATE QuicStreamSequencerBuffer {
   // Pre-requisite: bytes_used <= available bytes to read.
   bool MarkConsumed(size_t bytes_buffered);
 
+  // Consumes up to |max_bytes| bytes of the next readable region and returns
+  // an IOBuffer pointing to them in this buffer, so that they can be passed on
+  // without being copied. Stores the number of bytes consumed in |bytes_read|.
+  // Returns nullptr if there is nothing to read.
+  scoped_refptr<IOBuffer> ReadAsIOBuffer(size_t max_bytes, size_t* bytes_read);
+
   // Deletes and records as consumed any buffered data and clear the buffer.
   // (To be called only after sequencer's StopReading has been called.)
   size_t FlushBufferedFrames();
@@ -231,7 +257,7 @@ class NET_EXPORT_PRIVATE QuicStreamSequencerBuffer {
   // An ordered, variable-length list of blocks, with the length limited
   // such that the number of blocks never exceeds blocks_count_.
   // Each list entry can hold up to kBlockSizeBytes bytes.
-  std::vector<BufferBlock*> blocks_;
+  std::vector<scoped_refptr<BufferBlock>> blocks_;
 
   // Number of bytes in buffer.
   size_t num_bytes_buffered_;
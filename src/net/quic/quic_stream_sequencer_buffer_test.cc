@@ -128,7 +128,7 @@ class QuicStreamSequencerBufferPeer {
     return buffer_->GetInBlockOffset(offset);
   }
 
-  BufferBlock* GetBlock(size_t index) { return buffer_->blocks_[index]; }
+  BufferBlock* GetBlock(size_t index) { return buffer_->blocks_[index].get(); }
 
   int GapSize() { return buffer_->gaps_.size(); }
 
@@ -803,6 +803,81 @@ TEST_F(QuicStreamSequencerBufferTest, MarkConsumedAcrossEnd) {
   EXPECT_TRUE(helper_->CheckBufferInvariants());
 }
 
+TEST_F(QuicStreamSequencerBufferTest, ReadAsIOBuffer) {
+  string source(1024, 'a');
+  source += string(1024, 'b');
+  size_t written;
+  buffer_->OnStreamData(0, source, clock_.ApproximateNow(), &written,
+                        &error_details_);
+  size_t bytes_read;
+  scoped_refptr<IOBuffer> data = buffer_->ReadAsIOBuffer(1024, &bytes_read);
+  ASSERT_TRUE(data);
+  EXPECT_EQ(1024u, bytes_read);
+  EXPECT_EQ(string(1024, 'a'), string(data->data(), bytes_read));
+  EXPECT_EQ(helper_->GetBlock(0)->buffer, data->data());
+  EXPECT_EQ(1024u, buffer_->BytesConsumed());
+
+  data = buffer_->ReadAsIOBuffer(4096, &bytes_read);
+  ASSERT_TRUE(data);
+  EXPECT_EQ(1024u, bytes_read);
+  EXPECT_EQ(string(1024, 'b'), string(data->data(), bytes_read));
+  EXPECT_TRUE(buffer_->Empty());
+  EXPECT_FALSE(buffer_->ReadAsIOBuffer(1024, &bytes_read));
+  EXPECT_EQ(0u, bytes_read);
+  EXPECT_TRUE(helper_->CheckBufferInvariants());
+}
+
+TEST_F(QuicStreamSequencerBufferTest, ReadAsIOBufferStopsAtBlockEnd) {
+  string source(kBlockSizeBytes + 100, 'a');
+  size_t written;
+  buffer_->OnStreamData(0, source, clock_.ApproximateNow(), &written,
+                        &error_details_);
+  size_t bytes_read;
+  scoped_refptr<IOBuffer> data =
+      buffer_->ReadAsIOBuffer(2 * kBlockSizeBytes, &bytes_read);
+  ASSERT_TRUE(data);
+  EXPECT_EQ(kBlockSizeBytes, bytes_read);
+  // The first block is retired but still alive through |data|.
+  EXPECT_FALSE(helper_->GetBlock(0));
+  EXPECT_EQ(string(kBlockSizeBytes, 'a'), string(data->data(), bytes_read));
+  EXPECT_EQ(100u, helper_->ReadableBytes());
+  EXPECT_TRUE(helper_->CheckBufferInvariants());
+}
+
+TEST_F(QuicStreamSequencerBufferTest, ReadAsIOBufferCopiesBlockOnWrite) {
+  // Write into [0, 2.5 * kBlockSizeBytes - 1024) and then read out [0, 1024)
+  // without copying.
+  string source(2.5 * kBlockSizeBytes - 1024, 'a');
+  size_t written;
+  buffer_->OnStreamData(0, source, clock_.ApproximateNow(), &written,
+                        &error_details_);
+  size_t bytes_read;
+  scoped_refptr<IOBuffer> data = buffer_->ReadAsIOBuffer(1024, &bytes_read);
+  ASSERT_TRUE(data);
+  EXPECT_EQ(1024u, bytes_read);
+  BufferBlock* first_block = helper_->GetBlock(0);
+
+  // Wrap around into the consumed part of the first block, which must not
+  // change the data |data| points to.
+  source = string(1024 + 512, 'b');
+  buffer_->OnStreamData(2.5 * kBlockSizeBytes - 1024, source,
+                        clock_.ApproximateNow(), &written, &error_details_);
+  EXPECT_EQ(1024u + 512, written);
+  EXPECT_NE(first_block, helper_->GetBlock(0));
+  EXPECT_EQ(string(1024, 'a'), string(data->data(), bytes_read));
+
+  // The data still to read in the first block was copied along.
+  char dest[kBlockSizeBytes];
+  helper_->Read(dest, kBlockSizeBytes - 1024);
+  EXPECT_EQ(string(kBlockSizeBytes - 1024, 'a'),
+            string(dest, kBlockSizeBytes - 1024));
+  buffer_->MarkConsumed(kBlockSizeBytes + 0.5 * kBlockSizeBytes - 1024);
+  helper_->Read(dest, 1024 + 512);
+  EXPECT_EQ(string(1024 + 512, 'b'), string(dest, 1024 + 512));
+  EXPECT_TRUE(buffer_->Empty());
+  EXPECT_TRUE(helper_->CheckBufferInvariants());
+}
+
 TEST_F(QuicStreamSequencerBufferTest, FlushBufferedFrames) {
   // Write into [0, 2.5 * kBlockSizeBytes - 1024) and then read out [0, 1024).
   string source(max_capacity_bytes_ - 1024, 'a');
@@ -4,7 +4,9 @@
 
 #include "net/sdch/sdch_owner.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/debug/alias.h"
@@ -704,6 +706,19 @@ bool SdchOwner::SchedulePersistedDictionaryLoads(
   if (!persisted_info.GetDictionary(kDictionariesKey, &dictionary_set))
     return false;
 
+  struct PersistedDictionary {
+    GURL url;
+    base::Time last_used;
+    base::Time created_time;
+    int use_count;
+
+    // Most recently used first.
+    bool operator<(const PersistedDictionary& rhs) const {
+      return last_used > rhs.last_used;
+    }
+  };
+  std::vector<PersistedDictionary> persisted_dictionaries;
+
   // Any formatting error will result in skipping that particular
   // dictionary.
   for (base::DictionaryValue::Iterator dict_it(*dictionary_set);
@@ -729,12 +744,21 @@ bool SdchOwner::SchedulePersistedDictionaryLoads(
     if (!dict_info->GetDouble(kDictionaryCreatedTimeKey, &created_time))
       continue;
 
+    persisted_dictionaries.push_back(
+        {dict_url, base::Time::FromDoubleT(last_used),
+         base::Time::FromDoubleT(created_time), use_count});
+  }
+
+  // Reload the dictionaries most likely to be needed soon first, so that they
+  // are advertised as early as possible after startup.
+  std::sort(persisted_dictionaries.begin(), persisted_dictionaries.end());
+  for (const PersistedDictionary& dictionary : persisted_dictionaries) {
     fetcher_->ScheduleReload(
-        dict_url,
+        dictionary.url,
         base::Bind(&SdchOwner::OnDictionaryFetched,
                    // SdchOwner will outlive its member variables.
-                   base::Unretained(this), base::Time::FromDoubleT(last_used),
-                   base::Time::FromDoubleT(created_time), use_count));
+                   base::Unretained(this), dictionary.last_used,
+                   dictionary.created_time, dictionary.use_count));
   }
 
   return true;
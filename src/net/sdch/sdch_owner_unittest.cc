@@ -262,6 +262,14 @@ class MockSdchDictionaryFetcher : public SdchDictionaryFetcher {
     return false;
   }
 
+  // Returns the URLs of the pending requests, in the order they were made.
+  std::vector<GURL> GetPendingRequestURLs() const {
+    std::vector<GURL> urls;
+    for (const PendingRequest& request : requests_)
+      urls.push_back(request.url_);
+    return urls;
+  }
+
   bool CompletePendingRequest(const GURL& dictionary_url,
                               const std::string& dictionary_text,
                               const BoundNetLog& net_log,
@@ -920,6 +928,40 @@ TEST_F(SdchOwnerPersistenceTest, TwoDicts) {
   EXPECT_TRUE(owner_->HasDictionaryFromURLForTesting(url1));
 }
 
+// The most recently used dictionaries should be reloaded first.
+TEST_F(SdchOwnerPersistenceTest, ReloadsMostRecentlyUsedFirst) {
+  const GURL url0("http://www.example.com/dict0");
+  const GURL url1("http://www.example.com/dict1");
+  const GURL url2("http://www.example.com/dict2");
+
+  std::unique_ptr<TestPrefStorage> storage(new TestPrefStorage(true));
+  TestPrefStorage* old_storage = storage.get();  // Save storage pointer.
+  ResetOwner(std::move(storage));                // Takes ownership of storage.
+  InsertDictionaryForURL(url0, "0");
+  InsertDictionaryForURL(url1, "1");
+  InsertDictionaryForURL(url2, "2");
+
+  storage.reset(new TestPrefStorage(*old_storage));
+  const base::Time now = base::Time::Now();
+  const struct {
+    const GURL& url;
+    int hours_since_use;
+  } kLastUses[] = {{url0, 3}, {url1, 1}, {url2, 2}};
+  for (const auto& last_use : kLastUses) {
+    base::DictionaryValue* dict = nullptr;
+    ASSERT_TRUE(
+        GetDictionaryForURL(storage.get(), last_use.url, nullptr, &dict));
+    dict->SetDouble(
+        "last_used",
+        (now - base::TimeDelta::FromHours(last_use.hours_since_use))
+            .ToDoubleT());
+  }
+
+  ResetOwner(std::move(storage));
+  std::vector<GURL> expected_urls = {url1, url2, url0};
+  EXPECT_EQ(expected_urls, fetcher_->GetPendingRequestURLs());
+}
+
 TEST_F(SdchOwnerPersistenceTest, OneGoodDictOneBadDict) {
   const GURL url0("http://www.example.com/dict0");
   const GURL url1("http://www.example.com/dict1");
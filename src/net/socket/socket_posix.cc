@@ -7,6 +7,7 @@
 #include <errno.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <utility>
 
 #include "base/callback_helpers.h"
@@ -61,6 +62,7 @@ SocketPosix::SocketPosix()
     : socket_fd_(kInvalidSocket),
       read_buf_len_(0),
       write_buf_len_(0),
+      write_second_buf_len_(0),
       waiting_connect_(false) {}
 
 SocketPosix::~SocketPosix() {
@@ -272,6 +274,31 @@ int SocketPosix::Write(IOBuffer* buf,
   return rv;
 }
 
+int SocketPosix::WriteGathered(IOBuffer* first,
+                               int first_len,
+                               IOBuffer* second,
+                               int second_len,
+                               const CompletionCallback& callback) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_NE(kInvalidSocket, socket_fd_);
+  DCHECK(!waiting_connect_);
+  CHECK(write_callback_.is_null());
+  // Synchronous operation not supported
+  DCHECK(!callback.is_null());
+  DCHECK_LT(0, first_len);
+  DCHECK_LT(0, second_len);
+
+  int rv = DoWriteGathered(first, first_len, second, second_len);
+  if (rv == ERR_IO_PENDING) {
+    rv = WaitForWrite(first, first_len, callback);
+    if (rv == ERR_IO_PENDING) {
+      write_second_buf_ = second;
+      write_second_buf_len_ = second_len;
+    }
+  }
+  return rv;
+}
+
 int SocketPosix::WaitForWrite(IOBuffer* buf,
                               int buf_len,
                               const CompletionCallback& callback) {
@@ -454,8 +481,32 @@ int SocketPosix::DoWrite(IOBuffer* buf, int buf_len) {
   return rv >= 0 ? rv : MapSystemError(errno);
 }
 
+int SocketPosix::DoWriteGathered(IOBuffer* first,
+                                 int first_len,
+                                 IOBuffer* second,
+                                 int second_len) {
+  struct iovec iov[2];
+  iov[0].iov_base = first->data();
+  iov[0].iov_len = first_len;
+  iov[1].iov_base = second->data();
+  iov[1].iov_len = second_len;
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // See DoWrite() for why MSG_NOSIGNAL is used.
+  struct msghdr msg = {};
+  msg.msg_iov = iov;
+  msg.msg_iovlen = arraysize(iov);
+  int rv = HANDLE_EINTR(sendmsg(socket_fd_, &msg, MSG_NOSIGNAL));
+#else
+  int rv = HANDLE_EINTR(writev(socket_fd_, iov, arraysize(iov)));
+#endif
+  return rv >= 0 ? rv : MapSystemError(errno);
+}
+
 void SocketPosix::WriteCompleted() {
-  int rv = DoWrite(write_buf_.get(), write_buf_len_);
+  int rv = write_second_buf_
+               ? DoWriteGathered(write_buf_.get(), write_buf_len_,
+                                 write_second_buf_.get(), write_second_buf_len_)
+               : DoWrite(write_buf_.get(), write_buf_len_);
   if (rv == ERR_IO_PENDING)
     return;
 
@@ -463,6 +514,8 @@ void SocketPosix::WriteCompleted() {
   DCHECK(ok);
   write_buf_ = NULL;
   write_buf_len_ = 0;
+  write_second_buf_ = NULL;
+  write_second_buf_len_ = 0;
   base::ResetAndReturn(&write_callback_).Run(rv);
 }
 
@@ -488,6 +541,8 @@ void SocketPosix::StopWatchingAndCleanUp() {
   if (!write_callback_.is_null()) {
     write_buf_ = NULL;
     write_buf_len_ = 0;
+    write_second_buf_ = NULL;
+    write_second_buf_len_ = 0;
     write_callback_.Reset();
   }
 
@@ -60,6 +60,13 @@ class NET_EXPORT_PRIVATE SocketPosix : public base::MessageLoopForIO::Watcher {
   // TODO(byungchul): Need more robust way to pass system errno.
   int Read(IOBuffer* buf, int buf_len, const CompletionCallback& callback);
   int Write(IOBuffer* buf, int buf_len, const CompletionCallback& callback);
+  // Writes |first_len| bytes of |first| followed by |second_len| bytes of
+  // |second| with a single gather write. Otherwise the same as Write().
+  int WriteGathered(IOBuffer* first,
+                    int first_len,
+                    IOBuffer* second,
+                    int second_len,
+                    const CompletionCallback& callback);
 
   // Waits for next write event. This is called by TCPSocketPosix for TCP
   // fastopen after sending first data. Returns ERR_IO_PENDING if it starts
@@ -98,6 +105,10 @@ class NET_EXPORT_PRIVATE SocketPosix : public base::MessageLoopForIO::Watcher {
   void ReadCompleted();
 
   int DoWrite(IOBuffer* buf, int buf_len);
+  int DoWriteGathered(IOBuffer* first,
+                      int first_len,
+                      IOBuffer* second,
+                      int second_len);
   void WriteCompleted();
 
   void StopWatchingAndCleanUp();
@@ -117,6 +128,9 @@ class NET_EXPORT_PRIVATE SocketPosix : public base::MessageLoopForIO::Watcher {
   base::MessageLoopForIO::FileDescriptorWatcher write_socket_watcher_;
   scoped_refptr<IOBuffer> write_buf_;
   int write_buf_len_;
+  // Set while a WriteGathered() is pending, in addition to |write_buf_|.
+  scoped_refptr<IOBuffer> write_second_buf_;
+  int write_second_buf_len_;
   // External callback; called when write or connect is complete.
   CompletionCallback write_callback_;
 
@@ -4,13 +4,28 @@
 
 #include "net/socket/stream_socket.h"
 
+#include "base/logging.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/values.h"
+#include "net/base/net_errors.h"
 
 namespace net {
 
+bool StreamSocket::SupportsGatheredWrite() const {
+  return false;
+}
+
+int StreamSocket::WriteGathered(IOBuffer* first,
+                                int first_len,
+                                IOBuffer* second,
+                                int second_len,
+                                const CompletionCallback& callback) {
+  NOTREACHED();
+  return ERR_NOT_IMPLEMENTED;
+}
+
 StreamSocket::UseHistory::UseHistory()
     : was_ever_connected_(false),
       was_used_to_convey_data_(false),
@@ -83,6 +83,19 @@ class NET_EXPORT_PRIVATE StreamSocket : public Socket {
   // Enables use of TCP FastOpen for the underlying transport socket.
   virtual void EnableTCPFastOpenIfSupported() {}
 
+  // Returns true if WriteGathered() may be called on this socket.
+  virtual bool SupportsGatheredWrite() const;
+
+  // Writes |first_len| bytes of |first| followed by |second_len| bytes of
+  // |second|, without copying them into a single buffer first. Otherwise
+  // has the same semantics as Write(), and may write fewer bytes than the sum
+  // of both lengths. Must only be called if SupportsGatheredWrite() is true.
+  virtual int WriteGathered(IOBuffer* first,
+                            int first_len,
+                            IOBuffer* second,
+                            int second_len,
+                            const CompletionCallback& callback);
+
   // Returns true if NPN was negotiated during the connection of this socket.
   virtual bool WasNpnNegotiated() const = 0;
 
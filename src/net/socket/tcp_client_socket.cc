@@ -11,6 +11,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/profiler/scoped_tracker.h"
 #include "base/time/time.h"
+#include "build/build_config.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
@@ -255,6 +256,37 @@ void TCPClientSocket::EnableTCPFastOpenIfSupported() {
   socket_->EnableTCPFastOpenIfSupported();
 }
 
+bool TCPClientSocket::SupportsGatheredWrite() const {
+#if defined(OS_POSIX)
+  return socket_->SupportsGatheredWrite();
+#else
+  return false;
+#endif
+}
+
+int TCPClientSocket::WriteGathered(IOBuffer* first,
+                                   int first_len,
+                                   IOBuffer* second,
+                                   int second_len,
+                                   const CompletionCallback& callback) {
+#if defined(OS_POSIX)
+  DCHECK(!callback.is_null());
+
+  // See Write() for why base::Unretained() is safe.
+  CompletionCallback write_callback = base::Bind(
+      &TCPClientSocket::DidCompleteWrite, base::Unretained(this), callback);
+  int result = socket_->WriteGathered(first, first_len, second, second_len,
+                                      write_callback);
+  if (result > 0)
+    use_history_.set_was_used_to_convey_data();
+
+  return result;
+#else
+  return StreamSocket::WriteGathered(first, first_len, second, second_len,
+                                     callback);
+#endif
+}
+
 bool TCPClientSocket::WasNpnNegotiated() const {
   return false;
 }
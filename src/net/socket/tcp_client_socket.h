@@ -57,6 +57,12 @@ class NET_EXPORT TCPClientSocket : public StreamSocket {
   void SetOmniboxSpeculation() override;
   bool WasEverUsed() const override;
   void EnableTCPFastOpenIfSupported() override;
+  bool SupportsGatheredWrite() const override;
+  int WriteGathered(IOBuffer* first,
+                    int first_len,
+                    IOBuffer* second,
+                    int second_len,
+                    const CompletionCallback& callback) override;
   bool WasNpnNegotiated() const override;
   NextProto GetNegotiatedProtocol() const override;
   bool GetSSLInfo(SSLInfo* ssl_info) override;
@@ -312,6 +312,30 @@ int TCPSocketPosix::Write(IOBuffer* buf,
   return rv;
 }
 
+bool TCPSocketPosix::SupportsGatheredWrite() const {
+  return !use_tcp_fastopen_ || tcp_fastopen_write_attempted_;
+}
+
+int TCPSocketPosix::WriteGathered(IOBuffer* first,
+                                  int first_len,
+                                  IOBuffer* second,
+                                  int second_len,
+                                  const CompletionCallback& callback) {
+  DCHECK(socket_);
+  DCHECK(!callback.is_null());
+  DCHECK(SupportsGatheredWrite());
+
+  CompletionCallback write_callback = base::Bind(
+      &TCPSocketPosix::WriteGatheredCompleted, base::Unretained(this),
+      make_scoped_refptr(first), first_len, make_scoped_refptr(second),
+      callback);
+  int rv = socket_->WriteGathered(first, first_len, second, second_len,
+                                  write_callback);
+  if (rv != ERR_IO_PENDING)
+    rv = HandleWriteGatheredCompleted(first, first_len, second, rv);
+  return rv;
+}
+
 int TCPSocketPosix::GetLocalAddress(IPEndPoint* address) const {
   DCHECK(address);
 
@@ -658,6 +682,34 @@ int TCPSocketPosix::HandleWriteCompleted(IOBuffer* buf, int rv) {
   return rv;
 }
 
+void TCPSocketPosix::WriteGatheredCompleted(
+    const scoped_refptr<IOBuffer>& first,
+    int first_len,
+    const scoped_refptr<IOBuffer>& second,
+    const CompletionCallback& callback,
+    int rv) {
+  DCHECK_NE(ERR_IO_PENDING, rv);
+  callback.Run(
+      HandleWriteGatheredCompleted(first.get(), first_len, second.get(), rv));
+}
+
+int TCPSocketPosix::HandleWriteGatheredCompleted(IOBuffer* first,
+                                                 int first_len,
+                                                 IOBuffer* second,
+                                                 int rv) {
+  if (rv <= first_len)
+    return HandleWriteCompleted(first, rv);
+
+  NotifySocketPerformanceWatcher();
+  // Log each buffer separately, as the bytes aren't contiguous.
+  net_log_.AddByteTransferEvent(NetLog::TYPE_SOCKET_BYTES_SENT, first_len,
+                                first->data());
+  net_log_.AddByteTransferEvent(NetLog::TYPE_SOCKET_BYTES_SENT,
+                                rv - first_len, second->data());
+  NetworkActivityMonitor::GetInstance()->IncrementBytesSent(rv);
+  return rv;
+}
+
 int TCPSocketPosix::TcpFastOpenWrite(IOBuffer* buf,
                                      int buf_len,
                                      const CompletionCallback& callback) {
@@ -60,6 +60,15 @@ class NET_EXPORT TCPSocketPosix {
   int Read(IOBuffer* buf, int buf_len, const CompletionCallback& callback);
   int Write(IOBuffer* buf, int buf_len, const CompletionCallback& callback);
 
+  // Returns false while the first write of a TCP FastOpen socket, which also
+  // connects it, is still to be made.
+  bool SupportsGatheredWrite() const;
+  int WriteGathered(IOBuffer* first,
+                    int first_len,
+                    IOBuffer* second,
+                    int second_len,
+                    const CompletionCallback& callback);
+
   int GetLocalAddress(IPEndPoint* address) const;
   int GetPeerAddress(IPEndPoint* address) const;
 
@@ -204,6 +213,15 @@ class NET_EXPORT TCPSocketPosix {
                       const CompletionCallback& callback,
                       int rv);
   int HandleWriteCompleted(IOBuffer* buf, int rv);
+  void WriteGatheredCompleted(const scoped_refptr<IOBuffer>& first,
+                              int first_len,
+                              const scoped_refptr<IOBuffer>& second,
+                              const CompletionCallback& callback,
+                              int rv);
+  int HandleWriteGatheredCompleted(IOBuffer* first,
+                                   int first_len,
+                                   IOBuffer* second,
+                                   int rv);
   int TcpFastOpenWrite(IOBuffer* buf,
                        int buf_len,
                        const CompletionCallback& callback);
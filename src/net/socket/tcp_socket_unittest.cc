@@ -385,6 +385,54 @@ TEST_F(TCPSocketTest, ReadWrite) {
   ASSERT_EQ(message, received_message);
 }
 
+#if defined(OS_POSIX)
+TEST_F(TCPSocketTest, WriteGathered) {
+  ASSERT_NO_FATAL_FAILURE(SetUpListenIPv4());
+
+  TestCompletionCallback connect_callback;
+  TCPSocket connecting_socket(NULL, NULL, NetLog::Source());
+  ASSERT_EQ(OK, connecting_socket.Open(ADDRESS_FAMILY_IPV4));
+  connecting_socket.Connect(local_address_, connect_callback.callback());
+
+  TestCompletionCallback accept_callback;
+  std::unique_ptr<TCPSocket> accepted_socket;
+  IPEndPoint accepted_address;
+  int result = socket_.Accept(&accepted_socket, &accepted_address,
+                              accept_callback.callback());
+  ASSERT_EQ(OK, accept_callback.GetResult(result));
+  ASSERT_TRUE(accepted_socket.get());
+  EXPECT_EQ(OK, connect_callback.WaitForResult());
+  ASSERT_TRUE(connecting_socket.SupportsGatheredWrite());
+
+  const std::string first("POST / HTTP/1.1\r\n\r\n");
+  const std::string second("request body");
+  scoped_refptr<StringIOBuffer> first_buffer(new StringIOBuffer(first));
+  scoped_refptr<StringIOBuffer> second_buffer(new StringIOBuffer(second));
+
+  // A small write to a loopback socket isn't split.
+  TestCompletionCallback write_callback;
+  result = connecting_socket.WriteGathered(
+      first_buffer.get(), first_buffer->size(), second_buffer.get(),
+      second_buffer->size(), write_callback.callback());
+  ASSERT_EQ(static_cast<int>(first.size() + second.size()),
+            write_callback.GetResult(result));
+
+  const std::string message = first + second;
+  std::string received_message;
+  while (received_message.size() < message.size()) {
+    scoped_refptr<IOBufferWithSize> read_buffer(
+        new IOBufferWithSize(message.size() - received_message.size()));
+    TestCompletionCallback read_callback;
+    int read_result = accepted_socket->Read(
+        read_buffer.get(), read_buffer->size(), read_callback.callback());
+    read_result = read_callback.GetResult(read_result);
+    ASSERT_GT(read_result, 0);
+    received_message.append(read_buffer->data(), read_result);
+  }
+  EXPECT_EQ(message, received_message);
+}
+#endif  // defined(OS_POSIX)
+
 // These tests require kernel support for tcp_info struct, and so they are
 // enabled only on certain platforms.
 #if defined(TCP_INFO) || defined(OS_LINUX)
@@ -42,7 +42,7 @@ void HpackDecoder::HandleControlFrameHeadersStart(
 bool HpackDecoder::HandleControlFrameHeadersData(const char* headers_data,
                                                  size_t headers_data_length) {
   if (!header_block_started_) {
-    decoded_block_.clear();
+    decoded_block_.ClearAndRetainStorage();
     if (handler_ != nullptr) {
       handler_->OnHeaderBlockStart();
     }
@@ -128,10 +128,14 @@ bool HpackDecoder::HandleHeaderRepresentation(StringPiece name,
       decoded_block_[name] = value;
     } else {
       // The key already exists, append |value| with appropriate delimiter.
-      string new_value = it->second.as_string();
-      new_value.append((name == kCookieKey) ? "; " : string(1, '\0'));
-      value.AppendToString(&new_value);
-      decoded_block_.ReplaceOrAppendHeader(name, new_value);
+      it->second.CopyToString(&joined_value_buffer_);
+      if (name == kCookieKey) {
+        joined_value_buffer_.append("; ");
+      } else {
+        joined_value_buffer_.push_back('\0');
+      }
+      value.AppendToString(&joined_value_buffer_);
+      decoded_block_.ReplaceOrAppendHeader(name, joined_value_buffer_);
     }
   } else {
     DCHECK(decoded_block_.empty());
@@ -150,6 +154,14 @@ bool HpackDecoder::DecodeNextOpcodeWrapper(HpackInputStream* input_stream) {
 }
 
 bool HpackDecoder::DecodeNextOpcode(HpackInputStream* input_stream) {
+  // Fast path for 7.1 where the index fits in the opcode octet and refers to
+  // the static table, by far the most common representation.
+  uint32_t static_index = 0;
+  if (input_stream->MatchSingleOctetIndexAndConsume(header_table_.static_size(),
+                                                    &static_index)) {
+    const HpackEntry* entry = header_table_.GetStaticByIndex(static_index);
+    return HandleHeaderRepresentation(entry->name(), entry->value());
+  }
   // Implements 7.1: Indexed Header Field Representation.
   if (input_stream->MatchPrefixAndConsume(kIndexedOpcode)) {
     return DecodeNextIndexedHeader(input_stream);
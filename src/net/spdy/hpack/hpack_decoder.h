@@ -65,7 +65,7 @@ class NET_EXPORT_PRIVATE HpackDecoder : public HpackDecoderInterface {
   bool HandleControlFrameHeadersComplete(size_t* compressed_len) override;
 
   // Accessor for the most recently decoded headers block. Valid until the next
-  // call to HandleControlFrameHeadersData().
+  // call to HandleControlFrameHeadersData(), which reuses the block's storage.
   // TODO(birenroy): Remove this method when all users of HpackDecoder specify
   // a SpdyHeadersHandlerInterface.
   const SpdyHeaderBlock& decoded_block() override;
@@ -105,6 +105,9 @@ class NET_EXPORT_PRIVATE HpackDecoder : public HpackDecoderInterface {
   // Scratch space for storing decoded literals.
   std::string key_buffer_, value_buffer_;
 
+  // Scratch space for joining the values of a repeated header.
+  std::string joined_value_buffer_;
+
   // If non-NULL, handles decoded headers.
   SpdyHeadersHandlerInterface* handler_;
   size_t total_header_bytes_;
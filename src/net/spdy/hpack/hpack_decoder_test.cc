@@ -9,6 +9,7 @@
 
 #include "base/logging.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/stringprintf.h"
 #include "net/spdy/hpack/hpack_encoder.h"
 #include "net/spdy/hpack/hpack_input_stream.h"
 #include "net/spdy/hpack/hpack_output_stream.h"
@@ -352,6 +353,30 @@ TEST_P(HpackDecoderTest, IndexedHeaderDynamic) {
   EXPECT_EQ(expected_header_set3, header_set3);
 }
 
+// Indices at the end of the static table, at the start of the dynamic table,
+// and beyond the single-octet encoding should all decode.
+TEST_P(HpackDecoderTest, IndexedHeaderTableBoundaries) {
+  // Add entries until index #127 is in the dynamic table.
+  for (int i = 0; i < 127 - 61; ++i) {
+    string block("\x40\x03"
+                 "foo"
+                 "\x03",
+                 6);
+    block.append(base::StringPrintf("%03d", i));
+    DecodeBlockExpectingSuccess(block);
+  }
+
+  // Reference static entry #61, dynamic entry #62, and dynamic entry #127,
+  // which needs a second octet.
+  const SpdyHeaderBlock& header_set =
+      DecodeBlockExpectingSuccess(StringPiece("\xbd\xbe\xff\x00", 4));
+  EXPECT_THAT(header_set,
+              ElementsAre(Pair("www-authenticate", ""),
+                          Pair("foo", StringPiece("065\0"
+                                                  "000",
+                                                  7))));
+}
+
 // Test a too-large indexed header.
 TEST_P(HpackDecoderTest, InvalidIndexedHeader) {
   // High-bit set, and a prefix of one more than the number of static entries.
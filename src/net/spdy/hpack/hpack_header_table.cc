@@ -61,6 +61,12 @@ const HpackEntry* HpackHeaderTable::GetByIndex(size_t index) {
   return NULL;
 }
 
+const HpackEntry* HpackHeaderTable::GetStaticByIndex(size_t index) const {
+  DCHECK_GE(index, 1u);
+  DCHECK_LE(index, static_entries_.size());
+  return &static_entries_[index - 1];
+}
+
 const HpackEntry* HpackHeaderTable::GetByName(StringPiece name) {
   {
     NameToEntryMap::const_iterator it = static_name_index_.find(name);
@@ -86,6 +86,13 @@ class NET_EXPORT_PRIVATE HpackHeaderTable {
   // Returns the entry matching the index, or NULL.
   const HpackEntry* GetByIndex(size_t index);
 
+  // Number of entries in the static table, which has indices
+  // [1, static_size()].
+  size_t static_size() const { return static_entries_.size(); }
+
+  // Returns the static entry at |index|, which must be in [1, static_size()].
+  const HpackEntry* GetStaticByIndex(size_t index) const;
+
   // Returns the lowest-value entry having |name|, or NULL.
   const HpackEntry* GetByName(base::StringPiece name);
 
@@ -160,6 +160,27 @@ bool HpackInputStream::DecodeNextHuffmanString(string* str) {
   return HpackHuffmanDecoder::DecodeString(&bounded_reader, str);
 }
 
+bool HpackInputStream::MatchSingleOctetIndexAndConsume(uint32_t max_index,
+                                                       uint32_t* index) {
+  if (buffer_.empty() || bit_offset_ != 0) {
+    return false;
+  }
+  const uint8_t next_octet = buffer_[0];
+  if ((next_octet >> (8 - kIndexedOpcode.bit_size)) != kIndexedOpcode.bits) {
+    return false;
+  }
+  // An all-ones prefix is continued in the following octets.
+  const uint8_t prefix_mask = (1 << (8 - kIndexedOpcode.bit_size)) - 1;
+  const uint32_t value = next_octet & prefix_mask;
+  if (value == 0 || value == prefix_mask || value > max_index) {
+    return false;
+  }
+  buffer_.remove_prefix(1);
+  parsed_bytes_current_ += 1;
+  *index = value;
+  return true;
+}
+
 bool HpackInputStream::PeekBits(size_t* peeked_count, uint32_t* out) const {
   size_t byte_offset = (bit_offset_ + *peeked_count) / 8;
   size_t bit_offset = (bit_offset_ + *peeked_count) % 8;
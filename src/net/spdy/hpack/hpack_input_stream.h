@@ -51,6 +51,13 @@ class NET_EXPORT_PRIVATE HpackInputStream {
   bool DecodeNextIdentityString(base::StringPiece* str);
   bool DecodeNextHuffmanString(std::string* str);
 
+  // If the next octet is a complete Indexed Header Field representation
+  // (section 6.1) with an index in [1, |max_index|], consumes it, stores the
+  // index in |*index| and returns true. Otherwise consumes nothing and returns
+  // false. Lets the decoder resolve the common single-octet references to the
+  // static table without MatchPrefixAndConsume() and DecodeNextUint32().
+  bool MatchSingleOctetIndexAndConsume(uint32_t max_index, uint32_t* index);
+
   // Stores input bits into the most-significant, unfilled bits of |out|.
   // |peeked_count| is the number of filled bits in |out| which have been
   // previously peeked. PeekBits() will fill some number of remaining bits,
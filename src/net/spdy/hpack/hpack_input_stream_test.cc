@@ -710,6 +710,41 @@ TEST(HpackInputStreamTest, ConsumeByteRemainder) {
   EXPECT_FALSE(input_stream.HasMoreData());
 }
 
+TEST(HpackInputStreamTest, MatchSingleOctetIndexAndConsume) {
+  const uint32_t kMaxIndex = 61;
+  uint32_t index = 0;
+
+  // Indices in [1, max_index] are consumed.
+  HpackInputStream input_stream1("\x81\xbd");
+  HpackInputStreamPeer input_stream1_peer(&input_stream1);
+  EXPECT_TRUE(input_stream1.MatchSingleOctetIndexAndConsume(kMaxIndex, &index));
+  EXPECT_EQ(1u, index);
+  EXPECT_TRUE(input_stream1.MatchSingleOctetIndexAndConsume(kMaxIndex, &index));
+  EXPECT_EQ(61u, index);
+  EXPECT_EQ(2u, input_stream1_peer.ParsedBytesCurrent());
+  EXPECT_FALSE(input_stream1.HasMoreData());
+  EXPECT_FALSE(input_stream1.NeedMoreData());
+
+  // Other representations, index 0, larger indices and multi-octet indices
+  // are left for the generic decoding.
+  for (const char* octets : {"\x40", "\x80", "\xbe", "\xff\x00"}) {
+    HpackInputStream input_stream2(octets);
+    HpackInputStreamPeer input_stream2_peer(&input_stream2);
+    EXPECT_FALSE(
+        input_stream2.MatchSingleOctetIndexAndConsume(kMaxIndex, &index));
+    EXPECT_EQ(0u, input_stream2_peer.ParsedBytesCurrent());
+    EXPECT_TRUE(input_stream2.HasMoreData());
+  }
+  EXPECT_EQ(61u, index);
+
+  // Nothing is consumed mid-octet.
+  HpackInputStream input_stream3("\x81");
+  HpackInputStreamPeer input_stream3_peer(&input_stream3);
+  input_stream3_peer.SetBitOffsetForTest(1);
+  EXPECT_FALSE(
+      input_stream3.MatchSingleOctetIndexAndConsume(kMaxIndex, &index));
+}
+
 TEST(HpackInputStreamTest, IncompleteHeaderMatchPrefixAndConsume) {
   HpackInputStream input_stream("");
   HpackInputStreamPeer input_stream_peer(&input_stream);
@@ -55,6 +55,8 @@ class SpdyHeaderBlock::Storage {
 
   void Clear() { arena_.Reset(); }
 
+  void ClearAndRetainFirstBlock() { arena_.ResetKeepingFirstBlock(); }
+
  private:
   UnsafeArena arena_;
 };
@@ -170,6 +172,11 @@ void SpdyHeaderBlock::clear() {
   storage_->Clear();
 }
 
+void SpdyHeaderBlock::ClearAndRetainStorage() {
+  block_.clear();
+  storage_->ClearAndRetainFirstBlock();
+}
+
 void SpdyHeaderBlock::insert(
     const SpdyHeaderBlock::MapType::value_type& value) {
   ReplaceOrAppendHeader(value.first, value.second);
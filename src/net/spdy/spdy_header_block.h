@@ -83,6 +83,11 @@ class NET_EXPORT SpdyHeaderBlock {
   // Clears both our MapType member and the memory used to hold headers.
   void clear();
 
+  // Like clear(), but keeps the first block of the backing storage for reuse.
+  // Meant for blocks that are repeatedly filled and cleared, like a decoder's
+  // output, so that each header set doesn't reallocate storage.
+  void ClearAndRetainStorage();
+
   // These methods copy data into our backing storage.
   void insert(const MapType::value_type& value);
   void ReplaceOrAppendHeader(const base::StringPiece key,
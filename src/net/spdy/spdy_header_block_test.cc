@@ -96,6 +96,22 @@ TEST(SpdyHeaderBlockTest, AddHeaders) {
   EXPECT_EQ("", block1.GetHeader("key"));
 }
 
+// This test verifies that a block cleared with ClearAndRetainStorage() reuses
+// its storage for the next headers.
+TEST(SpdyHeaderBlockTest, ClearAndRetainStorage) {
+  SpdyHeaderBlock block;
+  block["foo"] = "bar";
+  const char* value_data = block.GetHeader("foo").data();
+  block.ClearAndRetainStorage();
+  EXPECT_TRUE(block.empty());
+  EXPECT_EQ(block.end(), block.find("foo"));
+
+  block["baz"] = "qux";
+  EXPECT_EQ(base::StringPiece("qux"), block.GetHeader("baz"));
+  // "baz" is written where "foo" was, and "qux" where "bar" was.
+  EXPECT_EQ(value_data, block.GetHeader("baz").data());
+}
+
 // This test verifies that SpdyHeaderBlock can be copied using Clone().
 TEST(SpdyHeaderBlockTest, CopyBlocks) {
   SpdyHeaderBlock block1;
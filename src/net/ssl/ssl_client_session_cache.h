@@ -11,7 +11,7 @@
 #include <memory>
 #include <string>
 
-#include "base/containers/mru_cache.h"
+#include "base/containers/flat_mru_cache.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_checker.h"
@@ -66,7 +66,7 @@ class NET_EXPORT SSLClientSessionCache {
   };
 
   using CacheEntryMap =
-      base::HashingMRUCache<std::string, std::unique_ptr<CacheEntry>>;
+      base::FlatMRUCache<std::string, std::unique_ptr<CacheEntry>>;
 
   // Returns true if |entry| is expired as of |now|.
   bool IsExpired(CacheEntry* entry, const base::Time& now);
@@ -0,0 +1,111 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/test/scoped_allocation_counter.h"
+
+#include "base/allocator/allocator_shim.h"
+#include "base/allocator/features.h"
+#include "base/atomicops.h"
+#include "base/logging.h"
+
+namespace net {
+namespace test {
+
+namespace {
+
+// Whether a ScopedAllocationCounter exists.
+bool g_counting = false;
+
+#if BUILDFLAG(USE_EXPERIMENTAL_ALLOCATOR_SHIM)
+
+using base::allocator::AllocatorDispatch;
+
+base::subtle::AtomicWord g_allocation_count = 0;
+
+void CountAllocation() {
+  base::subtle::NoBarrier_AtomicIncrement(&g_allocation_count, 1);
+}
+
+void* HookAlloc(const AllocatorDispatch* self, size_t size) {
+  CountAllocation();
+  const AllocatorDispatch* const next = self->next;
+  return next->alloc_function(next, size);
+}
+
+void* HookZeroInitAlloc(const AllocatorDispatch* self, size_t n, size_t size) {
+  CountAllocation();
+  const AllocatorDispatch* const next = self->next;
+  return next->alloc_zero_initialized_function(next, n, size);
+}
+
+void* HookAllocAligned(const AllocatorDispatch* self,
+                       size_t alignment,
+                       size_t size) {
+  CountAllocation();
+  const AllocatorDispatch* const next = self->next;
+  return next->alloc_aligned_function(next, alignment, size);
+}
+
+void* HookRealloc(const AllocatorDispatch* self, void* address, size_t size) {
+  // realloc(size == 0) means free().
+  if (size > 0)
+    CountAllocation();
+  const AllocatorDispatch* const next = self->next;
+  return next->realloc_function(next, address, size);
+}
+
+void HookFree(const AllocatorDispatch* self, void* address) {
+  const AllocatorDispatch* const next = self->next;
+  next->free_function(next, address);
+}
+
+AllocatorDispatch g_allocator_hooks = {
+    &HookAlloc,         /* alloc_function */
+    &HookZeroInitAlloc, /* alloc_zero_initialized_function */
+    &HookAllocAligned,  /* alloc_aligned_function */
+    &HookRealloc,       /* realloc_function */
+    &HookFree,          /* free_function */
+    nullptr,            /* next */
+};
+
+#endif  // BUILDFLAG(USE_EXPERIMENTAL_ALLOCATOR_SHIM)
+
+}  // namespace
+
+ScopedAllocationCounter::ScopedAllocationCounter() {
+  CHECK(!g_counting);
+  g_counting = true;
+#if BUILDFLAG(USE_EXPERIMENTAL_ALLOCATOR_SHIM)
+  base::subtle::NoBarrier_Store(&g_allocation_count, 0);
+  base::allocator::InsertAllocatorDispatch(&g_allocator_hooks);
+#endif
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() {
+  CHECK(g_counting);
+#if BUILDFLAG(USE_EXPERIMENTAL_ALLOCATOR_SHIM)
+  base::allocator::RemoveAllocatorDispatchForTesting(&g_allocator_hooks);
+#endif
+  g_counting = false;
+}
+
+// static
+bool ScopedAllocationCounter::IsSupported() {
+#if BUILDFLAG(USE_EXPERIMENTAL_ALLOCATOR_SHIM)
+  return true;
+#else
+  return false;
+#endif
+}
+
+size_t ScopedAllocationCounter::GetAllocationCount() const {
+#if BUILDFLAG(USE_EXPERIMENTAL_ALLOCATOR_SHIM)
+  return static_cast<size_t>(base::subtle::NoBarrier_Load(&g_allocation_count));
+#else
+  return 0;
+#endif
+}
+
+}  // namespace test
+}  // namespace net
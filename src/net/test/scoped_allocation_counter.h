@@ -0,0 +1,39 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_TEST_SCOPED_ALLOCATION_COUNTER_H_
+#define NET_TEST_SCOPED_ALLOCATION_COUNTER_H_
+
+#include <stddef.h>
+
+#include "base/macros.h"
+
+namespace net {
+namespace test {
+
+// The ScopedAllocationCounter class counts the memory allocations made on all
+// threads within the current block, for perftests to report allocations per
+// operation. Allocations are intercepted through the allocator shim, so they
+// can't be counted in builds without it, see IsSupported(). Only one instance
+// may exist at a time.
+class ScopedAllocationCounter {
+ public:
+  ScopedAllocationCounter();
+  ~ScopedAllocationCounter();
+
+  // Returns true if allocations can be counted in this build.
+  static bool IsSupported();
+
+  // Returns the number of allocations, including reallocations, made since
+  // the counter was created. Always 0 if !IsSupported().
+  size_t GetAllocationCount() const;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ScopedAllocationCounter);
+};
+
+}  // namespace test
+}  // namespace net
+
+#endif  // NET_TEST_SCOPED_ALLOCATION_COUNTER_H_
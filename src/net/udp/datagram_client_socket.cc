@@ -0,0 +1,32 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/udp/datagram_client_socket.h"
+
+#include "base/logging.h"
+#include "net/base/net_errors.h"
+
+namespace net {
+
+bool DatagramClientSocket::SupportsMultipleDatagrams() const {
+  return false;
+}
+
+int DatagramClientSocket::ReadMultiple(IOBuffer* buf,
+                                       int datagram_size,
+                                       int max_datagrams,
+                                       std::vector<int>* sizes,
+                                       const CompletionCallback& callback) {
+  NOTREACHED();
+  return ERR_NOT_IMPLEMENTED;
+}
+
+int DatagramClientSocket::WriteMultiple(IOBuffer* buf,
+                                        const std::vector<int>& sizes,
+                                        const CompletionCallback& callback) {
+  NOTREACHED();
+  return ERR_NOT_IMPLEMENTED;
+}
+
+}  // namespace net
@@ -5,12 +5,16 @@
 #ifndef NET_UDP_DATAGRAM_CLIENT_SOCKET_H_
 #define NET_UDP_DATAGRAM_CLIENT_SOCKET_H_
 
+#include <vector>
+
+#include "net/base/completion_callback.h"
 #include "net/base/network_change_notifier.h"
 #include "net/socket/socket.h"
 #include "net/udp/datagram_socket.h"
 
 namespace net {
 
+class IOBuffer;
 class IPEndPoint;
 
 class NET_EXPORT_PRIVATE DatagramClientSocket : public DatagramSocket,
@@ -40,6 +44,28 @@ class NET_EXPORT_PRIVATE DatagramClientSocket : public DatagramSocket,
   // ConnectUsingNetwork() or ConnectUsingDefaultNetwork().
   virtual NetworkChangeNotifier::NetworkHandle GetBoundNetwork() const = 0;
 
+  // Returns true if ReadMultiple() and WriteMultiple() are implemented. They
+  // transfer several datagrams per system call where the platform allows it.
+  // The default implementation returns false.
+  virtual bool SupportsMultipleDatagrams() const;
+
+  // Reads up to |max_datagrams| datagrams. The i-th datagram is read at offset
+  // i * |datagram_size| of |buf|, which must hold |max_datagrams| of them, and
+  // its size is stored in (*sizes)[i]. Returns the number of datagrams read, or
+  // a net error code. If ERR_IO_PENDING is returned, the caller must keep |buf|
+  // and |sizes| alive until the callback is called.
+  virtual int ReadMultiple(IOBuffer* buf,
+                           int datagram_size,
+                           int max_datagrams,
+                           std::vector<int>* sizes,
+                           const CompletionCallback& callback);
+
+  // Writes the datagrams of |sizes| bytes stored back to back in |buf|. Returns
+  // the number of bytes written, which is the sum of |sizes|, or a net error
+  // code. Several datagrams may have been sent when an error is returned.
+  virtual int WriteMultiple(IOBuffer* buf,
+                            const std::vector<int>& sizes,
+                            const CompletionCallback& callback);
 };
 
 }  // namespace net
@@ -89,6 +89,27 @@ int UDPClientSocket::Write(IOBuffer* buf,
   return socket_.Write(buf, buf_len, callback);
 }
 
+#if defined(OS_POSIX)
+bool UDPClientSocket::SupportsMultipleDatagrams() const {
+  return true;
+}
+
+int UDPClientSocket::ReadMultiple(IOBuffer* buf,
+                                  int datagram_size,
+                                  int max_datagrams,
+                                  std::vector<int>* sizes,
+                                  const CompletionCallback& callback) {
+  return socket_.ReadMultiple(buf, datagram_size, max_datagrams, sizes,
+                              callback);
+}
+
+int UDPClientSocket::WriteMultiple(IOBuffer* buf,
+                                   const std::vector<int>& sizes,
+                                   const CompletionCallback& callback) {
+  return socket_.WriteMultiple(buf, sizes, callback);
+}
+#endif
+
 void UDPClientSocket::Close() {
   socket_.Close();
 }
@@ -32,6 +32,17 @@ class NET_EXPORT_PRIVATE UDPClientSocket : public DatagramClientSocket {
                           const IPEndPoint& address) override;
   int ConnectUsingDefaultNetwork(const IPEndPoint& address) override;
   NetworkChangeNotifier::NetworkHandle GetBoundNetwork() const override;
+#if defined(OS_POSIX)
+  bool SupportsMultipleDatagrams() const override;
+  int ReadMultiple(IOBuffer* buf,
+                   int datagram_size,
+                   int max_datagrams,
+                   std::vector<int>* sizes,
+                   const CompletionCallback& callback) override;
+  int WriteMultiple(IOBuffer* buf,
+                    const std::vector<int>& sizes,
+                    const CompletionCallback& callback) override;
+#endif
   int Read(IOBuffer* buf,
            int buf_len,
            const CompletionCallback& callback) override;
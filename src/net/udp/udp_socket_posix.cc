@@ -12,6 +12,8 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 
+#include <algorithm>
+
 #include "base/callback.h"
 #include "base/debug/alias.h"
 #include "base/files/file_util.h"
@@ -31,6 +33,14 @@
 #include "net/socket/socket_descriptor.h"
 #include "net/udp/udp_net_log_parameters.h"
 
+#if defined(OS_LINUX)
+#include <netinet/udp.h>
+
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+#endif
+
 #if defined(OS_ANDROID)
 #include <dlfcn.h>
 // This was added in Lollipop to dlfcn.h
@@ -48,6 +58,12 @@ const int kBindRetries = 10;
 const int kPortStart = 1024;
 const int kPortEnd = 65535;
 
+#if defined(OS_LINUX)
+// Limits of the datagrams sent by a single system call.
+const int kMaxDatagramsPerCall = 64;
+const int kMaxSegmentationOffloadBytes = 64000;
+#endif
+
 #if defined(OS_MACOSX)
 
 // Returns IPv4 address in network order.
@@ -87,7 +103,14 @@ UDPSocketPosix::UDPSocketPosix(DatagramSocket::BindType bind_type,
       write_watcher_(this),
       read_buf_len_(0),
       recv_from_address_(NULL),
+      read_datagram_sizes_(NULL),
+      read_max_datagrams_(0),
       write_buf_len_(0),
+      write_datagrams_sent_(0),
+      write_bytes_sent_(0),
+#if defined(OS_LINUX)
+      gso_supported_(true),
+#endif
       net_log_(BoundNetLog::Make(net_log, NetLog::SOURCE_UDP_SOCKET)),
       bound_network_(NetworkChangeNotifier::kInvalidNetworkHandle) {
   net_log_.BeginEvent(NetLog::TYPE_SOCKET_ALIVE,
@@ -128,10 +151,10 @@ void UDPSocketPosix::Close() {
   read_buf_len_ = 0;
   read_callback_.Reset();
   recv_from_address_ = NULL;
-  write_buf_ = NULL;
-  write_buf_len_ = 0;
+  read_datagram_sizes_ = NULL;
+  read_max_datagrams_ = 0;
+  ResetWriteState();
   write_callback_.Reset();
-  send_to_address_.reset();
 
   bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
   DCHECK(ok);
@@ -225,6 +248,41 @@ int UDPSocketPosix::RecvFrom(IOBuffer* buf,
   return ERR_IO_PENDING;
 }
 
+int UDPSocketPosix::ReadMultiple(IOBuffer* buf,
+                                 int datagram_size,
+                                 int max_datagrams,
+                                 std::vector<int>* sizes,
+                                 const CompletionCallback& callback) {
+  DCHECK(CalledOnValidThread());
+  DCHECK_NE(kInvalidSocket, socket_);
+  CHECK(read_callback_.is_null());
+  DCHECK(!read_datagram_sizes_);
+  DCHECK(!callback.is_null());  // Synchronous operation not supported
+  DCHECK_GT(datagram_size, 0);
+  DCHECK_GT(max_datagrams, 0);
+  DCHECK(sizes);
+
+  int result = InternalReadMultiple(buf, datagram_size, max_datagrams, sizes);
+  if (result != ERR_IO_PENDING)
+    return result;
+
+  if (!base::MessageLoopForIO::current()->WatchFileDescriptor(
+          socket_, true, base::MessageLoopForIO::WATCH_READ,
+          &read_socket_watcher_, &read_watcher_)) {
+    PLOG(ERROR) << "WatchFileDescriptor failed on read";
+    result = MapSystemError(errno);
+    LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  read_buf_ = buf;
+  read_buf_len_ = datagram_size;
+  read_datagram_sizes_ = sizes;
+  read_max_datagrams_ = max_datagrams;
+  read_callback_ = callback;
+  return ERR_IO_PENDING;
+}
+
 int UDPSocketPosix::Write(IOBuffer* buf,
                           int buf_len,
                           const CompletionCallback& callback) {
@@ -238,6 +296,39 @@ int UDPSocketPosix::SendTo(IOBuffer* buf,
   return SendToOrWrite(buf, buf_len, &address, callback);
 }
 
+int UDPSocketPosix::WriteMultiple(IOBuffer* buf,
+                                  const std::vector<int>& sizes,
+                                  const CompletionCallback& callback) {
+  DCHECK(CalledOnValidThread());
+  DCHECK_NE(kInvalidSocket, socket_);
+  CHECK(write_callback_.is_null());
+  DCHECK(!callback.is_null());  // Synchronous operation not supported
+  DCHECK(!sizes.empty());
+
+  write_buf_ = buf;
+  write_datagram_sizes_ = sizes;
+  write_datagrams_sent_ = 0;
+  write_bytes_sent_ = 0;
+  int result = InternalWriteMultiple();
+  if (result != ERR_IO_PENDING) {
+    ResetWriteState();
+    return result;
+  }
+
+  if (!base::MessageLoopForIO::current()->WatchFileDescriptor(
+          socket_, true, base::MessageLoopForIO::WATCH_WRITE,
+          &write_socket_watcher_, &write_watcher_)) {
+    DVLOG(1) << "WatchFileDescriptor failed on write, errno " << errno;
+    result = MapSystemError(errno);
+    LogWrite(result, NULL, NULL);
+    ResetWriteState();
+    return result;
+  }
+
+  write_callback_ = callback;
+  return ERR_IO_PENDING;
+}
+
 int UDPSocketPosix::SendToOrWrite(IOBuffer* buf,
                                   int buf_len,
                                   const IPEndPoint* address,
@@ -456,12 +547,20 @@ void UDPSocketPosix::DoWriteCallback(int rv) {
 }
 
 void UDPSocketPosix::DidCompleteRead() {
-  int result =
-      InternalRecvFrom(read_buf_.get(), read_buf_len_, recv_from_address_);
+  int result;
+  if (read_datagram_sizes_) {
+    result = InternalReadMultiple(read_buf_.get(), read_buf_len_,
+                                  read_max_datagrams_, read_datagram_sizes_);
+  } else {
+    result =
+        InternalRecvFrom(read_buf_.get(), read_buf_len_, recv_from_address_);
+  }
   if (result != ERR_IO_PENDING) {
     read_buf_ = NULL;
     read_buf_len_ = 0;
     recv_from_address_ = NULL;
+    read_datagram_sizes_ = NULL;
+    read_max_datagrams_ = 0;
     bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
     DCHECK(ok);
     DoReadCallback(result);
@@ -494,13 +593,16 @@ void UDPSocketPosix::LogRead(int result,
 }
 
 void UDPSocketPosix::DidCompleteWrite() {
-  int result =
-      InternalSendTo(write_buf_.get(), write_buf_len_, send_to_address_.get());
+  int result;
+  if (!write_datagram_sizes_.empty()) {
+    result = InternalWriteMultiple();
+  } else {
+    result = InternalSendTo(write_buf_.get(), write_buf_len_,
+                            send_to_address_.get());
+  }
 
   if (result != ERR_IO_PENDING) {
-    write_buf_ = NULL;
-    write_buf_len_ = 0;
-    send_to_address_.reset();
+    ResetWriteState();
     write_socket_watcher_.StopWatchingFileDescriptor();
     DoWriteCallback(result);
   }
@@ -580,6 +682,162 @@ int UDPSocketPosix::InternalSendTo(IOBuffer* buf,
   return result;
 }
 
+int UDPSocketPosix::InternalReadMultiple(IOBuffer* buf,
+                                         int datagram_size,
+                                         int max_datagrams,
+                                         std::vector<int>* sizes) {
+  sizes->clear();
+#if defined(OS_LINUX)
+  std::vector<mmsghdr> messages(max_datagrams);
+  std::vector<iovec> iovecs(max_datagrams);
+  std::vector<SockaddrStorage> storages(max_datagrams);
+  for (int i = 0; i < max_datagrams; ++i) {
+    iovecs[i].iov_base = buf->data() + i * datagram_size;
+    iovecs[i].iov_len = datagram_size;
+    messages[i].msg_hdr.msg_name = storages[i].addr;
+    messages[i].msg_hdr.msg_namelen = storages[i].addr_len;
+    messages[i].msg_hdr.msg_iov = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int num_datagrams =
+      HANDLE_EINTR(recvmmsg(socket_, messages.data(), max_datagrams, 0, NULL));
+  if (num_datagrams < 0) {
+    int result = MapSystemError(errno);
+    if (result != ERR_IO_PENDING)
+      LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  for (int i = 0; i < num_datagrams; ++i) {
+    sizes->push_back(messages[i].msg_len);
+    LogRead(messages[i].msg_len, buf->data() + i * datagram_size,
+            messages[i].msg_hdr.msg_namelen, storages[i].addr);
+  }
+  return num_datagrams;
+#else
+  for (int i = 0; i < max_datagrams; ++i) {
+    scoped_refptr<IOBuffer> datagram(
+        new WrappedIOBuffer(buf->data() + i * datagram_size));
+    int result = InternalRecvFrom(datagram.get(), datagram_size, NULL);
+    if (result < 0)
+      return i ? i : result;
+    sizes->push_back(result);
+  }
+  return max_datagrams;
+#endif
+}
+
+int UDPSocketPosix::InternalWriteMultiple() {
+  while (write_datagrams_sent_ < write_datagram_sizes_.size()) {
+    int result = InternalSendDatagrams(
+        write_buf_.get(), write_bytes_sent_,
+        &write_datagram_sizes_[write_datagrams_sent_],
+        static_cast<int>(write_datagram_sizes_.size() - write_datagrams_sent_));
+    if (result < 0)
+      return result;
+    for (int i = 0; i < result; ++i)
+      write_bytes_sent_ += write_datagram_sizes_[write_datagrams_sent_++];
+  }
+  return write_bytes_sent_;
+}
+
+int UDPSocketPosix::InternalSendDatagrams(IOBuffer* buf,
+                                          int offset,
+                                          const int* sizes,
+                                          int num_datagrams) {
+#if defined(OS_LINUX)
+  if (gso_supported_ && num_datagrams > 1) {
+    // The kernel splits a buffer into datagrams of the size of the first one,
+    // and only the last datagram may be shorter.
+    int segment_size = sizes[0];
+    int num_segments = 1;
+    int total_size = segment_size;
+    while (num_segments < num_datagrams &&
+           num_segments < kMaxDatagramsPerCall &&
+           sizes[num_segments] <= segment_size &&
+           total_size + sizes[num_segments] <= kMaxSegmentationOffloadBytes) {
+      total_size += sizes[num_segments++];
+      if (sizes[num_segments - 1] < segment_size)
+        break;
+    }
+
+    if (num_segments > 1) {
+      iovec iov;
+      iov.iov_base = buf->data() + offset;
+      iov.iov_len = total_size;
+      char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+      msghdr message = {};
+      message.msg_iov = &iov;
+      message.msg_iovlen = 1;
+      message.msg_control = control;
+      message.msg_controllen = sizeof(control);
+      cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+      cmsg->cmsg_level = SOL_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      uint16_t gso_size = static_cast<uint16_t>(segment_size);
+      memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+
+      int rv = HANDLE_EINTR(sendmsg(socket_, &message, 0));
+      if (rv >= 0) {
+        for (int i = 0, datagram_offset = offset; i < num_segments; ++i) {
+          LogWrite(sizes[i], buf->data() + datagram_offset, NULL);
+          datagram_offset += sizes[i];
+        }
+        return num_segments;
+      }
+      if (errno != EIO && errno != EINVAL && errno != ENOPROTOOPT &&
+          errno != EOPNOTSUPP) {
+        int result = MapSystemError(errno);
+        if (result != ERR_IO_PENDING)
+          LogWrite(result, NULL, NULL);
+        return result;
+      }
+      // Neither the kernel nor the device can segment the datagrams, so fall
+      // back to sendmmsg().
+      gso_supported_ = false;
+    }
+  }
+
+  int batch_size = std::min(num_datagrams, kMaxDatagramsPerCall);
+  std::vector<mmsghdr> messages(batch_size);
+  std::vector<iovec> iovecs(batch_size);
+  for (int i = 0, datagram_offset = offset; i < batch_size; ++i) {
+    iovecs[i].iov_base = buf->data() + datagram_offset;
+    iovecs[i].iov_len = sizes[i];
+    messages[i].msg_hdr.msg_iov = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    datagram_offset += sizes[i];
+  }
+
+  int num_sent =
+      HANDLE_EINTR(sendmmsg(socket_, messages.data(), batch_size, 0));
+  if (num_sent < 0) {
+    int result = MapSystemError(errno);
+    if (result != ERR_IO_PENDING)
+      LogWrite(result, NULL, NULL);
+    return result;
+  }
+  for (int i = 0; i < num_sent; ++i)
+    LogWrite(messages[i].msg_len, static_cast<char*>(iovecs[i].iov_base), NULL);
+  return num_sent;
+#else
+  scoped_refptr<IOBuffer> datagram(new WrappedIOBuffer(buf->data() + offset));
+  int result = InternalSendTo(datagram.get(), sizes[0], NULL);
+  return result < 0 ? result : 1;
+#endif
+}
+
+void UDPSocketPosix::ResetWriteState() {
+  write_buf_ = NULL;
+  write_buf_len_ = 0;
+  send_to_address_.reset();
+  write_datagram_sizes_.clear();
+  write_datagrams_sent_ = 0;
+  write_bytes_sent_ = 0;
+}
+
 int UDPSocketPosix::SetMulticastOptions() {
   if (!(socket_options_ & SOCKET_OPTION_MULTICAST_LOOP)) {
     int rv;
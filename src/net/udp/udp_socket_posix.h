@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -83,6 +84,30 @@ class NET_EXPORT UDPSocketPosix : public base::NonThreadSafe {
   // has been connected.
   int Write(IOBuffer* buf, int buf_len, const CompletionCallback& callback);
 
+  // Reads up to |max_datagrams| datagrams, with a single recvmmsg() call on
+  // Linux. The i-th datagram is read at offset i * |datagram_size| of |buf|
+  // and its size is stored in (*sizes)[i]. Returns the number of datagrams
+  // read, or a net error code. If ERR_IO_PENDING is returned, the caller must
+  // keep |buf| and |sizes| alive until the callback is called.
+  // Only usable from the client-side of a UDP socket, after the socket
+  // has been connected.
+  int ReadMultiple(IOBuffer* buf,
+                   int datagram_size,
+                   int max_datagrams,
+                   std::vector<int>* sizes,
+                   const CompletionCallback& callback);
+
+  // Writes the datagrams of |sizes| bytes stored back to back in |buf|. On
+  // Linux, runs of datagrams of the same size are sent with a single sendmsg()
+  // call using UDP generic segmentation offload when the kernel supports it,
+  // and the others with sendmmsg(). Returns the number of bytes written, or a
+  // net error code.
+  // Only usable from the client-side of a UDP socket, after the socket
+  // has been connected.
+  int WriteMultiple(IOBuffer* buf,
+                    const std::vector<int>& sizes,
+                    const CompletionCallback& callback);
+
   // Reads from a socket and receive sender address information.
   // |buf| is the buffer to read data into.
   // |buf_len| is the maximum amount of data to read.
@@ -248,6 +273,24 @@ class NET_EXPORT UDPSocketPosix : public base::NonThreadSafe {
   int InternalConnect(const IPEndPoint& address);
   int InternalRecvFrom(IOBuffer* buf, int buf_len, IPEndPoint* address);
   int InternalSendTo(IOBuffer* buf, int buf_len, const IPEndPoint* address);
+  int InternalReadMultiple(IOBuffer* buf,
+                           int datagram_size,
+                           int max_datagrams,
+                           std::vector<int>* sizes);
+
+  // Sends the datagrams of |write_datagram_sizes_| which haven't been sent
+  // yet. Returns the number of bytes written by the whole WriteMultiple(),
+  // ERR_IO_PENDING or a net error code.
+  int InternalWriteMultiple();
+
+  // Sends some of the datagrams of |sizes|, starting with the one at |offset|
+  // of |buf|. Returns the number of datagrams sent, or a net error code.
+  int InternalSendDatagrams(IOBuffer* buf,
+                            int offset,
+                            const int* sizes,
+                            int num_datagrams);
+
+  void ResetWriteState();
 
   // Applies |socket_options_| to |socket_|. Should be called before
   // Bind().
@@ -297,11 +340,27 @@ class NET_EXPORT UDPSocketPosix : public base::NonThreadSafe {
   int read_buf_len_;
   IPEndPoint* recv_from_address_;
 
+  // The sizes of the datagrams read by a pending ReadMultiple(), or NULL. In
+  // that case |read_buf_len_| is the size of each datagram.
+  std::vector<int>* read_datagram_sizes_;
+  int read_max_datagrams_;
+
   // The buffer used by InternalWrite() to retry Write requests
   scoped_refptr<IOBuffer> write_buf_;
   int write_buf_len_;
   std::unique_ptr<IPEndPoint> send_to_address_;
 
+  // The datagrams of a pending WriteMultiple(), the number of them already
+  // sent and their total size.
+  std::vector<int> write_datagram_sizes_;
+  size_t write_datagrams_sent_;
+  int write_bytes_sent_;
+
+#if defined(OS_LINUX)
+  // Whether sendmsg() accepts UDP_SEGMENT. Reset after the first failure.
+  bool gso_supported_;
+#endif
+
   // External callback; called when read is complete.
   CompletionCallback read_callback_;
 
@@ -590,6 +590,65 @@ TEST_F(UDPSocketTest, CloseWithPendingRead) {
   EXPECT_FALSE(callback.have_result());
 }
 
+#if defined(OS_POSIX)
+TEST_F(UDPSocketTest, ReadAndWriteMultiple) {
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", 0, &bind_address);
+  UDPServerSocket server(NULL, NetLog::Source());
+  ASSERT_EQ(OK, server.Listen(bind_address));
+  IPEndPoint server_address;
+  ASSERT_EQ(OK, server.GetLocalAddress(&server_address));
+
+  UDPClientSocket client(DatagramSocket::DEFAULT_BIND, RandIntCallback(), NULL,
+                         NetLog::Source());
+  ASSERT_EQ(OK, client.Connect(server_address));
+  ASSERT_TRUE(client.SupportsMultipleDatagrams());
+
+  // The first datagrams have the same size, so that the kernel can segment
+  // them.
+  const std::string kMessages[] = {"hello", "world", "!"};
+  std::string data;
+  std::vector<int> sizes;
+  for (const std::string& message : kMessages) {
+    data += message;
+    sizes.push_back(static_cast<int>(message.size()));
+  }
+  scoped_refptr<StringIOBuffer> write_buffer(new StringIOBuffer(data));
+  TestCompletionCallback write_callback;
+  int rv = client.WriteMultiple(write_buffer.get(), sizes,
+                                write_callback.callback());
+  EXPECT_EQ(static_cast<int>(data.size()), write_callback.GetResult(rv));
+
+  for (const std::string& message : kMessages) {
+    EXPECT_EQ(message, RecvFromSocket(&server));
+    EXPECT_EQ(static_cast<int>(message.size()),
+              SendToSocket(&server, message));
+  }
+
+  const int kDatagramSize = 16;
+  const int kMaxDatagrams = 4;
+  scoped_refptr<IOBuffer> read_buffer(
+      new IOBuffer(kDatagramSize * kMaxDatagrams));
+  std::vector<std::string> received;
+  while (received.size() < arraysize(kMessages)) {
+    std::vector<int> read_sizes;
+    TestCompletionCallback read_callback;
+    rv = client.ReadMultiple(read_buffer.get(), kDatagramSize, kMaxDatagrams,
+                             &read_sizes, read_callback.callback());
+    rv = read_callback.GetResult(rv);
+    ASSERT_GT(rv, 0);
+    ASSERT_EQ(static_cast<size_t>(rv), read_sizes.size());
+    for (int i = 0; i < rv; ++i) {
+      received.push_back(std::string(read_buffer->data() + i * kDatagramSize,
+                                     read_sizes[i]));
+    }
+  }
+  ASSERT_EQ(arraysize(kMessages), received.size());
+  for (size_t i = 0; i < received.size(); ++i)
+    EXPECT_EQ(kMessages[i], received[i]);
+}
+#endif  // defined(OS_POSIX)
+
 #if defined(OS_ANDROID)
 // Some Android devices do not support multicast socket.
 // The ones supporting multicast need WifiManager.MulitcastLock to enable it.
@@ -63,7 +63,9 @@ struct FetchInfo {
 // requests or network requests (which *may* still be served from cache).
 // The UniqueFetchQueue enforces that a URL can only be queued for network fetch
 // at most once. Calling Clear() resets UniqueFetchQueue's memory of which URLs
-// have been queued.
+// have been queued. Cache requests are popped ahead of network requests: they
+// complete quickly and reload dictionaries that sites already use, which would
+// otherwise go unadvertised while slow network fetches are in progress.
 class SdchDictionaryFetcher::UniqueFetchQueue {
  public:
   UniqueFetchQueue();
@@ -75,7 +77,8 @@ class SdchDictionaryFetcher::UniqueFetchQueue {
   void Clear();
 
  private:
-  std::queue<FetchInfo> queue_;
+  std::queue<FetchInfo> cache_queue_;
+  std::queue<FetchInfo> network_queue_;
   std::set<GURL> ever_network_queued_;
 
   DISALLOW_COPY_AND_ASSIGN(UniqueFetchQueue);
@@ -87,28 +90,33 @@ SdchDictionaryFetcher::UniqueFetchQueue::~UniqueFetchQueue() {}
 bool SdchDictionaryFetcher::UniqueFetchQueue::Push(const FetchInfo& info) {
   if (ever_network_queued_.count(info.url) != 0)
     return false;
-  if (!info.cache_only)
+  if (info.cache_only) {
+    cache_queue_.push(info);
+  } else {
     ever_network_queued_.insert(info.url);
-  queue_.push(info);
+    network_queue_.push(info);
+  }
   return true;
 }
 
 bool SdchDictionaryFetcher::UniqueFetchQueue::Pop(FetchInfo* info) {
-  if (IsEmpty())
+  std::queue<FetchInfo>* queue =
+      cache_queue_.empty() ? &network_queue_ : &cache_queue_;
+  if (queue->empty())
     return false;
-  *info = queue_.front();
-  queue_.pop();
+  *info = queue->front();
+  queue->pop();
   return true;
 }
 
 bool SdchDictionaryFetcher::UniqueFetchQueue::IsEmpty() const {
-  return queue_.empty();
+  return cache_queue_.empty() && network_queue_.empty();
 }
 
 void SdchDictionaryFetcher::UniqueFetchQueue::Clear() {
   ever_network_queued_.clear();
-  while (!queue_.empty())
-    queue_.pop();
+  cache_queue_ = std::queue<FetchInfo>();
+  network_queue_ = std::queue<FetchInfo>();
 }
 
 SdchDictionaryFetcher::SdchDictionaryFetcher(URLRequestContext* context)
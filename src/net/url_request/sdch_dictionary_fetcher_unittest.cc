@@ -441,6 +441,26 @@ TEST_F(SdchDictionaryFetcherTest, LoopRace) {
       additions[1].dictionary_text);
 }
 
+// Reloads from the cache should be fetched before queued network fetches.
+TEST_F(SdchDictionaryFetcherTest, ReloadsBeforeQueuedFetches) {
+  GURL dictionary0_url(PathToGurl("dictionary0"));
+  GURL dictionary1_url(PathToGurl("dictionary1"));
+  GURL dictionary2_url(PathToGurl("dictionary2"));
+  fetcher()->Schedule(dictionary0_url, GetDefaultCallback());
+  fetcher()->Schedule(dictionary1_url, GetDefaultCallback());
+  fetcher()->ScheduleReload(dictionary2_url, GetDefaultCallback());
+  WaitForNoJobs();
+
+  ASSERT_EQ(3, jobs_requested());
+  std::vector<DictionaryAdditions> additions;
+  GetDictionaryAdditions(&additions);
+  ASSERT_EQ(3u, additions.size());
+  // The first fetch was already in progress when the reload was scheduled.
+  EXPECT_EQ(dictionary0_url, additions[0].dictionary_url);
+  EXPECT_EQ(dictionary2_url, additions[1].dictionary_url);
+  EXPECT_EQ(dictionary1_url, additions[2].dictionary_url);
+}
+
 TEST_F(SdchDictionaryFetcherTest, ScheduleReloadLoadFlags) {
   GURL dictionary_url(PathToGurl("dictionary"));
   fetcher()->ScheduleReload(dictionary_url, GetDefaultCallback());
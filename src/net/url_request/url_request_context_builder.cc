@@ -20,20 +20,26 @@
 #include "net/base/net_errors.h"
 #include "net/base/network_delegate_impl.h"
 #include "net/base/sdch_manager.h"
+#include "net/cert/caching_cert_verifier.h"
 #include "net/cert/cert_verifier.h"
+#include "net/cert/cert_verifier_cache_persister.h"
+#include "net/cert/cert_verify_proc.h"
 #include "net/cert/ct_known_logs.h"
 #include "net/cert/ct_log_verifier.h"
 #include "net/cert/ct_policy_enforcer.h"
 #include "net/cert/ct_verifier.h"
 #include "net/cert/multi_log_ct_verifier.h"
+#include "net/cert/multi_threaded_cert_verifier.h"
 #include "net/code_cache/code_cache_impl.h"
 #include "net/cookies/cookie_monster.h"
+#include "net/dns/host_cache_persister.h"
 #include "net/dns/host_resolver.h"
 #include "net/http/http_auth_handler_factory.h"
 #include "net/http/http_cache.h"
 #include "net/http/http_network_layer.h"
 #include "net/http/http_server_properties_impl.h"
 #include "net/http/http_server_properties_manager.h"
+#include "net/http/http_server_properties_persister.h"
 #include "net/http/transport_security_persister.h"
 #include "net/http/transport_security_state.h"
 #include "net/quic/quic_stream_factory.h"
@@ -138,8 +144,14 @@ class ContainerURLRequestContext : public URLRequestContext {
  public:
   explicit ContainerURLRequestContext(
       const scoped_refptr<base::SingleThreadTaskRunner>& file_task_runner)
-      : file_task_runner_(file_task_runner), storage_(this) {}
-  ~ContainerURLRequestContext() override { AssertNoURLRequests(); }
+      : file_task_runner_(file_task_runner),
+        storage_(this),
+        http_server_properties_manager_(nullptr) {}
+  ~ContainerURLRequestContext() override {
+    AssertNoURLRequests();
+    if (http_server_properties_manager_)
+      http_server_properties_manager_->ShutdownOnPrefThread();
+  }
 
   URLRequestContextStorage* storage() {
     return &storage_;
@@ -163,6 +175,22 @@ class ContainerURLRequestContext : public URLRequestContext {
     transport_security_persister_ = std::move(transport_security_persister);
   }
 
+  void set_host_cache_persister(
+      std::unique_ptr<HostCachePersister> host_cache_persister) {
+    host_cache_persister_ = std::move(host_cache_persister);
+  }
+
+  void set_cert_verifier_cache_persister(
+      std::unique_ptr<CertVerifierCachePersister>
+          cert_verifier_cache_persister) {
+    cert_verifier_cache_persister_ = std::move(cert_verifier_cache_persister);
+  }
+
+  void set_http_server_properties_manager(
+      HttpServerPropertiesManager* http_server_properties_manager) {
+    http_server_properties_manager_ = http_server_properties_manager;
+  }
+
  private:
   // The thread should be torn down last.
   std::unique_ptr<base::Thread> file_thread_;
@@ -170,6 +198,12 @@ class ContainerURLRequestContext : public URLRequestContext {
 
   URLRequestContextStorage storage_;
   std::unique_ptr<TransportSecurityPersister> transport_security_persister_;
+  // Destroyed before the host resolver in |storage_|, which owns the cache.
+  std::unique_ptr<HostCachePersister> host_cache_persister_;
+  // Destroyed before the cert verifier in |storage_|, which owns the cache.
+  std::unique_ptr<CertVerifierCachePersister> cert_verifier_cache_persister_;
+  // Owned by |storage_|.
+  HttpServerPropertiesManager* http_server_properties_manager_;
 
   DISALLOW_COPY_AND_ASSIGN(ContainerURLRequestContext);
 };
@@ -328,6 +362,13 @@ std::unique_ptr<URLRequestContext> URLRequestContextBuilder::Build() {
   }
   storage->set_host_resolver(std::move(host_resolver_));
 
+  if (!host_cache_persister_path_.empty() &&
+      context->host_resolver()->GetHostCache()) {
+    context->set_host_cache_persister(base::WrapUnique(new HostCachePersister(
+        context->host_resolver()->GetHostCache(), host_cache_persister_path_,
+        context->GetFileTaskRunner())));
+  }
+
   if (!proxy_service_) {
     // TODO(willchan): Switch to using this code when
     // ProxyService::CreateSystemProxyConfigService()'s signature doesn't suck.
@@ -387,6 +428,18 @@ std::unique_ptr<URLRequestContext> URLRequestContextBuilder::Build() {
 
   if (http_server_properties_) {
     storage->set_http_server_properties(std::move(http_server_properties_));
+  } else if (!http_server_properties_persister_path_.empty()) {
+    // The pref and network threads of the manager are both this thread.
+    HttpServerPropertiesManager* http_server_properties_manager =
+        new HttpServerPropertiesManager(
+            new HttpServerPropertiesPersister(
+                http_server_properties_persister_path_,
+                context->GetFileTaskRunner()),
+            base::ThreadTaskRunnerHandle::Get());
+    http_server_properties_manager->InitializeOnNetworkThread();
+    context->set_http_server_properties_manager(http_server_properties_manager);
+    storage->set_http_server_properties(
+        base::WrapUnique(http_server_properties_manager));
   } else {
     storage->set_http_server_properties(
         std::unique_ptr<HttpServerProperties>(new HttpServerPropertiesImpl()));
@@ -394,6 +447,15 @@ std::unique_ptr<URLRequestContext> URLRequestContextBuilder::Build() {
 
   if (cert_verifier_) {
     storage->set_cert_verifier(std::move(cert_verifier_));
+  } else if (!cert_verifier_cache_persister_path_.empty()) {
+    std::unique_ptr<CachingCertVerifier> caching_cert_verifier(
+        new CachingCertVerifier(base::MakeUnique<MultiThreadedCertVerifier>(
+            CertVerifyProc::CreateDefault())));
+    context->set_cert_verifier_cache_persister(
+        base::WrapUnique(new CertVerifierCachePersister(
+            caching_cert_verifier.get(), cert_verifier_cache_persister_path_,
+            context->GetFileTaskRunner())));
+    storage->set_cert_verifier(std::move(caching_cert_verifier));
   } else {
     storage->set_cert_verifier(CertVerifier::CreateDefault());
   }
@@ -460,6 +522,8 @@ std::unique_ptr<URLRequestContext> URLRequestContextBuilder::Build() {
       http_network_session_params_.quic_migrate_sessions_early;
   network_session_params.quic_disable_bidirectional_streams =
       http_network_session_params_.quic_disable_bidirectional_streams;
+  network_session_params.warm_origins =
+      http_network_session_params_.warm_origins;
   if (proxy_delegate_) {
     network_session_params.proxy_delegate = proxy_delegate_.get();
     storage->set_proxy_delegate(std::move(proxy_delegate_));
@@ -108,6 +108,7 @@ class NET_EXPORT URLRequestContextBuilder {
     bool quic_migrate_sessions_on_network_change;
     bool quic_migrate_sessions_early;
     bool quic_disable_bidirectional_streams;
+    HttpWarmConnectionReservoir::WarmOrigins warm_origins;
   };
 
   URLRequestContextBuilder();
@@ -214,6 +215,33 @@ class NET_EXPORT URLRequestContextBuilder {
     transport_security_persister_path_ = transport_security_persister_path;
   }
 
+  // Persists the cache of the host resolver in |host_cache_persister_path|,
+  // so that hostnames resolved before a restart don't wait for DNS. See
+  // HostResolver::Options::max_stale_age for serving the restored entries
+  // once they have expired.
+  void set_host_cache_persister_path(
+      const base::FilePath& host_cache_persister_path) {
+    host_cache_persister_path_ = host_cache_persister_path;
+  }
+
+  // Persists the successful results of the default cert verifier in
+  // |cert_verifier_cache_persister_path|, so that chains verified before a
+  // restart aren't verified again. Ignored if SetCertVerifier() is called.
+  void set_cert_verifier_cache_persister_path(
+      const base::FilePath& cert_verifier_cache_persister_path) {
+    cert_verifier_cache_persister_path_ = cert_verifier_cache_persister_path;
+  }
+
+  // Persists the HttpServerProperties, including the QUIC server configs
+  // stored in them (see set_quic_max_server_configs_stored_in_properties()),
+  // in |http_server_properties_persister_path|. Ignored if
+  // SetHttpServerProperties() is called.
+  void set_http_server_properties_persister_path(
+      const base::FilePath& http_server_properties_persister_path) {
+    http_server_properties_persister_path_ =
+        http_server_properties_persister_path;
+  }
+
   void SetSpdyAndQuicEnabled(bool spdy_enabled,
                              bool quic_enabled);
 
@@ -286,6 +314,13 @@ class NET_EXPORT URLRequestContextBuilder {
         quic_disable_bidirectional_streams;
   }
 
+  // Keeps |num_connections| idle connections to |origin| in the socket pools,
+  // so that requests to it rarely wait for a new connection.
+  void add_warm_origin(const url::SchemeHostPort& origin,
+                       int num_connections) {
+    http_network_session_params_.warm_origins[origin] = num_connections;
+  }
+
   void set_throttling_enabled(bool throttling_enabled) {
     throttling_enabled_ = throttling_enabled;
   }
@@ -361,6 +396,9 @@ class NET_EXPORT URLRequestContextBuilder {
   HttpCacheParams http_cache_params_;
   HttpNetworkSessionParams http_network_session_params_;
   base::FilePath transport_security_persister_path_;
+  base::FilePath http_server_properties_persister_path_;
+  base::FilePath host_cache_persister_path_;
+  base::FilePath cert_verifier_cache_persister_path_;
   NetLog* net_log_;
   std::unique_ptr<HostResolver> host_resolver_;
   std::unique_ptr<ChannelIDService> channel_id_service_;
@@ -4,45 +4,35 @@
 
 #include "net/websockets/websocket_deflater.h"
 
-#include <string.h>
 #include <algorithm>
 #include <deque>
+#include <utility>
 #include <vector>
 
 #include "base/logging.h"
 #include "net/base/io_buffer.h"
+#include "net/websockets/websocket_zlib_stream_pool.h"
 #include "third_party/zlib/zlib.h"
 
 namespace net {
 
 WebSocketDeflater::WebSocketDeflater(ContextTakeOverMode mode)
-    : mode_(mode), are_bytes_added_(false) {}
+    : mode_(mode), window_bits_(0), are_bytes_added_(false) {}
 
 WebSocketDeflater::~WebSocketDeflater() {
   if (stream_) {
-    deflateEnd(stream_.get());
-    stream_.reset(NULL);
+    WebSocketZlibStreamPool::GetInstance()->ReleaseDeflateStream(
+        window_bits_, std::move(stream_));
   }
 }
 
 bool WebSocketDeflater::Initialize(int window_bits) {
   DCHECK(!stream_);
-  stream_.reset(new z_stream);
-
-  DCHECK_LE(8, window_bits);
-  DCHECK_GE(15, window_bits);
-  memset(stream_.get(), 0, sizeof(*stream_));
-  int result = deflateInit2(stream_.get(),
-                            Z_DEFAULT_COMPRESSION,
-                            Z_DEFLATED,
-                            -window_bits,  // Negative value for raw deflate
-                            8,  // default mem level
-                            Z_DEFAULT_STRATEGY);
-  if (result != Z_OK) {
-    deflateEnd(stream_.get());
-    stream_.reset();
+  stream_ = WebSocketZlibStreamPool::GetInstance()->TakeDeflateStream(
+      window_bits);
+  if (!stream_)
     return false;
-  }
+  window_bits_ = window_bits;
   const size_t kFixedBufferSize = 4096;
   fixed_buffer_.resize(kFixedBufferSize);
   return true;
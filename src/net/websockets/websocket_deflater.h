@@ -67,6 +67,8 @@ class NET_EXPORT_PRIVATE WebSocketDeflater {
 
   std::unique_ptr<z_stream_s> stream_;
   ContextTakeOverMode mode_;
+  // The window bits |stream_| was created with.
+  int window_bits_;
   std::deque<char> buffer_;
   std::vector<char> fixed_buffer_;
   // true if bytes were added after last Finish().
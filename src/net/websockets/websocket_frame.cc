@@ -10,6 +10,7 @@
 #include "base/big_endian.h"
 #include "base/logging.h"
 #include "base/rand_util.h"
+#include "build/build_config.h"
 #include "net/base/io_buffer.h"
 #include "net/base/net_errors.h"
 
@@ -19,9 +20,12 @@ namespace {
 
 // GCC (and Clang) can transparently use vector ops. Only try to do this on
 // architectures where we know it works, otherwise gcc will attempt to emulate
-// the vector ops, which is unlikely to be efficient.
-// TODO(ricea): Add ARCH_CPU_ARM_FAMILY when arm_neon=1 becomes the default.
-#if defined(COMPILER_GCC) && defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+// the vector ops, which is unlikely to be efficient. On x86 the XOR compiles
+// to SSE2, and on ARM to NEON when the target has it (always on ARM64).
+#if defined(COMPILER_GCC) && !defined(OS_NACL) && \
+    (defined(ARCH_CPU_X86_FAMILY) ||              \
+     (defined(ARCH_CPU_ARM_FAMILY) &&             \
+      (defined(__ARM_NEON__) || defined(__ARM_NEON))))
 
 using PackedMaskType = uint32_t __attribute__((vector_size(16)));
 
@@ -29,8 +33,7 @@ using PackedMaskType = uint32_t __attribute__((vector_size(16)));
 
 using PackedMaskType = size_t;
 
-#endif  // defined(COMPILER_GCC) && defined(ARCH_CPU_X86_FAMILY) &&
-        // !defined(OS_NACL)
+#endif
 
 const uint8_t kFinalBit = 0x80;
 const uint8_t kReserved1Bit = 0x40;
@@ -6,10 +6,12 @@
 
 #include <algorithm>
 #include <deque>
+#include <utility>
 #include <vector>
 
 #include "base/logging.h"
 #include "net/base/io_buffer.h"
+#include "net/websockets/websocket_zlib_stream_pool.h"
 #include "third_party/zlib/zlib.h"
 
 namespace net {
@@ -33,35 +35,33 @@ class ShrinkableIOBufferWithSize : public IOBufferWithSize {
 }  // namespace
 
 WebSocketInflater::WebSocketInflater()
-    : input_queue_(kDefaultInputIOBufferCapacity),
+    : window_bits_(0),
+      input_queue_(kDefaultInputIOBufferCapacity),
       output_buffer_(kDefaultBufferCapacity) {}
 
 WebSocketInflater::WebSocketInflater(size_t input_queue_capacity,
                                      size_t output_buffer_capacity)
-    : input_queue_(input_queue_capacity),
+    : window_bits_(0),
+      input_queue_(input_queue_capacity),
       output_buffer_(output_buffer_capacity) {
   DCHECK_GT(input_queue_capacity, 0u);
   DCHECK_GT(output_buffer_capacity, 0u);
 }
 
 bool WebSocketInflater::Initialize(int window_bits) {
-  DCHECK_LE(8, window_bits);
-  DCHECK_GE(15, window_bits);
-  stream_.reset(new z_stream);
-  memset(stream_.get(), 0, sizeof(*stream_));
-  int result = inflateInit2(stream_.get(), -window_bits);
-  if (result != Z_OK) {
-    inflateEnd(stream_.get());
-    stream_.reset();
+  DCHECK(!stream_);
+  stream_ = WebSocketZlibStreamPool::GetInstance()->TakeInflateStream(
+      window_bits);
+  if (!stream_)
     return false;
-  }
+  window_bits_ = window_bits;
   return true;
 }
 
 WebSocketInflater::~WebSocketInflater() {
   if (stream_) {
-    inflateEnd(stream_.get());
-    stream_.reset();
+    WebSocketZlibStreamPool::GetInstance()->ReleaseInflateStream(
+        window_bits_, std::move(stream_));
   }
 }
 
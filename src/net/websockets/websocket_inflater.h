@@ -121,6 +121,8 @@ class NET_EXPORT_PRIVATE WebSocketInflater {
   int InflateChokedInput();
 
   std::unique_ptr<z_stream_s> stream_;
+  // The window bits |stream_| was created with.
+  int window_bits_;
   InputQueue input_queue_;
   OutputBuffer output_buffer_;
 
@@ -0,0 +1,155 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/websockets/websocket_zlib_stream_pool.h"
+
+#include <string.h>
+#include <utility>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "third_party/zlib/zlib.h"
+
+namespace net {
+
+namespace {
+
+base::LazyInstance<WebSocketZlibStreamPool>::Leaky g_stream_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Frees |streams| with |end|, which is deflateEnd() or inflateEnd().
+void EndStreams(const std::multimap<int, std::unique_ptr<z_stream_s>>& streams,
+                int (*end)(z_streamp)) {
+  for (const auto& entry : streams)
+    end(entry.second.get());
+}
+
+}  // namespace
+
+// static
+WebSocketZlibStreamPool* WebSocketZlibStreamPool::GetInstance() {
+  return g_stream_pool.Pointer();
+}
+
+std::unique_ptr<z_stream_s> WebSocketZlibStreamPool::TakeDeflateStream(
+    int window_bits) {
+  DCHECK_LE(8, window_bits);
+  DCHECK_GE(15, window_bits);
+  {
+    base::AutoLock lock(lock_);
+    std::unique_ptr<z_stream_s> stream =
+        TakeIdleStream(&idle_deflate_streams_, window_bits);
+    if (stream)
+      return stream;
+  }
+
+  std::unique_ptr<z_stream_s> stream(new z_stream);
+  memset(stream.get(), 0, sizeof(*stream));
+  int result = deflateInit2(stream.get(),
+                            Z_DEFAULT_COMPRESSION,
+                            Z_DEFLATED,
+                            -window_bits,  // Negative value for raw deflate
+                            8,  // default mem level
+                            Z_DEFAULT_STRATEGY);
+  if (result != Z_OK) {
+    deflateEnd(stream.get());
+    return nullptr;
+  }
+  return stream;
+}
+
+void WebSocketZlibStreamPool::ReleaseDeflateStream(
+    int window_bits,
+    std::unique_ptr<z_stream_s> stream) {
+  DCHECK(stream);
+  if (deflateReset(stream.get()) == Z_OK) {
+    base::AutoLock lock(lock_);
+    if (idle_deflate_streams_.size() < kMaxIdleStreams) {
+      idle_deflate_streams_.insert(std::make_pair(window_bits,
+                                                  std::move(stream)));
+      return;
+    }
+  }
+  deflateEnd(stream.get());
+}
+
+std::unique_ptr<z_stream_s> WebSocketZlibStreamPool::TakeInflateStream(
+    int window_bits) {
+  DCHECK_LE(8, window_bits);
+  DCHECK_GE(15, window_bits);
+  {
+    base::AutoLock lock(lock_);
+    std::unique_ptr<z_stream_s> stream =
+        TakeIdleStream(&idle_inflate_streams_, window_bits);
+    if (stream)
+      return stream;
+  }
+
+  std::unique_ptr<z_stream_s> stream(new z_stream);
+  memset(stream.get(), 0, sizeof(*stream));
+  int result = inflateInit2(stream.get(), -window_bits);
+  if (result != Z_OK) {
+    inflateEnd(stream.get());
+    return nullptr;
+  }
+  return stream;
+}
+
+void WebSocketZlibStreamPool::ReleaseInflateStream(
+    int window_bits,
+    std::unique_ptr<z_stream_s> stream) {
+  DCHECK(stream);
+  if (inflateReset(stream.get()) == Z_OK) {
+    base::AutoLock lock(lock_);
+    if (idle_inflate_streams_.size() < kMaxIdleStreams) {
+      idle_inflate_streams_.insert(std::make_pair(window_bits,
+                                                  std::move(stream)));
+      return;
+    }
+  }
+  inflateEnd(stream.get());
+}
+
+size_t WebSocketZlibStreamPool::GetIdleDeflateStreamCountForTesting() const {
+  base::AutoLock lock(lock_);
+  return idle_deflate_streams_.size();
+}
+
+size_t WebSocketZlibStreamPool::GetIdleInflateStreamCountForTesting() const {
+  base::AutoLock lock(lock_);
+  return idle_inflate_streams_.size();
+}
+
+void WebSocketZlibStreamPool::ClearForTesting() {
+  StreamMap deflate_streams;
+  StreamMap inflate_streams;
+  {
+    base::AutoLock lock(lock_);
+    deflate_streams.swap(idle_deflate_streams_);
+    inflate_streams.swap(idle_inflate_streams_);
+  }
+  EndStreams(deflate_streams, &deflateEnd);
+  EndStreams(inflate_streams, &inflateEnd);
+}
+
+WebSocketZlibStreamPool::WebSocketZlibStreamPool() {}
+
+WebSocketZlibStreamPool::~WebSocketZlibStreamPool() {
+  EndStreams(idle_deflate_streams_, &deflateEnd);
+  EndStreams(idle_inflate_streams_, &inflateEnd);
+}
+
+std::unique_ptr<z_stream_s> WebSocketZlibStreamPool::TakeIdleStream(
+    StreamMap* streams,
+    int window_bits) {
+  lock_.AssertAcquired();
+  StreamMap::iterator it = streams->find(window_bits);
+  if (it == streams->end())
+    return nullptr;
+  std::unique_ptr<z_stream_s> stream = std::move(it->second);
+  streams->erase(it);
+  return stream;
+}
+
+}  // namespace net
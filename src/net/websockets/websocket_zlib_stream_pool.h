@@ -0,0 +1,82 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_WEBSOCKETS_WEBSOCKET_ZLIB_STREAM_POOL_H_
+#define NET_WEBSOCKETS_WEBSOCKET_ZLIB_STREAM_POOL_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "net/base/net_export.h"
+
+extern "C" struct z_stream_s;
+
+namespace base {
+template <typename T>
+struct DefaultLazyInstanceTraits;
+}
+
+namespace net {
+
+// Keeps the zlib streams of finished permessage-deflate connections, so that
+// new connections can reuse their allocated state (up to 256KB per deflate
+// stream) instead of allocating and initialising it again. Streams are only
+// shared between connections that negotiated the same window size, and are
+// reset before they're reused, so no data is shared between connections.
+//
+// Thread-safe.
+class NET_EXPORT_PRIVATE WebSocketZlibStreamPool {
+ public:
+  // The number of idle streams of each kind that are kept.
+  static const size_t kMaxIdleStreams = 4;
+
+  static WebSocketZlibStreamPool* GetInstance();
+
+  // Returns a raw deflate stream with |window_bits|, initialised with the
+  // parameters used by WebSocketDeflater, or nullptr on failure.
+  std::unique_ptr<z_stream_s> TakeDeflateStream(int window_bits);
+  // Takes back a stream returned by TakeDeflateStream(|window_bits|). The
+  // stream is reset, or freed if enough streams are idle already.
+  void ReleaseDeflateStream(int window_bits,
+                            std::unique_ptr<z_stream_s> stream);
+
+  // The same as above, for raw inflate streams.
+  std::unique_ptr<z_stream_s> TakeInflateStream(int window_bits);
+  void ReleaseInflateStream(int window_bits,
+                            std::unique_ptr<z_stream_s> stream);
+
+  size_t GetIdleDeflateStreamCountForTesting() const;
+  size_t GetIdleInflateStreamCountForTesting() const;
+
+  // Frees all idle streams.
+  void ClearForTesting();
+
+ private:
+  friend struct base::DefaultLazyInstanceTraits<WebSocketZlibStreamPool>;
+
+  // Idle streams, keyed by window bits.
+  using StreamMap = std::multimap<int, std::unique_ptr<z_stream_s>>;
+
+  WebSocketZlibStreamPool();
+  ~WebSocketZlibStreamPool();
+
+  // Removes a stream with |window_bits| from |streams|, if there's one.
+  std::unique_ptr<z_stream_s> TakeIdleStream(StreamMap* streams,
+                                             int window_bits);
+
+  mutable base::Lock lock_;
+  StreamMap idle_deflate_streams_;
+  StreamMap idle_inflate_streams_;
+
+  DISALLOW_COPY_AND_ASSIGN(WebSocketZlibStreamPool);
+};
+
+}  // namespace net
+
+#endif  // NET_WEBSOCKETS_WEBSOCKET_ZLIB_STREAM_POOL_H_
@@ -0,0 +1,100 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/websockets/websocket_zlib_stream_pool.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "net/base/io_buffer.h"
+#include "net/websockets/websocket_deflater.h"
+#include "net/websockets/websocket_inflater.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/zlib/zlib.h"
+
+namespace net {
+
+namespace {
+
+class WebSocketZlibStreamPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override { pool()->ClearForTesting(); }
+  void TearDown() override { pool()->ClearForTesting(); }
+
+  WebSocketZlibStreamPool* pool() {
+    return WebSocketZlibStreamPool::GetInstance();
+  }
+};
+
+TEST_F(WebSocketZlibStreamPoolTest, ReusesStreamsWithSameWindowBits) {
+  std::unique_ptr<z_stream_s> stream = pool()->TakeDeflateStream(15);
+  ASSERT_TRUE(stream);
+  z_stream_s* raw_stream = stream.get();
+  pool()->ReleaseDeflateStream(15, std::move(stream));
+  EXPECT_EQ(1u, pool()->GetIdleDeflateStreamCountForTesting());
+  EXPECT_EQ(0u, pool()->GetIdleInflateStreamCountForTesting());
+
+  // A stream with another window size isn't reused.
+  std::unique_ptr<z_stream_s> other_stream = pool()->TakeDeflateStream(10);
+  ASSERT_TRUE(other_stream);
+  EXPECT_NE(raw_stream, other_stream.get());
+  EXPECT_EQ(1u, pool()->GetIdleDeflateStreamCountForTesting());
+
+  stream = pool()->TakeDeflateStream(15);
+  EXPECT_EQ(raw_stream, stream.get());
+  EXPECT_EQ(0u, pool()->GetIdleDeflateStreamCountForTesting());
+
+  pool()->ReleaseDeflateStream(15, std::move(stream));
+  pool()->ReleaseDeflateStream(10, std::move(other_stream));
+  EXPECT_EQ(2u, pool()->GetIdleDeflateStreamCountForTesting());
+}
+
+TEST_F(WebSocketZlibStreamPoolTest, LimitsIdleStreams) {
+  std::vector<std::unique_ptr<z_stream_s>> streams;
+  for (size_t i = 0; i <= WebSocketZlibStreamPool::kMaxIdleStreams; ++i) {
+    streams.push_back(pool()->TakeInflateStream(15));
+    ASSERT_TRUE(streams.back());
+  }
+  for (auto& stream : streams)
+    pool()->ReleaseInflateStream(15, std::move(stream));
+  EXPECT_EQ(WebSocketZlibStreamPool::kMaxIdleStreams,
+            pool()->GetIdleInflateStreamCountForTesting());
+}
+
+// A deflater using a stream released by another one must not refer back to
+// the data compressed by the first.
+TEST_F(WebSocketZlibStreamPoolTest, ReusedDeflaterStartsWithEmptyContext) {
+  const std::string kFirstOutput("\xf2\x48\xcd\xc9\xc9\x07\x00", 7);
+  for (int i = 0; i < 2; ++i) {
+    WebSocketDeflater deflater(WebSocketDeflater::TAKE_OVER_CONTEXT);
+    ASSERT_TRUE(deflater.Initialize(15));
+    ASSERT_TRUE(deflater.AddBytes("Hello", 5));
+    ASSERT_TRUE(deflater.Finish());
+    scoped_refptr<IOBufferWithSize> output =
+        deflater.GetOutput(deflater.CurrentOutputSize());
+    EXPECT_EQ(kFirstOutput, std::string(output->data(), output->size()));
+  }
+  EXPECT_EQ(1u, pool()->GetIdleDeflateStreamCountForTesting());
+}
+
+TEST_F(WebSocketZlibStreamPoolTest, ReusedInflaterStartsWithEmptyContext) {
+  for (int i = 0; i < 2; ++i) {
+    WebSocketInflater inflater;
+    ASSERT_TRUE(inflater.Initialize(15));
+    ASSERT_TRUE(inflater.AddBytes("\xf2\x48\xcd\xc9\xc9\x07\x00", 7));
+    ASSERT_TRUE(inflater.Finish());
+    scoped_refptr<IOBufferWithSize> output =
+        inflater.GetOutput(inflater.CurrentOutputSize());
+    ASSERT_TRUE(output);
+    EXPECT_EQ("Hello", std::string(output->data(), output->size()));
+  }
+  EXPECT_EQ(1u, pool()->GetIdleInflateStreamCountForTesting());
+}
+
+}  // namespace
+
+}  // namespace net
@@ -5,9 +5,17 @@
 #include "ozone/media/vaapi_picture_wayland.h"
 
 #include <string>
+#include <vector>
 
 namespace content {
 
+namespace {
+
+// DRM_FORMAT_XRGB8888, which is VA_FOURCC_BGRX in memory order.
+const EGLint kDrmFormatXRGB8888 = 0x34325258;
+
+}  // namespace
+
 VaapiPictureWayland::VaapiPictureWayland(
     const scoped_refptr<VaapiWrapper>& vaapi_wrapper,
     const base::Callback<bool(void)> make_context_current,
@@ -27,13 +35,15 @@ bool VaapiPictureWayland::Initialize() {
   if (!make_context_current_.Run())
     return false;
 
-  if (!va_wrapper_->CreateRGBImage(size(), va_image_.get())) {
-    DVLOG(1) << "Failed to create VAImage";
-    return false;
-  }
+  if (!InitializeDmaBuf()) {
+    if (!va_wrapper_->CreateRGBImage(size(), va_image_.get())) {
+      DVLOG(1) << "Failed to create VAImage";
+      return false;
+    }
 
-  if (!CreateEGLImage(va_image_.get()))
-     return false;
+    if (!CreateEGLImage(va_image_.get()))
+       return false;
+  }
 
   gfx::ScopedTextureBinder texture_binder(GL_TEXTURE_2D, texture_id());
   if (!gl_image_->BindTexImage(GL_TEXTURE_2D)) {
@@ -56,6 +66,73 @@ VaapiPictureWayland::~VaapiPictureWayland() {
 
   if (va_wrapper_)
     va_wrapper_->DestroyImage(va_image_.get());
+  va_surface_ = nullptr;
+}
+
+bool VaapiPictureWayland::InitializeDmaBuf() {
+  if (!gl::GLSurfaceEGL::HasEGLExtension("EGL_EXT_image_dma_buf_import"))
+    return false;
+
+  std::vector<VASurfaceAttrib> va_attribs(1);
+  va_attribs[0].type = VASurfaceAttribPixelFormat;
+  va_attribs[0].flags = VA_SURFACE_ATTRIB_SETTABLE;
+  va_attribs[0].value.type = VAGenericValueTypeInteger;
+  va_attribs[0].value.value.i = VA_FOURCC_BGRX;
+
+  va_surface_ =
+      va_wrapper_->CreateUnownedSurface(VA_RT_FORMAT_RGB32, size(), va_attribs);
+  if (!va_surface_) {
+    DVLOG(1) << "Failed to create RGB VASurface";
+    return false;
+  }
+
+  if (!va_wrapper_->DeriveImage(va_surface_->id(), va_image_.get())) {
+    va_surface_ = nullptr;
+    return false;
+  }
+
+  if (!CreateDmaBufEGLImage(va_image_.get())) {
+    va_wrapper_->DestroyImage(va_image_.get());
+    va_surface_ = nullptr;
+    gl_image_ = nullptr;
+    return false;
+  }
+
+  return true;
+}
+
+bool VaapiPictureWayland::CreateDmaBufEGLImage(VAImage* va_image) {
+  DCHECK(va_image);
+
+  VABufferInfo buffer_info;
+  if (!va_wrapper_->ExportBufferAsDmaBuf(va_image->buf, &buffer_info)) {
+    DVLOG(1) << "Failed to export VAImage as dmabuf";
+    return false;
+  }
+
+  EGLint attribs[] = {
+      EGL_WIDTH, static_cast<EGLint>(va_image->width),
+      EGL_HEIGHT, static_cast<EGLint>(va_image->height),
+      EGL_LINUX_DRM_FOURCC_EXT, kDrmFormatXRGB8888,
+      EGL_DMA_BUF_PLANE0_FD_EXT, static_cast<EGLint>(buffer_info.handle),
+      EGL_DMA_BUF_PLANE0_OFFSET_EXT, static_cast<EGLint>(va_image->offsets[0]),
+      EGL_DMA_BUF_PLANE0_PITCH_EXT, static_cast<EGLint>(va_image->pitches[0]),
+      EGL_NONE };
+
+  // EGL keeps its own reference to the dmabuf, so the handle can be released
+  // right after the import.
+  gl_image_ = new gl::GLImageEGL(size());
+  bool result = gl_image_->Initialize(EGL_LINUX_DMA_BUF_EXT,
+                                      static_cast<EGLClientBuffer>(nullptr),
+                                      attribs);
+  va_wrapper_->ReleaseBufferHandle(va_image->buf);
+
+  if (!result) {
+    LOG(ERROR) << "Failed to create a GLImageEGL for a Va dmabuf.";
+    return false;
+  }
+
+  return true;
 }
 
 bool VaapiPictureWayland::CreateEGLImage(VAImage* va_image) {
@@ -97,9 +174,14 @@ bool VaapiPictureWayland::CreateEGLImage(VAImage* va_image) {
 
 bool VaapiPictureWayland::DownloadFromSurface(
     const scoped_refptr<VASurface>& va_surface) {
-    DCHECK(CalledOnValidThread());
-    if (!va_wrapper_->PutSurfaceIntoImage(va_surface->id(), va_image_.get()))
-      return false;
+  DCHECK(CalledOnValidThread());
+  if (va_surface_) {
+    return va_wrapper_->BlitSurface(va_surface->id(), va_surface->size(),
+                                    va_surface_->id(), size());
+  }
+
+  if (!va_wrapper_->PutSurfaceIntoImage(va_surface->id(), va_image_.get()))
+    return false;
 
   return true;
 }
@@ -33,6 +33,12 @@ class VaapiPictureWayland : public VaapiPicture {
   scoped_refptr<gl::GLImage> GetImageToBind() override;
 
  private:
+  // Zero-copy path: the picture owns an RGB VASurface exported as a dmabuf
+  // and imported into EGL, so decoded frames are converted and scaled into
+  // it by the VPP engine and sampled by GL without another copy.
+  bool InitializeDmaBuf();
+  bool CreateDmaBufEGLImage(VAImage* va_image);
+
   bool CreateEGLImage(VAImage* va_image);
 
   base::Callback<bool(void)> make_context_current_; //NOLINT
@@ -40,6 +46,8 @@ class VaapiPictureWayland : public VaapiPicture {
   const scoped_refptr<VaapiWrapper>&  va_wrapper_;
 
   std::unique_ptr<VAImage> va_image_;
+  // Set when the zero-copy path is used; |va_image_| is then derived from it.
+  scoped_refptr<VASurface> va_surface_;
   // EGLImage bound to the GL textures used by the VDA client.
   scoped_refptr<gl::GLImageEGL> gl_image_;
 
@@ -1080,6 +1080,25 @@ bool VaapiWrapper::AcquireBufferHandle(VABufferID buf_id,
   return true;
 }
 
+bool VaapiWrapper::DeriveImage(VASurfaceID va_surface_id, VAImage* image) {
+  base::AutoLock auto_lock(*va_lock_);
+  VAStatus va_res = vaDeriveImage(va_display_, va_surface_id, image);
+  VA_SUCCESS_OR_RETURN(va_res, "vaDeriveImage failed", false);
+  return true;
+}
+
+bool VaapiWrapper::ExportBufferAsDmaBuf(VABufferID buf_id,
+                                        VABufferInfo* buf_info) {
+  DCHECK(buf_info);
+  base::AutoLock auto_lock(*va_lock_);
+
+  buf_info->mem_type = VA_SURFACE_ATTRIB_MEM_TYPE_DRM_PRIME;
+  VAStatus va_res = vaAcquireBufferHandle(va_display_, buf_id, buf_info);
+  VA_SUCCESS_OR_RETURN(va_res, "Failed to export buffer as dmabuf", false);
+
+  return true;
+}
+
 bool VaapiWrapper::ReleaseBufferHandle(VABufferID buf_id) {
   base::AutoLock auto_lock(*va_lock_);
   VAStatus va_res = vaReleaseBufferHandle(va_display_, buf_id);
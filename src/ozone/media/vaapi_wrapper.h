@@ -198,6 +198,13 @@ class CONTENT_EXPORT VaapiWrapper {
   bool AcquireBufferHandle(VABufferID buf_id, VABufferInfo* buf_info);
   bool ReleaseBufferHandle(VABufferID buf_id);
 
+  // Derive a VAImage that aliases the memory of |va_surface_id| without
+  // mapping it. Release it with DestroyImage().
+  bool DeriveImage(VASurfaceID va_surface_id, VAImage* image);
+  // Export |buf_id| as a dmabuf, whose fd is returned in |buf_info->handle|
+  // until ReleaseBufferHandle() is called.
+  bool ExportBufferAsDmaBuf(VABufferID buf_id, VABufferInfo* buf_info);
+
  private:
   struct ProfileInfo {
     VAProfile va_profile;
@@ -0,0 +1,75 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OZONE_PLATFORM_INPUT_EVENT_BATCH_H_
+#define OZONE_PLATFORM_INPUT_EVENT_BATCH_H_
+
+#include <stdint.h>
+
+namespace ui {
+
+// Coalesced pointer input sent from the Wayland host to the browser process
+// in a single WaylandInput_BatchNotify message. Only the latest motion is
+// kept, while axis offsets are accumulated. Events that can not be coalesced
+// (buttons, keys, touches, ...) flush the batch before they are sent.
+struct InputEventBatch {
+  InputEventBatch() { Reset(); }
+
+  bool IsEmpty() const { return !has_motion && !has_axis; }
+
+  void Reset() {
+    has_motion = false;
+    motion_x = 0;
+    motion_y = 0;
+    has_axis = false;
+    axis_x = 0;
+    axis_y = 0;
+    axis_xoffset = 0;
+    axis_yoffset = 0;
+    coalesced_count = 0;
+  }
+
+  void AddMotion(float x, float y) {
+    has_motion = true;
+    motion_x = x;
+    motion_y = y;
+    ++coalesced_count;
+  }
+
+  void AddAxis(float x, float y, int xoffset, int yoffset) {
+    has_axis = true;
+    axis_x = x;
+    axis_y = y;
+    axis_xoffset += xoffset;
+    axis_yoffset += yoffset;
+    ++coalesced_count;
+  }
+
+  bool has_motion;
+  float motion_x;
+  float motion_y;
+  bool has_axis;
+  float axis_x;
+  float axis_y;
+  int axis_xoffset;
+  int axis_yoffset;
+  // Number of Wayland events folded into this batch.
+  uint32_t coalesced_count;
+};
+
+}  // namespace ui
+
+#endif  // OZONE_PLATFORM_INPUT_EVENT_BATCH_H_
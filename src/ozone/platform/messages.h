@@ -26,6 +26,7 @@
 #include "ipc/ipc_param_traits.h"
 #include "ipc/param_traits_macros.h"
 #include "ozone/platform/input_content_type.h"
+#include "ozone/platform/input_event_batch.h"
 #include "ozone/platform/window_constants.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/events/event_constants.h"
@@ -59,6 +60,18 @@ IPC_ENUM_TRAITS_MAX_VALUE(ui::WidgetState,
 IPC_ENUM_TRAITS_MAX_VALUE(ui::WidgetType,
                           ui::TOOLTIP)
 
+IPC_STRUCT_TRAITS_BEGIN(ui::InputEventBatch)
+  IPC_STRUCT_TRAITS_MEMBER(has_motion)
+  IPC_STRUCT_TRAITS_MEMBER(motion_x)
+  IPC_STRUCT_TRAITS_MEMBER(motion_y)
+  IPC_STRUCT_TRAITS_MEMBER(has_axis)
+  IPC_STRUCT_TRAITS_MEMBER(axis_x)
+  IPC_STRUCT_TRAITS_MEMBER(axis_y)
+  IPC_STRUCT_TRAITS_MEMBER(axis_xoffset)
+  IPC_STRUCT_TRAITS_MEMBER(axis_yoffset)
+  IPC_STRUCT_TRAITS_MEMBER(coalesced_count)
+IPC_STRUCT_TRAITS_END()
+
 #if defined(OS_WEBOS)
 IPC_ENUM_TRAITS_MAX_VALUE(webos::InputPanelState, webos::INPUT_PANEL_SHOWN)
 IPC_ENUM_TRAITS_MAX_VALUE(ui::WebOSXInputSpecialKeySymbolType,
@@ -164,6 +177,9 @@ IPC_MESSAGE_CONTROL4(WaylandInput_AxisNotify,  // NOLINT(readability/fn_size)
                      int /*x_offset*/,
                      int /*y_offset*/)
 
+IPC_MESSAGE_CONTROL1(WaylandInput_BatchNotify,  // NOLINT(readability/fn_size)
+                     ui::InputEventBatch /*batch*/)
+
 IPC_MESSAGE_CONTROL3(WaylandInput_PointerEnter,  // NOLINT(readability/fn_size)
                      unsigned /*handle*/,
                      float /*x*/,
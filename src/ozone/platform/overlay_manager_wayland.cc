@@ -0,0 +1,79 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ozone/platform/overlay_manager_wayland.h"
+
+#include "base/lazy_instance.h"
+#include "base/memory/ptr_util.h"
+#include "ui/gfx/geometry/rect_conversions.h"
+#include "ui/gfx/geometry/size_conversions.h"
+#include "ui/ozone/public/overlay_candidates_ozone.h"
+
+namespace ui {
+namespace {
+
+struct VideoPlaneClient {
+  OverlayManagerWayland::VideoPlaneGeometryCallback callback;
+  bool can_scale = false;
+};
+
+base::LazyInstance<VideoPlaneClient> g_video_plane_client =
+    LAZY_INSTANCE_INITIALIZER;
+
+class OverlayCandidatesWayland : public OverlayCandidatesOzone {
+ public:
+  OverlayCandidatesWayland() {}
+
+  void CheckOverlaySupport(OverlaySurfaceCandidateList* surfaces) override;
+};
+
+void OverlayCandidatesWayland::CheckOverlaySupport(
+    OverlaySurfaceCandidateList* surfaces) {
+  const VideoPlaneClient& client = g_video_plane_client.Get();
+  if (client.callback.is_null())
+    return;
+
+  // There is a single video plane below the surface of the window, which
+  // neither rotates nor flips its content.
+  for (auto& candidate : *surfaces) {
+    if (candidate.plane_z_order != -1)
+      continue;
+    if (candidate.transform != gfx::OVERLAY_TRANSFORM_NONE)
+      return;
+
+    // Compositor requires all overlay rectangles to have integer coords.
+    gfx::RectF display_rect =
+        gfx::RectF(gfx::ToEnclosedRect(candidate.display_rect));
+    if (!client.can_scale &&
+        gfx::ToRoundedSize(display_rect.size()) != candidate.buffer_size)
+      return;
+
+    candidate.overlay_handled = true;
+    candidate.display_rect = display_rect;
+    client.callback.Run(display_rect);
+    return;
+  }
+}
+
+}  // namespace
+
+OverlayManagerWayland::OverlayManagerWayland() {}
+
+OverlayManagerWayland::~OverlayManagerWayland() {}
+
+std::unique_ptr<OverlayCandidatesOzone>
+OverlayManagerWayland::CreateOverlayCandidates(gfx::AcceleratedWidget w) {
+  return base::WrapUnique(new OverlayCandidatesWayland());
+}
+
+// static
+void OverlayManagerWayland::SetVideoPlaneGeometryCallback(
+    const VideoPlaneGeometryCallback& callback,
+    bool can_scale) {
+  VideoPlaneClient& client = g_video_plane_client.Get();
+  client.callback = callback;
+  client.can_scale = can_scale;
+}
+
+}  // namespace ui
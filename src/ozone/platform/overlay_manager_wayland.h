@@ -0,0 +1,48 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef OZONE_PLATFORM_OVERLAY_MANAGER_WAYLAND_H_
+#define OZONE_PLATFORM_OVERLAY_MANAGER_WAYLAND_H_
+
+#include <memory>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "ozone/platform/ozone_export_wayland.h"
+#include "ui/gfx/geometry/rect_f.h"
+#include "ui/ozone/public/overlay_manager_ozone.h"
+
+namespace ui {
+
+// Lets the compositor promote video to the hardware video plane, which lies
+// below the Wayland surface of the window. The compositor then only punches a
+// transparent hole into its output instead of drawing the video.
+class OZONE_WAYLAND_EXPORT OverlayManagerWayland : public OverlayManagerOzone {
+ public:
+  OverlayManagerWayland();
+  ~OverlayManagerWayland() override;
+
+  // OverlayManagerOzone:
+  std::unique_ptr<OverlayCandidatesOzone> CreateOverlayCandidates(
+      gfx::AcceleratedWidget w) override;
+
+  // Called with the display rect of the hole whenever an underlay is accepted
+  // in the compositor, so that the video plane can be positioned to match it.
+  using VideoPlaneGeometryCallback =
+      base::Callback<void(const gfx::RectF& display_rect)>;
+
+  // Registers the client owning the video plane. Underlays are only accepted
+  // while a callback is set and, unless |can_scale|, only when the video is
+  // displayed at the size of its buffer. Pass a null callback to unregister.
+  static void SetVideoPlaneGeometryCallback(
+      const VideoPlaneGeometryCallback& callback,
+      bool can_scale);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(OverlayManagerWayland);
+};
+
+}  // namespace ui
+
+#endif  // OZONE_PLATFORM_OVERLAY_MANAGER_WAYLAND_H_
@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "ozone/platform/desktop_platform_screen_delegate.h"
 #include "ozone/platform/messages.h"
 #include "ozone/platform/ozone_gpu_platform_support_host.h"
@@ -301,6 +302,7 @@ bool WindowManagerWayland::OnMessageReceived(const IPC::Message& message) {
   IPC_MESSAGE_HANDLER(WaylandInput_ButtonNotify, ButtonNotify)
   IPC_MESSAGE_HANDLER(WaylandInput_TouchNotify, TouchNotify)
   IPC_MESSAGE_HANDLER(WaylandInput_AxisNotify, AxisNotify)
+  IPC_MESSAGE_HANDLER(WaylandInput_BatchNotify, BatchNotify)
   IPC_MESSAGE_HANDLER(WaylandInput_PointerEnter, PointerEnter)
   IPC_MESSAGE_HANDLER(WaylandInput_PointerLeave, PointerLeave)
   IPC_MESSAGE_HANDLER(WaylandInput_KeyNotify, KeyNotify)
@@ -368,6 +370,13 @@ void WindowManagerWayland::AxisNotify(float x,
           weak_ptr_factory_.GetWeakPtr(), x, y, xoffset, yoffset));
 }
 
+void WindowManagerWayland::BatchNotify(const InputEventBatch& batch) {
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE,
+      base::Bind(&WindowManagerWayland::NotifyBatch,
+          weak_ptr_factory_.GetWeakPtr(), batch, dragging_));
+}
+
 void WindowManagerWayland::PointerEnter(unsigned handle,
                                         float x,
                                         float y) {
@@ -607,6 +616,23 @@ void WindowManagerWayland::NotifyAxis(float x,
   DispatchEvent(&wheelev);
 }
 
+void WindowManagerWayland::NotifyBatch(const InputEventBatch& batch,
+                                       bool dragging) {
+  TRACE_EVENT1("ozone", "WindowManagerWayland::NotifyBatch",
+               "coalesced_count", batch.coalesced_count);
+  if (batch.has_motion) {
+    if (dragging)
+      NotifyDragging(batch.motion_x, batch.motion_y);
+    else
+      NotifyMotion(batch.motion_x, batch.motion_y);
+  }
+
+  if (batch.has_axis) {
+    NotifyAxis(batch.axis_x, batch.axis_y,
+               batch.axis_xoffset, batch.axis_yoffset);
+  }
+}
+
 void WindowManagerWayland::NotifyPointerEnter(unsigned handle,
                                                  float x,
                                                  float y) {
@@ -11,6 +11,7 @@
 
 #include "base/memory/shared_memory.h"
 #include "base/memory/weak_ptr.h"
+#include "ozone/platform/input_event_batch.h"
 #include "ui/base/cursor/cursor.h"
 #include "ui/events/event.h"
 #include "ui/events/event_source.h"
@@ -99,6 +100,8 @@ class WindowManagerWayland
                   float y,
                   int xoffset,
                   int yoffset);
+  // Handles coalesced motion/axis events in a single task.
+  void BatchNotify(const InputEventBatch& batch);
   void PointerEnter(unsigned handle, float x, float y);
   void PointerLeave(unsigned handle, float x, float y);
   void KeyNotify(EventType type,
@@ -155,6 +158,7 @@ class WindowManagerWayland
                   float y,
                   int xoffset,
                   int yoffset);
+  void NotifyBatch(const InputEventBatch& batch, bool dragging);
   void NotifyPointerEnter(unsigned handle,
                           float x,
                           float y);
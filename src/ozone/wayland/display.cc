@@ -21,6 +21,7 @@
 #include "base/message_loop/message_loop.h"
 #include "base/native_library.h"
 #include "base/stl_util.h"
+#include "base/time/time.h"
 #include "ipc/ipc_sender.h"
 #include "ozone/platform/messages.h"
 #if defined(USE_DATA_DEVICE_MANAGER)
@@ -85,6 +86,15 @@ static const struct wl_drm_listener drm_listener = {
 #endif
 
 namespace ozonewayland {
+
+namespace {
+
+// Upper bound for how long coalesced motion/axis events wait for vsync
+// before they are sent anyway. Roughly one frame at 60 Hz.
+const int kMaxInputBatchDelayMs = 16;
+
+}  // namespace
+
 WaylandDisplay* WaylandDisplay::instance_ = NULL;
 
 WaylandDisplay::WaylandDisplay() : SurfaceFactoryOzone(),
@@ -99,6 +109,7 @@ WaylandDisplay::WaylandDisplay() : SurfaceFactoryOzone(),
     webos_input_manager_(NULL),
     webos_xinput_extension_(NULL),
     webos_xinput_(NULL),
+    subcompositor_(NULL),
     pointer_visible_(false),
 #else
     text_input_manager_(NULL),
@@ -116,6 +127,7 @@ WaylandDisplay::WaylandDisplay() : SurfaceFactoryOzone(),
     seat_list_(),
     widget_map_(),
     serial_(0),
+    input_batch_flush_scheduled_(false),
     processing_events_(false),
 #if defined(ENABLE_DRM_SUPPORT)
     m_authenticated_(false),
@@ -140,6 +152,7 @@ WaylandWindow* WaylandDisplay::GetWindow(unsigned window_handle) const {
 
 #if defined(OS_WEBOS)
 void WaylandDisplay::CompositorBuffersSwapped(unsigned handle) {
+  FlushInputBatch();
   Dispatch(new Compositor_BuffersSwapped(handle));
 }
 
@@ -343,6 +356,15 @@ wl_webos_input_manager* WaylandDisplay::GetWebosInputManager() const {
 WebOSSurfaceGroupCompositor* WaylandDisplay::GetGroupCompositor() const {
   return group_compositor_.get();
 }
+
+WaylandWindow* WaylandDisplay::GetSurfaceGroupOwner(
+    const std::string& group) const {
+  for (const auto& it : widget_map_) {
+    if (it.second->IsSurfaceGroupOwner(group))
+      return it.second;
+  }
+  return NULL;
+}
 #else
 struct wl_text_input_manager* WaylandDisplay::GetTextInputManager() const {
   return text_input_manager_;
@@ -562,6 +584,9 @@ void WaylandDisplay::Terminate() {
 #if defined(OS_WEBOS)
   if (text_model_factory_)
     text_model_factory_destroy(text_model_factory_);
+
+  if (subcompositor_)
+    wl_subcompositor_destroy(subcompositor_);
 #else
   if (text_input_manager_)
     wl_text_input_manager_destroy(text_input_manager_);
@@ -918,6 +943,9 @@ void WaylandDisplay::DisplayHandleGlobal(void *data,
         wl_webos_xinput_extension_register_input(disp->webos_xinput_extension_);
   } else if (strcmp(interface, "wl_webos_surface_group_compositor") == 0) {
     disp->group_compositor_.reset(new WebOSSurfaceGroupCompositor(registry, name));
+  } else if (strcmp(interface, "wl_subcompositor") == 0) {
+    disp->subcompositor_ = static_cast<wl_subcompositor*>(
+        wl_registry_bind(registry, name, &wl_subcompositor_interface, 1));
   }
 #else
   else if (strcmp(interface, "wl_text_input_manager") == 0) {
@@ -999,7 +1027,9 @@ IPC::MessageFilter* WaylandDisplay::GetMessageFilter() {
 }
 
 void WaylandDisplay::MotionNotify(float x, float y) {
-  Dispatch(new WaylandInput_MotionNotify(x, y));
+  base::AutoLock lock(input_batch_lock_);
+  input_batch_.AddMotion(x, y);
+  ScheduleInputBatchFlushLocked();
 }
 
 void WaylandDisplay::ButtonNotify(unsigned handle,
@@ -1007,6 +1037,7 @@ void WaylandDisplay::ButtonNotify(unsigned handle,
                                   ui::EventFlags flags,
                                   float x,
                                   float y) {
+  FlushInputBatch();
   Dispatch(new WaylandInput_ButtonNotify(handle, type, flags, x, y));
 }
 
@@ -1014,14 +1045,18 @@ void WaylandDisplay::AxisNotify(float x,
                                 float y,
                                 int xoffset,
                                 int yoffset) {
-  Dispatch(new WaylandInput_AxisNotify(x, y, xoffset, yoffset));
+  base::AutoLock lock(input_batch_lock_);
+  input_batch_.AddAxis(x, y, xoffset, yoffset);
+  ScheduleInputBatchFlushLocked();
 }
 
 void WaylandDisplay::PointerEnter(unsigned handle, float x, float y) {
+  FlushInputBatch();
   Dispatch(new WaylandInput_PointerEnter(handle, x, y));
 }
 
 void WaylandDisplay::PointerLeave(unsigned handle, float x, float y) {
+  FlushInputBatch();
   Dispatch(new WaylandInput_PointerLeave(handle, x, y));
 }
 
@@ -1031,6 +1066,7 @@ void WaylandDisplay::KeyNotify(ui::EventType type,
                                ui::EventSourceType source_type,
 #endif
                                int device_id) {
+  FlushInputBatch();
   Dispatch(new WaylandInput_KeyNotify(type, code,
 #if defined(OS_WEBOS)
                                       source_type,
@@ -1041,6 +1077,7 @@ void WaylandDisplay::KeyNotify(ui::EventType type,
 void WaylandDisplay::VirtualKeyNotify(ui::EventType type,
                                       uint32_t key,
                                       int device_id) {
+  FlushInputBatch();
   Dispatch(new WaylandInput_VirtualKeyNotify(type, key, device_id));
 }
 
@@ -1049,6 +1086,7 @@ void WaylandDisplay::TouchNotify(ui::EventType type,
                                  float y,
                                  int32_t touch_id,
                                  uint32_t time_stamp) {
+  FlushInputBatch();
   Dispatch(new WaylandInput_TouchNotify(type, x, y, touch_id, time_stamp));
 }
 
@@ -1151,6 +1189,43 @@ void WaylandDisplay::Dispatch(IPC::Message* message) {
       FROM_HERE, base::Bind(&WaylandDisplay::Send, weak_ptr_, message));
 }
 
+void WaylandDisplay::ScheduleInputBatchFlushLocked() {
+  input_batch_lock_.AssertAcquired();
+  if (input_batch_flush_scheduled_)
+    return;
+
+  if (!loop_) {
+    // The channel is not established yet, nothing to coalesce against.
+    FlushInputBatchLocked();
+    return;
+  }
+
+  // Vsync normally flushes the batch (see CompositorBuffersSwapped). Nothing
+  // may be drawing though, so make sure the events are not held forever.
+  input_batch_flush_scheduled_ = true;
+  loop_->task_runner()->PostDelayedTask(
+      FROM_HERE, base::Bind(&WaylandDisplay::FlushInputBatch, weak_ptr_),
+      base::TimeDelta::FromMilliseconds(kMaxInputBatchDelayMs));
+}
+
+void WaylandDisplay::FlushInputBatch() {
+  base::AutoLock lock(input_batch_lock_);
+  FlushInputBatchLocked();
+}
+
+void WaylandDisplay::FlushInputBatchLocked() {
+  input_batch_lock_.AssertAcquired();
+  input_batch_flush_scheduled_ = false;
+  if (input_batch_.IsEmpty())
+    return;
+
+  // Dispatch while holding the lock, so that a flush racing between the poll
+  // thread and the GPU main thread can not reorder the batch with the event
+  // that triggered it.
+  Dispatch(new WaylandInput_BatchNotify(input_batch_));
+  input_batch_.Reset();
+}
+
 void WaylandDisplay::Send(IPC::Message* message) {
   // The GPU process never sends synchronous IPC, so clear the unblock flag.
   // This ensures the message is treated as a synchronous one and helps preserve
@@ -36,7 +36,9 @@
 
 #include "base/memory/shared_memory.h"
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "ozone/platform/input_content_type.h"
+#include "ozone/platform/input_event_batch.h"
 #include "ozone/platform/window_constants.h"
 #include "ui/events/event_constants.h"
 #include "ui/ozone/public/gpu_platform_support.h"
@@ -235,6 +237,9 @@ class WaylandDisplay : public ui::SurfaceFactoryOzone,
   void WindowClose(unsigned windowhandle);
 
   WebOSSurfaceGroupCompositor* GetGroupCompositor() const;
+  wl_subcompositor* GetSubcompositor() const { return subcompositor_; }
+  // Returns the window of this process that created |group|, if any.
+  WaylandWindow* GetSurfaceGroupOwner(const std::string& group) const;
   WaylandSeat* SetPrimarySeat(wl_pointer* input_pointer);
 #endif
 
@@ -307,6 +312,11 @@ class WaylandDisplay : public ui::SurfaceFactoryOzone,
   // Posts task to main loop of the thread on which Dispatcher was initialized.
   void Dispatch(IPC::Message* message);
   void Send(IPC::Message* message);
+  // Sends the pending coalesced motion/axis events, if any. Called on vsync,
+  // before any event that can not be coalesced and when the batch times out.
+  void FlushInputBatch();
+  void FlushInputBatchLocked();
+  void ScheduleInputBatchFlushLocked();
 
 #if defined(OS_WEBOS)
   void SetKeyMask(unsigned w, uint32_t key_mask, bool value);
@@ -343,6 +353,7 @@ class WaylandDisplay : public ui::SurfaceFactoryOzone,
   wl_webos_input_manager* webos_input_manager_;
   wl_webos_xinput_extension* webos_xinput_extension_;
   wl_webos_xinput* webos_xinput_;
+  wl_subcompositor* subcompositor_;
   std::unique_ptr<WebOSSurfaceGroupCompositor> group_compositor_;
   bool pointer_visible_;
 #else
@@ -363,6 +374,12 @@ class WaylandDisplay : public ui::SurfaceFactoryOzone,
   WindowMap widget_map_;
   // Display queues messages till Channel is establised.
   DeferredMessages deferred_messages_;
+  // Motion and axis events are coalesced into input_batch_ instead of being
+  // sent one message each. Input arrives on the poll thread while vsync is
+  // reported on the GPU main thread, hence the lock.
+  base::Lock input_batch_lock_;
+  ui::InputEventBatch input_batch_;
+  bool input_batch_flush_scheduled_;
   unsigned serial_;
   bool processing_events_ :1;
 #if defined(ENABLE_DRM_SUPPORT)
@@ -9,26 +9,62 @@
 #include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <unistd.h>
 #include <wayland-client.h>
 
 #include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "ozone/wayland/display.h"
 
 namespace ozonewayland {
 const int MAX_EVENTS = 16;
 
+namespace {
+
+// Reads everything written so far to the (non-blocking) wakeup pipe, so
+// that the next poll() blocks again until a new wakeup is requested.
+void DrainWakeupPipe(int fd) {
+  char buf[MAX_EVENTS];
+  while (HANDLE_EINTR(read(fd, buf, sizeof(buf))) > 0) {
+  }
+}
+
+}  // namespace
+
 WaylandDisplayPollThread::WaylandDisplayPollThread(wl_display* display)
     : base::Thread("WaylandDisplayPollThread"),
       display_(display),
       polling_(base::WaitableEvent::ResetPolicy::MANUAL,
                base::WaitableEvent::InitialState::NOT_SIGNALED),
       stop_polling_(base::WaitableEvent::ResetPolicy::MANUAL,
-                    base::WaitableEvent::InitialState::NOT_SIGNALED) {
+                    base::WaitableEvent::InitialState::NOT_SIGNALED),
+      wakeup_pipe_read_(-1),
+      wakeup_pipe_write_(-1) {
   DCHECK(display_);
+  int fds[2];
+  if (pipe(fds)) {
+    LOG(ERROR) << "pipe() failed, errno: " << errno;
+    return;
+  }
+  if (!base::SetNonBlocking(fds[0]) || !base::SetNonBlocking(fds[1])) {
+    LOG(ERROR) << "SetNonBlocking for wakeup pipe failed, errno: " << errno;
+    IGNORE_EINTR(close(fds[0]));
+    IGNORE_EINTR(close(fds[1]));
+    return;
+  }
+  wakeup_pipe_read_ = fds[0];
+  wakeup_pipe_write_ = fds[1];
 }
 
 WaylandDisplayPollThread::~WaylandDisplayPollThread() {
   StopProcessingEvents();
+  if (wakeup_pipe_read_ >= 0)
+    IGNORE_EINTR(close(wakeup_pipe_read_));
+  if (wakeup_pipe_write_ >= 0)
+    IGNORE_EINTR(close(wakeup_pipe_write_));
 }
 
 void WaylandDisplayPollThread::StartProcessingEvents() {
@@ -42,23 +78,47 @@ void WaylandDisplayPollThread::StartProcessingEvents() {
 }
 
 void WaylandDisplayPollThread::StopProcessingEvents() {
-  if (polling_.IsSignaled())
+  if (polling_.IsSignaled()) {
     stop_polling_.Signal();
+    Wakeup();
+  }
 
   Stop();
 }
 
+void WaylandDisplayPollThread::Wakeup() {
+  if (wakeup_pipe_write_ < 0)
+    return;
+  // A full pipe already guarantees a pending wakeup, so EAGAIN is harmless.
+  char buf = 0;
+  int nwrite = HANDLE_EINTR(write(wakeup_pipe_write_, &buf, 1));
+  DCHECK(nwrite == 1 || errno == EAGAIN)
+      << "[nwrite:" << nwrite << "] [errno:" << errno << "]";
+}
+
 void WaylandDisplayPollThread::CleanUp() {
   SetThreadWasQuitProperly(true);
 }
 
 void  WaylandDisplayPollThread::DisplayRun(WaylandDisplayPollThread* data) {
-  struct pollfd pollfd;
-  int i, ret, count = 0;
+  struct pollfd pollfds[2];
+  int ret, count = 0;
   uint32_t event = 0;
   unsigned display_fd = wl_display_get_fd(data->display_);
-  pollfd.fd = display_fd;
-  pollfd.events = POLLIN | POLLERR | POLLHUP;
+  pollfds[0].fd = display_fd;
+  pollfds[0].events = POLLIN | POLLERR | POLLHUP;
+  pollfds[0].revents = 0;
+  // The wakeup pipe lets StopProcessingEvents interrupt a poll() blocked
+  // without timeout. If the pipe could not be created, fall back to polling
+  // with a short timeout so that stop_polling_ is still noticed.
+  const bool has_wakeup_pipe = data->wakeup_pipe_read_ >= 0;
+  pollfds[1].fd = data->wakeup_pipe_read_;
+  pollfds[1].events = POLLIN;
+  pollfds[1].revents = 0;
+  const nfds_t nfds = has_wakeup_pipe ? 2 : 1;
+
+  int wakeups = 0;
+  base::TimeTicks wakeup_period_start = base::TimeTicks::Now();
 
   // Set the signal state. This is used to query from other threads (i.e.
   // StopProcessingEvents on Main thread), if this thread is still polling.
@@ -84,23 +144,28 @@ void  WaylandDisplayPollThread::DisplayRun(WaylandDisplayPollThread* data) {
       continue;
     preparing_read = true;
 
-    int timeout = -1;
-#if defined(OS_WEBOS)
-    // FIXME(jose.dapena): this is a workaround. As poll() with -1 timeout
-    // does not finish if stop_polling_ is signalled, adding a timeout
-    // allows wayland thread to finish properly. This has a side effect,
-    // we properly update last frame.
-    // It should work for both WAM and browser.
-    timeout = 30;
-#endif
-    count = poll(&pollfd, 1, timeout);
+    int timeout = has_wakeup_pipe ? -1 : 30;
+    count = poll(pollfds, nfds, timeout);
     if (count < 0 && errno != EINTR) {
       LOG(ERROR) << "poll returned an error." << errno;
       break;
     }
 
-    if (count == 1) {
-      event = pollfd.revents;
+    ++wakeups;
+    base::TimeTicks now = base::TimeTicks::Now();
+    base::TimeDelta period = now - wakeup_period_start;
+    if (period >= base::TimeDelta::FromSeconds(1)) {
+      TRACE_COUNTER1("ozone", "WaylandDisplayPollThread::WakeupsPerSecond",
+                     static_cast<int>(wakeups / period.InSecondsF()));
+      wakeups = 0;
+      wakeup_period_start = now;
+    }
+
+    if (count > 0 && has_wakeup_pipe && (pollfds[1].revents & POLLIN))
+      DrainWakeupPipe(data->wakeup_pipe_read_);
+
+    if (count > 0 && pollfds[0].revents) {
+      event = pollfds[0].revents;
       // We can have cases where POLLIN and POLLHUP are both set for
       // example. Don't break if both flags are set.
       if ((event & POLLERR || event & POLLHUP) &&
@@ -30,9 +30,15 @@ class WaylandDisplayPollThread : public base::Thread {
 
  private:
   static void DisplayRun(WaylandDisplayPollThread* data);
+  // Interrupts a blocking poll() in DisplayRun.
+  void Wakeup();
   wl_display* display_;
   base::WaitableEvent polling_;  // Is set as long as the thread is polling.
   base::WaitableEvent stop_polling_;
+  // Self-pipe polled next to the display fd, so that DisplayRun can block
+  // without a timeout and still return as soon as stop_polling_ is signaled.
+  int wakeup_pipe_read_;
+  int wakeup_pipe_write_;
   DISALLOW_COPY_AND_ASSIGN(WaylandDisplayPollThread);
 };
 
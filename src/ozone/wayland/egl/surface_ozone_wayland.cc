@@ -5,6 +5,8 @@
 #include "ozone/wayland/egl/surface_ozone_wayland.h"
 
 #include "ozone/wayland/display.h"
+#include "ozone/wayland/egl/wayland_presentation_feedback.h"
+#include "ozone/wayland/screen.h"
 #include "ozone/wayland/window.h"
 #include "third_party/khronos/EGL/egl.h"
 #include "ui/ozone/common/egl_util.h"
@@ -14,9 +16,13 @@ namespace ozonewayland {
 
 SurfaceOzoneWayland::SurfaceOzoneWayland(unsigned handle)
     : handle_(handle) {
+  WaylandScreen* screen = WaylandDisplay::GetInstance()->PrimaryScreen();
+  presentation_feedback_ =
+      new WaylandPresentationFeedback(screen ? screen->Refresh() : 0);
 }
 
 SurfaceOzoneWayland::~SurfaceOzoneWayland() {
+  presentation_feedback_->Stop();
   WaylandDisplay::GetInstance()->DestroyWindow(handle_);
   WaylandDisplay::GetInstance()->FlushDisplay();
 }
@@ -36,25 +42,48 @@ bool SurfaceOzoneWayland::ResizeNativeWindow(
 bool SurfaceOzoneWayland::OnSwapBuffers() {
 #if defined(OS_WEBOS)
   WaylandDisplay::GetInstance()->CompositorBuffersSwapped(handle_);
+#endif
   WaylandWindow* window = WaylandDisplay::GetInstance()->GetWindow(handle_);
+  if (window)
+    presentation_feedback_->RequestFeedback(window->GetEGLSurface());
   WaylandDisplay::GetInstance()->FlushDisplay();
-#endif
   return true;
 }
 
 void SurfaceOzoneWayland::OnSwapBuffersAsync(
     const ui::SwapCompletionCallback& callback) {
-#if defined(OS_WEBOS)
   OnSwapBuffers();
-#endif
 }
 
 std::unique_ptr<gfx::VSyncProvider> SurfaceOzoneWayland::CreateVSyncProvider() {
-  return std::unique_ptr<gfx::VSyncProvider>();
+  return std::unique_ptr<gfx::VSyncProvider>(
+      new WaylandVSyncProvider(presentation_feedback_));
 }
 
 void* /* EGLConfig */ SurfaceOzoneWayland::GetEGLSurfaceConfig(
     const ui::EglConfigCallbacks& egl) {
+  // Prefer a config that can preserve the back buffer, which partial swaps
+  // with eglSwapBuffersWithDamage rely on.
+  EGLint preserved_config_attribs[] = {EGL_BUFFER_SIZE,
+                                       32,
+                                       EGL_ALPHA_SIZE,
+                                       8,
+                                       EGL_BLUE_SIZE,
+                                       8,
+                                       EGL_GREEN_SIZE,
+                                       8,
+                                       EGL_RED_SIZE,
+                                       8,
+                                       EGL_RENDERABLE_TYPE,
+                                       EGL_OPENGL_ES2_BIT,
+                                       EGL_SURFACE_TYPE,
+                                       EGL_WINDOW_BIT |
+                                           EGL_SWAP_BEHAVIOR_PRESERVED_BIT,
+                                       EGL_NONE};
+  void* config = ChooseEGLConfig(egl, preserved_config_attribs);
+  if (config)
+    return config;
+
   EGLint config_attribs[] = {EGL_BUFFER_SIZE,
                              32,
                              EGL_ALPHA_SIZE,
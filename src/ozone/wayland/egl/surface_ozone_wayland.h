@@ -5,11 +5,14 @@
 #ifndef OZONE_WAYLAND_EGL_SURFACE_OZONE_WAYLAND
 #define OZONE_WAYLAND_EGL_SURFACE_OZONE_WAYLAND
 
+#include "base/memory/ref_counted.h"
 #include "ui/gfx/gfx_export.h"
 #include "ui/ozone/public/surface_ozone_egl.h"
 
 namespace ozonewayland {
 
+class WaylandPresentationFeedback;
+
 // Provides EGL support for SurfaceOzone.
 class SurfaceOzoneWayland : public ui::SurfaceOzoneEGL {
  public:
@@ -26,6 +29,8 @@ class SurfaceOzoneWayland : public ui::SurfaceOzoneEGL {
 
  private:
   unsigned handle_;
+  // Drives the vsync parameters reported by CreateVSyncProvider().
+  scoped_refptr<WaylandPresentationFeedback> presentation_feedback_;
   DISALLOW_COPY_AND_ASSIGN(SurfaceOzoneWayland);
 };
 
@@ -0,0 +1,162 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ozone/wayland/egl/wayland_presentation_feedback.h"
+
+#include <wayland-client.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/trace_event/trace_event.h"
+
+namespace ozonewayland {
+
+namespace {
+
+const int64_t kDefaultRefreshIntervalUs =
+    base::Time::kMicrosecondsPerSecond / 60;
+
+// Intervals out of this range are measurement errors, not refresh rates.
+const int64_t kMinRefreshIntervalUs = base::Time::kMicrosecondsPerSecond / 240;
+const int64_t kMaxRefreshIntervalUs = base::Time::kMicrosecondsPerSecond / 24;
+
+// Gaps of up to this many refreshes between presentations are counted as
+// missed frames. Longer ones are the surface being idle.
+const int64_t kMaxMissedFrames = 8;
+
+// Frame callback times only have millisecond precision, so each measured
+// interval only moves the estimate by this fraction of the difference.
+const int kRefreshIntervalSmoothing = 8;
+
+// Frame callback times are milliseconds in an unspecified base. Compositors
+// use CLOCK_MONOTONIC, like base::TimeTicks, truncated to 32 bits.
+base::TimeTicks FrameTimeToTimeTicks(uint32_t time, base::TimeTicks now) {
+  const int64_t now_ms = (now - base::TimeTicks()).InMilliseconds();
+  // Unsigned arithmetic takes care of the wrap around.
+  const int32_t age_ms =
+      static_cast<int32_t>(static_cast<uint32_t>(now_ms) - time);
+  // A compositor on another clock gives nonsense; go by the time the callback
+  // arrived then.
+  if (age_ms < 0 || age_ms > base::Time::kMillisecondsPerSecond)
+    return now;
+  return base::TimeTicks() + base::TimeDelta::FromMilliseconds(now_ms - age_ms);
+}
+
+}  // namespace
+
+WaylandPresentationFeedback::WaylandPresentationFeedback(int32_t refresh)
+    : has_new_parameters_(false),
+      refresh_interval_(base::TimeDelta::FromMicroseconds(
+          kDefaultRefreshIntervalUs)),
+      dropped_frame_count_(0) {
+  if (refresh > 0) {
+    const int64_t interval_us =
+        base::Time::kMicrosecondsPerSecond * 1000 / refresh;
+    if (interval_us >= kMinRefreshIntervalUs &&
+        interval_us <= kMaxRefreshIntervalUs) {
+      refresh_interval_ = base::TimeDelta::FromMicroseconds(interval_us);
+    }
+  }
+}
+
+WaylandPresentationFeedback::~WaylandPresentationFeedback() {
+  Stop();
+}
+
+void WaylandPresentationFeedback::RequestFeedback(wl_surface* surface) {
+  static const wl_callback_listener kFrameListener = {
+      WaylandPresentationFeedback::OnFrameDone,
+  };
+
+  base::AutoLock lock(lock_);
+  wl_callback* callback = wl_surface_frame(surface);
+  wl_callback_add_listener(callback, &kFrameListener, this);
+  pending_callbacks_.push_back(callback);
+}
+
+void WaylandPresentationFeedback::Stop() {
+  base::AutoLock lock(lock_);
+  for (wl_callback* callback : pending_callbacks_)
+    wl_callback_destroy(callback);
+  pending_callbacks_.clear();
+}
+
+bool WaylandPresentationFeedback::GetVSyncParameters(
+    base::TimeTicks* timebase,
+    base::TimeDelta* interval) {
+  base::AutoLock lock(lock_);
+  if (!has_new_parameters_)
+    return false;
+  has_new_parameters_ = false;
+  *timebase = last_presentation_time_;
+  *interval = refresh_interval_;
+  return true;
+}
+
+// static
+void WaylandPresentationFeedback::OnFrameDone(void* data,
+                                              wl_callback* callback,
+                                              uint32_t time) {
+  static_cast<WaylandPresentationFeedback*>(data)->DidPresent(callback, time);
+}
+
+void WaylandPresentationFeedback::DidPresent(wl_callback* callback,
+                                             uint32_t time) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  base::AutoLock lock(lock_);
+  auto it = std::find(pending_callbacks_.begin(), pending_callbacks_.end(),
+                      callback);
+  if (it == pending_callbacks_.end())
+    return;
+  pending_callbacks_.erase(it);
+  wl_callback_destroy(callback);
+
+  const base::TimeTicks presentation_time = FrameTimeToTimeTicks(time, now);
+  // Commits that land in the same repaint are done at the same time.
+  if (presentation_time <= last_presentation_time_)
+    return;
+
+  if (!last_presentation_time_.is_null()) {
+    const base::TimeDelta elapsed = presentation_time - last_presentation_time_;
+    const int64_t refreshes =
+        (elapsed + refresh_interval_ / 2) / refresh_interval_;
+    if (refreshes >= 1 && refreshes <= kMaxMissedFrames + 1) {
+      const base::TimeDelta measured_interval = elapsed / refreshes;
+      if (measured_interval.InMicroseconds() >= kMinRefreshIntervalUs &&
+          measured_interval.InMicroseconds() <= kMaxRefreshIntervalUs) {
+        refresh_interval_ += (measured_interval - refresh_interval_) /
+                             kRefreshIntervalSmoothing;
+      }
+      if (refreshes > 1) {
+        dropped_frame_count_ += refreshes - 1;
+        TRACE_EVENT_INSTANT2(
+            "gpu", "WaylandPresentationFeedback::FrameDropped",
+            TRACE_EVENT_SCOPE_THREAD, "missed_refreshes", refreshes - 1,
+            "total_dropped", dropped_frame_count_);
+      }
+    }
+  }
+
+  last_presentation_time_ = presentation_time;
+  has_new_parameters_ = true;
+  TRACE_COUNTER1("gpu", "WaylandRefreshIntervalUs",
+                 refresh_interval_.InMicroseconds());
+}
+
+WaylandVSyncProvider::WaylandVSyncProvider(
+    scoped_refptr<WaylandPresentationFeedback> feedback)
+    : feedback_(std::move(feedback)) {}
+
+WaylandVSyncProvider::~WaylandVSyncProvider() {}
+
+void WaylandVSyncProvider::GetVSyncParameters(
+    const UpdateVSyncCallback& callback) {
+  base::TimeTicks timebase;
+  base::TimeDelta interval;
+  if (feedback_->GetVSyncParameters(&timebase, &interval))
+    callback.Run(timebase, interval);
+}
+
+}  // namespace ozonewayland
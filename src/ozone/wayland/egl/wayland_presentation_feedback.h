@@ -0,0 +1,86 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef OZONE_WAYLAND_EGL_WAYLAND_PRESENTATION_FEEDBACK_H_
+#define OZONE_WAYLAND_EGL_WAYLAND_PRESENTATION_FEEDBACK_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "ui/gfx/vsync_provider.h"
+
+struct wl_callback;
+struct wl_surface;
+
+namespace ozonewayland {
+
+// Learns the timing of the output a surface is presented on from the frame
+// callbacks of the compositor, which are done when it repaints with a new
+// commit of the surface. The time of the last repaint gives the vsync
+// timebase, and the times between repaints give the refresh interval, as
+// well as the frames the surface missed.
+//
+// Frame callbacks are requested from the GPU main thread and done on the
+// display poll thread.
+class WaylandPresentationFeedback
+    : public base::RefCountedThreadSafe<WaylandPresentationFeedback> {
+ public:
+  // |refresh| is the refresh rate of the output in mHz as the compositor
+  // reported it, or 0 if unknown.
+  explicit WaylandPresentationFeedback(int32_t refresh);
+
+  // Asks to be told when the next commit of |surface| gets presented. To be
+  // called after each swap.
+  void RequestFeedback(wl_surface* surface);
+
+  // Drops the requests in flight. To be called before |surface| goes away.
+  void Stop();
+
+  // Returns false if nothing new was presented since the last call.
+  bool GetVSyncParameters(base::TimeTicks* timebase,
+                          base::TimeDelta* interval);
+
+ private:
+  friend class base::RefCountedThreadSafe<WaylandPresentationFeedback>;
+  ~WaylandPresentationFeedback();
+
+  static void OnFrameDone(void* data, wl_callback* callback, uint32_t time);
+
+  void DidPresent(wl_callback* callback, uint32_t time);
+
+  base::Lock lock_;
+  std::vector<wl_callback*> pending_callbacks_;
+  bool has_new_parameters_;
+  base::TimeTicks last_presentation_time_;
+  base::TimeDelta refresh_interval_;
+  int64_t dropped_frame_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(WaylandPresentationFeedback);
+};
+
+// Reports the vsync parameters learnt by a WaylandPresentationFeedback, which
+// drive the BeginFrameSource of the compositor.
+class WaylandVSyncProvider : public gfx::VSyncProvider {
+ public:
+  explicit WaylandVSyncProvider(
+      scoped_refptr<WaylandPresentationFeedback> feedback);
+  ~WaylandVSyncProvider() override;
+
+  // gfx::VSyncProvider:
+  void GetVSyncParameters(const UpdateVSyncCallback& callback) override;
+
+ private:
+  scoped_refptr<WaylandPresentationFeedback> feedback_;
+
+  DISALLOW_COPY_AND_ASSIGN(WaylandVSyncProvider);
+};
+
+}  // namespace ozonewayland
+
+#endif  // OZONE_WAYLAND_EGL_WAYLAND_PRESENTATION_FEEDBACK_H_
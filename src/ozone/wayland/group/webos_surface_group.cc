@@ -57,6 +57,52 @@ WebOSSurfaceGroupLayer* WebOSSurfaceGroup::CreateNamedLayer(const std::string& n
   return group_layer;
 }
 
+WebOSSurfaceGroupLayer* WebOSSurfaceGroup::GetNamedLayer(
+    const std::string& name) {
+  for (WebOSSurfaceGroupLayer* layer : named_layer_) {
+    if (layer->GetName() == name)
+      return layer;
+  }
+  return NULL;
+}
+
+void WebOSSurfaceGroup::StackLocalSurface(WebOSSurfaceGroupLayer* layer,
+                                          wl_subsurface* subsurface,
+                                          wl_surface* surface) {
+  WaylandDisplay* display = WaylandDisplay::GetInstance();
+  WaylandWindow* window = display->GetWindow(window_handle_);
+  wl_surface* owner_surface = window->ShellSurface()->GetWLSurface();
+
+  // Stack next to the closest local layers on the same side of the owner.
+  int z_order = layer->GetLayerOrder();
+  WebOSSurfaceGroupLayer* below = NULL;
+  WebOSSurfaceGroupLayer* above = NULL;
+  for (WebOSSurfaceGroupLayer* it : named_layer_) {
+    if (it == layer || !it->GetLocalSurface())
+      continue;
+    int it_z_order = it->GetLayerOrder();
+    if ((it_z_order < 0) != (z_order < 0))
+      continue;
+    if (it_z_order < z_order) {
+      if (!below || it_z_order > below->GetLayerOrder())
+        below = it;
+    } else if (!above || it_z_order < above->GetLayerOrder()) {
+      above = it;
+    }
+  }
+
+  if (below)
+    wl_subsurface_place_above(subsurface, below->GetLocalSurface());
+  else if (above)
+    wl_subsurface_place_below(subsurface, above->GetLocalSurface());
+  else if (z_order < 0)
+    wl_subsurface_place_below(subsurface, owner_surface);
+  else
+    wl_subsurface_place_above(subsurface, owner_surface);
+
+  layer->SetLocalSurface(surface);
+}
+
 void WebOSSurfaceGroup::AttachSurface(const std::string& layer) {
   WaylandDisplay* display = WaylandDisplay::GetInstance();
   WaylandWindow* window = display->GetWindow(window_handle_);
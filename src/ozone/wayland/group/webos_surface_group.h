@@ -43,6 +43,16 @@ class OZONE_WAYLAND_EXPORT WebOSSurfaceGroup
   void AttachAnonymousSurface(ZHint hint = ZHint::ZHintAbove);
 
   WebOSSurfaceGroupLayer* CreateNamedLayer(const std::string& name, int z_order);
+  WebOSSurfaceGroupLayer* GetNamedLayer(const std::string& name);
+
+  // Stacks |surface|, a sub-surface of the owner presented in |layer|, among
+  // the owner and the other local layers according to the layer z orders.
+  void StackLocalSurface(WebOSSurfaceGroupLayer* layer,
+                         wl_subsurface* subsurface,
+                         wl_surface* surface);
+
+  void SetName(const std::string& name) { name_ = name; }
+  const std::string& GetName() const { return name_; }
   void AttachSurface(const std::string& layer);
   void DetachSurface();
 
@@ -53,6 +63,7 @@ class OZONE_WAYLAND_EXPORT WebOSSurfaceGroup
 
  private:
   std::list<WebOSSurfaceGroupLayer*> named_layer_;
+  std::string name_;
 
   bool attached_surface_;
   unsigned window_handle_;
@@ -29,6 +29,7 @@ WebOSSurfaceGroup* WebOSSurfaceGroupCompositor::CreateGroup(
 
   WebOSSurfaceGroup* group = new WebOSSurfaceGroup(handle);
   group->init(grp);
+  group->SetName(name);
   return group;
 }
 
@@ -7,7 +7,9 @@
 namespace ozonewayland {
 
 WebOSSurfaceGroupLayer::WebOSSurfaceGroupLayer()
-    : wl_webos_surface_group_layer() {
+    : wl_webos_surface_group_layer()
+    , layer_z_order_(0)
+    , local_surface_(NULL) {
 }
 
 WebOSSurfaceGroupLayer::~WebOSSurfaceGroupLayer() {
@@ -34,9 +34,15 @@ class WebOSSurfaceGroupLayer
   void SetLayerOrder(int z_order) { layer_z_order_ = z_order; }
   int GetLayerOrder() { return layer_z_order_; }
 
+  // Surface of a window of this process presented in this layer as a
+  // sub-surface of the group owner, or NULL.
+  void SetLocalSurface(wl_surface* surface) { local_surface_ = surface; }
+  wl_surface* GetLocalSurface() { return local_surface_; }
+
  private:
   std::string layer_name_;
   int layer_z_order_;
+  wl_surface* local_surface_;
 
   DISALLOW_COPY_AND_ASSIGN(WebOSSurfaceGroupLayer);
 };
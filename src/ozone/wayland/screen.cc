@@ -12,7 +12,11 @@
 namespace ozonewayland {
 
 WaylandScreen::WaylandScreen(wl_registry* registry, uint32_t id)
-    : output_(NULL), rect_(0, 0, 0, 0), transform_(-1) {
+    : output_(NULL),
+      rect_(0, 0, 0, 0),
+      transform_(-1),
+      refresh_(0),
+      pending_refresh_(0) {
   static const wl_output_listener kOutputListener = {
       WaylandScreen::OutputHandleGeometry, WaylandScreen::OutputHandleMode,
       WaylandScreen::OutputDone,
@@ -74,12 +78,14 @@ void WaylandScreen::OutputHandleMode(void* data,
   if (flags & WL_OUTPUT_MODE_CURRENT) {
     WaylandScreen* screen = static_cast<WaylandScreen*>(data);
     screen->pending_rect_.set_size(gfx::Size(width, height));
+    screen->pending_refresh_ = refresh;
   }
 }
 
 // static
 void WaylandScreen::OutputDone(void* data, struct wl_output* wl_output) {
   WaylandScreen* screen = static_cast<WaylandScreen*>(data);
+  screen->refresh_ = screen->pending_refresh_;
   if (screen->rect_ != screen->pending_rect_ ||
       screen->pending_transform_ != screen->transform_) {
     screen->rect_ = screen->pending_rect_;
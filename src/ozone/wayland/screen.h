@@ -28,6 +28,8 @@ class WaylandScreen {
   gfx::Rect Geometry() const { return rect_; }
   int32_t GetOutputTransform() const { return transform_; }
   int GetOutputTransformDegrees() const;
+  // Refresh rate of the active mode in mHz, or 0 if unknown.
+  int32_t Refresh() const { return refresh_; }
 
  private:
   // Callback functions that allows the display to initialize the screen's
@@ -58,9 +60,11 @@ class WaylandScreen {
   // Rect and transform of active mode.
   gfx::Rect rect_;
   int32_t transform_;
+  int32_t refresh_;
 
   gfx::Rect pending_rect_;
   int32_t pending_transform_;
+  int32_t pending_refresh_;
 
   DISALLOW_COPY_AND_ASSIGN(WaylandScreen);
 };
@@ -134,6 +134,8 @@
         'egl/egl_window.h',
         'egl/surface_ozone_wayland.cc',
         'egl/surface_ozone_wayland.h',
+        'egl/wayland_presentation_feedback.cc',
+        'egl/wayland_presentation_feedback.h',
         'input/cursor.cc',
         'input/cursor.h',
         'input/keyboard.cc',
@@ -15,6 +15,7 @@
 #if defined(OS_WEBOS)
 #include "ozone/wayland/group/webos_surface_group.h"
 #include "ozone/wayland/group/webos_surface_group_compositor.h"
+#include "ozone/wayland/group/webos_surface_group_layer.h"
 #include "ozone/wayland/input/webos_text_input.h"
 #include "ui/platform_window/webos/window_group_configuration.h"
 #endif
@@ -29,6 +30,9 @@ WaylandWindow::WaylandWindow(unsigned handle)
 #if defined(OS_WEBOS)
       surface_group_(0),
       is_surface_group_client_(false),
+      surface_group_owner_(0),
+      subsurface_surface_(NULL),
+      subsurface_(NULL),
 #endif
       allocation_(gfx::Rect(0, 0, 1, 1)),
       pointer_entered_(false) {
@@ -48,7 +52,16 @@ WaylandWindow::~WaylandWindow() {
 #endif
   }
 
+#if defined(OS_WEBOS)
+  if (subsurface_)
+    DetachFromLocalGroup();
+#endif
+
   delete window_;
+#if defined(OS_WEBOS)
+  if (subsurface_surface_)
+    wl_surface_destroy(subsurface_surface_);
+#endif
   delete shell_surface_;
 }
 
@@ -174,6 +187,9 @@ void WaylandWindow::CreateGroup(const ui::WindowGroupConfiguration& config) {
 void WaylandWindow::AttachToGroup(const std::string& group,
                                   const std::string& layer) {
   DLOG_ASSERT(!surface_group_);
+  if (AttachToLocalGroup(group, layer))
+    return;
+
   WebOSSurfaceGroupCompositor* compositor =
       WaylandDisplay::GetInstance()->GetGroupCompositor();
   surface_group_ = compositor->GetGroup(handle_, group);
@@ -195,6 +211,11 @@ void WaylandWindow::FocusGroupLayer() {
 }
 
 void WaylandWindow::DetachGroup() {
+  if (subsurface_) {
+    DetachFromLocalGroup();
+    return;
+  }
+
   if (!surface_group_)
     return;
 
@@ -206,6 +227,74 @@ void WaylandWindow::DetachGroup() {
   delete surface_group_;
   surface_group_ = NULL;
 }
+
+bool WaylandWindow::IsSurfaceGroupOwner(const std::string& group) const {
+  return surface_group_ && !is_surface_group_client_ &&
+         surface_group_->GetName() == group;
+}
+
+bool WaylandWindow::AttachToLocalGroup(const std::string& group,
+                                       const std::string& layer) {
+  // Once the EGL window exists its surface can not change, so only windows
+  // that were realized on a sub-surface can become one again.
+  if (subsurface_ || (window_ && !subsurface_surface_) ||
+      !getenv("OZONE_WAYLAND_GROUP_SUBSURFACES"))
+    return false;
+
+  WaylandDisplay* display = WaylandDisplay::GetInstance();
+  WaylandWindow* owner = display->GetSurfaceGroupOwner(group);
+  if (!display->GetSubcompositor() || !owner || !owner->ShellSurface())
+    return false;
+
+  WebOSSurfaceGroupLayer* group_layer =
+      owner->surface_group_->GetNamedLayer(layer);
+  if (!group_layer || group_layer->GetLocalSurface())
+    return false;
+
+  if (!subsurface_surface_) {
+    subsurface_surface_ =
+        wl_compositor_create_surface(display->GetCompositor());
+    wl_surface_set_user_data(subsurface_surface_, this);
+  }
+  subsurface_ = wl_subcompositor_get_subsurface(
+      display->GetSubcompositor(), subsurface_surface_,
+      owner->ShellSurface()->GetWLSurface());
+  // Layers redraw on their own, so do not hold their buffers until the owner
+  // commits.
+  wl_subsurface_set_desync(subsurface_);
+  wl_subsurface_set_position(subsurface_, allocation_.x(), allocation_.y());
+  owner->surface_group_->StackLocalSurface(group_layer, subsurface_,
+                                           subsurface_surface_);
+
+  surface_group_owner_ = owner->Handle();
+  is_surface_group_client_ = true;
+  surface_group_client_layer_ = layer;
+  display->FlushDisplay();
+  RAW_PMLOG_DEBUG("WebOSWebView",
+                  "Window(handle:%d) attached to layer:%s of window(handle:%d) "
+                  "as sub-surface", handle_, layer.c_str(), owner->Handle());
+  return true;
+}
+
+void WaylandWindow::DetachFromLocalGroup() {
+  WaylandDisplay* display = WaylandDisplay::GetInstance();
+  WaylandWindow* owner = display->GetWindow(surface_group_owner_);
+  if (owner && owner->surface_group_) {
+    WebOSSurfaceGroupLayer* group_layer =
+        owner->surface_group_->GetNamedLayer(surface_group_client_layer_);
+    if (group_layer && group_layer->GetLocalSurface() == subsurface_surface_)
+      group_layer->SetLocalSurface(NULL);
+  }
+
+  // Unmaps the layer. |subsurface_surface_| is kept since the EGL window
+  // renders into it.
+  wl_subsurface_destroy(subsurface_);
+  subsurface_ = NULL;
+  surface_group_owner_ = 0;
+  is_surface_group_client_ = false;
+  surface_group_client_layer_ = std::string();
+  display->FlushDisplay();
+}
 #endif
 
 void WaylandWindow::RealizeAcceleratedWidget() {
@@ -218,10 +307,18 @@ void WaylandWindow::RealizeAcceleratedWidget() {
 #endif
   }
 
-  if (!window_)
-    window_ = new EGLWindow(shell_surface_->GetWLSurface(),
-                            allocation_.width(),
+  if (!window_) {
+    window_ = new EGLWindow(GetEGLSurface(), allocation_.width(),
                             allocation_.height());
+  }
+}
+
+wl_surface* WaylandWindow::GetEGLSurface() const {
+#if defined(OS_WEBOS)
+  if (subsurface_surface_)
+    return subsurface_surface_;
+#endif
+  return shell_surface_->GetWLSurface();
 }
 
 wl_egl_window* WaylandWindow::egl_window() const {
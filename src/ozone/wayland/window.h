@@ -63,6 +63,7 @@ class WaylandWindow {
   void FocusGroupOwner();
   void FocusGroupLayer();
   void DetachGroup();
+  bool IsSurfaceGroupOwner(const std::string& group) const;
 #endif
 
   ShellType Type() const { return type_; }
@@ -71,6 +72,9 @@ class WaylandWindow {
 
   void RealizeAcceleratedWidget();
 
+  // Returns the surface the EGL window draws to.
+  wl_surface* GetEGLSurface() const;
+
   // Returns pointer to egl window associated with the window.
   // The WaylandWindow object owns the pointer.
   wl_egl_window* egl_window() const;
@@ -87,6 +91,15 @@ class WaylandWindow {
   void SetPointerEntered(bool entered) { pointer_entered_ = entered; }
 
  private:
+#if defined(OS_WEBOS)
+  // Presents this window in |layer| of a group created by another window of
+  // this process as a sub-surface of the owner's surface, so the compositor
+  // gets one surface tree instead of another top-level surface. Only possible
+  // before the EGL window is created; returns false if not used.
+  bool AttachToLocalGroup(const std::string& group, const std::string& layer);
+  void DetachFromLocalGroup();
+#endif
+
   WaylandShellSurface* shell_surface_;
   EGLWindow* window_;
 
@@ -96,6 +109,9 @@ class WaylandWindow {
   WebOSSurfaceGroup* surface_group_;
   bool is_surface_group_client_;
   std::string surface_group_client_layer_;
+  unsigned surface_group_owner_;
+  wl_surface* subsurface_surface_;
+  wl_subsurface* subsurface_;
 #endif
   gfx::Rect allocation_;
 
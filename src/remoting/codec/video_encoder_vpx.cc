@@ -4,6 +4,7 @@
 
 #include "remoting/codec/video_encoder_vpx.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -42,6 +43,36 @@ const int kVp9I444ProfileNumber = 1;
 const int kVp9AqModeNone = 0;
 const int kVp9AqModeCyclicRefresh = 3;
 
+// libvpx splits the frame between its threads by macroblock rows (VP8) or by
+// tile columns (VP9), and a thread is only worth its synchronization overhead
+// with enough of the frame to itself. VP9 tiles are at least 256px wide.
+const int kMinRowsPerThread = 4 * kMacroBlockSize;
+const int kMinVp9TileColumnWidth = 256;
+const int kMaxEncoderThreads = 8;
+
+// Returns the number of threads libvpx should encode frames of |size| with.
+int GetEncoderThreadCount(bool use_vp9, const webrtc::DesktopSize& size) {
+  // Going to multiple threads on low end systems can really hurt performance,
+  // http://crbug.com/99179, so keep a core for capturing on the others.
+  const int processors = base::SysInfo::NumberOfProcessors();
+  if (processors <= 2)
+    return 1;
+
+  const int max_threads = use_vp9 ? size.width() / kMinVp9TileColumnWidth
+                                  : size.height() / kMinRowsPerThread;
+  return std::max(
+      1, std::min(std::min(processors - 1, kMaxEncoderThreads), max_threads));
+}
+
+// Returns the log2 of the number of tile columns VP9 should use, so that each
+// of |threads| threads gets a column of its own.
+int GetVp9TileColumnsLog2(int threads) {
+  int log2 = 0;
+  while ((1 << (log2 + 1)) <= threads)
+    ++log2;
+  return log2;
+}
+
 void SetCommonCodecParameters(vpx_codec_enc_cfg_t* config,
                               const webrtc::DesktopSize& size) {
   // Use millisecond granularity time base.
@@ -60,12 +91,6 @@ void SetCommonCodecParameters(vpx_codec_enc_cfg_t* config,
   // frames, so take the hit of an "unnecessary" key-frame every 10,000 frames.
   config->kf_min_dist = 10000;
   config->kf_max_dist = 10000;
-
-  // Using 2 threads gives a great boost in performance for most systems with
-  // adequate processing power. NB: Going to multiple threads on low end
-  // windows systems can really hurt performance.
-  // http://crbug.com/99179
-  config->g_threads = (base::SysInfo::NumberOfProcessors() > 2) ? 2 : 1;
 }
 
 void SetVp8CodecParameters(vpx_codec_enc_cfg_t* config,
@@ -75,6 +100,7 @@ void SetVp8CodecParameters(vpx_codec_enc_cfg_t* config,
       config->rc_target_bitrate / config->g_w / config->g_h;
 
   SetCommonCodecParameters(config, size);
+  config->g_threads = GetEncoderThreadCount(false, size);
 
   // Value of 2 means using the real time profile. This is basically a
   // redundant option since we explicitly select real time mode when doing
@@ -91,6 +117,8 @@ void SetVp9CodecParameters(vpx_codec_enc_cfg_t* config,
                            bool lossless_color,
                            bool lossless_encode) {
   SetCommonCodecParameters(config, size);
+  config->g_threads =
+      1 << GetVp9TileColumnsLog2(GetEncoderThreadCount(true, size));
 
   // Configure VP9 for I420 or I444 source frames.
   config->g_profile =
@@ -125,7 +153,9 @@ void SetVp8CodecOptions(vpx_codec_ctx_t* codec) {
   DCHECK_EQ(VPX_CODEC_OK, ret) << "Failed to set noise sensitivity";
 }
 
-void SetVp9CodecOptions(vpx_codec_ctx_t* codec, bool lossless_encode) {
+void SetVp9CodecOptions(vpx_codec_ctx_t* codec,
+                        int threads,
+                        bool lossless_encode) {
   // Request the lowest-CPU usage that VP9 supports, which depends on whether
   // we are encoding lossy or lossless.
   // Note that this is configured via the same parameter as for VP8.
@@ -147,6 +177,11 @@ void SetVp9CodecOptions(vpx_codec_ctx_t* codec, bool lossless_encode) {
   int aq_mode = lossless_encode ? kVp9AqModeNone : kVp9AqModeCyclicRefresh;
   ret = vpx_codec_control(codec, VP9E_SET_AQ_MODE, aq_mode);
   DCHECK_EQ(VPX_CODEC_OK, ret) << "Failed to set aq mode";
+
+  // VP9 only encodes in parallel across tile columns, so give each thread one.
+  ret = vpx_codec_control(codec, VP9E_SET_TILE_COLUMNS,
+                          GetVp9TileColumnsLog2(threads));
+  DCHECK_EQ(VPX_CODEC_OK, ret) << "Failed to set tile columns";
 }
 
 void FreeImageIfMismatched(bool use_i444,
@@ -416,7 +451,7 @@ void VideoEncoderVpx::Configure(const webrtc::DesktopSize& size) {
 
   // Apply further customizations to the codec now it's initialized.
   if (use_vp9_) {
-    SetVp9CodecOptions(codec_.get(), lossless_encode_);
+    SetVp9CodecOptions(codec_.get(), config.g_threads, lossless_encode_);
   } else {
     SetVp8CodecOptions(codec_.get());
   }
@@ -150,6 +150,29 @@ TEST(VideoEncoderVpxTest, Vp9SizeChangeNoCrash) {
   EXPECT_TRUE(packet);
 }
 
+// Test that frames big enough to be encoded with several threads, and tile
+// columns for VP9, encode both in full and when only part of them changed.
+TEST(VideoEncoderVpxTest, MultiThreadedPartialUpdate) {
+  webrtc::DesktopSize frame_size(1920, 1080);
+  std::unique_ptr<webrtc::DesktopFrame> frame(CreateTestFrame(frame_size));
+
+  std::unique_ptr<VideoEncoderVpx> encoders[] = {
+      VideoEncoderVpx::CreateForVP8(), VideoEncoderVpx::CreateForVP9()};
+  for (const auto& encoder : encoders) {
+    frame->mutable_updated_region()->SetRect(
+        webrtc::DesktopRect::MakeSize(frame_size));
+    std::unique_ptr<VideoPacket> packet = encoder->Encode(*frame, 0);
+    ASSERT_TRUE(packet);
+    EXPECT_TRUE(packet->key_frame());
+
+    frame->mutable_updated_region()->SetRect(
+        webrtc::DesktopRect::MakeXYWH(1000, 500, 64, 64));
+    packet = encoder->Encode(*frame, 0);
+    ASSERT_TRUE(packet);
+    EXPECT_FALSE(packet->key_frame());
+  }
+}
+
 // Test that the DPI information is correctly propagated from the
 // webrtc::DesktopFrame to the VideoPacket.
 TEST(VideoEncoderVpxTest, DpiPropagation) {
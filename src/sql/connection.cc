@@ -328,7 +328,10 @@ Connection::Connection()
       page_size_(0),
       cache_size_(0),
       exclusive_locking_(false),
+      wal_mode_(false),
+      durability_(DURABILITY_DEFAULT),
       restrict_to_user_(false),
+      wal_checkpoint_pending_(false),
       transaction_nesting_(0),
       needs_rollback_(false),
       in_memory_(false),
@@ -341,14 +344,15 @@ Connection::Connection()
       autocommit_time_histogram_(NULL),
       update_time_histogram_(NULL),
       query_time_histogram_(NULL),
-      clock_(new TimeSource()) {
+      clock_(new TimeSource()),
+      weak_factory_(this) {
 }
 
 Connection::~Connection() {
   Close();
 }
 
-void Connection::RecordEvent(Events event, size_t count) {
+void Connection::RecordEvent(Events event, size_t count) const {
   for (size_t i = 0; i < count; ++i) {
     UMA_HISTOGRAM_ENUMERATION("Sqlite.Stats", event, EVENT_MAX_VALUE);
   }
@@ -454,6 +458,10 @@ void Connection::CloseInternal(bool forced) {
     (*i)->Close(forced);
   open_statements_.clear();
 
+  // A checkpoint scheduled for this database mustn't run against the next one.
+  weak_factory_.InvalidateWeakPtrs();
+  wal_checkpoint_pending_ = false;
+
   if (db_) {
     // Call to AssertIOAllowed() cannot go at the beginning of the function
     // because Close() must be called from destructor to clean
@@ -1743,10 +1751,38 @@ bool Connection::OpenInternal(const std::string& file_name,
   // DELETE (default) - delete -journal file to commit.
   // TRUNCATE - truncate -journal file to commit.
   // PERSIST - zero out header of -journal file to commit.
+  // WAL - append to -wal file to commit.
   // TRUNCATE should be faster than DELETE because it won't need directory
   // changes for each transaction.  PERSIST may break the spirit of using
-  // secure_delete.
-  ignore_result(Execute("PRAGMA journal_mode = TRUNCATE"));
+  // secure_delete.  WAL is only used when asked for, along with
+  // synchronous=NORMAL so that commits don't sync.
+  // http://www.sqlite.org/wal.html
+  if (wal_mode_) {
+    ignore_result(Execute("PRAGMA journal_mode = WAL"));
+    if (!wal_checkpoint_delay_.is_zero())
+      sqlite3_wal_hook(db_, &Connection::OnWalCommit, this);
+  } else {
+    ignore_result(Execute("PRAGMA journal_mode = TRUNCATE"));
+  }
+
+  // http://www.sqlite.org/pragma.html#pragma_synchronous
+  Durability durability = durability_;
+  if (durability == DURABILITY_DEFAULT)
+    durability = wal_mode_ ? DURABILITY_NORMAL : DURABILITY_FULL;
+  switch (durability) {
+    case DURABILITY_FULL:
+      ignore_result(Execute("PRAGMA synchronous = FULL"));
+      break;
+    case DURABILITY_NORMAL:
+      ignore_result(Execute("PRAGMA synchronous = NORMAL"));
+      break;
+    case DURABILITY_NONE:
+      ignore_result(Execute("PRAGMA synchronous = OFF"));
+      break;
+    case DURABILITY_DEFAULT:
+      NOTREACHED();
+      break;
+  }
 
   const base::TimeDelta kBusyTimeout =
     base::TimeDelta::FromSeconds(kBusyTimeoutSeconds);
@@ -1882,6 +1918,9 @@ int Connection::OnSqliteError(
   UMA_HISTOGRAM_SPARSE_SLOWLY("Sqlite.Error", err);
   AddTaggedHistogram("Sqlite.Error", err);
 
+  if ((err & 0xff) == SQLITE_IOERR && mmap_enabled_ && db_)
+    DisableMmapAfterError();
+
   // Always log the error.
   if (!sql && stmt)
     sql = stmt->GetSQLStatement();
@@ -1910,6 +1949,57 @@ int Connection::OnSqliteError(
   return err;
 }
 
+void Connection::DisableMmapAfterError() const {
+  // SQLite leaves the mapping alone while pages from it are in use, and the
+  // pager stops fetching from it either way, so this is safe mid-statement.
+  // The mapping is recomputed by GetAppropriateMmapSize() on the next Open().
+  // sqlite3_exec() is used directly so that a failure here doesn't come back
+  // through OnSqliteError().
+  mmap_enabled_ = false;
+  RecordOneEvent(EVENT_MMAP_DISABLED_ON_ERROR);
+  sqlite3_exec(db_, "PRAGMA mmap_size = 0", NULL, NULL, NULL);
+}
+
+// static
+int Connection::OnWalCommit(void* connection,
+                            sqlite3* db,
+                            const char* db_name,
+                            int pages) {
+  // SQLite's own auto-checkpoint threshold, which this hook replaces.
+  const int kCheckpointPages = 1000;
+  Connection* self = static_cast<Connection*>(connection);
+  if (pages < kCheckpointPages || self->wal_checkpoint_pending_)
+    return SQLITE_OK;
+
+  if (!base::ThreadTaskRunnerHandle::IsSet()) {
+    sqlite3_wal_checkpoint_v2(db, db_name, SQLITE_CHECKPOINT_PASSIVE, NULL,
+                              NULL);
+    return SQLITE_OK;
+  }
+
+  self->wal_checkpoint_pending_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&Connection::CheckpointWal, self->weak_factory_.GetWeakPtr()),
+      self->wal_checkpoint_delay_);
+  return SQLITE_OK;
+}
+
+void Connection::CheckpointWal() {
+  wal_checkpoint_pending_ = false;
+  if (!db_)
+    return;
+
+  AssertIOAllowed();
+  RecordOneEvent(EVENT_WAL_CHECKPOINT);
+  // A passive checkpoint copies what it can without waiting on readers, and
+  // busy databases just get checkpointed by a later commit.
+  int rc = sqlite3_wal_checkpoint_v2(db_, NULL, SQLITE_CHECKPOINT_PASSIVE,
+                                     NULL, NULL);
+  if (rc != SQLITE_OK && rc != SQLITE_BUSY)
+    OnSqliteError(rc, NULL, "-- sqlite3_wal_checkpoint_v2()");
+}
+
 bool Connection::FullIntegrityCheck(std::vector<std::string>* messages) {
   return IntegrityCheckHelper("PRAGMA integrity_check", messages);
 }
@@ -18,6 +18,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/time/time.h"
 #include "sql/sql_export.h"
@@ -144,6 +145,52 @@ class SQL_EXPORT Connection {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to use write-ahead logging instead of a rollback journal. A commit
+  // then appends to the -wal file, which is synced only when it is
+  // checkpointed into the database, instead of syncing both a journal and the
+  // database. A power loss can undo the last commits, but doesn't corrupt the
+  // database.
+  //
+  // This must be called before Open() to have an effect.
+  void set_wal_mode() { wal_mode_ = true; }
+
+  // How hard commits try to survive a power loss or OS crash. An application
+  // crash never loses committed data, whatever the tier.
+  enum Durability {
+    // The journal mode's default: DURABILITY_FULL with a rollback journal,
+    // DURABILITY_NORMAL with WAL.
+    DURABILITY_DEFAULT,
+
+    // "PRAGMA synchronous = FULL": every commit is synced before it returns.
+    DURABILITY_FULL,
+
+    // "PRAGMA synchronous = NORMAL": with WAL, a power loss can undo the last
+    // commits but not corrupt the database. With a rollback journal it syncs
+    // less often, and a power loss at the wrong time can corrupt the database.
+    DURABILITY_NORMAL,
+
+    // "PRAGMA synchronous = OFF": nothing is synced. Only for databases which
+    // can be thrown away and rebuilt, such as caches.
+    DURABILITY_NONE,
+  };
+
+  // Sets the durability tier. This must be called before Open() to have an
+  // effect.
+  void set_durability(Durability durability) { durability_ = durability; }
+
+  // In WAL mode, SQLite checkpoints the -wal file back into the database in
+  // whichever commit grows it past 1000 pages, adding the cost of copying
+  // and syncing those pages to that commit. Calling this moves the checkpoint
+  // to a task posted |delay| after that commit, on the thread the connection
+  // is used on, so that it runs once the burst of writes is over. Without a
+  // task runner on that thread the checkpoint is done in the commit, as
+  // SQLite would.
+  //
+  // This must be called before Open() to have an effect.
+  void set_wal_checkpoint_delay(base::TimeDelta delay) {
+    wal_checkpoint_delay_ = delay;
+  }
+
   // Call to cause Open() to restrict access permissions of the
   // database file to only the owner.
   // TODO(shess): Currently only supported on OS_POSIX, is a noop on
@@ -219,12 +266,18 @@ class SQL_EXPORT Connection {
     EVENT_MMAP_SUCCESS_PARTIAL,      // Read but did not reach EOF.
     EVENT_MMAP_SUCCESS_NO_PROGRESS,  // Read quota exhausted.
 
+    // Memory-mapped I/O turned off after an I/O error while it was in use.
+    EVENT_MMAP_DISABLED_ON_ERROR,
+
+    // Checkpoints run by the scheduler set up by set_wal_checkpoint_delay().
+    EVENT_WAL_CHECKPOINT,
+
     // Leave this at the end.
     // TODO(shess): |EVENT_MAX| causes compile fail on Windows.
     EVENT_MAX_VALUE
   };
-  void RecordEvent(Events event, size_t count);
-  void RecordOneEvent(Events event) {
+  void RecordEvent(Events event, size_t count) const;
+  void RecordOneEvent(Events event) const {
     RecordEvent(event, 1);
   }
 
@@ -718,6 +771,20 @@ class SQL_EXPORT Connection {
   // the file should only be read through once.
   size_t GetAppropriateMmapSize();
 
+  // Turns memory-mapped I/O off after an I/O error, which may have come from
+  // the mapping, so that the rest of the session uses regular I/O.
+  void DisableMmapAfterError() const;
+
+  // Called by SQLite after each commit in WAL mode, with the number of
+  // |pages| in the -wal file. Schedules a checkpoint when it gets too large.
+  static int OnWalCommit(void* connection,
+                         sqlite3* db,
+                         const char* db_name,
+                         int pages);
+
+  // Runs a passive checkpoint of the -wal file.
+  void CheckpointWal();
+
   // The actual sqlite database. Will be NULL before Init has been called or if
   // Init resulted in an error.
   sqlite3* db_;
@@ -727,8 +794,17 @@ class SQL_EXPORT Connection {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool wal_mode_;
+  Durability durability_;
   bool restrict_to_user_;
 
+  // Delay from the commit which fills the -wal file to the checkpoint, see
+  // set_wal_checkpoint_delay(). Zero leaves checkpoints to SQLite.
+  base::TimeDelta wal_checkpoint_delay_;
+
+  // |true| while a task posted to run CheckpointWal() hasn't run yet.
+  bool wal_checkpoint_pending_;
+
   // All cached statements. Keeping a reference to these statements means that
   // they'll remain active.
   typedef std::map<StatementID, scoped_refptr<StatementRef> >
@@ -763,8 +839,9 @@ class SQL_EXPORT Connection {
   bool mmap_disabled_;
 
   // |true| if SQLite memory-mapped I/O was enabled for this connection.
-  // Used by ReleaseCacheMemoryIfNeeded().
-  bool mmap_enabled_;
+  // Used by ReleaseCacheMemoryIfNeeded(). Cleared by DisableMmapAfterError(),
+  // which runs from the const error path.
+  mutable bool mmap_enabled_;
 
   // Used by ReleaseCacheMemoryIfNeeded() to track if new changes have happened
   // since memory was last released.
@@ -798,6 +875,8 @@ class SQL_EXPORT Connection {
   // Stores the dump provider object when db is open.
   std::unique_ptr<ConnectionMemoryDumpProvider> memory_dump_provider_;
 
+  base::WeakPtrFactory<Connection> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(Connection);
 };
 
@@ -0,0 +1,105 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/macros.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "sql/connection.h"
+#include "sql/statement.h"
+#include "sql/transaction.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace sql {
+namespace {
+
+const int kRowCount = 2000;
+const int kRowsPerTransaction = 10;
+const int kValueSize = 256;
+
+// The journal and durability settings compared below.
+struct Mode {
+  const char* name;
+  bool wal;
+  Connection::Durability durability;
+  bool mmap_disabled;
+};
+
+const Mode kModes[] = {
+    {"truncate", false, Connection::DURABILITY_DEFAULT, false},
+    {"truncate_normal", false, Connection::DURABILITY_NORMAL, false},
+    {"wal", true, Connection::DURABILITY_DEFAULT, false},
+    {"wal_full", true, Connection::DURABILITY_FULL, false},
+    {"wal_no_mmap", true, Connection::DURABILITY_DEFAULT, true},
+};
+
+class SQLConnectionPerfTest : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  void RunMode(const Mode& mode) {
+    Connection db;
+    if (mode.wal) {
+      db.set_wal_mode();
+      db.set_wal_checkpoint_delay(base::TimeDelta::FromMilliseconds(100));
+    }
+    db.set_durability(mode.durability);
+    if (mode.mmap_disabled)
+      db.set_mmap_disabled();
+    ASSERT_TRUE(db.Open(temp_dir_.path().AppendASCII(mode.name)));
+    ASSERT_TRUE(
+        db.Execute("CREATE TABLE foo (id INTEGER PRIMARY KEY, value TEXT)"));
+
+    const std::string value(kValueSize, 'x');
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kRowCount; i += kRowsPerTransaction) {
+      Transaction transaction(&db);
+      ASSERT_TRUE(transaction.Begin());
+      for (int j = i; j < i + kRowsPerTransaction; ++j) {
+        Statement s(db.GetCachedStatement(
+            SQL_FROM_HERE, "INSERT INTO foo (id, value) VALUES (?, ?)"));
+        s.BindInt(0, j);
+        s.BindString(1, value);
+        ASSERT_TRUE(s.Run());
+      }
+      ASSERT_TRUE(transaction.Commit());
+    }
+    base::TimeDelta insert_time = base::TimeTicks::Now() - start;
+
+    // Let a scheduled checkpoint run, so that reads see the usual state.
+    base::RunLoop().RunUntilIdle();
+
+    start = base::TimeTicks::Now();
+    for (int i = 0; i < kRowCount; ++i) {
+      Statement s(db.GetCachedStatement(
+          SQL_FROM_HERE, "SELECT value FROM foo WHERE id = ?"));
+      s.BindInt(0, i);
+      ASSERT_TRUE(s.Step());
+    }
+    base::TimeDelta read_time = base::TimeTicks::Now() - start;
+
+    perf_test::PrintResult("insert", "", mode.name,
+                           kRowCount / insert_time.InSecondsF(), "rows/s",
+                           true);
+    perf_test::PrintResult("read", "", mode.name,
+                           kRowCount / read_time.InSecondsF(), "rows/s", true);
+  }
+
+ private:
+  base::MessageLoop message_loop_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(SQLConnectionPerfTest, InsertAndRead) {
+  for (const Mode& mode : kModes)
+    RunMode(mode);
+}
+
+}  // namespace
+}  // namespace sql
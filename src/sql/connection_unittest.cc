@@ -11,7 +11,9 @@
 #include "base/files/scoped_temp_dir.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/message_loop/message_loop.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/run_loop.h"
 #include "base/test/histogram_tester.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "sql/connection.h"
@@ -539,6 +541,97 @@ TEST_F(SQLConnectionTest, RazePageSize) {
   ASSERT_EQ(kPageSize, s.ColumnInt(0));
 }
 
+// Test that set_wal_mode() switches the journal to write-ahead logging.
+TEST_F(SQLConnectionTest, WALMode) {
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("truncate", s.ColumnString(0));
+  }
+
+  db().Close();
+  db().set_wal_mode();
+  ASSERT_TRUE(db().Open(db_path()));
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (id INTEGER PRIMARY KEY)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (1)"));
+
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("wal", s.ColumnString(0));
+  }
+  {
+    // 1 is NORMAL.
+    sql::Statement s(db().GetUniqueStatement("PRAGMA synchronous"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(1, s.ColumnInt(0));
+  }
+
+  // Commits went to the -wal file.
+  EXPECT_TRUE(GetPathExists(
+      base::FilePath(db_path().value() + FILE_PATH_LITERAL("-wal"))));
+}
+
+// Test that set_durability() picks the synchronous setting.
+TEST_F(SQLConnectionTest, Durability) {
+  // 0 is OFF, 1 is NORMAL, 2 is FULL.
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA synchronous"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(2, s.ColumnInt(0));
+  }
+
+  db().Close();
+  db().set_durability(sql::Connection::DURABILITY_NONE);
+  ASSERT_TRUE(db().Open(db_path()));
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA synchronous"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(0, s.ColumnInt(0));
+  }
+
+  db().Close();
+  db().set_wal_mode();
+  db().set_durability(sql::Connection::DURABILITY_FULL);
+  ASSERT_TRUE(db().Open(db_path()));
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA synchronous"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(2, s.ColumnInt(0));
+  }
+}
+
+// Test that set_wal_checkpoint_delay() moves the checkpoint out of the commit
+// which fills the -wal file.
+TEST_F(SQLConnectionTest, WALCheckpointDelay) {
+  base::MessageLoop message_loop;
+  base::HistogramTester histogram_tester;
+
+  db().Close();
+  db().set_wal_mode();
+  db().set_wal_checkpoint_delay(base::TimeDelta::FromMilliseconds(1));
+  ASSERT_TRUE(db().Open(db_path()));
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (value BLOB)"));
+
+  // Write well past SQLite's 1000 page auto-checkpoint threshold.
+  ASSERT_TRUE(db().BeginTransaction());
+  for (int i = 0; i < 1100; ++i) {
+    sql::Statement s(db().GetCachedStatement(
+        SQL_FROM_HERE, "INSERT INTO foo (value) VALUES (zeroblob(4096))"));
+    ASSERT_TRUE(s.Run());
+  }
+  ASSERT_TRUE(db().CommitTransaction());
+  histogram_tester.ExpectBucketCount(
+      "Sqlite.Stats", sql::Connection::EVENT_WAL_CHECKPOINT, 0);
+
+  base::RunLoop run_loop;
+  message_loop.task_runner()->PostDelayedTask(
+      FROM_HERE, run_loop.QuitClosure(), base::TimeDelta::FromMilliseconds(50));
+  run_loop.Run();
+  histogram_tester.ExpectBucketCount(
+      "Sqlite.Stats", sql::Connection::EVENT_WAL_CHECKPOINT, 1);
+}
+
 // Test that Raze() results are seen in other connections.
 TEST_F(SQLConnectionTest, RazeMultiple) {
   const char* kCreateSql = "CREATE TABLE foo (id INTEGER PRIMARY KEY, value)";
@@ -130,6 +130,21 @@
       # TODO(jschuh): crbug.com/167187 fix size_t to int truncations.
       'msvs_disabled_warnings': [4267, ],
     },
+    {
+      # GN: //sql:sql_perftests
+      'target_name': 'sql_perftests',
+      'type': '<(gtest_target_type)',
+      'dependencies': [
+        'sql',
+        '../base/base.gyp:test_support_base',
+        '../base/base.gyp:test_support_perf',
+        '../testing/gtest.gyp:gtest',
+        '../testing/perf/perf_test.gyp:perf_test',
+      ],
+      'sources': [
+        'connection_perftest.cc',
+      ],
+    },
   ],
   'conditions': [
     ['OS == "android"', {
@@ -11,10 +11,15 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/memory/ptr_util.h"
 #include "base/memory/shared_memory.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task_runner_util.h"
 #include "storage/browser/blob/blob_data_handle.h"
 #include "storage/browser/blob/blob_storage_context.h"
+#include "storage/browser/blob/shareable_file_reference.h"
 
 namespace storage {
 namespace {
@@ -66,6 +71,36 @@ IPCBlobCreationCancelCode ConvertReferencedBlobErrorToConstructingError(
   return IPCBlobCreationCancelCode::REFERENCED_BLOB_BROKEN;
 }
 
+// Creates |count| files in |dir| for the renderer to write a blob's data to.
+// On failure, the files created so far are deleted. Runs on the file runner.
+bool CreateBlobFiles(const base::FilePath& dir,
+                     size_t count,
+                     std::vector<base::File>* files,
+                     std::vector<base::FilePath>* paths) {
+  bool success = base::CreateDirectory(dir);
+  for (size_t i = 0; success && i < count; i++) {
+    base::FilePath path;
+    success = base::CreateTemporaryFileInDir(dir, &path);
+    if (!success)
+      break;
+    paths->push_back(path);
+    files->emplace_back(path, base::File::FLAG_OPEN | base::File::FLAG_WRITE);
+    success = files->back().IsValid();
+  }
+  if (success)
+    return true;
+  files->clear();
+  for (const base::FilePath& path : *paths)
+    base::DeleteFile(path, false /* recursive */);
+  paths->clear();
+  return false;
+}
+
+void DeleteBlobFiles(const std::vector<base::FilePath>& paths) {
+  for (const base::FilePath& path : paths)
+    base::DeleteFile(path, false /* recursive */);
+}
+
 }  // namespace
 
 using MemoryItemRequest =
@@ -118,7 +153,8 @@ BlobTransportResult BlobAsyncBuilderHost::StartBuildingBlob(
     const std::vector<DataElement>& elements,
     size_t memory_available,
     BlobStorageContext* context,
-    const RequestMemoryCallback& request_memory) {
+    const RequestMemoryCallback& request_memory,
+    const CancelBuildingBlobCallback& cancel) {
   DCHECK(context);
   DCHECK(async_blob_map_.find(uuid) != async_blob_map_.end());
 
@@ -131,19 +167,25 @@ BlobTransportResult BlobAsyncBuilderHost::StartBuildingBlob(
     return BlobTransportResult::BAD_IPC;
   }
 
-  // Step 2: Check if we have enough memory to store the blob.
-  if (total_memory_size_bytes > memory_available) {
+  // Step 2: Check if we have enough memory or disk to store the blob. Blobs
+  //         that are large or don't fit in memory go to disk if there is room.
+  bool page_to_disk =
+      (total_memory_size_bytes > memory_available ||
+       total_memory_size_bytes >= min_page_to_disk_size_) &&
+      context->CanPageToDisk(total_memory_size_bytes);
+  if (total_memory_size_bytes > memory_available && !page_to_disk) {
     CancelBuildingBlob(uuid, IPCBlobCreationCancelCode::OUT_OF_MEMORY, context);
     return BlobTransportResult::CANCEL_MEMORY_FULL;
   }
 
-  // From here on, we know we can fit the blob in memory.
+  // From here on, we know we can fit the blob in memory or on disk.
   BlobBuildingState* state_ptr = async_blob_map_[uuid].get();
   if (!state_ptr->request_builder.requests().empty()) {
     // Check that we're not a duplicate call.
     return BlobTransportResult::BAD_IPC;
   }
   state_ptr->request_memory_callback = request_memory;
+  state_ptr->cancel_callback = cancel;
 
   // Step 3: Check to make sure the referenced blob information we received
   //         earlier is correct:
@@ -174,15 +216,38 @@ BlobTransportResult BlobAsyncBuilderHost::StartBuildingBlob(
     return BlobTransportResult::DONE;
   }
 
+  // Step 5: Decide if the renderer writes the blob straight to files. The
+  //         requests are sent once the files exist.
+  if (page_to_disk) {
+    state_ptr->request_builder.InitializeForFileRequests(
+        max_file_size_, total_memory_size_bytes, elements,
+        &(state_ptr->data_builder));
+    state_ptr->request_received.resize(
+        state_ptr->request_builder.requests().size(), false);
+    std::vector<base::File>* files = new std::vector<base::File>();
+    std::vector<base::FilePath>* paths = new std::vector<base::FilePath>();
+    scoped_refptr<base::SequencedTaskRunner> file_runner =
+        context->file_runner();
+    base::PostTaskAndReplyWithResult(
+        file_runner.get(), FROM_HERE,
+        base::Bind(&CreateBlobFiles, context->blob_storage_dir(),
+                   state_ptr->request_builder.file_sizes().size(), files,
+                   paths),
+        base::Bind(&BlobAsyncBuilderHost::OnFilesCreated,
+                   ptr_factory_.GetWeakPtr(), uuid, context->AsWeakPtr(),
+                   file_runner, base::Owned(files), base::Owned(paths)));
+    return BlobTransportResult::PENDING_RESPONSES;
+  }
+
   // From here on, we know the blob's size is less than |memory_available|,
   // so we know we're < max(size_t).
-  // Step 5: Decide if we're using shared memory.
+  // Step 6: Decide if we're using shared memory.
   if (total_memory_size_bytes > max_ipc_memory_size_) {
     state_ptr->request_builder.InitializeForSharedMemoryRequests(
         max_shared_memory_size_, total_memory_size_bytes, elements,
         &(state_ptr->data_builder));
   } else {
-    // Step 6: We can fit in IPC.
+    // Step 7: We can fit in IPC.
     state_ptr->request_builder.InitializeForIPCRequests(
         max_ipc_memory_size_, total_memory_size_bytes, elements,
         &(state_ptr->data_builder));
@@ -267,6 +332,12 @@ BlobTransportResult BlobAsyncBuilderHost::OnMemoryResponses(
             request.browser_item_offset, request.message.size);
         break;
       case IPCBlobItemRequestStrategy::FILE:
+        DCHECK_LT(request.message.handle_index, state->files.size());
+        invalid_ipc = !state->data_builder.PopulateFutureFile(
+            request.browser_item_index,
+            state->files[request.message.handle_index],
+            response.time_file_modified);
+        break;
       case IPCBlobItemRequestStrategy::UNKNOWN:
         DVLOG(1) << "Not implemented.";
         invalid_ipc = true;
@@ -392,6 +463,8 @@ BlobTransportResult BlobAsyncBuilderHost::ContinueBlobMemoryRequests(
         byte_requests->back().handle_index = 0;
         break;
       case IPCBlobItemRequestStrategy::FILE:
+        NOTREACHED() << "File requests are all sent by OnFilesCreated.";
+        break;
       case IPCBlobItemRequestStrategy::UNKNOWN:
         NOTREACHED() << "Not implemented yet.";
         break;
@@ -408,6 +481,53 @@ BlobTransportResult BlobAsyncBuilderHost::ContinueBlobMemoryRequests(
   return BlobTransportResult::PENDING_RESPONSES;
 }
 
+void BlobAsyncBuilderHost::OnFilesCreated(
+    const std::string& uuid,
+    base::WeakPtr<BlobStorageContext> context,
+    scoped_refptr<base::SequencedTaskRunner> file_runner,
+    std::vector<base::File>* files,
+    std::vector<base::FilePath>* paths,
+    bool success) {
+  auto state_it = async_blob_map_.find(uuid);
+  if (!context || state_it == async_blob_map_.end()) {
+    // The blob was cancelled while its files were being created.
+    files->clear();
+    file_runner->PostTask(FROM_HERE, base::Bind(&DeleteBlobFiles, *paths));
+    return;
+  }
+  BlobBuildingState* state = state_it->second.get();
+  if (!success) {
+    DVLOG(1) << "Unable to create files for blob transfer.";
+    CancelBuildingBlobCallback cancel = state->cancel_callback;
+    CancelBuildingBlob(uuid, IPCBlobCreationCancelCode::FILE_WRITE_FAILED,
+                       context.get());
+    cancel.Run(IPCBlobCreationCancelCode::FILE_WRITE_FAILED);
+    return;
+  }
+
+  const std::vector<size_t>& file_sizes =
+      state->request_builder.file_sizes();
+  DCHECK_EQ(file_sizes.size(), paths->size());
+  for (size_t i = 0; i < paths->size(); i++) {
+    state->files.push_back(
+        context->CreatePagedFileReference((*paths)[i], file_sizes[i]));
+  }
+
+  // The renderer reports one modification time per file, so all of the
+  // requests go out together.
+  const std::vector<MemoryItemRequest>& requests =
+      state->request_builder.requests();
+  std::unique_ptr<std::vector<BlobItemBytesRequest>> byte_requests(
+      new std::vector<BlobItemBytesRequest>());
+  for (const MemoryItemRequest& request : requests)
+    byte_requests->push_back(request.message);
+  state->next_request = requests.size();
+  state->request_memory_callback.Run(
+      std::move(byte_requests),
+      base::WrapUnique(new std::vector<base::SharedMemoryHandle>()),
+      base::WrapUnique(new std::vector<base::File>(std::move(*files))));
+}
+
 void BlobAsyncBuilderHost::ReferencedBlobFinished(
     const std::string& owning_blob_uuid,
     base::WeakPtr<BlobStorageContext> context,
@@ -30,19 +30,24 @@
 #include "storage/common/data_element.h"
 
 namespace base {
+class FilePath;
+class SequencedTaskRunner;
 class SharedMemory;
 }
 
 namespace storage {
 class BlobDataHandle;
 class BlobStorageContext;
+class ShareableFileReference;
 
 // This class
 // * holds all blobs that are currently being built asynchronously for a child
 //   process,
 // * sends memory requests through the given callback in |StartBuildingBlob|,
 //   and uses the BlobTransportResult return value to signify other results,
-// * includes all logic for deciding which async transport strategy to use, and
+// * includes all logic for deciding which async transport strategy to use,
+//   including having the renderer write large blobs straight to files when the
+//   context has disk enabled, and
 // * handles all blob construction communication with the BlobStorageContext.
 // The method |CancelAll| must be called by the consumer, it is not called on
 // destruction.
@@ -52,6 +57,8 @@ class STORAGE_EXPORT BlobAsyncBuilderHost {
       std::unique_ptr<std::vector<storage::BlobItemBytesRequest>>,
       std::unique_ptr<std::vector<base::SharedMemoryHandle>>,
       std::unique_ptr<std::vector<base::File>>)>;
+  using CancelBuildingBlobCallback =
+      base::Callback<void(IPCBlobCreationCancelCode)>;
   BlobAsyncBuilderHost();
   ~BlobAsyncBuilderHost();
 
@@ -84,12 +91,16 @@ class STORAGE_EXPORT BlobAsyncBuilderHost {
   //   before returning.
   // * BAD_IPC: The arguments were invalid/bad. This marks the blob as broken in
   //   the context before returning.
+  // When the blob is written to files, they are created before any request is
+  // sent. If that fails, the blob is marked as broken and |cancel| is run with
+  // FILE_WRITE_FAILED, as there is no pending call to return it from.
   BlobTransportResult StartBuildingBlob(
       const std::string& uuid,
       const std::vector<DataElement>& elements,
       size_t memory_available,
       BlobStorageContext* context,
-      const RequestMemoryCallback& request_memory);
+      const RequestMemoryCallback& request_memory,
+      const CancelBuildingBlobCallback& cancel);
 
   // This is called when we have responses from the Renderer to our calls to
   // the request_memory callback above. See above for return value meaning.
@@ -131,6 +142,11 @@ class STORAGE_EXPORT BlobAsyncBuilderHost {
     max_file_size_ = max_file_size;
   }
 
+  // For testing use only.  Must be called before StartBuildingBlob.
+  void SetMinPageToDiskSizeForTesting(uint64_t min_page_to_disk_size) {
+    min_page_to_disk_size_ = min_page_to_disk_size;
+  }
+
  private:
   struct BlobBuildingState {
     // |refernced_blob_handles| should be all handles generated from the set
@@ -153,6 +169,9 @@ class STORAGE_EXPORT BlobAsyncBuilderHost {
     size_t num_shared_memory_requests = 0;
     // Only relevant if num_shared_memory_requests is > 0
     size_t current_shared_memory_handle_index = 0;
+    // The files the renderer writes the blob to, by handle index, when it is
+    // paged to disk. Releasing them deletes the files.
+    std::vector<scoped_refptr<ShareableFileReference>> files;
 
     // We save these to double check that the RegisterBlob and StartBuildingBlob
     // messages are in sync.
@@ -168,6 +187,7 @@ class STORAGE_EXPORT BlobAsyncBuilderHost {
     size_t num_referenced_blobs_building = 0;
 
     BlobAsyncBuilderHost::RequestMemoryCallback request_memory_callback;
+    BlobAsyncBuilderHost::CancelBuildingBlobCallback cancel_callback;
   };
 
   typedef std::map<std::string, std::unique_ptr<BlobBuildingState>>
@@ -177,6 +197,16 @@ class STORAGE_EXPORT BlobAsyncBuilderHost {
   BlobTransportResult ContinueBlobMemoryRequests(const std::string& uuid,
                                                  BlobStorageContext* context);
 
+  // Called when the files for a blob being paged to disk have been created,
+  // or failed to be. Sends all of the blob's requests to the renderer along
+  // with the files.
+  void OnFilesCreated(const std::string& uuid,
+                      base::WeakPtr<BlobStorageContext> context,
+                      scoped_refptr<base::SequencedTaskRunner> file_runner,
+                      std::vector<base::File>* files,
+                      std::vector<base::FilePath>* paths,
+                      bool success);
+
   // This is our callback for when we want to finish the blob and we're waiting
   // for blobs we reference to be built. When the last callback occurs, we
   // complete the blob and erase our internal state.
@@ -196,6 +226,7 @@ class STORAGE_EXPORT BlobAsyncBuilderHost {
   size_t max_ipc_memory_size_ = kBlobStorageIPCThresholdBytes;
   size_t max_shared_memory_size_ = kBlobStorageMaxSharedMemoryBytes;
   uint64_t max_file_size_ = kBlobStorageMaxFileSizeBytes;
+  uint64_t min_page_to_disk_size_ = kBlobStorageMinPageToDiskBytes;
 
   base::WeakPtrFactory<BlobAsyncBuilderHost> ptr_factory_;
 
@@ -14,11 +14,13 @@
 
 #include "base/bind.h"
 #include "base/callback.h"
+#include "base/files/file_util.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram.h"
+#include "base/sequenced_task_runner.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "storage/browser/blob/blob_data_builder.h"
@@ -26,13 +28,14 @@
 #include "storage/browser/blob/blob_data_item.h"
 #include "storage/browser/blob/blob_data_snapshot.h"
 #include "storage/browser/blob/shareable_blob_data_item.h"
+#include "storage/browser/blob/shareable_file_reference.h"
 #include "url/gurl.h"
 
 namespace storage {
 using BlobRegistryEntry = BlobStorageRegistry::Entry;
 using BlobState = BlobStorageRegistry::BlobState;
 
-BlobStorageContext::BlobStorageContext() : memory_usage_(0) {}
+BlobStorageContext::BlobStorageContext() : memory_usage_(0), disk_usage_(0) {}
 
 BlobStorageContext::~BlobStorageContext() {
 }
@@ -95,6 +98,42 @@ void BlobStorageContext::RevokePublicBlobURL(const GURL& blob_url) {
   DecrementBlobRefCount(uuid);
 }
 
+void BlobStorageContext::EnableDisk(
+    const base::FilePath& blob_storage_dir,
+    scoped_refptr<base::SequencedTaskRunner> file_runner) {
+  DCHECK(!blob_storage_dir.empty());
+  DCHECK(file_runner);
+  blob_storage_dir_ = blob_storage_dir;
+  file_runner_ = std::move(file_runner);
+  // Nothing references files from an earlier session, so they can go. This is
+  // sequenced before any file we create.
+  file_runner_->PostTask(FROM_HERE,
+                         base::Bind(base::IgnoreResult(&base::DeleteFile),
+                                    blob_storage_dir_, true /* recursive */));
+}
+
+scoped_refptr<ShareableFileReference>
+BlobStorageContext::CreatePagedFileReference(const base::FilePath& path,
+                                             uint64_t size) {
+  DCHECK(disk_enabled());
+  scoped_refptr<ShareableFileReference> reference =
+      ShareableFileReference::GetOrCreate(
+          path, ShareableFileReference::DELETE_ON_FINAL_RELEASE,
+          file_runner_.get());
+  disk_usage_ += size;
+  reference->AddFinalReleaseCallback(base::Bind(
+      &BlobStorageContext::OnPagedFileReleased, AsWeakPtr(), size));
+  TRACE_COUNTER1("Blob", "DiskUsageBytes", disk_usage_);
+  return reference;
+}
+
+void BlobStorageContext::OnPagedFileReleased(uint64_t size,
+                                             const base::FilePath& path) {
+  DCHECK_LE(size, disk_usage_);
+  disk_usage_ -= size;
+  TRACE_COUNTER1("Blob", "DiskUsageBytes", disk_usage_);
+}
+
 void BlobStorageContext::CreatePendingBlob(
     const std::string& uuid,
     const std::string& content_type,
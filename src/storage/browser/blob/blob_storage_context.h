@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "base/callback_forward.h"
+#include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -28,7 +29,7 @@
 class GURL;
 
 namespace base {
-class FilePath;
+class SequencedTaskRunner;
 class Time;
 }
 
@@ -43,6 +44,7 @@ class BlobDataBuilder;
 class BlobDataItem;
 class BlobDataSnapshot;
 class ShareableBlobDataItem;
+class ShareableFileReference;
 
 // This class handles the logistics of blob Storage within the browser process,
 // and maintains a mapping from blob uuid to the data. The class is single
@@ -81,6 +83,27 @@ class STORAGE_EXPORT BlobStorageContext
     return kBlobStorageMaxMemoryUsage - memory_usage_;
   }
 
+  // Lets large blobs be written to files in |blob_storage_dir| as they are
+  // transported, instead of being held in memory. Files left there by an
+  // earlier session are deleted first. File operations run on |file_runner|.
+  void EnableDisk(const base::FilePath& blob_storage_dir,
+                  scoped_refptr<base::SequencedTaskRunner> file_runner);
+
+  bool disk_enabled() const { return !!file_runner_; }
+  const base::FilePath& blob_storage_dir() const { return blob_storage_dir_; }
+  base::SequencedTaskRunner* file_runner() const { return file_runner_.get(); }
+  uint64_t disk_usage() const { return disk_usage_; }
+  uint64_t disk_available() const {
+    return disk_usage_ < kBlobStorageMaxDiskSpace
+               ? kBlobStorageMaxDiskSpace - disk_usage_
+               : 0;
+  }
+
+  // Returns true if disk is enabled and has room for |total_bytes| more.
+  bool CanPageToDisk(uint64_t total_bytes) const {
+    return disk_enabled() && total_bytes <= disk_available();
+  }
+
   const BlobStorageRegistry& registry() { return registry_; }
 
  private:
@@ -156,6 +179,14 @@ class STORAGE_EXPORT BlobStorageContext
                   uint64_t length,
                   InternalBlobData::Builder* target_blob_data);
 
+  // Returns a reference to |path|, a file of |size| bytes written with blob
+  // data. The file counts towards disk_usage() until the last reference is
+  // released, when it is deleted.
+  scoped_refptr<ShareableFileReference> CreatePagedFileReference(
+      const base::FilePath& path,
+      uint64_t size);
+  void OnPagedFileReleased(uint64_t size, const base::FilePath& path);
+
   BlobStorageRegistry registry_;
 
   // Used to keep track of how much memory is being utilized for blob data,
@@ -163,6 +194,12 @@ class STORAGE_EXPORT BlobStorageContext
   // items of TYPE_FILE.
   size_t memory_usage_;
 
+  base::FilePath blob_storage_dir_;
+  scoped_refptr<base::SequencedTaskRunner> file_runner_;
+  // The size of the files written with transported blob data that are still
+  // referenced.
+  uint64_t disk_usage_;
+
   DISALLOW_COPY_AND_ASSIGN(BlobStorageContext);
 };
 
@@ -55,6 +55,8 @@ void DidGetGlobalUsageForLimitedGlobalUsage(const UsageCallback& callback,
   callback.Run(total_global_usage - global_unlimited_usage);
 }
 
+void DidGetHostUsageForReconcile(int64_t usage) {}
+
 }  // namespace
 
 ClientUsageTracker::ClientUsageTracker(
@@ -144,6 +146,7 @@ void ClientUsageTracker::UpdateUsageCache(const GURL& origin, int64_t delta) {
       return;
 
     cached_usage_by_host_[host][origin] += delta;
+    dirty_origins_.insert(origin);
     if (IsStorageUnlimited(origin))
       global_unlimited_usage_ += delta;
     else
@@ -229,6 +232,46 @@ void ClientUsageTracker::SetUsageCacheEnabled(const GURL& origin,
   }
 }
 
+void ClientUsageTracker::SeedUsageCache(
+    const std::map<GURL, int64_t>& origin_usage,
+    bool complete) {
+  HostSet seeded_hosts;
+  for (const auto& origin_and_usage : origin_usage) {
+    const GURL& origin = origin_and_usage.first;
+    std::string host = net::GetHostOrSpecFromURL(origin);
+    if (ContainsKey(cached_hosts_, host) ||
+        !IsUsageCacheEnabledForOrigin(origin)) {
+      continue;
+    }
+    AddCachedOrigin(origin, origin_and_usage.second);
+    // The value came from the database, so there is nothing to write back.
+    dirty_origins_.erase(origin);
+    seeded_hosts.insert(host);
+  }
+  cached_hosts_.insert(seeded_hosts.begin(), seeded_hosts.end());
+
+  // Hosts missing from a complete snapshot had no usage, so the global totals
+  // computed from the cache are exact.
+  if (complete)
+    global_usage_retrieved_ = true;
+}
+
+void ClientUsageTracker::TakeDirtyOriginsUsage(
+    std::map<GURL, int64_t>* origin_usage) {
+  DCHECK(origin_usage);
+  for (const auto& origin : dirty_origins_) {
+    int64_t usage = 0;
+    GetCachedOriginUsage(origin, &usage);
+    (*origin_usage)[origin] = usage;
+  }
+  dirty_origins_.clear();
+}
+
+void ClientUsageTracker::ReconcileUsageCache() {
+  client_->GetOriginsForType(type_, base::Bind(
+      &ClientUsageTracker::DidGetOriginsForReconcile, AsWeakPtr()));
+}
+
 void ClientUsageTracker::AccumulateLimitedOriginUsage(
     AccumulateInfo* info,
     const UsageCallback& callback,
@@ -353,6 +396,77 @@ void ClientUsageTracker::DidGetHostUsageAfterUpdate(const GURL& origin,
   storage_monitor_->NotifyUsageChange(filter, 0);
 }
 
+void ClientUsageTracker::DidGetOriginsForReconcile(
+    const std::set<GURL>& origins) {
+  OriginSetByHost origins_by_host;
+  for (const auto& origin : origins)
+    origins_by_host[net::GetHostOrSpecFromURL(origin)].insert(origin);
+
+  // Drop cached origins the client no longer has. Origins modified since the
+  // last flush may have been created after the client listed its origins.
+  for (auto host_itr = cached_usage_by_host_.begin();
+       host_itr != cached_usage_by_host_.end();) {
+    const std::string& host = host_itr->first;
+    UsageMap& usage_map = host_itr->second;
+    for (auto itr = usage_map.begin(); itr != usage_map.end();) {
+      if (OriginSetContainsOrigin(origins_by_host, host, itr->first) ||
+          ContainsKey(dirty_origins_, itr->first)) {
+        ++itr;
+        continue;
+      }
+      AddCachedOrigin(itr->first, 0);
+      usage_map.erase(itr++);
+    }
+    if (usage_map.empty())
+      cached_usage_by_host_.erase(host_itr++);
+    else
+      ++host_itr;
+  }
+
+  for (const auto& host_and_origins : origins_by_host) {
+    const std::string& host = host_and_origins.first;
+    if (!ContainsKey(cached_hosts_, host)) {
+      // Uncached hosts are normally gathered on demand, but the global totals
+      // claim to include every origin, so gather the ones that were missed.
+      if (global_usage_retrieved_)
+        GetHostUsage(host, base::Bind(&DidGetHostUsageForReconcile));
+      continue;
+    }
+    for (const auto& origin : host_and_origins.second) {
+      if (!IsUsageCacheEnabledForOrigin(origin))
+        continue;
+      client_->GetOriginUsage(
+          origin, type_,
+          base::Bind(&ClientUsageTracker::DidGetOriginUsageForReconcile,
+                     AsWeakPtr(), origin));
+    }
+  }
+}
+
+void ClientUsageTracker::DidGetOriginUsageForReconcile(const GURL& origin,
+                                                       int64_t usage) {
+  if (usage < 0)
+    usage = 0;
+
+  // The host may have been dropped from the cache while the client was busy.
+  std::string host = net::GetHostOrSpecFromURL(origin);
+  if (!ContainsKey(cached_hosts_, host) ||
+      !IsUsageCacheEnabledForOrigin(origin)) {
+    return;
+  }
+
+  int64_t cached_usage = 0;
+  GetCachedOriginUsage(origin, &cached_usage);
+  if (cached_usage == usage)
+    return;
+
+  AddCachedOrigin(origin, usage);
+  if (storage_monitor_) {
+    StorageObserver::Filter filter(type_, origin);
+    storage_monitor_->NotifyUsageChange(filter, usage - cached_usage);
+  }
+}
+
 void ClientUsageTracker::AddCachedOrigin(const GURL& origin,
                                          int64_t new_usage) {
   DCHECK(IsUsageCacheEnabledForOrigin(origin));
@@ -362,6 +476,7 @@ void ClientUsageTracker::AddCachedOrigin(const GURL& origin,
   int64_t delta = new_usage - *usage;
   *usage = new_usage;
   if (delta) {
+    dirty_origins_.insert(origin);
     if (IsStorageUnlimited(origin))
       global_unlimited_usage_ += delta;
     else
@@ -58,6 +58,26 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   bool IsUsageCacheEnabledForOrigin(const GURL& origin) const;
   void SetUsageCacheEnabled(const GURL& origin, bool enabled);
 
+  // Fills the cache with usage persisted by an earlier session, so that the
+  // first queries for these hosts need not wait for the client. Hosts that
+  // are already cached keep their values. If |complete| the persisted origins
+  // were all the origins of the client, and global usage is answered from the
+  // cache as well.
+  void SeedUsageCache(const std::map<GURL, int64_t>& origin_usage,
+                      bool complete);
+
+  // Moves the current usage of every origin whose cached usage changed since
+  // the last call into |origin_usage|. Origins that are no longer cached are
+  // reported with zero usage.
+  void TakeDirtyOriginsUsage(std::map<GURL, int64_t>* origin_usage);
+
+  // Whether the cache holds the usage of every origin of the client.
+  bool global_usage_retrieved() const { return global_usage_retrieved_; }
+
+  // Asks the client for its origins and their usage, and corrects the cache
+  // where it has drifted, e.g. after seeding it from a stale snapshot.
+  void ReconcileUsageCache();
+
  private:
   typedef CallbackQueueMap<HostUsageAccumulator, std::string, int64_t, int64_t>
       HostUsageAccumulatorMap;
@@ -97,6 +117,9 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
 
   void DidGetHostUsageAfterUpdate(const GURL& origin, int64_t usage);
 
+  void DidGetOriginsForReconcile(const std::set<GURL>& origins);
+  void DidGetOriginUsageForReconcile(const GURL& origin, int64_t usage);
+
   // Methods used by our GatherUsage tasks, as a task makes progress
   // origins and hosts are added incrementally to the cache.
   void AddCachedOrigin(const GURL& origin, int64_t usage);
@@ -124,6 +147,9 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   HostSet cached_hosts_;
   HostUsageMap cached_usage_by_host_;
 
+  // Origins whose cached usage has changed since TakeDirtyOriginsUsage().
+  std::set<GURL> dirty_origins_;
+
   OriginSetByHost non_cached_limited_origins_by_host_;
   OriginSetByHost non_cached_unlimited_origins_by_host_;
 
@@ -15,6 +15,7 @@
 #include "base/files/file_util.h"
 #include "base/macros.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/strings/string_number_conversions.h"
 #include "sql/connection.h"
 #include "sql/meta_table.h"
 #include "sql/statement.h"
@@ -26,13 +27,20 @@ namespace {
 
 // Definitions for database schema.
 
-const int kCurrentVersion = 5;
+const int kCurrentVersion = 6;
 const int kCompatibleVersion = 2;
 
 const char kHostQuotaTable[] = "HostQuotaTable";
 const char kOriginInfoTable[] = "OriginInfoTable";
 const char kEvictionInfoTable[] = "EvictionInfoTable";
+const char kOriginUsageTable[] = "OriginUsageTable";
 const char kIsOriginTableBootstrapped[] = "IsOriginTableBootstrapped";
+const char kCompleteUsageCacheClientsPrefix[] = "CompleteUsageCacheClients";
+
+std::string GetCompleteUsageCacheClientsKey(StorageType type) {
+  return kCompleteUsageCacheClientsPrefix +
+         base::IntToString(static_cast<int>(type));
+}
 
 bool VerifyValidQuotaConfig(const char* key) {
   return (key != NULL &&
@@ -93,7 +101,13 @@ const QuotaDatabase::TableSchema QuotaDatabase::kTables[] = {
      "(origin TEXT NOT NULL,"
      " type INTEGER NOT NULL,"
      " last_eviction_time INTEGER DEFAULT 0,"
-     " UNIQUE(origin, type))"}};
+     " UNIQUE(origin, type))"},
+    {kOriginUsageTable,
+     "(origin TEXT NOT NULL,"
+     " type INTEGER NOT NULL,"
+     " client_id INTEGER NOT NULL,"
+     " usage INTEGER DEFAULT 0,"
+     " UNIQUE(origin, type, client_id))"}};
 
 // static
 const QuotaDatabase::IndexSchema QuotaDatabase::kIndexes[] = {
@@ -152,6 +166,19 @@ QuotaDatabase::OriginInfoTableEntry::OriginInfoTableEntry(
       last_modified_time(last_modified_time) {
 }
 
+QuotaDatabase::OriginUsageTableEntry::OriginUsageTableEntry()
+    : type(kStorageTypeUnknown),
+      client_id(QuotaClient::kUnknown),
+      usage(0) {
+}
+
+QuotaDatabase::OriginUsageTableEntry::OriginUsageTableEntry(
+    const GURL& origin,
+    StorageType type,
+    QuotaClient::ID client_id,
+    int64_t usage)
+    : origin(origin), type(type), client_id(client_id), usage(usage) {}
+
 // QuotaDatabase ------------------------------------------------------------
 QuotaDatabase::QuotaDatabase(const base::FilePath& path)
     : db_file_path_(path),
@@ -519,6 +546,78 @@ bool QuotaDatabase::SetOriginDatabaseBootstrapped(bool bootstrap_flag) {
   return meta_table_->SetValue(kIsOriginTableBootstrapped, bootstrap_flag);
 }
 
+bool QuotaDatabase::GetOriginUsages(
+    std::vector<OriginUsageTableEntry>* entries) {
+  DCHECK(entries);
+  if (!LazyOpen(false))
+    return false;
+
+  const char* kSql = "SELECT origin, type, client_id, usage"
+                     " FROM OriginUsageTable";
+  sql::Statement statement(db_->GetCachedStatement(SQL_FROM_HERE, kSql));
+
+  entries->clear();
+  while (statement.Step()) {
+    entries->push_back(OriginUsageTableEntry(
+        GURL(statement.ColumnString(0)),
+        static_cast<StorageType>(statement.ColumnInt(1)),
+        static_cast<QuotaClient::ID>(statement.ColumnInt(2)),
+        statement.ColumnInt64(3)));
+  }
+
+  return statement.Succeeded();
+}
+
+bool QuotaDatabase::SetOriginUsages(
+    const std::vector<OriginUsageTableEntry>& entries) {
+  if (!LazyOpen(true))
+    return false;
+
+  for (const auto& entry : entries) {
+    DCHECK_GE(entry.usage, 0);
+    sql::Statement statement;
+    if (entry.usage > 0) {
+      const char* kSql =
+          "INSERT OR REPLACE INTO OriginUsageTable"
+          " (origin, type, client_id, usage)"
+          " VALUES (?, ?, ?, ?)";
+      statement.Assign(db_->GetCachedStatement(SQL_FROM_HERE, kSql));
+      statement.BindInt64(3, entry.usage);
+    } else {
+      const char* kSql =
+          "DELETE FROM OriginUsageTable"
+          " WHERE origin = ? AND type = ? AND client_id = ?";
+      statement.Assign(db_->GetCachedStatement(SQL_FROM_HERE, kSql));
+    }
+    statement.BindString(0, entry.origin.spec());
+    statement.BindInt(1, static_cast<int>(entry.type));
+    statement.BindInt(2, static_cast<int>(entry.client_id));
+
+    if (!statement.Run())
+      return false;
+  }
+
+  ScheduleCommit();
+  return true;
+}
+
+bool QuotaDatabase::GetCompleteUsageCacheClients(StorageType type,
+                                                 int* client_mask) {
+  DCHECK(client_mask);
+  if (!LazyOpen(false))
+    return false;
+  return meta_table_->GetValue(GetCompleteUsageCacheClientsKey(type).c_str(),
+                               client_mask);
+}
+
+bool QuotaDatabase::SetCompleteUsageCacheClients(StorageType type,
+                                                 int client_mask) {
+  if (!LazyOpen(true))
+    return false;
+  return meta_table_->SetValue(GetCompleteUsageCacheClientsKey(type).c_str(),
+                               client_mask);
+}
+
 void QuotaDatabase::Commit() {
   if (!db_)
     return;
@@ -705,7 +804,9 @@ bool QuotaDatabase::UpgradeSchema(int current_version) {
         return false;
     }
     return transaction.Commit();
-  } else if (current_version < 5) {
+  }
+
+  if (current_version < 5) {
     sql::Transaction transaction(db_.get());
     if (!transaction.Begin())
       return false;
@@ -722,6 +823,28 @@ bool QuotaDatabase::UpgradeSchema(int current_version) {
     }
 
     meta_table_->SetVersionNumber(5);
+    if (!transaction.Commit())
+      return false;
+    current_version = 5;
+  }
+
+  if (current_version == 5) {
+    sql::Transaction transaction(db_.get());
+    if (!transaction.Begin())
+      return false;
+
+    const QuotaDatabase::TableSchema& usage_table_schema = kTables[3];
+    DCHECK_EQ(strcmp(kOriginUsageTable, usage_table_schema.table_name), 0);
+
+    std::string sql("CREATE TABLE ");
+    sql += usage_table_schema.table_name;
+    sql += usage_table_schema.columns;
+    if (!db_->Execute(sql.c_str())) {
+      VLOG(1) << "Failed to execute " << sql;
+      return false;
+    }
+
+    meta_table_->SetVersionNumber(6);
     return transaction.Commit();
   }
   return false;
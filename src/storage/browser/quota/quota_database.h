@@ -11,12 +11,14 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
+#include "storage/browser/quota/quota_client.h"
 #include "storage/browser/storage_browser_export.h"
 #include "storage/common/quota/quota_types.h"
 #include "url/gurl.h"
@@ -53,6 +55,20 @@ class STORAGE_EXPORT QuotaDatabase {
     base::Time last_modified_time;
   };
 
+  // The last known usage of |origin| by one client, used to answer usage
+  // queries after a restart without asking the client.
+  struct STORAGE_EXPORT OriginUsageTableEntry {
+    OriginUsageTableEntry();
+    OriginUsageTableEntry(const GURL& origin,
+                          StorageType type,
+                          QuotaClient::ID client_id,
+                          int64_t usage);
+    GURL origin;
+    StorageType type;
+    QuotaClient::ID client_id;
+    int64_t usage;
+  };
+
   // Constants for {Get,Set}QuotaConfigValue keys.
   static const char kDesiredAvailableSpaceKey[];
   static const char kTemporaryQuotaOverrideKey[];
@@ -129,6 +145,20 @@ class STORAGE_EXPORT QuotaDatabase {
   bool IsOriginDatabaseBootstrapped();
   bool SetOriginDatabaseBootstrapped(bool bootstrap_flag);
 
+  // Populates |entries| with all the cached origin usage. Returns whether the
+  // operation succeeded.
+  bool GetOriginUsages(std::vector<OriginUsageTableEntry>* entries);
+
+  // Stores the usage in |entries|, replacing any previous value for the same
+  // origin, type and client. Entries with zero usage are removed.
+  bool SetOriginUsages(const std::vector<OriginUsageTableEntry>& entries);
+
+  // The bitmask of QuotaClient::IDs whose cached usage of |type| covers all
+  // of their origins, not only the hosts that happened to be queried.
+  // GetCompleteUsageCacheClients() returns whether the value could be found.
+  bool GetCompleteUsageCacheClients(StorageType type, int* client_mask);
+  bool SetCompleteUsageCacheClients(StorageType type, int client_mask);
+
  private:
   struct STORAGE_EXPORT QuotaTableEntry {
     QuotaTableEntry();
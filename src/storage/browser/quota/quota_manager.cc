@@ -49,6 +49,13 @@ const int64_t kMBytes = 1024 * 1024;
 const int kMinutesInMilliSeconds = 60 * 1000;
 
 const int64_t kReportHistogramInterval = 60 * 60 * 1000;  // 1 hour
+const int64_t kSaveUsageCacheInterval = 30 * 1000;  // 30 seconds
+const int64_t kReconcileUsageCacheDelay = 60 * 1000;  // 1 minute
+
+// The storage types whose usage is persisted across sessions.
+const StorageType kUsageCacheTypes[] = {
+    kStorageTypeTemporary, kStorageTypePersistent, kStorageTypeSyncable,
+};
 const double kTemporaryQuotaRatioToAvail = 1.0 / 3.0;  // 33%
 
 }  // namespace
@@ -859,6 +866,49 @@ class QuotaManager::DumpOriginInfoTableHelper {
   OriginInfoTableEntries entries_;
 };
 
+class QuotaManager::UsageCacheHelper {
+ public:
+  bool LoadUsageCacheOnDBThread(QuotaDatabase* database) {
+    DCHECK(database);
+    // Nothing is cached yet if the database does not exist.
+    database->GetOriginUsages(&entries_);
+    for (StorageType type : kUsageCacheTypes) {
+      int client_mask = 0;
+      if (database->GetCompleteUsageCacheClients(type, &client_mask))
+        complete_clients_[type] = client_mask;
+    }
+    return true;
+  }
+
+  bool SaveUsageCacheOnDBThread(QuotaDatabase* database) {
+    DCHECK(database);
+    if (!entries_.empty() && !database->SetOriginUsages(entries_))
+      return false;
+    for (const auto& type_and_clients : complete_clients_) {
+      if (!database->SetCompleteUsageCacheClients(type_and_clients.first,
+                                                  type_and_clients.second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void DidSaveUsageCache(const base::WeakPtr<QuotaManager>& manager,
+                         bool success) {
+    if (manager)
+      manager->DidDatabaseWork(success);
+  }
+
+  bool empty() const { return entries_.empty() && complete_clients_.empty(); }
+
+  OriginUsageTableEntries* entries() { return &entries_; }
+  std::map<StorageType, int>* complete_clients() { return &complete_clients_; }
+
+ private:
+  OriginUsageTableEntries entries_;
+  std::map<StorageType, int> complete_clients_;
+};
+
 // QuotaManager ---------------------------------------------------------------
 
 QuotaManager::QuotaManager(
@@ -905,6 +955,14 @@ void QuotaManager::GetUsageAndQuotaForWebApps(
 
   DCHECK(origin == origin.GetOrigin());
   LazyInitialize();
+  if (!temporary_quota_initialized_) {
+    // Answer from the persisted usage cache once it is loaded rather than
+    // making the clients scan their storage now.
+    db_initialization_callbacks_.Add(base::Bind(
+        &QuotaManager::GetUsageAndQuotaForWebApps,
+        weak_factory_.GetWeakPtr(), origin, type, callback));
+    return;
+  }
 
   bool unlimited = IsStorageUnlimited(origin, type);
   bool can_query_disk_size = CanQueryDiskSize(origin);
@@ -1273,6 +1331,10 @@ void QuotaManager::RemoveStorageObserverForFilter(
 
 QuotaManager::~QuotaManager() {
   proxy_->manager_ = NULL;
+  // Write back the usage changed since the last save. The database is deleted
+  // on the DB thread after this task runs.
+  if (save_usage_cache_timer_.IsRunning())
+    SaveUsageCache();
   for (auto* client : clients_)
     client->OnQuotaManagerDestroyed();
   if (database_)
@@ -1307,6 +1369,19 @@ void QuotaManager::LazyInitialize() {
       clients_, kStorageTypeSyncable, special_storage_policy_.get(),
       storage_monitor_.get()));
 
+  // Load the usage cache first, so that it is in place when the callbacks
+  // waiting for DidInitialize() run.
+  if (!is_incognito_) {
+    UsageCacheHelper* helper = new UsageCacheHelper;
+    PostTaskAndReplyWithResultForDBThread(
+        FROM_HERE,
+        base::Bind(&UsageCacheHelper::LoadUsageCacheOnDBThread,
+                   base::Unretained(helper)),
+        base::Bind(&QuotaManager::DidLoadUsageCache,
+                   weak_factory_.GetWeakPtr(),
+                   base::Owned(helper)));
+  }
+
   int64_t* temporary_quota_override = new int64_t(-1);
   int64_t* desired_available_space = new int64_t(-1);
   PostTaskAndReplyWithResultForDBThread(
@@ -1558,6 +1633,87 @@ void QuotaManager::DidDumpOriginInfoTableForHistogram(
   }
 }
 
+void QuotaManager::DidLoadUsageCache(UsageCacheHelper* helper, bool success) {
+  std::map<std::pair<StorageType, QuotaClient::ID>, std::map<GURL, int64_t>>
+      usage_by_tracker;
+  for (const auto& entry : *helper->entries()) {
+    usage_by_tracker[std::make_pair(entry.type, entry.client_id)]
+                    [entry.origin] = entry.usage;
+  }
+
+  for (StorageType type : kUsageCacheTypes) {
+    int complete_clients = (*helper->complete_clients())[type];
+    saved_complete_usage_cache_clients_[type] = complete_clients;
+    for (auto* client : clients_) {
+      ClientUsageTracker* client_tracker =
+          GetUsageTracker(type)->GetClientTracker(client->id());
+      if (!client_tracker)
+        continue;
+      client_tracker->SeedUsageCache(
+          usage_by_tracker[std::make_pair(type, client->id())],
+          (complete_clients & client->id()) != 0);
+    }
+  }
+
+  save_usage_cache_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromMilliseconds(kSaveUsageCacheInterval),
+      this, &QuotaManager::SaveUsageCache);
+  reconcile_usage_cache_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromMilliseconds(kReconcileUsageCacheDelay),
+      this, &QuotaManager::ReconcileUsageCache);
+}
+
+void QuotaManager::SaveUsageCache() {
+  if (db_disabled_)
+    return;
+
+  std::unique_ptr<UsageCacheHelper> helper(new UsageCacheHelper);
+  for (StorageType type : kUsageCacheTypes) {
+    int complete_clients = 0;
+    for (auto* client : clients_) {
+      ClientUsageTracker* client_tracker =
+          GetUsageTracker(type)->GetClientTracker(client->id());
+      if (!client_tracker)
+        continue;
+      std::map<GURL, int64_t> origin_usage;
+      client_tracker->TakeDirtyOriginsUsage(&origin_usage);
+      for (const auto& origin_and_usage : origin_usage) {
+        helper->entries()->push_back(OriginUsageTableEntry(
+            origin_and_usage.first, type, client->id(),
+            std::max<int64_t>(origin_and_usage.second, 0)));
+      }
+      if (client_tracker->global_usage_retrieved())
+        complete_clients |= client->id();
+    }
+    if (complete_clients != saved_complete_usage_cache_clients_[type]) {
+      (*helper->complete_clients())[type] = complete_clients;
+      saved_complete_usage_cache_clients_[type] = complete_clients;
+    }
+  }
+  if (helper->empty())
+    return;
+
+  UsageCacheHelper* helper_ptr = helper.get();
+  PostTaskAndReplyWithResultForDBThread(
+      FROM_HERE,
+      base::Bind(&UsageCacheHelper::SaveUsageCacheOnDBThread,
+                 base::Unretained(helper_ptr)),
+      base::Bind(&UsageCacheHelper::DidSaveUsageCache,
+                 base::Owned(helper.release()),
+                 weak_factory_.GetWeakPtr()));
+}
+
+void QuotaManager::ReconcileUsageCache() {
+  for (StorageType type : kUsageCacheTypes) {
+    for (auto* client : clients_) {
+      ClientUsageTracker* client_tracker =
+          GetUsageTracker(type)->GetClientTracker(client->id());
+      if (client_tracker)
+        client_tracker->ReconcileUsageCache();
+    }
+  }
+}
+
 std::set<GURL> QuotaManager::GetEvictionOriginExceptions(
     const std::set<GURL>& extra_exceptions) {
   std::set<GURL> exceptions = extra_exceptions;
@@ -312,11 +312,14 @@ class STORAGE_EXPORT QuotaManager
   class GetModifiedSinceHelper;
   class DumpQuotaTableHelper;
   class DumpOriginInfoTableHelper;
+  class UsageCacheHelper;
 
   typedef QuotaDatabase::QuotaTableEntry QuotaTableEntry;
   typedef QuotaDatabase::OriginInfoTableEntry OriginInfoTableEntry;
+  typedef QuotaDatabase::OriginUsageTableEntry OriginUsageTableEntry;
   typedef std::vector<QuotaTableEntry> QuotaTableEntries;
   typedef std::vector<OriginInfoTableEntry> OriginInfoTableEntries;
+  typedef std::vector<OriginUsageTableEntry> OriginUsageTableEntries;
 
   // Function pointer type used to store the function which returns
   // information about the volume containing the given FilePath.
@@ -400,6 +403,15 @@ class STORAGE_EXPORT QuotaManager
   void DidDumpOriginInfoTableForHistogram(
       const OriginInfoTableEntries& entries);
 
+  // Methods for the persistent usage cache. The cache is loaded once during
+  // initialization, the origins whose usage changed are written back
+  // periodically, and the clients are asked for their actual usage once in
+  // the background to correct whatever drifted while the browser was not
+  // running.
+  void DidLoadUsageCache(UsageCacheHelper* helper, bool success);
+  void SaveUsageCache();
+  void ReconcileUsageCache();
+
   std::set<GURL> GetEvictionOriginExceptions(
       const std::set<GURL>& extra_exceptions);
   void DidGetEvictionOrigin(const GetOriginCallback& callback,
@@ -502,6 +514,11 @@ class STORAGE_EXPORT QuotaManager
 
   base::RepeatingTimer histogram_timer_;
 
+  base::RepeatingTimer save_usage_cache_timer_;
+  base::OneShotTimer reconcile_usage_cache_timer_;
+  // The complete client masks last written to the database, by type.
+  std::map<StorageType, int> saved_complete_usage_cache_clients_;
+
   // Pointer to the function used to get volume information. This is
   // overwritten by QuotaManagerTest in order to attain deterministic reported
   // values. The default value points to QuotaManager::GetVolumeInfo.
@@ -19,6 +19,12 @@ const uint64_t kBlobStorageMaxFileSizeBytes = 100 * 1024 * 1024;
 const uint64_t kBlobStorageMinFileSizeBytes = 1 * 1024 * 1024;
 const size_t kBlobStorageMaxBlobMemorySize =
     kBlobStorageMaxMemoryUsage - kBlobStorageMinFileSizeBytes;
+// When the blob storage context has disk enabled, blobs whose data is at least
+// this large are written to files as they are transported, and so are blobs
+// that don't fit in the remaining memory.
+const uint64_t kBlobStorageMinPageToDiskBytes = 50 * 1024 * 1024;
+// The most disk space that transported blob data may use.
+const uint64_t kBlobStorageMaxDiskSpace = 2048ull * 1024 * 1024;  // 2 GB.
 
 enum class IPCBlobItemRequestStrategy {
   UNKNOWN = 0,
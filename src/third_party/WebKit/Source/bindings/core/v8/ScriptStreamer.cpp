@@ -513,11 +513,9 @@ void ScriptStreamer::notifyAppendData(ScriptResource* resource)
             recordStartedStreamingHistogram(m_scriptType, 0);
             return;
         }
-        if (ScriptStreamerThread::shared()->isRunningTask()) {
-            // At the moment we only have one thread for running the tasks. A
-            // new task shouldn't be queued before the running task completes,
-            // because the running task can block and wait for data from the
-            // network.
+        if (!ScriptStreamerThread::shared()->canPostTask(m_scriptType)) {
+            // A new task shouldn't be queued behind a running task, because
+            // the running task can block and wait for data from the network.
             suppressStreaming();
             recordNotStreamingReasonHistogram(m_scriptType, ThreadBusy);
             recordStartedStreamingHistogram(m_scriptType, 0);
@@ -549,6 +547,7 @@ void ScriptStreamer::notifyAppendData(ScriptResource* resource)
             return;
         }
 
+        TRACE_EVENT_ASYNC_BEGIN1("v8", "v8.parseOnBackgroundWaiting", this, "url", m_scriptURLString.utf8());
         ScriptStreamerThread::shared()->postTask(crossThreadBind(&ScriptStreamerThread::runScriptStreamingTask, passed(std::move(scriptStreamingTask)), wrapCrossThreadPersistent(this)));
         recordStartedStreamingHistogram(m_scriptType, 1);
     }
@@ -11,6 +11,7 @@
 #include "public/platform/WebTaskRunner.h"
 #include "public/platform/WebTraceLocation.h"
 #include "wtf/PtrUtil.h"
+#include <algorithm>
 #include <memory>
 
 namespace blink {
@@ -55,31 +56,62 @@ ScriptStreamerThread* ScriptStreamerThread::shared()
     return s_sharedThread;
 }
 
+ScriptStreamerThread::ScriptStreamerThread()
+    // Most of the time a task waits for the network rather than parses, so
+    // use at least two threads, one of which is kept for parser-blocking
+    // scripts.
+    : m_maximumThreads(std::min<size_t>(std::max<size_t>(Platform::current()->numberOfProcessors(), 2), 8))
+    , m_runningTasks(0)
+{
+}
+
+bool ScriptStreamerThread::canPostTask(ScriptStreamer::Type scriptType) const
+{
+    ASSERT(isMainThread());
+    MutexLocker locker(m_mutex);
+    size_t availableThreads = scriptType == ScriptStreamer::ParsingBlocking ? m_maximumThreads : m_maximumThreads - 1;
+    return m_runningTasks < availableThreads;
+}
+
 void ScriptStreamerThread::postTask(std::unique_ptr<CrossThreadClosure> task)
 {
     ASSERT(isMainThread());
     MutexLocker locker(m_mutex);
-    ASSERT(!m_runningTask);
-    m_runningTask = true;
-    platformThread().getWebTaskRunner()->postTask(BLINK_FROM_HERE, std::move(task));
+    ASSERT(m_runningTasks < m_maximumThreads);
+    ++m_runningTasks;
+    takeIdleThread().getWebTaskRunner()->postTask(BLINK_FROM_HERE, std::move(task));
 }
 
 void ScriptStreamerThread::taskDone()
 {
     MutexLocker locker(m_mutex);
-    ASSERT(m_runningTask);
-    m_runningTask = false;
+    ASSERT(m_runningTasks);
+    --m_runningTasks;
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+        if (m_threads[i]->isCurrentThread()) {
+            ASSERT(m_threadIsBusy[i]);
+            m_threadIsBusy[i] = false;
+            return;
+        }
+    }
+    ASSERT_NOT_REACHED();
 }
 
-WebThread& ScriptStreamerThread::platformThread()
+WebThread& ScriptStreamerThread::takeIdleThread()
 {
-    if (!isRunning())
-        m_thread = wrapUnique(Platform::current()->createThread("ScriptStreamerThread"));
-    return *m_thread;
+    size_t index = m_threadIsBusy.find(false);
+    if (index == kNotFound) {
+        index = m_threads.size();
+        m_threads.append(wrapUnique(Platform::current()->createThread("ScriptStreamerThread")));
+        m_threadIsBusy.append(false);
+    }
+    m_threadIsBusy[index] = true;
+    return *m_threads[index];
 }
 
 void ScriptStreamerThread::runScriptStreamingTask(std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask> task, ScriptStreamer* streamer)
 {
+    TRACE_EVENT_ASYNC_END0("v8", "v8.parseOnBackgroundWaiting", streamer);
     TRACE_EVENT1("v8,devtools.timeline", "v8.parseOnBackground", "data", InspectorParseScriptEvent::data(streamer->scriptResourceIdentifier(), streamer->scriptURLString()));
     // Running the task can and will block: SourceStream::GetSomeData will get
     // called and it will block and wait for data from the network.
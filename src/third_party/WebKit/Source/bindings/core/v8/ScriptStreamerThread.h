@@ -5,18 +5,20 @@
 #ifndef ScriptStreamerThread_h
 #define ScriptStreamerThread_h
 
+#include "bindings/core/v8/ScriptStreamer.h"
 #include "core/CoreExport.h"
 #include "platform/TaskSynchronizer.h"
 #include "public/platform/WebThread.h"
 #include "wtf/Functional.h"
+#include "wtf/Vector.h"
 #include <memory>
 #include <v8.h>
 
 namespace blink {
 
-class ScriptStreamer;
-
-// A singleton thread for running background tasks for script streaming.
+// A singleton pool of threads for running background tasks for script
+// streaming. A task can block and wait for data from the network, so each task
+// runs on a thread of its own; tasks are never queued behind each other.
 class CORE_EXPORT ScriptStreamerThread {
     USING_FAST_MALLOC(ScriptStreamerThread);
     WTF_MAKE_NONCOPYABLE(ScriptStreamerThread);
@@ -25,12 +27,17 @@ public:
     static void shutdown();
     static ScriptStreamerThread* shared();
 
+    // Returns true if a thread is free for streaming a script of the given
+    // type. The last thread is kept for parser-blocking scripts, so that async
+    // and deferred scripts can not delay them.
+    bool canPostTask(ScriptStreamer::Type) const;
+
     void postTask(std::unique_ptr<CrossThreadClosure>);
 
     bool isRunningTask() const
     {
         MutexLocker locker(m_mutex);
-        return m_runningTask;
+        return m_runningTasks;
     }
 
     void taskDone();
@@ -38,21 +45,16 @@ public:
     static void runScriptStreamingTask(std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask>, ScriptStreamer*);
 
 private:
-    ScriptStreamerThread()
-        : m_runningTask(false) { }
-
-    bool isRunning() const
-    {
-        return !!m_thread;
-    }
+    ScriptStreamerThread();
 
-    WebThread& platformThread();
+    // Returns an idle thread, creating it if needed, and marks it busy.
+    WebThread& takeIdleThread();
 
-    // At the moment, we only use one thread, so we can only stream one script
-    // at a time. FIXME: Use a thread pool and stream multiple scripts.
-    std::unique_ptr<WebThread> m_thread;
-    bool m_runningTask;
-    mutable Mutex m_mutex; // Guards m_runningTask.
+    const size_t m_maximumThreads;
+    Vector<std::unique_ptr<WebThread>> m_threads;
+    Vector<bool> m_threadIsBusy;
+    size_t m_runningTasks;
+    mutable Mutex m_mutex; // Guards m_threads, m_threadIsBusy and m_runningTasks.
 };
 
 } // namespace blink
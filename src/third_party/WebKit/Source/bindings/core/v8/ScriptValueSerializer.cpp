@@ -406,8 +406,13 @@ String SerializedScriptValueWriter::takeWireString()
 {
     static_assert(sizeof(BufferValueType) == 2, "BufferValueType should be 2 bytes");
     fillHole();
-    ASSERT((m_position + 1) / sizeof(BufferValueType) <= m_buffer.size());
-    return String(m_buffer.data(), (m_position + 1) / sizeof(BufferValueType));
+    unsigned length = (m_position + 1) / sizeof(BufferValueType);
+    ASSERT(length <= m_buffer.length());
+    if (!length)
+        return String();
+    m_buffer.shrink(length);
+    m_position = 0;
+    return String::adopt(m_buffer);
 }
 
 void SerializedScriptValueWriter::writeReferenceCount(uint32_t numberOfReferences)
@@ -547,7 +552,13 @@ void SerializedScriptValueWriter::append(const uint8_t* data, int length)
 void SerializedScriptValueWriter::ensureSpace(unsigned extra)
 {
     static_assert(sizeof(BufferValueType) == 2, "BufferValueType should be 2 bytes");
-    m_buffer.resize((m_position + extra + 1) / sizeof(BufferValueType)); // "+ 1" to round up.
+    unsigned neededLength = (m_position + extra + 1) / sizeof(BufferValueType); // "+ 1" to round up.
+    unsigned length = m_buffer.length();
+    if (neededLength <= length)
+        return;
+    // Grow geometrically, like Vector, so that many small appends stay
+    // amortized linear.
+    m_buffer.resize(std::max(neededLength, std::max(16u, length + length / 4 + 1)));
 }
 
 void SerializedScriptValueWriter::fillHole()
@@ -561,7 +572,7 @@ void SerializedScriptValueWriter::fillHole()
 
 uint8_t* SerializedScriptValueWriter::byteAt(int position)
 {
-    return reinterpret_cast<uint8_t*>(m_buffer.data()) + position;
+    return reinterpret_cast<uint8_t*>(m_buffer.characters()) + position;
 }
 
 int SerializedScriptValueWriter::v8StringWriteOptions()
@@ -12,6 +12,7 @@
 #include "wtf/HashMap.h"
 #include "wtf/Noncopyable.h"
 #include "wtf/Vector.h"
+#include "wtf/text/StringBuffer.h"
 #include "wtf/text/WTFString.h"
 #include "wtf/typed_arrays/ArrayBufferContents.h"
 #include <v8.h>
@@ -194,7 +195,10 @@ protected:
     int v8StringWriteOptions();
 
 private:
-    Vector<BufferValueType> m_buffer;
+    // The wire string is written in place, so that takeWireString() can
+    // adopt it instead of copying what may be megabytes of ArrayBuffer
+    // contents. Its length is the capacity; m_position is the size in bytes.
+    StringBuffer<BufferValueType> m_buffer;
     unsigned m_position;
 };
 
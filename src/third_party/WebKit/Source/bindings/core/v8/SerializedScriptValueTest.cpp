@@ -7,8 +7,10 @@
 #include "bindings/core/v8/ExceptionStatePlaceholder.h"
 #include "bindings/core/v8/SerializedScriptValueFactory.h"
 #include "bindings/core/v8/V8Binding.h"
+#include "bindings/core/v8/V8ArrayBuffer.h"
 #include "bindings/core/v8/V8BindingForTesting.h"
 #include "bindings/core/v8/V8File.h"
+#include "core/dom/DOMArrayBuffer.h"
 #include "core/fileapi/File.h"
 #include "platform/testing/UnitTestHelpers.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -58,4 +60,33 @@ TEST(SerializedScriptValueTest, FileConstructorFile)
     EXPECT_EQ("hello.txt", file->name());
 }
 
+TEST(SerializedScriptValueTest, LargeArrayBufferAndStrings)
+{
+    V8TestingScope scope;
+    const unsigned byteLength = 1024 * 1024 + 1;
+    DOMArrayBuffer* originalBuffer = DOMArrayBuffer::create(byteLength, 1);
+    uint8_t* originalData = static_cast<uint8_t*>(originalBuffer->data());
+    for (unsigned i = 0; i < byteLength; ++i)
+        originalData[i] = static_cast<uint8_t>(i * 7);
+
+    // An odd-length one-byte string after the buffer leaves the writer at an
+    // odd position, so the last UChar of the wire string is half padding.
+    v8::Local<v8::Array> v8OriginalArray = v8::Array::New(scope.isolate(), 2);
+    v8OriginalArray->Set(scope.context(), 0, toV8(originalBuffer, scope.context()->Global(), scope.isolate())).FromJust();
+    v8OriginalArray->Set(scope.context(), 1, v8String(scope.isolate(), "abc")).FromJust();
+    RefPtr<SerializedScriptValue> serializedScriptValue =
+        SerializedScriptValue::serialize(scope.isolate(), v8OriginalArray, nullptr, nullptr, ASSERT_NO_EXCEPTION);
+    EXPECT_GT(serializedScriptValue->toWireString().length(), byteLength / 2);
+    v8::Local<v8::Value> v8Array = serializedScriptValue->deserialize(scope.isolate());
+
+    ASSERT_TRUE(v8Array->IsArray());
+    v8::Local<v8::Object> array = v8::Local<v8::Object>::Cast(v8Array);
+    v8::Local<v8::Value> v8Buffer = array->Get(scope.context(), 0).ToLocalChecked();
+    ASSERT_TRUE(V8ArrayBuffer::hasInstance(v8Buffer, scope.isolate()));
+    DOMArrayBuffer* buffer = V8ArrayBuffer::toImpl(v8::Local<v8::Object>::Cast(v8Buffer));
+    ASSERT_EQ(byteLength, buffer->byteLength());
+    EXPECT_EQ(0, memcmp(originalData, buffer->data(), byteLength));
+    EXPECT_EQ("abc", toCoreString(array->Get(scope.context(), 1).ToLocalChecked().As<v8::String>()));
+}
+
 } // namespace blink
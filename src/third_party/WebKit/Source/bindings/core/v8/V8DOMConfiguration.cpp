@@ -53,7 +53,21 @@ void installAttributeInternal(v8::Isolate* isolate, v8::Local<v8::ObjectTemplate
     }
     v8::Local<v8::Value> data = v8::External::New(isolate, const_cast<WrapperTypeInfo*>(attribute.data));
 
+    // Interface objects, e.g. the hundreds of constructors on the global
+    // object, are plain data properties once created. Let V8 replace them
+    // with one on first access, so that later accesses don't call back.
+    bool isLazyDataProperty = getter == v8ConstructorAttributeGetter && attribute.settings == v8::DEFAULT;
+
     DCHECK(attribute.propertyLocationConfiguration);
+    if (isLazyDataProperty) {
+        if (attribute.propertyLocationConfiguration & V8DOMConfiguration::OnInstance)
+            instanceTemplate->SetLazyDataProperty(name, getter, data, static_cast<v8::PropertyAttribute>(attribute.attribute));
+        if (attribute.propertyLocationConfiguration & V8DOMConfiguration::OnPrototype)
+            prototypeTemplate->SetLazyDataProperty(name, getter, data, static_cast<v8::PropertyAttribute>(attribute.attribute));
+        if (attribute.propertyLocationConfiguration & V8DOMConfiguration::OnInterface)
+            NOTREACHED();
+        return;
+    }
     if (attribute.propertyLocationConfiguration & V8DOMConfiguration::OnInstance)
         instanceTemplate->SetNativeDataProperty(name, getter, setter, data, static_cast<v8::PropertyAttribute>(attribute.attribute), v8::Local<v8::AccessorSignature>(), static_cast<v8::AccessControl>(attribute.settings));
     if (attribute.propertyLocationConfiguration & V8DOMConfiguration::OnPrototype)
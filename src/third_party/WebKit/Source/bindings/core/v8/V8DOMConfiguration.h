@@ -64,6 +64,8 @@ public:
 
     // AttributeConfiguration translates into calls to SetNativeDataProperty() on either
     // the instance or the prototype ObjectTemplate, based on |instanceOrPrototypeConfiguration|.
+    // Interface objects (|getter| is v8ConstructorAttributeGetter) are installed
+    // with SetLazyDataProperty() instead.
     struct AttributeConfiguration {
         AttributeConfiguration& operator=(const AttributeConfiguration&) = delete;
         DISALLOW_NEW();
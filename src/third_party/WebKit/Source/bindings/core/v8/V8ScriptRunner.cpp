@@ -40,8 +40,10 @@
 #include "platform/Histogram.h"
 #include "platform/ScriptForbiddenScope.h"
 #include "platform/TraceEvent.h"
+#include "platform/weborigin/SecurityOrigin.h"
 #include "public/platform/Platform.h"
 #include "wtf/CurrentTime.h"
+#include "wtf/MainThread.h"
 
 #if OS(WIN)
 #include <malloc.h>
@@ -207,6 +209,46 @@ unsigned cacheTag(CacheTagKind kind, CachedMetadataHandler* cacheHandler)
 }
 
 // Check previously stored timestamp.
+const int minimalCodeLengthForCaching = 1024;
+
+// Keeps the metadata of a script without a resource in memory, the way
+// Resource::CachedMetadataHandlerImpl does for CacheLocally.
+class InlineScriptCacheHandler final : public CachedMetadataHandler {
+public:
+    static InlineScriptCacheHandler* create()
+    {
+        return new InlineScriptCacheHandler;
+    }
+
+    void setCachedMetadata(unsigned dataTypeID, const char* data, size_t size, CacheType) override
+    {
+        m_cachedMetadata = CachedMetadata::create(dataTypeID, data, size);
+    }
+
+    void clearCachedMetadata(CacheType) override
+    {
+        m_cachedMetadata.clear();
+    }
+
+    CachedMetadata* cachedMetadata(unsigned dataTypeID) const override
+    {
+        if (!m_cachedMetadata || m_cachedMetadata->dataTypeID() != dataTypeID)
+            return nullptr;
+        return m_cachedMetadata.get();
+    }
+
+    // The source is already decoded.
+    String encoding() const override
+    {
+        return emptyString();
+    }
+
+private:
+    InlineScriptCacheHandler() { }
+
+    RefPtr<CachedMetadata> m_cachedMetadata;
+};
+
 bool isResourceHotForCaching(CachedMetadataHandler* cacheHandler, int hotHours)
 {
     const double cacheWithinSeconds = hotHours * 60 * 60;
@@ -289,7 +331,6 @@ std::unique_ptr<CompileFn> bind(const A&... args)
 // cacheOptions.
 std::unique_ptr<CompileFn> selectCompileFunction(V8CacheOptions cacheOptions, CachedMetadataHandler* cacheHandler, v8::Local<v8::String> code, V8CompileHistogram::Cacheability cacheabilityIfNoHandler, bool isLocalFile)
 {
-    static const int minimalCodeLength = 1024;
     static const int hotHours = 72;
 
     // Caching is not available in this case.
@@ -301,7 +342,7 @@ std::unique_ptr<CompileFn> selectCompileFunction(V8CacheOptions cacheOptions, Ca
 
     // Caching is not worthwhile for small scripts.  Do not use caching
     // unless explicitly expected, indicated by the cache option.
-    if (code->Length() < minimalCodeLength)
+    if (code->Length() < minimalCodeLengthForCaching)
         return bind(compileWithoutOptions, V8CompileHistogram::Cacheable);
 
     // The cacheOptions will guide our strategy:
@@ -368,7 +409,12 @@ v8::MaybeLocal<v8::Script> V8ScriptRunner::compileScript(const ScriptSourceCode&
         V8ThrowException::throwGeneralError(isolate, "Source file too large.");
         return v8::Local<v8::Script>();
     }
-    return compileScript(v8String(isolate, source.source()), source.url(), source.sourceMapUrl(), source.startPosition(), isolate, source.resource(), source.streamer(), source.resource() ? source.resource()->cacheHandler() : nullptr, accessControlStatus, cacheOptions);
+    CachedMetadataHandler* cacheHandler = nullptr;
+    if (source.resource())
+        cacheHandler = source.resource()->cacheHandler();
+    else if (cacheOptions != V8CacheOptionsNone)
+        cacheHandler = inlineScriptCacheHandler(source, isolate);
+    return compileScript(v8String(isolate, source.source()), source.url(), source.sourceMapUrl(), source.startPosition(), isolate, source.resource(), source.streamer(), cacheHandler, accessControlStatus, cacheOptions);
 }
 
 v8::MaybeLocal<v8::Script> V8ScriptRunner::compileScript(const CompressibleString& code, const String& fileName, const String& sourceMapUrl, const TextPosition& textPosition, v8::Isolate* isolate, CachedMetadataHandler* cacheMetadataHandler, AccessControlStatus accessControlStatus, V8CacheOptions v8CacheOptions)
@@ -603,4 +649,42 @@ void V8ScriptRunner::setCacheTimeStamp(CachedMetadataHandler* cacheHandler)
     cacheHandler->setCachedMetadata(tag, reinterpret_cast<char*>(&now), sizeof(now), CachedMetadataHandler::SendToPlatform);
 }
 
+CachedMetadataHandler* V8ScriptRunner::inlineScriptCacheHandler(const ScriptSourceCode& source, v8::Isolate* isolate)
+{
+    static const unsigned maximumInlineScriptCacheSize = 64;
+
+    if (!isMainThread() || source.source().length() < static_cast<unsigned>(minimalCodeLengthForCaching) || !isolate->InContext())
+        return nullptr;
+    ExecutionContext* executionContext = currentExecutionContext(isolate);
+    if (!executionContext || !executionContext->getSecurityOrigin() || executionContext->getSecurityOrigin()->isUnique())
+        return nullptr;
+
+    // A hash collision only costs a rejected code cache, as V8 checks the
+    // source when consuming it.
+    String key = executionContext->getSecurityOrigin()->toString() + "\n" + String::number(StringHash::hash(source.source().toString()));
+
+    using InlineScriptCache = HeapHashMap<String, Member<CachedMetadataHandler>>;
+    DEFINE_STATIC_LOCAL(InlineScriptCache, inlineScriptCache, (new InlineScriptCache));
+
+    enum InlineScriptCacheLookup {
+        InlineScriptCacheMiss,
+        InlineScriptCacheSourceSeen,
+        InlineScriptCacheCodeHit,
+        InlineScriptCacheLookupMax
+    };
+    DEFINE_STATIC_LOCAL(EnumerationHistogram, lookupHistogram, ("V8.InlineScriptCacheLookup", InlineScriptCacheLookupMax));
+
+    InlineScriptCache::iterator it = inlineScriptCache.find(key);
+    if (it != inlineScriptCache.end()) {
+        CachedMetadataHandler* cacheHandler = it->value;
+        lookupHistogram.count(cacheHandler->cachedMetadata(tagForCodeCache(cacheHandler)) ? InlineScriptCacheCodeHit : InlineScriptCacheSourceSeen);
+        return cacheHandler;
+    }
+
+    lookupHistogram.count(InlineScriptCacheMiss);
+    if (inlineScriptCache.size() == maximumInlineScriptCacheSize)
+        inlineScriptCache.remove(inlineScriptCache.begin());
+    return inlineScriptCache.add(key, InlineScriptCacheHandler::create()).storedValue->value;
+}
+
 } // namespace blink
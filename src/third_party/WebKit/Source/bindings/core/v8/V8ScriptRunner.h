@@ -73,6 +73,11 @@ public:
     static unsigned tagForCodeCache(CachedMetadataHandler*);
     static void setCacheTimeStamp(CachedMetadataHandler*);
 
+    // Returns the in-memory cache handler shared by the scripts without a
+    // resource, e.g. inline scripts, that have the same source and origin as
+    // the given one, or null if the script can not be cached this way.
+    static CachedMetadataHandler* inlineScriptCacheHandler(const ScriptSourceCode&, v8::Isolate*);
+
 
     // Utiltiies for calling functions added to the V8 extras binding object.
 
@@ -4,11 +4,14 @@
 
 #include "bindings/core/v8/V8ScriptRunner.h"
 
+#include "bindings/core/v8/ScriptSourceCode.h"
 #include "bindings/core/v8/V8Binding.h"
 #include "bindings/core/v8/V8BindingForTesting.h"
 #include "core/fetch/CachedMetadataHandler.h"
+#include "core/dom/Document.h"
 #include "core/fetch/ScriptResource.h"
 #include "platform/heap/Handle.h"
+#include "platform/weborigin/SecurityOrigin.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include <v8.h>
 
@@ -139,6 +142,27 @@ TEST_F(V8ScriptRunnerTest, codeOption)
     EXPECT_FALSE(cacheHandler()->cachedMetadata(tagForCodeCache(anotherResource->cacheHandler())));
 }
 
+TEST_F(V8ScriptRunnerTest, inlineScriptCache)
+{
+    V8TestingScope scope;
+    scope.document().setSecurityOrigin(SecurityOrigin::createFromString("http://example.test"));
+    ScriptSourceCode source(code());
+    CachedMetadataHandler* cacheHandler = V8ScriptRunner::inlineScriptCacheHandler(source, scope.isolate());
+    ASSERT_TRUE(cacheHandler);
+    EXPECT_EQ(cacheHandler, V8ScriptRunner::inlineScriptCacheHandler(ScriptSourceCode(code()), scope.isolate()));
+
+    // The first compile only marks the script as seen, the second one
+    // produces the code cache.
+    EXPECT_FALSE(V8ScriptRunner::compileScript(source, scope.isolate(), SharableCrossOrigin, V8CacheOptionsCode).IsEmpty());
+    EXPECT_FALSE(cacheHandler->cachedMetadata(tagForCodeCache(cacheHandler)));
+    EXPECT_FALSE(V8ScriptRunner::compileScript(source, scope.isolate(), SharableCrossOrigin, V8CacheOptionsCode).IsEmpty());
+    EXPECT_TRUE(cacheHandler->cachedMetadata(tagForCodeCache(cacheHandler)));
+    EXPECT_FALSE(V8ScriptRunner::compileScript(source, scope.isolate(), SharableCrossOrigin, V8CacheOptionsCode).IsEmpty());
+
+    // Small scripts are not worth caching.
+    EXPECT_FALSE(V8ScriptRunner::inlineScriptCacheHandler(ScriptSourceCode(String("a = 1;")), scope.isolate()));
+}
+
 } // namespace
 
 } // namespace blink
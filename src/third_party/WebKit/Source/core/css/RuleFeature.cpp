@@ -42,6 +42,7 @@
 #include "core/dom/Node.h"
 #include "core/inspector/InspectorTraceEvents.h"
 #include "wtf/BitVector.h"
+#include <algorithm>
 
 namespace blink {
 
@@ -261,6 +262,55 @@ RuleFeatureSet::~RuleFeatureSet()
 {
 }
 
+void RuleFeatureSet::InvalidationSetFeatures::add(const InvalidationSetFeatures& other)
+{
+    classes.appendVector(other.classes);
+    attributes.appendVector(other.attributes);
+    ids.appendVector(other.ids);
+    tagNames.appendVector(other.tagNames);
+    customPseudoElement |= other.customPseudoElement;
+    addFlags(other);
+}
+
+void RuleFeatureSet::InvalidationSetFeatures::addFlags(const InvalidationSetFeatures& other)
+{
+    maxDirectAdjacentSelectors = std::min(maxDirectAdjacentSelectors, other.maxDirectAdjacentSelectors);
+    hasBeforeOrAfter |= other.hasBeforeOrAfter;
+    treeBoundaryCrossing |= other.treeBoundaryCrossing;
+    adjacent |= other.adjacent;
+    insertionPointCrossing |= other.insertionPointCrossing;
+    forceSubtree |= other.forceSubtree;
+    contentPseudoCrossing |= other.contentPseudoCrossing;
+    invalidatesSlotted |= other.invalidatesSlotted;
+}
+
+bool RuleFeatureSet::InvalidationSetFeatures::hasFeatures() const
+{
+    return !classes.isEmpty() || !attributes.isEmpty() || !ids.isEmpty() || !tagNames.isEmpty() || customPseudoElement;
+}
+
+void RuleFeatureSet::InvalidationSetFeatures::narrowToMostSelectiveFeature()
+{
+    if (!ids.isEmpty()) {
+        ids.shrink(1);
+        classes.clear();
+        attributes.clear();
+        tagNames.clear();
+    } else if (!classes.isEmpty()) {
+        classes.shrink(1);
+        attributes.clear();
+        tagNames.clear();
+    } else if (!attributes.isEmpty()) {
+        attributes.shrink(1);
+        tagNames.clear();
+    } else if (!tagNames.isEmpty()) {
+        tagNames.shrink(1);
+    } else {
+        return;
+    }
+    customPseudoElement = false;
+}
+
 ALWAYS_INLINE InvalidationSet& RuleFeatureSet::ensureClassInvalidationSet(const AtomicString& className, InvalidationType type)
 {
     return ensureInvalidationSet(m_classInvalidationSets, className, type);
@@ -284,11 +334,11 @@ ALWAYS_INLINE InvalidationSet& RuleFeatureSet::ensurePseudoInvalidationSet(CSSSe
 bool RuleFeatureSet::extractInvalidationSetFeature(const CSSSelector& selector, InvalidationSetFeatures& features)
 {
     if (selector.match() == CSSSelector::Tag && selector.tagQName().localName() != starAtom) {
-        features.tagName = selector.tagQName().localName();
+        features.tagNames.append(selector.tagQName().localName());
         return true;
     }
     if (selector.match() == CSSSelector::Id) {
-        features.id = selector.value();
+        features.ids.append(selector.value());
         return true;
     }
     if (selector.match() == CSSSelector::Class) {
@@ -407,10 +457,28 @@ void RuleFeatureSet::updateInvalidationSetsForContentAttribute(const RuleData& r
 std::pair<const CSSSelector*, RuleFeatureSet::UseFeaturesType>
 RuleFeatureSet::extractInvalidationSetFeatures(const CSSSelector& selector, InvalidationSetFeatures& features, PositionType position, CSSSelector::PseudoType pseudo)
 {
-    bool foundFeatures = false;
+    // Every simple selector in a compound has to match, so the most selective
+    // of their features is enough to find the elements to invalidate. The
+    // features of selector lists, like in :-webkit-any(), are alternatives, and
+    // are only needed if the compound has no feature of its own.
+    InvalidationSetFeatures compoundFeatures;
+    InvalidationSetFeatures listFeatures;
+    bool foundListFeatures = false;
+    auto addCompoundFeatures = [&features, &compoundFeatures, &listFeatures, &foundListFeatures]() {
+        if (!compoundFeatures.hasFeatures()) {
+            features.add(compoundFeatures);
+            features.add(listFeatures);
+            return foundListFeatures;
+        }
+        compoundFeatures.narrowToMostSelectiveFeature();
+        features.add(compoundFeatures);
+        features.addFlags(listFeatures);
+        return true;
+    };
+
     for (const CSSSelector* current = &selector; current; current = current->tagHistory()) {
         if (pseudo != CSSSelector::PseudoNot)
-            foundFeatures |= extractInvalidationSetFeature(*current, features);
+            extractInvalidationSetFeature(*current, compoundFeatures);
         // Initialize the entry in the invalidation set map, if supported.
         if (InvalidationSet* invalidationSet = invalidationSetForSelector(*current, InvalidateDescendants)) {
             if (position == Subject)
@@ -422,6 +490,7 @@ RuleFeatureSet::extractInvalidationSetFeatures(const CSSSelector& selector, Inva
                 // will make addFeaturesToInvalidationSets start marking invalidation
                 // sets for subtree recalc for features in the rightmost compound
                 // selector.
+                addCompoundFeatures();
                 return std::make_pair(&selector, ForceSubtree);
             }
             if (const CSSSelectorList* selectorList = current->selectorList()) {
@@ -433,22 +502,24 @@ RuleFeatureSet::extractInvalidationSetFeatures(const CSSSelector& selector, Inva
                 const CSSSelector* subSelector = selectorList->first();
                 bool allSubSelectorsHaveFeatures = !!subSelector;
                 for (; subSelector; subSelector = CSSSelectorList::next(*subSelector)) {
-                    auto result = extractInvalidationSetFeatures(*subSelector, features, position, current->getPseudoType());
+                    auto result = extractInvalidationSetFeatures(*subSelector, listFeatures, position, current->getPseudoType());
                     if (result.first) {
                         // A non-null selector return means the sub-selector contained a
                         // selector which requiresSubtreeInvalidation(). Return the rightmost
                         // selector to mark for subtree recalcs like above.
+                        addCompoundFeatures();
                         return std::make_pair(&selector, ForceSubtree);
                     }
                     allSubSelectorsHaveFeatures &= result.second == UseFeatures;
                 }
-                foundFeatures |= allSubSelectorsHaveFeatures;
+                foundListFeatures |= allSubSelectorsHaveFeatures;
             }
         }
 
         if (current->relation() == CSSSelector::SubSelector)
             continue;
 
+        bool foundFeatures = addCompoundFeatures();
         features.treeBoundaryCrossing = current->isShadowSelector();
         if (current->relationIsAffectedByPseudoContent()) {
             features.contentPseudoCrossing = true;
@@ -459,7 +530,7 @@ RuleFeatureSet::extractInvalidationSetFeatures(const CSSSelector& selector, Inva
             features.maxDirectAdjacentSelectors = 1;
         return std::make_pair(current->tagHistory(), foundFeatures ? UseFeatures : ForceSubtree);
     }
-    return std::make_pair(nullptr,  foundFeatures ? UseFeatures : ForceSubtree);
+    return std::make_pair(nullptr, addCompoundFeatures() ? UseFeatures : ForceSubtree);
 }
 
 // Add features extracted from the rightmost compound selector to descendant invalidation
@@ -484,10 +555,10 @@ void RuleFeatureSet::addFeaturesToInvalidationSet(InvalidationSet& invalidationS
     if (features.contentPseudoCrossing || features.forceSubtree)
         return;
 
-    if (!features.id.isEmpty())
-        invalidationSet.addId(features.id);
-    if (!features.tagName.isEmpty())
-        invalidationSet.addTagName(features.tagName);
+    for (const auto& id : features.ids)
+        invalidationSet.addId(id);
+    for (const auto& tagName : features.tagNames)
+        invalidationSet.addTagName(tagName);
     for (const auto& className : features.classes)
         invalidationSet.addClass(className);
     for (const auto& attribute : features.attributes)
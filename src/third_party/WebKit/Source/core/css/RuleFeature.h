@@ -148,10 +148,18 @@ private:
     struct InvalidationSetFeatures {
         DISALLOW_NEW();
 
+        void add(const InvalidationSetFeatures& other);
+        void addFlags(const InvalidationSetFeatures& other);
+        bool hasFeatures() const;
+        // Keeps only the most selective of the id, class, attribute and tag
+        // name features. Used for compound selectors, where each of them has
+        // to match.
+        void narrowToMostSelectiveFeature();
+
         Vector<AtomicString> classes;
         Vector<AtomicString> attributes;
-        AtomicString id;
-        AtomicString tagName;
+        Vector<AtomicString> ids;
+        Vector<AtomicString> tagNames;
         unsigned maxDirectAdjacentSelectors = UINT_MAX;
         bool customPseudoElement = false;
         bool hasBeforeOrAfter = false;
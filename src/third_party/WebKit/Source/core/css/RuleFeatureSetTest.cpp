@@ -85,6 +85,11 @@ public:
         return m_ruleFeatureSet->collectFeaturesFromRuleData(ruleData);
     }
 
+    Element& firstBodyChild() const
+    {
+        return *Traversal<HTMLElement>::firstChild(*m_document->body());
+    }
+
     void collectInvalidationSetsForClass(InvalidationLists& invalidationLists, const AtomicString& className) const
     {
         Element* element = Traversal<HTMLElement>::firstChild(*Traversal<HTMLElement>::firstChild(*m_document->body()));
@@ -351,6 +356,48 @@ TEST_F(RuleFeatureSetTest, attribute)
     expectAttributeInvalidation("d", invalidationLists.descendants);
 }
 
+TEST_F(RuleFeatureSetTest, compoundUsesMostSelectiveFeature)
+{
+    EXPECT_EQ(RuleFeatureSet::SelectorMayMatch, collectFeatures(".a b.c"));
+
+    InvalidationLists invalidationLists;
+    collectInvalidationSetsForClass(invalidationLists, "a");
+    expectClassInvalidation("c", invalidationLists.descendants);
+    // The <b> element does not have class c, so it can not match.
+    EXPECT_FALSE(invalidationLists.descendants[0]->invalidatesElement(firstBodyChild()));
+}
+
+TEST_F(RuleFeatureSetTest, compoundPrefersIdOverClass)
+{
+    EXPECT_EQ(RuleFeatureSet::SelectorMayMatch, collectFeatures(".a .b#c[d]"));
+
+    InvalidationLists invalidationLists;
+    collectInvalidationSetsForClass(invalidationLists, "a");
+    expectIdInvalidation("c", invalidationLists.descendants);
+}
+
+TEST_F(RuleFeatureSetTest, compoundFeatureOverAnyAlternatives)
+{
+    EXPECT_EQ(RuleFeatureSet::SelectorMayMatch, collectFeatures(".a .b:-webkit-any(.c, .d)"));
+
+    InvalidationLists invalidationLists;
+    collectInvalidationSetsForClass(invalidationLists, "a");
+    expectClassInvalidation("b", invalidationLists.descendants);
+}
+
+TEST_F(RuleFeatureSetTest, anyWithIds)
+{
+    EXPECT_EQ(RuleFeatureSet::SelectorMayMatch, collectFeatures(".a :-webkit-any(#b, #c)"));
+
+    InvalidationLists invalidationLists;
+    collectInvalidationSetsForClass(invalidationLists, "a");
+    ASSERT_EQ(1u, invalidationLists.descendants.size());
+    HashSet<AtomicString> ids = idSet(*invalidationLists.descendants[0]);
+    EXPECT_EQ(2u, ids.size());
+    EXPECT_TRUE(ids.contains("b"));
+    EXPECT_TRUE(ids.contains("c"));
+}
+
 TEST_F(RuleFeatureSetTest, pseudoClass)
 {
     EXPECT_EQ(RuleFeatureSet::SelectorMayMatch, collectFeatures(":valid"));
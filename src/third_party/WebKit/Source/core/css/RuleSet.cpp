@@ -302,6 +302,21 @@ void RuleSet::addRulesFromSheet(StyleSheetContents* sheet, const MediaQueryEvalu
     addChildRules(sheet->childRules(), medium, addRuleFlags);
 }
 
+static bool mediaQueryResultsChanged(const MediaQueryResultList& results, const MediaQueryEvaluator& medium)
+{
+    for (const auto& result : results) {
+        if (medium.eval(result->expression()) != result->result())
+            return true;
+    }
+    return false;
+}
+
+bool RuleSet::didMediaQueryResultsChange(const MediaQueryEvaluator& medium) const
+{
+    return mediaQueryResultsChanged(m_viewportDependentMediaQueryResults, medium)
+        || mediaQueryResultsChanged(m_deviceDependentMediaQueryResults, medium);
+}
+
 void RuleSet::addStyleRule(StyleRule* rule, AddRuleFlags addRuleFlags)
 {
     for (size_t selectorIndex = 0; selectorIndex != kNotFound; selectorIndex = rule->selectorList().indexOfNextSelectorAfter(selectorIndex))
@@ -160,6 +160,8 @@ public:
     const HeapVector<MinimalRuleData>& slottedPseudoElementRules() const { return m_slottedPseudoElementRules; }
     const MediaQueryResultList& viewportDependentMediaQueryResults() const { return m_viewportDependentMediaQueryResults; }
     const MediaQueryResultList& deviceDependentMediaQueryResults() const { return m_deviceDependentMediaQueryResults; }
+    // True if a media query evaluated while adding the rules has a different result for the given medium.
+    bool didMediaQueryResultsChange(const MediaQueryEvaluator&) const;
 
     unsigned ruleCount() const { return m_ruleCount; }
 
@@ -209,4 +209,20 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_HostContextAndClass)
     ASSERT_EQ(0u, rules->size());
 }
 
+TEST(RuleSetTest, DescendantSelectorIdentifierHashes_Attribute)
+{
+    CSSTestHelper helper;
+
+    helper.addCSSRules("[data-theme] .x { } [data-theme] + .y { }");
+    RuleSet& ruleSet = helper.ruleSet();
+    const TerminatedArray<RuleData>* descendantRules = ruleSet.classRules("x");
+    ASSERT_EQ(1u, descendantRules->size());
+    // The ancestor attribute selector can be used for fast rejection.
+    EXPECT_NE(0u, descendantRules->at(0).descendantSelectorIdentifierHashes()[0]);
+    const TerminatedArray<RuleData>* adjacentRules = ruleSet.classRules("y");
+    ASSERT_EQ(1u, adjacentRules->size());
+    // Siblings are not in the ancestor filter.
+    EXPECT_EQ(0u, adjacentRules->at(0).descendantSelectorIdentifierHashes()[0]);
+}
+
 } // namespace blink
@@ -35,7 +35,7 @@
 namespace blink {
 
 // Salt to separate otherwise identical string hashes so a class-selector like .article won't match <article> elements.
-enum { TagNameSalt = 13, IdAttributeSalt = 17, ClassAttributeSalt = 19 };
+enum { TagNameSalt = 13, IdAttributeSalt = 17, ClassAttributeSalt = 19, AttributeSalt = 23 };
 
 static inline void collectElementIdentifierHashes(const Element& element, Vector<unsigned, 4>& identifierHashes)
 {
@@ -48,6 +48,11 @@ static inline void collectElementIdentifierHashes(const Element& element, Vector
         for (size_t i = 0; i < count; ++i)
             identifierHashes.append(classNames[i].impl()->existingHash() * ClassAttributeSalt);
     }
+    // Attribute selectors match on the exact local name (see Attribute::matches), so
+    // ancestors can be filtered on the names alone. attributes() synchronizes lazy
+    // attributes, as SelectorChecker would when matching against them.
+    for (const auto& attribute : element.attributes())
+        identifierHashes.append(attribute.localName().impl()->existingHash() * AttributeSalt);
 }
 
 void SelectorFilter::pushParentStackFrame(Element& parent)
@@ -125,6 +130,15 @@ static inline void collectDescendantSelectorIdentifierHashes(const CSSSelector&
         if (selector.tagQName().localName() != starAtom)
             (*hash++) = selector.tagQName().localName().impl()->existingHash() * TagNameSalt;
         break;
+    case CSSSelector::AttributeExact:
+    case CSSSelector::AttributeSet:
+    case CSSSelector::AttributeList:
+    case CSSSelector::AttributeContain:
+    case CSSSelector::AttributeBegin:
+    case CSSSelector::AttributeEnd:
+    case CSSSelector::AttributeHyphen:
+        (*hash++) = selector.attribute().localName().impl()->existingHash() * AttributeSalt;
+        break;
     default:
         break;
     }
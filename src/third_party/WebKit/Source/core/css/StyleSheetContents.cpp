@@ -110,13 +110,6 @@ bool StyleSheetContents::isCacheableForResource() const
     // This would require dealing with multiple clients for load callbacks.
     if (!loadCompleted())
         return false;
-    // FIXME: StyleSheets with media queries can't be cached because their RuleSet
-    // is processed differently based off the media queries, which might resolve
-    // differently depending on the context of the parent CSSStyleSheet (e.g.
-    // if they are in differently sized iframes). Once RuleSets are media query
-    // agnostic, we can restore sharing of StyleSheetContents with medea queries.
-    if (m_hasMediaQueries)
-        return false;
     // FIXME: Support copying import rules.
     if (!m_importRules.isEmpty())
         return false;
@@ -344,7 +337,10 @@ void StyleSheetContents::parseAuthorStyleSheet(const CSSStyleSheetResource* cach
     }
 
     CSSParserContext context(parserContext(), UseCounter::getFrom(this));
-    CSSParser::parseSheet(context, this, sheetText);
+    if (CSSTokenizer::Scope* tokenizedSheetText = cachedStyleSheet->tokenizedSheetText(mimeTypeCheck))
+        CSSParser::parseSheet(context, this, *tokenizedSheetText);
+    else
+        CSSParser::parseSheet(context, this, sheetText);
 }
 
 void StyleSheetContents::parseString(const String& sheetText)
@@ -593,6 +589,11 @@ void StyleSheetContents::clearReferencedFromResource()
 
 RuleSet& StyleSheetContents::ensureRuleSet(const MediaQueryEvaluator& medium, AddRuleFlags addRuleFlags)
 {
+    // A sheet shared between documents can be evaluated against a different
+    // medium, e.g. in differently sized iframes. Build a RuleSet for this one
+    // and leave the old one to the resolvers that already use it.
+    if (m_ruleSet && m_ruleSet->didMediaQueryResultsChange(medium))
+        m_ruleSet.clear();
     if (!m_ruleSet) {
         m_ruleSet = RuleSet::create();
         m_ruleSet->addRulesFromSheet(this, medium, addRuleFlags);
@@ -4,7 +4,11 @@
 
 #include "core/css/StyleSheetContents.h"
 
+#include "core/MediaTypeNames.h"
 #include "core/css/CSSTestHelper.h"
+#include "core/css/MediaQueryEvaluator.h"
+#include "core/css/MediaValuesCached.h"
+#include "core/css/RuleSet.h"
 #include "core/css/parser/CSSParser.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -46,4 +50,43 @@ TEST(StyleSheetContentsTest, InsertFontFaceRule)
     EXPECT_TRUE(styleSheet->hasFontFaceRule());
 }
 
+static MediaQueryEvaluator* createEvaluator(double viewportWidth)
+{
+    MediaValuesCached::MediaValuesCachedData data;
+    data.viewportWidth = viewportWidth;
+    data.viewportHeight = 500;
+    data.deviceWidth = 1000;
+    data.deviceHeight = 500;
+    data.mediaType = MediaTypeNames::screen;
+    data.strictMode = true;
+    return new MediaQueryEvaluator(*MediaValuesCached::create(data));
+}
+
+TEST(StyleSheetContentsTest, RuleSetForDifferentMedium)
+{
+    CSSParserContext context(HTMLStandardMode, nullptr);
+
+    StyleSheetContents* styleSheet = StyleSheetContents::create(context);
+    styleSheet->parseString("@media (min-width: 600px) { .wide { color: pink } }");
+    EXPECT_TRUE(styleSheet->hasMediaQueries());
+
+    MediaQueryEvaluator* narrow = createEvaluator(500);
+    MediaQueryEvaluator* wide = createEvaluator(800);
+
+    RuleSet* narrowRuleSet = &styleSheet->ensureRuleSet(*narrow, RuleHasNoSpecialState);
+    narrowRuleSet->compactRulesIfNeeded();
+    EXPECT_FALSE(narrowRuleSet->didMediaQueryResultsChange(*narrow));
+    EXPECT_TRUE(narrowRuleSet->didMediaQueryResultsChange(*wide));
+    EXPECT_EQ(narrowRuleSet, &styleSheet->ensureRuleSet(*narrow, RuleHasNoSpecialState));
+    EXPECT_FALSE(narrowRuleSet->classRules("wide"));
+
+    // A sheet shared with a wider frame gets a RuleSet of its own.
+    RuleSet* wideRuleSet = &styleSheet->ensureRuleSet(*wide, RuleHasNoSpecialState);
+    wideRuleSet->compactRulesIfNeeded();
+    EXPECT_NE(narrowRuleSet, wideRuleSet);
+    ASSERT_TRUE(wideRuleSet->classRules("wide"));
+    EXPECT_EQ(1u, wideRuleSet->classRules("wide")->size());
+    EXPECT_FALSE(narrowRuleSet->classRules("wide"));
+}
+
 } // namespace blink
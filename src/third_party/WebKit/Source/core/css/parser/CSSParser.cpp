@@ -54,6 +54,11 @@ void CSSParser::parseSheet(const CSSParserContext& context, StyleSheetContents*
     return CSSParserImpl::parseStyleSheet(text, context, styleSheet);
 }
 
+void CSSParser::parseSheet(const CSSParserContext& context, StyleSheetContents* styleSheet, CSSTokenizer::Scope& tokenizedText)
+{
+    return CSSParserImpl::parseStyleSheet(tokenizedText, context, styleSheet);
+}
+
 void CSSParser::parseSheetForInspector(const CSSParserContext& context, StyleSheetContents* styleSheet, const String& text, CSSParserObserver& observer)
 {
     return CSSParserImpl::parseStyleSheetForInspector(text, context, styleSheet, observer);
@@ -9,6 +9,7 @@
 #include "core/CoreExport.h"
 #include "core/css/CSSValue.h"
 #include "core/css/parser/CSSParserMode.h"
+#include "core/css/parser/CSSTokenizer.h"
 #include "platform/graphics/Color.h"
 #include <memory>
 
@@ -32,6 +33,7 @@ public:
     // As well as regular rules, allows @import and @namespace but not @charset
     static StyleRuleBase* parseRule(const CSSParserContext&, StyleSheetContents*, const String&);
     static void parseSheet(const CSSParserContext&, StyleSheetContents*, const String&);
+    static void parseSheet(const CSSParserContext&, StyleSheetContents*, CSSTokenizer::Scope&);
     static CSSSelectorList parseSelector(const CSSParserContext&, StyleSheetContents*, const String&);
     static CSSSelectorList parsePageSelector(const CSSParserContext&, StyleSheetContents*, const String&);
     static bool parseDeclarationList(const CSSParserContext&, MutableStylePropertySet*, const String&);
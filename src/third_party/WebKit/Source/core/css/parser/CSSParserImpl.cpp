@@ -171,13 +171,7 @@ void CSSParserImpl::parseStyleSheet(const String& string, const CSSParserContext
     TRACE_EVENT_END0("blink,blink_style", "CSSParserImpl::parseStyleSheet.tokenize");
 
     TRACE_EVENT_BEGIN0("blink,blink_style", "CSSParserImpl::parseStyleSheet.parse");
-    CSSParserImpl parser(context, styleSheet);
-    bool firstRuleValid = parser.consumeRuleList(scope.tokenRange(), TopLevelRuleList, [&styleSheet](StyleRuleBase* rule) {
-        if (rule->isCharsetRule())
-            return;
-        styleSheet->parserAppendRule(rule);
-    });
-    styleSheet->setHasSyntacticallyValidCSSHeader(firstRuleValid);
+    consumeStyleSheet(scope.tokenRange(), context, styleSheet);
     TRACE_EVENT_END0("blink,blink_style", "CSSParserImpl::parseStyleSheet.parse");
 
     TRACE_EVENT_END2(
@@ -186,6 +180,26 @@ void CSSParserImpl::parseStyleSheet(const String& string, const CSSParserContext
         "length", string.length());
 }
 
+void CSSParserImpl::parseStyleSheet(CSSTokenizer::Scope& scope, const CSSParserContext& context, StyleSheetContents* styleSheet)
+{
+    TRACE_EVENT2(
+        "blink,blink_style", "CSSParserImpl::parseStyleSheet.parse",
+        "baseUrl", context.baseURL().getString().utf8(),
+        "tokenCount", scope.tokenCount());
+    consumeStyleSheet(scope.tokenRange(), context, styleSheet);
+}
+
+void CSSParserImpl::consumeStyleSheet(CSSParserTokenRange range, const CSSParserContext& context, StyleSheetContents* styleSheet)
+{
+    CSSParserImpl parser(context, styleSheet);
+    bool firstRuleValid = parser.consumeRuleList(range, TopLevelRuleList, [&styleSheet](StyleRuleBase* rule) {
+        if (rule->isCharsetRule())
+            return;
+        styleSheet->parserAppendRule(rule);
+    });
+    styleSheet->setHasSyntacticallyValidCSSHeader(firstRuleValid);
+}
+
 CSSSelectorList CSSParserImpl::parsePageSelector(CSSParserTokenRange range, StyleSheetContents* styleSheet)
 {
     // We only support a small subset of the css-page spec.
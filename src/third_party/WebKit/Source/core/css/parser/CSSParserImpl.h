@@ -10,6 +10,7 @@
 #include "core/css/CSSPropertySourceData.h"
 #include "core/css/parser/CSSParserMode.h"
 #include "core/css/parser/CSSParserTokenRange.h"
+#include "core/css/parser/CSSTokenizer.h"
 #include "platform/heap/Handle.h"
 #include "wtf/Vector.h"
 #include "wtf/text/WTFString.h"
@@ -63,6 +64,7 @@ public:
     static bool parseDeclarationList(MutableStylePropertySet*, const String&, const CSSParserContext&);
     static StyleRuleBase* parseRule(const String&, const CSSParserContext&, StyleSheetContents*, AllowedRulesType);
     static void parseStyleSheet(const String&, const CSSParserContext&, StyleSheetContents*);
+    static void parseStyleSheet(CSSTokenizer::Scope&, const CSSParserContext&, StyleSheetContents*);
     static CSSSelectorList parsePageSelector(CSSParserTokenRange, StyleSheetContents*);
 
     static ImmutableStylePropertySet* parseCustomPropertySet(CSSParserTokenRange);
@@ -81,6 +83,8 @@ private:
         KeyframesRuleList
     };
 
+    static void consumeStyleSheet(CSSParserTokenRange, const CSSParserContext&, StyleSheetContents*);
+
     // Returns whether the first encountered rule was valid
     template<typename T>
     bool consumeRuleList(CSSParserTokenRange, RuleListType, T callback);
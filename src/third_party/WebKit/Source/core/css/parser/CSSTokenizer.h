@@ -24,8 +24,11 @@ class CORE_EXPORT CSSTokenizer {
     WTF_MAKE_NONCOPYABLE(CSSTokenizer);
     USING_FAST_MALLOC(CSSTokenizer);
 public:
+    // Scopes can be built on a background thread from an isolated copy of
+    // the string and handed over to the main thread to be parsed there.
     class CORE_EXPORT Scope {
-        DISALLOW_NEW();
+        USING_FAST_MALLOC(Scope);
+        WTF_MAKE_NONCOPYABLE(Scope);
     public:
         Scope(const String&);
         Scope(const String&, CSSParserObserverWrapper&); // For the inspector
@@ -84,7 +84,8 @@ void ScopedStyleResolver::appendCSSStyleSheet(CSSStyleSheet& cssSheet, const Med
     m_authorStyleSheets.append(&cssSheet);
     StyleSheetContents* sheet = cssSheet.contents();
     AddRuleFlags addRuleFlags = treeScope().document().getSecurityOrigin()->canRequest(sheet->baseURL()) ? RuleHasDocumentSecurityOrigin : RuleHasNoSpecialState;
-    const RuleSet& ruleSet = sheet->ensureRuleSet(medium, addRuleFlags);
+    RuleSet& ruleSet = sheet->ensureRuleSet(medium, addRuleFlags);
+    m_authorRuleSets.append(&ruleSet);
 
     addKeyframeRules(ruleSet);
     addFontFaceRules(ruleSet);
@@ -99,7 +100,7 @@ void ScopedStyleResolver::collectFeaturesTo(RuleFeatureSet& features, HeapHashSe
         ASSERT(m_authorStyleSheets[i]->ownerNode());
         StyleSheetContents* contents = m_authorStyleSheets[i]->contents();
         if (contents->hasOneClient() || visitedSharedStyleSheetContents.add(contents).isNewEntry)
-            features.add(contents->ruleSet().features());
+            features.add(m_authorRuleSets[i]->features());
     }
 
     if (!m_treeBoundaryCrossingRuleSet)
@@ -112,6 +113,7 @@ void ScopedStyleResolver::collectFeaturesTo(RuleFeatureSet& features, HeapHashSe
 void ScopedStyleResolver::resetAuthorStyle()
 {
     m_authorStyleSheets.clear();
+    m_authorRuleSets.clear();
     m_keyframesRuleMap.clear();
     m_treeBoundaryCrossingRuleSet = nullptr;
     m_hasDeepOrShadowSelector = false;
@@ -148,7 +150,7 @@ void ScopedStyleResolver::collectMatchingAuthorRules(ElementRuleCollector& colle
 {
     for (size_t i = 0; i < m_authorStyleSheets.size(); ++i) {
         ASSERT(m_authorStyleSheets[i]->ownerNode());
-        MatchRequest matchRequest(&m_authorStyleSheets[i]->contents()->ruleSet(), &m_scope->rootNode(), m_authorStyleSheets[i], i);
+        MatchRequest matchRequest(m_authorRuleSets[i], &m_scope->rootNode(), m_authorStyleSheets[i], i);
         collector.collectMatchingRules(matchRequest, cascadeOrder);
     }
 }
@@ -157,7 +159,7 @@ void ScopedStyleResolver::collectMatchingShadowHostRules(ElementRuleCollector& c
 {
     for (size_t i = 0; i < m_authorStyleSheets.size(); ++i) {
         ASSERT(m_authorStyleSheets[i]->ownerNode());
-        MatchRequest matchRequest(&m_authorStyleSheets[i]->contents()->ruleSet(), &m_scope->rootNode(), m_authorStyleSheets[i], i);
+        MatchRequest matchRequest(m_authorRuleSets[i], &m_scope->rootNode(), m_authorStyleSheets[i], i);
         collector.collectMatchingShadowHostRules(matchRequest, cascadeOrder);
     }
 }
@@ -178,7 +180,7 @@ void ScopedStyleResolver::matchPageRules(PageRuleCollector& collector)
     // Only consider the global author RuleSet for @page rules, as per the HTML5 spec.
     ASSERT(m_scope->rootNode().isDocumentNode());
     for (size_t i = 0; i < m_authorStyleSheets.size(); ++i)
-        collector.matchPageRules(&m_authorStyleSheets[i]->contents()->ruleSet());
+        collector.matchPageRules(m_authorRuleSets[i]);
 }
 
 void ScopedStyleResolver::collectViewportRulesTo(ViewportStyleResolver* resolver) const
@@ -186,13 +188,14 @@ void ScopedStyleResolver::collectViewportRulesTo(ViewportStyleResolver* resolver
     if (!m_scope->rootNode().isDocumentNode())
         return;
     for (size_t i = 0; i < m_authorStyleSheets.size(); ++i)
-        resolver->collectViewportRules(&m_authorStyleSheets[i]->contents()->ruleSet(), ViewportStyleResolver::AuthorOrigin);
+        resolver->collectViewportRules(m_authorRuleSets[i], ViewportStyleResolver::AuthorOrigin);
 }
 
 DEFINE_TRACE(ScopedStyleResolver)
 {
     visitor->trace(m_scope);
     visitor->trace(m_authorStyleSheets);
+    visitor->trace(m_authorRuleSets);
     visitor->trace(m_keyframesRuleMap);
     visitor->trace(m_treeBoundaryCrossingRuleSet);
 }
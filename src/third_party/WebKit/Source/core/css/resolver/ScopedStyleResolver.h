@@ -79,6 +79,9 @@ private:
     Member<TreeScope> m_scope;
 
     HeapVector<Member<CSSStyleSheet>> m_authorStyleSheets;
+    // The RuleSet of each sheet in m_authorStyleSheets. A sheet shared with
+    // other documents may since have built a RuleSet for another medium.
+    HeapVector<Member<RuleSet>> m_authorRuleSets;
 
     using KeyframesRuleMap = HeapHashMap<const StringImpl*, Member<StyleRuleKeyframes>>;
     KeyframesRuleMap m_keyframesRuleMap;
@@ -184,7 +184,7 @@ void CharacterData::setDataAndUpdate(const String& newData, unsigned offsetOfRep
 void CharacterData::didModifyData(const String& oldData, UpdateSource source)
 {
     if (MutationObserverInterestGroup* mutationRecipients = MutationObserverInterestGroup::createForCharacterDataMutation(*this))
-        mutationRecipients->enqueueMutationRecord(MutationRecord::createCharacterData(this, oldData));
+        mutationRecipients->enqueueMutationRecord(MutationRecord::createCharacterData(this, mutationRecipients->isOldValueRequested() ? oldData : String()));
 
     if (parentNode()) {
         ContainerNode::ChildrenChange change = {ContainerNode::TextChanged, this, previousSibling(), nextSibling(), ContainerNode::ChildrenChangeSourceAPI};
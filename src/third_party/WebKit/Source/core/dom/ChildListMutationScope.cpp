@@ -130,8 +130,10 @@ void ChildListMutationAccumulator::enqueueMutationRecord()
     DCHECK(hasObservers());
     DCHECK(!isEmpty());
 
-    StaticNodeList* addedNodes = StaticNodeList::adopt(m_addedNodes);
-    StaticNodeList* removedNodes = StaticNodeList::adopt(m_removedNodes);
+    // A record usually has either added or removed nodes, so the empty list is
+    // only created if script asks for it.
+    StaticNodeList* addedNodes = m_addedNodes.isEmpty() ? nullptr : StaticNodeList::adopt(m_addedNodes);
+    StaticNodeList* removedNodes = m_removedNodes.isEmpty() ? nullptr : StaticNodeList::adopt(m_removedNodes);
     MutationRecord* record = MutationRecord::createChildList(m_target, addedNodes, removedNodes, m_previousSibling.release(), m_nextSibling.release());
     m_observers->enqueueMutationRecord(record);
     m_lastAdded = nullptr;
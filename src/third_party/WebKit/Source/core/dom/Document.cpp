@@ -1878,6 +1878,11 @@ void Document::updateStyle()
     DCHECK_EQ(styleResolver(), &resolver);
     m_lifecycle.advanceTo(DocumentLifecycle::StyleClean);
     if (shouldRecordStats) {
+        // Elements styled versus elements whose style actually changed shows
+        // how precise the invalidation sets were for this recalc.
+        TRACE_COUNTER2("blink,blink_style", "StyleRecalcInvalidation",
+            "elementsStyled", styleEngine().stats()->elementsStyled,
+            "stylesChanged", styleEngine().stats()->stylesChanged);
         TRACE_EVENT_END2("blink,blink_style", "Document::updateStyle",
             "resolverAccessCount", styleEngine().styleForElementCount() - initialElementCount,
             "counters", styleEngine().stats()->toTracedValue());
@@ -54,6 +54,7 @@
 #include "platform/weborigin/ReferrerPolicy.h"
 #include "public/platform/WebFocusType.h"
 #include "public/platform/WebInsecureRequestPolicy.h"
+#include "wtf/HashCountedSet.h"
 #include "wtf/HashSet.h"
 #include "wtf/PassRefPtr.h"
 #include <memory>
@@ -705,6 +706,14 @@ public:
     bool hasListenerType(ListenerType listenerType) const { return (m_listenerTypes & listenerType); }
     void addListenerTypeIfNeeded(const AtomicString& eventType);
 
+    // Counts the event listeners registered on the nodes of this document by
+    // event type. May overcount, e.g. for listeners of collected nodes, but
+    // never undercounts, so EventDispatcher can skip invoking listeners when
+    // there are none for the type of the event it dispatches.
+    void didAddNodeEventListeners(const AtomicString& eventType, unsigned count = 1) { m_nodeEventListenerCounts.add(eventType, count); }
+    void didRemoveNodeEventListener(const AtomicString& eventType) { m_nodeEventListenerCounts.remove(eventType); }
+    bool mayHaveNodeEventListeners(const AtomicString& eventType) const { return m_nodeEventListenerCounts.contains(eventType); }
+
     bool hasMutationObserversOfType(MutationObserver::MutationType type) const
     {
         return m_mutationObserverTypes & type;
@@ -1281,6 +1290,7 @@ private:
     AttachedRangeSet m_ranges;
 
     unsigned short m_listenerTypes;
+    HashCountedSet<AtomicString> m_nodeEventListenerCounts;
 
     MutationObserverOptions m_mutationObserverTypes;
 
@@ -30,6 +30,8 @@
 
 #include "core/dom/Document.h"
 
+#include "core/EventTypeNames.h"
+#include "core/events/EventListener.h"
 #include "core/frame/FrameView.h"
 #include "core/html/HTMLHeadElement.h"
 #include "core/html/HTMLLinkElement.h"
@@ -289,4 +291,46 @@ TEST_F(DocumentTest, EnforceSandboxFlags)
     EXPECT_TRUE(document().getSecurityOrigin()->isPotentiallyTrustworthy());
 }
 
+namespace {
+
+class TestEventListener : public EventListener {
+public:
+    static TestEventListener* create() { return new TestEventListener(); }
+
+    bool operator==(const EventListener& other) const override { return this == &other; }
+    void handleEvent(ExecutionContext*, Event*) override { }
+
+private:
+    TestEventListener() : EventListener(CPPEventListenerType) { }
+};
+
+} // namespace
+
+TEST_F(DocumentTest, NodeEventListenerCounts)
+{
+    setHtmlInnerHTML("<body><div id=target></div></body>");
+    Element* target = document().getElementById("target");
+    TestEventListener* first = TestEventListener::create();
+    TestEventListener* second = TestEventListener::create();
+    EXPECT_FALSE(document().mayHaveNodeEventListeners(EventTypeNames::mousemove));
+
+    target->addEventListener(EventTypeNames::mousemove, first);
+    document().body()->addEventListener(EventTypeNames::mousemove, second);
+    EXPECT_TRUE(document().mayHaveNodeEventListeners(EventTypeNames::mousemove));
+    EXPECT_FALSE(document().mayHaveNodeEventListeners(EventTypeNames::pointermove));
+
+    target->removeEventListener(EventTypeNames::mousemove, first);
+    EXPECT_TRUE(document().mayHaveNodeEventListeners(EventTypeNames::mousemove));
+    document().body()->removeEventListener(EventTypeNames::mousemove, second);
+    EXPECT_FALSE(document().mayHaveNodeEventListeners(EventTypeNames::mousemove));
+
+    // Listeners move along with their node to another document.
+    Document* otherDocument = Document::create();
+    target->addEventListener(EventTypeNames::mousemove, first);
+    otherDocument->adoptNode(target, ASSERT_NO_EXCEPTION);
+    EXPECT_TRUE(otherDocument->mayHaveNodeEventListeners(EventTypeNames::mousemove));
+    target->removeEventListener(EventTypeNames::mousemove, first);
+    EXPECT_FALSE(otherDocument->mayHaveNodeEventListeners(EventTypeNames::mousemove));
+}
+
 } // namespace blink
@@ -3222,7 +3222,7 @@ void Element::willModifyAttribute(const QualifiedName& name, const AtomicString&
     }
 
     if (MutationObserverInterestGroup* recipients = MutationObserverInterestGroup::createForAttributesMutation(*this, name))
-        recipients->enqueueMutationRecord(MutationRecord::createAttributes(this, name, oldValue));
+        recipients->enqueueMutationRecord(MutationRecord::createAttributes(this, name, recipients->isOldValueRequested() ? oldValue : nullAtom));
 
     InspectorInstrumentation::willModifyDOMAttr(this, oldValue, newValue);
 }
@@ -170,6 +170,15 @@ bool IntersectionObservation::computeGeometry(IntersectionGeometry& geometry) co
 
     clipToRoot(geometry);
 
+    // A target that doesn't intersect the root has a threshold index of 0. If
+    // that was also its last index, no entry will be generated, so skip the
+    // mapping below, which walks up the layout tree. This is the common case
+    // for the many offscreen targets of a lazy loading page.
+    if (!geometry.doesIntersect && !m_lastThresholdIndex) {
+        geometry.intersectionRect = LayoutRect();
+        return true;
+    }
+
     mapTargetRectToTargetFrameCoordinates(geometry.targetRect);
 
     if (geometry.doesIntersect)
@@ -177,11 +186,6 @@ bool IntersectionObservation::computeGeometry(IntersectionGeometry& geometry) co
     else
         geometry.intersectionRect = LayoutRect();
 
-    // Small optimization: if we're not going to report root bounds, don't bother
-    // transforming them to the frame.
-    if (m_shouldReportRootBounds)
-        mapRootRectToRootFrameCoordinates(geometry.rootRect);
-
     return true;
 }
 
@@ -215,6 +219,10 @@ void IntersectionObservation::computeIntersectionObservations(DOMHighResTimeStam
         newThresholdIndex = observer().firstThresholdGreaterThan(newVisibleRatio);
     }
     if (m_lastThresholdIndex != newThresholdIndex) {
+        // Root bounds are only needed for the entry, and only if they are
+        // reported at all.
+        if (m_shouldReportRootBounds)
+            mapRootRectToRootFrameCoordinates(geometry.rootRect);
         IntRect snappedRootBounds = pixelSnappedIntRect(geometry.rootRect);
         IntRect* rootBoundsPointer = m_shouldReportRootBounds ? &snappedRootBounds : nullptr;
         IntersectionObserverEntry* newEntry = new IntersectionObserverEntry(
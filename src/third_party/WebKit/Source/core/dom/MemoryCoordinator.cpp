@@ -37,6 +37,8 @@ void MemoryCoordinator::onMemoryPressure(WebMemoryPressureLevel level)
     }
     if (ProcessHeap::isLowEndDevice())
         memoryCache()->pruneAll();
+    else
+        memoryCache()->onMemoryPressure(level);
     WTF::Partitions::decommitFreeableMemory();
 }
 
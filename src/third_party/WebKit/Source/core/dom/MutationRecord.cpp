@@ -40,6 +40,13 @@ namespace blink {
 
 namespace {
 
+StaticNodeList* lazilyInitializeEmptyNodeList(Member<StaticNodeList>& nodeList)
+{
+    if (!nodeList)
+        nodeList = StaticNodeList::createEmpty();
+    return nodeList.get();
+}
+
 class ChildListRecord : public MutationRecord {
 public:
     ChildListRecord(Node* target, StaticNodeList* added, StaticNodeList* removed, Node* previousSibling, Node* nextSibling)
@@ -64,8 +71,8 @@ public:
 private:
     const AtomicString& type() override;
     Node* target() override { return m_target.get(); }
-    StaticNodeList* addedNodes() override { return m_addedNodes.get(); }
-    StaticNodeList* removedNodes() override { return m_removedNodes.get(); }
+    StaticNodeList* addedNodes() override { return lazilyInitializeEmptyNodeList(m_addedNodes); }
+    StaticNodeList* removedNodes() override { return lazilyInitializeEmptyNodeList(m_removedNodes); }
     Node* previousSibling() override { return m_previousSibling.get(); }
     Node* nextSibling() override { return m_nextSibling.get(); }
 
@@ -98,13 +105,6 @@ private:
     StaticNodeList* addedNodes() override { return lazilyInitializeEmptyNodeList(m_addedNodes); }
     StaticNodeList* removedNodes() override { return lazilyInitializeEmptyNodeList(m_removedNodes); }
 
-    static StaticNodeList* lazilyInitializeEmptyNodeList(Member<StaticNodeList>& nodeList)
-    {
-        if (!nodeList)
-            nodeList = StaticNodeList::createEmpty();
-        return nodeList.get();
-    }
-
     Member<Node> m_target;
     String m_oldValue;
     Member<StaticNodeList> m_addedNodes;
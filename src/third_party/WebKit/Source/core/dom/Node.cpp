@@ -1852,12 +1852,14 @@ void Node::didMoveToNewDocument(Document& oldDocument)
 {
     TreeScopeAdopter::ensureDidMoveToNewDocumentWasCalled(oldDocument);
 
-    if (const EventTargetData* eventTargetData = this->eventTargetData()) {
-        const EventListenerMap& listenerMap = eventTargetData->eventListenerMap;
+    if (EventTargetData* eventTargetData = this->eventTargetData()) {
+        EventListenerMap& listenerMap = eventTargetData->eventListenerMap;
         if (!listenerMap.isEmpty()) {
             Vector<AtomicString> types = listenerMap.eventTypes();
-            for (unsigned i = 0; i < types.size(); ++i)
+            for (unsigned i = 0; i < types.size(); ++i) {
                 document().addListenerTypeIfNeeded(types[i]);
+                document().didAddNodeEventListeners(types[i], listenerMap.find(types[i])->size());
+            }
         }
     }
 
@@ -1886,6 +1888,7 @@ void Node::addedEventListener(const AtomicString& eventType, RegisteredEventList
 {
     EventTarget::addedEventListener(eventType, registeredListener);
     document().addListenerTypeIfNeeded(eventType);
+    document().didAddNodeEventListeners(eventType);
     if (FrameHost* frameHost = document().frameHost())
         frameHost->eventHandlerRegistry().didAddEventHandler(*this, eventType, registeredListener.options());
 }
@@ -1893,8 +1896,9 @@ void Node::addedEventListener(const AtomicString& eventType, RegisteredEventList
 void Node::removedEventListener(const AtomicString& eventType, const RegisteredEventListener& registeredListener)
 {
     EventTarget::removedEventListener(eventType, registeredListener);
-    // FIXME: Notify Document that the listener has vanished. We need to keep track of a number of
-    // listeners for each type, not just a bool - see https://bugs.webkit.org/show_bug.cgi?id=33861
+    document().didRemoveNodeEventListener(eventType);
+    // FIXME: Notify Document that the listener has vanished for the ListenerType bits too. We need
+    // to keep track of a number of listeners for each type, not just a bool - see https://bugs.webkit.org/show_bug.cgi?id=33861
     if (FrameHost* frameHost = document().frameHost())
         frameHost->eventHandlerRegistry().didRemoveEventHandler(*this, eventType, registeredListener.options());
 }
@@ -27,6 +27,7 @@
 #include "core/dom/SelectorQuery.h"
 
 #include "bindings/core/v8/ExceptionState.h"
+#include "core/HTMLNames.h"
 #include "core/css/SelectorChecker.h"
 #include "core/css/parser/CSSParser.h"
 #include "core/dom/Document.h"
@@ -99,6 +100,43 @@ private:
     Member<Element> m_currentElement;
 };
 
+static bool selectorDependsOnlyOnTreeAndAttributes(const CSSSelector& selector)
+{
+    for (const CSSSelector* current = &selector; current; current = current->tagHistory()) {
+        switch (current->match()) {
+        case CSSSelector::Tag:
+        case CSSSelector::Id:
+        case CSSSelector::Class:
+            break;
+        case CSSSelector::AttributeExact:
+        case CSSSelector::AttributeSet:
+        case CSSSelector::AttributeHyphen:
+        case CSSSelector::AttributeList:
+        case CSSSelector::AttributeContain:
+        case CSSSelector::AttributeBegin:
+        case CSSSelector::AttributeEnd:
+            // The style attribute is updated lazily, without a DOM tree
+            // version change, when the inline style is changed through CSSOM.
+            if (current->attribute().localName() == HTMLNames::styleAttr.localName())
+                return false;
+            break;
+        default:
+            return false;
+        }
+        switch (current->relation()) {
+        case CSSSelector::SubSelector:
+        case CSSSelector::Descendant:
+        case CSSSelector::Child:
+        case CSSSelector::DirectAdjacent:
+        case CSSSelector::IndirectAdjacent:
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
 void SelectorDataList::initialize(const CSSSelectorList& selectorList)
 {
     DCHECK(m_selectors.isEmpty());
@@ -109,6 +147,7 @@ void SelectorDataList::initialize(const CSSSelectorList& selectorList)
 
     m_usesDeepCombinatorOrShadowPseudo = false;
     m_needsUpdatedDistribution = false;
+    m_canCacheResults = true;
     m_selectors.reserveInitialCapacity(selectorCount);
     unsigned index = 0;
     for (const CSSSelector* selector = selectorList.first(); selector; selector = CSSSelectorList::next(*selector), ++index) {
@@ -117,6 +156,7 @@ void SelectorDataList::initialize(const CSSSelectorList& selectorList)
         m_selectors.uncheckedAppend(selector);
         m_usesDeepCombinatorOrShadowPseudo |= selectorList.selectorUsesDeepCombinatorOrShadowPseudo(index);
         m_needsUpdatedDistribution |= selectorList.selectorNeedsUpdatedDistribution(index);
+        m_canCacheResults &= selectorDependsOnlyOnTreeAndAttributes(*selector);
     }
 }
 
@@ -533,6 +573,8 @@ std::unique_ptr<SelectorQuery> SelectorQuery::adopt(CSSSelectorList selectorList
 }
 
 SelectorQuery::SelectorQuery(CSSSelectorList selectorList)
+    : m_cachedDOMTreeVersion(0)
+    , m_cachedResultsAreComplete(false)
 {
     m_selectorList = std::move(selectorList);
     m_selectors.initialize(m_selectorList);
@@ -550,12 +592,52 @@ Element* SelectorQuery::closest(Element& element) const
 
 StaticElementList* SelectorQuery::queryAll(ContainerNode& rootNode) const
 {
-    return m_selectors.queryAll(rootNode);
+    if (!m_selectors.canCacheResults())
+        return m_selectors.queryAll(rootNode);
+
+    if (hasCachedResults(rootNode) && m_cachedResultsAreComplete) {
+        HeapVector<Member<Element>> elements;
+        elements.reserveInitialCapacity(m_cachedElements.size());
+        for (Element* element : m_cachedElements)
+            elements.uncheckedAppend(element);
+        return StaticElementList::adopt(elements);
+    }
+
+    StaticElementList* result = m_selectors.queryAll(rootNode);
+    m_cachedElements.clear();
+    m_cachedElements.reserveInitialCapacity(result->length());
+    for (unsigned i = 0; i < result->length(); ++i)
+        m_cachedElements.uncheckedAppend(result->item(i));
+    setCachedResults(rootNode, true);
+    return result;
 }
 
 Element* SelectorQuery::queryFirst(ContainerNode& rootNode) const
 {
-    return m_selectors.queryFirst(rootNode);
+    if (!m_selectors.canCacheResults())
+        return m_selectors.queryFirst(rootNode);
+
+    if (hasCachedResults(rootNode))
+        return m_cachedElements.isEmpty() ? nullptr : m_cachedElements.first().get();
+
+    Element* result = m_selectors.queryFirst(rootNode);
+    m_cachedElements.clear();
+    if (result)
+        m_cachedElements.append(result);
+    setCachedResults(rootNode, false);
+    return result;
+}
+
+bool SelectorQuery::hasCachedResults(const ContainerNode& rootNode) const
+{
+    return m_cachedRootNode.get() == &rootNode && m_cachedDOMTreeVersion == rootNode.document().domTreeVersion();
+}
+
+void SelectorQuery::setCachedResults(ContainerNode& rootNode, bool isComplete) const
+{
+    m_cachedRootNode = &rootNode;
+    m_cachedDOMTreeVersion = rootNode.document().domTreeVersion();
+    m_cachedResultsAreComplete = isComplete;
 }
 
 SelectorQuery* SelectorQueryCache::add(const AtomicString& selectors, const Document& document, ExceptionState& exceptionState)
@@ -53,6 +53,10 @@ public:
     StaticElementList* queryAll(ContainerNode& rootNode) const;
     Element* queryFirst(ContainerNode& rootNode) const;
 
+    // True if the results only depend on the tree and the attributes of the
+    // elements in it, i.e. the selectors have no pseudo classes.
+    bool canCacheResults() const { return m_canCacheResults; }
+
 private:
     bool canUseFastQuery(const ContainerNode& rootNode) const;
     bool selectorMatches(const CSSSelector&, Element&, const ContainerNode&) const;
@@ -84,6 +88,7 @@ private:
     Vector<const CSSSelector*> m_selectors;
     bool m_usesDeepCombinatorOrShadowPseudo : 1;
     bool m_needsUpdatedDistribution : 1;
+    bool m_canCacheResults : 1;
 };
 
 class CORE_EXPORT SelectorQuery {
@@ -99,8 +104,21 @@ public:
 private:
     explicit SelectorQuery(CSSSelectorList);
 
+    bool hasCachedResults(const ContainerNode& rootNode) const;
+    void setCachedResults(ContainerNode& rootNode, bool isComplete) const;
+
     SelectorDataList m_selectors;
     CSSSelectorList m_selectorList;
+
+    // Results of the last query on m_cachedRootNode, valid until the DOM tree
+    // version changes, which it does for any tree or attribute mutation. Until
+    // then the elements are still in the subtree of the root node, so they are
+    // kept alive without being traced. Only the first match is stored when
+    // m_cachedResultsAreComplete is false.
+    mutable WeakPersistent<ContainerNode> m_cachedRootNode;
+    mutable uint64_t m_cachedDOMTreeVersion;
+    mutable Vector<UntracedMember<Element>> m_cachedElements;
+    mutable bool m_cachedResultsAreComplete;
 };
 
 class SelectorQueryCache {
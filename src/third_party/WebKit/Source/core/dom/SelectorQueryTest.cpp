@@ -4,8 +4,10 @@
 
 #include "core/dom/SelectorQuery.h"
 
+#include "core/HTMLNames.h"
 #include "core/css/parser/CSSParser.h"
 #include "core/dom/Document.h"
+#include "core/dom/StaticNodeList.h"
 #include "core/html/HTMLHtmlElement.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include <memory>
@@ -30,4 +32,34 @@ TEST(SelectorQueryTest, NotMatchingPseudoElement)
     EXPECT_NE(nullptr, elm);
 }
 
+TEST(SelectorQueryTest, CachedResultsInvalidatedByMutations)
+{
+    Document* document = Document::create();
+    HTMLHtmlElement* html = HTMLHtmlElement::create(*document);
+    document->appendChild(html);
+    document->documentElement()->setInnerHTML("<body><div id=a class=x></div><div id=b></div></body>", ASSERT_NO_EXCEPTION);
+
+    CSSSelectorList selectorList = CSSParser::parseSelector(CSSParserContext(*document, nullptr), nullptr, "body > .x");
+    std::unique_ptr<SelectorQuery> query = SelectorQuery::adopt(std::move(selectorList));
+    Element* a = document->getElementById("a");
+    Element* b = document->getElementById("b");
+
+    EXPECT_EQ(a, query->queryFirst(*document));
+    StaticElementList* result = query->queryAll(*document);
+    ASSERT_EQ(1u, result->length());
+    EXPECT_EQ(a, result->item(0));
+    // Each call returns a new list.
+    EXPECT_NE(result, query->queryAll(*document));
+
+    b->setAttribute(HTMLNames::classAttr, "x");
+    result = query->queryAll(*document);
+    ASSERT_EQ(2u, result->length());
+    EXPECT_EQ(b, result->item(1));
+
+    a->remove();
+    EXPECT_EQ(b, query->queryFirst(*document));
+    EXPECT_EQ(1u, query->queryAll(*document)->length());
+    EXPECT_EQ(0u, query->queryAll(*a)->length());
+}
+
 } // namespace blink
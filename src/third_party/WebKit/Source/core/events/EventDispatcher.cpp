@@ -122,7 +122,9 @@ DispatchEventResult EventDispatcher::dispatch()
     ASSERT(m_event->target());
     TRACE_EVENT1("devtools.timeline", "EventDispatch", "data", InspectorEventDispatchEvent::data(*m_event));
     EventDispatchHandlingState* preDispatchEventHandlerResult = nullptr;
-    if (dispatchEventPreProcess(preDispatchEventHandlerResult) == ContinueDispatching) {
+    // Most events, e.g. mousemove and pointermove, have no listeners on the
+    // path. Skip the phases then, but still run the default event handlers.
+    if (dispatchEventPreProcess(preDispatchEventHandlerResult) == ContinueDispatching && mayHaveEventListeners()) {
         if (dispatchEventAtCapturing() == ContinueDispatching) {
             if (dispatchEventAtTarget() == ContinueDispatching)
                 dispatchEventAtBubbling();
@@ -139,6 +141,15 @@ DispatchEventResult EventDispatcher::dispatch()
     return EventTarget::dispatchEventResult(*m_event);
 }
 
+inline bool EventDispatcher::mayHaveEventListeners() const
+{
+    // All the nodes in the event path are in the document of the target node.
+    if (m_node->document().mayHaveNodeEventListeners(m_event->type()))
+        return true;
+    LocalDOMWindow* window = m_event->eventPath().windowEventContext().window();
+    return window && window->hasEventListeners(m_event->type());
+}
+
 inline EventDispatchContinuation EventDispatcher::dispatchEventPreProcess(EventDispatchHandlingState*& preDispatchEventHandlerResult)
 {
     // Give the target node a chance to do some work before DOM event handlers get a crack.
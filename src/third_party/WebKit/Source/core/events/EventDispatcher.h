@@ -67,6 +67,7 @@ public:
 private:
     EventDispatcher(Node&, Event*);
 
+    bool mayHaveEventListeners() const;
     EventDispatchContinuation dispatchEventPreProcess(EventDispatchHandlingState*&);
     EventDispatchContinuation dispatchEventAtCapturing();
     EventDispatchContinuation dispatchEventAtTarget();
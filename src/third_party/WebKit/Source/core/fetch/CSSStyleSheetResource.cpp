@@ -32,11 +32,24 @@
 #include "core/fetch/ResourceClientOrObserverWalker.h"
 #include "core/fetch/ResourceFetcher.h"
 #include "core/fetch/StyleSheetResourceClient.h"
+#include "platform/CrossThreadFunctional.h"
 #include "platform/SharedBuffer.h"
+#include "platform/TraceEvent.h"
+#include "platform/threading/BackgroundTaskRunner.h"
+#include "public/platform/Platform.h"
+#include "public/platform/WebScheduler.h"
+#include "public/platform/WebTaskRunner.h"
+#include "public/platform/WebThread.h"
+#include "public/platform/WebTraceLocation.h"
 #include "wtf/CurrentTime.h"
+#include "wtf/PtrUtil.h"
 
 namespace blink {
 
+// Sheets at least this long, such as CSS framework bundles, are tokenized on
+// a background thread so that the main thread only has to build the rules.
+static const unsigned minimumLengthForBackgroundTokenization = 64 * 1024;
+
 CSSStyleSheetResource* CSSStyleSheetResource::fetch(FetchRequest& request, ResourceFetcher* fetcher)
 {
     ASSERT(request.resourceRequest().frameType() == WebURLRequest::FrameTypeNone);
@@ -51,6 +64,7 @@ CSSStyleSheetResource* CSSStyleSheetResource::createForTest(const ResourceReques
 
 CSSStyleSheetResource::CSSStyleSheetResource(const ResourceRequest& resourceRequest, const ResourceLoaderOptions& options, const String& charset)
     : StyleSheetResource(resourceRequest, CSSStyleSheet, options, "text/css", charset)
+    , m_isTokenizing(false)
 {
 }
 
@@ -81,7 +95,9 @@ void CSSStyleSheetResource::didAddClient(ResourceClient* c)
     // see the comment of HTMLLinkElement::setCSSStyleSheet.
     Resource::didAddClient(c);
 
-    if (!isLoading())
+    // Clients added while the sheet is being tokenized are notified with the
+    // others once it is done.
+    if (!isLoading() && !m_isTokenizing)
         static_cast<StyleSheetResourceClient*>(c)->setCSSStyleSheet(m_resourceRequest.url(), m_response.url(), encoding(), this);
 }
 
@@ -99,22 +115,62 @@ const String CSSStyleSheetResource::sheetText(MIMETypeCheck mimeTypeCheck) const
     return decodedText();
 }
 
+CSSTokenizer::Scope* CSSStyleSheetResource::tokenizedSheetText(MIMETypeCheck mimeTypeCheck) const
+{
+    if (!m_tokenizedSheetText || !canUseSheet(mimeTypeCheck))
+        return nullptr;
+    return m_tokenizedSheetText.get();
+}
+
 void CSSStyleSheetResource::checkNotify()
 {
+    if (m_isTokenizing)
+        return;
+
     // Decode the data to find out the encoding and keep the sheet text around during checkNotify()
     if (m_data)
         m_decodedSheetText = decodedText();
 
+    if (m_decodedSheetText.length() >= minimumLengthForBackgroundTokenization && hasClientsOrObservers()) {
+        m_isTokenizing = true;
+        std::unique_ptr<WebTaskRunner> loadingTaskRunner = wrapUnique(Platform::current()->currentThread()->scheduler()->loadingTaskRunner()->clone());
+        BackgroundTaskRunner::postOnBackgroundThread(BLINK_FROM_HERE, crossThreadBind(&CSSStyleSheetResource::tokenizeOnBackgroundThread, wrapCrossThreadPersistent(this), m_decodedSheetText, passed(std::move(loadingTaskRunner))), BackgroundTaskRunner::TaskSizeLongRunningTask);
+        return;
+    }
+
+    notifyClients();
+}
+
+void CSSStyleSheetResource::tokenizeOnBackgroundThread(CSSStyleSheetResource* resource, const String& sheetText, std::unique_ptr<WebTaskRunner> loadingTaskRunner)
+{
+    TRACE_EVENT1("blink,blink_style", "CSSStyleSheetResource::tokenizeOnBackgroundThread", "length", sheetText.length());
+    // The tokens point into |sheetText|, which is an isolated copy owned by
+    // the scope, so the scope can be handed over to the main thread as a whole.
+    std::unique_ptr<CSSTokenizer::Scope> tokenizedSheetText = wrapUnique(new CSSTokenizer::Scope(sheetText));
+    loadingTaskRunner->postTask(BLINK_FROM_HERE, crossThreadBind(&CSSStyleSheetResource::didTokenizeOnBackgroundThread, wrapCrossThreadPersistent(resource), passed(std::move(tokenizedSheetText))));
+}
+
+void CSSStyleSheetResource::didTokenizeOnBackgroundThread(std::unique_ptr<CSSTokenizer::Scope> tokenizedSheetText)
+{
+    DCHECK(m_isTokenizing);
+    m_isTokenizing = false;
+    m_tokenizedSheetText = std::move(tokenizedSheetText);
+    notifyClients();
+}
+
+void CSSStyleSheetResource::notifyClients()
+{
     ResourceClientWalker<StyleSheetResourceClient> w(m_clients);
     while (StyleSheetResourceClient* c = w.next())
         c->setCSSStyleSheet(m_resourceRequest.url(), m_response.url(), encoding(), this);
     // Clear the decoded text as it is unlikely to be needed immediately again and is cheap to regenerate.
     m_decodedSheetText = String();
+    m_tokenizedSheetText = nullptr;
 }
 
 bool CSSStyleSheetResource::isSafeToUnlock() const
 {
-    return m_data->hasOneRef();
+    return !m_isTokenizing && m_data->hasOneRef();
 }
 
 void CSSStyleSheetResource::destroyDecodedDataIfPossible()
@@ -27,8 +27,10 @@
 #define CSSStyleSheetResource_h
 
 #include "core/CoreExport.h"
+#include "core/css/parser/CSSTokenizer.h"
 #include "core/fetch/StyleSheetResource.h"
 #include "platform/heap/Handle.h"
+#include <memory>
 
 namespace blink {
 
@@ -37,6 +39,7 @@ class FetchRequest;
 class ResourceClient;
 class ResourceFetcher;
 class StyleSheetContents;
+class WebTaskRunner;
 
 class CORE_EXPORT CSSStyleSheetResource final : public StyleSheetResource {
 public:
@@ -49,6 +52,10 @@ public:
     DECLARE_VIRTUAL_TRACE();
 
     const String sheetText(MIMETypeCheck = MIMETypeCheck::Strict) const;
+    // The tokens of sheetText(), when the sheet was large enough to be
+    // tokenized on a background thread. Only available while clients are
+    // being notified that the sheet has loaded.
+    CSSTokenizer::Scope* tokenizedSheetText(MIMETypeCheck = MIMETypeCheck::Strict) const;
 
     void didAddClient(ResourceClient*) override;
 
@@ -75,10 +82,16 @@ private:
 
     bool canUseSheet(MIMETypeCheck) const;
     void checkNotify() override;
+    void notifyClients();
+
+    static void tokenizeOnBackgroundThread(CSSStyleSheetResource*, const String& sheetText, std::unique_ptr<WebTaskRunner>);
+    void didTokenizeOnBackgroundThread(std::unique_ptr<CSSTokenizer::Scope>);
 
     void setParsedStyleSheetCache(StyleSheetContents*);
 
     String m_decodedSheetText;
+    std::unique_ptr<CSSTokenizer::Scope> m_tokenizedSheetText;
+    bool m_isTokenizing;
 
     Member<StyleSheetContents> m_parsedStyleSheetCache;
 };
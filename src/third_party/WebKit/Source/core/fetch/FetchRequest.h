@@ -89,7 +89,7 @@ public:
 
     double preloadDiscoveryTime() { return m_preloadDiscoveryTime; }
 
-    bool isLinkPreload() { return m_linkPreload; }
+    bool isLinkPreload() const { return m_linkPreload; }
     void setLinkPreload(bool isLinkPreload) { m_linkPreload = isLinkPreload; }
 
     void setContentSecurityCheck(ContentSecurityPolicyDisposition contentSecurityPolicyOption) { m_options.contentSecurityPolicyOption = contentSecurityPolicyOption; }
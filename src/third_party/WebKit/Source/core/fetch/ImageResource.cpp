@@ -45,6 +45,9 @@ namespace blink {
 
 using ImageResourceObserverWalker = ResourceClientOrObserverWalker<ImageResourceObserver, ImageResourceObserver>;
 
+// The minimum interval between updates of a still image while it loads.
+static const double kFlushDelaySeconds = 1.;
+
 ImageResource* ImageResource::fetch(FetchRequest& request, ResourceFetcher* fetcher)
 {
     if (request.resourceRequest().requestContext() == WebURLRequest::RequestContextUnspecified)
@@ -65,6 +68,7 @@ ImageResource::ImageResource(const ResourceRequest& resourceRequest, const Resou
     , m_image(nullptr)
     , m_hasDevicePixelRatioHeaderValue(false)
     , m_size(LayoutUnit(0), LayoutUnit(0))
+    , m_flushTimer(this, &ImageResource::flushImageIfNeeded)
 {
     WTF_LOG(ResourceLoading, "new ImageResource(ResourceRequest) %p", this);
 }
@@ -75,6 +79,7 @@ ImageResource::ImageResource(blink::Image* image, const ResourceLoaderOptions& o
     , m_image(image)
     , m_hasDevicePixelRatioHeaderValue(false)
     , m_size(LayoutUnit(0), LayoutUnit(0))
+    , m_flushTimer(this, &ImageResource::flushImageIfNeeded)
 {
     WTF_LOG(ResourceLoading, "new ImageResource(Image) %p", this);
     setStatus(Cached);
@@ -245,6 +250,32 @@ void ImageResource::appendData(const char* data, size_t length)
         m_multipartParser->appendData(data, length);
     } else {
         Resource::appendData(data, length);
+
+        // Update right away until the size is known, since layout needs it,
+        // and for animated images, whose frames should show as they arrive.
+        if (!m_sizeAvailable || (m_image && m_image->maybeAnimated())) {
+            updateImage(false);
+            return;
+        }
+
+        // Otherwise each update makes the observers repaint, which decodes
+        // the image again, so only update every kFlushDelaySeconds.
+        if (!m_flushTimer.isActive()) {
+            double now = WTF::monotonicallyIncreasingTime();
+            if (!m_lastFlushTime)
+                m_lastFlushTime = now;
+            double flushDelay = std::max(m_lastFlushTime - now + kFlushDelaySeconds, 0.);
+            m_flushTimer.startOneShot(flushDelay, BLINK_FROM_HERE);
+        }
+    }
+}
+
+void ImageResource::flushImageIfNeeded(TimerBase*)
+{
+    // We might have already loaded the image fully, in which case we don't
+    // need to call |updateImage()|.
+    if (isLoading()) {
+        m_lastFlushTime = WTF::monotonicallyIncreasingTime();
         updateImage(false);
     }
 }
@@ -393,6 +424,7 @@ void ImageResource::updateImage(bool allDataReceived)
     // queried for info (like size or specific image frames).
     if (m_image)
         sizeAvailable = m_image->setData(m_data, allDataReceived);
+    m_sizeAvailable = sizeAvailable;
 
     // Go ahead and tell our observers to try to draw if we have either
     // received all the data or the size is known. Each chunk from the
@@ -422,6 +454,7 @@ void ImageResource::updateImageAndClearBuffer()
 
 void ImageResource::finish(double loadFinishTime)
 {
+    m_flushTimer.stop();
     if (m_multipartParser) {
         m_multipartParser->finish();
         if (m_data)
@@ -434,6 +467,7 @@ void ImageResource::finish(double loadFinishTime)
 
 void ImageResource::error(const ResourceError& error)
 {
+    m_flushTimer.stop();
     if (m_multipartParser)
         m_multipartParser->cancel();
     clear();
@@ -26,6 +26,7 @@
 #include "core/CoreExport.h"
 #include "core/fetch/MultipartImageResourceParser.h"
 #include "core/fetch/Resource.h"
+#include "platform/Timer.h"
 #include "platform/geometry/IntRect.h"
 #include "platform/geometry/IntSizeHash.h"
 #include "platform/geometry/LayoutSize.h"
@@ -157,6 +158,7 @@ private:
     void createImage();
     void updateImage(bool allDataReceived);
     void updateImageAndClearBuffer();
+    void flushImageIfNeeded(TimerBase*);
     void clearImage();
     // If not null, changeRect is the changed part of the image.
     void notifyObservers(const IntRect* changeRect = nullptr);
@@ -178,6 +180,13 @@ private:
     HashCountedSet<ImageResourceObserver*> m_finishedObservers;
 
     LayoutSize m_size;
+
+    // While loading, updates of a still image whose size is known are
+    // coalesced by |m_flushTimer|, so that its observers repaint, and the
+    // image is decoded, at most every kFlushDelaySeconds.
+    Timer<ImageResource> m_flushTimer;
+    double m_lastFlushTime = 0;
+    bool m_sizeAvailable = false;
 };
 
 DEFINE_RESOURCE_TYPE_CASTS(Image);
@@ -262,6 +262,34 @@ TEST(ImageResourceTest, UpdateBitmapImages)
     ASSERT_TRUE(cachedImage->getImage()->isBitmapImage());
 }
 
+TEST(ImageResourceTest, ThrottleUpdatesOnceSizeIsAvailable)
+{
+    ImageResource* cachedImage = ImageResource::create(ResourceRequest());
+    cachedImage->setStatus(Resource::Pending);
+
+    Persistent<MockImageResourceClient> client = new MockImageResourceClient(cachedImage);
+
+    Vector<unsigned char> jpeg = jpegImage();
+    cachedImage->responseReceived(ResourceResponse(KURL(), "image/jpeg", jpeg.size(), nullAtom, String()), nullptr);
+
+    // The headers make the size available, which observers learn right away.
+    cachedImage->appendData(reinterpret_cast<const char*>(jpeg.data()), jpeg.size() - 2);
+    ASSERT_FALSE(cachedImage->errorOccurred());
+    ASSERT_TRUE(cachedImage->hasImage());
+    EXPECT_EQ(1, client->imageChangedCount());
+
+    // Later chunks are coalesced until the flush timer fires or the load
+    // finishes.
+    cachedImage->appendData(reinterpret_cast<const char*>(jpeg.data()) + jpeg.size() - 2, 1);
+    cachedImage->appendData(reinterpret_cast<const char*>(jpeg.data()) + jpeg.size() - 1, 1);
+    EXPECT_EQ(1, client->imageChangedCount());
+
+    cachedImage->finish();
+    ASSERT_FALSE(cachedImage->errorOccurred());
+    EXPECT_EQ(2, client->imageChangedCount());
+    EXPECT_TRUE(client->notifyFinishedCalled());
+}
+
 TEST(ImageResourceTest, ReloadIfLoFi)
 {
     KURL testURL(ParsedURLString, "http://www.test.com/cancelTest.html");
@@ -237,6 +237,8 @@ size_t MemoryCache::liveCapacity() const
 void MemoryCache::pruneLiveResources(PruneStrategy strategy)
 {
     ASSERT(!m_prunePending);
+    if (strategy == MemoryPressurePrune)
+        strategy = AutomaticPrune;
     size_t capacity = liveCapacity();
     if (strategy == MaximalPrune)
         capacity = 0;
@@ -284,6 +286,8 @@ void MemoryCache::pruneDeadResources(PruneStrategy strategy)
     size_t capacity = deadCapacity();
     if (strategy == MaximalPrune)
         capacity = 0;
+    else if (strategy == MemoryPressurePrune)
+        capacity = std::min(capacity, m_minDeadCapacity);
     if (!m_deadSize || (capacity && m_deadSize <= capacity))
         return;
 
@@ -397,10 +401,27 @@ MemoryCacheEntry* MemoryCache::getEntryForResource(const Resource* resource) con
     return entry;
 }
 
-MemoryCacheLRUList* MemoryCache::lruListFor(unsigned accessCount, size_t size)
+// Scripts, style sheets and fonts are small compared to images but block
+// rendering and have to be reparsed when refetched, so they are kept as long
+// as resources of this many times their size.
+static unsigned refetchCostFactor(Resource::Type type)
+{
+    switch (type) {
+    case Resource::CSSStyleSheet:
+    case Resource::Script:
+    case Resource::Font:
+    case Resource::XSLStyleSheet:
+    case Resource::ImportResource:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+MemoryCacheLRUList* MemoryCache::lruListFor(Resource::Type type, unsigned accessCount, size_t size)
 {
     ASSERT(accessCount > 0);
-    unsigned queueIndex = WTF::fastLog2(size / accessCount);
+    unsigned queueIndex = WTF::fastLog2(size / (accessCount * refetchCostFactor(type)));
     if (m_allResources.size() <= queueIndex)
         m_allResources.grow(queueIndex + 1);
     return &m_allResources[queueIndex];
@@ -537,11 +558,11 @@ void MemoryCache::update(Resource* resource, size_t oldSize, size_t newSize, boo
     // The object must now be moved to a different queue, since either its size or its accessCount has been changed,
     // and both of those are used to determine which LRU queue the resource should be in.
     if (oldSize)
-        removeFromLRUList(entry, lruListFor(entry->m_accessCount, oldSize));
+        removeFromLRUList(entry, lruListFor(resource->getType(), entry->m_accessCount, oldSize));
     if (wasAccessed)
         entry->m_accessCount++;
     if (newSize)
-        insertInLRUList(entry, lruListFor(entry->m_accessCount, newSize));
+        insertInLRUList(entry, lruListFor(resource->getType(), entry->m_accessCount, newSize));
 
     ptrdiff_t delta = newSize - oldSize;
     if (resource->hasClientsOrObservers()) {
@@ -704,6 +725,15 @@ void MemoryCache::pruneAll()
     pruneNow(currentTime, MaximalPrune);
 }
 
+void MemoryCache::onMemoryPressure(WebMemoryPressureLevel level)
+{
+    TRACE_EVENT1("renderer", "MemoryCache::onMemoryPressure", "level", level);
+    if (level == WebMemoryPressureLevelCritical)
+        pruneAll();
+    else if (level == WebMemoryPressureLevelModerate)
+        pruneNow(WTF::currentTime(), MemoryPressurePrune);
+}
+
 void MemoryCache::pruneNow(double currentTime, PruneStrategy strategy)
 {
     if (m_prunePending) {
@@ -740,7 +770,7 @@ bool MemoryCache::isInSameLRUListForTest(const Resource* x, const Resource* y)
     MemoryCacheEntry* ey = getEntryForResource(y);
     ASSERT(ex);
     ASSERT(ey);
-    return lruListFor(ex->m_accessCount, x->size()) == lruListFor(ey->m_accessCount, y->size());
+    return lruListFor(x->getType(), ex->m_accessCount, x->size()) == lruListFor(y->getType(), ey->m_accessCount, y->size());
 }
 
 #ifdef MEMORY_CACHE_STATS
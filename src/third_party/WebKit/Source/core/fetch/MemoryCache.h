@@ -28,6 +28,7 @@
 #include "core/CoreExport.h"
 #include "core/fetch/Resource.h"
 #include "platform/MemoryCacheDumpProvider.h"
+#include "public/platform/WebMemoryPressureLevel.h"
 #include "public/platform/WebThread.h"
 #include "wtf/Allocator.h"
 #include "wtf/HashMap.h"
@@ -220,6 +221,10 @@ public:
 
     void pruneAll();
 
+    // Moderate pressure evicts dead resources down to the minimum dead
+    // capacity; critical pressure prunes everything that can be pruned.
+    void onMemoryPressure(WebMemoryPressureLevel);
+
     void updateFramePaintTimestamp();
 
     // Take memory usage snapshot for tracing.
@@ -231,12 +236,14 @@ private:
         // Automatically decide how much to prune.
         AutomaticPrune,
         // Maximally prune resources.
-        MaximalPrune
+        MaximalPrune,
+        // Prune dead resources down to the minimum dead capacity.
+        MemoryPressurePrune
     };
 
     MemoryCache();
 
-    MemoryCacheLRUList* lruListFor(unsigned accessCount, size_t);
+    MemoryCacheLRUList* lruListFor(Resource::Type, unsigned accessCount, size_t);
 
 #ifdef MEMORY_CACHE_STATS
     void dumpStats(Timer<MemoryCache>*);
@@ -141,6 +141,61 @@ TEST_F(MemoryCacheTest, VeryLargeResourceAccounting)
     ASSERT_EQ(cachedResource->size(), memoryCache()->liveSize());
 }
 
+// Verifies that style sheets and scripts outlive images of the same size,
+// since they are more expensive to refetch.
+TEST_F(MemoryCacheTest, RefetchCostWeightsLRUList)
+{
+    memoryCache()->setMaxPruneDeferralDelay(0);
+    const size_t resourceSize = 64 * 1024;
+    FakeResource* image = FakeResource::create(ResourceRequest("http://test/image"), Resource::Image);
+    FakeResource* otherImage = FakeResource::create(ResourceRequest("http://test/image2"), Resource::Image);
+    FakeResource* script = FakeResource::create(ResourceRequest("http://test/script"), Resource::Script);
+    image->fakeEncodedSize(resourceSize);
+    otherImage->fakeEncodedSize(resourceSize);
+    script->fakeEncodedSize(resourceSize);
+    const size_t totalSize = image->size() + otherImage->size() + script->size();
+    memoryCache()->setCapacities(0, totalSize, totalSize);
+    memoryCache()->add(script);
+    memoryCache()->add(image);
+    memoryCache()->add(otherImage);
+
+    EXPECT_TRUE(memoryCache()->isInSameLRUListForTest(image, otherImage));
+    EXPECT_FALSE(memoryCache()->isInSameLRUListForTest(image, script));
+
+    // Making room for two of the resources evicts both images, even though
+    // the script was added first.
+    const size_t capacity = image->size() + script->size();
+    memoryCache()->setCapacities(0, capacity, capacity);
+    EXPECT_TRUE(memoryCache()->contains(script));
+    EXPECT_FALSE(memoryCache()->contains(image));
+    EXPECT_FALSE(memoryCache()->contains(otherImage));
+}
+
+// Verifies that moderate memory pressure evicts dead resources down to the
+// minimum dead capacity, and critical pressure evicts all of them.
+TEST_F(MemoryCacheTest, MemoryPressureEvictsDeadResources)
+{
+    memoryCache()->setDelayBeforeLiveDecodedPrune(0);
+    FakeResource* resource1 = FakeResource::create(ResourceRequest("http://test/resource1"), Resource::Raw);
+    FakeResource* resource2 = FakeResource::create(ResourceRequest("http://test/resource2"), Resource::Raw);
+    resource1->fakeEncodedSize(1024);
+    resource2->fakeEncodedSize(16 * 1024);
+    const size_t totalSize = resource1->size() + resource2->size();
+    memoryCache()->setCapacities(resource1->size() * 2, totalSize, totalSize);
+    memoryCache()->add(resource1);
+    memoryCache()->add(resource2);
+    memoryCache()->prune();
+    EXPECT_EQ(totalSize, memoryCache()->deadSize());
+
+    memoryCache()->onMemoryPressure(WebMemoryPressureLevelModerate);
+    EXPECT_TRUE(memoryCache()->contains(resource1));
+    EXPECT_FALSE(memoryCache()->contains(resource2));
+    EXPECT_EQ(resource1->size(), memoryCache()->deadSize());
+
+    memoryCache()->onMemoryPressure(WebMemoryPressureLevelCritical);
+    EXPECT_EQ(0u, memoryCache()->deadSize());
+}
+
 // Verifies that dead resources that exceed dead resource capacity are evicted
 // from cache when pruning.
 static void TestDeadResourceEviction(Resource* resource1, Resource* resource2)
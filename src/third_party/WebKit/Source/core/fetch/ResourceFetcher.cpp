@@ -518,12 +518,97 @@ Resource* ResourceFetcher::requestResource(FetchRequest& request, const Resource
     if (!resourceNeedsLoad(resource, request, policy))
         return resource;
 
+    bool throttleable = isThrottleable(resource, request);
+    if (m_throttledResources.contains(resource)) {
+        if (throttleable)
+            return resource;
+        unthrottleLoad(resource);
+    } else if (throttleable && !canStartThrottleableLoad()) {
+        throttleLoad(resource);
+        return resource;
+    }
+
     if (!startLoad(resource))
         return nullptr;
+    if (isRenderBlocking(resource, request))
+        m_renderBlockingResources.add(resource);
+    else if (throttleable)
+        m_throttleableResources.add(resource);
     ASSERT(!resource->errorOccurred() || request.options().synchronousPolicy == RequestSynchronously);
     return resource;
 }
 
+bool ResourceFetcher::isRenderBlocking(const Resource* resource, const FetchRequest& request) const
+{
+    if (resource->getType() == Resource::CSSStyleSheet)
+        return true;
+    return resource->getType() == Resource::Script && request.defer() == FetchRequest::NoDefer && !request.forPreload();
+}
+
+bool ResourceFetcher::isThrottleable(const Resource* resource, const FetchRequest& request) const
+{
+    // Only speculative preloads are throttled: the parser needs the other
+    // resources now, and <link rel=preload> is an explicit author request.
+    if (!request.forPreload() || request.isLinkPreload())
+        return false;
+    return resource->resourceRequest().priority() <= ResourceLoadPriorityLow;
+}
+
+// Roughly the number of low priority loads that fill a slow connection
+// without delaying the render-blocking ones.
+static const unsigned kMaxThrottleableLoadsWhileRenderBlocked = 2;
+
+bool ResourceFetcher::canStartThrottleableLoad() const
+{
+    return m_renderBlockingResources.isEmpty() || m_throttleableResources.size() < kMaxThrottleableLoadsWhileRenderBlocked;
+}
+
+void ResourceFetcher::throttleLoad(Resource* resource)
+{
+    TRACE_EVENT_ASYNC_STEP_INTO0("blink.net", "Resource", resource->identifier(), "Throttled");
+    m_throttledResources.set(resource, monotonicallyIncreasingTime());
+}
+
+void ResourceFetcher::unthrottleLoad(Resource* resource)
+{
+    double queueTime = monotonicallyIncreasingTime() - m_throttledResources.take(resource);
+    TRACE_EVENT_ASYNC_STEP_INTO1("blink.net", "Resource", resource->identifier(), "Unthrottled", "queueTimeMs", queueTime * 1000);
+}
+
+void ResourceFetcher::startThrottledLoadsIfPossible()
+{
+    while (!m_throttledResources.isEmpty()) {
+        // Start the highest priority resource first, and among equals the
+        // one that waited longest. Resources whose priority was raised, such
+        // as images that became visible, are no longer throttleable.
+        Resource* next = nullptr;
+        double nextQueueStartTime = 0;
+        for (const auto& throttled : m_throttledResources) {
+            Resource* resource = throttled.key.get();
+            ResourceLoadPriority priority = resource->resourceRequest().priority();
+            if (!next || priority > next->resourceRequest().priority() || (priority == next->resourceRequest().priority() && throttled.value < nextQueueStartTime)) {
+                next = resource;
+                nextQueueStartTime = throttled.value;
+            }
+        }
+        bool throttleable = next->resourceRequest().priority() <= ResourceLoadPriorityLow;
+        if (throttleable && !canStartThrottleableLoad())
+            return;
+        unthrottleLoad(next);
+        if (!next->stillNeedsLoad() || !startLoad(next))
+            continue;
+        if (throttleable && next->isLoading())
+            m_throttleableResources.add(next);
+    }
+}
+
+void ResourceFetcher::didStopLoading(Resource* resource)
+{
+    m_renderBlockingResources.remove(resource);
+    m_throttleableResources.remove(resource);
+    startThrottledLoadsIfPossible();
+}
+
 void ResourceFetcher::resourceTimingReportTimerFired(Timer<ResourceFetcher>* timer)
 {
     ASSERT_UNUSED(timer, timer == &m_resourceTimingReportTimer);
@@ -935,6 +1020,7 @@ void ResourceFetcher::didFinishLoading(Resource* resource, double finishTime, in
     if (finishReason == DidFinishLoading)
         resource->finish(finishTime);
     context().didLoadResource(resource);
+    didStopLoading(resource);
 }
 
 void ResourceFetcher::didFailLoading(Resource* resource, const ResourceError& error)
@@ -946,6 +1032,7 @@ void ResourceFetcher::didFailLoading(Resource* resource, const ResourceError& er
     context().dispatchDidFail(resource->identifier(), error, isInternalRequest);
     resource->error(error);
     context().didLoadResource(resource);
+    didStopLoading(resource);
 }
 
 void ResourceFetcher::didReceiveResponse(Resource* resource, const ResourceResponse& response)
@@ -1018,6 +1105,7 @@ void ResourceFetcher::removeResourceLoader(ResourceLoader* loader)
 
 void ResourceFetcher::stopFetching()
 {
+    m_throttledResources.clear();
     m_nonBlockingLoaders.cancelAll();
     m_loaders.cancelAll();
 }
@@ -1083,7 +1171,7 @@ void ResourceFetcher::updateAllImageResourcePriorities()
     TRACE_EVENT0("blink", "ResourceLoadPriorityOptimizer::updateAllImageResourcePriorities");
     for (const auto& documentResource : m_documentResources) {
         Resource* resource = documentResource.value.get();
-        if (!resource || !resource->isImage() || !resource->isLoading())
+        if (!resource || !resource->isImage() || (!resource->isLoading() && !m_throttledResources.contains(resource)))
             continue;
 
         ResourcePriority resourcePriority = resource->priorityFromObservers();
@@ -1095,6 +1183,7 @@ void ResourceFetcher::updateAllImageResourcePriorities()
         TRACE_EVENT_ASYNC_STEP_INTO1("blink.net", "Resource", resource->identifier(), "ChangePriority", "priority", resourceLoadPriority);
         context().dispatchDidChangeResourcePriority(resource->identifier(), resourceLoadPriority, resourcePriority.intraPriorityValue);
     }
+    startThrottledLoadsIfPossible();
 }
 
 void ResourceFetcher::reloadLoFiImages()
@@ -1288,6 +1377,9 @@ DEFINE_TRACE(ResourceFetcher)
     visitor->trace(m_archive);
     visitor->trace(m_loaders);
     visitor->trace(m_nonBlockingLoaders);
+    visitor->trace(m_renderBlockingResources);
+    visitor->trace(m_throttleableResources);
+    visitor->trace(m_throttledResources);
     visitor->trace(m_documentResources);
     visitor->trace(m_preloads);
     visitor->trace(m_resourceTimingInfoMap);
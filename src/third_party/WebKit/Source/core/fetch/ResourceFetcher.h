@@ -181,6 +181,16 @@ private:
     bool resourceNeedsLoad(Resource*, const FetchRequest&, RevalidationPolicy);
     bool shouldDeferImageLoad(const KURL&) const;
 
+    // Speculative low priority loads are held back while render-blocking
+    // resources load, unless fewer than a few of them are already in flight.
+    bool isRenderBlocking(const Resource*, const FetchRequest&) const;
+    bool isThrottleable(const Resource*, const FetchRequest&) const;
+    bool canStartThrottleableLoad() const;
+    void throttleLoad(Resource*);
+    void unthrottleLoad(Resource*);
+    void startThrottledLoadsIfPossible();
+    void didStopLoading(Resource*);
+
     void resourceTimingReportTimerFired(Timer<ResourceFetcher>*);
 
     void reloadImagesIfNotDeferred();
@@ -205,6 +215,11 @@ private:
     ResourceLoaderSet m_loaders;
     ResourceLoaderSet m_nonBlockingLoaders;
 
+    HeapHashSet<Member<Resource>> m_renderBlockingResources;
+    HeapHashSet<Member<Resource>> m_throttleableResources;
+    // Throttled resources, with the time they were throttled at.
+    HeapHashMap<Member<Resource>, double> m_throttledResources;
+
     // Used in hit rate histograms.
     class DeadResourceStatsRecorder {
         DISALLOW_NEW();
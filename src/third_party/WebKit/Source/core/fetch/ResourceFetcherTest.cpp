@@ -346,6 +346,94 @@ TEST_F(ResourceFetcherTest, DontReuseMediaDataUrl)
     memoryCache()->remove(resource2);
 }
 
+TEST_F(ResourceFetcherTest, ThrottleSpeculativePreloadsWhileRenderBlocked)
+{
+    KURL cssURL(ParsedURLString, "http://127.0.0.1:8000/style.css");
+    ResourceResponse cssResponse;
+    cssResponse.setURL(cssURL);
+    cssResponse.setHTTPStatusCode(200);
+    Platform::current()->getURLLoaderMockFactory()->registerURL(cssURL, WrappedResourceResponse(cssResponse), "");
+
+    ResourceFetcher* fetcher = ResourceFetcher::create(ResourceFetcherTestMockFetchContext::create());
+    FetchRequest cssRequest = FetchRequest(cssURL, FetchInitiatorInfo());
+    Resource* css = fetcher->requestResource(cssRequest, TestResourceFactory(Resource::CSSStyleSheet));
+    ASSERT_TRUE(css);
+    EXPECT_TRUE(css->loader());
+
+    // Two low priority preloads may share the connection with the style
+    // sheet, the third one waits for it.
+    Vector<KURL> imageURLs;
+    HeapVector<Member<Resource>> images;
+    for (int i = 0; i < 3; ++i) {
+        KURL url(ParsedURLString, String::format("http://127.0.0.1:8000/image%d.png", i));
+        URLTestHelpers::registerMockedURLLoad(url, "white-1x1.png", "image/png");
+        FetchRequest imageRequest = FetchRequest(url, FetchInitiatorInfo());
+        imageRequest.setForPreload(true);
+        Resource* image = fetcher->requestResource(imageRequest, TestResourceFactory(Resource::Image));
+        ASSERT_TRUE(image);
+        imageURLs.append(url);
+        images.append(image);
+    }
+    EXPECT_TRUE(images[0]->loader());
+    EXPECT_TRUE(images[1]->loader());
+    EXPECT_FALSE(images[2]->loader());
+    EXPECT_TRUE(images[2]->stillNeedsLoad());
+
+    // The parser asking for the resource starts it immediately.
+    FetchRequest parserRequest = FetchRequest(imageURLs[2], FetchInitiatorInfo());
+    EXPECT_EQ(images[2], fetcher->requestResource(parserRequest, TestResourceFactory(Resource::Image)));
+    EXPECT_TRUE(images[2]->loader());
+
+    Platform::current()->getURLLoaderMockFactory()->serveAsynchronousRequests();
+    EXPECT_TRUE(css->isLoaded());
+    for (Resource* image : images) {
+        EXPECT_TRUE(image->isLoaded());
+        memoryCache()->remove(image);
+    }
+    for (const KURL& url : imageURLs)
+        Platform::current()->getURLLoaderMockFactory()->unregisterURL(url);
+    Platform::current()->getURLLoaderMockFactory()->unregisterURL(cssURL);
+    memoryCache()->remove(css);
+}
+
+TEST_F(ResourceFetcherTest, StartThrottledPreloadsWhenRenderBlockingLoadsFinish)
+{
+    KURL cssURL(ParsedURLString, "http://127.0.0.1:8000/style.css");
+    ResourceResponse cssResponse;
+    cssResponse.setURL(cssURL);
+    cssResponse.setHTTPStatusCode(200);
+    Platform::current()->getURLLoaderMockFactory()->registerURL(cssURL, WrappedResourceResponse(cssResponse), "");
+
+    ResourceFetcher* fetcher = ResourceFetcher::create(ResourceFetcherTestMockFetchContext::create());
+    FetchRequest cssRequest = FetchRequest(cssURL, FetchInitiatorInfo());
+    Resource* css = fetcher->requestResource(cssRequest, TestResourceFactory(Resource::CSSStyleSheet));
+    ASSERT_TRUE(css);
+
+    Vector<KURL> imageURLs;
+    HeapVector<Member<Resource>> images;
+    for (int i = 0; i < 4; ++i) {
+        KURL url(ParsedURLString, String::format("http://127.0.0.1:8000/late%d.png", i));
+        URLTestHelpers::registerMockedURLLoad(url, "white-1x1.png", "image/png");
+        FetchRequest imageRequest = FetchRequest(url, FetchInitiatorInfo());
+        imageRequest.setForPreload(true);
+        images.append(fetcher->requestResource(imageRequest, TestResourceFactory(Resource::Image)));
+        imageURLs.append(url);
+    }
+    EXPECT_FALSE(images[2]->loader());
+    EXPECT_FALSE(images[3]->loader());
+
+    Platform::current()->getURLLoaderMockFactory()->serveAsynchronousRequests();
+    EXPECT_TRUE(css->isLoaded());
+    for (Resource* image : images) {
+        EXPECT_TRUE(image->isLoaded());
+        memoryCache()->remove(image);
+    }
+    for (const KURL& url : imageURLs)
+        Platform::current()->getURLLoaderMockFactory()->unregisterURL(url);
+    Platform::current()->getURLLoaderMockFactory()->unregisterURL(cssURL);
+    memoryCache()->remove(css);
+}
+
 class ServeRequestsOnCompleteClient final : public GarbageCollectedFinalized<ServeRequestsOnCompleteClient>, public RawResourceClient {
 public:
     void notifyFinished(Resource*) override
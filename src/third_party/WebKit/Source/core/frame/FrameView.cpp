@@ -166,6 +166,7 @@ FrameView::FrameView(LocalFrame* frame)
     , m_viewportIntersectionValid(false)
     , m_hiddenForThrottling(false)
     , m_crossOriginForThrottling(false)
+    , m_containedForThrottling(false)
     , m_subtreeThrottled(false)
     , m_currentUpdateLifecyclePhasesTargetState(DocumentLifecycle::Uninitialized)
     , m_scrollAnchor(this)
@@ -4244,6 +4245,17 @@ void FrameView::updateThrottlingStatus()
         if (parentFrame->isLocalFrame() && toLocalFrame(parentFrame)->view() && toLocalFrame(parentFrame)->view()->canThrottleRendering())
             m_subtreeThrottled = true;
     }
+
+    // Same-origin frames can opt in to throttling with 'contain: strict' on
+    // their owner element. Their size then doesn't depend on their content,
+    // and the embedder has declared that it doesn't depend on their layout
+    // or painting either, so keeping their last layout while offscreen is
+    // safe. Script can still force a layout of a throttled frame.
+    m_containedForThrottling = false;
+    if (HTMLFrameOwnerElement* ownerElement = m_frame->deprecatedLocalOwner()) {
+        if (const ComputedStyle* style = ownerElement->computedStyle())
+            m_containedForThrottling = style->contain() == ContainsStrict;
+    }
 }
 
 void FrameView::notifyRenderThrottlingObserversForTesting()
@@ -4312,7 +4324,7 @@ bool FrameView::canThrottleRendering() const
 {
     if (!RuntimeEnabledFeatures::renderingPipelineThrottlingEnabled())
         return false;
-    return m_subtreeThrottled || (m_hiddenForThrottling && m_crossOriginForThrottling);
+    return m_subtreeThrottled || (m_hiddenForThrottling && (m_crossOriginForThrottling || m_containedForThrottling));
 }
 
 LayoutBox& FrameView::boxForScrollControlPaintInvalidation() const
@@ -900,6 +900,7 @@ private:
     // notifications, i.e., not in the middle of the lifecycle.
     bool m_hiddenForThrottling;
     bool m_crossOriginForThrottling;
+    bool m_containedForThrottling;
     bool m_subtreeThrottled;
 
     // Paint properties for SPv2 Only.
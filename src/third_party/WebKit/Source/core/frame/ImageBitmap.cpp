@@ -51,25 +51,6 @@ static PassRefPtr<SkImage> newSkImageFromRaster(const SkImageInfo& info, std::un
         }, nullptr));
 }
 
-static void swizzleImageData(unsigned char* srcAddr, int height, int bytesPerRow, bool flipY)
-{
-    if (flipY) {
-        for (int i = 0; i < height / 2; i++) {
-            int topRowStartPosition = i * bytesPerRow;
-            int bottomRowStartPosition = (height - 1 - i) * bytesPerRow;
-            for (int j = 0; j < bytesPerRow; j += 4) {
-                std::swap(srcAddr[topRowStartPosition + j], srcAddr[bottomRowStartPosition + j + 2]);
-                std::swap(srcAddr[topRowStartPosition + j + 1], srcAddr[bottomRowStartPosition + j + 1]);
-                std::swap(srcAddr[topRowStartPosition + j + 2], srcAddr[bottomRowStartPosition + j]);
-                std::swap(srcAddr[topRowStartPosition + j + 3], srcAddr[bottomRowStartPosition + j + 3]);
-            }
-        }
-    } else {
-        for (int i = 0; i < height * bytesPerRow; i += 4)
-            std::swap(srcAddr[i], srcAddr[i + 2]);
-    }
-}
-
 static PassRefPtr<SkImage> flipSkImageVertically(SkImage* input, AlphaDisposition alphaOp)
 {
     int width = input->width();
@@ -280,42 +261,32 @@ ImageBitmap::ImageBitmap(ImageData* data, const IntRect& cropRect, const ImageBi
             info = SkImageInfo::Make(cropRect.width(), dstHeight, kBGRA_8888_SkColorType, kPremul_SkAlphaType);
         int srcPixelBytesPerRow = info.bytesPerPixel() * data->size().width();
         int dstPixelBytesPerRow = info.bytesPerPixel() * cropRect.width();
-        if (cropRect == IntRect(IntPoint(), data->size())) {
-            swizzleImageData(srcAddr, srcHeight, srcPixelBytesPerRow, flipY);
-            m_image = StaticBitmapImage::create(fromSkSp(SkImage::MakeRasterCopy(SkPixmap(info, srcAddr, dstPixelBytesPerRow))));
-            // restore the original ImageData
-            swizzleImageData(srcAddr, srcHeight, srcPixelBytesPerRow, flipY);
-        } else {
-            std::unique_ptr<uint8_t[]> copiedDataBuffer = wrapArrayUnique(new uint8_t[dstHeight * dstPixelBytesPerRow]());
-            if (!srcRect.isEmpty()) {
-                IntPoint srcPoint = IntPoint((cropRect.x() > 0) ? cropRect.x() : 0, (cropRect.y() > 0) ? cropRect.y() : 0);
-                IntPoint dstPoint = IntPoint((cropRect.x() >= 0) ? 0 : -cropRect.x(), (cropRect.y() >= 0) ? 0 : -cropRect.y());
-                int copyHeight = srcHeight - srcPoint.y();
-                if (cropRect.height() < copyHeight)
-                    copyHeight = cropRect.height();
-                int copyWidth = data->size().width() - srcPoint.x();
-                if (cropRect.width() < copyWidth)
-                    copyWidth = cropRect.width();
-                for (int i = 0; i < copyHeight; i++) {
-                    int srcStartCopyPosition = (i + srcPoint.y()) * srcPixelBytesPerRow + srcPoint.x() * info.bytesPerPixel();
-                    int srcEndCopyPosition = srcStartCopyPosition + copyWidth * info.bytesPerPixel();
-                    int dstStartCopyPosition;
-                    if (flipY)
-                        dstStartCopyPosition = (dstHeight -1 - dstPoint.y() - i) * dstPixelBytesPerRow + dstPoint.x() * info.bytesPerPixel();
-                    else
-                        dstStartCopyPosition = (dstPoint.y() + i) * dstPixelBytesPerRow + dstPoint.x() * info.bytesPerPixel();
-                    for (int j = 0; j < srcEndCopyPosition - srcStartCopyPosition; j++) {
-                        if (j % 4 == 0)
-                            copiedDataBuffer[dstStartCopyPosition + j] = srcAddr[srcStartCopyPosition + j + 2];
-                        else if (j % 4 == 2)
-                            copiedDataBuffer[dstStartCopyPosition + j] = srcAddr[srcStartCopyPosition + j - 2];
-                        else
-                            copiedDataBuffer[dstStartCopyPosition + j] = srcAddr[srcStartCopyPosition + j];
-                    }
+        // Swizzle and flip while copying, in a single pass that leaves the
+        // ImageData untouched. The buffer only needs clearing if the crop
+        // rect extends past the ImageData.
+        std::unique_ptr<uint8_t[]> copiedDataBuffer = wrapArrayUnique(srcRect == cropRect ? new uint8_t[dstHeight * dstPixelBytesPerRow] : new uint8_t[dstHeight * dstPixelBytesPerRow]());
+        if (!srcRect.isEmpty()) {
+            IntPoint srcPoint = IntPoint((cropRect.x() > 0) ? cropRect.x() : 0, (cropRect.y() > 0) ? cropRect.y() : 0);
+            IntPoint dstPoint = IntPoint((cropRect.x() >= 0) ? 0 : -cropRect.x(), (cropRect.y() >= 0) ? 0 : -cropRect.y());
+            int copyHeight = srcHeight - srcPoint.y();
+            if (cropRect.height() < copyHeight)
+                copyHeight = cropRect.height();
+            int copyWidth = data->size().width() - srcPoint.x();
+            if (cropRect.width() < copyWidth)
+                copyWidth = cropRect.width();
+            for (int i = 0; i < copyHeight; i++) {
+                const unsigned char* src = srcAddr + (i + srcPoint.y()) * srcPixelBytesPerRow + srcPoint.x() * info.bytesPerPixel();
+                int dstRow = flipY ? dstHeight - 1 - dstPoint.y() - i : dstPoint.y() + i;
+                uint8_t* dst = copiedDataBuffer.get() + dstRow * dstPixelBytesPerRow + dstPoint.x() * info.bytesPerPixel();
+                for (int j = 0; j < copyWidth; j++, src += 4, dst += 4) {
+                    dst[0] = src[2];
+                    dst[1] = src[1];
+                    dst[2] = src[0];
+                    dst[3] = src[3];
                 }
             }
-            m_image = StaticBitmapImage::create(newSkImageFromRaster(info, std::move(copiedDataBuffer), dstPixelBytesPerRow));
         }
+        m_image = StaticBitmapImage::create(newSkImageFromRaster(info, std::move(copiedDataBuffer), dstPixelBytesPerRow));
         m_image->setPremultiplied(premultiplyAlpha);
         m_image->setOriginClean(isImageDataOriginClean);
         return;
@@ -37,6 +37,7 @@
 #include "core/html/HTMLCanvasElement.h"
 #include "core/html/HTMLImageElement.h"
 #include "core/html/HTMLVideoElement.h"
+#include "core/html/ImageData.h"
 #include "platform/graphics/StaticBitmapImage.h"
 #include "platform/graphics/skia/SkiaUtils.h"
 #include "platform/heap/Handle.h"
@@ -143,4 +144,26 @@ TEST_F(ImageBitmapTest, ImageBitmapSourceChanged)
     }
 }
 
+// Verifies that an unpremultiplied, flipped ImageBitmap created from an
+// ImageData has the expected pixels, and that the ImageData is not modified.
+TEST_F(ImageBitmapTest, ImageDataUnpremultipliedFlipY)
+{
+    const uint8_t pixels[] = {
+        255, 0, 0, 255, 0, 255, 0, 255,
+        0, 0, 255, 255, 10, 20, 30, 128,
+    };
+    ImageData* imageData = ImageData::create(IntSize(2, 2));
+    memcpy(imageData->data()->data(), pixels, sizeof(pixels));
+
+    ImageBitmapOptions options;
+    options.setImageOrientation("flipY");
+    options.setPremultiplyAlpha("none");
+    ImageBitmap* imageBitmap = ImageBitmap::create(imageData, IntRect(0, 0, 2, 2), options);
+    ASSERT_EQ(0, memcmp(imageData->data()->data(), pixels, sizeof(pixels)));
+
+    std::unique_ptr<uint8_t[]> bitmapPixels = imageBitmap->copyBitmapData(DontPremultiplyAlpha);
+    EXPECT_EQ(0, memcmp(bitmapPixels.get(), pixels + 8, 8));
+    EXPECT_EQ(0, memcmp(bitmapPixels.get() + 8, pixels, 8));
+}
+
 } // namespace blink
@@ -307,9 +307,10 @@ void HTMLCanvasElement::didFinalizeFrame()
     m_dirtyRect.intersect(srcRect);
     LayoutBox* ro = layoutBox();
     // Canvas content updates do not need to be propagated as
-    // paint invalidations if the canvas is accelerated, since
-    // the canvas contents are sent separately through a texture layer.
-    if (ro && (!m_context || !m_context->isAccelerated())) {
+    // paint invalidations if the canvas is accelerated, or controlled
+    // by an OffscreenCanvas, since the canvas contents are sent
+    // separately through a texture or surface layer.
+    if (ro && !m_surfaceLayerBridge && (!m_context || !m_context->isAccelerated())) {
         LayoutRect mappedDirtyRect(enclosingIntRect(mapRect(m_dirtyRect, srcRect, FloatRect(ro->contentBoxRect()))));
         // For querying PaintLayer::compositingState()
         // FIXME: is this invalidation using the correct compositing state?
@@ -0,0 +1,90 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/leveldatabase/leveldb_chrome.h"
+
+#include <string>
+
+#include "base/lazy_instance.h"
+#include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "third_party/leveldatabase/src/include/leveldb/cache.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+
+namespace leveldb_chrome {
+
+namespace {
+
+const size_t kSharedBlockCacheSize = 8 * 1024 * 1024;
+const size_t kLowEndSharedBlockCacheSize = 1024 * 1024;
+
+// Owns the shared block cache and reports its usage to memory-infra.
+class SharedBlockCache : public base::trace_event::MemoryDumpProvider {
+ public:
+  SharedBlockCache()
+      : cache_(leveldb::NewLRUCache(base::SysInfo::IsLowEndDevice()
+                                        ? kLowEndSharedBlockCacheSize
+                                        : kSharedBlockCacheSize)) {
+    // The cache is thread-safe, so it can be dumped on any thread.
+    base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+        this, "LevelDBSharedBlockCache", nullptr);
+  }
+
+  leveldb::Cache* cache() const { return cache_; }
+
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override {
+    auto* dump = pmd->CreateAllocatorDump("leveldb/shared_block_cache");
+    dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                    base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                    cache_->TotalCharge());
+    const char* system_allocator_name =
+        base::trace_event::MemoryDumpManager::GetInstance()
+            ->system_allocator_pool_name();
+    if (system_allocator_name)
+      pmd->AddSuballocation(dump->guid(), system_allocator_name);
+    return true;
+  }
+
+ private:
+  // Leaked, as the databases using it may outlive any owner.
+  leveldb::Cache* const cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedBlockCache);
+};
+
+base::LazyInstance<SharedBlockCache>::Leaky g_shared_block_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+const size_t kSmallDatabaseWriteBufferSize = 512 * 1024;
+
+leveldb::Cache* GetSharedBrowserBlockCache() {
+  return g_shared_block_cache.Get().cache();
+}
+
+uint64_t GetApproximateMemoryUsage(leveldb::DB* db,
+                                   bool uses_shared_block_cache) {
+  std::string value;
+  uint64_t usage = 0;
+  if (!db->GetProperty("leveldb.approximate-memory-usage", &value) ||
+      !base::StringToUint64(value, &usage)) {
+    return 0;
+  }
+  if (!uses_shared_block_cache)
+    return usage;
+  // The cache may have changed since the property was read, so this is only
+  // approximate too.
+  uint64_t shared_usage = GetSharedBrowserBlockCache()->TotalCharge();
+  return usage > shared_usage ? usage - shared_usage : 0;
+}
+
+}  // namespace leveldb_chrome
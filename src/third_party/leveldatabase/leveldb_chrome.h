@@ -0,0 +1,38 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_LEVELDATABASE_LEVELDB_CHROME_H_
+#define THIRD_PARTY_LEVELDATABASE_LEVELDB_CHROME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace leveldb {
+class Cache;
+class DB;
+}  // namespace leveldb
+
+namespace leveldb_chrome {
+
+// The write buffer size for the small databases of the browser process, e.g.
+// extension settings or protos cached by features. leveldb's default of 4MB
+// lets each database hold up to twice that in memtables.
+extern const size_t kSmallDatabaseWriteBufferSize;
+
+// Returns the LRU block cache shared by the databases of the browser process,
+// which keeps the blocks they cache within a single memory budget, rather
+// than the 8MB that leveldb caches per database by default. The blocks in the
+// cache are reported to memory-infra as "leveldb/shared_block_cache". Safe to
+// call from any thread; the cache is never destroyed.
+leveldb::Cache* GetSharedBrowserBlockCache();
+
+// Returns the memory used by |db| as the "leveldb.approximate-memory-usage"
+// property reports it, less the blocks of the shared block cache if |db|
+// uses it, since those are reported once for all the databases.
+uint64_t GetApproximateMemoryUsage(leveldb::DB* db,
+                                   bool uses_shared_block_cache);
+
+}  // namespace leveldb_chrome
+
+#endif  // THIRD_PARTY_LEVELDATABASE_LEVELDB_CHROME_H_
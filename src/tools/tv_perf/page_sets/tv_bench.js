@@ -0,0 +1,62 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Helpers for the TV workload pages. Results are reported as user timing
+// marks and measures, which end up in the trace for tv_metrics.py.
+var tvBench = (function() {
+  'use strict';
+
+  function param(name, defaultValue) {
+    var match = new RegExp('[?&]' + name + '=([^&]*)').exec(location.search);
+    if (!match)
+      return defaultValue;
+    return decodeURIComponent(match[1].replace(/\+/g, ' '));
+  }
+
+  // Calls |callback| once a frame with the current state of the page has
+  // been produced, which is one frame after the next animation frame.
+  function afterNextFrame(callback) {
+    requestAnimationFrame(function() {
+      requestAnimationFrame(callback);
+    });
+  }
+
+  function mark(name) {
+    performance.mark(name);
+  }
+
+  // Measures from the |startMark| mark, or navigation start, to now.
+  function measure(name, startMark) {
+    performance.measure(name, startMark || 'navigationStart');
+  }
+
+  function reportVideoDroppedFrames(video) {
+    var dropped = video.getVideoPlaybackQuality ?
+        video.getVideoPlaybackQuality().droppedVideoFrames :
+        video.webkitDroppedFrameCount;
+    if (dropped !== undefined)
+      mark('tv:video_dropped_frames=' + dropped);
+  }
+
+  function done() {
+    mark('tv:done');
+    document.title = 'done';
+  }
+
+  function skip(reason) {
+    console.warn('Skipped: ' + reason);
+    mark('tv:skipped');
+    done();
+  }
+
+  return {
+    param: param,
+    afterNextFrame: afterNextFrame,
+    mark: mark,
+    measure: measure,
+    reportVideoDroppedFrames: reportVideoDroppedFrames,
+    done: done,
+    skip: skip,
+  };
+})();
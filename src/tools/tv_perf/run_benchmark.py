@@ -0,0 +1,245 @@
+#!/usr/bin/env python
+# Copyright 2016 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Runs the TV workload stories against a browser and prints their metrics.
+
+Each story is one launch of the browser on a page of page_sets/, with startup
+tracing recording the whole run. The metrics are then computed from the trace
+by tv_metrics.py and printed as perf_test results. See README.md.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import signal
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+try:
+  from urllib import urlencode
+  from BaseHTTPServer import HTTPServer
+  from SimpleHTTPServer import SimpleHTTPRequestHandler
+except ImportError:
+  from urllib.parse import urlencode
+  from http.server import HTTPServer, SimpleHTTPRequestHandler
+
+import tv_metrics
+
+
+PAGE_SETS_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                             'page_sets')
+
+TRACE_CATEGORIES = [
+    'benchmark',
+    'blink.user_timing',
+    'gpu',
+    'input',
+    'latencyInfo',
+    'media',
+    'disabled-by-default-memory-infra',
+]
+
+# Light dumps only have the totals of the processes, which is all peak_rss
+# needs, and are cheap enough not to skew the other metrics.
+MEMORY_DUMP_INTERVAL_MS = 1000
+
+
+class Story(object):
+
+  def __init__(self, name, page, duration, browser_args=None):
+    self.name = name
+    self.page = page
+    # Seconds of tracing. The page has to be done within them.
+    self.duration = duration
+    self.browser_args = browser_args or []
+
+
+STORIES = [
+    Story('cold_launch', 'cold_launch.html', 10),
+    Story('channel_zap', 'channel_zap.html', 40),
+    Story('epg_scroll', 'epg_scroll.html', 20,
+          browser_args=['--enable-gpu-benchmarking']),
+    Story('mse_playback', 'mse_playback.html', 30),
+]
+
+
+class _QuietRequestHandler(SimpleHTTPRequestHandler):
+
+  def log_message(self, format, *args):
+    pass
+
+
+def StartPageServer():
+  """Serves page_sets/ on a free local port, so that pages can fetch media
+  and run as they would from an app server. Returns the server."""
+  os.chdir(PAGE_SETS_DIR)
+  server = HTTPServer(('127.0.0.1', 0), _QuietRequestHandler)
+  thread = threading.Thread(target=server.serve_forever)
+  thread.daemon = True
+  thread.start()
+  return server
+
+
+def WriteTraceConfigFile(path, story, trace_path):
+  trace_config = {
+      'record_mode': 'record-until-full',
+      'included_categories': TRACE_CATEGORIES,
+      'memory_dump_config': {
+          'triggers': [{
+              'mode': 'light',
+              'periodic_interval_ms': MEMORY_DUMP_INTERVAL_MS,
+          }],
+      },
+  }
+  with open(path, 'w') as f:
+    json.dump({
+        'trace_config': trace_config,
+        'startup_duration': story.duration,
+        'result_file': trace_path,
+    }, f)
+
+
+def WaitForTrace(trace_path, timeout):
+  """Waits for the browser to be done writing the trace. Returns False if it
+  did not start writing within |timeout| seconds."""
+  deadline = time.time() + timeout
+  last_size = -1
+  while time.time() < deadline:
+    if os.path.exists(trace_path):
+      size = os.path.getsize(trace_path)
+      if size and size == last_size:
+        return True
+      last_size = size
+    time.sleep(1)
+  return False
+
+
+def StopBrowser(process):
+  if process.poll() is not None:
+    return
+  process.send_signal(signal.SIGTERM)
+  for _ in range(10):
+    if process.poll() is not None:
+      return
+    time.sleep(0.5)
+  process.kill()
+  process.wait()
+
+
+def RunStory(options, story, base_url, work_dir, iteration):
+  """Runs |story| once and returns the path of its trace, or None."""
+  name = '%s_%d' % (story.name, iteration)
+  trace_path = os.path.join(work_dir, name + '.json')
+  config_path = os.path.join(work_dir, name + '_config.json')
+  WriteTraceConfigFile(config_path, story, trace_path)
+
+  query = {}
+  if options.channels:
+    query['channels'] = options.channels
+  if options.media_src:
+    query['src'] = options.media_src
+  if query:
+    query['mime'] = options.media_mime
+  url = '%s/%s' % (base_url, story.page)
+  if query:
+    url += '?' + urlencode(query)
+
+  # A new profile every time keeps the launches cold as far as the browser
+  # caches go. The ones of the OS are up to the device setup.
+  user_data_dir = os.path.join(work_dir, name + '_profile')
+  command = ([options.browser] + options.browser_args + story.browser_args +
+             ['--user-data-dir=%s' % user_data_dir,
+              '--trace-config-file=%s' % config_path, url])
+  process = subprocess.Popen(command)
+  try:
+    if not WaitForTrace(trace_path, story.duration + options.timeout):
+      sys.stderr.write('%s: no trace was written\n' % name)
+      return None
+  finally:
+    StopBrowser(process)
+  return trace_path
+
+
+def MergeMetrics(results, metrics):
+  for metric, value in metrics.items():
+    if isinstance(value, list):
+      results.setdefault(metric, []).extend(value)
+    else:
+      results.setdefault(metric, []).append(value)
+
+
+def ParseArguments(args):
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--browser', required=True,
+                      help='Path of the browser binary to run.')
+  parser.add_argument('--browser-arg', dest='browser_args', action='append',
+                      default=[], help='Extra switch for the browser.')
+  parser.add_argument('--story', dest='stories', action='append',
+                      choices=[story.name for story in STORIES],
+                      help='Story to run; all of them by default.')
+  parser.add_argument('--repeat', type=int, default=3,
+                      help='Number of runs of each story.')
+  parser.add_argument('--channels', default='',
+                      help='Comma separated media URLs for channel_zap.')
+  parser.add_argument('--media-src', default='',
+                      help='Media segment URL for mse_playback.')
+  parser.add_argument('--media-mime',
+                      default='video/mp4; codecs="avc1.4d401f"',
+                      help='MIME type of the channels and --media-src.')
+  parser.add_argument('--timeout', type=int, default=30,
+                      help='Seconds to wait for the trace past the story.')
+  parser.add_argument('--output-dir',
+                      help='Directory to keep the traces and results.json in.')
+  return parser.parse_args(args)
+
+
+def main(args):
+  options = ParseArguments(args)
+  # The page server changes the working directory.
+  if os.path.exists(options.browser):
+    options.browser = os.path.abspath(options.browser)
+  if options.output_dir:
+    options.output_dir = os.path.abspath(options.output_dir)
+  stories = [story for story in STORIES
+             if not options.stories or story.name in options.stories]
+  server = StartPageServer()
+  base_url = 'http://127.0.0.1:%d' % server.server_address[1]
+  work_dir = options.output_dir or tempfile.mkdtemp(prefix='tv_perf')
+  if not os.path.isdir(work_dir):
+    os.makedirs(work_dir)
+
+  all_results = {}
+  failed = False
+  try:
+    for story in stories:
+      results = {}
+      for iteration in range(options.repeat):
+        trace_path = RunStory(options, story, base_url, work_dir, iteration)
+        if not trace_path:
+          failed = True
+          continue
+        MergeMetrics(results, tv_metrics.ComputeMetrics(
+            tv_metrics.LoadTraceEvents(trace_path)))
+      for metric in tv_metrics.UNITS:
+        if metric in results:
+          print(tv_metrics.FormatResult(metric, story.name, results[metric]))
+      all_results[story.name] = results
+  finally:
+    server.shutdown()
+
+  if options.output_dir:
+    with open(os.path.join(work_dir, 'results.json'), 'w') as f:
+      json.dump(all_results, f, indent=2, sort_keys=True)
+  else:
+    shutil.rmtree(work_dir, ignore_errors=True)
+  return 1 if failed else 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv[1:]))
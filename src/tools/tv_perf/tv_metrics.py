@@ -0,0 +1,164 @@
+# Copyright 2016 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Computes the TV workload metrics from a Chrome JSON trace.
+
+Every metric comes from trace events only, so the same numbers can be taken
+from a trace recorded on the device by any means:
+
+  time_to_first_frame  The 'tv:time_to_first_frame' user timing measure of
+                       the page, from navigation start to the first frame
+                       with content.
+  zap_latency          The 'tv:zap_latency' user timing measures of the page,
+                       from a channel change to the video playing.
+  ums_zap_latency      The UMediaClientImpl::Zap async events, the part of
+                       the zaps spent in the media pipeline.
+  dropped_frames       Refreshes missed by the compositor surface, from the
+                       WaylandPresentationFeedback::FrameDropped events, plus
+                       the video frames the page reported dropped.
+  input_latency        The InputLatency::* async events, from the input event
+                       to the frame showing its effect.
+  peak_rss             The largest sum of the resident set sizes of all the
+                       processes in one memory dump.
+"""
+
+import collections
+import json
+
+
+USER_TIMING_CATEGORY = 'blink.user_timing'
+
+TIME_TO_FIRST_FRAME_MEASURE = 'tv:time_to_first_frame'
+ZAP_LATENCY_MEASURE = 'tv:zap_latency'
+# Marks named 'tv:video_dropped_frames=<count>' report video frames dropped.
+VIDEO_DROPPED_FRAMES_MARK_PREFIX = 'tv:video_dropped_frames='
+
+UMS_ZAP_EVENT = 'UMediaClientImpl::Zap'
+FRAME_DROPPED_EVENT = 'WaylandPresentationFeedback::FrameDropped'
+INPUT_LATENCY_EVENT_PREFIX = 'InputLatency::'
+
+ASYNC_BEGIN_PHASES = ('S', 'b')
+ASYNC_END_PHASES = ('F', 'e')
+MARK_PHASES = ('R', 'I', 'i', 'n')
+MEMORY_DUMP_PHASE = 'v'
+
+# The units of each metric, as perf dashboards want them.
+UNITS = collections.OrderedDict([
+    ('time_to_first_frame', 'ms'),
+    ('zap_latency', 'ms'),
+    ('ums_zap_latency', 'ms'),
+    ('dropped_frames', 'count'),
+    ('input_latency', 'ms'),
+    ('peak_rss', 'MB'),
+])
+
+
+def LoadTraceEvents(path):
+  """Returns the events of the JSON trace at |path|, which may be either a
+  bare event array or an object with a 'traceEvents' member."""
+  with open(path) as f:
+    trace = json.load(f)
+  if isinstance(trace, dict):
+    return trace.get('traceEvents', [])
+  return trace
+
+
+def AsyncDurations(events, matches):
+  """Returns the durations in milliseconds of the async events whose names
+  satisfy |matches|, in the order they started. Begins without an end, as
+  when the trace stops in the middle of one, are left out."""
+  open_events = collections.defaultdict(list)
+  durations = []
+  for event in sorted(events, key=lambda e: e.get('ts', 0)):
+    phase = event.get('ph')
+    if phase not in ASYNC_BEGIN_PHASES and phase not in ASYNC_END_PHASES:
+      continue
+    name = event.get('name', '')
+    if not matches(name):
+      continue
+    key = (event.get('cat'), name, event.get('id'), event.get('pid'))
+    if phase in ASYNC_BEGIN_PHASES:
+      open_events[key].append(event)
+    elif open_events[key]:
+      begin = open_events[key].pop(0)
+      durations.append((begin['ts'], (event['ts'] - begin['ts']) / 1000.0))
+  return [duration for _, duration in sorted(durations)]
+
+
+def UserTimingMeasures(events, measure_name):
+  return AsyncDurations(
+      [e for e in events if e.get('cat') == USER_TIMING_CATEGORY],
+      lambda name: name == measure_name)
+
+
+def Marks(events, prefix):
+  return [e.get('name', '') for e in events
+          if e.get('ph') in MARK_PHASES and
+          e.get('cat') == USER_TIMING_CATEGORY and
+          e.get('name', '').startswith(prefix)]
+
+
+def DroppedFrames(events):
+  dropped = 0
+  for event in events:
+    if event.get('name') == FRAME_DROPPED_EVENT:
+      dropped += int(event.get('args', {}).get('missed_refreshes', 0))
+  for mark in Marks(events, VIDEO_DROPPED_FRAMES_MARK_PREFIX):
+    try:
+      dropped += int(mark[len(VIDEO_DROPPED_FRAMES_MARK_PREFIX):])
+    except ValueError:
+      pass
+  return dropped
+
+
+def PeakResidentSetMegabytes(events):
+  """Returns the peak total resident set size over the memory dumps of the
+  trace, or None if it has none."""
+  totals = collections.defaultdict(int)
+  for event in events:
+    if event.get('ph') != MEMORY_DUMP_PHASE:
+      continue
+    process_totals = (event.get('args', {}).get('dumps', {})
+                      .get('process_totals', {}))
+    resident_set_bytes = process_totals.get('resident_set_bytes')
+    if resident_set_bytes is None:
+      continue
+    # Sizes in dumps are hex strings.
+    totals[event.get('id')] += int(resident_set_bytes, 16)
+  if not totals:
+    return None
+  return max(totals.values()) / float(1024 * 1024)
+
+
+def ComputeMetrics(events):
+  """Returns a dict from the names of the metrics found in |events| to their
+  values. Metrics with samples are lists, the others single numbers."""
+  metrics = collections.OrderedDict()
+
+  def AddSamples(name, samples):
+    if samples:
+      metrics[name] = samples
+
+  AddSamples('time_to_first_frame',
+             UserTimingMeasures(events, TIME_TO_FIRST_FRAME_MEASURE))
+  AddSamples('zap_latency', UserTimingMeasures(events, ZAP_LATENCY_MEASURE))
+  AddSamples('ums_zap_latency',
+             AsyncDurations(events, lambda name: name == UMS_ZAP_EVENT))
+  metrics['dropped_frames'] = DroppedFrames(events)
+  AddSamples('input_latency', AsyncDurations(
+      events, lambda name: name.startswith(INPUT_LATENCY_EVENT_PREFIX)))
+  peak_rss = PeakResidentSetMegabytes(events)
+  if peak_rss is not None:
+    metrics['peak_rss'] = peak_rss
+  return metrics
+
+
+def FormatResult(metric, story, value):
+  """Formats a result the way perf_test::PrintResult does, so the existing
+  perf log parsers pick it up."""
+  units = UNITS[metric]
+  if isinstance(value, list):
+    return 'RESULT %s: %s= [%s] %s' % (
+        metric, story, ','.join('%.3f' % v for v in value), units)
+  return 'RESULT %s: %s= %s %s' % (metric, story, value, units)
@@ -0,0 +1,120 @@
+#!/usr/bin/env python
+# Copyright 2016 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+import json
+import os
+import tempfile
+import tv_metrics
+import unittest
+
+
+def AsyncEvent(phase, name, ts, id, cat='benchmark', **args):
+  return {'ph': phase, 'cat': cat, 'name': name, 'ts': ts, 'id': id,
+          'pid': 1, 'tid': 1, 'args': args}
+
+
+def UserTimingEvent(phase, name, ts, id=1):
+  return AsyncEvent(phase, name, ts, id, cat=tv_metrics.USER_TIMING_CATEGORY)
+
+
+def MemoryDump(dump_id, pid, resident_set_bytes):
+  return {'ph': 'v', 'cat': 'disabled-by-default-memory-infra',
+          'name': 'periodic_interval', 'ts': 0, 'id': dump_id, 'pid': pid,
+          'args': {'dumps': {'process_totals': {
+              'resident_set_bytes': '%x' % resident_set_bytes}}}}
+
+
+class TvMetricsTest(unittest.TestCase):
+
+  def test_LoadTraceEvents(self):
+    events = [UserTimingEvent('R', 'tv:done', 10)]
+    for trace in (events, {'traceEvents': events, 'metadata': {}}):
+      with tempfile.NamedTemporaryFile('w', delete=False) as f:
+        json.dump(trace, f)
+      try:
+        self.assertEqual(events, tv_metrics.LoadTraceEvents(f.name))
+      finally:
+        os.remove(f.name)
+
+  def test_AsyncDurationsPairsByIdInStartOrder(self):
+    events = [
+        AsyncEvent('S', 'UMediaClientImpl::Zap', 5000, '0x2'),
+        AsyncEvent('S', 'UMediaClientImpl::Zap', 1000, '0x1'),
+        AsyncEvent('T', 'UMediaClientImpl::Zap', 3000, '0x1'),
+        AsyncEvent('F', 'UMediaClientImpl::Zap', 4000, '0x1'),
+        AsyncEvent('F', 'UMediaClientImpl::Zap', 5500, '0x2'),
+        # Never ended.
+        AsyncEvent('S', 'UMediaClientImpl::Zap', 9000, '0x1'),
+    ]
+    self.assertEqual(
+        [3.0, 0.5],
+        tv_metrics.AsyncDurations(
+            events, lambda name: name == 'UMediaClientImpl::Zap'))
+
+  def test_UserTimingMeasures(self):
+    events = [
+        UserTimingEvent('b', 'tv:zap_latency', 1000),
+        UserTimingEvent('e', 'tv:zap_latency', 251000),
+        UserTimingEvent('b', 'tv:zap_latency', 300000),
+        UserTimingEvent('e', 'tv:zap_latency', 420000),
+        # Same name outside of user timing.
+        AsyncEvent('b', 'tv:zap_latency', 0, 1),
+        AsyncEvent('e', 'tv:zap_latency', 999000, 1),
+    ]
+    self.assertEqual([250.0, 120.0],
+                     tv_metrics.UserTimingMeasures(events, 'tv:zap_latency'))
+
+  def test_DroppedFrames(self):
+    events = [
+        {'ph': 'I', 'cat': 'gpu',
+         'name': 'WaylandPresentationFeedback::FrameDropped',
+         'args': {'missed_refreshes': 2, 'total_dropped': 2}},
+        {'ph': 'I', 'cat': 'gpu',
+         'name': 'WaylandPresentationFeedback::FrameDropped',
+         'args': {'missed_refreshes': 1, 'total_dropped': 3}},
+        UserTimingEvent('R', 'tv:video_dropped_frames=4', 0),
+        UserTimingEvent('R', 'tv:video_dropped_frames=junk', 0),
+    ]
+    self.assertEqual(7, tv_metrics.DroppedFrames(events))
+
+  def test_PeakResidentSetMegabytesSumsProcessesOfADump(self):
+    mb = 1024 * 1024
+    events = [
+        MemoryDump('0x1', 1, 100 * mb),
+        MemoryDump('0x1', 2, 50 * mb),
+        MemoryDump('0x2', 1, 120 * mb),
+        MemoryDump('0x2', 2, 20 * mb),
+    ]
+    self.assertEqual(150.0, tv_metrics.PeakResidentSetMegabytes(events))
+    self.assertIsNone(tv_metrics.PeakResidentSetMegabytes([]))
+
+  def test_ComputeMetrics(self):
+    events = [
+        UserTimingEvent('b', 'tv:time_to_first_frame', 0),
+        UserTimingEvent('e', 'tv:time_to_first_frame', 800000),
+        AsyncEvent('S', 'InputLatency::GestureScrollUpdate', 1000, '0x5'),
+        AsyncEvent('F', 'InputLatency::GestureScrollUpdate', 41000, '0x5'),
+        MemoryDump('0x1', 1, 1024 * 1024),
+    ]
+    metrics = tv_metrics.ComputeMetrics(events)
+    self.assertEqual(
+        ['time_to_first_frame', 'dropped_frames', 'input_latency', 'peak_rss'],
+        list(metrics.keys()))
+    self.assertEqual([800.0], metrics['time_to_first_frame'])
+    self.assertEqual(0, metrics['dropped_frames'])
+    self.assertEqual([40.0], metrics['input_latency'])
+    self.assertEqual(1.0, metrics['peak_rss'])
+
+  def test_FormatResult(self):
+    self.assertEqual('RESULT zap_latency: channel_zap= [250.000,120.500] ms',
+                     tv_metrics.FormatResult('zap_latency', 'channel_zap',
+                                             [250.0, 120.5]))
+    self.assertEqual('RESULT dropped_frames: epg_scroll= 3 count',
+                     tv_metrics.FormatResult('dropped_frames', 'epg_scroll',
+                                             3))
+
+
+if __name__ == '__main__':
+  unittest.main(verbosity=2)
@@ -77,6 +77,11 @@ const unsigned char kPngDataChunkType[4] = { 'I', 'D', 'A', 'T' };
 const char kPakFileSuffix[] = ".pak";
 #endif
 
+// The default cap on decompressed resources kept by LoadDataResourceBytes().
+// Compressed resources are mostly WebUI scripts and styles, so this holds the
+// working set of a few pages.
+const size_t kDefaultDecompressedResourcesLimit = 2 * 1024 * 1024;
+
 ResourceBundle* g_shared_instance_ = NULL;
 
 #if defined(OS_ANDROID)
@@ -538,10 +543,7 @@ base::RefCountedMemory* ResourceBundle::LoadDataResourceBytesForScale(
         GetRawDataResourceForScaleImpl(resource_id, scale_factor);
     if (!data.empty()) {
       if (data.starts_with(CUSTOM_GZIP_HEADER)) {
-        // Jump past special identification byte prepended to header
-        const unsigned char* gzip_start =
-            reinterpret_cast<const unsigned char*>(data.data()) + 1;
-        bytes = DecodeGzipData(gzip_start, data.length() - 1);
+        bytes = DecompressDataResource(resource_id, scale_factor, data);
       } else {
         bytes = new base::RefCountedStaticMemory(data.data(), data.length());
       }
@@ -567,6 +569,12 @@ base::StringPiece ResourceBundle::GetRawDataResourceForScale(
   return data;
 }
 
+void ResourceBundle::SetDecompressedResourceCacheLimit(size_t max_bytes) {
+  DCHECK(base::PlatformThread::CurrentRef() == creation_thread_);
+  decompressed_resources_limit_ = max_bytes;
+  TrimDecompressedResources(max_bytes);
+}
+
 base::string16 ResourceBundle::GetLocalizedString(int message_id) {
   base::string16 string;
   if (delegate_ && delegate_->GetLocalizedString(message_id, &string))
@@ -718,7 +726,11 @@ ResourceBundle::ResourceBundle(Delegate* delegate)
     : delegate_(delegate),
       images_and_fonts_lock_(new base::Lock),
       locale_resources_data_lock_(new base::Lock),
-      max_scale_factor_(SCALE_FACTOR_100P) {
+      max_scale_factor_(SCALE_FACTOR_100P),
+      decompressed_resources_(DecompressedResourceCache::NO_AUTO_EVICT),
+      decompressed_resources_bytes_(0),
+      decompressed_resources_limit_(kDefaultDecompressedResourcesLimit),
+      creation_thread_(base::PlatformThread::CurrentRef()) {
 }
 
 ResourceBundle::~ResourceBundle() {
@@ -847,6 +859,47 @@ void ResourceBundle::AddDataPack(DataPack* data_pack) {
   if (GetScaleForScaleFactor(data_pack->GetScaleFactor()) >
       GetScaleForScaleFactor(max_scale_factor_))
     max_scale_factor_ = data_pack->GetScaleFactor();
+
+  // The new pack may change which resources are found first.
+  if (base::PlatformThread::CurrentRef() == creation_thread_)
+    TrimDecompressedResources(0);
+}
+
+base::RefCountedMemory* ResourceBundle::DecompressDataResource(
+    int resource_id,
+    ScaleFactor scale_factor,
+    base::StringPiece data) const {
+  // Jump past special identification byte prepended to header
+  const unsigned char* gzip_start =
+      reinterpret_cast<const unsigned char*>(data.data()) + 1;
+  if (decompressed_resources_limit_ == 0 ||
+      base::PlatformThread::CurrentRef() != creation_thread_) {
+    return DecodeGzipData(gzip_start, data.length() - 1);
+  }
+
+  DecompressedResourceKey key(resource_id, scale_factor);
+  DecompressedResourceCache::iterator it = decompressed_resources_.Get(key);
+  if (it != decompressed_resources_.end())
+    return it->second.get();
+
+  base::RefCountedMemory* bytes =
+      DecodeGzipData(gzip_start, data.length() - 1);
+  if (bytes->size() <= decompressed_resources_limit_) {
+    decompressed_resources_.Put(key,
+                                scoped_refptr<base::RefCountedMemory>(bytes));
+    decompressed_resources_bytes_ += bytes->size();
+    TrimDecompressedResources(decompressed_resources_limit_);
+  }
+  return bytes;
+}
+
+void ResourceBundle::TrimDecompressedResources(size_t max_bytes) const {
+  while (decompressed_resources_bytes_ > max_bytes) {
+    DecompressedResourceCache::reverse_iterator oldest =
+        decompressed_resources_.rbegin();
+    decompressed_resources_bytes_ -= oldest->second->size();
+    decompressed_resources_.Erase(oldest);
+  }
 }
 
 void ResourceBundle::InitDefaultFontList() {
@@ -12,13 +12,16 @@
 #include <string>
 
 #include "base/containers/hash_tables.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/files/memory_mapped_file.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/scoped_vector.h"
 #include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
+#include "base/threading/platform_thread.h"
 #include "build/build_config.h"
 #include "ui/base/layout.h"
 #include "ui/base/ui_base_export.h"
@@ -244,6 +247,11 @@ class UI_BASE_EXPORT ResourceBundle {
   base::StringPiece GetRawDataResourceForScale(int resource_id,
                                                ScaleFactor scale_factor) const;
 
+  // Sets the number of bytes of decompressed gzip resources that
+  // LoadDataResourceBytes() keeps around, so that resources loaded repeatedly
+  // are only inflated once. Pass 0 to disable the cache.
+  void SetDecompressedResourceCacheLimit(size_t max_bytes);
+
   // Get a localized string given a message id.  Returns an empty
   // string if the message_id is not found.
   base::string16 GetLocalizedString(int message_id);
@@ -357,6 +365,18 @@ class UI_BASE_EXPORT ResourceBundle {
   // accordingly.
   void AddDataPack(DataPack* data_pack);
 
+  // Returns the inflated contents of the gzip resource |data|, which was
+  // found for |resource_id| and |scale_factor|, using
+  // |decompressed_resources_| when called on the thread that created the
+  // ResourceBundle.
+  base::RefCountedMemory* DecompressDataResource(int resource_id,
+                                                 ScaleFactor scale_factor,
+                                                 base::StringPiece data) const;
+
+  // Evicts the least recently used decompressed resources until at most
+  // |max_bytes| of them remain.
+  void TrimDecompressedResources(size_t max_bytes) const;
+
   // Try to load the locale specific strings from an external data module.
   // Returns the locale that is loaded.
   std::string LoadLocaleResources(const std::string& pref_locale);
@@ -441,6 +461,19 @@ class UI_BASE_EXPORT ResourceBundle {
   // The maximum scale factor currently loaded.
   ScaleFactor max_scale_factor_;
 
+  // Decompressed gzip resources, keyed by resource id and the scale factor
+  // they were requested for. Only used on |creation_thread_|, which keeps the
+  // pointers handed out by LoadDataResourceBytes() alive until the caller has
+  // taken its own reference.
+  typedef std::pair<int, ScaleFactor> DecompressedResourceKey;
+  typedef base::MRUCache<DecompressedResourceKey,
+                         scoped_refptr<base::RefCountedMemory>>
+      DecompressedResourceCache;
+  mutable DecompressedResourceCache decompressed_resources_;
+  mutable size_t decompressed_resources_bytes_;
+  size_t decompressed_resources_limit_;
+  const base::PlatformThreadRef creation_thread_;
+
   // Cached images. The ResourceBundle caches all retrieved images and keeps
   // ownership of the pointers.
   typedef std::map<int, gfx::Image> ImageMap;
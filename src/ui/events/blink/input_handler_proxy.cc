@@ -442,6 +442,22 @@ bool InputHandlerProxy::ShouldAnimate(bool has_precise_scroll_deltas) const {
 #endif
 }
 
+bool InputHandlerProxy::AnimateScroll(const gfx::Point& viewport_point,
+                                      const gfx::Vector2dF& scroll_delta) {
+  TRACE_EVENT2("input", "InputHandlerProxy::AnimateScroll", "deltaX",
+               scroll_delta.x(), "deltaY", scroll_delta.y());
+  // Don't take the currently scrolling layer away from a gesture scroll.
+  if (gesture_scroll_on_impl_thread_)
+    return false;
+
+  if (fling_curve_)
+    CancelCurrentFling();
+
+  cc::InputHandler::ScrollStatus scroll_status =
+      input_handler_->ScrollAnimated(viewport_point, scroll_delta);
+  return scroll_status.thread == cc::InputHandler::SCROLL_ON_IMPL_THREAD;
+}
+
 InputHandlerProxy::EventDisposition InputHandlerProxy::HandleMouseWheel(
     const WebMouseWheelEvent& wheel_event) {
   // Only call |CancelCurrentFling()| if a fling was active, as it will
@@ -59,6 +59,13 @@ class InputHandlerProxy
       ui::LatencyInfo* latency_info);
   EventDisposition HandleInputEvent(const blink::WebInputEvent& event);
 
+  // Animates a scroll by |scroll_delta| of the layer under |viewport_point| on
+  // the impl thread, on behalf of the main thread (e.g. to bring the focused
+  // element into view), retargeting the animation if one is running. Returns
+  // false if the scroll has to happen on the main thread instead.
+  bool AnimateScroll(const gfx::Point& viewport_point,
+                     const gfx::Vector2dF& scroll_delta);
+
   // cc::InputHandlerClient implementation.
   void WillShutdown() override;
   void Animate(base::TimeTicks time) override;
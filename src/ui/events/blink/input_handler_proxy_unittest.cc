@@ -595,6 +595,33 @@ TEST_P(InputHandlerProxyTest, DISABLED_GestureScrollByCoarsePixels) {
   VERIFY_AND_RESET_MOCKS();
 }
 
+TEST_P(InputHandlerProxyTest, AnimateScroll) {
+  EXPECT_CALL(mock_input_handler_,
+              ScrollAnimated(gfx::Point(10, 20), gfx::Vector2dF(0, 300)))
+      .WillOnce(testing::Return(kImplThreadScrollState));
+  EXPECT_TRUE(input_handler_->AnimateScroll(gfx::Point(10, 20),
+                                            gfx::Vector2dF(0, 300)));
+  VERIFY_AND_RESET_MOCKS();
+
+  EXPECT_CALL(mock_input_handler_, ScrollAnimated(testing::_, testing::_))
+      .WillOnce(testing::Return(kMainThreadScrollState));
+  EXPECT_FALSE(input_handler_->AnimateScroll(gfx::Point(10, 20),
+                                             gfx::Vector2dF(0, 300)));
+  VERIFY_AND_RESET_MOCKS();
+
+  // A gesture scroll on the impl thread keeps its scrolling layer.
+  gesture_.type = WebInputEvent::GestureScrollBegin;
+  EXPECT_CALL(mock_input_handler_, ScrollBegin(testing::_, testing::_))
+      .WillOnce(testing::Return(kImplThreadScrollState));
+  EXPECT_EQ(InputHandlerProxy::DID_HANDLE,
+            input_handler_->HandleInputEvent(gesture_));
+  EXPECT_CALL(mock_input_handler_, ScrollAnimated(testing::_, testing::_))
+      .Times(0);
+  EXPECT_FALSE(input_handler_->AnimateScroll(gfx::Point(10, 20),
+                                             gfx::Vector2dF(0, 300)));
+  VERIFY_AND_RESET_MOCKS();
+}
+
 TEST_P(InputHandlerProxyTest, GestureScrollBeginThatTargetViewport) {
   // We shouldn't send any events to the widget for this gesture.
   expected_disposition_ = InputHandlerProxy::DID_HANDLE;
@@ -5,10 +5,17 @@
 #include "ui/gfx/codec/png_codec.h"
 
 #include <stdint.h>
+#include <string.h>
 
+#include "base/bind.h"
+#include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/strings/string_util.h"
+#include "base/task_runner.h"
+#include "base/task_runner_util.h"
+#include "build/build_config.h"
 #include "third_party/libpng/png.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkColorPriv.h"
@@ -17,14 +24,68 @@
 #include "ui/gfx/geometry/size.h"
 #include "ui/gfx/skia_util.h"
 
+// The row converters below handle several pixels per step with SSE2 on x86,
+// and with NEON on ARM when the target has it (always on ARM64).
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#define PNG_CODEC_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && \
+    (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define PNG_CODEC_NEON
+#endif
+
 namespace gfx {
 
 namespace {
 
+#if !defined(PNG_CODEC_NEON)
+// Swaps the first and the third bytes of a pixel loaded from memory.
+inline uint32_t SwapFirstAndThirdBytes(uint32_t pixel) {
+  return (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) |
+         ((pixel & 0xFF) << 16);
+}
+
+// Writes the first three bytes of each of the four |pixels| loaded from
+// memory to |rgb|, using three word stores instead of twelve byte stores.
+inline void StorePackedRGB(const uint32_t* pixels, unsigned char* rgb) {
+  const uint32_t p0 = pixels[0] & 0xFFFFFF;
+  const uint32_t p1 = pixels[1] & 0xFFFFFF;
+  const uint32_t p2 = pixels[2] & 0xFFFFFF;
+  const uint32_t p3 = pixels[3] & 0xFFFFFF;
+  const uint32_t packed[3] = {p0 | (p1 << 24), (p1 >> 8) | (p2 << 16),
+                              (p2 >> 16) | (p3 << 8)};
+  memcpy(rgb, packed, sizeof(packed));
+}
+#endif  // !defined(PNG_CODEC_NEON)
+
 // Converts BGRA->RGBA and RGBA->BGRA.
 void ConvertBetweenBGRAandRGBA(const unsigned char* input, int pixel_width,
                                unsigned char* output, bool* is_opaque) {
-  for (int x = 0; x < pixel_width; x++) {
+  int x = 0;
+#if defined(PNG_CODEC_SSE2)
+  const __m128i green_alpha_mask = _mm_set1_epi32(0xFF00FF00);
+  for (; x + 4 <= pixel_width; x += 4) {
+    const __m128i pixels =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[x * 4]));
+    const __m128i green_alpha = _mm_and_si128(pixels, green_alpha_mask);
+    const __m128i red_blue = _mm_andnot_si128(green_alpha_mask, pixels);
+    // Rotating each pixel's red and blue by 16 bits swaps them.
+    const __m128i blue_red = _mm_or_si128(_mm_slli_epi32(red_blue, 16),
+                                          _mm_srli_epi32(red_blue, 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[x * 4]),
+                     _mm_or_si128(green_alpha, blue_red));
+  }
+#elif defined(PNG_CODEC_NEON)
+  for (; x + 16 <= pixel_width; x += 16) {
+    uint8x16x4_t pixels = vld4q_u8(&input[x * 4]);
+    const uint8x16_t first = pixels.val[0];
+    pixels.val[0] = pixels.val[2];
+    pixels.val[2] = first;
+    vst4q_u8(&output[x * 4], pixels);
+  }
+#endif
+  for (; x < pixel_width; x++) {
     const unsigned char* pixel_in = &input[x * 4];
     unsigned char* pixel_out = &output[x * 4];
     pixel_out[0] = pixel_in[2];
@@ -36,13 +97,102 @@ void ConvertBetweenBGRAandRGBA(const unsigned char* input, int pixel_width,
 
 void ConvertRGBAtoRGB(const unsigned char* rgba, int pixel_width,
                       unsigned char* rgb, bool* is_opaque) {
-  for (int x = 0; x < pixel_width; x++)
+  int x = 0;
+#if defined(PNG_CODEC_NEON)
+  for (; x + 16 <= pixel_width; x += 16) {
+    const uint8x16x4_t pixels = vld4q_u8(&rgba[x * 4]);
+    uint8x16x3_t packed;
+    packed.val[0] = pixels.val[0];
+    packed.val[1] = pixels.val[1];
+    packed.val[2] = pixels.val[2];
+    vst3q_u8(&rgb[x * 3], packed);
+  }
+#elif defined(ARCH_CPU_LITTLE_ENDIAN)
+  for (; x + 4 <= pixel_width; x += 4) {
+    uint32_t pixels[4];
+    memcpy(pixels, &rgba[x * 4], sizeof(pixels));
+    StorePackedRGB(pixels, &rgb[x * 3]);
+  }
+#endif
+  for (; x < pixel_width; x++)
     memcpy(&rgb[x * 3], &rgba[x * 4], 3);
 }
 
+void ConvertBGRAtoRGB(const unsigned char* bgra, int pixel_width,
+                      unsigned char* rgb, bool* is_opaque) {
+  int x = 0;
+#if defined(PNG_CODEC_NEON)
+  for (; x + 16 <= pixel_width; x += 16) {
+    const uint8x16x4_t pixels = vld4q_u8(&bgra[x * 4]);
+    uint8x16x3_t packed;
+    packed.val[0] = pixels.val[2];
+    packed.val[1] = pixels.val[1];
+    packed.val[2] = pixels.val[0];
+    vst3q_u8(&rgb[x * 3], packed);
+  }
+#elif defined(ARCH_CPU_LITTLE_ENDIAN)
+  for (; x + 4 <= pixel_width; x += 4) {
+    uint32_t pixels[4];
+    memcpy(pixels, &bgra[x * 4], sizeof(pixels));
+    for (uint32_t& pixel : pixels)
+      pixel = SwapFirstAndThirdBytes(pixel);
+    StorePackedRGB(pixels, &rgb[x * 3]);
+  }
+#endif
+  for (; x < pixel_width; x++) {
+    const unsigned char* pixel_in = &bgra[x * 4];
+    unsigned char* pixel_out = &rgb[x * 3];
+    pixel_out[0] = pixel_in[2];
+    pixel_out[1] = pixel_in[1];
+    pixel_out[2] = pixel_in[0];
+  }
+}
+
+bool IsOpaqueSkiaPixel(const unsigned char* skia, int x) {
+  uint32_t pixel;
+  memcpy(&pixel, &skia[x * 4], sizeof(pixel));
+  return SkGetPackedA32(pixel) == 255;
+}
+
+// Returns the index of the first pixel of |skia| from |x| on that is not
+// opaque, or |pixel_width| if there is none.
+int FindEndOfOpaqueRun(const unsigned char* skia, int x, int pixel_width) {
+  while (x < pixel_width && IsOpaqueSkiaPixel(skia, x))
+    x++;
+  return x;
+}
+
+// Opaque skia pixels need no unpremultiplication, only reordering, which the
+// converters above do several pixels at a time.
+void ConvertOpaqueSkiaToRGB(const unsigned char* skia, int pixel_width,
+                            unsigned char* rgb) {
+#if SK_R32_SHIFT == 0
+  ConvertRGBAtoRGB(skia, pixel_width, rgb, NULL);
+#else
+  ConvertBGRAtoRGB(skia, pixel_width, rgb, NULL);
+#endif
+}
+
+void ConvertOpaqueSkiaToRGBA(const unsigned char* skia, int pixel_width,
+                             unsigned char* rgba) {
+#if SK_R32_SHIFT == 0
+  memcpy(rgba, skia, pixel_width * 4);
+#else
+  ConvertBetweenBGRAandRGBA(skia, pixel_width, rgba, NULL);
+#endif
+}
+
 void ConvertSkiaToRGB(const unsigned char* skia, int pixel_width,
                       unsigned char* rgb, bool* is_opaque) {
   for (int x = 0; x < pixel_width; x++) {
+    const int opaque_end = FindEndOfOpaqueRun(skia, x, pixel_width);
+    if (opaque_end > x) {
+      ConvertOpaqueSkiaToRGB(&skia[x * 4], opaque_end - x, &rgb[x * 3]);
+      x = opaque_end;
+      if (x == pixel_width)
+        break;
+    }
+
     const uint32_t pixel_in = *reinterpret_cast<const uint32_t*>(&skia[x * 4]);
     unsigned char* pixel_out = &rgb[x * 3];
 
@@ -62,7 +212,20 @@ void ConvertSkiaToRGB(const unsigned char* skia, int pixel_width,
 
 void ConvertSkiaToRGBA(const unsigned char* skia, int pixel_width,
                        unsigned char* rgba, bool* is_opaque) {
-  gfx::ConvertSkiaToRGBA(skia, pixel_width, rgba);
+  int x = 0;
+  while (x < pixel_width) {
+    const int opaque_end = FindEndOfOpaqueRun(skia, x, pixel_width);
+    ConvertOpaqueSkiaToRGBA(&skia[x * 4], opaque_end - x, &rgba[x * 4]);
+    x = opaque_end;
+
+    int translucent_end = x;
+    while (translucent_end < pixel_width &&
+           !IsOpaqueSkiaPixel(skia, translucent_end)) {
+      translucent_end++;
+    }
+    gfx::ConvertSkiaToRGBA(&skia[x * 4], translucent_end - x, &rgba[x * 4]);
+    x = translucent_end;
+  }
 }
 
 }  // namespace
@@ -496,17 +659,6 @@ void FakeFlushCallback(png_structp png) {
   // we're required to provide this function by libpng.
 }
 
-void ConvertBGRAtoRGB(const unsigned char* bgra, int pixel_width,
-                      unsigned char* rgb, bool* is_opaque) {
-  for (int x = 0; x < pixel_width; x++) {
-    const unsigned char* pixel_in = &bgra[x * 4];
-    unsigned char* pixel_out = &rgb[x * 3];
-    pixel_out[0] = pixel_in[2];
-    pixel_out[1] = pixel_in[1];
-    pixel_out[2] = pixel_in[0];
-  }
-}
-
 #ifdef PNG_TEXT_SUPPORTED
 class CommentWriter {
  public:
@@ -571,6 +723,7 @@ bool DoLibpngWrite(png_struct* png_ptr, png_info* info_ptr,
                    PngEncoderState* state,
                    int width, int height, int row_byte_width,
                    const unsigned char* input, int compression_level,
+                   int png_filters,
                    int png_output_color_type, int output_color_components,
                    FormatConverter converter,
                    const std::vector<PNGCodec::Comment>& comments) {
@@ -588,6 +741,7 @@ bool DoLibpngWrite(png_struct* png_ptr, png_info* info_ptr,
   }
 
   png_set_compression_level(png_ptr, compression_level);
+  png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, png_filters);
 
   // Set our callback for libpng to give us the data.
   png_set_write_fn(png_ptr, state, EncoderWriteCallback, FakeFlushCallback);
@@ -626,14 +780,27 @@ bool DoLibpngWrite(png_struct* png_ptr, png_info* info_ptr,
   return true;
 }
 
-bool EncodeWithCompressionLevel(const unsigned char* input,
-                                PNGCodec::ColorFormat format,
-                                const Size& size,
-                                int row_byte_width,
-                                bool discard_transparency,
-                                const std::vector<PNGCodec::Comment>& comments,
-                                int compression_level,
-                                std::vector<unsigned char>* output) {
+int GetPNGFilters(PNGCodec::FilterStrategy filter_strategy) {
+  switch (filter_strategy) {
+    case PNGCodec::FILTER_ADAPTIVE:
+      return PNG_ALL_FILTERS;
+    case PNGCodec::FILTER_NONE:
+      return PNG_FILTER_NONE;
+    case PNGCodec::FILTER_SUB:
+      return PNG_FILTER_SUB;
+  }
+  NOTREACHED();
+  return PNG_ALL_FILTERS;
+}
+
+bool EncodeWithOptions(const unsigned char* input,
+                       PNGCodec::ColorFormat format,
+                       const Size& size,
+                       int row_byte_width,
+                       bool discard_transparency,
+                       const std::vector<PNGCodec::Comment>& comments,
+                       const PNGCodec::EncodeOptions& options,
+                       std::vector<unsigned char>* output) {
   // Run to convert an input row into the output row format, NULL means no
   // conversion is necessary.
   FormatConverter converter = NULL;
@@ -723,15 +890,17 @@ bool EncodeWithCompressionLevel(const unsigned char* input,
   PngEncoderState state(output);
   bool success = DoLibpngWrite(png_ptr, info_ptr, &state,
                                size.width(), size.height(), row_byte_width,
-                               input, compression_level, png_output_color_type,
-                               output_color_components, converter, comments);
+                               input, options.compression_level,
+                               GetPNGFilters(options.filter_strategy),
+                               png_output_color_type, output_color_components,
+                               converter, comments);
 
   return success;
 }
 
 bool InternalEncodeSkBitmap(const SkBitmap& input,
                             bool discard_transparency,
-                            int compression_level,
+                            const PNGCodec::EncodeOptions& options,
                             std::vector<unsigned char>* output) {
   if (input.empty() || input.isNull())
     return false;
@@ -742,17 +911,26 @@ bool InternalEncodeSkBitmap(const SkBitmap& input,
   unsigned char* inputAddr = bpp == 1 ?
       reinterpret_cast<unsigned char*>(input.getAddr8(0, 0)) :
       reinterpret_cast<unsigned char*>(input.getAddr32(0, 0));    // bpp = 4
-  return EncodeWithCompressionLevel(
+  return EncodeWithOptions(
       inputAddr,
       PNGCodec::FORMAT_SkBitmap,
       Size(input.width(), input.height()),
       static_cast<int>(input.rowBytes()),
       discard_transparency,
       std::vector<PNGCodec::Comment>(),
-      compression_level,
+      options,
       output);
 }
 
+scoped_refptr<base::RefCountedBytes> EncodeSkBitmapToBytes(
+    const SkBitmap& input,
+    bool discard_transparency,
+    const PNGCodec::EncodeOptions& options) {
+  std::vector<unsigned char> output;
+  if (!InternalEncodeSkBitmap(input, discard_transparency, options, &output))
+    return nullptr;
+  return base::RefCountedBytes::TakeVector(&output);
+}
 
 }  // namespace
 
@@ -764,14 +942,14 @@ bool PNGCodec::Encode(const unsigned char* input,
                       bool discard_transparency,
                       const std::vector<Comment>& comments,
                       std::vector<unsigned char>* output) {
-  return EncodeWithCompressionLevel(input,
-                                    format,
-                                    size,
-                                    row_byte_width,
-                                    discard_transparency,
-                                    comments,
-                                    Z_DEFAULT_COMPRESSION,
-                                    output);
+  return EncodeWithOptions(input,
+                           format,
+                           size,
+                           row_byte_width,
+                           discard_transparency,
+                           comments,
+                           EncodeOptions(),
+                           output);
 }
 
 // static
@@ -780,7 +958,7 @@ bool PNGCodec::EncodeBGRASkBitmap(const SkBitmap& input,
                                   std::vector<unsigned char>* output) {
   return InternalEncodeSkBitmap(input,
                                 discard_transparency,
-                                Z_DEFAULT_COMPRESSION,
+                                EncodeOptions(),
                                 output);
 }
 
@@ -789,7 +967,7 @@ bool PNGCodec::EncodeA8SkBitmap(const SkBitmap& input,
                                 std::vector<unsigned char>* output) {
   return InternalEncodeSkBitmap(input,
                                 false,
-                                Z_DEFAULT_COMPRESSION,
+                                EncodeOptions(),
                                 output);
 }
 
@@ -797,12 +975,47 @@ bool PNGCodec::EncodeA8SkBitmap(const SkBitmap& input,
 bool PNGCodec::FastEncodeBGRASkBitmap(const SkBitmap& input,
                                       bool discard_transparency,
                                       std::vector<unsigned char>* output) {
+  EncodeOptions options;
+  options.compression_level = Z_BEST_SPEED;
   return InternalEncodeSkBitmap(input,
                                 discard_transparency,
-                                Z_BEST_SPEED,
+                                options,
                                 output);
 }
 
+// static
+bool PNGCodec::EncodeBGRASkBitmapWithOptions(
+    const SkBitmap& input,
+    bool discard_transparency,
+    const EncodeOptions& options,
+    std::vector<unsigned char>* output) {
+  return InternalEncodeSkBitmap(input, discard_transparency, options, output);
+}
+
+// static
+void PNGCodec::EncodeBGRASkBitmapAsync(
+    const SkBitmap& input,
+    bool discard_transparency,
+    const EncodeOptions& options,
+    const scoped_refptr<base::TaskRunner>& task_runner,
+    const EncodeCallback& callback) {
+  // The caller may draw into |input| once this returns, so unless it is
+  // immutable the task encodes a copy of it.
+  SkBitmap bitmap(input);
+  if (!input.isImmutable() && !input.copyTo(&bitmap, input.colorType()))
+    bitmap.reset();
+  base::PostTaskAndReplyWithResult(
+      task_runner.get(), FROM_HERE,
+      base::Bind(&EncodeSkBitmapToBytes, bitmap, discard_transparency,
+                 options),
+      callback);
+}
+
+PNGCodec::EncodeOptions::EncodeOptions()
+    : compression_level(Z_DEFAULT_COMPRESSION),
+      filter_strategy(FILTER_ADAPTIVE) {
+}
+
 PNGCodec::Comment::Comment(const std::string& k, const std::string& t)
     : key(k), text(t) {
 }
@@ -10,11 +10,18 @@
 #include <string>
 #include <vector>
 
+#include "base/callback_forward.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "ui/gfx/gfx_export.h"
 
 class SkBitmap;
 
+namespace base {
+class RefCountedBytes;
+class TaskRunner;
+}
+
 namespace gfx {
 
 class Size;
@@ -55,6 +62,36 @@ class GFX_EXPORT PNGCodec {
     std::string text;
   };
 
+  // The row filters libpng may apply before compressing the image. Filtering
+  // makes photos compress much better, at a cost in encoding time.
+  enum FilterStrategy {
+    // libpng picks the best filter for each row. This compresses the most and
+    // is the slowest.
+    FILTER_ADAPTIVE,
+    // Rows are compressed as is. The fastest, and fine for flat UI graphics.
+    FILTER_NONE,
+    // Pixels are stored as differences with their left neighbors. Gets most
+    // of the gain of adaptive filtering on photos and thumbnails, for a small
+    // fraction of its cost.
+    FILTER_SUB,
+  };
+
+  // Trades encoding speed for size.
+  struct GFX_EXPORT EncodeOptions {
+    EncodeOptions();
+
+    // The zlib compression level, from 0 (no compression) to 9 (the best
+    // compression), or -1 for the zlib default. Defaults to -1.
+    int compression_level;
+
+    // Defaults to FILTER_ADAPTIVE.
+    FilterStrategy filter_strategy;
+  };
+
+  // Called with the PNG data, or null on failure.
+  typedef base::Callback<void(scoped_refptr<base::RefCountedBytes>)>
+      EncodeCallback;
+
   // Encodes the given raw 'input' data, with each pixel being represented as
   // given in 'format'. The encoded PNG data will be written into the supplied
   // vector and true will be returned on success. On failure (false), the
@@ -96,6 +133,24 @@ class GFX_EXPORT PNGCodec {
                                      bool discard_transparency,
                                      std::vector<unsigned char>* output);
 
+  // Like EncodeBGRASkBitmap(), but compresses with the zlib level and the
+  // row filters of |options|.
+  static bool EncodeBGRASkBitmapWithOptions(const SkBitmap& input,
+                                            bool discard_transparency,
+                                            const EncodeOptions& options,
+                                            std::vector<unsigned char>* output);
+
+  // Like EncodeBGRASkBitmapWithOptions(), but encodes on |task_runner| and
+  // replies to |callback| on the calling thread, which must have a
+  // ThreadTaskRunnerHandle. Unless |input| is immutable, a copy of its pixels
+  // is encoded, so the caller may keep drawing into it.
+  static void EncodeBGRASkBitmapAsync(
+      const SkBitmap& input,
+      bool discard_transparency,
+      const EncodeOptions& options,
+      const scoped_refptr<base::TaskRunner>& task_runner,
+      const EncodeCallback& callback);
+
   // Call PNGCodec::Encode on the supplied SkBitmap |input|, which is assumed
   // to be kA8_Config, 8 bits per pixel. The bitmap is encoded as a grayscale
   // PNG with alpha used for color intensity. The |output| param is passed
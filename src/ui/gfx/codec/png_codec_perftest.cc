@@ -0,0 +1,103 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorPriv.h"
+#include "third_party/zlib/zlib.h"
+#include "ui/gfx/codec/png_codec.h"
+
+namespace gfx {
+
+namespace {
+
+const int kIterations = 50;
+
+// The sizes of the page thumbnails of the most visited sites, at 1x and 2x.
+const struct {
+  int width;
+  int height;
+} kThumbnailSizes[] = {
+    {212, 132},
+    {424, 264},
+};
+
+// Draws something that compresses like a page thumbnail: a header bar and
+// lines of text over a flat background, next to a photo-like area of smooth
+// gradients with some noise.
+void MakeThumbnail(int width, int height, SkBitmap* bitmap) {
+  bitmap->allocN32Pixels(width, height);
+  uint32_t seed = 1;
+  for (int y = 0; y < height; ++y) {
+    uint32_t* row = bitmap->getAddr32(0, y);
+    for (int x = 0; x < width; ++x) {
+      seed = seed * 1103515245 + 12345;
+      const int noise = static_cast<int>((seed >> 16) & 0xF);
+      if (y < height / 8) {
+        row[x] = SkPackARGB32(255, 66, 133, 244);
+      } else if (x < width / 2) {
+        const bool text = (y / 4) % 3 == 0 && (x / 3) % 7 != 0;
+        row[x] = text ? SkPackARGB32(255, 32, 33, 36)
+                      : SkPackARGB32(255, 255, 255, 255);
+      } else {
+        row[x] = SkPackARGB32(255, (x * 255 / width + noise) & 0xFF,
+                              (y * 255 / height + noise) & 0xFF,
+                              (128 + noise) & 0xFF);
+      }
+    }
+  }
+}
+
+void EncodeThumbnails(const char* trace,
+                      const PNGCodec::EncodeOptions& options) {
+  for (size_t i = 0; i < arraysize(kThumbnailSizes); ++i) {
+    SkBitmap thumbnail;
+    MakeThumbnail(kThumbnailSizes[i].width, kThumbnailSizes[i].height,
+                  &thumbnail);
+
+    std::vector<unsigned char> encoded;
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int j = 0; j < kIterations; ++j) {
+      ASSERT_TRUE(PNGCodec::EncodeBGRASkBitmapWithOptions(thumbnail, true,
+                                                          options, &encoded));
+    }
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    const std::string modifier = base::StringPrintf(
+        "_%dx%d", kThumbnailSizes[i].width, kThumbnailSizes[i].height);
+    const double megapixels = static_cast<double>(kIterations) *
+                              thumbnail.width() * thumbnail.height() / 1e6;
+    perf_test::PrintResult("png_encode_throughput", modifier, trace,
+                           megapixels / elapsed.InSecondsF(), "MP/s", true);
+    perf_test::PrintResult("png_encode_size", modifier, trace, encoded.size(),
+                           "bytes", true);
+  }
+}
+
+}  // namespace
+
+TEST(PNGCodecPerfTest, EncodeThumbnails) {
+  PNGCodec::EncodeOptions options;
+  EncodeThumbnails("default", options);
+
+  options.compression_level = Z_BEST_SPEED;
+  EncodeThumbnails("level_1", options);
+
+  options.filter_strategy = PNGCodec::FILTER_SUB;
+  EncodeThumbnails("level_1_filter_sub", options);
+
+  options.filter_strategy = PNGCodec::FILTER_NONE;
+  EncodeThumbnails("level_1_filter_none", options);
+}
+
+}  // namespace gfx
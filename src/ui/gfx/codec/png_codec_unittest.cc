@@ -8,8 +8,13 @@
 #include <algorithm>
 #include <cmath>
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/test/test_simple_task_runner.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/libpng/png.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -268,6 +273,23 @@ void MakeTestBGRASkBitmap(int w, int h, SkBitmap* bmp) {
     src_data[i] = SkPreMultiplyARGB(i % 255, i % 250, i % 245, i % 240);
 }
 
+// Makes a bitmap with runs of opaque pixels of varying lengths between
+// translucent ones.
+void MakeMostlyOpaqueTestBGRASkBitmap(int w, int h, SkBitmap* bmp) {
+  bmp->allocN32Pixels(w, h);
+
+  uint32_t* src_data = bmp->getAddr32(0, 0);
+  for (int i = 0; i < w * h; i++) {
+    const int alpha = i % 23 == 0 || i % 29 == 0 ? i % 240 : 255;
+    src_data[i] = SkPreMultiplyARGB(alpha, i % 255, i % 250, i % 245);
+  }
+}
+
+void SaveEncodedData(scoped_refptr<base::RefCountedBytes>* result,
+                     scoped_refptr<base::RefCountedBytes> encoded) {
+  *result = encoded;
+}
+
 void MakeTestA8SkBitmap(int w, int h, SkBitmap* bmp) {
   bmp->allocPixels(SkImageInfo::MakeA8(w, h));
 
@@ -362,6 +384,61 @@ TEST(PNGCodec, EncodeDecodeBGRA) {
   ASSERT_TRUE(original == decoded);
 }
 
+// The row converters handle several pixels per step; an odd width also tests
+// the pixels left over at the end of the rows.
+TEST(PNGCodec, EncodeDecodeBGRAOddWidth) {
+  const int w = 37, h = 3;
+
+  std::vector<unsigned char> original;
+  MakeRGBAImage(w, h, true, &original);
+
+  std::vector<unsigned char> encoded;
+  ASSERT_TRUE(PNGCodec::Encode(&original[0], PNGCodec::FORMAT_BGRA,
+                               Size(w, h), w * 4, false,
+                               std::vector<PNGCodec::Comment>(),
+                               &encoded));
+  std::vector<unsigned char> decoded;
+  int outw, outh;
+  ASSERT_TRUE(PNGCodec::Decode(&encoded[0], encoded.size(),
+                               PNGCodec::FORMAT_BGRA, &decoded,
+                               &outw, &outh));
+  ASSERT_EQ(w, outw);
+  ASSERT_EQ(h, outh);
+  EXPECT_EQ(original, decoded);
+
+  // Discarding the alpha channel.
+  ASSERT_TRUE(PNGCodec::Encode(&original[0], PNGCodec::FORMAT_BGRA,
+                               Size(w, h), w * 4, true,
+                               std::vector<PNGCodec::Comment>(),
+                               &encoded));
+  ASSERT_TRUE(PNGCodec::Decode(&encoded[0], encoded.size(),
+                               PNGCodec::FORMAT_RGB, &decoded,
+                               &outw, &outh));
+  ASSERT_EQ(w, outw);
+  ASSERT_EQ(h, outh);
+  ASSERT_EQ(static_cast<size_t>(w * h * 3), decoded.size());
+  for (int i = 0; i < w * h; i++) {
+    EXPECT_EQ(original[i * 4 + 2], decoded[i * 3]);
+    EXPECT_EQ(original[i * 4 + 1], decoded[i * 3 + 1]);
+    EXPECT_EQ(original[i * 4], decoded[i * 3 + 2]);
+  }
+
+  // And from RGBA.
+  ASSERT_TRUE(PNGCodec::Encode(&original[0], PNGCodec::FORMAT_RGBA,
+                               Size(w, h), w * 4, true,
+                               std::vector<PNGCodec::Comment>(),
+                               &encoded));
+  ASSERT_TRUE(PNGCodec::Decode(&encoded[0], encoded.size(),
+                               PNGCodec::FORMAT_RGB, &decoded,
+                               &outw, &outh));
+  ASSERT_EQ(static_cast<size_t>(w * h * 3), decoded.size());
+  for (int i = 0; i < w * h; i++) {
+    EXPECT_EQ(original[i * 4], decoded[i * 3]);
+    EXPECT_EQ(original[i * 4 + 1], decoded[i * 3 + 1]);
+    EXPECT_EQ(original[i * 4 + 2], decoded[i * 3 + 2]);
+  }
+}
+
 TEST(PNGCodec, DecodePalette) {
   const int w = 20, h = 20;
 
@@ -1188,5 +1265,110 @@ TEST(PNGCodec, EncodeDecodeWithVaryingCompressionLevels) {
   EXPECT_TRUE(BitmapsAreEqual(decoded, original_bitmap));
 }
 
+TEST(PNGCodec, EncodeMostlyOpaqueBGRASkBitmap) {
+  const int w = 45, h = 7;
+
+  SkBitmap original_bitmap;
+  MakeMostlyOpaqueTestBGRASkBitmap(w, h, &original_bitmap);
+
+  for (bool discard_transparency : {false, true}) {
+    std::vector<unsigned char> encoded;
+    ASSERT_TRUE(PNGCodec::EncodeBGRASkBitmap(original_bitmap,
+                                             discard_transparency, &encoded));
+    SkBitmap decoded_bitmap;
+    ASSERT_TRUE(PNGCodec::Decode(&encoded.front(), encoded.size(),
+                                 &decoded_bitmap));
+
+    for (int y = 0; y < h; y++) {
+      for (int x = 0; x < w; x++) {
+        uint32_t original_pixel = original_bitmap.getAddr32(0, y)[x];
+        uint32_t decoded_pixel = decoded_bitmap.getAddr32(0, y)[x];
+        if (discard_transparency) {
+          uint32_t unpremultiplied =
+              SkUnPreMultiply::PMColorToColor(original_pixel);
+          EXPECT_TRUE(NonAlphaColorsClose(unpremultiplied, decoded_pixel));
+        } else {
+          EXPECT_TRUE(ColorsClose(original_pixel, decoded_pixel));
+        }
+      }
+    }
+  }
+}
+
+TEST(PNGCodec, EncodeBGRASkBitmapWithOptions) {
+  const int w = 20, h = 20;
+
+  SkBitmap original_bitmap;
+  MakeTestBGRASkBitmap(w, h, &original_bitmap);
+
+  const PNGCodec::FilterStrategy kFilterStrategies[] = {
+      PNGCodec::FILTER_ADAPTIVE, PNGCodec::FILTER_NONE, PNGCodec::FILTER_SUB};
+  for (PNGCodec::FilterStrategy filter_strategy : kFilterStrategies) {
+    for (int compression_level = Z_NO_COMPRESSION;
+         compression_level <= Z_BEST_COMPRESSION; compression_level += 3) {
+      PNGCodec::EncodeOptions options;
+      options.compression_level = compression_level;
+      options.filter_strategy = filter_strategy;
+      std::vector<unsigned char> encoded;
+      ASSERT_TRUE(PNGCodec::EncodeBGRASkBitmapWithOptions(
+          original_bitmap, false, options, &encoded));
+
+      SkBitmap decoded;
+      ASSERT_TRUE(PNGCodec::Decode(&encoded[0], encoded.size(), &decoded));
+      EXPECT_TRUE(BitmapsAreEqual(decoded, original_bitmap));
+    }
+  }
+
+  // Storing the rows without compressing them makes a bigger image.
+  PNGCodec::EncodeOptions stored_options;
+  stored_options.compression_level = Z_NO_COMPRESSION;
+  stored_options.filter_strategy = PNGCodec::FILTER_NONE;
+  std::vector<unsigned char> encoded_stored;
+  ASSERT_TRUE(PNGCodec::EncodeBGRASkBitmapWithOptions(
+      original_bitmap, false, stored_options, &encoded_stored));
+  std::vector<unsigned char> encoded_default;
+  ASSERT_TRUE(PNGCodec::EncodeBGRASkBitmapWithOptions(
+      original_bitmap, false, PNGCodec::EncodeOptions(), &encoded_default));
+  EXPECT_GT(encoded_stored.size(), encoded_default.size());
+}
+
+TEST(PNGCodec, EncodeBGRASkBitmapAsync) {
+  base::MessageLoop message_loop;
+  scoped_refptr<base::TestSimpleTaskRunner> task_runner(
+      new base::TestSimpleTaskRunner);
+  const int w = 20, h = 20;
+
+  SkBitmap original_bitmap;
+  MakeTestBGRASkBitmap(w, h, &original_bitmap);
+  SkBitmap expected_bitmap;
+  ASSERT_TRUE(original_bitmap.copyTo(&expected_bitmap));
+
+  scoped_refptr<base::RefCountedBytes> encoded;
+  PNGCodec::EncodeBGRASkBitmapAsync(original_bitmap, false,
+                                    PNGCodec::EncodeOptions(), task_runner,
+                                    base::Bind(&SaveEncodedData, &encoded));
+
+  // Drawing into the bitmap before the encoding runs does not change the
+  // image.
+  original_bitmap.eraseColor(SK_ColorRED);
+  task_runner->RunUntilIdle();
+  EXPECT_FALSE(encoded);
+  base::RunLoop().RunUntilIdle();
+  ASSERT_TRUE(encoded);
+
+  SkBitmap decoded;
+  ASSERT_TRUE(PNGCodec::Decode(encoded->front(), encoded->size(), &decoded));
+  EXPECT_TRUE(BitmapsAreEqual(decoded, expected_bitmap));
+
+  // Empty bitmaps fail to encode.
+  encoded = new base::RefCountedBytes;
+  PNGCodec::EncodeBGRASkBitmapAsync(SkBitmap(), false,
+                                    PNGCodec::EncodeOptions(), task_runner,
+                                    base::Bind(&SaveEncodedData, &encoded));
+  task_runner->RunUntilIdle();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(encoded);
+}
+
 
 }  // namespace gfx
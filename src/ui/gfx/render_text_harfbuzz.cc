@@ -12,6 +12,7 @@
 #include "base/i18n/char_iterator.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/pickle.h"
 #include "base/profiler/scoped_tracker.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -29,6 +30,7 @@
 #include "ui/gfx/geometry/safe_integer_conversions.h"
 #include "ui/gfx/harfbuzz_font_skia.h"
 #include "ui/gfx/range/range_f.h"
+#include "ui/gfx/shaped_run_cache.h"
 #include "ui/gfx/skia_util.h"
 #include "ui/gfx/text_utils.h"
 #include "ui/gfx/utf16_indexing.h"
@@ -49,6 +51,14 @@ const size_t kMaxTextLength = 10000;
 // character to belong to more scripts.
 const size_t kMaxScripts = 5;
 
+// Runs longer than this are not cached, since the shaped run cache is meant
+// for the short strings of labels, menus and lists.
+const size_t kMaxCachedRunLength = 256;
+
+// The number of characters on each side of a run that HarfBuzz looks at when
+// shaping the run, see HB_BUFFER_CONTEXT_LENGTH.
+const size_t kShapingContextLength = 5;
+
 // Returns true if characters of |block_code| may trigger font fallback.
 bool IsUnusualBlockCode(UBlockCode block_code) {
   return block_code == UBLOCK_GEOMETRIC_SHAPES ||
@@ -564,6 +574,73 @@ struct CaseInsensitiveCompare {
   }
 };
 
+// Returns the key of the shaped run cache for shaping |run| of |text| with
+// |font| and |params|. The key covers the characters around the run which
+// HarfBuzz uses as context, and everything else the shaping depends on.
+std::string GetShapedRunCacheKey(const base::string16& text,
+                                 const Font& font,
+                                 const FontRenderParams& params,
+                                 bool subpixel_rendering_suppressed,
+                                 float glyph_width_for_test,
+                                 const internal::TextRunHarfBuzz& run) {
+  const size_t context_start =
+      run.range.start() -
+      std::min(run.range.start(), kShapingContextLength);
+  const size_t context_end =
+      std::min(text.length(), run.range.end() + kShapingContextLength);
+
+  base::Pickle pickle;
+  pickle.WriteString16(
+      text.substr(context_start, context_end - context_start));
+  pickle.WriteUInt32(static_cast<uint32_t>(run.range.start() - context_start));
+  pickle.WriteUInt32(static_cast<uint32_t>(run.range.length()));
+  pickle.WriteString(font.GetFontName());
+  pickle.WriteInt(run.font_size);
+  pickle.WriteBool(run.italic);
+  pickle.WriteInt(static_cast<int>(run.weight));
+  pickle.WriteInt(run.script);
+  pickle.WriteBool(run.is_rtl);
+  pickle.WriteBool(params.antialiasing);
+  pickle.WriteBool(params.subpixel_positioning);
+  pickle.WriteBool(params.autohinter);
+  pickle.WriteBool(params.use_bitmaps);
+  pickle.WriteInt(params.hinting);
+  pickle.WriteInt(params.subpixel_rendering);
+  pickle.WriteBool(subpixel_rendering_suppressed);
+  pickle.WriteFloat(glyph_width_for_test);
+  return std::string(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+// Copies the glyphs of |shaped_run| into |run|.
+void SetGlyphsFromShapedRun(const internal::ShapedRun& shaped_run,
+                            internal::TextRunHarfBuzz* run) {
+  run->glyph_count = shaped_run.glyphs.size();
+  run->glyphs.reset(new uint16_t[run->glyph_count]);
+  std::copy(shaped_run.glyphs.begin(), shaped_run.glyphs.end(),
+            run->glyphs.get());
+  run->positions.reset(new SkPoint[run->glyph_count]);
+  std::copy(shaped_run.positions.begin(), shaped_run.positions.end(),
+            run->positions.get());
+  run->glyph_to_char.resize(run->glyph_count);
+  for (size_t i = 0; i < run->glyph_count; ++i)
+    run->glyph_to_char[i] = shaped_run.glyph_to_char[i] + run->range.start();
+  run->width = shaped_run.width;
+}
+
+// Returns the glyphs of |run| for the shaped run cache.
+internal::ShapedRun GetShapedRun(const internal::TextRunHarfBuzz& run) {
+  internal::ShapedRun shaped_run;
+  shaped_run.glyphs.assign(run.glyphs.get(),
+                           run.glyphs.get() + run.glyph_count);
+  shaped_run.positions.assign(run.positions.get(),
+                              run.positions.get() + run.glyph_count);
+  shaped_run.glyph_to_char.reserve(run.glyph_count);
+  for (uint32_t glyph_char : run.glyph_to_char)
+    shaped_run.glyph_to_char.push_back(glyph_char - run.range.start());
+  shaped_run.width = run.width;
+  return shaped_run;
+}
+
 }  // namespace
 
 namespace internal {
@@ -1480,6 +1557,21 @@ bool RenderTextHarfBuzz::ShapeRunWithFont(const base::string16& text,
   run->font = font;
   run->render_params = params;
 
+  // Reuse the glyphs of an identical run shaped by any RenderText, which is
+  // common in lists and menus.
+  std::string cache_key;
+  if (run->range.length() <= kMaxCachedRunLength) {
+    cache_key = GetShapedRunCacheKey(text, font, params,
+                                     subpixel_rendering_suppressed(),
+                                     glyph_width_for_test_, *run);
+    internal::ShapedRun shaped_run;
+    if (internal::ShapedRunCache::GetInstance()->Get(cache_key,
+                                                     &shaped_run)) {
+      SetGlyphsFromShapedRun(shaped_run, run);
+      return true;
+    }
+  }
+
   hb_font_t* harfbuzz_font = CreateHarfBuzzFont(
       run->skia_face, SkIntToScalar(run->font_size), run->render_params,
       subpixel_rendering_suppressed());
@@ -1536,6 +1628,9 @@ bool RenderTextHarfBuzz::ShapeRunWithFont(const base::string16& text,
 
   hb_buffer_destroy(buffer);
   hb_font_destroy(harfbuzz_font);
+
+  if (!cache_key.empty())
+    internal::ShapedRunCache::GetInstance()->Put(cache_key, GetShapedRun(*run));
   return true;
 }
 
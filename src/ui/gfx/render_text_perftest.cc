@@ -0,0 +1,80 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string16.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/render_text.h"
+#include "ui/gfx/shaped_run_cache.h"
+
+namespace gfx {
+
+namespace {
+
+const int kIterations = 20;
+
+// The number of rows of the list, and of distinct labels among them. Like in
+// program guides and settings lists, most labels repeat across rows.
+const int kRowCount = 500;
+const int kDistinctLabelCount = 50;
+
+const char* const kLabelFormats[] = {
+    "Channel %d",
+    "News at %d",
+    "Movie: The Return of the %dth Knight",
+    "Settings > Picture > Mode %d",
+    "%d:00 PM",
+};
+
+class RenderTextPerfTest : public testing::Test {
+ protected:
+  // Lays out |kRowCount| labels like a list view would, each in its own
+  // RenderText, and returns how long it took.
+  base::TimeDelta LayOutList(bool clear_cache_each_time) {
+    std::vector<base::string16> labels;
+    for (int i = 0; i < kRowCount; ++i) {
+      const int label = i % kDistinctLabelCount;
+      labels.push_back(base::UTF8ToUTF16(base::StringPrintf(
+          kLabelFormats[label % arraysize(kLabelFormats)], label)));
+    }
+
+    internal::ShapedRunCache::GetInstance()->Clear();
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kIterations; ++i) {
+      if (clear_cache_each_time)
+        internal::ShapedRunCache::GetInstance()->Clear();
+      for (const base::string16& label : labels) {
+        std::unique_ptr<RenderText> render_text(RenderText::CreateInstance());
+        render_text->SetDisplayRect(Rect(0, 0, 300, 24));
+        render_text->SetText(label);
+        EXPECT_LT(0, render_text->GetStringSize().width());
+      }
+    }
+    return base::TimeTicks::Now() - start;
+  }
+};
+
+}  // namespace
+
+TEST_F(RenderTextPerfTest, ListLayout) {
+  const double row_count = static_cast<double>(kIterations * kRowCount);
+  perf_test::PrintResult(
+      "render_text_list_layout", "", "cold_cache",
+      row_count / LayOutList(true).InSecondsF(), "rows/s", true);
+  perf_test::PrintResult(
+      "render_text_list_layout", "", "warm_cache",
+      row_count / LayOutList(false).InSecondsF(), "rows/s", true);
+}
+
+}  // namespace gfx
@@ -33,6 +33,7 @@
 #include "ui/gfx/range/range.h"
 #include "ui/gfx/range/range_f.h"
 #include "ui/gfx/render_text_harfbuzz.h"
+#include "ui/gfx/shaped_run_cache.h"
 #include "ui/gfx/text_utils.h"
 
 #if defined(OS_WIN)
@@ -3039,6 +3040,49 @@ TEST_F(RenderTextTest, HarfBuzz_NonExistentFont) {
                                FontRenderParams(), run);
 }
 
+// Ensure identical runs are shaped once and reused at any position in a text.
+TEST_F(RenderTextTest, HarfBuzz_ShapedRunCache) {
+  internal::ShapedRunCache* cache = internal::ShapedRunCache::GetInstance();
+  cache->Clear();
+
+  RenderTextHarfBuzz first;
+  first.SetText(ASCIIToUTF16("Channel 7"));
+  first.EnsureLayout();
+  const size_t entry_count = cache->GetEntryCount();
+  EXPECT_LT(0U, entry_count);
+
+  RenderTextHarfBuzz second;
+  second.SetText(ASCIIToUTF16("Channel 7"));
+  second.EnsureLayout();
+  EXPECT_EQ(entry_count, cache->GetEntryCount());
+
+  const internal::TextRunHarfBuzz* first_run = first.GetRunList()->runs()[0];
+  const internal::TextRunHarfBuzz* second_run = second.GetRunList()->runs()[0];
+  ASSERT_EQ(first_run->glyph_count, second_run->glyph_count);
+  EXPECT_EQ(first_run->width, second_run->width);
+  for (size_t i = 0; i < first_run->glyph_count; ++i) {
+    EXPECT_EQ(first_run->glyphs[i], second_run->glyphs[i]);
+    EXPECT_EQ(first_run->positions[i], second_run->positions[i]);
+    EXPECT_EQ(first_run->glyph_to_char[i], second_run->glyph_to_char[i]);
+  }
+
+  // A run reused at another position in a text gets the glyph to character
+  // mapping of that position.
+  RenderTextHarfBuzz render_text;
+  render_text.SetText(WideToUTF16(L"\x0645\x0631\x062D\x0628\x0627 abc"));
+  render_text.EnsureLayout();
+  const internal::TextRunHarfBuzz* last_run =
+      render_text.GetRunList()->runs().back();
+  const std::vector<uint32_t> glyph_to_char = last_run->glyph_to_char;
+  render_text.SetText(
+      WideToUTF16(L"\x0627\x0645\x0631\x062D\x0628\x0627 abc"));
+  render_text.EnsureLayout();
+  last_run = render_text.GetRunList()->runs().back();
+  ASSERT_EQ(glyph_to_char.size(), last_run->glyph_to_char.size());
+  for (size_t i = 0; i < glyph_to_char.size(); ++i)
+    EXPECT_EQ(glyph_to_char[i] + 1, last_run->glyph_to_char[i]);
+}
+
 // Ensure an empty run returns sane values to queries.
 TEST_F(RenderTextTest, HarfBuzz_EmptyRun) {
   internal::TextRunHarfBuzz run((Font()));
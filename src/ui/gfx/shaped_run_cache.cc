@@ -0,0 +1,128 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gfx/shaped_run_cache.h"
+
+#include "base/lazy_instance.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
+
+namespace gfx {
+namespace internal {
+
+namespace {
+
+// Enough for the runs of the labels of a few screens full of lists and menus,
+// which are a few dozen bytes each.
+const size_t kMaxGlobalCacheSizeBytes = 1024 * 1024;
+
+struct GlobalShapedRunCache {
+  GlobalShapedRunCache() : cache(kMaxGlobalCacheSizeBytes) {
+    base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+        &cache, "ShapedRunCache", nullptr);
+  }
+
+  ShapedRunCache cache;
+};
+
+base::LazyInstance<GlobalShapedRunCache>::Leaky g_shaped_run_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+size_t GetEntrySize(const std::string& key, const ShapedRun& run) {
+  return key.size() + run.EstimateMemoryUsage();
+}
+
+}  // namespace
+
+ShapedRun::ShapedRun() : width(0.0f) {}
+
+ShapedRun::ShapedRun(const ShapedRun& other) = default;
+
+ShapedRun::~ShapedRun() {}
+
+size_t ShapedRun::EstimateMemoryUsage() const {
+  return sizeof(*this) + glyphs.capacity() * sizeof(uint16_t) +
+         positions.capacity() * sizeof(SkPoint) +
+         glyph_to_char.capacity() * sizeof(uint32_t);
+}
+
+// static
+ShapedRunCache* ShapedRunCache::GetInstance() {
+  return &g_shaped_run_cache.Get().cache;
+}
+
+ShapedRunCache::ShapedRunCache(size_t max_size_bytes)
+    : max_size_bytes_(max_size_bytes),
+      cache_(base::MRUCache<std::string, ShapedRun>::NO_AUTO_EVICT),
+      size_bytes_(0) {}
+
+ShapedRunCache::~ShapedRunCache() {}
+
+bool ShapedRunCache::Get(const std::string& key, ShapedRun* run) {
+  base::AutoLock lock(lock_);
+  auto it = cache_.Get(key);
+  if (it == cache_.end())
+    return false;
+  *run = it->second;
+  return true;
+}
+
+void ShapedRunCache::Put(const std::string& key, const ShapedRun& run) {
+  base::AutoLock lock(lock_);
+  auto it = cache_.Peek(key);
+  if (it != cache_.end())
+    size_bytes_ -= GetEntrySize(it->first, it->second);
+  cache_.Put(key, run);
+  size_bytes_ += GetEntrySize(key, run);
+  EvictIfNeeded();
+}
+
+void ShapedRunCache::Clear() {
+  base::AutoLock lock(lock_);
+  cache_.Clear();
+  size_bytes_ = 0;
+}
+
+size_t ShapedRunCache::GetSizeInBytes() const {
+  base::AutoLock lock(lock_);
+  return size_bytes_;
+}
+
+size_t ShapedRunCache::GetEntryCount() const {
+  base::AutoLock lock(lock_);
+  return cache_.size();
+}
+
+bool ShapedRunCache::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  base::AutoLock lock(lock_);
+  base::trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump("font_caches/shaped_runs");
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                  base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                  size_bytes_);
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameObjectCount,
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  cache_.size());
+  const char* system_allocator_name =
+      base::trace_event::MemoryDumpManager::GetInstance()
+          ->system_allocator_pool_name();
+  if (system_allocator_name)
+    pmd->AddSuballocation(dump->guid(), system_allocator_name);
+  return true;
+}
+
+void ShapedRunCache::EvictIfNeeded() {
+  lock_.AssertAcquired();
+  while (size_bytes_ > max_size_bytes_ && !cache_.empty()) {
+    auto oldest = cache_.rbegin();
+    size_bytes_ -= GetEntrySize(oldest->first, oldest->second);
+    cache_.Erase(oldest);
+  }
+}
+
+}  // namespace internal
+}  // namespace gfx
@@ -0,0 +1,91 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_GFX_SHAPED_RUN_CACHE_H_
+#define UI_GFX_SHAPED_RUN_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "third_party/skia/include/core/SkPoint.h"
+#include "ui/gfx/gfx_export.h"
+
+namespace gfx {
+namespace internal {
+
+// The glyphs of a text run as shaped by HarfBuzz. |glyph_to_char| is relative
+// to the start of the run, so that the same run can be reused at any position
+// in a text.
+struct GFX_EXPORT ShapedRun {
+  ShapedRun();
+  ShapedRun(const ShapedRun& other);
+  ~ShapedRun();
+
+  // Returns the approximate number of bytes used by the run.
+  size_t EstimateMemoryUsage() const;
+
+  std::vector<uint16_t> glyphs;
+  std::vector<SkPoint> positions;
+  std::vector<uint32_t> glyph_to_char;
+  float width;
+};
+
+// A cache of shaped runs, keyed by everything the shaping depends on: the text
+// of the run and its context, the font, its size and style, and the render
+// params. The least recently used runs are evicted once the cache grows
+// beyond |max_size_bytes|. Lists, menus and grids draw the same strings over
+// and over in many RenderText instances, so a process-wide instance lets them
+// shape each string only once. Can be used on any thread.
+class GFX_EXPORT ShapedRunCache : public base::trace_event::MemoryDumpProvider {
+ public:
+  // Returns the process-wide instance, which reports its size to
+  // memory-infra.
+  static ShapedRunCache* GetInstance();
+
+  explicit ShapedRunCache(size_t max_size_bytes);
+  ~ShapedRunCache() override;
+
+  // Copies the run cached under |key| into |run| and marks it as the most
+  // recently used. Returns false if there is no such run.
+  bool Get(const std::string& key, ShapedRun* run);
+
+  // Caches |run| under |key|, replacing the run cached under it, if any.
+  void Put(const std::string& key, const ShapedRun& run);
+
+  // Evicts all the runs.
+  void Clear();
+
+  size_t GetSizeInBytes() const;
+  size_t GetEntryCount() const;
+
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
+ private:
+  // Evicts the least recently used runs until the cache fits in
+  // |max_size_bytes_|. |lock_| must be held.
+  void EvictIfNeeded();
+
+  const size_t max_size_bytes_;
+
+  mutable base::Lock lock_;
+  base::MRUCache<std::string, ShapedRun> cache_;
+  // The sizes of the keys and runs in |cache_|.
+  size_t size_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShapedRunCache);
+};
+
+}  // namespace internal
+}  // namespace gfx
+
+#endif  // UI_GFX_SHAPED_RUN_CACHE_H_
@@ -0,0 +1,80 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gfx/shaped_run_cache.h"
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace gfx {
+namespace internal {
+
+namespace {
+
+ShapedRun MakeShapedRun(size_t glyph_count) {
+  ShapedRun run;
+  for (size_t i = 0; i < glyph_count; ++i) {
+    run.glyphs.push_back(static_cast<uint16_t>(i + 1));
+    run.positions.push_back(SkPoint::Make(10.0f * i, 0.0f));
+    run.glyph_to_char.push_back(static_cast<uint32_t>(i));
+  }
+  run.width = 10.0f * glyph_count;
+  return run;
+}
+
+}  // namespace
+
+TEST(ShapedRunCacheTest, GetAndPut) {
+  ShapedRunCache cache(1024 * 1024);
+  ShapedRun run;
+  EXPECT_FALSE(cache.Get("a", &run));
+
+  cache.Put("a", MakeShapedRun(3));
+  ASSERT_TRUE(cache.Get("a", &run));
+  EXPECT_EQ(3U, run.glyphs.size());
+  EXPECT_EQ(3U, run.positions.size());
+  EXPECT_EQ(3U, run.glyph_to_char.size());
+  EXPECT_EQ(30.0f, run.width);
+  EXPECT_EQ(1U, cache.GetEntryCount());
+
+  // Replacing a run keeps the size accounting right.
+  const size_t size = cache.GetSizeInBytes();
+  cache.Put("a", MakeShapedRun(6));
+  ASSERT_TRUE(cache.Get("a", &run));
+  EXPECT_EQ(6U, run.glyphs.size());
+  EXPECT_EQ(1U, cache.GetEntryCount());
+  EXPECT_LT(size, cache.GetSizeInBytes());
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get("a", &run));
+  EXPECT_EQ(0U, cache.GetEntryCount());
+  EXPECT_EQ(0U, cache.GetSizeInBytes());
+}
+
+TEST(ShapedRunCacheTest, EvictsLeastRecentlyUsed) {
+  const ShapedRun shaped_run = MakeShapedRun(8);
+  const size_t entry_size = std::string("a").size() +
+                            shaped_run.EstimateMemoryUsage();
+  ShapedRunCache cache(entry_size * 3);
+
+  cache.Put("a", shaped_run);
+  cache.Put("b", shaped_run);
+  cache.Put("c", shaped_run);
+  EXPECT_EQ(3U, cache.GetEntryCount());
+
+  // Using "a" makes "b" the least recently used run.
+  ShapedRun run;
+  EXPECT_TRUE(cache.Get("a", &run));
+  cache.Put("d", shaped_run);
+  EXPECT_EQ(3U, cache.GetEntryCount());
+  EXPECT_LE(cache.GetSizeInBytes(), entry_size * 3);
+  EXPECT_TRUE(cache.Get("a", &run));
+  EXPECT_FALSE(cache.Get("b", &run));
+  EXPECT_TRUE(cache.Get("c", &run));
+  EXPECT_TRUE(cache.Get("d", &run));
+}
+
+}  // namespace internal
+}  // namespace gfx
@@ -126,6 +126,13 @@ bool g_egl_window_fixed_size_supported = false;
 bool g_egl_surfaceless_context_supported = false;
 bool g_egl_surface_orientation_supported = false;
 bool g_use_direct_composition = false;
+bool g_egl_buffer_age_supported = false;
+
+typedef EGLBoolean (EGLAPIENTRYP SwapBuffersWithDamageProc)(EGLDisplay dpy,
+                                                            EGLSurface surface,
+                                                            EGLint* rects,
+                                                            EGLint n_rects);
+SwapBuffersWithDamageProc g_egl_swap_buffers_with_damage = NULL;
 
 class EGLSyncControlVSyncProvider : public SyncControlVSyncProvider {
  public:
@@ -466,6 +473,20 @@ bool GLSurfaceEGL::InitializeOneOff() {
   g_egl_surface_orientation_supported =
       HasEGLExtension("EGL_ANGLE_surface_orientation");
 
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableSwapBuffersWithDamage)) {
+    if (HasEGLExtension("EGL_KHR_swap_buffers_with_damage")) {
+      g_egl_swap_buffers_with_damage =
+          reinterpret_cast<SwapBuffersWithDamageProc>(
+              eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+    } else if (HasEGLExtension("EGL_EXT_swap_buffers_with_damage")) {
+      g_egl_swap_buffers_with_damage =
+          reinterpret_cast<SwapBuffersWithDamageProc>(
+              eglGetProcAddress("eglSwapBuffersWithDamageEXT"));
+    }
+    g_egl_buffer_age_supported = HasEGLExtension("EGL_EXT_buffer_age");
+  }
+
   // Need EGL_ANGLE_flexible_surface_compatibility to allow surfaces with and
   // without alpha to be bound to the same context.
   g_use_direct_composition =
@@ -615,6 +636,7 @@ NativeViewGLSurfaceEGL::NativeViewGLSurfaceEGL(EGLNativeWindowType window)
       enable_fixed_size_angle_(false),
       surface_(NULL),
       supports_post_sub_buffer_(false),
+      uses_swap_buffers_with_damage_(false),
       flips_vertically_(false),
       swap_interval_(1) {
 #if defined(OS_ANDROID)
@@ -712,6 +734,15 @@ bool NativeViewGLSurfaceEGL::Initialize(
     supports_post_sub_buffer_ = (surfaceVal && retVal) == EGL_TRUE;
   }
 
+  // cc only redraws the damaged rect on PostSubBuffer, so the rest of the
+  // back buffer has to hold the previous frame.
+  if (!supports_post_sub_buffer_ && g_egl_swap_buffers_with_damage &&
+      eglSurfaceAttrib(GetDisplay(), surface_, EGL_SWAP_BEHAVIOR,
+                       EGL_BUFFER_PRESERVED)) {
+    uses_swap_buffers_with_damage_ = true;
+    supports_post_sub_buffer_ = true;
+  }
+
   if (sync_provider)
     vsync_provider_.reset(sync_provider.release());
   else if (g_egl_sync_control_supported)
@@ -873,10 +904,19 @@ gfx::SwapResult NativeViewGLSurfaceEGL::PostSubBuffer(int x,
                                                       int width,
                                                       int height) {
   DCHECK(supports_post_sub_buffer_);
+  gfx::Size size = GetSize();
+  if (!size.IsEmpty()) {
+    TRACE_COUNTER1("gpu", "NativeViewGLSurfaceEGL::RedrawnPixelsPercent",
+                   100.0 * width * height / size.GetArea());
+  }
+
   if (!CommitAndClearPendingOverlays()) {
     DVLOG(1) << "Failed to commit pending overlay planes.";
     return gfx::SwapResult::SWAP_FAILED;
   }
+  if (uses_swap_buffers_with_damage_)
+    return SwapBuffersWithDamage(gfx::Rect(x, y, width, height));
+
   if (flips_vertically_) {
     // With EGL_SURFACE_ORIENTATION_INVERT_Y_ANGLE the contents are rendered
     // inverted, but the PostSubBuffer rectangle is still measured from the
@@ -898,6 +938,37 @@ gfx::SwapResult NativeViewGLSurfaceEGL::PostSubBuffer(int x,
   return gfx::SwapResult::SWAP_ACK;
 }
 
+gfx::SwapResult NativeViewGLSurfaceEGL::SwapBuffersWithDamage(
+    const gfx::Rect& rect) {
+  TRACE_EVENT2("gpu", "NativeViewGLSurfaceEGL::SwapBuffersWithDamage",
+               "width", rect.width(), "height", rect.height());
+
+  if (g_egl_buffer_age_supported) {
+    // A preserved back buffer always holds the previous frame. Anything else
+    // means the driver ignored EGL_BUFFER_PRESERVED and the frame is only
+    // partially valid.
+    EGLint buffer_age = 0;
+    if (eglQuerySurface(GetDisplay(), surface_, EGL_BUFFER_AGE_EXT,
+                        &buffer_age) &&
+        buffer_age != 1) {
+      DLOG(WARNING) << "Unexpected EGL buffer age " << buffer_age
+                    << " on a buffer preserving surface";
+    }
+  }
+
+  // Damage rects are measured from the bottom left, like PostSubBuffer.
+  EGLint damage[4] = {rect.x(), rect.y(), rect.width(), rect.height()};
+  if (flips_vertically_)
+    damage[1] = GetSize().height() - rect.y() - rect.height();
+
+  if (!g_egl_swap_buffers_with_damage(GetDisplay(), surface_, damage, 1)) {
+    DVLOG(1) << "eglSwapBuffersWithDamage failed with error "
+             << GetLastEGLErrorString();
+    return gfx::SwapResult::SWAP_FAILED;
+  }
+  return gfx::SwapResult::SWAP_ACK;
+}
+
 bool NativeViewGLSurfaceEGL::SupportsCommitOverlayPlanes() {
 #if defined(OS_ANDROID)
   return true;
@@ -132,8 +132,14 @@ class GL_EXPORT NativeViewGLSurfaceEGL : public GLSurfaceEGL {
   // fail to be committed.
   bool CommitAndClearPendingOverlays();
 
+  // Presents |rect| of a buffer preserving surface with
+  // eglSwapBuffersWithDamage. Backs PostSubBuffer() when
+  // |uses_swap_buffers_with_damage_| is set.
+  gfx::SwapResult SwapBuffersWithDamage(const gfx::Rect& rect);
+
   EGLSurface surface_;
   bool supports_post_sub_buffer_;
+  bool uses_swap_buffers_with_damage_;
   bool flips_vertically_;
 
   std::unique_ptr<gfx::VSyncProvider> vsync_provider_;
@@ -69,6 +69,11 @@ const char kGpuNoContextLost[]              = "gpu-no-context-lost";
 // Disables the use of DirectComposition to draw to the screen.
 const char kDisableDirectComposition[] = "disable-direct-composition";
 
+// Implements PostSubBuffer with eglSwapBuffersWithDamage on a buffer
+// preserving window surface when EGL_NV_post_sub_buffer is missing, so only
+// the damaged part of a frame is redrawn and reported to the compositor.
+const char kEnableSwapBuffersWithDamage[] = "enable-swap-buffers-with-damage";
+
 // Indicates whether the dual GPU switching is supported or not.
 const char kSupportsDualGpus[]              = "supports-dual-gpus";
 
@@ -107,6 +112,7 @@ const char* kGLSwitchesCopiedFromGpuProcessHost[] = {
     kOverrideUseGLWithOSMesaForTests,
     kUseANGLE,
     kDisableDirectComposition,
+    kEnableSwapBuffersWithDamage,
 };
 const int kGLSwitchesCopiedFromGpuProcessHostNumSwitches =
     arraysize(kGLSwitchesCopiedFromGpuProcessHost);
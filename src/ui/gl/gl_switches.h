@@ -36,6 +36,7 @@ GL_EXPORT extern const char kEnableGPUServiceLogging[];
 GL_EXPORT extern const char kEnableGPUServiceTracing[];
 GL_EXPORT extern const char kGpuNoContextLost[];
 GL_EXPORT extern const char kDisableDirectComposition[];
+GL_EXPORT extern const char kEnableSwapBuffersWithDamage[];
 
 GL_EXPORT extern const char kSupportsDualGpus[];
 
@@ -12,6 +12,7 @@
 #include "base/logging.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
+#include "url/url_canon.h"
 #include "url/url_canon_stdstring.h"
 #include "url/url_util.h"
 
@@ -67,6 +68,38 @@ const std::string& EmptyStringForGURL() {
 
 #endif  // WIN32
 
+// Copies |input_spec| to |spec| if it is a canonical http or https URL, which
+// avoids running the canonicalizer and over-allocating |spec| for it.
+bool CopyIfCanonical(base::StringPiece input_spec,
+                     bool trim_path_end,
+                     std::string* spec,
+                     url::Parsed* parsed) {
+  if (!url::IsCanonicalHttpURL(input_spec.data(),
+                               static_cast<int>(input_spec.length()), parsed)) {
+    return false;
+  }
+  spec->assign(input_spec.data(), input_spec.length());
+#if DCHECK_IS_ON()
+  std::string canonical_spec;
+  url::StdStringCanonOutput output(&canonical_spec);
+  url::Parsed canonical_parsed;
+  DCHECK(url::Canonicalize(input_spec.data(),
+                           static_cast<int>(input_spec.length()),
+                           trim_path_end, NULL, &output, &canonical_parsed));
+  output.Complete();
+  DCHECK_EQ(canonical_spec, *spec);
+#endif
+  return true;
+}
+
+// Only 8-bit input is checked.
+bool CopyIfCanonical(base::StringPiece16 input_spec,
+                     bool trim_path_end,
+                     std::string* spec,
+                     url::Parsed* parsed) {
+  return false;
+}
+
 }  // namespace
 
 GURL::GURL() : is_valid_(false) {
@@ -129,6 +162,13 @@ GURL::GURL(std::string canonical_spec, const url::Parsed& parsed, bool is_valid)
 template<typename STR>
 void GURL::InitCanonical(base::BasicStringPiece<STR> input_spec,
                          bool trim_path_end) {
+  // Most URLs, e.g. the ones coming from the network stack, are canonical
+  // already.
+  if (CopyIfCanonical(input_spec, trim_path_end, &spec_, &parsed_)) {
+    is_valid_ = true;
+    return;
+  }
+
   // Reserve enough room in the output for the input, plus some extra so that
   // we have room if we have to escape a few things without reallocating.
   spec_.reserve(input_spec.size() + 32);
@@ -499,6 +499,15 @@ URL_EXPORT void CanonicalizeRef(const base::char16* spec,
 //
 // The 8-bit versions require UTF-8 encoding.
 
+// Returns true if |spec| is an http or https URL which CanonicalizeStandardURL
+// would leave unchanged, and sets |*parsed| to its components. This is a quick
+// check for URLs which are known to be canonical, e.g. ones from the network
+// stack. It is conservative: some canonical URLs, e.g. ones with a port, an
+// IP address host or escapes, are not recognized.
+URL_EXPORT bool IsCanonicalHttpURL(const char* spec,
+                                   int spec_len,
+                                   Parsed* parsed);
+
 // Use for standard URLs with authorities and paths.
 URL_EXPORT bool CanonicalizeStandardURL(const char* spec,
                                         int spec_len,
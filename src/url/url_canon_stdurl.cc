@@ -90,6 +90,36 @@ bool DoCanonicalizeStandardURL(const URLComponentSource<CHAR>& source,
   return success;
 }
 
+inline bool IsLowerCaseAlphaNumeric(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+}
+
+// Hosts made of these characters are copied as is by the host canonicalizer,
+// unless they are IP addresses.
+inline bool IsCanonicalHostChar(char c) {
+  return IsLowerCaseAlphaNumeric(c) || c == '-' || c == '.';
+}
+
+// Path characters which the path canonicalizer copies as is. Dots are only
+// special as whole "." and ".." segments, which are checked separately.
+inline bool IsCanonicalPathChar(char c) {
+  if (IsLowerCaseAlphaNumeric(c) || (c >= 'A' && c <= 'Z'))
+    return true;
+  switch (c) {
+    case '!': case '$': case '&': case '\'': case '(': case ')': case '*':
+    case '+': case ',': case '-': case '.': case '/': case ':': case ';':
+    case '=': case '@': case '[': case ']': case '_': case '~':
+      return true;
+    default:
+      return false;
+  }
+}
+
+inline bool IsDotSegment(const char* segment, int segment_len) {
+  return (segment_len == 1 && segment[0] == '.') ||
+         (segment_len == 2 && segment[0] == '.' && segment[1] == '.');
+}
+
 }  // namespace
 
 
@@ -124,6 +154,85 @@ int DefaultPortForScheme(const char* scheme, int scheme_len) {
   return default_port;
 }
 
+bool IsCanonicalHttpURL(const char* spec, int spec_len, Parsed* parsed) {
+  int scheme_len;
+  if (spec_len > 7 && !strncmp(spec, "http://", 7))
+    scheme_len = 4;
+  else if (spec_len > 8 && !strncmp(spec, "https://", 8))
+    scheme_len = 5;
+  else
+    return false;
+
+  // Host, which must be followed by a path since the canonicalizer would add
+  // one. Anything but a port-less lower case DNS name takes the slow path.
+  int host_begin = scheme_len + 3;
+  int last_label_begin = host_begin;
+  int i = host_begin;
+  for (; i < spec_len && spec[i] != '/'; i++) {
+    if (!IsCanonicalHostChar(spec[i]))
+      return false;
+    if (spec[i] == '.' && i + 1 < spec_len && spec[i + 1] != '/')
+      last_label_begin = i + 1;
+  }
+  if (i == host_begin || i == spec_len)
+    return false;
+  // A host whose last label is numeric may be an IPv4 address, which the
+  // canonicalizer could rewrite.
+  if (spec[last_label_begin] >= '0' && spec[last_label_begin] <= '9')
+    return false;
+  Component host = MakeRange(host_begin, i);
+
+  // Path, without escapes or dot segments.
+  int path_begin = i;
+  int segment_begin = i;
+  for (; i < spec_len && spec[i] != '?' && spec[i] != '#'; i++) {
+    if (spec[i] == '/') {
+      if (IsDotSegment(&spec[segment_begin], i - segment_begin))
+        return false;
+      segment_begin = i + 1;
+    } else if (!IsCanonicalPathChar(spec[i])) {
+      return false;
+    }
+  }
+  if (IsDotSegment(&spec[segment_begin], i - segment_begin))
+    return false;
+  Component path = MakeRange(path_begin, i);
+
+  Component query;
+  if (i < spec_len && spec[i] == '?') {
+    int query_begin = ++i;
+    for (; i < spec_len && spec[i] != '#'; i++) {
+      if (!IsQueryChar(static_cast<unsigned char>(spec[i])))
+        return false;
+    }
+    query = MakeRange(query_begin, i);
+  }
+
+  // Printable ASCII is copied as is into the ref; spaces would be trimmed
+  // from the end of the URL.
+  Component ref;
+  if (i < spec_len) {
+    int ref_begin = ++i;
+    for (; i < spec_len; i++) {
+      unsigned char c = static_cast<unsigned char>(spec[i]);
+      if (c <= ' ' || c >= 0x7F)
+        return false;
+    }
+    ref = MakeRange(ref_begin, i);
+  }
+
+  parsed->scheme = Component(0, scheme_len);
+  parsed->username = Component();
+  parsed->password = Component();
+  parsed->host = host;
+  parsed->port = Component();
+  parsed->path = path;
+  parsed->query = query;
+  parsed->ref = ref;
+  parsed->clear_inner_parsed();
+  return true;
+}
+
 bool CanonicalizeStandardURL(const char* spec,
                              int spec_len,
                              const Parsed& parsed,
@@ -1361,6 +1361,77 @@ TEST(URLCanonTest, CanonicalizeStandardURL) {
   }
 }
 
+TEST(URLCanonTest, IsCanonicalHttpURL) {
+  struct URLCase {
+    const char* input;
+    bool expected_canonical;
+  } cases[] = {
+    {"http://www.google.com/", true},
+    {"https://www.example.com/a/b.html?q=1&r=[2]#frag", true},
+    {"http://a/~user/_x-y;p=1,2+3*4!5$6&7(8)9@a:b", true},
+    {"http://a/b?c=d#e#f", true},
+    {"http://foo.bar./x", true},
+    {"http://a/b?#", true},
+      // The canonicalizer would add a path, lower case the host or the scheme,
+      // or drop the default port.
+    {"http://a", false},
+    {"http://a?b", false},
+    {"http://A/", false},
+    {"HTTP://a/", false},
+    {"http://a:80/", false},
+      // Canonical, but not recognized.
+    {"http://a:8080/", false},
+    {"http://user@a/", false},
+    {"http://a_b.com/", false},
+    {"ftp://a/", false},
+      // IPv4 addresses may be rewritten.
+    {"http://1.2.3.4/", false},
+    {"http://127.1/", false},
+    {"http://0x7f.1/", false},
+      // Dot segments, escapes and characters which need escaping.
+    {"http://a/./b", false},
+    {"http://a/b/..", false},
+    {"http://a/%41", false},
+    {"http://a/b c", false},
+    {"http://a/b\\c", false},
+    {"http://a/b?c d", false},
+    {"http://a/b?c<d>", false},
+    {"http://a/b?c'd", false},
+    {"http://a/b#c d", false},
+    {"http://a/b\xc3\xa9", false},
+    {"http:///a/", false},
+  };
+
+  for (size_t i = 0; i < arraysize(cases); i++) {
+    int url_len = static_cast<int>(strlen(cases[i].input));
+    Parsed parsed;
+    EXPECT_EQ(cases[i].expected_canonical,
+              IsCanonicalHttpURL(cases[i].input, url_len, &parsed))
+        << cases[i].input;
+    if (!cases[i].expected_canonical)
+      continue;
+
+    // The URL and its components must be what the canonicalizer produces.
+    Parsed input_parsed;
+    ParseStandardURL(cases[i].input, url_len, &input_parsed);
+    Parsed out_parsed;
+    std::string out_str;
+    StdStringCanonOutput output(&out_str);
+    EXPECT_TRUE(CanonicalizeStandardURL(cases[i].input, url_len, input_parsed,
+                                        NULL, &output, &out_parsed));
+    output.Complete();
+    EXPECT_EQ(cases[i].input, out_str);
+    EXPECT_TRUE(out_parsed.scheme == parsed.scheme);
+    EXPECT_TRUE(out_parsed.username == parsed.username);
+    EXPECT_TRUE(out_parsed.password == parsed.password);
+    EXPECT_TRUE(out_parsed.host == parsed.host);
+    EXPECT_TRUE(out_parsed.port == parsed.port);
+    EXPECT_TRUE(out_parsed.path == parsed.path);
+    EXPECT_TRUE(out_parsed.query == parsed.query);
+    EXPECT_TRUE(out_parsed.ref == parsed.ref);
+  }
+}
+
 // The codepath here is the same as for regular canonicalization, so we just
 // need to test that things are replaced or not correctly.
 TEST(URLCanonTest, ReplaceStandardURL) {
@@ -5,9 +5,25 @@
 #include "webos/common/webos_watchdog.h"
 
 #include <signal.h>
+#include <stddef.h>
 
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/command_line.h"
+#include "base/format_macros.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/metrics/histogram.h"
+#include "base/profiler/native_stack_sampler.h"
+#include "base/profiler/stack_sampling_profiler.h"
+#include "base/single_thread_task_runner.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/common/content_switches.h"
 
 namespace webos {
@@ -16,6 +32,61 @@ static const int kDefaultWatchdogTimeout = 100;
 static const int kDefaultWatchdogPeriod = 20;
 static const int kWatchdogCleanupPeriod = 10;
 
+// How often the watched threads get a heartbeat, and the stall after which
+// the stack of a thread is logged, unless half the timeout is shorter.
+static const int kHeartbeatIntervalSeconds = 1;
+static const int kLongStallSeconds = 5;
+
+namespace {
+
+// Logs the stack of the thread, with the modules of the frames so that it can
+// be symbolized offline.
+void LogStackOfThread(const std::string& name, base::PlatformThreadId tid) {
+  std::unique_ptr<base::NativeStackSampler> sampler =
+      base::NativeStackSampler::Create(tid, nullptr);
+  if (!sampler) {
+    LOG(ERROR) << "Can't sample the stack of thread " << name;
+    return;
+  }
+
+  std::vector<base::StackSamplingProfiler::Module> modules;
+  base::StackSamplingProfiler::Sample sample;
+  sampler->ProfileRecordingStarting(&modules);
+  sampler->RecordStackSample(&sample);
+  sampler->ProfileRecordingStopped();
+
+  LOG(ERROR) << "Stack of stalled thread " << name << " (" << tid << "):";
+  for (size_t i = 0; i < sample.size(); ++i) {
+    const base::StackSamplingProfiler::Frame& frame = sample[i];
+    if (frame.module_index >= modules.size()) {
+      LOG(ERROR) << base::StringPrintf("  #%" PRIuS " 0x%" PRIxPTR, i,
+                                       frame.instruction_pointer);
+      continue;
+    }
+    const base::StackSamplingProfiler::Module& module =
+        modules[frame.module_index];
+    LOG(ERROR) << base::StringPrintf(
+        "  #%" PRIuS " 0x%" PRIxPTR " %s+0x%" PRIxPTR " (%s)", i,
+        frame.instruction_pointer, module.filename.value().c_str(),
+        frame.instruction_pointer - module.base_address, module.id.c_str());
+  }
+}
+
+}  // namespace
+
+struct WebOSWatchdog::WatchedThread {
+  std::string name;
+  base::PlatformThreadId tid;
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner;
+  base::HistogramBase* heartbeat_delay_histogram;
+
+  // When the heartbeat that hasn't run yet was posted, if there is one.
+  base::TimeTicks heartbeat_post_time;
+
+  // The stack is only logged for the first long stall of the thread.
+  bool stack_logged;
+};
+
 WebOSWatchdog::WebOSWatchdog()
     : period_(kDefaultWatchdogPeriod),
       timeout_(kDefaultWatchdogTimeout),
@@ -27,6 +98,8 @@ WebOSWatchdog::~WebOSWatchdog() {
     watchdog_thread_->Disarm();
     watchdog_thread_->Cleanup();
   }
+  // Joins the thread, so none of the tasks bound to |this| can run after.
+  monitor_thread_.reset();
 }
 
 void WebOSWatchdog::StartWatchdog() {
@@ -38,6 +111,96 @@ void WebOSWatchdog::Arm() {
   watchdog_thread_->Arm();
 }
 
+void WebOSWatchdog::WatchCurrentThread(const std::string& name) {
+  std::unique_ptr<WatchedThread> thread(new WatchedThread);
+  thread->name = name;
+  thread->tid = base::PlatformThread::CurrentId();
+  thread->task_runner = base::ThreadTaskRunnerHandle::Get();
+  thread->heartbeat_delay_histogram = base::Histogram::FactoryTimeGet(
+      "WebOS.Watchdog.HeartbeatDelay." + name,
+      base::TimeDelta::FromMilliseconds(1),
+      base::TimeDelta::FromSeconds(timeout_), 50,
+      base::HistogramBase::kUmaTargetedHistogramFlag);
+  thread->stack_logged = false;
+
+  bool start_checking = false;
+  if (!monitor_thread_) {
+    monitor_thread_.reset(new base::Thread("WebOSHangMonitor"));
+    if (!monitor_thread_->Start()) {
+      LOG(ERROR) << "Can't start the hang monitor thread";
+      monitor_thread_.reset();
+      return;
+    }
+    start_checking = true;
+  }
+  monitor_thread_->task_runner()->PostTask(
+      FROM_HERE, base::Bind(&WebOSWatchdog::AddWatchedThread,
+                            base::Unretained(this), base::Passed(&thread)));
+  if (start_checking) {
+    monitor_thread_->task_runner()->PostTask(
+        FROM_HERE, base::Bind(&WebOSWatchdog::CheckWatchedThreads,
+                              base::Unretained(this)));
+  }
+}
+
+void WebOSWatchdog::AddWatchedThread(std::unique_ptr<WatchedThread> thread) {
+  watched_threads_.push_back(std::move(thread));
+}
+
+void WebOSWatchdog::CheckWatchedThreads() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::TimeDelta timeout = base::TimeDelta::FromSeconds(timeout_);
+  const base::TimeDelta long_stall =
+      std::min(base::TimeDelta::FromSeconds(kLongStallSeconds), timeout / 2);
+
+  for (const std::unique_ptr<WatchedThread>& thread : watched_threads_) {
+    if (thread->heartbeat_post_time.is_null()) {
+      // The reply runs back on this thread once the heartbeat ran.
+      thread->heartbeat_post_time = now;
+      thread->task_runner->PostTaskAndReply(
+          FROM_HERE, base::Bind(&base::DoNothing),
+          base::Bind(&WebOSWatchdog::DidRunHeartbeat, base::Unretained(this),
+                     thread.get(), now));
+      continue;
+    }
+
+    const base::TimeDelta stall = now - thread->heartbeat_post_time;
+    if (stall >= long_stall && !thread->stack_logged) {
+      thread->stack_logged = true;
+      TRACE_EVENT_INSTANT2("webos", "WebOSWatchdog::LongStall",
+                           TRACE_EVENT_SCOPE_PROCESS, "thread", thread->name,
+                           "stall_ms", stall.InMilliseconds());
+      LOG(ERROR) << "Thread " << thread->name << " stalled for "
+                 << stall.InSecondsF() << "s";
+      LogStackOfThread(thread->name, thread->tid);
+    }
+
+    if (stall >= timeout) {
+      thread->heartbeat_delay_histogram->AddTime(stall);
+      // kill process
+      RAW_PMLOG_INFO("WatchdogThread",
+                     "Stuck detected in thread %d in process %d! Kill %d "
+                     "process",
+                     thread->tid, getpid(), getpid());
+      kill(getpid(), SIGABRT);
+      return;
+    }
+  }
+
+  monitor_thread_->task_runner()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&WebOSWatchdog::CheckWatchedThreads, base::Unretained(this)),
+      base::TimeDelta::FromSeconds(kHeartbeatIntervalSeconds));
+}
+
+void WebOSWatchdog::DidRunHeartbeat(WatchedThread* thread,
+                                    base::TimeTicks post_time) {
+  DCHECK_EQ(post_time, thread->heartbeat_post_time);
+  thread->heartbeat_delay_histogram->AddTime(base::TimeTicks::Now() -
+                                             post_time);
+  thread->heartbeat_post_time = base::TimeTicks();
+}
+
 WebOSWatchdog::WatchdogThread::WatchdogThread(const base::TimeDelta& duration,
                                               WebOSWatchdog* watchdog)
     : base::Watchdog(duration, "WebOSWatchdog", true), watchdog_(watchdog) {
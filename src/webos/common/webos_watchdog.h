@@ -18,10 +18,17 @@
 #define WEBOS_COMMON_WEBOS_WATCHDOG_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "base/threading/platform_thread.h"
 #include "base/threading/watchdog.h"
 #include "base/time/time.h"
 
+namespace base {
+class Thread;
+}
+
 namespace webos {
 
 class WebOSWatchdog {
@@ -40,7 +47,22 @@ class WebOSWatchdog {
   int WatchingThreadTid() { return watching_tid_; }
   void SetWatchingThreadTid(int tid) { watching_tid_ = tid; }
 
+  // Adds the calling thread, which must have a task runner, to the threads
+  // watched for hangs. A heartbeat task is posted to each of them every second
+  // and how late it runs is recorded in the
+  // "WebOS.Watchdog.HeartbeatDelay.<name>" histogram. The first time one of
+  // the threads stalls for long, its stack is logged, and if it stalls for the
+  // whole timeout the process is killed like with Arm().
+  void WatchCurrentThread(const std::string& name);
+
  private:
+  struct WatchedThread;
+
+  // These run on |monitor_thread_|.
+  void AddWatchedThread(std::unique_ptr<WatchedThread> thread);
+  void CheckWatchedThreads();
+  void DidRunHeartbeat(WatchedThread* thread, base::TimeTicks post_time);
+
   class WatchdogThread : public base::Watchdog {
    public:
     WatchdogThread(const base::TimeDelta& duration, WebOSWatchdog* watchdog);
@@ -52,6 +74,10 @@ class WebOSWatchdog {
   };
 
   std::unique_ptr<base::Watchdog> watchdog_thread_;
+
+  // Posts the heartbeats and checks on them. Only it uses |watched_threads_|.
+  std::unique_ptr<base::Thread> monitor_thread_;
+  std::vector<std::unique_ptr<WatchedThread>> watched_threads_;
   int watching_tid_;
   int period_;
   int timeout_;